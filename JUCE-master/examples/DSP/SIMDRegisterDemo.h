@@ -57,12 +57,6 @@
 
 using namespace dsp;
 
-template <typename T>
-static T* toBasePointer (SIMDRegister<T>* r) noexcept
-{
-    return reinterpret_cast<T*> (r);
-}
-
 constexpr auto registerSize = dsp::SIMDRegister<float>::size();
 
 //==============================================================================
@@ -76,49 +70,26 @@ struct SIMDRegisterDemoDSP
         iir.reset (new IIR::Filter<SIMDRegister<float>> (iirCoefficients));
 
         interleaved = AudioBlock<SIMDRegister<float>> (interleavedBlockData, 1, spec.maximumBlockSize);
-        zero        = AudioBlock<float> (zeroData, SIMDRegister<float>::size(), spec.maximumBlockSize);
-
-        zero.clear();
 
         auto monoSpec = spec;
         monoSpec.numChannels = 1;
         iir->prepare (monoSpec);
     }
 
-    template <typename SampleType>
-    auto prepareChannelPointers (const AudioBlock<SampleType>& block)
-    {
-        std::array<SampleType*, registerSize> result {};
-
-        for (size_t ch = 0; ch < result.size(); ++ch)
-            result[ch] = (ch < block.getNumChannels() ? block.getChannelPointer (ch) : zero.getChannelPointer (ch));
-
-        return result;
-    }
-
     void process (const ProcessContextReplacing<float>& context)
     {
         jassert (context.getInputBlock().getNumSamples()  == context.getOutputBlock().getNumSamples());
         jassert (context.getInputBlock().getNumChannels() == context.getOutputBlock().getNumChannels());
 
-        const auto& input  = context.getInputBlock();
-        const auto numSamples = (int) input.getNumSamples();
-
-        auto inChannels = prepareChannelPointers (input);
+        const auto& input = context.getInputBlock();
+        const auto numChannels = jmin (input.getNumChannels(), registerSize);
+        auto block = interleaved.getSubBlock (0, input.getNumSamples());
 
-        using Format = AudioData::Format<AudioData::Float32, AudioData::NativeEndian>;
+        packChannels (input.getSubsetChannelBlock (0, numChannels), block);
 
-        AudioData::interleaveSamples (AudioData::NonInterleavedSource<Format> { inChannels.data(),                                 registerSize, },
-                                      AudioData::InterleavedDest<Format>      { toBasePointer (interleaved.getChannelPointer (0)), registerSize },
-                                      numSamples);
+        iir->process (ProcessContextReplacing<SIMDRegister<float>> (block));
 
-        iir->process (ProcessContextReplacing<SIMDRegister<float>> (interleaved));
-
-        auto outChannels = prepareChannelPointers (context.getOutputBlock());
-
-        AudioData::deinterleaveSamples (AudioData::InterleavedSource<Format>  { toBasePointer (interleaved.getChannelPointer (0)), registerSize },
-                                        AudioData::NonInterleavedDest<Format> { outChannels.data(),                                registerSize },
-                                        numSamples);
+        unpackChannels (block, context.getOutputBlock().getSubsetChannelBlock (0, numChannels));
     }
 
     void reset()
@@ -148,9 +119,7 @@ struct SIMDRegisterDemoDSP
     std::unique_ptr<IIR::Filter<SIMDRegister<float>>> iir;
 
     AudioBlock<SIMDRegister<float>> interleaved;
-    AudioBlock<float> zero;
-
-    HeapBlock<char> interleavedBlockData, zeroData;
+    HeapBlock<char> interleavedBlockData;
 
     ChoiceParameter typeParam { { "Low-pass", "High-pass", "Band-pass" }, 1, "Type" };
     SliderParameter cutoffParam { { 20.0, 20000.0 }, 0.5, 440.0f, "Cutoff", "Hz" };
@@ -181,6 +181,7 @@ static String getAllSystemInfo()
       << "CPU has AVX512VBMI:      " << boolString (SystemStats::hasAVX512VBMI()      ) << newLine
       << "CPU has AVX512VL:        " << boolString (SystemStats::hasAVX512VL()        ) << newLine
       << "CPU has AVX512VPOPCNTDQ: " << boolString (SystemStats::hasAVX512VPOPCNTDQ() ) << newLine
+      << "CPU has SHA:             " << boolString (SystemStats::hasSHA()             ) << newLine
       << "CPU has Neon:            " << boolString (SystemStats::hasNeon()            ) << newLine
       << newLine;
 
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/** The block size and channel count that a benchmark is run with. */
+struct BenchmarkConfig
+{
+    int blockSize = 512;
+    int numChannels = 2;
+    double sampleRate = 48000.0;
+};
+
+//==============================================================================
+/** A named piece of work to be timed.
+
+    The prepare function is called once for each configuration, and should set up
+    any state that's needed and return a function that processes a single block of
+    blockSize samples on each of numChannels channels. It can return an empty
+    function if the configuration isn't supported.
+*/
+struct BenchmarkCase
+{
+    using ProcessFunction = std::function<void()>;
+
+    String name;
+    std::function<ProcessFunction (const BenchmarkConfig&)> prepare;
+};
+
+//==============================================================================
+/** The timing of one benchmark case in one configuration. */
+struct BenchmarkResult
+{
+    String name;
+    int blockSize = 0, numChannels = 0, numRuns = 0;
+    double nsPerSample = 0;         // the mean over all the runs
+    double confidenceInterval = 0;  // the half-width of the 95% confidence interval of the mean
+    double fastestNsPerSample = 0;
+
+    String getKey() const       { return name + " / " + String (blockSize) + " / " + String (numChannels); }
+};
+
+//==============================================================================
+/** Times benchmark cases, and reads and writes results in a machine-readable form. */
+class BenchmarkHarness
+{
+public:
+    struct Options
+    {
+        int numRuns = 20;  // must be at least 1
+        double secondsPerRun = 0.01;
+        double warmUpSeconds = 0.05;
+    };
+
+    explicit BenchmarkHarness (Options opts) : options (opts) {}
+
+    /** Times a case, returning nothing if it doesn't support the given configuration. */
+    std::optional<BenchmarkResult> run (const BenchmarkCase& benchmark, const BenchmarkConfig& config) const
+    {
+        auto process = benchmark.prepare (config);
+
+        if (process == nullptr)
+            return {};
+
+        // Run for a while to settle caches, branch predictors and CPU clocks, and to
+        // find out how many blocks fit into each timed run
+        int64 numBlocks = 0;
+        const auto warmUpStart = Time::getHighResolutionTicks();
+
+        do
+        {
+            process();
+            ++numBlocks;
+        }
+        while (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - warmUpStart) < options.warmUpSeconds);
+
+        const auto warmUpSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - warmUpStart);
+        const auto blocksPerRun = jmax ((int64) 1, (int64) ((double) numBlocks * options.secondsPerRun / warmUpSeconds));
+        const auto samplesPerRun = (double) blocksPerRun * config.blockSize * config.numChannels;
+
+        std::vector<double> nsPerSample;
+
+        for (int run = 0; run < options.numRuns; ++run)
+        {
+            const auto start = Time::getHighResolutionTicks();
+
+            for (int64 i = 0; i < blocksPerRun; ++i)
+                process();
+
+            const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+            nsPerSample.push_back (seconds * 1.0e9 / samplesPerRun);
+        }
+
+        const auto n = (double) nsPerSample.size();
+        const auto mean = std::accumulate (nsPerSample.begin(), nsPerSample.end(), 0.0) / n;
+        const auto sumOfSquares = std::accumulate (nsPerSample.begin(), nsPerSample.end(), 0.0,
+                                                   [mean] (double total, double v) { return total + (v - mean) * (v - mean); });
+        const auto sampleStandardDeviation = n > 1 ? std::sqrt (sumOfSquares / (n - 1)) : 0.0;
+
+        BenchmarkResult result;
+        result.name = benchmark.name;
+        result.blockSize = config.blockSize;
+        result.numChannels = config.numChannels;
+        result.numRuns = (int) nsPerSample.size();
+        result.nsPerSample = mean;
+        result.fastestNsPerSample = *std::min_element (nsPerSample.begin(), nsPerSample.end());
+        result.confidenceInterval = getStudentT95 (result.numRuns - 1) * sampleStandardDeviation / std::sqrt (n);
+        return result;
+    }
+
+    //==============================================================================
+    static var toJSON (const std::vector<BenchmarkResult>& results)
+    {
+        auto root = std::make_unique<DynamicObject>();
+        root->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+        root->setProperty ("os", SystemStats::getOperatingSystemName());
+        root->setProperty ("cpu", SystemStats::getCpuModel());
+        root->setProperty ("date", Time::getCurrentTime().toISO8601 (true));
+
+        Array<var> list;
+
+        for (auto& r : results)
+        {
+            auto item = std::make_unique<DynamicObject>();
+            item->setProperty ("name", r.name);
+            item->setProperty ("blockSize", r.blockSize);
+            item->setProperty ("numChannels", r.numChannels);
+            item->setProperty ("numRuns", r.numRuns);
+            item->setProperty ("nsPerSample", r.nsPerSample);
+            item->setProperty ("confidenceInterval", r.confidenceInterval);
+            item->setProperty ("fastestNsPerSample", r.fastestNsPerSample);
+            list.add (var (item.release()));
+        }
+
+        root->setProperty ("results", list);
+        return var (root.release());
+    }
+
+    static std::vector<BenchmarkResult> fromJSON (const var& json)
+    {
+        std::vector<BenchmarkResult> results;
+
+        if (auto* list = json["results"].getArray())
+        {
+            for (auto& item : *list)
+            {
+                BenchmarkResult r;
+                r.name = item["name"].toString();
+                r.blockSize = item["blockSize"];
+                r.numChannels = item["numChannels"];
+                r.numRuns = item["numRuns"];
+                r.nsPerSample = item["nsPerSample"];
+                r.confidenceInterval = item["confidenceInterval"];
+                r.fastestNsPerSample = item["fastestNsPerSample"];
+                results.push_back (r);
+            }
+        }
+
+        return results;
+    }
+
+    //==============================================================================
+    /** Returns true if a result is slower than its baseline by more than both the
+        given tolerance and the combined uncertainty of the two measurements.
+    */
+    static bool isRegression (const BenchmarkResult& result, const BenchmarkResult& baseline, double tolerancePercent)
+    {
+        const auto difference = result.nsPerSample - baseline.nsPerSample;
+
+        return difference > baseline.nsPerSample * tolerancePercent / 100.0
+            && difference > result.confidenceInterval + baseline.confidenceInterval;
+    }
+
+private:
+    static double getStudentT95 (int degreesOfFreedom)
+    {
+        // Two-sided 95% critical values of Student's t distribution
+        static constexpr double table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                            2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                            2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+        if (degreesOfFreedom < 1)
+            return 0.0;
+
+        if (degreesOfFreedom <= (int) std::size (table))
+            return table[degreesOfFreedom - 1];
+
+        return 1.96;
+    }
+
+    Options options;
+};
@@ -0,0 +1,421 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BenchmarkHarness.h"
+
+namespace Benchmarks
+{
+
+//==============================================================================
+inline AudioBuffer<float> createNoise (int numChannels, int numSamples, uint64 seed = 1)
+{
+    AudioBuffer<float> buffer (numChannels, numSamples);
+    FastRandom random (seed);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        random.fillUniform (buffer.getWritePointer (ch), (size_t) numSamples, { -0.5f, 0.5f });
+
+    return buffer;
+}
+
+/** Two buffers of noise, which most of the simple benchmarks work on. */
+struct SourceAndDest
+{
+    explicit SourceAndDest (const BenchmarkConfig& config)
+        : source (createNoise (config.numChannels, config.blockSize, 1)),
+          dest (createNoise (config.numChannels, config.blockSize, 2))
+    {}
+
+    AudioBuffer<float> source, dest;
+};
+
+template <typename Fn>
+BenchmarkCase makeVectorCase (String name, Fn perChannel)
+{
+    return { std::move (name), [perChannel] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        auto buffers = std::make_shared<SourceAndDest> (config);
+
+        return [buffers, perChannel]
+        {
+            for (int ch = 0; ch < buffers->dest.getNumChannels(); ++ch)
+                perChannel (buffers->dest.getWritePointer (ch), buffers->source.getReadPointer (ch), buffers->dest.getNumSamples());
+        };
+    } };
+}
+
+template <typename Processor>
+BenchmarkCase makeDSPProcessorCase (String name, std::function<void (Processor&, const BenchmarkConfig&)> setUp)
+{
+    return { std::move (name), [setUp] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        auto processor = std::make_shared<Processor>();
+        setUp (*processor, config);
+        processor->prepare ({ config.sampleRate, (uint32) config.blockSize, (uint32) config.numChannels });
+
+        auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (config.numChannels, config.blockSize));
+
+        return [processor, buffer]
+        {
+            dsp::AudioBlock<float> block (*buffer);
+            processor->process (dsp::ProcessContextReplacing<float> (block));
+        };
+    } };
+}
+
+//==============================================================================
+inline std::vector<BenchmarkCase> createFloatVectorOperationsCases()
+{
+    using FVO = FloatVectorOperations;
+
+    return
+    {
+        makeVectorCase ("FloatVectorOperations::add", [] (float* d, const float* s, int n)               { FVO::add (d, s, n); }),
+        makeVectorCase ("FloatVectorOperations::multiply", [] (float* d, const float* s, int n)          { FVO::multiply (d, s, n); }),
+        makeVectorCase ("FloatVectorOperations::addWithMultiply", [] (float* d, const float* s, int n)   { FVO::addWithMultiply (d, s, 0.5f, n); }),
+        makeVectorCase ("FloatVectorOperations::clip", [] (float* d, const float* s, int n)              { FVO::clip (d, s, -0.25f, 0.25f, n); }),
+        makeVectorCase ("FloatVectorOperations::findMinAndMax", [] (float*, const float* s, int n)       { ignoreUnused (FVO::findMinAndMax (s, n)); })
+    };
+}
+
+inline BenchmarkCase createFFTCase()
+{
+    return { "dsp::FFT real forward", [] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        if (! isPowerOfTwo (config.blockSize))
+            return {};
+
+        auto fft = std::make_shared<dsp::FFT> (roundToInt (std::log2 (config.blockSize)));
+        auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (config.numChannels, config.blockSize * 2));
+
+        return [fft, buffer]
+        {
+            for (int ch = 0; ch < buffer->getNumChannels(); ++ch)
+                fft->performRealOnlyForwardTransform (buffer->getWritePointer (ch), true);
+        };
+    } };
+}
+
+inline BenchmarkCase createConvolutionCase()
+{
+    return { "dsp::Convolution 1s IR", [] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        // The convolution only handles mono and stereo signals
+        if (config.numChannels > 2)
+            return {};
+
+        auto convolution = std::make_shared<dsp::Convolution>();
+        convolution->prepare ({ config.sampleRate, (uint32) config.blockSize, (uint32) config.numChannels });
+
+        const auto irLength = (int) config.sampleRate;
+        auto ir = createNoise (config.numChannels, irLength, 3);
+
+        for (int i = 0; i < irLength; ++i)
+            for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+                ir.setSample (ch, i, ir.getSample (ch, i) * std::exp (-5.0f * (float) i / (float) irLength));
+
+        convolution->loadImpulseResponse (std::move (ir), config.sampleRate,
+                                          config.numChannels > 1 ? dsp::Convolution::Stereo::yes : dsp::Convolution::Stereo::no,
+                                          dsp::Convolution::Trim::no, dsp::Convolution::Normalise::yes);
+
+        auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (config.numChannels, config.blockSize));
+
+        auto process = [convolution, buffer]
+        {
+            dsp::AudioBlock<float> block (*buffer);
+            convolution->process (dsp::ProcessContextReplacing<float> (block));
+        };
+
+        // The impulse response is loaded on a background thread, and only swapped in
+        // during a call to process()
+        for (auto start = Time::getMillisecondCounter(); convolution->getCurrentIRSize() != irLength;)
+        {
+            if (Time::getMillisecondCounter() - start > 10000)
+                return {};
+
+            process();
+            Thread::sleep (1);
+        }
+
+        return process;
+    } };
+}
+
+inline BenchmarkCase createOversamplingCase()
+{
+    return { "dsp::Oversampling 4x IIR", [] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        auto oversampling = std::make_shared<dsp::Oversampling<float>> ((size_t) config.numChannels, 2,
+                                                                        dsp::Oversampling<float>::filterHalfBandPolyphaseIIR);
+        oversampling->initProcessing ((size_t) config.blockSize);
+
+        auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (config.numChannels, config.blockSize));
+
+        return [oversampling, buffer]
+        {
+            dsp::AudioBlock<float> block (*buffer);
+            oversampling->processSamplesUp (block);
+            oversampling->processSamplesDown (block);
+        };
+    } };
+}
+
+inline std::vector<BenchmarkCase> createFilterCases()
+{
+    using IIRFilter = dsp::ProcessorDuplicator<dsp::IIR::Filter<float>, dsp::IIR::Coefficients<float>>;
+    using FIRFilter = dsp::ProcessorDuplicator<dsp::FIR::Filter<float>, dsp::FIR::Coefficients<float>>;
+
+    return
+    {
+        makeDSPProcessorCase<IIRFilter> ("dsp::IIR biquad low-pass", [] (IIRFilter& f, const BenchmarkConfig& config)
+        {
+            f.state = dsp::IIR::Coefficients<float>::makeLowPass (config.sampleRate, 1000.0f);
+        }),
+
+        makeDSPProcessorCase<FIRFilter> ("dsp::FIR 128 taps", [] (FIRFilter& f, const BenchmarkConfig& config)
+        {
+            f.state = dsp::FilterDesign<float>::designFIRLowpassWindowMethod (8000.0f, config.sampleRate, 127,
+                                                                              dsp::WindowingFunction<float>::hann);
+        })
+    };
+}
+
+//==============================================================================
+struct SineSound final : public SynthesiserSound
+{
+    bool appliesToNote (int) override      { return true; }
+    bool appliesToChannel (int) override   { return true; }
+};
+
+struct SineVoice final : public SynthesiserVoice
+{
+    bool canPlaySound (SynthesiserSound*) override    { return true; }
+
+    void startNote (int note, float velocity, SynthesiserSound*, int) override
+    {
+        phase = 0.0;
+        delta = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+        level = velocity * 0.05f;
+    }
+
+    void stopNote (float, bool) override              { clearCurrentNote(); }
+    void pitchWheelMoved (int) override               {}
+    void controllerMoved (int, int) override          {}
+
+    void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+    {
+        for (int i = startSample; i < startSample + numSamples; ++i)
+        {
+            const auto sample = level * (float) std::sin (phase);
+            phase = std::fmod (phase + delta, MathConstants<double>::twoPi);
+
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                output.addSample (ch, i, sample);
+        }
+    }
+
+    using SynthesiserVoice::renderNextBlock;
+
+    double phase = 0.0, delta = 0.0;
+    float level = 0.0f;
+};
+
+inline BenchmarkCase createSynthesiserCase (int numVoices)
+{
+    return { "Synthesiser " + String (numVoices) + " voices", [numVoices] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        auto synth = std::make_shared<Synthesiser>();
+        synth->addSound (new SineSound());
+
+        for (int i = 0; i < numVoices; ++i)
+            synth->addVoice (new SineVoice());
+
+        synth->setCurrentPlaybackSampleRate (config.sampleRate);
+
+        for (int i = 0; i < numVoices; ++i)
+            synth->noteOn (1, 36 + i, 0.8f);
+
+        auto buffer = std::make_shared<AudioBuffer<float>> (config.numChannels, config.blockSize);
+        auto midi = std::make_shared<MidiBuffer>();
+
+        return [synth, buffer, midi]
+        {
+            buffer->clear();
+            synth->renderNextBlock (*buffer, *midi, 0, buffer->getNumSamples());
+        };
+    } };
+}
+
+//==============================================================================
+class GainProcessor final : public AudioProcessor
+{
+public:
+    explicit GainProcessor (int numChannels)
+        : AudioProcessor (BusesProperties().withInput  ("Input",  AudioChannelSet::discreteChannels (numChannels))
+                                           .withOutput ("Output", AudioChannelSet::discreteChannels (numChannels)))
+    {}
+
+    const String getName() const override                       { return "Gain"; }
+    void prepareToPlay (double, int) override                   {}
+    void releaseResources() override                            {}
+    double getTailLengthSeconds() const override                { return 0.0; }
+    bool acceptsMidi() const override                           { return false; }
+    bool producesMidi() const override                          { return false; }
+    AudioProcessorEditor* createEditor() override               { return nullptr; }
+    bool hasEditor() const override                             { return false; }
+    int getNumPrograms() override                               { return 1; }
+    int getCurrentProgram() override                            { return 0; }
+    void setCurrentProgram (int) override                       {}
+    const String getProgramName (int) override                  { return {}; }
+    void changeProgramName (int, const String&) override        {}
+    void getStateInformation (MemoryBlock&) override            {}
+    void setStateInformation (const void*, int) override        {}
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        buffer.applyGain (0.99f);
+    }
+
+    using AudioProcessor::processBlock;
+};
+
+inline BenchmarkCase createGraphCase (int numNodes)
+{
+    return { "AudioProcessorGraph " + String (numNodes) + " nodes", [numNodes] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        auto graph = std::make_shared<AudioProcessorGraph>();
+        graph->setPlayConfigDetails (config.numChannels, config.numChannels, config.sampleRate, config.blockSize);
+
+        auto previous = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode), {}, AudioProcessorGraph::UpdateKind::none);
+        const auto output = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode), {}, AudioProcessorGraph::UpdateKind::none);
+
+        auto connect = [&] (AudioProcessorGraph::Node::Ptr source, AudioProcessorGraph::Node::Ptr dest)
+        {
+            for (int ch = 0; ch < config.numChannels; ++ch)
+                graph->addConnection ({ { source->nodeID, ch }, { dest->nodeID, ch } }, AudioProcessorGraph::UpdateKind::none);
+        };
+
+        for (int i = 0; i < numNodes; ++i)
+        {
+            auto node = graph->addNode (std::make_unique<GainProcessor> (config.numChannels), {}, AudioProcessorGraph::UpdateKind::none);
+            connect (previous, node);
+            previous = node;
+        }
+
+        connect (previous, output);
+        graph->prepareToPlay (config.sampleRate, config.blockSize);
+
+        auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (config.numChannels, config.blockSize));
+        auto midi = std::make_shared<MidiBuffer>();
+
+        return [graph, buffer, midi]
+        {
+            graph->processBlock (*buffer, *midi);
+        };
+    } };
+}
+
+//==============================================================================
+template <typename Format>
+BenchmarkCase createReaderCase (String name, int bitDepth, int maxChannels)
+{
+    return { std::move (name), [bitDepth, maxChannels] (const BenchmarkConfig& config) -> BenchmarkCase::ProcessFunction
+    {
+        if (config.numChannels > maxChannels)
+            return {};
+
+        // Ten seconds of noise, encoded into memory so that the disk isn't involved
+        const auto length = (int) config.sampleRate * 10;
+        auto data = std::make_shared<MemoryBlock>();
+        Format format;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (*data, false),
+                                                                               config.sampleRate, (unsigned int) config.numChannels,
+                                                                               bitDepth, {}, 0));
+
+            if (writer == nullptr)
+                return {};
+
+            writer->writeFromAudioSampleBuffer (createNoise (config.numChannels, length), 0, length);
+        }
+
+        std::shared_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (*data, false), true));
+
+        if (reader == nullptr)
+            return {};
+
+        auto buffer = std::make_shared<AudioBuffer<float>> (config.numChannels, config.blockSize);
+        auto position = std::make_shared<int64>();
+
+        return [data, reader, buffer, position]
+        {
+            if (*position + buffer->getNumSamples() > reader->lengthInSamples)
+                *position = 0;
+
+            reader->read (buffer.get(), 0, buffer->getNumSamples(), *position, true, true);
+            *position += buffer->getNumSamples();
+        };
+    } };
+}
+
+//==============================================================================
+inline std::vector<BenchmarkCase> createAllCases()
+{
+    auto cases = createFloatVectorOperationsCases();
+
+    cases.push_back (createFFTCase());
+    cases.push_back (createConvolutionCase());
+    cases.push_back (createOversamplingCase());
+
+    for (auto& c : createFilterCases())
+        cases.push_back (std::move (c));
+
+    cases.push_back (createSynthesiserCase (16));
+    cases.push_back (createGraphCase (8));
+    cases.push_back (createGraphCase (64));
+    cases.push_back (createReaderCase<WavAudioFormat> ("WavAudioFormat reader 24-bit", 24, 64));
+
+   #if JUCE_USE_FLAC
+    cases.push_back (createReaderCase<FlacAudioFormat> ("FlacAudioFormat reader 24-bit", 24, 8));
+   #endif
+
+    return cases;
+}
+
+} // namespace Benchmarks
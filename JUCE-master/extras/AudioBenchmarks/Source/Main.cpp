@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BenchmarkHarness.h"
+#include "Benchmarks.h"
+
+//==============================================================================
+static Array<int> parseIntList (const String& text)
+{
+    Array<int> values;
+
+    for (auto& token : StringArray::fromTokens (text, ",", {}))
+        if (token.trim().getIntValue() > 0)
+            values.add (token.trim().getIntValue());
+
+    return values;
+}
+
+static String formatResult (const BenchmarkResult& r)
+{
+    return r.name.paddedRight (' ', 40)
+         + String (r.blockSize).paddedLeft (' ', 7)
+         + String (r.numChannels).paddedLeft (' ', 5)
+         + String (r.nsPerSample, 3).paddedLeft (' ', 12)
+         + (" +/- " + String (r.confidenceInterval, 3)).paddedRight (' ', 14);
+}
+
+//==============================================================================
+int main (int argc, char** argv)
+{
+    ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << argv[0] << " [--help|-h] [--list] [--filter=text] [--block-sizes=64,256,1024] [--channels=1,2,8]" << std::endl
+                  << "    [--runs=20] [--output=results.json] [--baseline=results.json] [--tolerance=5]" << std::endl << std::endl
+                  << "Times each benchmark in nanoseconds per sample per channel, with a 95% confidence interval." << std::endl
+                  << "When a baseline is given, returns a non-zero exit code if any result is slower than its" << std::endl
+                  << "baseline by more than the tolerance percentage and the measurement uncertainty." << std::endl;
+        return 0;
+    }
+
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const auto cases = Benchmarks::createAllCases();
+
+    if (args.containsOption ("--list"))
+    {
+        for (auto& c : cases)
+            std::cout << c.name << std::endl;
+
+        return 0;
+    }
+
+    const auto filter     = args.getValueForOption ("--filter");
+    const auto blockSizes = parseIntList (args.containsOption ("--block-sizes") ? args.getValueForOption ("--block-sizes") : "64,256,1024");
+    const auto channels   = parseIntList (args.containsOption ("--channels")    ? args.getValueForOption ("--channels")    : "1,2,8");
+    const auto tolerance  = args.containsOption ("--tolerance") ? args.getValueForOption ("--tolerance").getDoubleValue() : 5.0;
+
+    BenchmarkHarness::Options options;
+
+    if (args.containsOption ("--runs"))
+        options.numRuns = jmax (1, args.getValueForOption ("--runs").getIntValue());
+
+    std::map<String, BenchmarkResult> baseline;
+
+    if (args.containsOption ("--baseline"))
+    {
+        const auto file = args.getFileForOption ("--baseline");
+        const auto json = JSON::parse (file);
+
+        if (json.isVoid())
+        {
+            std::cerr << "Couldn't read the baseline file " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        for (auto& r : BenchmarkHarness::fromJSON (json))
+            baseline[r.getKey()] = r;
+    }
+
+    std::cout << String ("Benchmark").paddedRight (' ', 40) << "  block   ch     ns/sample" << std::endl;
+
+    BenchmarkHarness harness (options);
+    std::vector<BenchmarkResult> results;
+    int numRegressions = 0;
+
+    for (auto& c : cases)
+    {
+        if (filter.isNotEmpty() && ! c.name.containsIgnoreCase (filter))
+            continue;
+
+        for (auto numChannels : channels)
+        {
+            for (auto blockSize : blockSizes)
+            {
+                BenchmarkConfig config;
+                config.blockSize = blockSize;
+                config.numChannels = numChannels;
+
+                auto result = harness.run (c, config);
+
+                if (! result.has_value())
+                    continue;
+
+                auto line = formatResult (*result);
+                auto previous = baseline.find (result->getKey());
+
+                if (previous != baseline.end())
+                {
+                    const auto& old = previous->second;
+                    line << String (100.0 * (result->nsPerSample - old.nsPerSample) / old.nsPerSample, 1).paddedLeft (' ', 8) << "%";
+
+                    if (BenchmarkHarness::isRegression (*result, old, tolerance))
+                    {
+                        line << "  REGRESSION";
+                        ++numRegressions;
+                    }
+                }
+
+                std::cout << line << std::endl;
+                results.push_back (*result);
+            }
+        }
+    }
+
+    if (args.containsOption ("--output"))
+    {
+        const auto file = args.getFileForOption ("--output");
+
+        if (! file.replaceWithText (JSON::toString (BenchmarkHarness::toJSON (results))))
+        {
+            std::cerr << "Couldn't write to " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    if (numRegressions > 0)
+    {
+        std::cout << std::endl << numRegressions << " benchmark" << (numRegressions > 1 ? "s" : "") << " regressed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
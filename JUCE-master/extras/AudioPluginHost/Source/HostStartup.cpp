@@ -35,6 +35,7 @@
 #include <JuceHeader.h>
 #include "UI/MainHostWindow.h"
 #include "Plugins/InternalPlugins.h"
+#include "Plugins/OfflineRenderer.h"
 
 #if ! (JUCE_PLUGINHOST_VST || JUCE_PLUGINHOST_VST3 || JUCE_PLUGINHOST_AU)
  #error "If you're building the audio plugin host, you probably want to enable VST and/or AU support"
@@ -163,6 +164,13 @@ public:
         appProperties.reset (new ApplicationProperties());
         appProperties->setStorageParameters (options);
 
+        if (OfflineRenderer::isRenderCommand (getCommandLineParameterArray()))
+        {
+            setApplicationReturnValue (OfflineRenderer::runFromCommandLine (getCommandLineParameterArray()));
+            quit();
+            return;
+        }
+
         mainWindow.reset (new MainHostWindow());
 
         commandManager.registerAllCommandsForTarget (this);
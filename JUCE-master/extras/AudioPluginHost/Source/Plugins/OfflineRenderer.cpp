@@ -0,0 +1,371 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../UI/MainHostWindow.h"
+#include "InternalPlugins.h"
+#include "OfflineRenderer.h"
+
+//==============================================================================
+static std::unique_ptr<AudioFormatWriter> createWavWriter (const File& file, double sampleRate,
+                                                           int numChannels, int bitsPerSample)
+{
+    file.deleteFile();
+
+    auto stream = file.createOutputStream();
+
+    if (stream == nullptr)
+        return nullptr;
+
+    std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (stream.get(), sampleRate,
+                                                                                 (unsigned int) numChannels,
+                                                                                 bitsPerSample, {}, 0));
+
+    if (writer != nullptr)
+        stream.release();
+
+    return writer;
+}
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer (AudioPluginFormatManager& fm, KnownPluginList& kpl)
+    : formatManager (fm), knownPlugins (kpl)
+{
+    audioFormatManager.registerBasicFormats();
+}
+
+Result OfflineRenderer::render (const Array<File>& graphFiles, const Options& options)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto sampleRate = options.sampleRate;
+    auto length = (int64) (options.lengthInSeconds * sampleRate);
+    int numInputChannels = 0;
+
+    if (options.inputFile != File())
+    {
+        std::unique_ptr<AudioFormatReader> reader (audioFormatManager.createReaderFor (options.inputFile));
+
+        if (reader == nullptr)
+            return Result::fail ("Couldn't read the input file " + options.inputFile.getFullPathName());
+
+        sampleRate = reader->sampleRate;
+        length = reader->lengthInSamples;
+        numInputChannels = (int) reader->numChannels;
+    }
+
+    if (length <= 0)
+        return Result::fail ("There's nothing to render: give an input file or a length");
+
+    if (! options.outputDirectory.createDirectory())
+        return Result::fail ("Couldn't create the output directory " + options.outputDirectory.getFullPathName());
+
+    // Graphs have to be loaded and prepared on the message thread, so do that for every
+    // segment before any rendering starts
+    const auto numSegments = jmax (1, options.numSegments);
+    OwnedArray<Segment> segments;
+
+    for (auto& graphFile : graphFiles)
+    {
+        const auto outputFile = options.outputDirectory.getChildFile (graphFile.getFileNameWithoutExtension() + ".wav");
+
+        for (int i = 0; i < numSegments; ++i)
+        {
+            auto* segment = segments.add (new Segment());
+            segment->outputFile = numSegments == 1 ? outputFile
+                                                   : outputFile.getSiblingFile (outputFile.getFileNameWithoutExtension() + ".part" + String (i) + ".wav");
+            segment->startSample = length * i / numSegments;
+            segment->endSample = length * (i + 1) / numSegments;
+
+            String error;
+            segment->graph = loadGraph (graphFile, sampleRate, numInputChannels, options, error);
+
+            if (segment->graph == nullptr)
+                return Result::fail (graphFile.getFileName() + ": " + error);
+        }
+    }
+
+    numSamplesRendered = 0;
+    const auto totalSamples = length * graphFiles.size();
+    const auto startTime = Time::getMillisecondCounterHiRes();
+
+    {
+        ThreadPool pool (ThreadPoolOptions{}.withThreadName ("Offline render")
+                                            .withNumberOfThreads (jmax (1, options.numThreads)));
+
+        for (auto* segment : segments)
+            pool.addJob ([this, segment, &options, sampleRate, numInputChannels]
+                         {
+                             renderSegment (*segment, options, sampleRate, numInputChannels);
+                         });
+
+        for (auto lastReport = startTime; pool.getNumJobs() > 0;)
+        {
+            Thread::sleep (50);
+
+            if (Time::getMillisecondCounterHiRes() - lastReport >= 1000.0)
+            {
+                lastReport = Time::getMillisecondCounterHiRes();
+                std::cout << "Rendered " << String (100.0 * (double) numSamplesRendered.load() / (double) totalSamples, 1) << "%" << std::endl;
+            }
+        }
+    }
+
+    const auto elapsedSeconds = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    for (auto* segment : segments)
+        if (segment->error.isNotEmpty())
+            return Result::fail (segment->error);
+
+    if (numSegments > 1)
+    {
+        for (int i = 0; i < graphFiles.size(); ++i)
+        {
+            const auto outputFile = segments[i * numSegments]->outputFile.getSiblingFile (graphFiles[i].getFileNameWithoutExtension() + ".wav");
+            auto writer = createWavWriter (outputFile, sampleRate, options.numOutputChannels, options.bitsPerSample);
+
+            if (writer == nullptr)
+                return Result::fail ("Couldn't write to " + outputFile.getFullPathName());
+
+            for (int j = 0; j < numSegments; ++j)
+            {
+                const auto partFile = segments[i * numSegments + j]->outputFile;
+                std::unique_ptr<AudioFormatReader> reader (audioFormatManager.createReaderFor (partFile));
+
+                if (reader == nullptr || ! writer->writeFromAudioReader (*reader, 0, -1))
+                    return Result::fail ("Couldn't join the segments of " + outputFile.getFullPathName());
+
+                reader = nullptr;
+                partFile.deleteFile();
+            }
+        }
+    }
+
+    // Pre-roll isn't counted, so this is the rate at which usable output was produced
+    const auto audioSeconds = (double) totalSamples / sampleRate;
+
+    std::cout << "Rendered " << String (audioSeconds, 1) << " seconds of audio from " << graphFiles.size()
+              << (graphFiles.size() == 1 ? " graph" : " graphs") << " in " << String (elapsedSeconds, 2)
+              << " seconds (" << String (audioSeconds / jmax (elapsedSeconds, 1.0e-6), 1) << "x realtime)" << std::endl;
+
+    return Result::ok();
+}
+
+std::unique_ptr<AudioProcessorGraph> OfflineRenderer::loadGraph (const File& file, double sampleRate, int numInputChannels,
+                                                                 const Options& options, String& error)
+{
+    using NodeID = AudioProcessorGraph::NodeID;
+
+    auto xml = parseXMLIfTagMatches (file, "FILTERGRAPH");
+
+    if (xml == nullptr)
+    {
+        error = "Not a valid graph file";
+        return nullptr;
+    }
+
+    auto graph = std::make_unique<AudioProcessorGraph>();
+    graph->setPlayConfigDetails (numInputChannels, options.numOutputChannels, sampleRate, options.blockSize);
+
+    for (auto* e : xml->getChildWithTagNameIterator ("FILTER"))
+    {
+        auto instance = PluginGraph::createInstanceFromXml (*e, formatManager, knownPlugins, sampleRate, options.blockSize);
+
+        if (instance == nullptr)
+        {
+            PluginDescription description;
+
+            for (auto* child : e->getChildIterator())
+                if (description.loadFromXml (*child))
+                    break;
+
+            error = "Couldn't create the plugin \"" + description.name + "\"";
+            return nullptr;
+        }
+
+        if (auto node = graph->addNode (std::move (instance), NodeID ((uint32) e->getIntAttribute ("uid"))))
+        {
+            if (auto* state = e->getChildByName ("STATE"))
+            {
+                MemoryBlock m;
+                m.fromBase64Encoding (state->getAllSubText());
+
+                node->getProcessor()->setStateInformation (m.getData(), (int) m.getSize());
+            }
+        }
+    }
+
+    for (auto* e : xml->getChildWithTagNameIterator ("CONNECTION"))
+    {
+        graph->addConnection ({ { NodeID ((uint32) e->getIntAttribute ("srcFilter")), e->getIntAttribute ("srcChannel") },
+                                { NodeID ((uint32) e->getIntAttribute ("dstFilter")), e->getIntAttribute ("dstChannel") } });
+    }
+
+    graph->removeIllegalConnections();
+    graph->setNonRealtime (true);
+    graph->prepareToPlay (sampleRate, options.blockSize);
+
+    return graph;
+}
+
+void OfflineRenderer::renderSegment (Segment& segment, const Options& options, double sampleRate, int numInputChannels)
+{
+    auto writer = createWavWriter (segment.outputFile, sampleRate, options.numOutputChannels, options.bitsPerSample);
+
+    if (writer == nullptr)
+    {
+        segment.error = "Couldn't write to " + segment.outputFile.getFullPathName();
+        return;
+    }
+
+    std::unique_ptr<AudioFormatReader> reader;
+
+    if (numInputChannels > 0)
+        reader.reset (audioFormatManager.createReaderFor (options.inputFile));
+
+    auto& graph = *segment.graph;
+
+    // The output for input sample n appears at n + latency, so the input is run on past the
+    // end of the segment by the latency, and the first latency samples of output are skipped
+    const auto latency = (int64) graph.getLatencySamples();
+    const auto preRoll = segment.startSample > 0 ? (int64) (options.preRollSeconds * sampleRate) : 0;
+    const auto endPosition = segment.endSample + latency;
+
+    AudioBuffer<float> buffer (jmax (numInputChannels, options.numOutputChannels), options.blockSize);
+    MidiBuffer midi;
+
+    for (auto position = jmax ((int64) 0, segment.startSample - preRoll); position < endPosition;)
+    {
+        const auto numSamples = (int) jmin ((int64) options.blockSize, endPosition - position);
+        buffer.clear();
+
+        if (reader != nullptr)
+        {
+            AudioBuffer<float> input (buffer.getArrayOfWritePointers(), numInputChannels, numSamples);
+            reader->read (&input, 0, numSamples, position, true, true);
+        }
+
+        AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+        midi.clear();
+        graph.processBlock (block, midi);
+
+        const auto outputStart = position - latency;
+        const auto first = (int) jlimit ((int64) 0, (int64) numSamples, segment.startSample - outputStart);
+        const auto last  = (int) jlimit ((int64) 0, (int64) numSamples, segment.endSample - outputStart);
+
+        if (last > first)
+        {
+            AudioBuffer<float> output (buffer.getArrayOfWritePointers(), options.numOutputChannels, first, last - first);
+
+            if (! writer->writeFromAudioSampleBuffer (output, 0, last - first))
+            {
+                segment.error = "Couldn't write to " + segment.outputFile.getFullPathName();
+                return;
+            }
+
+            numSamplesRendered += last - first;
+        }
+
+        position += numSamples;
+    }
+}
+
+//==============================================================================
+bool OfflineRenderer::isRenderCommand (const StringArray& commandLineParameters)
+{
+    return ArgumentList ("AudioPluginHost", commandLineParameters).containsOption ("--render");
+}
+
+int OfflineRenderer::runFromCommandLine (const StringArray& commandLineParameters)
+{
+    ArgumentList args ("AudioPluginHost", commandLineParameters);
+
+    Array<File> graphFiles;
+
+    for (auto& arg : args.arguments)
+        if (! arg.isOption())
+            graphFiles.add (arg.resolveAsFile());
+
+    if (graphFiles.isEmpty())
+    {
+        std::cout << "AudioPluginHost --render graph.filtergraph [more graphs...] [--input=input.wav | --length=seconds]" << std::endl
+                  << "    [--sample-rate=44100] [--output-dir=dir] [--channels=2] [--bits=24] [--block-size=512]" << std::endl
+                  << "    [--segments=1] [--threads=numCpus] [--pre-roll=2]" << std::endl << std::endl
+                  << "Renders each graph to a WAV file in the output directory, without using an audio device." << std::endl
+                  << "The graphs, and the segments each one is split into, are rendered in parallel." << std::endl;
+        return 1;
+    }
+
+    const auto getOption = [&args] (StringRef option, auto defaultValue)
+    {
+        return args.containsOption (option) ? static_cast<decltype (defaultValue)> (args.getValueForOption (option).getDoubleValue())
+                                            : defaultValue;
+    };
+
+    Options options;
+
+    if (args.containsOption ("--input"))
+        options.inputFile = args.getFileForOption ("--input");
+
+    options.outputDirectory   = args.containsOption ("--output-dir") ? args.getFileForOption ("--output-dir")
+                                                                     : File::getCurrentWorkingDirectory();
+    options.lengthInSeconds   = getOption ("--length",      options.lengthInSeconds);
+    options.sampleRate        = getOption ("--sample-rate", options.sampleRate);
+    options.numOutputChannels = jmax (1, getOption ("--channels",   options.numOutputChannels));
+    options.bitsPerSample     = getOption ("--bits",        options.bitsPerSample);
+    options.blockSize         = jmax (1, getOption ("--block-size", options.blockSize));
+    options.numSegments       = jmax (1, getOption ("--segments",   options.numSegments));
+    options.numThreads        = jmax (1, getOption ("--threads",    options.numThreads));
+    options.preRollSeconds    = jmax (0.0, getOption ("--pre-roll", options.preRollSeconds));
+
+    AudioPluginFormatManager pluginFormatManager;
+    pluginFormatManager.addDefaultFormats();
+    pluginFormatManager.addFormat (new InternalPluginFormat());
+
+    KnownPluginList knownPluginList;
+
+    if (auto savedPluginList = getAppProperties().getUserSettings()->getXmlValue ("pluginList"))
+        knownPluginList.recreateFromXml (*savedPluginList);
+
+    OfflineRenderer renderer (pluginFormatManager, knownPluginList);
+    const auto result = renderer.render (graphFiles, options);
+
+    if (result.failed())
+    {
+        std::cerr << result.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Renders saved graphs without an audio device, as fast as the CPU allows.
+
+    Each graph is loaded from its .filtergraph file, switched to non-realtime mode and
+    driven from an audio file (or from silence), and its output is written to a WAV file.
+    A graph can also be split into time segments: every graph and segment gets its own
+    copy of the graph, and all of them are rendered in parallel on a pool of threads.
+
+    Segments after the first start rendering a little early, and that pre-roll is
+    discarded, so that reverb tails and other state have time to build up before the
+    part of the output that's kept.
+*/
+class OfflineRenderer
+{
+public:
+    //==============================================================================
+    struct Options
+    {
+        /** The file to feed into the graphs' audio inputs. If this is File(), the graphs
+            are fed silence for lengthInSeconds at the given sample rate instead.
+        */
+        File inputFile;
+        double lengthInSeconds = 0.0, sampleRate = 44100.0;
+
+        /** Each graph is rendered to a WAV file with the same name in this directory. */
+        File outputDirectory;
+        int numOutputChannels = 2, bitsPerSample = 24;
+
+        int blockSize = 512;
+        int numSegments = 1;
+        int numThreads = SystemStats::getNumCpus();
+        double preRollSeconds = 2.0;
+    };
+
+    OfflineRenderer (AudioPluginFormatManager&, KnownPluginList&);
+
+    /** Renders each of the graph files, returning an error if any of them failed.
+        This must be called on the message thread, which it blocks until it's finished.
+    */
+    Result render (const Array<File>& graphFiles, const Options&);
+
+    //==============================================================================
+    /** Returns true if the command line asks the host to render rather than open a window. */
+    static bool isRenderCommand (const StringArray& commandLineParameters);
+
+    /** Parses the options from the command line, renders, and returns the process exit code. */
+    static int runFromCommandLine (const StringArray& commandLineParameters);
+
+private:
+    //==============================================================================
+    struct Segment
+    {
+        File outputFile;
+        int64 startSample = 0, endSample = 0;
+        std::unique_ptr<AudioProcessorGraph> graph;
+        String error;
+    };
+
+    std::unique_ptr<AudioProcessorGraph> loadGraph (const File&, double sampleRate, int numInputChannels,
+                                                    const Options&, String& error);
+    void renderSegment (Segment&, const Options&, double sampleRate, int numInputChannels);
+
+    AudioPluginFormatManager& formatManager;
+    KnownPluginList& knownPlugins;
+    AudioFormatManager audioFormatManager;
+    std::atomic<int64> numSamplesRendered { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (OfflineRenderer)
+};
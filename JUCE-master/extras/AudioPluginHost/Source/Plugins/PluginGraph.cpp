@@ -392,7 +392,11 @@ static XmlElement* createNodeXml (AudioProcessorGraph::Node* const node) noexcep
     return nullptr;
 }
 
-void PluginGraph::createNodeFromXml (const XmlElement& xml)
+std::unique_ptr<AudioPluginInstance> PluginGraph::createInstanceFromXml (const XmlElement& xml,
+                                                                       AudioPluginFormatManager& fm,
+                                                                       KnownPluginList& kpl,
+                                                                       double sampleRate,
+                                                                       int blockSize)
 {
     PluginDescriptionAndPreference pd;
     const auto nodeUsesARA = xml.getBoolAttribute ("useARA");
@@ -409,16 +413,16 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
 
     auto createInstanceWithFallback = [&]() -> std::unique_ptr<AudioPluginInstance>
     {
-        auto createInstance = [this] (const PluginDescriptionAndPreference& description) -> std::unique_ptr<AudioPluginInstance>
+        auto createInstance = [&] (const PluginDescriptionAndPreference& description) -> std::unique_ptr<AudioPluginInstance>
         {
             String errorMessage;
 
             auto localDpiDisabler = makeDPIAwarenessDisablerForPlugin (description.pluginDescription);
 
-            auto instance = formatManager.createPluginInstance (description.pluginDescription,
-                                                                graph.getSampleRate(),
-                                                                graph.getBlockSize(),
-                                                                errorMessage);
+            auto instance = fm.createPluginInstance (description.pluginDescription,
+                                                     sampleRate,
+                                                     blockSize,
+                                                     errorMessage);
 
            #if JUCE_PLUGINHOST_ARA && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX)
             if (instance
@@ -435,14 +439,14 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
         if (auto instance = createInstance (pd))
             return instance;
 
-        const auto allFormats = formatManager.getFormats();
+        const auto allFormats = fm.getFormats();
         const auto matchingFormat = std::find_if (allFormats.begin(), allFormats.end(),
                                                   [&] (const AudioPluginFormat* f) { return f->getName() == pd.pluginDescription.pluginFormatName; });
 
         if (matchingFormat == allFormats.end())
             return nullptr;
 
-        const auto plugins = knownPlugins.getTypesForFormat (**matchingFormat);
+        const auto plugins = kpl.getTypesForFormat (**matchingFormat);
         const auto matchingPlugin = std::find_if (plugins.begin(), plugins.end(),
                                                   [&] (const PluginDescription& desc) { return pd.pluginDescription.uniqueId == desc.uniqueId; });
 
@@ -452,7 +456,9 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
         return createInstance (PluginDescriptionAndPreference { *matchingPlugin });
     };
 
-    if (auto instance = createInstanceWithFallback())
+    auto instance = createInstanceWithFallback();
+
+    if (instance != nullptr)
     {
         if (auto* layoutEntity = xml.getChildByName ("LAYOUT"))
         {
@@ -463,7 +469,15 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
 
             instance->setBusesLayout (layout);
         }
+    }
+
+    return instance;
+}
 
+void PluginGraph::createNodeFromXml (const XmlElement& xml)
+{
+    if (auto instance = createInstanceFromXml (xml, formatManager, knownPlugins, graph.getSampleRate(), graph.getBlockSize()))
+    {
         if (auto node = graph.addNode (std::move (instance), NodeID ((uint32) xml.getIntAttribute ("uid"))))
         {
             if (auto* state = xml.getChildByName ("STATE"))
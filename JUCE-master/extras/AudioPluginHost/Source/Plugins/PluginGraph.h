@@ -98,6 +98,15 @@ public:
     std::unique_ptr<XmlElement> createXml() const;
     void restoreFromXml (const XmlElement&);
 
+    /** Creates the plugin described by a FILTER element of a saved graph, and restores its
+        bus layout. Returns nullptr if the plugin can't be created.
+    */
+    static std::unique_ptr<AudioPluginInstance> createInstanceFromXml (const XmlElement&,
+                                                                       AudioPluginFormatManager&,
+                                                                       KnownPluginList&,
+                                                                       double sampleRate,
+                                                                       int blockSize);
+
     static const char* getFilenameSuffix()      { return ".filtergraph"; }
     static const char* getFilenameWildcard()    { return "*.filtergraph"; }
 
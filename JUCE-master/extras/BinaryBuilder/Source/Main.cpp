@@ -44,16 +44,21 @@
 */
 
 #include <JuceHeader.h>
+#include "../../Build/juce_build_tools/utils/juce_CompressedResources.h"
 
 
 //==============================================================================
 static int addFile (const File& file,
                     const String& classname,
                     OutputStream& headerStream,
-                    OutputStream& cppStream)
+                    OutputStream& cppStream,
+                    bool compress)
 {
-    MemoryBlock mb;
-    file.loadFileAsData (mb);
+    MemoryBlock original, compressed;
+    file.loadFileAsData (original);
+
+    const bool isCompressed = compress && build_tools::compressResourceData (original, compressed);
+    const MemoryBlock& mb = isCompressed ? compressed : original;
 
     const String name (file.getFileName()
                            .replaceCharacter (' ', '_')
@@ -61,11 +66,16 @@ static int addFile (const File& file,
                            .retainCharacters ("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz_0123456789"));
 
     std::cout << "Adding " << name << ": "
-              << (int) mb.getSize() << " bytes" << std::endl;
+              << (int) original.getSize() << " bytes";
+
+    if (isCompressed)
+        std::cout << " (compressed to " << (int) compressed.getSize() << ")";
 
-    headerStream << "    extern const char*  " << name << ";\r\n"
+    std::cout << std::endl;
+
+    headerStream << (compress ? "    extern const LazyResource  " : "    extern const char*  ") << name << ";\r\n"
                     "    const int           " << name << "Size = "
-                 << (int) mb.getSize() << ";\r\n\r\n";
+                 << (int) original.getSize() << ";\r\n\r\n";
 
     static int tempNum = 0;
 
@@ -86,12 +96,21 @@ static int addFile (const File& file,
 
     cppStream << (int) data[i] << ",0,0};\r\n";
 
-    cppStream << "const char* " << classname << "::" << name
-              << " = (const char*) temp" << tempNum << ";\r\n\r\n";
+    if (compress)
+        cppStream << "const " << classname << "::LazyResource " << classname << "::" << name
+                  << " { temp" << tempNum << ", " << (int) mb.getSize() << ", " << (int) original.getSize() << ", { nullptr } };\r\n\r\n";
+    else
+        cppStream << "const char* " << classname << "::" << name
+                  << " = (const char*) temp" << tempNum << ";\r\n\r\n";
 
     return (int) mb.getSize();
 }
 
+static String withCrLf (const char* text)
+{
+    return StringArray::fromLines (text).joinIntoString ("\r\n") + "\r\n";
+}
+
 static bool isHiddenFile (const File& f, const File& root)
 {
     return f.getFileName().endsWithIgnoreCase (".scc")
@@ -107,21 +126,29 @@ int main (int argc, char* argv[])
 {
     std::cout << std::endl << " BinaryBuilder!  Visit www.juce.com for more info." << std::endl;
 
+    StringArray arguments (argv, argc);
+    const bool compress = arguments.contains ("--compress");
+    arguments.removeString ("--compress");
+    argc = arguments.size();
+
     if (argc < 4 || argc > 5)
     {
-        std::cout << " Usage: BinaryBuilder  sourcedirectory targetdirectory targetclassname [optional wildcard pattern]\n\n"
+        std::cout << " Usage: BinaryBuilder  sourcedirectory targetdirectory targetclassname [optional wildcard pattern] [--compress]\n\n"
                      " BinaryBuilder will find all files in the source directory, and encode them\n"
                      " into two files called (targetclassname).cpp and (targetclassname).h, which it\n"
                      " will write into the target directory supplied.\n\n"
                      " Any files in sub-directories of the source directory will be put into the\n"
                      " resultant class, but #ifdef'ed out using the name of the sub-directory (hard to\n"
-                     " explain, but obvious when you try it...)\n";
+                     " explain, but obvious when you try it...)\n\n"
+                     " With --compress, files that compress well are stored deflated, and are decoded\n"
+                     " the first time they're used. The variables then have the type LazyResource,\n"
+                     " which converts to a const char* pointing at the decoded data.\n";
 
         return 0;
     }
 
     const File sourceDirectory (File::getCurrentWorkingDirectory()
-                                     .getChildFile (String (argv[1]).unquoted()));
+                                     .getChildFile (arguments[1].unquoted()));
 
     if (! sourceDirectory.isDirectory())
     {
@@ -133,7 +160,7 @@ int main (int argc, char* argv[])
     }
 
     const File destDirectory (File::getCurrentWorkingDirectory()
-                                   .getChildFile (String (argv[2]).unquoted()));
+                                   .getChildFile (arguments[2].unquoted()));
 
     if (! destDirectory.isDirectory())
     {
@@ -143,7 +170,7 @@ int main (int argc, char* argv[])
         return 0;
     }
 
-    String className (argv[3]);
+    String className (arguments[3]);
     className = className.trim();
 
     const File headerFile (destDirectory.getChildFile (className).withFileExtension (".h"));
@@ -155,7 +182,7 @@ int main (int argc, char* argv[])
               << "..." << std::endl << std::endl;
 
     auto files = sourceDirectory.findChildFiles (File::findFiles, true,
-                                                 (argc > 4) ? argv[4] : "*");
+                                                 (argc > 4) ? arguments[4] : "*");
 
     if (files.isEmpty())
     {
@@ -186,12 +213,31 @@ int main (int argc, char* argv[])
     }
 
     *header << "/* (Auto-generated binary data file). */\r\n\r\n"
-               "#pragma once\r\n\r\n"
-               "namespace " << className << "\r\n"
+               "#pragma once\r\n\r\n";
+
+    if (compress)
+        *header << "#include <atomic>\r\n\r\n";
+
+    *header << "namespace " << className << "\r\n"
                "{\r\n";
 
-    *cpp << "/* (Auto-generated binary data file). */\r\n\r\n"
-            "#include \"" << className << ".h\"\r\n\r\n";
+    *cpp << "/* (Auto-generated binary data file). */\r\n\r\n";
+
+    if (compress)
+    {
+        *header << withCrLf (build_tools::getLazyResourceDeclaration()) << "\r\n";
+
+        *cpp << "#include <cstring>\r\n"
+                "#include <new>\r\n";
+    }
+
+    *cpp << "#include \"" << className << ".h\"\r\n\r\n";
+
+    if (compress)
+        *cpp << "namespace " << className << "\r\n"
+                "{\r\n"
+             << withCrLf (build_tools::getLazyResourceImplementation())
+             << "}\r\n\r\n";
 
     int totalBytes = 0;
 
@@ -207,14 +253,14 @@ int main (int argc, char* argv[])
                 *header << "  #ifdef " << file.getParentDirectory().getFileName().toUpperCase() << "\r\n";
                 *cpp << "#ifdef " << file.getParentDirectory().getFileName().toUpperCase() << "\r\n";
 
-                totalBytes += addFile (file, className, *header, *cpp);
+                totalBytes += addFile (file, className, *header, *cpp, compress);
 
                 *header << "  #endif\r\n";
                 *cpp << "#endif\r\n";
             }
             else
             {
-                totalBytes += addFile (file, className, *header, *cpp);
+                totalBytes += addFile (file, className, *header, *cpp, compress);
             }
         }
     }
@@ -436,7 +436,7 @@ endfunction()
 function(juce_add_binary_data target)
     set(one_value_args NAMESPACE HEADER_NAME)
     set(multi_value_args SOURCES)
-    cmake_parse_arguments(JUCE_ARG "" "${one_value_args}" "${multi_value_args}" ${ARGN})
+    cmake_parse_arguments(JUCE_ARG "COMPRESS" "${one_value_args}" "${multi_value_args}" ${ARGN})
 
     list(LENGTH JUCE_ARG_SOURCES num_binary_files)
 
@@ -478,9 +478,15 @@ function(juce_add_binary_data target)
     set(input_file_list "${juce_binary_data_folder}/input_file_list")
     file(WRITE "${input_file_list}" "${newline_delimited_input}")
 
+    set(compress_flag)
+
+    if(JUCE_ARG_COMPRESS)
+        set(compress_flag --compress)
+    endif()
+
     add_custom_command(OUTPUT ${binary_file_names}
         COMMAND juce::juceaide binarydata "${JUCE_ARG_NAMESPACE}" "${JUCE_ARG_HEADER_NAME}"
-            ${juce_binary_data_folder} "${input_file_list}"
+            ${juce_binary_data_folder} "${input_file_list}" ${compress_flag}
         WORKING_DIRECTORY ${CMAKE_CURRENT_LIST_DIR}
         DEPENDS "${input_file_list}" ${JUCE_ARG_SOURCES}
         VERBATIM)
@@ -66,6 +66,7 @@
 
 #include "utils/juce_ProjectType.h"
 #include "utils/juce_BuildHelperFunctions.h"
+#include "utils/juce_CompressedResources.h"
 #include "utils/juce_BinaryResourceFile.h"
 #include "utils/juce_RelativePath.h"
 #include "utils/juce_Icons.h"
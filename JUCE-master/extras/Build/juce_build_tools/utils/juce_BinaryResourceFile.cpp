@@ -87,15 +87,30 @@ namespace juce::build_tools
            << newLine;
     }
 
+    static void writeLines (MemoryOutputStream& mo, const char* text)
+    {
+        // The output stream's newLine string has to be used to get the project's line endings
+        for (auto& line : StringArray::fromLines (text))
+            mo << line << newLine;
+    }
+
     Result ResourceFile::writeHeader (MemoryOutputStream& header)
     {
         header << "/* =========================================================================================";
         writeComment (header);
         header << "#pragma once" << newLine
-               << newLine
-               << "namespace " << className << newLine
+               << newLine;
+
+        if (compress)
+            header << "#include <atomic>" << newLine
+                   << newLine;
+
+        header << "namespace " << className << newLine
                << "{" << newLine;
 
+        if (compress)
+            writeLines (header, getLazyResourceDeclaration());
+
         for (int i = 0; i < files.size(); ++i)
         {
             auto& file = files.getReference (i);
@@ -111,7 +126,7 @@ namespace juce::build_tools
 
             if (fileStream.openedOk())
             {
-                header << "    extern const char*   " << variableName << ";" << newLine;
+                header << (compress ? "    extern const LazyResource   " : "    extern const char*   ") << variableName << ";" << newLine;
                 header << "    const int            " << variableName << "Size = " << (int) dataSize << ";" << newLine << newLine;
             }
         }
@@ -143,11 +158,20 @@ namespace juce::build_tools
 
         cpp << "/* ==================================== " << resourceFileIdentifierString << " ====================================";
         writeComment (cpp);
-        cpp << "#include <cstring>" << newLine
-            << newLine
+        cpp << "#include <cstring>" << newLine;
+
+        // Every file needs the declaration of LazyResource, and one of them needs its implementation
+        if (compress)
+            cpp << "#include <new>" << newLine
+                << "#include \"" << headerFile.getFileName() << "\"" << newLine;
+
+        cpp << newLine
             << "namespace " << className << newLine
             << "{" << newLine;
 
+        if (compress && isFirstFile)
+            writeLines (cpp, getLazyResourceImplementation());
+
         while (i < files.size())
         {
             auto& file = files.getReference (i);
@@ -162,14 +186,19 @@ namespace juce::build_tools
                 cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
                      << "static const unsigned char " << tempVariable << "[] =" << newLine;
 
-                {
-                    MemoryBlock data;
-                    fileStream.readIntoMemoryBlock (data);
-                    writeDataAsCppLiteral (data, cpp, true, true);
-                }
+                MemoryBlock data, compressed;
+                fileStream.readIntoMemoryBlock (data);
+
+                const auto& storedData = compress && compressResourceData (data, compressed) ? compressed : data;
+                writeDataAsCppLiteral (storedData, cpp, true, true);
+
+                cpp << newLine << newLine;
 
-                cpp << newLine << newLine
-                    << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
+                if (compress)
+                    cpp << "const LazyResource " << variableName << " { " << tempVariable << ", "
+                        << (int) storedData.getSize() << ", " << (int) data.getSize() << ", { nullptr } };" << newLine;
+                else
+                    cpp << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
             }
 
             ++i;
@@ -180,7 +209,7 @@ namespace juce::build_tools
 
         if (isFirstFile)
         {
-            if (i < files.size())
+            if (i < files.size() && ! compress)
             {
                 cpp << newLine
                     << "}" << newLine
@@ -44,6 +44,14 @@ namespace juce::build_tools
 
         String getClassName() const { return className; }
 
+        /*  If this is enabled, resources that compress well are stored compressed, and are
+            decoded the first time they're used. The generated variables then have the type
+            LazyResource rather than const char*, but can be used in the same way.
+        */
+        void setCompressionEnabled (bool shouldCompress) { compress = shouldCompress; }
+
+        bool isCompressionEnabled() const { return compress; }
+
         void addFile (const File& file);
 
         String getDataVariableFor (const File& file) const;
@@ -71,6 +79,7 @@ namespace juce::build_tools
         Array<File> files;
         StringArray variableNames;
         String className { "BinaryData" };
+        bool compress = false;
 
         Result writeHeader (MemoryOutputStream&);
 
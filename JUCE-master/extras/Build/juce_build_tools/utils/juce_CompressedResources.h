@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::build_tools
+{
+
+    /*  Compresses the data for a binary resource with raw deflate. Returns false if the data
+        doesn't shrink by enough to be worth decoding at runtime, in which case it should be
+        stored as it is.
+    */
+    inline bool compressResourceData (const MemoryBlock& source, MemoryBlock& compressed)
+    {
+        compressed.reset();
+
+        {
+            MemoryOutputStream out (compressed, false);
+            GZIPCompressorOutputStream zipper (out, 9, GZIPCompressorOutputStream::windowBitsRaw);
+            zipper.write (source.getData(), source.getSize());
+        }
+
+        return compressed.getSize() < source.getSize() - source.getSize() / 10;
+    }
+
+    /*  Generated headers declare resources that may be compressed with this type, which can be
+        used anywhere that the usual const char* could.
+    */
+    inline const char* getLazyResourceDeclaration()
+    {
+        return R"(    // A resource that may be stored compressed. It converts to a pointer to its data, which is
+    // decoded the first time it's needed and then kept for the lifetime of the program.
+    // Resources that are stored uncompressed are returned directly, without being copied.
+    struct LazyResource
+    {
+        const unsigned char* storedData;
+        int storedSize, size;
+        mutable std::atomic<const char*> decodedData;
+
+        const char* getData() const;
+        operator const char*() const    { return getData(); }
+    };
+)";
+    }
+
+    /*  The implementation of LazyResource::getData(), which must be written into exactly one of
+        the generated .cpp files. It can't depend on JUCE or zlib, because the generated files may
+        be built into a library of their own.
+    */
+    inline const char* getLazyResourceImplementation()
+    {
+        return R"(namespace
+{
+    struct BitReader
+    {
+        const unsigned char* data;
+        size_t size, position = 0;
+        unsigned int bitBuffer = 0;
+        int numBits = 0;
+        bool overrun = false;
+
+        int getBits (int numBitsNeeded)
+        {
+            while (numBits < numBitsNeeded)
+            {
+                unsigned int byte = 0;
+
+                if (position < size)
+                    byte = data[position++];
+                else
+                    overrun = true;
+
+                bitBuffer |= byte << numBits;
+                numBits += 8;
+            }
+
+            const auto result = (int) (bitBuffer & ((1u << numBitsNeeded) - 1u));
+            bitBuffer >>= numBitsNeeded;
+            numBits -= numBitsNeeded;
+            return result;
+        }
+    };
+
+    struct HuffmanTable
+    {
+        short counts[16], symbols[288];
+
+        bool build (const unsigned char* lengths, int numSymbols)
+        {
+            for (auto& c : counts)
+                c = 0;
+
+            for (int i = 0; i < numSymbols; ++i)
+                ++counts[lengths[i]];
+
+            counts[0] = 0;
+
+            for (int length = 1, codesLeft = 1; length < 16; ++length)
+            {
+                codesLeft = (codesLeft << 1) - counts[length];
+
+                if (codesLeft < 0)
+                    return false;
+            }
+
+            short offsets[16] = {};
+
+            for (int length = 1; length < 15; ++length)
+                offsets[length + 1] = (short) (offsets[length] + counts[length]);
+
+            for (int i = 0; i < numSymbols; ++i)
+                if (lengths[i] != 0)
+                    symbols[offsets[lengths[i]]++] = (short) i;
+
+            return true;
+        }
+
+        int decode (BitReader& in) const
+        {
+            for (int length = 1, code = 0, first = 0, index = 0; length < 16; ++length)
+            {
+                code |= in.getBits (1);
+                const int count = counts[length];
+
+                if (code - count < first)
+                    return symbols[index + (code - first)];
+
+                index += count;
+                first = (first + count) << 1;
+                code <<= 1;
+            }
+
+            return -1;
+        }
+    };
+
+    bool inflate (const unsigned char* source, size_t sourceSize, char* dest, size_t destSize)
+    {
+        static const short lengthBases[]   = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const short lengthExtras[]  = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const short distanceBases[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537,
+                                               2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static const short distanceExtras[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        static const unsigned char codeLengthOrder[] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+        BitReader in { source, sourceSize };
+        HuffmanTable lengthCodes, distanceCodes;
+        size_t numWritten = 0;
+
+        for (;;)
+        {
+            const auto isLastBlock = in.getBits (1) != 0;
+            const auto blockType = in.getBits (2);
+
+            if (blockType == 0)
+            {
+                // Stored blocks start on a byte boundary, so drop the rest of the current byte
+                in.bitBuffer = 0;
+                in.numBits = 0;
+
+                if (in.position + 4 > in.size)
+                    return false;
+
+                const auto length = (size_t) (in.data[in.position] | (in.data[in.position + 1] << 8));
+                in.position += 4;
+
+                if (in.position + length > in.size || numWritten + length > destSize)
+                    return false;
+
+                memcpy (dest + numWritten, in.data + in.position, length);
+                in.position += length;
+                numWritten += length;
+            }
+            else if (blockType == 1 || blockType == 2)
+            {
+                unsigned char lengths[320];
+
+                if (blockType == 1)
+                {
+                    for (int i = 0; i < 318; ++i)
+                        lengths[i] = (unsigned char) (i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : i < 288 ? 8 : 5);
+
+                    lengthCodes.build (lengths, 288);
+                    distanceCodes.build (lengths + 288, 30);
+                }
+                else
+                {
+                    const auto numLengths      = in.getBits (5) + 257;
+                    const auto numDistances    = in.getBits (5) + 1;
+                    const auto numCodeLengths  = in.getBits (4) + 4;
+
+                    if (numLengths > 286 || numDistances > 30)
+                        return false;
+
+                    unsigned char codeLengths[19] = {};
+
+                    for (int i = 0; i < numCodeLengths; ++i)
+                        codeLengths[codeLengthOrder[i]] = (unsigned char) in.getBits (3);
+
+                    HuffmanTable codeLengthCodes;
+
+                    if (! codeLengthCodes.build (codeLengths, 19))
+                        return false;
+
+                    for (int i = 0; i < numLengths + numDistances;)
+                    {
+                        const auto symbol = codeLengthCodes.decode (in);
+
+                        if (symbol < 0 || in.overrun)
+                            return false;
+
+                        if (symbol < 16)
+                        {
+                            lengths[i++] = (unsigned char) symbol;
+                            continue;
+                        }
+
+                        unsigned char value = 0;
+                        int repeat = 0;
+
+                        if (symbol == 16)
+                        {
+                            if (i == 0)
+                                return false;
+
+                            value = lengths[i - 1];
+                            repeat = 3 + in.getBits (2);
+                        }
+                        else
+                        {
+                            repeat = symbol == 17 ? 3 + in.getBits (3) : 11 + in.getBits (7);
+                        }
+
+                        if (i + repeat > numLengths + numDistances)
+                            return false;
+
+                        while (--repeat >= 0)
+                            lengths[i++] = value;
+                    }
+
+                    if (! lengthCodes.build (lengths, numLengths) || ! distanceCodes.build (lengths + numLengths, numDistances))
+                        return false;
+                }
+
+                for (;;)
+                {
+                    auto symbol = lengthCodes.decode (in);
+
+                    if (symbol < 0 || in.overrun)
+                        return false;
+
+                    if (symbol < 256)
+                    {
+                        if (numWritten >= destSize)
+                            return false;
+
+                        dest[numWritten++] = (char) symbol;
+                        continue;
+                    }
+
+                    if (symbol == 256)
+                        break;
+
+                    symbol -= 257;
+
+                    if (symbol >= 29)
+                        return false;
+
+                    const auto length = (size_t) (lengthBases[symbol] + in.getBits (lengthExtras[symbol]));
+                    const auto distanceSymbol = distanceCodes.decode (in);
+
+                    if (distanceSymbol < 0 || distanceSymbol >= 30)
+                        return false;
+
+                    const auto distance = (size_t) (distanceBases[distanceSymbol] + in.getBits (distanceExtras[distanceSymbol]));
+
+                    if (distance > numWritten || numWritten + length > destSize)
+                        return false;
+
+                    for (size_t i = 0; i < length; ++i, ++numWritten)
+                        dest[numWritten] = dest[numWritten - distance];
+                }
+            }
+            else
+            {
+                return false;
+            }
+
+            if (in.overrun)
+                return false;
+
+            if (isLastBlock)
+                return numWritten == destSize;
+        }
+    }
+}
+
+const char* LazyResource::getData() const
+{
+    if (storedSize == size)
+        return (const char*) storedData;
+
+    if (auto* existing = decodedData.load (std::memory_order_acquire))
+        return existing;
+
+    auto* decoded = new (std::nothrow) char[(size_t) size + 1];
+
+    if (decoded == nullptr || ! inflate (storedData, (size_t) storedSize, decoded, (size_t) size))
+    {
+        delete[] decoded;
+        return nullptr;
+    }
+
+    decoded[size] = 0;
+
+    // If another thread got there first, use its copy instead
+    const char* expected = nullptr;
+
+    if (decodedData.compare_exchange_strong (expected, decoded, std::memory_order_acq_rel))
+        return decoded;
+
+    delete[] decoded;
+    return expected;
+}
+)";
+    }
+
+} // namespace juce::build_tools
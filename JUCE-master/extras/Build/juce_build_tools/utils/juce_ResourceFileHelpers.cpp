@@ -73,18 +73,84 @@ namespace juce::build_tools
         return t;
     }
 
-    bool overwriteFileWithNewDataIfDifferent (const File& file, const void* data, size_t numBytes)
+    //==============================================================================
+    /*  Remembers the hashes of files that have been compared or written, along with their size
+        and modification time, so that a file that hasn't been touched since doesn't need to be
+        read again the next time the same output is generated.
+    */
+    class FileHashCache
     {
-        if (file.getSize() == (int64) numBytes
-            && calculateMemoryHashCode (data, numBytes) == calculateFileHashCode (file))
-            return true;
+    public:
+        static FileHashCache& getInstance()
+        {
+            static FileHashCache cache;
+            return cache;
+        }
+
+        uint64 getHash (const File& file)
+        {
+            const auto key = file.getFullPathName();
+            const auto size = file.getSize();
+            const auto modificationTime = file.getLastModificationTime().toMilliseconds();
+
+            {
+                const ScopedLock sl (lock);
+
+                const auto it = entries.find (key);
+
+                if (it != entries.end() && it->second.size == size && it->second.modificationTime == modificationTime)
+                    return it->second.hash;
+            }
+
+            const auto hash = calculateFileHashCode (file);
+
+            const ScopedLock sl (lock);
+            entries[key] = { size, modificationTime, hash };
+            return hash;
+        }
+
+        void setHash (const File& file, uint64 hash)
+        {
+            const Entry entry { file.getSize(), file.getLastModificationTime().toMilliseconds(), hash };
+
+            const ScopedLock sl (lock);
+            entries[file.getFullPathName()] = entry;
+        }
+
+    private:
+        struct Entry
+        {
+            int64 size, modificationTime;
+            uint64 hash;
+        };
 
+        CriticalSection lock;
+        std::unordered_map<String, Entry> entries;
+    };
+
+    static bool writeFile (const File& file, const void* data, size_t numBytes)
+    {
         if (file.exists())
             return file.replaceWithData (data, numBytes);
 
         return file.getParentDirectory().createDirectory() && file.appendData (data, numBytes);
     }
 
+    bool overwriteFileWithNewDataIfDifferent (const File& file, const void* data, size_t numBytes)
+    {
+        auto& cache = FileHashCache::getInstance();
+        const auto newHash = calculateMemoryHashCode (data, numBytes);
+
+        if (file.getSize() == (int64) numBytes && newHash == cache.getHash (file))
+            return true;
+
+        if (! writeFile (file, data, numBytes))
+            return false;
+
+        cache.setHash (file, newHash);
+        return true;
+    }
+
     bool overwriteFileWithNewDataIfDifferent (const File& file, const MemoryOutputStream& newData)
     {
         return overwriteFileWithNewDataIfDifferent (file, newData.getData(), newData.getDataSize());
@@ -96,4 +162,20 @@ namespace juce::build_tools
         return overwriteFileWithNewDataIfDifferent (file, utf8, strlen (utf8));
     }
 
+    bool copyFileIfDifferent (const File& source, const File& target)
+    {
+        auto& cache = FileHashCache::getInstance();
+
+        if (target.existsAsFile()
+            && target.getSize() == source.getSize()
+            && cache.getHash (target) == cache.getHash (source))
+            return true;
+
+        if (! source.copyFileTo (target))
+            return false;
+
+        cache.setHash (target, cache.getHash (source));
+        return true;
+    }
+
 } // namespace juce::build_tools
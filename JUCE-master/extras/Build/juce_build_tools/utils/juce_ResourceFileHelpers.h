@@ -43,4 +43,11 @@ namespace juce:: build_tools
     bool overwriteFileWithNewDataIfDifferent (const File& file, const MemoryOutputStream& newData);
     bool overwriteFileWithNewDataIfDifferent (const File& file, const String& newData);
 
+    /*  Copies a file unless the target already has the same contents. Like the functions
+        above, this leaves unchanged files untouched, so that build systems don't rebuild them.
+        The hashes of files are cached for as long as their size and modification time stay
+        the same, so repeated saves of an unchanged project don't need to read them again.
+    */
+    bool copyFileIfDifferent (const File& source, const File& target);
+
 } // namespace juce::build_tools
@@ -88,6 +88,7 @@ int writeBinaryData (juce::ArgumentList&& args)
 
     resourceFile.setClassName (namespaceName.text);
     const auto lineEndings = args.removeOptionIfFound ("--windows") ? "\r\n" : "\n";
+    resourceFile.setCompressionEnabled (args.removeOptionIfFound ("--compress"));
 
     const auto allLines = [&]
     {
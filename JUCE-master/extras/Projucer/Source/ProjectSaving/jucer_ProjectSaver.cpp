@@ -117,7 +117,7 @@ bool ProjectSaver::copyFolder (const File& source, const File& dest)
             auto target = dest.getChildFile (f.getFileName());
             filesCreated.add (target);
 
-            if (! f.copyFileTo (target))
+            if (! build_tools::copyFileIfDifferent (f, target))
                 return false;
         }
 
@@ -763,10 +763,7 @@ void ProjectSaver::writeProjects (const OwnedArray<LibraryModule>& modules, Proj
                 generatedFilesGroup.sortAlphabetically (true, true);
                 exporter->getAllGroups().add (generatedFilesGroup);
 
-                if (ProjucerApplication::getApp().isRunningCommandLine)
-                    saveExporter (*exporter, modules);
-                else
-                    threadPool.addJob ([this, &exporter, &modules] { saveExporter (*exporter, modules); });
+                threadPool.addJob ([this, &exporter, &modules] { saveExporter (*exporter, modules); });
             }
             else
             {
@@ -830,12 +827,10 @@ void ProjectSaver::saveExporter (ProjectExporter& exporter, const OwnedArray<Lib
     {
         exporter.create (modules);
 
-        auto outputString = "Finished saving: " + exporter.getUniqueName();
-
-        if (MessageManager::getInstance()->isThisTheMessageThread())
-            std::cout <<  outputString << std::endl;
-        else
-            MessageManager::callAsync ([outputString] { std::cout <<  outputString << std::endl; });
+        // Exporters are saved in parallel, and when running from the command line there's no
+        // message loop to post this to, so just keep the lines from being interleaved
+        const ScopedLock sl (outputLock);
+        std::cout << "Finished saving: " << exporter.getUniqueName() << std::endl;
     }
     catch (build_tools::SaveError& error)
     {
@@ -136,7 +136,7 @@ private:
     SortedSet<File> filesCreated;
     String projectLineFeed;
 
-    CriticalSection errorLock;
+    CriticalSection errorLock, outputLock;
     StringArray errors;
 
     std::unique_ptr<SaveThreadWithProgressWindow> saveThread;
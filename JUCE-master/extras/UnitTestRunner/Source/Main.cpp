@@ -56,6 +56,80 @@ class ConsoleUnitTestRunner final : public UnitTestRunner
     }
 };
 
+//==============================================================================
+static var benchmarkResultsToJSON (const UnitTestRunner& runner)
+{
+    auto root = std::make_unique<DynamicObject>();
+    root->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+    root->setProperty ("os", SystemStats::getOperatingSystemName());
+    root->setProperty ("cpu", SystemStats::getCpuModel());
+    root->setProperty ("date", Time::getCurrentTime().toISO8601 (true));
+
+    Array<var> list;
+
+    for (int i = 0; i < runner.getNumBenchmarkResults(); ++i)
+    {
+        auto* r = runner.getBenchmarkResult (i);
+
+        auto item = std::make_unique<DynamicObject>();
+        item->setProperty ("name", r->getKey());
+        item->setProperty ("numSamples", r->numSamples);
+        item->setProperty ("medianNanoseconds", r->medianNanoseconds);
+        item->setProperty ("meanNanoseconds", r->meanNanoseconds);
+        item->setProperty ("standardDeviationNanoseconds", r->standardDeviationNanoseconds);
+        item->setProperty ("fastestNanoseconds", r->fastestNanoseconds);
+        list.add (var (item.release()));
+    }
+
+    root->setProperty ("results", list);
+    return var (root.release());
+}
+
+/*  Returns the number of benchmarks that are slower than their baseline by more than both
+    the tolerance percentage and the combined standard deviation of the two measurements.
+*/
+static int compareBenchmarksWithBaseline (const UnitTestRunner& runner, const var& baseline, double tolerancePercent)
+{
+    std::map<String, var> previousResults;
+
+    if (auto* list = baseline["results"].getArray())
+        for (auto& item : *list)
+            previousResults[item["name"].toString()] = item;
+
+    Logger::writeToLog (newLine + "Benchmark comparison with baseline:" + newLine);
+
+    int numRegressions = 0;
+
+    for (int i = 0; i < runner.getNumBenchmarkResults(); ++i)
+    {
+        auto* r = runner.getBenchmarkResult (i);
+        auto line = r->getKey().paddedRight (' ', 70) + String (r->medianNanoseconds, 1).paddedLeft (' ', 14) + " ns";
+        auto previous = previousResults.find (r->getKey());
+
+        if (previous == previousResults.end())
+        {
+            Logger::writeToLog (line + "       (new)");
+            continue;
+        }
+
+        const auto oldMedian = (double) previous->second["medianNanoseconds"];
+        const auto oldDeviation = (double) previous->second["standardDeviationNanoseconds"];
+        const auto difference = r->medianNanoseconds - oldMedian;
+
+        line << String (oldMedian > 0.0 ? 100.0 * difference / oldMedian : 0.0, 1).paddedLeft (' ', 8) << "%";
+
+        if (difference > oldMedian * tolerancePercent / 100.0
+             && difference > r->standardDeviationNanoseconds + oldDeviation)
+        {
+            line << "  REGRESSION";
+            ++numRegressions;
+        }
+
+        Logger::writeToLog (line);
+    }
+
+    return numRegressions;
+}
 
 //==============================================================================
 int main (int argc, char **argv)
@@ -64,7 +138,11 @@ int main (int argc, char **argv)
 
     if (args.containsOption ("--help|-h"))
     {
-        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category=category] [--seed=seed]" << std::endl;
+        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category=category] [--seed=seed]" << std::endl
+                  << "    [--benchmark [--output=results.json] [--baseline=results.json] [--tolerance=10]]" << std::endl << std::endl
+                  << "With --benchmark, times the tests in the Benchmarks category (or the given category)." << std::endl
+                  << "When a baseline is given, returns a non-zero exit code if any benchmark's median is slower" << std::endl
+                  << "than its baseline by more than the tolerance percentage and the measurement deviation." << std::endl;
         return 0;
     }
 
@@ -96,8 +174,28 @@ int main (int argc, char **argv)
         return Random::getSystemRandom().nextInt64();
     }();
 
+    const auto benchmarking = args.containsOption ("--benchmark");
+    var baseline;
+
+    if (benchmarking && args.containsOption ("--baseline"))
+    {
+        const auto file = args.getFileForOption ("--baseline");
+        baseline = JSON::parse (file);
+
+        if (baseline.isVoid())
+        {
+            std::cerr << "Couldn't read the baseline file " << file.getFullPathName() << std::endl;
+            Logger::setCurrentLogger (nullptr);
+            return 1;
+        }
+    }
+
+    runner.setBenchmarkingEnabled (benchmarking);
+
     if (args.containsOption ("--category"))
         runner.runTestsInCategory (args.getValueForOption ("--category"), seed);
+    else if (benchmarking)
+        runner.runTestsInCategory (UnitTestCategories::benchmarks, seed);
     else
         runner.runAllTests (seed);
 
@@ -122,6 +220,34 @@ int main (int argc, char **argv)
         return 1;
     }
 
+    if (benchmarking)
+    {
+        if (args.containsOption ("--output"))
+        {
+            const auto file = args.getFileForOption ("--output");
+
+            if (! file.replaceWithText (JSON::toString (benchmarkResultsToJSON (runner))))
+            {
+                std::cerr << "Couldn't write to " << file.getFullPathName() << std::endl;
+                Logger::setCurrentLogger (nullptr);
+                return 1;
+            }
+        }
+
+        if (! baseline.isVoid())
+        {
+            const auto tolerance = args.containsOption ("--tolerance") ? args.getValueForOption ("--tolerance").getDoubleValue() : 10.0;
+            const auto numRegressions = compareBenchmarksWithBaseline (runner, baseline, tolerance);
+
+            if (numRegressions > 0)
+            {
+                logger.writeToLog (String (newLine) + String (numRegressions) + " benchmark" + (numRegressions > 1 ? "s" : "") + " regressed");
+                Logger::setCurrentLogger (nullptr);
+                return 1;
+            }
+        }
+    }
+
     logger.writeToLog (newLine + "All tests completed successfully");
     Logger::setCurrentLogger (nullptr);
 
@@ -35,8 +35,58 @@
 namespace juce
 {
 
-ThreadedAnalyticsDestination::ThreadedAnalyticsDestination (const String& threadName)
-    : dispatcher (threadName, *this)
+//==============================================================================
+namespace AnalyticsEventHelpers
+{
+    static var toVar (const StringPairArray& pairs)
+    {
+        DynamicObject::Ptr object (new DynamicObject());
+
+        for (int i = 0; i < pairs.size(); ++i)
+            object->setProperty (pairs.getAllKeys()[i], pairs.getAllValues()[i]);
+
+        return object.get();
+    }
+
+    static StringPairArray toStringPairArray (const var& v)
+    {
+        StringPairArray pairs;
+
+        if (auto* object = v.getDynamicObject())
+            for (auto& property : object->getProperties())
+                pairs.set (property.name.toString(), property.value.toString());
+
+        return pairs;
+    }
+
+    static var toVar (const AnalyticsDestination::AnalyticsEvent& event)
+    {
+        DynamicObject::Ptr object (new DynamicObject());
+        object->setProperty ("name", event.name);
+        object->setProperty ("type", event.eventType);
+        object->setProperty ("timestamp", (int64) event.timestamp);
+        object->setProperty ("userID", event.userID);
+        object->setProperty ("parameters", toVar (event.parameters));
+        object->setProperty ("userProperties", toVar (event.userProperties));
+        return object.get();
+    }
+
+    static AnalyticsDestination::AnalyticsEvent toEvent (const var& v)
+    {
+        return { v["name"].toString(),
+                 (int) v["type"],
+                 (uint32) (int64) v["timestamp"],
+                 toStringPairArray (v["parameters"]),
+                 v["userID"].toString(),
+                 toStringPairArray (v["userProperties"]) };
+    }
+}
+
+//==============================================================================
+ThreadedAnalyticsDestination::ThreadedAnalyticsDestination (const String& threadName, int maxNumQueuedEvents)
+    : maxQueueSize ((size_t) jmax (1, maxNumQueuedEvents)),
+      newEvents (jmax (1, maxNumQueuedEvents)),
+      dispatcher (threadName, *this)
 {}
 
 ThreadedAnalyticsDestination::~ThreadedAnalyticsDestination()
@@ -53,7 +103,25 @@ void ThreadedAnalyticsDestination::setBatchPeriod (int newBatchPeriodMillisecond
 
 void ThreadedAnalyticsDestination::logEvent (const AnalyticsEvent& event)
 {
-    dispatcher.addToQueue (event);
+    if (! newEvents.push (event))
+        ++numDroppedEvents;
+}
+
+MemoryBlock ThreadedAnalyticsDestination::createCompressedBatch (const Array<AnalyticsEvent>& events)
+{
+    Array<var> batch;
+
+    for (auto& event : events)
+        batch.add (AnalyticsEventHelpers::toVar (event));
+
+    MemoryOutputStream output;
+
+    {
+        GZIPCompressorOutputStream compressor (output, -1, GZIPCompressorOutputStream::windowBitsGZIP);
+        compressor << JSON::toString (batch, true);
+    }
+
+    return output.getMemoryBlock();
 }
 
 void ThreadedAnalyticsDestination::startAnalyticsThread (int initialBatchPeriodMilliseconds)
@@ -62,16 +130,31 @@ void ThreadedAnalyticsDestination::startAnalyticsThread (int initialBatchPeriodM
     dispatcher.startThread();
 }
 
+void ThreadedAnalyticsDestination::setSpoolFile (const File& file)
+{
+    // This can't be changed while the analytics thread is using the file!
+    jassert (! dispatcher.isThreadRunning());
+
+    dispatcher.spoolFile = file;
+}
+
 void ThreadedAnalyticsDestination::stopAnalyticsThread (int timeout)
 {
     dispatcher.signalThreadShouldExit();
     stopLoggingEvents();
     dispatcher.stopThread (timeout);
 
-    if (dispatcher.eventQueue.size() > 0)
+    // Only the events that arrived since the thread last looked still need to be
+    // dealt with, and with a spool file they're just appended to it.
+    dispatcher.takeNewEvents();
+
+    if (dispatcher.spoolFile != File())
+        dispatcher.closeSpool();
+    else if (dispatcher.eventQueue.size() > 0)
         saveUnloggedEvents (dispatcher.eventQueue);
 }
 
+//==============================================================================
 ThreadedAnalyticsDestination::EventDispatcher::EventDispatcher (const String& dispatcherThreadName,
                                                                 ThreadedAnalyticsDestination& destination)
     : Thread (dispatcherThreadName),
@@ -87,34 +170,42 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
         std::deque<AnalyticsEvent> restoredEventQueue;
         parent.restoreUnloggedEvents (restoredEventQueue);
 
-        const ScopedLock lock (queueAccess);
-
         for (auto rit = restoredEventQueue.rbegin(); rit != restoredEventQueue.rend(); ++rit)
             eventQueue.push_front (*rit);
+
+        restoreFromSpool();
+
+        if (eventQueue.size() > parent.maxQueueSize)
+        {
+            const auto numToDrop = eventQueue.size() - parent.maxQueueSize;
+            parent.numDroppedEvents += (int) numToDrop;
+            eventQueue.erase (eventQueue.begin(), eventQueue.begin() + (std::ptrdiff_t) numToDrop);
+        }
+
+        // Events restored from elsewhere are added to the spool too.
+        rewriteSpool();
     }
 
     const int maxBatchSize = parent.getMaximumBatchSize();
 
     while (! threadShouldExit())
     {
-        {
-            const ScopedLock lock (queueAccess);
+        takeNewEvents();
 
-            const auto numEventsInBatch = eventsToSend.size();
-            const auto freeBatchCapacity = maxBatchSize - numEventsInBatch;
+        const auto numEventsInBatch = eventsToSend.size();
+        const auto freeBatchCapacity = maxBatchSize - numEventsInBatch;
 
-            if (freeBatchCapacity > 0)
-            {
-                const auto numNewEvents = (int) eventQueue.size() - numEventsInBatch;
+        if (freeBatchCapacity > 0)
+        {
+            const auto numNewEvents = (int) eventQueue.size() - numEventsInBatch;
 
-                if (numNewEvents > 0)
-                {
-                    const auto numEventsToAdd = jmin (numNewEvents, freeBatchCapacity);
-                    const auto newBatchSize = numEventsInBatch + numEventsToAdd;
+            if (numNewEvents > 0)
+            {
+                const auto numEventsToAdd = jmin (numNewEvents, freeBatchCapacity);
+                const auto newBatchSize = numEventsInBatch + numEventsToAdd;
 
-                    for (auto i = numEventsInBatch; i < newBatchSize; ++i)
-                        eventsToSend.add (eventQueue[(size_t) i]);
-                }
+                for (auto i = numEventsInBatch; i < newBatchSize; ++i)
+                    eventsToSend.add (eventQueue[(size_t) i]);
             }
         }
 
@@ -124,31 +215,181 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
         {
             if (parent.logBatchedEvents (eventsToSend))
             {
-                const ScopedLock lock (queueAccess);
-
-                for (auto i = 0; i < eventsToSend.size(); ++i)
-                    eventQueue.pop_front();
-
+                const auto numLogged = (size_t) eventsToSend.size();
                 eventsToSend.clearQuick();
+                removeOldestEvents (0, numLogged, false);
             }
         }
 
-        while (Time::getMillisecondCounter() - submissionTime < (uint32) batchPeriodMilliseconds.get())
+        const auto elapsed = (int) (Time::getMillisecondCounter() - submissionTime);
+        const auto remaining = batchPeriodMilliseconds.get() - elapsed;
+
+        if (remaining > 0)
+            wait (remaining);
+    }
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::takeNewEvents()
+{
+    AnalyticsEvent event;
+    bool receivedEvents = false;
+
+    while (parent.newEvents.pop (event))
+    {
+        if (spoolFile != File())
+        {
+            DynamicObject::Ptr record (new DynamicObject());
+            record->setProperty ("event", AnalyticsEventHelpers::toVar (event));
+            appendToSpool (record.get());
+        }
+
+        eventQueue.push_back (std::move (event));
+        receivedEvents = true;
+    }
+
+    if (! receivedEvents)
+        return;
+
+    if (spoolStream != nullptr)
+        spoolStream->flush();
+
+    // The events being logged stay at the front of the queue, so the oldest of the
+    // other ones are dropped instead.
+    const auto numInBatch = (size_t) eventsToSend.size();
+
+    if (eventQueue.size() > parent.maxQueueSize)
+        removeOldestEvents (numInBatch, jmin (eventQueue.size() - parent.maxQueueSize,
+                                              eventQueue.size() - numInBatch), true);
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::removeOldestEvents (size_t firstIndex, size_t numToRemove, bool dropped)
+{
+    if (numToRemove == 0)
+        return;
+
+    if (dropped)
+        parent.numDroppedEvents += (int) numToRemove;
+
+    const auto first = eventQueue.begin() + (std::ptrdiff_t) firstIndex;
+    eventQueue.erase (first, first + (std::ptrdiff_t) numToRemove);
+
+    if (spoolFile == File())
+        return;
+
+    if (eventQueue.empty())
+    {
+        closeSpool();
+        spoolFile.deleteFile();
+        numRemovedEventsInSpool = 0;
+        return;
+    }
+
+    // The spool is only ever appended to, except when a lot of it describes events
+    // that are gone, in which case it's rewritten with just the remaining ones.
+    numRemovedEventsInSpool += numToRemove;
+
+    if (firstIndex > 0 || numRemovedEventsInSpool > parent.maxQueueSize)
+    {
+        rewriteSpool();
+    }
+    else
+    {
+        DynamicObject::Ptr record (new DynamicObject());
+        record->setProperty ("removed", (int64) numToRemove);
+        appendToSpool (record.get());
+
+        if (spoolStream != nullptr)
+            spoolStream->flush();
+    }
+}
+
+//==============================================================================
+/*  The spool file has a line of JSON for each change to the queue: either an event
+    that has been added to the back, or a number of events removed from the front.
+*/
+void ThreadedAnalyticsDestination::EventDispatcher::restoreFromSpool()
+{
+    if (spoolFile == File() || ! spoolFile.existsAsFile())
+        return;
+
+    std::deque<AnalyticsEvent> spooledEvents;
+    StringArray lines;
+    spoolFile.readLines (lines);
+
+    for (auto& line : lines)
+    {
+        const auto record = JSON::parse (line);
+
+        if (record.hasProperty ("removed"))
+        {
+            const auto numRemoved = jmin ((size_t) jmax ((int64) 0, (int64) record["removed"]), spooledEvents.size());
+            spooledEvents.erase (spooledEvents.begin(), spooledEvents.begin() + (std::ptrdiff_t) numRemoved);
+        }
+        else if (record.hasProperty ("event"))
         {
-            if (threadShouldExit())
-                return;
+            spooledEvents.push_back (AnalyticsEventHelpers::toEvent (record["event"]));
+        }
+    }
 
-            Thread::sleep (100);
+    eventQueue.insert (eventQueue.begin(), spooledEvents.begin(), spooledEvents.end());
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::appendToSpool (const var& record)
+{
+    if (spoolFile == File())
+        return;
+
+    if (spoolStream == nullptr)
+    {
+        spoolStream = std::make_unique<FileOutputStream> (spoolFile);
+
+        if (spoolStream->failedToOpen())
+        {
+            spoolStream.reset();
+            return;
         }
     }
+
+    *spoolStream << JSON::toString (record, true) << "\n";
 }
 
-void ThreadedAnalyticsDestination::EventDispatcher::addToQueue (const AnalyticsEvent& event)
+void ThreadedAnalyticsDestination::EventDispatcher::rewriteSpool()
 {
-    const ScopedLock lock (queueAccess);
-    eventQueue.push_back (event);
+    if (spoolFile == File())
+        return;
+
+    closeSpool();
+    numRemovedEventsInSpool = 0;
+
+    if (eventQueue.empty())
+    {
+        spoolFile.deleteFile();
+        return;
+    }
+
+    TemporaryFile temp (spoolFile);
+
+    {
+        FileOutputStream output (temp.getFile());
+
+        if (output.failedToOpen())
+            return;
+
+        for (auto& event : eventQueue)
+        {
+            DynamicObject::Ptr record (new DynamicObject());
+            record->setProperty ("event", AnalyticsEventHelpers::toVar (event));
+            output << JSON::toString (record.get(), true) << "\n";
+        }
+    }
+
+    temp.overwriteTargetFileWithTemporary();
 }
 
+void ThreadedAnalyticsDestination::EventDispatcher::closeSpool()
+{
+    spoolStream.reset();
+}
 
 //==============================================================================
 //==============================================================================
@@ -160,11 +401,18 @@ namespace DestinationTestHelpers
     struct BasicDestination final : public ThreadedAnalyticsDestination
     {
         BasicDestination (std::deque<AnalyticsEvent>& loggedEvents,
-                          std::deque<AnalyticsEvent>& unloggedEvents)
-            : ThreadedAnalyticsDestination ("ThreadedAnalyticsDestinationTest"),
+                          std::deque<AnalyticsEvent>& unloggedEvents,
+                          bool shouldLogEvents = true,
+                          const File& spoolFile = {},
+                          int maxNumQueuedEvents = 8192)
+            : ThreadedAnalyticsDestination ("ThreadedAnalyticsDestinationTest", maxNumQueuedEvents),
               loggedEventQueue (loggedEvents),
-              unloggedEventStore (unloggedEvents)
+              unloggedEventStore (unloggedEvents),
+              loggingIsEnabled (shouldLogEvents)
         {
+            if (spoolFile != File())
+                setSpoolFile (spoolFile);
+
             startAnalyticsThread (20);
         }
 
@@ -214,7 +462,7 @@ namespace DestinationTestHelpers
 
         std::deque<AnalyticsEvent>& loggedEventQueue;
         std::deque<AnalyticsEvent>& unloggedEventStore;
-        bool loggingIsEnabled = true;
+        std::atomic<bool> loggingIsEnabled;
         CriticalSection eventQueueChanging;
     };
 }
@@ -239,6 +487,28 @@ struct ThreadedAnalyticsDestinationTests final : public UnitTest
         }
     }
 
+    void waitForLoggedEvents (DestinationTestHelpers::BasicDestination& destination,
+                              const std::deque<AnalyticsDestination::AnalyticsEvent>& loggedEvents,
+                              size_t numExpected)
+    {
+        size_t waitTime = 0, numLoggedEvents = 0;
+
+        while (numLoggedEvents < numExpected)
+        {
+            if (waitTime > 4000)
+            {
+                expect (waitTime < 4000);
+                break;
+            }
+
+            Thread::sleep (40);
+            waitTime += 40;
+
+            const ScopedLock lock (destination.eventQueueChanging);
+            numLoggedEvents = loggedEvents.size();
+        }
+    }
+
     void runTest() override
     {
         std::deque<AnalyticsDestination::AnalyticsEvent> testEvents;
@@ -256,22 +526,7 @@ struct ThreadedAnalyticsDestinationTests final : public UnitTest
             for (auto& event : testEvents)
                 destination.logEvent (event);
 
-            size_t waitTime = 0, numLoggedEvents = 0;
-
-            while (numLoggedEvents < testEvents.size())
-            {
-                if (waitTime > 4000)
-                {
-                    expect (waitTime < 4000);
-                    break;
-                }
-
-                Thread::sleep (40);
-                waitTime += 40;
-
-                const ScopedLock lock (destination.eventQueueChanging);
-                numLoggedEvents = loggedEvents.size();
-            }
+            waitForLoggedEvents (destination, loggedEvents, testEvents.size());
         }
 
         compareEventQueues (loggedEvents, testEvents);
@@ -290,6 +545,70 @@ struct ThreadedAnalyticsDestinationTests final : public UnitTest
 
         compareEventQueues (unloggedEvents, testEvents);
         expect (loggedEvents.size() == 0);
+
+        unloggedEvents.clear();
+
+        beginTest ("Spooled events");
+        {
+            TemporaryFile spool;
+
+            {
+                DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents, false, spool.getFile());
+
+                for (auto& event : testEvents)
+                    destination.logEvent (event);
+            }
+
+            expect (unloggedEvents.empty());
+            expect (spool.getFile().existsAsFile());
+
+            {
+                DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents, true, spool.getFile());
+                waitForLoggedEvents (destination, loggedEvents, testEvents.size());
+            }
+
+            compareEventQueues (loggedEvents, testEvents);
+            expect (unloggedEvents.empty());
+            expect (! spool.getFile().existsAsFile());
+        }
+
+        loggedEvents.clear();
+
+        beginTest ("Queue size is limited");
+        {
+            constexpr int maxNumQueuedEvents = 16, numEvents = 100;
+
+            {
+                DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents, false, {}, maxNumQueuedEvents);
+
+                for (int i = 0; i < numEvents; ++i)
+                    destination.logEvent (testEvents[(size_t) i % testEvents.size()]);
+            }
+
+            expect ((int) unloggedEvents.size() <= maxNumQueuedEvents);
+            expect (loggedEvents.empty());
+        }
+
+        beginTest ("Compressed batches");
+        {
+            Array<AnalyticsDestination::AnalyticsEvent> batch;
+
+            for (auto& event : testEvents)
+                batch.add (event);
+
+            batch.getReference (0).parameters.set ("key", "value");
+
+            const auto compressed = ThreadedAnalyticsDestination::createCompressedBatch (batch);
+            MemoryInputStream compressedInput (compressed, false);
+            GZIPDecompressorInputStream decompressor (&compressedInput, false, GZIPDecompressorInputStream::gzipFormat);
+            const auto parsed = JSON::parse (decompressor.readEntireStreamAsString());
+
+            expect (parsed.isArray());
+            expectEquals (parsed.size(), batch.size());
+            expectEquals (parsed[0]["name"].toString(), batch[0].name);
+            expectEquals (parsed[0]["parameters"]["key"].toString(), String ("value"));
+            expectEquals ((int64) parsed[6]["timestamp"], (int64) batch[6].timestamp);
+        }
     }
 };
 
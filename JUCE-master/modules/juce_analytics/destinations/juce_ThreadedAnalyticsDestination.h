@@ -49,6 +49,15 @@ namespace juce
     calls to setBatchPeriod. Here events are grouped together into batches, with
     the maximum batch size set by the implementation of getMaximumBatchSize.
 
+    logEvent never blocks: events are passed to the analytics thread through a
+    lock-free queue of fixed size. The number of events waiting to be logged is
+    limited too, and the oldest ones are dropped when there are too many, see
+    getNumDroppedEvents.
+
+    Unlogged events can either be saved when the analytics thread is shut down,
+    by overriding saveUnloggedEvents and restoreUnloggedEvents, or written to a
+    spool file as they arrive, see setSpoolFile.
+
     It's important to call stopAnalyticsThread in the destructor of your
     subclass (or before then) to give the analytics thread time to shut down.
     Calling stopAnalyticsThread will, in turn, call stopLoggingEvents, which
@@ -65,10 +74,13 @@ public:
     /**
         Creates a ThreadedAnalyticsDestination.
 
-        @param threadName     used to identify the analytics
-                              thread in debug builds
+        @param threadName           used to identify the analytics
+                                    thread in debug builds
+        @param maxNumQueuedEvents   the maximum number of events that can be
+                                    waiting to be logged
     */
-    ThreadedAnalyticsDestination (const String& threadName = "Analytics thread");
+    ThreadedAnalyticsDestination (const String& threadName = "Analytics thread",
+                                  int maxNumQueuedEvents = 8192);
 
     /** Destructor. */
     ~ThreadedAnalyticsDestination() override;
@@ -131,12 +143,28 @@ public:
         Adds an event to the queue, which will ultimately be submitted to
         logBatchedEvents.
 
-        This method is thread safe.
+        This method is thread safe, and it doesn't wait for any locks. If the
+        queue is full the event is dropped.
 
         @param event               the analytics event to add to the queue
     */
     void logEvent (const AnalyticsEvent& event) override final;
 
+    /** Returns the number of events that have been dropped because too many
+        events were waiting to be logged.
+    */
+    int getNumDroppedEvents() const noexcept        { return numDroppedEvents.get(); }
+
+    //==============================================================================
+    /**
+        Returns a batch of events as a gzip-compressed JSON array, which you
+        can use as the body of a request in your logBatchedEvents method.
+
+        Each event becomes an object with "name", "type", "timestamp", "userID",
+        "parameters" and "userProperties" properties.
+    */
+    static MemoryBlock createCompressedBatch (const Array<AnalyticsEvent>& events);
+
 protected:
     //==============================================================================
     /**
@@ -147,6 +175,20 @@ protected:
     */
     void startAnalyticsThread (int initialBatchPeriodMilliseconds);
 
+    /**
+        Makes the analytics thread keep unlogged events in a file.
+
+        New events are appended to the file as they're taken from the queue,
+        and the file is updated as batches are logged, so there's very little
+        left to write when the analytics thread is shut down. Events in the
+        file are put back into the queue when the analytics thread starts.
+
+        When a spool file is used saveUnloggedEvents isn't called.
+
+        This must be called before startAnalyticsThread.
+    */
+    void setSpoolFile (const File& file);
+
     //==============================================================================
     /**
         Triggers the shutdown of the analytics thread.
@@ -178,11 +220,13 @@ private:
         stopLoggingEvents and this method need to complete inside the timeout
         set in stopAnalyticsThread.
 
+        This method isn't called if a spool file has been set.
+
         @param eventsToSave                  the events that could not be logged
 
-        @see stopAnalyticsThread, stopLoggingEvents, restoreUnloggedEvents
+        @see stopAnalyticsThread, stopLoggingEvents, restoreUnloggedEvents, setSpoolFile
     */
-    virtual void saveUnloggedEvents (const std::deque<AnalyticsEvent>& eventsToSave) = 0;
+    virtual void saveUnloggedEvents (const std::deque<AnalyticsEvent>& eventsToSave) { ignoreUnused (eventsToSave); }
 
     /**
         The counterpart to saveUnloggedEvents.
@@ -198,26 +242,40 @@ private:
 
         @see saveUnloggedEvents
     */
-    virtual void restoreUnloggedEvents (std::deque<AnalyticsEvent>& restoredEventQueue) = 0;
+    virtual void restoreUnloggedEvents (std::deque<AnalyticsEvent>& restoredEventQueue) { ignoreUnused (restoredEventQueue); }
 
+    //==============================================================================
     struct EventDispatcher   : public Thread
     {
         EventDispatcher (const String& threadName, ThreadedAnalyticsDestination&);
 
         void run() override;
-        void addToQueue (const AnalyticsEvent&);
+        void takeNewEvents();
+        void removeOldestEvents (size_t firstIndex, size_t numToRemove, bool dropped);
+
+        void restoreFromSpool();
+        void appendToSpool (const var&);
+        void rewriteSpool();
+        void closeSpool();
 
         ThreadedAnalyticsDestination& parent;
 
+        // Only used by the analytics thread, or by stopAnalyticsThread once the
+        // thread has stopped.
         std::deque<AnalyticsEvent> eventQueue;
-        CriticalSection queueAccess;
+        Array<AnalyticsEvent> eventsToSend;
 
-        Atomic<int> batchPeriodMilliseconds { 1000 };
+        File spoolFile;
+        std::unique_ptr<FileOutputStream> spoolStream;
+        size_t numRemovedEventsInSpool = 0;
 
-        Array<AnalyticsEvent> eventsToSend;
+        Atomic<int> batchPeriodMilliseconds { 1000 };
     };
 
     const String destinationName;
+    const size_t maxQueueSize;
+    MultiProducerFifo<AnalyticsEvent, FifoReaders::single> newEvents;
+    Atomic<int> numDroppedEvents { 0 };
     EventDispatcher dispatcher;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadedAnalyticsDestination)
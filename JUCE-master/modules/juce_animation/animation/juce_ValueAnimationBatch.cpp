@@ -0,0 +1,410 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+class ValueAnimationBatch::BatchAnimator final : public Animator::Impl
+{
+public:
+    explicit BatchAnimator (ValueAnimationBatch& b)  : batch (&b) {}
+
+    Animator::Status internalUpdate (double timestampMs) override
+    {
+        if (batch == nullptr)
+            return Animator::Status::finished;
+
+        batch->update (timestampMs);
+        return batch->getNumRunning() > 0 ? Animator::Status::inProgress : Animator::Status::finished;
+    }
+
+    void onStart (double) override {}
+    void onComplete() override {}
+
+    ValueAnimationBatch* batch;
+};
+
+//==============================================================================
+static constexpr int freeSlot = -1, pendingSlot = -2;
+
+ValueAnimationBatch::ValueAnimationBatch (Point<float> controlPoint1, Point<float> controlPoint2)
+    : impl (std::make_shared<BatchAnimator> (*this)),
+      animator (impl)
+{
+    // The x axis represents time, it's important this always stays in the range 0 - 1
+    jassert (isPositiveAndNotGreaterThan (controlPoint1.x, 1.0f));
+    jassert (isPositiveAndNotGreaterThan (controlPoint2.x, 1.0f));
+
+    // The same polynomial coefficients as chromium::gfx::CubicBezier
+    curve.cx = 3.0f * controlPoint1.x;
+    curve.bx = 3.0f * (controlPoint2.x - controlPoint1.x) - curve.cx;
+    curve.ax = 1.0f - curve.cx - curve.bx;
+
+    curve.cy = 3.0f * controlPoint1.y;
+    curve.by = 3.0f * (controlPoint2.y - controlPoint1.y) - curve.cy;
+    curve.ay = 1.0f - curve.cy - curve.by;
+
+    curve.isLinear = approximatelyEqual (controlPoint1.x, controlPoint1.y)
+                  && approximatelyEqual (controlPoint2.x, controlPoint2.y);
+}
+
+ValueAnimationBatch::~ValueAnimationBatch()
+{
+    impl->batch = nullptr;
+}
+
+void ValueAnimationBatch::setValuesChangedCallback (ValuesChangedCallback callback)
+{
+    valuesChanged = std::move (callback);
+}
+
+void ValueAnimationBatch::setOnCompleteCallback (CompletedCallback callback)
+{
+    onComplete = std::move (callback);
+}
+
+//==============================================================================
+int ValueAnimationBatch::start (double durationMs)
+{
+    int id;
+
+    if (freeIds.empty())
+    {
+        id = (int) indexForId.size();
+        indexForId.push_back (freeSlot);
+    }
+    else
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+
+    // Animations added during an update have to wait, so that the spans passed to the
+    // callbacks stay valid
+    if (isUpdating)
+    {
+        pendingStarts.emplace_back (id, durationMs);
+        indexForId[(size_t) id] = pendingSlot;
+    }
+    else
+    {
+        indexForId[(size_t) id] = (int) ids.size();
+
+        ids.push_back (id);
+        startTimes.push_back (std::numeric_limits<double>::quiet_NaN());
+        inverseDurations.push_back (durationMs > 0.0 ? 1.0 / durationMs : 0.0);
+        shouldComplete.push_back (durationMs > 0.0 ? 0 : 1);
+
+        for (auto* v : { &progress, &values, &low, &high })
+            v->push_back (0.0f);
+    }
+
+    if (! impl->running)
+        animator.start();
+
+    return id;
+}
+
+void ValueAnimationBatch::complete (int id)
+{
+    if (! isRunning (id))
+        return;
+
+    if (const auto index = indexForId[(size_t) id]; index >= 0)
+    {
+        shouldComplete[(size_t) index] = 1;
+        return;
+    }
+
+    for (auto& [pendingId, durationMs] : pendingStarts)
+        if (pendingId == id)
+            durationMs = 0.0;
+}
+
+void ValueAnimationBatch::remove (int id)
+{
+    if (! isRunning (id))
+        return;
+
+    if (isUpdating)
+    {
+        pendingRemovals.push_back (id);
+        return;
+    }
+
+    removeAt ((size_t) indexForId[(size_t) id]);
+    freeIds.push_back (id);
+}
+
+bool ValueAnimationBatch::isRunning (int id) const
+{
+    return isPositiveAndBelow (id, (int) indexForId.size()) && indexForId[(size_t) id] != freeSlot;
+}
+
+int ValueAnimationBatch::getNumRunning() const noexcept
+{
+    return (int) (ids.size() + pendingStarts.size());
+}
+
+Animator ValueAnimationBatch::getAnimator() const
+{
+    return animator;
+}
+
+//==============================================================================
+void ValueAnimationBatch::update (double timestampMs)
+{
+    if (isUpdating)
+    {
+        // If this is hit, one of the callbacks is trying to update the batch recursively
+        jassertfalse;
+        return;
+    }
+
+    isUpdating = true;
+
+    const auto numValues = ids.size();
+
+    for (size_t i = 0; i < numValues; ++i)
+        if (std::isnan (startTimes[i]))
+            startTimes[i] = timestampMs;
+
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        const auto p = jlimit (0.0f, 1.0f, (float) ((timestampMs - startTimes[i]) * inverseDurations[i]));
+        progress[i] = shouldComplete[i] != 0 ? 1.0f : p;
+    }
+
+    ease ((int) numValues);
+
+    NullCheckedInvocation::invoke (valuesChanged,
+                                   Span<const int> (ids.data(), numValues),
+                                   Span<const float> (values.data(), numValues));
+
+    completedIds.clear();
+
+    for (size_t i = 0; i < numValues; ++i)
+        if (progress[i] >= 1.0f)
+            completedIds.push_back (ids[i]);
+
+    for (auto id : completedIds)
+        removeAt ((size_t) indexForId[(size_t) id]);
+
+    if (! completedIds.empty())
+        NullCheckedInvocation::invoke (onComplete, Span<const int> (completedIds.data(), completedIds.size()));
+
+    freeIds.insert (freeIds.end(), completedIds.begin(), completedIds.end());
+    isUpdating = false;
+
+    applyPendingChanges();
+}
+
+void ValueAnimationBatch::ease (int numValues)
+{
+    const auto n = (size_t) numValues;
+
+    if (curve.isLinear)
+    {
+        std::copy (progress.begin(), progress.begin() + (ptrdiff_t) n, values.begin());
+        return;
+    }
+
+    // x(t) is monotonic when the control points' x coordinates are within 0 to 1, so
+    // t can be found by bisection. Every animation takes the same number of steps, which
+    // keeps these loops branch-free and lets the compiler vectorise them.
+    std::fill (low.begin(), low.begin() + (ptrdiff_t) n, 0.0f);
+    std::fill (high.begin(), high.begin() + (ptrdiff_t) n, 1.0f);
+
+    const auto [ax, bx, cx, ay, by, cy, isLinear] = curve;
+    ignoreUnused (isLinear);
+
+    for (int step = 0; step < 20; ++step)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto t = (low[i] + high[i]) * 0.5f;
+            const auto x = ((ax * t + bx) * t + cx) * t;
+            const auto isBelow = x < progress[i];
+
+            low[i]  = isBelow ? t : low[i];
+            high[i] = isBelow ? high[i] : t;
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto t = (low[i] + high[i]) * 0.5f;
+        const auto y = ((ay * t + by) * t + cy) * t;
+
+        // Keep the start and end values exact
+        values[i] = progress[i] <= 0.0f ? 0.0f : (progress[i] >= 1.0f ? 1.0f : y);
+    }
+}
+
+void ValueAnimationBatch::removeAt (size_t index)
+{
+    const auto last = ids.size() - 1;
+
+    indexForId[(size_t) ids[index]] = freeSlot;
+
+    if (index != last)
+    {
+        ids[index] = ids[last];
+        startTimes[index] = startTimes[last];
+        inverseDurations[index] = inverseDurations[last];
+        shouldComplete[index] = shouldComplete[last];
+        progress[index] = progress[last];
+        values[index] = values[last];
+        indexForId[(size_t) ids[index]] = (int) index;
+    }
+
+    for (auto* v : { &progress, &values, &low, &high })
+        v->pop_back();
+
+    ids.pop_back();
+    startTimes.pop_back();
+    inverseDurations.pop_back();
+    shouldComplete.pop_back();
+}
+
+void ValueAnimationBatch::applyPendingChanges()
+{
+    const auto starts = std::exchange (pendingStarts, {});
+
+    for (const auto& [id, durationMs] : starts)
+    {
+        // start() reuses the ID, so this just moves it out of the pending state
+        freeIds.push_back (id);
+        indexForId[(size_t) id] = freeSlot;
+        [[maybe_unused]] const auto newId = start (durationMs);
+        jassert (newId == id);
+    }
+
+    const auto removals = std::exchange (pendingRemovals, {});
+
+    for (const auto id : removals)
+        remove (id);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ValueAnimationBatchTests  : public UnitTest
+{
+    ValueAnimationBatchTests()
+        : UnitTest ("ValueAnimationBatch", UnitTestCategories::gui)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Values match Easings::createCubicBezier()");
+        {
+            const Point<float> p1 { 0.25f, 0.1f }, p2 { 0.25f, 1.0f };
+            const auto easing = Easings::createCubicBezier (p1, p2);
+
+            ValueAnimationBatch batch { p1, p2 };
+            std::map<int, float> latest;
+
+            batch.setValuesChangedCallback ([&] (Span<const int> ids, Span<const float> values)
+            {
+                for (size_t i = 0; i < ids.size(); ++i)
+                    latest[ids[i]] = values[i];
+            });
+
+            const auto a = batch.start (100.0);
+            const auto b = batch.start (400.0);
+
+            for (double t = 0.0; t <= 100.0; t += 10.0)
+            {
+                batch.update (t);
+                expectWithinAbsoluteError (latest[a], easing ((float) (t / 100.0)), 1.0e-4f);
+                expectWithinAbsoluteError (latest[b], easing ((float) (t / 400.0)), 1.0e-4f);
+            }
+
+            expect (! batch.isRunning (a));
+            expect (batch.isRunning (b));
+            expectEquals (latest[a], 1.0f);
+        }
+
+        beginTest ("Completed animations are reported and their IDs are reused");
+        {
+            ValueAnimationBatch batch;
+            std::vector<int> completed;
+
+            batch.setOnCompleteCallback ([&] (Span<const int> ids)
+            {
+                completed.insert (completed.end(), ids.begin(), ids.end());
+
+                // Animations started from a callback begin at the next update
+                batch.start (10.0);
+            });
+
+            const auto a = batch.start (10.0);
+            const auto b = batch.start (10.0);
+            batch.complete (b);
+
+            batch.update (0.0);
+            expect (completed == std::vector<int> { b });
+            expectEquals (batch.getNumRunning(), 2);
+
+            batch.remove (a);
+            expect (! batch.isRunning (a));
+            expectEquals (batch.getNumRunning(), 1);
+
+            expectEquals (batch.start (10.0), a);
+        }
+
+        beginTest ("The Animator finishes once every animation has completed");
+        {
+            ValueAnimationBatch batch;
+            auto animator = batch.getAnimator();
+
+            batch.start (10.0);
+            expect (animator.update (0.0) == Animator::Status::inProgress);
+            expect (animator.update (10.0) == Animator::Status::finished);
+
+            batch.start (10.0);
+            expect (animator.update (20.0) == Animator::Status::inProgress);
+        }
+    }
+};
+
+static ValueAnimationBatchTests valueAnimationBatchTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs many value animations that share the same easing curve, as one Animator.
+
+    Each ValueAnimatorBuilder Animator is updated on its own, calls its own easing function
+    and its own value change callback, which adds up when thousands of them are running at
+    once. A ValueAnimationBatch stores the state of all its animations in packed arrays
+    instead, evaluates the easing curve for all of them in loops that the compiler can
+    vectorise, and delivers every value in a single callback per update.
+
+    The easing curve is a cubic bezier, with the same meaning as the one created by
+    Easings::createCubicBezier(). The default control points give a linear progression.
+
+    Register the Animator returned by getAnimator() with an AnimatorUpdater or a
+    VBlankAnimatorUpdater to drive the batch. It starts itself whenever an animation is
+    added, and finishes when the last animation has completed.
+
+    @code
+    ValueAnimationBatch batch { { 0.42f, 0.0f }, { 0.58f, 1.0f } };
+    VBlankAnimatorUpdater updater { this };
+
+    batch.setValuesChangedCallback ([this] (Span<const int> ids, Span<const float> values)
+    {
+        for (size_t i = 0; i < ids.size(); ++i)
+            items[(size_t) ids[i]].setAlpha (values[i]);
+    });
+
+    updater.addAnimator (batch.getAnimator());
+    @endcode
+
+    @see ValueAnimatorBuilder, Easings, VBlankAnimatorUpdater
+
+    @tags{Animations}
+*/
+class JUCE_API  ValueAnimationBatch
+{
+public:
+    //==============================================================================
+    /** Creates a batch whose animations follow the cubic bezier curve with the given
+        control points. The x coordinates must be in the range 0 to 1.
+    */
+    explicit ValueAnimationBatch (Point<float> controlPoint1 = { 0.0f, 0.0f },
+                                  Point<float> controlPoint2 = { 1.0f, 1.0f });
+
+    /** Destructor. */
+    ~ValueAnimationBatch();
+
+    //==============================================================================
+    /** The type of the callback that receives the values of all running animations after
+        each update. The two spans have the same size, and values[i] belongs to the animation
+        whose ID is ids[i]. The order of the animations isn't specified.
+
+        As with ValueAnimatorBuilder, each animation reports a value of 0.0 in the update after
+        it was started, and its last reported value is 1.0.
+    */
+    using ValuesChangedCallback = std::function<void (Span<const int> ids, Span<const float> values)>;
+
+    /** The type of the callback that receives the IDs of the animations that completed during
+        an update. It's called after the ValuesChangedCallback that reported their final values.
+    */
+    using CompletedCallback = std::function<void (Span<const int> ids)>;
+
+    /** Sets the callback that receives all the values once per update. */
+    void setValuesChangedCallback (ValuesChangedCallback callback);
+
+    /** Sets the callback that receives the IDs of completed animations. */
+    void setOnCompleteCallback (CompletedCallback callback);
+
+    //==============================================================================
+    /** Adds an animation that will take the given time to progress from 0.0 to 1.0, starting
+        at the next update. Returns an ID for it, which will be reused once the animation has
+        completed or been removed. IDs are small non-negative numbers, so they can be used as
+        indices into the caller's own arrays.
+    */
+    int start (double durationMs);
+
+    /** Makes an animation report a value of 1.0 and complete at the next update. */
+    void complete (int id);
+
+    /** Removes an animation without completing it. */
+    void remove (int id);
+
+    /** Returns true if an animation with this ID is running. */
+    bool isRunning (int id) const;
+
+    /** Returns the number of animations that are running. */
+    int getNumRunning() const noexcept;
+
+    //==============================================================================
+    /** Returns the Animator that updates the whole batch. */
+    Animator getAnimator() const;
+
+    /** Updates every animation, and calls the callbacks. This is normally called by the
+        Animator returned from getAnimator().
+    */
+    void update (double timestampMs);
+
+private:
+    //==============================================================================
+    class BatchAnimator;
+
+    void ease (int numValues);
+    void removeAt (size_t index);
+    void applyPendingChanges();
+
+    struct Curve
+    {
+        float ax, bx, cx, ay, by, cy;
+        bool isLinear;
+    };
+
+    Curve curve;
+
+    std::vector<int> ids;
+    std::vector<double> startTimes, inverseDurations;
+    std::vector<float> progress, values, low, high;
+    std::vector<uint8> shouldComplete;
+    std::vector<int> indexForId, freeIds, completedIds;
+    std::vector<std::pair<int, double>> pendingStarts;
+    std::vector<int> pendingRemovals;
+    bool isUpdating = false;
+
+    ValuesChangedCallback valuesChanged;
+    CompletedCallback onComplete;
+
+    std::shared_ptr<BatchAnimator> impl;
+    Animator animator;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueAnimationBatch)
+};
+
+} // namespace juce
@@ -68,3 +68,4 @@ JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 #include "animation/juce_AnimatorUpdater.cpp"
 #include "animation/juce_Easings.cpp"
 #include "animation/juce_ValueAnimatorBuilder.cpp"
+#include "animation/juce_ValueAnimationBatch.cpp"
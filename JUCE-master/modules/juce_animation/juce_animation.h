@@ -73,4 +73,5 @@
 #include "animation/juce_Easings.h"
 #include "animation/juce_StaticAnimationLimits.h"
 #include "animation/juce_ValueAnimatorBuilder.h"
+#include "animation/juce_ValueAnimationBatch.h"
 #include "animation/juce_VBlankAnimatorUpdater.h"
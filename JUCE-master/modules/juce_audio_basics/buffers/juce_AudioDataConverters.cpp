@@ -461,6 +461,304 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
                                     numSamples);
 }
 
+//==============================================================================
+namespace VectorisedConversionHelpers
+{
+    // Every integer format is read as a left-justified 32-bit value, which converts to a
+    // float exactly as the per-sample code does, because the scale factors are powers of two.
+    constexpr float int32ToFloatScale = 1.0f / 2147483648.0f;
+
+    template <typename LoadFn>
+    static void convertToFloat (float* dest, int numSamples, LoadFn&& load) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto scale = _mm_set1_ps (int32ToFloatScale);
+
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_ps (dest + i, _mm_mul_ps (_mm_cvtepi32_ps (_mm_set_epi32 (load (i + 3), load (i + 2), load (i + 1), load (i))), scale));
+       #elif JUCE_USE_ARM_NEON
+        const auto scale = vdupq_n_f32 (int32ToFloatScale);
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const int32 lanes[] { load (i), load (i + 1), load (i + 2), load (i + 3) };
+            vst1q_f32 (dest + i, vmulq_f32 (vcvtq_f32_s32 (vld1q_s32 (lanes)), scale));
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+            dest[i] = (float) load (i) * int32ToFloatScale;
+    }
+
+    static auto int16Loader (const uint8* source, int stride) noexcept
+    {
+        const auto byteStride = (size_t) stride * 2;
+
+        return [=] (int i)
+        {
+            return (int32) ((uint32) readUnaligned<uint16> (source + (size_t) i * byteStride) << 16);
+        };
+    }
+
+    // After the first sample, each one is read as the 32-bit word that ends with it, which
+    // means that the reads never go past the end of the data.
+    static auto int24Loader (const uint8* source, int stride) noexcept
+    {
+        const auto byteStride = (size_t) stride * 3;
+
+        return [=] (int i)
+        {
+            if (i == 0)
+                return (int32) ((uint32) ByteOrder::littleEndian24Bit (source) << 8);
+
+            return (int32) (readUnaligned<uint32> (source + (size_t) i * byteStride - 1) & 0xffffff00u);
+        };
+    }
+
+    static auto int32Loader (const uint8* source, int stride) noexcept
+    {
+        const auto byteStride = (size_t) stride * 4;
+
+        return [=] (int i)
+        {
+            return readUnaligned<int32> (source + (size_t) i * byteStride);
+        };
+    }
+
+    static void int16ToFloat (float* dest, const uint8* source, int stride, int numSamples) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        if (stride == 1)
+        {
+            int i = 0;
+            const auto scale = _mm_set1_ps (int32ToFloatScale);
+            const auto zero = _mm_setzero_si128();
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const auto samples = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + 2 * i));
+                _mm_storeu_ps (dest + i,     _mm_mul_ps (_mm_cvtepi32_ps (_mm_unpacklo_epi16 (zero, samples)), scale));
+                _mm_storeu_ps (dest + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (_mm_unpackhi_epi16 (zero, samples)), scale));
+            }
+
+            dest += i;
+            source += 2 * i;
+            numSamples -= i;
+        }
+       #endif
+
+        convertToFloat (dest, numSamples, int16Loader (source, stride));
+    }
+
+    template <typename LoadFn>
+    static void copyToInt32 (int32* dest, int numSamples, LoadFn&& load) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = load (i);
+    }
+
+    static void int16ToInt32 (int32* dest, const uint8* source, int stride, int numSamples) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        if (stride == 1)
+        {
+            int i = 0;
+            const auto zero = _mm_setzero_si128();
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const auto samples = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + 2 * i));
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i),     _mm_unpacklo_epi16 (zero, samples));
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i + 4), _mm_unpackhi_epi16 (zero, samples));
+            }
+
+            dest += i;
+            source += 2 * i;
+            numSamples -= i;
+        }
+       #endif
+
+        copyToInt32 (dest, numSamples, int16Loader (source, stride));
+    }
+
+    static void floatToFloat (float* dest, const float* source, int stride, int numSamples) noexcept
+    {
+        if (stride == 1)
+        {
+            memcpy (dest, source, (size_t) numSamples * sizeof (float));
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = source[(size_t) i * (size_t) stride];
+    }
+
+    //==============================================================================
+    // Matches the rounding and clipping of Int16::setAsFloat() and Int24::setAsFloat().
+    template <int maxValue, typename StoreFn>
+    static void convertFromFloatRounded (const float* source, int numSamples, StoreFn&& store) noexcept
+    {
+        constexpr auto scale = 1.0f + (float) maxValue;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto vScale = _mm_set1_ps (scale);
+        const auto vMax = _mm_set1_ps ((float) maxValue);
+        const auto vMin = _mm_set1_ps ((float) -maxValue);
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const auto scaled = _mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (source + i), vScale), vMin), vMax);
+
+            int32 lanes[4];
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (lanes), _mm_cvtps_epi32 (scaled));
+
+            for (int j = 0; j < 4; ++j)
+                store (i + j, lanes[j]);
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+            store (i, jlimit (-maxValue, maxValue, roundToInt (source[i] * (1.0 + (double) maxValue))));
+    }
+
+    static void floatToInt16 (uint8* dest, int stride, const float* source, int numSamples) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        if (stride == 1)
+        {
+            int i = 0;
+            const auto scale = _mm_set1_ps (32768.0f);
+            const auto vMax = _mm_set1_ps (32767.0f);
+            const auto vMin = _mm_set1_ps (-32767.0f);
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const auto a = _mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (source + i),     scale), vMin), vMax);
+                const auto b = _mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (source + i + 4), scale), vMin), vMax);
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + 2 * i), _mm_packs_epi32 (_mm_cvtps_epi32 (a), _mm_cvtps_epi32 (b)));
+            }
+
+            dest += 2 * i;
+            source += i;
+            numSamples -= i;
+        }
+       #endif
+
+        const auto byteStride = (size_t) stride * 2;
+
+        convertFromFloatRounded<0x7fff> (source, numSamples, [=] (int i, int32 value)
+        {
+            writeUnaligned<uint16> (dest + (size_t) i * byteStride, (uint16) value);
+        });
+    }
+
+    static void floatToInt24 (uint8* dest, int stride, const float* source, int numSamples) noexcept
+    {
+        const auto byteStride = (size_t) stride * 3;
+
+        convertFromFloatRounded<0x7fffff> (source, numSamples, [=] (int i, int32 value)
+        {
+            ByteOrder::littleEndian24BitToChars (value, dest + (size_t) i * byteStride);
+        });
+    }
+
+    // Matches Int32::setAsFloat(), which clips, then scales and truncates in double precision.
+    static void floatToInt32 (uint8* dest, int stride, const float* source, int numSamples) noexcept
+    {
+        const auto byteStride = (size_t) stride * 4;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto scale = _mm_set1_pd ((double) 0x7fffffff);
+        const auto one = _mm_set1_ps (1.0f);
+        const auto minusOne = _mm_set1_ps (-1.0f);
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const auto clipped = _mm_min_ps (_mm_max_ps (_mm_loadu_ps (source + i), minusOne), one);
+            const auto low  = _mm_cvttpd_epi32 (_mm_mul_pd (_mm_cvtps_pd (clipped), scale));
+            const auto high = _mm_cvttpd_epi32 (_mm_mul_pd (_mm_cvtps_pd (_mm_movehl_ps (clipped, clipped)), scale));
+
+            int32 lanes[4];
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (lanes), _mm_unpacklo_epi64 (low, high));
+
+            for (int j = 0; j < 4; ++j)
+                writeUnaligned<int32> (dest + (size_t) (i + j) * byteStride, lanes[j]);
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+            writeUnaligned<int32> (dest + (size_t) i * byteStride, (int32) ((double) 0x7fffffff * jlimit (-1.0, 1.0, (double) source[i])));
+    }
+
+    static void floatToFloat (float* dest, int stride, const float* source, int numSamples) noexcept
+    {
+        if (stride == 1)
+        {
+            memcpy (dest, source, (size_t) numSamples * sizeof (float));
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[(size_t) i * (size_t) stride] = source[i];
+    }
+}
+
+void AudioData::VectorisedConversions::toFloat (float* dest, const void* source, Format sourceFormat,
+                                                int sourceStride, int numSamples) noexcept
+{
+    using namespace VectorisedConversionHelpers;
+    auto* bytes = static_cast<const uint8*> (source);
+
+    switch (sourceFormat)
+    {
+        case int16:     int16ToFloat (dest, bytes, sourceStride, numSamples); break;
+        case int24:     convertToFloat (dest, numSamples, int24Loader (bytes, sourceStride)); break;
+        case int32:     convertToFloat (dest, numSamples, int32Loader (bytes, sourceStride)); break;
+        case float32:   floatToFloat (dest, static_cast<const float*> (source), sourceStride, numSamples); break;
+        case none:
+        default:        jassertfalse; break;
+    }
+}
+
+void AudioData::VectorisedConversions::toInt32 (void* dest, const void* source, Format sourceFormat,
+                                                int sourceStride, int numSamples) noexcept
+{
+    using namespace VectorisedConversionHelpers;
+    auto* ints = static_cast<juce::int32*> (dest);
+    auto* bytes = static_cast<const uint8*> (source);
+
+    switch (sourceFormat)
+    {
+        case int16:     int16ToInt32 (ints, bytes, sourceStride, numSamples); break;
+        case int24:     copyToInt32 (ints, numSamples, int24Loader (bytes, sourceStride)); break;
+        case int32:     copyToInt32 (ints, numSamples, int32Loader (bytes, sourceStride)); break;
+        case float32:
+        case none:
+        default:        jassertfalse; break;
+    }
+}
+
+void AudioData::VectorisedConversions::fromFloat (void* dest, Format destFormat, int destStride,
+                                                  const float* source, int numSamples) noexcept
+{
+    using namespace VectorisedConversionHelpers;
+    auto* bytes = static_cast<uint8*> (dest);
+
+    switch (destFormat)
+    {
+        case int16:     floatToInt16 (bytes, destStride, source, numSamples); break;
+        case int24:     floatToInt24 (bytes, destStride, source, numSamples); break;
+        case int32:     floatToInt32 (bytes, destStride, source, numSamples); break;
+        case float32:   floatToFloat (static_cast<float*> (dest), destStride, source, numSamples); break;
+        case none:
+        default:        jassertfalse; break;
+    }
+}
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -576,9 +874,92 @@ public:
         }
     };
 
+    template <class F>
+    static void testVectorisedConversions (UnitTest& unitTest, Random& r)
+    {
+        using Contiguous = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+        using ConstContiguous = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+        using Packed = AudioData::Pointer<F, AudioData::LittleEndian, AudioData::Interleaved, AudioData::NonConst>;
+        using ConstPacked = AudioData::Pointer<F, AudioData::LittleEndian, AudioData::Interleaved, AudioData::Const>;
+
+        for (auto numChannels : { 1, 2, 3, 8 })
+        {
+            const auto numSamples = 1 + r.nextInt (300);
+            HeapBlock<char> packed ((size_t) (numSamples * numChannels * Packed::getBytesPerSample()), true);
+            std::vector<float> floats ((size_t) numSamples), expected ((size_t) numSamples), actual ((size_t) numSamples);
+
+            for (auto& f : floats)
+                f = r.nextFloat() * 2.4f - 1.2f;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                // float -> packed, on the vectorised path and one sample at a time
+                Packed (addBytesToPointer (packed.get(), ch * Packed::getBytesPerSample()), numChannels)
+                    .convertSamples (ConstContiguous (floats.data()), numSamples);
+
+                {
+                    Packed p (addBytesToPointer (packed.get(), ch * Packed::getBytesPerSample()), numChannels);
+                    std::vector<char> single ((size_t) Packed::getBytesPerSample());
+                    Packed s (single.data(), 1);
+                    bool allMatch = true;
+
+                    for (int i = 0; i < numSamples; ++i, ++p)
+                    {
+                        s.setAsFloat (floats[(size_t) i]);
+                        allMatch = allMatch && memcmp (p.getRawData(), single.data(), single.size()) == 0;
+                    }
+
+                    unitTest.expect (allMatch);
+                }
+
+                // packed -> float
+                Contiguous (actual.data()).convertSamples (ConstPacked (addBytesToPointer (packed.get(), ch * Packed::getBytesPerSample()), numChannels),
+                                                           numSamples);
+
+                ConstPacked p (addBytesToPointer (packed.get(), ch * Packed::getBytesPerSample()), numChannels);
+
+                for (auto& e : expected)
+                {
+                    e = p.getAsFloat();
+                    ++p;
+                }
+
+                unitTest.expect (memcmp (expected.data(), actual.data(), expected.size() * sizeof (float)) == 0);
+
+                // packed -> int32
+                if constexpr (! std::is_same_v<F, AudioData::Float32>)
+                {
+                    using Int32Contiguous = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+
+                    std::vector<int32> ints ((size_t) numSamples);
+                    Int32Contiguous (ints.data()).convertSamples (ConstPacked (addBytesToPointer (packed.get(), ch * Packed::getBytesPerSample()), numChannels),
+                                                                  numSamples);
+
+                    ConstPacked q (addBytesToPointer (packed.get(), ch * Packed::getBytesPerSample()), numChannels);
+                    bool allMatch = true;
+
+                    for (auto value : ints)
+                    {
+                        allMatch = allMatch && value == q.getAsInt32();
+                        ++q;
+                    }
+
+                    unitTest.expect (allMatch);
+                }
+            }
+        }
+    }
+
     void runTest() override
     {
         auto r = getRandom();
+
+        beginTest ("Vectorised conversions match per-sample conversions");
+        testVectorisedConversions<AudioData::Int16>   (*this, r);
+        testVectorisedConversions<AudioData::Int24>   (*this, r);
+        testVectorisedConversions<AudioData::Int32>   (*this, r);
+        testVectorisedConversions<AudioData::Float32> (*this, r);
+
         beginTest ("Round-trip conversion: Int8");
         Test1 <AudioData::Int8>::test (*this, r);
         beginTest ("Round-trip conversion: Int16");
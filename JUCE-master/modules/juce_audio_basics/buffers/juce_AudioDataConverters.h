@@ -332,6 +332,36 @@ public:
         static void* toVoidPtr (VoidType* v) noexcept { return const_cast<void*> (v); }
         enum { isConst = 1 };
     };
+
+    //==============================================================================
+    // Vectorised conversions that Pointer::convertSamples() uses when converting between
+    // contiguous native floats and little-endian 16, 24 or 32-bit integer or float samples,
+    // which may be interleaved, and when widening integer samples into contiguous native
+    // 32-bit integers. The strides are in samples. These give exactly the same results as
+    // the generic per-sample conversions.
+    struct JUCE_API  VectorisedConversions
+    {
+        enum Format { none = -1, int16, int24, int32, float32 };
+
+        template <class SampleFormat, class Endianness>
+        static constexpr Format getFormat() noexcept
+        {
+           #if JUCE_BIG_ENDIAN
+            return none;
+           #else
+            if constexpr (! std::is_base_of_v<LittleEndian, Endianness>)  return none;
+            else if constexpr (std::is_same_v<SampleFormat, Int16>)       return int16;
+            else if constexpr (std::is_same_v<SampleFormat, Int24>)       return int24;
+            else if constexpr (std::is_same_v<SampleFormat, Int32>)       return int32;
+            else if constexpr (std::is_same_v<SampleFormat, Float32>)     return float32;
+            else                                                          return none;
+           #endif
+        }
+
+        static void toFloat (float* dest, const void* source, Format sourceFormat, int sourceStride, int numSamples) noexcept;
+        static void fromFloat (void* dest, Format destFormat, int destStride, const float* source, int numSamples) noexcept;
+        static void toInt32 (void* dest, const void* source, Format sourceFormat, int sourceStride, int numSamples) noexcept;
+    };
   #endif
 
     //==============================================================================
@@ -476,6 +506,15 @@ public:
             // trying to write to a const pointer! For a writeable one, use AudioData::NonConst instead!
             static_assert (Constness::isConst == 0, "Attempt to write to a const pointer");
 
+            if constexpr (canConvertVectorised<OtherPointerType>())
+            {
+                if (source.getRawData() != getRawData())
+                {
+                    convertVectorised (source, numSamples);
+                    return;
+                }
+            }
+
             Pointer dest (*this);
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
@@ -582,10 +621,44 @@ public:
 
     private:
         //==============================================================================
+        template <class, class, class, class> friend class Pointer;
+
         SampleFormat data;
 
+        static constexpr auto vectorisedFormat = VectorisedConversions::getFormat<SampleFormat, Endianness>();
+        static constexpr bool isContiguous = InterleavingType::isInterleavedType == 0;
+
         inline void advance() noexcept                          { this->advanceData (data); }
 
+        template <class OtherPointerType>
+        static constexpr bool canConvertVectorised() noexcept
+        {
+            if constexpr (isContiguous && vectorisedFormat == VectorisedConversions::float32)
+                return OtherPointerType::vectorisedFormat != VectorisedConversions::none;
+            else if constexpr (isContiguous && vectorisedFormat == VectorisedConversions::int32
+                                && OtherPointerType::vectorisedFormat != VectorisedConversions::float32)
+                return OtherPointerType::vectorisedFormat != VectorisedConversions::none;
+            else
+                return vectorisedFormat != VectorisedConversions::none
+                        && OtherPointerType::isContiguous
+                        && OtherPointerType::vectorisedFormat == VectorisedConversions::float32;
+        }
+
+        template <class OtherPointerType>
+        void convertVectorised (const OtherPointerType& source, int numSamples) const noexcept
+        {
+            if constexpr (isContiguous && vectorisedFormat == VectorisedConversions::float32)
+                VectorisedConversions::toFloat (data.data, source.getRawData(), OtherPointerType::vectorisedFormat,
+                                                source.getNumInterleavedChannels(), numSamples);
+            else if constexpr (isContiguous && vectorisedFormat == VectorisedConversions::int32
+                                && OtherPointerType::vectorisedFormat != VectorisedConversions::float32)
+                VectorisedConversions::toInt32 (data.data, source.getRawData(), OtherPointerType::vectorisedFormat,
+                                                source.getNumInterleavedChannels(), numSamples);
+            else
+                VectorisedConversions::fromFloat (data.data, vectorisedFormat, getNumInterleavedChannels(),
+                                                  static_cast<const float*> (source.getRawData()), numSamples);
+        }
+
         Pointer operator++ (int); // private to force you to use the more efficient pre-increment!
         Pointer operator-- (int);
     };
@@ -35,7 +35,11 @@
 namespace juce
 {
 
-AudioProcessLoadMeasurer::AudioProcessLoadMeasurer()  = default;
+AudioProcessLoadMeasurer::AudioProcessLoadMeasurer()
+{
+    clearStatisticsLocked();
+}
+
 AudioProcessLoadMeasurer::~AudioProcessLoadMeasurer() = default;
 
 void AudioProcessLoadMeasurer::reset()
@@ -52,6 +56,33 @@ void AudioProcessLoadMeasurer::reset (double sampleRate, int blockSize)
 
     samplesPerBlock = blockSize;
     msPerSample = (sampleRate > 0.0 && blockSize > 0) ? 1000.0 / sampleRate : 0;
+
+    clearStatisticsLocked();
+}
+
+void AudioProcessLoadMeasurer::setStatisticsWindow (double seconds)
+{
+    const SpinLock::ScopedLockType lock (mutex);
+
+    statisticsWindowSeconds = jmax (0.0, seconds);
+    clearStatisticsLocked();
+}
+
+void AudioProcessLoadMeasurer::clearStatisticsLocked()
+{
+    for (auto& histogram : histograms)
+    {
+        for (auto& count : histogram.counts)
+            count = 0;
+
+        histogram.peak = 0;
+    }
+
+    currentHistogram = 0;
+    samplesInSubWindow = 0;
+    samplesPerSubWindow = approximatelyEqual (msPerSample, 0.0)
+                            ? 0
+                            : (int64) (statisticsWindowSeconds * 1000.0 / (msPerSample * numStatisticsSubWindows));
 }
 
 void AudioProcessLoadMeasurer::registerBlockRenderTime (double milliseconds)
@@ -72,7 +103,8 @@ void AudioProcessLoadMeasurer::registerRenderTime (double milliseconds, int numS
 
 void AudioProcessLoadMeasurer::registerRenderTimeLocked (double milliseconds, int numSamples)
 {
-    if (approximatelyEqual (msPerSample, 0.0))
+    // Empty blocks, which some hosts use to flush parameter changes, don't count
+    if (approximatelyEqual (msPerSample, 0.0) || numSamples <= 0)
         return;
 
     const auto maxMilliseconds = numSamples * msPerSample;
@@ -83,6 +115,93 @@ void AudioProcessLoadMeasurer::registerRenderTimeLocked (double milliseconds, in
 
     if (milliseconds > maxMilliseconds)
         ++xruns;
+
+    // When a window is set, the histogram is split into sub-windows, and the oldest
+    // one is cleared each time the current one fills up.
+    if (samplesPerSubWindow > 0 && samplesInSubWindow >= samplesPerSubWindow)
+    {
+        currentHistogram = (currentHistogram + 1) % numStatisticsSubWindows;
+        samplesInSubWindow = 0;
+
+        auto& oldest = histograms[(size_t) currentHistogram];
+
+        for (auto& count : oldest.counts)
+            count.store (0, std::memory_order_relaxed);
+
+        oldest.peak.store (0, std::memory_order_relaxed);
+    }
+
+    auto& histogram = histograms[(size_t) currentHistogram];
+    const auto bin = jlimit (0, numHistogramBins - 1, (int) (usedProportion * histogramBinsPerUnitLoad));
+    histogram.counts[(size_t) bin].fetch_add (1, std::memory_order_relaxed);
+
+    if (usedProportion > histogram.peak.load (std::memory_order_relaxed))
+        histogram.peak.store (usedProportion, std::memory_order_relaxed);
+
+    samplesInSubWindow += numSamples;
+}
+
+//==============================================================================
+int64 AudioProcessLoadMeasurer::getHistogramCounts (HistogramCounts& counts, double& peak) const
+{
+    int64 total = 0;
+    peak = 0;
+
+    for (auto& histogram : histograms)
+    {
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            const auto count = histogram.counts[i].load (std::memory_order_relaxed);
+            counts[i] += count;
+            total += count;
+        }
+
+        peak = jmax (peak, histogram.peak.load (std::memory_order_relaxed));
+    }
+
+    return total;
+}
+
+static double getPercentileFromCounts (const std::array<int64, AudioProcessLoadMeasurer::numHistogramBins>& counts,
+                                       int64 total, double peak, double percentile)
+{
+    if (total == 0)
+        return 0;
+
+    const auto target = jmax ((int64) 1, (int64) std::ceil ((double) total * jlimit (0.0, 100.0, percentile) / 100.0));
+    int64 cumulative = 0;
+
+    // Values are rounded up to the top of their bin, except in the last bin, which has no upper bound
+    for (size_t i = 0; i < counts.size() - 1; ++i)
+    {
+        cumulative += counts[i];
+
+        if (cumulative >= target)
+            return jmin (peak, (double) (i + 1) / AudioProcessLoadMeasurer::histogramBinsPerUnitLoad);
+    }
+
+    return peak;
+}
+
+AudioProcessLoadMeasurer::LoadStatistics AudioProcessLoadMeasurer::getLoadStatistics() const
+{
+    HistogramCounts counts {};
+    LoadStatistics stats;
+    stats.numBlocks = getHistogramCounts (counts, stats.peak);
+
+    stats.p50  = getPercentileFromCounts (counts, stats.numBlocks, stats.peak, 50.0);
+    stats.p99  = getPercentileFromCounts (counts, stats.numBlocks, stats.peak, 99.0);
+    stats.p999 = getPercentileFromCounts (counts, stats.numBlocks, stats.peak, 99.9);
+    return stats;
+}
+
+double AudioProcessLoadMeasurer::getLoadPercentile (double percentile) const
+{
+    HistogramCounts counts {};
+    double peak = 0;
+    const auto total = getHistogramCounts (counts, peak);
+
+    return getPercentileFromCounts (counts, total, peak, percentile);
 }
 
 double AudioProcessLoadMeasurer::getLoadAsProportion() const   { return jlimit (0.0, 1.0, cpuUsageProportion.load()); }
@@ -93,14 +212,14 @@ int AudioProcessLoadMeasurer::getXRunCount() const             { return xruns; }
 AudioProcessLoadMeasurer::ScopedTimer::ScopedTimer (AudioProcessLoadMeasurer& p)
     : ScopedTimer (p, p.samplesPerBlock)
 {
+    // The block size should never be zero. Did you remember to call AudioProcessLoadMeasurer::reset(),
+    // passing the expected samples per block?
+    jassert (samplesInBlock);
 }
 
 AudioProcessLoadMeasurer::ScopedTimer::ScopedTimer (AudioProcessLoadMeasurer& p, int numSamplesInBlock)
     : owner (p), startTime (Time::getMillisecondCounterHiRes()), samplesInBlock (numSamplesInBlock)
 {
-    // numSamplesInBlock should never be zero. Did you remember to call AudioProcessLoadMeasurer::reset(),
-    // passing the expected samples per block?
-    jassert (numSamplesInBlock);
 }
 
 AudioProcessLoadMeasurer::ScopedTimer::~ScopedTimer()
@@ -108,4 +227,83 @@ AudioProcessLoadMeasurer::ScopedTimer::~ScopedTimer()
     owner.registerRenderTime (Time::getMillisecondCounterHiRes() - startTime, samplesInBlock);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessLoadMeasurerTests final : public UnitTest
+{
+public:
+    AudioProcessLoadMeasurerTests()
+        : UnitTest ("AudioProcessLoadMeasurer", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        // One sample per millisecond, so a 10 sample block has 10ms available
+        beginTest ("Percentiles show occasional spikes");
+        {
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (1000.0, 10);
+
+            for (int i = 0; i < 990; ++i)
+                measurer.registerRenderTime (1.0, 10);
+
+            for (int i = 0; i < 9; ++i)
+                measurer.registerRenderTime (5.0, 10);
+
+            measurer.registerRenderTime (20.0, 10);
+
+            const auto stats = measurer.getLoadStatistics();
+            expectEquals (stats.numBlocks, (int64) 1000);
+            expectWithinAbsoluteError (stats.p50, 0.1, binWidth);
+            expectWithinAbsoluteError (stats.p99, 0.1, binWidth);
+            expectWithinAbsoluteError (stats.p999, 0.5, binWidth);
+            expect (exactlyEqual (stats.peak, 2.0));
+            expect (exactlyEqual (measurer.getLoadPercentile (100.0), 2.0));
+            expectEquals (measurer.getXRunCount(), 1);
+
+            measurer.reset (1000.0, 10);
+            expectEquals (measurer.getLoadStatistics().numBlocks, (int64) 0);
+            expect (exactlyEqual (measurer.getLoadPercentile (99.0), 0.0));
+        }
+
+        beginTest ("Statistics window forgets old blocks");
+        {
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (1000.0, 10);
+            measurer.setStatisticsWindow (1.0);
+
+            for (int i = 0; i < 200; ++i)
+                measurer.registerRenderTime (9.0, 10);
+
+            expectWithinAbsoluteError (measurer.getLoadPercentile (50.0), 0.9, binWidth);
+
+            for (int i = 0; i < 200; ++i)
+                measurer.registerRenderTime (1.0, 10);
+
+            const auto stats = measurer.getLoadStatistics();
+            expect (stats.numBlocks >= 88 && stats.numBlocks <= 113);
+            expect (exactlyEqual (stats.peak, 0.1));
+        }
+
+        beginTest ("Empty blocks are ignored");
+        {
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (1000.0, 10);
+            measurer.registerRenderTime (1.0, 0);
+
+            expectEquals (measurer.getLoadStatistics().numBlocks, (int64) 0);
+            expectEquals (measurer.getXRunCount(), 0);
+        }
+    }
+
+private:
+    static constexpr double binWidth = 1.0 / AudioProcessLoadMeasurer::histogramBinsPerUnitLoad;
+};
+
+static AudioProcessLoadMeasurerTests audioProcessLoadMeasurerTests;
+
+#endif
+
 } // namespace juce
@@ -40,6 +40,12 @@ namespace juce
     Maintains an ongoing measurement of the proportion of time which is being
     spent inside an audio callback.
 
+    As well as a smoothed average, the measurer keeps a histogram of the load of
+    every block, from which percentiles such as the 99th or 99.9th can be read.
+    These show the occasional spikes that cause dropouts, which an average hides.
+    The histogram uses a fixed amount of memory, and can cover either everything
+    since the last reset or a sliding window of recent audio - see setStatisticsWindow().
+
     @tags{Audio}
 */
 class JUCE_API  AudioProcessLoadMeasurer
@@ -67,6 +73,56 @@ public:
     /** Returns the number of over- (or under-) runs recorded since the state was reset. */
     int getXRunCount() const;
 
+    //==============================================================================
+    /** A summary of the distribution of per-block loads, each value being a
+        proportion of the time available for the block.
+
+        Values greater than 1.0 mean that blocks took longer than the audio they
+        were rendering.
+    */
+    struct LoadStatistics
+    {
+        double p50 = 0, p99 = 0, p999 = 0, peak = 0;
+        int64 numBlocks = 0;
+    };
+
+    /** Returns the median, 99th and 99.9th percentile and peak load of the blocks within
+        the current statistics window.
+
+        This reads the histogram without locking, so it can be called from any thread.
+        Percentiles are rounded up to the resolution of the histogram, which is
+        1 / histogramBinsPerUnitLoad.
+    */
+    LoadStatistics getLoadStatistics() const;
+
+    /** Returns the load, as a proportion, below which the given percentage of the blocks
+        within the current statistics window fell.
+
+        For example, getLoadPercentile (99.0) returns the 99th percentile.
+    */
+    double getLoadPercentile (double percentile) const;
+
+    /** Sets the length of audio, in seconds, that the load statistics cover.
+
+        The statistics will then approximately describe the most recent blocks that add up to
+        this length of audio. A value of 0 (the default) makes them cover every block since
+        the last reset. Calling this clears the statistics.
+    */
+    void setStatisticsWindow (double seconds);
+
+    /** Returns the length of audio covered by the load statistics, or 0 if they cover every
+        block since the last reset.
+    */
+    double getStatisticsWindow() const noexcept         { return statisticsWindowSeconds; }
+
+    /** The number of histogram bins covering each unit of load. */
+    static constexpr int histogramBinsPerUnitLoad = 64;
+
+    /** The number of histogram bins. Loads beyond the range of the histogram are all
+        counted in the last bin.
+    */
+    static constexpr int numHistogramBins = 2 * histogramBinsPerUnitLoad;
+
     //==============================================================================
     /** This class measures the time between its construction and destruction and
         adds it to an AudioProcessLoadMeasurer.
@@ -109,12 +165,29 @@ public:
 
 private:
     void registerRenderTimeLocked (double, int);
+    void clearStatisticsLocked();
+
+    using HistogramCounts = std::array<int64, numHistogramBins>;
+    int64 getHistogramCounts (HistogramCounts&, double& peak) const;
+
+    struct Histogram
+    {
+        std::array<std::atomic<uint32>, numHistogramBins> counts;
+        std::atomic<double> peak { 0 };
+    };
+
+    static constexpr int numStatisticsSubWindows = 8;
 
     SpinLock mutex;
     int samplesPerBlock = 0;
     double msPerSample = 0;
     std::atomic<double> cpuUsageProportion { 0 };
     std::atomic<int> xruns { 0 };
+
+    std::array<Histogram, numStatisticsSubWindows> histograms;
+    int currentHistogram = 0;
+    int64 samplesPerSubWindow = 0, samplesInSubWindow = 0;
+    std::atomic<double> statisticsWindowSeconds { 0 };
 };
 
 
@@ -743,13 +743,7 @@ public:
             return;
 
         const auto increment = (endGain - startGain) / (float) numSamples;
-        auto* d = channels[channel] + startSample;
-
-        while (--numSamples >= 0)
-        {
-            *d++ *= startGain;
-            startGain += increment;
-        }
+        FloatVectorOperations::multiplyWithRamp (channels[channel] + startSample, startGain, increment, numSamples);
     }
 
     /** Applies a range of gains to a region of all channels.
@@ -897,14 +891,8 @@ public:
 
         isClear = false;
         const auto increment = (endGain - startGain) / (Type) numSamples;
-        auto* d = channels[destChannel] + destStartSample;
-
-        while (--numSamples >= 0)
-        {
-            *d++ += startGain * *source++;
-            startGain += increment;
-        }
-}
+        FloatVectorOperations::addWithRamp (channels[destChannel] + destStartSample, source, startGain, increment, numSamples);
+    }
 
     /** Copies samples from another buffer to this one.
 
@@ -1045,13 +1033,7 @@ public:
 
         isClear = false;
         const auto increment = (endGain - startGain) / (Type) numSamples;
-        auto* d = channels[destChannel] + destStartSample;
-
-        while (--numSamples >= 0)
-        {
-            *d++ = startGain * *source++;
-            startGain += increment;
-        }
+        FloatVectorOperations::copyWithRamp (channels[destChannel] + destStartSample, source, startGain, increment, numSamples);
     }
 
     /** Returns a Range indicating the lowest and highest sample values in a given section.
@@ -1107,16 +1089,8 @@ public:
         if (numSamples <= 0 || isClear || ! isPositiveAndBelow (channel, numChannels))
             return Type (0);
 
-        auto* data = channels[channel] + startSample;
-        double sum = 0.0;
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            auto sample = data[i];
-            sum += sample * sample;
-        }
-
-        return static_cast<Type> (std::sqrt (sum / numSamples));
+        const auto sum = FloatVectorOperations::sumOfSquares (channels[channel] + startSample, numSamples);
+        return static_cast<Type> (std::sqrt (sum / (Type) numSamples));
     }
 
     /** Reverses a part of a channel. */
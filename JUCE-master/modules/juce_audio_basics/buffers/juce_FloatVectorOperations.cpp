@@ -503,6 +503,343 @@ namespace FloatVectorHelpers
     };
    #endif
 
+   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    template <typename Mode>
+    struct Reduction
+    {
+        using Type = typename Mode::Type;
+        using ParallelType = typename Mode::ParallelType;
+
+        // The vector partial sums are moved into a double after at most this many values, so
+        // that long float buffers don't lose precision.
+        enum { blockSize = 1024 };
+
+        template <typename Size, typename VectorTerm, typename ScalarTerm>
+        static Type accumulate (Size num, VectorTerm&& vectorTerm, ScalarTerm&& scalarTerm) noexcept
+        {
+            const auto step = (Size) Mode::numParallel;
+            double total = 0;
+            Size i = 0;
+
+            while (num - i >= step)
+            {
+                const auto blockEnd = i + jmin ((Size) blockSize, num - i);
+                auto partialSums = Mode::load1 ((Type) 0);
+
+                for (; i + step <= blockEnd; i += step)
+                    partialSums = Mode::add (partialSums, vectorTerm (i));
+
+                Type lanes[Mode::numParallel];
+                Mode::storeU (lanes, partialSums);
+
+                for (auto lane : lanes)
+                    total += lane;
+            }
+
+            for (; i < num; ++i)
+                total += scalarTerm (i);
+
+            return (Type) total;
+        }
+
+        template <typename Size>
+        static Type sum (const Type* src, Size num) noexcept
+        {
+            return accumulate (num,
+                               [src] (Size i) { return Mode::loadU (src + i); },
+                               [src] (Size i) { return (double) src[i]; });
+        }
+
+        template <typename Size>
+        static Type sumOfSquares (const Type* src, Size num) noexcept
+        {
+            return accumulate (num,
+                               [src] (Size i) { const auto v = Mode::loadU (src + i); return Mode::mul (v, v); },
+                               [src] (Size i) { return (double) src[i] * (double) src[i]; });
+        }
+
+        template <typename Size>
+        static Type dotProduct (const Type* src1, const Type* src2, Size num) noexcept
+        {
+            return accumulate (num,
+                               [src1, src2] (Size i) { return Mode::mul (Mode::loadU (src1 + i), Mode::loadU (src2 + i)); },
+                               [src1, src2] (Size i) { return (double) src1[i] * (double) src2[i]; });
+        }
+    };
+
+    template <typename Mode>
+    struct Ramp
+    {
+        using Type = typename Mode::Type;
+        using ParallelType = typename Mode::ParallelType;
+
+        /*  Each gain is calculated from its index rather than by repeatedly adding the
+            increment, so that rounding errors don't accumulate over long ramps.
+        */
+        template <typename Size, typename VectorOp, typename ScalarOp>
+        static void process (Type startGain, Type increment, Size num, VectorOp&& vectorOp, ScalarOp&& scalarOp) noexcept
+        {
+            const auto step = (Size) Mode::numParallel;
+            Size i = 0;
+
+            if (num >= step)
+            {
+                Type laneIndices[Mode::numParallel];
+
+                for (int lane = 0; lane < Mode::numParallel; ++lane)
+                    laneIndices[lane] = (Type) lane;
+
+                const auto start = Mode::load1 (startGain);
+                const auto inc = Mode::load1 (increment);
+                const auto indexStep = Mode::load1 ((Type) Mode::numParallel);
+                auto indices = Mode::loadU (laneIndices);
+
+                for (; i + step <= num; i += step)
+                {
+                    vectorOp (i, Mode::add (start, Mode::mul (indices, inc)));
+                    indices = Mode::add (indices, indexStep);
+                }
+            }
+
+            for (; i < num; ++i)
+                scalarOp (i, startGain + (Type) i * increment);
+        }
+
+        template <typename Size>
+        static void multiply (Type* dest, Type startGain, Type increment, Size num) noexcept
+        {
+            process (startGain, increment, num,
+                     [dest] (Size i, ParallelType g) { Mode::storeU (dest + i, Mode::mul (Mode::loadU (dest + i), g)); },
+                     [dest] (Size i, Type g)         { dest[i] *= g; });
+        }
+
+        template <typename Size>
+        static void copy (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+        {
+            process (startGain, increment, num,
+                     [dest, src] (Size i, ParallelType g) { Mode::storeU (dest + i, Mode::mul (Mode::loadU (src + i), g)); },
+                     [dest, src] (Size i, Type g)         { dest[i] = src[i] * g; });
+        }
+
+        template <typename Size>
+        static void add (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+        {
+            process (startGain, increment, num,
+                     [dest, src] (Size i, ParallelType g) { Mode::storeU (dest + i, Mode::add (Mode::loadU (dest + i), Mode::mul (Mode::loadU (src + i), g))); },
+                     [dest, src] (Size i, Type g)         { dest[i] += src[i] * g; });
+        }
+    };
+   #endif
+
+   #if JUCE_USE_AVX_INTRINSICS && ! JUCE_USE_VDSP_FRAMEWORK
+    #define JUCE_USE_AVX_DISPATCH 1
+
+    /*  The AVX2 and AVX-512 kernels below are compiled for instruction sets that the rest of
+        the binary can't assume are available, so they must only ever be reached through
+        getAVXKernels(), which picks a set at runtime according to the host CPU.
+
+        They deliberately use separate multiplies and adds rather than FMA, so that their
+        results are bit-identical to the SSE versions.
+    */
+   #if JUCE_MSVC
+    #define JUCE_AVX2_TARGET
+    #define JUCE_AVX512_TARGET
+   #else
+    #define JUCE_AVX2_TARGET    __attribute__ ((target ("avx2")))
+    #define JUCE_AVX512_TARGET  __attribute__ ((target ("avx512f")))
+   #endif
+
+    struct AVX2Ops32
+    {
+        using ParallelType = __m256;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX2_TARGET ParallelType load1 (float v) noexcept                       { return _mm256_set1_ps (v); }
+        static forcedinline JUCE_AVX2_TARGET ParallelType loadU (const float* v) noexcept                { return _mm256_loadu_ps (v); }
+        static forcedinline JUCE_AVX2_TARGET ParallelType loadInt (const int* v) noexcept                { return _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+        static forcedinline JUCE_AVX2_TARGET void storeU (float* dest, ParallelType a) noexcept          { _mm256_storeu_ps (dest, a); }
+
+        static forcedinline JUCE_AVX2_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        static forcedinline JUCE_AVX2_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        static forcedinline JUCE_AVX2_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        static forcedinline JUCE_AVX2_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+    };
+
+    struct AVX512Ops32
+    {
+        using ParallelType = __m512;
+        enum { numParallel = 16 };
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType load1 (float v) noexcept                       { return _mm512_set1_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadU (const float* v) noexcept                { return _mm512_loadu_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadInt (const int* v) noexcept                { return _mm512_cvtepi32_ps (_mm512_loadu_si512 (v)); }
+        static forcedinline JUCE_AVX512_TARGET void storeU (float* dest, ParallelType a) noexcept          { _mm512_storeu_ps (dest, a); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_ps (a, b); }
+    };
+
+    struct AVXKernels
+    {
+        void (*addSrc) (float*, const float*, size_t) noexcept = nullptr;
+        void (*addSrc1Src2) (float*, const float*, const float*, size_t) noexcept = nullptr;
+        void (*multiplySrc) (float*, const float*, size_t) noexcept = nullptr;
+        void (*multiplySrc1Src2) (float*, const float*, const float*, size_t) noexcept = nullptr;
+        void (*multiplyScalar) (float*, float, size_t) noexcept = nullptr;
+        void (*addWithMultiplyScalar) (float*, const float*, float, size_t) noexcept = nullptr;
+        void (*addWithMultiplySrc1Src2) (float*, const float*, const float*, size_t) noexcept = nullptr;
+        void (*clip) (float*, const float*, float, float, size_t) noexcept = nullptr;
+        void (*convertFixedToFloat) (float*, const int*, float, size_t) noexcept = nullptr;
+        Range<float> (*findMinAndMax) (const float*, size_t) noexcept = nullptr;
+    };
+
+    // Below this size the SSE code is just as quick, so there's no point in the indirect call
+    constexpr size_t minNumValuesForAVX = 32;
+
+    #define JUCE_AVX_LOOP(vecOp, scalarOp) \
+        size_t i = 0; \
+        for (; i + Ops::numParallel <= num; i += Ops::numParallel) { vecOp; } \
+        for (; i < num; ++i) { scalarOp; }
+
+    #define JUCE_DEFINE_AVX_KERNELS(target) \
+        target static void addSrc (float* dest, const float* src, size_t num) noexcept \
+        { \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::add (Ops::loadU (dest + i), Ops::loadU (src + i))), \
+                           dest[i] += src[i]) \
+        } \
+        \
+        target static void addSrc1Src2 (float* dest, const float* src1, const float* src2, size_t num) noexcept \
+        { \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::add (Ops::loadU (src1 + i), Ops::loadU (src2 + i))), \
+                           dest[i] = src1[i] + src2[i]) \
+        } \
+        \
+        target static void multiplySrc (float* dest, const float* src, size_t num) noexcept \
+        { \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::mul (Ops::loadU (dest + i), Ops::loadU (src + i))), \
+                           dest[i] *= src[i]) \
+        } \
+        \
+        target static void multiplySrc1Src2 (float* dest, const float* src1, const float* src2, size_t num) noexcept \
+        { \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::mul (Ops::loadU (src1 + i), Ops::loadU (src2 + i))), \
+                           dest[i] = src1[i] * src2[i]) \
+        } \
+        \
+        target static void multiplyScalar (float* dest, float multiplier, size_t num) noexcept \
+        { \
+            const auto mult = Ops::load1 (multiplier); \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::mul (Ops::loadU (dest + i), mult)), \
+                           dest[i] *= multiplier) \
+        } \
+        \
+        target static void addWithMultiplyScalar (float* dest, const float* src, float multiplier, size_t num) noexcept \
+        { \
+            const auto mult = Ops::load1 (multiplier); \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::add (Ops::loadU (dest + i), Ops::mul (mult, Ops::loadU (src + i)))), \
+                           const auto product = src[i] * multiplier; dest[i] += product) \
+        } \
+        \
+        target static void addWithMultiplySrc1Src2 (float* dest, const float* src1, const float* src2, size_t num) noexcept \
+        { \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::add (Ops::loadU (dest + i), Ops::mul (Ops::loadU (src1 + i), Ops::loadU (src2 + i)))), \
+                           const auto product = src1[i] * src2[i]; dest[i] += product) \
+        } \
+        \
+        target static void clip (float* dest, const float* src, float low, float high, size_t num) noexcept \
+        { \
+            const auto lo = Ops::load1 (low); \
+            const auto hi = Ops::load1 (high); \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::max (Ops::min (Ops::loadU (src + i), hi), lo)), \
+                           dest[i] = jmax (jmin (src[i], high), low)) \
+        } \
+        \
+        target static void convertFixedToFloat (float* dest, const int* src, float multiplier, size_t num) noexcept \
+        { \
+            const auto mult = Ops::load1 (multiplier); \
+            JUCE_AVX_LOOP (Ops::storeU (dest + i, Ops::mul (mult, Ops::loadInt (src + i))), \
+                           dest[i] = (float) src[i] * multiplier) \
+        } \
+        \
+        target static Range<float> findMinAndMax (const float* src, size_t num) noexcept \
+        { \
+            if (num < 2 * (size_t) Ops::numParallel) \
+                return Range<float>::findMinAndMax (src, num); \
+            \
+            auto mn = Ops::loadU (src); \
+            auto mx = mn; \
+            size_t i = Ops::numParallel; \
+            \
+            for (; i + Ops::numParallel <= num; i += Ops::numParallel) \
+            { \
+                const auto v = Ops::loadU (src + i); \
+                mn = Ops::min (mn, v); \
+                mx = Ops::max (mx, v); \
+            } \
+            \
+            float mins[Ops::numParallel], maxs[Ops::numParallel]; \
+            Ops::storeU (mins, mn); \
+            Ops::storeU (maxs, mx); \
+            \
+            Range<float> result (mins[0], maxs[0]); \
+            \
+            for (int j = 1; j < Ops::numParallel; ++j) \
+                result = Range<float> (jmin (result.getStart(), mins[j]), jmax (result.getEnd(), maxs[j])); \
+            \
+            for (; i < num; ++i) \
+                result = result.getUnionWith (src[i]); \
+            \
+            return result; \
+        } \
+        \
+        static AVXKernels createKernels() noexcept \
+        { \
+            return { addSrc, addSrc1Src2, multiplySrc, multiplySrc1Src2, multiplyScalar, \
+                     addWithMultiplyScalar, addWithMultiplySrc1Src2, clip, convertFixedToFloat, findMinAndMax }; \
+        }
+
+    namespace AVX2
+    {
+        using Ops = AVX2Ops32;
+        JUCE_DEFINE_AVX_KERNELS (JUCE_AVX2_TARGET)
+    }
+
+    // Some versions of GCC's own AVX-512 headers trigger this warning
+    JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wmaybe-uninitialized")
+
+    namespace AVX512
+    {
+        using Ops = AVX512Ops32;
+        JUCE_DEFINE_AVX_KERNELS (JUCE_AVX512_TARGET)
+    }
+
+    JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+
+    #undef JUCE_DEFINE_AVX_KERNELS
+    #undef JUCE_AVX_LOOP
+
+    static const AVXKernels& getAVXKernels() noexcept
+    {
+        static const AVXKernels kernels = []
+        {
+            if (SystemStats::hasAVX512F())  return AVX512::createKernels();
+            if (SystemStats::hasAVX2())     return AVX2::createKernels();
+
+            return AVXKernels();
+        }();
+
+        return kernels;
+    }
+
+    #define JUCE_TRY_AVX_KERNEL(kernelName, ...) \
+        if (auto* kernel = getAVXKernels().kernelName; kernel != nullptr && num >= (decltype (num)) minNumValuesForAVX) \
+            return kernel (__VA_ARGS__, (size_t) num);
+   #else
+    #define JUCE_TRY_AVX_KERNEL(kernelName, ...)
+   #endif
+
 //==============================================================================
 namespace
 {
@@ -636,6 +973,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (addSrc, dest, src)
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -662,6 +1000,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (addSrc1Src2, dest, src1, src2)
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -740,6 +1079,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (addWithMultiplyScalar, dest, src, multiplier)
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -768,6 +1108,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (addWithMultiplySrc1Src2, dest, src1, src2)
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -832,6 +1173,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (multiplySrc, dest, src)
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -858,6 +1200,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (multiplySrc1Src2, dest, src1, src2)
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
                                             Mode::mul (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -884,6 +1227,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (multiplyScalar, dest, multiplier)
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -1077,6 +1421,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_TRY_AVX_KERNEL (clip, dest, src, low, high)
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1107,6 +1452,7 @@ namespace
     Range<float> findMinAndMax (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_TRY_AVX_KERNEL (findMinAndMax, src)
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
        #else
         return Range<float>::findMinAndMax (src, num);
@@ -1163,6 +1509,123 @@ namespace
        #endif
     }
 
+    template <typename Size>
+    float sum (const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_sve (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reduction<FloatVectorHelpers::BasicOps32>::sum (src, num);
+       #else
+        return (float) std::accumulate (src, src + num, 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    double sum (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_sveD (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reduction<FloatVectorHelpers::BasicOps64>::sum (src, num);
+       #else
+        return std::accumulate (src, src + num, 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    float sumOfSquares (const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_svesq (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reduction<FloatVectorHelpers::BasicOps32>::sumOfSquares (src, num);
+       #else
+        return (float) std::inner_product (src, src + num, src, 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    double sumOfSquares (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_svesqD (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reduction<FloatVectorHelpers::BasicOps64>::sumOfSquares (src, num);
+       #else
+        return std::inner_product (src, src + num, src, 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    float dotProduct (const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_dotpr (src1, 1, src2, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reduction<FloatVectorHelpers::BasicOps32>::dotProduct (src1, src2, num);
+       #else
+        return (float) std::inner_product (src1, src1 + num, src2, 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    double dotProduct (const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_dotprD (src1, 1, src2, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reduction<FloatVectorHelpers::BasicOps64>::dotProduct (src1, src2, num);
+       #else
+        return std::inner_product (src1, src1 + num, src2, 0.0);
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    void multiplyWithRamp (Type* dest, Type startGain, Type increment, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        FloatVectorHelpers::Ramp<typename FloatVectorHelpers::ModeType<sizeof (Type)>::Mode>::multiply (dest, startGain, increment, num);
+       #else
+        for (auto i = (decltype (num)) 0; i < num; ++i)
+            dest[i] *= startGain + (Type) i * increment;
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    void copyWithRamp (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        FloatVectorHelpers::Ramp<typename FloatVectorHelpers::ModeType<sizeof (Type)>::Mode>::copy (dest, src, startGain, increment, num);
+       #else
+        for (auto i = (decltype (num)) 0; i < num; ++i)
+            dest[i] = src[i] * (startGain + (Type) i * increment);
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    void addWithRamp (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        FloatVectorHelpers::Ramp<typename FloatVectorHelpers::ModeType<sizeof (Type)>::Mode>::add (dest, src, startGain, increment, num);
+       #else
+        for (auto i = (decltype (num)) 0; i < num; ++i)
+            dest[i] += src[i] * (startGain + (Type) i * increment);
+       #endif
+    }
+
     template <typename Size>
     void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
     {
@@ -1172,6 +1635,7 @@ namespace
                                   JUCE_LOAD_NONE,
                                   JUCE_INCREMENT_SRC_DEST, )
        #else
+        JUCE_TRY_AVX_KERNEL (convertFixedToFloat, dest, src, multiplier)
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
                                       Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src)))),
                                       JUCE_LOAD_NONE,
@@ -1181,6 +1645,9 @@ namespace
     }
 
 } // namespace
+
+#undef JUCE_TRY_AVX_KERNEL
+
 } // namespace FloatVectorHelpers
 
 //==============================================================================
@@ -1420,6 +1887,57 @@ FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMax
     return FloatVectorHelpers::findMaximum (src, numValues);
 }
 
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::sum (const FloatType* src,
+                                                                              CountType numValues) noexcept
+{
+    return FloatVectorHelpers::sum (src, numValues);
+}
+
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::sumOfSquares (const FloatType* src,
+                                                                                       CountType numValues) noexcept
+{
+    return FloatVectorHelpers::sumOfSquares (src, numValues);
+}
+
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::dotProduct (const FloatType* src1,
+                                                                                     const FloatType* src2,
+                                                                                     CountType numValues) noexcept
+{
+    return FloatVectorHelpers::dotProduct (src1, src2, numValues);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiplyWithRamp (FloatType* dest,
+                                                                                      FloatType startGain,
+                                                                                      FloatType gainIncrement,
+                                                                                      CountType numValues) noexcept
+{
+    FloatVectorHelpers::multiplyWithRamp (dest, startGain, gainIncrement, numValues);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::copyWithRamp (FloatType* dest,
+                                                                                  const FloatType* src,
+                                                                                  FloatType startGain,
+                                                                                  FloatType gainIncrement,
+                                                                                  CountType numValues) noexcept
+{
+    FloatVectorHelpers::copyWithRamp (dest, src, startGain, gainIncrement, numValues);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithRamp (FloatType* dest,
+                                                                                 const FloatType* src,
+                                                                                 FloatType startGain,
+                                                                                 FloatType gainIncrement,
+                                                                                 CountType numValues) noexcept
+{
+    FloatVectorHelpers::addWithRamp (dest, src, startGain, gainIncrement, numValues);
+}
+
 template struct FloatVectorOperationsBase<float, int>;
 template struct FloatVectorOperationsBase<float, size_t>;
 template struct FloatVectorOperationsBase<double, int>;
@@ -1656,6 +2174,54 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            u.expect (exactlyEqual (FloatVectorOperations::sum (data1, num), (ValueType) (8 * num)));
+            u.expect (exactlyEqual (FloatVectorOperations::sumOfSquares (data2, num), (ValueType) (9 * num)));
+            u.expect (exactlyEqual (FloatVectorOperations::dotProduct (data1, data2, num), (ValueType) (24 * num)));
+
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+
+            double expectedSum = 0, expectedSumOfSquares = 0, expectedDotProduct = 0;
+
+            for (int i = 0; i < num; ++i)
+            {
+                expectedSum += data1[i];
+                expectedSumOfSquares += (double) data1[i] * data1[i];
+                expectedDotProduct += (double) data1[i] * data2[i];
+            }
+
+            u.expect (resultsMatch (FloatVectorOperations::sum (data1, num), expectedSum));
+            u.expect (resultsMatch (FloatVectorOperations::sumOfSquares (data1, num), expectedSumOfSquares));
+            u.expect (resultsMatch (FloatVectorOperations::dotProduct (data1, data2, num), expectedDotProduct));
+
+            const auto startGain = (ValueType) 0.5, gainIncrement = (ValueType) 0.25 / (ValueType) num;
+            const auto rampGain = [&] (int i) { return startGain + (ValueType) i * gainIncrement; };
+
+            FloatVectorOperations::copyWithRamp (data2, data1, startGain, gainIncrement, num);
+            u.expect (allValuesMatch (data2, num, [&] (int i) { return data1[i] * rampGain (i); }));
+
+            FloatVectorOperations::addWithRamp (data2, data1, startGain, gainIncrement, num);
+            u.expect (allValuesMatch (data2, num, [&] (int i) { return 2 * data1[i] * rampGain (i); }));
+
+            FloatVectorOperations::copy (data2, data1, num);
+            FloatVectorOperations::multiplyWithRamp (data2, startGain, gainIncrement, num);
+            u.expect (allValuesMatch (data2, num, [&] (int i) { return data1[i] * rampGain (i); }));
+        }
+
+        static bool resultsMatch (ValueType result, double expected)
+        {
+            return std::abs ((double) result - expected) <= std::abs (expected) * (double) std::numeric_limits<ValueType>::epsilon() * 4;
+        }
+
+        template <typename Fn>
+        static bool allValuesMatch (const ValueType* d, int num, Fn&& expected)
+        {
+            for (int i = 0; i < num; ++i)
+                if (std::abs (d[i] - expected (i)) > std::abs (expected (i)) * std::numeric_limits<ValueType>::epsilon() * 4)
+                    return false;
+
+            return true;
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1718,6 +2284,77 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+        beginTest ("Results don't depend on the instruction set chosen at runtime");
+        {
+            auto random = getRandom();
+
+            for (int num = 1; num < 300; num += random.nextInt (9) + 1)
+            {
+                const auto size = (size_t) num + 16;
+                HeapBlock<float> buffer1 (size), buffer2 (size), buffer3 (size), expected (size);
+                HeapBlock<int> ints (size);
+
+               #if JUCE_ARM
+                float* const src1 = buffer1;
+                float* const src2 = buffer2;
+                float* const dest = buffer3;
+                int* const intSrc = ints;
+               #else
+                float* const src1 = buffer1 + random.nextInt (16);
+                float* const src2 = buffer2 + random.nextInt (16);
+                float* const dest = buffer3 + random.nextInt (16);
+                int* const intSrc = ints + random.nextInt (16);
+               #endif
+
+                for (int i = 0; i < num; ++i)
+                {
+                    src1[i] = random.nextFloat() * 200.0f - 100.0f;
+                    src2[i] = random.nextFloat() * 200.0f - 100.0f;
+                    intSrc[i] = random.nextInt();
+                }
+
+                const auto check = [&] (auto&& computeExpected)
+                {
+                    for (int i = 0; i < num; ++i)
+                        expected[i] = computeExpected (i);
+
+                    expect (std::equal (dest, dest + num, expected.get()));
+                };
+
+                FloatVectorOperations::add (dest, src1, src2, num);
+                check ([&] (int i) { return src1[i] + src2[i]; });
+
+                FloatVectorOperations::add (dest, src1, num);
+                check ([&] (int i) { return (src1[i] + src2[i]) + src1[i]; });
+
+                FloatVectorOperations::multiply (dest, src1, src2, num);
+                check ([&] (int i) { return src1[i] * src2[i]; });
+
+                FloatVectorOperations::multiply (dest, src1, num);
+                check ([&] (int i) { return (src1[i] * src2[i]) * src1[i]; });
+
+                FloatVectorOperations::copy (dest, src1, num);
+                FloatVectorOperations::multiply (dest, 0.3f, num);
+                check ([&] (int i) { return src1[i] * 0.3f; });
+
+                FloatVectorOperations::copy (dest, src1, num);
+                FloatVectorOperations::addWithMultiply (dest, src2, 0.7f, num);
+                check ([&] (int i) { const auto product = src2[i] * 0.7f; return src1[i] + product; });
+
+                FloatVectorOperations::copy (dest, src1, num);
+                FloatVectorOperations::addWithMultiply (dest, src1, src2, num);
+                check ([&] (int i) { const auto product = src1[i] * src2[i]; return src1[i] + product; });
+
+                FloatVectorOperations::clip (dest, src1, -50.0f, 25.0f, num);
+                check ([&] (int i) { return jlimit (-50.0f, 25.0f, src1[i]); });
+
+                FloatVectorOperations::convertFixedToFloat (dest, intSrc, 1.0f / 0x7fffffff, num);
+                check ([&] (int i) { return (float) intSrc[i] * (1.0f / 0x7fffffff); });
+
+                expect (FloatVectorOperations::findMinAndMax (src1, num) == Range<float>::findMinAndMax (src1, num));
+            }
+        }
     }
 };
 
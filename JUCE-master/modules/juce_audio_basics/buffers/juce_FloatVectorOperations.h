@@ -148,6 +148,26 @@ struct JUCE_API FloatVectorOperationsBase
 
     /** Finds the maximum value in the given array. */
     static FloatType JUCE_CALLTYPE findMaximum (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the sum of the values in the given array. */
+    static FloatType JUCE_CALLTYPE sum (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the sum of the squares of the values in the given array.
+        Dividing this by numValues and taking the square root gives the RMS level.
+    */
+    static FloatType JUCE_CALLTYPE sumOfSquares (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the sum of the products of the corresponding elements of two arrays. */
+    static FloatType JUCE_CALLTYPE dotProduct (const FloatType* src1, const FloatType* src2, CountType numValues) noexcept;
+
+    /** Multiplies each destination value by a gain that starts at startGain and changes by gainIncrement for each successive value. */
+    static void JUCE_CALLTYPE multiplyWithRamp (FloatType* dest, FloatType startGain, FloatType gainIncrement, CountType numValues) noexcept;
+
+    /** Copies a vector of floating point numbers, multiplying each value by a gain that starts at startGain and changes by gainIncrement for each successive value. */
+    static void JUCE_CALLTYPE copyWithRamp (FloatType* dest, const FloatType* src, FloatType startGain, FloatType gainIncrement, CountType numValues) noexcept;
+
+    /** Adds the source values to the destination values, multiplying each source value by a gain that starts at startGain and changes by gainIncrement for each successive value. */
+    static void JUCE_CALLTYPE addWithRamp (FloatType* dest, const FloatType* src, FloatType startGain, FloatType gainIncrement, CountType numValues) noexcept;
 };
 
 #if ! DOXYGEN
@@ -173,7 +193,13 @@ struct NameForwarder : public Bases...
           Bases::clip...,
           Bases::findMinAndMax...,
           Bases::findMinimum...,
-          Bases::findMaximum...;
+          Bases::findMaximum...,
+          Bases::sum...,
+          Bases::sumOfSquares...,
+          Bases::dotProduct...,
+          Bases::multiplyWithRamp...,
+          Bases::copyWithRamp...,
+          Bases::addWithRamp...;
 };
 
 } // namespace detail
@@ -41,12 +41,18 @@
  #error "Incorrect use of JUCE cpp file"
 #endif
 
+#define JUCE_CORE_INCLUDE_NATIVE_HEADERS 1
+
 #include "juce_audio_basics.h"
 
 #if JUCE_USE_SSE_INTRINSICS
  #include <emmintrin.h>
 #endif
 
+#if JUCE_USE_AVX_INTRINSICS
+ #include <immintrin.h>
+#endif
+
 #if JUCE_MAC || JUCE_IOS
  #ifndef JUCE_USE_VDSP_FRAMEWORK
   #define JUCE_USE_VDSP_FRAMEWORK 1
@@ -66,6 +72,16 @@
  #include <arm_neon.h>
 #endif
 
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#elif ! JUCE_WINDOWS
+ #include <semaphore.h>
+#endif
+
 #include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
@@ -74,18 +90,23 @@
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
+#include "utilities/juce_Reverb.cpp"
+#include "utilities/juce_AudioLevelMeter.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
 #include "midi/juce_MidiMessageSequence.cpp"
+#include "midi/juce_CompactMidiMessageSequence.cpp"
 #include "midi/juce_MidiRPN.cpp"
 #include "mpe/juce_MPEValue.cpp"
 #include "mpe/juce_MPENote.cpp"
 #include "mpe/juce_MPEZoneLayout.cpp"
 #include "mpe/juce_MPEInstrument.cpp"
 #include "mpe/juce_MPEMessages.cpp"
+#include "synthesisers/juce_ParallelVoiceRenderer.h"
 #include "mpe/juce_MPESynthesiserBase.cpp"
 #include "mpe/juce_MPESynthesiserVoice.cpp"
 #include "mpe/juce_MPESynthesiser.cpp"
@@ -109,8 +130,12 @@
 #include "midi/ump/juce_UMPMidi1ToMidi2DefaultTranslator.cpp"
 #include "midi/ump/juce_UMPIterator.cpp"
 #include "utilities/juce_AudioWorkgroup.cpp"
+#include "utilities/juce_RealtimeThreadPool.cpp"
 
 #if JUCE_UNIT_TESTS
  #include "utilities/juce_ADSR_test.cpp"
+ #include "utilities/juce_Reverb_test.cpp"
+ #include "utilities/juce_RealtimeThreadPool_test.cpp"
+ #include "synthesisers/juce_Synthesiser_test.cpp"
  #include "midi/ump/juce_UMP_test.cpp"
 #endif
@@ -78,6 +78,14 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
+#ifndef JUCE_USE_AVX_INTRINSICS
+ #define JUCE_USE_AVX_INTRINSICS 1
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX_INTRINSICS
+#endif
+
 #if __ARM_NEON__ && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
  #define JUCE_USE_ARM_NEON 1
 #endif
@@ -101,12 +109,17 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_PolyphaseResampler.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
+#include "utilities/juce_AudioLevelMeter.h"
 #include "utilities/juce_ADSR.h"
+#include "utilities/juce_AudioWorkgroup.h"
+#include "utilities/juce_RealtimeThreadPool.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
+#include "midi/juce_CompactMidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
@@ -131,7 +144,6 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "sources/juce_ToneGeneratorAudioSource.h"
 #include "synthesisers/juce_Synthesiser.h"
 #include "audio_play_head/juce_AudioPlayHead.h"
-#include "utilities/juce_AudioWorkgroup.h"
 #include "midi/ump/juce_UMPBytesOnGroup.h"
 #include "midi/ump/juce_UMPDeviceInfo.h"
 
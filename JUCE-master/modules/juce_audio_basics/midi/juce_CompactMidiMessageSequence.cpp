@@ -0,0 +1,529 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+CompactMidiMessageSequence::CompactMidiMessageSequence() = default;
+
+CompactMidiMessageSequence::CompactMidiMessageSequence (const MidiMessageSequence& other)
+{
+    const auto numEvents = other.getNumEvents();
+    size_t numBytes = 0;
+
+    for (const auto* holder : other)
+        numBytes += (size_t) holder->message.getRawDataSize();
+
+    ensureStorageAllocated (numEvents, numBytes);
+
+    for (const auto* holder : other)
+        addEvent (holder->message.getRawData(), holder->message.getRawDataSize(), holder->message.getTimeStamp());
+
+    for (int i = 0; i < numEvents; ++i)
+        noteOffIndices[(size_t) i] = other.getIndexOfMatchingKeyUp (i);
+}
+
+MidiMessageSequence CompactMidiMessageSequence::toMidiMessageSequence() const
+{
+    MidiMessageSequence result;
+
+    for (int i = 0; i < getNumEvents(); ++i)
+        result.addEvent (getMessage (i));
+
+    for (int i = 0; i < getNumEvents(); ++i)
+    {
+        const auto noteOff = noteOffIndices[(size_t) i];
+
+        if (noteOff >= 0)
+            result.getEventPointer (i)->noteOffObject = result.getEventPointer (noteOff);
+    }
+
+    return result;
+}
+
+//==============================================================================
+void CompactMidiMessageSequence::clear() noexcept
+{
+    timestamps.clear();
+    dataOffsets.clear();
+    dataSizes.clear();
+    noteOffIndices.clear();
+    pool.clear();
+    numUnusedPoolBytes = 0;
+}
+
+void CompactMidiMessageSequence::ensureStorageAllocated (int numEvents, size_t numBytesOfMidiData)
+{
+    timestamps.reserve ((size_t) numEvents);
+    dataOffsets.reserve ((size_t) numEvents);
+    dataSizes.reserve ((size_t) numEvents);
+    noteOffIndices.reserve ((size_t) numEvents);
+    pool.reserve (numBytesOfMidiData);
+}
+
+double CompactMidiMessageSequence::getEventTime (int index) const noexcept
+{
+    return isPositiveAndBelow (index, getNumEvents()) ? timestamps[(size_t) index] : 0.0;
+}
+
+const uint8* CompactMidiMessageSequence::getEventData (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumEvents()));
+    return pool.data() + dataOffsets[(size_t) index];
+}
+
+int CompactMidiMessageSequence::getEventDataSize (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumEvents()));
+    return dataSizes[(size_t) index];
+}
+
+MidiMessage CompactMidiMessageSequence::getMessage (int index) const
+{
+    return MidiMessage (getEventData (index), getEventDataSize (index), timestamps[(size_t) index]);
+}
+
+int CompactMidiMessageSequence::getIndexOfMatchingKeyUp (int index) const noexcept
+{
+    return isPositiveAndBelow (index, getNumEvents()) ? noteOffIndices[(size_t) index] : -1;
+}
+
+double CompactMidiMessageSequence::getTimeOfMatchingKeyUp (int index) const noexcept
+{
+    const auto noteOff = getIndexOfMatchingKeyUp (index);
+    return noteOff >= 0 ? timestamps[(size_t) noteOff] : 0.0;
+}
+
+int CompactMidiMessageSequence::getNextIndexAtTime (double timeStamp) const noexcept
+{
+    return (int) std::distance (timestamps.begin(), std::lower_bound (timestamps.begin(), timestamps.end(), timeStamp));
+}
+
+//==============================================================================
+void CompactMidiMessageSequence::insertEvent (int index, double time, const uint8* data, int numBytes)
+{
+    jassert (numBytes > 0);
+
+    // Appending is the common case, and can't change any existing indices
+    if (index < getNumEvents())
+        for (auto& noteOff : noteOffIndices)
+            if (noteOff >= index)
+                ++noteOff;
+
+    const auto pos = (size_t) index;
+    timestamps.insert (timestamps.begin() + (ptrdiff_t) pos, time);
+    dataOffsets.insert (dataOffsets.begin() + (ptrdiff_t) pos, (uint32) pool.size());
+    dataSizes.insert (dataSizes.begin() + (ptrdiff_t) pos, (int32) numBytes);
+    noteOffIndices.insert (noteOffIndices.begin() + (ptrdiff_t) pos, -1);
+    pool.insert (pool.end(), data, data + numBytes);
+}
+
+void CompactMidiMessageSequence::removeEvent (int index)
+{
+    for (auto& noteOff : noteOffIndices)
+    {
+        if (noteOff == index)
+            noteOff = -1;
+        else if (noteOff > index)
+            --noteOff;
+    }
+
+    const auto pos = (ptrdiff_t) index;
+    numUnusedPoolBytes += (size_t) dataSizes[(size_t) index];
+
+    timestamps.erase (timestamps.begin() + pos);
+    dataOffsets.erase (dataOffsets.begin() + pos);
+    dataSizes.erase (dataSizes.begin() + pos);
+    noteOffIndices.erase (noteOffIndices.begin() + pos);
+
+    compactPoolIfNeeded();
+}
+
+void CompactMidiMessageSequence::compactPoolIfNeeded()
+{
+    if (numUnusedPoolBytes < 1024 || numUnusedPoolBytes < pool.size() / 2)
+        return;
+
+    // Rewriting the pool in event order also puts neighbouring events next to each other again
+    std::vector<uint8> newPool;
+    newPool.reserve (pool.size() - numUnusedPoolBytes);
+
+    for (size_t i = 0; i < timestamps.size(); ++i)
+    {
+        const auto* start = pool.data() + dataOffsets[i];
+        dataOffsets[i] = (uint32) newPool.size();
+        newPool.insert (newPool.end(), start, start + dataSizes[i]);
+    }
+
+    pool.swap (newPool);
+    numUnusedPoolBytes = 0;
+}
+
+int CompactMidiMessageSequence::addEvent (const MidiMessage& newMessage, double timeAdjustment)
+{
+    return addEvent (newMessage.getRawData(), newMessage.getRawDataSize(), newMessage.getTimeStamp() + timeAdjustment);
+}
+
+int CompactMidiMessageSequence::addEvent (const uint8* midiData, int numBytes, double timeStamp)
+{
+    const auto index = (int) std::distance (timestamps.begin(), std::upper_bound (timestamps.begin(), timestamps.end(), timeStamp));
+    insertEvent (index, timeStamp, midiData, numBytes);
+    return index;
+}
+
+int CompactMidiMessageSequence::setEventTime (int index, double newTime)
+{
+    if (! isPositiveAndBelow (index, getNumEvents()))
+    {
+        jassertfalse;
+        return index;
+    }
+
+    const auto upper = (int) std::distance (timestamps.begin(), std::upper_bound (timestamps.begin(), timestamps.end(), newTime));
+    const auto newIndex = upper > index ? upper - 1 : upper;
+
+    if (newIndex != index)
+    {
+        for (auto& noteOff : noteOffIndices)
+        {
+            if (noteOff == index)
+                noteOff = newIndex;
+            else if (index < newIndex && noteOff > index && noteOff <= newIndex)
+                --noteOff;
+            else if (newIndex < index && noteOff >= newIndex && noteOff < index)
+                ++noteOff;
+        }
+
+        const auto moveElement = [&] (auto& v)
+        {
+            const auto first = v.begin();
+
+            if (index < newIndex)
+                std::rotate (first + index, first + index + 1, first + newIndex + 1);
+            else
+                std::rotate (first + newIndex, first + index, first + index + 1);
+        };
+
+        moveElement (timestamps);
+        moveElement (dataOffsets);
+        moveElement (dataSizes);
+        moveElement (noteOffIndices);
+    }
+
+    timestamps[(size_t) newIndex] = newTime;
+    return newIndex;
+}
+
+void CompactMidiMessageSequence::deleteEvent (int index, bool deleteMatchingNoteUp)
+{
+    if (! isPositiveAndBelow (index, getNumEvents()))
+        return;
+
+    if (deleteMatchingNoteUp)
+    {
+        const auto noteOff = noteOffIndices[(size_t) index];
+
+        if (noteOff >= 0)
+        {
+            removeEvent (noteOff);
+
+            if (noteOff < index)
+                --index;
+        }
+    }
+
+    removeEvent (index);
+}
+
+void CompactMidiMessageSequence::addSequence (const CompactMidiMessageSequence& other, double timeAdjustmentDelta)
+{
+    const auto numExisting = getNumEvents();
+    const auto numOther = other.getNumEvents();
+
+    CompactMidiMessageSequence result;
+    result.ensureStorageAllocated (numExisting + numOther,
+                                   pool.size() - numUnusedPoolBytes + other.pool.size() - other.numUnusedPoolBytes);
+
+    std::vector<int32> newIndices ((size_t) numExisting);
+    int i = 0, j = 0;
+
+    while (i < numExisting || j < numOther)
+    {
+        const auto otherTime = j < numOther ? other.timestamps[(size_t) j] + timeAdjustmentDelta : 0.0;
+
+        if (j >= numOther || (i < numExisting && timestamps[(size_t) i] <= otherTime))
+        {
+            newIndices[(size_t) i] = result.getNumEvents();
+            result.insertEvent (result.getNumEvents(), timestamps[(size_t) i], getEventData (i), getEventDataSize (i));
+            ++i;
+        }
+        else
+        {
+            result.insertEvent (result.getNumEvents(), otherTime, other.getEventData (j), other.getEventDataSize (j));
+            ++j;
+        }
+    }
+
+    for (size_t k = 0; k < (size_t) numExisting; ++k)
+        if (const auto noteOff = noteOffIndices[k]; noteOff >= 0)
+            result.noteOffIndices[(size_t) newIndices[k]] = newIndices[(size_t) noteOff];
+
+    swapWith (result);
+}
+
+void CompactMidiMessageSequence::addTimeToMessages (double delta) noexcept
+{
+    if (! approximatelyEqual (delta, 0.0))
+        for (auto& t : timestamps)
+            t += delta;
+}
+
+//==============================================================================
+void CompactMidiMessageSequence::updateMatchedPairs()
+{
+    std::array<int32, 16 * 128> openNotes;
+    std::vector<int> missingNoteOffs;
+
+    const auto getNoteSlot = [this] (size_t index, bool& isNoteOn, bool& isNoteOff)
+    {
+        const auto* d = pool.data() + dataOffsets[index];
+        const auto status = d[0] & 0xf0;
+        isNoteOn = isNoteOff = false;
+
+        if (dataSizes[index] < 3 || (status != 0x80 && status != 0x90))
+            return -1;
+
+        isNoteOn = (status == 0x90 && d[2] != 0);
+        isNoteOff = ! isNoteOn;
+        return (d[0] & 0x0f) * 128 + (d[1] & 0x7f);
+    };
+
+    const auto matchPairs = [&] (std::vector<int>* notesNeedingNoteOffs)
+    {
+        openNotes.fill (-1);
+
+        for (size_t i = 0; i < timestamps.size(); ++i)
+        {
+            bool isNoteOn, isNoteOff;
+            const auto slot = getNoteSlot (i, isNoteOn, isNoteOff);
+            noteOffIndices[i] = -1;
+
+            if (slot < 0)
+                continue;
+
+            auto& open = openNotes[(size_t) slot];
+
+            if (isNoteOn)
+            {
+                if (open >= 0 && notesNeedingNoteOffs != nullptr)
+                    notesNeedingNoteOffs->push_back ((int) i);
+
+                open = (int32) i;
+            }
+            else if (isNoteOff && open >= 0)
+            {
+                noteOffIndices[(size_t) open] = (int32) i;
+                open = -1;
+            }
+        }
+    };
+
+    matchPairs (&missingNoteOffs);
+
+    if (missingNoteOffs.empty())
+        return;
+
+    // Some note-ons were followed by another note-on for the same note. Give each of
+    // them a note-off just before the second note-on, then match everything again.
+    CompactMidiMessageSequence result;
+    result.ensureStorageAllocated (getNumEvents() + (int) missingNoteOffs.size(),
+                                   pool.size() - numUnusedPoolBytes + missingNoteOffs.size() * 3);
+
+    auto nextMissing = missingNoteOffs.begin();
+
+    for (int i = 0; i < getNumEvents(); ++i)
+    {
+        if (nextMissing != missingNoteOffs.end() && *nextMissing == i)
+        {
+            const auto* noteOn = getEventData (i);
+            const uint8 noteOff[] { (uint8) (0x80 | (noteOn[0] & 0x0f)), noteOn[1], 0 };
+            result.insertEvent (result.getNumEvents(), timestamps[(size_t) i], noteOff, 3);
+            ++nextMissing;
+        }
+
+        result.insertEvent (result.getNumEvents(), timestamps[(size_t) i], getEventData (i), getEventDataSize (i));
+    }
+
+    swapWith (result);
+    matchPairs (nullptr);
+}
+
+void CompactMidiMessageSequence::swapWith (CompactMidiMessageSequence& other) noexcept
+{
+    timestamps.swap (other.timestamps);
+    dataOffsets.swap (other.dataOffsets);
+    dataSizes.swap (other.dataSizes);
+    noteOffIndices.swap (other.noteOffIndices);
+    pool.swap (other.pool);
+    std::swap (numUnusedPoolBytes, other.numUnusedPoolBytes);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct CompactMidiMessageSequenceTest final : public UnitTest
+{
+    CompactMidiMessageSequenceTest()
+        : UnitTest ("CompactMidiMessageSequence", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Events are ordered and paired like MidiMessageSequence");
+        {
+            auto random = getRandom();
+
+            for (int run = 0; run < 20; ++run)
+            {
+                MidiMessageSequence reference;
+                CompactMidiMessageSequence compact;
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    const auto time = (double) random.nextInt (50);
+                    const auto note = 60 + random.nextInt (4);
+                    const auto message = random.nextBool() ? MidiMessage::noteOn (1, note, (uint8) 100)
+                                                           : MidiMessage::noteOff (1, note);
+
+                    reference.addEvent (message.withTimeStamp (time));
+                    compact.addEvent (message.withTimeStamp (time));
+                }
+
+                reference.updateMatchedPairs();
+                compact.updateMatchedPairs();
+                expectMatches (compact, reference);
+
+                for (int i = 0; i < 20; ++i)
+                {
+                    // MidiMessageSequence would be left with a dangling pointer if a paired note-off were removed alone
+                    const auto index = random.nextInt (reference.getNumEvents());
+
+                    if (reference.getEventPointer (index)->message.isNoteOn())
+                    {
+                        reference.deleteEvent (index, true);
+                        compact.deleteEvent (index, true);
+                    }
+                }
+
+                expectMatches (compact, reference);
+            }
+        }
+
+        CompactMidiMessageSequence s;
+        s.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (0.0));
+        s.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (4.0));
+        s.addEvent (MidiMessage::noteOn  (1, 30, 0.5f).withTimeStamp (2.0));
+        s.addEvent (MidiMessage::noteOff (1, 30, 0.5f).withTimeStamp (8.0));
+        s.updateMatchedPairs();
+
+        beginTest ("Time & indices");
+        expectEquals (s.getStartTime(), 0.0);
+        expectEquals (s.getEndTime(), 8.0);
+        expectEquals (s.getNextIndexAtTime (0.5), 1);
+        expectEquals (s.getNextIndexAtTime (2.0), 1);
+        expectEquals (s.getNextIndexAtTime (9.0), 4);
+        expectEquals (s.getIndexOfMatchingKeyUp (0), 2);
+        expectEquals (s.getTimeOfMatchingKeyUp (1), 8.0);
+
+        beginTest ("Moving an event keeps its note pairing");
+        expectEquals (s.setEventTime (0, 3.0), 1);
+        expectEquals (s.getEventTime (1), 3.0);
+        expectEquals (s.getIndexOfMatchingKeyUp (1), 2);
+        expectEquals (s.getIndexOfMatchingKeyUp (0), 3);
+        expectEquals (s.setEventTime (3, 1.0), 0);
+        expectEquals (s.getIndexOfMatchingKeyUp (1), 0);
+        expectEquals (s.getIndexOfMatchingKeyUp (2), 3);
+
+        beginTest ("Merging sequences");
+        {
+            CompactMidiMessageSequence other;
+            other.addEvent (MidiMessage::controllerEvent (2, 7, 100).withTimeStamp (0.0));
+            other.addEvent (MidiMessage::controllerEvent (2, 7, 50).withTimeStamp (1.0));
+
+            s.addSequence (other, 2.0);
+            expectEquals (s.getNumEvents(), 6);
+            expectEquals (s.getEventTime (2), 2.0);
+            expect (s.getMessage (2).isController());
+            expect (s.getMessage (4).isController());
+            expectEquals (s.getIndexOfMatchingKeyUp (3), 5);
+        }
+
+        beginTest ("Long messages and conversion");
+        {
+            const uint8 sysex[] { 0xf0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0xf7 };
+            s.addEvent (sysex, (int) sizeof (sysex), 2.5);
+            s.updateMatchedPairs();
+
+            const auto converted = s.toMidiMessageSequence();
+            expectEquals (converted.getNumEvents(), s.getNumEvents());
+
+            const CompactMidiMessageSequence roundTripped (converted);
+            expectMatches (roundTripped, converted);
+            expect (roundTripped.getMessage (3).isSysEx());
+            expectEquals (roundTripped.getEventDataSize (3), (int) sizeof (sysex));
+        }
+    }
+
+    void expectMatches (const CompactMidiMessageSequence& compact, const MidiMessageSequence& reference)
+    {
+        expectEquals (compact.getNumEvents(), reference.getNumEvents());
+
+        for (int i = 0; i < reference.getNumEvents(); ++i)
+        {
+            const auto& message = reference.getEventPointer (i)->message;
+
+            expectEquals (compact.getEventTime (i), message.getTimeStamp());
+            expect (compact.getEventDataSize (i) == message.getRawDataSize()
+                    && std::equal (message.getRawData(), message.getRawData() + message.getRawDataSize(), compact.getEventData (i)));
+            expectEquals (compact.getIndexOfMatchingKeyUp (i), reference.getIndexOfMatchingKeyUp (i));
+        }
+    }
+};
+
+static CompactMidiMessageSequenceTest compactMidiMessageSequenceTest;
+
+#endif
+
+} // namespace juce
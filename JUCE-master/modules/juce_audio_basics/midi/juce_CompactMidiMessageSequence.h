@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A sequence of timestamped midi messages, stored in a small number of flat arrays.
+
+    MidiMessageSequence allocates a separate MidiEventHolder for every event, and links
+    note-ons to their note-offs by pointer, so sorting, matching and playing a long
+    sequence all spend most of their time chasing pointers. This class keeps the same
+    information in a structure-of-arrays layout instead: one array of timestamps, one
+    of offsets into a shared pool of message bytes, and one of note-off indices. An
+    event costs about 20 bytes plus its data, and scanning the timestamps is a linear
+    walk through memory.
+
+    The sequence is always kept sorted. Events at the same time stay in the order in
+    which they were added, just like MidiMessageSequence.
+
+    Because events are referred to by index, adding, moving or deleting an event
+    shifts the indices of the events after it. Matching note-off indices are updated
+    automatically when that happens.
+
+    @see MidiMessageSequence
+
+    @tags{Audio}
+*/
+class JUCE_API  CompactMidiMessageSequence
+{
+public:
+    //==============================================================================
+    /** Creates an empty sequence. */
+    CompactMidiMessageSequence();
+
+    /** Creates a compact copy of a MidiMessageSequence, including its matched note pairs. */
+    explicit CompactMidiMessageSequence (const MidiMessageSequence&);
+
+    /** Creates a MidiMessageSequence containing the same events and note pairs. */
+    MidiMessageSequence toMidiMessageSequence() const;
+
+    //==============================================================================
+    /** Clears the sequence. */
+    void clear() noexcept;
+
+    /** Preallocates enough space for a number of events and bytes of midi data. */
+    void ensureStorageAllocated (int numEvents, size_t numBytesOfMidiData);
+
+    /** Returns the number of events in the sequence. */
+    int getNumEvents() const noexcept                           { return (int) timestamps.size(); }
+
+    /** Returns the timestamp of the event at a given index.
+        If the index is out-of-range, this will return 0.0
+    */
+    double getEventTime (int index) const noexcept;
+
+    /** Returns a pointer to the contiguous array of all the event timestamps. */
+    const double* getEventTimes() const noexcept                { return timestamps.data(); }
+
+    /** Returns the raw midi data of an event. The index must be in range.
+        The pointer is only valid until the sequence is next modified.
+    */
+    const uint8* getEventData (int index) const noexcept;
+
+    /** Returns the number of bytes of midi data in an event. The index must be in range. */
+    int getEventDataSize (int index) const noexcept;
+
+    /** Returns a copy of an event as a MidiMessage, with its timestamp set. */
+    MidiMessage getMessage (int index) const;
+
+    /** Returns the index of the note-up that matches the note-on at this index.
+        If the event at this index isn't a note-on, or it has no matching note-off,
+        this will return -1.
+        @see updateMatchedPairs
+    */
+    int getIndexOfMatchingKeyUp (int index) const noexcept;
+
+    /** Returns the time of the note-up that matches the note-on at this index.
+        If the event at this index isn't a note-on, it'll just return 0.
+    */
+    double getTimeOfMatchingKeyUp (int index) const noexcept;
+
+    /** Returns the index of the first event on or after the given timestamp.
+        This is a binary search. If the time is beyond the end of the sequence, this
+        will return the number of events.
+    */
+    int getNextIndexAtTime (double timeStamp) const noexcept;
+
+    /** Returns the timestamp of the first event in the sequence. */
+    double getStartTime() const noexcept                        { return getEventTime (0); }
+
+    /** Returns the timestamp of the last event in the sequence. */
+    double getEndTime() const noexcept                          { return getEventTime (getNumEvents() - 1); }
+
+    //==============================================================================
+    /** Inserts a midi message into the sequence, after any events at the same time.
+
+        Remember to call updateMatchedPairs() after adding note-on events.
+
+        @returns the index at which the event was inserted
+    */
+    int addEvent (const MidiMessage& newMessage, double timeAdjustment = 0);
+
+    /** Inserts some raw midi data into the sequence, after any events at the same time.
+
+        Remember to call updateMatchedPairs() after adding note-on events.
+
+        @returns the index at which the event was inserted
+    */
+    int addEvent (const uint8* midiData, int numBytes, double timeStamp);
+
+    /** Changes the time of an event, moving it to keep the sequence sorted.
+
+        The event is placed after any others that are already at the new time. Its
+        matching note-off link, and those of the other events, are kept.
+
+        @returns the new index of the event
+    */
+    int setEventTime (int index, double newTime);
+
+    /** Deletes one of the events in the sequence.
+
+        @param index                 the index of the event to delete
+        @param deleteMatchingNoteUp  whether to also remove the matching note-off
+                                     if the event you're removing is a note-on
+    */
+    void deleteEvent (int index, bool deleteMatchingNoteUp);
+
+    /** Merges another sequence into this one.
+        Remember to call updateMatchedPairs() after using this method.
+    */
+    void addSequence (const CompactMidiMessageSequence& other, double timeAdjustmentDelta);
+
+    /** Adds an offset to the timestamps of all events in the sequence. */
+    void addTimeToMessages (double deltaTime) noexcept;
+
+    //==============================================================================
+    /** Makes sure all the note-on and note-off pairs are up-to-date.
+
+        This pairs each note-on with the next note-off for the same note and channel.
+        If another note-on for the same note comes first, a note-off is inserted just
+        before it, as MidiMessageSequence::updateMatchedPairs() does. Unlike that
+        function, this runs in a single pass over the events.
+    */
+    void updateMatchedPairs();
+
+    /** Swaps this sequence with another one. */
+    void swapWith (CompactMidiMessageSequence&) noexcept;
+
+private:
+    //==============================================================================
+    void insertEvent (int index, double time, const uint8* data, int numBytes);
+    void removeEvent (int index);
+    void compactPoolIfNeeded();
+
+    std::vector<double> timestamps;
+    std::vector<uint32> dataOffsets;
+    std::vector<int32> dataSizes;
+    std::vector<int32> noteOffIndices;
+    std::vector<uint8> pool;
+    size_t numUnusedPoolBytes = 0;
+
+    JUCE_LEAK_DETECTOR (CompactMidiMessageSequence)
+};
+
+} // namespace juce
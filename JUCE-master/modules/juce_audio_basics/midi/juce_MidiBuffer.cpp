@@ -118,17 +118,80 @@ MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
     addEvent (message, 0);
 }
 
-void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
-void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
+MidiBuffer::MidiBuffer (const MidiBuffer& other)
+    : data (other.data), overflowed (other.overflowed)
+{
+    setFixedCapacity (other.fixedCapacity);
+}
+
+MidiBuffer& MidiBuffer::operator= (const MidiBuffer& other)
+{
+    if (this != &other)
+    {
+        MidiBuffer copy (other);
+        swapWith (copy);
+    }
+
+    return *this;
+}
+
+void MidiBuffer::swapWith (MidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    mergeSpace.swapWith (other.mergeSpace);
+    std::swap (fixedCapacity, other.fixedCapacity);
+    std::swap (overflowed, other.overflowed);
+}
+
+void MidiBuffer::clear() noexcept
+{
+    data.clearQuick();
+    overflowed = false;
+}
+
 void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
 bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
 
+void MidiBuffer::setFixedCapacity (size_t maximumNumBytes)
+{
+    fixedCapacity = maximumNumBytes;
+
+    if (fixedCapacity > 0)
+    {
+        // Clearing a range or merging never makes the buffer bigger, so the existing
+        // contents are the most that the merge space ever has to hold.
+        const auto numBytesNeeded = jmax ((int) fixedCapacity, data.size());
+        data.ensureStorageAllocated (numBytesNeeded);
+        mergeSpace.ensureStorageAllocated (numBytesNeeded);
+    }
+}
+
+bool MidiBuffer::hasSpaceFor (size_t numBytes) noexcept
+{
+    if (fixedCapacity == 0 || (size_t) data.size() + numBytes <= fixedCapacity)
+        return true;
+
+    overflowed = true;
+    return false;
+}
+
 void MidiBuffer::clear (int startSample, int numSamples)
 {
     auto start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
     auto end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
 
-    data.removeRange ((int) (start - data.begin()), (int) (end - start));
+    if (fixedCapacity == 0)
+    {
+        data.removeRange ((int) (start - data.begin()), (int) (end - start));
+        return;
+    }
+
+    // Array::removeRange may shrink the storage, so copy the remaining events into
+    // the merge space instead, which is already big enough to hold them.
+    mergeSpace.clearQuick();
+    mergeSpace.addArray (data.begin(), (int) (start - data.begin()));
+    mergeSpace.addArray (end, (int) (data.end() - end));
+    data.swapWith (mergeSpace);
 }
 
 bool MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
@@ -150,6 +213,10 @@ bool MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
     }
 
     auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
+
+    if (! hasSpaceFor (newItemSize))
+        return false;
+
     auto offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
 
     data.insertMultiple (offset, 0, (int) newItemSize);
@@ -178,6 +245,67 @@ void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
     }
 }
 
+bool MidiBuffer::mergeEvents (const MidiBuffer* const* buffersToMerge, int numBuffers)
+{
+    using namespace MidiBufferHelpers;
+
+    auto allAdded = true;
+
+    for (int i = 0; i < numBuffers; ++i)
+    {
+        auto* source = buffersToMerge[i];
+
+        if (source == nullptr || source->isEmpty())
+            continue;
+
+        // A buffer can't be merged into itself!
+        jassert (source != this);
+
+        if (fixedCapacity == 0)
+            mergeSpace.ensureStorageAllocated (data.size() + source->data.size());
+
+        mergeSpace.clearQuick();
+
+        auto* existing = data.begin();
+        auto* newEvent = source->data.begin();
+        const auto* existingEnd = data.end();
+        const auto* newEventsEnd = source->data.end();
+        auto numExistingBytesLeft = (size_t) data.size();
+
+        while (existing < existingEnd || newEvent < newEventsEnd)
+        {
+            if (newEvent < newEventsEnd && (existing >= existingEnd || getEventTime (newEvent) < getEventTime (existing)))
+            {
+                const auto size = getEventTotalSize (newEvent);
+
+                // Events that don't fit are skipped, but the existing ones must always be kept
+                if (fixedCapacity == 0 || (size_t) mergeSpace.size() + numExistingBytesLeft + size <= fixedCapacity)
+                {
+                    mergeSpace.addArray (newEvent, size);
+                }
+                else
+                {
+                    overflowed = true;
+                    allAdded = false;
+                }
+
+                newEvent += size;
+            }
+            else
+            {
+                const auto size = getEventTotalSize (existing);
+                mergeSpace.addArray (existing, size);
+                existing += size;
+                numExistingBytesLeft -= size;
+            }
+        }
+
+        data.swapWith (mergeSpace);
+    }
+
+    return allAdded;
+}
+
 int MidiBuffer::getNumEvents() const noexcept
 {
     int n = 0;
@@ -320,6 +448,108 @@ struct MidiBufferTest final : public UnitTest
                 expectEquals (buffer.getNumEvents(), 1);
             }
         }
+
+        beginTest ("Fixed capacity");
+        {
+            const auto message = MidiMessage::controllerEvent (1, 7, 100);
+            constexpr auto eventSize = 9;
+
+            MidiBuffer buffer;
+            buffer.setFixedCapacity (eventSize * 4);
+            expectEquals ((int) buffer.getFixedCapacity(), eventSize * 4);
+
+            for (int i = 0; i < 4; ++i)
+                expect (buffer.addEvent (message, i * 10));
+
+            expect (! buffer.hasOverflowed());
+            expect (! buffer.addEvent (message, 5));
+            expect (buffer.hasOverflowed());
+            expectEquals (buffer.getNumEvents(), 4);
+
+            buffer.clear (10, 10);
+            expectEquals (buffer.getNumEvents(), 3);
+            expect (buffer.addEvent (message, 5));
+            expectEquals (buffer.getFirstEventTime(), 0);
+            expectEquals (buffer.getLastEventTime(), 30);
+
+            const auto copy = buffer;
+            expectEquals ((int) copy.getFixedCapacity(), eventSize * 4);
+            expectEquals (copy.getNumEvents(), 4);
+
+            buffer.clear();
+            expect (! buffer.hasOverflowed());
+            expect (buffer.isEmpty());
+
+            buffer.setFixedCapacity (0);
+            expect (buffer.addEvent (message, 0));
+            expect (! buffer.hasOverflowed());
+        }
+
+        beginTest ("Merge events");
+        {
+            const auto makeBuffer = [] (std::initializer_list<int> notes)
+            {
+                MidiBuffer result;
+
+                for (auto note : notes)
+                    result.addEvent (MidiMessage::noteOn (1, note, 1.0f), note);
+
+                return result;
+            };
+
+            const auto a = makeBuffer ({ 1, 5, 9 });
+            const auto b = makeBuffer ({ 2, 5, 20 });
+            const auto c = makeBuffer ({ 0, 5 });
+            const MidiBuffer* buffers[] { &a, nullptr, &b, &c };
+
+            const auto getNotes = [] (const MidiBuffer& buffer)
+            {
+                Array<int> result;
+
+                for (const auto metadata : buffer)
+                    result.add (metadata.getMessage().getNoteNumber());
+
+                return result;
+            };
+
+            {
+                auto merged = makeBuffer ({ 3, 5 });
+                expect (merged.mergeEvents (buffers, numElementsInArray (buffers)));
+                expectEquals (merged.getNumEvents(), 10);
+
+                expect (getNotes (merged) == Array<int> { 0, 1, 2, 3, 5, 5, 5, 5, 9, 20 });
+            }
+
+            {
+                // Events at the same position keep the order of the buffers
+                MidiBuffer first, second, merged;
+                first.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 4);
+                second.addEvent (MidiMessage::noteOn (2, 60, 1.0f), 4);
+                merged.addEvent (MidiMessage::noteOn (3, 60, 1.0f), 4);
+
+                const MidiBuffer* toMerge[] { &first, &second };
+                expect (merged.mergeEvents (toMerge, 2));
+
+                Array<int> channels;
+
+                for (const auto metadata : merged)
+                    channels.add (metadata.getMessage().getChannel());
+
+                expect (channels == Array<int> { 3, 1, 2 });
+            }
+
+            {
+                MidiBuffer merged;
+                merged.setFixedCapacity (9 * 4);
+                merged.addEvent (MidiMessage::noteOn (1, 30, 1.0f), 30);
+
+                expect (! merged.mergeEvents (buffers, numElementsInArray (buffers)));
+                expect (merged.hasOverflowed());
+                expectEquals (merged.getNumEvents(), 4);
+                // The buffers are merged one after another, so the later ones are dropped
+                expect (getNotes (merged) == Array<int> { 1, 5, 9, 30 });
+            }
+        }
     }
 };
 
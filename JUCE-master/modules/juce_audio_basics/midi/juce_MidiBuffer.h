@@ -163,14 +163,32 @@ public:
     /** Creates a MidiBuffer containing a single midi message. */
     explicit MidiBuffer (const MidiMessage& message) noexcept;
 
+    /** Creates a copy of another buffer.
+        If the other buffer has a fixed capacity, the copy will have the same capacity.
+    */
+    MidiBuffer (const MidiBuffer&);
+
+    /** Replaces the contents of this buffer with a copy of another one, including its capacity. */
+    MidiBuffer& operator= (const MidiBuffer&);
+
+    /** Move constructor. */
+    MidiBuffer (MidiBuffer&&) noexcept = default;
+
+    /** Move assignment operator. */
+    MidiBuffer& operator= (MidiBuffer&&) noexcept = default;
+
     //==============================================================================
-    /** Removes all events from the buffer. */
+    /** Removes all events from the buffer.
+        This also resets the flag returned by hasOverflowed().
+    */
     void clear() noexcept;
 
     /** Removes all events between two times from the buffer.
 
         All events for which (start <= event position < start + numSamples) will
         be removed.
+
+        If the buffer has a fixed capacity, this won't allocate or free any memory.
     */
     void clear (int start, int numSamples);
 
@@ -198,7 +216,11 @@ public:
 
         To retrieve events, use a MidiBufferIterator object.
 
-        Returns true on success, or false on failure.
+        Returns true on success, or false on failure. If the buffer has a fixed
+        capacity and there isn't enough room left for the event, it won't be added,
+        and this will return false.
+
+        @see setFixedCapacity
     */
     bool addEvent (const MidiMessage& midiMessage, int sampleNumber);
 
@@ -218,7 +240,11 @@ public:
 
         To retrieve events, use a MidiBufferIterator object.
 
-        Returns true on success, or false on failure.
+        Returns true on success, or false on failure. If the buffer has a fixed
+        capacity and there isn't enough room left for the event, it won't be added,
+        and this will return false.
+
+        @see setFixedCapacity
     */
     bool addEvent (const void* rawMidiData,
                    int maxBytesOfMidiData,
@@ -237,12 +263,34 @@ public:
                                     startSample will be taken.
         @param sampleDeltaToAdd     a value which will be added to the source timestamps of the events
                                     that are added to this buffer
+
+        If this buffer has a fixed capacity, any events that don't fit will be dropped,
+        and hasOverflowed() will return true afterwards.
     */
     void addEvents (const MidiBuffer& otherBuffer,
                     int startSample,
                     int numSamples,
                     int sampleDeltaToAdd);
 
+    /** Merges the events from several other buffers into this one.
+
+        Because all the buffers are already sorted, this is much quicker than adding
+        the events one at a time. Events which share a sample position are kept in the
+        order of the buffers in the list, after any such events that were already in
+        this buffer.
+
+        If this buffer has a fixed capacity, this won't allocate any memory, so it's
+        safe to call on the audio thread. Any events that don't fit will be dropped,
+        and the method will return false. The events that were already in this
+        buffer are always kept.
+
+        @param buffersToMerge   an array of pointers to the buffers to merge. Null entries
+                                are skipped. None of these may be this buffer.
+        @param numBuffers       the number of pointers in the array
+        @returns                true if all of the events were added
+    */
+    bool mergeEvents (const MidiBuffer* const* buffersToMerge, int numBuffers);
+
     /** Returns the sample number of the first event in the buffer.
         If the buffer's empty, this will just return 0.
     */
@@ -257,7 +305,7 @@ public:
     /** Exchanges the contents of this buffer with another one.
 
         This is a quick operation, because no memory allocating or copying is done, it
-        just swaps the internal state of the two buffers.
+        just swaps the internal state of the two buffers, including their capacities.
     */
     void swapWith (MidiBuffer&) noexcept;
 
@@ -267,6 +315,37 @@ public:
     */
     void ensureSize (size_t minimumNumBytes);
 
+    //==============================================================================
+    /** Gives the buffer a fixed amount of storage which it will never grow beyond.
+
+        This allocates all the memory the buffer will need up front. After that,
+        adding, clearing and merging events won't allocate, so the buffer can be
+        filled on the audio thread however much MIDI arrives. When an event doesn't
+        fit, it's dropped and the buffer remembers that it overflowed - see
+        hasOverflowed().
+
+        Each event uses 6 bytes plus the size of its MIDI data, so a capacity of
+        1024 bytes holds about 110 three-byte messages. As merging needs somewhere
+        to build its result, the buffer reserves twice this amount of memory.
+
+        Passing 0 returns the buffer to its default behaviour, where it grows as
+        needed. Any events already in the buffer are kept, even if they don't fit
+        into the new capacity.
+
+        This must not be called on the audio thread, as it may allocate.
+    */
+    void setFixedCapacity (size_t maximumNumBytes);
+
+    /** Returns the capacity set with setFixedCapacity(), or 0 if the buffer can grow. */
+    size_t getFixedCapacity() const noexcept                { return fixedCapacity; }
+
+    /** Returns true if any events have been dropped since the buffer was last cleared.
+
+        This can only happen when the buffer has a fixed capacity.
+        @see setFixedCapacity, clear
+    */
+    bool hasOverflowed() const noexcept                     { return overflowed; }
+
     /** Get a read-only iterator pointing to the beginning of this buffer. */
     MidiBufferIterator begin()  const noexcept { return cbegin(); }
 
@@ -351,6 +430,12 @@ public:
     Array<uint8> data;
 
 private:
+    bool hasSpaceFor (size_t numBytes) noexcept;
+
+    Array<uint8> mergeSpace;
+    size_t fixedCapacity = 0;
+    bool overflowed = false;
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
@@ -40,6 +40,12 @@ namespace juce
     Helper class that takes chunks of incoming midi bytes, packages them into
     messages, and dispatches them to a midi callback.
 
+    Complete messages are passed to the callback's handleIncomingMidiMessage()
+    function. If the callback also has a function with the signature
+    handleIncomingMidiBytes (UserDataType*, const uint8*, int numBytes, double time),
+    that will be called instead with the raw bytes of each message, which avoids
+    creating a MidiMessage (and allocating, in the case of long SysEx messages).
+
     @tags{Audio}
 */
 class MidiDataConcatenator
@@ -79,7 +85,7 @@ public:
 
             if (isRealtimeMessage (nextByte))
             {
-                callback.handleIncomingMidiMessage (input, MidiMessage (nextByte, time));
+                sendMessage (callback, input, &nextByte, 1, time);
                 // These can be embedded in the middle of a normal message, so we won't
                 // reset the currentMessageLen here.
                 continue;
@@ -105,13 +111,33 @@ public:
 
             if (expectedLength == currentMessageLen)
             {
-                callback.handleIncomingMidiMessage (input, MidiMessage (currentMessage, expectedLength, time));
+                sendMessage (callback, input, currentMessage, expectedLength, time);
                 currentMessageLen = 1; // reset, but leave the first byte to use as the running status byte
             }
         }
     }
 
 private:
+    template <typename CallbackType, typename UserDataType, typename = void>
+    struct HasBytesCallback : std::false_type {};
+
+    template <typename CallbackType, typename UserDataType>
+    struct HasBytesCallback<CallbackType, UserDataType,
+                            std::void_t<decltype (std::declval<CallbackType&>().handleIncomingMidiBytes (std::declval<UserDataType*>(),
+                                                                                                         std::declval<const uint8*>(),
+                                                                                                         0,
+                                                                                                         0.0))>>
+        : std::true_type {};
+
+    template <typename UserDataType, typename CallbackType>
+    static void sendMessage (CallbackType& callback, UserDataType* input, const uint8* data, int numBytes, double time)
+    {
+        if constexpr (HasBytesCallback<CallbackType, UserDataType>::value)
+            callback.handleIncomingMidiBytes (input, data, numBytes, time);
+        else
+            callback.handleIncomingMidiMessage (input, MidiMessage (data, numBytes, time));
+    }
+
     template <typename UserDataType, typename CallbackType>
     void processSysex (const uint8*& d, int& numBytes, double time,
                        UserDataType* input, CallbackType& callback)
@@ -140,7 +166,7 @@ private:
 
                 if (*d >= 0xfa || *d == 0xf8)
                 {
-                    callback.handleIncomingMidiMessage (input, MidiMessage (*d, time));
+                    sendMessage (callback, input, d, 1, time);
                     ++d;
                     --numBytes;
                 }
@@ -152,7 +178,7 @@ private:
 
                     if (used > 0)
                     {
-                        callback.handleIncomingMidiMessage (input, m);
+                        sendMessage (callback, input, m.getRawData(), m.getRawDataSize(), time);
                         numBytes -= used;
                         d += used;
                     }
@@ -173,7 +199,7 @@ private:
         {
             if (totalMessage [pendingSysexSize - 1] == 0xf7)
             {
-                callback.handleIncomingMidiMessage (input, MidiMessage (totalMessage, pendingSysexSize, pendingSysexTime));
+                sendMessage (callback, input, totalMessage, pendingSysexSize, pendingSysexTime);
                 pendingSysexSize = 0;
             }
             else
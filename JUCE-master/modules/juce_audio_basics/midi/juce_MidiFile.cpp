@@ -414,27 +414,29 @@ bool MidiFile::readFrom (InputStream& sourceStream,
     return successful;
 }
 
-template <typename It>
-static void reorderNoteOnsAfterNoteOffs (const It begin, const It end)
+template <typename It, typename GetMessage>
+static void reorderNoteOnsAfterNoteOffs (const It begin, const It end, GetMessage getMessage)
 {
     for (auto it = begin; it != end;)
     {
-        const auto firstNoteOn = std::find_if (it, end, [] (const auto& x)
+        const auto firstNoteOn = std::find_if (it, end, [&] (const auto& x)
         {
-            return x->message.isNoteOn();
+            return getMessage (x).isNoteOn();
         });
 
         if (firstNoteOn == end)
             return;
 
-        const auto channel = (*firstNoteOn)->message.getChannel();
-        const auto noteNumber = (*firstNoteOn)->message.getNoteNumber();
+        const auto channel = getMessage (*firstNoteOn).getChannel();
+        const auto noteNumber = getMessage (*firstNoteOn).getNoteNumber();
         const auto rEnd = std::make_reverse_iterator (firstNoteOn);
         const auto lastNoteOff = std::find_if (std::make_reverse_iterator (end), rEnd, [&] (const auto& x)
         {
-            return x->message.getChannel() == channel
-                   && x->message.getNoteNumber() == noteNumber
-                   && x->message.isNoteOff();
+            const auto& message = getMessage (x);
+
+            return message.getChannel() == channel
+                   && message.getNoteNumber() == noteNumber
+                   && message.isNoteOff();
         });
 
         if (lastNoteOff == rEnd)
@@ -446,6 +448,12 @@ static void reorderNoteOnsAfterNoteOffs (const It begin, const It end)
     }
 }
 
+template <typename It>
+static void reorderNoteOnsAfterNoteOffs (const It begin, const It end)
+{
+    reorderNoteOnsAfterNoteOffs (begin, end, [] (const auto& x) -> const MidiMessage& { return x->message; });
+}
+
 void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNoteOffs)
 {
     auto sequence = MidiFileHelpers::readTrack (data, size);
@@ -570,6 +578,210 @@ bool MidiFile::writeTrack (OutputStream& mainOut, const MidiMessageSequence& ms)
     return true;
 }
 
+//==============================================================================
+PackedMidiFile::PackedMidiFile() = default;
+PackedMidiFile::~PackedMidiFile() = default;
+PackedMidiFile::PackedMidiFile (PackedMidiFile&&) noexcept = default;
+PackedMidiFile& PackedMidiFile::operator= (PackedMidiFile&&) noexcept = default;
+
+PackedMidiFile::Event PackedMidiFile::Track::getEvent (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumEvents()));
+
+    const auto& e = events[(size_t) index];
+    return { eventData.data() + e.offset, e.numBytes, e.tick };
+}
+
+int PackedMidiFile::Track::getLastTick() const noexcept
+{
+    return events.empty() ? 0 : events.back().tick;
+}
+
+PackedMidiFile::Track::Iterator PackedMidiFile::Track::findNextTick (int tick) const noexcept
+{
+    const auto it = std::lower_bound (events.begin(), events.end(), tick, [] (const PackedEvent& e, int t)
+    {
+        return e.tick < t;
+    });
+
+    return { *this, (int) std::distance (events.begin(), it) };
+}
+
+void PackedMidiFile::clear()
+{
+    chunks.clear();
+    mappedFile.reset();
+    fileData.reset();
+    timeFormat = 0;
+    fileType = 0;
+}
+
+bool PackedMidiFile::loadFrom (const File& file)
+{
+    clear();
+
+    auto mapped = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    if (mapped->getData() == nullptr)
+        return false;
+
+    mappedFile = std::move (mapped);
+    return parseChunks (static_cast<const uint8*> (mappedFile->getData()), mappedFile->getSize());
+}
+
+bool PackedMidiFile::loadFrom (InputStream& sourceStream)
+{
+    clear();
+
+    const int maxSensibleMidiFileSize = 200 * 1024 * 1024;
+
+    if (! sourceStream.readIntoMemoryBlock (fileData, maxSensibleMidiFileSize))
+        return false;
+
+    return parseChunks (static_cast<const uint8*> (fileData.getData()), fileData.getSize());
+}
+
+bool PackedMidiFile::parseChunks (const uint8* d, size_t size)
+{
+    const auto optHeader = MidiFileHelpers::parseMidiHeader (d, size);
+
+    if (! optHeader.hasValue())
+    {
+        clear();
+        return false;
+    }
+
+    const auto header = *optHeader;
+    timeFormat = header.timeFormat;
+
+    d += header.bytesRead;
+    size -= (size_t) header.bytesRead;
+
+    for (int track = 0; track < header.numberOfTracks; ++track)
+    {
+        const auto optChunkType = MidiFileHelpers::tryRead<uint32> (d, size);
+        const auto optChunkSize = MidiFileHelpers::tryRead<uint32> (d, size);
+
+        if (! optChunkType.hasValue() || ! optChunkSize.hasValue() || size < *optChunkSize)
+        {
+            clear();
+            return false;
+        }
+
+        const auto chunkSize = *optChunkSize;
+
+        if (*optChunkType == ByteOrder::bigEndianInt ("MTrk"))
+            chunks.push_back ({ d, (int) chunkSize, nullptr });
+
+        size -= chunkSize;
+        d += chunkSize;
+    }
+
+    if (size != 0)
+    {
+        clear();
+        return false;
+    }
+
+    fileType = header.fileType;
+    return true;
+}
+
+int PackedMidiFile::getNumTracks() const noexcept
+{
+    return (int) chunks.size();
+}
+
+const PackedMidiFile::Track* PackedMidiFile::getTrack (int index)
+{
+    if (! isPositiveAndBelow (index, getNumTracks()))
+        return nullptr;
+
+    auto& chunk = chunks[(size_t) index];
+
+    if (chunk.track != nullptr)
+        return chunk.track.get();
+
+    auto track = std::make_unique<Track>();
+    auto& events = track->events;
+    auto& eventData = track->eventData;
+
+    // most events are three bytes of data after a one byte delta-time
+    events.reserve ((size_t) chunk.size / 4);
+    eventData.reserve ((size_t) chunk.size);
+
+    auto* data = chunk.data;
+    auto size = chunk.size;
+    int64 time = 0;
+    uint8 lastStatusByte = 0;
+
+    while (size > 0)
+    {
+        const auto delay = MidiMessage::readVariableLengthValue (data, size);
+
+        if (! delay.isValid())
+            break;
+
+        data += delay.bytesUsed;
+        size -= delay.bytesUsed;
+        time += delay.value;
+
+        if (size <= 0)
+            break;
+
+        int messSize = 0;
+        const MidiMessage mm (data, size, messSize, lastStatusByte, 0.0);
+
+        if (messSize <= 0)
+            break;
+
+        size -= messSize;
+        data += messSize;
+
+        const auto* raw = mm.getRawData();
+        const auto numBytes = mm.getRawDataSize();
+
+        events.push_back ({ (int32) jmin (time, (int64) std::numeric_limits<int32>::max()),
+                            (uint32) eventData.size(),
+                            (int32) numBytes });
+        eventData.insert (eventData.end(), raw, raw + numBytes);
+
+        if ((raw[0] & 0xf0) != 0xf0)
+            lastStatusByte = raw[0];
+    }
+
+    struct RawMessage
+    {
+        bool isNoteOn() const noexcept          { return (data[0] & 0xf0) == 0x90 && data[2] != 0; }
+        bool isNoteOff() const noexcept         { return (data[0] & 0xf0) == 0x80 || ((data[0] & 0xf0) == 0x90 && data[2] == 0); }
+        int getChannel() const noexcept         { return (data[0] & 0xf0) < 0xf0 ? (data[0] & 0x0f) + 1 : 0; }
+        int getNoteNumber() const noexcept      { return data[1]; }
+
+        const uint8* data;
+    };
+
+    const auto getMessage = [&eventData] (const Track::PackedEvent& e)
+    {
+        return RawMessage { eventData.data() + e.offset };
+    };
+
+    for (auto it = events.begin(); it != events.end();)
+    {
+        const auto nextTime = std::find_if (it, events.end(), [tick = it->tick] (const auto& e) { return e.tick != tick; });
+        reorderNoteOnsAfterNoteOffs (it, nextTime, getMessage);
+        it = nextTime;
+    }
+
+    chunk.track = std::move (track);
+    return chunk.track.get();
+}
+
+void PackedMidiFile::decodeAllTracks()
+{
+    for (int i = 0; i < getNumTracks(); ++i)
+        getTrack (i);
+}
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -865,6 +1077,109 @@ struct MidiFileTest final : public UnitTest
                 expect (sequence.getEventPointer (5)->message.isNoteOn());
             }
         }
+
+        beginTest ("PackedMidiFile reads the same events as MidiFile");
+        {
+            MemoryOutputStream os;
+
+            {
+                MidiMessageSequence first, second;
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    first.addEvent (MidiMessage::noteOn (1 + i % 3, 40 + i % 20, 0.5f).withTimeStamp (i * 10));
+                    first.addEvent (MidiMessage::noteOff (1 + i % 3, 40 + i % 20).withTimeStamp (i * 10 + 20));
+                }
+
+                const uint8 sysexData[] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+                second.addEvent (MidiMessage::tempoMetaEvent (500000).withTimeStamp (0));
+                second.addEvent (MidiMessage::createSysExMessage (sysexData, (int) sizeof (sysexData)).withTimeStamp (50));
+                second.addEvent (MidiMessage::controllerEvent (2, 7, 100).withTimeStamp (50));
+
+                MidiFile file;
+                file.setTicksPerQuarterNote (480);
+                file.addTrack (first);
+                file.addTrack (second);
+                file.writeTo (os);
+            }
+
+            MidiFile reference;
+            {
+                MemoryInputStream is (os.getData(), os.getDataSize(), false);
+                expect (reference.readFrom (is, false));
+            }
+
+            PackedMidiFile packed;
+            {
+                MemoryInputStream is (os.getData(), os.getDataSize(), false);
+                expect (packed.loadFrom (is));
+            }
+
+            expectEquals (packed.getNumTracks(), reference.getNumTracks());
+            expectEquals (packed.getTimeFormat(), reference.getTimeFormat());
+            expectEquals (packed.getFileType(), 1);
+
+            for (int t = 0; t < reference.getNumTracks(); ++t)
+            {
+                const auto& expected = *reference.getTrack (t);
+                const auto* track = packed.getTrack (t);
+
+                expect (track != nullptr);
+                expectEquals (track->getNumEvents(), expected.getNumEvents());
+
+                for (auto it = track->begin(); it != track->end(); ++it)
+                {
+                    const auto event = *it;
+                    const auto& message = expected.getEventPointer (it.getIndex())->message;
+
+                    expectEquals ((double) event.tick, message.getTimeStamp());
+                    expectEquals (event.numBytes, message.getRawDataSize());
+                    expect (std::equal (event.data, event.data + event.numBytes, message.getRawData()));
+                }
+            }
+
+            const auto* track = packed.getTrack (0);
+            expect (packed.getTrack (2) == nullptr);
+            expectEquals (track->getLastTick(), 1990 + 20);
+            expectEquals ((*track->findNextTick (1005)).tick, 1010);
+            expectEquals (track->findNextTick (0).getIndex(), 0);
+            expect (track->findNextTick (5000) == track->end());
+
+            TemporaryFile tempFile (".mid");
+            expect (tempFile.getFile().replaceWithData (os.getData(), os.getDataSize()));
+
+            PackedMidiFile mapped;
+            expect (mapped.loadFrom (tempFile.getFile()));
+            mapped.decodeAllTracks();
+            expectEquals (mapped.getNumTracks(), 2);
+            expectEquals (mapped.getTrack (1)->getNumEvents(), reference.getTrack (1)->getNumEvents());
+        }
+
+        beginTest ("PackedMidiFile respects running status and note order");
+        {
+            MemoryOutputStream os;
+            writeBytes (os, { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96 });
+            writeBytes (os, { 'M', 'T', 'r', 'k', 0, 0, 0, 11 });
+            writeBytes (os, { 0x10, 0x90, 0x40, 0x40, 0x00, 0x40, 0x00, 0x00, 0xff, 0x2f, 0x00 });
+
+            MemoryInputStream is (os.getData(), os.getDataSize(), false);
+            PackedMidiFile packed;
+            expect (packed.loadFrom (is));
+            expectEquals (packed.getFileType(), 0);
+
+            const auto* track = packed.getTrack (0);
+            expectEquals (track->getNumEvents(), 3);
+
+            // The note-off (a note-on with zero velocity) is moved before the note-on
+            expect (track->getEvent (0).getMessage().isNoteOff());
+            expect (track->getEvent (1).getMessage().isNoteOn());
+            expect (track->getEvent (2).getMessage().isEndOfTrackMetaEvent());
+            expectEquals (track->getEvent (1).tick, 0x10);
+
+            MemoryInputStream truncated (os.getData(), os.getDataSize() - 1, false);
+            expect (! packed.loadFrom (truncated));
+            expectEquals (packed.getNumTracks(), 0);
+        }
     }
 
     template <typename Fn>
@@ -207,4 +207,189 @@ private:
     JUCE_LEAK_DETECTOR (MidiFile)
 };
 
+//==============================================================================
+/**
+    A compact, read-only view of the events in a standard midi file.
+
+    MidiFile turns every event into a MidiMessageSequence::MidiEventHolder, which is
+    slow to build and uses a lot of memory for big files. PackedMidiFile instead keeps
+    the file's raw bytes (memory-mapped, if it's loaded from a File), and only decodes
+    a track the first time it's asked for. A decoded track stores each event as a
+    tick position and its raw bytes in a pair of flat arrays, so an event costs about
+    12 bytes plus its data, and seeking to a position is a binary search.
+
+    Events are kept in the order they appear in the track. Like MidiFile::readFrom(),
+    a note-off is moved in front of a note-on for the same note at the same tick. No
+    matching note-offs are added, and the timestamps are always in midi ticks.
+
+    @code
+    PackedMidiFile midiFile;
+
+    if (midiFile.loadFrom (file))
+        if (auto* track = midiFile.getTrack (0))
+            for (auto it = track->findNextTick (startTick); it != track->end(); ++it)
+                processEvent ((*it).getMessage());
+    @endcode
+
+    @see MidiFile
+
+    @tags{Audio}
+*/
+class JUCE_API  PackedMidiFile
+{
+public:
+    //==============================================================================
+    /** Creates an empty PackedMidiFile. */
+    PackedMidiFile();
+
+    /** Destructor. */
+    ~PackedMidiFile();
+
+    /** Move constructor. */
+    PackedMidiFile (PackedMidiFile&&) noexcept;
+
+    /** Move assignment operator. */
+    PackedMidiFile& operator= (PackedMidiFile&&) noexcept;
+
+    //==============================================================================
+    /** Describes one of the events in a track.
+        The data points into storage owned by the PackedMidiFile, so it's only valid
+        while the file is still loaded.
+    */
+    struct Event
+    {
+        /** Creates a MidiMessage from this event, with its timestamp set to the tick position. */
+        MidiMessage getMessage() const          { return MidiMessage (data, numBytes, (double) tick); }
+
+        /** A pointer to the event's raw midi data, including its status byte. */
+        const uint8* data = nullptr;
+
+        /** The number of bytes of midi data. */
+        int numBytes = 0;
+
+        /** The position of the event, in midi ticks from the start of the track. */
+        int tick = 0;
+    };
+
+    //==============================================================================
+    /** The decoded events of one track. */
+    class JUCE_API  Track
+    {
+    public:
+        /** Iterates over the events in a track. */
+        class Iterator
+        {
+        public:
+            using difference_type   = int;
+            using value_type        = Event;
+            using reference         = Event;
+            using pointer           = void;
+            using iterator_category = std::input_iterator_tag;
+
+            Iterator() = default;
+            Iterator (const Track& t, int i) noexcept  : track (&t), index (i) {}
+
+            Iterator& operator++() noexcept                            { ++index; return *this; }
+            Iterator operator++ (int) noexcept                         { auto copy = *this; ++index; return copy; }
+            bool operator== (const Iterator& other) const noexcept     { return index == other.index && track == other.track; }
+            bool operator!= (const Iterator& other) const noexcept     { return ! operator== (other); }
+            Event operator*() const noexcept                           { return track->getEvent (index); }
+
+            /** Returns the index of the event that the iterator points to. */
+            int getIndex() const noexcept                              { return index; }
+
+        private:
+            const Track* track = nullptr;
+            int index = 0;
+        };
+
+        /** Returns the number of events in the track. */
+        int getNumEvents() const noexcept                   { return (int) events.size(); }
+
+        /** Returns one of the events. The index must be in range. */
+        Event getEvent (int index) const noexcept;
+
+        /** Returns the tick position of the last event, or 0 if the track is empty. */
+        int getLastTick() const noexcept;
+
+        /** Returns an iterator pointing to the first event at or after the given tick.
+            This is a binary search, so is quick even for very long tracks.
+        */
+        Iterator findNextTick (int tick) const noexcept;
+
+        Iterator begin() const noexcept                     { return { *this, 0 }; }
+        Iterator end() const noexcept                       { return { *this, getNumEvents() }; }
+
+    private:
+        friend class PackedMidiFile;
+
+        struct PackedEvent
+        {
+            int32 tick;
+            uint32 offset;
+            int32 numBytes;
+        };
+
+        std::vector<PackedEvent> events;
+        std::vector<uint8> eventData;
+    };
+
+    //==============================================================================
+    /** Memory-maps a midi file and reads its header and track layout.
+        The tracks themselves aren't decoded until getTrack() is called.
+        @returns true if the file was a valid midi file
+    */
+    bool loadFrom (const File& file);
+
+    /** Reads a midi file from a stream, and reads its header and track layout.
+        The tracks themselves aren't decoded until getTrack() is called.
+        @returns true if the stream contained a valid midi file
+    */
+    bool loadFrom (InputStream& sourceStream);
+
+    /** Unloads the file. */
+    void clear();
+
+    //==============================================================================
+    /** Returns the number of tracks in the file. */
+    int getNumTracks() const noexcept;
+
+    /** Returns one of the tracks, decoding it first if it hasn't been used yet.
+
+        As this may decode the track, it mustn't be called from several threads at
+        once unless decodeAllTracks() has been called first.
+
+        @returns a pointer to the track, or nullptr if the index is out-of-range
+    */
+    const Track* getTrack (int index);
+
+    /** Decodes any tracks that haven't been decoded yet. */
+    void decodeAllTracks();
+
+    /** Returns the file's time format - see MidiFile::getTimeFormat(). */
+    short getTimeFormat() const noexcept                    { return timeFormat; }
+
+    /** Returns the file's type, which is 0, 1 or 2. */
+    int getFileType() const noexcept                        { return fileType; }
+
+private:
+    //==============================================================================
+    struct TrackChunk
+    {
+        const uint8* data = nullptr;
+        int size = 0;
+        std::unique_ptr<Track> track;
+    };
+
+    bool parseChunks (const uint8* data, size_t size);
+
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    MemoryBlock fileData;
+    std::vector<TrackChunk> chunks;
+    short timeFormat = 0;
+    int fileType = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PackedMidiFile)
+};
+
 } // namespace juce
@@ -192,6 +192,83 @@ namespace juce::universal_midi_packets
 
         Midi1ToBytestreamTranslator translator;
     };
+
+    /**
+        Passes Universal MIDI Packets through several converters in turn.
+
+        Each packet produced by one converter is handed straight to the next one,
+        and the packets produced by the last converter are passed to the callback.
+        The whole chain is resolved at compile time, so there's no type-erasure,
+        copying or allocation between the stages.
+
+        @code
+        ConverterChain<ToUMP2Converter, MyPerNoteFilter> chain;
+
+        dispatcher.dispatch (begin, end, time, [&] (const View& view, double t)
+        {
+            chain.convert (view, [&] (const View& converted) { receive (converted, t); });
+        });
+        @endcode
+
+        @tags{Audio}
+    */
+    template <typename... Converters>
+    class ConverterChain
+    {
+    public:
+        ConverterChain() = default;
+
+        explicit ConverterChain (Converters... c)
+            : converters (std::move (c)...) {}
+
+        template <typename Fn>
+        void convert (const View& v, Fn&& fn)
+        {
+            convertFrom<0> (v, fn);
+        }
+
+        /** Resets every converter in the chain which has a reset() function. */
+        void reset()
+        {
+            std::apply ([] (auto&... c) { (resetConverter (c), ...); }, converters);
+        }
+
+        /** Returns one of the converters in the chain. */
+        template <size_t Index>
+        auto& get() noexcept { return std::get<Index> (converters); }
+
+    private:
+        template <size_t Index, typename Fn>
+        void convertFrom (const View& v, Fn& fn)
+        {
+            if constexpr (Index == sizeof... (Converters))
+            {
+                fn (v);
+            }
+            else
+            {
+                std::get<Index> (converters).convert (v, [&] (const View& converted)
+                {
+                    convertFrom<Index + 1> (converted, fn);
+                });
+            }
+        }
+
+        template <typename Converter, typename = void>
+        struct HasReset : std::false_type {};
+
+        template <typename Converter>
+        struct HasReset<Converter, std::void_t<decltype (std::declval<Converter&>().reset())>> : std::true_type {};
+
+        template <typename Converter>
+        static void resetConverter (Converter& c)
+        {
+            if constexpr (HasReset<Converter>::value)
+                c.reset();
+        }
+
+        std::tuple<Converters...> converters;
+    };
 } // namespace juce::universal_midi_packets
 
 #endif
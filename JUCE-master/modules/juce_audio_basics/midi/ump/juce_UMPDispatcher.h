@@ -54,6 +54,10 @@ public:
 
         If the range ends part-way through a packet, the next call to `dispatch` will
         continue from that point in the packet (unless `reset` is called first).
+
+        Packets which lie completely inside the range are not copied: the View passed
+        to the callback points straight into the input, so it's only valid for the
+        duration of the callback.
     */
     template <typename PacketCallbackFunction>
     void dispatch (const uint32_t* begin,
@@ -61,16 +65,32 @@ public:
                    double timeStamp,
                    PacketCallbackFunction&& callback)
     {
-        std::for_each (begin, end, [&] (uint32_t word)
+        // First, finish off any packet that was left incomplete by the previous call
+        while (currentPacketLen != 0 && begin != end)
         {
-            nextPacket[currentPacketLen++] = word;
+            nextPacket[currentPacketLen++] = *begin++;
 
             if (currentPacketLen == Utils::getNumWordsForMessageType (nextPacket.front()))
             {
                 callback (View (nextPacket.data()), timeStamp);
                 currentPacketLen = 0;
             }
-        });
+        }
+
+        while (begin != end)
+        {
+            const auto numWords = (ptrdiff_t) Utils::getNumWordsForMessageType (*begin);
+
+            if (end - begin < numWords)
+            {
+                std::copy (begin, end, nextPacket.begin());
+                currentPacketLen = (size_t) (end - begin);
+                return;
+            }
+
+            callback (View (begin), timeStamp);
+            begin += numWords;
+        }
     }
 
 private:
@@ -125,11 +145,15 @@ public:
             Callback (BytestreamToUMPDispatcher& d, CallbackPtr c)
                 : dispatch (d), callbackPtr (c) {}
 
-            void handleIncomingMidiMessage (void*, const MidiMessage& msg) const
+            // The concatenator calls this in preference to handleIncomingMidiMessage, so
+            // complete messages (including SysEx) are converted without creating a MidiMessage.
+            void handleIncomingMidiBytes (void*, const uint8_t* data, int numBytes, double time) const
             {
-                Conversion::toMidi1 (BytestreamMidiView (&msg), [&] (const View& view)
+                const BytestreamMidiView view { Span (unalignedPointerCast<const std::byte*> (data), (size_t) numBytes), time };
+
+                Conversion::toMidi1 (view, [&] (const View& packet)
                 {
-                    dispatch.converter.convert (view, *callbackPtr);
+                    dispatch.converter.convert (packet, *callbackPtr);
                 });
             }
 
@@ -135,6 +135,95 @@ public:
             }
         }
 
+        beginTest ("Dispatcher passes complete packets without copying them");
+        {
+            const uint32_t words[] { 0x20904040, 0x40904000, 0x80000000, 0x10f80000, 0x30160102, 0x03040506, 0x20804000 };
+            std::vector<const uint32_t*> seen;
+            std::vector<uint32_t> firstWords;
+
+            Dispatcher dispatcher;
+            const auto callback = [&] (const View& v, double)
+            {
+                seen.push_back (v.data());
+                firstWords.push_back (v[0]);
+            };
+
+            dispatcher.dispatch (std::begin (words), std::end (words), 0.0, callback);
+
+            expect (seen == std::vector<const uint32_t*> { words, words + 1, words + 3, words + 4, words + 6 });
+
+            // Packets split across calls are still reassembled
+            seen.clear();
+            firstWords.clear();
+
+            for (auto split : { 1, 2, 5 })
+            {
+                dispatcher.dispatch (std::begin (words), words + split, 0.0, callback);
+                dispatcher.dispatch (words + split, std::end (words), 0.0, callback);
+            }
+
+            expect (firstWords == std::vector<uint32_t> { 0x20904040, 0x40904000, 0x10f80000, 0x30160102, 0x20804000,
+                                                          0x20904040, 0x40904000, 0x10f80000, 0x30160102, 0x20804000,
+                                                          0x20904040, 0x40904000, 0x10f80000, 0x30160102, 0x20804000 });
+        }
+
+        beginTest ("Converters can be chained");
+        {
+            ConverterChain<ToUMP2Converter, ToUMP1Converter> chain;
+
+            forEachNonSysExTestMessage (random, [&] (const MidiMessage& m)
+            {
+                const auto midi1 = toMidi1 (m);
+
+                Packets output;
+                chain.convert (View (midi1.data()), [&] (const View& v) { output.add (v); });
+
+                // Controllers may be held back by the MIDI 1 -> 2 translator, note-ons with
+                // zero velocity come back as note-offs, and program changes are preceded by
+                // the bank selects from any earlier controllers, but everything else should
+                // come back unchanged
+                if (m.isController())
+                    return;
+
+                std::vector<uint32_t> expected (midi1.data(), midi1.data() + midi1.size());
+
+                if (m.isNoteOn (true) && m.getVelocity() == 0)
+                    expected[0] = (expected[0] & 0xff0fffff) | 0x00800000;
+
+                auto numBankSelectWords = (size_t) 0;
+
+                if (m.isProgramChange() && output.size() == expected.size() + 2)
+                {
+                    const auto bankSelectStatus = (uint32_t) (0x20b00000 | ((m.getChannel() - 1) << 16));
+                    const auto* words = output.data();
+
+                    expect ((words[0] & 0xffffff00) == bankSelectStatus);
+                    expect ((words[1] & 0xffffff00) == (bankSelectStatus | 0x2000));
+                    numBankSelectWords = 2;
+                }
+
+                expect (output.size() == expected.size() + numBankSelectWords
+                        && std::equal (expected.begin(), expected.end(), output.data() + numBankSelectWords));
+            });
+
+            chain.reset();
+        }
+
+        beginTest ("BytestreamToUMPDispatcher converts SysEx straight from the input bytes");
+        {
+            BytestreamToUMPDispatcher dispatcher (PacketProtocol::MIDI_1_0, 1024);
+            const auto sysEx = createRandomSysEx (random, 100);
+            Packets output;
+
+            dispatcher.dispatch (sysEx.getRawData(), sysEx.getRawData() + sysEx.getRawDataSize(), 0.0, [&] (const View& v)
+            {
+                output.add (v);
+            });
+
+            const auto expected = toMidi1 (sysEx);
+            expect (output.size() == expected.size() && std::equal (output.data(), output.data() + output.size(), expected.data()));
+        }
+
         ToBytestreamDispatcher converter (0);
         Packets packets;
 
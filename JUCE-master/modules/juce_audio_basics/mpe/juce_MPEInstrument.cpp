@@ -53,6 +53,10 @@ MPEInstrument::MPEInstrument() noexcept
     mpeInstrumentFill (lastPressureLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (lastTimbreLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (isMemberChannelSustained, false);
+    mpeInstrumentFill (lastNotePlayedIndex, -1);
+
+    notes.ensureStorageAllocated (numPreallocatedNotes);
+    pendingChanges.reserve ((size_t) numPreallocatedNotes);
 
     pitchbendDimension.value = &MPENote::pitchbend;
     pressureDimension.value  = &MPENote::pressure;
@@ -211,6 +215,20 @@ void MPEInstrument::processNextMidiEvent (const MidiMessage& message)
     else if (message.isAftertouch())          processMidiAfterTouchMessage (message);
 }
 
+void MPEInstrument::processNextMidiBuffer (const MidiBuffer& buffer)
+{
+    const ScopedLock sl (lock);
+
+    {
+        const ScopedValueSetter<bool> batching (isBatchingChanges, true);
+
+        for (const auto metadata : buffer)
+            processNextMidiEvent (metadata.getMessage());
+    }
+
+    sendPendingChanges();
+}
+
 //==============================================================================
 void MPEInstrument::processMidiNoteOnMessage (const MidiMessage& message)
 {
@@ -285,8 +303,10 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
             {
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+                updateNoteIndex();
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
                 notes.remove (i);
+                updateNoteIndex();
             }
         }
     }
@@ -303,8 +323,10 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
             {
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+                updateNoteIndex();
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
                 notes.remove (i);
+                updateNoteIndex();
             }
         }
     }
@@ -370,11 +392,13 @@ void MPEInstrument::noteOn (int midiChannel,
         // pathological case: second note-on received for same note -> retrigger it
         alreadyPlayingNote->keyState = MPENote::off;
         alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+        updateNoteIndex();
         listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
         notes.remove (alreadyPlayingNote);
     }
 
     notes.add (newNote);
+    updateNoteIndex();
     listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
 }
 
@@ -392,6 +416,7 @@ void MPEInstrument::noteOff (int midiChannel,
     {
         note->keyState = (note->keyState == MPENote::keyDownAndSustained) ? MPENote::sustained : MPENote::off;
         note->noteOffVelocity = midiNoteOffVelocity;
+        updateNoteIndex();
 
         // If no more notes are playing on this channel in mpe mode, reset the dimension values
         if (! legacyMode.isEnabled && getLastNotePlayedPtr (midiChannel) == nullptr)
@@ -405,6 +430,7 @@ void MPEInstrument::noteOff (int midiChannel,
         {
             listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
             notes.remove (note);
+            updateNoteIndex();
         }
         else
         {
@@ -511,7 +537,7 @@ void MPEInstrument::updateDimensionMaster (bool isLowerZone, MPEDimension& dimen
             // master pitchbend is a special case: we don't change the note's own pitchbend,
             // instead we have to update its total (master + note) pitchbend.
             updateNoteTotalPitchbend (note);
-            listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); });
+            callListenersDimensionChanged (note, pitchbendDimension);
         }
         else if (dimension.getValue (note) != value)
         {
@@ -538,11 +564,60 @@ void MPEInstrument::updateDimensionForNote (MPENote& note, MPEDimension& dimensi
 //==============================================================================
 void MPEInstrument::callListenersDimensionChanged (const MPENote& note, const MPEDimension& dimension)
 {
+    if (isBatchingChanges)
+    {
+        const auto flag = (uint8) (&dimension == &pressureDimension ? 1 : (&dimension == &pitchbendDimension ? 2 : 4));
+
+        const auto pending = std::find_if (pendingChanges.begin(), pendingChanges.end(),
+                                           [&] (const PendingChange& c) { return c.noteID == note.noteID; });
+
+        if (pending != pendingChanges.end())
+            pending->dimensions |= flag;
+        else
+            pendingChanges.push_back ({ note.noteID, flag });
+
+        return;
+    }
+
     if (&dimension == &pressureDimension)  { listeners.call ([&] (Listener& l) { l.notePressureChanged  (note); }); return; }
     if (&dimension == &timbreDimension)    { listeners.call ([&] (Listener& l) { l.noteTimbreChanged    (note); }); return; }
     if (&dimension == &pitchbendDimension) { listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); }); return; }
 }
 
+void MPEInstrument::sendPendingChanges()
+{
+    for (const auto& change : pendingChanges)
+    {
+        const auto found = std::find_if (notes.begin(), notes.end(),
+                                         [&] (const MPENote& n) { return n.noteID == change.noteID; });
+
+        // The note was released, and noteReleased() has already reported its final values
+        if (found == notes.end())
+            continue;
+
+        const auto note = *found;
+
+        if ((change.dimensions & 1) != 0)  listeners.call ([&] (Listener& l) { l.notePressureChanged  (note); });
+        if ((change.dimensions & 2) != 0)  listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); });
+        if ((change.dimensions & 4) != 0)  listeners.call ([&] (Listener& l) { l.noteTimbreChanged    (note); });
+    }
+
+    pendingChanges.clear();
+}
+
+void MPEInstrument::updateNoteIndex() noexcept
+{
+    mpeInstrumentFill (lastNotePlayedIndex, -1);
+
+    for (int i = 0; i < notes.size(); ++i)
+    {
+        const auto& note = notes.getReference (i);
+
+        if (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+            lastNotePlayedIndex[note.midiChannel - 1] = i;
+    }
+}
+
 //==============================================================================
 void MPEInstrument::updateNoteTotalPitchbend (MPENote& note)
 {
@@ -625,6 +700,7 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
             {
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
                 notes.remove (i);
+                updateNoteIndex();
             }
             else
             {
@@ -779,16 +855,11 @@ const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexc
 {
     const ScopedLock sl (lock);
 
-    for (auto i = notes.size(); --i >= 0;)
-    {
-        auto& note = notes.getReference (i);
+    if (! isPositiveAndBelow (midiChannel - 1, (int) numElementsInArray (lastNotePlayedIndex)))
+        return nullptr;
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
-            return &note;
-    }
-
-    return nullptr;
+    const auto index = lastNotePlayedIndex[midiChannel - 1];
+    return index >= 0 ? &notes.getReference (index) : nullptr;
 }
 
 MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) noexcept
@@ -859,10 +930,12 @@ void MPEInstrument::releaseAllNotes()
         auto& note = notes.getReference (i);
         note.keyState = MPENote::off;
         note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+        updateNoteIndex();
         listeners.call ([&] (Listener& l) { l.noteReleased (note); });
     }
 
-    notes.clear();
+    notes.clearQuick();
+    updateNoteIndex();
 }
 
 //==============================================================================
@@ -2205,6 +2278,45 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("processNextMidiBuffer");
+        {
+            UnitTestInstrument test;
+            test.setZoneLayout (testLayout);
+
+            MidiBuffer buffer;
+            buffer.addEvent (MidiMessage::noteOn (3, 60, (uint8) 100), 0);
+            buffer.addEvent (MidiMessage::noteOn (4, 62, (uint8) 100), 1);
+
+            for (int i = 0; i < 5; ++i)
+            {
+                buffer.addEvent (MidiMessage::channelPressureChange (3, 20 + i), 2 + i);
+                buffer.addEvent (MidiMessage::pitchWheel (4, 9000 + i), 2 + i);
+            }
+
+            buffer.addEvent (MidiMessage::controllerEvent (3, 74, 70), 10);
+            buffer.addEvent (MidiMessage::noteOff (4, 62, (uint8) 33), 11);
+
+            test.processNextMidiBuffer (buffer);
+
+            // notes are still added and released straight away...
+            expectEquals (test.noteAddedCallCounter, 2);
+            expectEquals (test.noteReleasedCallCounter, 1);
+            expectHasFinishedNote (test, 4, 62, 33);
+            expectEquals (test.lastNoteFinished->pitchbend.as14BitInt(), 9004);
+
+            // ...but the changes to each note's dimensions are only reported once, with their
+            // final values, and not at all for notes that have been released
+            expectEquals (test.notePressureChangedCallCounter, 1);
+            expectEquals (test.noteTimbreChangedCallCounter, 1);
+            expectEquals (test.notePitchbendChangedCallCounter, 0);
+            expectNote (test.getNote (3, 60), 100, 24, 8192, 70, MPENote::keyDown);
+
+            // outside of a buffer, every change is reported
+            test.pressure (3, MPEValue::from7BitInt (50));
+            test.pressure (3, MPEValue::from7BitInt (51));
+            expectEquals (test.notePressureChangedCallCounter, 3);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 
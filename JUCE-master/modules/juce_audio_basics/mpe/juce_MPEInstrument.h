@@ -154,6 +154,25 @@ public:
     */
     virtual void processNextMidiEvent (const MidiMessage& message);
 
+    /** Processes all the messages in a MidiBuffer, in order, by calling
+        processNextMidiEvent() for each of them.
+
+        The instrument's lock is held once for the whole buffer, rather than once for
+        each message, and changes to the notes' pressure, pitchbend and timbre are
+        gathered up. Once the whole buffer has been processed, the listeners get at most
+        one notePressureChanged(), notePitchbendChanged() and noteTimbreChanged() call for
+        each note that changed, with its final values. Notes that are released within the
+        buffer don't get these calls, as noteReleased() reports their final values.
+
+        Notes being added and released, and changes to their key states, are still
+        reported straight away and in order.
+
+        Use this when the listeners only need to know the state at the end of each block,
+        for example to update a display. For sample-accurate modulation, call
+        processNextMidiEvent() at the position of each message instead.
+    */
+    void processNextMidiBuffer (const MidiBuffer& buffer);
+
     //==============================================================================
     /** Request a note-on on the given channel, with the given initial note
         number and velocity.
@@ -373,7 +392,11 @@ protected:
 
 private:
     //==============================================================================
-    Array<MPENote> notes;
+    // Storage for this many notes is allocated up-front, so that the MIDI thread won't
+    // normally need to allocate anything
+    static constexpr int numPreallocatedNotes = 128;
+
+    Array<MPENote, DummyCriticalSection, numPreallocatedNotes> notes;
     MPEZoneLayout zoneLayout;
     ListenerList<Listener> listeners;
 
@@ -381,6 +404,20 @@ private:
     uint8 lastTimbreLowerBitReceivedOnChannel[16];
     bool isMemberChannelSustained[16];
 
+    // For each channel, the index in notes of the most recent note with its key down, or -1.
+    // This is kept up to date whenever notes are added, removed or released, so that the
+    // per-channel controller messages don't need to search for their notes.
+    int lastNotePlayedIndex[16];
+
+    struct PendingChange
+    {
+        uint16 noteID;
+        uint8 dimensions;
+    };
+
+    std::vector<PendingChange> pendingChanges;
+    bool isBatchingChanges = false;
+
     struct LegacyMode
     {
         bool isEnabled = false;
@@ -405,6 +442,8 @@ private:
     void updateDimensionMaster (bool, MPEDimension&, MPEValue);
     void updateDimensionForNote (MPENote&, MPEDimension&, MPEValue);
     void callListenersDimensionChanged (const MPENote&, const MPEDimension&);
+    void sendPendingChanges();
+    void updateNoteIndex() noexcept;
     MPEValue getInitialValueForNewNote (int midiChannel, MPEDimension&) const;
 
     void processMidiNoteOnMessage (const MidiMessage&);
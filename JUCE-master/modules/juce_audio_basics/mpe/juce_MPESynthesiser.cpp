@@ -282,6 +282,11 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
         const ScopedLock sl (stealLock);
         usableVoicesToStealArray.ensureStorageAllocated (voices.size() + 1);
     }
+
+    {
+        const ScopedLock sl (voicesLock);
+        voicesToRender.ensureStorageAllocated (voices.size() + 1);
+    }
 }
 
 void MPESynthesiser::clearVoices()
@@ -340,25 +345,79 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 
 //==============================================================================
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    renderActiveVoices (buffer, startSample, numSamples);
+}
+
+void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
+{
+    renderActiveVoices (buffer, startSample, numSamples);
+}
+
+template <typename FloatType>
+void MPESynthesiser::renderActiveVoices (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    if (parallelRenderer == nullptr)
     {
-        if (voice->isActive())
-            voice->renderNextBlock (buffer, startSample, numSamples);
+        for (auto* voice : voices)
+        {
+            if (voice->isActive())
+                voice->renderNextBlock (buffer, startSample, numSamples);
+        }
+
+        return;
     }
+
+    voicesToRender.clearQuick();
+
+    for (auto* voice : voices)
+        if (voice->isActive())
+            voicesToRender.add (voice);
+
+    if (voicesToRender.size() > 1
+         && parallelRenderer->render (voicesToRender.getRawDataPointer(), voicesToRender.size(),
+                                      buffer, startSample, numSamples))
+        return;
+
+    for (auto* voice : voicesToRender)
+        voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
-void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
+//==============================================================================
+void MPESynthesiser::setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
 {
-    const ScopedLock sl (voicesLock);
+    std::unique_ptr<detail::ParallelVoiceRenderer> newRenderer;
 
-    for (auto* voice : voices)
+    if (numWorkerThreads > 0)
     {
-        if (voice->isActive())
-            voice->renderNextBlock (buffer, startSample, numSamples);
+        newRenderer = std::make_unique<detail::ParallelVoiceRenderer> (numWorkerThreads, maximumNumChannels, maximumBlockSize);
+
+        const ScopedLock sl (voicesLock);
+        newRenderer->setAudioWorkgroup (audioWorkgroup);
     }
+
+    {
+        const ScopedLock sl (voicesLock);
+        std::swap (parallelRenderer, newRenderer);
+    }
+
+    // the old worker threads are stopped here, outside the lock
+}
+
+int MPESynthesiser::getNumRenderThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumThreads() : 0;
+}
+
+void MPESynthesiser::setAudioWorkgroup (const AudioWorkgroup& workgroupToUse)
+{
+    const ScopedLock sl (voicesLock);
+    audioWorkgroup = workgroupToUse;
+
+    if (parallelRenderer != nullptr)
+        parallelRenderer->setAudioWorkgroup (audioWorkgroup);
 }
 
 } // namespace juce
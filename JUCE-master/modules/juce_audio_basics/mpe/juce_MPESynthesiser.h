@@ -35,6 +35,8 @@
 namespace juce
 {
 
+namespace detail { class ParallelVoiceRenderer; }
+
 //==============================================================================
 /**
     Base class for an MPE-compatible musical device that can play sounds.
@@ -147,6 +149,29 @@ public:
     */
     void setCurrentPlaybackSampleRate (double newRate) override;
 
+    //==============================================================================
+    /** Allows the active voices to be rendered on several threads at once.
+
+        This works in the same way as Synthesiser::setNumRenderThreads(): the voices are
+        rendered in groups by the audio thread and the given number of realtime worker
+        threads, and the results are summed in a fixed order.
+
+        Your voices must be safe to render concurrently with each other. Pass zero to stop
+        the worker threads and go back to rendering serially.
+
+        @see setAudioWorkgroup
+    */
+    void setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads set with setNumRenderThreads(). */
+    int getNumRenderThreads() const noexcept;
+
+    /** Sets the workgroup that the worker threads started by setNumRenderThreads() should join.
+
+        Call this from your AudioProcessor::audioWorkgroupContextChanged() override.
+    */
+    void setAudioWorkgroup (const AudioWorkgroup& workgroupToUse);
+
     //==============================================================================
     /** Handle incoming MIDI events.
 
@@ -319,6 +344,13 @@ private:
     mutable CriticalSection stealLock;
     mutable Array<MPESynthesiserVoice*> usableVoicesToStealArray;
 
+    std::unique_ptr<detail::ParallelVoiceRenderer> parallelRenderer;
+    Array<MPESynthesiserVoice*> voicesToRender;
+    AudioWorkgroup audioWorkgroup;
+
+    template <typename FloatType>
+    void renderActiveVoices (AudioBuffer<FloatType>&, int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
 
@@ -51,6 +51,7 @@ void ChannelRemappingAudioSource::setNumberOfChannelsToProduce (const int requir
 {
     const ScopedLock sl (lock);
     requiredNumberOfChannels = requiredNumberOfChannels_;
+    planNeedsUpdate = true;
 }
 
 void ChannelRemappingAudioSource::clearAllMappings()
@@ -59,6 +60,7 @@ void ChannelRemappingAudioSource::clearAllMappings()
 
     remappedInputs.clear();
     remappedOutputs.clear();
+    planNeedsUpdate = true;
 }
 
 void ChannelRemappingAudioSource::setInputChannelMapping (const int destIndex, const int sourceIndex)
@@ -69,6 +71,7 @@ void ChannelRemappingAudioSource::setInputChannelMapping (const int destIndex, c
         remappedInputs.add (-1);
 
     remappedInputs.set (destIndex, sourceIndex);
+    planNeedsUpdate = true;
 }
 
 void ChannelRemappingAudioSource::setOutputChannelMapping (const int sourceIndex, const int destIndex)
@@ -79,6 +82,7 @@ void ChannelRemappingAudioSource::setOutputChannelMapping (const int sourceIndex
         remappedOutputs.add (-1);
 
     remappedOutputs.set (sourceIndex, destIndex);
+    planNeedsUpdate = true;
 }
 
 int ChannelRemappingAudioSource::getRemappedInputChannel (const int inputChannelIndex) const
@@ -116,15 +120,24 @@ void ChannelRemappingAudioSource::getNextAudioBlock (const AudioSourceChannelInf
 {
     const ScopedLock sl (lock);
 
-    buffer.setSize (requiredNumberOfChannels, bufferToFill.numSamples, false, false, true);
-
     const int numChans = bufferToFill.buffer->getNumChannels();
 
+    if (planNeedsUpdate || numChans != numChannelsInPlan)
+        updateRenderPlan (numChans);
+
+    if (canRenderInPlace)
+    {
+        renderInPlace (bufferToFill);
+        return;
+    }
+
+    buffer.setSize (requiredNumberOfChannels, bufferToFill.numSamples, false, false, true);
+
     for (int i = 0; i < buffer.getNumChannels(); ++i)
     {
-        const int remappedChan = getRemappedInputChannel (i);
+        const int remappedChan = inputSources[(size_t) i];
 
-        if (remappedChan >= 0 && remappedChan < numChans)
+        if (remappedChan >= 0)
         {
             buffer.copyFrom (i, 0, *bufferToFill.buffer,
                              remappedChan,
@@ -141,18 +154,113 @@ void ChannelRemappingAudioSource::getNextAudioBlock (const AudioSourceChannelInf
 
     source->getNextAudioBlock (remappedInfo);
 
-    bufferToFill.clearActiveBufferRegion();
+    mixIntoDestination (bufferToFill);
+}
+
+void ChannelRemappingAudioSource::updateRenderPlan (int numChannelsAvailable)
+{
+    const auto getMapping = [numChannelsAvailable] (const Array<int>& mappings, int index)
+    {
+        const auto chan = isPositiveAndBelow (index, mappings.size()) ? mappings.getUnchecked (index) : -1;
+        return isPositiveAndBelow (chan, numChannelsAvailable) ? chan : -1;
+    };
+
+    inputSources.resize ((size_t) requiredNumberOfChannels);
+    outputConnections.clear();
+    outputConnections.reserve ((size_t) requiredNumberOfChannels);
+    channelPointers.resize ((size_t) requiredNumberOfChannels);
 
     for (int i = 0; i < requiredNumberOfChannels; ++i)
     {
-        const int remappedChan = getRemappedOutputChannel (i);
+        inputSources[(size_t) i] = getMapping (remappedInputs, i);
+
+        const auto dest = getMapping (remappedOutputs, i);
+
+        if (dest >= 0)
+            outputConnections.emplace_back (dest, i);
+    }
+
+    std::stable_sort (outputConnections.begin(), outputConnections.end(),
+                      [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+    // The source can use the destination's channels directly if each of its channels has a
+    // destination of its own, and reads either that same channel or nothing
+    canRenderInPlace = (int) outputConnections.size() == requiredNumberOfChannels;
+
+    for (size_t i = 1; canRenderInPlace && i < outputConnections.size(); ++i)
+        canRenderInPlace = outputConnections[i].first != outputConnections[i - 1].first;
+
+    for (const auto& [dest, chan] : outputConnections)
+        if (inputSources[(size_t) chan] >= 0 && inputSources[(size_t) chan] != dest)
+            canRenderInPlace = false;
+
+    numChannelsInPlan = numChannelsAvailable;
+    planNeedsUpdate = false;
+}
+
+void ChannelRemappingAudioSource::renderInPlace (const AudioSourceChannelInfo& bufferToFill)
+{
+    auto& dest = *bufferToFill.buffer;
+    const auto numSamples = bufferToFill.numSamples;
+    auto connection = outputConnections.begin();
+
+    for (int i = 0; i < dest.getNumChannels(); ++i)
+    {
+        if (connection != outputConnections.end() && connection->first == i)
+        {
+            auto* channel = dest.getWritePointer (i, bufferToFill.startSample);
+            channelPointers[(size_t) connection->second] = channel;
+
+            if (inputSources[(size_t) connection->second] < 0)
+                FloatVectorOperations::clear (channel, numSamples);
+
+            ++connection;
+        }
+        else
+        {
+            dest.clear (i, bufferToFill.startSample, numSamples);
+        }
+    }
+
+    AudioBuffer<float> channels (channelPointers.data(), requiredNumberOfChannels, numSamples);
+    source->getNextAudioBlock (AudioSourceChannelInfo (channels));
+}
+
+void ChannelRemappingAudioSource::mixIntoDestination (const AudioSourceChannelInfo& bufferToFill)
+{
+    auto& dest = *bufferToFill.buffer;
+    const auto numSamples = bufferToFill.numSamples;
+    auto connection = outputConnections.begin();
+
+    for (int i = 0; i < dest.getNumChannels(); ++i)
+    {
+        const auto next = std::find_if (connection, outputConnections.end(),
+                                        [i] (const auto& c) { return c.first != i; });
+        const auto numSources = std::distance (connection, next);
+
+        if (numSources == 0)
+        {
+            dest.clear (i, bufferToFill.startSample, numSamples);
+            continue;
+        }
+
+        auto* out = dest.getWritePointer (i, bufferToFill.startSample);
+        const auto* first = buffer.getReadPointer (connection->second);
 
-        if (remappedChan >= 0 && remappedChan < numChans)
+        // Writing the first two sources in one pass saves clearing the channel and reading it back
+        if (numSources == 1)
+        {
+            FloatVectorOperations::copy (out, first, numSamples);
+        }
+        else
         {
-            bufferToFill.buffer->addFrom (remappedChan, bufferToFill.startSample,
-                                          buffer, i, 0, bufferToFill.numSamples);
+            FloatVectorOperations::add (out, first, buffer.getReadPointer ((connection + 1)->second), numSamples);
 
+            for (auto extra = connection + 2; extra != next; ++extra)
+                FloatVectorOperations::add (out, buffer.getReadPointer (extra->second), numSamples);
         }
+
+        connection = next;
     }
 }
 
@@ -196,4 +304,148 @@ void ChannelRemappingAudioSource::restoreFromXml (const XmlElement& e)
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ChannelRemappingAudioSourceTests final : public UnitTest
+{
+public:
+    ChannelRemappingAudioSourceTests()
+        : UnitTest ("ChannelRemappingAudioSource", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("A permutation of channels is rendered in place");
+        {
+            TestSource testSource;
+            ChannelRemappingAudioSource remapper (&testSource, false);
+            remapper.setNumberOfChannelsToProduce (2);
+            remapper.setInputChannelMapping (0, 2);
+            remapper.setOutputChannelMapping (0, 2);
+            remapper.setInputChannelMapping (1, 0);
+            remapper.setOutputChannelMapping (1, 0);
+
+            auto buffer = createBuffer (3);
+            remapper.getNextAudioBlock (AudioSourceChannelInfo (&buffer, startSample, numSamples));
+
+            expect (testSource.channelPointers[0] == buffer.getReadPointer (2, startSample));
+            expect (testSource.channelPointers[1] == buffer.getReadPointer (0, startSample));
+
+            expect (regionMatches (buffer, 0, 1.0f + 20.0f));
+            expect (regionMatches (buffer, 1, 0.0f));
+            expect (regionMatches (buffer, 2, 3.0f + 10.0f));
+            expect (outsideRegionIsUntouched (buffer));
+        }
+
+        beginTest ("Channels with no input are cleared before being rendered in place");
+        {
+            TestSource testSource;
+            ChannelRemappingAudioSource remapper (&testSource, false);
+            remapper.setNumberOfChannelsToProduce (1);
+            remapper.setOutputChannelMapping (0, 1);
+
+            auto buffer = createBuffer (2);
+            remapper.getNextAudioBlock (AudioSourceChannelInfo (&buffer, startSample, numSamples));
+
+            expect (testSource.channelPointers[0] == buffer.getReadPointer (1, startSample));
+            expect (regionMatches (buffer, 0, 0.0f));
+            expect (regionMatches (buffer, 1, 10.0f));
+            expect (outsideRegionIsUntouched (buffer));
+        }
+
+        beginTest ("Many channels can be mixed into one");
+        {
+            TestSource testSource;
+            ChannelRemappingAudioSource remapper (&testSource, false);
+            remapper.setNumberOfChannelsToProduce (3);
+
+            for (int i = 0; i < 3; ++i)
+                remapper.setOutputChannelMapping (i, 1);
+
+            remapper.setInputChannelMapping (0, 0);
+            remapper.setInputChannelMapping (1, 0);
+            remapper.setInputChannelMapping (2, 1);
+
+            auto buffer = createBuffer (2);
+            remapper.getNextAudioBlock (AudioSourceChannelInfo (&buffer, startSample, numSamples));
+
+            expect (testSource.channelPointers[0] != buffer.getReadPointer (0, startSample));
+            expect (regionMatches (buffer, 0, 0.0f));
+            expect (regionMatches (buffer, 1, (1.0f + 10.0f) + (1.0f + 20.0f) + (2.0f + 30.0f)));
+            expect (outsideRegionIsUntouched (buffer));
+
+            // Changing the mapping switches back to rendering in place
+            remapper.setNumberOfChannelsToProduce (1);
+            remapper.setInputChannelMapping (0, 1);
+
+            buffer = createBuffer (2);
+            remapper.getNextAudioBlock (AudioSourceChannelInfo (&buffer, startSample, numSamples));
+
+            expect (testSource.channelPointers[0] == buffer.getReadPointer (1, startSample));
+            expect (regionMatches (buffer, 1, 2.0f + 10.0f));
+        }
+    }
+
+private:
+    static constexpr int startSample = 8, numSamples = 16;
+
+    // Adds 10 times the (1-based) channel number to each channel
+    struct TestSource final : public AudioSource
+    {
+        void prepareToPlay (int, double) override {}
+        void releaseResources() override {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            channelPointers.clear();
+
+            for (int i = 0; i < info.buffer->getNumChannels(); ++i)
+            {
+                channelPointers.push_back (info.buffer->getReadPointer (i, info.startSample));
+                FloatVectorOperations::add (info.buffer->getWritePointer (i, info.startSample),
+                                            10.0f * (float) (i + 1), info.numSamples);
+            }
+        }
+
+        std::vector<const float*> channelPointers;
+    };
+
+    // Each channel is filled with its (1-based) channel number
+    static AudioBuffer<float> createBuffer (int numChannels)
+    {
+        AudioBuffer<float> buffer (numChannels, startSample + numSamples + 8);
+
+        for (int i = 0; i < numChannels; ++i)
+            FloatVectorOperations::fill (buffer.getWritePointer (i), (float) (i + 1), buffer.getNumSamples());
+
+        return buffer;
+    }
+
+    static bool regionMatches (const AudioBuffer<float>& buffer, int channel, float value)
+    {
+        const auto* data = buffer.getReadPointer (channel, startSample);
+        return std::all_of (data, data + numSamples, [value] (auto x) { return exactlyEqual (x, value); });
+    }
+
+    static bool outsideRegionIsUntouched (const AudioBuffer<float>& buffer)
+    {
+        for (int i = 0; i < buffer.getNumChannels(); ++i)
+        {
+            const auto* data = buffer.getReadPointer (i);
+
+            for (int s = 0; s < buffer.getNumSamples(); ++s)
+                if ((s < startSample || s >= startSample + numSamples) && ! exactlyEqual (data[s], (float) (i + 1)))
+                    return false;
+        }
+
+        return true;
+    }
+};
+
+static ChannelRemappingAudioSourceTests channelRemappingAudioSourceTests;
+
+#endif
+
 } // namespace juce
@@ -48,6 +48,12 @@ namespace juce
     create an appropriate mapping, otherwise no channels will be connected and
     it'll produce silence.
 
+    When every channel of the input source is sent to a different output channel, and
+    each one either takes its input from that same channel or has no input, the source
+    renders straight into the buffer passed to getNextAudioBlock(), without any copying.
+    Otherwise the channels are gathered into a temporary buffer, and then copied or mixed
+    back into the output channels.
+
     @see AudioSource
 
     @tags{Audio}
@@ -147,6 +153,17 @@ private:
     AudioSourceChannelInfo remappedInfo;
     CriticalSection lock;
 
+    // Worked out from the mappings whenever they, or the number of channels we're given, change
+    std::vector<int> inputSources;                      // for each of the source's channels, the channel to read, or -1
+    std::vector<std::pair<int, int>> outputConnections; // (destination, source channel) pairs, sorted by destination
+    std::vector<float*> channelPointers;
+    int numChannelsInPlan = -1;
+    bool planNeedsUpdate = true, canRenderInPlace = false;
+
+    void updateRenderPlan (int numChannelsAvailable);
+    void renderInPlace (const AudioSourceChannelInfo&);
+    void mixIntoDestination (const AudioSourceChannelInfo&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelRemappingAudioSource)
 };
 
@@ -45,6 +45,61 @@ MixerAudioSource::~MixerAudioSource()
     removeAllInputs();
 }
 
+//==============================================================================
+void MixerAudioSource::setNumMixThreads (int numWorkerThreads, int maximumNumChannels)
+{
+    std::unique_ptr<RealtimeThreadPool> newThreads;
+
+    if (numWorkerThreads > 0)
+    {
+        jassert (maximumNumChannels > 0);
+        newThreads = std::make_unique<RealtimeThreadPool> (RealtimeThreadPoolOptions{}.withThreadName ("Mixer Thread")
+                                                                            .withNumberOfThreads (numWorkerThreads));
+
+        const ScopedLock sl (lock);
+        newThreads->setAudioWorkgroup (audioWorkgroup);
+    }
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (workerThreads, newThreads);
+        maxNumMixChannels = workerThreads != nullptr ? jmax (1, maximumNumChannels) : 0;
+        updateScratchBuffers();
+    }
+
+    // the old worker threads are stopped here, outside the lock
+}
+
+int MixerAudioSource::getNumMixThreads() const noexcept
+{
+    return workerThreads != nullptr ? workerThreads->getNumThreads() : 0;
+}
+
+void MixerAudioSource::setAudioWorkgroup (const AudioWorkgroup& workgroupToUse)
+{
+    const ScopedLock sl (lock);
+    audioWorkgroup = workgroupToUse;
+
+    if (workerThreads != nullptr)
+        workerThreads->setAudioWorkgroup (audioWorkgroup);
+}
+
+void MixerAudioSource::updateScratchBuffers()
+{
+    if (workerThreads == nullptr)
+    {
+        scratchBuffers.clear();
+        return;
+    }
+
+    // Input 0 renders straight into the output, so its buffer is never used, but having
+    // one for every input keeps the indexing simple
+    scratchBuffers.resize ((size_t) inputs.size());
+
+    for (auto& buffer : scratchBuffers)
+        buffer.setSize (maxNumMixChannels, bufferSizeExpected, false, false, true);
+}
+
 //==============================================================================
 void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhenRemoved)
 {
@@ -66,6 +121,7 @@ void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhen
 
         inputsToDelete.setBit (inputs.size(), deleteWhenRemoved);
         inputs.add (input);
+        updateScratchBuffers();
     }
 }
 
@@ -87,6 +143,7 @@ void MixerAudioSource::removeInputSource (AudioSource* const input)
 
             inputsToDelete.shiftBits (-1, index);
             inputs.remove (index);
+            updateScratchBuffers();
         }
 
         input->releaseResources();
@@ -105,6 +162,7 @@ void MixerAudioSource::removeAllInputs()
                 toDelete.add (inputs.getUnchecked (i));
 
         inputs.clear();
+        updateScratchBuffers();
     }
 
     for (int i = toDelete.size(); --i >= 0;)
@@ -119,6 +177,7 @@ void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sample
 
     currentSampleRate = sampleRate;
     bufferSizeExpected = samplesPerBlockExpected;
+    updateScratchBuffers();
 
     for (int i = inputs.size(); --i >= 0;)
         inputs.getUnchecked (i)->prepareToPlay (samplesPerBlockExpected, sampleRate);
@@ -135,12 +194,46 @@ void MixerAudioSource::releaseResources()
 
     currentSampleRate = 0;
     bufferSizeExpected = 0;
+    updateScratchBuffers();
+}
+
+bool MixerAudioSource::mixInParallel (const AudioSourceChannelInfo& info)
+{
+    const auto numChannels = jmax (1, info.buffer->getNumChannels());
+
+    if (workerThreads == nullptr
+         || inputs.size() < 2
+         || numChannels > maxNumMixChannels
+         || info.numSamples > bufferSizeExpected)
+        return false;
+
+    workerThreads->run (inputs.size(), [&] (int index)
+    {
+        if (index == 0)
+        {
+            inputs.getUnchecked (0)->getNextAudioBlock (info);
+            return;
+        }
+
+        // Refers to the scratch data, so that the input sees the same number of channels as it would when mixing serially
+        AudioBuffer<float> target (scratchBuffers[(size_t) index].getArrayOfWritePointers(), numChannels, info.numSamples);
+        inputs.getUnchecked (index)->getNextAudioBlock (AudioSourceChannelInfo (&target, 0, info.numSamples));
+    });
+
+    for (int i = 1; i < inputs.size(); ++i)
+        for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+            info.buffer->addFrom (chan, info.startSample, scratchBuffers[(size_t) i], chan, 0, info.numSamples);
+
+    return true;
 }
 
 void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
     const ScopedLock sl (lock);
 
+    if (mixInParallel (info))
+        return;
+
     if (inputs.size() > 0)
     {
         inputs.getUnchecked (0)->getNextAudioBlock (info);
@@ -167,4 +260,68 @@ void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MixerAudioSourceTests final : public UnitTest
+{
+public:
+    MixerAudioSourceTests()
+        : UnitTest ("MixerAudioSource", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Mixing on worker threads gives the same result as mixing serially");
+        {
+            constexpr int numInputs = 24, blockSize = 256, numBlocks = 8;
+
+            MixerAudioSource serial, parallel;
+            parallel.setNumMixThreads (3, 2);
+            expectEquals (parallel.getNumMixThreads(), 3);
+
+            for (int i = 0; i < numInputs; ++i)
+            {
+                for (auto* mixer : { &serial, &parallel })
+                {
+                    auto* tone = new ToneGeneratorAudioSource();
+                    tone->setFrequency (100.0 + 37.0 * i);
+                    tone->setAmplitude (1.0f / (float) (i + 1));
+                    mixer->addInputSource (tone, true);
+                }
+            }
+
+            serial.prepareToPlay (blockSize, 44100.0);
+            parallel.prepareToPlay (blockSize, 44100.0);
+
+            AudioBuffer<float> serialOut (2, blockSize + 10), parallelOut (2, blockSize + 10);
+            bool allEqual = true;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                serialOut.clear();
+                parallelOut.clear();
+
+                serial  .getNextAudioBlock (AudioSourceChannelInfo (&serialOut,   10, blockSize));
+                parallel.getNextAudioBlock (AudioSourceChannelInfo (&parallelOut, 10, blockSize));
+
+                for (int chan = 0; chan < 2; ++chan)
+                    for (int i = 0; i < serialOut.getNumSamples(); ++i)
+                        allEqual = allEqual && exactlyEqual (serialOut.getSample (chan, i), parallelOut.getSample (chan, i));
+            }
+
+            expect (allEqual);
+            expect (! exactlyEqual (parallelOut.getMagnitude (10, blockSize), 0.0f));
+
+            parallel.setNumMixThreads (0, 0);
+            expectEquals (parallel.getNumMixThreads(), 0);
+        }
+    }
+};
+
+static MixerAudioSourceTests mixerAudioSourceTests;
+
+#endif
+
 } // namespace juce
@@ -81,6 +81,37 @@ public:
     */
     void removeAllInputs();
 
+    //==============================================================================
+    /** Allows the inputs to be pulled on several threads at once.
+
+        Calling this with a non-zero number will start that many realtime worker threads.
+        During each call to getNextAudioBlock(), the audio thread and the workers share out
+        the inputs, each of which renders into its own scratch buffer. The buffers are then
+        added to the output in the order the inputs were added, so the result is the same as
+        when mixing serially, whatever the timing of the threads.
+
+        The scratch buffers are sized using the maximum number of channels given here, and
+        the block size passed to prepareToPlay(). Blocks that are larger than this, or have
+        more channels, are mixed serially.
+
+        Your input sources must be safe to call concurrently with each other, so sources
+        that share state, such as a reader or a BufferingAudioSource's background thread,
+        need to be able to handle that.
+
+        Pass zero to stop the worker threads and go back to mixing serially.
+
+        @see setAudioWorkgroup
+    */
+    void setNumMixThreads (int numWorkerThreads, int maximumNumChannels);
+
+    /** Returns the number of worker threads set with setNumMixThreads(). */
+    int getNumMixThreads() const noexcept;
+
+    /** Sets the workgroup that the worker threads started by setNumMixThreads() should join,
+        so that they're scheduled alongside the audio thread.
+    */
+    void setAudioWorkgroup (const AudioWorkgroup& workgroupToUse);
+
     //==============================================================================
     /** Implementation of the AudioSource method.
         This will call prepareToPlay() on all its input sources.
@@ -105,6 +136,14 @@ private:
     double currentSampleRate;
     int bufferSizeExpected;
 
+    std::unique_ptr<RealtimeThreadPool> workerThreads;
+    std::vector<AudioBuffer<float>> scratchBuffers;
+    AudioWorkgroup audioWorkgroup;
+    int maxNumMixChannels = 0;
+
+    void updateScratchBuffers();
+    bool mixInParallel (const AudioSourceChannelInfo&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MixerAudioSource)
 };
 
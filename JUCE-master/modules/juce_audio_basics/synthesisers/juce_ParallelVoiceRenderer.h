@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+//==============================================================================
+/*  Renders synthesiser voices on a set of realtime worker threads.
+
+    The active voices are dealt out in turn to a fixed number of groups. Each group renders
+    its voices into its own scratch buffer, and whichever thread is free picks up the next
+    group. Once every group is done, the audio thread adds the scratch buffers to the output
+    in group order, so the result doesn't depend on which thread rendered which group.
+*/
+class ParallelVoiceRenderer
+{
+public:
+    ParallelVoiceRenderer (int numWorkerThreads, int maxNumChannels, int maxBlockSizeIn)
+        : threads (RealtimeThreadPoolOptions{}.withThreadName ("Synth Voice Thread")
+                                             .withNumberOfThreads (numWorkerThreads)),
+          numGroups (2 * (numWorkerThreads + 1)),
+          maxChannels (maxNumChannels),
+          maxBlockSize (maxBlockSizeIn)
+    {
+        jassert (numWorkerThreads > 0 && maxNumChannels > 0 && maxBlockSizeIn > 0);
+
+        floatScratch .resize ((size_t) numGroups);
+        doubleScratch.resize ((size_t) numGroups);
+
+        for (auto& buffer : floatScratch)   buffer.setSize (maxChannels, maxBlockSize);
+        for (auto& buffer : doubleScratch)  buffer.setSize (maxChannels, maxBlockSize);
+    }
+
+    int getNumThreads() const noexcept          { return threads.getNumThreads(); }
+
+    void setAudioWorkgroup (const AudioWorkgroup& newWorkgroup)
+    {
+        threads.setAudioWorkgroup (newWorkgroup);
+    }
+
+    /*  Call from the audio thread only. Adds the output of each voice to the given region of
+        the buffer. Returns false without rendering anything if the buffer has more channels
+        than this renderer was prepared for, in which case the caller should render serially.
+    */
+    template <typename VoiceType, typename FloatType>
+    bool render (VoiceType* const* voices, int numVoices,
+                 AudioBuffer<FloatType>& output, int startSample, int numSamples)
+    {
+        const auto numChannels = output.getNumChannels();
+
+        if (numChannels > maxChannels)
+            return false;
+
+        auto& scratch = getScratch ((FloatType*) nullptr);
+        const auto numGroupsToUse = jmin (numGroups, numVoices);
+
+        for (int offset = 0; offset < numSamples; offset += maxBlockSize)
+        {
+            const auto numThisTime = jmin (maxBlockSize, numSamples - offset);
+
+            threads.run (numGroupsToUse, [&] (int group)
+            {
+                auto& buffer = scratch[(size_t) group];
+
+                // Refers to the scratch data, so that the voices see the same number of channels as the output
+                AudioBuffer<FloatType> target (buffer.getArrayOfWritePointers(), numChannels, numThisTime);
+                target.clear();
+
+                for (auto i = group; i < numVoices; i += numGroupsToUse)
+                    voices[i]->renderNextBlock (target, 0, numThisTime);
+            });
+
+            for (int group = 0; group < numGroupsToUse; ++group)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    output.addFrom (ch, startSample + offset, scratch[(size_t) group], ch, 0, numThisTime);
+        }
+
+        return true;
+    }
+
+private:
+    //==============================================================================
+    std::vector<AudioBuffer<float>>&  getScratch (float*)   { return floatScratch; }
+    std::vector<AudioBuffer<double>>& getScratch (double*)  { return doubleScratch; }
+
+    //==============================================================================
+    RealtimeThreadPool threads;
+    const int numGroups, maxChannels, maxBlockSize;
+    std::vector<AudioBuffer<float>> floatScratch;
+    std::vector<AudioBuffer<double>> doubleScratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelVoiceRenderer)
+};
+
+} // namespace juce::detail
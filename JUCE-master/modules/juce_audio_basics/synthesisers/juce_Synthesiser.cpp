@@ -106,6 +106,7 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    updateVoiceIndices();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
@@ -116,6 +117,13 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
         const ScopedLock sl (lock);
         newVoice->setCurrentPlaybackSampleRate (sampleRate);
         voice = voices.add (newVoice);
+        voice->indexInSynthesiser = voices.size() - 1;
+
+        // setting the bit first makes sure the storage is allocated here rather than on the audio thread
+        possiblyFreeVoices.setBit (voice->indexInSynthesiser);
+
+        if (voice->isVoiceActive())
+            possiblyFreeVoices.clearBit (voice->indexInSynthesiser);
     }
 
     {
@@ -123,13 +131,97 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
         usableVoicesToStealArray.ensureStorageAllocated (voices.size() + 1);
     }
 
+    {
+        const ScopedLock sl (lock);
+        voicesToRender.ensureStorageAllocated (voices.size() + 1);
+    }
+
     return voice;
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
+
+    if (auto* voice = voices[index])
+        removeFromNoteIndex (voice);
+
     voices.remove (index);
+    updateVoiceIndices();
+}
+
+void Synthesiser::updateVoiceIndices()
+{
+    std::fill (std::begin (firstVoiceForNote), std::end (firstVoiceForNote), nullptr);
+    possiblyFreeVoices.setRange (0, possiblyFreeVoices.getHighestBit() + 1, false);
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        voice->indexInSynthesiser = i;
+        voice->indexedNote = -1;
+        voice->nextVoiceWithSameNote = nullptr;
+
+        if (isPositiveAndBelow (voice->currentlyPlayingNote, numElementsInArray (firstVoiceForNote)))
+            addToNoteIndex (voice, voice->currentlyPlayingNote);
+
+        if (! voice->isVoiceActive())
+            possiblyFreeVoices.setBit (i);
+    }
+}
+
+void Synthesiser::addToNoteIndex (SynthesiserVoice* voice, int midiNoteNumber) noexcept
+{
+    jassert (voice->indexedNote < 0);
+
+    if (isPositiveAndBelow (midiNoteNumber, numElementsInArray (firstVoiceForNote)))
+    {
+        voice->indexedNote = midiNoteNumber;
+        voice->nextVoiceWithSameNote = firstVoiceForNote[midiNoteNumber];
+        firstVoiceForNote[midiNoteNumber] = voice;
+    }
+}
+
+void Synthesiser::removeFromNoteIndex (SynthesiserVoice* voice) noexcept
+{
+    if (voice->indexedNote < 0)
+        return;
+
+    for (auto** v = &firstVoiceForNote[voice->indexedNote]; *v != nullptr; v = &((*v)->nextVoiceWithSameNote))
+    {
+        if (*v == voice)
+        {
+            *v = voice->nextVoiceWithSameNote;
+            break;
+        }
+    }
+
+    voice->indexedNote = -1;
+    voice->nextVoiceWithSameNote = nullptr;
+}
+
+template <typename Callback>
+void Synthesiser::forEachVoiceWithNote (int midiNoteNumber, Callback&& callback)
+{
+    // The index may still hold voices that have since finished, so each one is checked
+    if (isPositiveAndBelow (midiNoteNumber, numElementsInArray (firstVoiceForNote)))
+    {
+        for (auto* voice = firstVoiceForNote[midiNoteNumber]; voice != nullptr;)
+        {
+            auto* next = voice->nextVoiceWithSameNote;
+
+            if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+                callback (voice);
+
+            voice = next;
+        }
+    }
+    else
+    {
+        for (auto* voice : voices)
+            if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+                callback (voice);
+    }
 }
 
 void Synthesiser::clearSounds()
@@ -162,6 +254,45 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setSubBlockSplittingEnabled (bool shouldSplitBlocks) noexcept
+{
+    subBlockSplittingEnabled = shouldSplitBlocks;
+}
+
+void Synthesiser::setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    std::unique_ptr<detail::ParallelVoiceRenderer> newRenderer;
+
+    if (numWorkerThreads > 0)
+    {
+        newRenderer = std::make_unique<detail::ParallelVoiceRenderer> (numWorkerThreads, maximumNumChannels, maximumBlockSize);
+
+        const ScopedLock sl (lock);
+        newRenderer->setAudioWorkgroup (audioWorkgroup);
+    }
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (parallelRenderer, newRenderer);
+    }
+
+    // the old worker threads are stopped here, outside the lock
+}
+
+int Synthesiser::getNumRenderThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumThreads() : 0;
+}
+
+void Synthesiser::setAudioWorkgroup (const AudioWorkgroup& workgroupToUse)
+{
+    const ScopedLock sl (lock);
+    audioWorkgroup = workgroupToUse;
+
+    if (parallelRenderer != nullptr)
+        parallelRenderer->setAudioWorkgroup (audioWorkgroup);
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -192,7 +323,30 @@ void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
 
     const ScopedLock sl (lock);
 
-    for (; numSamples > 0; ++midiIterator)
+    if (! subBlockSplittingEnabled)
+    {
+        const auto endSample = startSample + numSamples;
+
+        for (; midiIterator != midiData.cend() && (*midiIterator).samplePosition < endSample; ++midiIterator)
+        {
+            const auto metadata = *midiIterator;
+            currentEventSampleOffset = metadata.samplePosition - startSample;
+            handleMidiEvent (metadata.getMessage());
+        }
+
+        currentEventSampleOffset = 0;
+
+        if (targetChannels > 0 && numSamples > 0)
+            renderVoices (outputAudio, startSample, numSamples);
+
+        for (auto* voice : voices)
+        {
+            voice->noteStartSampleOffset = 0;
+            voice->noteStopSampleOffset = jmin (voice->noteStopSampleOffset, 0);
+        }
+    }
+
+    for (; subBlockSplittingEnabled && numSamples > 0; ++midiIterator)
     {
         if (midiIterator == midiData.cend())
         {
@@ -253,13 +407,42 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    renderAllVoices (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    renderAllVoices (buffer, startSample, numSamples);
+}
+
+template <typename FloatType>
+void Synthesiser::renderAllVoices (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+{
+    if (parallelRenderer == nullptr)
+    {
+        for (auto* voice : voices)
+            voice->renderNextBlock (buffer, startSample, numSamples);
+
+        return;
+    }
+
+    // Idle voices are still called, as they would be when rendering serially
+    voicesToRender.clearQuick();
+
     for (auto* voice : voices)
+    {
+        if (voice->isVoiceActive())
+            voicesToRender.add (voice);
+        else
+            voice->renderNextBlock (buffer, startSample, numSamples);
+    }
+
+    if (voicesToRender.size() > 1
+         && parallelRenderer->render (voicesToRender.getRawDataPointer(), voicesToRender.size(),
+                                      buffer, startSample, numSamples))
+        return;
+
+    for (auto* voice : voicesToRender)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
@@ -316,9 +499,11 @@ void Synthesiser::noteOn (const int midiChannel,
         {
             // If hitting a note that's still ringing, stop it first (it could be
             // still playing because of the sustain or sostenuto pedal).
-            for (auto* voice : voices)
-                if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
+            forEachVoiceWithNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
+            {
+                if (voice->isPlayingChannel (midiChannel))
                     stopVoice (voice, 1.0f, true);
+            });
 
             startVoice (findFreeVoice (sound, midiChannel, midiNoteNumber, shouldStealNotes),
                         sound, midiChannel, midiNoteNumber, velocity);
@@ -337,6 +522,14 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
         if (voice->currentlyPlayingSound != nullptr)
             voice->stopNote (0.0f, false);
 
+        removeFromNoteIndex (voice);
+        addToNoteIndex (voice, midiNoteNumber);
+
+        if (voice->indexInSynthesiser >= 0)
+            possiblyFreeVoices.clearBit (voice->indexInSynthesiser);
+
+        voice->noteStartSampleOffset = currentEventSampleOffset;
+        voice->noteStopSampleOffset = -1;
         voice->currentlyPlayingNote = midiNoteNumber;
         voice->currentPlayingMidiChannel = midiChannel;
         voice->noteOnTime = ++lastNoteOnCounter;
@@ -354,10 +547,14 @@ void Synthesiser::stopVoice (SynthesiserVoice* voice, float velocity, const bool
 {
     jassert (voice != nullptr);
 
+    voice->noteStopSampleOffset = currentEventSampleOffset;
     voice->stopNote (velocity, allowTailOff);
 
     // the subclass MUST call clearCurrentNote() if it's not tailing off! RTFM for stopNote()!
     jassert (allowTailOff || (voice->getCurrentlyPlayingNote() < 0 && voice->getCurrentlyPlayingSound() == nullptr));
+
+    if (voice->indexInSynthesiser >= 0 && ! voice->isVoiceActive())
+        possiblyFreeVoices.setBit (voice->indexInSynthesiser);
 }
 
 void Synthesiser::noteOff (const int midiChannel,
@@ -367,10 +564,9 @@ void Synthesiser::noteOff (const int midiChannel,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    forEachVoiceWithNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
     {
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && voice->isPlayingChannel (midiChannel))
+        if (voice->isPlayingChannel (midiChannel))
         {
             if (auto sound = voice->getCurrentlyPlayingSound())
             {
@@ -386,7 +582,7 @@ void Synthesiser::noteOff (const int midiChannel,
                 }
             }
         }
-    }
+    });
 }
 
 void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
@@ -394,9 +590,17 @@ void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
     const ScopedLock sl (lock);
 
     for (auto* voice : voices)
+    {
         if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
+        {
+            voice->noteStopSampleOffset = currentEventSampleOffset;
             voice->stopNote (1.0f, allowTailOff);
 
+            if (voice->indexInSynthesiser >= 0 && ! voice->isVoiceActive())
+                possiblyFreeVoices.setBit (voice->indexInSynthesiser);
+        }
+    }
+
     sustainPedalsDown.clear();
 }
 
@@ -432,10 +636,11 @@ void Synthesiser::handleAftertouch (int midiChannel, int midiNoteNumber, int aft
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && (midiChannel <= 0 || voice->isPlayingChannel (midiChannel)))
+    forEachVoiceWithNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
+    {
+        if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
             voice->aftertouchChanged (aftertouchValue);
+    });
 }
 
 void Synthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
@@ -512,9 +717,29 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
 {
     const ScopedLock sl (lock);
 
+    // Try the voices that were idle when last checked first, dropping any that have become busy
+    for (int i = possiblyFreeVoices.findNextSetBit (0); i >= 0; i = possiblyFreeVoices.findNextSetBit (i + 1))
+    {
+        if (auto* voice = voices[i])
+        {
+            if (voice->isVoiceActive())
+                possiblyFreeVoices.clearBit (i);
+            else if (voice->canPlaySound (soundToPlay))
+                return voice;
+        }
+    }
+
+    // Voices may also have finished playing without the synth being told, so check the others
     for (auto* voice : voices)
-        if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
-            return voice;
+    {
+        if (! possiblyFreeVoices[voice->indexInSynthesiser] && ! voice->isVoiceActive())
+        {
+            possiblyFreeVoices.setBit (voice->indexInSynthesiser);
+
+            if (voice->canPlaySound (soundToPlay))
+                return voice;
+        }
+    }
 
     if (stealIfNoneAvailable)
         return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
@@ -552,15 +777,6 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
 
             usableVoicesToStealArray.add (voice);
 
-            // NB: Using a functor rather than a lambda here due to scare-stories about
-            // compilers generating code containing heap allocations..
-            struct Sorter
-            {
-                bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
-            };
-
-            std::sort (usableVoicesToStealArray.begin(), usableVoicesToStealArray.end(), Sorter());
-
             if (! voice->isPlayingButReleased()) // Don't protect released notes
             {
                 auto note = voice->getCurrentlyPlayingNote();
@@ -574,6 +790,15 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
         }
     }
 
+    // NB: Using a functor rather than a lambda here due to scare-stories about
+    // compilers generating code containing heap allocations..
+    struct Sorter
+    {
+        bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
+    };
+
+    std::sort (usableVoicesToStealArray.begin(), usableVoicesToStealArray.end(), Sorter());
+
     // Eliminate pathological cases (ie: only 1 note playing): we always give precedence to the lowest note(s)
     if (top == low)
         top = nullptr;
@@ -35,6 +35,8 @@
 namespace juce
 {
 
+namespace detail { class ParallelVoiceRenderer; }
+
 //==============================================================================
 /**
     Describes one of the sounds that a Synthesiser can play.
@@ -258,6 +260,29 @@ public:
     /** Returns true if this voice started playing its current note before the other voice did. */
     bool wasStartedBefore (const SynthesiserVoice& other) const noexcept;
 
+    //==============================================================================
+    /** Returns the position within the next rendered block at which the current note started.
+
+        When the synthesiser renders whole blocks (see Synthesiser::setSubBlockSplittingEnabled()),
+        startNote() is called before the block is rendered, and this tells the voice how many
+        samples into the block it should start sounding.
+
+        This is 0 if the note started in an earlier block, or if the synthesiser is splitting
+        blocks at each event.
+    */
+    int getNoteStartSampleOffset() const noexcept               { return noteStartSampleOffset; }
+
+    /** Returns the position within the next rendered block at which stopNote() was called.
+
+        When the synthesiser renders whole blocks (see Synthesiser::setSubBlockSplittingEnabled()),
+        stopNote() is called before the block is rendered, and this tells the voice how many
+        samples into the block it should begin its release.
+
+        This is -1 if the current note hasn't been stopped, and 0 if it was stopped in an
+        earlier block, or if the synthesiser is splitting blocks at each event.
+    */
+    int getNoteStopSampleOffset() const noexcept                { return noteStopSampleOffset; }
+
 protected:
     /** Resets the state of this voice after a sound has finished playing.
 
@@ -280,7 +305,13 @@ private:
 
     double currentSampleRate = 44100.0;
     int currentlyPlayingNote = -1, currentPlayingMidiChannel = 0;
+    int noteStartSampleOffset = 0, noteStopSampleOffset = -1;
     uint32 noteOnTime = 0;
+
+    // Bookkeeping for the Synthesiser's voice lookups
+    int indexInSynthesiser = -1, indexedNote = -1;
+    SynthesiserVoice* nextVoiceWithSameNote = nullptr;
+
     SynthesiserSound::Ptr currentlyPlayingSound;
     bool keyIsDown = false, sustainPedalDown = false, sostenutoPedalDown = false;
 
@@ -569,6 +600,58 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Chooses whether audio blocks are split up at each incoming midi event.
+
+        By default this is enabled, and renderVoices() is called for each sub-block between the
+        midi events (see setMinimumRenderingSubdivisionSize()). With many voices and dense midi
+        data, the overhead of these calls can become significant.
+
+        If disabled, all the midi events in a block are handled first, and then renderVoices() is
+        called once for the whole block. While doing so, startNote() and stopNote() are called with
+        the position of the event recorded in the voice, so voices that support it can use
+        SynthesiserVoice::getNoteStartSampleOffset() and SynthesiserVoice::getNoteStopSampleOffset()
+        to keep the timing sample-accurate. Controller, pitch-wheel and pressure changes apply to
+        the whole block, and a voice that gets stolen during the block stops at the start of it.
+    */
+    void setSubBlockSplittingEnabled (bool shouldSplitBlocks) noexcept;
+
+    /** Returns true if blocks are split up at each midi event.
+        @see setSubBlockSplittingEnabled
+    */
+    bool isSubBlockSplittingEnabled() const noexcept                { return subBlockSplittingEnabled; }
+
+    //==============================================================================
+    /** Allows the voices to be rendered on several threads at once.
+
+        This is useful when the voices are expensive to render. Calling this with a non-zero
+        number will start that many realtime worker threads. During each call to renderVoices(),
+        the active voices are shared out between a fixed number of groups, and the audio thread
+        and the workers render the groups into separate scratch buffers. These are then added
+        to the output in a fixed order, so the result doesn't depend on the timing of the threads.
+
+        The scratch buffers are allocated here, so you need to give the maximum number of output
+        channels and the maximum block size you'll render. Larger blocks are rendered in several
+        parts, and buffers with more channels are rendered serially.
+
+        Your voices must be safe to render concurrently with each other. The note and controller
+        callbacks are still only ever made from the thread calling renderNextBlock().
+
+        Pass zero to stop the worker threads and go back to rendering serially.
+
+        @see setAudioWorkgroup
+    */
+    void setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads set with setNumRenderThreads(). */
+    int getNumRenderThreads() const noexcept;
+
+    /** Sets the workgroup that the worker threads started by setNumRenderThreads() should join.
+
+        Call this from your AudioProcessor::audioWorkgroupContextChanged() override, so that
+        the workers are scheduled alongside the audio thread.
+    */
+    void setAudioWorkgroup (const AudioWorkgroup& workgroupToUse);
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -636,15 +719,38 @@ private:
     double sampleRate = 0;
     uint32 lastNoteOnCounter = 0;
     int minimumSubBlockSize = 32;
+    int currentEventSampleOffset = 0;
     bool subBlockSubdivisionIsStrict = false;
+    bool subBlockSplittingEnabled = true;
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
     mutable CriticalSection stealLock;
     mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
 
+    // The voices that were idle when last checked, by index. These are only hints, as voices
+    // can finish playing without the synth being told, so they're verified before use.
+    mutable BigInteger possiblyFreeVoices;
+
+    // For each midi note, a list of the voices that were started with it
+    SynthesiserVoice* firstVoiceForNote[128] = {};
+
+    std::unique_ptr<detail::ParallelVoiceRenderer> parallelRenderer;
+    Array<SynthesiserVoice*> voicesToRender;
+    AudioWorkgroup audioWorkgroup;
+
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
+    void updateVoiceIndices();
+    void addToNoteIndex (SynthesiserVoice*, int midiNoteNumber) noexcept;
+    void removeFromNoteIndex (SynthesiserVoice*) noexcept;
+
+    template <typename Callback>
+    void forEachVoiceWithNote (int midiNoteNumber, Callback&&);
+
+    template <typename FloatType>
+    void renderAllVoices (AudioBuffer<FloatType>&, int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Synthesiser)
 };
 
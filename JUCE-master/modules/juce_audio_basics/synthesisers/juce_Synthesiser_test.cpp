@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SynthesiserTests final : public UnitTest
+{
+public:
+    SynthesiserTests()  : UnitTest ("Synthesiser", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Free voices are used before stealing");
+        {
+            Synthesiser synth;
+            auto voices = prepare (synth, 4);
+
+            for (int note = 60; note < 64; ++note)
+                synth.noteOn (1, note, 1.0f);
+
+            std::set<int> notes;
+
+            for (auto* voice : voices)
+                notes.insert (voice->getCurrentlyPlayingNote());
+
+            expect (notes == std::set<int> { 60, 61, 62, 63 });
+
+            // The oldest note that isn't the lowest or highest is stolen
+            synth.noteOn (1, 70, 1.0f);
+            expect (findVoicePlaying (voices, 61) == nullptr);
+            expect (findVoicePlaying (voices, 70) != nullptr);
+        }
+
+        beginTest ("Note-offs and aftertouch reach the voices playing the note");
+        {
+            Synthesiser synth;
+            auto voices = prepare (synth, 6);
+
+            for (int note = 60; note < 66; ++note)
+                synth.noteOn (1, note, 1.0f);
+
+            synth.handleAftertouch (1, 62, 100);
+            expectEquals (findVoicePlaying (voices, 62)->lastAftertouch, 100);
+            expectEquals (findVoicePlaying (voices, 63)->lastAftertouch, -1);
+
+            synth.noteOff (1, 62, 1.0f, false);
+            expect (findVoicePlaying (voices, 62) == nullptr);
+            expectEquals (countActive (voices), 5);
+
+            // Voices that are restarted on a different note must no longer respond to their old ones
+            findVoicePlaying (voices, 63)->finishImmediately();
+            synth.noteOn (1, 66, 1.0f);
+            synth.noteOn (1, 67, 1.0f);
+            expectEquals (countActive (voices), 6);
+
+            synth.noteOff (1, 62, 1.0f, false);
+            synth.noteOff (1, 63, 1.0f, false);
+            expectEquals (countActive (voices), 6);
+
+            synth.noteOff (1, 66, 1.0f, false);
+            synth.noteOff (1, 67, 1.0f, false);
+            expectEquals (countActive (voices), 4);
+        }
+
+        beginTest ("Voices that finish while rendering are reused");
+        {
+            Synthesiser synth;
+            auto voices = prepare (synth, 2);
+
+            AudioBuffer<float> buffer (1, 64);
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+            midi.addEvent (MidiMessage::noteOn (1, 61, 1.0f), 0);
+            midi.addEvent (MidiMessage::noteOff (1, 60), 10);
+            synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+
+            // The released voice finishes its tail during the block, so the new note mustn't steal
+            synth.noteOn (1, 62, 1.0f);
+            expect (findVoicePlaying (voices, 61) != nullptr);
+            expect (findVoicePlaying (voices, 62) != nullptr);
+        }
+
+        beginTest ("Blocks can be rendered without splitting");
+        {
+            Synthesiser synth;
+            auto voices = prepare (synth, 2);
+            synth.setMinimumRenderingSubdivisionSize (1);
+
+            AudioBuffer<float> buffer (1, 64);
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 10);
+            midi.addEvent (MidiMessage::noteOff (1, 60), 50);
+
+            synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+            expectEquals (voices[0]->numRenderCalls, 3);
+
+            synth.setSubBlockSplittingEnabled (false);
+            midi.clear();
+            midi.addEvent (MidiMessage::noteOn (1, 61, 1.0f), 10);
+            midi.addEvent (MidiMessage::noteOff (1, 61), 50);
+
+            for (auto* voice : voices)
+                voice->numRenderCalls = 0;
+
+            synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+
+            for (auto* voice : voices)
+                expectEquals (voice->numRenderCalls, 1);
+
+            auto* voice = voices[0]->lastStartedNote == 61 ? voices[0] : voices[1];
+            expectEquals (voice->startOffsetWhenRendered, 10);
+            expectEquals (voice->stopOffsetWhenRendered, 50);
+            expectEquals (voice->getNoteStartSampleOffset(), 0);
+        }
+
+        beginTest ("Voices can be rendered on worker threads");
+        {
+            auto renderNotes = [this] (int numThreads)
+            {
+                Synthesiser synth;
+                prepare (synth, 16);
+
+                if (numThreads > 0)
+                    synth.setNumRenderThreads (numThreads, 2, 128);
+
+                expectEquals (synth.getNumRenderThreads(), numThreads);
+
+                AudioBuffer<float> buffer (2, 300);
+                buffer.clear();
+
+                MidiBuffer midi;
+
+                for (int note = 40; note < 52; ++note)
+                    midi.addEvent (MidiMessage::noteOn (1, note, 1.0f), (note - 40) * 10);
+
+                synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+                return buffer;
+            };
+
+            const auto serial = renderNotes (0);
+            const auto parallel = renderNotes (3);
+
+            for (int ch = 0; ch < serial.getNumChannels(); ++ch)
+                for (int i = 0; i < serial.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (parallel.getSample (ch, i), serial.getSample (ch, i), 1.0e-5f);
+
+            // The groups are always summed in the same order
+            const auto again = renderNotes (3);
+
+            for (int ch = 0; ch < parallel.getNumChannels(); ++ch)
+                for (int i = 0; i < parallel.getNumSamples(); ++i)
+                    expectEquals (again.getSample (ch, i), parallel.getSample (ch, i));
+        }
+    }
+
+private:
+    struct TestSound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override      { return true; }
+        bool appliesToChannel (int) override   { return true; }
+    };
+
+    struct TestVoice final : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float, SynthesiserSound*, int) override
+        {
+            lastStartedNote = note;
+            lastAftertouch = -1;
+            phase = 0;
+            releasing = false;
+        }
+
+        void stopNote (float, bool allowTailOff) override
+        {
+            if (allowTailOff)
+                releasing = true;
+            else
+                clearCurrentNote();
+        }
+
+        void pitchWheelMoved (int) override {}
+        void controllerMoved (int, int) override {}
+        void aftertouchChanged (int value) override   { lastAftertouch = value; }
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            if (isVoiceActive())
+            {
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                        buffer.addSample (ch, startSample + i, std::sin ((float) (phase + i) * (float) lastStartedNote * 0.001f) * 0.1f);
+
+                phase += numSamples;
+            }
+
+            ++numRenderCalls;
+            startOffsetWhenRendered = getNoteStartSampleOffset();
+            stopOffsetWhenRendered = getNoteStopSampleOffset();
+
+            if (releasing)
+                finishImmediately();
+        }
+
+        using SynthesiserVoice::renderNextBlock;
+
+        void finishImmediately()
+        {
+            releasing = false;
+            clearCurrentNote();
+        }
+
+        int lastStartedNote = -1, lastAftertouch = -1, numRenderCalls = 0, phase = 0;
+        int startOffsetWhenRendered = 0, stopOffsetWhenRendered = -1;
+        bool releasing = false;
+    };
+
+    static std::vector<TestVoice*> prepare (Synthesiser& synth, int numVoices)
+    {
+        std::vector<TestVoice*> voices;
+
+        for (int i = 0; i < numVoices; ++i)
+            voices.push_back (static_cast<TestVoice*> (synth.addVoice (new TestVoice())));
+
+        synth.addSound (new TestSound());
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        return voices;
+    }
+
+    static TestVoice* findVoicePlaying (const std::vector<TestVoice*>& voices, int note)
+    {
+        for (auto* voice : voices)
+            if (voice->isVoiceActive() && voice->getCurrentlyPlayingNote() == note)
+                return voice;
+
+        return nullptr;
+    }
+
+    static int countActive (const std::vector<TestVoice*>& voices)
+    {
+        return (int) std::count_if (voices.begin(), voices.end(), [] (auto* v) { return v->isVoiceActive(); });
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+} // namespace juce
@@ -43,6 +43,11 @@ namespace juce
     with setParameters() then call getNextSample() to get the envelope value to be applied
     to each audio sample or applyEnvelopeToBuffer() to apply the envelope to a whole buffer.
 
+    getNextSamples() and applyEnvelopeToBuffer() render blocks at once, working out each
+    stage with vector operations. The length of each stage in samples is worked out when it
+    starts, so the stages change at the same samples however the envelope is rendered,
+    although the values may differ from the ones getNextSample() returns by rounding errors.
+
     Do not change the parameters during playback. If you change the parameters before the
     release stage has completed then you must call reset() before the next call to
     noteOn().
@@ -59,6 +64,15 @@ public:
     }
 
     //==============================================================================
+    /** The shapes that the attack, decay and release stages can have. */
+    enum class Curve
+    {
+        linear,         /**< Straight lines. */
+        exponential     /**< The stages move quickly at first and then level out, like a
+                             capacitor charging and discharging. Each stage still takes
+                             its set time. */
+    };
+
     /**
         Holds the parameters being used by an ADSR object.
 
@@ -71,15 +85,18 @@ public:
         Parameters (float attackTimeSeconds,
                     float decayTimeSeconds,
                     float sustainLevel,
-                    float releaseTimeSeconds)
+                    float releaseTimeSeconds,
+                    Curve curveToUse = Curve::linear)
             : attack (attackTimeSeconds),
               decay (decayTimeSeconds),
               sustain (sustainLevel),
-              release (releaseTimeSeconds)
+              release (releaseTimeSeconds),
+              curve (curveToUse)
         {
         }
 
         float attack = 0.1f, decay = 0.1f, sustain = 1.0f, release = 0.1f;
+        Curve curve = Curve::linear;
     };
 
     /** Sets the parameters that will be used by an ADSR object.
@@ -132,11 +149,13 @@ public:
         if (attackRate > 0.0f)
         {
             state = State::attack;
+            startStage();
         }
         else if (decayRate > 0.0f)
         {
             envelopeVal = 1.0f;
             state = State::decay;
+            startStage();
         }
         else
         {
@@ -154,6 +173,7 @@ public:
             {
                 releaseRate = (float) (envelopeVal / (parameters.release * sampleRate));
                 state = State::release;
+                startStage();
             }
             else
             {
@@ -176,56 +196,71 @@ public:
                 return 0.0f;
             }
 
-            case State::attack:
+            case State::sustain:
             {
-                envelopeVal += attackRate;
-
-                if (envelopeVal >= 1.0f)
-                {
-                    envelopeVal = 1.0f;
-                    goToNextState();
-                }
-
+                envelopeVal = parameters.sustain;
                 break;
             }
 
+            case State::attack:
             case State::decay:
+            case State::release:
             {
-                envelopeVal -= decayRate;
-
-                if (envelopeVal <= parameters.sustain)
+                if (++stageIndex >= stageLength)
                 {
-                    envelopeVal = parameters.sustain;
+                    envelopeVal = stageEnd;
                     goToNextState();
                 }
+                else
+                {
+                    envelopeVal = isExponential() ? stageTarget + (envelopeVal - stageTarget) * getStageCurve().coefficient
+                                                  : envelopeVal + stageStep;
+                }
 
                 break;
             }
+        }
 
-            case State::sustain:
-            {
-                envelopeVal = parameters.sustain;
-                break;
-            }
+        return envelopeVal;
+    }
 
-            case State::release:
+    /** Writes the next numSamples envelope values to an array, advancing the envelope
+        as many calls to getNextSample() would.
+
+        @see getNextSample, applyEnvelopeToBuffer
+    */
+    void getNextSamples (float* destination, int numSamples) noexcept
+    {
+        while (numSamples > 0)
+        {
+            switch (state)
             {
-                envelopeVal -= releaseRate;
+                case State::idle:
+                    FloatVectorOperations::clear (destination, numSamples);
+                    return;
 
-                if (envelopeVal <= 0.0f)
-                    goToNextState();
+                case State::sustain:
+                    envelopeVal = parameters.sustain;
+                    FloatVectorOperations::fill (destination, envelopeVal, numSamples);
+                    return;
 
-                break;
+                case State::attack:
+                case State::decay:
+                case State::release:
+                {
+                    const auto numDone = renderStage (destination, numSamples);
+                    destination += numDone;
+                    numSamples -= numDone;
+                    break;
+                }
             }
         }
-
-        return envelopeVal;
     }
 
     /** This method will conveniently apply the next numSamples number of envelope values
         to an AudioBuffer.
 
-        @see getNextSample
+        @see getNextSample, getNextSamples
     */
     template <typename FloatType>
     void applyEnvelopeToBuffer (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
@@ -245,15 +280,30 @@ public:
         }
 
         auto numChannels = buffer.getNumChannels();
+        float envelope[256];
 
-        while (--numSamples >= 0)
+        while (numSamples > 0)
         {
-            auto env = getNextSample();
+            const auto num = jmin (numSamples, (int) std::size (envelope));
+            getNextSamples (envelope, num);
 
             for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+            {
+                auto* samples = buffer.getWritePointer (i, startSample);
+
+                if constexpr (std::is_same_v<FloatType, float>)
+                {
+                    FloatVectorOperations::multiply (samples, envelope, num);
+                }
+                else
+                {
+                    for (int j = 0; j < num; ++j)
+                        samples[j] *= (FloatType) envelope[j];
+                }
+            }
 
-            ++startSample;
+            startSample += num;
+            numSamples -= num;
         }
     }
 
@@ -270,6 +320,13 @@ private:
         decayRate   = getRate (1.0f - parameters.sustain, parameters.decay, sampleRate);
         releaseRate = getRate (parameters.sustain, parameters.release, sampleRate);
 
+        attackCurve .setTime (parameters.attack,  sampleRate, risingCurveRatio);
+        decayCurve  .setTime (parameters.decay,   sampleRate, fallingCurveRatio);
+        releaseCurve.setTime (parameters.release, sampleRate, fallingCurveRatio);
+
+        if (state == State::attack || state == State::decay || state == State::release)
+            startStage();
+
         if ((state == State::attack && attackRate <= 0.0f)
             || (state == State::decay && (decayRate <= 0.0f || envelopeVal <= parameters.sustain))
             || (state == State::release && releaseRate <= 0.0f))
@@ -283,6 +340,7 @@ private:
         if (state == State::attack)
         {
             state = (decayRate > 0.0f ? State::decay : State::sustain);
+            startStage();
             return;
         }
 
@@ -296,6 +354,129 @@ private:
             reset();
     }
 
+    //==============================================================================
+    static constexpr int rampBlockSize = 32;
+    static constexpr float risingCurveRatio = 0.3f, fallingCurveRatio = 0.001f;
+
+    /*  An exponential stage heads for a target beyond its end, so that it gets there in a
+        finite time. The ratio sets how far beyond, relative to the distance it travels,
+        and so how strongly it curves. The first powers of the per-sample coefficient let
+        a block of values be calculated with vector operations rather than one by one.
+    */
+    struct ExponentialCurve
+    {
+        void setTime (float timeInSeconds, double sr, float ratio) noexcept
+        {
+            const auto numSamples = timeInSeconds * sr;
+            logCoefficient = numSamples > 0.0 ? -std::log ((1.0 + ratio) / ratio) / numSamples : 0.0;
+            coefficient = (float) std::exp (logCoefficient);
+
+            for (size_t i = 0; i < powers.size(); ++i)
+                powers[i] = (float) std::exp (logCoefficient * (double) (i + 1));
+        }
+
+        double logCoefficient = 0.0;
+        float coefficient = 0.0f;
+        std::array<float, rampBlockSize> powers {};
+    };
+
+    bool isExponential() const noexcept     { return parameters.curve == Curve::exponential; }
+
+    const ExponentialCurve& getStageCurve() const noexcept
+    {
+        return state == State::attack ? attackCurve : (state == State::decay ? decayCurve : releaseCurve);
+    }
+
+    void startStage() noexcept
+    {
+        const auto rising = (state == State::attack);
+        const auto falling = (state == State::decay);
+
+        stageIndex = 0;
+        stageEnd   = rising ? 1.0f : (falling ? parameters.sustain : 0.0f);
+        stageStep  = rising ? attackRate : -(falling ? decayRate : releaseRate);
+
+        // The stage ends on the first sample that would reach its end. A little tolerance
+        // keeps stages that should end exactly on a sample from being one sample longer.
+        double numSamplesToEnd = 0.0;
+
+        if (isExponential())
+        {
+            const auto ratio = rising ? risingCurveRatio : fallingCurveRatio;
+            const auto distance = (double) (rising ? 1.0f : (falling ? 1.0f - parameters.sustain : envelopeVal));
+
+            stageTarget = (float) (stageEnd + (rising ? ratio : -ratio) * distance);
+
+            const auto remaining = (double) (stageEnd - stageTarget) / (double) (envelopeVal - stageTarget);
+            const auto logCoefficient = getStageCurve().logCoefficient;
+
+            if (remaining > 0.0 && remaining < 1.0 && logCoefficient < 0.0)
+                numSamplesToEnd = std::log (remaining) / logCoefficient;
+        }
+        else if (! exactlyEqual (stageStep, 0.0f))
+        {
+            numSamplesToEnd = (double) (stageEnd - envelopeVal) / (double) stageStep;
+        }
+
+        stageLength = jmax (1, (int) std::ceil (jmin (numSamplesToEnd, 1.0e9) - 1.0e-3));
+    }
+
+    /*  Renders up to numSamples values of the current attack, decay or release stage and
+        returns the number of values written, which stops at the end of the stage.
+
+        Linear values are the current value plus multiples of the step, and exponential
+        ones are the target plus powers of the coefficient times the current distance
+        from it, so both are a table scaled and offset for each block.
+    */
+    int renderStage (float* destination, int numSamples) noexcept
+    {
+        static constexpr auto ramp = []
+        {
+            std::array<float, rampBlockSize> result {};
+
+            for (size_t i = 0; i < result.size(); ++i)
+                result[i] = (float) (i + 1);
+
+            return result;
+        }();
+
+        const auto remaining = stageLength - stageIndex;
+        const auto num = jmin (numSamples, remaining);
+        const auto reachesEnd = (num == remaining);
+        const auto numValues = reachesEnd ? num - 1 : num;
+        const auto* table = isExponential() ? getStageCurve().powers.data() : ramp.data();
+
+        for (int done = 0; done < numValues;)
+        {
+            const auto blockSize = jmin (numValues - done, rampBlockSize);
+            auto* dest = destination + done;
+
+            if (isExponential())
+            {
+                FloatVectorOperations::copyWithMultiply (dest, table, envelopeVal - stageTarget, blockSize);
+                FloatVectorOperations::add (dest, stageTarget, blockSize);
+            }
+            else
+            {
+                FloatVectorOperations::copyWithMultiply (dest, table, stageStep, blockSize);
+                FloatVectorOperations::add (dest, envelopeVal, blockSize);
+            }
+
+            envelopeVal = dest[blockSize - 1];
+            done += blockSize;
+        }
+
+        stageIndex += num;
+
+        if (reachesEnd)
+        {
+            envelopeVal = destination[num - 1] = stageEnd;
+            goToNextState();
+        }
+
+        return num;
+    }
+
     //==============================================================================
     enum class State { idle, attack, decay, sustain, release };
 
@@ -304,6 +485,9 @@ private:
 
     double sampleRate = 44100.0;
     float envelopeVal = 0.0f, attackRate = 0.0f, decayRate = 0.0f, releaseRate = 0.0f;
+    float stageEnd = 0.0f, stageStep = 0.0f, stageTarget = 0.0f;
+    int stageIndex = 0, stageLength = 1;
+    ExponentialCurve attackCurve, decayCurve, releaseCurve;
 };
 
 } // namespace juce
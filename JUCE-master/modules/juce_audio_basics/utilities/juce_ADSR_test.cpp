@@ -189,6 +189,92 @@ struct ADSRTests final : public UnitTest
 
             expect (! adsr.isActive());
         }
+
+        for (auto curve : { ADSR::Curve::linear, ADSR::Curve::exponential })
+        {
+            const auto curveName = String (curve == ADSR::Curve::linear ? "linear" : "exponential");
+
+            beginTest ("Block rendering matches per-sample rendering (" + curveName + ")");
+            {
+                auto random = getRandom();
+
+                for (const auto& params : { ADSR::Parameters { 0.01f, 0.02f, 0.5f, 0.03f, curve },
+                                            ADSR::Parameters { 0.0f, 0.005f, 0.25f, 0.001f, curve },
+                                            ADSR::Parameters { 0.002f, 0.0f, 0.8f, 0.0f, curve } })
+                {
+                    ADSR perSample, block;
+
+                    for (auto* a : { &perSample, &block })
+                    {
+                        a->setSampleRate (sampleRate);
+                        a->setParameters (params);
+                        a->noteOn();
+                    }
+
+                    const auto noteOffTime = roundToInt (0.02 * sampleRate);
+                    std::vector<float> expected, actual;
+
+                    for (int start = 0; start < 4 * noteOffTime;)
+                    {
+                        if (start == noteOffTime)
+                        {
+                            perSample.noteOff();
+                            block.noteOff();
+                        }
+
+                        const auto nextStop = start < noteOffTime ? noteOffTime : 4 * noteOffTime;
+                        const auto num = jmin (nextStop - start, 1 + random.nextInt (300));
+
+                        for (int i = 0; i < num; ++i)
+                            expected.push_back (perSample.getNextSample());
+
+                        actual.resize (expected.size());
+                        block.getNextSamples (actual.data() + start, num);
+
+                        expect (block.isActive() == perSample.isActive());
+                        start += num;
+                    }
+
+                    for (size_t i = 0; i < expected.size(); ++i)
+                        expectWithinAbsoluteError (actual[i], expected[i], 1.0e-4f);
+
+                    // The stages must change at the same samples
+                    for (const auto level : { 1.0f, params.sustain, 0.0f })
+                        expectEquals ((int) std::distance (actual.begin(), std::find (actual.begin(), actual.end(), level)),
+                                      (int) std::distance (expected.begin(), std::find (expected.begin(), expected.end(), level)));
+                }
+            }
+        }
+
+        beginTest ("Exponential stages take their set times");
+        {
+            adsr.reset();
+            adsr.setParameters ({ parameters.attack, parameters.decay, parameters.sustain, parameters.release, ADSR::Curve::exponential });
+            adsr.noteOn();
+
+            auto buffer = getTestBuffer (sampleRate, parameters.attack);
+            adsr.applyEnvelopeToBuffer (buffer, 0, buffer.getNumSamples());
+
+            expect (isIncreasing (buffer));
+            expectWithinAbsoluteError (buffer.getSample (0, buffer.getNumSamples() - 1), 1.0f, 1.0e-3f);
+
+            // An exponential attack is steeper at the start than a linear one
+            expectGreaterThan (buffer.getSample (0, buffer.getNumSamples() / 4), 0.25f);
+
+            buffer = getTestBuffer (sampleRate, parameters.decay);
+            adsr.applyEnvelopeToBuffer (buffer, 0, buffer.getNumSamples());
+
+            expect (isDecreasing (buffer));
+            expectWithinAbsoluteError (buffer.getSample (0, buffer.getNumSamples() - 1), parameters.sustain, 1.0e-3f);
+
+            adsr.noteOff();
+            buffer = getTestBuffer (sampleRate, parameters.release);
+            adsr.applyEnvelopeToBuffer (buffer, 0, buffer.getNumSamples());
+
+            expect (isDecreasing (buffer));
+            expectLessThan (buffer.getSample (0, buffer.getNumSamples() / 4), 0.5f * 0.25f);
+            expectWithinAbsoluteError (adsr.getNextSample(), 0.0f, 1.0e-3f);
+        }
     }
 
     static void advanceADSR (ADSR& adsr, int numSamplesToAdvance)
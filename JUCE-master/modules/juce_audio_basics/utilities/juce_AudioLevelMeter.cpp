@@ -0,0 +1,562 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace LevelMeterHelpers
+{
+    constexpr float silence = -100.0f;
+    constexpr float histogramMinimum = -70.0f;   // the absolute gate
+    constexpr float histogramBinsPerLU = 10.0f;
+
+    static float energyToLoudness (double meanSquare) noexcept
+    {
+        return meanSquare > 0.0 ? jmax (silence, (float) (-0.691 + 10.0 * std::log10 (meanSquare)))
+                                : silence;
+    }
+
+    static double loudnessToEnergy (double loudness) noexcept
+    {
+        return std::pow (10.0, (loudness + 0.691) / 10.0);
+    }
+
+    static double getLoudnessWeight (AudioChannelSet::ChannelType type) noexcept
+    {
+        if (type == AudioChannelSet::LFE || type == AudioChannelSet::LFE2)
+            return 0.0;
+
+        for (auto surround : { AudioChannelSet::leftSurround,     AudioChannelSet::rightSurround,
+                               AudioChannelSet::leftSurroundSide, AudioChannelSet::rightSurroundSide,
+                               AudioChannelSet::leftSurroundRear, AudioChannelSet::rightSurroundRear })
+            if (type == surround)
+                return 1.41;
+
+        return 1.0;
+    }
+
+    static void publishMaximum (std::atomic<float>& destination, float value) noexcept
+    {
+        auto current = destination.load();
+
+        while (value > current && ! destination.compare_exchange_weak (current, value))
+        {}
+    }
+}
+
+//==============================================================================
+AudioLevelMeter::AudioLevelMeter()
+{
+    reset();
+}
+
+AudioLevelMeter::~AudioLevelMeter() = default;
+
+//==============================================================================
+void AudioLevelMeter::prepare (double sampleRate, const AudioChannelSet& channelLayout)
+{
+    jassert (sampleRate > 0.0);
+
+    numChannels = channelLayout.size();
+    subBlockLength = jmax (1, roundToInt (sampleRate / 10.0));
+
+    channelStates.assign ((size_t) numChannels, {});
+    squaredSumHistory.assign ((size_t) (numChannels * rmsSubBlocks), 0.0);
+    publishedLevels = std::make_unique<PublishedLevels[]> ((size_t) numChannels);
+
+    for (int i = 0; i < numChannels; ++i)
+        channelStates[(size_t) i].loudnessWeight = LevelMeterHelpers::getLoudnessWeight (channelLayout.getTypeOfChannel (i));
+
+    // The two stages of the K-weighting filter from BS.1770, calculated from their analogue
+    // prototypes so that they work at any sample rate. At 48kHz, these give the coefficients
+    // listed in the standard.
+    {
+        const auto k = std::tan (MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+        const auto q = 0.7071752369554196;
+        const auto highGain = std::pow (10.0, 3.999843853973347 / 20.0);
+        const auto bandGain = std::pow (highGain, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        kWeighting.b0 = (highGain + bandGain * k / q + k * k) / a0;
+        kWeighting.b1 = 2.0 * (k * k - highGain) / a0;
+        kWeighting.b2 = (highGain - bandGain * k / q + k * k) / a0;
+        kWeighting.a1 = 2.0 * (k * k - 1.0) / a0;
+        kWeighting.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    {
+        const auto k = std::tan (MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+        const auto q = 0.5003270373238773;
+        const auto a0 = 1.0 + k / q + k * k;
+
+        kWeighting.highPassA1 = 2.0 * (k * k - 1.0) / a0;
+        kWeighting.highPassA2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    // Hann-windowed sinc filters for the points a quarter, a half and three quarters of the
+    // way between the two samples in the middle of each phase's taps.
+    for (int phase = 0; phase < numInterpolatedPhases; ++phase)
+    {
+        auto* coefficients = interpolationPhases[phase];
+        double sum = 0.0;
+
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+        {
+            const auto distance = tap - tapsPerPhase / 2 + (phase + 1) / 4.0;
+            const auto x = MathConstants<double>::pi * distance;
+            const auto window = 0.5 + 0.5 * std::cos (x / (tapsPerPhase / 2));
+            const auto value = window * std::sin (x) / x;
+
+            coefficients[tap] = (float) value;
+            sum += value;
+        }
+
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+            coefficients[tap] = (float) (coefficients[tap] / sum);
+    }
+
+    reset();
+}
+
+void AudioLevelMeter::reset() noexcept
+{
+    for (auto& state : channelStates)
+    {
+        const auto weight = state.loudnessWeight;
+        state = {};
+        state.loudnessWeight = weight;
+    }
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        publishedLevels[(size_t) i].peak = 0.0f;
+        publishedLevels[(size_t) i].truePeak = 0.0f;
+        publishedLevels[(size_t) i].rms = 0.0f;
+    }
+
+    std::fill (squaredSumHistory.begin(), squaredSumHistory.end(), 0.0);
+    energyHistory.fill (0.0);
+    numSubBlocksMeasured = 0;
+    samplesUntilSubBlockEnd = subBlockLength;
+
+    momentaryLoudness = LevelMeterHelpers::silence;
+    shortTermLoudness = LevelMeterHelpers::silence;
+    resetIntegratedLoudness();
+}
+
+//==============================================================================
+void AudioLevelMeter::process (const AudioBuffer<float>& buffer) noexcept   { processBuffer (buffer); }
+void AudioLevelMeter::process (const AudioBuffer<double>& buffer) noexcept  { processBuffer (buffer); }
+
+template <typename SampleType>
+void AudioLevelMeter::processBuffer (const AudioBuffer<SampleType>& buffer) noexcept
+{
+    // You need to call prepare() before process()!
+    jassert (subBlockLength > 0);
+
+    if (subBlockLength == 0)
+        return;
+
+    const auto channelsToMeasure = jmin (numChannels, buffer.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+
+    for (int start = 0; start < numSamples;)
+    {
+        const auto num = jmin (numSamples - start, samplesUntilSubBlockEnd);
+
+        for (int i = 0; i < channelsToMeasure; ++i)
+            measureChannel (channelStates[(size_t) i], buffer.getReadPointer (i, start), num);
+
+        start += num;
+        samplesUntilSubBlockEnd -= num;
+
+        if (samplesUntilSubBlockEnd == 0)
+        {
+            finishSubBlock();
+            samplesUntilSubBlockEnd = subBlockLength;
+        }
+    }
+
+    for (int i = 0; i < channelsToMeasure; ++i)
+    {
+        auto& state = channelStates[(size_t) i];
+        LevelMeterHelpers::publishMaximum (publishedLevels[(size_t) i].peak, state.peak);
+        LevelMeterHelpers::publishMaximum (publishedLevels[(size_t) i].truePeak, jmax (state.peak, state.truePeak));
+        state.peak = state.truePeak = 0.0f;
+    }
+}
+
+template <typename SampleType>
+void AudioLevelMeter::measureChannel (ChannelState& state, const SampleType* input, int numSamples) noexcept
+{
+    constexpr auto historyLength = tapsPerPhase - 1;
+
+    // The chunk is preceded by the end of the previous one, for the interpolation filters
+    float samples[historyLength + chunkSize];
+    float interpolated[chunkSize];
+    auto* chunk = samples + historyLength;
+
+    std::copy (std::begin (state.history), std::end (state.history), samples);
+
+    const auto& coeffs = kWeighting;
+    auto s1 = state.shelfState[0], s2 = state.shelfState[1];
+    auto h1 = state.highPassState[0], h2 = state.highPassState[1];
+    auto weightedSum = state.weightedSum, squaredSum = state.squaredSum;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto num = jmin (chunkSize, numSamples - start);
+
+        for (int i = 0; i < num; ++i)
+            chunk[i] = (float) input[start + i];
+
+        auto range = FloatVectorOperations::findMinAndMax (chunk, num);
+        state.peak = jmax (state.peak, -range.getStart(), range.getEnd());
+
+        for (const auto& phase : interpolationPhases)
+        {
+            std::fill (interpolated, interpolated + num, 0.0f);
+
+            for (int tap = 0; tap < tapsPerPhase; ++tap)
+            {
+                const auto coefficient = phase[tap];
+                const auto* source = chunk - tap;
+
+                for (int i = 0; i < num; ++i)
+                    interpolated[i] += coefficient * source[i];
+            }
+
+            range = FloatVectorOperations::findMinAndMax (interpolated, num);
+            state.truePeak = jmax (state.truePeak, -range.getStart(), range.getEnd());
+        }
+
+        for (int i = 0; i < num; ++i)
+        {
+            const auto in = (double) chunk[i];
+
+            const auto shelved = coeffs.b0 * in + s1;
+            s1 = coeffs.b1 * in - coeffs.a1 * shelved + s2;
+            s2 = coeffs.b2 * in - coeffs.a2 * shelved;
+
+            const auto weighted = shelved + h1;
+            h1 = -2.0 * shelved - coeffs.highPassA1 * weighted + h2;
+            h2 = shelved - coeffs.highPassA2 * weighted;
+
+            weightedSum += weighted * weighted;
+            squaredSum += in * in;
+        }
+
+        std::copy (chunk + num - historyLength, chunk + num, samples);
+    }
+
+    JUCE_SNAP_TO_ZERO (s1);  JUCE_SNAP_TO_ZERO (s2);
+    JUCE_SNAP_TO_ZERO (h1);  JUCE_SNAP_TO_ZERO (h2);
+
+    std::copy (samples, samples + historyLength, state.history);
+    state.shelfState[0] = s1;       state.shelfState[1] = s2;
+    state.highPassState[0] = h1;    state.highPassState[1] = h2;
+    state.weightedSum = weightedSum;
+    state.squaredSum = squaredSum;
+}
+
+void AudioLevelMeter::finishSubBlock() noexcept
+{
+    using namespace LevelMeterHelpers;
+
+    const auto rmsIndex = (int) (numSubBlocksMeasured % rmsSubBlocks);
+    double energy = 0.0;
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        auto& state = channelStates[(size_t) i];
+        auto* history = squaredSumHistory.data() + i * rmsSubBlocks;
+
+        history[rmsIndex] = state.squaredSum;
+        const auto total = std::accumulate (history, history + rmsSubBlocks, 0.0);
+        publishedLevels[(size_t) i].rms = (float) std::sqrt (total / (rmsSubBlocks * subBlockLength));
+
+        energy += state.loudnessWeight * state.weightedSum;
+        state.weightedSum = state.squaredSum = 0.0;
+    }
+
+    const auto energyIndex = (int) (numSubBlocksMeasured % shortTermSubBlocks);
+    energyHistory[(size_t) energyIndex] = energy / subBlockLength;
+    ++numSubBlocksMeasured;
+
+    double momentaryEnergy = 0.0;
+
+    for (int i = 0; i < momentarySubBlocks; ++i)
+        momentaryEnergy += energyHistory[(size_t) ((energyIndex - i + shortTermSubBlocks) % shortTermSubBlocks)];
+
+    const auto momentary = energyToLoudness (momentaryEnergy / momentarySubBlocks);
+    momentaryLoudness = momentary;
+    shortTermLoudness = energyToLoudness (std::accumulate (energyHistory.begin(), energyHistory.end(), 0.0) / shortTermSubBlocks);
+
+    // Each 400ms block goes into the histogram for the integrated loudness, unless it's below
+    // the absolute gate. The blocks overlap by 75%, as the standard requires.
+    if (numSubBlocksMeasured >= momentarySubBlocks && momentary > histogramMinimum)
+    {
+        const auto bin = jmin (numHistogramBins - 1, (int) ((momentary - histogramMinimum) * histogramBinsPerLU));
+        loudnessHistogram[(size_t) bin].fetch_add (1, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+AudioLevelMeter::ChannelLevels AudioLevelMeter::getChannelLevels (int channel) noexcept
+{
+    jassert (isPositiveAndBelow (channel, numChannels));
+
+    if (! isPositiveAndBelow (channel, numChannels))
+        return {};
+
+    auto& levels = publishedLevels[(size_t) channel];
+    return { levels.peak.exchange (0.0f), levels.truePeak.exchange (0.0f), levels.rms.load() };
+}
+
+float AudioLevelMeter::getIntegratedLoudness() const noexcept
+{
+    using namespace LevelMeterHelpers;
+
+    std::array<uint32, numHistogramBins> counts;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+        counts[i] = loudnessHistogram[i].load (std::memory_order_relaxed);
+
+    const auto getMeanLoudness = [&counts] (int firstBin)
+    {
+        double energy = 0.0;
+        uint64 numBlocks = 0;
+
+        for (auto bin = (size_t) firstBin; bin < counts.size(); ++bin)
+        {
+            if (counts[bin] == 0)
+                continue;
+
+            energy += counts[bin] * loudnessToEnergy (histogramMinimum + ((double) bin + 0.5) / histogramBinsPerLU);
+            numBlocks += counts[bin];
+        }
+
+        return numBlocks > 0 ? energyToLoudness (energy / (double) numBlocks) : silence;
+    };
+
+    // The relative gate leaves out blocks more than 10 LU below the loudness of those
+    // that passed the absolute gate
+    const auto ungated = getMeanLoudness (0);
+
+    if (ungated <= histogramMinimum)
+        return silence;
+
+    const auto relativeGate = ungated - 10.0f;
+    const auto firstBin = jlimit (0, numHistogramBins - 1,
+                                  (int) std::ceil ((relativeGate - histogramMinimum) * histogramBinsPerLU - 0.5f));
+
+    return getMeanLoudness (firstBin);
+}
+
+void AudioLevelMeter::resetIntegratedLoudness() noexcept
+{
+    for (auto& count : loudnessHistogram)
+        count.store (0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioLevelMeterTests final : public UnitTest
+{
+public:
+    AudioLevelMeterTests()
+        : UnitTest ("AudioLevelMeter", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("A full-scale 997Hz sine on one channel measures -3.01 LUFS");
+        {
+            for (auto sampleRate : { 44100.0, 48000.0, 96000.0 })
+            {
+                AudioLevelMeter meter;
+                meter.prepare (sampleRate, AudioChannelSet::mono());
+
+                processSine (meter, sampleRate, { 1.0f }, 997.0, 0.0, 4.0);
+
+                expectWithinAbsoluteError (meter.getMomentaryLoudness(),  -3.01f, 0.05f);
+                expectWithinAbsoluteError (meter.getShortTermLoudness(),  -3.01f, 0.05f);
+                expectWithinAbsoluteError (meter.getIntegratedLoudness(), -3.01f, 0.1f);
+            }
+        }
+
+        beginTest ("A stereo 1kHz sine at -23dBFS measures -23 LUFS");
+        {
+            AudioLevelMeter meter;
+            meter.prepare (48000.0, AudioChannelSet::stereo());
+
+            const auto gain = Decibels::decibelsToGain (-23.0f);
+            processSine (meter, 48000.0, { gain, gain }, 1000.0, 0.0, 20.0);
+
+            expectWithinAbsoluteError (meter.getMomentaryLoudness(),  -23.0f, 0.1f);
+            expectWithinAbsoluteError (meter.getShortTermLoudness(),  -23.0f, 0.1f);
+            expectWithinAbsoluteError (meter.getIntegratedLoudness(), -23.0f, 0.1f);
+        }
+
+        beginTest ("LFE channels are left out of the loudness, and surround channels are weighted");
+        {
+            AudioLevelMeter meter;
+            meter.prepare (48000.0, AudioChannelSet::create5point1());
+
+            const auto layout = AudioChannelSet::create5point1();
+            std::vector<float> gains ((size_t) layout.size(), 0.0f);
+            gains[(size_t) layout.getChannelIndexForType (AudioChannelSet::LFE)] = 1.0f;
+            processSine (meter, 48000.0, gains, 997.0, 0.0, 1.0);
+
+            expectEquals (meter.getMomentaryLoudness(), -100.0f);
+
+            meter.reset();
+            gains[(size_t) layout.getChannelIndexForType (AudioChannelSet::leftSurround)] = 1.0f;
+            processSine (meter, 48000.0, gains, 997.0, 0.0, 1.0);
+
+            expectWithinAbsoluteError (meter.getMomentaryLoudness(), -3.01f + 10.0f * std::log10 (1.41f), 0.05f);
+        }
+
+        beginTest ("The true peak finds the peaks between samples");
+        {
+            AudioLevelMeter meter;
+            meter.prepare (48000.0, AudioChannelSet::mono());
+
+            // A quarter of the sample rate, so that every sample lands half way up the sine
+            processSine (meter, 48000.0, { 1.0f }, 12000.0, MathConstants<double>::pi / 4.0, 0.3);
+
+            const auto levels = meter.getChannelLevels (0);
+            expectWithinAbsoluteError (levels.peak, std::sqrt (0.5f), 0.001f);
+            expectWithinAbsoluteError (levels.truePeak, 1.0f, 0.05f);
+            expectWithinAbsoluteError (levels.rms, std::sqrt (0.5f), 0.001f);
+        }
+
+        beginTest ("Peaks are held until they're read");
+        {
+            AudioLevelMeter meter;
+            meter.prepare (48000.0, AudioChannelSet::stereo());
+
+            AudioBuffer<float> buffer (2, 512);
+            buffer.clear();
+            buffer.setSample (1, 100, -0.5f);
+            meter.process (buffer);
+
+            buffer.clear();
+            meter.process (buffer);
+
+            auto levels = meter.getChannelLevels (1);
+            expectEquals (levels.peak, 0.5f);
+            expectGreaterOrEqual (levels.truePeak, 0.5f);
+            expectEquals (meter.getChannelLevels (0).peak, 0.0f);
+
+            levels = meter.getChannelLevels (1);
+            expectEquals (levels.peak, 0.0f);
+            expectEquals (levels.truePeak, 0.0f);
+        }
+
+        beginTest ("Double precision buffers give the same results");
+        {
+            AudioLevelMeter floatMeter, doubleMeter;
+            floatMeter.prepare (48000.0, AudioChannelSet::mono());
+            doubleMeter.prepare (48000.0, AudioChannelSet::mono());
+
+            AudioBuffer<float> floatBuffer (1, 4800);
+            AudioBuffer<double> doubleBuffer (1, 4800);
+
+            for (int i = 0; i < 4800; ++i)
+            {
+                const auto value = 0.25 * std::sin (0.05 * i);
+                floatBuffer.setSample (0, i, (float) value);
+                doubleBuffer.setSample (0, i, value);
+            }
+
+            for (int i = 0; i < 5; ++i)
+            {
+                floatMeter.process (floatBuffer);
+                doubleMeter.process (doubleBuffer);
+            }
+
+            expectWithinAbsoluteError (floatMeter.getMomentaryLoudness(), doubleMeter.getMomentaryLoudness(), 0.001f);
+            expectWithinAbsoluteError (floatMeter.getChannelLevels (0).rms, doubleMeter.getChannelLevels (0).rms, 0.0001f);
+        }
+
+        beginTest ("The integrated loudness gates out silence and quiet passages");
+        {
+            AudioLevelMeter meter;
+            meter.prepare (48000.0, AudioChannelSet::mono());
+
+            processSine (meter, 48000.0, { Decibels::decibelsToGain (-17.0f) }, 997.0, 0.0, 10.0);
+            processSine (meter, 48000.0, { Decibels::decibelsToGain (-47.0f) }, 997.0, 0.0, 10.0);
+            processSine (meter, 48000.0, { 0.0f }, 997.0, 0.0, 10.0);
+
+            expectEquals (meter.getShortTermLoudness(), -100.0f);
+            expectWithinAbsoluteError (meter.getIntegratedLoudness(), -20.01f, 0.2f);
+
+            meter.resetIntegratedLoudness();
+            expectEquals (meter.getIntegratedLoudness(), -100.0f);
+        }
+    }
+
+private:
+    static void processSine (AudioLevelMeter& meter, double sampleRate, const std::vector<float>& gains,
+                             double frequency, double phase, double seconds)
+    {
+        AudioBuffer<float> buffer ((int) gains.size(), 480);
+        const auto numBlocks = roundToInt (seconds * sampleRate / buffer.getNumSamples());
+        const auto delta = MathConstants<double>::twoPi * frequency / sampleRate;
+        int64 position = 0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int i = 0; i < buffer.getNumSamples(); ++i, ++position)
+            {
+                const auto value = (float) std::sin (phase + delta * (double) position);
+
+                for (size_t channel = 0; channel < gains.size(); ++channel)
+                    buffer.setSample ((int) channel, i, gains[channel] * value);
+            }
+
+            meter.process (buffer);
+        }
+    }
+};
+
+static AudioLevelMeterTests audioLevelMeterTests;
+
+#endif
+
+} // namespace juce
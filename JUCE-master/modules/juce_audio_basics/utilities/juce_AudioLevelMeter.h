@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Measures the peak, true peak, RMS level and loudness of a multi-channel signal,
+    for driving level meters.
+
+    All the measurements are made together, in a single pass over each channel of
+    each block passed to process(). The oversampling for the true peak and the peak
+    detection are done in short chunks that the compiler can vectorise, and the
+    K-weighting filter for the loudness shares its loop with the sums of squares.
+
+    The results are published through atomics, so a UI thread can read them while
+    the audio thread is calling process(), without any locks.
+
+    Loudness is measured as described in ITU-R BS.1770-4 and EBU R 128:
+    - the momentary loudness covers the last 400ms, and the short-term loudness the
+      last 3 seconds. Both are updated every 100ms.
+    - the integrated loudness is gated, and covers everything since the meter was
+      reset. It's accurate to within 0.1 LU.
+    - the true peak uses 4x oversampling, with a 48-tap interpolation filter.
+
+    Loudness values are in LUFS. Silence is reported as -100, which matches the
+    default of Decibels::gainToDecibels(). Peaks and RMS levels are linear gains.
+
+    @code
+    // In the audio callback
+    meter.process (buffer);
+
+    // In a timer callback on the message thread
+    const auto levels = meter.getChannelLevels (0);
+    peakMeter.setLevel (Decibels::gainToDecibels (levels.truePeak));
+    loudnessLabel.setText (String (meter.getShortTermLoudness(), 1) + " LUFS", dontSendNotification);
+    @endcode
+
+    @see Decibels, AudioBuffer::getMagnitude, AudioBuffer::getRMSLevel
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioLevelMeter
+{
+public:
+    //==============================================================================
+    /** Creates a meter. You need to call prepare() before using it. */
+    AudioLevelMeter();
+
+    /** Destructor. */
+    ~AudioLevelMeter();
+
+    //==============================================================================
+    /** Allocates the meter's state, sets up its filters for a sample rate, then resets it.
+
+        The channel layout decides how much each channel contributes to the loudness.
+        LFE channels are left out, and surround channels are weighted by 1.41, as
+        BS.1770 specifies. Use AudioChannelSet::discreteChannels() to give every
+        channel the same weight.
+
+        This must not be called while another thread is using the meter.
+    */
+    void prepare (double sampleRate, const AudioChannelSet& channelLayout);
+
+    /** Clears all the measurements, including the integrated loudness. */
+    void reset() noexcept;
+
+    /** Returns the number of channels in the layout passed to prepare(). */
+    int getNumChannels() const noexcept                     { return numChannels; }
+
+    //==============================================================================
+    /** Measures a block of audio.
+
+        Call this on the audio thread. It doesn't allocate or lock. If the buffer has
+        more channels than the meter, the extra channels are ignored.
+    */
+    void process (const AudioBuffer<float>& buffer) noexcept;
+
+    /** Measures a block of audio.
+        @see process
+    */
+    void process (const AudioBuffer<double>& buffer) noexcept;
+
+    //==============================================================================
+    /** The levels of a single channel. */
+    struct ChannelLevels
+    {
+        float peak = 0.0f;      /**< The highest absolute sample value. */
+        float truePeak = 0.0f;  /**< The highest absolute value of the oversampled signal. */
+        float rms = 0.0f;       /**< The RMS level over the last 300ms. */
+    };
+
+    /** Returns the levels of one channel.
+
+        The peak values are the highest since the previous call for the same channel,
+        so that a meter showing them never misses a peak, however seldom it's updated.
+        This means that only one thread should call this.
+    */
+    ChannelLevels getChannelLevels (int channel) noexcept;
+
+    /** Returns the loudness over the last 400ms, in LUFS. */
+    float getMomentaryLoudness() const noexcept             { return momentaryLoudness.load(); }
+
+    /** Returns the loudness over the last 3 seconds, in LUFS. */
+    float getShortTermLoudness() const noexcept             { return shortTermLoudness.load(); }
+
+    /** Returns the gated loudness since the meter was last reset, in LUFS.
+
+        This has to look through a histogram of all the measurements, so it's a bit
+        slower than the other getters, although it doesn't allocate.
+    */
+    float getIntegratedLoudness() const noexcept;
+
+    /** Restarts the integrated loudness measurement, without affecting the others.
+
+        This can be called from any thread.
+    */
+    void resetIntegratedLoudness() noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int tapsPerPhase = 12, numInterpolatedPhases = 3, chunkSize = 64;
+    static constexpr int rmsSubBlocks = 3, momentarySubBlocks = 4, shortTermSubBlocks = 30;
+    static constexpr int numHistogramBins = 800;
+
+    struct ChannelState
+    {
+        double shelfState[2] {}, highPassState[2] {};
+        double weightedSum = 0.0, squaredSum = 0.0, loudnessWeight = 1.0;
+        float history[tapsPerPhase - 1] {};
+        float peak = 0.0f, truePeak = 0.0f;
+    };
+
+    struct PublishedLevels
+    {
+        std::atomic<float> peak { 0.0f }, truePeak { 0.0f }, rms { 0.0f };
+    };
+
+    struct KWeighting
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;    // the high shelf
+        double highPassA1 = 0.0, highPassA2 = 0.0;                  // the high-pass, whose zeros are both at DC
+    };
+
+    int numChannels = 0, subBlockLength = 0, samplesUntilSubBlockEnd = 0;
+    int64 numSubBlocksMeasured = 0;
+    KWeighting kWeighting;
+    float interpolationPhases[numInterpolatedPhases][tapsPerPhase] {};
+    std::vector<ChannelState> channelStates;
+    std::vector<double> squaredSumHistory;          // rmsSubBlocks sums for each channel
+    std::array<double, shortTermSubBlocks> energyHistory {};
+    std::unique_ptr<PublishedLevels[]> publishedLevels;
+    std::atomic<float> momentaryLoudness { -100.0f }, shortTermLoudness { -100.0f };
+    std::array<std::atomic<uint32>, numHistogramBins> loudnessHistogram;
+
+    template <typename SampleType>
+    void processBuffer (const AudioBuffer<SampleType>&) noexcept;
+
+    template <typename SampleType>
+    void measureChannel (ChannelState&, const SampleType*, int numSamples) noexcept;
+
+    void finishSubBlock() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioLevelMeter)
+};
+
+} // namespace juce
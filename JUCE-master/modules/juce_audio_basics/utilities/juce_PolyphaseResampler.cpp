@@ -0,0 +1,437 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+namespace PolyphaseResamplerHelpers
+{
+    struct QualitySettings
+    {
+        int baseNumTaps, numPhases;
+        double cutoff, kaiserBeta;
+    };
+
+    static QualitySettings getSettings (PolyphaseResampler::Quality quality) noexcept
+    {
+        switch (quality)
+        {
+            case PolyphaseResampler::Quality::low:      return { 16, 64,   0.73, 6.76 };
+            case PolyphaseResampler::Quality::medium:   return { 32, 256,  0.82, 8.96 };
+            case PolyphaseResampler::Quality::high:     break;
+        }
+
+        return { 64, 1024, 0.89, 11.16 };
+    }
+
+    // Zeroth-order modified Bessel function of the first kind, for the Kaiser window
+    static double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+        const auto halfX = x * 0.5;
+
+        for (int k = 1; k < 50; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+
+            if (term < sum * 1.0e-12)
+                break;
+        }
+
+        return sum;
+    }
+
+    static double getSpeedRatio (double start, double end, int index, int numSamples) noexcept
+    {
+        return start + (end - start) * index / numSamples;
+    }
+
+    // Calculates the dot products of the samples with two consecutive phases of coefficients
+    static void dotProducts (const float* samples, const float* phase0, const float* phase1,
+                             int numTaps, float& result0, float& result1) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        auto sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+
+        for (; i + 4 <= numTaps; i += 4)
+        {
+            auto s = _mm_loadu_ps (samples + i);
+            sum0 = _mm_add_ps (sum0, _mm_mul_ps (s, _mm_loadu_ps (phase0 + i)));
+            sum1 = _mm_add_ps (sum1, _mm_mul_ps (s, _mm_loadu_ps (phase1 + i)));
+        }
+
+        alignas (16) float totals0[4], totals1[4];
+        _mm_store_ps (totals0, sum0);
+        _mm_store_ps (totals1, sum1);
+        result0 = (totals0[0] + totals0[1]) + (totals0[2] + totals0[3]);
+        result1 = (totals1[0] + totals1[1]) + (totals1[2] + totals1[3]);
+       #elif JUCE_USE_ARM_NEON
+        auto sum0 = vdupq_n_f32 (0.0f), sum1 = vdupq_n_f32 (0.0f);
+
+        for (; i + 4 <= numTaps; i += 4)
+        {
+            auto s = vld1q_f32 (samples + i);
+            sum0 = vmlaq_f32 (sum0, s, vld1q_f32 (phase0 + i));
+            sum1 = vmlaq_f32 (sum1, s, vld1q_f32 (phase1 + i));
+        }
+
+        alignas (16) float totals0[4], totals1[4];
+        vst1q_f32 (totals0, sum0);
+        vst1q_f32 (totals1, sum1);
+        result0 = (totals0[0] + totals0[1]) + (totals0[2] + totals0[3]);
+        result1 = (totals1[0] + totals1[1]) + (totals1[2] + totals1[3]);
+       #else
+        result0 = result1 = 0.0f;
+       #endif
+
+        for (; i < numTaps; ++i)
+        {
+            result0 += samples[i] * phase0[i];
+            result1 += samples[i] * phase1[i];
+        }
+    }
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler() = default;
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+PolyphaseResampler::PolyphaseResampler (PolyphaseResampler&&) noexcept = default;
+PolyphaseResampler& PolyphaseResampler::operator= (PolyphaseResampler&&) noexcept = default;
+
+void PolyphaseResampler::prepare (int newNumChannels, double maximumSpeedRatio, Quality quality)
+{
+    jassert (newNumChannels > 0 && maximumSpeedRatio > 0.0);
+
+    numChannels = jmax (1, newNumChannels);
+    maxSpeedRatio = jmax (1.0, maximumSpeedRatio);
+
+    createPhases (quality);
+
+    // Input is appended after the history until the buffer is full, when the most recent
+    // numTaps samples are moved back to the start, so this sets how often that happens.
+    history.setSize (numChannels, numTaps * 8);
+    inputPointers.malloc (numChannels);
+    outputPointers.malloc (numChannels);
+
+    reset();
+}
+
+void PolyphaseResampler::createPhases (Quality quality)
+{
+    using namespace PolyphaseResamplerHelpers;
+
+    const auto settings = getSettings (quality);
+
+    numTaps = ((int) std::ceil (settings.baseNumTaps * maxSpeedRatio) + 3) & ~3;
+    numPhases = settings.numPhases;
+
+    const auto cutoff = settings.cutoff / maxSpeedRatio;
+    const auto halfLength = numTaps / 2;
+    const auto windowScale = 1.0 / besselI0 (settings.kaiserBeta);
+
+    phases.malloc ((size_t) (numPhases + 1) * (size_t) numTaps);
+
+    for (int p = 0; p <= numPhases; ++p)
+    {
+        auto* phase = phases + p * numTaps;
+        const auto fraction = (double) p / numPhases;
+        double sum = 0.0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            // the distance from this tap to the point being interpolated, which lies
+            // between taps (halfLength - 1) and halfLength
+            const auto distance = i - (halfLength - 1) - fraction;
+            const auto x = MathConstants<double>::pi * cutoff * distance;
+            const auto sinc = std::abs (x) < 1.0e-9 ? 1.0 : std::sin (x) / x;
+            const auto w = distance / halfLength;
+            const auto window = std::abs (w) >= 1.0 ? 0.0
+                                                    : besselI0 (settings.kaiserBeta * std::sqrt (1.0 - w * w)) * windowScale;
+
+            const auto value = cutoff * sinc * window;
+            phase[i] = (float) value;
+            sum += value;
+        }
+
+        // normalise each phase so that DC passes at exactly unity gain
+        for (int i = 0; i < numTaps; ++i)
+            phase[i] = (float) (phase[i] / sum);
+    }
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    history.clear();
+    writePos = numTaps;
+    subSamplePos = 1.0;
+}
+
+//==============================================================================
+int PolyphaseResampler::getNumInputSamplesNeeded (double startSpeedRatio, double endSpeedRatio,
+                                                  int numOutputSamplesToProduce) const noexcept
+{
+    auto pos = subSamplePos;
+    int numNeeded = 0;
+
+    for (int i = 0; i < numOutputSamplesToProduce; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            ++numNeeded;
+            pos -= 1.0;
+        }
+
+        pos += PolyphaseResamplerHelpers::getSpeedRatio (startSpeedRatio, endSpeedRatio, i, numOutputSamplesToProduce);
+    }
+
+    return numNeeded;
+}
+
+int PolyphaseResampler::process (double startSpeedRatio, double endSpeedRatio,
+                                 const float* const* inputChannels, float* const* outputChannels,
+                                 int numOutputSamplesToProduce) noexcept
+{
+    return processImpl (startSpeedRatio, endSpeedRatio, inputChannels, 1,
+                        outputChannels, 1, numOutputSamplesToProduce);
+}
+
+int PolyphaseResampler::processInterleaved (double startSpeedRatio, double endSpeedRatio,
+                                            const float* input, float* output,
+                                            int numOutputSamplesToProduce) noexcept
+{
+    for (int i = 0; i < numChannels; ++i)
+    {
+        inputPointers[i] = input + i;
+        outputPointers[i] = output + i;
+    }
+
+    return processImpl (startSpeedRatio, endSpeedRatio, inputPointers, numChannels,
+                        outputPointers, numChannels, numOutputSamplesToProduce);
+}
+
+int PolyphaseResampler::processImpl (double startSpeedRatio, double endSpeedRatio,
+                                     const float* const* inputs, int inputStride,
+                                     float* const* outputs, int outputStride,
+                                     int numOutputSamplesToProduce) noexcept
+{
+    // You need to call prepare() before using the resampler!
+    jassert (numTaps > 0);
+
+    // The filter was designed for ratios up to the one given to prepare(), so
+    // larger ratios than this will alias
+    jassert (jmax (startSpeedRatio, endSpeedRatio) <= maxSpeedRatio * 1.0001 || maxSpeedRatio <= 1.0);
+
+    const auto bufferSize = history.getNumSamples();
+    auto* const* channels = history.getArrayOfWritePointers();
+    auto pos = subSamplePos;
+    int numUsed = 0;
+
+    for (int i = 0; i < numOutputSamplesToProduce; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            if (writePos == bufferSize)
+            {
+                for (int chan = 0; chan < numChannels; ++chan)
+                    std::memmove (channels[chan], channels[chan] + bufferSize - numTaps, (size_t) numTaps * sizeof (float));
+
+                writePos = numTaps;
+            }
+
+            for (int chan = 0; chan < numChannels; ++chan)
+                channels[chan][writePos] = inputs[chan][numUsed * inputStride];
+
+            ++writePos;
+            ++numUsed;
+            pos -= 1.0;
+        }
+
+        const auto phasePos = pos * numPhases;
+        const auto phaseIndex = jmin (numPhases - 1, (int) phasePos);
+        const auto phaseFraction = (float) (phasePos - phaseIndex);
+        const auto* phase0 = phases + phaseIndex * numTaps;
+        const auto* phase1 = phase0 + numTaps;
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            float result0, result1;
+            PolyphaseResamplerHelpers::dotProducts (channels[chan] + writePos - numTaps, phase0, phase1,
+                                                    numTaps, result0, result1);
+
+            outputs[chan][i * outputStride] = result0 + phaseFraction * (result1 - result0);
+        }
+
+        pos += PolyphaseResamplerHelpers::getSpeedRatio (startSpeedRatio, endSpeedRatio, i, numOutputSamplesToProduce);
+    }
+
+    subSamplePos = pos;
+    return numUsed;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PolyphaseResamplerTests final : public UnitTest
+{
+public:
+    PolyphaseResamplerTests()
+        : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("An impulse at unity ratio is delayed by the reported latency, with unity gain");
+        {
+            for (auto quality : { PolyphaseResampler::Quality::low, PolyphaseResampler::Quality::medium, PolyphaseResampler::Quality::high })
+            {
+                PolyphaseResampler resampler;
+                resampler.prepare (1, 1.0, quality);
+
+                std::vector<float> input (256, 0.0f), output (256);
+                input[10] = 1.0f;
+
+                const float* in[] { input.data() };
+                float* out[] { output.data() };
+                expectEquals (resampler.process (1.0, in, out, 256), 256);
+
+                const auto peak = std::max_element (output.begin(), output.end()) - output.begin();
+                expectEquals ((int) peak, 10 + resampler.getLatencyInInputSamples());
+                expectWithinAbsoluteError (std::accumulate (output.begin(), output.end(), 0.0f), 1.0f, 1.0e-4f);
+            }
+        }
+
+        beginTest ("Input usage matches getNumInputSamplesNeeded, including across blocks and ratio ramps");
+        {
+            PolyphaseResampler resampler;
+            resampler.prepare (2, 2.0, PolyphaseResampler::Quality::medium);
+
+            std::vector<float> input (4096, 0.25f), output (512);
+            const float* in[] { input.data(), input.data() };
+            float* out[] { output.data(), output.data() };
+
+            const std::pair<double, double> ratios[] { { 1.0, 1.0 }, { 0.5, 1.7 }, { 1.7, 1.7 }, { 2.0, 0.3 } };
+            int64 totalUsed = 0;
+            double expectedPosition = 0.0;
+
+            for (auto [start, end] : ratios)
+            {
+                const auto needed = resampler.getNumInputSamplesNeeded (start, end, 500);
+                expectEquals (resampler.process (start, end, in, out, 500), needed);
+                totalUsed += needed;
+
+                for (int i = 0; i < 500; ++i)
+                    expectedPosition += start + (end - start) * i / 500;
+            }
+
+            expect (std::abs ((double) totalUsed - expectedPosition) <= 1.0);
+        }
+
+        beginTest ("Sine waves are converted without audible error");
+        {
+            const auto inRate = 44100.0, outRate = 48000.0;
+            const auto ratio = inRate / outRate;
+
+            PolyphaseResampler resampler;
+            resampler.prepare (1, ratio, PolyphaseResampler::Quality::high);
+
+            const auto numOut = 4096;
+            std::vector<float> input ((size_t) resampler.getNumInputSamplesNeeded (ratio, numOut)), output ((size_t) numOut);
+
+            const auto frequency = 1000.0;
+
+            for (size_t i = 0; i < input.size(); ++i)
+                input[i] = (float) std::sin (MathConstants<double>::twoPi * frequency * (double) i / inRate);
+
+            const float* in[] { input.data() };
+            float* out[] { output.data() };
+            resampler.process (ratio, in, out, numOut);
+
+            // output sample i corresponds to the input at (i * ratio - latency)
+            double maxError = 0.0;
+
+            for (int i = 256; i < numOut; ++i)
+            {
+                const auto inputTime = i * ratio - resampler.getLatencyInInputSamples();
+                const auto expected = std::sin (MathConstants<double>::twoPi * frequency * inputTime / inRate);
+                maxError = jmax (maxError, std::abs (expected - output[(size_t) i]));
+            }
+
+            expectLessThan (maxError, 1.0e-3);
+        }
+
+        beginTest ("Interleaved processing matches non-interleaved processing");
+        {
+            PolyphaseResampler planar, interleaved;
+            planar.prepare (2, 1.5, PolyphaseResampler::Quality::low);
+            interleaved.prepare (2, 1.5, PolyphaseResampler::Quality::low);
+
+            Random random (0x1234);
+            const auto numIn = 2000, numOut = 1000;
+            AudioBuffer<float> planarIn (2, numIn), planarOut (2, numOut);
+            std::vector<float> interleavedIn ((size_t) numIn * 2), interleavedOut ((size_t) numOut * 2);
+
+            for (int i = 0; i < numIn; ++i)
+            {
+                for (int chan = 0; chan < 2; ++chan)
+                {
+                    const auto value = random.nextFloat() * 2.0f - 1.0f;
+                    planarIn.setSample (chan, i, value);
+                    interleavedIn[(size_t) (i * 2 + chan)] = value;
+                }
+            }
+
+            const auto usedPlanar = planar.process (0.8, 1.5, planarIn.getArrayOfReadPointers(), planarOut.getArrayOfWritePointers(), numOut);
+            const auto usedInterleaved = interleaved.processInterleaved (0.8, 1.5, interleavedIn.data(), interleavedOut.data(), numOut);
+            expectEquals (usedInterleaved, usedPlanar);
+
+            bool allEqual = true;
+
+            for (int i = 0; i < numOut; ++i)
+                for (int chan = 0; chan < 2; ++chan)
+                    allEqual = allEqual && exactlyEqual (planarOut.getSample (chan, i), interleavedOut[(size_t) (i * 2 + chan)]);
+
+            expect (allEqual);
+        }
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    A multi-channel windowed-sinc resampler, for high quality sample rate conversion
+    and varispeed playback.
+
+    The resampler precalculates a bank of filter phases when it's prepared, and each
+    output sample is computed by interpolating between the two nearest phases, so it
+    can handle any ratio, and the ratio can be changed smoothly over each block. The
+    filter's cutoff is chosen for the largest ratio passed to prepare(), so that
+    speeding up the input doesn't cause aliasing.
+
+    Like the interpolators, the resampler is stateful, so call reset() whenever there's
+    a break in the continuity of the input. Unlike those, one object handles all the
+    channels of a stream, and it can read and write interleaved data.
+
+    @code
+    PolyphaseResampler resampler;
+    resampler.prepare (2, 48000.0 / 44100.0, PolyphaseResampler::Quality::high);
+
+    auto numNeeded = resampler.getNumInputSamplesNeeded (48000.0 / 44100.0, numOutputSamples);
+    // ...fetch numNeeded input samples, then:
+    resampler.process (48000.0 / 44100.0, inputChannels, outputChannels, numOutputSamples);
+    @endcode
+
+    @see LagrangeInterpolator, WindowedSincInterpolator, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** The available trade-offs between quality, latency and CPU. */
+    enum class Quality
+    {
+        low,        /**< 16 taps, about 70dB of stopband rejection. */
+        medium,     /**< 32 taps, about 90dB of stopband rejection. */
+        high        /**< 64 taps, about 110dB of stopband rejection, with a wider passband. */
+    };
+
+    /** Creates a resampler. You need to call prepare() before using it. */
+    PolyphaseResampler();
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    PolyphaseResampler (PolyphaseResampler&&) noexcept;
+    PolyphaseResampler& operator= (PolyphaseResampler&&) noexcept;
+
+    //==============================================================================
+    /** Builds the filter bank and allocates the resampler's buffers, then resets it.
+
+        @param numChannels          the number of channels that will be processed
+        @param maximumSpeedRatio    the largest number of input samples per output sample
+                                    that will be used. Ratios of 1 or less (upsampling) all
+                                    use the same filter, but for larger ratios the filter
+                                    gets longer, in proportion to this value
+        @param quality              the filter quality to use
+    */
+    void prepare (int numChannels, double maximumSpeedRatio, Quality quality);
+
+    /** Clears the resampler's history.
+
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    /** Returns the delay, in input samples, between a sample going in and the
+        corresponding point coming out.
+
+        In output samples, this is the value divided by the speed ratio.
+    */
+    int getLatencyInInputSamples() const noexcept           { return numTaps / 2; }
+
+    /** Returns the number of channels passed to prepare(). */
+    int getNumChannels() const noexcept                     { return numChannels; }
+
+    /** Returns the number of filter taps used for each output sample. */
+    int getNumTaps() const noexcept                         { return numTaps; }
+
+    //==============================================================================
+    /** Returns the number of input samples that a call to process() with the same
+        arguments would consume.
+    */
+    int getNumInputSamplesNeeded (double startSpeedRatio, double endSpeedRatio,
+                                  int numOutputSamplesToProduce) const noexcept;
+
+    /** Returns the number of input samples that a call to process() with the same
+        arguments would consume.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept
+    {
+        return getNumInputSamplesNeeded (speedRatio, speedRatio, numOutputSamplesToProduce);
+    }
+
+    /** Resamples a block of non-interleaved channels, moving the speed ratio linearly
+        from startSpeedRatio to endSpeedRatio across the block.
+
+        @param startSpeedRatio              the number of input samples per output sample at the
+                                            start of the block
+        @param endSpeedRatio                the ratio to move towards by the end of the block
+        @param inputChannels                one pointer per channel to read from. Each channel must
+                                            contain at least as many samples as getNumInputSamplesNeeded()
+                                            returns for the same arguments
+        @param outputChannels               one pointer per channel to write the results to
+        @param numOutputSamplesToProduce    the number of output samples to create
+
+        @returns the number of input samples that were used
+    */
+    int process (double startSpeedRatio, double endSpeedRatio,
+                 const float* const* inputChannels, float* const* outputChannels,
+                 int numOutputSamplesToProduce) noexcept;
+
+    /** Resamples a block of non-interleaved channels at a fixed speed ratio.
+        @see process
+    */
+    int process (double speedRatio, const float* const* inputChannels,
+                 float* const* outputChannels, int numOutputSamplesToProduce) noexcept
+    {
+        return process (speedRatio, speedRatio, inputChannels, outputChannels, numOutputSamplesToProduce);
+    }
+
+    /** Resamples a block of interleaved samples, moving the speed ratio linearly
+        from startSpeedRatio to endSpeedRatio across the block.
+
+        This is the same as process(), but with all the channels' samples interleaved in
+        the input and output. numOutputSamplesToProduce is the number of frames to produce,
+        and the return value is a number of frames too.
+    */
+    int processInterleaved (double startSpeedRatio, double endSpeedRatio,
+                            const float* input, float* output,
+                            int numOutputSamplesToProduce) noexcept;
+
+    /** Resamples a block of interleaved samples at a fixed speed ratio.
+        @see processInterleaved
+    */
+    int processInterleaved (double speedRatio, const float* input, float* output,
+                            int numOutputSamplesToProduce) noexcept
+    {
+        return processInterleaved (speedRatio, speedRatio, input, output, numOutputSamplesToProduce);
+    }
+
+private:
+    //==============================================================================
+    int numChannels = 0, numTaps = 0, numPhases = 0;
+    double maxSpeedRatio = 1.0;
+    HeapBlock<float> phases;    // (numPhases + 1) * numTaps coefficients
+    AudioBuffer<float> history; // the most recent input, always with at least numTaps valid samples before writePos
+    HeapBlock<const float*> inputPointers;
+    HeapBlock<float*> outputPointers;
+    double subSamplePos = 1.0;
+    int writePos = 0;
+
+    void createPhases (Quality quality);
+    int processImpl (double startSpeedRatio, double endSpeedRatio,
+                     const float* const* inputs, int inputStride,
+                     float* const* outputs, int outputStride,
+                     int numOutputSamplesToProduce) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
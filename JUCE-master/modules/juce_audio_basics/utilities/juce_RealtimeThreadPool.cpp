@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/*  A counting semaphore that only makes a system call when a thread actually has to sleep,
+    or has to be woken up. The count goes negative while threads are waiting.
+*/
+class RealtimeThreadPool::Semaphore
+{
+public:
+    Semaphore()
+    {
+       #if JUCE_MAC || JUCE_IOS
+        semaphore = dispatch_semaphore_create (0);
+       #elif JUCE_WINDOWS
+        semaphore = CreateSemaphoreW (nullptr, 0, std::numeric_limits<LONG>::max(), nullptr);
+       #elif ! (JUCE_LINUX || JUCE_ANDROID)
+        sem_init (&semaphore, 0, 0);
+       #endif
+    }
+
+    ~Semaphore()
+    {
+       #if JUCE_MAC || JUCE_IOS
+        dispatch_release (semaphore);
+       #elif JUCE_WINDOWS
+        CloseHandle (semaphore);
+       #elif ! (JUCE_LINUX || JUCE_ANDROID)
+        sem_destroy (&semaphore);
+       #endif
+    }
+
+    void signal (int num) noexcept
+    {
+        const auto previous = count.fetch_add (num, std::memory_order_release);
+        const auto numToWake = jmin (num, -previous);
+
+        if (numToWake > 0)
+            signalNative (numToWake);
+    }
+
+    void wait (int spinTimeMicroseconds) noexcept
+    {
+        if (spinTimeMicroseconds > 0)
+        {
+            const auto spinEnd = Time::getHighResolutionTicks()
+                               + Time::secondsToHighResolutionTicks (spinTimeMicroseconds * 1.0e-6);
+
+            do
+            {
+                if (tryWait())
+                    return;
+            }
+            while (Time::getHighResolutionTicks() < spinEnd);
+        }
+
+        if (count.fetch_sub (1, std::memory_order_acquire) > 0)
+            return;
+
+        waitNative();
+    }
+
+private:
+    bool tryWait() noexcept
+    {
+        for (auto c = count.load (std::memory_order_relaxed); c > 0;)
+            if (count.compare_exchange_weak (c, c - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+
+        return false;
+    }
+
+    void signalNative (int num) noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        available.fetch_add ((uint32) num, std::memory_order_release);
+        syscall (SYS_futex, reinterpret_cast<uint32*> (&available), FUTEX_WAKE_PRIVATE, num, nullptr, nullptr, 0);
+       #elif JUCE_MAC || JUCE_IOS
+        for (int i = 0; i < num; ++i)
+            dispatch_semaphore_signal (semaphore);
+       #elif JUCE_WINDOWS
+        ReleaseSemaphore (semaphore, (LONG) num, nullptr);
+       #else
+        for (int i = 0; i < num; ++i)
+            sem_post (&semaphore);
+       #endif
+    }
+
+    void waitNative() noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        for (;;)
+        {
+            for (auto a = available.load (std::memory_order_relaxed); a > 0;)
+                if (available.compare_exchange_weak (a, a - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                    return;
+
+            syscall (SYS_futex, reinterpret_cast<uint32*> (&available), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+        }
+       #elif JUCE_MAC || JUCE_IOS
+        dispatch_semaphore_wait (semaphore, DISPATCH_TIME_FOREVER);
+       #elif JUCE_WINDOWS
+        WaitForSingleObject (semaphore, INFINITE);
+       #else
+        while (sem_wait (&semaphore) != 0 && errno == EINTR) {}
+       #endif
+    }
+
+    std::atomic<int> count { 0 };
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    std::atomic<uint32> available { 0 };
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_t semaphore;
+   #elif JUCE_WINDOWS
+    HANDLE semaphore;
+   #else
+    sem_t semaphore;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (Semaphore)
+};
+
+//==============================================================================
+class RealtimeThreadPool::Worker final : private Thread
+{
+public:
+    Worker (RealtimeThreadPool& p, const RealtimeThreadPoolOptions& options)
+        : Thread (options.threadName),
+          owner (p),
+          spinTimeMicroseconds (options.spinTimeMicroseconds)
+    {
+        if (! startRealtimeThread (options.realtimeOptions))
+            startThread (Priority::highest);
+    }
+
+    ~Worker() override
+    {
+        stopThread (-1);
+    }
+
+    using Thread::signalThreadShouldExit;
+
+private:
+    void run() override
+    {
+        WorkgroupToken token;
+        auto lastGeneration = -1;
+
+        for (;;)
+        {
+            owner.wakeUp->wait (spinTimeMicroseconds);
+
+            if (threadShouldExit())
+                return;
+
+            joinWorkgroupIfChanged (token, lastGeneration);
+
+            ++owner.numActiveWorkers;
+
+            if (auto* job = owner.currentJob.load())
+                job->work();
+
+            --owner.numActiveWorkers;
+        }
+    }
+
+    void joinWorkgroupIfChanged (WorkgroupToken& token, int& lastGeneration)
+    {
+        const auto currentGeneration = owner.workgroupGeneration.load();
+
+        if (std::exchange (lastGeneration, currentGeneration) == currentGeneration)
+            return;
+
+        const SpinLock::ScopedLockType sl (owner.workgroupLock);
+        owner.workgroup.join (token);
+    }
+
+    RealtimeThreadPool& owner;
+    const int spinTimeMicroseconds;
+};
+
+//==============================================================================
+void RealtimeThreadPool::Job::work()
+{
+    for (auto task = nextTask.fetch_add (1); task < numTasks; task = nextTask.fetch_add (1))
+    {
+        process (task);
+        numTasksDone.fetch_add (1, std::memory_order_acq_rel);
+    }
+}
+
+//==============================================================================
+RealtimeThreadPool::RealtimeThreadPool (const RealtimeThreadPoolOptions& options)
+    : wakeUp (std::make_unique<Semaphore>())
+{
+    jassert (options.numberOfThreads > 0);
+
+    for (int i = 0; i < options.numberOfThreads; ++i)
+        workers.push_back (std::make_unique<Worker> (*this, options));
+
+    maxWorkersToWake = getNumThreads();
+}
+
+RealtimeThreadPool::~RealtimeThreadPool()
+{
+    // Don't delete the pool while it's running tasks!
+    jassert (currentJob == nullptr);
+
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    wakeUp->signal (getNumThreads());
+    workers.clear();
+}
+
+int RealtimeThreadPool::getNumThreads() const noexcept
+{
+    return (int) workers.size();
+}
+
+void RealtimeThreadPool::setAudioWorkgroup (const AudioWorkgroup& newWorkgroup)
+{
+    const auto maxParallelThreads = (int) newWorkgroup.getMaxParallelThreadCount();
+
+    {
+        const SpinLock::ScopedLockType sl (workgroupLock);
+        workgroup = newWorkgroup;
+    }
+
+    maxWorkersToWake = maxParallelThreads > 0 ? jlimit (0, getNumThreads(), maxParallelThreads - 1)
+                                              : getNumThreads();
+    ++workgroupGeneration;
+}
+
+void RealtimeThreadPool::runJob (Job& job)
+{
+    currentJob = &job;
+
+    // The calling thread takes the first task itself
+    if (const auto numToWake = jmin (job.numTasks - 1, maxWorkersToWake.load()); numToWake > 0)
+        wakeUp->signal (numToWake);
+
+    job.work();
+
+    while (job.numTasksDone.load (std::memory_order_acquire) < job.numTasks)
+        Thread::yield();
+
+    // Wait until every worker has let go of the job, as it lives on the calling thread's stack
+    currentJob = nullptr;
+
+    while (numActiveWorkers != 0)
+        Thread::yield();
+}
+
+} // namespace juce
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Options for creating a RealtimeThreadPool.
+
+    @see RealtimeThreadPool
+
+    @tags{Audio}
+*/
+struct RealtimeThreadPoolOptions
+{
+    /** The name to give each thread in the pool. */
+    [[nodiscard]] RealtimeThreadPoolOptions withThreadName (String newThreadName) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::threadName, newThreadName);
+    }
+
+    /** The number of worker threads to start. The thread that calls RealtimeThreadPool::run()
+        also runs tasks, so this is usually one less than the number of threads you'd like to
+        be working at once.
+    */
+    [[nodiscard]] RealtimeThreadPoolOptions withNumberOfThreads (int newNumberOfThreads) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::numberOfThreads, newNumberOfThreads);
+    }
+
+    /** The realtime options that the worker threads are started with. If a realtime thread
+        can't be started, the threads fall back to the highest normal priority.
+    */
+    [[nodiscard]] RealtimeThreadPoolOptions withRealtimeOptions (Thread::RealtimeOptions newRealtimeOptions) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::realtimeOptions, newRealtimeOptions);
+    }
+
+    /** How long a worker keeps checking for more work after it has finished, before it goes
+        to sleep.
+
+        When the pool is used once per audio callback, and the callbacks are short, spinning
+        for a little longer than the gap between the calls to run() means the workers never
+        have to be woken by the OS, at the cost of keeping those cores busy.
+    */
+    [[nodiscard]] RealtimeThreadPoolOptions withSpinTimeMicroseconds (int newSpinTimeMicroseconds) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::spinTimeMicroseconds, newSpinTimeMicroseconds);
+    }
+
+    String threadName { "Realtime Pool" };
+    int numberOfThreads { jmax (1, SystemStats::getNumPhysicalCpus() - 1) };
+    Thread::RealtimeOptions realtimeOptions = Thread::RealtimeOptions{}.withPriority (9);
+    int spinTimeMicroseconds = 0;
+};
+
+//==============================================================================
+/**
+    A set of realtime threads that help the audio thread get through a list of tasks within
+    a single audio callback.
+
+    run() wakes as many workers as there are tasks for, and then the calling thread and the
+    workers each take the next unclaimed task until none are left. It returns once every task
+    has finished, so the tasks can safely refer to data on the calling thread's stack.
+
+    Because the calling thread also takes tasks, it never has to wait for a worker to be
+    woken: a task that no worker has picked up yet is simply run by the caller. The only time
+    spent waiting is for tasks that are already running on another thread, so a late worker
+    can't make the callback miss its deadline.
+
+    Sleeping workers are woken with a semaphore (a futex on Linux and Android), and never
+    wait on a mutex or condition variable, so run() is realtime-safe.
+
+    The workers join the workgroup given to setAudioWorkgroup(), so that on platforms that
+    support workgroups they're scheduled together with the audio thread. Pass the workgroup
+    from AudioIODevice::getWorkgroup() or AudioProcessor::audioWorkgroupContextChanged().
+
+    @code
+    RealtimeThreadPool pool;
+
+    void audioDeviceAboutToStart (AudioIODevice* device) override
+    {
+        pool.setAudioWorkgroup (device->getWorkgroup());
+    }
+
+    void audioDeviceIOCallbackWithContext (...) override
+    {
+        pool.run (numTracks, [&] (int track) { tracks[track].process (...); });
+    }
+    @endcode
+
+    @see AudioWorkgroup, RealtimeThreadPoolOptions
+
+    @tags{Audio}
+*/
+class JUCE_API  RealtimeThreadPool
+{
+public:
+    //==============================================================================
+    /** Creates the pool and starts its worker threads. */
+    explicit RealtimeThreadPool (const RealtimeThreadPoolOptions& options = {});
+
+    /** Stops the worker threads. This must not be called while run() is in progress. */
+    ~RealtimeThreadPool();
+
+    //==============================================================================
+    /** Returns the number of worker threads, not counting the thread that calls run(). */
+    int getNumThreads() const noexcept;
+
+    /** Sets the workgroup that the worker threads should join. Each worker rejoins the next
+        time it wakes up.
+
+        If the workgroup recommends a maximum number of parallel threads, no more workers than
+        that (less one for the calling thread) are woken for each call to run().
+    */
+    void setAudioWorkgroup (const AudioWorkgroup& newWorkgroup);
+
+    /** Calls task (i) for each i from 0 to numTasks - 1, on whichever threads are free, and
+        returns when all of them have finished.
+
+        Tasks are started in order. Only one thread may call this at a time, and it mustn't be
+        called from inside one of its own tasks.
+    */
+    template <typename Task>
+    void run (int numTasks, Task&& task)
+    {
+        if (numTasks <= 0)
+            return;
+
+        TaskJob<std::remove_reference_t<Task>> job (task, numTasks);
+        runJob (job);
+    }
+
+private:
+    //==============================================================================
+    struct Job
+    {
+        virtual ~Job() = default;
+        virtual void process (int task) = 0;
+
+        void work();
+
+        int numTasks = 0;
+        std::atomic<int> nextTask { 0 }, numTasksDone { 0 };
+    };
+
+    template <typename Task>
+    struct TaskJob final : public Job
+    {
+        TaskJob (Task& t, int num) : task (t)       { numTasks = num; }
+        void process (int index) override           { task (index); }
+
+        Task& task;
+    };
+
+    class Semaphore;
+    class Worker;
+
+    void runJob (Job&);
+
+    //==============================================================================
+    std::unique_ptr<Semaphore> wakeUp;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<int> numActiveWorkers { 0 }, maxWorkersToWake { 0 };
+
+    SpinLock workgroupLock;
+    AudioWorkgroup workgroup;
+    std::atomic<int> workgroupGeneration { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeThreadPool)
+};
+
+} // namespace juce
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class RealtimeThreadPoolTests final : public UnitTest
+{
+public:
+    RealtimeThreadPoolTests()  : UnitTest ("RealtimeThreadPool", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Every task runs exactly once");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPoolOptions{}.withNumberOfThreads (3));
+
+            for (const auto numTasks : { 0, 1, 2, 3, 4, 17, 100 })
+            {
+                std::vector<std::atomic<int>> counts ((size_t) numTasks);
+
+                for (auto& c : counts)
+                    c = 0;
+
+                pool.run (numTasks, [&] (int task) { ++counts[(size_t) task]; });
+
+                expect (std::all_of (counts.begin(), counts.end(), [] (const auto& c) { return c == 1; }));
+            }
+        }
+
+        beginTest ("Tasks are shared between threads");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPoolOptions{}.withNumberOfThreads (2));
+            std::set<Thread::ThreadID> threadsUsed;
+            SpinLock threadsLock;
+
+            // Each task waits until another has started, so they can't all run on one thread
+            std::atomic<int> numStarted { 0 };
+
+            pool.run (3, [&] (int)
+            {
+                {
+                    const SpinLock::ScopedLockType sl (threadsLock);
+                    threadsUsed.insert (Thread::getCurrentThreadId());
+                }
+
+                if (++numStarted < 2)
+                    while (numStarted < 2)
+                        Thread::yield();
+            });
+
+            expectGreaterOrEqual ((int) threadsUsed.size(), 2);
+        }
+
+        beginTest ("Repeated runs see the results of earlier ones");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPoolOptions{}.withNumberOfThreads (2)
+                                                                .withSpinTimeMicroseconds (200));
+            std::vector<int> values (64, 0);
+
+            for (int i = 0; i < 1000; ++i)
+                pool.run ((int) values.size(), [&] (int task) { ++values[(size_t) task]; });
+
+            expect (std::all_of (values.begin(), values.end(), [] (int v) { return v == 1000; }));
+        }
+
+        beginTest ("A pool can be deleted straight after it's created");
+        {
+            for (int i = 0; i < 10; ++i)
+                RealtimeThreadPool pool (RealtimeThreadPoolOptions{}.withNumberOfThreads (4));
+        }
+    }
+};
+
+static RealtimeThreadPoolTests realtimeThreadPoolTests;
+
+} // namespace juce
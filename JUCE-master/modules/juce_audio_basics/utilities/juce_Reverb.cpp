@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+namespace ReverbHelpers
+{
+    using Ops = FloatVectorHelpers::BasicOps32;
+
+    // Builds a register from separate values without going through memory, as a wide
+    // load of values that have just been stored individually would stall store-forwarding
+    static forcedinline Ops::ParallelType gather (const float* const* positions, int i) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        return _mm_setr_ps (positions[0][i], positions[1][i], positions[2][i], positions[3][i]);
+       #else
+        auto v = vdupq_n_f32 (positions[0][i]);
+        v = vsetq_lane_f32 (positions[1][i], v, 1);
+        v = vsetq_lane_f32 (positions[2][i], v, 2);
+        return vsetq_lane_f32 (positions[3][i], v, 3);
+       #endif
+    }
+}
+#endif
+
+template <int numChannelsToUse>
+void Reverb::CombFilterBank::process (const float* input, const float* damp, const float* feedbackLevel,
+                                      float* const* outputs, int numSamples) noexcept
+{
+    static_assert (numChannelsToUse > 0 && numChannelsToUse <= numChannels);
+    constexpr int numFiltersToUse = numChannelsToUse * numCombs;
+
+   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    using ReverbHelpers::Ops;
+    constexpr int numParallel = Ops::numParallel;
+    constexpr int numGroups = numFiltersToUse / numParallel;
+    static_assert (numCombs % numParallel == 0, "The filters must fill whole SIMD registers");
+
+   #if JUCE_INTEL
+    // Vector version of JUCE_UNDENORMALISE, so that the results match the scalar code
+    const auto undenormaliser = Ops::load1 (0.1f);
+    const auto undenormalise = [undenormaliser] (Ops::ParallelType v) { return Ops::sub (Ops::add (v, undenormaliser), undenormaliser); };
+   #else
+    const auto undenormalise = [] (Ops::ParallelType v) { return v; };
+   #endif
+   #endif
+
+    int offset = 0;
+
+    while (offset < numSamples)
+    {
+        int numToProcess = numSamples - offset;
+        float* positions[numFilters];
+
+        for (int j = 0; j < numFiltersToUse; ++j)
+        {
+            numToProcess = jmin (numToProcess, bufferSizes[j] - bufferIndices[j]);
+            positions[j] = buffers[j] + bufferIndices[j];
+        }
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        Ops::ParallelType last[numFilters / numParallel];
+
+        for (int g = 0; g < numGroups; ++g)
+            last[g] = Ops::loadU (lastValues + g * numParallel);
+
+        for (int i = 0; i < numToProcess; ++i)
+        {
+            const int n = offset + i;
+
+            const auto d        = Ops::load1 (damp[n]);
+            const auto dInverse = Ops::load1 (1.0f - damp[n]);
+            const auto feedbck  = Ops::load1 (feedbackLevel[n]);
+            const auto in       = Ops::load1 (input[n]);
+
+            for (int c = 0; c < numChannelsToUse; ++c)
+            {
+                float sum = 0;
+
+                for (int j = 0; j < numCombs; ++j)
+                    sum += positions[c * numCombs + j][i];
+
+                outputs[c][n] = sum;
+            }
+
+            float temps[numFilters];
+
+            for (int g = 0; g < numGroups; ++g)
+            {
+                last[g] = undenormalise (Ops::add (Ops::mul (ReverbHelpers::gather (positions + g * numParallel, i), dInverse),
+                                                   Ops::mul (last[g], d)));
+
+                Ops::storeU (temps + g * numParallel, undenormalise (Ops::add (in, Ops::mul (last[g], feedbck))));
+            }
+
+            for (int j = 0; j < numFiltersToUse; ++j)
+                positions[j][i] = temps[j];
+        }
+
+        for (int g = 0; g < numGroups; ++g)
+            Ops::storeU (lastValues + g * numParallel, last[g]);
+       #else
+        for (int i = 0; i < numToProcess; ++i)
+        {
+            const int n = offset + i;
+
+            for (int c = 0; c < numChannelsToUse; ++c)
+            {
+                float sum = 0;
+
+                for (int j = c * numCombs; j < (c + 1) * numCombs; ++j)
+                {
+                    const float out = positions[j][i];
+                    float l = (out * (1.0f - damp[n])) + (lastValues[j] * damp[n]);
+                    JUCE_UNDENORMALISE (l);
+                    lastValues[j] = l;
+
+                    float temp = input[n] + (l * feedbackLevel[n]);
+                    JUCE_UNDENORMALISE (temp);
+                    positions[j][i] = temp;
+                    sum += out;
+                }
+
+                outputs[c][n] = sum;
+            }
+        }
+       #endif
+
+        for (int j = 0; j < numFiltersToUse; ++j)
+        {
+            bufferIndices[j] += numToProcess;
+
+            if (bufferIndices[j] == bufferSizes[j])
+                bufferIndices[j] = 0;
+        }
+
+        offset += numToProcess;
+    }
+}
+
+template void Reverb::CombFilterBank::process<1> (const float*, const float*, const float*, float* const*, int) noexcept;
+template void Reverb::CombFilterBank::process<2> (const float*, const float*, const float*, float* const*, int) noexcept;
+
+} // namespace juce
@@ -106,12 +106,16 @@ public:
         const int stereoSpread = 23;
         const int intSampleRate = (int) sampleRate;
 
+        int combSizes[numChannels * numCombs];
+
         for (int i = 0; i < numCombs; ++i)
         {
-            comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
-            comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            combSizes[i]            = (intSampleRate * combTunings[i]) / 44100;
+            combSizes[numCombs + i] = (intSampleRate * (combTunings[i] + stereoSpread)) / 44100;
         }
 
+        combs.setSizes (combSizes);
+
         for (int i = 0; i < numAllPasses; ++i)
         {
             allPass[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
@@ -129,14 +133,11 @@ public:
     /** Clears the reverb's buffers. */
     void reset()
     {
-        for (int j = 0; j < numChannels; ++j)
-        {
-            for (int i = 0; i < numCombs; ++i)
-                comb[j][i].clear();
+        combs.clear();
 
+        for (int j = 0; j < numChannels; ++j)
             for (int i = 0; i < numAllPasses; ++i)
                 allPass[j][i].clear();
-        }
     }
 
     //==============================================================================
@@ -146,33 +147,41 @@ public:
         JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6011)
         jassert (left != nullptr && right != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += maxBlockSize)
         {
-            // NOLINTNEXTLINE(clang-analyzer-core.NullDereference)
-            const float input = (left[i] + right[i]) * gain;
-            float outL = 0, outR = 0;
+            const int num = jmin ((int) maxBlockSize, numSamples - start);
+            float* const l = left + start;
+            float* const r = right + start;
 
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
+            float input[maxBlockSize], damp[maxBlockSize], feedbck[maxBlockSize];
+            float outL[maxBlockSize], outR[maxBlockSize];
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
+            for (int i = 0; i < num; ++i)
             {
-                outL += comb[0][j].process (input, damp, feedbck);
-                outR += comb[1][j].process (input, damp, feedbck);
+                // NOLINTNEXTLINE(clang-analyzer-core.NullDereference)
+                input[i]   = (l[i] + r[i]) * gain;
+                damp[i]    = damping.getNextValue();
+                feedbck[i] = feedback.getNextValue();
             }
 
+            float* const outputs[] = { outL, outR };
+            combs.process<2> (input, damp, feedbck, outputs, num);  // accumulate the comb filters in parallel
+
             for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
             {
-                outL = allPass[0][j].process (outL);
-                outR = allPass[1][j].process (outR);
+                allPass[0][j].process (outL, num);
+                allPass[1][j].process (outR, num);
             }
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-            const float wet2 = wetGain2.getNextValue();
+            for (int i = 0; i < num; ++i)
+            {
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+                const float wet2 = wetGain2.getNextValue();
 
-            left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
-            right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+                l[i] = outL[i] * wet1 + outR[i] * wet2 + l[i] * dry;
+                r[i] = outR[i] * wet1 + outL[i] * wet2 + r[i] * dry;
+            }
         }
         JUCE_END_IGNORE_WARNINGS_MSVC
     }
@@ -183,24 +192,33 @@ public:
         JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6011)
         jassert (samples != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += maxBlockSize)
         {
-            const float input = samples[i] * gain;
-            float output = 0;
+            const int num = jmin ((int) maxBlockSize, numSamples - start);
+            float* const s = samples + start;
 
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
+            float input[maxBlockSize], damp[maxBlockSize], feedbck[maxBlockSize], output[maxBlockSize];
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-                output += comb[0][j].process (input, damp, feedbck);
+            for (int i = 0; i < num; ++i)
+            {
+                input[i]   = s[i] * gain;
+                damp[i]    = damping.getNextValue();
+                feedbck[i] = feedback.getNextValue();
+            }
+
+            float* const outputs[] = { output };
+            combs.process<1> (input, damp, feedbck, outputs, num);  // accumulate the comb filters in parallel
 
             for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-                output = allPass[0][j].process (output);
+                allPass[0][j].process (output, num);
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
+            for (int i = 0; i < num; ++i)
+            {
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
 
-            samples[i] = output * wet1 + samples[i] * dry;
+                s[i] = output[i] * wet1 + s[i] * dry;
+            }
         }
         JUCE_END_IGNORE_WARNINGS_MSVC
     }
@@ -229,18 +247,31 @@ private:
     }
 
     //==============================================================================
-    class CombFilter
+    enum { numCombs = 8, numAllPasses = 4, numChannels = 2, maxBlockSize = 64 };
+
+    //==============================================================================
+    /*  The parallel comb filters of both channels. They all share their input and
+        coefficients, so their states are kept side by side and updated across SIMD
+        lanes, the filters of channel c being at indices [c * numCombs, (c + 1) * numCombs).
+        Samples are handled in runs during which no delay line wraps.
+    */
+    class CombFilterBank
     {
     public:
-        CombFilter() noexcept {}
+        CombFilterBank() noexcept {}
 
-        void setSize (const int size)
+        void setSizes (const int* sizes)
         {
-            if (size != bufferSize)
+            for (int j = 0; j < numFilters; ++j)
             {
-                bufferIndex = 0;
-                buffer.malloc (size);
-                bufferSize = size;
+                jassert (sizes[j] > 0);
+
+                if (sizes[j] != bufferSizes[j])
+                {
+                    bufferIndices[j] = 0;
+                    buffers[j].malloc (sizes[j]);
+                    bufferSizes[j] = sizes[j];
+                }
             }
 
             clear();
@@ -248,29 +279,29 @@ private:
 
         void clear() noexcept
         {
-            last = 0;
-            buffer.clear ((size_t) bufferSize);
+            for (int j = 0; j < numFilters; ++j)
+            {
+                lastValues[j] = 0;
+                buffers[j].clear ((size_t) bufferSizes[j]);
+            }
         }
 
-        float process (const float input, const float damp, const float feedbackLevel) noexcept
-        {
-            const float output = buffer[bufferIndex];
-            last = (output * (1.0f - damp)) + (last * damp);
-            JUCE_UNDENORMALISE (last);
-
-            float temp = input + (last * feedbackLevel);
-            JUCE_UNDENORMALISE (temp);
-            buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return output;
-        }
+        /*  Runs the filters of the first numChannelsToUse channels over a block, writing
+            the sum of each channel's filter outputs. This is defined in juce_Reverb.cpp,
+            where the SIMD helpers are available.
+        */
+        template <int numChannelsToUse>
+        void process (const float* input, const float* damp, const float* feedbackLevel,
+                      float* const* outputs, int numSamples) noexcept;
 
     private:
-        HeapBlock<float> buffer;
-        int bufferSize = 0, bufferIndex = 0;
-        float last = 0.0f;
+        enum { numFilters = numChannels * numCombs };
 
-        JUCE_DECLARE_NON_COPYABLE (CombFilter)
+        HeapBlock<float> buffers[numFilters];
+        int bufferSizes[numFilters] = {}, bufferIndices[numFilters] = {};
+        float lastValues[numFilters] = {};
+
+        JUCE_DECLARE_NON_COPYABLE (CombFilterBank)
     };
 
     //==============================================================================
@@ -281,6 +312,8 @@ private:
 
         void setSize (const int size)
         {
+            jassert (size > 0);
+
             if (size != bufferSize)
             {
                 bufferIndex = 0;
@@ -296,14 +329,31 @@ private:
             buffer.clear ((size_t) bufferSize);
         }
 
-        float process (const float input) noexcept
+        void process (float* samples, int numSamples) noexcept
         {
-            const float bufferedValue = buffer [bufferIndex];
-            float temp = input + (bufferedValue * 0.5f);
-            JUCE_UNDENORMALISE (temp);
-            buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return bufferedValue - input;
+            while (numSamples > 0)
+            {
+                const int numToProcess = jmin (numSamples, bufferSize - bufferIndex);
+                float* const position = buffer + bufferIndex;
+
+                for (int i = 0; i < numToProcess; ++i)
+                {
+                    const float input = samples[i];
+                    const float bufferedValue = position[i];
+                    float temp = input + (bufferedValue * 0.5f);
+                    JUCE_UNDENORMALISE (temp);
+                    position[i] = temp;
+                    samples[i] = bufferedValue - input;
+                }
+
+                bufferIndex += numToProcess;
+
+                if (bufferIndex == bufferSize)
+                    bufferIndex = 0;
+
+                samples += numToProcess;
+                numSamples -= numToProcess;
+            }
         }
 
     private:
@@ -314,12 +364,11 @@ private:
     };
 
     //==============================================================================
-    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
-
+    //==============================================================================
     Parameters parameters;
     float gain;
 
-    CombFilter comb [numChannels][numCombs];
+    CombFilterBank combs;
     AllPassFilter allPass [numChannels][numAllPasses];
 
     SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
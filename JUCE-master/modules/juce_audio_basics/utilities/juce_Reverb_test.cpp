@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ReverbTests final : public UnitTest
+{
+    ReverbTests()  : UnitTest ("Reverb", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 44100.0;
+        constexpr int numSamples = 4000;
+
+        Reverb::Parameters parameters;
+        parameters.roomSize = 0.8f;
+        parameters.damping  = 0.3f;
+        parameters.width    = 0.7f;
+
+        auto random = getRandom();
+        AudioBuffer<float> input (2, numSamples);
+
+        for (int channel = 0; channel < input.getNumChannels(); ++channel)
+            for (int sample = 0; sample < numSamples; ++sample)
+                input.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+        beginTest ("Stereo output matches a per-sample reference");
+        {
+            AudioBuffer<float> expected (input), actual (input);
+
+            ReferenceReverb reference (sampleRate, parameters);
+            reference.processStereo (expected.getWritePointer (0), expected.getWritePointer (1), numSamples);
+
+            Reverb reverb;
+            reverb.setSampleRate (sampleRate);
+            reverb.setParameters (parameters);
+            reverb.processStereo (actual.getWritePointer (0), actual.getWritePointer (1), numSamples);
+
+            expectBuffersMatch (actual, expected, 2);
+        }
+
+        beginTest ("Mono output matches a per-sample reference");
+        {
+            AudioBuffer<float> expected (input), actual (input);
+
+            ReferenceReverb reference (sampleRate, parameters);
+            reference.processMono (expected.getWritePointer (0), numSamples);
+
+            Reverb reverb;
+            reverb.setSampleRate (sampleRate);
+            reverb.setParameters (parameters);
+            reverb.processMono (actual.getWritePointer (0), numSamples);
+
+            expectBuffersMatch (actual, expected, 1);
+        }
+
+        beginTest ("Output is independent of the block size");
+        {
+            AudioBuffer<float> expected (input), actual (input);
+
+            Reverb wholeBuffer, smallBlocks;
+
+            for (auto* reverb : { &wholeBuffer, &smallBlocks })
+            {
+                reverb->setSampleRate (sampleRate);
+                reverb->setParameters (parameters);
+            }
+
+            wholeBuffer.processStereo (expected.getWritePointer (0), expected.getWritePointer (1), numSamples);
+
+            for (int start = 0; start < numSamples;)
+            {
+                const auto blockSize = jmin (1 + random.nextInt (200), numSamples - start);
+                smallBlocks.processStereo (actual.getWritePointer (0, start), actual.getWritePointer (1, start), blockSize);
+                start += blockSize;
+            }
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int sample = 0; sample < numSamples; ++sample)
+                    expectEquals (actual.getSample (channel, sample), expected.getSample (channel, sample));
+        }
+    }
+
+private:
+    void expectBuffersMatch (const AudioBuffer<float>& actual, const AudioBuffer<float>& expected, int numChannels)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int sample = 0; sample < actual.getNumSamples(); ++sample)
+                expectWithinAbsoluteError (actual.getSample (channel, sample), expected.getSample (channel, sample), 1.0e-4f);
+    }
+
+    // The original one-sample-at-a-time Freeverb loop, used as the reference
+    struct ReferenceReverb
+    {
+        ReferenceReverb (double sampleRate, const Reverb::Parameters& p)
+        {
+            static const short combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+            static const short allPassTunings[] = { 556, 441, 341, 225 };
+            const int intSampleRate = (int) sampleRate;
+
+            for (int c = 0; c < 2; ++c)
+            {
+                for (int i = 0; i < 8; ++i)
+                    combs[c][i].setSize ((intSampleRate * (combTunings[i] + c * 23)) / 44100);
+
+                for (int i = 0; i < 4; ++i)
+                    allPasses[c][i].setSize ((intSampleRate * (allPassTunings[i] + c * 23)) / 44100);
+            }
+
+            // Like Reverb, start from the default parameters and ramp towards the new ones
+            setParameters ({});
+
+            for (auto* v : { &damping, &feedback, &dryGain, &wetGain1, &wetGain2 })
+                v->reset (sampleRate, 0.01);
+
+            setParameters (p);
+        }
+
+        void setParameters (const Reverb::Parameters& p)
+        {
+            const float wet = p.wetLevel * 3.0f;
+            dryGain .setTargetValue (p.dryLevel * 2.0f);
+            wetGain1.setTargetValue (0.5f * wet * (1.0f + p.width));
+            wetGain2.setTargetValue (0.5f * wet * (1.0f - p.width));
+            damping .setTargetValue (p.damping * 0.4f);
+            feedback.setTargetValue (p.roomSize * 0.28f + 0.7f);
+        }
+
+        void processStereo (float* left, float* right, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = (left[i] + right[i]) * 0.015f;
+                float outL = 0, outR = 0;
+
+                const float damp    = damping.getNextValue();
+                const float feedbck = feedback.getNextValue();
+
+                for (int j = 0; j < 8; ++j)
+                {
+                    outL += combs[0][j].process (input, damp, feedbck);
+                    outR += combs[1][j].process (input, damp, feedbck);
+                }
+
+                for (int j = 0; j < 4; ++j)
+                {
+                    outL = allPasses[0][j].process (outL);
+                    outR = allPasses[1][j].process (outR);
+                }
+
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+                const float wet2 = wetGain2.getNextValue();
+
+                left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
+                right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+            }
+        }
+
+        void processMono (float* samples, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = samples[i] * 0.015f;
+                float output = 0;
+
+                const float damp    = damping.getNextValue();
+                const float feedbck = feedback.getNextValue();
+
+                for (int j = 0; j < 8; ++j)
+                    output += combs[0][j].process (input, damp, feedbck);
+
+                for (int j = 0; j < 4; ++j)
+                    output = allPasses[0][j].process (output);
+
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+
+                samples[i] = output * wet1 + samples[i] * dry;
+            }
+        }
+
+        struct CombFilter
+        {
+            void setSize (int size)  { buffer.resize ((size_t) size); }
+
+            float process (float input, float damp, float feedbackLevel)
+            {
+                const float output = buffer[index];
+                last = (output * (1.0f - damp)) + (last * damp);
+                JUCE_UNDENORMALISE (last);
+
+                float temp = input + (last * feedbackLevel);
+                JUCE_UNDENORMALISE (temp);
+                buffer[index] = temp;
+                index = (index + 1) % buffer.size();
+                return output;
+            }
+
+            std::vector<float> buffer;
+            size_t index = 0;
+            float last = 0.0f;
+        };
+
+        struct AllPassFilter
+        {
+            void setSize (int size)  { buffer.resize ((size_t) size); }
+
+            float process (float input)
+            {
+                const float bufferedValue = buffer[index];
+                float temp = input + (bufferedValue * 0.5f);
+                JUCE_UNDENORMALISE (temp);
+                buffer[index] = temp;
+                index = (index + 1) % buffer.size();
+                return bufferedValue - input;
+            }
+
+            std::vector<float> buffer;
+            size_t index = 0;
+        };
+
+        CombFilter combs[2][8];
+        AllPassFilter allPasses[2][4];
+        SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
+    };
+};
+
+static ReverbTests reverbTests;
+
+} // namespace juce
@@ -94,6 +94,38 @@ public:
             for (int i = 0; i < values.getNumSamples(); ++i)
                 expectWithinAbsoluteError (values.getSample (0, i), values.getSample (1, i), 1.0e-9);
         }
+
+        beginTest ("Block values");
+        {
+            checkBlockValues<ValueSmoothingTypes::Linear>();
+            checkBlockValues<ValueSmoothingTypes::Multiplicative>();
+        }
+    }
+
+private:
+    template <typename SmoothingType>
+    void checkBlockValues()
+    {
+        SmoothedValue<float, SmoothingType> sv (1.0f), reference (1.0f);
+
+        for (auto* v : { &sv, &reference })
+        {
+            v->reset (300);
+            v->setTargetValue (3.0f);
+        }
+
+        const auto numSamples = 400;
+        std::vector<float> values ((size_t) numSamples);
+
+        sv.getNextValues (values.data(), 101);
+        sv.getNextValues (values.data() + 101, numSamples - 101);
+
+        for (int i = 0; i < numSamples; ++i)
+            expectWithinAbsoluteError (values[(size_t) i], reference.getNextValue(), 1.0e-5f);
+
+        expectEquals (values[299], sv.getTargetValue());
+        expectEquals (values.back(), sv.getTargetValue());
+        expect (! sv.isSmoothing());
     }
 };
 
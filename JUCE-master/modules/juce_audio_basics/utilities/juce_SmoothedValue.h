@@ -341,6 +341,40 @@ public:
         return this->currentValue;
     }
 
+    //==============================================================================
+    /** Writes the next numSamples values of the ramp into a buffer.
+
+        This advances the smoothed value in the same way as calling getNextValue
+        numSamples times, but computes the whole ramp in a form that the compiler can
+        vectorise. Linear ramps are evaluated directly from the start value and step,
+        and multiplicative ramps use precomputed powers of the geometric step, so the
+        values can differ from those of getNextValue by a small rounding error. The
+        value that reaches the target is always exactly the target.
+
+        @param destination  Pointer to a raw array that receives the values
+        @param numSamples   The number of values to write
+    */
+    void getNextValues (FloatType* destination, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        // The value that reaches the target is assigned exactly rather than computed
+        const auto numRampValues = jlimit (0, numSamples, this->countdown - 1);
+
+        if (numRampValues > 0)
+        {
+            writeRamp (destination, numRampValues);
+            this->currentValue = destination[numRampValues - 1];
+            this->countdown -= numRampValues;
+        }
+
+        if (numRampValues < numSamples)
+        {
+            this->setCurrentAndTargetValue (this->target);
+            FloatVectorOperations::fill (destination + numRampValues, this->target, numSamples - numRampValues);
+        }
+    }
+
     //==============================================================================
    #ifndef DOXYGEN
     /** Using the new methods:
@@ -407,6 +441,44 @@ private:
         }
     }
 
+    //==============================================================================
+    template <typename T = SmoothingType>
+    void writeRamp (FloatType* destination, int numValues) const noexcept
+    {
+        const auto start = this->currentValue;
+
+        if constexpr (std::is_same_v<T, ValueSmoothingTypes::Linear>)
+        {
+            for (int i = 0; i < numValues; ++i)
+                destination[i] = start + step * (FloatType) (i + 1);
+        }
+        else if constexpr (std::is_same_v<T, ValueSmoothingTypes::Multiplicative>)
+        {
+            // Each group of values is the last value of the previous group multiplied by
+            // step^1 ... step^groupSize, which leaves only one dependent multiply per group
+            constexpr int groupSize = 8;
+            FloatType powers[groupSize];
+            powers[0] = step;
+
+            for (int j = 1; j < groupSize; ++j)
+                powers[j] = powers[j - 1] * step;
+
+            auto base = start;
+            int i = 0;
+
+            for (; i + groupSize <= numValues; i += groupSize)
+            {
+                for (int j = 0; j < groupSize; ++j)
+                    destination[i + j] = base * powers[j];
+
+                base = destination[i + groupSize - 1];
+            }
+
+            for (int j = 0; i < numValues; ++i, ++j)
+                destination[i] = base * powers[j];
+        }
+    }
+
     //==============================================================================
     FloatType step = FloatType();
     int stepsToTarget = 0;
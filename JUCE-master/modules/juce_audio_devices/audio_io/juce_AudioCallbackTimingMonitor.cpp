@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioCallbackTimingMonitor::AudioCallbackTimingMonitor (int numCallbacksToRemember)
+    : numSlots (jmax (1, numCallbacksToRemember)),
+      slots (new Slot[(size_t) numSlots])
+{
+    reset (0.0);
+}
+
+AudioCallbackTimingMonitor::~AudioCallbackTimingMonitor() = default;
+
+void AudioCallbackTimingMonitor::reset (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    numCallbacks = 0;
+    overruns = 0;
+    lateCallbacks = 0;
+
+    for (auto& bin : jitterBins)
+        bin = 0;
+
+    lastStartTimeMs = 0;
+    lastPeriodMs = 0;
+    lastCallbackOverran = false;
+}
+
+void AudioCallbackTimingMonitor::registerCallback (double startTimeMs, double durationMs, int numSamples) noexcept
+{
+    const auto rate = sampleRate.load (std::memory_order_relaxed);
+    const auto periodMs = rate > 0.0 ? numSamples * 1000.0 / rate : 0.0;
+    const auto index = numCallbacks.load (std::memory_order_relaxed);
+
+    if (index > 0 && lastPeriodMs > 0.0)
+    {
+        const auto intervalMs = startTimeMs - lastStartTimeMs;
+        const auto bin = jlimit (0, numJitterBins - 1,
+                                 numJitterBins / 2 + (int) std::floor ((intervalMs - lastPeriodMs) / jitterBinWidthMs));
+
+        jitterBins[(size_t) bin].fetch_add (1, std::memory_order_relaxed);
+
+        if (intervalMs > lastPeriodMs * 1.5 && ! lastCallbackOverran)
+            lateCallbacks.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    lastCallbackOverran = periodMs > 0.0 && durationMs > periodMs;
+
+    if (lastCallbackOverran)
+        overruns.fetch_add (1, std::memory_order_relaxed);
+
+    lastStartTimeMs = startTimeMs;
+    lastPeriodMs = periodMs;
+
+    // A reader that sees any of the values written below will also see that the slot
+    // being overwritten is no longer valid - see getRecentCallbacks().
+    std::atomic_thread_fence (std::memory_order_release);
+
+    auto& slot = slots[(size_t) (index % numSlots)];
+    slot.startTimeMs.store (startTimeMs, std::memory_order_relaxed);
+    slot.durationMs.store (durationMs, std::memory_order_relaxed);
+    slot.numSamples.store (numSamples, std::memory_order_relaxed);
+
+    numCallbacks.store (index + 1, std::memory_order_release);
+}
+
+std::vector<AudioCallbackTimingMonitor::CallbackTiming> AudioCallbackTimingMonitor::getRecentCallbacks (int maxNumCallbacks) const
+{
+    const auto end = numCallbacks.load (std::memory_order_acquire);
+    const auto start = jmax ((int64) 0, end - jmin (maxNumCallbacks, numSlots));
+
+    std::vector<CallbackTiming> result;
+    result.reserve ((size_t) (end - start));
+
+    for (auto i = start; i < end; ++i)
+    {
+        auto& slot = slots[(size_t) (i % numSlots)];
+        result.push_back ({ slot.startTimeMs.load (std::memory_order_relaxed),
+                            slot.durationMs.load (std::memory_order_relaxed),
+                            slot.numSamples.load (std::memory_order_relaxed) });
+    }
+
+    std::atomic_thread_fence (std::memory_order_acquire);
+
+    // Any entries whose slots have been, or are being, overwritten by the audio thread
+    // while we were copying them are discarded.
+    const auto firstValid = numCallbacks.load (std::memory_order_relaxed) + 1 - numSlots;
+
+    if (firstValid > start)
+        result.erase (result.begin(), result.begin() + (std::ptrdiff_t) jmin (firstValid - start, end - start));
+
+    return result;
+}
+
+int64 AudioCallbackTimingMonitor::getNumCallbacks() const noexcept
+{
+    return numCallbacks.load (std::memory_order_relaxed);
+}
+
+std::array<uint32, AudioCallbackTimingMonitor::numJitterBins> AudioCallbackTimingMonitor::getJitterHistogram() const
+{
+    std::array<uint32, numJitterBins> result;
+
+    for (size_t i = 0; i < result.size(); ++i)
+        result[i] = jitterBins[i].load (std::memory_order_relaxed);
+
+    return result;
+}
+
+Range<double> AudioCallbackTimingMonitor::getJitterBinRange (int binIndex) noexcept
+{
+    const auto start = (binIndex - numJitterBins / 2) * jitterBinWidthMs;
+    return { start, start + jitterBinWidthMs };
+}
+
+AudioCallbackTimingMonitor::XRunCounts AudioCallbackTimingMonitor::getXRunCounts (int deviceReportedXRuns) const noexcept
+{
+    XRunCounts counts;
+    counts.overruns = overruns.load (std::memory_order_relaxed);
+    counts.lateCallbacks = lateCallbacks.load (std::memory_order_relaxed);
+    counts.deviceReported = deviceReportedXRuns;
+    return counts;
+}
+
+var AudioCallbackTimingMonitor::toVar (int maxNumCallbacks, int deviceReportedXRuns) const
+{
+    const auto xruns = getXRunCounts (deviceReportedXRuns);
+
+    DynamicObject::Ptr xrunObject (new DynamicObject());
+    xrunObject->setProperty ("overruns", xruns.overruns);
+    xrunObject->setProperty ("lateCallbacks", xruns.lateCallbacks);
+    xrunObject->setProperty ("deviceReported", xruns.deviceReported);
+    xrunObject->setProperty ("deviceSide", xruns.getNumDeviceSideXRuns());
+
+    Array<var> histogram;
+
+    for (auto count : getJitterHistogram())
+        histogram.add ((int64) count);
+
+    DynamicObject::Ptr jitterObject (new DynamicObject());
+    jitterObject->setProperty ("binWidthMs", jitterBinWidthMs);
+    jitterObject->setProperty ("firstBinStartMs", getJitterBinRange (0).getStart());
+    jitterObject->setProperty ("counts", histogram);
+
+    Array<var> callbackList;
+
+    for (auto& timing : getRecentCallbacks (maxNumCallbacks))
+        callbackList.add (Array<var> { timing.startTimeMs, timing.durationMs, timing.numSamples });
+
+    DynamicObject::Ptr result (new DynamicObject());
+    result->setProperty ("sampleRate", sampleRate.load (std::memory_order_relaxed));
+    result->setProperty ("numCallbacks", getNumCallbacks());
+    result->setProperty ("xruns", xrunObject.get());
+    result->setProperty ("jitter", jitterObject.get());
+    result->setProperty ("callbacks", callbackList);
+    return result.get();
+}
+
+} // namespace juce
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records the timing of every audio callback so that it can be inspected from
+    another thread while the device is running.
+
+    For each callback, the monitor stores the time at which it started, how long it
+    took and how many samples it processed, in a fixed-size history that can be
+    read by a monitoring thread without locking. It also keeps a histogram of the
+    jitter between consecutive callbacks, i.e. the difference between the measured
+    interval and the period implied by the previous block, and classifies xruns
+    according to their likely cause:
+
+    - an overrun is a callback that took longer than the duration of the audio
+      it was processing, meaning that the callback itself missed its deadline;
+    - a late callback is one that arrived more than 1.5 periods after the previous
+      one even though that previous callback finished in time, which points at the
+      driver, the device or the OS scheduler rather than the audio code.
+
+    The AudioDeviceManager owns one of these and feeds it from its device callback,
+    see AudioDeviceManager::getCallbackTimingMonitor().
+
+    All the recording methods are realtime-safe, and all the getters may be called
+    concurrently from any thread.
+
+    @see AudioProcessLoadMeasurer
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioCallbackTimingMonitor
+{
+public:
+    /** Creates a monitor that remembers the timing of the given number of most recent callbacks. */
+    explicit AudioCallbackTimingMonitor (int numCallbacksToRemember = 1024);
+
+    /** Destructor. */
+    ~AudioCallbackTimingMonitor();
+
+    //==============================================================================
+    /** Clears the history and all counters, in preparation for a device running at
+        the given sample rate.
+
+        This must not be called concurrently with registerCallback().
+    */
+    void reset (double sampleRate);
+
+    /** Records a callback that started at the given time (as returned by
+        Time::getMillisecondCounterHiRes()) and lasted for the given number of
+        milliseconds.
+
+        This is called from the audio thread, and is realtime-safe.
+    */
+    void registerCallback (double startTimeMs, double durationMs, int numSamples) noexcept;
+
+    //==============================================================================
+    /** The timing of a single callback. */
+    struct CallbackTiming
+    {
+        /** The time at which the callback started, as returned by Time::getMillisecondCounterHiRes(). */
+        double startTimeMs = 0;
+
+        /** The time spent inside the callback, in milliseconds. */
+        double durationMs = 0;
+
+        /** The number of samples the callback was asked to process. */
+        int numSamples = 0;
+    };
+
+    /** Returns the timing of the most recent callbacks, oldest first.
+
+        At most maxNumCallbacks entries are returned, and never more than the number
+        of callbacks the monitor was told to remember.
+    */
+    std::vector<CallbackTiming> getRecentCallbacks (int maxNumCallbacks) const;
+
+    /** Returns the number of callbacks registered since the last reset. */
+    int64 getNumCallbacks() const noexcept;
+
+    //==============================================================================
+    /** The number of bins in the jitter histogram. */
+    static constexpr int numJitterBins = 64;
+
+    /** The width of each bin in the jitter histogram, in milliseconds. */
+    static constexpr double jitterBinWidthMs = 0.25;
+
+    /** Returns the number of callbacks whose jitter fell into each bin of the histogram.
+
+        Bin i counts the callbacks whose interval from the previous callback differed from
+        the expected period by an amount within getJitterBinRange (i). Values outside the
+        histogram's range are counted in the first or last bin.
+    */
+    std::array<uint32, numJitterBins> getJitterHistogram() const;
+
+    /** Returns the range of jitter values, in milliseconds, counted by a bin of the histogram. */
+    static Range<double> getJitterBinRange (int binIndex) noexcept;
+
+    //==============================================================================
+    /** A breakdown of the xruns detected since the last reset. */
+    struct XRunCounts
+    {
+        /** The number of callbacks that took longer than the audio they processed. */
+        int overruns = 0;
+
+        /** The number of callbacks that arrived late even though the previous one finished in time. */
+        int lateCallbacks = 0;
+
+        /** The number of xruns reported by the device, or -1 if the device doesn't report them. */
+        int deviceReported = -1;
+
+        /** Returns the number of xruns that can't be blamed on the callback taking too long.
+
+            If the device reports its xruns, any that aren't explained by an overrun are
+            attributed to the device, otherwise this is the number of late callbacks.
+        */
+        int getNumDeviceSideXRuns() const noexcept
+        {
+            return jmax (lateCallbacks, deviceReported - overruns);
+        }
+    };
+
+    /** Returns the xruns detected since the last reset, combined with the number that the
+        device itself reported (as returned by AudioIODevice::getXRunCount()).
+    */
+    XRunCounts getXRunCounts (int deviceReportedXRuns = -1) const noexcept;
+
+    //==============================================================================
+    /** Returns a snapshot of the monitor's state in a form that can be written out
+        with JSON::toString().
+
+        The result contains the sample rate, the number of callbacks, the xrun counts,
+        the jitter histogram and the timing of up to maxNumCallbacks recent callbacks,
+        each one written as a [startTimeMs, durationMs, numSamples] array.
+    */
+    var toVar (int maxNumCallbacks = 256, int deviceReportedXRuns = -1) const;
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        std::atomic<double> startTimeMs { 0.0 }, durationMs { 0.0 };
+        std::atomic<int> numSamples { 0 };
+    };
+
+    const int numSlots;
+    std::unique_ptr<Slot[]> slots;
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int64> numCallbacks { 0 };
+    std::atomic<int> overruns { 0 }, lateCallbacks { 0 };
+    std::array<std::atomic<uint32>, numJitterBins> jitterBins;
+
+    // Only touched by the audio thread
+    double lastStartTimeMs = 0, lastPeriodMs = 0;
+    bool lastCallbackOverran = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioCallbackTimingMonitor)
+};
+
+} // namespace juce
@@ -1011,6 +1011,12 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float* const* inputChan
                                                    int numSamples,
                                                    const AudioIODeviceCallbackContext& context)
 {
+    JUCE_SCOPED_REALTIME_CONTEXT ("AudioDeviceManager audio callback")
+    JUCE_SCOPED_TRACE ("AudioDeviceManager audio callback")
+    JUCE_TRACE_HISTOGRAM_ADD ("Audio callback block size", numSamples)
+
+    const auto callbackStartTime = Time::getMillisecondCounterHiRes();
+
     const ScopedLock sl (audioCallbackLock);
 
     inputLevelGetter->updateLevel (inputChannelData, numInputChannels, numSamples);
@@ -1071,12 +1077,17 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float* const* inputChan
     }
 
     outputLevelGetter->updateLevel (outputChannelData, numOutputChannels, numSamples);
+
+    callbackTimingMonitor.registerCallback (callbackStartTime,
+                                            Time::getMillisecondCounterHiRes() - callbackStartTime,
+                                            numSamples);
 }
 
 void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device)
 {
     loadMeasurer.reset (device->getCurrentSampleRate(),
                         device->getCurrentBufferSizeSamples());
+    callbackTimingMonitor.reset (device->getCurrentSampleRate());
 
     updateCurrentSetup();
 
@@ -1316,6 +1327,12 @@ int AudioDeviceManager::getXRunCount() const noexcept
     return jmax (0, deviceXRuns) + loadMeasurer.getXRunCount();
 }
 
+var AudioDeviceManager::getCallbackTimingReport (int maxNumCallbacks) const
+{
+    auto deviceXRuns = (currentAudioDevice != nullptr ? currentAudioDevice->getXRunCount() : -1);
+    return callbackTimingMonitor.toVar (maxNumCallbacks, deviceXRuns);
+}
+
 //==============================================================================
 // Deprecated
 void AudioDeviceManager::setMidiInputEnabled (const String& name, const bool enabled)
@@ -485,6 +485,24 @@ public:
     */
     int getXRunCount() const noexcept;
 
+    /** Returns the object that records the timing of each audio callback.
+
+        The monitor is reset whenever a device starts, and keeps its contents after the
+        device stops so that they can still be inspected. Its getters can be called from
+        any thread while the device is running.
+
+        @see getCallbackTimingReport
+    */
+    const AudioCallbackTimingMonitor& getCallbackTimingMonitor() const noexcept  { return callbackTimingMonitor; }
+
+    /** Returns a snapshot of the callback timing monitor's state, including the number of
+        xruns reported by the current device, in a form that can be written out with
+        JSON::toString().
+
+        @see AudioCallbackTimingMonitor::toVar
+    */
+    var getCallbackTimingReport (int maxNumCallbacks = 256) const;
+
     //==============================================================================
    #ifndef DOXYGEN
     [[deprecated ("Use setMidiInputDeviceEnabled instead.")]]
@@ -537,6 +555,7 @@ private:
     int testSoundPosition = 0;
 
     AudioProcessLoadMeasurer loadMeasurer;
+    AudioCallbackTimingMonitor callbackTimingMonitor;
 
     LevelMeter::Ptr inputLevelGetter   { new LevelMeter() },
                     outputLevelGetter  { new LevelMeter() };
@@ -277,6 +277,7 @@ namespace juce
 }
 #endif
 
+#include "audio_io/juce_AudioCallbackTimingMonitor.cpp"
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
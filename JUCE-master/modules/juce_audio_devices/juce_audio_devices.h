@@ -120,6 +120,16 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_USE_MMAP
+    Makes ALSA devices convert audio directly into and out of the device's ring
+    buffer using mmap access, rather than going through snd_pcm_readi/writei.
+    This saves a copy per period, and can allow smaller buffer sizes to run
+    reliably. Devices that don't support mmap access still use read/write transfers.
+*/
+#ifndef JUCE_ALSA_USE_MMAP
+ #define JUCE_ALSA_USE_MMAP 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices.
 */
@@ -192,6 +202,7 @@ namespace juce
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
 #include "audio_io/juce_SystemAudioVolume.h"
+#include "audio_io/juce_AudioCallbackTimingMonitor.h"
 #include "sources/juce_AudioSourcePlayer.h"
 #include "sources/juce_AudioTransportSource.h"
 #include "audio_io/juce_AudioDeviceManager.h"
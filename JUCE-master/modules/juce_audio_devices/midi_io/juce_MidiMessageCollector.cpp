@@ -35,6 +35,88 @@
 namespace juce
 {
 
+//==============================================================================
+struct MidiMessageCollector::LockFreeQueue
+{
+    explicit LockFreeQueue (int numBytes)
+        : fifo (numBytes), storage ((size_t) numBytes), scratch ((size_t) numBytes)
+    {
+    }
+
+    void reset (double newSampleRate, double newStartTime) noexcept
+    {
+        fifo.read (fifo.getNumReady());
+        sampleRate = newSampleRate;
+        startTime = newStartTime;
+    }
+
+    // Called by the threads adding messages
+    void push (const MidiMessage& message) noexcept
+    {
+        const auto numBytes = message.getRawDataSize();
+        const auto totalSize = headerSize + numBytes;
+
+        uint8 header[headerSize];
+        writeUnaligned<double> (header, (message.getTimeStamp() - 0.001 * startTime) * sampleRate);
+        writeUnaligned<int32> (header + sizeof (double), numBytes);
+
+        const ScopedLock sl (producerLock);
+
+        if (fifo.getFreeSpace() < totalSize)
+            return;
+
+        const auto* messageData = message.getRawData();
+        int n = 0;
+
+        fifo.write (totalSize).forEach ([&] (int index)
+        {
+            storage[index] = n < headerSize ? header[n] : messageData[n - headerSize];
+            ++n;
+        });
+    }
+
+    // Called by the audio thread. Moves everything that's waiting in the queue into
+    // the buffer, with sample positions relative to the previous callback.
+    void pop (MidiBuffer& dest, double lastCallbackTime) noexcept
+    {
+        const auto reader = fifo.read (fifo.getNumReady());
+        const auto numBytes = reader.blockSize1 + reader.blockSize2;
+
+        if (numBytes == 0)
+            return;
+
+        memcpy (scratch, storage + reader.startIndex1, (size_t) reader.blockSize1);
+        memcpy (scratch + reader.blockSize1, storage + reader.startIndex2, (size_t) reader.blockSize2);
+
+        const auto currentRate = sampleRate.load();
+        const auto callbackPosition = 0.001 * (lastCallbackTime - startTime) * currentRate;
+
+        for (int offset = 0; offset < numBytes;)
+        {
+            const auto* header = scratch + offset;
+            const auto messageSize = readUnaligned<int32> (header + sizeof (double));
+            const auto sampleNumber = (int) (readUnaligned<double> (header) - callbackPosition);
+
+            dest.addEvent (header + headerSize, messageSize, sampleNumber);
+            offset += headerSize + messageSize;
+        }
+
+        // if the messages haven't been used for over a second, only keep the latest ones
+        const auto lastSampleNumber = dest.getLastEventTime();
+
+        if (lastSampleNumber > currentRate)
+            dest.clear (0, lastSampleNumber - (int) currentRate);
+    }
+
+    static constexpr int headerSize = (int) (sizeof (double) + sizeof (int32));
+
+    AbstractFifo fifo;
+    HeapBlock<uint8> storage, scratch;
+    CriticalSection producerLock;
+    std::atomic<double> sampleRate { 44100.0 }, startTime { 0.0 };
+};
+
+//==============================================================================
 MidiMessageCollector::MidiMessageCollector()
 {
 }
@@ -56,12 +138,35 @@ void MidiMessageCollector::reset (const double newSampleRate)
     sampleRate = newSampleRate;
     incomingMessages.clear();
     lastCallbackTime = Time::getMillisecondCounterHiRes();
+
+    if (lockFreeQueue != nullptr)
+        lockFreeQueue->reset (sampleRate, lastCallbackTime);
 }
 
-void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
+void MidiMessageCollector::setLockFreeQueueSize (int numBytes)
 {
+    jassert (numBytes >= 0);
+
     const ScopedLock sl (midiCallbackLock);
 
+    if (numBytes > 0)
+    {
+        lockFreeQueue = std::make_unique<LockFreeQueue> (numBytes);
+        incomingMessages.setFixedCapacity ((size_t) numBytes);
+    }
+    else
+    {
+        lockFreeQueue.reset();
+        incomingMessages.setFixedCapacity (0);
+    }
+
+   #if JUCE_DEBUG
+    hasCalledReset = false;
+   #endif
+}
+
+void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
+{
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
@@ -70,6 +175,14 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
     // for details of what the number should be.
     jassert (! approximatelyEqual (message.getTimeStamp(), 0.0));
 
+    if (lockFreeQueue != nullptr)
+    {
+        lockFreeQueue->push (message);
+        return;
+    }
+
+    const ScopedLock sl (midiCallbackLock);
+
     auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
 
     incomingMessages.addEvent (message, sampleNumber);
@@ -83,17 +196,27 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
 void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
                                                       const int numSamples)
 {
-    const ScopedLock sl (midiCallbackLock);
-
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
 
     jassert (numSamples > 0);
 
-    auto timeNow = Time::getMillisecondCounterHiRes();
-    auto msElapsed = timeNow - lastCallbackTime;
+    if (lockFreeQueue != nullptr)
+    {
+        const auto timeNow = Time::getMillisecondCounterHiRes();
+        lockFreeQueue->pop (incomingMessages, lastCallbackTime);
+        addEventsToBuffer (destBuffer, numSamples, timeNow);
+        return;
+    }
 
+    const ScopedLock sl (midiCallbackLock);
+    addEventsToBuffer (destBuffer, numSamples, Time::getMillisecondCounterHiRes());
+}
+
+void MidiMessageCollector::addEventsToBuffer (MidiBuffer& destBuffer, int numSamples, double timeNow)
+{
+    auto msElapsed = timeNow - lastCallbackTime;
     lastCallbackTime = timeNow;
 
     if (! incomingMessages.isEmpty())
@@ -73,6 +73,10 @@ public:
 
         This method is fully thread-safe when overlapping calls are made with
         removeNextBlockOfMessages().
+
+        When a lock-free queue is in use, the message is dropped if the queue is full.
+
+        @see setLockFreeQueueSize
     */
     void addMessageToQueue (const MidiMessage& message);
 
@@ -100,6 +104,27 @@ public:
     */
     void ensureStorageAllocated (size_t bytes);
 
+    /** Makes the collector pass messages to the audio thread through a lock-free queue.
+
+        By default, addMessageToQueue() and removeNextBlockOfMessages() share a lock,
+        so a busy MIDI thread can hold up the audio callback. Once a lock-free queue has
+        been set, removeNextBlockOfMessages() never waits and never allocates. Its work
+        is bounded by the queue size. The message timestamps are converted to sample
+        positions before they go into the queue, so that work happens on the thread
+        that adds the message.
+
+        If several threads add messages, they still share a lock with each other, but
+        the audio thread never takes it.
+
+        Each queued message uses 12 bytes plus the size of its data. Messages that
+        arrive while the queue is full are dropped. Passing 0 goes back to the default
+        locking behaviour.
+
+        This must be called before the collector is used, while no other thread is
+        adding or removing messages. You also need to call reset() again afterwards.
+    */
+    void setLockFreeQueueSize (int numBytes);
+
 
     //==============================================================================
     /** @internal */
@@ -111,6 +136,11 @@ public:
 
 private:
     //==============================================================================
+    struct LockFreeQueue;
+
+    void addEventsToBuffer (MidiBuffer& destBuffer, int numSamples, double timeNow);
+
+    std::unique_ptr<LockFreeQueue> lockFreeQueue;
     double lastCallbackTime = 0;
     CriticalSection midiCallbackLock;
     MidiBuffer incomingMessages;
@@ -220,14 +220,32 @@ public:
             return false;
         }
 
-        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
+        isMmap = false;
+
+       #if JUCE_ALSA_USE_MMAP
+        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+        {
+            isMmap = true;
             isInterleaved = true;
-        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
+        }
+        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_NONINTERLEAVED) >= 0)
+        {
+            isMmap = true;
             isInterleaved = false;
-        else
+        }
+       #endif
+
+        if (! isMmap)
         {
-            jassertfalse;
-            return false;
+            if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
+                isInterleaved = true;
+            else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
+                isInterleaved = false;
+            else
+            {
+                jassertfalse;
+                return false;
+            }
         }
 
         enum { isFloatBit = 1 << 16, isLittleEndianBit = 1 << 17, onlyUseLower24Bits = 1 << 18 };
@@ -249,6 +267,7 @@ public:
             {
                 const int type = formatsToTry [i + 1];
                 bitDepth = type & 255;
+                format = (snd_pcm_format_t) formatsToTry [i];
 
                 converter.reset (createConverter (isInput, bitDepth,
                                                   (type & isFloatBit) != 0,
@@ -289,7 +308,7 @@ public:
             latency = (int) frames * ((int) periods - 1); // (this is the method JACK uses to guess the latency..)
 
         JUCE_ALSA_LOG ("frames: " << (int) frames << ", periods: " << (int) periods
-                          << ", samplesPerPeriod: " << (int) samplesPerPeriod);
+                          << ", samplesPerPeriod: " << (int) samplesPerPeriod << ", mmap: " << (int) isMmap);
 
         snd_pcm_sw_params_t* swParams;
         snd_pcm_sw_params_alloca (&swParams);
@@ -300,6 +319,7 @@ public:
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_silence_threshold (handle, swParams, 0))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_silence_size (handle, swParams, boundary))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_start_threshold (handle, swParams, samplesPerPeriod))
+            || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_avail_min (handle, swParams, samplesPerPeriod))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_stop_threshold (handle, swParams, boundary))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params (handle, swParams)))
         {
@@ -326,7 +346,20 @@ public:
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
-        if (isInterleaved)
+        if (isMmap)
+        {
+            numDone = transferMmap (numSamples, [&] (const snd_pcm_channel_area_t* areas, snd_pcm_uframes_t offset, int start, int num)
+            {
+                for (int i = 0; i < numChannelsRunning; ++i)
+                {
+                    if (isInterleaved)
+                        converter->convertSamples (getAreaAddress (areas[0], offset), i, data[i] + start, 0, num);
+                    else
+                        converter->convertSamples (getAreaAddress (areas[i], offset), data[i] + start, num);
+                }
+            });
+        }
+        else if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
 
@@ -363,7 +396,32 @@ public:
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
-        if (isInterleaved)
+        if (isMmap)
+        {
+            auto num = transferMmap (numSamples, [&] (const snd_pcm_channel_area_t* areas, snd_pcm_uframes_t offset, int start, int numToRead)
+            {
+                for (int i = 0; i < numChannelsRunning; ++i)
+                {
+                    if (isInterleaved)
+                        converter->convertSamples (data[i] + start, 0, getAreaAddress (areas[0], offset), i, numToRead);
+                    else
+                        converter->convertSamples (data[i] + start, getAreaAddress (areas[i], offset), numToRead);
+                }
+            });
+
+            if (num < 0)
+            {
+                if (num == -(EPIPE))
+                    overrunCount++;
+
+                if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) num, 1 /* silent */)))
+                    return false;
+            }
+
+            if (num < numSamples)
+                JUCE_ALSA_LOG ("Did not read all samples: num: " << num << ", numSamples: " << numSamples);
+        }
+        else if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
             scratch.fillWith (0); // (not clearing this data causes warnings in valgrind)
@@ -409,6 +467,45 @@ public:
         return true;
     }
 
+    /** Writes some silence to an output device, which is used to fill its buffer before it starts. */
+    bool writeSilence (int numSamples)
+    {
+        jassert (! isInput);
+        snd_pcm_sframes_t numDone = 0;
+
+        if (isMmap)
+        {
+            numDone = transferMmap (numSamples, [&] (const snd_pcm_channel_area_t* areas, snd_pcm_uframes_t offset, int, int num)
+            {
+                snd_pcm_areas_silence (areas, offset, (unsigned int) numChannelsRunning, (snd_pcm_uframes_t) num, format);
+            });
+        }
+        else
+        {
+            // All the formats we use are signed or floating point, so silence is all zeros
+            scratch.ensureSize ((size_t) snd_pcm_frames_to_bytes (handle, numSamples), false);
+            scratch.fillWith (0);
+
+            if (isInterleaved)
+            {
+                numDone = snd_pcm_writei (handle, scratch.getData(), (snd_pcm_uframes_t) numSamples);
+            }
+            else
+            {
+                std::vector<void*> channels ((size_t) numChannelsRunning, scratch.getData());
+                numDone = snd_pcm_writen (handle, channels.data(), (snd_pcm_uframes_t) numSamples);
+            }
+        }
+
+        if (numDone < 0)
+        {
+            JUCE_ALSA_FAILED ((int) numDone);
+            return false;
+        }
+
+        return true;
+    }
+
     //==============================================================================
     snd_pcm_t* handle;
     String error;
@@ -419,10 +516,74 @@ private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMmap = false;
+    snd_pcm_format_t format = SND_PCM_FORMAT_UNKNOWN;
     MemoryBlock scratch;
     std::unique_ptr<AudioData::Converter> converter;
 
+    //==============================================================================
+    static void* getAreaAddress (const snd_pcm_channel_area_t& area, snd_pcm_uframes_t offset) noexcept
+    {
+        return static_cast<char*> (area.addr) + (area.first + offset * area.step) / 8;
+    }
+
+    // Transfers numSamples frames directly to or from the device's ring buffer. The transfer
+    // function is called with each contiguous region of the ring, as returned by snd_pcm_mmap_begin,
+    // along with the index of its first frame within the block.
+    template <typename TransferFunction>
+    snd_pcm_sframes_t transferMmap (int numSamples, TransferFunction&& transfer)
+    {
+        int numDone = 0;
+
+        while (numDone < numSamples)
+        {
+            const auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+                return avail;
+
+            if (avail == 0)
+            {
+                if (isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED)
+                {
+                    if (const auto err = snd_pcm_start (handle); err < 0)
+                        return err;
+                }
+
+                const auto err = snd_pcm_wait (handle, 1000);
+
+                if (err < 0)
+                    return err;
+
+                if (err == 0)
+                    break;
+
+                continue;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto frames = (snd_pcm_uframes_t) (numSamples - numDone);
+
+            if (const auto err = snd_pcm_mmap_begin (handle, &areas, &offset, &frames); err < 0)
+                return err;
+
+            transfer (areas, offset, numDone, (int) frames);
+
+            const auto committed = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (committed < 0)
+                return committed;
+
+            if ((snd_pcm_uframes_t) committed != frames)
+                return -EPIPE;
+
+            numDone += (int) frames;
+        }
+
+        return numDone;
+    }
+
     //==============================================================================
     template <class SampleType>
     struct ConverterHelper
@@ -621,8 +782,13 @@ public:
             return;
         }
 
+        // Linking the streams means that they're started and stopped together, so that
+        // their periods stay in step and one poll() can wait for both of them
         if (outputDevice != nullptr && inputDevice != nullptr)
-            snd_pcm_link (outputDevice->handle, inputDevice->handle);
+        {
+            [[maybe_unused]] const auto linkResult = snd_pcm_link (outputDevice->handle, inputDevice->handle);
+            JUCE_ALSA_LOG ("snd_pcm_link: " << linkResult);
+        }
 
         if (inputDevice != nullptr && JUCE_ALSA_FAILED (snd_pcm_prepare (inputDevice->handle)))
             return;
@@ -630,6 +796,9 @@ public:
         if (outputDevice != nullptr && JUCE_ALSA_FAILED (snd_pcm_prepare (outputDevice->handle)))
             return;
 
+        if (! createPollDescriptors())
+            return;
+
         startThread (Priority::high);
 
         int count = 1000;
@@ -671,6 +840,7 @@ public:
 
         inputDevice.reset();
         outputDevice.reset();
+        pollDescriptors.clear();
 
         inputChannelBuffer.setSize (1, 1);
         outputChannelBuffer.setSize (1, 1);
@@ -686,23 +856,23 @@ public:
 
     void run() override
     {
-        while (! threadShouldExit())
+        if (! startStreams())
         {
-            if (inputDevice != nullptr && inputDevice->handle != nullptr)
-            {
-                if (outputDevice == nullptr || outputDevice->handle == nullptr)
-                {
-                    JUCE_ALSA_FAILED (snd_pcm_wait (inputDevice->handle, 2000));
+            JUCE_ALSA_LOG ("Failed to start streams");
+            return;
+        }
 
-                    if (threadShouldExit())
-                        break;
+        while (! threadShouldExit())
+        {
+            waitForDevices (2000);
 
-                    auto avail = snd_pcm_avail_update (inputDevice->handle);
+            if (threadShouldExit())
+                break;
 
-                    if (avail < 0)
-                        JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, (int) avail, 0));
-                }
+            const auto xrunsBefore = getXRunCount();
 
+            if (inputDevice != nullptr && inputDevice->handle != nullptr)
+            {
                 audioIoInProgress = true;
 
                 if (! inputDevice->readFromInputDevice (inputChannelBuffer, bufferSize))
@@ -739,16 +909,6 @@ public:
 
             if (outputDevice != nullptr && outputDevice->handle != nullptr)
             {
-                JUCE_ALSA_FAILED (snd_pcm_wait (outputDevice->handle, 2000));
-
-                if (threadShouldExit())
-                    break;
-
-                auto avail = snd_pcm_avail_update (outputDevice->handle);
-
-                if (avail < 0)
-                    JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, (int) avail, 0));
-
                 audioIoInProgress = true;
 
                 if (! outputDevice->writeToOutputDevice (outputChannelBuffer, bufferSize))
@@ -759,6 +919,14 @@ public:
 
                 audioIoInProgress = false;
             }
+
+            // After an xrun, the devices have been re-prepared, so they need restarting
+            // together, with the output buffer refilled.
+            if (getXRunCount() != xrunsBefore && ! startStreams())
+            {
+                JUCE_ALSA_LOG ("Failed to restart streams after xrun");
+                break;
+            }
         }
 
         audioIoInProgress = false;
@@ -814,6 +982,9 @@ private:
     unsigned int minChansOut = 0, maxChansOut = 0;
     unsigned int minChansIn = 0, maxChansIn = 0;
 
+    std::vector<pollfd> pollDescriptors;
+    int numInputPollDescriptors = 0;
+
     bool failed (const int errorNum)
     {
         if (errorNum >= 0)
@@ -824,6 +995,115 @@ private:
         return true;
     }
 
+    //==============================================================================
+    bool createPollDescriptors()
+    {
+        pollDescriptors.clear();
+        numInputPollDescriptors = 0;
+
+        for (auto* device : { inputDevice.get(), outputDevice.get() })
+        {
+            if (device == nullptr)
+                continue;
+
+            const auto count = snd_pcm_poll_descriptors_count (device->handle);
+
+            if (JUCE_ALSA_FAILED (count))
+                return false;
+
+            const auto start = pollDescriptors.size();
+            pollDescriptors.resize (start + (size_t) count);
+
+            if (JUCE_ALSA_FAILED (snd_pcm_poll_descriptors (device->handle, pollDescriptors.data() + start, (unsigned int) count)))
+                return false;
+
+            if (device == inputDevice.get())
+                numInputPollDescriptors = count;
+        }
+
+        return true;
+    }
+
+    // Fills the output buffer with silence, apart from one period, and starts the streams.
+    // A linked output is started along with the input, otherwise it starts automatically
+    // once its start threshold has been written.
+    bool startStreams()
+    {
+        if (inputDevice != nullptr && inputDevice->handle != nullptr
+             && snd_pcm_state (inputDevice->handle) != SND_PCM_STATE_PREPARED
+             && JUCE_ALSA_FAILED (snd_pcm_prepare (inputDevice->handle)))
+            return false;
+
+        if (outputDevice != nullptr && outputDevice->handle != nullptr)
+        {
+            if (snd_pcm_state (outputDevice->handle) != SND_PCM_STATE_PREPARED
+                 && JUCE_ALSA_FAILED (snd_pcm_prepare (outputDevice->handle)))
+                return false;
+
+            if (outputDevice->latency > 0 && ! outputDevice->writeSilence (outputDevice->latency))
+                return false;
+        }
+
+        if (inputDevice != nullptr && inputDevice->handle != nullptr
+             && snd_pcm_state (inputDevice->handle) == SND_PCM_STATE_PREPARED)
+            return ! JUCE_ALSA_FAILED (snd_pcm_start (inputDevice->handle));
+
+        return true;
+    }
+
+    // Waits in a single poll() until the input has a period to read and the output has space
+    // for a period, so that the thread wakes once per period rather than once per device.
+    void waitForDevices (int timeoutMs)
+    {
+        const auto numDescriptors = (int) pollDescriptors.size();
+        const auto numOutputPollDescriptors = numDescriptors - numInputPollDescriptors;
+
+        bool inputReady  = inputDevice == nullptr  || inputDevice->handle == nullptr;
+        bool outputReady = outputDevice == nullptr || outputDevice->handle == nullptr;
+
+        while (! (inputReady && outputReady))
+        {
+            // Only poll the descriptors of a device that isn't ready yet, otherwise poll()
+            // would keep returning immediately for the one that is
+            auto* first = pollDescriptors.data() + (inputReady ? numInputPollDescriptors : 0);
+            const auto count = inputReady ? numOutputPollDescriptors
+                                          : (outputReady ? numInputPollDescriptors : numDescriptors);
+
+            const auto result = poll (first, (nfds_t) count, timeoutMs);
+
+            if (threadShouldExit())
+                return;
+
+            if (result < 0 && errno == EINTR)
+                continue;
+
+            // On a timeout or error, carry on and let the read or write report the problem
+            if (result <= 0)
+            {
+                JUCE_ALSA_LOG ("poll timed out or failed: " << result);
+                return;
+            }
+
+            if (! inputReady)
+                inputReady = isDeviceReady (*inputDevice, pollDescriptors.data(), numInputPollDescriptors, POLLIN);
+
+            if (! outputReady)
+                outputReady = isDeviceReady (*outputDevice, pollDescriptors.data() + numInputPollDescriptors,
+                                             numOutputPollDescriptors, POLLOUT);
+        }
+    }
+
+    static bool isDeviceReady (ALSADevice& device, pollfd* descriptors, int numDescriptors, unsigned short eventWanted)
+    {
+        unsigned short revents = 0;
+
+        if (snd_pcm_poll_descriptors_revents (device.handle, descriptors, (unsigned int) numDescriptors, &revents) < 0)
+            return true;
+
+        // An error event means an xrun, which the subsequent read or write will recover from
+        return (revents & (eventWanted | POLLERR)) != 0;
+    }
+
     void initialiseRatesAndChannels()
     {
         sampleRates.clear();
@@ -427,6 +427,9 @@ private:
 
             using Frames = decltype (context.audioFrames);
 
+            // Bela's buffers are already non-interleaved floats, so the callback is given
+            // pointers straight into them, without any copying or conversion.
+
             // Setup channelInBuffers
             for (int ch = 0; ch < actualNumberOfInputs; ++ch)
             {
@@ -442,7 +445,7 @@ private:
                 if (ch < analogChannelStart)
                     channelOutBuffer[ch] = &context.audioOut[(Frames) ch * context.audioFrames];
                 else
-                    channelOutBuffer[ch] = &context.analogOut[(Frames) (ch - analogChannelStart) * context.audioFrames];
+                    channelOutBuffer[ch] = &context.analogOut[(Frames) (ch - analogChannelStart) * context.analogFrames];
             }
 
             callback->audioDeviceIOCallbackWithContext (channelInBuffer.getData(),
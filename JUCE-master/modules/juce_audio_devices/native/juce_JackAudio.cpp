@@ -453,6 +453,9 @@ private:
     //==============================================================================
     void process (const int numSamples)
     {
+        // JACK's port buffers are non-interleaved floats, so the callback is given them
+        // directly, without any copying or conversion. They can move between cycles, so
+        // they have to be fetched each time.
         int numActiveInChans = 0, numActiveOutChans = 0;
 
         for (int i = 0; i < totalNumberOfInputChannels; ++i)
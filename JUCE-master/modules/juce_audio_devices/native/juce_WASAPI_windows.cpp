@@ -89,6 +89,7 @@ static void logFailure ([[maybe_unused]] HRESULT hr)
             JUCE_WASAPI_ERR (AUDCLNT_E_BUFFER_ERROR, 0x018)
             JUCE_WASAPI_ERR (AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED, 0x019)
             JUCE_WASAPI_ERR (AUDCLNT_E_INVALID_DEVICE_PERIOD, 0x020)
+            JUCE_WASAPI_ERR (AUDCLNT_E_ENGINE_PERIODICITY_LOCKED, 0x028)
             default: break;
         }
 
@@ -411,6 +412,21 @@ static bool supportsSampleRateConversion (WASAPIDeviceMode deviceMode) noexcept
     return deviceMode == WASAPIDeviceMode::shared;
 }
 
+// IAudioClient3 only accepts periods that are the minimum period plus a whole number of
+// fundamental periods, up to the maximum, so this rounds a buffer size up to the nearest one.
+static int getNearestLowLatencyPeriod (int bufferSizeSamples, int minPeriod, int maxPeriod, int fundamentalPeriod) noexcept
+{
+    if (minPeriod <= 0 || fundamentalPeriod <= 0)
+        return bufferSizeSamples;
+
+    maxPeriod = jmax (minPeriod, maxPeriod);
+
+    const auto clamped = jlimit (minPeriod, maxPeriod, bufferSizeSamples);
+    const auto numFundamentals = (clamped - minPeriod + fundamentalPeriod - 1) / fundamentalPeriod;
+
+    return jmin (maxPeriod, minPeriod + numFundamentals * fundamentalPeriod);
+}
+
 //==============================================================================
 class WASAPIDeviceBase
 {
@@ -668,19 +684,20 @@ private:
                     defaultBufferSize = (int) defaultPeriod;
                     lowLatencyMaxBufferSize = (int) maxPeriod;
                     lowLatencyBufferSizeMultiple = (int) fundamentalPeriod;
+                    return;
                 }
             }
+
+            // Without IAudioClient3 (i.e. before Windows 10), the device behaves like a normal shared one
         }
-        else
-        {
-            REFERENCE_TIME defaultPeriod, minPeriod;
 
-            if (! check (audioClient->GetDevicePeriod (&defaultPeriod, &minPeriod)))
-                return;
+        REFERENCE_TIME defaultPeriod, minPeriod;
 
-            minBufferSize = refTimeToSamples (minPeriod, defaultSampleRate);
-            defaultBufferSize = refTimeToSamples (defaultPeriod, defaultSampleRate);
-        }
+        if (! check (audioClient->GetDevicePeriod (&defaultPeriod, &minPeriod)))
+            return;
+
+        minBufferSize = refTimeToSamples (minPeriod, defaultSampleRate);
+        defaultBufferSize = refTimeToSamples (defaultPeriod, defaultSampleRate);
     }
 
     void querySupportedSampleRates (WAVEFORMATEXTENSIBLE format, ComSmartPtr<IAudioClient>& audioClient)
@@ -842,13 +859,38 @@ private:
 
     bool initialiseLowLatencyClient (int bufferSizeSamples, WAVEFORMATEXTENSIBLE format)
     {
-        if (auto audioClient3 = client.getInterface<IAudioClient3>())
-            return check (audioClient3->InitializeSharedAudioStream (getStreamFlags(),
-                                                                     (UINT32) bufferSizeSamples,
-                                                                     (WAVEFORMATEX*) &format,
-                                                                     nullptr));
+        auto audioClient3 = client.getInterface<IAudioClient3>();
 
-        return false;
+        if (audioClient3 == nullptr || lowLatencyBufferSizeMultiple <= 0)
+            return initialiseStandardClient (bufferSizeSamples, format);
+
+        const auto period = getNearestLowLatencyPeriod (bufferSizeSamples, minBufferSize,
+                                                        lowLatencyMaxBufferSize, lowLatencyBufferSizeMultiple);
+
+        auto hr = audioClient3->InitializeSharedAudioStream (getStreamFlags(), (UINT32) period, (WAVEFORMATEX*) &format, nullptr);
+
+        if (hr == MAKE_HRESULT (1, 0x889, 0x28)) // AUDCLNT_E_ENGINE_PERIODICITY_LOCKED
+        {
+            // Another stream has already fixed the engine's period, so the only one we can use is that one
+            WAVEFORMATEX* currentFormat = nullptr;
+            UINT32 currentPeriod = 0;
+
+            if (! check (audioClient3->GetCurrentSharedModeEnginePeriod (&currentFormat, &currentPeriod)))
+                return false;
+
+            CoTaskMemFree (currentFormat);
+
+            client = nullptr;
+            client = createClient();
+            audioClient3 = client != nullptr ? client.getInterface<IAudioClient3>() : nullptr;
+
+            if (audioClient3 == nullptr)
+                return false;
+
+            hr = audioClient3->InitializeSharedAudioStream (getStreamFlags(), currentPeriod, (WAVEFORMATEX*) &format, nullptr);
+        }
+
+        return check (hr);
     }
 
     bool initialiseStandardClient (int bufferSizeSamples, WAVEFORMATEXTENSIBLE format)
@@ -1367,6 +1409,14 @@ public:
         }
 
         currentBufferSizeSamples  = bufferSizeSamples <= 0 ? defaultBufferSize : jmax (bufferSizeSamples, minBufferSize);
+
+        if (isLowLatencyMode (deviceMode))
+        {
+            currentBufferSizeSamples = getNearestLowLatencyPeriod (currentBufferSizeSamples, minBufferSize,
+                                                                   lowLatencyMaxBufferSize, lowLatencyBufferSizeMultiple);
+            bufferSizeSamples = currentBufferSizeSamples;
+        }
+
         currentSampleRate         = sampleRate > 0 ? sampleRate : defaultSampleRate;
         lastKnownInputChannels    = inputChannels;
         lastKnownOutputChannels   = outputChannels;
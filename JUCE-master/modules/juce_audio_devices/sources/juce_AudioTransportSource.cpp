@@ -35,14 +35,100 @@
 namespace juce
 {
 
+struct AudioTransportSource::SourceChain
+{
+    PositionableAudioSource* source = nullptr;
+    std::unique_ptr<BufferingAudioSource> bufferingSource;
+    std::unique_ptr<ResamplingAudioSource> resamplerSource;
+    PositionableAudioSource* positionableSource = nullptr;
+    AudioSource* masterSource = nullptr;
+    double sourceSampleRate = 0;
+    int readAheadBufferSize = 0;
+};
+
+//==============================================================================
 AudioTransportSource::AudioTransportSource()
 {
 }
 
 AudioTransportSource::~AudioTransportSource()
 {
+    cancelPendingUpdate();
     setSource (nullptr);
     releaseMasterResources();
+
+    releaseSourceChain (std::move (cuedChain));
+    releaseSourceChain (std::move (retiredChain));
+}
+
+std::unique_ptr<AudioTransportSource::SourceChain> AudioTransportSource::createSourceChain (PositionableAudioSource* newSource,
+                                                                                           int readAheadSize,
+                                                                                           TimeSliceThread* readAheadThread,
+                                                                                           double sourceSampleRateToCorrectFor,
+                                                                                           int maxNumChannels)
+{
+    auto chain = std::make_unique<SourceChain>();
+    chain->source = newSource;
+    chain->readAheadBufferSize = readAheadSize;
+    chain->sourceSampleRate = sourceSampleRateToCorrectFor;
+
+    if (newSource == nullptr)
+        return chain;
+
+    chain->positionableSource = newSource;
+
+    if (readAheadSize > 0)
+    {
+        // If you want to use a read-ahead buffer, you must also provide a TimeSliceThread
+        // for it to use!
+        jassert (readAheadThread != nullptr);
+
+        chain->bufferingSource = std::make_unique<BufferingAudioSource> (newSource, *readAheadThread,
+                                                                         false, readAheadSize, maxNumChannels);
+        chain->positionableSource = chain->bufferingSource.get();
+    }
+
+    chain->positionableSource->setNextReadPosition (0);
+
+    if (sourceSampleRateToCorrectFor > 0)
+    {
+        chain->resamplerSource = std::make_unique<ResamplingAudioSource> (chain->positionableSource, false, maxNumChannels);
+        chain->masterSource = chain->resamplerSource.get();
+    }
+    else
+    {
+        chain->masterSource = chain->positionableSource;
+    }
+
+    if (isPrepared)
+    {
+        if (chain->resamplerSource != nullptr && sourceSampleRateToCorrectFor > 0 && sampleRate > 0)
+            chain->resamplerSource->setResamplingRatio (sourceSampleRateToCorrectFor / sampleRate);
+
+        chain->masterSource->prepareToPlay (blockSize, sampleRate);
+    }
+
+    return chain;
+}
+
+void AudioTransportSource::exchangeCurrentChain (SourceChain& chain) noexcept
+{
+    auto* newResamplerSource = chain.resamplerSource.release();
+    auto* newBufferingSource = chain.bufferingSource.release();
+    chain.resamplerSource.reset (std::exchange (resamplerSource, newResamplerSource));
+    chain.bufferingSource.reset (std::exchange (bufferingSource, newBufferingSource));
+
+    std::swap (source, chain.source);
+    std::swap (positionableSource, chain.positionableSource);
+    std::swap (masterSource, chain.masterSource);
+    std::swap (sourceSampleRate, chain.sourceSampleRate);
+    std::swap (readAheadBufferSize, chain.readAheadBufferSize);
+}
+
+void AudioTransportSource::releaseSourceChain (std::unique_ptr<SourceChain> chain)
+{
+    if (chain != nullptr && chain->masterSource != nullptr)
+        chain->masterSource->releaseResources();
 }
 
 void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
@@ -57,63 +143,179 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
         setSource (nullptr, 0, nullptr); // deselect and reselect to avoid releasing resources wrongly
     }
 
-    ResamplingAudioSource* newResamplerSource = nullptr;
-    BufferingAudioSource* newBufferingSource = nullptr;
-    PositionableAudioSource* newPositionableSource = nullptr;
-    AudioSource* newMasterSource = nullptr;
+    auto chain = createSourceChain (newSource, readAheadSize, readAheadThread,
+                                    sourceSampleRateToCorrectFor, maxNumChannels);
+    std::unique_ptr<SourceChain> oldCuedChain, oldRetiredChain;
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        exchangeCurrentChain (*chain);
+        std::swap (oldCuedChain, cuedChain);
+        std::swap (oldRetiredChain, retiredChain);
 
-    std::unique_ptr<ResamplingAudioSource> oldResamplerSource (resamplerSource);
-    std::unique_ptr<BufferingAudioSource> oldBufferingSource (bufferingSource);
-    AudioSource* oldMasterSource = masterSource;
+        playing = false;
+    }
+
+    // the chain now holds the old source, which is released here, outside the lock
+    releaseSourceChain (std::move (chain));
+    releaseSourceChain (std::move (oldCuedChain));
+    releaseSourceChain (std::move (oldRetiredChain));
+}
+
+//==============================================================================
+bool AudioTransportSource::cueNextSource (PositionableAudioSource* nextSource, int64 switchPosition,
+                                          int crossfadeLength, int readAheadSize, TimeSliceThread* readAheadThread,
+                                          double sourceSampleRateToCorrectFor, int maxNumChannels)
+{
+    jassert (crossfadeLength >= 0);
+
+    std::unique_ptr<SourceChain> newChain;
+
+    if (nextSource != nullptr)
+        newChain = createSourceChain (nextSource, readAheadSize, readAheadThread,
+                                      sourceSampleRateToCorrectFor, maxNumChannels);
+
+    AudioBuffer<float> newCueBuffer (jmax (1, maxNumChannels), jmax (blockSize, 512));
+    std::unique_ptr<SourceChain> oldCuedChain, oldRetiredChain;
+    bool wasCued = false;
 
-    if (newSource != nullptr)
     {
-        newPositionableSource = newSource;
+        const ScopedLock sl (callbackLock);
 
-        if (readAheadSize > 0)
+        // A switch that's already under way has to be allowed to finish
+        if (cueSamplesPlayed < 0)
         {
-            // If you want to use a read-ahead buffer, you must also provide a TimeSliceThread
-            // for it to use!
-            jassert (readAheadThread != nullptr);
-
-            newPositionableSource = newBufferingSource
-                = new BufferingAudioSource (newPositionableSource, *readAheadThread,
-                                            false, readAheadSize, maxNumChannels);
+            std::swap (oldCuedChain, cuedChain);
+            std::swap (cuedChain, newChain);
+            std::swap (cueBuffer, newCueBuffer);
+            cueSwitchPosition = switchPosition;
+            cueCrossfadeLength = crossfadeLength;
+            wasCued = true;
         }
 
-        newPositionableSource->setNextReadPosition (0);
+        std::swap (oldRetiredChain, retiredChain);
+    }
+
+    releaseSourceChain (std::move (newChain));
+    releaseSourceChain (std::move (oldCuedChain));
+    releaseSourceChain (std::move (oldRetiredChain));
+    return wasCued;
+}
+
+bool AudioTransportSource::cancelCue()
+{
+    std::unique_ptr<SourceChain> oldCuedChain;
 
-        if (sourceSampleRateToCorrectFor > 0)
-            newMasterSource = newResamplerSource
-                = new ResamplingAudioSource (newPositionableSource, false, maxNumChannels);
-        else
-            newMasterSource = newPositionableSource;
+    {
+        const ScopedLock sl (callbackLock);
 
-        if (isPrepared)
+        if (cueSamplesPlayed >= 0)
+            return false;
+
+        std::swap (oldCuedChain, cuedChain);
+    }
+
+    const auto wasCued = oldCuedChain != nullptr;
+    releaseSourceChain (std::move (oldCuedChain));
+    return wasCued;
+}
+
+bool AudioTransportSource::isSourceCued() const
+{
+    const ScopedLock sl (callbackLock);
+    return cuedChain != nullptr;
+}
+
+bool AudioTransportSource::waitForCuedSourceReady (int numSamples, int timeoutMilliseconds)
+{
+    BufferingAudioSource* cuedBufferingSource = nullptr;
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        if (cuedChain == nullptr)
+            return false;
+
+        cuedBufferingSource = cuedChain->bufferingSource.get();
+    }
+
+    // The audio thread may switch to the cued source while this is waiting, but only the
+    // thread that calls cueNextSource() will delete it
+    return cuedBufferingSource == nullptr
+            || cuedBufferingSource->waitForNextAudioBlockReady (AudioSourceChannelInfo (nullptr, 0, numSamples),
+                                                                (uint32) jmax (0, timeoutMilliseconds));
+}
+
+void AudioTransportSource::mixInCuedSource (const AudioSourceChannelInfo& info, int64 blockStartPosition)
+{
+    auto offset = 0;
+
+    if (cueSamplesPlayed < 0)
+    {
+        const auto samplesUntilSwitch = cueSwitchPosition - blockStartPosition;
+
+        if (samplesUntilSwitch >= info.numSamples)
+            return;
+
+        offset = (int) jmax ((int64) 0, samplesUntilSwitch);
+        cueSamplesPlayed = 0;
+    }
+
+    const auto numOutputChannels = info.buffer->getNumChannels();
+    const auto numCuedChannels = jmin (numOutputChannels, cueBuffer.getNumChannels());
+
+    while (offset < info.numSamples)
+    {
+        const auto numThisTime = jmin (cueBuffer.getNumSamples(), info.numSamples - offset);
+
+        AudioBuffer<float> cued (cueBuffer.getArrayOfWritePointers(), numCuedChannels, numThisTime);
+        cuedChain->masterSource->getNextAudioBlock (AudioSourceChannelInfo (&cued, 0, numThisTime));
+
+        for (int chan = 0; chan < numOutputChannels; ++chan)
         {
-            if (newResamplerSource != nullptr && sourceSampleRateToCorrectFor > 0 && sampleRate > 0)
-                newResamplerSource->setResamplingRatio (sourceSampleRateToCorrectFor / sampleRate);
+            auto* dest = info.buffer->getWritePointer (chan, info.startSample + offset);
+            const auto* next = chan < numCuedChannels ? cued.getReadPointer (chan) : nullptr;
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                const auto fade = cueCrossfadeLength > 0 ? jmin (1.0f, (float) (cueSamplesPlayed + i) / (float) cueCrossfadeLength)
+                                                         : 1.0f;
 
-            newMasterSource->prepareToPlay (blockSize, sampleRate);
+                dest[i] = dest[i] * (1.0f - fade) + (next != nullptr ? next[i] * fade : 0.0f);
+            }
         }
+
+        cueSamplesPlayed += numThisTime;
+        offset += numThisTime;
     }
 
+    if (cueSamplesPlayed >= cueCrossfadeLength)
     {
-        const ScopedLock sl (callbackLock);
+        // The old chain is kept until the message thread can release it, as that may
+        // involve stopping a read-ahead thread
+        exchangeCurrentChain (*cuedChain);
+        jassert (retiredChain == nullptr);
+        std::swap (retiredChain, cuedChain);
+        cueSamplesPlayed = -1;
+        triggerAsyncUpdate();
+    }
+}
 
-        source = newSource;
-        resamplerSource = newResamplerSource;
-        bufferingSource = newBufferingSource;
-        masterSource = newMasterSource;
-        positionableSource = newPositionableSource;
-        readAheadBufferSize = readAheadSize;
-        sourceSampleRate = sourceSampleRateToCorrectFor;
+void AudioTransportSource::handleAsyncUpdate()
+{
+    std::unique_ptr<SourceChain> oldChain;
 
-        playing = false;
+    {
+        const ScopedLock sl (callbackLock);
+        std::swap (oldChain, retiredChain);
     }
 
-    if (oldMasterSource != nullptr)
-        oldMasterSource->releaseResources();
+    if (oldChain != nullptr)
+    {
+        releaseSourceChain (std::move (oldChain));
+        sendChangeMessage();
+    }
 }
 
 void AudioTransportSource::start()
@@ -241,6 +443,14 @@ void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double ne
     if (resamplerSource != nullptr && sourceSampleRate > 0)
         resamplerSource->setResamplingRatio (sourceSampleRate / sampleRate);
 
+    if (cuedChain != nullptr)
+    {
+        if (cuedChain->resamplerSource != nullptr && cuedChain->sourceSampleRate > 0)
+            cuedChain->resamplerSource->setResamplingRatio (cuedChain->sourceSampleRate / sampleRate);
+
+        cuedChain->masterSource->prepareToPlay (samplesPerBlockExpected, sampleRate);
+    }
+
     isPrepared = true;
 }
 
@@ -251,6 +461,9 @@ void AudioTransportSource::releaseMasterResources()
     if (masterSource != nullptr)
         masterSource->releaseResources();
 
+    if (cuedChain != nullptr)
+        cuedChain->masterSource->releaseResources();
+
     isPrepared = false;
 }
 
@@ -265,8 +478,13 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
 
     if (masterSource != nullptr && ! stopped)
     {
+        const auto blockStartPosition = cuedChain != nullptr ? getNextReadPosition() : 0;
+
         masterSource->getNextAudioBlock (info);
 
+        if (cuedChain != nullptr)
+            mixInCuedSource (info, blockStartPosition);
+
         if (! playing)
         {
             // just stopped playing, so fade out the last block..
@@ -277,7 +495,7 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
                 info.buffer->clear (info.startSample + 256, info.numSamples - 256);
         }
 
-        if (hasStreamFinished())
+        if (cuedChain == nullptr && hasStreamFinished())
         {
             playing = false;
             sendChangeMessage();
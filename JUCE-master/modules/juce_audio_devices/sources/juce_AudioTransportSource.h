@@ -51,7 +51,8 @@ namespace juce
     @tags{Audio}
 */
 class JUCE_API  AudioTransportSource  : public PositionableAudioSource,
-                                        public ChangeBroadcaster
+                                        public ChangeBroadcaster,
+                                        private AsyncUpdater
 {
 public:
     //==============================================================================
@@ -93,6 +94,58 @@ public:
                     double sourceSampleRateToCorrectFor = 0.0,
                     int maxNumChannels = 2);
 
+    //==============================================================================
+    /** Prepares another source to take over from the current one at a given position.
+
+        The new source is wrapped and prepared here in the same way as setSource() would do,
+        so if you give it a read-ahead buffer, that starts filling on the background thread
+        straight away while the current source carries on playing. When playback reaches
+        switchPosition, the transport switches to the new source at exactly that sample,
+        fading across from the old one over crossfadeLength samples if this isn't zero.
+        The positions and lengths are in output samples, like getNextReadPosition().
+
+        Until the switch, playback won't stop when the current source runs out. Afterwards,
+        the transport reports the new source's position and length, and once the old source
+        is no longer needed it's released on the message thread and a change message is sent.
+        As with setSource(), neither source will be deleted by this object.
+
+        Calling this again replaces any cue that hasn't been reached, and setSource() removes
+        it. Use waitForCuedSourceReady() if you need to know that the new source's read-ahead
+        buffer has been filled, so that the switch won't have to wait for the disk.
+
+        @returns false if the source couldn't be cued because the transport is part-way
+                 through crossfading to a previously cued one
+        @see setSource, cancelCue, isSourceCued
+    */
+    bool cueNextSource (PositionableAudioSource* nextSource,
+                        int64 switchPosition,
+                        int crossfadeLength = 0,
+                        int readAheadBufferSize = 0,
+                        TimeSliceThread* readAheadThread = nullptr,
+                        double sourceSampleRateToCorrectFor = 0.0,
+                        int maxNumChannels = 2);
+
+    /** Removes a source that was set with cueNextSource(), as long as playback hasn't
+        started switching to it.
+
+        @returns true if a cue was removed
+    */
+    bool cancelCue();
+
+    /** Returns true if a source has been set with cueNextSource() and playback hasn't
+        finished switching to it yet.
+    */
+    bool isSourceCued() const;
+
+    /** Waits for the read-ahead buffer of a source set with cueNextSource() to hold at
+        least the given number of samples.
+
+        This should be called from the same thread as cueNextSource(). It returns true
+        straight away if the cued source doesn't use a read-ahead buffer, and false if
+        there's no cued source or it times out.
+    */
+    bool waitForCuedSourceReady (int numSamples, int timeoutMilliseconds);
+
     //==============================================================================
     /** Changes the current playback position in the source stream.
 
@@ -184,7 +237,19 @@ private:
     int blockSize = 128, readAheadBufferSize = 0;
     bool isPrepared = false;
 
+    struct SourceChain;
+    std::unique_ptr<SourceChain> cuedChain, retiredChain;
+    AudioBuffer<float> cueBuffer;
+    int64 cueSwitchPosition = 0;
+    int cueCrossfadeLength = 0, cueSamplesPlayed = -1;
+
     void releaseMasterResources();
+    std::unique_ptr<SourceChain> createSourceChain (PositionableAudioSource*, int readAheadSize, TimeSliceThread*,
+                                                    double sourceSampleRateToCorrectFor, int maxNumChannels);
+    void exchangeCurrentChain (SourceChain&) noexcept;
+    static void releaseSourceChain (std::unique_ptr<SourceChain>);
+    void mixInCuedSource (const AudioSourceChannelInfo&, int64 blockStartPosition);
+    void handleAsyncUpdate() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTransportSource)
 };
@@ -846,7 +846,7 @@ public:
         if (numSamples <= 0)
             return true;
 
-        if (map == nullptr || ! mappedSection.contains (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
+        if (! ensureSectionIsMapped (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
         {
             jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
             return false;
@@ -911,7 +911,7 @@ public:
     {
         numSamples = jmin (numSamples, lengthInSamples - startSampleInFile);
 
-        if (map == nullptr || numSamples <= 0 || ! mappedSection.contains (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
+        if (numSamples <= 0 || ! ensureSectionIsMapped (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
         {
             jassert (numSamples <= 0); // you must make sure that the window contains all the samples you're going to attempt to read.
 
@@ -972,6 +972,18 @@ Array<int> AiffAudioFormat::getPossibleBitDepths()
 bool AiffAudioFormat::canDoStereo() { return true; }
 bool AiffAudioFormat::canDoMono()   { return true; }
 
+AudioFormat::HeaderMatch AiffAudioFormat::matchesHeader (const void* headerData, size_t numBytes)
+{
+    auto* bytes = static_cast<const char*> (headerData);
+
+    if (numBytes >= 12
+         && memcmp (bytes, "FORM", 4) == 0
+         && (memcmp (bytes + 8, "AIFF", 4) == 0 || memcmp (bytes + 8, "AIFC", 4) == 0))
+        return HeaderMatch::yes;
+
+    return HeaderMatch::no;
+}
+
 #if JUCE_MAC
 bool AiffAudioFormat::canHandleFile (const File& f)
 {
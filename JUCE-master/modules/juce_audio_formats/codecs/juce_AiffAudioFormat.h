@@ -76,6 +76,7 @@ public:
     Array<int> getPossibleBitDepths() override;
     bool canDoStereo() override;
     bool canDoMono() override;
+    HeaderMatch matchesHeader (const void* headerData, size_t numBytes) override;
 
    #if JUCE_MAC
     bool canHandleFile (const File& fileToTest) override;
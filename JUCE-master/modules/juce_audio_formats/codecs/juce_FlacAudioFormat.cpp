@@ -403,38 +403,92 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
 };
 
+//==============================================================================
+/*  Reads the stream properties straight from the STREAMINFO block, and only creates
+    a FlacReader (and its libFLAC decoder) when samples are first read.
+*/
+class FlacMetadataReader final : public AudioFormatReader
+{
+public:
+    FlacMetadataReader (InputStream* in)
+        : AudioFormatReader (in, flacFormatName),
+          streamStart (in->getPosition())
+    {
+        uint8 header[4 + 4 + 34];
+
+        if (in->read (header, (int) sizeof (header)) != (int) sizeof (header)
+             || memcmp (header, "fLaC", 4) != 0
+             || (header[4] & 0x7f) != 0                                          // the first block must be STREAMINFO..
+             || ((header[5] << 16) | (header[6] << 8) | header[7]) != 34)        // ..and is always this size
+            return;
+
+        const auto* info = header + 8;
+        const auto rate = ((uint32) info[10] << 12) | ((uint32) info[11] << 4) | ((uint32) info[12] >> 4);
+        const auto totalSamples = ((uint64) (info[13] & 0x0f) << 32) | ByteOrder::bigEndianInt (info + 14);
+
+        if (rate == 0 || totalSamples == 0)
+            return;
+
+        sampleRate = rate;
+        numChannels = (unsigned int) ((info[12] >> 1) & 7) + 1;
+        bitsPerSample = (unsigned int) (((info[12] & 1) << 4) | (info[13] >> 4)) + 1;
+        lengthInSamples = (unsigned int) totalSamples;
+    }
+
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        if (reader == nullptr)
+        {
+            input->setPosition (streamStart);
+            reader = std::make_unique<FlacReader> (std::exchange (input, nullptr));
+        }
+
+        return reader->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+    }
+
+private:
+    const int64 streamStart;
+    std::unique_ptr<FlacReader> reader;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacMetadataReader)
+};
+
 
 //==============================================================================
 class FlacWriter final : public AudioFormatWriter
 {
 public:
-    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex)
+    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex, int numEncoderThreads)
         : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
-          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll),
+          qualityIndex (qualityOptionIndex)
     {
         encoder = FlacNamespace::FLAC__stream_encoder_new();
-
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+        configureEncoder (encoder);
 
         ok = FLAC__stream_encoder_init_stream (encoder,
                                                encodeWriteCallback, encodeSeekCallback,
                                                encodeTellCallback, encodeMetadataCallback,
                                                this) == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        if (ok && numEncoderThreads > 1)
+            parallelEncoder = std::make_unique<ParallelEncoder> (*this, numEncoderThreads);
+       #else
+        ignoreUnused (numEncoderThreads);
+       #endif
     }
 
     ~FlacWriter() override
     {
         if (ok)
         {
+           #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+            if (parallelEncoder != nullptr)
+                parallelEncoder->finish();
+           #endif
+
             FlacNamespace::FLAC__stream_encoder_finish (encoder);
             output->flush();
         }
@@ -477,6 +531,11 @@ public:
             samplesToWrite = const_cast<const int**> (channels.get());
         }
 
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        if (parallelEncoder != nullptr)
+            return parallelEncoder->write (samplesToWrite, numSamples);
+       #endif
+
         return FLAC__stream_encoder_process (encoder, (const FlacNamespace::FLAC__int32**) samplesToWrite, (unsigned) numSamples) != 0;
     }
 
@@ -499,7 +558,12 @@ public:
     void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
     {
         using namespace FlacNamespace;
-        auto& info = metadata->data.stream_info;
+        auto info = metadata->data.stream_info;
+
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        if (parallelEncoder != nullptr)
+            parallelEncoder->updateStreamInfo (info);
+       #endif
 
         unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
         const unsigned int channelsMinus1 = info.channels - 1;
@@ -561,8 +625,314 @@ public:
     bool ok = false;
 
 private:
+    void configureEncoder (FlacNamespace::FLAC__StreamEncoder* e) const
+    {
+        using namespace FlacNamespace;
+
+        if (qualityIndex > 0)
+            FLAC__stream_encoder_set_compression_level (e, (uint32) jmin (8, qualityIndex));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_channels (e, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (e, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (e, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (e, 0);
+        FLAC__stream_encoder_set_do_escape_coding (e, true);
+    }
+
+   #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+    //==============================================================================
+    /*  Splits the stream into groups of frames and encodes each group with its own
+        libFLAC encoder on a thread pool.
+
+        Frames don't depend on each other, except that loose mid-side stereo re-evaluates
+        its channel assignment every N frames - so as long as every group starts on one of
+        those boundaries, each frame comes out exactly as a single encoder would produce it,
+        apart from its frame number. The frame numbers are rewritten as the groups are
+        written out in order, and the stream info is rebuilt from the totals of all groups.
+
+        This needs libFLAC's internal CRC and MD5 functions, so is only available when using
+        the bundled FLAC code.
+    */
+    class ParallelEncoder
+    {
+    public:
+        ParallelEncoder (FlacWriter& w, int numThreads)
+            : owner (w),
+              pool (ThreadPoolOptions{}.withThreadName ("FLAC Encoder")
+                                       .withNumberOfThreads (numThreads)),
+              maxJobsInFlight ((size_t) numThreads * 2)
+        {
+            using namespace FlacNamespace;
+
+            blockSize = FLAC__stream_encoder_get_blocksize (owner.encoder);
+
+            // This mirrors the way libFLAC works out how often loose mid-side stereo re-tests
+            const auto looseFrames = jmax (1u, (uint32) (owner.sampleRate * 0.4 / (double) blockSize + 0.5));
+            framesPerGroup = looseFrames * jmax (1u, (minFramesPerGroup + looseFrames - 1) / looseFrames);
+
+            FLAC__MD5Init (&md5);
+            startNewGroup();
+        }
+
+        ~ParallelEncoder()
+        {
+            pool.removeAllJobs (true, -1);
+
+            if (! md5Finalised)
+            {
+                FlacNamespace::FLAC__byte unused[16];
+                FLAC__MD5Final (unused, &md5);
+            }
+        }
+
+        bool write (const int** samples, int numSamples)
+        {
+            using namespace FlacNamespace;
+
+            const auto bytesPerSample = (jmin ((unsigned int) 24, owner.bitsPerSample) + 7) / 8;
+
+            if (! FLAC__MD5Accumulate (&md5, (const FLAC__int32* const*) samples, owner.numChannels, (uint32) numSamples, bytesPerSample))
+                return false;
+
+            const auto samplesPerGroup = (int) (framesPerGroup * blockSize);
+
+            for (int done = 0; done < numSamples;)
+            {
+                const auto numToCopy = jmin (numSamples - done, samplesPerGroup - current->numSamples);
+
+                for (unsigned int ch = 0; ch < owner.numChannels; ++ch)
+                    std::copy (samples[ch] + done, samples[ch] + done + numToCopy,
+                               current->samples[ch].data() + current->numSamples);
+
+                current->numSamples += numToCopy;
+                done += numToCopy;
+
+                if (current->numSamples == samplesPerGroup)
+                {
+                    submitCurrentGroup();
+
+                    if (! writeFinishedGroups (false))
+                        return false;
+
+                    startNewGroup();
+                }
+            }
+
+            return true;
+        }
+
+        bool finish()
+        {
+            if (current->numSamples > 0)
+                submitCurrentGroup();
+
+            current.reset();
+            return writeFinishedGroups (true);
+        }
+
+        void updateStreamInfo (FlacNamespace::FLAC__StreamMetadata_StreamInfo& info)
+        {
+            info.min_framesize = totalSamples > 0 ? minFrameSize : 0;
+            info.max_framesize = maxFrameSize;
+            info.total_samples = totalSamples;
+            FLAC__MD5Final (info.md5sum, &md5);
+            md5Finalised = true;
+        }
+
+    private:
+        struct Group
+        {
+            std::vector<std::vector<int>> samples;
+            int numSamples = 0;
+            uint32 firstFrame = 0, minFrameSize = std::numeric_limits<uint32>::max(), maxFrameSize = 0;
+            MemoryOutputStream encoded;
+            bool succeeded = false;
+            WaitableEvent finished { true };
+        };
+
+        void startNewGroup()
+        {
+            current = std::make_shared<Group>();
+            current->samples.assign (owner.numChannels, std::vector<int> (framesPerGroup * blockSize));
+            current->firstFrame = nextFirstFrame;
+            nextFirstFrame += framesPerGroup;
+        }
+
+        void submitCurrentGroup()
+        {
+            auto group = current;
+            inFlight.push (group);
+
+            pool.addJob ([this, group]
+            {
+                group->succeeded = encodeGroup (*group);
+                group->finished.signal();
+            });
+        }
+
+        bool writeFinishedGroups (bool waitForAll)
+        {
+            bool succeeded = true;
+
+            while (! inFlight.empty())
+            {
+                auto& group = *inFlight.front();
+
+                // Block when too many groups are queued, so that memory use stays bounded
+                if (waitForAll || inFlight.size() > maxJobsInFlight)
+                    group.finished.wait();
+                else if (! group.finished.wait (0))
+                    break;
+
+                succeeded = succeeded && group.succeeded
+                             && owner.output->write (group.encoded.getData(), group.encoded.getDataSize());
+
+                totalSamples += (uint64) group.numSamples;
+                minFrameSize = jmin (minFrameSize, group.minFrameSize);
+                maxFrameSize = jmax (maxFrameSize, group.maxFrameSize);
+                inFlight.pop();
+            }
+
+            return succeeded;
+        }
+
+        bool encodeGroup (Group& group) const
+        {
+            using namespace FlacNamespace;
+
+            auto* e = FLAC__stream_encoder_new();
+            owner.configureEncoder (e);
+
+            auto ok = FLAC__stream_encoder_init_stream (e, groupWriteCallback, nullptr, nullptr, nullptr, &group)
+                        == FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+
+            std::vector<const FLAC__int32*> channels;
+
+            for (const auto& channel : group.samples)
+                channels.push_back (channel.data());
+
+            ok = ok && FLAC__stream_encoder_process (e, channels.data(), (unsigned) group.numSamples) != 0;
+
+            ok = FLAC__stream_encoder_finish (e) != 0 && ok;
+            FLAC__stream_encoder_delete (e);
+            return ok;
+        }
+
+        static FlacNamespace::FLAC__StreamEncoderWriteStatus groupWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                                const FlacNamespace::FLAC__byte buffer[],
+                                                                                size_t bytes,
+                                                                                unsigned int samples,
+                                                                                unsigned int currentFrame,
+                                                                                void* clientData)
+        {
+            // The stream header has already been written by the main encoder
+            if (samples == 0)
+                return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+
+            auto& group = *static_cast<Group*> (clientData);
+            const auto start = group.encoded.getDataSize();
+
+            if (! writeRenumberedFrame (buffer, bytes, group.firstFrame + currentFrame, group.encoded))
+                return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+
+            // Renumbering can change the frame's size
+            const auto frameSize = (uint32) (group.encoded.getDataSize() - start);
+            group.minFrameSize = jmin (group.minFrameSize, frameSize);
+            group.maxFrameSize = jmax (group.maxFrameSize, frameSize);
+            return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+        }
+
+        /*  Copies a frame, replacing the UTF-8 coded frame number in its header and
+            recalculating both of its checksums.
+        */
+        static bool writeRenumberedFrame (const uint8* frame, size_t size, uint32 frameNumber, MemoryOutputStream& dest)
+        {
+            using namespace FlacNamespace;
+
+            constexpr size_t numFixedHeaderBytes = 4;
+
+            if (size < numFixedHeaderBytes + 3)
+                return false;
+
+            const auto oldNumberSize = [first = frame[numFixedHeaderBytes]]() -> size_t
+            {
+                if ((first & 0x80) == 0x00) return 1;
+                if ((first & 0xe0) == 0xc0) return 2;
+                if ((first & 0xf0) == 0xe0) return 3;
+                if ((first & 0xf8) == 0xf0) return 4;
+                if ((first & 0xfc) == 0xf8) return 5;
+                if ((first & 0xfe) == 0xfc) return 6;
+                return 0;
+            }();
+
+            const auto blockSizeCode = frame[2] >> 4, sampleRateCode = frame[2] & 0x0f;
+            const auto numExtraBytes = (size_t) (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                                     + (size_t) (sampleRateCode == 12 ? 1 : (sampleRateCode == 13 || sampleRateCode == 14 ? 2 : 0));
+            const auto oldHeaderSize = numFixedHeaderBytes + oldNumberSize + numExtraBytes + 1;
+
+            if (oldNumberSize == 0 || size < oldHeaderSize + 2)
+                return false;
+
+            uint8 number[6];
+            const auto numberSize = [&]() -> size_t
+            {
+                if (frameNumber < 0x80)
+                {
+                    number[0] = (uint8) frameNumber;
+                    return 1;
+                }
+
+                const auto numBytes = frameNumber < 0x800 ? 2u : frameNumber < 0x10000 ? 3u : frameNumber < 0x200000 ? 4u
+                                                                : frameNumber < 0x4000000 ? 5u : 6u;
+
+                for (auto i = numBytes; --i > 0;)
+                {
+                    number[i] = (uint8) (0x80 | (frameNumber & 0x3f));
+                    frameNumber >>= 6;
+                }
+
+                number[0] = (uint8) (((0xff00u >> numBytes) & 0xff) | frameNumber);
+                return numBytes;
+            }();
+
+            const auto headerStart = dest.getDataSize();
+            auto ok = dest.write (frame, numFixedHeaderBytes)
+                   && dest.write (number, numberSize)
+                   && dest.write (frame + numFixedHeaderBytes + oldNumberSize, numExtraBytes);
+
+            const auto* header = static_cast<const uint8*> (dest.getData()) + headerStart;
+            const auto headerSize = dest.getDataSize() - headerStart;
+            ok = ok && dest.writeByte ((char) FLAC__crc8 (header, (uint32) headerSize));
+
+            ok = ok && dest.write (frame + oldHeaderSize, size - oldHeaderSize - 2);
+
+            const auto* newFrame = static_cast<const uint8*> (dest.getData()) + headerStart;
+            const auto crc = FLAC__crc16 (newFrame, (uint32) (dest.getDataSize() - headerStart));
+            return ok && dest.writeShortBigEndian ((short) crc);
+        }
+
+        static constexpr uint32 minFramesPerGroup = 64;
+
+        FlacWriter& owner;
+        ThreadPool pool;
+        const size_t maxJobsInFlight;
+        uint32 blockSize = 0, framesPerGroup = 0, nextFirstFrame = 0;
+        std::shared_ptr<Group> current;
+        std::queue<std::shared_ptr<Group>> inFlight;
+        FlacNamespace::FLAC__MD5Context md5;
+        bool md5Finalised = false;
+        uint64 totalSamples = 0;
+        uint32 minFrameSize = std::numeric_limits<uint32>::max(), maxFrameSize = 0;
+    };
+
+    std::unique_ptr<ParallelEncoder> parallelEncoder;
+   #endif
+
     FlacNamespace::FLAC__StreamEncoder* encoder;
     int64 streamStartPos;
+    int qualityIndex;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
@@ -585,6 +955,18 @@ Array<int> FlacAudioFormat::getPossibleBitDepths()
 
 bool FlacAudioFormat::canDoStereo()     { return true; }
 bool FlacAudioFormat::canDoMono()       { return true; }
+
+AudioFormat::HeaderMatch FlacAudioFormat::matchesHeader (const void* headerData, size_t numBytes)
+{
+    if (numBytes >= 4 && memcmp (headerData, "fLaC", 4) == 0)
+        return HeaderMatch::yes;
+
+    // libFLAC will skip an ID3v2 tag to find the stream
+    if (numBytes >= 3 && memcmp (headerData, "ID3", 3) == 0)
+        return HeaderMatch::possibly;
+
+    return HeaderMatch::no;
+}
 bool FlacAudioFormat::isCompressed()    { return true; }
 
 AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails)
@@ -600,6 +982,21 @@ AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool
     return nullptr;
 }
 
+AudioFormatReader* FlacAudioFormat::createMetadataReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails)
+{
+    const auto startPosition = in->getPosition();
+    std::unique_ptr<FlacMetadataReader> r (new FlacMetadataReader (in));
+
+    if (r->sampleRate > 0)
+        return r.release();
+
+    // The stream info couldn't be read directly (e.g. because there's an ID3 tag in front of it,
+    // or the length isn't stored), so let libFLAC have a go instead.
+    r->input = nullptr;
+    in->setPosition (startPosition);
+    return createReaderFor (in, deleteStreamIfOpeningFails);
+}
+
 AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
@@ -610,7 +1007,8 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
     {
         std::unique_ptr<FlacWriter> w (new FlacWriter (out, sampleRate, numberOfChannels,
-                                                     (uint32) bitsPerSample, qualityOptionIndex));
+                                                     (uint32) bitsPerSample, qualityOptionIndex,
+                                                     numEncoderThreads));
         if (w->ok)
             return w.release();
     }
@@ -623,6 +1021,87 @@ StringArray FlacAudioFormat::getQualityOptions()
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && (JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE))
+
+struct FlacAudioFormatTests final : public UnitTest
+{
+    FlacAudioFormatTests()
+        : UnitTest ("FLAC audio format tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Multithreaded encoding produces the same stream as a single thread");
+        {
+            auto random = getRandom();
+
+            for (auto numChannels : { 1, 2 })
+            {
+                AudioBuffer<float> source (numChannels, 1000003);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    for (int i = 0; i < source.getNumSamples(); ++i)
+                        source.setSample (ch, i, 0.5f * std::sin ((float) i * 0.01f * (float) (ch + 1))
+                                                   + 0.1f * (random.nextFloat() - 0.5f));
+
+                for (auto quality : { 0, 5, 8 })
+                {
+                    const auto serial = encode (source, quality, 1, random);
+                    const auto parallel = encode (source, quality, 4, random);
+
+                    expect (serial.getSize() > 0);
+                    expect (serial == parallel);
+
+                    std::unique_ptr<AudioFormatReader> reader (FlacAudioFormat().createReaderFor (new MemoryInputStream (parallel, false), true));
+                    expect (reader != nullptr);
+
+                    if (reader != nullptr)
+                    {
+                        expectEquals (reader->lengthInSamples, (int64) source.getNumSamples());
+
+                        AudioBuffer<float> decoded (numChannels, source.getNumSamples());
+                        reader->read (&decoded, 0, decoded.getNumSamples(), 0, true, true);
+
+                        for (int ch = 0; ch < numChannels; ++ch)
+                        {
+                            decoded.addFrom (ch, 0, source, ch, 0, source.getNumSamples(), -1.0f);
+                            expect (decoded.getMagnitude (ch, 0, decoded.getNumSamples()) < 1.0e-4f);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static MemoryBlock encode (const AudioBuffer<float>& source, int quality, int numThreads, Random& random)
+    {
+        MemoryBlock block;
+        FlacAudioFormat format;
+        format.setNumEncoderThreads (numThreads);
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (block, false),
+                                                                               44100.0, (unsigned int) source.getNumChannels(),
+                                                                               24, {}, quality));
+
+            for (int pos = 0; pos < source.getNumSamples();)
+            {
+                const auto numToWrite = jmin (source.getNumSamples() - pos, 1 + random.nextInt (20000));
+                writer->writeFromAudioSampleBuffer (source, pos, numToWrite);
+                pos += numToWrite;
+            }
+        }
+
+        return block;
+    }
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
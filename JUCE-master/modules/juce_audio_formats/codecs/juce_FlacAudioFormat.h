@@ -61,10 +61,13 @@ public:
     bool canDoMono() override;
     bool isCompressed() override;
     StringArray getQualityOptions() override;
+    HeaderMatch matchesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
+    AudioFormatReader* createMetadataReaderFor (InputStream* sourceStream,
+                                                bool deleteStreamIfOpeningFails) override;
 
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
@@ -74,7 +77,26 @@ public:
                                         int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
 
+    //==============================================================================
+    /** Sets the number of threads that writers created after this call will use
+        for encoding.
+
+        With more than one thread, a writer buffers groups of frames and encodes them
+        concurrently, writing the results in order. The output is identical to that of
+        a single-threaded writer. The default is 1, which encodes on the thread that
+        calls write().
+
+        This has no effect if JUCE_INCLUDE_FLAC_CODE is disabled, as it relies on parts
+        of libFLAC that a system library doesn't export.
+    */
+    void setNumEncoderThreads (int numThreads) noexcept         { numEncoderThreads = jmax (1, numThreads); }
+
+    /** Returns the number of encoder threads set by setNumEncoderThreads(). */
+    int getNumEncoderThreads() const noexcept                   { return numEncoderThreads; }
+
 private:
+    int numEncoderThreads = 1;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
 
@@ -1588,6 +1588,29 @@ struct MP3Stream
         return true;
     }
 
+    /*  Runs through every remaining frame in the stream, so that the table of frame
+        positions covers the whole of it.
+    */
+    void scanToEnd()
+    {
+        for (int attempts = 0; attempts < 10;)
+        {
+            int dummy = 0;
+            auto result = decodeNextBlock (nullptr, nullptr, dummy);
+
+            if (result < 0 || stream.isExhausted())
+                break;
+
+            attempts = result > 0 ? attempts + 1 : 0;
+        }
+    }
+
+    /*  The stream position of every framesPerStoredPosition'th frame. */
+    const Array<int64>& getFramePositions() const noexcept      { return frameStreamPositions; }
+    void setFramePositions (const Array<int64>& newPositions)   { frameStreamPositions = newPositions; }
+
+    static constexpr int getFramesPerStoredPosition() noexcept  { return storedStartPosInterval; }
+
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
@@ -2961,17 +2984,44 @@ private:
 
 //==============================================================================
 static const char* const mp3FormatName = "MP3 file";
+static constexpr int mp3SeekIndexTag = 0x2033504d; // "MP3 "
+
+static void skipID3 (InputStream& source)
+{
+    const int64 originalPosition = source.getPosition();
+    const uint32 firstWord = (uint32) source.readInt();
+
+    if ((firstWord & 0xffffff) == 0x334449)
+    {
+        uint8 buffer[6];
+
+        if (source.read (buffer, 6) == 6
+             && buffer[0] != 0xff
+             && ((buffer[2] | buffer[3] | buffer[4] | buffer[5]) & 0x80) == 0)
+        {
+            const uint32 length = (((uint32) buffer[2]) << 21)
+                                | (((uint32) buffer[3]) << 14)
+                                | (((uint32) buffer[4]) << 7)
+                                |  ((uint32) buffer[5]);
+
+            source.skipNextBytes (length);
+            return;
+        }
+    }
+
+    source.setPosition (originalPosition);
+}
 
 //==============================================================================
 class MP3Reader final : public AudioFormatReader
 {
 public:
-    MP3Reader (InputStream* const in)
+    MP3Reader (InputStream* const in, const MemoryBlock* seekIndexData = nullptr)
         : AudioFormatReader (in, mp3FormatName),
           stream (*in), currentPosition (0),
           decodedStart (0), decodedEnd (0)
     {
-        skipID3();
+        skipID3 (stream.stream);
         const int64 streamPos = stream.stream.getPosition();
 
         if (readNextBlock())
@@ -2981,6 +3031,9 @@ public:
             sampleRate = stream.frame.getFrequency();
             numChannels = (unsigned int) stream.frame.numChannels;
             lengthInSamples = findLength (streamPos);
+
+            if (seekIndexData != nullptr)
+                applySeekIndex (*seekIndexData);
         }
     }
 
@@ -3096,30 +3149,22 @@ private:
         return false;
     }
 
-    void skipID3()
+    void applySeekIndex (const MemoryBlock& seekIndexData)
     {
-        const int64 originalPosition = stream.stream.getPosition();
-        const uint32 firstWord = (uint32) stream.stream.readInt();
+        const auto index = detail::AudioFormatSeekIndex::fromMemoryBlock (seekIndexData, mp3SeekIndexTag,
+                                                                          stream.stream.getTotalLength());
+        Array<int64> positions;
 
-        if ((firstWord & 0xffffff) == 0x334449)
+        for (auto& entry : index.entries)
         {
-            uint8 buffer[6];
-
-            if (stream.stream.read (buffer, 6) == 6
-                 && buffer[0] != 0xff
-                 && ((buffer[2] | buffer[3] | buffer[4] | buffer[5]) & 0x80) == 0)
-            {
-                const uint32 length = (((uint32) buffer[2]) << 21)
-                                    | (((uint32) buffer[3]) << 14)
-                                    | (((uint32) buffer[4]) << 7)
-                                    |  ((uint32) buffer[5]);
-
-                stream.stream.skipNextBytes (length);
+            if (entry.sample != (int64) positions.size() * MP3Stream::getFramesPerStoredPosition() * 1152)
                 return;
-            }
+
+            positions.add (entry.byte);
         }
 
-        stream.stream.setPosition (originalPosition);
+        if (positions.size() > stream.getFramePositions().size())
+            stream.setFramePositions (positions);
     }
 
     int64 findLength (int64 streamStartPos)
@@ -3160,9 +3205,27 @@ bool MP3AudioFormat::canDoMono()                    { return true; }
 bool MP3AudioFormat::isCompressed()                 { return true; }
 StringArray MP3AudioFormat::getQualityOptions()     { return {}; }
 
+AudioFormat::HeaderMatch MP3AudioFormat::matchesHeader (const void* headerData, size_t numBytes)
+{
+    auto* bytes = static_cast<const uint8*> (headerData);
+
+    if (numBytes >= 2 && bytes[0] == 0xff && (bytes[1] & 0xe0) == 0xe0)
+        return HeaderMatch::yes;
+
+    // The decoder scans forward for the first frame, so this can't rule anything out.
+    // (An ID3 tag isn't conclusive either, as other formats can begin with one.)
+    return HeaderMatch::possibly;
+}
+
 AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, const bool deleteStreamIfOpeningFails)
 {
-    std::unique_ptr<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream));
+    return createReaderFor (sourceStream, deleteStreamIfOpeningFails, {});
+}
+
+AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails,
+                                                    const MemoryBlock& seekIndex)
+{
+    std::unique_ptr<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream, seekIndex.isEmpty() ? nullptr : &seekIndex));
 
     if (r->lengthInSamples > 0)
         return r.release();
@@ -3173,6 +3236,27 @@ AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, c
     return nullptr;
 }
 
+MemoryBlock MP3AudioFormat::createSeekIndex (InputStream& source)
+{
+    MP3Decoder::skipID3 (source);
+
+    MP3Decoder::MP3Stream stream (source);
+    stream.scanToEnd();
+
+    detail::AudioFormatSeekIndex index;
+    index.streamLength = source.getTotalLength();
+
+    const auto& positions = stream.getFramePositions();
+
+    for (int i = 0; i < positions.size(); ++i)
+        index.entries.push_back ({ (int64) i * MP3Decoder::MP3Stream::getFramesPerStoredPosition() * 1152, positions.getUnchecked (i) });
+
+    if (index.isEmpty())
+        return {};
+
+    return index.toMemoryBlock (MP3Decoder::mp3SeekIndexTag);
+}
+
 AudioFormatWriter* MP3AudioFormat::createWriterFor (OutputStream*, double /*sampleRateToUse*/,
                                                     unsigned int /*numberOfChannels*/, int /*bitsPerSample*/,
                                                     const StringPairArray& /*metadataValues*/, int /*qualityOptionIndex*/)
@@ -67,6 +67,7 @@ public:
     bool canDoMono() override;
     bool isCompressed() override;
     StringArray getQualityOptions() override;
+    HeaderMatch matchesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails) override;
@@ -75,6 +76,29 @@ public:
                                         unsigned int numberOfChannels, int bitsPerSample,
                                         const StringPairArray& metadataValues, int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
+
+    //==============================================================================
+    /** Scans an entire MP3 stream and returns a seek index for it.
+
+        The MP3 reader finds frame positions as it decodes, so a jump to a point
+        it hasn't reached yet means scanning all the frames up to it. Building an
+        index up-front (e.g. on a background thread, using a separate stream to
+        the one being read) lets a reader jump anywhere in the file straight away,
+        and the index can be stored next to the file and passed to createReaderFor()
+        later.
+
+        The stream is read from its current position to the end.
+    */
+    static MemoryBlock createSeekIndex (InputStream& source);
+
+    /** Creates a reader that uses a seek index previously built by createSeekIndex().
+
+        If the index doesn't match the stream (e.g. because the file has changed since
+        the index was built), it is ignored.
+    */
+    AudioFormatReader* createReaderFor (InputStream* sourceStream,
+                                        bool deleteStreamIfOpeningFails,
+                                        const MemoryBlock& seekIndex);
 };
 
 #endif
@@ -119,12 +119,15 @@ const char* const OggVorbisAudioFormat::id3date = "id3date";
 const char* const OggVorbisAudioFormat::id3genre = "id3genre";
 const char* const OggVorbisAudioFormat::id3trackNumber = "id3trackNumber";
 
+static constexpr int oggSeekIndexTag = 0x5367674f; // "OggS"
+
 
 //==============================================================================
 class OggReader final : public AudioFormatReader
 {
 public:
-    OggReader (InputStream* inp)  : AudioFormatReader (inp, oggFormatName)
+    OggReader (InputStream* inp, const MemoryBlock* seekIndexData = nullptr)
+        : AudioFormatReader (inp, oggFormatName)
     {
         sampleRate = 0;
         usesFloatingPointData = true;
@@ -156,6 +159,10 @@ public:
             sampleRate = (double) info->rate;
 
             reservoir.setSize ((int) numChannels, (int) jmin (lengthInSamples, (int64) 4096));
+
+            if (seekIndexData != nullptr && ov_streams (&ovFile) == 1)
+                seekIndex = detail::AudioFormatSeekIndex::fromMemoryBlock (*seekIndexData, oggSeekIndexTag,
+                                                                           input->getTotalLength());
         }
     }
 
@@ -194,7 +201,7 @@ public:
             bufferedRange = Range<int64> { newStart, newStart + reservoir.getNumSamples() };
 
             if (bufferedRange.getStart() != ov_pcm_tell (&ovFile))
-                ov_pcm_seek (&ovFile, bufferedRange.getStart());
+                seekTo (bufferedRange.getStart());
 
             int bitStream = 0;
             int offset = 0;
@@ -269,6 +276,45 @@ private:
     OggVorbisNamespace::ov_callbacks callbacks;
     AudioBuffer<float> reservoir;
     Range<int64> bufferedRange;
+    detail::AudioFormatSeekIndex seekIndex;
+
+    void seekTo (int64 target)
+    {
+        // With an index, jump straight to a nearby page and decode forwards from there,
+        // which avoids the bisection that ov_pcm_seek has to do. The first packet after
+        // a jump only primes the decoder, so if that overshoots the target, the entry
+        // before it is tried instead.
+        if (auto* entry = seekIndex.findEntryBefore (target))
+        {
+            for (int attempts = 2; --attempts >= 0; --entry)
+            {
+                if (ov_raw_seek (&ovFile, (long) entry->byte) != 0)
+                    break;
+
+                auto position = (int64) ov_pcm_tell (&ovFile);
+
+                while (position >= 0 && position < target)
+                {
+                    float** dataIn = nullptr;
+                    int bitStream = 0;
+                    auto samps = ov_read_float (&ovFile, &dataIn, (int) jmin ((int64) 4096, target - position), &bitStream);
+
+                    if (samps <= 0)
+                        break;
+
+                    position += samps;
+                }
+
+                if (position == target)
+                    return;
+
+                if (position < target || entry == seekIndex.entries.data())
+                    break;
+            }
+        }
+
+        ov_pcm_seek (&ovFile, target);
+    }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OggReader)
 };
@@ -450,9 +496,24 @@ bool OggVorbisAudioFormat::canDoStereo()    { return true; }
 bool OggVorbisAudioFormat::canDoMono()      { return true; }
 bool OggVorbisAudioFormat::isCompressed()   { return true; }
 
+AudioFormat::HeaderMatch OggVorbisAudioFormat::matchesHeader (const void* headerData, size_t numBytes)
+{
+    // vorbisfile will skip junk before the first page, so anything else could still be readable
+    if (numBytes >= 4 && memcmp (headerData, "OggS", 4) == 0)
+        return HeaderMatch::yes;
+
+    return HeaderMatch::possibly;
+}
+
 AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool deleteStreamIfOpeningFails)
 {
-    std::unique_ptr<OggReader> r (new OggReader (in));
+    return createReaderFor (in, deleteStreamIfOpeningFails, {});
+}
+
+AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool deleteStreamIfOpeningFails,
+                                                          const MemoryBlock& seekIndex)
+{
+    std::unique_ptr<OggReader> r (new OggReader (in, seekIndex.isEmpty() ? nullptr : &seekIndex));
 
     if (r->sampleRate > 0)
         return r.release();
@@ -486,6 +547,86 @@ StringArray OggVorbisAudioFormat::getQualityOptions()
              "192 kbps", "224 kbps", "256 kbps", "320 kbps", "500 kbps" };
 }
 
+MemoryBlock OggVorbisAudioFormat::createSeekIndex (InputStream& source)
+{
+    using namespace OggVorbisNamespace;
+
+    // Entries are spaced at least this many samples apart, which keeps the index small
+    // while bounding the amount of audio that has to be decoded after a jump.
+    constexpr int64 minSamplesBetweenEntries = 16384;
+
+    detail::AudioFormatSeekIndex index;
+    index.streamLength = source.getTotalLength();
+
+    ogg_sync_state syncState;
+    ogg_sync_init (&syncState);
+
+    ogg_page page;
+    auto pageStart = source.getPosition();
+    int64 lastGranule = -1;
+    long serialNumber = -1;
+    bool isValid = true;
+
+    for (;;)
+    {
+        auto result = ogg_sync_pageseek (&syncState, &page);
+
+        if (result < 0)
+        {
+            pageStart -= result;
+            continue;
+        }
+
+        if (result == 0)
+        {
+            constexpr int chunkSize = 8192;
+            auto* buffer = ogg_sync_buffer (&syncState, chunkSize);
+            auto bytesRead = source.read (buffer, chunkSize);
+
+            if (bytesRead <= 0)
+                break;
+
+            ogg_sync_wrote (&syncState, bytesRead);
+            continue;
+        }
+
+        const auto pageSerial = (long) ogg_page_serialno (&page);
+
+        if (serialNumber < 0)
+        {
+            serialNumber = pageSerial;
+        }
+        else if (pageSerial != serialNumber)
+        {
+            // chained or multiplexed streams aren't indexed
+            isValid = false;
+            break;
+        }
+
+        const auto granule = (int64) ogg_page_granulepos (&page);
+
+        if (granule >= 0)
+        {
+            // The samples that end on the previous page are the first ones that can be
+            // decoded after jumping to this one.
+            if (lastGranule >= 0 && granule > lastGranule
+                 && (index.entries.empty() || lastGranule - index.entries.back().sample >= minSamplesBetweenEntries))
+                index.entries.push_back ({ lastGranule, pageStart });
+
+            lastGranule = granule;
+        }
+
+        pageStart += result;
+    }
+
+    ogg_sync_clear (&syncState);
+
+    if (! isValid || index.isEmpty())
+        return {};
+
+    return index.toMemoryBlock (oggSeekIndexTag);
+}
+
 int OggVorbisAudioFormat::estimateOggFileQuality (const File& source)
 {
     if (auto in = source.createInputStream())
@@ -517,6 +658,93 @@ int OggVorbisAudioFormat::estimateOggFileQuality (const File& source)
     return 0;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && (JUCE_INCLUDE_OGGVORBIS_CODE || ! defined (JUCE_INCLUDE_OGGVORBIS_CODE))
+
+struct OggVorbisAudioFormatTests final : public UnitTest
+{
+    OggVorbisAudioFormatTests()
+        : UnitTest ("Ogg-Vorbis audio format tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        const auto encoded = encode (random);
+
+        beginTest ("A seek index can be built and matches its stream");
+        {
+            MemoryInputStream in (encoded, false);
+            const auto index = OggVorbisAudioFormat::createSeekIndex (in);
+            expect (index.getSize() > 0);
+
+            const auto parsed = detail::AudioFormatSeekIndex::fromMemoryBlock (index, oggSeekIndexTag, (int64) encoded.getSize());
+            expect (parsed.entries.size() > 10);
+
+            const auto stale = detail::AudioFormatSeekIndex::fromMemoryBlock (index, oggSeekIndexTag, (int64) encoded.getSize() + 1);
+            expect (stale.isEmpty());
+        }
+
+        beginTest ("Reads with a seek index match reads without one");
+        {
+            MemoryInputStream in (encoded, false);
+            const auto index = OggVorbisAudioFormat::createSeekIndex (in);
+
+            OggVorbisAudioFormat format;
+            std::unique_ptr<AudioFormatReader> plain (format.createReaderFor (new MemoryInputStream (encoded, false), true));
+            std::unique_ptr<AudioFormatReader> indexed (format.createReaderFor (new MemoryInputStream (encoded, false), true, index));
+
+            expect (plain != nullptr && indexed != nullptr);
+
+            if (plain != nullptr && indexed != nullptr)
+            {
+                expectEquals (indexed->lengthInSamples, plain->lengthInSamples);
+
+                AudioBuffer<float> expected (2, 3000), actual (2, 3000);
+
+                for (int i = 0; i < 50; ++i)
+                {
+                    const auto start = (int64) random.nextInt ((int) plain->lengthInSamples - expected.getNumSamples());
+
+                    plain->read (&expected, 0, expected.getNumSamples(), start, true, true);
+                    indexed->read (&actual, 0, actual.getNumSamples(), start, true, true);
+
+                    for (int ch = 0; ch < 2; ++ch)
+                    {
+                        actual.addFrom (ch, 0, expected, ch, 0, expected.getNumSamples(), -1.0f);
+                        expect (exactlyEqual (actual.getMagnitude (ch, 0, actual.getNumSamples()), 0.0f));
+                    }
+                }
+            }
+        }
+    }
+
+    static MemoryBlock encode (Random& random)
+    {
+        AudioBuffer<float> source (2, 44100 * 10);
+
+        for (int ch = 0; ch < source.getNumChannels(); ++ch)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                source.setSample (ch, i, 0.5f * std::sin ((float) i * 0.01f * (float) (ch + 1))
+                                           + 0.1f * (random.nextFloat() - 0.5f));
+
+        MemoryBlock block;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (OggVorbisAudioFormat().createWriterFor (new MemoryOutputStream (block, false),
+                                                                                               44100.0, 2, 16, {}, 4));
+            writer->writeFromAudioSampleBuffer (source, 0, source.getNumSamples());
+        }
+
+        return block;
+    }
+};
+
+static OggVorbisAudioFormatTests oggVorbisAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
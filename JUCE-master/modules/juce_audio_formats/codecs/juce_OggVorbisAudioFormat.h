@@ -61,6 +61,7 @@ public:
     bool canDoMono() override;
     bool isCompressed() override;
     StringArray getQualityOptions() override;
+    HeaderMatch matchesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     /** Tries to estimate the quality level of an ogg file based on its size.
@@ -101,6 +102,29 @@ public:
                                         int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
 
+    //==============================================================================
+    /** Scans an entire Ogg-Vorbis stream and returns a seek index for it.
+
+        Seeking in an Ogg stream normally involves bisecting the file, which can mean
+        many reads and seeks per jump. An index lets a reader go directly to a page
+        near the target position, so if you need fast random access you can build one
+        (e.g. on a background thread, using a separate stream to the one being read),
+        store it next to the file, and pass it to createReaderFor() later.
+
+        The stream is read from its current position to the end. If the stream isn't
+        a plain, unchained Ogg-Vorbis stream, this returns an empty block.
+    */
+    static MemoryBlock createSeekIndex (InputStream& source);
+
+    /** Creates a reader that uses a seek index previously built by createSeekIndex().
+
+        If the index doesn't match the stream (e.g. because the file has changed since
+        the index was built), it is ignored and the reader seeks in the usual way.
+    */
+    AudioFormatReader* createReaderFor (InputStream* sourceStream,
+                                        bool deleteStreamIfOpeningFails,
+                                        const MemoryBlock& seekIndex);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OggVorbisAudioFormat)
 };
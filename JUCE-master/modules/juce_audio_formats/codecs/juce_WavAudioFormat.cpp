@@ -1870,7 +1870,7 @@ public:
         if (numSamples <= 0)
             return true;
 
-        if (map == nullptr || ! mappedSection.contains (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
+        if (! ensureSectionIsMapped (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
         {
             jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
             return false;
@@ -1913,7 +1913,7 @@ public:
     {
         numSamples = jmin (numSamples, lengthInSamples - startSampleInFile);
 
-        if (map == nullptr || numSamples <= 0 || ! mappedSection.contains (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
+        if (numSamples <= 0 || ! ensureSectionIsMapped (Range<int64> (startSampleInFile, startSampleInFile + numSamples)))
         {
             jassert (numSamples <= 0); // you must make sure that the window contains all the samples you're going to attempt to read.
 
@@ -1982,6 +1982,18 @@ bool WavAudioFormat::isChannelLayoutSupported (const AudioChannelSet& channelSet
     return true;
 }
 
+AudioFormat::HeaderMatch WavAudioFormat::matchesHeader (const void* headerData, size_t numBytes)
+{
+    auto* bytes = static_cast<const char*> (headerData);
+
+    if (numBytes >= 12
+         && (memcmp (bytes, "RIFF", 4) == 0 || memcmp (bytes, "RF64", 4) == 0)
+         && memcmp (bytes + 8, "WAVE", 4) == 0)
+        return HeaderMatch::yes;
+
+    return HeaderMatch::no;
+}
+
 AudioFormatReader* WavAudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<WavAudioFormatReader> r (new WavAudioFormatReader (sourceStream));
@@ -2274,6 +2286,51 @@ struct WaveAudioFormatTests final : public UnitTest
                 expect (reader->metadataValues.getValue (WavAudioFormat::aswgVersion, "") == "3.01");
             }
         }
+
+        beginTest ("Memory-mapped readers can map a sliding window of the file");
+        {
+            constexpr int numChannels = 2, numSamples = 200000, windowSize = 10000;
+
+            AudioBuffer<float> source (numChannels, numSamples);
+            auto random = getRandom();
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    source.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+            TemporaryFile tempFile (".wav");
+            WavAudioFormat wavFormat;
+
+            {
+                auto writer = rawToUniquePtr (wavFormat.createWriterFor (tempFile.getFile().createOutputStream().release(),
+                                                                      44100.0, numChannels, 24, {}, 0));
+                expect (writer != nullptr);
+                expect (writer->writeFromAudioSampleBuffer (source, 0, numSamples));
+            }
+
+            auto streamReader = rawToUniquePtr (wavFormat.createReaderFor (tempFile.getFile().createInputStream().release(), true));
+            auto mappedReader = rawToUniquePtr (wavFormat.createMemoryMappedReader (tempFile.getFile()));
+            expect (streamReader != nullptr && mappedReader != nullptr);
+
+            mappedReader->setSlidingWindowSize (windowSize);
+            mappedReader->setReadAheadSize (4096);
+
+            AudioBuffer<float> expected (numChannels, 3000), actual (numChannels, 3000);
+            bool allMatch = true;
+
+            for (int pos = 0; pos < numSamples; pos += 3000)
+            {
+                streamReader->read (&expected, 0, 3000, pos, true, true);
+                expect (mappedReader->read (&actual, 0, 3000, pos, true, true));
+                allMatch = allMatch && expected == actual;
+
+                // The start of the mapping gets rounded down to a page boundary
+                expect (mappedReader->getMappedSection().getLength() <= windowSize + 4096);
+            }
+
+            expect (allMatch);
+            expect (mappedReader->getNumBytesUsed() < (size_t) (windowSize + 8192) * 6);
+        }
     }
 
 private:
@@ -289,6 +289,7 @@ public:
     bool canDoStereo() override;
     bool canDoMono() override;
     bool isChannelLayoutSupported (const AudioChannelSet& channelSet) override;
+    HeaderMatch matchesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
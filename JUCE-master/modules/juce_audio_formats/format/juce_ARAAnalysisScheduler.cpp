@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+struct ARAAnalysisScheduler::Task
+{
+    enum class State { pending, running, finished };
+
+    ARAAudioSource* audioSource;
+    std::unique_ptr<ARAAudioSourceReader> reader;
+    std::unique_ptr<Analyser> analyser;
+    int64 requestNumber;
+    bool visible = false;
+
+    State state = State::pending;       // guarded by the scheduler's lock
+    bool succeeded = false;
+    std::atomic<bool> cancelled { false };
+    WaitableEvent finishedEvent { true };
+};
+
+//==============================================================================
+class ARAAnalysisScheduler::Worker  : public ThreadPoolJob
+{
+public:
+    explicit Worker (ARAAnalysisScheduler& s)
+        : ThreadPoolJob ("ARA analysis"), scheduler (s)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        // There's one job for each request, but each job picks the most urgent
+        // task when it starts, rather than the one it was added for.
+        if (auto* task = scheduler.startNextTask())
+            scheduler.runTask (*task, *this);
+
+        return jobHasFinished;
+    }
+
+private:
+    ARAAnalysisScheduler& scheduler;
+};
+
+//==============================================================================
+ARAAnalysisScheduler::ARAAnalysisScheduler (AnalyserFactory createAnalyser, int numThreads, int samplesPerChunk)
+    : analyserFactory (std::move (createAnalyser)),
+      chunkSize (jmax (1, samplesPerChunk)),
+      pool (ThreadPoolOptions{}.withThreadName ("ARA analysis")
+                               .withNumberOfThreads (jmax (1, numThreads)))
+{
+    jassert (analyserFactory != nullptr);
+}
+
+ARAAnalysisScheduler::~ARAAnalysisScheduler()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    cancelTasks (nullptr, false);
+    pool.removeAllJobs (true, 10000);
+
+    cancelPendingUpdate();
+    removeTasks (false);
+}
+
+//==============================================================================
+void ARAAnalysisScheduler::requestAnalysis (ARAAudioSource& audioSource)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (findTask (audioSource) != nullptr)
+        return;
+
+    auto analyser = analyserFactory (audioSource);
+
+    if (analyser == nullptr)
+        return;
+
+    auto task = std::make_unique<Task>();
+    task->audioSource = &audioSource;
+    task->reader = std::make_unique<ARAAudioSourceReader> (&audioSource);
+    task->analyser = std::move (analyser);
+
+    audioSource.addListener (this);
+
+    {
+        const ScopedLock sl (lock);
+        task->requestNumber = nextRequestNumber++;
+        tasks.push_back (std::move (task));
+    }
+
+    pool.addJob (new Worker (*this), true);
+}
+
+void ARAAnalysisScheduler::cancelAnalysis (ARAAudioSource& audioSource)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    cancelTasks (&audioSource, true);
+    removeTasks (true);
+}
+
+bool ARAAnalysisScheduler::isAnalysing (const ARA::PlugIn::AudioSource& audioSource) const
+{
+    return findTask (audioSource) != nullptr;
+}
+
+int ARAAnalysisScheduler::getNumPendingAnalyses() const
+{
+    const ScopedLock sl (lock);
+
+    return (int) std::count_if (tasks.begin(), tasks.end(), [] (const auto& task)
+    {
+        return task->state != Task::State::finished && ! task->cancelled;
+    });
+}
+
+//==============================================================================
+void ARAAnalysisScheduler::prioritiseVisibleAudioSources (ARADocument& document, const ARAEditorView* view)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    std::set<const ARAAudioSource*> visibleSources;
+
+    for (auto* regionSequence : document.getRegionSequences())
+    {
+        if (view != nullptr)
+        {
+            const auto& hidden = view->getHiddenRegionSequences();
+
+            if (std::find (hidden.begin(), hidden.end(), regionSequence) != hidden.end())
+                continue;
+        }
+
+        for (auto* playbackRegion : regionSequence->getPlaybackRegions())
+            visibleSources.insert (playbackRegion->getAudioModification()->getAudioSource());
+    }
+
+    const ScopedLock sl (lock);
+
+    for (auto& task : tasks)
+        task->visible = visibleSources.count (task->audioSource) != 0;
+}
+
+//==============================================================================
+ARAAnalysisScheduler::Task* ARAAnalysisScheduler::findTask (const ARA::PlugIn::AudioSource& audioSource) const
+{
+    const ScopedLock sl (lock);
+
+    for (auto& task : tasks)
+        if (task->audioSource == &audioSource && task->state != Task::State::finished && ! task->cancelled)
+            return task.get();
+
+    return nullptr;
+}
+
+ARAAnalysisScheduler::Task* ARAAnalysisScheduler::startNextTask()
+{
+    const ScopedLock sl (lock);
+
+    Task* best = nullptr;
+
+    for (auto& task : tasks)
+    {
+        if (task->state != Task::State::pending || task->cancelled)
+            continue;
+
+        if (best == nullptr
+             || (task->visible && ! best->visible)
+             || (task->visible == best->visible && task->requestNumber < best->requestNumber))
+            best = task.get();
+    }
+
+    if (best != nullptr)
+        best->state = Task::State::running;
+
+    return best;
+}
+
+void ARAAnalysisScheduler::runTask (Task& task, const ThreadPoolJob& job)
+{
+    constexpr int readRetryIntervalMs = 50;
+    constexpr int readTimeoutMs = 2000;
+
+    auto& reader = *task.reader;
+    const auto shouldStop = [&] { return task.cancelled || job.shouldExit(); };
+
+    task.audioSource->notifyAnalysisProgressStarted();
+
+    AudioBuffer<float> buffer ((int) reader.numChannels, (int) jmin ((int64) chunkSize, jmax ((int64) 1, reader.lengthInSamples)));
+    bool succeeded = true;
+
+    for (int64 start = 0; start < reader.lengthInSamples && succeeded; start += buffer.getNumSamples())
+    {
+        const auto numSamples = (int) jmin ((int64) buffer.getNumSamples(), reader.lengthInSamples - start);
+
+        // A read fails while the host has disabled access to the samples, so give it
+        // a little while to turn it back on before abandoning the analysis.
+        for (int waited = 0;; waited += readRetryIntervalMs)
+        {
+            if (shouldStop() || waited > readTimeoutMs)
+            {
+                succeeded = false;
+                break;
+            }
+
+            if (reader.read (&buffer, 0, numSamples, start, true, true))
+                break;
+
+            Thread::sleep (readRetryIntervalMs);
+        }
+
+        if (! succeeded)
+            break;
+
+        if (numSamples < buffer.getNumSamples())
+            buffer.setSize (buffer.getNumChannels(), numSamples, true, false, true);
+
+        succeeded = task.analyser->processSamples (buffer, start) && ! shouldStop();
+
+        if (succeeded)
+            task.audioSource->notifyAnalysisProgressUpdated ((float) (start + numSamples) / (float) reader.lengthInSamples);
+    }
+
+    task.audioSource->notifyAnalysisProgressCompleted();
+
+    {
+        const ScopedLock sl (lock);
+        task.succeeded = succeeded;
+        task.state = Task::State::finished;
+        task.finishedEvent.signal();
+    }
+
+    triggerAsyncUpdate();
+}
+
+void ARAAnalysisScheduler::cancelTasks (const ARA::PlugIn::AudioSource* audioSource, bool waitForWorkers)
+{
+    std::vector<Task*> running;
+
+    {
+        const ScopedLock sl (lock);
+
+        for (auto& task : tasks)
+        {
+            if (audioSource != nullptr && task->audioSource != audioSource)
+                continue;
+
+            task->cancelled = true;
+
+            if (task->state == Task::State::pending)
+                task->state = Task::State::finished;
+            else if (task->state == Task::State::running)
+                running.push_back (task.get());
+        }
+    }
+
+    // Only removeTasks() deletes tasks, and it's called on this thread, so these
+    // pointers stay valid while we wait.
+    if (waitForWorkers)
+        for (auto* task : running)
+            task->finishedEvent.wait();
+}
+
+void ARAAnalysisScheduler::removeTasks (bool onlyFinishedOnes)
+{
+    std::vector<std::unique_ptr<Task>> removed;
+
+    {
+        const ScopedLock sl (lock);
+
+        for (auto it = tasks.begin(); it != tasks.end();)
+        {
+            if (! onlyFinishedOnes || (*it)->state == Task::State::finished)
+            {
+                removed.push_back (std::move (*it));
+                it = tasks.erase (it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // The readers and listeners must be removed on the message thread, and
+    // analysisFinished() may request another analysis, so this happens outside the lock.
+    for (auto& task : removed)
+    {
+        if (task->succeeded && ! task->cancelled)
+            task->analyser->analysisFinished (*task->audioSource);
+
+        task->reader.reset();
+
+        const auto sourceHasOtherTasks = [&]
+        {
+            const ScopedLock sl (lock);
+
+            return std::any_of (tasks.begin(), tasks.end(), [&] (const auto& other)
+            {
+                return other->audioSource == task->audioSource;
+            });
+        }();
+
+        if (! sourceHasOtherTasks)
+            task->audioSource->removeListener (this);
+    }
+}
+
+void ARAAnalysisScheduler::handleAsyncUpdate()
+{
+    removeTasks (true);
+}
+
+//==============================================================================
+void ARAAnalysisScheduler::doUpdateAudioSourceContent (ARAAudioSource* audioSource, ARAContentUpdateScopes scopeFlags)
+{
+    // The reader stops working when the samples change, so the analysis can't finish.
+    // The host will request a new one if it needs it.
+    if (scopeFlags.affectSamples())
+    {
+        cancelTasks (audioSource, false);
+        triggerAsyncUpdate();
+    }
+}
+
+void ARAAnalysisScheduler::willDestroyAudioSource (ARAAudioSource* audioSource)
+{
+    cancelTasks (audioSource, true);
+    removeTasks (true);
+}
+
+} // namespace juce
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs the analysis of ARA audio sources on a pool of background threads.
+
+    ARA hosts ask plugins to analyse their audio sources through
+    ARADocumentControllerSpecialisation::doRequestAudioSourceContentAnalysis(). Forward those
+    requests to requestAnalysis(), and answer
+    ARADocumentControllerSpecialisation::doIsAudioSourceContentAnalysisIncomplete() with
+    isAnalysing() or with your own record of which results exist.
+
+    For each audio source, the scheduler creates an Analyser with the function passed to its
+    constructor. Each Analyser is then fed all of the source's samples on one of the pool's
+    threads. The samples are read through an ARAAudioSourceReader in large chunks. The host is
+    told how far each analysis has got through the ARA analysis progress notifications. Once
+    all the samples have been processed, the Analyser's analysisFinished() method is called on
+    the message thread, so that it can store its results and call
+    ARAAudioSource::notifyContentChanged().
+
+    Sources that are waiting to be analysed are started in the order they were requested,
+    except that sources which can currently be seen go first, see prioritiseVisibleAudioSources().
+
+    An analysis is abandoned if its source is destroyed, if the source's samples change, or if
+    the samples can't be read for a while, for instance because the host has disabled sample
+    access. The host can then request the analysis again.
+
+    All the member functions must be called on the message thread, which is the ARA document
+    controller thread in JUCE plugins.
+
+    @tags{ARA}
+*/
+class JUCE_API  ARAAnalysisScheduler  : private ARAAudioSource::Listener,
+                                        private AsyncUpdater
+{
+public:
+    //==============================================================================
+    /** Performs the analysis of one audio source. */
+    class JUCE_API  Analyser
+    {
+    public:
+        /** Destructor. */
+        virtual ~Analyser() = default;
+
+        /** Called on a background thread with consecutive chunks of the audio source's
+            samples, starting with the first one.
+
+            Return false to abandon the analysis.
+        */
+        virtual bool processSamples (const AudioBuffer<float>& samples, int64 startSampleInSource) = 0;
+
+        /** Called on the message thread after all the samples of the source have been
+            processed.
+        */
+        virtual void analysisFinished (ARAAudioSource& audioSource) = 0;
+    };
+
+    /** Creates an Analyser for an audio source. This is called on the message thread. */
+    using AnalyserFactory = std::function<std::unique_ptr<Analyser> (ARAAudioSource&)>;
+
+    //==============================================================================
+    /** Creates a scheduler.
+
+        @param createAnalyser       creates an Analyser for each audio source to be analysed
+        @param numThreads           the number of sources that can be analysed at the same time
+        @param samplesPerChunk      the number of samples read from a source in one go
+    */
+    explicit ARAAnalysisScheduler (AnalyserFactory createAnalyser,
+                                   int numThreads = SystemStats::getNumCpus(),
+                                   int samplesPerChunk = 1 << 17);
+
+    /** Destructor. Abandons any analyses that haven't finished and waits for their
+        threads to stop.
+    */
+    ~ARAAnalysisScheduler() override;
+
+    //==============================================================================
+    /** Queues an audio source for analysis, unless it's already waiting or being analysed. */
+    void requestAnalysis (ARAAudioSource& audioSource);
+
+    /** Abandons the analysis of an audio source, waiting for it to stop if it has started. */
+    void cancelAnalysis (ARAAudioSource& audioSource);
+
+    /** Returns true if an audio source is waiting to be analysed or is being analysed. */
+    bool isAnalysing (const ARA::PlugIn::AudioSource& audioSource) const;
+
+    /** Returns the number of audio sources that are waiting to be analysed or are being
+        analysed.
+    */
+    int getNumPendingAnalyses() const;
+
+    //==============================================================================
+    /** Moves audio sources that can be seen in an editor view to the front of the queue.
+
+        A source can be seen if one of its playback regions is in a region sequence that the
+        view doesn't hide. If view is nullptr, every source with a playback region counts as
+        visible. Call this again whenever the view's hidden region sequences change, for
+        example from ARAEditorView::Listener::onHideRegionSequences().
+    */
+    void prioritiseVisibleAudioSources (ARADocument& document, const ARAEditorView* view);
+
+private:
+    //==============================================================================
+    struct Task;
+    class Worker;
+
+    Task* findTask (const ARA::PlugIn::AudioSource&) const;
+    Task* startNextTask();
+    void runTask (Task&, const ThreadPoolJob&);
+    void cancelTasks (const ARA::PlugIn::AudioSource*, bool waitForWorkers);
+    void removeTasks (bool onlyFinishedOnes);
+
+    void handleAsyncUpdate() override;
+
+    void doUpdateAudioSourceContent (ARAAudioSource*, ARAContentUpdateScopes) override;
+    void willDestroyAudioSource (ARAAudioSource*) override;
+
+    //==============================================================================
+    AnalyserFactory analyserFactory;
+    const int chunkSize;
+    ThreadPool pool;
+
+    CriticalSection lock;
+    std::vector<std::unique_ptr<Task>> tasks;
+    int64 nextRequestNumber = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ARAAnalysisScheduler)
+};
+
+} // namespace juce
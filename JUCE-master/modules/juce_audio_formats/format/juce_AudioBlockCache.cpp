@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioBlockCache::Block::Block (AudioFormatReader& reader, int64 startSample, int numSamples)
+    : range (startSample, startSample + numSamples),
+      buffer ((int) reader.numChannels, numSamples),
+      allSamplesRead (reader.read (&buffer, 0, numSamples, startSample, true, true))
+{
+}
+
+AudioBlockCache::AudioBlockCache (size_t maxSizeInBytes)
+    : maxSize (maxSizeInBytes)
+{
+}
+
+AudioBlockCache::~AudioBlockCache() = default;
+
+AudioBlockCache::BlockPtr AudioBlockCache::getBlock (const String& sourceIdentifier, int64 blockIndex)
+{
+    const ScopedLock sl (lock);
+
+    const auto found = index.find ({ sourceIdentifier, blockIndex });
+
+    if (found == index.end())
+        return {};
+
+    entries.splice (entries.begin(), entries, found->second);
+    return found->second->block;
+}
+
+AudioBlockCache::BlockPtr AudioBlockCache::getOrReadBlock (const String& sourceIdentifier, int64 blockIndex,
+                                                           int samplesPerBlock, AudioFormatReader& reader)
+{
+    if (auto existing = getBlock (sourceIdentifier, blockIndex))
+    {
+        jassert (existing->range.getLength() == samplesPerBlock);
+        return existing;
+    }
+
+    // The read happens without the lock held, so other sources aren't held up by it
+    auto block = std::make_shared<const Block> (reader, blockIndex * samplesPerBlock, samplesPerBlock);
+
+    if (block->allSamplesRead)
+        addBlock (sourceIdentifier, blockIndex, block);
+
+    return block;
+}
+
+void AudioBlockCache::addBlock (const String& sourceIdentifier, int64 blockIndex, BlockPtr block)
+{
+    jassert (block != nullptr);
+
+    const auto size = (size_t) block->buffer.getNumChannels() * (size_t) block->buffer.getNumSamples() * sizeof (float);
+    Key key { sourceIdentifier, blockIndex };
+
+    const ScopedLock sl (lock);
+
+    if (const auto found = index.find (key); found != index.end())
+        removeEntry (found->second);
+
+    entries.push_front ({ key, std::move (block), size });
+    index.emplace (std::move (key), entries.begin());
+    currentSize += size;
+
+    evictIfNeeded();
+}
+
+void AudioBlockCache::removeSource (const String& sourceIdentifier)
+{
+    const ScopedLock sl (lock);
+
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        const auto next = std::next (it);
+
+        if (it->key.source == sourceIdentifier)
+            removeEntry (it);
+
+        it = next;
+    }
+}
+
+void AudioBlockCache::clear()
+{
+    const ScopedLock sl (lock);
+    index.clear();
+    entries.clear();
+    currentSize = 0;
+}
+
+void AudioBlockCache::setMaximumSize (size_t maxSizeInBytes)
+{
+    const ScopedLock sl (lock);
+    maxSize = maxSizeInBytes;
+    evictIfNeeded();
+}
+
+size_t AudioBlockCache::getMaximumSize() const
+{
+    const ScopedLock sl (lock);
+    return maxSize;
+}
+
+size_t AudioBlockCache::getCurrentSize() const
+{
+    const ScopedLock sl (lock);
+    return currentSize;
+}
+
+int AudioBlockCache::getNumBlocks() const
+{
+    const ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+void AudioBlockCache::removeEntry (std::list<Entry>::iterator it)
+{
+    currentSize -= it->size;
+    index.erase (it->key);
+    entries.erase (it);
+}
+
+void AudioBlockCache::evictIfNeeded()
+{
+    while (currentSize > maxSize && ! entries.empty())
+        removeEntry (std::prev (entries.end()));
+}
+
+} // namespace juce
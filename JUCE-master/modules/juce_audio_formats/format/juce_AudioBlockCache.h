@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A memory-limited cache of decoded blocks of audio, which can be shared between
+    any number of readers that are streaming from the same sources.
+
+    Blocks are identified by a string naming their source (for example a file's
+    full path) and the index of the block within it. When the total size of the
+    cached blocks exceeds the limit, the least recently used blocks are dropped.
+    Blocks are handed out as shared pointers, so a block that is dropped from the
+    cache stays valid for as long as someone is still holding it.
+
+    All methods are thread-safe.
+
+    @see BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioBlockCache
+{
+public:
+    /** Creates a cache that will hold up to the given number of bytes of audio data. */
+    explicit AudioBlockCache (size_t maxSizeInBytes = 64 * 1024 * 1024);
+
+    /** Destructor. */
+    ~AudioBlockCache();
+
+    //==============================================================================
+    /** A decoded section of a source. */
+    struct Block
+    {
+        /** Reads a block from a reader. */
+        Block (AudioFormatReader& reader, int64 startSample, int numSamples);
+
+        Range<int64> range;
+        AudioBuffer<float> buffer;
+        bool allSamplesRead = false;
+    };
+
+    using BlockPtr = std::shared_ptr<const Block>;
+
+    /** Returns a cached block, or nullptr if it isn't in the cache. */
+    BlockPtr getBlock (const String& sourceIdentifier, int64 blockIndex);
+
+    /** Returns a cached block, reading it from the reader if it isn't in the cache yet.
+
+        The block covers samples [blockIndex * samplesPerBlock, (blockIndex + 1) * samplesPerBlock)
+        of the source, so everyone sharing a source identifier must use the same block size.
+        Blocks that couldn't be read completely are returned but not cached.
+    */
+    BlockPtr getOrReadBlock (const String& sourceIdentifier, int64 blockIndex,
+                             int samplesPerBlock, AudioFormatReader& reader);
+
+    /** Adds a block to the cache, replacing any existing block with the same key. */
+    void addBlock (const String& sourceIdentifier, int64 blockIndex, BlockPtr block);
+
+    /** Removes all the blocks belonging to a source, e.g. because its file has changed. */
+    void removeSource (const String& sourceIdentifier);
+
+    /** Removes all blocks. */
+    void clear();
+
+    //==============================================================================
+    /** Changes the size limit, dropping blocks if necessary. */
+    void setMaximumSize (size_t maxSizeInBytes);
+
+    /** Returns the size limit. */
+    size_t getMaximumSize() const;
+
+    /** Returns the number of bytes of audio data currently held. */
+    size_t getCurrentSize() const;
+
+    /** Returns the number of blocks currently held. */
+    int getNumBlocks() const;
+
+private:
+    struct Key
+    {
+        String source;
+        int64 index;
+
+        bool operator== (const Key& other) const noexcept   { return index == other.index && source == other.source; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator() (const Key& k) const noexcept     { return k.source.hash() ^ std::hash<int64>() (k.index); }
+    };
+
+    struct Entry
+    {
+        Key key;
+        BlockPtr block;
+        size_t size;
+    };
+
+    void removeEntry (std::list<Entry>::iterator);
+    void evictIfNeeded();
+
+    CriticalSection lock;
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    size_t maxSize, currentSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioBlockCache)
+};
+
+} // namespace juce
@@ -58,11 +58,21 @@ bool AudioFormat::canHandleFile (const File& f)
     return false;
 }
 
+AudioFormat::HeaderMatch AudioFormat::matchesHeader (const void*, size_t)
+{
+    return HeaderMatch::possibly;
+}
+
 const String& AudioFormat::getFormatName() const                { return formatName; }
 StringArray AudioFormat::getFileExtensions() const              { return fileExtensions; }
 bool AudioFormat::isCompressed()                                { return false; }
 StringArray AudioFormat::getQualityOptions()                    { return {}; }
 
+AudioFormatReader* AudioFormat::createMetadataReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails)
+{
+    return createReaderFor (sourceStream, deleteStreamIfOpeningFails);
+}
+
 MemoryMappedAudioFormatReader* AudioFormat::createMemoryMappedReader (const File&)
 {
     return nullptr;
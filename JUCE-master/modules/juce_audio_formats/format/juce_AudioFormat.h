@@ -72,6 +72,29 @@ public:
     */
     virtual bool canHandleFile (const File& fileToTest);
 
+    /** The result of checking whether the start of a stream looks like this format. */
+    enum class HeaderMatch
+    {
+        no,         /**< The data definitely isn't in this format. */
+        possibly,   /**< The format can't tell from the header alone. */
+        yes         /**< The header is one that this format recognises. */
+    };
+
+    /** The number of bytes from the start of a stream that are passed to matchesHeader(). */
+    static constexpr int numHeaderBytesToMatch = 16;
+
+    /** Checks the first few bytes of a stream to see whether it might be in this format.
+
+        The AudioFormatManager uses this to go straight to the right format for a file,
+        rather than trying to create a reader with every format in turn. The data may be
+        shorter than numHeaderBytesToMatch if the stream is very short.
+
+        Subclasses should only return HeaderMatch::no if createReaderFor() would certainly
+        fail for a stream beginning with this data. The default implementation returns
+        HeaderMatch::possibly.
+    */
+    virtual HeaderMatch matchesHeader (const void* headerData, size_t numBytes);
+
     /** Returns a set of sample rates that the format can read and write. */
     virtual Array<int> getPossibleSampleRates() = 0;
 
@@ -119,6 +142,20 @@ public:
     virtual AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                                 bool deleteStreamIfOpeningFails) = 0;
 
+    /** Tries to create a reader that's only going to be used to find out a stream's
+        properties and metadata.
+
+        This is intended for scanning large numbers of files. Formats can return a reader
+        that skips setting up their decoder until samples are actually read from it, so the
+        reader is still fully usable, but the first read may take longer.
+
+        The default implementation just calls createReaderFor().
+
+        @see createReaderFor, AudioFormatManager::createMetadataReaderFor
+    */
+    virtual AudioFormatReader* createMetadataReaderFor (InputStream* sourceStream,
+                                                        bool deleteStreamIfOpeningFails);
+
     /** Attempts to create a MemoryMappedAudioFormatReader, if possible for this format.
         If the format does not support this, the method will return nullptr;
     */
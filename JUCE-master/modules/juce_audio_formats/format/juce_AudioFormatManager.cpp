@@ -126,48 +126,211 @@ String AudioFormatManager::getWildcardForAllFormats() const
 }
 
 //==============================================================================
-AudioFormatReader* AudioFormatManager::createReaderFor (const File& file)
+//==============================================================================
+static AudioFormatReader* createReaderUsingHeader (const OwnedArray<AudioFormat>& formats,
+                                                   std::unique_ptr<InputStream> stream,
+                                                   const File* file,
+                                                   bool metadataOnly)
 {
     // you need to actually register some formats before the manager can
     // use them to open a file!
-    jassert (getNumKnownFormats() > 0);
+    jassert (formats.size() > 0);
 
-    for (auto* af : knownFormats)
-        if (af->canHandleFile (file))
-            if (auto in = file.createInputStream())
-                if (auto* r = af->createReaderFor (in.release(), true))
-                    return r;
+    if (stream == nullptr)
+        return nullptr;
+
+    const auto originalStreamPos = stream->getPosition();
+
+    uint8 header[AudioFormat::numHeaderBytesToMatch];
+    const auto headerSize = (size_t) jmax (0, stream->read (header, (int) sizeof (header)));
+    stream->setPosition (originalStreamPos);
+
+    // the stream that is passed-in must be capable of being repositioned so
+    // that all the formats can have a go at opening it.
+    jassert (stream->getPosition() == originalStreamPos);
+
+    Array<AudioFormat*> candidates;
+    int numMatches = 0;
+
+    for (auto* af : formats)
+    {
+        const auto match = af->matchesHeader (header, headerSize);
+
+        if (match == AudioFormat::HeaderMatch::yes)
+            candidates.insert (numMatches++, af);
+        else if (match == AudioFormat::HeaderMatch::possibly && (file == nullptr || af->canHandleFile (*file)))
+            candidates.add (af);
+    }
+
+    for (auto* af : candidates)
+    {
+        auto* r = metadataOnly ? af->createMetadataReaderFor (stream.get(), false)
+                               : af->createReaderFor (stream.get(), false);
+
+        if (r != nullptr)
+        {
+            stream.release();
+            return r;
+        }
+
+        stream->setPosition (originalStreamPos);
+        jassert (stream->getPosition() == originalStreamPos);
+    }
 
     return nullptr;
 }
 
+AudioFormatReader* AudioFormatManager::createReaderFor (const File& file)
+{
+    return createReaderUsingHeader (knownFormats, file.createInputStream(), &file, false);
+}
+
 AudioFormatReader* AudioFormatManager::createReaderFor (std::unique_ptr<InputStream> audioFileStream)
 {
-    // you need to actually register some formats before the manager can
-    // use them to open a file!
-    jassert (getNumKnownFormats() > 0);
+    return createReaderUsingHeader (knownFormats, std::move (audioFileStream), nullptr, false);
+}
 
-    if (audioFileStream != nullptr)
+AudioFormatReader* AudioFormatManager::createMetadataReaderFor (const File& file)
+{
+    return createReaderUsingHeader (knownFormats, file.createInputStream(), &file, true);
+}
+
+AudioFormatReader* AudioFormatManager::createMetadataReaderFor (std::unique_ptr<InputStream> audioFileStream)
+{
+    return createReaderUsingHeader (knownFormats, std::move (audioFileStream), nullptr, true);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioFormatManagerTests final : public UnitTest
+{
+    AudioFormatManagerTests()
+        : UnitTest ("AudioFormatManager", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
     {
-        auto originalStreamPos = audioFileStream->getPosition();
+        AudioBuffer<float> source (2, 10000);
 
-        for (auto* af : knownFormats)
+        for (int ch = 0; ch < source.getNumChannels(); ++ch)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                source.setSample (ch, i, 0.5f * std::sin ((float) i * 0.01f * (float) (ch + 1)));
+
+        beginTest ("Streams are dispatched to the format that recognises their header");
         {
-            if (auto* r = af->createReaderFor (audioFileStream.get(), false))
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+
+            auto* counter = new CountingFormat();
+            manager.registerFormat (counter, false);
+
+            for (auto* format : manager)
             {
-                audioFileStream.release();
-                return r;
+                if (format == counter || format->getPossibleBitDepths().isEmpty())
+                    continue;
+
+                const auto data = encode (*format, source);
+
+                if (data.isEmpty())
+                    continue;
+
+                std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (std::make_unique<MemoryInputStream> (data, false)));
+                expect (reader != nullptr);
+
+                if (reader != nullptr)
+                {
+                    expectEquals (reader->getFormatName(), format->getFormatName());
+                    expectEquals ((int) reader->numChannels, source.getNumChannels());
+                }
             }
 
-            audioFileStream->setPosition (originalStreamPos);
+            expectEquals (counter->numReadersRequested, 0);
 
-            // the stream that is passed-in must be capable of being repositioned so
-            // that all the formats can have a go at opening it.
-            jassert (audioFileStream->getPosition() == originalStreamPos);
+            std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (std::make_unique<MemoryInputStream> ("not audio", 9, false)));
+            expect (reader == nullptr);
+            expectEquals (counter->numReadersRequested, 1);
         }
+
+       #if JUCE_USE_FLAC
+        beginTest ("A metadata reader reports the same properties and can still read");
+        {
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+
+            const auto data = encode (*manager.findFormatForFileExtension ("flac"), source);
+
+            std::unique_ptr<AudioFormatReader> full (manager.createReaderFor (std::make_unique<MemoryInputStream> (data, false)));
+            std::unique_ptr<AudioFormatReader> metadata (manager.createMetadataReaderFor (std::make_unique<MemoryInputStream> (data, false)));
+
+            expect (full != nullptr && metadata != nullptr);
+
+            if (full != nullptr && metadata != nullptr)
+            {
+                expectEquals (metadata->sampleRate, full->sampleRate);
+                expectEquals (metadata->lengthInSamples, full->lengthInSamples);
+                expectEquals ((int) metadata->numChannels, (int) full->numChannels);
+                expectEquals ((int) metadata->bitsPerSample, (int) full->bitsPerSample);
+
+                AudioBuffer<float> a (2, 3000), b (2, 3000);
+                full->read (&a, 0, a.getNumSamples(), 5000, true, true);
+                metadata->read (&b, 0, b.getNumSamples(), 5000, true, true);
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    a.addFrom (ch, 0, b, ch, 0, b.getNumSamples(), -1.0f);
+                    expect (exactlyEqual (a.getMagnitude (ch, 0, a.getNumSamples()), 0.0f));
+                }
+            }
+        }
+       #endif
     }
 
-    return nullptr;
-}
+    static MemoryBlock encode (AudioFormat& format, const AudioBuffer<float>& source)
+    {
+        MemoryBlock block;
+
+        if (std::unique_ptr<AudioFormatWriter> writer { format.createWriterFor (new MemoryOutputStream (block, false), 44100.0,
+                                                                                (unsigned int) source.getNumChannels(),
+                                                                                format.getPossibleBitDepths().getFirst(), {}, 0) })
+            writer->writeFromAudioSampleBuffer (source, 0, source.getNumSamples());
+
+        return block;
+    }
+
+    struct CountingFormat final : public AudioFormat
+    {
+        CountingFormat() : AudioFormat ("Counting", ".counting") {}
+
+        Array<int> getPossibleSampleRates() override        { return {}; }
+        Array<int> getPossibleBitDepths() override          { return {}; }
+        bool canDoStereo() override                         { return true; }
+        bool canDoMono() override                           { return true; }
+
+        AudioFormatReader* createReaderFor (InputStream* in, bool deleteStreamIfOpeningFails) override
+        {
+            ++numReadersRequested;
+
+            if (deleteStreamIfOpeningFails)
+                delete in;
+
+            return nullptr;
+        }
+
+        AudioFormatWriter* createWriterFor (OutputStream*, double, unsigned int, int, const StringPairArray&, int) override
+        {
+            return nullptr;
+        }
+
+        using AudioFormat::createWriterFor;
+
+        int numReadersRequested = 0;
+    };
+};
+
+static AudioFormatManagerTests audioFormatManagerTests;
+
+#endif
 
 } // namespace juce
@@ -129,6 +129,11 @@ public:
     /** Searches through the known formats to try to create a suitable reader for
         this file.
 
+        The first few bytes of the file are checked with AudioFormat::matchesHeader(),
+        and any format that recognises them is tried first. After that, the formats
+        that can't tell from the header are tried if they can handle the file's
+        extension.
+
         If none of the registered formats can open the file, it'll return nullptr.
         It's the caller's responsibility to delete the reader that is returned.
     */
@@ -148,6 +153,19 @@ public:
     */
     AudioFormatReader* createReaderFor (std::unique_ptr<InputStream> audioFileStream);
 
+    /** Like createReaderFor(), but uses AudioFormat::createMetadataReaderFor() to open
+        the file.
+
+        This is intended for scanning large numbers of files where only the properties
+        and metadata of each one are needed.
+    */
+    AudioFormatReader* createMetadataReaderFor (const File& audioFile);
+
+    /** Like createReaderFor(), but uses AudioFormat::createMetadataReaderFor() to open
+        the stream.
+    */
+    AudioFormatReader* createMetadataReaderFor (std::unique_ptr<InputStream> audioFileStream);
+
 private:
     //==============================================================================
     OwnedArray<AudioFormat> knownFormats;
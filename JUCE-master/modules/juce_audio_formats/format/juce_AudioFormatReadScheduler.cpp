@@ -0,0 +1,373 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioFormatReadScheduler::AudioFormatReadScheduler()
+    : Thread ("Audio Read Scheduler")
+{
+    startThread (Priority::high);
+}
+
+AudioFormatReadScheduler::~AudioFormatReadScheduler()
+{
+    {
+        const ScopedLock sl (queueLock);
+        pending.clear();
+    }
+
+    signalThreadShouldExit();
+    wakeUp.signal();
+    stopThread (4000);
+}
+
+int64 AudioFormatReadScheduler::submit (Request request)
+{
+    jassert (request.reader != nullptr && request.buffer != nullptr);
+    jassert (request.startSampleInDestBuffer >= 0
+             && request.startSampleInDestBuffer + request.numSamples <= request.buffer->getNumSamples());
+
+    int64 id;
+
+    {
+        const ScopedLock sl (queueLock);
+        id = nextRequestID++;
+        pending.push_back ({ std::move (request), id });
+    }
+
+    wakeUp.signal();
+    return id;
+}
+
+bool AudioFormatReadScheduler::cancel (int64 requestID)
+{
+    const ScopedLock sl (queueLock);
+
+    const auto it = std::find_if (pending.begin(), pending.end(),
+                                  [requestID] (const auto& p) { return p.id == requestID; });
+
+    if (it == pending.end())
+        return false;
+
+    pending.erase (it);
+    return true;
+}
+
+void AudioFormatReadScheduler::cancelAllRequestsFor (AudioFormatReader& reader)
+{
+    {
+        const ScopedLock sl (queueLock);
+
+        pending.erase (std::remove_if (pending.begin(), pending.end(),
+                                       [&reader] (const auto& p) { return p.request.reader == &reader; }),
+                       pending.end());
+    }
+
+    // The read lock is held for as long as a batch is in progress
+    const ScopedLock rl (readLock);
+}
+
+int AudioFormatReadScheduler::getNumPendingRequests() const
+{
+    const ScopedLock sl (queueLock);
+    return (int) pending.size();
+}
+
+void AudioFormatReadScheduler::setMaxCoalescedSamples (int numSamples)
+{
+    jassert (numSamples > 0);
+
+    const ScopedLock sl (queueLock);
+    maxCoalescedSamples = jmax (1, numSamples);
+}
+
+//==============================================================================
+void AudioFormatReadScheduler::run()
+{
+    while (! threadShouldExit())
+        if (! serviceNextRequests())
+            wakeUp.wait (500);
+}
+
+bool AudioFormatReadScheduler::serviceNextRequests()
+{
+    const ScopedLock rl (readLock);
+    Range<int64> range;
+    int numChannels = 0;
+
+    {
+        const ScopedLock sl (queueLock);
+
+        if (pending.empty())
+            return false;
+
+        // Earliest deadline first. Among equal deadlines, carry on forwards through the
+        // reader that was used last, then take the others in order of file position.
+        const auto comesBefore = [this] (const PendingRequest& pa, const PendingRequest& pb)
+        {
+            const auto& a = pa.request;
+            const auto& b = pb.request;
+
+            if (! exactlyEqual (a.deadlineMs, b.deadlineMs))
+                return a.deadlineMs < b.deadlineMs;
+
+            const auto continuesA = a.reader == lastReader && a.readerStartSample >= lastReadEnd;
+            const auto continuesB = b.reader == lastReader && b.readerStartSample >= lastReadEnd;
+
+            if (continuesA != continuesB)
+                return continuesA;
+
+            if (a.reader != b.reader)
+                return std::less<>() (a.reader, b.reader);
+
+            if (a.readerStartSample != b.readerStartSample)
+                return a.readerStartSample < b.readerStartSample;
+
+            return pa.id < pb.id;
+        };
+
+        const auto first = std::min_element (pending.begin(), pending.end(), comesBefore);
+        auto* reader = first->request.reader;
+        range = Range<int64>::withStartAndLength (first->request.readerStartSample, first->request.numSamples);
+
+        batch.clear();
+        batch.push_back (std::move (*first));
+        pending.erase (first);
+
+        // Pull in any other requests for the same reader that overlap or touch the range
+        for (bool addedAny = true; addedAny;)
+        {
+            addedAny = false;
+
+            for (auto it = pending.begin(); it != pending.end();)
+            {
+                const auto other = Range<int64>::withStartAndLength (it->request.readerStartSample, it->request.numSamples);
+                const auto combined = range.getUnionWith (other);
+
+                if (it->request.reader == reader
+                    && other.getStart() <= range.getEnd() && other.getEnd() >= range.getStart()
+                    && combined.getLength() <= maxCoalescedSamples)
+                {
+                    range = combined;
+                    batch.push_back (std::move (*it));
+                    it = pending.erase (it);
+                    addedAny = true;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    for (const auto& p : batch)
+        numChannels = jmax (numChannels, p.request.buffer->getNumChannels());
+
+    auto* reader = batch.front().request.reader;
+    bool succeeded;
+
+    if (batch.size() == 1)
+    {
+        const auto& r = batch.front().request;
+        succeeded = reader->read (r.buffer, r.startSampleInDestBuffer, r.numSamples, r.readerStartSample, true, true);
+    }
+    else
+    {
+        scratch.setSize (numChannels, (int) range.getLength(), false, false, true);
+        succeeded = reader->read (&scratch, 0, (int) range.getLength(), range.getStart(), true, true);
+
+        for (const auto& p : batch)
+        {
+            const auto& r = p.request;
+
+            for (int ch = 0; ch < r.buffer->getNumChannels(); ++ch)
+                r.buffer->copyFrom (ch, r.startSampleInDestBuffer, scratch, ch,
+                                    (int) (r.readerStartSample - range.getStart()), r.numSamples);
+        }
+    }
+
+    lastReader = reader;
+    lastReadEnd = range.getEnd();
+
+    for (auto& p : batch)
+        NullCheckedInvocation::invoke (p.request.onComplete, succeeded);
+
+    batch.clear();
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioFormatReadSchedulerTests final : public UnitTest
+{
+public:
+    AudioFormatReadSchedulerTests()  : UnitTest ("AudioFormatReadScheduler", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Requests are read in deadline and file order, and neighbours are coalesced");
+        {
+            AudioFormatReadScheduler scheduler;
+            std::vector<PositionReader*> log;
+            PositionReader a { log }, b { log };
+            a.gate.reset();
+
+            AudioBuffer<float> blocker (2, 10), a1 (2, 100), a2 (1, 100), b1 (2, 100), b2 (2, 100);
+            WaitableEvent allDone;
+            std::atomic<int> numCompleted { 0 };
+            const auto onComplete = [&] (bool ok)
+            {
+                expect (ok);
+
+                if (++numCompleted == 5)
+                    allDone.signal();
+            };
+
+            a.readAsync (scheduler, blocker, 0, 10, 5000, 0.0, onComplete);
+            a.started.wait (1000);
+
+            b.readAsync (scheduler, b2, 0, 100, 1000, 10.0, onComplete);
+            a.readAsync (scheduler, a2, 0, 100, 100, 20.0, onComplete);
+            a.readAsync (scheduler, a1, 0, 100, 0, 20.0, onComplete);
+            b.readAsync (scheduler, b1, 0, 100, 0, 10.0, onComplete);
+            expectEquals (scheduler.getNumPendingRequests(), 4);
+
+            a.gate.signal();
+            expect (allDone.wait (5000));
+
+            expect (a.reads == std::vector<Range<int64>> { { 5000, 5010 }, { 0, 200 } });
+            expect (b.reads == std::vector<Range<int64>> { { 0, 100 }, { 1000, 1100 } });
+
+            expect (log == std::vector<PositionReader*> { &a, &b, &b, &a });
+
+            expect (contains (a1, 0, 100, 2));
+            expect (contains (a2, 100, 100, 1));
+            expect (contains (b1, 0, 100, 2));
+            expect (contains (b2, 1000, 100, 2));
+        }
+
+        beginTest ("Cancelled requests aren't read");
+        {
+            AudioFormatReadScheduler scheduler;
+            std::vector<PositionReader*> log;
+            PositionReader a { log }, b { log };
+            a.gate.reset();
+
+            AudioBuffer<float> buffer (2, 100);
+            std::atomic<int> numCompleted { 0 };
+            const auto onComplete = [&] (bool) { ++numCompleted; };
+
+            a.readAsync (scheduler, buffer, 0, 10, 0, 0.0, onComplete);
+            a.started.wait (1000);
+
+            const auto id = b.readAsync (scheduler, buffer, 0, 100, 0, 0.0, onComplete);
+            a.readAsync (scheduler, buffer, 0, 100, 1000, 0.0, onComplete);
+            a.readAsync (scheduler, buffer, 0, 100, 2000, 0.0, onComplete);
+
+            expect (scheduler.cancel (id));
+            expect (! scheduler.cancel (id));
+
+            // This should remove the pending requests straight away, then wait for the blocked one
+            Thread::launch ([&a] { Thread::sleep (50); a.gate.signal(); });
+            scheduler.cancelAllRequestsFor (a);
+
+            expectEquals (scheduler.getNumPendingRequests(), 0);
+            expectEquals (numCompleted.load(), 1);
+            expect (b.reads.empty());
+            expect (a.reads == std::vector<Range<int64>> { { 0, 10 } });
+        }
+    }
+
+private:
+    struct PositionReader final : public AudioFormatReader
+    {
+        explicit PositionReader (std::vector<PositionReader*>& readLog)
+            : AudioFormatReader (nullptr, {}),
+              log (readLog)
+        {
+            sampleRate            = 44100.0;
+            bitsPerSample         = 32;
+            usesFloatingPointData = true;
+            lengthInSamples       = 100000;
+            numChannels           = 2;
+            gate.signal();
+        }
+
+        bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            started.signal();
+            gate.wait (5000);
+
+            log.push_back (this);
+            reads.push_back (Range<int64>::withStartAndLength (startSampleInFile, numSamples));
+
+            for (int ch = 0; ch < numDestChannels; ++ch)
+                if (auto* dest = reinterpret_cast<float*> (destChannels[ch]))
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = getValue (ch, startSampleInFile + i);
+
+            return true;
+        }
+
+        static float getValue (int channel, int64 position)
+        {
+            return (float) position + (float) channel * 0.5f;
+        }
+
+        std::vector<PositionReader*>& log;
+        WaitableEvent gate { true }, started;
+        std::vector<Range<int64>> reads;
+    };
+
+    static bool contains (const AudioBuffer<float>& buffer, int64 start, int numSamples, int numChannels)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                if (! exactlyEqual (buffer.getSample (ch, i), PositionReader::getValue (ch, start + i)))
+                    return false;
+
+        return true;
+    }
+};
+
+static AudioFormatReadSchedulerTests audioFormatReadSchedulerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Performs asynchronous reads from any number of AudioFormatReaders on a single
+    background thread.
+
+    Instead of giving each reader its own buffering thread, requests from all readers
+    are submitted to one scheduler, which services them in order of their deadlines.
+    Requests that share a deadline are grouped by reader and read in order of their
+    position in the file, and requests for neighbouring sections of the same reader
+    are coalesced into a single read.
+
+    A SharedResourcePointer<AudioFormatReadScheduler> can be used to share one
+    scheduler between unrelated parts of an app.
+
+    @see AudioFormatReader::readAsync, BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioFormatReadScheduler  : private Thread
+{
+public:
+    /** Creates a scheduler and starts its thread. */
+    AudioFormatReadScheduler();
+
+    /** Destructor.
+
+        Any requests that are still pending are discarded without their callbacks
+        being made.
+    */
+    ~AudioFormatReadScheduler() override;
+
+    //==============================================================================
+    /** Describes a section of a reader to read into an AudioBuffer. */
+    struct Request
+    {
+        /** The reader to read from. This must stay alive until the request has completed. */
+        AudioFormatReader* reader = nullptr;
+
+        /** The buffer to fill. This must stay alive until the request has completed. */
+        AudioBuffer<float>* buffer = nullptr;
+
+        int startSampleInDestBuffer = 0;
+        int numSamples = 0;
+        int64 readerStartSample = 0;
+
+        /** The time by which the data is needed, in terms of Time::getMillisecondCounterHiRes(). */
+        double deadlineMs = 0.0;
+
+        /** Called on the scheduler's thread once the data has been read. */
+        std::function<void (bool succeeded)> onComplete;
+    };
+
+    /** Adds a request to the queue, returning an ID that can be used to cancel it. */
+    int64 submit (Request request);
+
+    /** Removes a request from the queue.
+
+        Returns true if the request was removed before it was started, in which case its
+        callback won't be made. If the request is already being read, this returns false.
+    */
+    bool cancel (int64 requestID);
+
+    /** Removes all requests for a reader, and waits for any read from it that is
+        in progress to finish.
+
+        Call this before deleting a reader that may still have requests queued.
+    */
+    void cancelAllRequestsFor (AudioFormatReader& reader);
+
+    /** Returns the number of requests that haven't been started yet. */
+    int getNumPendingRequests() const;
+
+    /** Sets the largest number of samples that will be read in one go when coalescing
+        neighbouring requests. A single request larger than this is still read in one go.
+    */
+    void setMaxCoalescedSamples (int numSamples);
+
+private:
+    struct PendingRequest
+    {
+        Request request;
+        int64 id;
+    };
+
+    void run() override;
+    bool serviceNextRequests();
+
+    CriticalSection queueLock, readLock;
+    std::vector<PendingRequest> pending;
+    std::vector<PendingRequest> batch;
+    AudioBuffer<float> scratch;
+    WaitableEvent wakeUp;
+    AudioFormatReader* lastReader = nullptr;
+    int64 lastReadEnd = 0, nextRequestID = 1;
+    int maxCoalescedSamples = 65536;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatReadScheduler)
+};
+
+} // namespace juce
@@ -215,6 +215,26 @@ bool AudioFormatReader::read (AudioBuffer<float>* buffer,
                          readerStartSample, numTargetChannels, ! usesFloatingPointData);
 }
 
+int64 AudioFormatReader::readAsync (AudioFormatReadScheduler& scheduler,
+                                    AudioBuffer<float>& buffer,
+                                    int startSampleInDestBuffer,
+                                    int numSamples,
+                                    int64 readerStartSample,
+                                    double deadlineMs,
+                                    std::function<void (bool)> onComplete)
+{
+    AudioFormatReadScheduler::Request request;
+    request.reader = this;
+    request.buffer = &buffer;
+    request.startSampleInDestBuffer = startSampleInDestBuffer;
+    request.numSamples = numSamples;
+    request.readerStartSample = readerStartSample;
+    request.deadlineMs = deadlineMs;
+    request.onComplete = std::move (onComplete);
+
+    return scheduler.submit (std::move (request));
+}
+
 void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples,
                                        Range<float>* const results, const int channelsToRead)
 {
@@ -440,6 +460,41 @@ void MemoryMappedAudioFormatReader::touchSample (int64 sample) const noexcept
         memoryReadDummyVariable += *(char*) sampleToPointer (sample);
     else
         jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
+
+    if (readAheadSize > 0)
+        prefetchSamples ({ sample, sample + readAheadSize });
+}
+
+void MemoryMappedAudioFormatReader::prefetchSamples (Range<int64> samples) const noexcept
+{
+    if (map != nullptr)
+        map->prefetch ({ sampleToFilePos (samples.getStart()), sampleToFilePos (samples.getEnd()) });
+}
+
+bool MemoryMappedAudioFormatReader::ensureSectionIsMapped (Range<int64> samples)
+{
+    if (map == nullptr || ! mappedSection.contains (samples))
+    {
+        if (slidingWindowSize <= 0)
+            return false;
+
+        const auto start = jlimit ((int64) 0, lengthInSamples, samples.getStart());
+        const auto end = jmin (lengthInSamples, start + jmax (slidingWindowSize, samples.getLength()));
+
+        if (! mapSectionOfFile ({ start, end }) || ! mappedSection.contains (samples))
+            return false;
+
+        prefetchedUpTo = start;
+    }
+
+    // Only ask for more once the reads have used up half of the last read-ahead
+    if (readAheadSize > 0 && samples.getEnd() + readAheadSize / 2 > prefetchedUpTo)
+    {
+        prefetchedUpTo = jmin (mappedSection.getEnd(), samples.getEnd() + readAheadSize);
+        prefetchSamples ({ samples.getEnd(), prefetchedUpTo });
+    }
+
+    return true;
 }
 
 } // namespace juce
@@ -36,6 +36,7 @@ namespace juce
 {
 
 class AudioFormat;
+class AudioFormatReadScheduler;
 
 
 //==============================================================================
@@ -160,6 +161,29 @@ public:
                bool useReaderLeftChan,
                bool useReaderRightChan);
 
+    /** Asks an AudioFormatReadScheduler to fill a section of an AudioBuffer from this
+        reader on its background thread, and to call a function when it's done.
+
+        The data is read as if by calling read (&buffer, startSampleInDestBuffer, numSamples,
+        readerStartSample, true, true). The buffer and this reader must stay alive until
+        the callback has been made, or until the request has been cancelled. The callback
+        is made on the scheduler's thread.
+
+        @param scheduler    the scheduler that should perform the read
+        @param deadlineMs   a time, in terms of Time::getMillisecondCounterHiRes(), by which
+                            the data is needed. Requests with earlier deadlines are read first
+        @param onComplete   called with the result of the read
+        @returns    an ID that can be passed to AudioFormatReadScheduler::cancel()
+        @see AudioFormatReadScheduler
+    */
+    int64 readAsync (AudioFormatReadScheduler& scheduler,
+                     AudioBuffer<float>& buffer,
+                     int startSampleInDestBuffer,
+                     int numSamples,
+                     int64 readerStartSample,
+                     double deadlineMs,
+                     std::function<void (bool succeeded)> onComplete);
+
     /** Finds the highest and lowest sample levels from a section of the audio stream.
 
         This will read a block of samples from the stream, and measure the
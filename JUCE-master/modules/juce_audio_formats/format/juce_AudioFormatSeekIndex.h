@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+//==============================================================================
+/*  A sorted table of (sample position, stream byte position) pairs, used by the
+    compressed-format readers to jump close to a sample without having to scan
+    or bisect the stream.
+
+    The table can be flattened into a MemoryBlock so that applications can keep
+    it next to the file. Because the block records the length of the stream that
+    it was built from, a stale index will be rejected rather than used.
+*/
+struct AudioFormatSeekIndex
+{
+    struct Entry
+    {
+        int64 sample, byte;
+    };
+
+    std::vector<Entry> entries;
+    int64 streamLength = 0;
+
+    bool isEmpty() const noexcept   { return entries.empty(); }
+
+    /*  Returns the last entry at or before the given sample, or nullptr if there isn't one. */
+    const Entry* findEntryBefore (int64 sample) const noexcept
+    {
+        auto it = std::upper_bound (entries.begin(), entries.end(), sample,
+                                    [] (int64 s, const Entry& e) { return s < e.sample; });
+
+        return it == entries.begin() ? nullptr : &*std::prev (it);
+    }
+
+    MemoryBlock toMemoryBlock (int formatTag) const
+    {
+        MemoryOutputStream out;
+        out.writeInt (magicNumber);
+        out.writeInt (formatTag);
+        out.writeInt64 (streamLength);
+        out.writeInt ((int) entries.size());
+
+        for (auto& e : entries)
+        {
+            out.writeInt64 (e.sample);
+            out.writeInt64 (e.byte);
+        }
+
+        return out.getMemoryBlock();
+    }
+
+    /*  Returns an empty index if the data is malformed, was made by a different format,
+        or describes a stream of a different length.
+    */
+    static AudioFormatSeekIndex fromMemoryBlock (const MemoryBlock& data, int formatTag, int64 expectedStreamLength)
+    {
+        MemoryInputStream in (data, false);
+
+        if (in.readInt() != magicNumber
+             || in.readInt() != formatTag
+             || in.readInt64() != expectedStreamLength)
+            return {};
+
+        const auto numEntries = in.readInt();
+
+        if (numEntries < 0 || in.getNumBytesRemaining() != (int64) numEntries * 16)
+            return {};
+
+        AudioFormatSeekIndex result;
+        result.streamLength = expectedStreamLength;
+        result.entries.reserve ((size_t) numEntries);
+
+        for (int i = 0; i < numEntries; ++i)
+        {
+            const auto sample = in.readInt64();
+            const auto byte = in.readInt64();
+
+            if (! result.entries.empty() && sample <= result.entries.back().sample)
+                return {};
+
+            result.entries.push_back ({ sample, byte });
+        }
+
+        return result;
+    }
+
+    static constexpr int magicNumber = 0x494b534a; // "JSKI"
+};
+
+} // namespace juce::detail
@@ -38,9 +38,28 @@ namespace juce
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, timeSliceThread, samplesToBuffer, nullptr, {})
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread& timeSliceThread,
+                                            int samplesToBuffer,
+                                            AudioBlockCache& blockCache,
+                                            const String& sourceIdentifier)
+    : BufferingAudioReader (sourceReader, timeSliceThread, samplesToBuffer, &blockCache, sourceIdentifier)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread& timeSliceThread,
+                                            int samplesToBuffer,
+                                            AudioBlockCache* blockCache,
+                                            const String& sourceIdentifier)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
       source (sourceReader), thread (timeSliceThread),
-      numBlocks (1 + (samplesToBuffer / samplesPerBlock))
+      numBlocks (1 + (samplesToBuffer / samplesPerBlock)),
+      cache (blockCache), cacheIdentifier (sourceIdentifier)
 {
     sampleRate            = source->sampleRate;
     lengthInSamples       = source->lengthInSamples;
@@ -122,20 +141,21 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
     return allSamplesRead;
 }
 
-BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples)
-    : range (pos, pos + numSamples),
-      buffer ((int) reader.numChannels, numSamples),
-      allSamplesRead (reader.read (&buffer, 0, numSamples, pos, true, true))
+const BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (int64 pos) const noexcept
 {
+    for (const auto& b : blocks)
+        if (b->range.contains (pos))
+            return b.get();
+
+    return nullptr;
 }
 
-BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (int64 pos) const noexcept
+AudioBlockCache::BlockPtr BufferingAudioReader::readBlock (int64 pos)
 {
-    for (auto* b : blocks)
-        if (b->range.contains (pos))
-            return b;
+    if (cache != nullptr)
+        return cache->getOrReadBlock (cacheIdentifier, pos / samplesPerBlock, samplesPerBlock, *source);
 
-    return nullptr;
+    return std::make_shared<const BufferedBlock> (*source, pos, samplesPerBlock);
 }
 
 int BufferingAudioReader::useTimeSlice()
@@ -148,35 +168,30 @@ bool BufferingAudioReader::readNextBufferChunk()
     auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
     auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
 
-    OwnedArray<BufferedBlock> newBlocks;
+    std::vector<AudioBlockCache::BlockPtr> newBlocks;
 
-    for (int i = blocks.size(); --i >= 0;)
-        if (blocks.getUnchecked (i)->range.intersects (Range<int64> (pos, endPos)))
-            newBlocks.add (blocks.getUnchecked (i));
+    for (const auto& b : blocks)
+        if (b->range.intersects (Range<int64> (pos, endPos)))
+            newBlocks.push_back (b);
 
-    if (newBlocks.size() == numBlocks)
-    {
-        newBlocks.clear (false);
+    if ((int) newBlocks.size() == numBlocks)
         return false;
-    }
 
     for (auto p = pos; p < endPos; p += samplesPerBlock)
     {
         if (getBlockContaining (p) == nullptr)
         {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
+            newBlocks.push_back (readBlock (p));
             break; // just do one block
         }
     }
 
     {
         const ScopedLock sl (lock);
-        newBlocks.swapWith (blocks);
+        newBlocks.swap (blocks);
     }
 
-    for (int i = blocks.size(); --i >= 0;)
-        newBlocks.removeObject (blocks.getUnchecked (i), false);
-
+    // The blocks that are no longer needed are released here, outside the lock
     return true;
 }
 
@@ -321,6 +336,85 @@ public:
                 expect (source == destination);
             }
         }
+
+        beginTest ("Readers sharing a block cache only decode each block once");
+        {
+            struct CountingReader final : public TestAudioFormatReader
+            {
+                using TestAudioFormatReader::TestAudioFormatReader;
+
+                bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                                  int64 startSampleInFile, int numSamples) override
+                {
+                    ++numReads;
+                    return TestAudioFormatReader::readSamples (destChannels, numDestChannels, startOffsetInDestBuffer,
+                                                               startSampleInFile, numSamples);
+                }
+
+                std::atomic<int> numReads { 0 };
+            };
+
+            Random random { getRandom() };
+            constexpr auto bufferSize = 100000;
+            const auto source = generateTestBuffer (random, bufferSize);
+
+            AudioBlockCache cache;
+            auto* firstSource = new CountingReader (&source);
+            auto* secondSource = new CountingReader (&source);
+
+            {
+                BufferingAudioReader reader (firstSource, thread, bufferSize, cache, "test");
+                reader.setReadTimeout (-1);
+
+                auto destination = generateTestBuffer (random, bufferSize);
+                read (reader, destination);
+                expect (source == destination);
+            }
+
+            const auto numBlocks = cache.getNumBlocks();
+            expect (numBlocks > 0);
+            expectEquals (cache.getCurrentSize(), (size_t) numBlocks * 2 * 32768 * sizeof (float));
+
+            BufferingAudioReader reader (secondSource, thread, bufferSize, cache, "test");
+            reader.setReadTimeout (-1);
+
+            auto destination = generateTestBuffer (random, bufferSize);
+            read (reader, destination);
+            expect (source == destination);
+            expectEquals (secondSource->numReads.load(), 0);
+        }
+
+        beginTest ("Block cache evicts the least recently used blocks");
+        {
+            const auto blockSize = 2 * 1000 * sizeof (float);
+            AudioBlockCache cache (3 * blockSize);
+
+            AudioBuffer<float> source (2, 10000);
+            source.clear();
+            TestAudioFormatReader sourceReader (&source);
+
+            AudioBlockCache::BlockPtr held;
+
+            for (int i = 0; i < 3; ++i)
+                if (auto block = cache.getOrReadBlock ("a", i, 1000, sourceReader); i == 1)
+                    held = block;
+
+            expect (cache.getBlock ("a", 0) != nullptr);
+
+            cache.getOrReadBlock ("b", 0, 1000, sourceReader);
+
+            expectEquals (cache.getNumBlocks(), 3);
+            expect (cache.getBlock ("a", 1) == nullptr);
+            expect (cache.getBlock ("a", 0) != nullptr);
+            expect (held != nullptr && held->range == Range<int64> (1000, 2000));
+
+            cache.removeSource ("a");
+            expectEquals (cache.getNumBlocks(), 1);
+            expectEquals (cache.getCurrentSize(), blockSize);
+
+            cache.setMaximumSize (0);
+            expectEquals (cache.getNumBlocks(), 0);
+        }
     }
 
 private:
@@ -62,6 +62,29 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader that shares its decoded blocks with other readers through a cache.
+
+        Any other reader that uses the same cache and source identifier will reuse blocks
+        that this one has decoded, and vice versa, so the identifier must be unique to the
+        audio data (for example a file's full path).
+
+        @param sourceReader     the source reader to wrap. This BufferingAudioReader
+                                takes ownership of this object and will delete it later
+                                when no longer needed
+        @param timeSliceThread  the thread that should be used to do the background reading.
+                                Make sure that the thread you supply is running, and won't
+                                be deleted while the reader object still exists.
+        @param samplesToBuffer  the total number of samples to buffer ahead.
+        @param blockCache       the cache to share blocks through. This must not be deleted
+                                while the reader object still exists.
+        @param sourceIdentifier identifies the source's audio data within the cache
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          TimeSliceThread& timeSliceThread,
+                          int samplesToBuffer,
+                          AudioBlockCache& blockCache,
+                          const String& sourceIdentifier);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -76,17 +99,13 @@ public:
                       int64 startSampleInFile, int numSamples) override;
 
 private:
-    struct BufferedBlock
-    {
-        BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples);
+    using BufferedBlock = AudioBlockCache::Block;
 
-        Range<int64> range;
-        AudioBuffer<float> buffer;
-        bool allSamplesRead = false;
-    };
+    BufferingAudioReader (AudioFormatReader*, TimeSliceThread&, int, AudioBlockCache*, const String&);
 
     int useTimeSlice() override;
-    BufferedBlock* getBlockContaining (int64 pos) const noexcept;
+    const BufferedBlock* getBlockContaining (int64 pos) const noexcept;
+    AudioBlockCache::BlockPtr readBlock (int64 pos);
     bool readNextBufferChunk();
 
     static constexpr int samplesPerBlock = 32768;
@@ -96,9 +115,11 @@ private:
     std::atomic<int64> nextReadPosition { 0 };
     const int numBlocks;
     int timeoutMs = 0;
+    AudioBlockCache* const cache;
+    const String cacheIdentifier;
 
     CriticalSection lock;
-    OwnedArray<BufferedBlock> blocks;
+    std::vector<AudioBlockCache::BlockPtr> blocks;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReader)
 };
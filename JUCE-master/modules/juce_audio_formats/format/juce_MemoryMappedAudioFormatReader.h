@@ -46,7 +46,9 @@ namespace juce
 
     Note that before reading samples from a MemoryMappedAudioFormatReader, you must first
     call mapEntireFile() or mapSectionOfFile() to ensure that the region you want to
-    read has been mapped.
+    read has been mapped, or call setSlidingWindowSize() to have the reader map a window
+    of the file around each read as it happens. The latter lets very large files be
+    read without reserving address space for the whole of them.
 
     @see AudioFormat::createMemoryMappedReader, AudioFormatReader
 
@@ -78,9 +80,53 @@ public:
     /** Returns the sample range that's currently memory-mapped and available for reading. */
     Range<int64> getMappedSection() const noexcept          { return mappedSection; }
 
-    /** Touches the memory for the given sample, to force it to be loaded into active memory. */
+    /** Touches the memory for the given sample, to force it to be loaded into active memory.
+
+        If a read-ahead size has been set, this also asks the OS to start loading the samples
+        that follow it.
+    */
     void touchSample (int64 sample) const noexcept;
 
+    //==============================================================================
+    /** Makes read operations map sections of the file on demand.
+
+        When this is non-zero, a read of samples that lie outside the mapped section will
+        replace the mapping with one that starts at the first sample being read and is at
+        least this many samples long, instead of failing. Zero turns this behaviour off,
+        which is the default.
+
+        Remapping isn't thread-safe, so only one thread should read from the reader when
+        this is enabled. getSample() never remaps, so it still needs the samples to have
+        been mapped already.
+    */
+    void setSlidingWindowSize (int64 numSamplesToMap) noexcept     { slidingWindowSize = jmax ((int64) 0, numSamplesToMap); }
+
+    /** Returns the size set by setSlidingWindowSize(). */
+    int64 getSlidingWindowSize() const noexcept                     { return slidingWindowSize; }
+
+    /** Sets a number of samples that the reader will ask the OS to start loading
+        beyond the end of each read, so that sequential reads don't stall on page faults.
+        Zero turns this off, which is the default.
+    */
+    void setReadAheadSize (int64 numSamples) noexcept               { readAheadSize = jmax ((int64) 0, numSamples); }
+
+    /** Returns the size set by setReadAheadSize(). */
+    int64 getReadAheadSize() const noexcept                         { return readAheadSize; }
+
+    /** Asks the OS to start loading the mapped memory for a range of samples.
+
+        This doesn't block, and only affects the part of the range that is currently mapped.
+    */
+    void prefetchSamples (Range<int64> samples) const noexcept;
+
+    /** Makes sure that a range of samples is mapped, moving the mapping if a sliding
+        window size has been set.
+
+        Returns false if the samples aren't mapped and couldn't be. Subclasses call this
+        before reading.
+    */
+    bool ensureSectionIsMapped (Range<int64> samples);
+
     /** Returns the samples for all channels at a given sample position.
         The result array must be large enough to hold a value for each channel
         that this reader contains.
@@ -96,6 +142,7 @@ protected:
     std::unique_ptr<MemoryMappedFile> map;
     int64 dataChunkStart, dataLength;
     int bytesPerFrame;
+    int64 slidingWindowSize = 0, readAheadSize = 0, prefetchedUpTo = 0;
 
     /** Converts a sample index to a byte position in the file. */
     inline int64 sampleToFilePos (int64 sample) const noexcept       { return dataChunkStart + sample * bytesPerFrame; }
@@ -0,0 +1,405 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class MultiTrackAudioWriter::IOThread final : public Thread
+{
+public:
+    explicit IOThread (MultiTrackAudioWriter& o)
+        : Thread ("MultiTrackAudioWriter"), owner (o)
+    {
+        startThread();
+    }
+
+    ~IOThread() override
+    {
+        signalThreadShouldExit();
+        owner.dataReady.signal();
+        stopThread (4000);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            // The timeout picks up tracks whose write() call crossed the threshold
+            // while every thread was busy with another track.
+            if (! owner.writeNextBlock (false))
+                owner.dataReady.wait (20);
+        }
+    }
+
+private:
+    MultiTrackAudioWriter& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (IOThread)
+};
+
+//==============================================================================
+MultiTrackAudioWriter::Track::Track (MultiTrackAudioWriter& o, std::unique_ptr<AudioFormatWriter> w, int numSamplesToBuffer)
+    : owner (o),
+      writer (std::move (w)),
+      fifo (numSamplesToBuffer + 1),
+      buffer ((int) writer->getNumChannels(), numSamplesToBuffer + 1),
+      writeThreshold (jmax (1, jmin (o.samplesPerBlock, numSamplesToBuffer / 2)))
+{
+}
+
+bool MultiTrackAudioWriter::Track::write (const float* const* data, int numSamples)
+{
+    if (numSamples <= 0)
+        return true;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    if (size1 + size2 < numSamples)
+    {
+        ++numOverruns;
+        return false;
+    }
+
+    for (int i = buffer.getNumChannels(); --i >= 0;)
+    {
+        buffer.copyFrom (i, start1, data[i], size1);
+        buffer.copyFrom (i, start2, data[i] + size1, size2);
+    }
+
+    fifo.finishedWrite (numSamples);
+
+    const auto numReady = fifo.getNumReady();
+    auto previousMax = highWaterMark.load();
+
+    while (numReady > previousMax && ! highWaterMark.compare_exchange_weak (previousMax, numReady))
+    {}
+
+    // Only wake the I/O threads when this block takes the track over its threshold, so
+    // that tracks filling in small increments don't signal on every callback.
+    if (numReady >= writeThreshold && numReady - numSamples < writeThreshold)
+        owner.dataReady.signal();
+
+    return true;
+}
+
+int MultiTrackAudioWriter::Track::writePendingData (int maxNumSamples)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (maxNumSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        writer->writeFromAudioSampleBuffer (buffer, start1, size1);
+
+    if (size2 > 0)
+        writer->writeFromAudioSampleBuffer (buffer, start2, size2);
+
+    fifo.finishedRead (size1 + size2);
+    numSamplesWritten += size1 + size2;
+    return size1 + size2;
+}
+
+//==============================================================================
+MultiTrackAudioWriter::MultiTrackAudioWriter (int numIOThreads, int samplesPerWriteBlock)
+    : samplesPerBlock (jmax (1, samplesPerWriteBlock))
+{
+    jassert (numIOThreads > 0);
+
+    for (int i = 0; i < jmax (1, numIOThreads); ++i)
+        threads.push_back (std::make_unique<IOThread> (*this));
+}
+
+MultiTrackAudioWriter::~MultiTrackAudioWriter()
+{
+    threads.clear();
+
+    while (tracks.size() > 0)
+        removeTrack (tracks.getLast());
+}
+
+MultiTrackAudioWriter::Track* MultiTrackAudioWriter::addTrack (std::unique_ptr<AudioFormatWriter> writer, int numSamplesToBuffer)
+{
+    if (writer == nullptr || numSamplesToBuffer <= 0)
+    {
+        jassertfalse;
+        return nullptr;
+    }
+
+    std::unique_ptr<Track> track (new Track (*this, std::move (writer), numSamplesToBuffer));
+
+    const ScopedLock sl (tracksLock);
+    return tracks.add (std::move (track));
+}
+
+void MultiTrackAudioWriter::removeTrack (Track* trackToRemove)
+{
+    if (trackToRemove == nullptr)
+        return;
+
+    claimTrack (*trackToRemove);
+
+    std::unique_ptr<Track> removed;
+
+    {
+        const ScopedLock sl (tracksLock);
+        jassert (tracks.contains (trackToRemove));
+
+        removed.reset (tracks.removeAndReturn (tracks.indexOf (trackToRemove)));
+    }
+
+    if (removed != nullptr)
+        while (removed->writePendingData (samplesPerBlock) > 0)
+        {}
+}
+
+int MultiTrackAudioWriter::getNumTracks() const
+{
+    const ScopedLock sl (tracksLock);
+    return tracks.size();
+}
+
+void MultiTrackAudioWriter::flush()
+{
+    while (writeNextBlock (true))
+    {}
+
+    Array<Track*> tracksToFlush;
+
+    {
+        const ScopedLock sl (tracksLock);
+
+        for (auto* track : tracks)
+            tracksToFlush.add (track);
+    }
+
+    for (auto* track : tracksToFlush)
+    {
+        claimTrack (*track);
+        track->writePendingData (track->fifo.getNumReady());
+        track->writer->flush();
+        releaseTrack (*track);
+    }
+}
+
+//==============================================================================
+MultiTrackAudioWriter::Track* MultiTrackAudioWriter::claimNextTrack (bool includePartialBlocks)
+{
+    const ScopedLock sl (tracksLock);
+
+    Track* best = nullptr;
+    double bestFullness = 0.0;
+
+    for (auto* track : tracks)
+    {
+        if (track->isBeingWritten)
+            continue;
+
+        const auto numReady = track->fifo.getNumReady();
+
+        if (numReady <= 0 || (! includePartialBlocks && numReady < track->writeThreshold))
+            continue;
+
+        const auto fullness = (double) numReady / (double) track->getBufferSize();
+
+        if (best == nullptr || fullness > bestFullness)
+        {
+            best = track;
+            bestFullness = fullness;
+        }
+    }
+
+    if (best != nullptr)
+        best->isBeingWritten = true;
+
+    return best;
+}
+
+void MultiTrackAudioWriter::claimTrack (Track& track)
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (tracksLock);
+
+            if (! track.isBeingWritten)
+            {
+                track.isBeingWritten = true;
+                return;
+            }
+        }
+
+        Thread::sleep (1);
+    }
+}
+
+void MultiTrackAudioWriter::releaseTrack (Track& track)
+{
+    const ScopedLock sl (tracksLock);
+    track.isBeingWritten = false;
+}
+
+bool MultiTrackAudioWriter::writeNextBlock (bool includePartialBlocks)
+{
+    if (auto* track = claimNextTrack (includePartialBlocks))
+    {
+        track->writePendingData (samplesPerBlock);
+        releaseTrack (*track);
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MultiTrackAudioWriterTests final : public UnitTest
+{
+    MultiTrackAudioWriterTests()
+        : UnitTest ("MultiTrackAudioWriter", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Every track is written completely and in order");
+        {
+            constexpr int numTracks = 24, numChannels = 2, totalSamples = 100000;
+            std::vector<MemoryBlock> files ((size_t) numTracks);
+            std::vector<MultiTrackAudioWriter::Track*> tracks;
+
+            {
+                MultiTrackAudioWriter recorder (3, 4096);
+
+                for (auto& file : files)
+                    tracks.push_back (recorder.addTrack (createWriter (file, numChannels), 20000));
+
+                expectEquals (recorder.getNumTracks(), numTracks);
+
+                AudioBuffer<float> block (numChannels, 1000);
+
+                for (int pos = 0; pos < totalSamples;)
+                {
+                    const auto numSamples = jmin (totalSamples - pos, 1 + random.nextInt (block.getNumSamples()));
+
+                    for (size_t t = 0; t < tracks.size(); ++t)
+                    {
+                        fillBlock (block, (int) t, pos, numSamples);
+
+                        while (! tracks[t]->write (block.getArrayOfReadPointers(), numSamples))
+                            Thread::sleep (1);
+                    }
+
+                    pos += numSamples;
+                }
+
+                recorder.flush();
+
+                for (auto* track : tracks)
+                {
+                    expectEquals (track->getNumSamplesBuffered(), 0);
+                    expectEquals (track->getNumSamplesWritten(), (int64) totalSamples);
+                    expect (track->getHighWaterMark() > 0);
+                    expect (track->getHighWaterMark() <= track->getBufferSize());
+                }
+
+                recorder.removeTrack (tracks.front());
+                expectEquals (recorder.getNumTracks(), numTracks - 1);
+            }
+
+            for (size_t t = 0; t < files.size(); ++t)
+            {
+                std::unique_ptr<AudioFormatReader> reader (WavAudioFormat().createReaderFor (new MemoryInputStream (files[t], false), true));
+                expect (reader != nullptr);
+
+                if (reader != nullptr)
+                {
+                    expectEquals (reader->lengthInSamples, (int64) totalSamples);
+
+                    AudioBuffer<float> expected (numChannels, totalSamples), actual (numChannels, totalSamples);
+                    fillBlock (expected, (int) t, 0, totalSamples);
+                    reader->read (&actual, 0, totalSamples, 0, true, true);
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        actual.addFrom (ch, 0, expected, ch, 0, totalSamples, -1.0f);
+                        expect (actual.getMagnitude (ch, 0, totalSamples) < 1.0e-4f);
+                    }
+                }
+            }
+        }
+
+        beginTest ("A full track rejects blocks and reports the overrun");
+        {
+            MemoryBlock file;
+            MultiTrackAudioWriter recorder (1, 4096);
+            auto* track = recorder.addTrack (createWriter (file, 1), 1000);
+
+            AudioBuffer<float> block (1, 2000);
+            block.clear();
+
+            expect (! track->write (block.getArrayOfReadPointers(), 2000));
+            expectEquals (track->getNumOverruns(), 1);
+            expectEquals (track->getNumSamplesBuffered(), 0);
+
+            expect (track->write (block.getArrayOfReadPointers(), 800));
+            expectEquals (track->getHighWaterMark(), 800);
+
+            track->resetHighWaterMark();
+            expectEquals (track->getHighWaterMark(), 0);
+        }
+    }
+
+    static std::unique_ptr<AudioFormatWriter> createWriter (MemoryBlock& block, int numChannels)
+    {
+        return std::unique_ptr<AudioFormatWriter> (WavAudioFormat().createWriterFor (new MemoryOutputStream (block, false),
+                                                                                     44100.0, (unsigned int) numChannels,
+                                                                                     24, {}, 0));
+    }
+
+    static void fillBlock (AudioBuffer<float>& block, int track, int startSample, int numSamples)
+    {
+        for (int ch = 0; ch < block.getNumChannels(); ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                block.setSample (ch, i, (float) (((startSample + i) * (track + 1) + ch * 17) % 1000) / 1000.0f - 0.5f);
+    }
+};
+
+static MultiTrackAudioWriterTests multiTrackAudioWriterTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Streams many AudioFormatWriters to disk from a small pool of shared I/O threads.
+
+    This does the same job as a set of AudioFormatWriter::ThreadedWriter objects, but
+    is designed for recording large numbers of tracks at once. Rather than polling each
+    track's FIFO in turn, the I/O threads are woken when a track has a full block ready,
+    and always service the track whose FIFO is closest to overflowing. Audio is passed
+    to each writer in large blocks, so that the file I/O happens in a few big writes
+    rather than many small ones.
+
+    Each track reports its buffer high-water mark and the number of blocks it has had to
+    reject, so that an app can warn the user when the disk isn't keeping up rather than
+    silently dropping audio.
+
+    @code
+    MultiTrackAudioWriter recorder (2);
+
+    auto* track = recorder.addTrack (std::move (writer), 48000 * 4);
+
+    // on the audio thread:
+    track->write (channelData, numSamples);
+
+    // on the message thread:
+    if (track->getHighWaterMark() > track->getBufferSize() * 3 / 4)
+        showDiskTooSlowWarning();
+
+    recorder.removeTrack (track);
+    @endcode
+
+    @see AudioFormatWriter::ThreadedWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  MultiTrackAudioWriter
+{
+public:
+    //==============================================================================
+    /** Creates a MultiTrackAudioWriter and starts its threads.
+
+        @param numIOThreads             the number of background threads that will share
+                                        the work of writing the tracks to disk
+        @param samplesPerWriteBlock     the number of samples that each track collects
+                                        before it's handed to its writer. Tracks whose
+                                        buffers are too small to hold two of these blocks
+                                        are written in half-buffer blocks instead.
+    */
+    explicit MultiTrackAudioWriter (int numIOThreads = 2, int samplesPerWriteBlock = 32768);
+
+    /** Destructor.
+        This writes any remaining data to the tracks' writers before deleting them.
+    */
+    ~MultiTrackAudioWriter();
+
+    //==============================================================================
+    /** A single track being recorded by a MultiTrackAudioWriter.
+
+        Track objects are created with MultiTrackAudioWriter::addTrack(), and stay
+        valid until they are passed to MultiTrackAudioWriter::removeTrack() or the
+        MultiTrackAudioWriter is deleted.
+    */
+    class JUCE_API  Track
+    {
+    public:
+        /** Pushes some incoming audio data into the track's FIFO.
+
+            This is safe to call from the audio thread. If there isn't enough free
+            space for all the samples, nothing is written, the track's overrun count
+            is incremented, and the method returns false.
+
+            The data must contain the same number of channels as the track's writer,
+            and none of the channels can be null.
+        */
+        bool write (const float* const* data, int numSamples);
+
+        /** Returns the number of samples that the track's FIFO can hold. */
+        int getBufferSize() const noexcept                      { return fifo.getTotalSize() - 1; }
+
+        /** Returns the number of samples that are waiting to be written to disk. */
+        int getNumSamplesBuffered() const noexcept              { return fifo.getNumReady(); }
+
+        /** Returns the largest number of samples that have been waiting in the FIFO
+            since the track was added, or since resetHighWaterMark() was last called.
+        */
+        int getHighWaterMark() const noexcept                   { return highWaterMark.load(); }
+
+        /** Resets the value returned by getHighWaterMark(). */
+        void resetHighWaterMark() noexcept                      { highWaterMark = 0; }
+
+        /** Returns the number of calls to write() that failed because the FIFO was full. */
+        int getNumOverruns() const noexcept                     { return numOverruns.load(); }
+
+        /** Returns the number of samples that have been passed to the writer so far. */
+        int64 getNumSamplesWritten() const noexcept             { return numSamplesWritten.load(); }
+
+    private:
+        friend class MultiTrackAudioWriter;
+
+        Track (MultiTrackAudioWriter&, std::unique_ptr<AudioFormatWriter>, int numSamplesToBuffer);
+
+        int writePendingData (int maxNumSamples);
+
+        MultiTrackAudioWriter& owner;
+        std::unique_ptr<AudioFormatWriter> writer;
+        AbstractFifo fifo;
+        AudioBuffer<float> buffer;
+        const int writeThreshold;
+        std::atomic<int> highWaterMark { 0 }, numOverruns { 0 };
+        std::atomic<int64> numSamplesWritten { 0 };
+        bool isBeingWritten = false;
+
+        JUCE_DECLARE_NON_COPYABLE (Track)
+    };
+
+    //==============================================================================
+    /** Adds a writer to be recorded to.
+
+        The MultiTrackAudioWriter takes ownership of the writer, and will delete it
+        when the track is removed. The returned object is owned by this class.
+
+        @param writer               the writer to stream the track's audio to
+        @param numSamplesToBuffer   the size of the track's FIFO
+    */
+    Track* addTrack (std::unique_ptr<AudioFormatWriter> writer, int numSamplesToBuffer);
+
+    /** Writes out any data that's still buffered for a track, then deletes it along
+        with its writer.
+    */
+    void removeTrack (Track* trackToRemove);
+
+    /** Returns the number of tracks. */
+    int getNumTracks() const;
+
+    /** Writes all the data that is currently buffered for every track, and then calls
+        AudioFormatWriter::flush() on each of their writers.
+
+        This mustn't be called at the same time as removeTrack().
+    */
+    void flush();
+
+private:
+    //==============================================================================
+    class IOThread;
+
+    Track* claimNextTrack (bool includePartialBlocks);
+    void claimTrack (Track&);
+    void releaseTrack (Track&);
+    bool writeNextBlock (bool includePartialBlocks);
+
+    const int samplesPerBlock;
+    CriticalSection tracksLock;
+    OwnedArray<Track> tracks;
+    WaitableEvent dataReady;
+    std::vector<std::unique_ptr<IOThread>> threads;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiTrackAudioWriter)
+};
+
+} // namespace juce
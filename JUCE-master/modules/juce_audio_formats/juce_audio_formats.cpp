@@ -67,7 +67,11 @@
 #include "format/juce_AudioFormatReaderSource.cpp"
 #include "format/juce_AudioFormatWriter.cpp"
 #include "format/juce_AudioSubsectionReader.cpp"
+#include "format/juce_AudioBlockCache.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
+#include "format/juce_AudioFormatReadScheduler.cpp"
+#include "format/juce_MultiTrackAudioWriter.cpp"
+#include "format/juce_AudioFormatSeekIndex.h"
 #include "sampler/juce_Sampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
@@ -80,6 +84,7 @@
 #if JucePlugin_Enable_ARA
  #include "juce_audio_processors/utilities/ARA/juce_ARADocumentControllerCommon.cpp"
  #include "format/juce_ARAAudioReaders.cpp"
+ #include "format/juce_ARAAnalysisScheduler.cpp"
 #endif
 
 #if JUCE_WINDOWS && JUCE_USE_WINDOWS_MEDIA_FORMAT
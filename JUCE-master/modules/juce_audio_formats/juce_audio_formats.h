@@ -127,7 +127,10 @@
 #include "format/juce_AudioFormatManager.h"
 #include "format/juce_AudioFormatReaderSource.h"
 #include "format/juce_AudioSubsectionReader.h"
+#include "format/juce_AudioBlockCache.h"
 #include "format/juce_BufferingAudioFormatReader.h"
+#include "format/juce_AudioFormatReadScheduler.h"
+#include "format/juce_MultiTrackAudioWriter.h"
 #include "codecs/juce_AiffAudioFormat.h"
 #include "codecs/juce_CoreAudioFormat.h"
 #include "codecs/juce_FlacAudioFormat.h"
@@ -142,4 +145,5 @@
  #include <juce_audio_processors/juce_audio_processors.h>
 
  #include "format/juce_ARAAudioReaders.h"
+ #include "format/juce_ARAAnalysisScheduler.h"
 #endif
@@ -46,21 +46,58 @@ SamplerSound::SamplerSound (const String& soundName,
       sourceSampleRate (source.sampleRate),
       midiNotes (notes),
       midiRootNote (midiNoteForNormalPitch)
+{
+    loadSamples (source, attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds, maxSampleLengthSeconds);
+}
+
+SamplerSound::SamplerSound (const String& soundName,
+                            std::unique_ptr<AudioFormatReader> sourceToStreamFrom,
+                            AudioBlockCache& cache,
+                            const String& identifier,
+                            const BigInteger& notes,
+                            int midiNoteForNormalPitch,
+                            double attackTimeSecs,
+                            double releaseTimeSecs,
+                            double maxSampleLengthSeconds,
+                            double preloadSeconds)
+    : name (soundName),
+      sourceSampleRate (sourceToStreamFrom->sampleRate),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch),
+      blockCache (&cache),
+      sourceIdentifier (identifier)
+{
+    loadSamples (*sourceToStreamFrom, attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds, preloadSeconds);
+
+    if (numPreloadedSamples < length)
+        streamSource = std::move (sourceToStreamFrom);
+}
+
+void SamplerSound::loadSamples (AudioFormatReader& source, double attackTimeSecs, double releaseTimeSecs,
+                                double maxSampleLengthSeconds, double preloadSeconds)
 {
     if (sourceSampleRate > 0 && source.lengthInSamples > 0)
     {
         length = jmin ((int) source.lengthInSamples,
                        (int) (maxSampleLengthSeconds * sourceSampleRate));
 
-        data.reset (new AudioBuffer<float> (jmin (2, (int) source.numChannels), length + 4));
+        numPreloadedSamples = jlimit (0, length, (int) (preloadSeconds * sourceSampleRate));
+
+        data.reset (new AudioBuffer<float> (jmin (2, (int) source.numChannels), numPreloadedSamples + 4));
 
-        source.read (data.get(), 0, length + 4, 0, true, true);
+        source.read (data.get(), 0, numPreloadedSamples + 4, 0, true, true);
 
         params.attack  = static_cast<float> (attackTimeSecs);
         params.release = static_cast<float> (releaseTimeSecs);
     }
 }
 
+AudioBlockCache::BlockPtr SamplerSound::readStreamBlock (int64 blockIndex)
+{
+    const ScopedLock sl (streamLock);
+    return blockCache->getOrReadBlock (sourceIdentifier, blockIndex, samplesPerStreamBlock, *streamSource);
+}
+
 SamplerSound::~SamplerSound()
 {
 }
@@ -75,18 +112,166 @@ bool SamplerSound::appliesToChannel (int /*midiChannel*/)
     return true;
 }
 
+//==============================================================================
+/*  Keeps the next few blocks of a streaming sound ready for a voice.
+
+    Each slot is handed back and forth between the two threads: the streaming thread
+    only fills slots that are empty, and the audio thread only reads slots that are
+    ready, and empties them again once it has moved past them. Blocks are only ever
+    released on the streaming thread.
+*/
+class SamplerVoice::Streamer final : private TimeSliceClient
+{
+public:
+    explicit Streamer (TimeSliceThread& t)  : thread (t)
+    {
+        thread.addTimeSliceClient (this);
+    }
+
+    ~Streamer() override
+    {
+        thread.removeTimeSliceClient (this);
+    }
+
+    // These are called on the audio thread
+    void start (SamplerSound& s) noexcept
+    {
+        {
+            const SpinLock::ScopedLockType sl (soundLock);
+            sound = &s;
+            ++generation;
+        }
+
+        releaseBlocksBefore (s.numPreloadedSamples / SamplerSound::samplesPerStreamBlock);
+    }
+
+    void stop() noexcept
+    {
+        {
+            const SpinLock::ScopedLockType sl (soundLock);
+            sound = nullptr;
+            ++generation;
+        }
+
+        releaseBlocksBefore (0);
+    }
+
+    const AudioBlockCache::Block* getBlock (int64 blockIndex) noexcept
+    {
+        auto& slot = getSlot (blockIndex);
+
+        if (slot.state.load (std::memory_order_acquire) != ready)
+            return nullptr;
+
+        if (slot.index == blockIndex && slot.generation == generation)
+            return slot.block.get();
+
+        // Left over from an earlier note, so let the streaming thread reuse it
+        if (slot.index < blockIndex || slot.generation != generation)
+            slot.state.store (empty, std::memory_order_release);
+
+        return nullptr;
+    }
+
+    void releaseBlocksBefore (int64 blockIndex) noexcept
+    {
+        for (auto& slot : slots)
+            if (slot.state.load (std::memory_order_acquire) == ready
+                 && (slot.index < blockIndex || slot.generation != generation))
+                slot.state.store (empty, std::memory_order_release);
+
+        firstBlockNeeded.store (blockIndex);
+    }
+
+private:
+    enum SlotState { empty, ready };
+
+    struct Slot
+    {
+        AudioBlockCache::BlockPtr block;
+        int64 index = -1;
+        uint32 generation = 0;
+        std::atomic<int> state { empty };
+    };
+
+    Slot& getSlot (int64 blockIndex) noexcept       { return slots[(size_t) (blockIndex % numSlots)]; }
+
+    int useTimeSlice() override
+    {
+        SynthesiserSound::Ptr soundToRead;
+        uint32 soundGeneration;
+
+        {
+            const SpinLock::ScopedLockType sl (soundLock);
+            soundToRead = sound;
+            soundGeneration = generation;
+        }
+
+        if (soundToRead == nullptr)
+        {
+            for (auto& slot : slots)
+                if (slot.state.load (std::memory_order_acquire) == empty)
+                    slot.block = nullptr;
+
+            return 20;
+        }
+
+        auto& s = *static_cast<SamplerSound*> (soundToRead.get());
+        const auto first = firstBlockNeeded.load();
+        const auto end = jmin (first + numSlots, (int64) (s.length + 1) / SamplerSound::samplesPerStreamBlock + 1);
+        auto didRead = false;
+
+        for (auto i = first; i < end; ++i)
+        {
+            auto& slot = getSlot (i);
+
+            if (slot.state.load (std::memory_order_acquire) != empty)
+                continue;
+
+            slot.block = s.readStreamBlock (i);
+            slot.index = i;
+            slot.generation = soundGeneration;
+            slot.state.store (ready, std::memory_order_release);
+            didRead = true;
+        }
+
+        return didRead ? 0 : 5;
+    }
+
+    static constexpr int64 numSlots = 4;
+
+    TimeSliceThread& thread;
+    std::array<Slot, (size_t) numSlots> slots;
+    std::atomic<int64> firstBlockNeeded { 0 };
+
+    SpinLock soundLock;
+    SynthesiserSound::Ptr sound;
+    uint32 generation = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Streamer)
+};
+
 //==============================================================================
 SamplerVoice::SamplerVoice() {}
+
+SamplerVoice::SamplerVoice (TimeSliceThread& streamingThread)
+    : streamer (std::make_unique<Streamer> (streamingThread))
+{
+}
+
 SamplerVoice::~SamplerVoice() {}
 
-bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
+bool SamplerVoice::canPlaySound (SynthesiserSound* s)
 {
-    return dynamic_cast<const SamplerSound*> (sound) != nullptr;
+    if (auto* sound = dynamic_cast<const SamplerSound*> (s))
+        return streamer != nullptr || ! sound->isStreaming();
+
+    return false;
 }
 
 void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
 {
-    if (auto* sound = dynamic_cast<const SamplerSound*> (s))
+    if (auto* sound = dynamic_cast<SamplerSound*> (s))
     {
         pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
                         * sound->sourceSampleRate / getSampleRate();
@@ -99,6 +284,9 @@ void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSou
         adsr.setParameters (sound->params);
 
         adsr.noteOn();
+
+        if (sound->isStreaming())
+            streamer->start (*sound);
     }
     else
     {
@@ -116,6 +304,9 @@ void SamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
     {
         clearCurrentNote();
         adsr.reset();
+
+        if (streamer != nullptr)
+            streamer->stop();
     }
 }
 
@@ -127,6 +318,12 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
 {
     if (auto* playingSound = static_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
     {
+        if (playingSound->isStreaming())
+        {
+            renderStreamedBlock (*playingSound, outputBuffer, startSample, numSamples);
+            return;
+        }
+
         auto& data = *playingSound->data;
         const float* const inL = data.getReadPointer (0);
         const float* const inR = data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr;
@@ -171,4 +368,167 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
     }
 }
 
+void SamplerVoice::renderStreamedBlock (SamplerSound& sound, AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    float* outL = outputBuffer.getWritePointer (0, startSample);
+    float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+    auto currentBlock = (int64) sourceSamplePosition / SamplerSound::samplesPerStreamBlock;
+
+    while (--numSamples >= 0)
+    {
+        auto pos = (int64) sourceSamplePosition;
+        auto alpha = (float) (sourceSamplePosition - (double) pos);
+        auto invAlpha = 1.0f - alpha;
+
+        float l0, r0, l1, r1;
+
+        // If the streaming thread has fallen behind, this plays silence rather than waiting for it
+        auto l = 0.0f, r = 0.0f;
+
+        if (getStreamedSample (sound, pos, l0, r0) && getStreamedSample (sound, pos + 1, l1, r1))
+        {
+            l = l0 * invAlpha + l1 * alpha;
+            r = r0 * invAlpha + r1 * alpha;
+        }
+
+        auto envelopeValue = adsr.getNextSample();
+
+        l *= lgain * envelopeValue;
+        r *= rgain * envelopeValue;
+
+        if (outR != nullptr)
+        {
+            *outL++ += l;
+            *outR++ += r;
+        }
+        else
+        {
+            *outL++ += (l + r) * 0.5f;
+        }
+
+        sourceSamplePosition += pitchRatio;
+
+        if (sourceSamplePosition > sound.length)
+        {
+            stopNote (0.0f, false);
+            return;
+        }
+
+        const auto block = (int64) sourceSamplePosition / SamplerSound::samplesPerStreamBlock;
+
+        if (block != currentBlock)
+        {
+            streamer->releaseBlocksBefore (block);
+            currentBlock = block;
+        }
+    }
+}
+
+bool SamplerVoice::getStreamedSample (const SamplerSound& sound, int64 position, float& left, float& right) noexcept
+{
+    if (position < sound.numPreloadedSamples)
+    {
+        left = sound.data->getSample (0, (int) position);
+        right = sound.data->getNumChannels() > 1 ? sound.data->getSample (1, (int) position) : left;
+        return true;
+    }
+
+    const auto blockIndex = position / SamplerSound::samplesPerStreamBlock;
+
+    if (auto* block = streamer->getBlock (blockIndex))
+    {
+        const auto& buffer = block->buffer;
+        const auto index = (int) (position - block->range.getStart());
+
+        left = buffer.getSample (0, index);
+        right = buffer.getNumChannels() > 1 ? buffer.getSample (1, index) : left;
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SamplerTests final : public UnitTest
+{
+public:
+    SamplerTests()  : UnitTest ("Sampler", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("A streaming sound plays the same audio as one held in memory");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 100000);
+
+            TimeSliceThread thread ("Sampler streaming");
+            thread.startThread();
+
+            AudioBlockCache cache;
+            BigInteger notes;
+            notes.setRange (0, 128, true);
+
+            Synthesiser inMemory, streaming;
+
+            TestAudioFormatReader reader (&source);
+            inMemory.addSound (new SamplerSound ("test", reader, notes, 60, 0.0, 0.0, 10.0));
+            inMemory.addVoice (new SamplerVoice());
+
+            auto* streamingSound = new SamplerSound ("test", std::make_unique<TestAudioFormatReader> (&source),
+                                                     cache, "test", notes, 60, 0.0, 0.0, 10.0, 0.5);
+            expect (streamingSound->isStreaming());
+            expectEquals (streamingSound->getAudioData()->getNumSamples(), 22050 + 4);
+
+            streaming.addSound (streamingSound);
+            streaming.addVoice (new SamplerVoice (thread));
+
+            for (auto* synth : { &inMemory, &streaming })
+                synth->setCurrentPlaybackSampleRate (44100.0);
+
+            constexpr auto blockSize = 512;
+            AudioBuffer<float> expected (2, blockSize), actual (2, blockSize);
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+
+            for (auto position = 0; position < source.getNumSamples(); position += blockSize)
+            {
+                // Give the streaming thread time to keep up
+                Thread::sleep (1);
+
+                expected.clear();
+                actual.clear();
+                inMemory.renderNextBlock (expected, midi, 0, blockSize);
+                streaming.renderNextBlock (actual, midi, 0, blockSize);
+                midi.clear();
+
+                expect (expected == actual);
+            }
+
+            expect (cache.getNumBlocks() > 0);
+        }
+
+        beginTest ("Voices without a streaming thread can't play streaming sounds");
+        {
+            AudioBuffer<float> source (1, 1000);
+            source.clear();
+
+            AudioBlockCache cache;
+            SamplerSound sound ("test", std::make_unique<TestAudioFormatReader> (&source),
+                                cache, "test", {}, 60, 0.0, 0.0, 10.0, 0.001);
+            expect (sound.isStreaming());
+
+            SamplerVoice voice;
+            expect (! voice.canPlaySound (&sound));
+        }
+    }
+};
+
+static SamplerTests samplerTests;
+
+#endif
+
 } // namespace juce
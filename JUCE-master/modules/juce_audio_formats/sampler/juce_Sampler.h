@@ -39,8 +39,9 @@ namespace juce
 /**
     A subclass of SynthesiserSound that represents a sampled audio clip.
 
-    This is a pretty basic sampler, and just attempts to load the whole audio stream
-    into memory.
+    This is a pretty basic sampler, which either loads the whole audio stream into
+    memory, or preloads the start of it and streams the rest from disk while it's
+    playing.
 
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
@@ -79,6 +80,41 @@ public:
                   double releaseTimeSecs,
                   double maxSampleLengthSeconds);
 
+    /** Creates a sampled sound that streams its audio from disk while it's playing.
+
+        Only the first preloadSeconds of the audio are read into memory here. The rest
+        is read in blocks on the streaming thread of each SamplerVoice that plays the
+        sound, and the blocks are kept in the given cache, so voices playing the same
+        sample share them. The preloaded section needs to be long enough to cover the
+        time it takes to read the first block after a note starts.
+
+        Only SamplerVoices that were created with a streaming thread can play these sounds.
+
+        @param name                 a name for the sample
+        @param sourceToStreamFrom   the audio to stream. This object takes ownership of it
+        @param blockCache           the cache to keep the decoded blocks in. This must stay
+                                    alive for as long as the sound does
+        @param sourceIdentifier     a name that's unique to the audio data, e.g. its file's
+                                    full path, used to identify its blocks in the cache
+        @param midiNotes            the set of midi keys that this sound should be played on
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate
+        @param attackTimeSecs       the attack (fade-in) time, in seconds
+        @param releaseTimeSecs      the decay (fade-out) time, in seconds
+        @param maxSampleLengthSeconds   a maximum length of audio to play, in seconds
+        @param preloadSeconds       how much of the start of the audio to keep in memory
+    */
+    SamplerSound (const String& name,
+                  std::unique_ptr<AudioFormatReader> sourceToStreamFrom,
+                  AudioBlockCache& blockCache,
+                  const String& sourceIdentifier,
+                  const BigInteger& midiNotes,
+                  int midiNoteForNormalPitch,
+                  double attackTimeSecs,
+                  double releaseTimeSecs,
+                  double maxSampleLengthSeconds,
+                  double preloadSeconds);
+
     /** Destructor. */
     ~SamplerSound() override;
 
@@ -87,10 +123,14 @@ public:
     const String& getName() const noexcept                  { return name; }
 
     /** Returns the audio sample data.
-        This could return nullptr if there was a problem loading the data.
+        This could return nullptr if there was a problem loading the data. For a
+        streaming sound, this only contains the preloaded section.
     */
     AudioBuffer<float>* getAudioData() const noexcept       { return data.get(); }
 
+    /** Returns true if this sound streams its audio rather than holding it all in memory. */
+    bool isStreaming() const noexcept                       { return streamSource != nullptr; }
+
     //==============================================================================
     /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
     void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
@@ -103,11 +143,22 @@ private:
     //==============================================================================
     friend class SamplerVoice;
 
+    void loadSamples (AudioFormatReader&, double attackTimeSecs, double releaseTimeSecs,
+                      double maxSampleLengthSeconds, double preloadSeconds);
+    AudioBlockCache::BlockPtr readStreamBlock (int64 blockIndex);
+
+    static constexpr int samplesPerStreamBlock = 32768;
+
     String name;
     std::unique_ptr<AudioBuffer<float>> data;
     double sourceSampleRate;
     BigInteger midiNotes;
-    int length = 0, midiRootNote = 0;
+    int length = 0, numPreloadedSamples = 0, midiRootNote = 0;
+
+    std::unique_ptr<AudioFormatReader> streamSource;
+    AudioBlockCache* blockCache = nullptr;
+    String sourceIdentifier;
+    CriticalSection streamLock;
 
     ADSR::Parameters params;
 
@@ -133,6 +184,13 @@ public:
     /** Creates a SamplerVoice. */
     SamplerVoice();
 
+    /** Creates a SamplerVoice that can also play streaming SamplerSounds.
+
+        The audio for those sounds is read on the given thread, which must be running
+        and must outlive the voice. Any number of voices can share a thread.
+    */
+    explicit SamplerVoice (TimeSliceThread& streamingThread);
+
     /** Destructor. */
     ~SamplerVoice() override;
 
@@ -150,11 +208,17 @@ public:
 
 private:
     //==============================================================================
+    class Streamer;
+
+    void renderStreamedBlock (SamplerSound&, AudioBuffer<float>&, int startSample, int numSamples);
+    bool getStreamedSample (const SamplerSound&, int64 position, float& left, float& right) noexcept;
+
     double pitchRatio = 0;
     double sourceSamplePosition = 0;
     float lgain = 0, rgain = 0;
 
     ADSR adsr;
+    std::unique_ptr<Streamer> streamer;
 
     JUCE_LEAK_DETECTOR (SamplerVoice)
 };
@@ -1662,6 +1662,8 @@ namespace AAXClasses
                         prepareProcessorWithSampleRateAndBufferSize (sampleRate, bufferSize);
                 }
 
+                AudioProcessLoadMeasurer::ScopedTimer timer (pluginInstance->getProcessLoadMeasurer(), buffer.getNumSamples());
+
                 if (bypass && pluginInstance->getBypassParameter() == nullptr)
                     pluginInstance->processBlockBypassed (buffer, midiBuffer);
                 else
@@ -2127,6 +2127,7 @@ private:
     {
         const ScopedLock sl (juceFilter->getCallbackLock());
         const ScopedPlayHead playhead { *this };
+        AudioProcessLoadMeasurer::ScopedTimer timer (juceFilter->getProcessLoadMeasurer(), buffer.getNumSamples());
 
         if (juceFilter->isSuspended())
         {
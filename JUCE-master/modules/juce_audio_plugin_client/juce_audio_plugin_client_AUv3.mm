@@ -557,6 +557,9 @@ public:
         midiMessages.ensureSize (2048);
         midiMessages.clear();
 
+        parameterChanges.ensureStorageAllocated (jmax (1024, 8 * processor.getParameters().size()));
+        parameterChanges.clear();
+
         hostMusicalContextCallback = [au musicalContextBlock];
         hostTransportStateCallback = [au transportStateBlock];
 
@@ -1502,6 +1505,9 @@ private:
                     if (auto* p = getJuceParameterForAUAddress (paramEvent.parameterAddress))
                     {
                         auto normalisedValue = paramEvent.value / getMaximumParameterValue (*p);
+
+                        // Ramps are reported as a jump to their target value at the start of the ramp
+                        parameterChanges.addEvent (*p, static_cast<int> (paramEvent.eventSampleTime - startTime), normalisedValue);
                         setAudioProcessorParameter (p, normalisedValue);
                     }
                 }
@@ -1523,6 +1529,7 @@ private:
         {
             // process params and incoming midi (only once for a given timestamp)
             midiMessages.clear();
+            parameterChanges.clear();
 
             const int numParams = juceParameters.getNumParameters();
             processEvents (realtimeEventListHead, numParams, static_cast<AUEventSampleTime> (timestamp->mSampleTime));
@@ -1659,6 +1666,9 @@ private:
     {
         auto& processor = getAudioProcessor();
         const ScopedLock sl (processor.getCallbackLock());
+        AudioProcessLoadMeasurer::ScopedTimer timer (processor.getProcessLoadMeasurer(), buffer.getNumSamples());
+
+        processor.setParameterChanges (&parameterChanges);
 
         if (processor.isSuspended())
             buffer.clear();
@@ -1666,6 +1676,8 @@ private:
             processor.processBlockBypassed (buffer, midiBuffer);
         else
             processor.processBlock (buffer, midiBuffer);
+
+        processor.setParameterChanges (nullptr);
     }
 
     //==============================================================================
@@ -1818,6 +1830,7 @@ private:
 
     OwnedArray<BusBuffer> inBusBuffers, outBusBuffers;
     MidiBuffer midiMessages;
+    AudioParameterChangeList parameterChanges;
     AUMIDIOutputEventBlock midiOutputEventBlock = nullptr;
 
    #if JUCE_APPLE_MIDI_EVENT_LIST_SUPPORTED
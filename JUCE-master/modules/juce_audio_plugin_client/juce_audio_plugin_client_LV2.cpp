@@ -595,6 +595,7 @@ public:
             else
             {
                 const auto isEnabled = ports.isEnabled();
+                AudioProcessLoadMeasurer::ScopedTimer timer (processor->getProcessLoadMeasurer(), audio.getNumSamples());
 
                 if (auto* param = processor->getBypassParameter())
                 {
@@ -469,6 +469,7 @@ private:
             else
             {
                 MidiBuffer mb;
+                AudioProcessLoadMeasurer::ScopedTimer timer (pluginInstance->getProcessLoadMeasurer(), scratchBuffer.getNumSamples());
 
                 if (isBypassed && pluginInstance->getBypassParameter() == nullptr)
                     pluginInstance->processBlockBypassed (scratchBuffer, mb);
@@ -483,6 +483,7 @@ public:
                 {
                     const int numChannels = jmax (numIn, numOut);
                     AudioBuffer<FloatType> chans (tmpBuffers.channels, isMidiEffect ? 0 : numChannels, numSamples);
+                    AudioProcessLoadMeasurer::ScopedTimer timer (processor->getProcessLoadMeasurer(), numSamples);
 
                     if (isBypassed && processor->getBypassParameter() == nullptr)
                         processor->processBlockBypassed (chans, midiEvents);
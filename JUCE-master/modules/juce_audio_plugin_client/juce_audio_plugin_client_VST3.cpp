@@ -3652,9 +3652,15 @@ public:
                 }
                 else
                #endif
-                if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
                 {
-                    if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                    {
+                        if (const auto change = getPointFromQueue (paramQueue, point))
+                            parameterChanges.addEvent (*param, (int) change->offsetSamples, (float) change->value);
+                    }
+
+                    if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
                         setValueAndNotifyIfChanged (*param, (float) change->value);
                 }
             }
@@ -3707,6 +3713,7 @@ public:
         }
 
         midiBuffer.clear();
+        parameterChanges.clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
@@ -3729,9 +3736,13 @@ public:
         // If all of these are zero, the host is attempting to flush parameters without processing audio.
         if (data.numSamples != 0 || data.numInputs != 0 || data.numOutputs != 0)
         {
+            pluginInstance->setParameterChanges (&parameterChanges);
+
             if      (processSetup.symbolicSampleSize == Vst::kSample32) processAudio<float>  (data);
             else if (processSetup.symbolicSampleSize == Vst::kSample64) processAudio<double> (data);
             else jassertfalse;
+
+            pluginInstance->setParameterChanges (nullptr);
         }
 
         if (auto* changes = data.outputParameterChanges)
@@ -3846,6 +3857,8 @@ private:
             }
             else
             {
+                AudioProcessLoadMeasurer::ScopedTimer timer (pluginInstance->getProcessLoadMeasurer(), buffer.getNumSamples());
+
                 // processBlockBypassed should only ever be called if the AudioProcessor doesn't
                 // return a valid parameter from getBypassParameter
                 if (pluginInstance->getBypassParameter() == nullptr && comPluginInstance->getBypassParameter()->getValue() >= 0.5f)
@@ -3902,6 +3915,9 @@ private:
         midiBuffer.ensureSize (2048);
         midiBuffer.clear();
 
+        parameterChanges.ensureStorageAllocated (jmax (1024, 8 * p.getParameters().size()));
+        parameterChanges.clear();
+
         bufferMapper.updateFromProcessor (p);
         bufferMapper.prepare (bufferSize);
     }
@@ -3975,6 +3991,7 @@ private:
     Vst::ProcessSetup processSetup;
 
     MidiBuffer midiBuffer;
+    AudioParameterChangeList parameterChanges;
     ClientBufferMapper bufferMapper;
 
     bool active = false;
@@ -149,6 +149,16 @@ public:
     /** Returns true if instantiation of this plugin type must be done from a non-message thread. */
     virtual bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const = 0;
 
+    /** Returns true if createPluginInstance() may be called for this description on a
+        background thread, and the new instance's state can be restored there too.
+
+        AudioPluginFormatManager::createPluginInstancesAsync() uses this to create plug-ins
+        in parallel, rather than one after another on the message thread. Only return true
+        if loading the module, creating the instance and calling setStateInformation() are
+        all safe to do on several threads at once.
+    */
+    virtual bool canCreateInstancesOnBackgroundThread (const PluginDescription&) const { return false; }
+
     /** A callback lambda that is passed to getARAFactory() */
     using ARAFactoryCreationCallback = std::function<void (ARAFactoryResult)>;
 
@@ -168,7 +178,8 @@ protected:
     AudioPluginFormat();
 
     /** Implementors must override this function. This is guaranteed to be called on
-        the message thread. You may call the callback on any thread.
+        the message thread, unless canCreateInstancesOnBackgroundThread() returns true
+        for the description. You may call the callback on any thread.
     */
     virtual void createPluginInstance (const PluginDescription&, double initialSampleRate,
                                        int initialBufferSize, PluginCreationCallback) = 0;
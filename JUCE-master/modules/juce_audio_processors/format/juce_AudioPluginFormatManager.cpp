@@ -185,6 +185,134 @@ void AudioPluginFormatManager::createPluginInstanceAsync (const PluginDescriptio
     new DeliverError (std::move (callback), error);
 }
 
+//==============================================================================
+struct AudioPluginFormatManager::BatchCreation
+{
+    std::vector<PluginInstanceRequest> requests;
+    double sampleRate;
+    int bufferSize;
+    BatchCreationCallback callback;
+    std::vector<int> messageThreadRequests;
+    size_t nextMessageThreadRequest = 0;
+};
+
+struct AudioPluginFormatManager::DeliverBatchResult final : public CallbackMessage
+{
+    DeliverBatchResult (std::shared_ptr<BatchCreation> b, int i, std::unique_ptr<AudioPluginInstance> p,
+                        const String& e, bool shouldRestoreState)
+        : batch (std::move (b)), index (i), instance (std::move (p)), error (e), restoreState (shouldRestoreState)
+    {
+        post();
+    }
+
+    void messageCallback() override
+    {
+        if (restoreState)
+            restorePluginState (instance.get(), batch->requests[(size_t) index].state);
+
+        batch->callback (index, std::move (instance), error);
+    }
+
+    static void restorePluginState (AudioPluginInstance* p, const MemoryBlock& state)
+    {
+        if (p != nullptr && ! state.isEmpty())
+            p->setStateInformation (state.getData(), (int) state.getSize());
+    }
+
+    std::shared_ptr<BatchCreation> batch;
+    int index;
+    std::unique_ptr<AudioPluginInstance> instance;
+    String error;
+    bool restoreState;
+};
+
+void AudioPluginFormatManager::createPluginInstancesAsync (std::vector<PluginInstanceRequest> requests,
+                                                           double initialSampleRate, int initialBufferSize,
+                                                           BatchCreationCallback callback)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert (callback != nullptr);
+
+    auto batch = std::make_shared<BatchCreation> (BatchCreation { std::move (requests), initialSampleRate,
+                                                                  initialBufferSize, std::move (callback), {} });
+
+    for (size_t i = 0; i < batch->requests.size(); ++i)
+    {
+        const auto index = (int) i;
+        const auto& description = batch->requests[i].description;
+        String error;
+
+        if (auto* format = findFormatForDescription (description, error))
+        {
+            if (! format->canCreateInstancesOnBackgroundThread (description))
+            {
+                batch->messageThreadRequests.push_back (index);
+                continue;
+            }
+
+            getCreationThreadPool().addJob ([batch, format, index]
+            {
+                const auto& request = batch->requests[(size_t) index];
+
+                format->createPluginInstance (request.description, batch->sampleRate, batch->bufferSize,
+                                              [batch, index] (std::unique_ptr<AudioPluginInstance> instance, const String& e)
+                                              {
+                                                  DeliverBatchResult::restorePluginState (instance.get(), batch->requests[(size_t) index].state);
+                                                  new DeliverBatchResult (batch, index, std::move (instance), e, false);
+                                              });
+            });
+        }
+        else
+        {
+            new DeliverBatchResult (batch, index, nullptr, error, false);
+        }
+    }
+
+    createNextOnMessageThread (std::move (batch));
+}
+
+void AudioPluginFormatManager::createNextOnMessageThread (std::shared_ptr<BatchCreation> batch)
+{
+    if (batch->nextMessageThreadRequest >= batch->messageThreadRequests.size())
+        return;
+
+    // Only one of these is posted at a time, so that the results coming back from the
+    // worker threads, and anything else that's queued, get a look in between plug-ins.
+    MessageManager::callAsync ([weakThis = WeakReference<AudioPluginFormatManager> (this), batch]
+    {
+        if (weakThis == nullptr)
+            return;
+
+        const auto index = batch->messageThreadRequests[batch->nextMessageThreadRequest++];
+        const auto& description = batch->requests[(size_t) index].description;
+        String error;
+
+        if (auto* format = weakThis->findFormatForDescription (description, error))
+        {
+            format->createPluginInstance (description, batch->sampleRate, batch->bufferSize,
+                                          [batch, index] (std::unique_ptr<AudioPluginInstance> instance, const String& e)
+                                          {
+                                              new DeliverBatchResult (batch, index, std::move (instance), e, true);
+                                          });
+        }
+        else
+        {
+            new DeliverBatchResult (batch, index, nullptr, error, false);
+        }
+
+        weakThis->createNextOnMessageThread (batch);
+    });
+}
+
+ThreadPool& AudioPluginFormatManager::getCreationThreadPool()
+{
+    if (creationThreadPool == nullptr)
+        creationThreadPool = std::make_unique<ThreadPool> (ThreadPoolOptions{}.withThreadName ("Plug-in creation")
+                                                                              .withNumberOfThreads (SystemStats::getNumCpus()));
+
+    return *creationThreadPool;
+}
+
 AudioPluginFormat* AudioPluginFormatManager::findFormatForDescription (const PluginDescription& description,
                                                                        String& errorMessage) const
 {
@@ -209,4 +337,124 @@ bool AudioPluginFormatManager::doesPluginStillExist (const PluginDescription& de
     return false;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_MODAL_LOOPS_PERMITTED
+
+class AudioPluginFormatManagerTests final : public UnitTest
+{
+public:
+    AudioPluginFormatManagerTests()
+        : UnitTest ("AudioPluginFormatManager", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Batches create every plug-in and restore their state");
+        {
+            AudioPluginFormatManager manager;
+            auto* background = new TestFormat ("Background", true);
+            auto* foreground = new TestFormat ("Foreground", false);
+            manager.addFormat (background);
+            manager.addFormat (foreground);
+
+            std::vector<AudioPluginFormatManager::PluginInstanceRequest> requests;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                PluginDescription desc;
+                desc.pluginFormatName = i % 3 == 0 ? "Foreground" : "Background";
+                desc.fileOrIdentifier = String (i);
+                requests.push_back ({ desc, MemoryBlock (&i, sizeof (i)) });
+            }
+
+            PluginDescription missing;
+            missing.pluginFormatName = "Missing";
+            requests.push_back ({ missing, {} });
+
+            std::map<int, std::unique_ptr<AudioPluginInstance>> results;
+            int numErrors = 0;
+
+            manager.createPluginInstancesAsync (requests, 44100.0, 512,
+                                                [&] (int index, std::unique_ptr<AudioPluginInstance> instance, const String& error)
+                                                {
+                                                    expect (MessageManager::getInstance()->isThisTheMessageThread());
+
+                                                    if (instance == nullptr)
+                                                    {
+                                                        expect (error.isNotEmpty());
+                                                        ++numErrors;
+                                                    }
+
+                                                    results[index] = std::move (instance);
+                                                });
+
+            for (int i = 0; i < 500 && (int) results.size() < (int) requests.size(); ++i)
+                MessageManager::getInstance()->runDispatchLoopUntil (10);
+
+            expectEquals ((int) results.size(), (int) requests.size());
+            expectEquals (numErrors, 1);
+            expectEquals (background->numOffMessageThread.load(), background->numCreated.load());
+            expectEquals (foreground->numOffMessageThread.load(), 0);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                auto* instance = dynamic_cast<TestInstance*> (results[i].get());
+                expect (instance != nullptr && instance->restoredState == i);
+            }
+        }
+    }
+
+private:
+    struct TestInstance final : public AudioProcessorGraph::AudioGraphIOProcessor
+    {
+        TestInstance() : AudioGraphIOProcessor (audioOutputNode) {}
+
+        void setStateInformation (const void* data, int sizeInBytes) override
+        {
+            if (sizeInBytes == (int) sizeof (restoredState))
+                std::memcpy (&restoredState, data, sizeof (restoredState));
+        }
+
+        int restoredState = -1;
+    };
+
+    struct TestFormat final : public AudioPluginFormat
+    {
+        TestFormat (const String& n, bool background) : name (n), createInBackground (background) {}
+
+        String getName() const override     { return name; }
+
+        void findAllTypesForFile (OwnedArray<PluginDescription>&, const String&) override   {}
+        bool fileMightContainThisPluginType (const String&) override                        { return true; }
+        String getNameOfPluginFromIdentifier (const String& id) override                    { return id; }
+        bool pluginNeedsRescanning (const PluginDescription&) override                      { return false; }
+        bool doesPluginStillExist (const PluginDescription&) override                       { return true; }
+        bool canScanForPlugins() const override                                             { return false; }
+        bool isTrivialToScan() const override                                               { return true; }
+        StringArray searchPathsForPlugins (const FileSearchPath&, bool, bool) override      { return {}; }
+        FileSearchPath getDefaultLocationsToSearch() override                               { return {}; }
+        bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override  { return false; }
+        bool canCreateInstancesOnBackgroundThread (const PluginDescription&) const override          { return createInBackground; }
+
+        void createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback callback) override
+        {
+            ++numCreated;
+
+            if (! MessageManager::getInstance()->isThisTheMessageThread())
+                ++numOffMessageThread;
+
+            callback (std::make_unique<TestInstance>(), {});
+        }
+
+        String name;
+        bool createInBackground;
+        std::atomic<int> numCreated { 0 }, numOffMessageThread { 0 };
+    };
+};
+
+static AudioPluginFormatManagerTests audioPluginFormatManagerTests;
+
+#endif
+
 } // namespace juce
@@ -118,6 +118,44 @@ public:
                                     double initialSampleRate, int initialBufferSize,
                                     AudioPluginFormat::PluginCreationCallback callback);
 
+    //==============================================================================
+    /** Describes one of the plug-ins to be created by createPluginInstancesAsync(). */
+    struct PluginInstanceRequest
+    {
+        /** The type of plug-in to create. */
+        PluginDescription description;
+
+        /** If this isn't empty, it will be passed to the new instance's
+            setStateInformation() before the instance is handed over.
+        */
+        MemoryBlock state;
+    };
+
+    /** A callback lambda that is passed to createPluginInstancesAsync().
+        It's given the index of the request, followed by the new instance (or
+        nullptr) and an error message.
+    */
+    using BatchCreationCallback = std::function<void (int, std::unique_ptr<AudioPluginInstance>, const String&)>;
+
+    /** Asynchronously creates a whole set of plug-ins, e.g. when loading a session.
+
+        Plug-ins whose format returns true from
+        AudioPluginFormat::canCreateInstancesOnBackgroundThread() are created and have
+        their state restored in parallel on a pool of worker threads. The rest are
+        created on the message thread one per message, so that the results from the
+        worker threads and other messages can be dealt with in between.
+
+        The callback will be called once for every request, on the message thread,
+        in whatever order the plug-ins finish. Like createPluginInstanceAsync(), the
+        caller must not block the message thread, and this manager must outlive the
+        whole batch.
+
+        This must be called on the message thread.
+    */
+    void createPluginInstancesAsync (std::vector<PluginInstanceRequest> requests,
+                                     double initialSampleRate, int initialBufferSize,
+                                     BatchCreationCallback callback);
+
     /** Tries to create an ::ARAFactoryWrapper for this description.
 
         The result of the operation will be wrapped into an ARAFactoryResult,
@@ -141,10 +179,17 @@ public:
 
 private:
     //==============================================================================
+    struct BatchCreation;
+    struct DeliverBatchResult;
+
     AudioPluginFormat* findFormatForDescription (const PluginDescription&, String& errorMessage) const;
+    ThreadPool& getCreationThreadPool();
+    void createNextOnMessageThread (std::shared_ptr<BatchCreation>);
 
     OwnedArray<AudioPluginFormat> formats;
+    std::unique_ptr<ThreadPool> creationThreadPool;
 
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AudioPluginFormatManager)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPluginFormatManager)
 };
 
@@ -766,9 +766,14 @@ public:
         channels.reserve ((size_t) jmin (128, numChannels));
     }
 
+    /*  If layoutsMatch is true, the input and output maps must be identical, with every bus
+        active, which allows the host's output buffers to be used directly when possible.
+        @see ClientBufferMapper::inputAndOutputLayoutsMatch
+    */
     AudioBuffer<FloatType> getMappedBuffer (Steinberg::Vst::ProcessData& data,
                                             const std::vector<DynamicChannelMapping>& inputMap,
-                                            const std::vector<DynamicChannelMapping>& outputMap)
+                                            const std::vector<DynamicChannelMapping>& outputMap,
+                                            bool layoutsMatch = false)
     {
         scratchBuffer.clear();
         channels.clear();
@@ -781,6 +786,14 @@ public:
         if (! validateLayouts<Direction::input, FloatType> (data.inputs, data.inputs + vstInputs, inputMap))
             return getBlankBuffer (usedChannels, (int) data.numSamples);
 
+        if (layoutsMatch)
+        {
+            if (setUpAliasedChannels (data, (size_t) vstInputs, outputMap, usedChannels))
+                return { channels.data(), (int) channels.size(), (int) data.numSamples };
+
+            channels.clear();
+        }
+
         setUpInputChannels (data, (size_t) vstInputs, scratchBuffer, inputMap, channels);
         setUpOutputChannels (scratchBuffer, outputMap, channels);
 
@@ -791,6 +804,82 @@ public:
     }
 
 private:
+    /*  When the inputs and outputs have the same layout, each JUCE channel can use the host's
+        output buffer for the same channel, so that nothing needs to be copied back to the host
+        afterwards. The inputs are copied into those buffers, unless the host is processing in
+        place, in which case nothing is copied at all.
+
+        Returns false, without touching any audio, if the host's buffers can't be used like this.
+    */
+    bool setUpAliasedChannels (Steinberg::Vst::ProcessData& data,
+                               size_t vstInputs,
+                               const std::vector<DynamicChannelMapping>& map,
+                               int usedChannels)
+    {
+        const auto vstOutputs = (size_t) countValidBuses<FloatType> (data.outputs, data.numOutputs);
+
+        if (vstInputs != map.size() || vstOutputs != map.size()
+            || ! validateLayouts<Direction::output, FloatType> (data.outputs, data.outputs + vstOutputs, map))
+            return false;
+
+        const auto numSamples = (size_t) data.numSamples;
+
+        // An output that doesn't share its buffer with the matching input mustn't overlap any
+        // other input, or writing to it could overwrite audio that hasn't been read yet.
+        auto inputsStart = std::numeric_limits<std::uintptr_t>::max();
+        std::uintptr_t inputsEnd = 0;
+
+        for (size_t busIndex = 0; busIndex < map.size(); ++busIndex)
+        {
+            auto** busPtr = getAudioBusPointer (detail::Tag<FloatType>{}, data.inputs[busIndex]);
+
+            for (size_t channelIndex = 0; channelIndex < map[busIndex].size(); ++channelIndex)
+            {
+                const auto start = reinterpret_cast<std::uintptr_t> (busPtr[channelIndex]);
+                inputsStart = jmin (inputsStart, start);
+                inputsEnd   = jmax (inputsEnd, start + numSamples * sizeof (FloatType));
+            }
+        }
+
+        channels.resize ((size_t) usedChannels);
+
+        for (size_t busIndex = 0, busOffset = 0; busIndex < map.size(); ++busIndex)
+        {
+            const auto& mapping = map[busIndex];
+            auto** ins  = getAudioBusPointer (detail::Tag<FloatType>{}, data.inputs[busIndex]);
+            auto** outs = getAudioBusPointer (detail::Tag<FloatType>{}, data.outputs[busIndex]);
+
+            if ((size_t) data.inputs[busIndex].numChannels != mapping.size()
+                || (size_t) data.outputs[busIndex].numChannels != mapping.size())
+                return false;
+
+            for (size_t channelIndex = 0; channelIndex < mapping.size(); ++channelIndex)
+            {
+                const auto start = reinterpret_cast<std::uintptr_t> (outs[channelIndex]);
+                const auto end = start + numSamples * sizeof (FloatType);
+
+                if (outs[channelIndex] != ins[channelIndex] && start < inputsEnd && inputsStart < end)
+                    return false;
+
+                channels[busOffset + (size_t) mapping.getJuceChannelForVst3Channel ((int) channelIndex)] = outs[channelIndex];
+            }
+
+            busOffset += mapping.size();
+        }
+
+        for (size_t busIndex = 0; busIndex < map.size(); ++busIndex)
+        {
+            auto** ins  = getAudioBusPointer (detail::Tag<FloatType>{}, data.inputs[busIndex]);
+            auto** outs = getAudioBusPointer (detail::Tag<FloatType>{}, data.outputs[busIndex]);
+
+            for (size_t channelIndex = 0; channelIndex < map[busIndex].size(); ++channelIndex)
+                if (outs[channelIndex] != ins[channelIndex])
+                    FloatVectorOperations::copy (outs[channelIndex], ins[channelIndex], numSamples);
+        }
+
+        return true;
+    }
+
     static void setUpInputChannels (Steinberg::Vst::ProcessData& data,
                                     size_t vstInputs,
                                     ScratchBuffer<FloatType>& scratchBuffer,
@@ -923,6 +1012,8 @@ public:
                 }
             }
         }
+
+        updateLayoutsMatch();
     }
 
     void prepare (int blockSize)
@@ -962,10 +1053,19 @@ public:
 
         sync (inputMap,  clientBuses.inputBuses);
         sync (outputMap, clientBuses.outputBuses);
+
+        updateLayoutsMatch();
     }
 
-    void setInputBusHostActive  (size_t bus, bool state) { setHostActive (inputMap,  bus, state); }
-    void setOutputBusHostActive (size_t bus, bool state) { setHostActive (outputMap, bus, state); }
+    void setInputBusHostActive  (size_t bus, bool state) { setHostActive (inputMap,  bus, state); updateLayoutsMatch(); }
+    void setOutputBusHostActive (size_t bus, bool state) { setHostActive (outputMap, bus, state); updateLayoutsMatch(); }
+
+    /*  Returns true if the inputs and outputs have identical layouts, with every bus active on
+        both the host and the client side. The host's output buffers can then be used directly
+        as the client's buffer. This is only recalculated when the layout or the bus activation
+        changes, rather than on every block.
+    */
+    bool inputAndOutputLayoutsMatch() const { return layoutsMatch; }
 
     auto& getData (detail::Tag<float>)  { return floatData; }
     auto& getData (detail::Tag<double>) { return doubleData; }
@@ -984,6 +1084,19 @@ public:
     const std::vector<DynamicChannelMapping>& getOutputMap() const { return outputMap; }
 
 private:
+    void updateLayoutsMatch()
+    {
+        const auto isFullyActive = [] (const DynamicChannelMapping& m) { return m.isHostActive() && m.isClientActive(); };
+
+        layoutsMatch = inputMap.size() == outputMap.size()
+                    && std::all_of (inputMap.begin(), inputMap.end(), isFullyActive)
+                    && std::all_of (outputMap.begin(), outputMap.end(), isFullyActive)
+                    && std::equal (inputMap.begin(), inputMap.end(), outputMap.begin(), [] (const auto& a, const auto& b)
+                       {
+                           return a.getAudioChannelSet() == b.getAudioChannelSet();
+                       });
+    }
+
     static void setHostActive (std::vector<DynamicChannelMapping>& map, size_t bus, bool state)
     {
         if (bus < map.size())
@@ -1003,6 +1116,7 @@ private:
 
     std::vector<DynamicChannelMapping> inputMap;
     std::vector<DynamicChannelMapping> outputMap;
+    bool layoutsMatch = false;
 };
 
 //==============================================================================
@@ -1017,8 +1131,9 @@ public:
     ClientRemappedBuffer (ClientBufferMapperData<FloatType>& mapperData,
                           const std::vector<DynamicChannelMapping>* inputMapIn,
                           const std::vector<DynamicChannelMapping>* outputMapIn,
-                          Steinberg::Vst::ProcessData& hostData)
-        : buffer (mapperData.getMappedBuffer (hostData, *inputMapIn, *outputMapIn)),
+                          Steinberg::Vst::ProcessData& hostData,
+                          bool layoutsMatch = false)
+        : buffer (mapperData.getMappedBuffer (hostData, *inputMapIn, *outputMapIn, layoutsMatch)),
           outputMap (outputMapIn),
           data (hostData)
     {}
@@ -1027,7 +1142,8 @@ public:
         : ClientRemappedBuffer (mapperIn.getData (detail::Tag<FloatType>{}),
                                 &mapperIn.getInputMap(),
                                 &mapperIn.getOutputMap(),
-                                hostData)
+                                hostData,
+                                mapperIn.inputAndOutputLayoutsMatch())
     {}
 
     ~ClientRemappedBuffer()
@@ -1063,7 +1179,11 @@ private:
                     {
                         auto* hostChannel = getAudioBusPointer (detail::Tag<FloatType>{}, bus)[j];
                         const auto juceChannel = juceBusOffset + (size_t) mapping.getJuceChannelForVst3Channel ((int) j);
-                        FloatVectorOperations::copy (hostChannel, buffer.getReadPointer ((int) juceChannel), (size_t) data.numSamples);
+                        const auto* clientChannel = buffer.getReadPointer ((int) juceChannel);
+
+                        // The client may have been rendering straight into the host's buffer
+                        if (hostChannel != clientChannel)
+                            FloatVectorOperations::copy (hostChannel, clientChannel, (size_t) data.numSamples);
                     }
                 }
                 else
@@ -1337,6 +1457,9 @@ public:
     MidiEventList() = default;
     virtual ~MidiEventList() = default;
 
+    // Steinberg's Host Checker states that no more than 2048 events are allowed at once
+    enum { maxNumEvents = 2048 };
+
     JUCE_DECLARE_VST3_COM_REF_METHODS
     JUCE_DECLARE_VST3_COM_QUERY_METHODS
 
@@ -1346,6 +1469,14 @@ public:
         events.clearQuick();
     }
 
+    /** Preallocates space for the given number of events, so that subsequent
+        calls to addEvent() don't need to allocate.
+    */
+    void ensureStorageAllocated (int numEvents)
+    {
+        events.ensureStorageAllocated (numEvents);
+    }
+
     Steinberg::int32 PLUGIN_API getEventCount() override
     {
         return (Steinberg::int32) events.size();
@@ -1468,7 +1599,6 @@ private:
                              StoredMidiMapping* midiMapping,
                              Callback&& callback)
     {
-        enum { maxNumEvents = 2048 }; // Steinberg's Host Checker states that no more than 2048 events are allowed at once
         int numEvents = 0;
 
         for (const auto metadata : midiBuffer)
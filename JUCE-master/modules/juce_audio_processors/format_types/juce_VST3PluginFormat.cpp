@@ -38,6 +38,10 @@
 #include "juce_VST3Common.h"
 #include "juce_ARACommon.h"
 
+#if JUCE_VST3_HOST_ASSERT_ON_ALLOCATION && ! JUCE_ENABLE_ALLOCATION_HOOKS
+ #error "JUCE_VST3_HOST_ASSERT_ON_ALLOCATION requires JUCE_ENABLE_ALLOCATION_HOOKS to be enabled"
+#endif
+
 #if JUCE_PLUGINHOST_ARA && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX)
 #include <ARA_API/ARAVST3.h>
 
@@ -2849,6 +2853,10 @@ public:
 
         setStateForAllMidiBuses (true);
 
+        // Pre-size the event lists so that they never need to grow on the audio thread
+        midiInputs ->ensureStorageAllocated (MidiEventList::maxNumEvents);
+        midiOutputs->ensureStorageAllocated (MidiEventList::maxNumEvents);
+
         warnOnFailure (holder->component->setActive (true));
         warnOnFailureIfImplemented (processor->setProcessing (true));
 
@@ -2963,19 +2971,29 @@ public:
         for (int i = getTotalNumInputChannels(); i < buffer.getNumChannels(); ++i)
             buffer.clear (i, 0, numSamples);
 
-        inputParameterChanges->clear();
-        outputParameterChanges->clear();
+        {
+           #if JUCE_VST3_HOST_ASSERT_ON_ALLOCATION
+            const ScopedAllocationAssertion allocationAssertion;
+           #endif
 
-        associateWith (data, buffer);
-        associateWith (data, midiMessages);
+            inputParameterChanges->clear();
+            outputParameterChanges->clear();
 
-        cachedParamValues.ifSet ([&] (Steinberg::int32 index, float value)
-        {
-            inputParameterChanges->set (cachedParamValues.getParamID (index), value, 0);
-        });
+            associateWith (data, buffer);
+            associateWith (data, midiMessages);
+
+            cachedParamValues.ifSet ([&] (Steinberg::int32 index, float value)
+            {
+                inputParameterChanges->set (cachedParamValues.getParamID (index), value, 0);
+            });
+        }
 
         processor->process (data);
 
+       #if JUCE_VST3_HOST_ASSERT_ON_ALLOCATION
+        const ScopedAllocationAssertion allocationAssertion;
+       #endif
+
         outputParameterChanges->forEach ([&] (Steinberg::int32 vstParamIndex, Vst::ParamID id, float value)
         {
             // Send the parameter value from the processor to the editor
@@ -557,6 +557,128 @@ public:
             expect (channelStartsWithValue (data.outputs[2], 3, 7.0f));
         }
 
+        beginTest ("Matching input and output layouts render directly into the host's output buffers");
+        {
+            ClientBufferMapperData<float> remapper;
+            remapper.prepare (10, blockSize * 2);
+
+            const Config config { { DynamicChannelMapping { AudioChannelSet::stereo() },
+                                    DynamicChannelMapping { AudioChannelSet::create7point1() } },
+                                  { DynamicChannelMapping { AudioChannelSet::stereo() },
+                                    DynamicChannelMapping { AudioChannelSet::create7point1() } } };
+
+            TestBuffers testBuffers { blockSize };
+
+            auto ins  = MultiBusBuffers{}.withBus (testBuffers, 2).withBus (testBuffers, 8);
+            auto outs = MultiBusBuffers{}.withBus (testBuffers, 2).withBus (testBuffers, 8);
+
+            auto data = makeProcessData (blockSize, ins, outs);
+
+            testBuffers.init();
+
+            {
+                ClientRemappedBuffer<float> scopedBuffer { remapper, &config.ins, &config.outs, data, true };
+                auto& remapped = scopedBuffer.buffer;
+
+                expect (remapped.getNumChannels() == 10);
+
+                // The buffer's channels are the host's output channels, in JUCE order
+                expect (remapped.getReadPointer (0) == data.outputs[0].channelBuffers32[0]);
+                expect (remapped.getReadPointer (1) == data.outputs[0].channelBuffers32[1]);
+                expect (remapped.getReadPointer (6) == data.outputs[1].channelBuffers32[6]);
+                expect (remapped.getReadPointer (8) == data.outputs[1].channelBuffers32[4]);
+
+                // The inputs have been copied into the output channels
+                expect (allMatch (remapped, 0, 1.0f));
+                expect (allMatch (remapped, 1, 2.0f));
+                expect (allMatch (remapped, 2, 3.0f));
+                expect (allMatch (remapped, 6, 9.0f));  // VST3 surround rear -> JUCE surround rear
+                expect (allMatch (remapped, 8, 7.0f));  // VST3 surround side -> JUCE surround side
+
+                for (auto i = 0; i < remapped.getNumChannels(); ++i)
+                {
+                    auto* ptr = remapped.getWritePointer (i);
+                    std::fill (ptr, ptr + remapped.getNumSamples(), (float) i);
+                }
+            }
+
+            expect (channelStartsWithValue (data.outputs[0], 0, 0.0f));
+            expect (channelStartsWithValue (data.outputs[0], 1, 1.0f));
+            expect (channelStartsWithValue (data.outputs[1], 4, 8.0f));
+            expect (channelStartsWithValue (data.outputs[1], 6, 6.0f));
+
+            // The inputs are untouched
+            expect (testBuffers.allMatch (0, 1.0f));
+            expect (testBuffers.allMatch (9, 10.0f));
+        }
+
+        beginTest ("Matching layouts processed in place don't copy any audio");
+        {
+            ClientBufferMapperData<float> remapper;
+            remapper.prepare (2, blockSize * 2);
+
+            const Config config { { DynamicChannelMapping { AudioChannelSet::stereo() } },
+                                  { DynamicChannelMapping { AudioChannelSet::stereo() } } };
+
+            TestBuffers testBuffers { blockSize };
+
+            auto ins = MultiBusBuffers{}.withBus (testBuffers, 2);
+            auto data = makeProcessData (blockSize, ins, ins);
+
+            testBuffers.init();
+
+            {
+                ClientRemappedBuffer<float> scopedBuffer { remapper, &config.ins, &config.outs, data, true };
+                auto& remapped = scopedBuffer.buffer;
+
+                expect (remapped.getNumChannels() == 2);
+                expect (remapped.getReadPointer (0) == testBuffers.get (0));
+                expect (remapped.getReadPointer (1) == testBuffers.get (1));
+                expect (allMatch (remapped, 0, 1.0f));
+                expect (allMatch (remapped, 1, 2.0f));
+
+                remapped.applyGain (2.0f);
+            }
+
+            expect (testBuffers.allMatch (0, 2.0f));
+            expect (testBuffers.allMatch (1, 4.0f));
+        }
+
+        beginTest ("Matching layouts with outputs overlapping other inputs fall back to copying");
+        {
+            ClientBufferMapperData<float> remapper;
+            remapper.prepare (2, blockSize * 2);
+
+            const Config config { { DynamicChannelMapping { AudioChannelSet::stereo() } },
+                                  { DynamicChannelMapping { AudioChannelSet::stereo() } } };
+
+            TestBuffers testBuffers { blockSize };
+
+            auto ins  = MultiBusBuffers{}.withBus (testBuffers, 2);
+            auto outs = MultiBusBuffers{}.withBus (testBuffers, 2);
+
+            // The outputs are the inputs, swapped
+            outs.pointerStorage[0][0] = testBuffers.get (1);
+            outs.pointerStorage[0][1] = testBuffers.get (0);
+
+            auto data = makeProcessData (blockSize, ins, outs);
+
+            testBuffers.init();
+
+            {
+                ClientRemappedBuffer<float> scopedBuffer { remapper, &config.ins, &config.outs, data, true };
+                auto& remapped = scopedBuffer.buffer;
+
+                expect (remapped.getReadPointer (0) != testBuffers.get (0));
+                expect (remapped.getReadPointer (0) != testBuffers.get (1));
+                expect (allMatch (remapped, 0, 1.0f));
+                expect (allMatch (remapped, 1, 2.0f));
+            }
+
+            expect (testBuffers.allMatch (0, 2.0f));
+            expect (testBuffers.allMatch (1, 1.0f));
+        }
+
         beginTest ("HostBufferMapper reorders channels correctly");
         {
             HostBufferMapper mapper;
@@ -122,6 +122,16 @@
  #define JUCE_PLUGINHOST_ARA 0
 #endif
 
+/** Config: JUCE_VST3_HOST_ASSERT_ON_ALLOCATION
+    If enabled, the VST3 plugin host will assert if any memory is allocated or freed by the
+    hosting wrapper itself during a call to processBlock(). Allocations made by the hosted
+    plugin are not checked. This requires JUCE_ENABLE_ALLOCATION_HOOKS to be enabled, and is
+    intended for debugging only.
+*/
+#ifndef JUCE_VST3_HOST_ASSERT_ON_ALLOCATION
+ #define JUCE_VST3_HOST_ASSERT_ON_ALLOCATION 0
+#endif
+
 /** Config: JUCE_CUSTOM_VST3_SDK
     If enabled, the embedded VST3 SDK in JUCE will not be added to the project and instead you should
     add the path to your custom VST3 SDK to the project's header search paths. Most users shouldn't
@@ -151,6 +161,7 @@
 #include "processors/juce_AudioProcessorEditor.h"
 #include "processors/juce_AudioProcessorListener.h"
 #include "processors/juce_AudioProcessorParameterGroup.h"
+#include "processors/juce_AudioParameterChangeList.h"
 #include "processors/juce_AudioProcessor.h"
 #include "processors/juce_PluginDescription.h"
 #include "processors/juce_AudioPluginInstance.h"
@@ -167,6 +178,7 @@
 #include "format_types/juce_VSTPluginFormat.h"
 #include "format_types/juce_ARAHosting.h"
 #include "scanning/juce_PluginDirectoryScanner.h"
+#include "scanning/juce_OutOfProcessPluginScanner.h"
 #include "scanning/juce_PluginListComponent.h"
 #include "utilities/juce_AudioProcessorParameterWithID.h"
 #include "utilities/juce_RangedAudioParameter.h"
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioParameterChangeList::AudioParameterChangeList (int initialCapacity)
+{
+    ensureStorageAllocated (initialCapacity);
+}
+
+void AudioParameterChangeList::ensureStorageAllocated (int numEvents)
+{
+    events.reserve ((size_t) jmax (0, numEvents));
+}
+
+bool AudioParameterChangeList::addEvent (AudioProcessorParameter& parameter, int sampleOffset, float newValue) noexcept
+{
+    if (events.size() >= events.capacity())
+        return false;
+
+    const auto offset = jmax (0, sampleOffset);
+
+    // Hosts usually send events grouped by parameter, so search backwards from the end
+    auto insertPoint = events.end();
+
+    while (insertPoint != events.begin() && std::prev (insertPoint)->sampleOffset > offset)
+        --insertPoint;
+
+    events.insert (insertPoint, { &parameter, offset, newValue });
+    return true;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioParameterChangeListTests final : public UnitTest
+{
+public:
+    AudioParameterChangeListTests()
+        : UnitTest ("Audio Parameter Change List", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        AudioParameterFloat paramA ({ "a", 1 }, "A", 0.0f, 1.0f, 0.0f);
+        AudioParameterFloat paramB ({ "b", 1 }, "B", 0.0f, 1.0f, 0.0f);
+
+        beginTest ("Events are kept in time order");
+        {
+            AudioParameterChangeList list (8);
+
+            list.addEvent (paramA, 0,  0.1f);
+            list.addEvent (paramA, 32, 0.2f);
+            list.addEvent (paramA, 64, 0.3f);
+            list.addEvent (paramB, 16, 0.4f);
+            list.addEvent (paramB, 32, 0.5f);
+
+            expectEquals (list.size(), 5);
+
+            for (int i = 1; i < list.size(); ++i)
+                expect (list[i - 1].sampleOffset <= list[i].sampleOffset);
+
+            expect (list[1].parameter == &paramB);
+            expect (list[2].parameter == &paramA);
+            expect (list[3].parameter == &paramB);
+            expect (exactlyEqual (list[4].value, 0.3f));
+        }
+
+        beginTest ("Adding to a full list drops the event without allocating");
+        {
+            AudioParameterChangeList list (2);
+            const auto* storage = list.begin();
+
+            expect (list.addEvent (paramA, 0, 0.0f));
+            expect (list.addEvent (paramA, 1, 0.5f));
+            expect (! list.addEvent (paramA, 2, 1.0f));
+
+            expectEquals (list.size(), 2);
+            expect (list.begin() == storage);
+
+            list.clear();
+            expect (list.isEmpty());
+            expectEquals (list.getCapacity(), 2);
+        }
+
+        beginTest ("Negative offsets are clamped to the start of the block");
+        {
+            AudioParameterChangeList list (1);
+            list.addEvent (paramA, -10, 0.5f);
+            expectEquals (list[0].sampleOffset, 0);
+        }
+    }
+};
+
+static AudioParameterChangeListTests audioParameterChangeListTests;
+
+#endif
+
+} // namespace juce
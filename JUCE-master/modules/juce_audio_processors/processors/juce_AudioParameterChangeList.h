@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A list of timestamped parameter changes supplied by the host for one audio block.
+
+    Plugin wrappers for formats that send sample-accurate automation fill one of these
+    before each call to AudioProcessor::processBlock(), and make it available through
+    AudioProcessor::getParameterChanges(). Events are held in order of their sample
+    offset within the block, and changes with the same offset keep the order in which
+    the host sent them.
+
+    Before processBlock() is called, each parameter in the list has already been set
+    to its final value for the block, so processors that ignore this list behave exactly
+    as they did before. Processors that want smooth, sample-accurate automation can
+    instead walk the events and ramp between them.
+
+    Storage is reserved up-front, so clearing and adding events never allocates. Once
+    the list is full, further events are dropped, although the parameters themselves
+    will still end up at the correct value.
+
+    @see AudioProcessor::getParameterChanges
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioParameterChangeList
+{
+public:
+    //==============================================================================
+    /** A single parameter change. */
+    struct Event
+    {
+        /** The parameter that changed. */
+        AudioProcessorParameter* parameter = nullptr;
+
+        /** The position of the change, in samples from the start of the block. */
+        int sampleOffset = 0;
+
+        /** The new normalised value of the parameter, in the range 0 to 1. */
+        float value = 0.0f;
+    };
+
+    //==============================================================================
+    /** Creates an empty list, reserving space for the given number of events. */
+    explicit AudioParameterChangeList (int initialCapacity = 0);
+
+    /** Makes sure that the list can hold at least this many events without allocating.
+        This must not be called on the audio thread.
+    */
+    void ensureStorageAllocated (int numEvents);
+
+    /** Returns the number of events that the list can hold. */
+    int getCapacity() const noexcept                    { return (int) events.capacity(); }
+
+    //==============================================================================
+    /** Removes all the events from the list. This doesn't free any storage. */
+    void clear() noexcept                               { events.clear(); }
+
+    /** Adds an event, keeping the list in time order.
+
+        Returns false if the list was already full, in which case the event is dropped.
+    */
+    bool addEvent (AudioProcessorParameter& parameter, int sampleOffset, float newValue) noexcept;
+
+    //==============================================================================
+    /** Returns the number of events in the list. */
+    int size() const noexcept                           { return (int) events.size(); }
+
+    /** Returns true if there are no events in the list. */
+    bool isEmpty() const noexcept                       { return events.empty(); }
+
+    /** Returns a reference to one of the events. */
+    const Event& operator[] (int index) const noexcept  { return events[(size_t) index]; }
+
+    /** Returns a pointer to the first event in the list. */
+    const Event* begin() const noexcept                 { return events.data(); }
+
+    /** Returns a pointer just beyond the last event in the list. */
+    const Event* end() const noexcept                   { return events.data() + events.size(); }
+
+private:
+    //==============================================================================
+    std::vector<Event> events;
+
+    JUCE_LEAK_DETECTOR (AudioParameterChangeList)
+};
+
+} // namespace juce
@@ -330,6 +330,12 @@ void AudioProcessor::getNextBestLayout (const BusesLayout& desiredLayout, BusesL
 }
 
 //==============================================================================
+const AudioParameterChangeList& AudioProcessor::getParameterChanges() const noexcept
+{
+    static const AudioParameterChangeList emptyList;
+    return parameterChanges != nullptr ? *parameterChanges : emptyList;
+}
+
 void AudioProcessor::setPlayHead (AudioPlayHead* newPlayHead)
 {
     playHead = newPlayHead;
@@ -377,6 +383,7 @@ void AudioProcessor::setRateAndBufferSizeDetails (double newSampleRate, int newB
 {
     currentSampleRate = newSampleRate;
     blockSize = newBlockSize;
+    processLoadMeasurer.reset (newSampleRate, newBlockSize);
 }
 
 //==============================================================================
@@ -950,6 +957,26 @@ void AudioProcessor::copyXmlToBinary (const XmlElement& xml, juce::MemoryBlock&
         = ByteOrder::swapIfBigEndian ((uint32) destData.getSize() - 9);
 }
 
+void AudioProcessor::copyStateToBinary (const ValueTree& state, juce::MemoryBlock& destData)
+{
+    MemoryOutputStream out (destData, false);
+    state.writeToCompactStream (out);
+}
+
+ValueTree AudioProcessor::getStateFromBinary (const void* data, const int sizeInBytes)
+{
+    if (sizeInBytes <= 0)
+        return {};
+
+    if (ValueTree::isCompactData (data, (size_t) sizeInBytes))
+        return ValueTree::readFromCompactData (data, (size_t) sizeInBytes);
+
+    if (auto xml = getXmlFromBinary (data, sizeInBytes))
+        return ValueTree::fromXml (*xml);
+
+    return {};
+}
+
 std::optional<String> AudioProcessor::getNameForMidiNoteNumber (int /*note*/, int /*midiChannel*/)
 {
     return std::nullopt;
@@ -736,6 +736,21 @@ public:
     */
     AudioPlayHead* getPlayHead() const noexcept                 { return playHead; }
 
+    /** Returns the timestamped parameter changes that the host sent for the current block.
+
+        You can ONLY call this from your processBlock() method, and must not keep the
+        reference beyond the current callback.
+
+        Plugin wrappers for formats with sample-accurate automation (currently VST3 and
+        AUv3) fill this list with every change the host sent for the block. By the time
+        processBlock() is called, each of these parameters has already been set to its final
+        value, so you only need to look at this list if you want to render automation
+        ramps within the block, rather than at block boundaries.
+
+        If the host or format doesn't supply timestamped changes, the list will be empty.
+    */
+    const AudioParameterChangeList& getParameterChanges() const noexcept;
+
     //==============================================================================
     /** Returns the total number of input channels.
 
@@ -1127,7 +1142,8 @@ public:
         Note that there's also a getCurrentProgramStateInformation() method, which only
         stores the current program, not the state of the entire processor.
 
-        See also the helper function copyXmlToBinary() for storing settings as XML.
+        See also the helper function copyXmlToBinary() for storing settings as XML, or
+        copyStateToBinary() for storing a ValueTree in a faster binary format.
 
         @see getCurrentProgramStateInformation
     */
@@ -1152,7 +1168,8 @@ public:
         Note that there's also a setCurrentProgramStateInformation() method, which tries
         to restore just the current program, not the state of the entire processor.
 
-        See also the helper function getXmlFromBinary() for loading settings as XML.
+        See also the helper functions getXmlFromBinary() and getStateFromBinary() for
+        loading settings that were stored by copyXmlToBinary() or copyStateToBinary().
 
         VST3ClientExtensions::getCompatibleParameterIds() will always be called after
         setStateInformation() therefore you can use information from the plugin state
@@ -1196,6 +1213,14 @@ public:
     */
     virtual void setPlayHead (AudioPlayHead* newPlayHead);
 
+    /** Tells the processor which list of parameter changes getParameterChanges() should
+        return during the next processBlock() call.
+
+        This is called by the plugin wrappers before each block. The processor doesn't take
+        ownership of the list, and passing nullptr means that no changes are available.
+    */
+    void setParameterChanges (const AudioParameterChangeList* newParameterChanges) noexcept  { parameterChanges = newParameterChanges; }
+
     //==============================================================================
     /** This is called by the processor to specify its details before being played. Use this
         version of the function if you are not interested in any sidechain and/or aux buses
@@ -1210,6 +1235,20 @@ public:
     */
     void setRateAndBufferSizeDetails (double sampleRate, int blockSize) noexcept;
 
+    /** Returns the object that measures how long this processor's processBlock() calls take.
+
+        The AudioProcessorPlayer, the AudioProcessorGraph and the plugin wrappers time each
+        call they make to processBlock() or processBlockBypassed() with this measurer, so a
+        processor can use it to show or log its own load, including percentiles of the
+        per-block load. It's reset whenever setRateAndBufferSizeDetails() is called.
+
+        @see AudioProcessLoadMeasurer::getLoadStatistics
+    */
+    AudioProcessLoadMeasurer& getProcessLoadMeasurer() noexcept              { return processLoadMeasurer; }
+
+    /** Returns the object that measures how long this processor's processBlock() calls take. */
+    const AudioProcessLoadMeasurer& getProcessLoadMeasurer() const noexcept  { return processLoadMeasurer; }
+
     /** This is called by the host when the thread workgroup context has changed.
 
         This will only be called on the audio thread, so you can join the audio workgroup
@@ -1359,6 +1398,25 @@ public:
     */
     static std::unique_ptr<XmlElement> getXmlFromBinary (const void* data, int sizeInBytes);
 
+    /** Helper function that stores a ValueTree as a binary blob, in the compact format
+        written by ValueTree::writeToCompactStream().
+
+        This is much faster to write and to read back than converting the tree to XML with
+        copyXmlToBinary(), and the data is smaller, so it's a better choice for large states.
+        Use getStateFromBinary() to reverse this operation.
+
+        @see AudioProcessorValueTreeState::copyStateToBinary
+    */
+    static void copyStateToBinary (const ValueTree& state, juce::MemoryBlock& destData);
+
+    /** Retrieves a ValueTree that was stored with copyStateToBinary().
+
+        This also accepts XML that was stored with copyXmlToBinary(), so a plugin can move to
+        the binary format and still load the states saved by its older versions. If the data
+        is in neither format, this returns an invalid tree.
+    */
+    static ValueTree getStateFromBinary (const void* data, int sizeInBytes);
+
     /** @internal */
     static void JUCE_CALLTYPE setTypeOfNextNewPlugin (WrapperType);
 
@@ -1475,6 +1533,7 @@ protected:
     //==============================================================================
     /** @internal */
     std::atomic<AudioPlayHead*> playHead { nullptr };
+    const AudioParameterChangeList* parameterChanges = nullptr;
 
     /** @internal */
     void sendParamChangeMessageToListeners (int parameterIndex, float newValue);
@@ -1577,6 +1636,7 @@ private:
     std::atomic<bool> nonRealtime { false };
     ProcessingPrecision processingPrecision = singlePrecision;
     CriticalSection callbackLock, listenerLock, activeEditorLock;
+    AudioProcessLoadMeasurer processLoadMeasurer;
 
     friend class Bus;
     mutable OwnedArray<Bus> inputBuses, outputBuses;
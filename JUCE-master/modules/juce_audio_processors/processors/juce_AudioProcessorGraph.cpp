@@ -149,13 +149,18 @@ public:
     using NodeAndChannel = AudioProcessorGraph::NodeAndChannel;
 
 private:
-    static auto equalRange (const std::set<NodeAndChannel>& pins, const NodeID node)
+    using Map = std::map<NodeAndChannel, std::set<NodeAndChannel>>;
+
+    /*  std::equal_range is linear when used with the bidirectional iterators of std::set and
+        std::map, so search using the container's own functions and a range of channel indices.
+    */
+    template <typename Container>
+    static auto equalRange (const Container& pins, NodeID node)
     {
-        return std::equal_range (pins.cbegin(), pins.cend(), node, ImplicitNode::compare);
+        return std::make_pair (pins.lower_bound (NodeAndChannel { node, std::numeric_limits<int>::lowest() }),
+                               pins.upper_bound (NodeAndChannel { node, std::numeric_limits<int>::max() }));
     }
 
-    using Map = std::map<NodeAndChannel, std::set<NodeAndChannel>>;
-
 public:
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
@@ -313,6 +318,27 @@ public:
             return false;
         }
 
+        /*  Returns a map from each source to the latest rendering index of any node it is
+            connected to. getRenderingIndex should return -1 for nodes that won't be rendered.
+        */
+        template <typename Fn>
+        std::map<NodeAndChannel, int> getLatestDestinationIndices (Fn&& getRenderingIndex) const
+        {
+            std::map<NodeAndChannel, int> result;
+
+            for (const auto& [source, destinations] : map)
+            {
+                auto latest = -1;
+
+                for (const auto& destination : destinations)
+                    latest = jmax (latest, getRenderingIndex (destination.nodeID));
+
+                result.emplace_hint (result.end(), source, latest);
+            }
+
+            return result;
+        }
+
     private:
         Map map;
     };
@@ -371,7 +397,7 @@ private:
 
     std::pair<Map::const_iterator, Map::const_iterator> getMatchingDestinations (NodeID destID) const
     {
-        return std::equal_range (sourcesForDestination.cbegin(), sourcesForDestination.cend(), destID, ImplicitNode::compare);
+        return equalRange (sourcesForDestination, destID);
     }
 
     Map sourcesForDestination;
@@ -503,6 +529,466 @@ private:
     std::optional<PrepareSettings> current, next;
 };
 
+class RenderThreadPool;
+
+//==============================================================================
+/*  A dependency graph of render steps, which can be worked through by several threads at once.
+
+    Each step may only start once all of the steps it depends on have finished. The set of
+    dependencies is fixed when the job is created, so running the job doesn't allocate.
+*/
+class ParallelRenderJob
+{
+public:
+    explicit ParallelRenderJob (const std::vector<std::vector<size_t>>& successorsForStep)
+        : numSteps (successorsForStep.size()),
+          ready (numSteps),
+          pending (numSteps)
+    {
+        successorStarts.reserve (numSteps + 1);
+        numDependencies.resize (numSteps, 0);
+
+        for (const auto& successors : successorsForStep)
+        {
+            successorStarts.push_back (successorIndices.size());
+            successorIndices.insert (successorIndices.end(), successors.begin(), successors.end());
+
+            for (const auto successor : successors)
+                ++numDependencies[successor];
+        }
+
+        successorStarts.push_back (successorIndices.size());
+    }
+
+    virtual ~ParallelRenderJob() = default;
+
+    /*  Call from the audio thread only, while no other thread is working on this job. */
+    void reset()
+    {
+        head = 0;
+        tail = 0;
+        numCompleted = 0;
+
+        for (auto& r : ready)
+            r.store (-1, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < numSteps; ++i)
+        {
+            pending[i].store (numDependencies[i], std::memory_order_relaxed);
+
+            if (numDependencies[i] == 0)
+                push (i);
+        }
+    }
+
+    /*  Processes steps as they become ready, returning once every step has been completed.
+        This may be called concurrently from several threads.
+
+        If a pool is given, the thread helps with the pool's other jobs while none of this
+        job's steps are ready.
+    */
+    void work (RenderThreadPool* pool);
+
+    /*  Processes one step if there is one ready, returning false if there wasn't. */
+    bool processNextStep()
+    {
+        const auto step = pop();
+
+        if (step < 0)
+            return false;
+
+        const auto stepIndex = (size_t) step;
+        processStep (stepIndex);
+
+        for (auto i = successorStarts[stepIndex]; i < successorStarts[stepIndex + 1]; ++i)
+        {
+            const auto successor = successorIndices[i];
+
+            if (pending[successor].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                push (successor);
+        }
+
+        numCompleted.fetch_add (1, std::memory_order_acq_rel);
+        return true;
+    }
+
+protected:
+    virtual void processStep (size_t) = 0;
+
+private:
+    /*  Every step is pushed exactly once per run, so the ready list never needs to wrap. */
+    void push (size_t step)
+    {
+        ready[tail.fetch_add (1, std::memory_order_relaxed)].store ((int) step, std::memory_order_release);
+    }
+
+    int pop()
+    {
+        for (auto h = head.load (std::memory_order_relaxed); h < numSteps;)
+        {
+            const auto step = ready[h].load (std::memory_order_acquire);
+
+            if (step < 0)
+                return -1;
+
+            if (head.compare_exchange_weak (h, h + 1, std::memory_order_relaxed))
+                return step;
+        }
+
+        return -1;
+    }
+
+    const size_t numSteps;
+    std::vector<size_t> successorStarts, successorIndices;
+    std::vector<int> numDependencies;
+
+    std::vector<std::atomic<int>> ready, pending;
+    std::atomic<size_t> head { 0 }, tail { 0 }, numCompleted { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelRenderJob)
+    JUCE_DECLARE_NON_MOVEABLE (ParallelRenderJob)
+};
+
+//==============================================================================
+/*  Holds the most recent workgroup passed to the graph, so that worker threads can join it. */
+class SharedAudioWorkgroup
+{
+public:
+    /*  Call from the audio thread only. */
+    void set (const AudioWorkgroup& newWorkgroup)
+    {
+        {
+            const SpinLock::ScopedLockType lock (mutex);
+            workgroup = newWorkgroup;
+        }
+
+        ++generation;
+    }
+
+    /*  Joins the calling thread to the current workgroup, if it has changed since lastGeneration. */
+    void joinIfChanged (WorkgroupToken& token, int& lastGeneration) const
+    {
+        const auto currentGeneration = generation.load();
+
+        if (std::exchange (lastGeneration, currentGeneration) == currentGeneration)
+            return;
+
+        const SpinLock::ScopedLockType lock (mutex);
+        workgroup.join (token);
+    }
+
+private:
+    SpinLock mutex;
+    AudioWorkgroup workgroup;
+    std::atomic<int> generation { 0 };
+};
+
+//==============================================================================
+/*  A set of realtime threads which help the audio thread to work through a ParallelRenderJob.
+
+    The pool is shared between the graph and each of the RenderSequences that were built to
+    use it. RenderSequences are only ever destroyed on the main thread, so the worker threads
+    will also be stopped on the main thread.
+
+    Graphs nested inside the graph share its pool, and run their own jobs from inside a step
+    of the outer job. Several jobs can therefore be active at once, and any thread that is
+    waiting for steps of one job helps out with the others, so a nested graph's nodes are
+    spread across all the threads rather than being processed in series.
+*/
+class RenderThreadPool
+{
+public:
+    RenderThreadPool (int numThreads, const SharedAudioWorkgroup& workgroupIn)
+        : workgroup (workgroupIn)
+    {
+        for (auto i = 0; i < numThreads; ++i)
+            workers.push_back (std::make_unique<Worker> (*this));
+
+        for (auto& worker : workers)
+            worker->start();
+    }
+
+    ~RenderThreadPool()
+    {
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto& worker : workers)
+            worker->notify();
+
+        workers.clear();
+    }
+
+    int getNumThreads() const { return (int) workers.size(); }
+
+    /*  Call from the audio thread, or from a step of another job that's running on this pool.
+        Works through the job on the calling thread and on each of the worker threads, and
+        returns once the job is complete.
+    */
+    void run (ParallelRenderJob& job)
+    {
+        job.reset();
+
+        auto* slot = std::find_if (activeJobs.begin(), activeJobs.end(), [&] (auto& s)
+        {
+            ParallelRenderJob* expected = nullptr;
+            return s.job.compare_exchange_strong (expected, &job);
+        });
+
+        if (slot == activeJobs.end())
+        {
+            // Too many nested jobs to share, so this one is worked through on this thread alone
+            job.work (nullptr);
+            return;
+        }
+
+        for (auto& worker : workers)
+            worker->notify();
+
+        job.work (this);
+
+        // The job is complete, but another thread may still be about to look at it.
+        // Wait until they've all let go, so that the job can be safely reset next time.
+        slot->job = nullptr;
+
+        while (slot->numHelpers != 0)
+            Thread::yield();
+    }
+
+    /*  Processes a single ready step of any active job other than the given one, returning
+        true if one was found.
+    */
+    bool helpWithOtherJobs (const ParallelRenderJob* jobToSkip)
+    {
+        for (auto& slot : activeJobs)
+        {
+            if (slot.job.load (std::memory_order_relaxed) == nullptr)
+                continue;
+
+            ++slot.numHelpers;
+            auto* job = slot.job.load();
+            const auto processed = job != nullptr && job != jobToSkip && job->processNextStep();
+            --slot.numHelpers;
+
+            if (processed)
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    class Worker final : private Thread
+    {
+    public:
+        explicit Worker (RenderThreadPool& p) : Thread ("Graph Render Thread"), pool (p) {}
+
+        ~Worker() override
+        {
+            stopThread (-1);
+        }
+
+        void start()
+        {
+            if (! startRealtimeThread (RealtimeOptions{}.withPriority (9)))
+                startThread (Priority::highest);
+        }
+
+        using Thread::notify;
+        using Thread::signalThreadShouldExit;
+
+    private:
+        void run() override
+        {
+            WorkgroupToken token;
+            auto lastGeneration = -1;
+
+            while (wait (-1) && ! threadShouldExit())
+            {
+                pool.workgroup.joinIfChanged (token, lastGeneration);
+
+                for (auto numAttempts = 0; pool.hasActiveJobs();)
+                {
+                    if (pool.helpWithOtherJobs (nullptr))
+                    {
+                        numAttempts = 0;
+                    }
+                    else if (++numAttempts > 100)
+                    {
+                        numAttempts = 0;
+                        Thread::yield();
+                    }
+                }
+            }
+        }
+
+        RenderThreadPool& pool;
+    };
+
+    bool hasActiveJobs() const
+    {
+        return std::any_of (activeJobs.begin(), activeJobs.end(), [] (const auto& slot) { return slot.job.load() != nullptr; });
+    }
+
+    struct ActiveJob
+    {
+        std::atomic<ParallelRenderJob*> job { nullptr };
+        std::atomic<int> numHelpers { 0 };
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::array<ActiveJob, 16> activeJobs;
+    const SharedAudioWorkgroup& workgroup;
+};
+
+void ParallelRenderJob::work (RenderThreadPool* pool)
+{
+    for (auto numAttempts = 0; numCompleted.load (std::memory_order_acquire) < numSteps;)
+    {
+        if (processNextStep() || (pool != nullptr && pool->helpWithOtherJobs (this)))
+        {
+            numAttempts = 0;
+        }
+        else if (++numAttempts > 100)
+        {
+            numAttempts = 0;
+            Thread::yield();
+        }
+    }
+}
+
+//==============================================================================
+/*  Collects timing statistics for a single node.
+
+    Each node is only ever processed by one thread at a time, so the statistics are written
+    without any synchronisation beyond relaxed atomics, and can be read from the message thread
+    at any time. The 99th percentile is estimated using a histogram with four buckets per
+    octave, so it is only accurate to within about 20%.
+*/
+class NodeProfiler
+{
+public:
+    NodeProfiler()
+    {
+        clear();
+    }
+
+    /*  Call from the rendering threads only. */
+    void addBlock (int64 durationTicks) noexcept
+    {
+        if (resetPending.load (std::memory_order_relaxed) && resetPending.exchange (false))
+            clear();
+
+        const auto ticks = (uint32) jlimit ((int64) 0, (int64) std::numeric_limits<uint32>::max(), durationTicks);
+
+        numBlocks.store (numBlocks.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        totalTicks.store (totalTicks.load (std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+        minTicks.store (jmin (minTicks.load (std::memory_order_relaxed), ticks), std::memory_order_relaxed);
+        maxTicks.store (jmax (maxTicks.load (std::memory_order_relaxed), ticks), std::memory_order_relaxed);
+
+        auto& bucket = histogram[(size_t) getBucketIndex (ticks)];
+        bucket.store (bucket.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /*  Call from the message thread only. The statistics are cleared on the next rendered block. */
+    void reset() noexcept
+    {
+        resetPending = true;
+    }
+
+    /*  Call from the message thread only. */
+    void setLatencies (int latency, int delayCompensation) noexcept
+    {
+        latencySamples = latency;
+        delayCompensationSamples = delayCompensation;
+    }
+
+    AudioProcessorGraph::NodeProfile getProfile (AudioProcessorGraph::NodeID nodeID) const
+    {
+        AudioProcessorGraph::NodeProfile result;
+        result.nodeID = nodeID;
+        result.latencySamples = latencySamples;
+        result.delayCompensationSamples = delayCompensationSamples;
+        result.numBlocks = numBlocks.load (std::memory_order_relaxed);
+
+        if (result.numBlocks == 0 || resetPending)
+        {
+            result.numBlocks = 0;
+            return result;
+        }
+
+        const auto msPerTick = 1000.0 / (double) Time::getHighResolutionTicksPerSecond();
+        const auto maximum = maxTicks.load (std::memory_order_relaxed);
+
+        result.minMilliseconds  = msPerTick * minTicks.load (std::memory_order_relaxed);
+        result.maxMilliseconds  = msPerTick * maximum;
+        result.meanMilliseconds = msPerTick * (double) totalTicks.load (std::memory_order_relaxed) / (double) result.numBlocks;
+
+        std::array<uint32, numBuckets> counts;
+        std::transform (histogram.begin(), histogram.end(), counts.begin(), [] (const auto& b) { return b.load (std::memory_order_relaxed); });
+
+        const auto numCounted = std::accumulate (counts.begin(), counts.end(), (int64) 0);
+        const auto target = (numCounted * 99 + 99) / 100;
+        int64 cumulative = 0;
+
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            cumulative += counts[i];
+
+            if (cumulative >= target)
+            {
+                result.p99Milliseconds = msPerTick * (double) jmin ((int64) maximum, getBucketUpperLimit ((int) i));
+                break;
+            }
+        }
+
+        return result;
+    }
+
+private:
+    static constexpr size_t numBuckets = 128;
+
+    static int getBucketIndex (uint32 ticks) noexcept
+    {
+        if (ticks < 4)
+            return (int) ticks;
+
+        const auto octave = findHighestSetBit (ticks);
+        return (octave - 1) * 4 + (int) ((ticks >> (octave - 2)) & 3);
+    }
+
+    static int64 getBucketUpperLimit (int index) noexcept
+    {
+        if (index < 4)
+            return index;
+
+        const auto octave = index / 4 + 1;
+        return (((int64) (4 + index % 4) + 1) << (octave - 2)) - 1;
+    }
+
+    void clear() noexcept
+    {
+        numBlocks = 0;
+        totalTicks = 0;
+        minTicks = std::numeric_limits<uint32>::max();
+        maxTicks = 0;
+
+        for (auto& bucket : histogram)
+            bucket = 0;
+    }
+
+    std::atomic<int64> numBlocks, totalTicks;
+    std::atomic<uint32> minTicks, maxTicks;
+    std::array<std::atomic<uint32>, numBuckets> histogram;
+    std::atomic<bool> resetPending { false };
+    std::atomic<int> latencySamples { 0 }, delayCompensationSamples { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (NodeProfiler)
+    JUCE_DECLARE_NON_MOVEABLE (NodeProfiler)
+};
+
+using NodeProfilers = std::map<AudioProcessorGraph::NodeID, std::shared_ptr<NodeProfiler>>;
+
 //==============================================================================
 template <typename FloatType>
 struct GraphRenderSequence
@@ -551,7 +1037,8 @@ struct GraphRenderSequence
             return;
         }
 
-        currentAudioOutputBuffer.setSize (jmax (1, buffer.getNumChannels()), numSamples);
+        // Only the channels that are written by the output node need to be accumulated
+        currentAudioOutputBuffer.setSize (jmax (1, jmin (buffer.getNumChannels(), numAudioOutputChannels)), numSamples, false, false, true);
         currentAudioOutputBuffer.clear();
         currentMidiOutputBuffer.clear();
 
@@ -563,12 +1050,26 @@ struct GraphRenderSequence
                                     audioPlayHead,
                                     numSamples };
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            if (parallelJob != nullptr)
+            {
+                parallelJob->ops = renderOps.data();
+                parallelJob->context = &context;
+                threadPool->run (*parallelJob);
+            }
+            else
+            {
+                for (const auto& op : renderOps)
+                    op->process (context);
+            }
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
-            buffer.copyFrom (i, 0, currentAudioOutputBuffer, i, 0, numSamples);
+        {
+            if (i < currentAudioOutputBuffer.getNumChannels())
+                buffer.copyFrom (i, 0, currentAudioOutputBuffer, i, 0, numSamples);
+            else
+                buffer.clear (i, 0, numSamples);
+        }
 
         midiMessages.clear();
         midiMessages.addEvents (currentMidiOutputBuffer, 0, buffer.getNumSamples(), 0);
@@ -596,7 +1097,8 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        writeAudioBuffer (index);
+        pushOp (std::make_unique<ClearOp> (index));
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -621,7 +1123,9 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        readAudioBuffer (srcIndex);
+        writeAudioBuffer (dstIndex);
+        pushOp (std::make_unique<CopyOp> (srcIndex, dstIndex));
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -646,7 +1150,9 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        readAudioBuffer (srcIndex);
+        writeAudioBuffer (dstIndex);
+        pushOp (std::make_unique<AddOp> (srcIndex, dstIndex));
     }
 
     JUCE_END_IGNORE_WARNINGS_MSVC
@@ -671,7 +1177,8 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        writeMidiBuffer (index);
+        pushOp (std::make_unique<ClearOp> (index));
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
@@ -696,7 +1203,9 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        readMidiBuffer (srcIndex);
+        writeMidiBuffer (dstIndex);
+        pushOp (std::make_unique<CopyOp> (srcIndex, dstIndex));
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
@@ -721,7 +1230,9 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        readMidiBuffer (srcIndex);
+        writeMidiBuffer (dstIndex);
+        pushOp (std::make_unique<AddOp> (srcIndex, dstIndex));
     }
 
     void addDelayChannelOp (int chan, int delaySize)
@@ -760,13 +1271,16 @@ struct GraphRenderSequence
             int readIndex = 0, writeIndex;
         };
 
-        renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
+        writeAudioBuffer (chan);
+        pushOp (std::make_unique<DelayChannelOp> (chan, delaySize));
+        totalDelaySamples += delaySize;
     }
 
     void addProcessOp (const Node::Ptr& node,
                        const Array<int>& audioChannelsUsed,
                        int totalNumChans,
-                       int midiBuffer)
+                       int midiBuffer,
+                       std::shared_ptr<NodeProfiler> profiler)
     {
         auto op = [&]() -> std::unique_ptr<NodeOp>
         {
@@ -778,6 +1292,7 @@ struct GraphRenderSequence
                         return std::make_unique<AudioInOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode:
+                        numAudioOutputChannels = jmax (numAudioOutputChannels, totalNumChans);
                         return std::make_unique<AudioOutOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode:
@@ -791,14 +1306,40 @@ struct GraphRenderSequence
             return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
         }();
 
-        renderOps.push_back (std::move (op));
+        op->profiler = std::move (profiler);
+
+        // Channels that are shared between the inputs and outputs are processed in place, but
+        // processors are expected to leave their input-only channels untouched.
+        const auto numOuts = node->getProcessor()->getTotalNumOutputChannels();
+
+        for (int i = 0; i < audioChannelsUsed.size(); ++i)
+        {
+            if (i < numOuts)
+                writeAudioBuffer (audioChannelsUsed[i]);
+            else
+                readAudioBuffer (audioChannelsUsed[i]);
+        }
+
+        if (node->getProcessor()->acceptsMidi() || node->getProcessor()->producesMidi())
+            writeMidiBuffer (midiBuffer);
+
+        if (auto* ioNode = dynamic_cast<const AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()))
+        {
+            if (ioNode->getType() == AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode)
+                access (audioOutputUsage, Access::write);
+            else if (ioNode->getType() == AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode)
+                access (midiOutputUsage, Access::write);
+        }
+
+        nodeOpIndices.push_back (renderOps.size());
+        pushOp (std::move (op));
     }
 
     void prepareBuffers (int blockSize)
     {
         renderingBuffer.setSize (numBuffersNeeded + 1, blockSize);
         renderingBuffer.clear();
-        currentAudioOutputBuffer.setSize (numBuffersNeeded + 1, blockSize);
+        currentAudioOutputBuffer.setSize (jmax (1, numAudioOutputChannels), blockSize);
         currentAudioOutputBuffer.clear();
 
         currentMidiOutputBuffer.clear();
@@ -817,7 +1358,23 @@ struct GraphRenderSequence
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
     }
 
-    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
+    /*  Call after prepareBuffers().
+
+        If the sequence contains nodes that don't depend on one another, the sequence will be
+        rendered in parallel using the threads in the provided pool. Otherwise, or if the pool
+        is null, the ops will be processed in order on the calling thread.
+    */
+    void prepareParallelRendering (std::shared_ptr<RenderThreadPool> pool)
+    {
+        threadPool = std::move (pool);
+        parallelJob.reset();
+
+        if (threadPool != nullptr && threadPool->getNumThreads() > 0 && hasIndependentNodes())
+            parallelJob = std::make_unique<ParallelJob> (opSuccessors);
+    }
+
+    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0, numAudioOutputChannels = 0;
+    int totalDelaySamples = 0;
 
     AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
 
@@ -845,7 +1402,8 @@ private:
               processor (*n->getProcessor()),
               audioChannelsToUse (audioChannelsUsed),
               audioChannels ((size_t) jmax (1, totalNumChans), nullptr),
-              midiBufferToUse (midiBufferIndex)
+              midiBufferToUse (midiBufferIndex),
+              usesMidi (processor.acceptsMidi() || processor.producesMidi())
         {
             while (audioChannelsToUse.size() < (int) audioChannels.size())
                 audioChannelsToUse.add (0);
@@ -881,7 +1439,24 @@ private:
             else
             {
                 const auto bypass = node->isBypassed() && processor.getBypassParameter() == nullptr;
-                processWithBuffer (c.globalIO, bypass, buffer, *midiBuffer);
+
+                // Processors that don't use MIDI get their own empty buffer, rather than sharing
+                // one with other nodes that might be processed at the same time.
+                if (! usesMidi)
+                    unusedMidiBuffer.clear();
+
+                auto& midi = usesMidi ? *midiBuffer : unusedMidiBuffer;
+
+                if (profiler != nullptr)
+                {
+                    const auto startTicks = Time::getHighResolutionTicks();
+                    processWithBuffer (c.globalIO, bypass, buffer, midi);
+                    profiler->addBlock (Time::getHighResolutionTicks() - startTicks);
+                }
+                else
+                {
+                    processWithBuffer (c.globalIO, bypass, buffer, midi);
+                }
             }
         }
 
@@ -894,6 +1469,9 @@ private:
         Array<int> audioChannelsToUse;
         std::vector<FloatType*> audioChannels;
         const int midiBufferToUse;
+        const bool usesMidi;
+        MidiBuffer unusedMidiBuffer;
+        std::shared_ptr<NodeProfiler> profiler;
     };
 
     struct ProcessOp final : public NodeOp
@@ -936,6 +1514,10 @@ private:
         template <typename Value>
         static void processImpl (bool bypass, AudioProcessor& p, AudioBuffer<Value>& audio, MidiBuffer& midi)
         {
+            JUCE_SCOPED_REALTIME_CONTEXT ("AudioProcessorGraph node")
+            JUCE_SCOPED_TRACE ("AudioProcessorGraph node")
+            AudioProcessLoadMeasurer::ScopedTimer timer (p.getProcessLoadMeasurer(), audio.getNumSamples());
+
             if (bypass)
                 p.processBlockBypassed (audio, midi);
             else
@@ -995,7 +1577,124 @@ private:
         }
     };
 
+    //==============================================================================
+    struct ParallelJob final : public ParallelRenderJob
+    {
+        using ParallelRenderJob::ParallelRenderJob;
+
+        void processStep (size_t index) override
+        {
+            ops[index]->process (*context);
+        }
+
+        const std::unique_ptr<RenderOp>* ops = nullptr;
+        const Context* context = nullptr;
+    };
+
+    //==============================================================================
+    /*  Ops are added in an order that is valid for serial rendering. When rendering in
+        parallel, each op must wait for any earlier op that writes a buffer it uses, and any op
+        writing to a buffer must also wait for earlier ops reading that buffer.
+    */
+    enum class Access { read, write };
+
+    struct Usage
+    {
+        std::optional<size_t> lastWriter;
+        std::vector<size_t> readersSinceLastWrite;
+    };
+
+    void addDependency (size_t from, size_t to)
+    {
+        if (from == to)
+            return;
+
+        auto& successors = opSuccessors[from];
+
+        if (successors.empty() || successors.back() != to)
+            successors.push_back (to);
+    }
+
+    void access (Usage& usage, Access type)
+    {
+        const auto thisOp = renderOps.size();
+
+        if (usage.lastWriter.has_value())
+            addDependency (*usage.lastWriter, thisOp);
+
+        if (type == Access::read)
+        {
+            usage.readersSinceLastWrite.push_back (thisOp);
+            return;
+        }
+
+        for (const auto reader : usage.readersSinceLastWrite)
+            addDependency (reader, thisOp);
+
+        usage.readersSinceLastWrite.clear();
+        usage.lastWriter = thisOp;
+    }
+
+    static Usage& getUsage (std::vector<Usage>& usages, int index)
+    {
+        if ((size_t) index >= usages.size())
+            usages.resize ((size_t) index + 1);
+
+        return usages[(size_t) index];
+    }
+
+    // The first audio buffer is always silent and is never written, so it can be shared freely.
+    void readAudioBuffer  (int index)  { if (index != 0) access (getUsage (audioBufferUsages, index), Access::read); }
+    void writeAudioBuffer (int index)  { if (index != 0) access (getUsage (audioBufferUsages, index), Access::write); }
+    void readMidiBuffer   (int index)  { access (getUsage (midiBufferUsages, index), Access::read); }
+    void writeMidiBuffer  (int index)  { access (getUsage (midiBufferUsages, index), Access::write); }
+
+    void pushOp (std::unique_ptr<RenderOp> op)
+    {
+        renderOps.push_back (std::move (op));
+        opSuccessors.resize (renderOps.size());
+    }
+
+    /*  Returns true if the longest chain of dependent nodes contains fewer nodes than the
+        whole sequence, i.e. at least two nodes could be processed at the same time.
+    */
+    bool hasIndependentNodes() const
+    {
+        const auto numNodeOps = (int) nodeOpIndices.size();
+
+        if (numNodeOps < 2)
+            return false;
+
+        // Ops only ever depend on earlier ops, so a single pass in order is enough.
+        std::vector<int> nodesOnLongestPath (renderOps.size(), 0);
+        std::vector<bool> isNodeOp (renderOps.size(), false);
+
+        for (const auto index : nodeOpIndices)
+            isNodeOp[index] = true;
+
+        auto longestPath = 0;
+
+        for (size_t i = 0; i < renderOps.size(); ++i)
+        {
+            const auto pathToHere = nodesOnLongestPath[i] + (isNodeOp[i] ? 1 : 0);
+            longestPath = jmax (longestPath, pathToHere);
+
+            for (const auto successor : opSuccessors[i])
+                nodesOnLongestPath[successor] = jmax (nodesOnLongestPath[successor], pathToHere);
+        }
+
+        return longestPath < numNodeOps;
+    }
+
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+
+    std::vector<std::vector<size_t>> opSuccessors;
+    std::vector<Usage> audioBufferUsages, midiBufferUsages;
+    Usage audioOutputUsage, midiOutputUsage;
+    std::vector<size_t> nodeOpIndices;
+
+    std::shared_ptr<RenderThreadPool> threadPool;
+    std::unique_ptr<ParallelJob> parallelJob;
 };
 
 //==============================================================================
@@ -1020,16 +1719,17 @@ public:
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
     template <typename FloatType>
-    static SequenceAndLatency build (const Nodes& n, const Connections& c)
+    static SequenceAndLatency build (const Nodes& n, const Connections& c, const NodeProfilers* profilers)
     {
         GraphRenderSequence<FloatType> sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
+        const RenderSequenceBuilder builder (n, c, profilers, sequence);
         return { std::move (sequence), builder.totalLatency };
     }
 
 private:
     //==============================================================================
     const Array<Node*> orderedNodes;
+    const NodeProfilers* const profilers;
 
     struct AssignedBuffer
     {
@@ -1056,6 +1756,7 @@ private:
     enum { readOnlyEmptyBufferIndex = 0 };
 
     std::unordered_map<uint32, int> delays;
+    std::map<NodeAndChannel, int> latestDestinationIndices;
     int totalLatency = 0;
 
     int getNodeDelay (NodeID nodeID) const noexcept
@@ -1069,14 +1770,30 @@ private:
         const auto sources = c.getSourceNodesForDestination (nodeID);
         return std::accumulate (sources.cbegin(), sources.cend(), 0, [this] (auto acc, auto source)
         {
-            return jmax (acc, this->getNodeDelay (source));
-        });
-    }
+            return jmax (acc, this->getNodeDelay (source));
+        });
+    }
+
+    //==============================================================================
+    /*  The ancestors of each node are stored as bitsets indexed by the node's position in the
+        graph's node list, which are far cheaper to merge and query than sets of NodeIDs.
+    */
+    struct NodeParents
+    {
+        std::unordered_map<uint32, int> indices;
+        std::vector<BigInteger> parents;
+        std::vector<bool> visited;
+
+        int getIndex (NodeID nodeID) const
+        {
+            const auto iter = indices.find (nodeID.uid);
+            return iter != indices.end() ? iter->second : -1;
+        }
+    };
 
-    //==============================================================================
     void getAllParentsOfNode (const NodeID& child,
-                              std::set<NodeID>& parents,
-                              const std::map<NodeID, std::set<NodeID>>& otherParents,
+                              BigInteger& parents,
+                              NodeParents& otherParents,
                               const Connections& c)
     {
         for (const auto& parentNode : c.getSourceNodesForDestination (child))
@@ -1084,42 +1801,52 @@ private:
             if (parentNode == child)
                 continue;
 
-            if (parents.insert (parentNode).second)
-            {
-                const auto parentParents = otherParents.find (parentNode);
+            const auto parentIndex = otherParents.getIndex (parentNode);
 
-                if (parentParents != otherParents.end())
-                {
-                    parents.insert (parentParents->second.begin(), parentParents->second.end());
-                    continue;
-                }
+            if (parentIndex < 0 || parents[parentIndex])
+                continue;
+
+            parents.setBit (parentIndex);
 
-                getAllParentsOfNode (parentNode, parents, otherParents, c);
+            if (otherParents.visited[(size_t) parentIndex])
+            {
+                parents |= otherParents.parents[(size_t) parentIndex];
+                continue;
             }
+
+            getAllParentsOfNode (parentNode, parents, otherParents, c);
         }
     }
 
     Array<Node*> createOrderedNodeList (const Nodes& n, const Connections& c)
     {
-        Array<Node*> result;
+        const auto& nodes = n.getNodes();
 
-        std::map<NodeID, std::set<NodeID>> nodeParents;
+        NodeParents nodeParents;
+        nodeParents.indices.reserve ((size_t) nodes.size());
+        nodeParents.parents.resize ((size_t) nodes.size());
+        nodeParents.visited.resize ((size_t) nodes.size(), false);
 
-        for (auto& node : n.getNodes())
+        for (int i = 0; i < nodes.size(); ++i)
+            nodeParents.indices.emplace (nodes.getUnchecked (i)->nodeID.uid, i);
+
+        Array<Node*> result;
+        Array<int> resultIndices;
+
+        for (int nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
         {
-            const auto nodeID = node->nodeID;
+            auto* node = nodes.getObjectPointerUnchecked (nodeIndex);
             int insertionIndex = 0;
 
             for (; insertionIndex < result.size(); ++insertionIndex)
-            {
-                auto& parents = nodeParents[result.getUnchecked (insertionIndex)->nodeID];
-
-                if (parents.find (nodeID) != parents.end())
+                if (nodeParents.parents[(size_t) resultIndices.getUnchecked (insertionIndex)][nodeIndex])
                     break;
-            }
 
             result.insert (insertionIndex, node);
-            getAllParentsOfNode (nodeID, nodeParents[node->nodeID], nodeParents, c);
+            resultIndices.insert (insertionIndex, nodeIndex);
+
+            nodeParents.visited[(size_t) nodeIndex] = true;
+            getAllParentsOfNode (node->nodeID, nodeParents.parents[(size_t) nodeIndex], nodeParents, c);
         }
 
         return result;
@@ -1387,6 +2114,7 @@ private:
         auto numIns  = processor.getTotalNumInputChannels();
         auto numOuts = processor.getTotalNumOutputChannels();
         auto totalChans = jmax (numIns, numOuts);
+        const auto delaySamplesBefore = sequence.totalDelaySamples;
 
         Array<int> audioChannelsToUse;
         const auto maxInputLatency = getInputLatencyForNode (c, node.nodeID);
@@ -1429,7 +2157,19 @@ private:
         if (numOuts == 0)
             totalLatency = jmax (totalLatency, thisNodeLatency);
 
-        sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse);
+        auto profiler = [&]() -> std::shared_ptr<NodeProfiler>
+        {
+            if (profilers == nullptr)
+                return nullptr;
+
+            const auto iter = profilers->find (node.nodeID);
+            return iter != profilers->end() ? iter->second : nullptr;
+        }();
+
+        if (profiler != nullptr)
+            profiler->setLatencies (processor.getLatencySamples(), sequence.totalDelaySamples - delaySamplesBefore);
+
+        sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse, std::move (profiler));
     }
 
     //==============================================================================
@@ -1462,8 +2202,9 @@ private:
                                      Array<AssignedBuffer>& buffers,
                                      const int stepIndex)
     {
+        // Buffers whose last reader was the node at stepIndex can be reused by the next node
         for (auto& b : buffers)
-            if (b.isAssigned() && ! isBufferNeededLater (c, stepIndex, -1, b.channel))
+            if (b.isAssigned() && ! isBufferNeededLater (c, stepIndex + 1, -1, b.channel))
                 b.setFree();
     }
 
@@ -1482,21 +2223,33 @@ private:
             return true;
         }
 
-        return std::any_of (orderedNodes.begin() + stepIndexToSearchFrom + 1, orderedNodes.end(), [&] (const auto* node)
-        {
-            return c.isSourceConnectedToDestinationNodeIgnoringChannel (output, node->nodeID, -1);
-        });
+        const auto iter = latestDestinationIndices.find (output);
+        return iter != latestDestinationIndices.cend() && stepIndexToSearchFrom < iter->second;
     }
 
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
-        : orderedNodes (createOrderedNodeList (n, c))
+    RenderSequenceBuilder (const Nodes& n, const Connections& c, const NodeProfilers* profilersIn, RenderSequence& sequence)
+        : orderedNodes (createOrderedNodeList (n, c)),
+          profilers (profilersIn)
     {
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
         midiBuffers .add (AssignedBuffer::createReadOnlyEmpty());
 
         const auto reversed = c.getDestinationsForSources();
 
+        // Finding out whether a buffer is needed later is the most frequent question that we ask
+        // while building the sequence, so it's worth caching the last place each output is used.
+        std::unordered_map<uint32, int> renderingIndices;
+
+        for (int i = 0; i < orderedNodes.size(); ++i)
+            renderingIndices.emplace (orderedNodes.getUnchecked (i)->nodeID.uid, i);
+
+        latestDestinationIndices = reversed.getLatestDestinationIndices ([&] (NodeID nodeID)
+        {
+            const auto iter = renderingIndices.find (nodeID.uid);
+            return iter != renderingIndices.cend() ? iter->second : -1;
+        });
+
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
             createRenderingOpsForNode (c, reversed, sequence, *orderedNodes.getUnchecked (i), i);
@@ -1521,10 +2274,16 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    std::shared_ptr<RenderThreadPool> pool,
+                    const NodeProfilers* profilers)
+        : RenderSequence (s,
+                          s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                              ? RenderSequenceBuilder::build<float>  (n, c, profilers)
+                              : RenderSequenceBuilder::build<double> (n, c, profilers),
+                          std::move (pool))
     {
     }
 
@@ -1549,10 +2308,14 @@ private:
         jassertfalse;
     }
 
-    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built)
+    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built, std::shared_ptr<RenderThreadPool> pool)
         : settings (s), sequence (std::move (built))
     {
-        visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize); });
+        visitRenderSequence (*this, [&] (auto& seq)
+        {
+            seq.prepareBuffers (settings.blockSize);
+            seq.prepareParallelRendering (std::move (pool));
+        });
     }
 
     PrepareSettings settings;
@@ -1759,6 +2522,11 @@ public:
         connections.disconnectNode (nodeID);
         auto result = nodes.removeNode (nodeID);
         nodeStates.removeNode (nodeID);
+
+        if (result != nullptr)
+            if (auto* nestedGraph = dynamic_cast<AudioProcessorGraph*> (result->getProcessor()))
+                nestedGraph->pimpl->setParentRenderThreadPool (nullptr);
+
         topologyChanged (updateKind);
         return result;
     }
@@ -1877,6 +2645,88 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
+    void setNumRenderThreads (int numThreads)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        numThreads = jmax (0, numThreads);
+
+        if (numThreads == getNumRenderThreads())
+            return;
+
+        renderThreadPool = numThreads > 0 ? std::make_shared<RenderThreadPool> (numThreads, sharedWorkgroup)
+                                          : nullptr;
+
+        // The topology hasn't changed, but the sequence must be rebuilt to use the new threads
+        lastBuiltSequence.reset();
+        rebuild (UpdateKind::sync);
+    }
+
+    int getNumRenderThreads() const
+    {
+        return renderThreadPool != nullptr ? renderThreadPool->getNumThreads() : 0;
+    }
+
+    /*  Lets a graph that's nested inside another one render on the outer graph's threads,
+        unless it has been given threads of its own.
+    */
+    void setParentRenderThreadPool (std::shared_ptr<RenderThreadPool> pool)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        if (std::exchange (parentRenderThreadPool, pool) == pool || renderThreadPool != nullptr)
+            return;
+
+        lastBuiltSequence.reset();
+        rebuild (UpdateKind::sync);
+    }
+
+    void setNodeProfilingEnabled (bool shouldBeEnabled)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        if (std::exchange (nodeProfilingEnabled, shouldBeEnabled) == shouldBeEnabled)
+            return;
+
+        if (! shouldBeEnabled)
+            nodeProfilers.clear();
+
+        lastBuiltSequence.reset();
+        rebuild (UpdateKind::sync);
+    }
+
+    bool isNodeProfilingEnabled() const
+    {
+        return nodeProfilingEnabled;
+    }
+
+    std::vector<NodeProfile> getNodeProfiles() const
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        std::vector<NodeProfile> result;
+        result.reserve (nodeProfilers.size());
+
+        for (const auto& [nodeID, profiler] : nodeProfilers)
+            result.push_back (profiler->getProfile (nodeID));
+
+        return result;
+    }
+
+    void resetNodeProfiles()
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        for (const auto& pair : nodeProfilers)
+            pair.second->reset();
+    }
+
+    /*  Call from the audio thread only. */
+    void audioWorkgroupContextChanged (const AudioWorkgroup& workgroup)
+    {
+        sharedWorkgroup.set (workgroup);
+    }
+
     template <typename Value>
     void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
     {
@@ -1926,6 +2776,13 @@ private:
 
     void handleAsyncUpdate()
     {
+        // Nested graphs are given the pool before they're prepared, so they're only built once
+        const auto pool = renderThreadPool != nullptr ? renderThreadPool : parentRenderThreadPool;
+
+        for (const auto node : nodes.getNodes())
+            if (auto* nestedGraph = dynamic_cast<AudioProcessorGraph*> (node->getProcessor()))
+                nestedGraph->pimpl->setParentRenderThreadPool (pool);
+
         if (const auto newSettings = nodeStates.applySettings (nodes))
         {
             for (const auto node : nodes.getNodes())
@@ -1935,7 +2792,14 @@ private:
 
             if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
             {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+                if (nodeProfilingEnabled)
+                    updateNodeProfilers();
+
+                auto sequence = std::make_unique<RenderSequence> (*newSettings,
+                                                                  nodes,
+                                                                  connections,
+                                                                  pool,
+                                                                  nodeProfilingEnabled ? &nodeProfilers : nullptr);
                 owner->setLatencySamples (sequence->getLatencySamples());
                 renderSequenceExchange.set (std::move (sequence));
             }
@@ -1947,10 +2811,29 @@ private:
         }
     }
 
+    /*  Keeps the statistics of nodes that are still in the graph, and adds some for new nodes. */
+    void updateNodeProfilers()
+    {
+        NodeProfilers updated;
+
+        for (const auto node : nodes.getNodes())
+        {
+            const auto iter = nodeProfilers.find (node->nodeID);
+            updated.emplace (node->nodeID, iter != nodeProfilers.end() ? iter->second
+                                                                       : std::make_shared<NodeProfiler>());
+        }
+
+        nodeProfilers = std::move (updated);
+    }
+
     AudioProcessorGraph* owner = nullptr;
     Nodes nodes;
     Connections connections;
     NodeStates nodeStates;
+    SharedAudioWorkgroup sharedWorkgroup;
+    std::shared_ptr<RenderThreadPool> renderThreadPool, parentRenderThreadPool;
+    NodeProfilers nodeProfilers;
+    bool nodeProfilingEnabled = false;
     RenderSequenceExchange renderSequenceExchange;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
@@ -2003,6 +2886,41 @@ void AudioProcessorGraph::setNonRealtime (bool isProcessingNonRealtime) noexcept
     pimpl->setNonRealtime (isProcessingNonRealtime);
 }
 
+void AudioProcessorGraph::audioWorkgroupContextChanged (const AudioWorkgroup& workgroup)
+{
+    pimpl->audioWorkgroupContextChanged (workgroup);
+}
+
+void AudioProcessorGraph::setNumRenderThreads (int numWorkerThreads)
+{
+    pimpl->setNumRenderThreads (numWorkerThreads);
+}
+
+int AudioProcessorGraph::getNumRenderThreads() const noexcept
+{
+    return pimpl->getNumRenderThreads();
+}
+
+void AudioProcessorGraph::setNodeProfilingEnabled (bool shouldBeEnabled)
+{
+    pimpl->setNodeProfilingEnabled (shouldBeEnabled);
+}
+
+bool AudioProcessorGraph::isNodeProfilingEnabled() const noexcept
+{
+    return pimpl->isNodeProfilingEnabled();
+}
+
+std::vector<AudioProcessorGraph::NodeProfile> AudioProcessorGraph::getNodeProfiles() const
+{
+    return pimpl->getNodeProfiles();
+}
+
+void AudioProcessorGraph::resetNodeProfiles()
+{
+    pimpl->resetNodeProfiles();
+}
+
 AudioProcessorGraph::Node::Ptr AudioProcessorGraph::removeNode (NodeID nodeID, UpdateKind updateKind)
 {
     return pimpl->removeNode (nodeID, updateKind);
@@ -2302,6 +3220,241 @@ public:
             // No test here, but older versions of the graph would take forever to complete building
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
+
+            const auto repatchStart = std::chrono::steady_clock::now();
+
+            for (auto it = nodeIDs.begin(); it != std::next (nodeIDs.begin(), 10); ++it)
+            {
+                expect (graph.removeConnection ({ { it[0], 0 }, { it[1], 0 } }));
+                expect (graph.addConnection    ({ { it[0], 0 }, { it[1], 0 } }));
+            }
+
+            const auto repatchEnd = std::chrono::steady_clock::now();
+            const auto repatchDuration = std::chrono::duration_cast<std::chrono::milliseconds> (repatchEnd - repatchStart).count();
+
+            // Each of these edits triggers a synchronous rebuild, which used to take several
+            // seconds on a graph of this size.
+            logMessage ("20 edits re-patched in " + String (repatchDuration) + " ms");
+        }
+
+        beginTest ("parallel rendering produces the same output as serial rendering");
+        {
+            constexpr auto blockSize = 64;
+
+            AudioProcessorGraph serialGraph, parallelGraph;
+            parallelGraph.setNumRenderThreads (3);
+            expect (parallelGraph.getNumRenderThreads() == 3);
+
+            for (auto* graph : { &serialGraph, &parallelGraph })
+            {
+                buildBranchingGraph (*graph);
+                graph->prepareToPlay (44100.0, blockSize);
+            }
+
+            Random random (getRandom().nextInt64());
+            AudioBuffer<float> serialBuffer (2, blockSize), parallelBuffer (2, blockSize);
+            MidiBuffer midi;
+
+            for (auto block = 0; block < 20; ++block)
+            {
+                for (auto channel = 0; channel < serialBuffer.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample < blockSize; ++sample)
+                        serialBuffer.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+                parallelBuffer.makeCopyOf (serialBuffer);
+
+                serialGraph.processBlock (serialBuffer, midi);
+                parallelGraph.processBlock (parallelBuffer, midi);
+
+                for (auto channel = 0; channel < serialBuffer.getNumChannels(); ++channel)
+                {
+                    expect (std::equal (serialBuffer.getReadPointer (channel),
+                                        serialBuffer.getReadPointer (channel) + blockSize,
+                                        parallelBuffer.getReadPointer (channel)));
+                }
+            }
+
+            parallelGraph.setNumRenderThreads (0);
+            expect (parallelGraph.getNumRenderThreads() == 0);
+        }
+
+        beginTest ("nested graphs rendered on the outer graph's threads match serial rendering");
+        {
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+            constexpr auto blockSize = 64;
+
+            AudioProcessorGraph serialGraph, parallelGraph;
+            parallelGraph.setNumRenderThreads (3);
+
+            for (auto* graph : { &serialGraph, &parallelGraph })
+            {
+                graph->setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+                const auto input  = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+                const auto output = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+                for (auto group = 0; group < 4; ++group)
+                {
+                    auto nested = std::make_unique<AudioProcessorGraph>();
+                    buildBranchingGraph (*nested);
+
+                    // Give the groups different latencies, so that the outer graph has to compensate
+                    const auto gain = graph->addNode (std::make_unique<GainProcessor> (0.25f, group * 5))->nodeID;
+                    const auto nestedID = graph->addNode (std::move (nested))->nodeID;
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                    {
+                        graph->addConnection ({ { input,    channel }, { gain,     channel } });
+                        graph->addConnection ({ { gain,     channel }, { nestedID, channel } });
+                        graph->addConnection ({ { nestedID, channel }, { output,   channel } });
+                    }
+                }
+
+                graph->prepareToPlay (44100.0, blockSize);
+            }
+
+            expectEquals (parallelGraph.getLatencySamples(), serialGraph.getLatencySamples());
+            expect (parallelGraph.getLatencySamples() > 0);
+
+            Random random (getRandom().nextInt64());
+            AudioBuffer<float> serialBuffer (2, blockSize), parallelBuffer (2, blockSize);
+            MidiBuffer midi;
+
+            for (auto block = 0; block < 20; ++block)
+            {
+                for (auto channel = 0; channel < serialBuffer.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample < blockSize; ++sample)
+                        serialBuffer.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+                parallelBuffer.makeCopyOf (serialBuffer);
+
+                serialGraph.processBlock (serialBuffer, midi);
+                parallelGraph.processBlock (parallelBuffer, midi);
+
+                for (auto channel = 0; channel < serialBuffer.getNumChannels(); ++channel)
+                {
+                    expect (std::equal (serialBuffer.getReadPointer (channel),
+                                        serialBuffer.getReadPointer (channel) + blockSize,
+                                        parallelBuffer.getReadPointer (channel)));
+                }
+            }
+        }
+
+        beginTest ("channels that aren't written by the output node are cleared");
+        {
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+            constexpr auto blockSize = 64;
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (4, 2, 44100.0, blockSize);
+
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+                graph.addConnection ({ { input, channel + 2 }, { output, channel } });
+
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> buffer (4, blockSize);
+            MidiBuffer midi;
+
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (auto sample = 0; sample < blockSize; ++sample)
+                    buffer.setSample (channel, sample, (float) (channel + 1));
+
+            // Use a block that is longer than the prepared size, so that it gets split into chunks
+            AudioBuffer<float> longBuffer (4, blockSize * 3);
+
+            for (auto channel = 0; channel < longBuffer.getNumChannels(); ++channel)
+                for (auto start = 0; start < longBuffer.getNumSamples(); start += blockSize)
+                    longBuffer.copyFrom (channel, start, buffer, channel, 0, blockSize);
+
+            for (auto* b : { &buffer, &longBuffer })
+            {
+                graph.processBlock (*b, midi);
+
+                for (auto channel = 0; channel < b->getNumChannels(); ++channel)
+                {
+                    const auto expected = channel < 2 ? (float) (channel + 3) : 0.0f;
+                    const auto* data = b->getReadPointer (channel);
+
+                    expect (std::all_of (data, data + b->getNumSamples(), [&] (float x) { return exactlyEqual (x, expected); }));
+                }
+            }
+        }
+
+        beginTest ("node profiling reports timings and latencies for each node");
+        {
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+            constexpr auto blockSize = 64;
+            constexpr auto latency = 10;
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            const auto input   = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+            const auto delayed = graph.addNode (std::make_unique<GainProcessor> (1.0f, latency))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                graph.addConnection ({ { input,   channel }, { delayed, channel } });
+                graph.addConnection ({ { delayed, channel }, { output,  channel } });
+                graph.addConnection ({ { input,   channel }, { output,  channel } });
+            }
+
+            expect (! graph.isNodeProfilingEnabled());
+            graph.prepareToPlay (44100.0, blockSize);
+            expect (graph.getNodeProfiles().empty());
+
+            graph.setNodeProfilingEnabled (true);
+            expect (graph.isNodeProfilingEnabled());
+
+            AudioBuffer<float> buffer (2, blockSize);
+            MidiBuffer midi;
+
+            constexpr auto numBlocks = 10;
+
+            for (auto block = 0; block < numBlocks; ++block)
+                graph.processBlock (buffer, midi);
+
+            const auto profiles = graph.getNodeProfiles();
+            expect (profiles.size() == 3);
+
+            const auto getProfile = [&] (AudioProcessorGraph::NodeID nodeID)
+            {
+                const auto iter = std::find_if (profiles.begin(), profiles.end(), [&] (const auto& p) { return p.nodeID == nodeID; });
+                return iter != profiles.end() ? *iter : AudioProcessorGraph::NodeProfile{};
+            };
+
+            for (const auto& profile : profiles)
+            {
+                expect (profile.numBlocks == numBlocks);
+                expect (profile.minMilliseconds <= profile.meanMilliseconds);
+                expect (profile.meanMilliseconds <= profile.maxMilliseconds);
+                expect (profile.p99Milliseconds <= profile.maxMilliseconds);
+            }
+
+            expectEquals (getProfile (delayed).latencySamples, latency);
+            expectEquals (getProfile (delayed).delayCompensationSamples, 0);
+            expectEquals (getProfile (output).delayCompensationSamples, 2 * latency);
+
+            graph.resetNodeProfiles();
+
+            for (const auto& profile : graph.getNodeProfiles())
+                expect (profile.numBlocks == 0);
+
+            graph.processBlock (buffer, midi);
+
+            for (const auto& profile : graph.getNodeProfiles())
+                expect (profile.numBlocks == 1);
+
+            graph.setNodeProfilingEnabled (false);
+            expect (graph.getNodeProfiles().empty());
         }
     }
 
@@ -2309,6 +3462,89 @@ private:
     enum class MidiIn  { no, yes };
     enum class MidiOut { no, yes };
 
+    /*  Creates a graph where the input is split between several branches with differing
+        latencies, which are then mixed together into a single output.
+    */
+    static void buildBranchingGraph (AudioProcessorGraph& graph)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+
+        const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+        const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+        const auto mixer  = graph.addNode (std::make_unique<GainProcessor> (0.5f, 0))->nodeID;
+
+        for (auto branch = 0; branch < 6; ++branch)
+        {
+            const auto first  = graph.addNode (std::make_unique<GainProcessor> (0.1f * (float) (branch + 1), branch * 3))->nodeID;
+            const auto second = graph.addNode (std::make_unique<GainProcessor> (1.0f - 0.1f * (float) branch, branch % 2))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                graph.addConnection ({ { input,  channel }, { first,  channel } });
+                graph.addConnection ({ { first,  channel }, { second, channel } });
+                graph.addConnection ({ { second, channel }, { mixer,  channel } });
+
+                if (branch % 3 == 0)
+                    graph.addConnection ({ { first, channel }, { mixer, channel } });
+            }
+        }
+
+        for (auto channel = 0; channel < 2; ++channel)
+        {
+            graph.addConnection ({ { mixer, channel }, { output, channel } });
+            graph.addConnection ({ { input, channel }, { output, channel } });
+        }
+    }
+
+    /*  Applies a gain and adds a channel-dependent offset, so that the output depends on both
+        the values and the ordering of the input channels.
+    */
+    class GainProcessor final : public AudioProcessor
+    {
+    public:
+        GainProcessor (float gainIn, int latency)
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())),
+              gain (gainIn)
+        {
+            setLatencySamples (latency);
+        }
+
+        const String getName() const override                         { return "Gain Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                auto* data = buffer.getWritePointer (channel);
+
+                for (auto sample = 0; sample < buffer.getNumSamples(); ++sample)
+                    data[sample] = data[sample] * gain + 0.01f * (float) (channel + 1);
+            }
+        }
+
+        using AudioProcessor::processBlock;
+
+    private:
+        float gain = 1.0f;
+    };
+
     class BasicProcessor final : public AudioProcessor
     {
     public:
@@ -332,6 +332,101 @@ public:
     */
     void rebuild();
 
+    //==============================================================================
+    /** Allows the graph to render independent branches in parallel.
+
+        By default, the graph processes all of its nodes one after another on the thread
+        that calls processBlock(). If you set this to a value greater than zero, the graph
+        will start this many realtime worker threads, and during each processBlock() call
+        the nodes will be shared between those threads and the calling thread. A node is
+        only processed once all of the nodes it depends on have finished, so the results
+        are identical to those of serial rendering.
+
+        If the graph receives an AudioWorkgroup via audioWorkgroupContextChanged(), the
+        worker threads will join that workgroup.
+
+        All of the processors in the graph must tolerate being processed at the same time as
+        one another on different threads. Graphs consisting of a single chain of nodes will
+        continue to be rendered serially, because there is nothing that can run in parallel.
+
+        Graphs that are nodes of this graph (and graphs nested inside those) share its worker
+        threads, unless they've been given threads of their own. The nodes inside a nested
+        graph are then spread across all of the threads, along with the rest of this graph's
+        nodes, rather than the nested graph being processed by a single thread. Each nested
+        graph compensates for the latency of its own nodes and reports the total as its
+        latency, so this graph compensates for it like any other node.
+
+        Pass zero to stop the worker threads and return to serial rendering. This function
+        should only be called from the message thread.
+
+        @see getNumRenderThreads
+    */
+    void setNumRenderThreads (int numWorkerThreads);
+
+    /** Returns the number of worker threads that was set with setNumRenderThreads().
+
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
+
+    //==============================================================================
+    /** Timing and latency statistics for a single node, as returned by getNodeProfiles(). */
+    struct NodeProfile
+    {
+        /** The node that these statistics describe. */
+        NodeID nodeID;
+
+        /** The number of blocks that have been timed since profiling was enabled or reset. */
+        int64 numBlocks = 0;
+
+        /** The wall-clock time taken to process a block, in milliseconds.
+
+            The 99th percentile is estimated from a histogram, and is only accurate to within
+            about 20%.
+        */
+        double minMilliseconds = 0.0, meanMilliseconds = 0.0, maxMilliseconds = 0.0, p99Milliseconds = 0.0;
+
+        /** The latency reported by the node's processor when the graph was last built. */
+        int latencySamples = 0;
+
+        /** The total length of the delay lines that the graph inserts in front of this node's
+            inputs to compensate for the latency of other nodes, summed over all channels.
+        */
+        int delayCompensationSamples = 0;
+    };
+
+    /** Enables or disables the collection of per-node timing statistics.
+
+        While profiling is enabled, the graph measures the time taken by each of its nodes
+        during every processBlock() call, which adds a small amount of overhead. The results
+        can be retrieved with getNodeProfiles().
+
+        This function should only be called from the message thread.
+
+        @see getNodeProfiles, resetNodeProfiles
+    */
+    void setNodeProfilingEnabled (bool shouldBeEnabled);
+
+    /** Returns true if node profiling has been enabled with setNodeProfilingEnabled(). */
+    bool isNodeProfilingEnabled() const noexcept;
+
+    /** Returns the statistics gathered for each node since profiling was enabled.
+
+        This doesn't take any locks, so it is safe to call repeatedly from the message thread
+        while the graph is rendering, e.g. from a Timer. Nodes that have been added since the
+        graph was last rebuilt won't be included yet.
+
+        @see setNodeProfilingEnabled
+    */
+    std::vector<NodeProfile> getNodeProfiles() const;
+
+    /** Clears the timing statistics of all nodes.
+
+        The statistics are cleared by the rendering thread when it processes the next block.
+        This function should only be called from the message thread.
+    */
+    void resetNodeProfiles();
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -428,6 +523,7 @@ public:
 
     void reset() override;
     void setNonRealtime (bool) noexcept override;
+    void audioWorkgroupContextChanged (const AudioWorkgroup&) override;
 
     double getTailLengthSeconds() const override;
     bool acceptsMidi() const override;
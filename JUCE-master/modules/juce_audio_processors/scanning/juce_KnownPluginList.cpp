@@ -42,6 +42,8 @@ void KnownPluginList::clear()
 {
     ScopedLock lock (typesArrayLock);
 
+    fingerprints.clear();
+
     if (! types.isEmpty())
     {
         types.clear();
@@ -127,6 +129,9 @@ void KnownPluginList::removeType (const PluginDescription& type)
         for (int i = types.size(); --i >= 0;)
             if (types.getUnchecked (i).isDuplicateOf (type))
                 types.remove (i);
+
+        // Make sure that the next scan finds this type again
+        fingerprints.erase ({ type.pluginFormatName, type.fileOrIdentifier });
     }
 
     sendChangeMessage();
@@ -135,6 +140,9 @@ void KnownPluginList::removeType (const PluginDescription& type)
 bool KnownPluginList::isListingUpToDate (const String& fileOrIdentifier,
                                          AudioPluginFormat& formatToUse) const
 {
+    if (isFingerprintUpToDate (fileOrIdentifier, formatToUse))
+        return true;
+
     if (getTypeForFile (fileOrIdentifier) == nullptr)
         return false;
 
@@ -147,6 +155,68 @@ bool KnownPluginList::isListingUpToDate (const String& fileOrIdentifier,
     return true;
 }
 
+//==============================================================================
+KnownPluginList::FileFingerprint KnownPluginList::FileFingerprint::fromFile (const File& file)
+{
+    FileFingerprint result;
+    result.lastModificationTime = file.getLastModificationTime();
+
+    if (! file.isDirectory())
+    {
+        result.size = file.getSize();
+        return result;
+    }
+
+    // The directory iterator's order isn't defined, so combine the entries with an addition
+    for (const auto& entry : RangedDirectoryIterator (file, true, "*", File::findFiles))
+    {
+        result.size += entry.getFileSize();
+        result.contentsHash += (uint64) (entry.getFile().getRelativePathFrom (file)
+                                           + ":" + String (entry.getFileSize())
+                                           + ":" + String (entry.getModificationTime().toMilliseconds())).hashCode64();
+    }
+
+    return result;
+}
+
+static bool canBeFingerprinted (const String& fileOrIdentifier)
+{
+    return File::isAbsolutePath (fileOrIdentifier) && File (fileOrIdentifier).exists();
+}
+
+void KnownPluginList::updateFingerprint (const String& fileOrIdentifier, AudioPluginFormat& format)
+{
+    if (! canBeFingerprinted (fileOrIdentifier))
+        return;
+
+    const auto fingerprint = FileFingerprint::fromFile (File (fileOrIdentifier));
+
+    ScopedLock lock (typesArrayLock);
+    fingerprints[{ format.getName(), fileOrIdentifier }] = fingerprint;
+}
+
+bool KnownPluginList::isFingerprintUpToDate (const String& fileOrIdentifier, AudioPluginFormat& format) const
+{
+    if (! canBeFingerprinted (fileOrIdentifier))
+        return false;
+
+    const auto stored = [&]() -> std::optional<FileFingerprint>
+    {
+        ScopedLock lock (typesArrayLock);
+        const auto it = fingerprints.find ({ format.getName(), fileOrIdentifier });
+        return it != fingerprints.end() ? std::optional<FileFingerprint> (it->second) : std::nullopt;
+    }();
+
+    return stored.has_value() && *stored == FileFingerprint::fromFile (File (fileOrIdentifier));
+}
+
+void KnownPluginList::clearFingerprints()
+{
+    ScopedLock lock (typesArrayLock);
+    fingerprints.clear();
+}
+
+//==============================================================================
 void KnownPluginList::setCustomScanner (std::unique_ptr<CustomScanner> newScanner)
 {
     if (scanner != newScanner)
@@ -160,6 +230,17 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
 {
     const ScopedLock sl (scanLock);
 
+    if (dontRescanIfAlreadyInList && isFingerprintUpToDate (fileOrIdentifier, format))
+    {
+        ScopedLock lock (typesArrayLock);
+
+        for (auto& d : types)
+            if (d.fileOrIdentifier == fileOrIdentifier && d.pluginFormatName == format.getName())
+                typesFound.add (new PluginDescription (d));
+
+        return false;
+    }
+
     if (dontRescanIfAlreadyInList
          && getTypeForFile (fileOrIdentifier) != nullptr)
     {
@@ -201,6 +282,9 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
         }
     }
 
+    if (! blacklist.contains (fileOrIdentifier))
+        updateFingerprint (fileOrIdentifier, format);
+
     for (auto* desc : found)
     {
         if (desc == nullptr)
@@ -382,6 +466,20 @@ std::unique_ptr<XmlElement> KnownPluginList::createXml() const
     for (auto& b : blacklist)
         e->createNewChildElement ("BLACKLISTED")->setAttribute ("id", b);
 
+    {
+        ScopedLock lock (typesArrayLock);
+
+        for (const auto& [key, fingerprint] : fingerprints)
+        {
+            auto* f = e->createNewChildElement ("FINGERPRINT");
+            f->setAttribute ("format", key.first);
+            f->setAttribute ("file", key.second);
+            f->setAttribute ("size", String (fingerprint.size));
+            f->setAttribute ("modified", String (fingerprint.lastModificationTime.toMilliseconds()));
+            f->setAttribute ("contents", String::toHexString ((int64) fingerprint.contentsHash));
+        }
+    }
+
     return e;
 }
 
@@ -397,9 +495,23 @@ void KnownPluginList::recreateFromXml (const XmlElement& xml)
             PluginDescription info;
 
             if (e->hasTagName ("BLACKLISTED"))
+            {
                 blacklist.add (e->getStringAttribute ("id"));
+            }
+            else if (e->hasTagName ("FINGERPRINT"))
+            {
+                FileFingerprint fingerprint;
+                fingerprint.size = e->getStringAttribute ("size").getLargeIntValue();
+                fingerprint.lastModificationTime = Time (e->getStringAttribute ("modified").getLargeIntValue());
+                fingerprint.contentsHash = (uint64) e->getStringAttribute ("contents").getHexValue64();
+
+                const ScopedLock lock (typesArrayLock);
+                fingerprints[{ e->getStringAttribute ("format"), e->getStringAttribute ("file") }] = fingerprint;
+            }
             else if (info.loadFromXml (*e))
+            {
                 addType (info);
+            }
         }
     }
 }
@@ -647,5 +759,121 @@ std::unique_ptr<KnownPluginList::PluginTree> KnownPluginList::createTree (const
     return createTree (getTypes(), sortMethod);
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class KnownPluginListTests final : public UnitTest
+{
+public:
+    KnownPluginListTests()
+        : UnitTest ("Known Plugin List", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile tempFile;
+        const auto file = tempFile.getFile();
+        file.replaceWithText ("plugin");
+
+        beginTest ("Unchanged files aren't scanned again");
+        {
+            KnownPluginList list;
+            CountingFormat format;
+            OwnedArray<PluginDescription> found;
+
+            expect (list.scanAndAddFile (file.getFullPathName(), true, found, format));
+
+            found.clear();
+            expect (! list.scanAndAddFile (file.getFullPathName(), true, found, format));
+            expectEquals (format.numScans, 1);
+            expectEquals (found.size(), 2);
+
+            list.scanAndAddFile (file.getFullPathName(), false, found, format);
+            expectEquals (format.numScans, 2);
+        }
+
+        beginTest ("Files without any plugins aren't scanned again");
+        {
+            KnownPluginList list;
+            CountingFormat format;
+            format.numTypesToFind = 0;
+            OwnedArray<PluginDescription> found;
+
+            list.scanAndAddFile (file.getFullPathName(), true, found, format);
+            list.scanAndAddFile (file.getFullPathName(), true, found, format);
+            expectEquals (format.numScans, 1);
+            expect (list.isListingUpToDate (file.getFullPathName(), format));
+        }
+
+        beginTest ("Changed files are scanned again");
+        {
+            KnownPluginList list;
+            CountingFormat format;
+            OwnedArray<PluginDescription> found;
+
+            list.scanAndAddFile (file.getFullPathName(), true, found, format);
+            file.appendText ("changed");
+            list.scanAndAddFile (file.getFullPathName(), true, found, format);
+            expectEquals (format.numScans, 2);
+        }
+
+        beginTest ("Fingerprints are saved in the XML state");
+        {
+            KnownPluginList list;
+            CountingFormat format;
+            OwnedArray<PluginDescription> found;
+
+            list.scanAndAddFile (file.getFullPathName(), true, found, format);
+
+            KnownPluginList restored;
+            restored.recreateFromXml (*list.createXml());
+            expect (restored.isFingerprintUpToDate (file.getFullPathName(), format));
+
+            restored.scanAndAddFile (file.getFullPathName(), true, found, format);
+            expectEquals (format.numScans, 1);
+
+            restored.clearFingerprints();
+            expect (! restored.isFingerprintUpToDate (file.getFullPathName(), format));
+        }
+    }
+
+private:
+    struct CountingFormat final : public AudioPluginFormat
+    {
+        String getName() const override     { return "Counting"; }
+
+        void findAllTypesForFile (OwnedArray<PluginDescription>& results, const String& fileOrIdentifier) override
+        {
+            ++numScans;
+
+            for (int i = 0; i < numTypesToFind; ++i)
+            {
+                auto desc = std::make_unique<PluginDescription>();
+                desc->name = "Plugin " + String (i);
+                desc->pluginFormatName = getName();
+                desc->fileOrIdentifier = fileOrIdentifier;
+                desc->uniqueId = desc->deprecatedUid = i + 1;
+                results.add (std::move (desc));
+            }
+        }
+
+        bool fileMightContainThisPluginType (const String&) override                { return true; }
+        String getNameOfPluginFromIdentifier (const String& id) override            { return id; }
+        bool pluginNeedsRescanning (const PluginDescription&) override              { return true; }
+        bool doesPluginStillExist (const PluginDescription&) override               { return true; }
+        bool canScanForPlugins() const override                                     { return true; }
+        bool isTrivialToScan() const override                                       { return false; }
+        StringArray searchPathsForPlugins (const FileSearchPath&, bool, bool) override  { return {}; }
+        FileSearchPath getDefaultLocationsToSearch() override                       { return {}; }
+        bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override  { return false; }
+        void createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback) override {}
+
+        int numScans = 0, numTypesToFind = 2;
+    };
+};
+
+static KnownPluginListTests knownPluginListTests;
+
+#endif
 
 } // namespace juce
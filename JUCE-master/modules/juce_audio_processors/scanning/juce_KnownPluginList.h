@@ -111,6 +111,60 @@ public:
     bool isListingUpToDate (const String& possiblePluginFileOrIdentifier,
                             AudioPluginFormat& formatToUse) const;
 
+    //==============================================================================
+    /** A summary of a plugin file's size and modification times.
+
+        The list stores one of these for every file that it scans, including files that
+        turn out not to contain any plugins. When scanAndAddFile() is asked not to rescan
+        known files, any file whose fingerprint is unchanged is skipped without being
+        loaded, which makes rescanning a folder of unchanged plugins very quick.
+
+        For bundles, which are directories, the fingerprint covers the names, sizes and
+        modification times of all the files inside the bundle, so replacing the binary
+        inside a bundle will be noticed even if the bundle's own time doesn't change.
+    */
+    struct FileFingerprint
+    {
+        /** Creates a fingerprint for a file or bundle. This doesn't read the file's contents. */
+        static FileFingerprint fromFile (const File& file);
+
+        /** The total size of the file, or of all the files inside a bundle. */
+        int64 size = 0;
+
+        /** The modification time of the file or bundle itself. */
+        Time lastModificationTime;
+
+        /** For bundles, a hash of the names, sizes and times of the files inside it. */
+        uint64 contentsHash = 0;
+
+        bool operator== (const FileFingerprint& other) const noexcept
+        {
+            return std::tie (size, lastModificationTime, contentsHash)
+                == std::tie (other.size, other.lastModificationTime, other.contentsHash);
+        }
+
+        bool operator!= (const FileFingerprint& other) const noexcept   { return ! operator== (other); }
+    };
+
+    /** Records the current fingerprint of a file, to show that it has just been scanned
+        with the given format.
+
+        scanAndAddFile() calls this automatically, but custom scanning code should call it
+        after adding the types that it finds in a file. This does nothing if the ID isn't
+        the path of an existing file.
+    */
+    void updateFingerprint (const String& fileOrIdentifier, AudioPluginFormat& format);
+
+    /** Returns true if the given file has been scanned with this format, and its
+        fingerprint shows that it hasn't changed since then.
+    */
+    bool isFingerprintUpToDate (const String& fileOrIdentifier, AudioPluginFormat& format) const;
+
+    /** Forgets all of the stored file fingerprints, so that every file will be scanned
+        again by the next scan.
+    */
+    void clearFingerprints();
+
     /** Scans and adds a bunch of files that might have been dragged-and-dropped.
         If any types are found in the files, their descriptions are returned in the array.
     */
@@ -240,6 +294,7 @@ private:
     //==============================================================================
     Array<PluginDescription> types;
     StringArray blacklist;
+    std::map<std::pair<String, String>, FileFingerprint> fingerprints;
     std::unique_ptr<CustomScanner> scanner;
     CriticalSection scanLock, typesArrayLock;
 
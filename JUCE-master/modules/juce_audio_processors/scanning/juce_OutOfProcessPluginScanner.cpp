@@ -0,0 +1,461 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class OutOfProcessPluginScanner::Connection final : private ChildProcessCoordinator
+{
+public:
+    enum class State
+    {
+        idle,
+        scanning,
+        finished,
+        failed
+    };
+
+    explicit Connection (WaitableEvent& eventToSignal)
+        : event (eventToSignal) {}
+
+    ~Connection() override
+    {
+        killWorkerProcess();
+    }
+
+    bool launch (const Options& options)
+    {
+        return launchWorkerProcess (options.workerExecutable, options.commandLineUID, 0, 0);
+    }
+
+    bool startScan (const String& formatName, const String& fileOrIdentifier, int timeoutMs)
+    {
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+            state = State::scanning;
+            result.reset();
+        }
+
+        currentFile = fileOrIdentifier;
+        startTime = Time::getMillisecondCounter();
+
+        MemoryBlock block;
+
+        {
+            MemoryOutputStream stream (block, false);
+            stream.writeString (formatName);
+            stream.writeString (fileOrIdentifier);
+            stream.writeInt (timeoutMs);
+        }
+
+        return sendMessageToWorker (block);
+    }
+
+    State getState() const
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        return state;
+    }
+
+    std::unique_ptr<XmlElement> takeResult()
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        state = State::idle;
+        currentFile = {};
+        return std::move (result);
+    }
+
+    bool hasTimedOut (int timeoutMs) const
+    {
+        return getState() == State::scanning
+            && (int) (Time::getMillisecondCounter() - startTime) > timeoutMs;
+    }
+
+    const String& getCurrentFile() const noexcept     { return currentFile; }
+
+private:
+    void handleMessageFromWorker (const MemoryBlock& mb) override
+    {
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+            result = parseXML (mb.toString());
+            state = State::finished;
+        }
+
+        event.signal();
+    }
+
+    void handleConnectionLost() override
+    {
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (state != State::finished)
+                state = State::failed;
+        }
+
+        event.signal();
+    }
+
+    WaitableEvent& event;
+    mutable std::mutex mutex;
+    State state = State::idle;
+    std::unique_ptr<XmlElement> result;
+    String currentFile;
+    uint32 startTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Connection)
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (KnownPluginList& listToAddResultsTo)
+    : OutOfProcessPluginScanner (listToAddResultsTo, Options{})
+{
+}
+
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (KnownPluginList& listToAddResultsTo, Options optionsIn)
+    : list (listToAddResultsTo), options (std::move (optionsIn))
+{
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner() = default;
+
+bool OutOfProcessPluginScanner::scan (AudioPluginFormat& format, const StringArray& filesOrIdentifiers)
+{
+    shouldCancel = false;
+    progress = 0.0f;
+
+    {
+        const ScopedLock sl (failedFilesLock);
+        failedFiles.clear();
+    }
+
+    std::deque<String> pending;
+
+    for (const auto& file : filesOrIdentifiers)
+    {
+        if (list.getBlacklistedFiles().contains (file))
+            continue;
+
+        if (options.dontRescanIfAlreadyInList && list.isListingUpToDate (file, format))
+            continue;
+
+        pending.push_back (file);
+    }
+
+    const auto numFiles = (int) pending.size();
+    auto numFilesDone = 0;
+
+    if (numFiles == 0)
+    {
+        progress = 1.0f;
+        return true;
+    }
+
+    const auto numWorkers = jlimit (1, numFiles, options.numWorkers > 0 ? options.numWorkers
+                                                                        : SystemStats::getNumPhysicalCpus());
+
+    std::vector<std::unique_ptr<Connection>> workers ((size_t) numWorkers);
+
+    const auto fileFailed = [&] (const String& file)
+    {
+        if (file.isNotEmpty())
+        {
+            list.addToBlacklist (file);
+
+            const ScopedLock sl (failedFilesLock);
+            failedFiles.add (file);
+        }
+    };
+
+    while (! shouldCancel)
+    {
+        auto anyWorkersBusy = false;
+
+        for (auto& worker : workers)
+        {
+            if (worker != nullptr)
+            {
+                const auto state = worker->getState();
+
+                if (state == Connection::State::scanning && ! worker->hasTimedOut (options.timeoutMs))
+                {
+                    anyWorkersBusy = true;
+                    continue;
+                }
+
+                if (state == Connection::State::finished)
+                {
+                    list.updateFingerprint (worker->getCurrentFile(), format);
+
+                    if (const auto xml = worker->takeResult())
+                    {
+                        for (const auto* item : xml->getChildIterator())
+                        {
+                            PluginDescription desc;
+
+                            if (desc.loadFromXml (*item))
+                                list.addType (desc);
+                        }
+                    }
+
+                    ++numFilesDone;
+                }
+                else if (state != Connection::State::idle)
+                {
+                    // The worker crashed or hung, so blame the plugin it was scanning and start a new one
+                    if (worker->getCurrentFile().isNotEmpty())
+                        ++numFilesDone;
+
+                    fileFailed (worker->getCurrentFile());
+                    worker.reset();
+                }
+            }
+
+            if (pending.empty())
+                continue;
+
+            if (worker == nullptr)
+            {
+                worker = std::make_unique<Connection> (workerEvent);
+
+                if (! worker->launch (options))
+                {
+                    worker.reset();
+                    continue;
+                }
+            }
+
+            if (worker->startScan (format.getName(), pending.front(), options.timeoutMs))
+            {
+                pending.pop_front();
+                anyWorkersBusy = true;
+            }
+            else
+            {
+                worker.reset();
+            }
+        }
+
+        progress = (float) numFilesDone / (float) numFiles;
+
+        if (! anyWorkersBusy)
+        {
+            // If no workers could be started, the executable probably doesn't call createWorkerIfRequested()
+            jassert (pending.empty());
+            return pending.empty();
+        }
+
+        workerEvent.wait (50);
+    }
+
+    return false;
+}
+
+void OutOfProcessPluginScanner::cancel() noexcept
+{
+    shouldCancel = true;
+    workerEvent.signal();
+}
+
+StringArray OutOfProcessPluginScanner::getFailedFiles() const
+{
+    const ScopedLock sl (failedFilesLock);
+    return failedFiles;
+}
+
+//==============================================================================
+class OutOfProcessPluginScanner::Worker::Impl final : private ChildProcessWorker,
+                                                       private AsyncUpdater,
+                                                       private Thread
+{
+public:
+    explicit Impl (std::function<void (AudioPluginFormatManager&)> addFormats)
+        : Thread ("Plugin scan watchdog")
+    {
+        if (addFormats != nullptr)
+            addFormats (formatManager);
+        else
+            formatManager.addDefaultFormats();
+    }
+
+    ~Impl() override
+    {
+        cancelPendingUpdate();
+        stopThread (2000);
+    }
+
+    bool initialise (const String& commandLine, const String& commandLineUID)
+    {
+        if (! initialiseFromCommandLine (commandLine, commandLineUID))
+            return false;
+
+        startThread (Priority::low);
+        return true;
+    }
+
+private:
+    void handleMessageFromCoordinator (const MemoryBlock& mb) override
+    {
+        if (mb.isEmpty())
+            return;
+
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        if (const auto results = scanIfPossible (mb, false))
+        {
+            sendResults (*results);
+        }
+        else
+        {
+            pendingBlocks.emplace (mb);
+            triggerAsyncUpdate();
+        }
+    }
+
+    void handleConnectionLost() override
+    {
+        JUCEApplicationBase::quit();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        for (;;)
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (pendingBlocks.empty())
+                return;
+
+            if (const auto results = scanIfPossible (pendingBlocks.front(), true))
+                sendResults (*results);
+
+            pendingBlocks.pop();
+        }
+    }
+
+    // Returns nullopt if the scan has to be done on the message thread instead
+    std::optional<XmlElement> scanIfPossible (const MemoryBlock& block, bool isMessageThread)
+    {
+        MemoryInputStream stream (block, false);
+        const auto formatName = stream.readString();
+        const auto identifier = stream.readString();
+        const auto timeoutMs  = stream.readInt();
+
+        PluginDescription pd;
+        pd.fileOrIdentifier = identifier;
+        pd.uniqueId = pd.deprecatedUid = 0;
+
+        auto* format = [&]() -> AudioPluginFormat*
+        {
+            for (auto* f : formatManager.getFormats())
+                if (f->getName() == formatName)
+                    return f;
+
+            return nullptr;
+        }();
+
+        XmlElement xml ("LIST");
+
+        if (format == nullptr)
+            return xml;
+
+        // Formats that need the message thread to be free while they create plugins must be
+        // scanned on this thread, and all other formats must be scanned on the message thread
+        if (format->requiresUnblockedMessageThreadDuringCreation (pd) == isMessageThread)
+            return std::nullopt;
+
+        OwnedArray<PluginDescription> results;
+
+        deadline = jmax ((uint32) 1, Time::getMillisecondCounter() + (uint32) jmax (0, timeoutMs));
+        format->findAllTypesForFile (results, identifier);
+        deadline = 0;
+
+        for (const auto& desc : results)
+            xml.addChildElement (desc->createXml().release());
+
+        return xml;
+    }
+
+    void sendResults (const XmlElement& xml)
+    {
+        const auto str = xml.toString();
+        sendMessageToCoordinator ({ str.toRawUTF8(), str.getNumBytesAsUTF8() });
+    }
+
+    // The coordinator will give up on a plugin that hangs, but it can't stop the process
+    // itself if the hang is blocking the message thread, so that's done from here instead
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (250);
+
+            const auto scanDeadline = deadline.load();
+
+            if (scanDeadline != 0 && (int) (Time::getMillisecondCounter() - scanDeadline) > 0)
+                Process::terminate();
+        }
+    }
+
+    AudioPluginFormatManager formatManager;
+    std::mutex mutex;
+    std::queue<MemoryBlock> pendingBlocks;
+    std::atomic<uint32> deadline { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Impl)
+};
+
+OutOfProcessPluginScanner::Worker::Worker (std::unique_ptr<Impl> implIn)
+    : impl (std::move (implIn)) {}
+
+OutOfProcessPluginScanner::Worker::~Worker() = default;
+
+std::unique_ptr<OutOfProcessPluginScanner::Worker> OutOfProcessPluginScanner::createWorkerIfRequested (const String& commandLine,
+                                                                                                       const String& commandLineUID,
+                                                                                                       std::function<void (AudioPluginFormatManager&)> addFormats)
+{
+    if (! commandLine.contains ("--" + commandLineUID + ":"))
+        return nullptr;
+
+    auto impl = std::make_unique<Worker::Impl> (std::move (addFormats));
+
+    if (! impl->initialise (commandLine, commandLineUID))
+        return nullptr;
+
+    return std::unique_ptr<Worker> (new Worker (std::move (impl)));
+}
+
+} // namespace juce
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Scans plugins in several child processes at once, and adds the results to a
+    KnownPluginList.
+
+    Each plugin is probed by one of a pool of worker processes, so a plugin that
+    crashes or hangs during scanning can't take down the host. Plugins whose worker
+    crashes, or which take longer than the timeout to scan, are added to the list's
+    blacklist and reported by getFailedFiles().
+
+    The worker processes are launched from an executable that must call
+    createWorkerIfRequested() early in its start-up, which is normally your own app:
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        scanWorker = OutOfProcessPluginScanner::createWorkerIfRequested (commandLine);
+
+        if (scanWorker != nullptr)
+            return; // This process was launched as a scanner, so don't create any windows
+
+        ...
+    }
+    @endcode
+
+    A scan is then run from a background thread:
+
+    @code
+    OutOfProcessPluginScanner scanner (knownPluginList, OutOfProcessPluginScanner::Options{}.withNumWorkers (8));
+    scanner.scan (format, format.searchPathsForPlugins (format.getDefaultLocationsToSearch(), true));
+    @endcode
+
+    @see PluginDirectoryScanner, KnownPluginList, ChildProcessCoordinator
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginScanner
+{
+public:
+    //==============================================================================
+    /** The default ID used on the command line to identify worker processes. */
+    static constexpr const char* defaultCommandLineUID = "jucepluginscanworker";
+
+    /** Settings that control how a scan is performed. */
+    struct Options
+    {
+        /** The executable to launch for each worker process. */
+        [[nodiscard]] Options withWorkerExecutable (const File& x) const    { return withMember (*this, &Options::workerExecutable, x); }
+
+        /** The ID passed on the worker's command line. This must match the ID passed to
+            createWorkerIfRequested() in the worker process.
+        */
+        [[nodiscard]] Options withCommandLineUID (const String& x) const    { return withMember (*this, &Options::commandLineUID, x); }
+
+        /** The number of worker processes to run at once. If this is zero or less, one
+            worker per physical CPU core will be used.
+        */
+        [[nodiscard]] Options withNumWorkers (int x) const                  { return withMember (*this, &Options::numWorkers, x); }
+
+        /** The maximum time that a worker may spend scanning a single file before it's
+            killed and the file is blacklisted.
+        */
+        [[nodiscard]] Options withTimeoutMs (int x) const                   { return withMember (*this, &Options::timeoutMs, x); }
+
+        /** If true, files whose listings are already in the KnownPluginList and are up to
+            date won't be scanned again.
+        */
+        [[nodiscard]] Options withDontRescanIfAlreadyInList (bool x) const  { return withMember (*this, &Options::dontRescanIfAlreadyInList, x); }
+
+        File workerExecutable = File::getSpecialLocation (File::currentExecutableFile);
+        String commandLineUID { defaultCommandLineUID };
+        int numWorkers = 0;
+        int timeoutMs = 60000;
+        bool dontRescanIfAlreadyInList = true;
+    };
+
+    //==============================================================================
+    /** Creates a scanner with the default options, which will add the plugins it finds
+        to the given list.
+    */
+    explicit OutOfProcessPluginScanner (KnownPluginList& listToAddResultsTo);
+
+    /** Creates a scanner which will add the plugins it finds to the given list. */
+    OutOfProcessPluginScanner (KnownPluginList& listToAddResultsTo, Options options);
+
+    /** Destructor. Any worker processes that are still running will be killed. */
+    ~OutOfProcessPluginScanner();
+
+    //==============================================================================
+    /** Scans a set of files or identifiers for plugins of the given format.
+
+        This blocks until every file has been scanned or cancel() is called, so it should
+        be run on a background thread. Types that are found are added to the
+        KnownPluginList as each worker reports back.
+
+        Returns false if the scan was cancelled, or if no worker processes could be launched.
+
+        @see AudioPluginFormat::searchPathsForPlugins
+    */
+    bool scan (AudioPluginFormat& format, const StringArray& filesOrIdentifiers);
+
+    /** Stops a scan that's in progress. This can be called from any thread. */
+    void cancel() noexcept;
+
+    /** Returns the proportion of files scanned so far in the current scan, between 0 and 1. */
+    float getProgress() const noexcept                  { return progress; }
+
+    /** Returns the files from the last scan whose workers crashed or timed out. */
+    StringArray getFailedFiles() const;
+
+    //==============================================================================
+    /** The object that runs inside a worker process. @see createWorkerIfRequested */
+    class Worker;
+
+    /** If this process was launched by an OutOfProcessPluginScanner, this creates the
+        object which handles scan requests from the coordinating process.
+
+        You need to keep the returned object alive until the app quits. When the
+        coordinator disconnects, the worker quits the app. If this process wasn't
+        launched as a scan worker, this returns nullptr.
+
+        @param commandLine      the command line passed to your app
+        @param commandLineUID   this must match Options::commandLineUID in the coordinator
+        @param addFormats       a function that adds the plugin formats to scan to a format
+                                manager. If this is empty, the default formats are added.
+    */
+    static std::unique_ptr<Worker> createWorkerIfRequested (const String& commandLine,
+                                                            const String& commandLineUID = defaultCommandLineUID,
+                                                            std::function<void (AudioPluginFormatManager&)> addFormats = {});
+
+private:
+    //==============================================================================
+    class Connection;
+
+    KnownPluginList& list;
+    const Options options;
+    std::atomic<float> progress { 0.0f };
+    std::atomic<bool> shouldCancel { false };
+    WaitableEvent workerEvent;
+    mutable CriticalSection failedFilesLock;
+    StringArray failedFiles;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+//==============================================================================
+/** Handles scan requests inside a worker process.
+
+    These are created by OutOfProcessPluginScanner::createWorkerIfRequested().
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginScanner::Worker
+{
+public:
+    /** Destructor. */
+    ~Worker();
+
+private:
+    friend class OutOfProcessPluginScanner;
+    class Impl;
+
+    explicit Worker (std::unique_ptr<Impl>);
+    std::unique_ptr<Impl> impl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+} // namespace juce
@@ -315,6 +315,8 @@ protected:
 
         This function's called from
         ARA::PlugIn::DocumentControllerDelegate::doRequestAudioSourceContentAnalysis.
+
+        An ARAAnalysisScheduler can be used to run the analyses on background threads.
     */
     virtual void                        doRequestAudioSourceContentAnalysis        (ARA::PlugIn::AudioSource*  audioSource,
                                                                                     std::vector<ARA::ARAContentType> const& contentTypes);
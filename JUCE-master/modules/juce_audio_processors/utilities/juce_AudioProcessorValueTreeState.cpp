@@ -117,6 +117,15 @@ public:
     float getDenormalisedValue() const                { return unnormalisedValue; }
     std::atomic<float>& getRawDenormalisedValue()     { return unnormalisedValue; }
 
+    int getIndex() const noexcept                     { return index; }
+
+    void setIndex (int newIndex, std::atomic<uint32>& dirtyFlagWord)
+    {
+        index = newIndex;
+        dirtyWord = &dirtyFlagWord;
+        dirtyWord->fetch_or (getDirtyBit());
+    }
+
     bool flushToTree (const Identifier& key, UndoManager* um)
     {
         auto needsUpdateTestValue = true;
@@ -156,8 +165,15 @@ private:
         listeners.call ([this] (Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
         listenersNeedCalling = false;
         needsUpdate = true;
+
+        // This must come after setting needsUpdate, so that a concurrent flush can't clear the
+        // bit without also seeing the new value
+        if (dirtyWord != nullptr)
+            dirtyWord->fetch_or (getDirtyBit());
     }
 
+    uint32 getDirtyBit() const noexcept     { return (uint32) 1 << (index % 32); }
+
     float denormalise (float normalised) const
     {
         return getParameter().convertFrom0to1 (normalised);
@@ -207,6 +223,8 @@ private:
     LockedListeners listeners;
     std::atomic<float> unnormalisedValue { 0.0f };
     std::atomic<bool> needsUpdate { true }, listenersNeedCalling { true };
+    std::atomic<uint32>* dirtyWord = nullptr;
+    int index = 0;
     bool ignoreParameterChangedCallbacks { false };
 };
 
@@ -268,8 +286,44 @@ AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& proc
     state = ValueTree (valueTreeType);
 }
 
+struct AudioProcessorValueTreeState::SerialisedState
+{
+    bool copyIfCurrent (MemoryBlock& destData, uint64 currentVersion)
+    {
+        const ScopedLock sl (lock);
+
+        if (version != currentVersion)
+            return false;
+
+        destData = data;
+        return true;
+    }
+
+    void store (const MemoryBlock& newData, uint64 newVersion)
+    {
+        const ScopedLock sl (lock);
+
+        if (newVersion > version)
+        {
+            data = newData;
+            version = newVersion;
+        }
+    }
+
+    CriticalSection lock;
+    MemoryBlock data;
+    uint64 version = 0;
+};
+
+struct AudioProcessorValueTreeState::BackgroundSerialiser
+{
+    ThreadPool pool { ThreadPoolOptions{}.withThreadName ("APVTS state serialiser")
+                                         .withNumberOfThreads (1) };
+};
+
+//==============================================================================
 AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& p, UndoManager* um)
-    : processor (p), undoManager (um)
+    : processor (p), undoManager (um), serialisedState (std::make_shared<SerialisedState>())
 {
     startTimerHz (10);
     state.addListener (this);
@@ -332,7 +386,15 @@ RangedAudioParameter* AudioProcessorValueTreeState::createAndAddParameter (std::
 //==============================================================================
 void AudioProcessorValueTreeState::addParameterAdapter (RangedAudioParameter& param)
 {
-    adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+    auto adapter = std::make_unique<ParameterAdapter> (param);
+    const auto index = (int) adapterList.size();
+
+    if ((size_t) index / 32 >= dirtyFlags.size())
+        dirtyFlags.push_back (std::make_unique<std::atomic<uint32>> (0));
+
+    adapter->setIndex (index, *dirtyFlags.back());
+    adapterList.push_back (adapter.get());
+    adapterTable.emplace (param.paramID, std::move (adapter));
 }
 
 AudioProcessorValueTreeState::ParameterAdapter* AudioProcessorValueTreeState::getParameterAdapter (StringRef paramID) const
@@ -386,6 +448,33 @@ std::atomic<float>* AudioProcessorValueTreeState::getRawParameterValue (StringRe
     return nullptr;
 }
 
+AudioProcessorValueTreeState::ParameterSnapshot AudioProcessorValueTreeState::createParameterSnapshot() const
+{
+    ParameterSnapshot snapshot;
+    snapshot.values.resize (adapterList.size());
+    updateParameterSnapshot (snapshot);
+    return snapshot;
+}
+
+void AudioProcessorValueTreeState::updateParameterSnapshot (ParameterSnapshot& snapshot) const noexcept
+{
+    // This snapshot wasn't created by createParameterSnapshot(), or parameters have been added since!
+    jassert (snapshot.values.size() == adapterList.size());
+
+    const auto num = jmin (snapshot.values.size(), adapterList.size());
+
+    for (size_t i = 0; i < num; ++i)
+        snapshot.values[i] = adapterList[i]->getRawDenormalisedValue().load (std::memory_order_relaxed);
+}
+
+int AudioProcessorValueTreeState::getParameterIndex (StringRef paramID) const noexcept
+{
+    if (auto* p = getParameterAdapter (paramID))
+        return p->getIndex();
+
+    return -1;
+}
+
 ValueTree AudioProcessorValueTreeState::copyState()
 {
     ScopedLock lock (valueTreeChanging);
@@ -403,6 +492,78 @@ void AudioProcessorValueTreeState::replaceState (const ValueTree& newState)
         undoManager->clearUndoHistory();
 }
 
+void AudioProcessorValueTreeState::copyStateToBinary (MemoryBlock& destData)
+{
+    ValueTree copy;
+    uint64 version = 0;
+
+    {
+        ScopedLock lock (valueTreeChanging);
+        flushParameterValuesToValueTree();
+
+        // The version is read before the tree is copied, so if the state changes in
+        // between, the data is stored as an older version and will be written again
+        version = stateVersion.load();
+
+        if (serialisedState->copyIfCurrent (destData, version))
+            return;
+
+        copy = state.createCopy();
+    }
+
+    AudioProcessor::copyStateToBinary (copy, destData);
+    serialisedState->store (destData, version);
+}
+
+bool AudioProcessorValueTreeState::replaceStateFromBinary (const void* data, int sizeInBytes)
+{
+    auto newState = AudioProcessor::getStateFromBinary (data, sizeInBytes);
+
+    if (! newState.isValid() || ! newState.hasType (state.getType()))
+        return false;
+
+    replaceState (newState);
+    return true;
+}
+
+void AudioProcessorValueTreeState::setBackgroundSerialisationEnabled (bool shouldSerialiseInBackground)
+{
+    if (shouldSerialiseInBackground && ! backgroundSerialiser.has_value())
+        backgroundSerialiser.emplace();
+    else if (! shouldSerialiseInBackground)
+        backgroundSerialiser.reset();
+}
+
+void AudioProcessorValueTreeState::serialiseInBackgroundIfNeeded()
+{
+    const auto version = stateVersion.load();
+    const auto now = Time::getMillisecondCounter();
+
+    if (version == lastBackgroundVersion)
+        return;
+
+    // Wait for the changes to settle, unless they've been going on for more than a second
+    if (version != std::exchange (versionAtLastTimerCallback, version) && now - lastBackgroundTime < 1000)
+        return;
+
+    lastBackgroundVersion = version;
+    lastBackgroundTime = now;
+
+    ValueTree copy;
+
+    {
+        ScopedLock lock (valueTreeChanging);
+        copy = state.createCopy();
+    }
+
+    (*backgroundSerialiser)->pool.addJob ([copy, version, target = serialisedState]
+    {
+        MemoryBlock data;
+        AudioProcessor::copyStateToBinary (copy, data);
+        target->store (data, version);
+    });
+}
+
 void AudioProcessorValueTreeState::setNewState (ValueTree vt)
 {
     jassert (vt.getParent() == state);
@@ -441,18 +602,34 @@ void AudioProcessorValueTreeState::updateParameterConnectionsToChildTrees()
 
 void AudioProcessorValueTreeState::valueTreePropertyChanged (ValueTree& tree, const Identifier&)
 {
+    ++stateVersion;
+
     if (tree.hasType (valueType) && tree.getParent() == state)
         setNewState (tree);
 }
 
 void AudioProcessorValueTreeState::valueTreeChildAdded (ValueTree& parent, ValueTree& tree)
 {
+    ++stateVersion;
+
     if (parent == state && tree.hasType (valueType))
         setNewState (tree);
 }
 
+void AudioProcessorValueTreeState::valueTreeChildRemoved (ValueTree&, ValueTree&, int)
+{
+    ++stateVersion;
+}
+
+void AudioProcessorValueTreeState::valueTreeChildOrderChanged (ValueTree&, int, int)
+{
+    ++stateVersion;
+}
+
 void AudioProcessorValueTreeState::valueTreeRedirected (ValueTree& v)
 {
+    ++stateVersion;
+
     if (v == state)
         updateParameterConnectionsToChildTrees();
 }
@@ -463,8 +640,14 @@ bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
 
     bool anyUpdated = false;
 
-    for (auto& p : adapterTable)
-        anyUpdated |= p.second->flushToTree (valuePropertyID, undoManager);
+    for (size_t word = 0; word < dirtyFlags.size(); ++word)
+    {
+        auto bits = dirtyFlags[word]->exchange (0);
+
+        for (size_t bit = 0; bits != 0; ++bit, bits >>= 1)
+            if ((bits & 1) != 0)
+                anyUpdated |= adapterList[word * 32 + bit]->flushToTree (valuePropertyID, undoManager);
+    }
 
     return anyUpdated;
 }
@@ -473,6 +656,9 @@ void AudioProcessorValueTreeState::timerCallback()
 {
     auto anythingUpdated = flushParameterValuesToValueTree();
 
+    if (backgroundSerialiser.has_value())
+        serialiseInBackgroundIfNeeded();
+
     startTimer (anythingUpdated ? 1000 / 50
                                 : jlimit (50, 500, getTimerInterval() + 20));
 }
@@ -986,6 +1172,123 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        beginTest ("Parameter snapshots hold the values at the time they were updated");
+        {
+            ParameterLayout layout;
+
+            for (int i = 0; i < 40; ++i)
+                layout.add (std::make_unique<Parameter> (String (i), String(), NormalisableRange<float> (0.0f, 100.0f), (float) i));
+
+            TestAudioProcessor proc (std::move (layout));
+
+            auto snapshot = proc.state.createParameterSnapshot();
+            expectEquals (snapshot.size(), 40);
+
+            const auto index = proc.state.getParameterIndex ("35");
+            expectEquals (index, 35);
+            expectEquals (proc.state.getParameterIndex ("unknown"), -1);
+            expectEquals (snapshot[index], 35.0f);
+
+            proc.state.getParameter ("35")->setValueNotifyingHost (0.5f);
+            expectEquals (snapshot[index], 35.0f);
+
+            proc.state.updateParameterSnapshot (snapshot);
+            expectEquals (snapshot[index], 50.0f);
+            expectEquals (snapshot[0], 0.0f);
+        }
+
+        beginTest ("Changed parameters are written to the state tree");
+        {
+            ParameterLayout layout;
+
+            for (int i = 0; i < 70; ++i)
+                layout.add (std::make_unique<Parameter> (String (i), String(), NormalisableRange<float> (0.0f, 100.0f), 0.0f));
+
+            TestAudioProcessor proc (std::move (layout));
+
+            const auto valueInTree = [&] (const String& key)
+            {
+                const auto copy = proc.state.copyState();
+                return (float) copy.getChildWithProperty ("id", key).getProperty ("value");
+            };
+
+            expectEquals (valueInTree ("3"), 0.0f);
+            expectEquals (valueInTree ("66"), 0.0f);
+
+            proc.state.getParameter ("66")->setValueNotifyingHost (0.25f);
+            expectEquals (valueInTree ("66"), 25.0f);
+            expectEquals (valueInTree ("3"), 0.0f);
+
+            proc.state.getParameter ("3")->setValueNotifyingHost (1.0f);
+            proc.state.getParameter ("66")->setValueNotifyingHost (0.5f);
+            expectEquals (valueInTree ("3"), 100.0f);
+            expectEquals (valueInTree ("66"), 50.0f);
+        }
+
+        beginTest ("The state can be stored as binary and restored");
+        {
+            TestAudioProcessor proc (ParameterLayout { std::make_unique<Parameter> (String ("a"), String(), NormalisableRange<float> (0.0f, 100.0f), 0.0f) });
+            proc.state.state.setProperty ("extra", "hello", nullptr);
+            proc.state.getParameter ("a")->setValueNotifyingHost (0.5f);
+
+            MemoryBlock data;
+            proc.state.copyStateToBinary (data);
+            expect (ValueTree::isCompactData (data.getData(), data.getSize()));
+
+            MemoryBlock again;
+            proc.state.copyStateToBinary (again);
+            expect (again == data);
+
+            proc.state.getParameter ("a")->setValueNotifyingHost (1.0f);
+            proc.state.state.setProperty ("extra", "changed", nullptr);
+
+            MemoryBlock changed;
+            proc.state.copyStateToBinary (changed);
+            expect (changed != data);
+
+            expect (proc.state.replaceStateFromBinary (data.getData(), (int) data.getSize()));
+            expectEquals (proc.state.state["extra"].toString(), String ("hello"));
+            expectEquals (proc.state.getRawParameterValue ("a")->load(), 50.0f);
+
+            MemoryBlock xml;
+            AudioProcessor::copyXmlToBinary (*proc.state.copyState().createXml(), xml);
+            expect (AudioProcessor::getStateFromBinary (xml.getData(), (int) xml.getSize()).isEquivalentTo (proc.state.copyState()));
+
+            expect (! proc.state.replaceStateFromBinary ("nonsense", 8));
+            expectEquals (proc.state.state["extra"].toString(), String ("hello"));
+
+            const auto otherType = ValueTree ("other");
+            AudioProcessor::copyStateToBinary (otherType, data);
+            expect (! proc.state.replaceStateFromBinary (data.getData(), (int) data.getSize()));
+        }
+
+        beginTest ("The state can be serialised in the background");
+        {
+            TestAudioProcessor proc (ParameterLayout { std::make_unique<Parameter> (String ("a"), String(), NormalisableRange<float> (0.0f, 100.0f), 0.0f) });
+            proc.state.setBackgroundSerialisationEnabled (true);
+            proc.state.state.setProperty ("extra", "background", nullptr);
+
+            const auto isUpToDate = [&]
+            {
+                const ScopedLock sl (proc.state.serialisedState->lock);
+                return proc.state.serialisedState->version == proc.state.stateVersion.load();
+            };
+
+            for (int i = 0; i < 200 && ! isUpToDate(); ++i)
+            {
+                proc.state.timerCallback();
+                Thread::sleep (10);
+            }
+
+            expect (isUpToDate());
+
+            MemoryBlock data;
+            proc.state.copyStateToBinary (data);
+            expectEquals (AudioProcessor::getStateFromBinary (data.getData(), (int) data.getSize())["extra"].toString(), String ("background"));
+
+            proc.state.setBackgroundSerialisationEnabled (false);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 };
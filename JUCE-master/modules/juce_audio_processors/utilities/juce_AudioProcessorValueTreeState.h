@@ -345,6 +345,62 @@ public:
     */
     std::atomic<float>* getRawParameterValue (StringRef parameterID) const noexcept;
 
+    //==============================================================================
+    /** Holds a copy of the current value of every parameter in an AudioProcessorValueTreeState.
+
+        Reading parameters individually with getRawParameterValue() means that a value may
+        change between two reads in the same audio block. Instead, you can keep one of these
+        snapshots in your processor, create it with createParameterSnapshot() in prepareToPlay(),
+        and call updateParameterSnapshot() at the start of each processBlock(). Every read made
+        from the snapshot during that block will then see the same set of values.
+
+        The values are denormalised, and are indexed in the order that the parameters were
+        added. Use getParameterIndex() to find the index of a particular parameter.
+
+        @see createParameterSnapshot, updateParameterSnapshot
+    */
+    class JUCE_API  ParameterSnapshot
+    {
+    public:
+        /** Creates an empty snapshot. */
+        ParameterSnapshot() = default;
+
+        /** Returns the number of parameter values held in the snapshot. */
+        int size() const noexcept                       { return (int) values.size(); }
+
+        /** Returns the value of the parameter with the given index. */
+        float operator[] (int index) const noexcept     { return isPositiveAndBelow (index, size()) ? values[(size_t) index] : 0.0f; }
+
+        /** Returns a pointer to the first value in the snapshot. */
+        const float* begin() const noexcept             { return values.data(); }
+
+        /** Returns a pointer just beyond the last value in the snapshot. */
+        const float* end() const noexcept               { return values.data() + values.size(); }
+
+    private:
+        friend class AudioProcessorValueTreeState;
+        std::vector<float> values;
+    };
+
+    /** Creates a snapshot holding the current values of all parameters.
+
+        This allocates, so call it from prepareToPlay() or the message thread rather than
+        the audio thread.
+    */
+    ParameterSnapshot createParameterSnapshot() const;
+
+    /** Refreshes a snapshot with the current values of all parameters.
+
+        The snapshot must have been created by createParameterSnapshot() on this object.
+        This doesn't allocate or lock, so it's safe to call on the audio thread.
+    */
+    void updateParameterSnapshot (ParameterSnapshot& snapshot) const noexcept;
+
+    /** Returns the index of a parameter's value within a ParameterSnapshot, or -1 if there's
+        no parameter with this ID.
+    */
+    int getParameterIndex (StringRef parameterID) const noexcept;
+
     //==============================================================================
     /** A listener class that can be attached to an AudioProcessorValueTreeState.
         Use AudioProcessorValueTreeState::addParameterListener() to register a callback.
@@ -403,6 +459,42 @@ public:
     */
     void replaceState (const ValueTree& newState);
 
+    /** Writes the state to a block of memory, in the binary format used by
+        AudioProcessor::copyStateToBinary(). This is intended for use in your processor's
+        getStateInformation() method.
+
+        The data that was written for the latest version of the state is kept, so if the
+        state hasn't changed since then, this only has to copy it. If background
+        serialisation is enabled, the state is also written on a background thread soon
+        after it changes, so hosts that save sessions often don't have to wait for it.
+
+        Like copyState(), this is thread-safe, but it's not realtime-safe.
+
+        @see replaceStateFromBinary, setBackgroundSerialisationEnabled
+    */
+    void copyStateToBinary (MemoryBlock& destData);
+
+    /** Replaces the state with one that was stored by copyStateToBinary(), or by
+        AudioProcessor::copyXmlToBinary(). This is intended for use in your processor's
+        setStateInformation() method.
+
+        Returns false, leaving the state unchanged, if the data can't be read or holds a
+        tree with a different type from the current state.
+
+        @see copyStateToBinary, replaceState
+    */
+    bool replaceStateFromBinary (const void* data, int sizeInBytes);
+
+    /** Enables writing the state on a background thread after it changes, so that
+        copyStateToBinary() can usually return the data straight away.
+
+        The state is copied on the message thread once the changes have settled, or at
+        most once a second while it keeps changing, and the copy is then serialised on a
+        thread that's shared by all the AudioProcessorValueTreeState objects in the process.
+        This is off by default.
+    */
+    void setBackgroundSerialisationEnabled (bool shouldSerialiseInBackground);
+
     //==============================================================================
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
@@ -638,6 +730,7 @@ private:
     //==============================================================================
    #if JUCE_UNIT_TESTS
     friend struct ParameterAdapterTests;
+    friend class AudioProcessorValueTreeStateTests;
    #endif
 
     void addParameterAdapter (RangedAudioParameter&);
@@ -649,9 +742,13 @@ private:
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
     void valueTreeRedirected (ValueTree&) override;
     void updateParameterConnectionsToChildTrees();
 
+    void serialiseInBackgroundIfNeeded();
+
     const Identifier valueType { "PARAM" }, valuePropertyID { "value" }, idPropertyID { "id" };
 
     struct StringRefLessThan final
@@ -661,8 +758,23 @@ private:
 
     std::map<StringRef, std::unique_ptr<ParameterAdapter>, StringRefLessThan> adapterTable;
 
+    // Adapters in the order they were added, along with one bit per adapter which is set when
+    // its value needs to be written to the tree. This lets the timer skip unchanged parameters.
+    std::vector<ParameterAdapter*> adapterList;
+    std::vector<std::unique_ptr<std::atomic<uint32>>> dirtyFlags;
+
     CriticalSection valueTreeChanging;
 
+    // Every change to the state bumps its version, so that the binary data that was last
+    // written for it can be reused if nothing has changed since
+    struct SerialisedState;
+    struct BackgroundSerialiser;
+    std::atomic<uint64> stateVersion { 1 };
+    std::shared_ptr<SerialisedState> serialisedState;
+    std::optional<SharedResourcePointer<BackgroundSerialiser>> backgroundSerialiser;
+    uint64 lastBackgroundVersion = 0, versionAtLastTimerCallback = 0;
+    uint32 lastBackgroundTime = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorValueTreeState)
 };
 
@@ -169,9 +169,15 @@ public:
     ~LevelDataSource() override
     {
         owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+        tiledLoader.reset();
     }
 
-    enum { timeBeforeDeletingReader = 3000 };
+    enum
+    {
+        timeBeforeDeletingReader = 3000,
+        thumbSamplesPerBlock = 256,
+        thumbSamplesPerTile = thumbSamplesPerBlock * 8
+    };
 
     void initialise (int64 samplesFinished)
     {
@@ -188,9 +194,14 @@ public:
             sampleRate = reader->sampleRate;
 
             if (lengthInSamples <= 0 || isFullyLoaded())
+            {
                 reader.reset();
+            }
             else
+            {
+                startTiledLoading();
                 owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+            }
         }
     }
 
@@ -241,6 +252,27 @@ public:
             return -1;
         }
 
+        if (tiledLoader != nullptr)
+        {
+            if (! tiledLoader->isFinished())
+                return 50;
+
+            const auto allTilesDone = tiledLoader->haveAllTilesBeenClaimed();
+            tiledLoader.reset();
+
+            if (! allTilesDone)
+            {
+                // None of the loader threads could open the source, so carry on
+                // from the end of the contiguous section, one block at a time.
+                numSamplesFinished = owner.getNumSamplesFinished();
+                return 0;
+            }
+
+            numSamplesFinished = lengthInSamples;
+            owner.cache.storeThumb (owner, hashCode);
+            return 200;
+        }
+
         bool justFinished = false;
 
         {
@@ -278,9 +310,72 @@ public:
     int64 hashCode = 0;
 
 private:
+    //==============================================================================
+    class TiledLoader
+    {
+    public:
+        TiledLoader (LevelDataSource& s, int numThreads, Range<int> thumbSamplesToLoad)
+            : levelSource (s),
+              pool (ThreadPoolOptions{}.withThreadName ("Thumbnail Loader")
+                                       .withNumberOfThreads (numThreads)),
+              nextTileStart (thumbSamplesToLoad.getStart()),
+              endThumbSample (thumbSamplesToLoad.getEnd())
+        {
+            for (int i = 0; i < numThreads; ++i)
+                pool.addJob ([this] { loadTiles(); });
+        }
+
+        ~TiledLoader()
+        {
+            shouldStop = true;
+        }
+
+        bool isFinished() const                     { return pool.getNumJobs() == 0; }
+        bool haveAllTilesBeenClaimed() const        { return nextTileStart.load() >= endThumbSample; }
+
+    private:
+        LevelDataSource& levelSource;
+        ThreadPool pool;
+        std::atomic<int> nextTileStart;
+        const int endThumbSample;
+        std::atomic<bool> shouldStop { false };
+
+        void loadTiles()
+        {
+            auto tileReader = levelSource.createTileReader();
+
+            if (tileReader == nullptr)
+                return;
+
+            HeapBlock<MinMaxValue> levelData;
+            HeapBlock<MinMaxValue*> levels;
+
+            while (! shouldStop)
+            {
+                auto tileStart = nextTileStart.fetch_add (thumbSamplesPerTile);
+
+                if (tileStart >= endThumbSample)
+                    break;
+
+                auto tileEnd = jmin (endThumbSample, tileStart + (int) thumbSamplesPerTile);
+
+                for (auto blockStart = tileStart; blockStart < tileEnd && ! shouldStop; blockStart += thumbSamplesPerBlock)
+                {
+                    auto numThumbSamps = jmin ((int) thumbSamplesPerBlock, tileEnd - blockStart);
+
+                    levelSource.readLevels (*tileReader, blockStart, numThumbSamps, levelData, levels);
+                    levelSource.owner.setLevels (levels, blockStart, (int) levelSource.numChannels, numThumbSamps);
+                }
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (TiledLoader)
+    };
+
     AudioThumbnail& owner;
     std::unique_ptr<InputSource> source;
     std::unique_ptr<AudioFormatReader> reader;
+    std::unique_ptr<TiledLoader> tiledLoader;
     CriticalSection readerLock;
     std::atomic<uint32> lastReaderUseTime { 0 };
 
@@ -291,13 +386,78 @@ private:
                 reader.reset (owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
     }
 
+    void startTiledLoading()
+    {
+        if (source == nullptr || owner.numLoaderThreads <= 1)
+            return;
+
+        auto firstThumbIndex = sampleToThumbSample (numSamplesFinished);
+        auto lastThumbIndex  = sampleToThumbSample (lengthInSamples);
+
+        if (lastThumbIndex - firstThumbIndex > (int) thumbSamplesPerTile)
+            tiledLoader = std::make_unique<TiledLoader> (*this, owner.numLoaderThreads,
+                                                         Range<int> (firstThumbIndex, lastThumbIndex));
+    }
+
+    // Each tile loader thread needs a reader of its own, so this prefers a memory-mapped
+    // reader for files, as those can be opened and read without any decoding state.
+    std::unique_ptr<AudioFormatReader> createTileReader()
+    {
+        std::unique_ptr<InputStream> stream (source->createInputStream());
+
+        if (stream == nullptr)
+            return {};
+
+        if (auto* fileStream = dynamic_cast<FileInputStream*> (stream.get()))
+        {
+            auto file = fileStream->getFile();
+
+            for (auto* format : owner.formatManagerToUse)
+            {
+                if (format->canHandleFile (file))
+                {
+                    std::unique_ptr<MemoryMappedAudioFormatReader> mappedReader (format->createMemoryMappedReader (file));
+
+                    if (mappedReader != nullptr
+                         && mappedReader->lengthInSamples == lengthInSamples
+                         && mappedReader->numChannels == numChannels
+                         && mappedReader->mapEntireFile())
+                        return mappedReader;
+                }
+            }
+        }
+
+        return std::unique_ptr<AudioFormatReader> (owner.formatManagerToUse.createReaderFor (std::move (stream)));
+    }
+
+    void readLevels (AudioFormatReader& levelReader, int firstThumbIndex, int numThumbSamps,
+                     HeapBlock<MinMaxValue>& levelData, HeapBlock<MinMaxValue*>& levels) const
+    {
+        levelData.malloc ((size_t) numThumbSamps * numChannels);
+        levels.malloc (numChannels);
+
+        for (int i = 0; i < (int) numChannels; ++i)
+            levels[i] = levelData + i * numThumbSamps;
+
+        HeapBlock<Range<float>> levelsRead (numChannels);
+
+        for (int i = 0; i < numThumbSamps; ++i)
+        {
+            levelReader.readMaxLevels ((firstThumbIndex + i) * (int64) owner.samplesPerThumbSample,
+                                       owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+
+            for (int j = 0; j < (int) numChannels; ++j)
+                levels[j][i].setFloat (levelsRead[j]);
+        }
+    }
+
     bool readNextBlock()
     {
         jassert (reader != nullptr);
 
         if (! isFullyLoaded())
         {
-            auto numToDo = (int) jmin (256 * (int64) owner.samplesPerThumbSample, lengthInSamples - numSamplesFinished);
+            auto numToDo = (int) jmin ((int64) thumbSamplesPerBlock * owner.samplesPerThumbSample, lengthInSamples - numSamplesFinished);
 
             if (numToDo > 0)
             {
@@ -307,22 +467,9 @@ private:
                 auto lastThumbIndex  = sampleToThumbSample (startSample + numToDo);
                 auto numThumbSamps = lastThumbIndex - firstThumbIndex;
 
-                HeapBlock<MinMaxValue> levelData ((unsigned int) numThumbSamps * numChannels);
-                HeapBlock<MinMaxValue*> levels (numChannels);
-
-                for (int i = 0; i < (int) numChannels; ++i)
-                    levels[i] = levelData + i * numThumbSamps;
-
-                HeapBlock<Range<float>> levelsRead (numChannels);
-
-                for (int i = 0; i < numThumbSamps; ++i)
-                {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
-
-                    for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
-                }
+                HeapBlock<MinMaxValue> levelData;
+                HeapBlock<MinMaxValue*> levels;
+                readLevels (*reader, firstThumbIndex, numThumbSamps, levelData, levels);
 
                 {
                     const ScopedUnlock su (readerLock);
@@ -634,6 +781,7 @@ void AudioThumbnail::clearChannelData()
     window->invalidate();
     channels.clear();
     totalSamples = numSamplesFinished = 0;
+    finishedRanges.clear();
     numChannels = 0;
     sampleRate = 0;
 
@@ -816,8 +964,15 @@ void AudioThumbnail::setLevels (const MinMaxValue* const* values, int thumbIndex
     auto start = thumbIndex * (int64) samplesPerThumbSample;
     auto end   = (thumbIndex + numValues) * (int64) samplesPerThumbSample;
 
-    if (numSamplesFinished >= start && end > numSamplesFinished)
-        numSamplesFinished = end;
+    // Blocks may arrive out of order from a tiled load, so the finished ranges are
+    // kept in order to work out how far the contiguous section from the start extends.
+    finishedRanges.addRange ({ 0, numSamplesFinished });
+    finishedRanges.addRange ({ start, end });
+
+    auto firstRange = finishedRanges.getRange (0);
+
+    if (firstRange.getStart() == 0)
+        numSamplesFinished = jmax (numSamplesFinished, firstRange.getEnd());
 
     totalSamples = jmax (numSamplesFinished, totalSamples);
     window->invalidate();
@@ -846,7 +1001,8 @@ bool AudioThumbnail::isFullyLoaded() const noexcept
 double AudioThumbnail::getProportionComplete() const noexcept
 {
     const ScopedLock sl (lock);
-    return jlimit (0.0, 1.0, (double) numSamplesFinished / (double) jmax ((int64) 1, totalSamples));
+    auto numSamplesLoaded = jmax (numSamplesFinished, finishedRanges.size());
+    return jlimit (0.0, 1.0, (double) numSamplesLoaded / (double) jmax ((int64) 1, totalSamples));
 }
 
 int64 AudioThumbnail::getNumSamplesFinished() const noexcept
@@ -907,4 +1063,105 @@ void AudioThumbnail::drawChannels (Graphics& g, const Rectangle<int>& area, doub
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioThumbnailTests final : public UnitTest
+{
+    AudioThumbnailTests()
+        : UnitTest ("AudioThumbnail", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("A tiled multithreaded load matches a sequential load");
+        {
+            const TemporaryFile tempFile (".wav");
+            const auto numSamples = 600000;
+            writeTestFile (tempFile.getFile(), numSamples);
+
+            AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+
+            AudioThumbnailCache sequentialCache (1), tiledCache (1);
+            AudioThumbnail sequential (samplesPerThumbSample, formatManager, sequentialCache);
+            AudioThumbnail tiled (samplesPerThumbSample, formatManager, tiledCache);
+            tiled.setNumLoaderThreads (4);
+
+            expect (sequential.setSource (new FileInputSource (tempFile.getFile())));
+            expect (tiled.setSource (new FileInputSource (tempFile.getFile())));
+
+            expect (waitUntilFullyLoaded (sequential));
+            expect (waitUntilFullyLoaded (tiled));
+
+            expectEquals (tiled.getProportionComplete(), 1.0);
+            expectEquals (tiled.getNumSamplesFinished(), sequential.getNumSamplesFinished());
+
+            MemoryOutputStream sequentialData, tiledData;
+            sequential.saveTo (sequentialData);
+            tiled.saveTo (tiledData);
+
+            expect (sequentialData.getMemoryBlock() == tiledData.getMemoryBlock());
+        }
+
+        beginTest ("Blocks added out of order extend the finished section once the gaps are filled");
+        {
+            AudioThumbnailCache cache (1);
+            AudioFormatManager formatManager;
+            AudioThumbnail thumb (samplesPerThumbSample, formatManager, cache);
+
+            const auto blockSize = 4 * samplesPerThumbSample;
+            thumb.reset (1, 44100.0, 3 * blockSize);
+
+            AudioBuffer<float> block (1, blockSize);
+            block.clear();
+
+            thumb.addBlock (2 * blockSize, block, 0, blockSize);
+            expectEquals (thumb.getNumSamplesFinished(), (int64) 0);
+            expectWithinAbsoluteError (thumb.getProportionComplete(), 1.0 / 3.0, 1.0e-9);
+
+            thumb.addBlock (0, block, 0, blockSize);
+            expectEquals (thumb.getNumSamplesFinished(), (int64) blockSize);
+
+            thumb.addBlock (blockSize, block, 0, blockSize);
+            expectEquals (thumb.getNumSamplesFinished(), (int64) (3 * blockSize));
+            expect (thumb.isFullyLoaded());
+        }
+    }
+
+    static constexpr int samplesPerThumbSample = 64;
+
+    static void writeTestFile (const File& file, int numSamples)
+    {
+        AudioBuffer<float> buffer (2, numSamples);
+        Random random (0x1234);
+
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (chan, i, (random.nextFloat() * 2.0f - 1.0f) * (float) (i % 10000) / 10000.0f);
+
+        WavAudioFormat format;
+
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (file.createOutputStream().release(),
+                                                                          44100.0, 2, 16, {}, 0));
+
+        if (writer != nullptr)
+            writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+    }
+
+    static bool waitUntilFullyLoaded (const AudioThumbnail& thumb)
+    {
+        for (int i = 0; i < 1000 && ! thumb.isFullyLoaded(); ++i)
+            Thread::sleep (10);
+
+        return thumb.isFullyLoaded();
+    }
+};
+
+static AudioThumbnailTests audioThumbnailTests;
+
+#endif
+
 } // namespace juce
@@ -108,6 +108,24 @@ public:
     */
     void setReader (AudioFormatReader* newReader, int64 hashCode) override;
 
+    /** Sets the number of threads that sources passed to setSource (InputSource*) after
+        this call will use to generate their low res data.
+
+        With more than one thread, the file is divided into tiles which are scanned
+        concurrently, each thread using its own reader (a memory-mapped one, if the source
+        is a file whose format supports it). The thumbnail is updated as each part of a
+        tile is finished, so drawChannel() will show sections of the waveform appearing
+        out of order. Note that the InputSource's createInputStream() method will be
+        called from these threads.
+
+        The default is 1, which scans the file from start to end on the cache's
+        TimeSliceThread. This has no effect on sources set with setReader().
+    */
+    void setNumLoaderThreads (int numThreads) noexcept          { numLoaderThreads = jmax (1, numThreads); }
+
+    /** Returns the number of threads set by setNumLoaderThreads(). */
+    int getNumLoaderThreads() const noexcept                    { return numLoaderThreads; }
+
     /** Sets an AudioBuffer as the source for the thumbnail.
 
         The buffer contents aren't copied and you must ensure that the lifetime of the buffer is
@@ -188,10 +206,18 @@ public:
     /** Returns true if the low res preview is fully generated. */
     bool isFullyLoaded() const noexcept override;
 
-    /** Returns a value between 0 and 1 to indicate the progress towards loading the entire file. */
+    /** Returns a value between 0 and 1 to indicate the progress towards loading the entire file.
+
+        This includes any sections that have been finished out of order by a thumbnail
+        using more than one loader thread.
+    */
     double getProportionComplete() const noexcept;
 
-    /** Returns the number of samples that have been set in the thumbnail. */
+    /** Returns the number of samples that have been set in the thumbnail.
+
+        This is the number of samples from the start of the source that have been
+        set without any gaps.
+    */
     int64 getNumSamplesFinished() const noexcept override;
 
     /** Returns the highest level in the thumbnail.
@@ -228,7 +254,9 @@ private:
     int32 samplesPerThumbSample = 0;
     int64 totalSamples { 0 };
     int64 numSamplesFinished = 0;
+    SparseSet<int64> finishedRanges;
     int32 numChannels = 0;
+    int numLoaderThreads = 1;
     double sampleRate = 0;
     CriticalSection lock;
 
@@ -145,6 +145,9 @@ void AudioThumbnailCache::storeThumb (const AudioThumbnailBase& thumb,
         thumb.saveTo (out);
     }
 
+    te->lastUsed = Time::getMillisecondCounter();
+    removeThumbsToFitMemoryBudget (te);
+
     saveNewlyFinishedThumbnail (thumb, hashCode);
 }
 
@@ -163,6 +166,51 @@ void AudioThumbnailCache::removeThumb (const int64 hashCode)
             thumbs.remove (i);
 }
 
+void AudioThumbnailCache::setMaxMemoryUsage (size_t maxNumBytes)
+{
+    const ScopedLock sl (lock);
+    maxNumBytesToStore = maxNumBytes;
+    removeThumbsToFitMemoryBudget (nullptr);
+}
+
+size_t AudioThumbnailCache::getMemoryUsage() const
+{
+    const ScopedLock sl (lock);
+    size_t total = 0;
+
+    for (auto* te : thumbs)
+        total += te->data.getSize();
+
+    return total;
+}
+
+void AudioThumbnailCache::removeThumbsToFitMemoryBudget (const ThumbnailCacheEntry* entryToKeep)
+{
+    if (maxNumBytesToStore == 0)
+        return;
+
+    auto total = getMemoryUsage();
+
+    while (total > maxNumBytesToStore)
+    {
+        int oldest = -1;
+
+        for (int i = 0; i < thumbs.size(); ++i)
+        {
+            auto* te = thumbs.getUnchecked (i);
+
+            if (te != entryToKeep && (oldest < 0 || te->lastUsed < thumbs.getUnchecked (oldest)->lastUsed))
+                oldest = i;
+        }
+
+        if (oldest < 0)
+            break;
+
+        total -= thumbs.getUnchecked (oldest)->data.getSize();
+        thumbs.remove (oldest);
+    }
+}
+
 static int getThumbnailCacheFileMagicHeader() noexcept
 {
     return (int) ByteOrder::littleEndianInt ("ThmC");
@@ -180,6 +228,7 @@ bool AudioThumbnailCache::readFromStream (InputStream& source)
     while (--numThumbnails >= 0 && ! source.isExhausted())
         thumbs.add (new ThumbnailCacheEntry (source));
 
+    removeThumbsToFitMemoryBudget (nullptr);
     return true;
 }
 
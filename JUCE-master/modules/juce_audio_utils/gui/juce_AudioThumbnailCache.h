@@ -83,6 +83,18 @@ public:
     /** Tells the cache to forget about the thumb with the given hashcode. */
     void removeThumb (int64 hashCode);
 
+    /** Sets a limit on the total number of bytes of thumbnail data held in memory.
+
+        Whenever storing a thumbnail takes the total over this limit, the least recently
+        used thumbnails are discarded until it fits again, although the one that has just
+        been stored is always kept. A value of 0 (the default) means that the cache is only
+        limited by the number of thumbnails passed to the constructor.
+    */
+    void setMaxMemoryUsage (size_t maxNumBytes);
+
+    /** Returns the number of bytes of thumbnail data currently held in memory. */
+    size_t getMemoryUsage() const;
+
     //==============================================================================
     /** Attempts to re-load a saved cache of thumbnails from a stream.
         The cache data must have been written by the writeToStream() method.
@@ -117,9 +129,11 @@ private:
     OwnedArray<ThumbnailCacheEntry> thumbs;
     CriticalSection lock;
     int maxNumThumbsToStore;
+    size_t maxNumBytesToStore = 0;
 
     ThumbnailCacheEntry* findThumbFor (int64 hash) const;
     int findOldestThumb() const;
+    void removeThumbsToFitMemoryBudget (const ThumbnailCacheEntry* entryToKeep);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnailCache)
 };
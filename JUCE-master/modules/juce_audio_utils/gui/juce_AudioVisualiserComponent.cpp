@@ -37,7 +37,7 @@ namespace juce
 
 struct AudioVisualiserComponent::ChannelInfo
 {
-    ChannelInfo (AudioVisualiserComponent& o, int bufferSize) : owner (o)
+    explicit ChannelInfo (int bufferSize)
     {
         setBufferSize (bufferSize);
         clear();
@@ -46,31 +46,14 @@ struct AudioVisualiserComponent::ChannelInfo
     void clear() noexcept
     {
         levels.fill ({});
-        value = {};
-        subSample = 0;
     }
 
-    void pushSamples (const float* inputSamples, int num) noexcept
+    void addLevel (Range<float> level) noexcept
     {
-        for (int i = 0; i < num; ++i)
-            pushSample (inputSamples[i]);
-    }
-
-    void pushSample (float newSample) noexcept
-    {
-        if (--subSample <= 0)
-        {
-            if (++nextSample == levels.size())
-                nextSample = 0;
+        if (++nextSample == levels.size())
+            nextSample = 0;
 
-            levels.getReference (nextSample) = value;
-            subSample = owner.getSamplesPerBlock();
-            value = Range<float> (newSample, newSample);
-        }
-        else
-        {
-            value = value.getUnionWith (newSample);
-        }
+        levels.getReference (nextSample) = level;
     }
 
     void setBufferSize (int newSize)
@@ -82,14 +65,64 @@ struct AudioVisualiserComponent::ChannelInfo
             nextSample = 0;
     }
 
-    AudioVisualiserComponent& owner;
+    // Only used on the message thread
     Array<Range<float>> levels;
-    Range<float> value;
-    std::atomic<int> nextSample { 0 }, subSample { 0 };
+    int nextSample = 0;
+
+    // Only used by the thread that's pushing audio data
+    Range<float> blockLevel;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelInfo)
 };
 
+//==============================================================================
+/*  A single-producer, single-consumer queue of finished blocks, each containing one
+    min/max range per channel. The audio thread writes to it, and the message thread
+    drains it into the channels' level history before painting.
+*/
+struct AudioVisualiserComponent::LevelFifo
+{
+    LevelFifo (int numChannelsToUse, int capacity)
+        : numChannels (numChannelsToUse),
+          fifo (capacity),
+          blocks ((size_t) (capacity * numChannels))
+    {
+    }
+
+    void push (const OwnedArray<ChannelInfo>& channels) noexcept
+    {
+        // If the queue is full the display has fallen behind, so the new block is dropped
+        fifo.write (1).forEach ([&] (int index)
+        {
+            auto* dest = blocks.data() + index * numChannels;
+
+            for (int i = 0; i < numChannels; ++i)
+                dest[i] = channels.getUnchecked (i)->blockLevel;
+        });
+    }
+
+    bool popAll (OwnedArray<ChannelInfo>& channels) noexcept
+    {
+        const auto numReady = fifo.getNumReady();
+
+        fifo.read (numReady).forEach ([&] (int index)
+        {
+            const auto* src = blocks.data() + index * numChannels;
+
+            for (int i = 0; i < numChannels; ++i)
+                channels.getUnchecked (i)->addLevel (src[i]);
+        });
+
+        return numReady > 0;
+    }
+
+    const int numChannels;
+    AbstractFifo fifo;
+    std::vector<Range<float>> blocks;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelFifo)
+};
+
 //==============================================================================
 AudioVisualiserComponent::AudioVisualiserComponent (int initialNumChannels)
   : numSamples (1024),
@@ -111,7 +144,10 @@ void AudioVisualiserComponent::setNumChannels (int numChannels)
     channels.clear();
 
     for (int i = 0; i < numChannels; ++i)
-        channels.add (new ChannelInfo (*this, numSamples));
+        channels.add (new ChannelInfo (numSamples));
+
+    levelFifo = std::make_unique<LevelFifo> (numChannels, 8192);
+    samplesInCurrentBlock = 0;
 }
 
 void AudioVisualiserComponent::setBufferSize (int newNumSamples)
@@ -126,30 +162,29 @@ void AudioVisualiserComponent::clear()
 {
     for (auto* c : channels)
         c->clear();
+
+    needsRepaint = true;
 }
 
 void AudioVisualiserComponent::pushBuffer (const float* const* d, int numChannels, int num)
 {
-    numChannels = jmin (numChannels, channels.size());
-
-    for (int i = 0; i < numChannels; ++i)
-        channels.getUnchecked (i)->pushSamples (d[i], num);
+    pushChannels (d, numChannels, 0, num);
 }
 
 void AudioVisualiserComponent::pushBuffer (const AudioBuffer<float>& buffer)
 {
-    pushBuffer (buffer.getArrayOfReadPointers(),
-                buffer.getNumChannels(),
-                buffer.getNumSamples());
+    pushChannels (buffer.getArrayOfReadPointers(),
+                  buffer.getNumChannels(),
+                  0,
+                  buffer.getNumSamples());
 }
 
 void AudioVisualiserComponent::pushBuffer (const AudioSourceChannelInfo& buffer)
 {
-    auto numChannels = jmin (buffer.buffer->getNumChannels(), channels.size());
-
-    for (int i = 0; i < numChannels; ++i)
-        channels.getUnchecked (i)->pushSamples (buffer.buffer->getReadPointer (i, buffer.startSample),
-                                               buffer.numSamples);
+    pushChannels (buffer.buffer->getArrayOfReadPointers(),
+                  buffer.buffer->getNumChannels(),
+                  buffer.startSample,
+                  buffer.numSamples);
 }
 
 void AudioVisualiserComponent::pushSample (const float* d, int numChannels)
@@ -157,7 +192,47 @@ void AudioVisualiserComponent::pushSample (const float* d, int numChannels)
     numChannels = jmin (numChannels, channels.size());
 
     for (int i = 0; i < numChannels; ++i)
-        channels.getUnchecked (i)->pushSample (d[i]);
+    {
+        auto& level = channels.getUnchecked (i)->blockLevel;
+        level = samplesInCurrentBlock == 0 ? Range<float> (d[i], d[i]) : level.getUnionWith (d[i]);
+    }
+
+    ++samplesInCurrentBlock;
+    finishBlockIfFull();
+}
+
+void AudioVisualiserComponent::pushChannels (const float* const* d, int numChannels, int startSample, int num)
+{
+    numChannels = jmin (numChannels, channels.size());
+
+    for (int pos = 0; pos < num;)
+    {
+        const auto numThisTime = jmin (num - pos, jmax (1, getSamplesPerBlock() - samplesInCurrentBlock));
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            auto& level = channels.getUnchecked (i)->blockLevel;
+            const auto range = FloatVectorOperations::findMinAndMax (d[i] + startSample + pos, numThisTime);
+            level = samplesInCurrentBlock == 0 ? range : level.getUnionWith (range);
+        }
+
+        pos += numThisTime;
+        samplesInCurrentBlock += numThisTime;
+        finishBlockIfFull();
+    }
+}
+
+void AudioVisualiserComponent::finishBlockIfFull() noexcept
+{
+    if (samplesInCurrentBlock < getSamplesPerBlock())
+        return;
+
+    levelFifo->push (channels);
+
+    for (auto* c : channels)
+        c->blockLevel = {};
+
+    samplesInCurrentBlock = 0;
 }
 
 void AudioVisualiserComponent::setSamplesPerBlock (int newSamplesPerPixel) noexcept
@@ -167,12 +242,22 @@ void AudioVisualiserComponent::setSamplesPerBlock (int newSamplesPerPixel) noexc
 
 void AudioVisualiserComponent::setRepaintRate (int frequencyInHz)
 {
-    startTimerHz (frequencyInHz);
+    minRepaintInterval = frequencyInHz > 0 ? 1.0 / frequencyInHz
+                                           : std::numeric_limits<double>::max();
 }
 
-void AudioVisualiserComponent::timerCallback()
+void AudioVisualiserComponent::vBlankCallback (double timestampSec)
 {
-    repaint();
+    if (levelFifo->popAll (channels))
+        needsRepaint = true;
+
+    // Allow a little jitter, so that a rate matching the display's isn't halved
+    if (needsRepaint && timestampSec - lastRepaintTime >= minRepaintInterval * 0.9)
+    {
+        needsRepaint = false;
+        lastRepaintTime = timestampSec;
+        repaint();
+    }
 }
 
 void AudioVisualiserComponent::setColours (Colour bk, Colour fg) noexcept
@@ -43,6 +43,10 @@ namespace juce
     one of these, set its size and oversampling rate, and then feed it with incoming
     data by calling one of its pushBuffer() or pushSample() methods.
 
+    The push methods don't lock or allocate, so they can be called directly from the
+    audio thread. Each block of incoming samples is reduced to a min/max range and passed
+    to the message thread through a lock-free queue.
+
     You can override its paint method for more customised views, but it's only designed
     as a quick-and-dirty class for simple tasks, so please don't send us feature requests
     for fancy additional features that you'd like it to support! If you're building a
@@ -51,8 +55,7 @@ namespace juce
 
     @tags{Audio}
 */
-class JUCE_API AudioVisualiserComponent  : public Component,
-                                           private Timer
+class JUCE_API AudioVisualiserComponent  : public Component
 {
 public:
     /** Creates a visualiser with the given number of channels. */
@@ -107,7 +110,10 @@ public:
     /** Sets the colours used to paint the */
     void setColours (Colour backgroundColour, Colour waveformColour) noexcept;
 
-    /** Sets the frequency at which the component repaints itself. */
+    /** Sets the maximum frequency at which the component repaints itself.
+        Repaints are synchronised with the display refresh, and only happen when new
+        data has arrived.
+    */
     void setRepaintRate (int frequencyInHz);
 
     /** Draws a channel of audio data in the given bounds.
@@ -129,12 +135,22 @@ public:
 
 private:
     struct ChannelInfo;
+    struct LevelFifo;
 
     OwnedArray<ChannelInfo> channels;
-    int numSamples, inputSamplesPerBlock;
+    std::unique_ptr<LevelFifo> levelFifo;
+    int numSamples;
+    std::atomic<int> inputSamplesPerBlock;
+    int samplesInCurrentBlock = 0;
     Colour backgroundColour, waveformColour;
 
-    void timerCallback() override;
+    double minRepaintInterval = 0, lastRepaintTime = 0;
+    bool needsRepaint = false;
+    VBlankAttachment vBlankAttachment { this, [this] (double timestampSec) { vBlankCallback (timestampSec); } };
+
+    void pushChannels (const float* const*, int numChannels, int startSample, int num);
+    void finishBlockIfFull() noexcept;
+    void vBlankCallback (double timestampSec);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioVisualiserComponent)
 };
@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+static const char* const thumbnailFileWildcard = "*.thumb";
+
+DiskBackedAudioThumbnailCache::DiskBackedAudioThumbnailCache (const File& directoryToUse,
+                                                              int maxNumThumbsInMemory,
+                                                              int64 maxBytesOnDisk)
+    : AudioThumbnailCache (maxNumThumbsInMemory),
+      directory (directoryToUse),
+      maxNumBytesOnDisk (maxBytesOnDisk)
+{
+    jassert (directory != File());
+    directory.createDirectory();
+}
+
+DiskBackedAudioThumbnailCache::~DiskBackedAudioThumbnailCache()
+{
+}
+
+File DiskBackedAudioThumbnailCache::getFileForHashCode (int64 hashCode) const
+{
+    return directory.getChildFile (String::toHexString (hashCode).paddedLeft ('0', 16)
+                                     + String (thumbnailFileWildcard).substring (1));
+}
+
+void DiskBackedAudioThumbnailCache::clearDirectory()
+{
+    const ScopedLock sl (directoryLock);
+
+    for (auto& f : directory.findChildFiles (File::findFiles, false, thumbnailFileWildcard))
+        f.deleteFile();
+}
+
+void DiskBackedAudioThumbnailCache::trimDirectory()
+{
+    if (maxNumBytesOnDisk <= 0)
+        return;
+
+    const ScopedLock sl (directoryLock);
+
+    struct FileInfo
+    {
+        File file;
+        int64 size;
+        Time lastUsed;
+    };
+
+    std::vector<FileInfo> files;
+    int64 totalSize = 0;
+
+    for (auto& f : directory.findChildFiles (File::findFiles, false, thumbnailFileWildcard))
+    {
+        files.push_back ({ f, f.getSize(), f.getLastModificationTime() });
+        totalSize += files.back().size;
+    }
+
+    std::sort (files.begin(), files.end(),
+               [] (const FileInfo& a, const FileInfo& b) { return a.lastUsed < b.lastUsed; });
+
+    for (auto& info : files)
+    {
+        if (totalSize <= maxNumBytesOnDisk)
+            break;
+
+        if (info.file.deleteFile())
+            totalSize -= info.size;
+    }
+}
+
+void DiskBackedAudioThumbnailCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase& thumb, int64 hashCode)
+{
+    {
+        const ScopedLock sl (directoryLock);
+
+        auto file = getFileForHashCode (hashCode);
+        TemporaryFile temp (file);
+
+        {
+            FileOutputStream out (temp.getFile());
+
+            if (! out.openedOk())
+                return;
+
+            thumb.saveTo (out);
+            out.flush();
+
+            if (out.getStatus().failed())
+                return;
+        }
+
+        if (! temp.overwriteTargetFileWithTemporary())
+            return;
+    }
+
+    trimDirectory();
+}
+
+bool DiskBackedAudioThumbnailCache::loadNewThumb (AudioThumbnailBase& thumb, int64 hashCode)
+{
+    const ScopedLock sl (directoryLock);
+
+    auto file = getFileForHashCode (hashCode);
+
+    if (! file.existsAsFile())
+        return false;
+
+    {
+        MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+        if (mappedFile.getData() == nullptr)
+            return false;
+
+        MemoryInputStream in (mappedFile.getData(), mappedFile.getSize(), false);
+
+        if (! thumb.loadFrom (in))
+            return false;
+    }
+
+    // The modification time doubles as the last-used time for trimDirectory()
+    file.setLastModificationTime (Time::getCurrentTime());
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct DiskBackedAudioThumbnailCacheTests final : public UnitTest
+{
+    DiskBackedAudioThumbnailCacheTests()
+        : UnitTest ("DiskBackedAudioThumbnailCache", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        const auto directory = File::createTempFile ("thumbs");
+        AudioFormatManager formatManager;
+
+        beginTest ("Thumbnails are reloaded from disk by a new cache");
+        {
+            MemoryBlock savedData;
+
+            {
+                DiskBackedAudioThumbnailCache cache (directory, 4);
+                AudioThumbnail thumb (64, formatManager, cache);
+                fillThumbnail (thumb, 0.5f);
+
+                cache.storeThumb (thumb, hashCode);
+                expect (cache.getFileForHashCode (hashCode).existsAsFile());
+
+                MemoryOutputStream out;
+                thumb.saveTo (out);
+                savedData = out.getMemoryBlock();
+            }
+
+            DiskBackedAudioThumbnailCache cache (directory, 4);
+            AudioThumbnail thumb (64, formatManager, cache);
+
+            expect (cache.loadThumb (thumb, hashCode));
+            expect (thumb.isFullyLoaded());
+
+            MemoryOutputStream loadedData;
+            thumb.saveTo (loadedData);
+            expect (loadedData.getMemoryBlock() == savedData);
+
+            expect (! cache.loadThumb (thumb, hashCode + 1));
+        }
+
+        beginTest ("The directory is trimmed to its size limit, oldest first");
+        {
+            DiskBackedAudioThumbnailCache unlimited (directory, 4);
+            unlimited.clearDirectory();
+
+            AudioThumbnail thumb (64, formatManager, unlimited);
+            fillThumbnail (thumb, 0.25f);
+            unlimited.storeThumb (thumb, 1);
+
+            const auto fileSize = unlimited.getFileForHashCode (1).getSize();
+            expect (fileSize > 0);
+
+            unlimited.getFileForHashCode (1).setLastModificationTime (Time::getCurrentTime() - RelativeTime::hours (1));
+            unlimited.storeThumb (thumb, 2);
+
+            DiskBackedAudioThumbnailCache limited (directory, 4, fileSize * 2);
+            limited.storeThumb (thumb, 3);
+
+            expect (! limited.getFileForHashCode (1).existsAsFile());
+            expect (limited.getFileForHashCode (2).existsAsFile());
+            expect (limited.getFileForHashCode (3).existsAsFile());
+        }
+
+        beginTest ("The in-memory cache respects its memory budget");
+        {
+            AudioThumbnailCache cache (10);
+            AudioThumbnail thumb (64, formatManager, cache);
+            fillThumbnail (thumb, 0.75f);
+
+            cache.storeThumb (thumb, 1);
+            const auto thumbSize = cache.getMemoryUsage();
+            expect (thumbSize > 0);
+
+            cache.setMaxMemoryUsage (thumbSize * 2);
+
+            for (int64 i = 2; i <= 5; ++i)
+                cache.storeThumb (thumb, i);
+
+            expectEquals ((int) cache.getMemoryUsage(), (int) (thumbSize * 2));
+            expect (! cache.loadThumb (thumb, 3));
+            expect (cache.loadThumb (thumb, 4));
+            expect (cache.loadThumb (thumb, 5));
+
+            cache.setMaxMemoryUsage (1);
+            expectEquals ((int) cache.getMemoryUsage(), 0);
+        }
+
+        directory.deleteRecursively();
+    }
+
+    static constexpr int64 hashCode = 0x12345678abcdef;
+
+    static void fillThumbnail (AudioThumbnail& thumb, float level)
+    {
+        AudioBuffer<float> buffer (2, 4096);
+
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (chan, i, (i % 2 == 0 ? level : -level) * (float) (chan + 1) * 0.5f);
+
+        thumb.reset (buffer.getNumChannels(), 44100.0, buffer.getNumSamples());
+        thumb.addBlock (0, buffer, 0, buffer.getNumSamples());
+    }
+};
+
+static DiskBackedAudioThumbnailCacheTests diskBackedAudioThumbnailCacheTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioThumbnailCache that also keeps every finished thumbnail in a directory
+    on disk, so that it can be reloaded instantly the next time it's needed, even
+    after the app has been restarted.
+
+    Each thumbnail is stored in its own small file, named after its hash code, and
+    containing the data written by AudioThumbnailBase::saveTo(). When a thumbnail
+    isn't in memory, the file is memory-mapped and loaded straight from the map.
+
+    The hash code is the only key, so for files you should use a FileInputSource that
+    includes the file's modification time in its hash, e.g.
+    @code
+    thumbnail.setSource (new FileInputSource (file, true));
+    @endcode
+    so that an edited file gets a new thumbnail rather than a stale one.
+
+    The directory is kept within a size limit by deleting the least recently used
+    files, and the in-memory part of the cache can be given a size limit with
+    AudioThumbnailCache::setMaxMemoryUsage().
+
+    @see AudioThumbnailCache, AudioThumbnail
+
+    @tags{Audio}
+*/
+class JUCE_API  DiskBackedAudioThumbnailCache  : public AudioThumbnailCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache that stores its thumbnails in the given directory.
+
+        @param directoryToUse           the directory to keep thumbnail files in. It will
+                                        be created if it doesn't already exist
+        @param maxNumThumbsInMemory     the maximum number of thumbnails to keep in memory
+        @param maxNumBytesOnDisk        the maximum total size of the files in the directory,
+                                        or 0 to let it grow without limit
+    */
+    DiskBackedAudioThumbnailCache (const File& directoryToUse,
+                                   int maxNumThumbsInMemory,
+                                   int64 maxNumBytesOnDisk = 0);
+
+    /** Destructor. */
+    ~DiskBackedAudioThumbnailCache() override;
+
+    //==============================================================================
+    /** Returns the directory that the thumbnail files are stored in. */
+    const File& getDirectory() const noexcept               { return directory; }
+
+    /** Returns the file that the thumbnail with the given hash code is stored in,
+        whether or not it exists yet.
+    */
+    File getFileForHashCode (int64 hashCode) const;
+
+    /** Deletes all the thumbnail files in the directory. */
+    void clearDirectory();
+
+    /** Deletes the least recently used thumbnail files until their total size is
+        within the limit passed to the constructor.
+
+        This is called automatically whenever a new thumbnail file is written.
+    */
+    void trimDirectory();
+
+protected:
+    //==============================================================================
+    /** @internal */
+    void saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64 hashCode) override;
+    /** @internal */
+    bool loadNewThumb (AudioThumbnailBase&, int64 hashCode) override;
+
+private:
+    //==============================================================================
+    const File directory;
+    const int64 maxNumBytesOnDisk;
+    CriticalSection directoryLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiskBackedAudioThumbnailCache)
+};
+
+} // namespace juce
@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct OpenGLSpectrogramRenderer::Pyramid
+{
+    static constexpr float minDecibels = -120.0f;
+
+    int numBins = 0, numLevels = 0;
+    double framesPerSecond = 0;
+    std::vector<int64> levelStarts, levelSizes; // in frames, indexed by channel * numLevels + level
+    std::vector<uint8> magnitudes;              // numBins values for each frame
+
+    int getNumChannels() const noexcept         { return numLevels > 0 ? (int) levelStarts.size() / numLevels : 0; }
+
+    static std::unique_ptr<Pyramid> build (const AudioBuffer<float>& audio, double sampleRate, int fftOrder, int hopSize)
+    {
+        const auto numChannels = audio.getNumChannels();
+        const auto numSamples = audio.getNumSamples();
+
+        if (numChannels <= 0 || numSamples <= 0)
+            return {};
+
+        dsp::FFT fft (fftOrder);
+        const auto fftSize = fft.getSize();
+        dsp::WindowingFunction<float> window ((size_t) fftSize, dsp::WindowingFunction<float>::hann, false);
+        std::vector<float> frameData ((size_t) fftSize * 2);
+
+        auto pyramid = std::make_unique<Pyramid>();
+        pyramid->numBins = fftSize / 2;
+        pyramid->framesPerSecond = sampleRate / hopSize;
+
+        const auto numBins = pyramid->numBins;
+        const auto numFrames = (int64) ((numSamples + hopSize - 1) / hopSize);
+        int64 totalFramesPerChannel = 0;
+
+        for (auto size = numFrames;; size = (size + 1) / 2)
+        {
+            ++pyramid->numLevels;
+            totalFramesPerChannel += size;
+
+            if (size == 1)
+                break;
+        }
+
+        auto& magnitudes = pyramid->magnitudes;
+        magnitudes.reserve ((size_t) (totalFramesPerChannel * numChannels * numBins));
+
+        // A full-scale sine wave peaks at fftSize / 4 once the Hann window has halved it
+        const auto gainScale = 4.0f / (float) fftSize;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            pyramid->levelStarts.push_back ((int64) magnitudes.size() / numBins);
+            pyramid->levelSizes.push_back (numFrames);
+
+            for (int64 frame = 0; frame < numFrames; ++frame)
+            {
+                const auto start = (int) frame * hopSize;
+                std::fill (frameData.begin(), frameData.end(), 0.0f);
+                FloatVectorOperations::copy (frameData.data(), audio.getReadPointer (channel, start),
+                                             jmin (fftSize, numSamples - start));
+
+                window.multiplyWithWindowingTable (frameData.data(), (size_t) fftSize);
+                fft.performFrequencyOnlyForwardTransform (frameData.data());
+
+                for (int bin = 0; bin < numBins; ++bin)
+                    magnitudes.push_back (toLevel (Decibels::gainToDecibels (frameData[(size_t) bin] * gainScale, minDecibels)));
+            }
+
+            for (int level = 1; level < pyramid->numLevels; ++level)
+            {
+                const auto previousStart = pyramid->levelStarts.back();
+                const auto previousSize = pyramid->levelSizes.back();
+                const auto size = (previousSize + 1) / 2;
+
+                pyramid->levelStarts.push_back ((int64) magnitudes.size() / numBins);
+                pyramid->levelSizes.push_back (size);
+
+                for (int64 i = 0; i < size; ++i)
+                {
+                    const auto a = (size_t) ((previousStart + i * 2) * numBins);
+                    const auto b = i * 2 + 1 < previousSize ? a + (size_t) numBins : a;
+
+                    for (size_t bin = 0; bin < (size_t) numBins; ++bin)
+                        magnitudes.push_back (jmax (magnitudes[a + bin], magnitudes[b + bin]));
+                }
+            }
+        }
+
+        return pyramid;
+    }
+
+    static uint8 toLevel (float decibels) noexcept
+    {
+        return (uint8) jlimit (0, 255, roundToInt ((decibels - minDecibels) * 255.0f / -minDecibels));
+    }
+};
+
+//==============================================================================
+class OpenGLSpectrogramRenderer::Pimpl
+{
+public:
+    Pimpl()
+    {
+        gradient.addColour (0.0, Colours::black);
+        gradient.addColour (0.3, Colours::darkblue);
+        gradient.addColour (0.6, Colours::red);
+        gradient.addColour (0.85, Colours::yellow);
+        gradient.addColour (1.0, Colours::white);
+    }
+
+    void setPyramid (std::unique_ptr<Pyramid> newPyramid)
+    {
+        const SpinLock::ScopedLockType sl (lock);
+        pending = std::move (newPyramid);
+        hasPending = true;
+    }
+
+    void setColourGradient (const ColourGradient& newGradient)
+    {
+        const SpinLock::ScopedLockType sl (lock);
+        gradient = newGradient;
+        colourMapNeedsUpdate = true;
+    }
+
+    void render (OpenGLContext& context, Rectangle<float> area, Range<double> timeRange,
+                 int channel, Range<float> decibelRange)
+    {
+        uploadPendingData();
+
+        if (current == nullptr || area.isEmpty() || timeRange.isEmpty() || decibelRange.isEmpty()
+             || ! isPositiveAndBelow (channel, current->getNumChannels()))
+            return;
+
+        const auto framesPerPixel = timeRange.getLength() * current->framesPerSecond / area.getWidth();
+        const auto level = PyramidTextureRenderer::chooseLevel (framesPerPixel, current->numLevels);
+        const auto levelScale = std::ldexp (1.0, -level);
+        const auto index = (size_t) (channel * current->numLevels + level);
+
+        auto* program = renderer.begin (context, fragmentShader, area);
+
+        if (program == nullptr)
+            return;
+
+        program->setUniform ("levelStart",     (GLfloat) current->levelStarts[index]);
+        program->setUniform ("levelSize",      (GLfloat) current->levelSizes[index]);
+        program->setUniform ("startFrame",     (GLfloat) (timeRange.getStart() * current->framesPerSecond * levelScale));
+        program->setUniform ("framesPerPixel", (GLfloat) (framesPerPixel * levelScale));
+        program->setUniform ("numBins",        (GLfloat) current->numBins);
+        program->setUniform ("decibelRange",   (decibelRange.getStart() - Pyramid::minDecibels) / -Pyramid::minDecibels,
+                                               (decibelRange.getEnd()   - Pyramid::minDecibels) / -Pyramid::minDecibels);
+        program->setUniform ("colourMap",      (GLint) 1);
+
+        gl::glActiveTexture (gl::GL_TEXTURE1);
+        colourMap.bind();
+
+        renderer.draw (texture);
+
+        gl::glActiveTexture (gl::GL_TEXTURE1);
+        colourMap.unbind();
+        gl::glActiveTexture (gl::GL_TEXTURE0);
+    }
+
+    void release()
+    {
+        texture.release();
+        colourMap.release();
+        renderer.release();
+        needsUpload = true;
+
+        const SpinLock::ScopedLockType sl (lock);
+        colourMapNeedsUpdate = true;
+    }
+
+private:
+    static constexpr int colourMapSize = 256; // the fragment shader relies on this size
+
+    static constexpr const char* fragmentShader =
+        "uniform " JUCE_HIGHP " float levelStart;"
+        "uniform " JUCE_HIGHP " float levelSize;"
+        "uniform " JUCE_HIGHP " float startFrame;"
+        "uniform " JUCE_HIGHP " float framesPerPixel;"
+        "uniform " JUCE_HIGHP " float numBins;"
+        "uniform " JUCE_MEDIUMP " vec2 decibelRange;"
+        "uniform sampler2D colourMap;"
+        JUCE_MEDIUMP " float fetchMagnitude (" JUCE_HIGHP " float frame, " JUCE_HIGHP " float bin)"
+        "{"
+          JUCE_HIGHP " float framesPerRow = textureSize.x / numBins;"
+          JUCE_HIGHP " float row = floor (frame / framesPerRow);"
+          JUCE_HIGHP " float column = (frame - row * framesPerRow) * numBins + bin;"
+          "return texture2D (pyramid, vec2 ((column + 0.5) / textureSize.x, (row + 0.5) / textureSize.y)).a;"
+        "}"
+        "void main()"
+        "{"
+          JUCE_HIGHP " float first = startFrame + floor (pixelPos.x) * framesPerPixel;"
+          JUCE_HIGHP " float last = first + framesPerPixel;"
+          JUCE_HIGHP " float bin = min (floor ((1.0 - pixelPos.y / areaBounds.w) * numBins), numBins - 1.0);"
+          JUCE_MEDIUMP " float magnitude = -1.0;"
+          "for (int i = 0; i < 2; ++i)"
+          "{"
+            JUCE_HIGHP " float frame = floor (first) + float (i);"
+            "if ((i == 0 || frame < last) && frame >= 0.0 && frame < levelSize)"
+              "magnitude = max (magnitude, fetchMagnitude (levelStart + frame, bin));"
+          "}"
+          "if (magnitude < 0.0)"
+            "discard;"
+          JUCE_MEDIUMP " float position = clamp ((magnitude - decibelRange.x) / (decibelRange.y - decibelRange.x), 0.0, 1.0);"
+          "gl_FragColor = texture2D (colourMap, vec2 ((position * 255.0 + 0.5) / 256.0, 0.5));"
+        "}";
+
+    void uploadPendingData()
+    {
+        std::optional<ColourGradient> newGradient;
+
+        {
+            const SpinLock::ScopedLockType sl (lock);
+
+            if (hasPending)
+            {
+                current = std::move (pending);
+                hasPending = false;
+                needsUpload = true;
+            }
+
+            if (std::exchange (colourMapNeedsUpdate, false))
+                newGradient = gradient;
+        }
+
+        if (newGradient.has_value())
+        {
+            PixelARGB colours[colourMapSize];
+            newGradient->createLookupTable (colours);
+            colourMap.loadARGB (colours, colourMapSize, 1);
+        }
+
+        if (! std::exchange (needsUpload, false))
+            return;
+
+        if (current == nullptr)
+        {
+            texture.release();
+            return;
+        }
+
+        const auto numBins = current->numBins;
+        const auto numFrames = (int64) current->magnitudes.size() / numBins;
+        const auto width = PyramidTextureRenderer::getTextureWidth (numFrames * numBins, numBins);
+        const auto framesPerRow = width / numBins;
+        const auto height = (int) ((numFrames + framesPerRow - 1) / framesPerRow);
+        const auto maxSize = PyramidTextureRenderer::getMaxTextureSize();
+
+        if (width > maxSize || height > maxSize)
+        {
+            // This spectrogram has too many frames to fit into a texture - try using a
+            // larger hop size, or a smaller FFT.
+            jassertfalse;
+            current.reset();
+            return;
+        }
+
+        current->magnitudes.resize ((size_t) width * (size_t) height);
+        texture.loadAlpha (current->magnitudes.data(), width, height);
+        PyramidTextureRenderer::useNearestFiltering (texture);
+    }
+
+    SpinLock lock;
+    std::unique_ptr<Pyramid> pending, current;
+    ColourGradient gradient;
+    bool hasPending = false, needsUpload = false, colourMapNeedsUpdate = true;
+
+    OpenGLTexture texture, colourMap;
+    PyramidTextureRenderer renderer;
+};
+
+//==============================================================================
+OpenGLSpectrogramRenderer::OpenGLSpectrogramRenderer()  : pimpl (std::make_unique<Pimpl>()) {}
+OpenGLSpectrogramRenderer::~OpenGLSpectrogramRenderer() = default;
+
+void OpenGLSpectrogramRenderer::setSource (const AudioBuffer<float>& audio, double sampleRate, int fftOrder, int hopSize)
+{
+    jassert (sampleRate > 0 && fftOrder > 0);
+
+    if (hopSize <= 0)
+        hopSize = jmax (1, (1 << fftOrder) / 2);
+
+    pimpl->setPyramid (Pyramid::build (audio, sampleRate, fftOrder, hopSize));
+}
+
+void OpenGLSpectrogramRenderer::clear()
+{
+    pimpl->setPyramid (nullptr);
+}
+
+void OpenGLSpectrogramRenderer::setColourGradient (const ColourGradient& newGradient)
+{
+    pimpl->setColourGradient (newGradient);
+}
+
+void OpenGLSpectrogramRenderer::render (OpenGLContext& context, Rectangle<float> area, Range<double> timeRange,
+                                        int channel, Range<float> decibelRange)
+{
+    pimpl->render (context, area, timeRange, channel, decibelRange);
+}
+
+void OpenGLSpectrogramRenderer::release()
+{
+    pimpl->release();
+}
+
+} // namespace juce
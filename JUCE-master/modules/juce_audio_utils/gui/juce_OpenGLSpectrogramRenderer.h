@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Draws spectrograms with OpenGL.
+
+    The audio is split into frames which are windowed and transformed with an FFT, and
+    their magnitudes in decibels are stored in a pyramid, where each level keeps the
+    loudest of each pair of frames in the level below. The pyramid is uploaded into a
+    texture once, so drawing a different range of time or decibels only changes a few
+    shader uniforms.
+
+    setSource() can be called on any thread, and the pyramid is uploaded the next
+    time render() is called. render() and release() must be called on the GL thread,
+    e.g. from OpenGLRenderer::renderOpenGL() and OpenGLRenderer::openGLContextClosing().
+
+    The texture needs one byte for each bin of each frame, plus about the same again for
+    the coarser levels, so choose the FFT size and hop size with long sources in mind.
+
+    This class is only available if the juce_opengl and juce_dsp modules are also being used.
+
+    @see OpenGLWaveformRenderer
+
+    @tags{Audio}
+*/
+class JUCE_API  OpenGLSpectrogramRenderer
+{
+public:
+    //==============================================================================
+    OpenGLSpectrogramRenderer();
+
+    /** Destructor. If render() has been called, release() must be called before this. */
+    ~OpenGLSpectrogramRenderer();
+
+    //==============================================================================
+    /** Analyses a buffer of audio and builds the spectrogram pyramid.
+
+        Each frame is 2 ^ fftOrder samples long, and frames start every hopSize samples.
+        If hopSize is 0, it's set to half of the frame length.
+    */
+    void setSource (const AudioBuffer<float>& audio, double sampleRate, int fftOrder = 10, int hopSize = 0);
+
+    /** Clears the spectrogram. */
+    void clear();
+
+    /** Sets the colours used for magnitudes from the bottom to the top of the decibel
+        range passed to render(). The gradient's start and end points are ignored, only
+        its colours and their proportional positions are used.
+    */
+    void setColourGradient (const ColourGradient& newGradient);
+
+    //==============================================================================
+    /** Draws one channel of the spectrogram.
+
+        The area is in pixels, relative to the top-left of the current GL viewport. Time
+        runs from left to right, and frequency from 0 at the bottom to Nyquist at the top.
+        Magnitudes are coloured according to where they fall in the given range of
+        decibels, where 0 dB is a full-scale sine wave.
+    */
+    void render (OpenGLContext& context, Rectangle<float> area, Range<double> timeRange,
+                 int channel, Range<float> decibelRange = { -100.0f, 0.0f });
+
+    /** Frees the GL resources. Call this on the GL thread before the context is closed. */
+    void release();
+
+private:
+    //==============================================================================
+    struct Pyramid;
+    class Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLSpectrogramRenderer)
+};
+
+} // namespace juce
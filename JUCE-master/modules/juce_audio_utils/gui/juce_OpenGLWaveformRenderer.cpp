@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct OpenGLWaveformRenderer::Pyramid
+{
+    int numLevels = 0;
+    double binsPerSecond = 0;
+    std::vector<int64> levelStarts, levelSizes; // indexed by channel * numLevels + level
+    std::vector<PixelARGB> texels;              // red holds each bin's minimum, green its maximum
+
+    int getNumChannels() const noexcept         { return numLevels > 0 ? (int) levelStarts.size() / numLevels : 0; }
+
+    template <typename GetRange>
+    static std::unique_ptr<Pyramid> build (int numChannels, int64 numBins, double binsPerSecond, GetRange&& getRange)
+    {
+        if (numChannels <= 0 || numBins <= 0)
+            return {};
+
+        auto pyramid = std::make_unique<Pyramid>();
+        pyramid->binsPerSecond = binsPerSecond;
+
+        int64 totalBinsPerChannel = 0;
+
+        for (auto size = numBins;; size = (size + 1) / 2)
+        {
+            ++pyramid->numLevels;
+            totalBinsPerChannel += size;
+
+            if (size == 1)
+                break;
+        }
+
+        auto& texels = pyramid->texels;
+        texels.reserve ((size_t) (totalBinsPerChannel * numChannels));
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            pyramid->levelStarts.push_back ((int64) texels.size());
+            pyramid->levelSizes.push_back (numBins);
+
+            for (int64 bin = 0; bin < numBins; ++bin)
+            {
+                const auto range = getRange (channel, bin);
+                texels.emplace_back ((uint8) 255, toLevel (range.getStart()), toLevel (range.getEnd()), (uint8) 0);
+            }
+
+            for (int level = 1; level < pyramid->numLevels; ++level)
+            {
+                const auto previousStart = pyramid->levelStarts.back();
+                const auto previousSize = pyramid->levelSizes.back();
+                const auto size = (previousSize + 1) / 2;
+
+                pyramid->levelStarts.push_back ((int64) texels.size());
+                pyramid->levelSizes.push_back (size);
+
+                for (int64 i = 0; i < size; ++i)
+                {
+                    const auto a = texels[(size_t) (previousStart + i * 2)];
+                    const auto b = i * 2 + 1 < previousSize ? texels[(size_t) (previousStart + i * 2 + 1)] : a;
+
+                    texels.emplace_back ((uint8) 255,
+                                         jmin (a.getRed(), b.getRed()),
+                                         jmax (a.getGreen(), b.getGreen()),
+                                         (uint8) 0);
+                }
+            }
+        }
+
+        return pyramid;
+    }
+
+    static uint8 toLevel (float value) noexcept
+    {
+        return (uint8) roundToInt ((jlimit (-1.0f, 1.0f, value) + 1.0f) * 127.5f);
+    }
+};
+
+//==============================================================================
+class OpenGLWaveformRenderer::Pimpl
+{
+public:
+    void setPyramid (std::unique_ptr<Pyramid> newPyramid)
+    {
+        const SpinLock::ScopedLockType sl (lock);
+        pending = std::move (newPyramid);
+        hasPending = true;
+    }
+
+    void render (OpenGLContext& context, Rectangle<float> area, Range<double> timeRange, int channel, Colour colour)
+    {
+        uploadPendingPyramid();
+
+        if (current == nullptr || area.isEmpty() || timeRange.isEmpty()
+             || ! isPositiveAndBelow (channel, current->getNumChannels()))
+            return;
+
+        const auto binsPerPixel = timeRange.getLength() * current->binsPerSecond / area.getWidth();
+        const auto level = PyramidTextureRenderer::chooseLevel (binsPerPixel, current->numLevels);
+        const auto levelScale = std::ldexp (1.0, -level);
+        const auto index = (size_t) (channel * current->numLevels + level);
+
+        auto* program = renderer.begin (context, fragmentShader, area);
+
+        if (program == nullptr)
+            return;
+
+        program->setUniform ("levelStart",   (GLfloat) current->levelStarts[index]);
+        program->setUniform ("levelSize",    (GLfloat) current->levelSizes[index]);
+        program->setUniform ("startBin",     (GLfloat) (timeRange.getStart() * current->binsPerSecond * levelScale));
+        program->setUniform ("binsPerPixel", (GLfloat) (binsPerPixel * levelScale));
+
+        const auto alpha = colour.getFloatAlpha();
+        program->setUniform ("colour", colour.getFloatRed() * alpha, colour.getFloatGreen() * alpha,
+                                       colour.getFloatBlue() * alpha, alpha);
+
+        renderer.draw (texture);
+    }
+
+    void release()
+    {
+        texture.release();
+        renderer.release();
+        needsUpload = true;
+    }
+
+private:
+    static constexpr const char* fragmentShader =
+        "uniform " JUCE_HIGHP " float levelStart;"
+        "uniform " JUCE_HIGHP " float levelSize;"
+        "uniform " JUCE_HIGHP " float startBin;"
+        "uniform " JUCE_HIGHP " float binsPerPixel;"
+        "uniform " JUCE_LOWP " vec4 colour;"
+        "void main()"
+        "{"
+          JUCE_HIGHP " float first = startBin + floor (pixelPos.x) * binsPerPixel;"
+          JUCE_HIGHP " float last = first + binsPerPixel;"
+          JUCE_MEDIUMP " float low = 1.0;"
+          JUCE_MEDIUMP " float high = 0.0;"
+          "for (int i = 0; i < 4; ++i)"
+          "{"
+            JUCE_HIGHP " float bin = floor (first) + float (i);"
+            "if (bin < last && bin >= 0.0 && bin < levelSize)"
+            "{"
+              JUCE_MEDIUMP " vec4 texel = fetchTexel (levelStart + bin);"
+              "low = min (low, texel.r);"
+              "high = max (high, texel.g);"
+            "}"
+          "}"
+          JUCE_HIGHP " float halfPixel = 0.5 / areaBounds.w;"
+          JUCE_HIGHP " float value = 1.0 - pixelPos.y / areaBounds.w;"
+          "if (high < low || value < low - halfPixel || value > high + halfPixel)"
+            "discard;"
+          "gl_FragColor = colour;"
+        "}";
+
+    void uploadPendingPyramid()
+    {
+        {
+            const SpinLock::ScopedLockType sl (lock);
+
+            if (hasPending)
+            {
+                current = std::move (pending);
+                hasPending = false;
+                needsUpload = true;
+            }
+        }
+
+        if (! std::exchange (needsUpload, false))
+            return;
+
+        if (current == nullptr)
+        {
+            texture.release();
+            return;
+        }
+
+        const auto numTexels = (int64) current->texels.size();
+        const auto width = PyramidTextureRenderer::getTextureWidth (numTexels, 1);
+        const auto height = (int) ((numTexels + width - 1) / width);
+        const auto maxSize = PyramidTextureRenderer::getMaxTextureSize();
+
+        if (width > maxSize || height > maxSize)
+        {
+            // This waveform has too many bins to fit into a texture - try using a larger
+            // number of samples per bin.
+            jassertfalse;
+            current.reset();
+            return;
+        }
+
+        current->texels.resize ((size_t) (width * height));
+        texture.loadARGB (current->texels.data(), width, height);
+        PyramidTextureRenderer::useNearestFiltering (texture);
+    }
+
+    SpinLock lock;
+    std::unique_ptr<Pyramid> pending, current;
+    bool hasPending = false, needsUpload = false;
+
+    OpenGLTexture texture;
+    PyramidTextureRenderer renderer;
+};
+
+//==============================================================================
+OpenGLWaveformRenderer::OpenGLWaveformRenderer()  : pimpl (std::make_unique<Pimpl>()) {}
+OpenGLWaveformRenderer::~OpenGLWaveformRenderer() = default;
+
+void OpenGLWaveformRenderer::setSource (const AudioBuffer<float>& audio, double sampleRate, int samplesPerBin)
+{
+    jassert (sampleRate > 0 && samplesPerBin > 0);
+    samplesPerBin = jmax (1, samplesPerBin);
+
+    const auto numSamples = audio.getNumSamples();
+    const auto numBins = (numSamples + samplesPerBin - 1) / samplesPerBin;
+
+    pimpl->setPyramid (Pyramid::build (audio.getNumChannels(), numBins, sampleRate / samplesPerBin,
+                                       [&] (int channel, int64 bin)
+                                       {
+                                           const auto start = (int) bin * samplesPerBin;
+                                           return FloatVectorOperations::findMinAndMax (audio.getReadPointer (channel, start),
+                                                                                        jmin (samplesPerBin, numSamples - start));
+                                       }));
+}
+
+void OpenGLWaveformRenderer::setSource (const AudioThumbnailBase& thumbnail, double binsPerSecond)
+{
+    jassert (binsPerSecond > 0);
+
+    const auto numBins = (int64) std::ceil (thumbnail.getTotalLength() * binsPerSecond);
+
+    pimpl->setPyramid (Pyramid::build (thumbnail.getNumChannels(), numBins, binsPerSecond,
+                                       [&] (int channel, int64 bin)
+                                       {
+                                           float low = 0, high = 0;
+                                           thumbnail.getApproximateMinMax ((double) bin / binsPerSecond,
+                                                                           (double) (bin + 1) / binsPerSecond,
+                                                                           channel, low, high);
+                                           return Range<float> (low, high);
+                                       }));
+}
+
+void OpenGLWaveformRenderer::clear()
+{
+    pimpl->setPyramid (nullptr);
+}
+
+void OpenGLWaveformRenderer::render (OpenGLContext& context, Rectangle<float> area, Range<double> timeRange,
+                                     int channel, Colour colour)
+{
+    pimpl->render (context, area, timeRange, channel, colour);
+}
+
+void OpenGLWaveformRenderer::release()
+{
+    pimpl->release();
+}
+
+} // namespace juce
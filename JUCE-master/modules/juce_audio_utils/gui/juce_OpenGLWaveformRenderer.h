@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Draws audio waveforms with OpenGL.
+
+    The audio is reduced to a pyramid of min/max levels, which is uploaded into a
+    texture once. After that, drawing a different range of time only changes a few
+    shader uniforms, so long waveforms can be panned and zoomed without any work
+    on the CPU.
+
+    setSource() can be called on any thread, and the pyramid is uploaded the next
+    time render() is called. render() and release() must be called on the GL thread,
+    e.g. from OpenGLRenderer::renderOpenGL() and OpenGLRenderer::openGLContextClosing().
+
+    This class is only available if the juce_opengl module is also being used.
+
+    @see OpenGLSpectrogramRenderer, AudioThumbnail
+
+    @tags{Audio}
+*/
+class JUCE_API  OpenGLWaveformRenderer
+{
+public:
+    //==============================================================================
+    OpenGLWaveformRenderer();
+
+    /** Destructor. If render() has been called, release() must be called before this. */
+    ~OpenGLWaveformRenderer();
+
+    //==============================================================================
+    /** Builds the waveform pyramid from a buffer of audio.
+
+        The finest level of the pyramid stores the minimum and maximum of each block
+        of samplesPerBin samples.
+    */
+    void setSource (const AudioBuffer<float>& audio, double sampleRate, int samplesPerBin = 64);
+
+    /** Builds the waveform pyramid from a thumbnail, using getApproximateMinMax() to
+        find the range of each bin.
+
+        The thumbnail should have finished loading. A binsPerSecond value higher than the
+        thumbnail's own resolution won't add any detail.
+    */
+    void setSource (const AudioThumbnailBase& thumbnail, double binsPerSecond = 1000.0);
+
+    /** Clears the waveform. */
+    void clear();
+
+    //==============================================================================
+    /** Draws one channel of the waveform.
+
+        The area is in pixels, relative to the top-left of the current GL viewport,
+        and the waveform's full scale from -1 to 1 is stretched to fill its height.
+        Parts of the time range that are outside the source are left empty.
+    */
+    void render (OpenGLContext& context, Rectangle<float> area, Range<double> timeRange,
+                 int channel, Colour colour);
+
+    /** Frees the GL resources. Call this on the GL thread before the context is closed. */
+    void release();
+
+private:
+    //==============================================================================
+    struct Pyramid;
+    class Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLWaveformRenderer)
+};
+
+} // namespace juce
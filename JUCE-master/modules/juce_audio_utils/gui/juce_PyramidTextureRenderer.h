@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+/*  The GL plumbing shared by OpenGLWaveformRenderer and OpenGLSpectrogramRenderer.
+
+    Both renderers pack a pyramid of levels into a single texture, treating it as one long
+    row of texels that wraps at the texture's width. This object owns the shader program
+    that reads from it, and the quad that covers the area being drawn.
+*/
+class PyramidTextureRenderer
+{
+public:
+    /*  Returns a power-of-two texture width that keeps the texture roughly square, and is
+        a multiple of the given number of texels per item.
+    */
+    static int getTextureWidth (int64 numTexels, int texelsPerItem)
+    {
+        const auto side = (int) std::ceil (std::sqrt ((double) jmax ((int64) 1, numTexels)));
+        return jmax (nextPowerOfTwo (side), nextPowerOfTwo (texelsPerItem));
+    }
+
+    static int getMaxTextureSize()
+    {
+        GLint size = 0;
+        gl::glGetIntegerv (gl::GL_MAX_TEXTURE_SIZE, &size);
+        return (int) size;
+    }
+
+    /*  Chooses the pyramid level at which each pixel covers between one and two items,
+        given the number of items per pixel at level 0.
+    */
+    static int chooseLevel (double itemsPerPixel, int numLevels)
+    {
+        if (itemsPerPixel <= 1.0 || numLevels <= 1)
+            return 0;
+
+        return jlimit (0, numLevels - 1, (int) std::floor (std::log2 (itemsPerPixel)));
+    }
+
+    static void useNearestFiltering (const OpenGLTexture& texture)
+    {
+        texture.bind();
+        gl::glTexParameteri (gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MIN_FILTER, gl::GL_NEAREST);
+        gl::glTexParameteri (gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_NEAREST);
+        texture.unbind();
+    }
+
+    /*  Compiles the program if needed, and prepares to draw the given area of the
+        current viewport. The fragment shader can use the 'pixelPos' and 'areaSize'
+        values, and the fetchTexel() function.
+        Returns nullptr if the program couldn't be built.
+    */
+    OpenGLShaderProgram* begin (OpenGLContext& context, const char* fragmentShaderBody, Rectangle<float> area)
+    {
+        using namespace ::juce::gl;
+
+        if (program == nullptr)
+        {
+            program = std::make_unique<OpenGLShaderProgram> (context);
+
+            const auto built = program->addVertexShader (OpenGLHelpers::translateVertexShaderToV3 (
+                                   "attribute " JUCE_HIGHP " vec2 position;"
+                                   "uniform " JUCE_HIGHP " vec2 screenSize;"
+                                   "uniform " JUCE_HIGHP " vec4 areaBounds;"
+                                   "varying " JUCE_HIGHP " vec2 pixelPos;"
+                                   "void main()"
+                                   "{"
+                                     "pixelPos = position - areaBounds.xy;"
+                                     "gl_Position = vec4 (position.x / (0.5 * screenSize.x) - 1.0,"
+                                                         "1.0 - position.y / (0.5 * screenSize.y), 0.0, 1.0);"
+                                   "}"))
+                            && program->addFragmentShader (OpenGLHelpers::translateFragmentShaderToV3 (
+                                   String ("uniform sampler2D pyramid;"
+                                           "uniform " JUCE_HIGHP " vec2 textureSize;"
+                                           "uniform " JUCE_HIGHP " vec4 areaBounds;"
+                                           "varying " JUCE_HIGHP " vec2 pixelPos;"
+                                           JUCE_HIGHP " vec4 fetchTexel (" JUCE_HIGHP " float index)"
+                                           "{"
+                                             JUCE_HIGHP " float row = floor (index / textureSize.x);"
+                                             JUCE_HIGHP " float column = index - row * textureSize.x;"
+                                             "return texture2D (pyramid, vec2 ((column + 0.5) / textureSize.x,"
+                                                                             "(row + 0.5) / textureSize.y));"
+                                           "}")
+                                   + fragmentShaderBody))
+                            && program->link();
+
+            if (! built)
+            {
+                // If you hit this, your GL driver couldn't build the shader - check getLastError()
+                DBG (program->getLastError());
+                jassertfalse;
+                program.reset();
+                return nullptr;
+            }
+
+            if (glGenVertexArrays != nullptr)
+                glGenVertexArrays (1, &vertexArray);
+
+            glGenBuffers (1, &vertexBuffer);
+        }
+
+        GLint viewport[4] = {};
+        glGetIntegerv (GL_VIEWPORT, viewport);
+
+        const GLfloat vertices[] = { area.getX(),     area.getY(),
+                                     area.getRight(), area.getY(),
+                                     area.getX(),     area.getBottom(),
+                                     area.getRight(), area.getBottom() };
+
+        if (vertexArray != 0)
+            glBindVertexArray (vertexArray);
+
+        glBindBuffer (GL_ARRAY_BUFFER, vertexBuffer);
+        glBufferData (GL_ARRAY_BUFFER, sizeof (vertices), vertices, GL_STREAM_DRAW);
+
+        program->use();
+
+        const auto positionID = (GLuint) glGetAttribLocation (program->getProgramID(), "position");
+        glVertexAttribPointer (positionID, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray (positionID);
+
+        program->setUniform ("screenSize", (GLfloat) viewport[2], (GLfloat) viewport[3]);
+        program->setUniform ("areaBounds", area.getX(), area.getY(), area.getWidth(), area.getHeight());
+        program->setUniform ("pyramid", (GLint) 0);
+
+        glEnable (GL_BLEND);
+        glBlendFunc (GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        return program.get();
+    }
+
+    void draw (const OpenGLTexture& pyramid)
+    {
+        using namespace ::juce::gl;
+
+        program->setUniform ("textureSize", (GLfloat) pyramid.getWidth(), (GLfloat) pyramid.getHeight());
+
+        glActiveTexture (GL_TEXTURE0);
+        pyramid.bind();
+        glDrawArrays (GL_TRIANGLE_STRIP, 0, 4);
+        pyramid.unbind();
+
+        glDisableVertexAttribArray ((GLuint) glGetAttribLocation (program->getProgramID(), "position"));
+        glBindBuffer (GL_ARRAY_BUFFER, 0);
+
+        if (vertexArray != 0)
+            glBindVertexArray (0);
+
+        glUseProgram (0);
+    }
+
+    void release()
+    {
+        using namespace ::juce::gl;
+
+        if (vertexBuffer != 0)
+            glDeleteBuffers (1, &vertexBuffer);
+
+        if (vertexArray != 0)
+            glDeleteVertexArrays (1, &vertexArray);
+
+        vertexBuffer = vertexArray = 0;
+        program.reset();
+    }
+
+private:
+    std::unique_ptr<OpenGLShaderProgram> program;
+    GLuint vertexArray = 0, vertexBuffer = 0;
+};
+
+} // namespace juce
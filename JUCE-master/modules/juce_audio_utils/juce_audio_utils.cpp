@@ -68,11 +68,22 @@
 #include "gui/juce_AudioDeviceSelectorComponent.cpp"
 #include "gui/juce_AudioThumbnail.cpp"
 #include "gui/juce_AudioThumbnailCache.cpp"
+#include "gui/juce_DiskBackedAudioThumbnailCache.cpp"
 #include "gui/juce_AudioVisualiserComponent.cpp"
 #include "gui/juce_KeyboardComponentBase.cpp"
 #include "gui/juce_MidiKeyboardComponent.cpp"
 #include "gui/juce_MPEKeyboardComponent.cpp"
 #include "gui/juce_AudioAppComponent.cpp"
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+ #include "gui/juce_PyramidTextureRenderer.h"
+ #include "gui/juce_OpenGLWaveformRenderer.cpp"
+
+ #if JUCE_MODULE_AVAILABLE_juce_dsp
+  #include "gui/juce_OpenGLSpectrogramRenderer.cpp"
+ #endif
+#endif
+
 #include "players/juce_SoundPlayer.cpp"
 #include "players/juce_AudioProcessorPlayer.cpp"
 #include "audio_cd/juce_AudioCDReader.cpp"
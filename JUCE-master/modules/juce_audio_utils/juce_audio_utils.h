@@ -88,12 +88,24 @@
 #include "gui/juce_AudioThumbnailBase.h"
 #include "gui/juce_AudioThumbnail.h"
 #include "gui/juce_AudioThumbnailCache.h"
+#include "gui/juce_DiskBackedAudioThumbnailCache.h"
 #include "gui/juce_AudioVisualiserComponent.h"
 #include "gui/juce_KeyboardComponentBase.h"
 #include "gui/juce_MidiKeyboardComponent.h"
 #include "gui/juce_MPEKeyboardComponent.h"
 #include "gui/juce_AudioAppComponent.h"
 #include "gui/juce_BluetoothMidiDevicePairingDialogue.h"
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+ #include <juce_opengl/juce_opengl.h>
+ #include "gui/juce_OpenGLWaveformRenderer.h"
+
+ #if JUCE_MODULE_AVAILABLE_juce_dsp
+  #include <juce_dsp/juce_dsp.h>
+  #include "gui/juce_OpenGLSpectrogramRenderer.h"
+ #endif
+#endif
+
 #include "players/juce_SoundPlayer.h"
 #include "players/juce_AudioProcessorPlayer.h"
 #include "audio_cd/juce_AudioCDBurner.h"
@@ -308,14 +308,22 @@ void AudioProcessorPlayer::audioDeviceIOCallbackWithContext (const float* const*
 
         if (! processor->isSuspended())
         {
+            JUCE_SCOPED_REALTIME_CONTEXT ("AudioProcessorPlayer processBlock")
+
             if (processor->isUsingDoublePrecision())
             {
                 conversionBuffer.makeCopyOf (buffer, true);
-                processor->processBlock (conversionBuffer, incomingMidi);
+
+                {
+                    AudioProcessLoadMeasurer::ScopedTimer timer (processor->getProcessLoadMeasurer(), numSamples);
+                    processor->processBlock (conversionBuffer, incomingMidi);
+                }
+
                 buffer.makeCopyOf (conversionBuffer, true);
             }
             else
             {
+                AudioProcessLoadMeasurer::ScopedTimer timer (processor->getProcessLoadMeasurer(), numSamples);
                 processor->processBlock (buffer, incomingMidi);
             }
 
@@ -1125,8 +1125,7 @@ private:
 
     void minimiseStorageAfterRemoval()
     {
-        if (values.capacity() > jmax (minimumAllocatedSize, values.size() * 2))
-            values.shrinkToNoMoreThan (jmax (values.size(), jmax (minimumAllocatedSize, 64 / (int) sizeof (ElementType))));
+        values.shrinkToFit (jmax (minimumAllocatedSize, 64 / (int) sizeof (ElementType)));
     }
 };
 
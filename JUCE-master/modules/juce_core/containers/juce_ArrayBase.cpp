@@ -515,6 +515,46 @@ public:
             }
         }
 
+        beginTest ("relocatable types");
+        {
+            static_assert (TypeHelpers::IsTriviallyRelocatable<String>::value);
+            static_assert (TypeHelpers::IsTriviallyRelocatable<var>::value);
+            static_assert (! TypeHelpers::IsTriviallyRelocatable<NoncopyableType>::value);
+
+            std::vector<String> referenceContainer;
+            ArrayBase<String, DummyCriticalSection> container;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                referenceContainer.push_back (String (i) + " is a string long enough to be allocated");
+                container.add (referenceContainer.back());
+            }
+
+            for (int i = 0; i < 10; ++i)
+            {
+                referenceContainer.insert (referenceContainer.begin() + i * 3, String (-i));
+                container.insert (i * 3, String (-i), 1);
+            }
+
+            for (int i = 0; i < 10; ++i)
+            {
+                referenceContainer.erase (referenceContainer.begin() + i * 2, referenceContainer.begin() + i * 2 + 3);
+                container.removeElements (i * 2, 3);
+            }
+
+            std::rotate (referenceContainer.begin() + 5, referenceContainer.begin() + 6, referenceContainer.begin() + 41);
+            container.move (5, 40);
+
+            checkEqual (container, referenceContainer);
+
+            container.removeElements (0, container.size() - 3);
+            referenceContainer.erase (referenceContainer.begin(), referenceContainer.end() - 3);
+            container.shrinkToFit (0);
+
+            expect (container.capacity() < 16);
+            checkEqual (container, referenceContainer);
+        }
+
         beginTest ("After converting move construction, ownership is transferred");
         {
             Derived obj;
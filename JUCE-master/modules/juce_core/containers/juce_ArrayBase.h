@@ -240,7 +240,7 @@ public:
     void ensureAllocatedSize (int minNumElements)
     {
         if (minNumElements > numAllocated)
-            setAllocatedSize ((minNumElements + minNumElements / 2 + 8) & ~7);
+            setAllocatedSize (getGrowthSize (minNumElements));
 
         jassert (numAllocated <= 0 || elements != nullptr);
     }
@@ -251,6 +251,18 @@ public:
             setAllocatedSize (maxNumElements);
     }
 
+    /** Frees some of the storage if less than half of it is being used.
+
+        Enough space is kept for the array to grow by the usual amount before it has to
+        reallocate again, so that adding and removing elements around the same size doesn't
+        keep reallocating the array.
+    */
+    void shrinkToFit (int minNumElements)
+    {
+        if (numAllocated > jmax (minNumElements, numUsed * 2))
+            shrinkToNoMoreThan (jmax (minNumElements, numUsed > 0 ? getGrowthSize (numUsed) : 0));
+    }
+
     void clear()
     {
         for (int i = 0; i < numUsed; ++i)
@@ -406,6 +418,19 @@ private:
     static constexpr auto isTriviallyCopyable = std::is_trivially_copyable_v<ElementType>;
    #endif
 
+    // Elements of these types can be moved around with memmove, without calling their
+    // move constructors and destructors
+    static constexpr auto isTriviallyRelocatable = isTriviallyCopyable
+                                                || TypeHelpers::IsTriviallyRelocatable<ElementType>::value;
+
+    // The storage grows by 50% each time, which lets the allocator reuse the blocks freed
+    // by earlier reallocations
+    static int getGrowthSize (int minNumElements) noexcept
+    {
+        const auto size = ((int64) minNumElements + minNumElements / 2 + 8) & ~(int64) 7;
+        return (int) jmin (size, (int64) std::numeric_limits<int>::max());
+    }
+
     //==============================================================================
     template <typename Type>
     void addArrayInternal (const Type* otherElements, int numElements)
@@ -427,7 +452,7 @@ private:
     //==============================================================================
     void setAllocatedSizeInternal (int numElements)
     {
-        if constexpr (isTriviallyCopyable)
+        if constexpr (isTriviallyRelocatable)
         {
             elements.realloc ((size_t) numElements);
         }
@@ -460,11 +485,11 @@ private:
 
     void createInsertSpaceInternal (int indexToInsertAt, int numElements)
     {
-        if constexpr (isTriviallyCopyable)
+        if constexpr (isTriviallyRelocatable)
         {
             auto* start = elements + indexToInsertAt;
             auto numElementsToShift = numUsed - indexToInsertAt;
-            memmove (start + numElements, start, (size_t) numElementsToShift * sizeof (ElementType));
+            memmove (static_cast<void*> (start + numElements), static_cast<const void*> (start), (size_t) numElementsToShift * sizeof (ElementType));
         }
         else
         {
@@ -483,11 +508,16 @@ private:
     //==============================================================================
     void removeElementsInternal (int indexToRemoveAt, int numElementsToRemove)
     {
-        if constexpr (isTriviallyCopyable)
+        if constexpr (isTriviallyRelocatable)
         {
             auto* start = elements + indexToRemoveAt;
             auto numElementsToShift = numUsed - (indexToRemoveAt + numElementsToRemove);
-            memmove (start, start + numElementsToRemove, (size_t) numElementsToShift * sizeof (ElementType));
+
+            if constexpr (! isTriviallyCopyable)
+                for (int i = 0; i < numElementsToRemove; ++i)
+                    start[i].~ElementType();
+
+            memmove (static_cast<void*> (start), static_cast<const void*> (start + numElementsToRemove), (size_t) numElementsToShift * sizeof (ElementType));
         }
         else
         {
@@ -506,25 +536,25 @@ private:
     //==============================================================================
     void moveInternal (int currentIndex, int newIndex) noexcept
     {
-        if constexpr (isTriviallyCopyable)
+        if constexpr (isTriviallyRelocatable)
         {
             char tempCopy[sizeof (ElementType)];
-            memcpy (tempCopy, elements + currentIndex, sizeof (ElementType));
+            memcpy (tempCopy, static_cast<const void*> (elements + currentIndex), sizeof (ElementType));
 
             if (newIndex > currentIndex)
             {
-                memmove (elements + currentIndex,
-                         elements + currentIndex + 1,
+                memmove (static_cast<void*> (elements + currentIndex),
+                         static_cast<const void*> (elements + currentIndex + 1),
                          (size_t) (newIndex - currentIndex) * sizeof (ElementType));
             }
             else
             {
-                memmove (elements + newIndex + 1,
-                         elements + newIndex,
+                memmove (static_cast<void*> (elements + newIndex + 1),
+                         static_cast<const void*> (elements + newIndex),
                          (size_t) (currentIndex - newIndex) * sizeof (ElementType));
             }
 
-            memcpy (elements + newIndex, tempCopy, sizeof (ElementType));
+            memcpy (static_cast<void*> (elements + newIndex), tempCopy, sizeof (ElementType));
         }
         else
         {
@@ -0,0 +1,682 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)) && ! defined (JUCE_FLAT_HASH_MAP_USE_SSE2)
+ #define JUCE_FLAT_HASH_MAP_USE_SSE2 1
+ #include <emmintrin.h>
+#endif
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Generates well-distributed hash values for use with FlatHashMap and FlatHashSet.
+
+    This has overloads for integers, enums, pointers, String and Identifier. Identifiers
+    are hashed by the address of their pooled string, so they're very cheap to hash.
+
+    To use other key types, supply a class with a similar function call operator that
+    returns a size_t.
+
+    @see FlatHashMap, FlatHashSet
+
+    @tags{Core}
+*/
+struct FlatHashFunctions
+{
+    /** Spreads the bits of a hash value, using the finaliser from MurmurHash3. */
+    static size_t mix (uint64 h) noexcept
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return (size_t) h;
+    }
+
+    template <typename Type>
+    std::enable_if_t<std::is_integral_v<Type> || std::is_enum_v<Type>, size_t>
+        operator() (Type key) const noexcept                        { return mix ((uint64) key); }
+
+    template <typename Type>
+    size_t operator() (Type* key) const noexcept                    { return mix ((uint64) (pointer_sized_uint) key); }
+
+    size_t operator() (const String& key) const noexcept            { return mix ((uint64) (uint32) key.hashCode()); }
+    size_t operator() (const Identifier& key) const noexcept        { return mix ((uint64) (pointer_sized_uint) key.getCharPointer().getAddress()); }
+};
+
+#ifndef DOXYGEN
+namespace detail
+{
+    /*  A group of control bytes, which are tested in parallel when probing.
+
+        Each slot in the table has a control byte: full slots hold the low 7 bits of
+        their key's hash, and empty or deleted slots have the top bit set.
+    */
+    struct FlatHashControlGroup
+    {
+        static constexpr size_t width = 16;
+        static constexpr int8 empty = -128;
+        static constexpr int8 deleted = -2;
+
+        explicit FlatHashControlGroup (const int8* controlBytes) noexcept
+           #if JUCE_FLAT_HASH_MAP_USE_SSE2
+            : bytes (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (controlBytes)))
+           #else
+            : bytes (controlBytes)
+           #endif
+        {}
+
+       #if JUCE_FLAT_HASH_MAP_USE_SSE2
+        uint32 match (int8 hashBits) const noexcept     { return (uint32) _mm_movemask_epi8 (_mm_cmpeq_epi8 (bytes, _mm_set1_epi8 (hashBits))); }
+        uint32 matchEmpty() const noexcept              { return match (empty); }
+        uint32 matchEmptyOrDeleted() const noexcept     { return (uint32) _mm_movemask_epi8 (_mm_cmpgt_epi8 (_mm_set1_epi8 (-1), bytes)); }
+       #else
+        uint32 match (int8 hashBits) const noexcept     { return matchIf ([hashBits] (int8 b) { return b == hashBits; }); }
+        uint32 matchEmpty() const noexcept              { return match (empty); }
+        uint32 matchEmptyOrDeleted() const noexcept     { return matchIf ([] (int8 b) { return b < -1; }); }
+       #endif
+
+        static int getLowestSetBit (uint32 mask) noexcept
+        {
+            jassert (mask != 0);
+
+           #if JUCE_MSVC
+            unsigned long index;
+            _BitScanForward (&index, mask);
+            return (int) index;
+           #else
+            return __builtin_ctz (mask);
+           #endif
+        }
+
+    private:
+       #if JUCE_FLAT_HASH_MAP_USE_SSE2
+        __m128i bytes;
+       #else
+        template <typename Predicate>
+        uint32 matchIf (Predicate&& predicate) const noexcept
+        {
+            uint32 result = 0;
+
+            for (size_t i = 0; i < width; ++i)
+                if (predicate (bytes[i]))
+                    result |= (uint32) 1 << i;
+
+            return result;
+        }
+
+        const int8* bytes;
+       #endif
+    };
+} // namespace detail
+#endif
+
+//==============================================================================
+/**
+    A hash map that stores its entries in a single flat array, using open addressing.
+
+    Unlike HashMap, which allocates a node for each entry and chains them together,
+    this keeps all the keys and values in one block of memory, with a separate array of
+    control bytes that holds a few bits of each entry's hash. A lookup tests a group of
+    16 control bytes at once (using SSE2 where it's available), so it rarely needs to
+    look at more than one key, and doesn't have to chase pointers.
+
+    Entries are moved around when the table grows, so pointers to values are only valid
+    until the next time something is added. The order of iteration is unspecified.
+
+    This class isn't thread-safe. If you need to share one between threads, you'll
+    need to protect it with a lock.
+
+    @code
+    FlatHashMap<Identifier, int> map;
+    map.set ("foo", 1);
+
+    if (auto* value = map.find ("foo"))
+        DBG (*value);
+
+    for (auto& entry : map)
+        DBG (entry.key.toString() << " = " << entry.value);
+    @endcode
+
+    @tparam KeyType          The type of the keys, which must be copy-constructible and
+                             comparable with operator==.
+    @tparam ValueType        The type of the values.
+    @tparam HashFunctionType A class with a function call operator that returns a size_t
+                             hash for a key. See FlatHashFunctions.
+
+    @see HashMap, FlatHashSet, FlatHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = FlatHashFunctions>
+class FlatHashMap
+{
+    using Group = detail::FlatHashControlGroup;
+
+public:
+    //==============================================================================
+    /** An entry in the map. */
+    struct Entry
+    {
+        const KeyType key;
+        ValueType value;
+    };
+
+    //==============================================================================
+    /** Creates an empty map. This doesn't allocate any memory. */
+    FlatHashMap() = default;
+
+    /** Creates an empty map with space for a number of entries. */
+    explicit FlatHashMap (int numEntriesToReserve, HashFunctionType hashFunctionToUse = {})
+        : hashFunction (std::move (hashFunctionToUse))
+    {
+        reserve (numEntriesToReserve);
+    }
+
+    FlatHashMap (const FlatHashMap& other)
+        : hashFunction (other.hashFunction)
+    {
+        reserve (other.size());
+
+        for (auto& entry : other)
+            new (slots + prepareInsert (hashFunction (entry.key))) Entry { entry.key, entry.value };
+    }
+
+    FlatHashMap (FlatHashMap&& other) noexcept
+    {
+        swapWith (other);
+    }
+
+    FlatHashMap& operator= (const FlatHashMap& other)
+    {
+        if (this != &other)
+        {
+            FlatHashMap copy (other);
+            swapWith (copy);
+        }
+
+        return *this;
+    }
+
+    FlatHashMap& operator= (FlatHashMap&& other) noexcept
+    {
+        FlatHashMap temp (std::move (other));
+        swapWith (temp);
+        return *this;
+    }
+
+    /** Destructor. */
+    ~FlatHashMap()
+    {
+        destroyEntries();
+    }
+
+    //==============================================================================
+    /** Returns the number of entries in the map. */
+    int size() const noexcept                           { return numEntries; }
+
+    /** Returns true if the map is empty. */
+    bool isEmpty() const noexcept                       { return numEntries == 0; }
+
+    /** Returns the number of slots that have been allocated. */
+    int getCapacity() const noexcept                    { return (int) capacity; }
+
+    /** Returns a pointer to the value for a key, or nullptr if the key isn't in the map. */
+    ValueType* find (const KeyType& key) noexcept
+    {
+        const auto index = findIndex (key);
+        return index != notFound ? &slots[index].value : nullptr;
+    }
+
+    /** Returns a pointer to the value for a key, or nullptr if the key isn't in the map. */
+    const ValueType* find (const KeyType& key) const noexcept
+    {
+        const auto index = findIndex (key);
+        return index != notFound ? &slots[index].value : nullptr;
+    }
+
+    /** Returns true if the map contains the given key. */
+    bool contains (const KeyType& key) const noexcept   { return findIndex (key) != notFound; }
+
+    /** Returns a copy of the value for a key, or a default-constructed value if the key
+        isn't in the map.
+    */
+    ValueType operator[] (const KeyType& key) const
+    {
+        if (auto* value = find (key))
+            return *value;
+
+        return ValueType();
+    }
+
+    /** Returns a reference to the value for a key, adding a default-constructed value
+        if the key isn't already in the map.
+    */
+    ValueType& getReference (const KeyType& key)
+    {
+        if (auto* value = find (key))
+            return *value;
+
+        auto* entry = new (slots + prepareInsert (hashFunction (key))) Entry { key, ValueType() };
+        return entry->value;
+    }
+
+    /** Adds or replaces the value for a key.
+        @returns true if the key was added, or false if it was already in the map
+    */
+    bool set (const KeyType& key, ValueType newValue)
+    {
+        const auto hash = hashFunction (key);
+
+        if (auto* value = find (key, hash))
+        {
+            *value = std::move (newValue);
+            return false;
+        }
+
+        new (slots + prepareInsert (hash)) Entry { key, std::move (newValue) };
+        return true;
+    }
+
+    /** Removes a key from the map.
+        @returns true if the key was found and removed
+    */
+    bool remove (const KeyType& key)
+    {
+        const auto index = findIndex (key);
+
+        if (index == notFound)
+            return false;
+
+        removeAt (index);
+        return true;
+    }
+
+    /** Removes all the entries for which a predicate, called with the key and value,
+        returns true.
+        @returns the number of entries that were removed
+    */
+    template <typename Predicate>
+    int removeIf (Predicate&& predicate)
+    {
+        int numRemoved = 0;
+
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            if (control[i] >= 0 && predicate (slots[i].key, slots[i].value))
+            {
+                removeAt (i);
+                ++numRemoved;
+            }
+        }
+
+        return numRemoved;
+    }
+
+    /** Removes all the entries, but keeps the memory that has been allocated. */
+    void clear() noexcept
+    {
+        if (capacity == 0)
+            return;
+
+        for (size_t i = 0; i < capacity; ++i)
+            if (control[i] >= 0)
+                slots[i].~Entry();
+
+        std::fill (control.get(), control.get() + capacity + Group::width, Group::empty);
+        numEntries = 0;
+        numDeleted = 0;
+    }
+
+    /** Makes sure there's enough space for a number of entries to be added without
+        the table needing to grow.
+    */
+    void reserve (int numEntriesNeeded)
+    {
+        if (numEntriesNeeded > 0 && (size_t) numEntriesNeeded > getGrowthLimit (capacity) - numDeleted)
+            rehash (getCapacityFor ((size_t) numEntriesNeeded));
+    }
+
+    /** Swaps the contents of this map with another one. */
+    void swapWith (FlatHashMap& other) noexcept
+    {
+        std::swap (control, other.control);
+        std::swap (slots, other.slots);
+        std::swap (capacity, other.capacity);
+        std::swap (numEntries, other.numEntries);
+        std::swap (numDeleted, other.numDeleted);
+        std::swap (hashFunction, other.hashFunction);
+    }
+
+    //==============================================================================
+    /** Iterates the entries in the map. */
+    template <bool isConst>
+    class IteratorBase
+    {
+    public:
+        using MapType   = std::conditional_t<isConst, const FlatHashMap, FlatHashMap>;
+        using EntryType = std::conditional_t<isConst, const Entry, Entry>;
+
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = EntryType;
+        using pointer           = EntryType*;
+        using reference         = EntryType&;
+        using iterator_category = std::forward_iterator_tag;
+
+        IteratorBase (MapType& m, size_t startIndex) noexcept  : map (&m), index (startIndex)   { skipEmptySlots(); }
+
+        EntryType& operator*() const noexcept       { return map->slots[index]; }
+        EntryType* operator->() const noexcept      { return map->slots + index; }
+
+        IteratorBase& operator++() noexcept         { ++index; skipEmptySlots(); return *this; }
+
+        bool operator== (const IteratorBase& other) const noexcept  { return index == other.index; }
+        bool operator!= (const IteratorBase& other) const noexcept  { return index != other.index; }
+
+    private:
+        void skipEmptySlots() noexcept
+        {
+            while (index < map->capacity && map->control[index] < 0)
+                ++index;
+        }
+
+        MapType* map;
+        size_t index;
+    };
+
+    using Iterator      = IteratorBase<false>;
+    using ConstIterator = IteratorBase<true>;
+
+    Iterator begin() noexcept               { return { *this, 0 }; }
+    Iterator end() noexcept                 { return { *this, capacity }; }
+    ConstIterator begin() const noexcept    { return { *this, 0 }; }
+    ConstIterator end() const noexcept      { return { *this, capacity }; }
+
+private:
+    //==============================================================================
+    static constexpr size_t notFound = ~(size_t) 0;
+    static constexpr size_t minCapacity = Group::width;
+
+    HeapBlock<int8> control;
+    HeapBlock<Entry> slots;
+    size_t capacity = 0, numDeleted = 0;
+    int numEntries = 0;
+    HashFunctionType hashFunction;
+
+    static int8 getControlBits (size_t hash) noexcept       { return (int8) (hash & 0x7f); }
+
+    // Tables are never allowed to get more than 7/8 full, so there's always an empty slot to stop a probe
+    static size_t getGrowthLimit (size_t numSlots) noexcept  { return numSlots - numSlots / 8; }
+
+    static size_t getCapacityFor (size_t numEntriesNeeded) noexcept
+    {
+        auto newCapacity = minCapacity;
+
+        while (getGrowthLimit (newCapacity) < numEntriesNeeded)
+            newCapacity *= 2;
+
+        return newCapacity;
+    }
+
+    ValueType* find (const KeyType& key, size_t hash) noexcept
+    {
+        const auto index = findIndex (key, hash);
+        return index != notFound ? &slots[index].value : nullptr;
+    }
+
+    size_t findIndex (const KeyType& key) const noexcept
+    {
+        return capacity != 0 ? findIndex (key, hashFunction (key)) : notFound;
+    }
+
+    // Probing moves through the table in triangular steps of whole groups, which
+    // visits every group-sized window once when the capacity is a power of two
+    size_t findIndex (const KeyType& key, size_t hash) const noexcept
+    {
+        if (capacity == 0)
+            return notFound;
+
+        const auto mask = capacity - 1;
+        const auto controlBits = getControlBits (hash);
+        auto position = (hash >> 7) & mask;
+
+        for (size_t step = Group::width;; step += Group::width)
+        {
+            const Group group (control + position);
+
+            for (auto bits = group.match (controlBits); bits != 0; bits &= bits - 1)
+            {
+                const auto index = (position + (size_t) Group::getLowestSetBit (bits)) & mask;
+
+                if (slots[index].key == key)
+                    return index;
+            }
+
+            if (group.matchEmpty() != 0)
+                return notFound;
+
+            position = (position + step) & mask;
+        }
+    }
+
+    size_t findInsertIndex (size_t hash) const noexcept
+    {
+        const auto mask = capacity - 1;
+        auto position = (hash >> 7) & mask;
+
+        for (size_t step = Group::width;; step += Group::width)
+        {
+            const auto bits = Group (control + position).matchEmptyOrDeleted();
+
+            if (bits != 0)
+                return (position + (size_t) Group::getLowestSetBit (bits)) & mask;
+
+            position = (position + step) & mask;
+        }
+    }
+
+    void setControl (size_t index, int8 value) noexcept
+    {
+        control[index] = value;
+
+        // The first group of control bytes is mirrored after the end of the table, so that
+        // a group can be loaded from any position without wrapping around
+        if (index < Group::width)
+            control[capacity + index] = value;
+    }
+
+    // Finds a free slot for a key that isn't in the map, growing the table if needed.
+    // The caller must construct an Entry in the slot that is returned.
+    size_t prepareInsert (size_t hash)
+    {
+        if ((size_t) numEntries + numDeleted + 1 > getGrowthLimit (capacity))
+        {
+            // If lots of the used slots are just deleted entries, rehashing at the same size will do
+            if (capacity != 0 && (size_t) numEntries + 1 <= getGrowthLimit (capacity) / 2)
+                rehash (capacity);
+            else
+                rehash (getCapacityFor ((size_t) numEntries + 1 + (size_t) numEntries / 2));
+        }
+
+        const auto index = findInsertIndex (hash);
+
+        if (control[index] == Group::deleted)
+            --numDeleted;
+
+        setControl (index, getControlBits (hash));
+        ++numEntries;
+        return index;
+    }
+
+    void removeAt (size_t index)
+    {
+        slots[index].~Entry();
+        setControl (index, Group::deleted);
+        --numEntries;
+        ++numDeleted;
+    }
+
+    void rehash (size_t newCapacity)
+    {
+        jassert (isPowerOfTwo (newCapacity) && newCapacity >= minCapacity);
+
+        auto oldControl = std::move (control);
+        auto oldSlots = std::move (slots);
+        const auto oldCapacity = std::exchange (capacity, newCapacity);
+
+        control.malloc (newCapacity + Group::width);
+        slots.malloc (newCapacity);
+        std::fill (control.get(), control.get() + newCapacity + Group::width, Group::empty);
+        numEntries = 0;
+        numDeleted = 0;
+
+        for (size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldControl[i] >= 0)
+            {
+                auto& entry = oldSlots[i];
+                new (slots + prepareInsert (hashFunction (entry.key))) Entry { entry.key, std::move (entry.value) };
+                entry.~Entry();
+            }
+        }
+    }
+
+    void destroyEntries() noexcept
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            if (control[i] >= 0)
+                slots[i].~Entry();
+    }
+
+    JUCE_LEAK_DETECTOR (FlatHashMap)
+};
+
+//==============================================================================
+/**
+    A set of unique keys, stored in a single flat array using open addressing.
+
+    This works in the same way as FlatHashMap - see that class for more details.
+
+    @see FlatHashMap, SortedSet
+
+    @tags{Core}
+*/
+template <typename KeyType, class HashFunctionType = FlatHashFunctions>
+class FlatHashSet
+{
+    struct Empty {};
+    using MapType = FlatHashMap<KeyType, Empty, HashFunctionType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty set. This doesn't allocate any memory. */
+    FlatHashSet() = default;
+
+    /** Creates an empty set with space for a number of keys. */
+    explicit FlatHashSet (int numKeysToReserve)  : map (numKeysToReserve) {}
+
+    /** Returns the number of keys in the set. */
+    int size() const noexcept                           { return map.size(); }
+
+    /** Returns true if the set is empty. */
+    bool isEmpty() const noexcept                       { return map.isEmpty(); }
+
+    /** Returns true if the set contains the given key. */
+    bool contains (const KeyType& key) const noexcept   { return map.contains (key); }
+
+    /** Adds a key to the set.
+        @returns true if the key was added, or false if it was already in the set
+    */
+    bool add (const KeyType& key)                       { return map.set (key, {}); }
+
+    /** Removes a key from the set.
+        @returns true if the key was found and removed
+    */
+    bool remove (const KeyType& key)                    { return map.remove (key); }
+
+    /** Removes all the keys for which a predicate returns true.
+        @returns the number of keys that were removed
+    */
+    template <typename Predicate>
+    int removeIf (Predicate&& predicate)                { return map.removeIf ([&] (const KeyType& k, Empty) { return predicate (k); }); }
+
+    /** Removes all the keys, but keeps the memory that has been allocated. */
+    void clear() noexcept                               { map.clear(); }
+
+    /** Makes sure there's enough space for a number of keys to be added without
+        the table needing to grow.
+    */
+    void reserve (int numKeysNeeded)                    { map.reserve (numKeysNeeded); }
+
+    /** Swaps the contents of this set with another one. */
+    void swapWith (FlatHashSet& other) noexcept         { map.swapWith (other.map); }
+
+    //==============================================================================
+    /** Iterates the keys in the set. */
+    class Iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = const KeyType;
+        using pointer           = const KeyType*;
+        using reference         = const KeyType&;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit Iterator (typename MapType::ConstIterator i) noexcept  : iter (i) {}
+
+        const KeyType& operator*() const noexcept       { return iter->key; }
+        const KeyType* operator->() const noexcept      { return &iter->key; }
+
+        Iterator& operator++() noexcept                 { ++iter; return *this; }
+
+        bool operator== (const Iterator& other) const noexcept  { return iter == other.iter; }
+        bool operator!= (const Iterator& other) const noexcept  { return iter != other.iter; }
+
+    private:
+        typename MapType::ConstIterator iter;
+    };
+
+    Iterator begin() const noexcept     { return Iterator (map.begin()); }
+    Iterator end() const noexcept       { return Iterator (map.end()); }
+
+private:
+    MapType map;
+};
+
+} // namespace juce
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FlatHashMapTests final : public UnitTest
+{
+public:
+    FlatHashMapTests()
+        : UnitTest ("FlatHashMap", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Random operations match std::map");
+        {
+            Random r (0x5eed);
+            FlatHashMap<int, int> map;
+            std::map<int, int> groundTruth;
+
+            for (int i = 0; i < 50000; ++i)
+            {
+                const auto key = r.nextInt (2000);
+                const auto operation = r.nextInt (4);
+
+                if (operation == 0)
+                {
+                    expect (map.remove (key) == (groundTruth.erase (key) != 0));
+                }
+                else if (operation == 1)
+                {
+                    auto* value = map.find (key);
+                    const auto it = groundTruth.find (key);
+                    expect ((value != nullptr) == (it != groundTruth.end()));
+
+                    if (value != nullptr && it != groundTruth.end())
+                        expectEquals (*value, it->second);
+                }
+                else
+                {
+                    const auto value = r.nextInt();
+                    expect (map.set (key, value) == (groundTruth.count (key) == 0));
+                    groundTruth[key] = value;
+                }
+
+                expectEquals (map.size(), (int) groundTruth.size());
+            }
+
+            int numVisited = 0;
+
+            for (auto& entry : map)
+            {
+                expectEquals (entry.value, groundTruth[entry.key]);
+                ++numVisited;
+            }
+
+            expectEquals (numVisited, (int) groundTruth.size());
+        }
+
+        beginTest ("String and Identifier keys");
+        {
+            FlatHashMap<String, int> strings;
+            FlatHashMap<Identifier, String> identifiers;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                strings.set ("key" + String (i), i);
+                identifiers.set (Identifier ("id" + String (i)), String (i));
+            }
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                expectEquals (strings["key" + String (i)], i);
+                expectEquals (identifiers[Identifier ("id" + String (i))], String (i));
+            }
+
+            expect (! strings.contains ("key1000"));
+            expect (! identifiers.contains ("id1000"));
+        }
+
+        beginTest ("Copying, moving and clearing");
+        {
+            FlatHashMap<int, String> map;
+
+            for (int i = 0; i < 100; ++i)
+                map.getReference (i) = String (i);
+
+            auto copy = map;
+            map.clear();
+            expect (map.isEmpty());
+            expect (map.getCapacity() > 0);
+            expectEquals (copy.size(), 100);
+            expectEquals (copy[42], String ("42"));
+
+            auto moved = std::move (copy);
+            expectEquals (moved.size(), 100);
+            expectEquals (moved.removeIf ([] (int key, const String&) { return key % 2 == 0; }), 50);
+            expectEquals (moved.size(), 50);
+            expect (! moved.contains (42));
+            expect (moved.contains (43));
+        }
+
+        beginTest ("Deleted slots are reused");
+        {
+            FlatHashMap<int, int> map;
+            map.reserve (100);
+            const auto capacity = map.getCapacity();
+
+            for (int i = 0; i < 100000; ++i)
+            {
+                map.set (i, i);
+                map.remove (i - 50);
+            }
+
+            expectEquals (map.size(), 50);
+            expectEquals (map.getCapacity(), capacity);
+        }
+
+        beginTest ("FlatHashSet");
+        {
+            FlatHashSet<Identifier> set;
+            expect (set.add ("a"));
+            expect (set.add ("b"));
+            expect (! set.add ("a"));
+            expectEquals (set.size(), 2);
+            expect (set.contains ("b"));
+            expect (set.remove ("b"));
+            expect (! set.contains ("b"));
+
+            int numKeys = 0;
+
+            for (auto& key : set)
+            {
+                expect (key == Identifier ("a"));
+                ++numKeys;
+            }
+
+            expectEquals (numKeys, 1);
+        }
+
+        beginTest ("NamedValueSet lookups with an index");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 100; ++i)
+                set.set ("value" + String (i), i);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                expectEquals (set.indexOf ("value" + String (i)), i);
+                expectEquals ((int) set["value" + String (i)], i);
+            }
+
+            expect (set.remove ("value99"));
+            expect (set.remove ("value10"));
+            expect (! set.contains ("value10"));
+            expectEquals (set.indexOf ("value11"), 10);
+            expectEquals ((int) set["value98"], 98);
+
+            auto copy = set;
+
+            while (copy.size() > 1)
+                copy.remove (copy.getName (0));
+
+            expectEquals (copy.indexOf ("value98"), 0);
+            expect (copy == NamedValueSet { { "value98", 98 } });
+            expectEquals (set.size(), 98);
+        }
+    }
+};
+
+static FlatHashMapTests flatHashMapTests;
+
+} // namespace juce
@@ -663,4 +663,327 @@ private:
     JUCE_DECLARE_NON_COPYABLE (LightweightListenerList)
 };
 
+//==============================================================================
+/**
+    A version of the ListenerList that stores a few listeners inside the object itself, and
+    doesn't need to allocate anything to keep track of the calls in progress.
+
+    This gives the same guarantees as a ListenerList: it is safe to add listeners, remove
+    listeners, clear the listeners, and even delete the InlineListenerList itself during any
+    listener callback. However, no memory is allocated until more than numInlineListeners
+    listeners have been added, and calling the listeners doesn't allocate or lock anything.
+
+    This makes it a good choice for objects that are created in large numbers and usually only
+    have one or two listeners, and for lists that are called very frequently.
+
+    Like ListenerList, it is NOT safe to make concurrent calls to the listeners from different
+    threads.
+
+    @see ListenerList, LightweightListenerList
+
+    @tags{Core}
+*/
+template <typename ListenerClass, int numInlineListeners = 2>
+class InlineListenerList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    InlineListenerList() = default;
+
+    /** Destructor. */
+    ~InlineListenerList()
+    {
+        clear();
+
+        // Any calls that are in progress will stop without touching this list again
+        for (auto* it = iterators; it != nullptr; it = it->next)
+            it->list = nullptr;
+    }
+
+    //==============================================================================
+    /** Adds a listener to the list.
+        A listener can only be added once, so if the listener is already in the list, this method
+        has no effect.
+
+        If a Listener is added during a callback, it is guaranteed not to be called in the same
+        iteration.
+
+        @see remove
+    */
+    void add (ListenerClass* listenerToAdd)
+    {
+        if (listenerToAdd == nullptr)
+        {
+            jassertfalse; // Listeners can't be null pointers!
+            return;
+        }
+
+        if (contains (listenerToAdd))
+            return;
+
+        if (numListeners == capacity)
+        {
+            capacity *= 2;
+            auto newStorage = std::make_unique<ListenerClass*[]> ((size_t) capacity);
+            std::copy (begin(), end(), newStorage.get());
+            heapStorage = std::move (newStorage);
+        }
+
+        getData()[numListeners++] = listenerToAdd;
+    }
+
+    /** Removes a listener from the list.
+        If the listener wasn't in the list, this has no effect.
+
+        If a Listener is removed during a callback, it is guaranteed not to be called if it hasn't
+        already been called.
+    */
+    void remove (ListenerClass* listenerToRemove)
+    {
+        jassert (listenerToRemove != nullptr); // Listeners can't be null pointers!
+
+        auto* data = getData();
+        const auto found = std::find (data, data + numListeners, listenerToRemove);
+
+        if (found == data + numListeners)
+            return;
+
+        const auto index = (int) std::distance (data, found);
+        std::copy (found + 1, data + numListeners, found);
+        --numListeners;
+
+        for (auto* it = iterators; it != nullptr; it = it->next)
+        {
+            if (index < it->end)
+                --it->end;
+
+            if (index <= it->index)
+                --it->index;
+        }
+    }
+
+    /** Adds a listener that will be automatically removed again when the Guard is destroyed.
+
+        Be very careful to ensure that the ErasedScopeGuard is destroyed or released before the
+        list is destroyed, otherwise the ErasedScopeGuard may attempt to dereference a dangling
+        pointer when it is destroyed, which will result in a crash.
+    */
+    [[nodiscard]] ErasedScopeGuard addScoped (ListenerClass& listenerToAdd)
+    {
+        add (&listenerToAdd);
+        return ErasedScopeGuard { [this, &listenerToAdd] { remove (&listenerToAdd); } };
+    }
+
+    /** Returns the number of registered listeners. */
+    [[nodiscard]] int size() const noexcept                                { return numListeners; }
+
+    /** Returns true if no listeners are registered, false otherwise. */
+    [[nodiscard]] bool isEmpty() const noexcept                            { return numListeners == 0; }
+
+    /** Clears the list.
+
+        If the list is cleared during a callback, it is guaranteed that no more listeners will be
+        called.
+    */
+    void clear()
+    {
+        numListeners = 0;
+
+        for (auto* it = iterators; it != nullptr; it = it->next)
+            it->end = 0;
+    }
+
+    /** Returns true if the specified listener has been added to the list. */
+    [[nodiscard]] bool contains (ListenerClass* listener) const noexcept
+    {
+        return std::find (begin(), end(), listener) != end();
+    }
+
+    /** Returns a pointer to the first listener.
+
+        The list mustn't be changed while the listeners are being iterated this way, so it's
+        usually better to use one of the call() methods.
+    */
+    ListenerClass* const* begin() const noexcept                           { return getData(); }
+
+    /** Returns a pointer to the position after the last listener. @see begin */
+    ListenerClass* const* end() const noexcept                             { return getData() + numListeners; }
+
+    //==============================================================================
+    /** Calls an invokable object for each listener in the list. */
+    template <typename Callback>
+    void call (Callback&& callback)
+    {
+        callCheckedExcluding (nullptr,
+                              DummyBailOutChecker{},
+                              std::forward<Callback> (callback));
+    }
+
+    /** Calls an invokable object for each listener in the list, except for the listener specified
+        by listenerToExclude.
+    */
+    template <typename Callback>
+    void callExcluding (ListenerClass* listenerToExclude, Callback&& callback)
+    {
+        callCheckedExcluding (listenerToExclude,
+                              DummyBailOutChecker{},
+                              std::forward<Callback> (callback));
+    }
+
+    /** Calls an invokable object for each listener in the list, additionally checking the bail-out
+        checker before each call.
+
+        See the ListenerList class description for info about writing a bail-out checker.
+    */
+    template <typename Callback, typename BailOutCheckerType>
+    void callChecked (const BailOutCheckerType& bailOutChecker, Callback&& callback)
+    {
+        callCheckedExcluding (nullptr,
+                              bailOutChecker,
+                              std::forward<Callback> (callback));
+    }
+
+    /** Calls an invokable object for each listener in the list, except for the listener specified
+        by listenerToExclude, additionally checking the bail-out checker before each call.
+
+        See the ListenerList class description for info about writing a bail-out checker.
+    */
+    template <typename Callback, typename BailOutCheckerType>
+    void callCheckedExcluding (ListenerClass* listenerToExclude,
+                               const BailOutCheckerType& bailOutChecker,
+                               Callback&& callback)
+    {
+        if (numListeners == 0)
+            return;
+
+       #if JUCE_ASSERTIONS_ENABLED_OR_LOGGED
+        // If you hit this assertion it means you're trying to call the listeners from multiple
+        // threads concurrently. If you need to do this use a ThreadSafeListenerList instead.
+        jassert (iterators == nullptr || iterators->threadId == std::this_thread::get_id());
+       #endif
+
+        // The iterators for the calls in progress form a stack, which remove() and clear()
+        // update when the list changes during a callback
+        Iterator it;
+        it.list = this;
+        it.end = numListeners;
+        it.next = iterators;
+        iterators = &it;
+
+        const ScopeGuard scope { [&it]
+        {
+            if (it.list != nullptr)
+                it.list->iterators = it.next;
+        } };
+
+        for (; it.index < it.end; ++it.index)
+        {
+            if (bailOutChecker.shouldBailOut())
+                return;
+
+            auto* listener = getData()[it.index];
+
+            if (listener == listenerToExclude)
+                continue;
+
+            callback (*listener);
+        }
+    }
+
+    //==============================================================================
+    /** Calls a specific listener method for each listener in the list. */
+    template <typename... MethodArgs, typename... Args>
+    void call (void (ListenerClass::*callbackFunction) (MethodArgs...), Args&&... args)
+    {
+        callCheckedExcluding (nullptr,
+                              DummyBailOutChecker{},
+                              callbackFunction,
+                              std::forward<Args> (args)...);
+    }
+
+    /** Calls a specific listener method for each listener in the list, except for the listener
+        specified by listenerToExclude.
+    */
+    template <typename... MethodArgs, typename... Args>
+    void callExcluding (ListenerClass* listenerToExclude,
+                        void (ListenerClass::*callbackFunction) (MethodArgs...),
+                        Args&&... args)
+    {
+        callCheckedExcluding (listenerToExclude,
+                              DummyBailOutChecker{},
+                              callbackFunction,
+                              std::forward<Args> (args)...);
+    }
+
+    /** Calls a specific listener method for each listener in the list, additionally checking the
+        bail-out checker before each call.
+
+        See the ListenerList class description for info about writing a bail-out checker.
+    */
+    template <typename BailOutCheckerType, typename... MethodArgs, typename... Args>
+    void callChecked (const BailOutCheckerType& bailOutChecker,
+                      void (ListenerClass::*callbackFunction) (MethodArgs...),
+                      Args&&... args)
+    {
+        callCheckedExcluding (nullptr,
+                              bailOutChecker,
+                              callbackFunction,
+                              std::forward<Args> (args)...);
+    }
+
+    /** Calls a specific listener method for each listener in the list, except for the listener
+        specified by listenerToExclude, additionally checking the bail-out checker before each call.
+
+        See the ListenerList class description for info about writing a bail-out checker.
+    */
+    template <typename BailOutCheckerType, typename... MethodArgs, typename... Args>
+    void callCheckedExcluding (ListenerClass* listenerToExclude,
+                               const BailOutCheckerType& bailOutChecker,
+                               void (ListenerClass::*callbackFunction) (MethodArgs...),
+                               Args&&... args)
+    {
+        callCheckedExcluding (listenerToExclude, bailOutChecker, [&] (ListenerClass& l)
+        {
+            (l.*callbackFunction) (args...);
+        });
+    }
+
+    //==============================================================================
+    /** A dummy bail-out checker that always returns false.
+        See the ListenerList class description for info about writing a bail-out checker.
+    */
+    using DummyBailOutChecker = typename ListenerList<ListenerClass>::DummyBailOutChecker;
+
+    //==============================================================================
+    using ThisType      = InlineListenerList<ListenerClass, numInlineListeners>;
+    using ListenerType  = ListenerClass;
+
+private:
+    //==============================================================================
+    static_assert (numInlineListeners > 0, "The list needs space for at least one listener");
+
+    struct Iterator
+    {
+        InlineListenerList* list = nullptr;
+        int index = 0, end = 0;
+        Iterator* next = nullptr;
+
+       #if JUCE_ASSERTIONS_ENABLED_OR_LOGGED
+        std::thread::id threadId = std::this_thread::get_id();
+       #endif
+    };
+
+    ListenerClass** getData() noexcept               { return heapStorage != nullptr ? heapStorage.get() : inlineStorage; }
+    ListenerClass* const* getData() const noexcept   { return heapStorage != nullptr ? heapStorage.get() : inlineStorage; }
+
+    ListenerClass* inlineStorage[(size_t) numInlineListeners] {};
+    std::unique_ptr<ListenerClass*[]> heapStorage;
+    int numListeners = 0, capacity = numInlineListeners;
+    Iterator* iterators = nullptr;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE (InlineListenerList)
+};
+
 } // namespace juce
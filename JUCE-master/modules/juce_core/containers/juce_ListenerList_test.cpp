@@ -35,9 +35,13 @@
 namespace juce
 {
 
+template <typename Traits>
 class ListenerListTests final : public UnitTest
 {
 public:
+    template <typename Listener>
+    using ListType = typename Traits::template ListType<Listener>;
+
     //==============================================================================
     class TestListener
     {
@@ -96,12 +100,13 @@ public:
 
     private:
         std::vector<std::unique_ptr<TestListener>> listeners;
-        ListenerList<TestListener> listenerList;
+        ListType<TestListener> listenerList;
         int callLevel = 0;
     };
 
     //==============================================================================
-    ListenerListTests() : UnitTest ("ListenerList", UnitTestCategories::containers) {}
+    explicit ListenerListTests (const String& testName)
+        : UnitTest (testName, UnitTestCategories::containers) {}
 
     void runTest() final
     {
@@ -319,7 +324,7 @@ public:
                 void notify() { onCallback(); }
             };
 
-            auto listeners = std::make_unique<juce::ListenerList<Listener>>();
+            auto listeners = std::make_unique<ListType<Listener>>();
 
             const auto callback = [&]
             {
@@ -346,7 +351,7 @@ public:
                 void notify() { onCallback(); }
             };
 
-            ListenerList<Listener> listeners;
+            ListType<Listener> listeners;
 
             bool listener1Called = false;
             bool listener2Called = false;
@@ -374,43 +379,16 @@ public:
             expect (! listener3Called);
         }
 
-        beginTest ("Using a critical section");
+        if (Traits::supportsCriticalSections)
         {
+            beginTest ("Using a critical section");
+
             struct Listener
             {
                 std::function<void()> onCallback;
                 void notify() { onCallback(); }
             };
 
-            struct TestCriticalSection
-            {
-                TestCriticalSection()  noexcept { isAlive() = true; }
-                ~TestCriticalSection() noexcept { isAlive() = false; }
-
-                static void enter() noexcept { numOutOfScopeCalls() += isAlive() ? 0 : 1; }
-                static void exit()  noexcept { numOutOfScopeCalls() += isAlive() ? 0 : 1; }
-
-                static bool tryEnter() noexcept
-                {
-                    numOutOfScopeCalls() += isAlive() ? 0 : 1;
-                    return true;
-                }
-
-                using ScopedLockType = GenericScopedLock<TestCriticalSection>;
-
-                static bool& isAlive() noexcept
-                {
-                    static bool inScope = false;
-                    return inScope;
-                }
-
-                static int& numOutOfScopeCalls() noexcept
-                {
-                    static int numOutOfScopeCalls = 0;
-                    return numOutOfScopeCalls;
-                }
-            };
-
             auto listeners = std::make_unique<juce::ListenerList<Listener, Array<Listener*, TestCriticalSection>>>();
 
             const auto callback = [&]{ listeners.reset(); };
@@ -428,7 +406,7 @@ public:
         {
             struct Listener{};
 
-            ListenerList<Listener> listeners;
+            ListType<Listener> listeners;
             expect (listeners.size() == 0);
 
             Listener listener1;
@@ -454,11 +432,40 @@ public:
             expect (listeners.size() == 2);
         }
 
+        beginTest ("Adding many listeners during a callback");
+        {
+            struct Listener{};
+
+            ListType<Listener> listeners;
+            std::vector<Listener> added (10);
+            Listener first;
+            listeners.add (&first);
+
+            int numberOfCallbacks = 0;
+
+            listeners.call ([&] (auto&)
+            {
+                for (auto& l : added)
+                    listeners.add (&l);
+
+                ++numberOfCallbacks;
+            });
+
+            expectEquals (numberOfCallbacks, 1);
+            expectEquals (listeners.size(), 11);
+
+            listeners.call ([&] (auto&) { ++numberOfCallbacks; });
+            expectEquals (numberOfCallbacks, 12);
+
+            for (auto& l : added)
+                expect (listeners.contains (&l));
+        }
+
         beginTest ("Add and remove a nested listener");
         {
             struct Listener{};
 
-            ListenerList<Listener> listeners;
+            ListType<Listener> listeners;
             expect (listeners.size() == 0);
 
             Listener listener1;
@@ -488,6 +495,35 @@ public:
     }
 
 private:
+    struct TestCriticalSection
+    {
+        TestCriticalSection()  noexcept { isAlive() = true; }
+        ~TestCriticalSection() noexcept { isAlive() = false; }
+
+        static void enter() noexcept { numOutOfScopeCalls() += isAlive() ? 0 : 1; }
+        static void exit()  noexcept { numOutOfScopeCalls() += isAlive() ? 0 : 1; }
+
+        static bool tryEnter() noexcept
+        {
+            numOutOfScopeCalls() += isAlive() ? 0 : 1;
+            return true;
+        }
+
+        using ScopedLockType = GenericScopedLock<TestCriticalSection>;
+
+        static bool& isAlive() noexcept
+        {
+            static bool inScope = false;
+            return inScope;
+        }
+
+        static int& numOutOfScopeCalls() noexcept
+        {
+            static int numOutOfScopeCalls = 0;
+            return numOutOfScopeCalls;
+        }
+    };
+
     static std::set<int> chooseUnique (Random& random, int max, int numChosen)
     {
         std::set<int> result;
@@ -755,7 +791,24 @@ public:
     }
 };
 
-static ListenerListTests listenerListTests;
+struct ListenerListTestTraits
+{
+    template <typename Listener>
+    using ListType = ListenerList<Listener>;
+
+    static constexpr bool supportsCriticalSections = true;
+};
+
+struct InlineListenerListTestTraits
+{
+    template <typename Listener>
+    using ListType = InlineListenerList<Listener>;
+
+    static constexpr bool supportsCriticalSections = false;
+};
+
+static ListenerListTests<ListenerListTestTraits> listenerListTests { "ListenerList" };
+static ListenerListTests<InlineListenerListTestTraits> inlineListenerListTests { "InlineListenerList" };
 static LightweightListenerListTests lightweightListenerListTests;
 
 } // namespace juce
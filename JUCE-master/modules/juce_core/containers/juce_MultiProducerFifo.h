@@ -0,0 +1,462 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/** Chooses whether a MultiProducerAbstractFifo or MultiProducerFifo may be read
+    from several threads at once.
+
+    A FIFO with a single reader is a little cheaper to read from, because the reader
+    doesn't need to compete with any other threads for the read position.
+
+    @see MultiProducerAbstractFifo, MultiProducerFifo
+
+    @tags{Core}
+*/
+enum class FifoReaders
+{
+    single,     /**< Only one thread at a time may read from the FIFO. */
+    multiple    /**< Any number of threads may read from the FIFO at the same time. */
+};
+
+//==============================================================================
+/**
+    Encapsulates the logic required to implement a bounded lock-free FIFO that can
+    be written by any number of threads at once.
+
+    Like AbstractFifo, this class doesn't hold any data itself. It keeps track of
+    which slots in your own buffer are free, being written, ready, or being read.
+    Each slot has a sequence number that says which of these it is, so writers only
+    compete with each other for the write position, and readers (if there is more
+    than one) for the read position. Nobody ever waits for a lock.
+
+    write() and read() claim a run of consecutive slots and return an object that
+    describes them. The slots are handed over to the other side when that object
+    goes out of scope, so you should fill or empty them before then:
+
+    @code
+    struct MyFifo
+    {
+        void addToFifo (const int* someData, int numItems)
+        {
+            const auto scope = fifo.write (numItems);
+            auto* source = someData;
+            scope.forEach ([&] (int index) { myBuffer[index] = *source++; });
+        }
+
+        int readFromFifo (int* someData, int numItems)
+        {
+            const auto scope = fifo.read (numItems);
+            auto* dest = someData;
+            scope.forEach ([&] (int index) { *dest++ = myBuffer[index]; });
+            return scope.blockSize1 + scope.blockSize2;
+        }
+
+        MultiProducerAbstractFifo<> fifo { 1024 };
+        int myBuffer[1024];
+    };
+    @endcode
+
+    As with any FIFO like this, a writer that has claimed a slot but not finished
+    writing it holds up the readers at that slot, even if later slots are ready.
+    Items written by a single thread are always read in the order they were written.
+
+    The total size is always a power of two, so make sure that you use
+    getTotalSize() to allocate your buffer.
+
+    @see MultiProducerFifo, AbstractFifo
+
+    @tags{Core}
+*/
+template <FifoReaders readers = FifoReaders::multiple>
+class MultiProducerAbstractFifo
+{
+public:
+    //==============================================================================
+    /** Creates a FIFO to manage a buffer with at least the specified capacity.
+        The capacity is rounded up to the next power of two.
+    */
+    explicit MultiProducerAbstractFifo (int minimumCapacity)
+        : capacity ((size_t) nextPowerOfTwo (jmax (1, minimumCapacity))),
+          sequences (new std::atomic<size_t>[capacity])
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            sequences[i].store (i, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    /** Returns the total size of the buffer being managed. All of it can be used. */
+    int getTotalSize() const noexcept   { return (int) capacity; }
+
+    /** Returns the number of items that have been claimed by writers but not yet by
+        readers. Other threads may be changing this, so treat it as a rough guide.
+    */
+    int getNumReady() const noexcept
+    {
+        const auto readPos = readPosition.load (std::memory_order_relaxed);
+        const auto writePos = writePosition.load (std::memory_order_relaxed);
+        return (int) jlimit ((std::ptrdiff_t) 0, (std::ptrdiff_t) capacity, (std::ptrdiff_t) (writePos - readPos));
+    }
+
+    /** Returns the number of slots that writers could currently claim. Other threads
+        may be changing this, so treat it as a rough guide.
+    */
+    int getFreeSpace() const noexcept   { return (int) capacity - getNumReady(); }
+
+    //==============================================================================
+private:
+    enum class ReadOrWrite { read, write };
+
+public:
+    /** Describes a run of slots that has been claimed for reading or writing.
+
+        The run may wrap around the end of the buffer, so it is described by two
+        blocks, in the same way as AbstractFifo::ScopedReadWrite. When this object
+        is destroyed, the slots are handed over to the other side of the FIFO.
+    */
+    template <ReadOrWrite mode>
+    class ScopedReadWrite final
+    {
+    public:
+        /** Creates an empty run, which does nothing when it is destroyed. */
+        ScopedReadWrite() = default;
+
+        ScopedReadWrite (const ScopedReadWrite&) = delete;
+        ScopedReadWrite& operator= (const ScopedReadWrite&) = delete;
+
+        ScopedReadWrite (ScopedReadWrite&& other) noexcept
+        {
+            swap (other);
+        }
+
+        ScopedReadWrite& operator= (ScopedReadWrite&& other) noexcept
+        {
+            ScopedReadWrite { std::move (other) }.swap (*this);
+            return *this;
+        }
+
+        /** Hands the slots over to the other side of the FIFO. */
+        ~ScopedReadWrite() noexcept
+        {
+            if (fifo != nullptr)
+                fifo->finish (mode, position, (size_t) (blockSize1 + blockSize2));
+        }
+
+        /** Calls the passed function with each index in the run, in order. */
+        template <typename FunctionToApply>
+        void forEach (FunctionToApply&& func) const
+        {
+            for (auto i = startIndex1, e = startIndex1 + blockSize1; i != e; ++i)  func (i);
+            for (auto i = startIndex2, e = startIndex2 + blockSize2; i != e; ++i)  func (i);
+        }
+
+        int startIndex1 = 0, blockSize1 = 0, startIndex2 = 0, blockSize2 = 0;
+
+    private:
+        friend class MultiProducerAbstractFifo;
+
+        ScopedReadWrite (MultiProducerAbstractFifo& f, size_t startPosition, size_t num) noexcept
+            : fifo (num > 0 ? &f : nullptr), position (startPosition)
+        {
+            const auto start = (int) (startPosition & (f.capacity - 1));
+            startIndex1 = start;
+            blockSize1 = jmin ((int) num, (int) f.capacity - start);
+            blockSize2 = (int) num - blockSize1;
+        }
+
+        void swap (ScopedReadWrite& other) noexcept
+        {
+            std::swap (fifo, other.fifo);
+            std::swap (position, other.position);
+            std::swap (startIndex1, other.startIndex1);
+            std::swap (blockSize1, other.blockSize1);
+            std::swap (startIndex2, other.startIndex2);
+            std::swap (blockSize2, other.blockSize2);
+        }
+
+        MultiProducerAbstractFifo* fifo = nullptr;
+        size_t position = 0;
+    };
+
+    using ScopedRead  = ScopedReadWrite<ReadOrWrite::read>;
+    using ScopedWrite = ScopedReadWrite<ReadOrWrite::write>;
+
+    /** Claims up to numToWrite consecutive slots for writing.
+
+        This never waits. If the buffer is nearly full, fewer slots than requested
+        may be returned, possibly none. The slots become readable when the returned
+        object goes out of scope.
+
+        This may be called from any number of threads at once.
+    */
+    ScopedWrite write (int numToWrite) noexcept
+    {
+        auto position = writePosition.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            const auto num = countSlotsWithSequence (position, (size_t) jmax (0, numToWrite), 0);
+
+            if (num == 0)
+            {
+                // Either the buffer is full, or another writer got to this slot first
+                if (numToWrite <= 0 || isBehind (sequenceAt (position), position))
+                    return {};
+
+                position = writePosition.load (std::memory_order_relaxed);
+            }
+            else if (writePosition.compare_exchange_weak (position, position + num, std::memory_order_relaxed))
+            {
+                return { *this, position, num };
+            }
+        }
+    }
+
+    /** Claims up to numToRead consecutive slots for reading.
+
+        This never waits. If there aren't enough items ready, fewer slots than
+        requested may be returned, possibly none. The slots can be written again
+        once the returned object goes out of scope.
+
+        If the FIFO was created with FifoReaders::single, only one thread may call
+        this at a time. Otherwise, this may be called from any number of threads.
+    */
+    ScopedRead read (int numToRead) noexcept
+    {
+        auto position = readPosition.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            const auto num = countSlotsWithSequence (position, (size_t) jmax (0, numToRead), 1);
+
+            if constexpr (readers == FifoReaders::single)
+            {
+                readPosition.store (position + num, std::memory_order_relaxed);
+                return { *this, position, num };
+            }
+            else
+            {
+                if (num == 0)
+                {
+                    // Either the buffer is empty, or another reader got to this slot first
+                    if (numToRead <= 0 || isBehind (sequenceAt (position), position + 1))
+                        return {};
+
+                    position = readPosition.load (std::memory_order_relaxed);
+                }
+                else if (readPosition.compare_exchange_weak (position, position + num, std::memory_order_relaxed))
+                {
+                    return { *this, position, num };
+                }
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    size_t sequenceAt (size_t position) const noexcept
+    {
+        return sequences[position & (capacity - 1)].load (std::memory_order_acquire);
+    }
+
+    static bool isBehind (size_t sequence, size_t position) noexcept
+    {
+        return (std::ptrdiff_t) (sequence - position) < 0;
+    }
+
+    // Counts the run of slots from position whose sequence is (position + offset).
+    // For writers, an offset of 0 means that the slot has been read on the previous
+    // pass. For readers, an offset of 1 means that the slot has been written.
+    size_t countSlotsWithSequence (size_t position, size_t maxNum, size_t offset) const noexcept
+    {
+        maxNum = jmin (maxNum, capacity);
+        size_t num = 0;
+
+        while (num < maxNum && sequenceAt (position + num) == position + num + offset)
+            ++num;
+
+        return num;
+    }
+
+    void finish (ReadOrWrite mode, size_t position, size_t num) noexcept
+    {
+        const auto offset = mode == ReadOrWrite::write ? (size_t) 1 : capacity;
+
+        for (auto i = position; i != position + num; ++i)
+            sequences[i & (capacity - 1)].store (i + offset, std::memory_order_release);
+    }
+
+    //==============================================================================
+    const size_t capacity;
+    std::unique_ptr<std::atomic<size_t>[]> sequences;
+
+    // Each position is on its own cache line, so that readers and writers don't slow each other down
+    JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4324)
+    alignas (64) std::atomic<size_t> writePosition { 0 };
+    alignas (64) std::atomic<size_t> readPosition { 0 };
+    JUCE_END_IGNORE_WARNINGS_MSVC
+
+    JUCE_DECLARE_NON_COPYABLE (MultiProducerAbstractFifo)
+};
+
+//==============================================================================
+/**
+    A bounded lock-free FIFO of values that can be written by any number of threads
+    at once, and read by one thread or several, depending on the readers parameter.
+
+    This is useful for sending messages from several worker threads to the audio
+    thread, for example, without needing to guard an AbstractFifo with a lock. None
+    of the functions wait or allocate, although copying or moving the values might.
+
+    ValueType must be default-constructible and move-assignable. Values that are
+    read are moved out of the FIFO, and the moved-from values stay in their slots
+    until they are overwritten.
+
+    @code
+    MultiProducerFifo<Message, FifoReaders::single> messages { 256 };
+
+    // On any thread
+    messages.push (Message { ... });
+
+    // On the audio thread
+    messages.popAll ([&] (Message& m) { handleMessage (m); });
+    @endcode
+
+    @see MultiProducerAbstractFifo, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename ValueType, FifoReaders readers = FifoReaders::multiple>
+class MultiProducerFifo
+{
+public:
+    /** Creates a FIFO with room for at least the specified number of values. */
+    explicit MultiProducerFifo (int minimumCapacity)
+        : fifo (minimumCapacity),
+          storage ((size_t) fifo.getTotalSize())
+    {}
+
+    //==============================================================================
+    /** Adds a copy of a value, returning false if the FIFO is full. */
+    bool push (const ValueType& value)
+    {
+        return pushWith ([&] (ValueType& slot) { slot = value; });
+    }
+
+    /** Moves a value into the FIFO, returning false if the FIFO is full. */
+    bool push (ValueType&& value)
+    {
+        return pushWith ([&] (ValueType& slot) { slot = std::move (value); });
+    }
+
+    /** Copies as many of the values as will fit into the FIFO, in order, and
+        returns how many were added. The values that were added are kept together,
+        so they won't be interleaved with values from other threads.
+    */
+    int push (Span<const ValueType> values)
+    {
+        const auto scope = fifo.write ((int) values.size());
+        auto* source = values.data();
+        scope.forEach ([&] (int index) { storage[(size_t) index] = *source++; });
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    //==============================================================================
+    /** Moves the next value out of the FIFO, returning false if it was empty. */
+    bool pop (ValueType& result)
+    {
+        return pop (1, [&] (ValueType& value) { result = std::move (value); }) != 0;
+    }
+
+    /** Moves as many values as are ready, up to the size of the destination, and
+        returns how many were moved.
+    */
+    int pop (Span<ValueType> destination)
+    {
+        auto* dest = destination.data();
+        return pop ((int) destination.size(), [&] (ValueType& value) { *dest++ = std::move (value); });
+    }
+
+    /** Calls a function with each of up to maxNumToPop values that are ready, in
+        order, and returns how many there were. The function is passed a reference
+        to the value in its slot, which it may move from.
+    */
+    template <typename Fn>
+    int pop (int maxNumToPop, Fn&& fn)
+    {
+        const auto scope = fifo.read (maxNumToPop);
+        scope.forEach ([&] (int index) { fn (storage[(size_t) index]); });
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    /** Calls a function with each of the values that are ready, in order, and
+        returns how many there were.
+    */
+    template <typename Fn>
+    int popAll (Fn&& fn)
+    {
+        return pop (fifo.getTotalSize(), std::forward<Fn> (fn));
+    }
+
+    //==============================================================================
+    /** Returns the maximum number of values that the FIFO can hold. */
+    int getTotalSize() const noexcept   { return fifo.getTotalSize(); }
+
+    /** Returns roughly how many values are waiting to be read.
+        @see MultiProducerAbstractFifo::getNumReady
+    */
+    int getNumReady() const noexcept    { return fifo.getNumReady(); }
+
+    /** Returns roughly how many values could be added.
+        @see MultiProducerAbstractFifo::getFreeSpace
+    */
+    int getFreeSpace() const noexcept   { return fifo.getFreeSpace(); }
+
+private:
+    template <typename Fn>
+    bool pushWith (Fn&& fn)
+    {
+        const auto scope = fifo.write (1);
+        scope.forEach ([&] (int index) { fn (storage[(size_t) index]); });
+        return scope.blockSize1 != 0;
+    }
+
+    MultiProducerAbstractFifo<readers> fifo;
+    std::vector<ValueType> storage;
+
+    JUCE_DECLARE_NON_COPYABLE (MultiProducerFifo)
+};
+
+} // namespace juce
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class MultiProducerFifoTests final : public UnitTest
+{
+public:
+    MultiProducerFifoTests()
+        : UnitTest ("MultiProducerFifo", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Values are read in the order they were written");
+        {
+            MultiProducerFifo<int> fifo { 5 };
+            expectEquals (fifo.getTotalSize(), 8);
+
+            for (auto i = 0; i < 8; ++i)
+                expect (fifo.push (i));
+
+            expect (! fifo.push (8));
+            expectEquals (fifo.getNumReady(), 8);
+
+            for (auto i = 0; i < 8; ++i)
+            {
+                int value = -1;
+                expect (fifo.pop (value));
+                expectEquals (value, i);
+            }
+
+            int value = -1;
+            expect (! fifo.pop (value));
+            expectEquals (fifo.getNumReady(), 0);
+        }
+
+        beginTest ("Batches wrap around the end of the buffer");
+        {
+            MultiProducerFifo<int, FifoReaders::single> fifo { 8 };
+            std::vector<int> written, read;
+
+            for (auto pass = 0; pass < 10; ++pass)
+            {
+                const std::vector<int> values { pass * 3, pass * 3 + 1, pass * 3 + 2 };
+                expectEquals (fifo.push (Span<const int> { values }), 3);
+                written.insert (written.end(), values.begin(), values.end());
+
+                std::array<int, 5> popped {};
+                const auto num = fifo.pop (Span<int> { popped });
+                read.insert (read.end(), popped.begin(), popped.begin() + num);
+            }
+
+            fifo.popAll ([&] (int v) { read.push_back (v); });
+            expect (read == written);
+
+            const std::vector<int> tooMany (20, 1);
+            expectEquals (fifo.push (Span<const int> { tooMany }), 8);
+            expectEquals (fifo.popAll ([] (int) {}), 8);
+        }
+
+        beginTest ("Slots are only reused once they have been read");
+        {
+            MultiProducerAbstractFifo<> fifo { 4 };
+
+            auto write = fifo.write (3);
+            expectEquals (write.blockSize1 + write.blockSize2, 3);
+
+            // Nothing is readable until the write has finished
+            expectEquals (fifo.read (1).blockSize1, 0);
+            write = {};
+
+            auto read = fifo.read (2);
+            expectEquals (read.startIndex1, 0);
+            expectEquals (read.blockSize1, 2);
+
+            // The slots being read can't be written yet
+            const auto secondWrite = fifo.write (4);
+            expectEquals (secondWrite.startIndex1, 3);
+            expectEquals (secondWrite.blockSize1 + secondWrite.blockSize2, 1);
+        }
+
+        testThreads<FifoReaders::multiple> ("Many threads can write and read at once", 3);
+        testThreads<FifoReaders::single>   ("Many threads can write to a FIFO with a single reader", 1);
+    }
+
+private:
+    template <FifoReaders readers>
+    void testThreads (const String& testName, int numReaders)
+    {
+        beginTest (testName);
+
+        constexpr auto numWriters = 4;
+        constexpr auto numPerWriter = 10000;
+
+        MultiProducerFifo<int, readers> fifo { 64 };
+        std::atomic<int> numWritersFinished { 0 };
+        std::vector<std::vector<int>> received ((size_t) numReaders);
+        std::vector<std::thread> threads;
+
+        for (auto writer = 0; writer < numWriters; ++writer)
+        {
+            threads.emplace_back ([&, writer]
+            {
+                for (auto i = 0; i < numPerWriter;)
+                {
+                    // Mix single values and batches
+                    if (i % 7 == 0)
+                    {
+                        const int batch[] { writer * numPerWriter + i, writer * numPerWriter + i + 1 };
+                        i += fifo.push (Span<const int> { batch, (size_t) jmin (2, numPerWriter - i) });
+                    }
+                    else if (fifo.push (writer * numPerWriter + i))
+                    {
+                        ++i;
+                    }
+
+                    std::this_thread::yield();
+                }
+
+                ++numWritersFinished;
+            });
+        }
+
+        for (auto reader = 0; reader < numReaders; ++reader)
+        {
+            threads.emplace_back ([&, reader]
+            {
+                auto& values = received[(size_t) reader];
+
+                for (;;)
+                {
+                    const auto finished = numWritersFinished.load() == numWriters;
+
+                    if (fifo.pop (5, [&] (int v) { values.push_back (v); }) == 0)
+                    {
+                        if (finished)
+                            break;
+
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        std::vector<int> all;
+        auto inOrder = true;
+
+        for (const auto& values : received)
+        {
+            // Each reader should see the values from each writer in the order they were written
+            std::vector<int> lastFromWriter (numWriters, -1);
+
+            for (auto v : values)
+            {
+                auto& last = lastFromWriter[(size_t) (v / numPerWriter)];
+                inOrder = inOrder && v > last;
+                last = v;
+            }
+
+            all.insert (all.end(), values.begin(), values.end());
+        }
+
+        expect (inOrder);
+
+        std::sort (all.begin(), all.end());
+        std::vector<int> expected (numWriters * numPerWriter);
+        std::iota (expected.begin(), expected.end(), 0);
+        expect (all == expected);
+    }
+};
+
+static MultiProducerFifoTests multiProducerFifoTests;
+
+} // namespace juce
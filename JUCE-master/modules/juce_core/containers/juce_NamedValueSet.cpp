@@ -70,32 +70,72 @@ bool NamedValueSet::NamedValue::operator!= (const NamedValue& other) const noexc
 NamedValueSet::NamedValueSet() noexcept {}
 NamedValueSet::~NamedValueSet() noexcept {}
 
-NamedValueSet::NamedValueSet (const NamedValueSet& other)  : values (other.values) {}
+NamedValueSet::NamedValueSet (const NamedValueSet& other)
+   : values (other.values)
+{
+    if (other.nameIndex != nullptr)
+        nameIndex = std::make_unique<FlatHashMap<Identifier, int>> (*other.nameIndex);
+}
 
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-   : values (std::move (other.values)) {}
+   : values (std::move (other.values)),
+     nameIndex (std::move (other.nameIndex))
+{}
 
 NamedValueSet::NamedValueSet (std::initializer_list<NamedValue> list)
    : values (std::move (list))
 {
+    updateIndex();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
     clear();
     values = other.values;
+
+    if (other.nameIndex != nullptr)
+        nameIndex = std::make_unique<FlatHashMap<Identifier, int>> (*other.nameIndex);
+
     return *this;
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    std::swap (other.nameIndex, nameIndex);
     return *this;
 }
 
 void NamedValueSet::clear()
 {
     values.clear();
+    nameIndex.reset();
+}
+
+void NamedValueSet::updateIndex()
+{
+    if (values.size() < minSizeForIndex)
+    {
+        nameIndex.reset();
+        return;
+    }
+
+    if (nameIndex == nullptr)
+        nameIndex = std::make_unique<FlatHashMap<Identifier, int>> (values.size());
+    else
+        nameIndex->clear();
+
+    // Added in reverse, so that if a name appears more than once, the first one is found
+    for (int i = values.size(); --i >= 0;)
+        nameIndex->set (values.getReference (i).name, i);
+}
+
+void NamedValueSet::addToIndex()
+{
+    if (nameIndex != nullptr)
+        nameIndex->set (values.getLast().name, values.size() - 1);
+    else if (values.size() >= minSizeForIndex)
+        updateIndex();
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const noexcept
@@ -161,6 +201,12 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto* i = nameIndex->find (name);
+        return i != nullptr ? &(values.getReference (*i).value) : nullptr;
+    }
+
     for (auto& i : values)
         if (i.name == name)
             return &(i.value);
@@ -170,6 +216,12 @@ var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 
 const var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto* i = nameIndex->find (name);
+        return i != nullptr ? &(values.getReference (*i).value) : nullptr;
+    }
+
     for (auto& i : values)
         if (i.name == name)
             return &(i.value);
@@ -189,6 +241,7 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
     }
 
     values.add ({ name, std::move (newValue) });
+    addToIndex();
     return true;
 }
 
@@ -204,6 +257,7 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
     }
 
     values.add ({ name, newValue });
+    addToIndex();
     return true;
 }
 
@@ -214,6 +268,12 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto* i = nameIndex->find (name);
+        return i != nullptr ? *i : -1;
+    }
+
     auto numValues = values.size();
 
     for (int i = 0; i < numValues; ++i)
@@ -225,18 +285,20 @@ int NamedValueSet::indexOf (const Identifier& name) const noexcept
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    auto numValues = values.size();
+    auto i = indexOf (name);
 
-    for (int i = 0; i < numValues; ++i)
-    {
-        if (values.getReference (i).name == name)
-        {
-            values.remove (i);
-            return true;
-        }
-    }
+    if (i < 0)
+        return false;
 
-    return false;
+    values.remove (i);
+
+    // Removing the last value (e.g. when undoing an add) doesn't move any of the others
+    if (nameIndex != nullptr && i == values.size() && values.size() >= minSizeForIndex)
+        nameIndex->remove (name);
+    else
+        updateIndex();
+
+    return true;
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -292,6 +354,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add ({ att->name, var (att->value) });
     }
+
+    updateIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
@@ -192,6 +192,14 @@ public:
 private:
     //==============================================================================
     Array<NamedValue> values;
+
+    // Sets with lots of values also keep a hash index of names, so that lookups
+    // don't have to search through all the values
+    std::unique_ptr<FlatHashMap<Identifier, int>> nameIndex;
+    static constexpr int minSizeForIndex = 16;
+
+    void updateIndex();
+    void addToIndex();
 };
 
 } // namespace juce
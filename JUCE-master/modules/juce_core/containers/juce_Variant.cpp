@@ -59,6 +59,7 @@ struct var::VariantType
     struct BoolTag      {};
     struct StringTag    {};
     struct ObjectTag    {};
+    struct DynamicObjectTag {};
     struct ArrayTag     {};
     struct BinaryTag    {};
     struct MethodTag    {};
@@ -76,6 +77,7 @@ struct var::VariantType
     bool isBinary       = false;
     bool isMethod       = false;
     bool isComparable   = false;
+    bool isDynamicObject = false;
 
     int                     (*toInt)         (const ValueUnion&)                 = defaultToInt;
     int64                   (*toInt64)       (const ValueUnion&)                 = defaultToInt64;
@@ -363,16 +365,28 @@ struct var::VariantType
           equals        (objectEquals),
           writeToStream (objectWriteToStream) {}
 
+    // Identical to an object, but records that the object is known to be a DynamicObject,
+    // so that getDynamicObject() doesn't need to repeat the dynamic_cast on every call
+    constexpr explicit VariantType (DynamicObjectTag) noexcept
+        : isObject        (true),
+          isDynamicObject (true),
+          toString        (objectToString),
+          toBool          (objectToBool),
+          toObject        (objectToObject),
+          clone           (objectClone),
+          cleanUp         (objectCleanUp),
+          createCopy      (objectCreateCopy),
+          equals          (objectEquals),
+          writeToStream   (objectWriteToStream) {}
+
     // array =======================================================================
     static String                  arrayToString (const ValueUnion&)            { return "[Array]"; }
     static ReferenceCountedObject* arrayToObject (const ValueUnion&) noexcept   { return nullptr; }
 
     static Array<var>* arrayToArray (const ValueUnion& data) noexcept
     {
-        if (auto* a = dynamic_cast<RefCountedArray*> (data.objectValue))
-            return &(a->array);
-
-        return nullptr;
+        // Only arrays ever use this type, so there's no need for a dynamic_cast
+        return &(static_cast<RefCountedArray*> (data.objectValue)->array);
     }
 
     static bool arrayEquals (const ValueUnion& data, const ValueUnion& otherData, const VariantType& otherType) noexcept
@@ -503,6 +517,7 @@ struct var::Instance
     static constexpr VariantType attributesString         { VariantType::StringTag{} };
     static constexpr VariantType attributesBinary         { VariantType::BinaryTag{} };
     static constexpr VariantType attributesObject         { VariantType::ObjectTag{} };
+    static constexpr VariantType attributesDynamicObject  { VariantType::DynamicObjectTag{} };
 };
 
 //==============================================================================
@@ -520,7 +535,7 @@ var::var (const int v) noexcept       : type (&Instance::attributesInt)    { val
 var::var (const int64 v) noexcept     : type (&Instance::attributesInt64)  { value.int64Value = v; }
 var::var (const bool v) noexcept      : type (&Instance::attributesBool)   { value.boolValue = v; }
 var::var (const double v) noexcept    : type (&Instance::attributesDouble) { value.doubleValue = v; }
-var::var (NativeFunction m) noexcept  : type (&Instance::attributesMethod) { value.methodValue = new NativeFunction (m); }
+var::var (NativeFunction m) noexcept  : type (&Instance::attributesMethod) { value.methodValue = new NativeFunction (std::move (m)); }
 var::var (const Array<var>& v)        : type (&Instance::attributesArray)  { value.objectValue = new VariantType::RefCountedArray (v); }
 var::var (const String& v)            : type (&Instance::attributesString) { new (value.stringValue) String (v); }
 var::var (const char* const v)        : type (&Instance::attributesString) { new (value.stringValue) String (v); }
@@ -539,7 +554,9 @@ var::var (const StringArray& v)       : type (&Instance::attributesArray)
     value.objectValue = new VariantType::RefCountedArray (strings);
 }
 
-var::var (ReferenceCountedObject* const object)  : type (&Instance::attributesObject)
+var::var (ReferenceCountedObject* const object)
+    : type (dynamic_cast<DynamicObject*> (object) != nullptr ? &Instance::attributesDynamicObject
+                                                             : &Instance::attributesObject)
 {
     value.objectValue = object;
 
@@ -572,7 +589,7 @@ var::operator String() const                            { return type->toString
 ReferenceCountedObject* var::getObject() const noexcept { return type->toObject (value); }
 Array<var>* var::getArray() const noexcept              { return type->toArray (value); }
 MemoryBlock* var::getBinaryData() const noexcept        { return type->toBinary (value); }
-DynamicObject* var::getDynamicObject() const noexcept   { return dynamic_cast<DynamicObject*> (getObject()); }
+DynamicObject* var::getDynamicObject() const noexcept   { return type->isDynamicObject ? static_cast<DynamicObject*> (value.objectValue) : nullptr; }
 
 //==============================================================================
 void var::swapWith (var& other) noexcept
@@ -630,6 +647,20 @@ var& var::operator= (String&& v)
     return *this;
 }
 
+var& var::operator= (MemoryBlock&& v)
+{
+    var v2 (std::move (v));
+    swapWith (v2);
+    return *this;
+}
+
+var& var::operator= (Array<var>&& v)
+{
+    var v2 (std::move (v));
+    swapWith (v2);
+    return *this;
+}
+
 //==============================================================================
 bool var::equals (const var& other) const noexcept
 {
@@ -643,7 +674,9 @@ bool var::equalsWithSameType (const var& other) const noexcept
 
 bool var::hasSameTypeAs (const var& other) const noexcept
 {
-    return type == other.type;
+    // DynamicObjects have their own VariantType, but are still the same type as other objects
+    const auto isPlainObject = [] (const VariantType& t) { return t.isObject && ! t.isArray; };
+    return type == other.type || (isPlainObject (*type) && isPlainObject (*other.type));
 }
 
 bool canCompare (const var& v1, const var& v2)
@@ -904,4 +937,64 @@ JUCE_END_IGNORE_DEPRECATION_WARNINGS
 
 #endif
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class VariantTests final : public UnitTest
+{
+public:
+    VariantTests()
+        : UnitTest ("var", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Objects");
+        {
+            struct PlainObject final : public ReferenceCountedObject {};
+            struct DerivedDynamicObject final : public DynamicObject {};
+
+            auto* dynamicObject = new DynamicObject();
+            auto* derived = new DerivedDynamicObject();
+            const var a (dynamicObject), b (derived), c (new PlainObject()), d (static_cast<ReferenceCountedObject*> (nullptr));
+
+            expect (a.getDynamicObject() == dynamicObject);
+            expect (b.getDynamicObject() == derived);
+            expect (c.getDynamicObject() == nullptr && c.getObject() != nullptr);
+            expect (d.getDynamicObject() == nullptr && d.isObject());
+
+            expect (a.hasSameTypeAs (c) && c.hasSameTypeAs (b) && d.hasSameTypeAs (a));
+            expect (! a.hasSameTypeAs (Array<var>()));
+
+            var copy;
+            copy = a;
+            expect (copy.getDynamicObject() == dynamicObject && copy == a);
+            expect (a.clone().getDynamicObject() != nullptr && a.clone() != a);
+        }
+
+        beginTest ("Moving");
+        {
+            Array<var> array { 1, "two", 3.0 };
+            const auto* elements = array.begin();
+
+            var v;
+            v = std::move (array);
+            expect (v.isArray() && v.size() == 3 && v.getArray()->begin() == elements);
+
+            MemoryBlock block (1000);
+            const auto* data = block.getData();
+            v = std::move (block);
+            expect (v.isBinaryData() && v.getBinaryData()->getData() == data);
+
+            var moved (std::move (v));
+            expect (moved.isBinaryData() && v.isVoid());
+        }
+    }
+};
+
+static VariantTests variantTests;
+
+#endif
+
 } // namespace juce
@@ -109,6 +109,8 @@ public:
     var (Array<var>&&);
     var& operator= (var&&) noexcept;
     var& operator= (String&&);
+    var& operator= (MemoryBlock&&);
+    var& operator= (Array<var>&&);
 
     void swapWith (var& other) noexcept;
 
@@ -352,4 +354,9 @@ JUCE_API bool operator== (const var&, const String&);
 JUCE_API bool operator!= (const var&, const String&);
 JUCE_API bool operator== (const var&, const char*);
 JUCE_API bool operator!= (const var&, const char*);
+
+#ifndef DOXYGEN
+template <> struct TypeHelpers::IsTriviallyRelocatable<var> : std::true_type {};
+#endif
+
 } // namespace juce
@@ -0,0 +1,522 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+int64 juce_fileReadAt (detail::NativeFileHandle, int64 pos, void* buffer, size_t numBytes);
+
+//==============================================================================
+class AsyncFileReader::Backend
+{
+public:
+    virtual ~Backend() = default;
+
+    virtual void submit (std::vector<Read>&) = 0;
+    virtual bool isNative() const noexcept = 0;
+
+    void waitForAll()
+    {
+        while (numOutstanding.load() > 0)
+            allDone.wait (100);
+    }
+
+protected:
+    std::atomic<int> numOutstanding { 0 };
+    WaitableEvent allDone;
+
+    void addOutstanding (size_t num)
+    {
+        numOutstanding += (int) num;
+    }
+
+    void complete (Read& r, int numBytesRead)
+    {
+        if (r.callback != nullptr)
+            r.callback (numBytesRead);
+
+        r.callback = nullptr;
+
+        if (--numOutstanding == 0)
+            allDone.signal();
+    }
+};
+
+//==============================================================================
+class AsyncFileReader::ThreadedBackend final : public Backend,
+                                               private Thread
+{
+public:
+    explicit ThreadedBackend (detail::NativeFileHandle h)
+        : Thread ("AsyncFileReader"), handle (h)
+    {
+        startThread();
+    }
+
+    ~ThreadedBackend() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread (4000);
+    }
+
+    void submit (std::vector<Read>& reads) override
+    {
+        addOutstanding (reads.size());
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto& r : reads)
+                pending.push_back (std::move (r));
+        }
+
+        notify();
+    }
+
+    bool isNative() const noexcept override    { return false; }
+
+private:
+    detail::NativeFileHandle handle;
+    CriticalSection lock;
+    std::deque<Read> pending;
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            Read r;
+            bool gotRead = false;
+
+            {
+                const ScopedLock sl (lock);
+
+                if (! pending.empty())
+                {
+                    r = std::move (pending.front());
+                    pending.pop_front();
+                    gotRead = true;
+                }
+            }
+
+            if (! gotRead)
+            {
+                wait (-1);
+                continue;
+            }
+
+            auto numRead = juce_fileReadAt (handle, r.position, r.destBuffer, (size_t) r.numBytes);
+            complete (r, (int) numRead);
+        }
+    }
+};
+
+//==============================================================================
+#if JUCE_USE_IO_URING
+
+class AsyncFileReader::IoUringBackend final : public Backend,
+                                              private Thread
+{
+public:
+    IoUringBackend (detail::NativeFileHandle h, int maxReadsInFlight)
+        : Thread ("AsyncFileReader"), handle (h)
+    {
+        io_uring_params params {};
+        ringFd = (int) syscall (__NR_io_uring_setup, (unsigned) jlimit (1, 4096, maxReadsInFlight), &params);
+
+        if (ringFd < 0)
+            return;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof (unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+
+        const auto singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+        if (singleMap)
+            sqRingSize = cqRingSize = jmax (sqRingSize, cqRingSize);
+
+        sqRing = map (sqRingSize, IORING_OFF_SQ_RING);
+        cqRing = singleMap ? sqRing : map (cqRingSize, IORING_OFF_CQ_RING);
+        sqesSize = params.sq_entries * sizeof (io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*> (map (sqesSize, IORING_OFF_SQES));
+
+        if (sqRing == nullptr || cqRing == nullptr || sqes == nullptr)
+            return;
+
+        auto* sq = static_cast<char*> (sqRing);
+        sqTail  = reinterpret_cast<unsigned*> (sq + params.sq_off.tail);
+        sqMask  = *reinterpret_cast<unsigned*> (sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*> (sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*> (cqRing);
+        cqHead = reinterpret_cast<unsigned*> (cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*> (cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*> (cq + params.cq_off.ring_mask);
+        cqes   = reinterpret_cast<io_uring_cqe*> (cq + params.cq_off.cqes);
+
+        // Keeping one submission slot spare means there's always room for the wake-up
+        // request that the destructor sends.
+        inFlight.resize (params.sq_entries - 1);
+
+        for (size_t i = inFlight.size(); i > 0; --i)
+            freeSlots.push_back (i - 1);
+
+        isValid = ! freeSlots.empty();
+
+        if (isValid)
+            startThread();
+    }
+
+    ~IoUringBackend() override
+    {
+        if (isThreadRunning())
+        {
+            signalThreadShouldExit();
+
+            {
+                const ScopedLock sl (lock);
+                auto& sqe = getNextSqe();
+                sqe.opcode = IORING_OP_NOP;
+                sqe.user_data = wakeUpTag;
+                publishSqes (1);
+            }
+
+            stopThread (4000);
+        }
+
+        if (sqes != nullptr)                            munmap (sqes, sqesSize);
+        if (cqRing != nullptr && cqRing != sqRing)      munmap (cqRing, cqRingSize);
+        if (sqRing != nullptr)                          munmap (sqRing, sqRingSize);
+        if (ringFd >= 0)                                close (ringFd);
+    }
+
+    bool isUsable() const noexcept                  { return isValid; }
+    bool isNative() const noexcept override         { return true; }
+
+    void submit (std::vector<Read>& reads) override
+    {
+        addOutstanding (reads.size());
+
+        const ScopedLock sl (lock);
+
+        for (auto& r : reads)
+            backlog.push_back (std::move (r));
+
+        submitBacklog();
+    }
+
+private:
+    static constexpr uint64 wakeUpTag = ~(uint64) 0;
+
+    detail::NativeFileHandle handle;
+    int ringFd = -1;
+    size_t sqRingSize = 0, cqRingSize = 0, sqesSize = 0;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    io_uring_sqe* sqes = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned sqMask = 0, cqMask = 0;
+    bool isValid = false;
+
+    CriticalSection lock;
+    std::vector<Read> inFlight;
+    std::vector<size_t> freeSlots;
+    std::deque<Read> backlog;
+
+    void* map (size_t size, off_t offset) const
+    {
+        auto* result = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+        return result == MAP_FAILED ? nullptr : result;
+    }
+
+    io_uring_sqe& getNextSqe() const
+    {
+        auto index = (*sqTail + numUnpublished) & sqMask;
+        auto& sqe = sqes[index];
+        zerostruct (sqe);
+        sqArray[index] = index;
+        return sqe;
+    }
+
+    unsigned numUnpublished = 0;
+
+    void publishSqes (unsigned num)
+    {
+        __atomic_store_n (sqTail, *sqTail + num, __ATOMIC_RELEASE);
+        numUnpublished = 0;
+
+        while (syscall (__NR_io_uring_enter, ringFd, num, 0, 0, nullptr, 0) < 0 && errno == EINTR)
+        {}
+    }
+
+    void submitBacklog()
+    {
+        unsigned numAdded = 0;
+
+        while (! backlog.empty() && ! freeSlots.empty())
+        {
+            auto slot = freeSlots.back();
+            freeSlots.pop_back();
+
+            auto& r = inFlight[slot];
+            r = std::move (backlog.front());
+            backlog.pop_front();
+
+            auto& sqe = getNextSqe();
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = handle.get();
+            sqe.addr = (uint64) (pointer_sized_uint) r.destBuffer;
+            sqe.len = (uint32) r.numBytes;
+            sqe.off = (uint64) r.position;
+            sqe.user_data = slot;
+            ++numUnpublished;
+            ++numAdded;
+        }
+
+        if (numAdded > 0)
+            publishSqes (numAdded);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            syscall (__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+            for (;;)
+            {
+                auto head = *cqHead;
+
+                if (head == __atomic_load_n (cqTail, __ATOMIC_ACQUIRE))
+                    break;
+
+                const auto cqe = cqes[head & cqMask];
+                __atomic_store_n (cqHead, head + 1, __ATOMIC_RELEASE);
+
+                if (cqe.user_data == wakeUpTag)
+                    continue;
+
+                Read r;
+
+                {
+                    const ScopedLock sl (lock);
+                    r = std::move (inFlight[(size_t) cqe.user_data]);
+                    freeSlots.push_back ((size_t) cqe.user_data);
+                }
+
+                auto numRead = (int64) cqe.res;
+
+                // Older kernels can set up a ring but don't support IORING_OP_READ, so
+                // any failure is retried synchronously, which also gets a proper result
+                // for short reads that were interrupted.
+                if (numRead < 0 || (numRead < r.numBytes && numRead > 0))
+                {
+                    auto offset = jmax ((int64) 0, numRead);
+                    auto rest = juce_fileReadAt (handle, r.position + offset,
+                                                 static_cast<char*> (r.destBuffer) + offset,
+                                                 (size_t) (r.numBytes - offset));
+                    numRead = rest < 0 ? -1 : offset + rest;
+                }
+
+                complete (r, (int) numRead);
+            }
+
+            const ScopedLock sl (lock);
+            submitBacklog();
+        }
+    }
+};
+
+#endif
+
+//==============================================================================
+AsyncFileReader::AsyncFileReader (const File& fileToRead, int maxReadsInFlight, bool useNativeAsyncIOIfAvailable)
+    : stream (fileToRead)
+{
+    if (! stream.openedOk())
+        return;
+
+   #if JUCE_USE_IO_URING
+    if (useNativeAsyncIOIfAvailable)
+    {
+        auto uring = std::make_unique<IoUringBackend> (stream.fileHandle, maxReadsInFlight);
+
+        if (uring->isUsable())
+            backend = std::move (uring);
+    }
+   #else
+    ignoreUnused (maxReadsInFlight, useNativeAsyncIOIfAvailable);
+   #endif
+
+    if (backend == nullptr)
+        backend = std::make_unique<ThreadedBackend> (stream.fileHandle);
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    waitForAll();
+    backend.reset();
+}
+
+const File& AsyncFileReader::getFile() const noexcept       { return stream.getFile(); }
+const Result& AsyncFileReader::getStatus() const noexcept   { return stream.getStatus(); }
+
+bool AsyncFileReader::isUsingNativeAsyncIO() const noexcept
+{
+    return backend != nullptr && backend->isNative();
+}
+
+void AsyncFileReader::addRead (int64 filePosition, void* destBuffer, int numBytes, Callback callback)
+{
+    jassert (destBuffer != nullptr && numBytes >= 0 && filePosition >= 0);
+    queuedReads.push_back ({ filePosition, destBuffer, numBytes, std::move (callback) });
+}
+
+void AsyncFileReader::submit()
+{
+    if (queuedReads.empty())
+        return;
+
+    if (backend != nullptr)
+    {
+        backend->submit (queuedReads);
+    }
+    else
+    {
+        for (auto& r : queuedReads)
+            if (r.callback != nullptr)
+                r.callback (-1);
+    }
+
+    queuedReads.clear();
+}
+
+void AsyncFileReader::waitForAll()
+{
+    if (backend != nullptr)
+        backend->waitForAll();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AsyncFileReaderTests final : public UnitTest
+{
+    AsyncFileReaderTests()
+        : UnitTest ("AsyncFileReader", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile tempFile;
+        MemoryBlock data (300000);
+        auto random = getRandom();
+
+        for (size_t i = 0; i < data.getSize(); ++i)
+            data[i] = (char) random.nextInt (256);
+
+        expect (tempFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+        for (auto useNative : { false, true })
+        {
+            beginTest (useNative ? "Native reads" : "Threaded reads");
+
+            AsyncFileReader reader (tempFile.getFile(), 16, useNative);
+            expect (reader.openedOk());
+
+            if (! useNative)
+                expect (! reader.isUsingNativeAsyncIO());
+            else if (! reader.isUsingNativeAsyncIO())
+                logMessage ("Native asynchronous I/O isn't available, so the threaded reader was used");
+
+            constexpr int numReads = 500;
+            std::vector<MemoryBlock> buffers (numReads);
+            std::vector<int64> positions (numReads);
+            std::vector<int> results (numReads, -2);
+
+            for (int i = 0; i < numReads; ++i)
+            {
+                auto size = random.nextInt (5000);
+                positions[(size_t) i] = random.nextInt ((int) data.getSize());
+                buffers[(size_t) i].setSize ((size_t) size + 1);
+
+                reader.addRead (positions[(size_t) i], buffers[(size_t) i].getData(), size,
+                                [&results, i] (int numRead) { results[(size_t) i] = numRead; });
+
+                if (i % 50 == 49)
+                    reader.submit();
+            }
+
+            reader.submit();
+            reader.waitForAll();
+
+            for (int i = 0; i < numReads; ++i)
+            {
+                auto pos = positions[(size_t) i];
+                auto expectedSize = (int) jmin ((int64) buffers[(size_t) i].getSize() - 1, (int64) data.getSize() - pos);
+
+                expectEquals (results[(size_t) i], expectedSize);
+
+                if (results[(size_t) i] == expectedSize)
+                    expect (memcmp (buffers[(size_t) i].getData(), data.begin() + pos, (size_t) expectedSize) == 0);
+            }
+        }
+
+        beginTest ("Missing file");
+        {
+            AsyncFileReader reader (tempFile.getFile().getSiblingFile ("doesNotExist_"
+                                                                       + String::toHexString (random.nextInt64())));
+            expect (! reader.openedOk());
+
+            char buffer[16];
+            int result = 0;
+            reader.addRead (0, buffer, 16, [&result] (int numRead) { result = numRead; });
+            reader.submit();
+            reader.waitForAll();
+            expectEquals (result, -1);
+        }
+    }
+};
+
+static AsyncFileReaderTests asyncFileReaderTests;
+
+#endif
+
+} // namespace juce
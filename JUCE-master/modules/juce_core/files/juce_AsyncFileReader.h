@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads blocks of data from a file asynchronously.
+
+    Reads are queued with addRead(), and then handed over together by submit(), so a
+    batch of small reads costs very little more than a single one. When each read has
+    finished, its callback is called with the number of bytes that were read, or -1 if
+    the read failed.
+
+    On Linux, this uses io_uring when the kernel supports it, so that the reads are
+    performed by the kernel without tying up a thread for each one. Elsewhere, or if
+    io_uring is unavailable, the reads are done on a background thread using positional
+    reads, which still lets the submitting thread carry on while the data arrives.
+
+    Callbacks are made on an internal thread, so they should be quick, and must be
+    thread-safe with respect to whatever the submitting thread is doing. The buffer
+    for each read must stay valid until its callback has been called.
+
+    @code
+    AsyncFileReader reader (file);
+
+    for (auto& chunk : chunksToLoad)
+        reader.addRead (chunk.position, chunk.buffer, chunk.size,
+                        [&chunk] (int numBytesRead) { chunk.markLoaded (numBytesRead); });
+
+    reader.submit();
+    @endcode
+
+    @see FileInputStream
+    @tags{Core}
+*/
+class JUCE_API  AsyncFileReader
+{
+public:
+    //==============================================================================
+    /** The function that is called when a read has finished. The argument is the number
+        of bytes that were read, which may be less than requested at the end of the file,
+        or -1 if there was an error.
+    */
+    using Callback = std::function<void (int numBytesRead)>;
+
+    /** Opens a file for asynchronous reading.
+
+        @param fileToRead                   the file to read from
+        @param maxReadsInFlight             the number of reads that may be handed to the
+                                            operating system at the same time. Any more are
+                                            queued until earlier ones finish.
+        @param useNativeAsyncIOIfAvailable  if false, the background thread will always be
+                                            used, even if the OS supports something better
+    */
+    explicit AsyncFileReader (const File& fileToRead,
+                              int maxReadsInFlight = 64,
+                              bool useNativeAsyncIOIfAvailable = true);
+
+    /** Destructor. This waits for any reads that have been submitted to finish. */
+    ~AsyncFileReader();
+
+    //==============================================================================
+    /** Returns the file that this reader is reading from. */
+    const File& getFile() const noexcept;
+
+    /** Returns the status of the file, which will show an error if it couldn't be opened. */
+    const Result& getStatus() const noexcept;
+
+    /** Returns true if the file was opened successfully. */
+    bool openedOk() const noexcept                      { return getStatus().wasOk(); }
+
+    /** Returns true if the reader is using the operating system's own asynchronous I/O,
+        rather than a background thread.
+    */
+    bool isUsingNativeAsyncIO() const noexcept;
+
+    //==============================================================================
+    /** Queues a read, which won't start until submit() is called.
+
+        @param filePosition     the position in the file to read from
+        @param destBuffer       the buffer to read into, which must remain valid until the
+                                callback has been called
+        @param numBytes         the number of bytes to read
+        @param callback         the function to call when the read has finished
+    */
+    void addRead (int64 filePosition, void* destBuffer, int numBytes, Callback callback);
+
+    /** Starts all the reads that have been queued with addRead(). */
+    void submit();
+
+    /** Blocks until all the reads that have been submitted have finished, and their
+        callbacks have returned.
+    */
+    void waitForAll();
+
+private:
+    //==============================================================================
+    struct Read
+    {
+        int64 position = 0;
+        void* destBuffer = nullptr;
+        int numBytes = 0;
+        Callback callback;
+    };
+
+    class Backend;
+    class ThreadedBackend;
+    class IoUringBackend;
+
+    FileInputStream stream;
+    std::vector<Read> queuedReads;
+    std::unique_ptr<Backend> backend;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncFileReader)
+};
+
+} // namespace juce
@@ -135,6 +135,8 @@ public:
     float getEstimatedProgress() const;
 
 private:
+    friend class ParallelDirectoryWalker;
+
     using KnownPaths = std::set<File>;
 
     DirectoryIterator (const File& directory,
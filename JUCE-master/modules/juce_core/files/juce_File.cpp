@@ -1038,16 +1038,48 @@ JUCE_END_IGNORE_DEPRECATION_WARNINGS
 #endif
 
 //==============================================================================
-MemoryMappedFile::MemoryMappedFile (const File& file, MemoryMappedFile::AccessMode mode, bool exclusive)
-    : range (0, file.getSize())
+MemoryMappedFile::MemoryMappedFile (const File& f, MemoryMappedFile::AccessMode mode, bool exclusive)
+    : range (0, f.getSize()), mappedFile (f), accessMode (mode), exclusiveAccess (exclusive)
 {
-    openInternal (file, mode, exclusive);
+    openInternal (mappedFile, mode, exclusive);
 }
 
-MemoryMappedFile::MemoryMappedFile (const File& file, const Range<int64>& fileRange, AccessMode mode, bool exclusive)
-    : range (fileRange.getIntersectionWith (Range<int64> (0, file.getSize())))
+MemoryMappedFile::MemoryMappedFile (const File& f, const Range<int64>& fileRange, AccessMode mode, bool exclusive)
+    : range (fileRange.getIntersectionWith (Range<int64> (0, f.getSize()))), mappedFile (f), accessMode (mode), exclusiveAccess (exclusive)
 {
-    openInternal (file, mode, exclusive);
+    if (range.isEmpty())
+        range = {};
+    else
+        openInternal (mappedFile, mode, exclusive);
+}
+
+bool MemoryMappedFile::remap (Range<int64> newFileRange)
+{
+    MemoryMappedFile newMapping (mappedFile, newFileRange, accessMode, exclusiveAccess);
+
+    // the old mapping gets released when newMapping goes out of scope
+    std::swap (address, newMapping.address);
+    std::swap (range, newMapping.range);
+    std::swap (fileHandle, newMapping.fileHandle);
+
+    return address != nullptr;
+}
+
+void MemoryMappedFile::prefault (Range<int64> rangeInFile) const noexcept
+{
+    const auto section = range.getIntersectionWith (rangeInFile);
+
+    if (address == nullptr || section.isEmpty())
+        return;
+
+    const auto* start = static_cast<const volatile char*> (address) + (section.getStart() - range.getStart());
+    const auto numBytes = (size_t) section.getLength();
+    constexpr size_t stride = 4096;
+
+    for (size_t i = 0; i < numBytes; i += stride)
+        (void) start[i];
+
+    (void) start[numBytes - 1];
 }
 
 
@@ -1253,6 +1285,44 @@ public:
             expect (tempFile2.deleteFile());
         }
 
+        beginTest ("Memory-mapped file hints and remapping");
+
+        {
+            TemporaryFile bigFile;
+            MemoryBlock data (1 << 20);
+
+            for (size_t i = 0; i < data.getSize(); ++i)
+                data[i] = (char) (i / 4096);
+
+            expect (bigFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            MemoryMappedFile mmf (bigFile.getFile(), { 0, 65536 }, MemoryMappedFile::readOnly);
+            expect (mmf.getData() != nullptr);
+
+           #if ! JUCE_WINDOWS
+            expect (mmf.adviseAccessPattern (MemoryMappedFile::AccessPattern::random));
+            expect (mmf.adviseAccessPattern (MemoryMappedFile::AccessPattern::sequential, { 1000, 5000 }));
+           #endif
+            expect (mmf.adviseAccessPattern (MemoryMappedFile::AccessPattern::willNeed, { 0, 65536 }));
+            expect (! mmf.adviseAccessPattern (MemoryMappedFile::AccessPattern::willNeed, { 100000, 200000 }));
+
+            mmf.prefault ({ 0, 65536 });
+
+            if (mmf.lockInMemory ({ 4096, 8192 }))
+                mmf.unlockFromMemory ({ 4096, 8192 });
+
+            expect (mmf.remap ({ 500000, 600000 }));
+            expect (mmf.getData() != nullptr);
+            expect (mmf.getRange().getStart() <= 500000);
+            expect (mmf.getRange().getEnd() == 600000);
+
+            const auto offset = (size_t) (500000 - mmf.getRange().getStart());
+            expect (memcmp (addBytesToPointer (mmf.getData(), offset), addBytesToPointer (data.getData(), 500000), 100000) == 0);
+
+            expect (! mmf.remap ({ 2000000, 3000000 }));
+            expect (mmf.getData() == nullptr);
+        }
+
         beginTest ("More writing");
 
         expect (tempFile.appendData ("abcdefghij", 10));
@@ -61,8 +61,12 @@ int FileInputStream::read (void* buffer, int bytesToRead)
     // sign that something is broken!
     jassert (buffer != nullptr && bytesToRead >= 0);
 
+    JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+    JUCE_SCOPED_TRACE ("FileInputStream::read")
+
     auto num = readInternal (buffer, (size_t) bytesToRead);
     currentPosition += (int64) num;
+    JUCE_TRACE_COUNTER_ADD ("File bytes read", num)
 
     return (int) num;
 }
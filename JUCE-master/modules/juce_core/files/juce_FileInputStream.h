@@ -96,6 +96,8 @@ private:
     void openHandle();
     size_t readInternal (void*, size_t);
 
+    friend class AsyncFileReader;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileInputStream)
 };
 
@@ -72,6 +72,9 @@ bool FileOutputStream::flushBuffer()
 
     if (bytesInBuffer > 0)
     {
+        JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+        JUCE_SCOPED_TRACE ("FileOutputStream::flushBuffer")
+        JUCE_TRACE_COUNTER_ADD ("File bytes written", bytesInBuffer)
         ok = (writeInternal (buffer, bytesInBuffer) == (ssize_t) bytesInBuffer);
         bytesInBuffer = 0;
     }
@@ -82,6 +85,9 @@ bool FileOutputStream::flushBuffer()
 void FileOutputStream::flush()
 {
     flushBuffer();
+
+    JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+    JUCE_SCOPED_TRACE ("FileOutputStream::flush")
     flushInternal();
 }
 
@@ -111,6 +117,9 @@ bool FileOutputStream::write (const void* const src, const size_t numBytes)
         }
         else
         {
+            JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+            JUCE_SCOPED_TRACE ("FileOutputStream::write")
+            JUCE_TRACE_COUNTER_ADD ("File bytes written", numBytes)
             auto bytesWritten = writeInternal (src, numBytes);
 
             if (bytesWritten < 0)
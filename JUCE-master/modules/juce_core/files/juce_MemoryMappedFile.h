@@ -108,10 +108,93 @@ public:
     /** Returns the section of the file at which the mapped memory represents. */
     Range<int64> getRange() const noexcept      { return range; }
 
+    /** Tells the OS that a section of the mapped file will be accessed soon, so that it
+        can start reading it in before it's needed.
+
+        The range is given as byte positions within the file, and any part of it that lies
+        outside the mapped range is ignored. This is only a hint - it doesn't block, and
+        on some platforms it may do nothing.
+    */
+    void prefetch (Range<int64> rangeInFile) const noexcept;
+
+    /** The hints that can be passed to adviseAccessPattern(). */
+    enum class AccessPattern
+    {
+        normal,         /**< No particular pattern - the OS will use its default read-ahead. */
+        sequential,     /**< The data will be read in order, so pages can be read ahead aggressively
+                             and dropped soon after they've been used. */
+        random,         /**< The data will be accessed in no particular order, so read-ahead is
+                             likely to be wasted. */
+        willNeed,       /**< The data will be accessed soon, so the OS should start reading it in. */
+        dontNeed        /**< The data won't be needed for a while, so the OS can release the pages. */
+    };
+
+    /** Tells the OS how a section of the mapped file is going to be accessed.
+
+        The range is given as byte positions within the file, and any part of it that lies
+        outside the mapped range is ignored. This is only a hint, and returns false if the
+        platform doesn't support it. On Windows, only willNeed and dontNeed have any effect.
+
+        Note that using dontNeed on an exclusive read-write mapping would throw away any
+        unwritten changes on some systems, so it's ignored for that kind of mapping.
+    */
+    bool adviseAccessPattern (AccessPattern pattern, Range<int64> rangeInFile) const noexcept;
+
+    /** Tells the OS how the whole of the mapped range is going to be accessed.
+        @see adviseAccessPattern
+    */
+    bool adviseAccessPattern (AccessPattern pattern) const noexcept     { return adviseAccessPattern (pattern, range); }
+
+    /** Asks the OS to back the mapping with huge pages, which reduces the number of TLB
+        misses when randomly accessing a very large mapping.
+
+        This is currently only possible on Linux, and only succeeds if the kernel supports
+        transparent huge pages for the filesystem that the file lives on. Returns true if
+        the request was accepted.
+    */
+    bool requestHugePages() const noexcept;
+
+    /** Reads in a section of the mapped file and locks it into physical memory, so that
+        accessing it can never cause a page fault.
+
+        This is intended for data that will be read on a realtime thread. The range is given
+        as byte positions within the file, and any part of it that lies outside the mapped range
+        is ignored. Locking may fail if it would exceed the process's locked-memory limit, in
+        which case this will return false, although the pages will still have been read in.
+
+        Locked sections are released by unlockFromMemory(), or when the mapping is closed.
+        @see prefault
+    */
+    bool lockInMemory (Range<int64> rangeInFile) const noexcept;
+
+    /** Releases a section that was previously locked with lockInMemory(). */
+    void unlockFromMemory (Range<int64> rangeInFile) const noexcept;
+
+    /** Touches every page in a section of the mapped file so that it's read into memory
+        now, rather than when it's first accessed. This blocks until all the pages have been
+        read in, so it should be called from a background thread.
+    */
+    void prefault (Range<int64> rangeInFile) const noexcept;
+
+    /** Replaces the current mapping with one that covers a different section of the same file.
+
+        This can be used to slide a window over a file which is too large to map all at once.
+        As with the constructor, the start of the range may be rounded down to the OS's page
+        size, so use getRange() to find the actual range that was mapped. Any hints or locks
+        that were applied to the old section are lost.
+
+        If the new section can't be mapped, this returns false and the object will be left
+        with no mapping at all.
+    */
+    bool remap (Range<int64> newFileRange);
+
 private:
     //==============================================================================
     void* address = nullptr;
     Range<int64> range;
+    File mappedFile;
+    AccessMode accessMode;
+    bool exclusiveAccess;
 
    #if JUCE_WINDOWS
     void* fileHandle = nullptr;
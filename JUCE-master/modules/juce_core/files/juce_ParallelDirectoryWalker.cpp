@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ParallelDirectoryWalker::Walk
+{
+    Walk (ThreadPool& pool, const Callback& cb, const String& wildCard,
+          int types, File::FollowSymlinks follow, const std::atomic<bool>* cancel)
+        : group (pool),
+          callback (cb),
+          wildCards (DirectoryIterator::parseWildcards (wildCard)),
+          matchesEverything (wildCards.size() == 1 && wildCards[0] == "*"),
+          whatToLookFor (types),
+          followSymlinks (follow),
+          shouldCancel (cancel)
+    {
+        // you have to specify the type of files you're looking for!
+        jassert ((whatToLookFor & (File::findFiles | File::findDirectories)) != 0);
+        jassert (whatToLookFor > 0 && whatToLookFor <= 7);
+    }
+
+    bool isCancelled() const noexcept
+    {
+        return shouldCancel != nullptr && shouldCancel->load();
+    }
+
+    void addFolder (const File& folder)
+    {
+        group.run ([this, folder] { scanFolder (folder); });
+    }
+
+    void scanFolder (const File& folder)
+    {
+        if (followSymlinks == File::FollowSymlinks::noCycles)
+        {
+            const ScopedLock sl (knownPathsLock);
+            knownPaths.insert (folder);
+        }
+
+        DirectoryIterator::NativeIterator finder (folder, "*");
+        const auto path = File::addTrailingSeparator (folder.getFullPathName());
+        const auto ignoreHidden = (whatToLookFor & File::ignoreHiddenFiles) != 0;
+
+        DirectoryEntry entry;
+        String filename;
+
+        while (finder.next (filename, &entry.directory, &entry.hidden, &entry.fileSize,
+                            &entry.modTime, &entry.creationTime, &entry.readOnly))
+        {
+            if (isCancelled())
+            {
+                group.cancel();
+                return;
+            }
+
+            if (filename.containsOnly (".") || (ignoreHidden && entry.hidden))
+                continue;
+
+            entry.file = File::createFileWithoutCheckingPath (path + filename);
+
+            if (entry.directory && mayRecurseInto (entry.file))
+                addFolder (entry.file);
+
+            if ((whatToLookFor & (entry.directory ? File::findDirectories : File::findFiles)) != 0
+                 && (matchesEverything || DirectoryIterator::fileMatches (wildCards, filename)))
+                callback (entry);
+        }
+    }
+
+    bool mayRecurseInto (const File& folder)
+    {
+        if (followSymlinks == File::FollowSymlinks::yes || ! folder.isSymbolicLink())
+            return true;
+
+        if (followSymlinks == File::FollowSymlinks::no)
+            return false;
+
+        const ScopedLock sl (knownPathsLock);
+        return knownPaths.insert (folder.getLinkedTarget()).second;
+    }
+
+    TaskGroup group;
+    const Callback& callback;
+    const StringArray wildCards;
+    const bool matchesEverything;
+    const int whatToLookFor;
+    const File::FollowSymlinks followSymlinks;
+    const std::atomic<bool>* shouldCancel;
+
+    CriticalSection knownPathsLock;
+    std::set<File> knownPaths;
+
+    JUCE_DECLARE_NON_COPYABLE (Walk)
+};
+
+//==============================================================================
+bool ParallelDirectoryWalker::walk (ThreadPool& pool,
+                                    const File& directory,
+                                    const Callback& callback,
+                                    const String& wildCard,
+                                    int whatToLookFor,
+                                    File::FollowSymlinks followSymlinks,
+                                    const std::atomic<bool>* shouldCancel)
+{
+    Walk w (pool, callback, wildCard, whatToLookFor, followSymlinks, shouldCancel);
+    w.addFolder (directory);
+    w.group.wait();
+
+    return ! w.isCancelled();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ParallelDirectoryWalkerTests final : public UnitTest
+{
+    ParallelDirectoryWalkerTests()
+        : UnitTest ("ParallelDirectoryWalker", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile tempFolder;
+        const auto root = tempFolder.getFile();
+        expect (root.createDirectory().wasOk());
+
+        for (int i = 0; i < 10; ++i)
+        {
+            auto sub = root.getChildFile ("folder" + String (i)).getChildFile ("inner" + String (i % 3));
+            expect (sub.createDirectory().wasOk());
+
+            for (int j = 0; j < 5; ++j)
+                expect (sub.getChildFile ("file" + String (j) + (j % 2 == 0 ? ".wav" : ".txt")).replaceWithText ("x"));
+        }
+
+        expect (root.getChildFile (".hidden.wav").replaceWithText ("hidden"));
+
+        ThreadPool pool (4);
+
+        for (auto wildCard : { "*", "*.wav", "*.wav;*.txt", "file1*" })
+        {
+            for (auto types : { (int) File::findFiles, (int) File::findDirectories, (int) File::findFilesAndDirectories,
+                                (int) File::findFiles | File::ignoreHiddenFiles })
+            {
+                beginTest ("Matches RangedDirectoryIterator: " + String (wildCard) + ", " + String (types));
+
+                std::set<File> expected;
+
+                for (const auto& entry : RangedDirectoryIterator (root, true, wildCard, types))
+                    expected.insert (entry.getFile());
+
+                std::set<File> found;
+                CriticalSection lock;
+
+                expect (ParallelDirectoryWalker::walk (pool, root, [&] (const DirectoryEntry& entry)
+                {
+                    expect (entry.isDirectory() == entry.getFile().isDirectory());
+
+                    if (! entry.isDirectory())
+                        expectEquals (entry.getFileSize(), entry.getFile().getSize());
+
+                    const ScopedLock sl (lock);
+                    found.insert (entry.getFile());
+                }, wildCard, types));
+
+                expect (found == expected);
+            }
+        }
+
+        beginTest ("Cancellation");
+        {
+            std::atomic<bool> cancel { false };
+            std::atomic<int> numFound { 0 };
+
+            auto completed = ParallelDirectoryWalker::walk (pool, root, [&] (const DirectoryEntry&)
+            {
+                if (++numFound == 3)
+                    cancel = true;
+            }, "*", File::findFilesAndDirectories, File::FollowSymlinks::yes, &cancel);
+
+            expect (! completed);
+            expect (numFound.load() < 70);
+        }
+
+       #if ! JUCE_WINDOWS
+        beginTest ("Symlink cycles");
+        {
+            auto link = root.getChildFile ("folder0").getChildFile ("loop");
+            expect (root.createSymbolicLink (link, true));
+
+            std::atomic<int> numFound { 0 };
+            expect (ParallelDirectoryWalker::walk (pool, root, [&] (const DirectoryEntry&) { ++numFound; },
+                                                   "*.wav", File::findFiles, File::FollowSymlinks::noCycles));
+
+            expectEquals (numFound.load(), 31);
+
+            numFound = 0;
+            expect (ParallelDirectoryWalker::walk (pool, root, [&] (const DirectoryEntry&) { ++numFound; },
+                                                   "*.wav", File::findFiles, File::FollowSymlinks::no));
+
+            expectEquals (numFound.load(), 31);
+        }
+       #endif
+    }
+};
+
+static ParallelDirectoryWalkerTests parallelDirectoryWalkerTests;
+
+#endif
+
+} // namespace juce
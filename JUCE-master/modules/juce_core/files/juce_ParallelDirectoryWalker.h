@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Searches a directory tree using the threads of a ThreadPool, passing each matching
+    file or folder to a callback as soon as it's found.
+
+    Each folder is listed by a separate task, so a large tree is spread over all the
+    threads in the pool, which is much quicker than a RangedDirectoryIterator when
+    the file system can service several requests at once (as SSDs and network drives
+    generally can).
+
+    The callback is called concurrently from the pool's threads, so it must be
+    thread-safe. The order in which entries are found is undefined.
+
+    @code
+    std::mutex mutex;
+    Array<File> samples;
+
+    ParallelDirectoryWalker::walk (pool, sampleFolder, [&] (const DirectoryEntry& entry)
+    {
+        const std::scoped_lock lock { mutex };
+        samples.add (entry.getFile());
+    }, "*.wav;*.aif");
+    @endcode
+
+    @see RangedDirectoryIterator, TaskGroup
+    @tags{Core}
+*/
+class JUCE_API  ParallelDirectoryWalker
+{
+public:
+    /** The function that is called for each entry that is found. */
+    using Callback = std::function<void (const DirectoryEntry&)>;
+
+    /** Recursively searches a directory, calling the callback for each match.
+
+        This returns when the whole tree has been searched, and all the callbacks have
+        returned. The calling thread helps out with the search while it waits.
+
+        @param pool             the pool whose threads should do the searching
+        @param directory        the directory to search in
+        @param callback         the function to call for each entry that matches
+        @param wildCard         the file pattern to match. This may contain multiple patterns
+                                separated by a semi-colon or comma, e.g. "*.jpg;*.png"
+        @param whatToLookFor    a value from the File::TypesOfFileToFind enum, specifying
+                                whether to look for files, directories, or both
+        @param followSymlinks   the policy to use when symlinks are encountered
+        @param shouldCancel     if this is non-null, setting it to true from any thread will
+                                stop the search as soon as possible
+        @returns true if the whole tree was searched, or false if it was cancelled
+    */
+    static bool walk (ThreadPool& pool,
+                      const File& directory,
+                      const Callback& callback,
+                      const String& wildCard = "*",
+                      int whatToLookFor = File::findFiles,
+                      File::FollowSymlinks followSymlinks = File::FollowSymlinks::yes,
+                      const std::atomic<bool>* shouldCancel = nullptr);
+
+    ParallelDirectoryWalker() = delete;
+
+private:
+    struct Walk;
+};
+
+} // namespace juce
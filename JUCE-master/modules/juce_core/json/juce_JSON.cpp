@@ -863,6 +863,61 @@ public:
 
 static JSONTests JSONUnitTests;
 
+//==============================================================================
+class JSONBenchmarks final : public BenchmarkTest
+{
+public:
+    JSONBenchmarks()
+        : BenchmarkTest ("JSON benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    static var createDocument()
+    {
+        Array<var> items;
+
+        for (int i = 0; i < 200; ++i)
+        {
+            auto item = std::make_unique<DynamicObject>();
+            item->setProperty ("id", i);
+            item->setProperty ("name", "Item " + String (i));
+            item->setProperty ("value", i * 0.5);
+            item->setProperty ("enabled", i % 2 == 0);
+            item->setProperty ("tags", Array<var> { "a", "b", "c" });
+            items.add (var (item.release()));
+        }
+
+        auto root = std::make_unique<DynamicObject>();
+        root->setProperty ("items", items);
+        return var (root.release());
+    }
+
+    void runTest() override
+    {
+        const auto document = createDocument();
+        const auto text = JSON::toString (document);
+
+        beginTest ("Parsing and writing");
+        {
+            benchmark ("Parsing", [&]
+            {
+                doNotOptimise (JSON::parse (text));
+            });
+
+            benchmark ("Writing", [&]
+            {
+                doNotOptimise (JSON::toString (document));
+            });
+
+            benchmark ("Writing compactly", [&]
+            {
+                doNotOptimise (JSON::toString (document, true));
+            });
+        }
+    }
+};
+
+static JSONBenchmarks jsonBenchmarks;
+
 #endif
 
 } // namespace juce
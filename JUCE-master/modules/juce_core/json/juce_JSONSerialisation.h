@@ -101,6 +101,18 @@ public:
         return Visitor::convert (t, options);
     }
 
+    /** Writes the argument to a JSONStreamWriter, without building an intermediate var.
+
+        The text that is written is the same as calling JSON::writeToStream() on the result
+        of convert(). Returns false if conversion fails, in which case the writer may have
+        been left holding an incomplete document.
+    */
+    template <typename T>
+    static bool writeJSON (JSONStreamWriter& writer, const T& t, const Options& options = {})
+    {
+        return StreamVisitor::convert (writer, t, options);
+    }
+
 private:
     class Visitor
     {
@@ -250,6 +262,165 @@ private:
         std::optional<var> value;
         bool versionIncluded = true;
     };
+
+    class StreamVisitor
+    {
+    public:
+        template <typename T>
+        static bool convert (JSONStreamWriter& writer, const T& t, const Options& options)
+        {
+            constexpr auto fallbackVersion = detail::ForwardingSerialisationTraits<T>::marshallingVersion;
+            const auto versionToUse = options.getExplicitVersion()
+                                             .value_or (fallbackVersion);
+
+            if (versionToUse > fallbackVersion)
+            {
+                // The requested explicit version is higher than the declared version of the type.
+                return false;
+            }
+
+            StreamVisitor visitor { writer, versionToUse, options.getVersionIncluded() };
+            detail::doSave (visitor, t);
+            return visitor.finish();
+        }
+
+        std::optional<int> getVersion() const { return version; }
+
+        template <typename... Ts>
+        void operator() (Ts&&... ts)
+        {
+            (visit (std::forward<Ts> (ts)), ...);
+        }
+
+    private:
+        // Mirrors the states that Visitor::value passes through
+        enum class State { empty, primitive, array, object, failed };
+
+        StreamVisitor (JSONStreamWriter& w, const std::optional<int>& explicitVersion, bool includeVersion)
+            : writer (w), version (explicitVersion), versionIncluded (includeVersion)
+        {
+            if (version.has_value() && includeVersion)
+            {
+                writer.startObject();
+                writer.writeName ("__version__");
+                writer.writeInteger (*version);
+                state = State::object;
+            }
+        }
+
+        template <typename T>
+        void visit (const T& t)
+        {
+            if (! beginValue())
+                return;
+
+            if constexpr (std::is_integral_v<T>)
+                writer.writeInteger ((int64) t);
+            else if constexpr (std::is_floating_point_v<T>)
+                writer.writeDouble ((double) t);
+            else if (! convert (t))
+                state = State::failed;
+        }
+
+        template <typename T>
+        void visit (const Named<T>& named)
+        {
+            if (state == State::failed)
+                return;
+
+            if (state == State::empty)
+            {
+                writer.startObject();
+                state = State::object;
+            }
+
+            if (state != State::object)
+            {
+                // Serialisation failure! This may be caused by archiving a primitive or
+                // SerialisationSize, and then attempting to archive a named pair to the same
+                // archive instance.
+                // When using named pairs, *all* items serialised with a particular archiver must be
+                // named pairs.
+                jassertfalse;
+
+                state = State::failed;
+                return;
+            }
+
+            writer.writeName (String (named.name.data(), named.name.size()));
+
+            if (! convert (named.value))
+                state = State::failed;
+        }
+
+        template <typename T>
+        void visit (const SerialisationSize<T>&)
+        {
+            if (state == State::empty)
+            {
+                writer.startArray();
+                state = State::array;
+            }
+            else if (beginValue())
+            {
+                writer.startArray();
+                writer.endArray();
+            }
+        }
+
+        void visit (const bool& t)
+        {
+            if (beginValue())
+                writer.writeBool (t);
+        }
+
+        void visit (const String& t)
+        {
+            if (beginValue())
+                writer.writeString (t);
+        }
+
+        void visit (const var& t)
+        {
+            if (beginValue())
+                writer.writeVar (t);
+        }
+
+        template <typename T>
+        bool convert (const T& t)
+        {
+            return convert (writer, t, Options{}.withVersionIncluded (versionIncluded));
+        }
+
+        bool beginValue()
+        {
+            if (state == State::empty)
+                state = State::primitive;
+            else if (state != State::array)
+                state = State::failed;
+
+            return state != State::failed;
+        }
+
+        bool finish()
+        {
+            switch (state)
+            {
+                case State::empty:      writer.writeNull(); break;
+                case State::array:      writer.endArray(); break;
+                case State::object:     writer.endObject(); break;
+                case State::primitive:  break;
+                case State::failed:     return false;
+            }
+
+            return true;
+        }
+
+        JSONStreamWriter& writer;
+        std::optional<int> version;
+        State state = State::empty;
+        bool versionIncluded = true;
+    };
 };
 
 //==============================================================================
@@ -278,21 +449,142 @@ public:
     template <typename T>
     static std::optional<T> convert (const var& v)
     {
-        return Visitor::convert<T> (v);
+        return Visitor<VarNode>::convert<T> (VarNode { v });
+    }
+
+    /** Attempts to parse JSON-formatted text from a stream directly into an instance of type T.
+
+        This gives the same result as calling convert() on the output of JSON::parse(), but
+        reads the stream incrementally and never builds a tree of var objects, other than for
+        any members of T which are themselves of type var.
+
+        This will return a non-null optional if both parsing and conversion succeed, or nullopt
+        otherwise.
+    */
+    template <typename T>
+    static std::optional<T> readJSON (InputStream& input)
+    {
+        detail::JSONTape tape;
+
+        if (detail::JSONTape::parse (input, tape).failed() || tape.tokens.empty())
+            return std::nullopt;
+
+        return Visitor<TapeNode>::convert<T> (TapeNode { tape, 0 });
     }
 
 private:
+    // Gives the visitor a common interface to a var, or to a token in a parsed JSON document
+    class VarNode
+    {
+    public:
+        explicit VarNode (const var& v) : value (v) {}
+
+        struct Cursor
+        {
+            bool isDone() const     { return index >= size; }
+            VarNode next()          { return VarNode { array->getReference (index++) }; }
+
+            const Array<var>* array = nullptr;
+            int index = 0, size = 0;
+        };
+
+        std::optional<Cursor> getArrayCursor() const
+        {
+            if (auto* array = value.getArray())
+                return Cursor { array, 0, array->size() };
+
+            return std::nullopt;
+        }
+
+        bool isObject() const       { return value.getDynamicObject() != nullptr; }
+
+        std::optional<VarNode> getProperty (const Identifier& name) const
+        {
+            if (auto* obj = value.getDynamicObject())
+                if (obj->hasProperty (name))
+                    return VarNode { obj->getProperty (name) };
+
+            return std::nullopt;
+        }
+
+        var toVar() const           { return value; }
+
+    private:
+        var value;
+    };
+
+    class TapeNode
+    {
+    public:
+        TapeNode (const detail::JSONTape& t, int i) : tape (&t), index (i) {}
+
+        struct Cursor
+        {
+            bool isDone() const     { return remaining == 0; }
+
+            TapeNode next()
+            {
+                TapeNode result { *tape, index };
+                index = tape->tokens[(size_t) index].end;
+                --remaining;
+                return result;
+            }
+
+            const detail::JSONTape* tape = nullptr;
+            int index = 0, size = 0, remaining = 0;
+        };
+
+        std::optional<Cursor> getArrayCursor() const
+        {
+            const auto& token = getToken();
+
+            if (token.kind != Kind::array)
+                return std::nullopt;
+
+            return Cursor { tape, index + 1, token.numChildren, token.numChildren };
+        }
+
+        bool isObject() const       { return getToken().kind == Kind::object; }
+
+        std::optional<TapeNode> getProperty (const Identifier& name) const
+        {
+            const auto& token = getToken();
+
+            if (token.kind != Kind::object)
+                return std::nullopt;
+
+            std::optional<TapeNode> result;
+
+            // As in a DynamicObject, the last of any duplicated names wins
+            for (auto i = index + 1; i < token.end; i = tape->tokens[(size_t) i].end)
+                if (tape->tokens[(size_t) i].name == name.toString())
+                    result = TapeNode { *tape, i };
+
+            return result;
+        }
+
+        var toVar() const           { return tape->toVar (index); }
+
+    private:
+        using Kind = detail::JSONTape::Token::Kind;
+
+        const detail::JSONTape::Token& getToken() const  { return tape->tokens[(size_t) index]; }
+
+        const detail::JSONTape* tape = nullptr;
+        int index = 0;
+    };
+
+    template <typename Node>
     class Visitor
     {
     public:
         template <typename T>
-        static std::optional<T> convert (const var& v)
+        static std::optional<T> convert (const Node& v)
         {
             const auto version = [&]() -> std::optional<int>
             {
-                if (auto* obj = v.getDynamicObject())
-                    if (obj->hasProperty ("__version__"))
-                        return (int) obj->getProperty ("__version__");
+                if (auto property = v.getProperty ("__version__"))
+                    return (int) property->toVar();
 
                 return std::nullopt;
             }();
@@ -313,7 +605,7 @@ private:
         }
 
     private:
-        Visitor (std::optional<int> vn, const var& i)
+        Visitor (std::optional<int> vn, const Node& i)
             : version (vn), input (i) {}
 
         template <typename T>
@@ -351,9 +643,7 @@ private:
             if (! node.has_value())
                 return;
 
-            auto* obj = node->getDynamicObject();
-
-            failed = obj == nullptr || ! tryGetProperty (*obj, named);
+            failed = ! node->isObject() || ! tryGetProperty (*node, named);
         }
 
         template <typename T>
@@ -362,10 +652,10 @@ private:
             if (failed)
                 return;
 
-            if (auto* array = input.getArray())
+            if (auto arrayCursor = input.getArrayCursor())
             {
-                t.size = static_cast<T> (array->size());
-                currentArrayIndex = 0;
+                t.size = static_cast<T> (arrayCursor->size);
+                cursor = arrayCursor;
             }
             else
             {
@@ -385,7 +675,7 @@ private:
 
         void visit (var& t)
         {
-            t = input;
+            t = input.toVar();
         }
 
         static std::optional<double> pullTyped (std::in_place_type_t<double>, const var& source)
@@ -408,21 +698,16 @@ private:
             return source.isString() ? std::optional<String> (source.toString()) : std::nullopt;
         }
 
-        std::optional<var> getNodeToRead()
+        std::optional<Node> getNodeToRead()
         {
             if (failed)
                 return std::nullopt;
 
-            if (currentArrayIndex == std::numeric_limits<size_t>::max())
-                return input;
-
-            const auto* array = input.getArray();
-
-            if (array == nullptr)
+            if (! cursor.has_value())
                 return input;
 
-            if ((int) currentArrayIndex < array->size())
-                return array->getReference ((int) currentArrayIndex++);
+            if (! cursor->isDone())
+                return cursor->next();
 
             failed = true;
             return std::nullopt;
@@ -436,7 +721,7 @@ private:
             if (! node.has_value())
                 return;
 
-            auto typed = pullTyped (tag, *node);
+            auto typed = pullTyped (tag, node->toVar());
 
             if (typed.has_value())
                 t = static_cast<T> (*typed);
@@ -445,14 +730,14 @@ private:
         }
 
         template <typename T>
-        static bool tryGetProperty (const DynamicObject& obj, const Named<T>& n)
+        static bool tryGetProperty (const Node& obj, const Named<T>& n)
         {
-            const Identifier identifier (String (n.name.data(), n.name.size()));
+            const auto property = obj.getProperty (Identifier (String (n.name.data(), n.name.size())));
 
-            if (! obj.hasProperty (identifier))
+            if (! property.has_value())
                 return false;
 
-            const auto converted = convert<T> (obj.getProperty (identifier));
+            const auto converted = convert<T> (*property);
 
             if (! converted.has_value())
                 return false;
@@ -462,8 +747,8 @@ private:
         }
 
         std::optional<int> version;
-        var input;
-        size_t currentArrayIndex = std::numeric_limits<size_t>::max();
+        Node input;
+        std::optional<typename Node::Cursor> cursor;
         bool failed = false;
     };
 };
@@ -604,9 +604,62 @@ public:
                 expect (FromVar::convert<TypeWithInnerVar> (objectWithPayload) == TypeWithInnerVar { 404, payload });
             }
         }
+
+        beginTest ("Streaming matches conversion via var");
+        {
+            expectStreamedRoundTrip (TypeWithExternalUnifiedSerialisation { 7, "hello world", { 5, 6, 7 }, { { "foo", 4 }, { "bar", 5 } } });
+            expectStreamedRoundTrip (TypeWithInternalUnifiedSerialisation { 7.89, 4.321f, "custom string", { "foo", "bar", "baz" } });
+            expectStreamedRoundTrip (TypeWithExternalSplitSerialisation { "string", { 1, 2, 3 } });
+            expectStreamedRoundTrip (TypeWithExternalSplitSerialisation { std::nullopt, {} });
+            expectStreamedRoundTrip (TypeWithInternalSplitSerialisation { "string", { 16, 32, 48 } });
+            expectStreamedRoundTrip (TypeWithVersionedSerialisation { 1, 2, 3, 4 });
+            expectStreamedRoundTrip (TypeWithRawVarLast { 200, "success", "another string" });
+            expectStreamedRoundTrip (TypeWithRawVarFirst { 200, "success", 123.456 });
+            expectStreamedRoundTrip (std::vector<int> { 1, 2, 3 });
+            expectStreamedRoundTrip (String ("hello world"));
+
+            for (auto versionIncluded : { false, true })
+            {
+                const auto options = ToVar::Options{}.withVersionIncluded (versionIncluded);
+                MemoryOutputStream streamed;
+                JSONStreamWriter writer (streamed, JSON::FormatOptions{}.withSpacing (JSON::Spacing::singleLine));
+                expect (ToVar::writeJSON (writer, TypeWithVersionedSerialisation { 1, 2, 3, 4 }, options));
+                expectEquals (streamed.toString(),
+                              JSON::toString (*ToVar::convert (TypeWithVersionedSerialisation { 1, 2, 3, 4 }, options), true));
+            }
+
+            MemoryOutputStream unused;
+            JSONStreamWriter writer (unused);
+            expect (! ToVar::writeJSON (writer, TypeWithBrokenArraySerialisation {}));
+
+            const auto readText = [] (const char* text)
+            {
+                MemoryInputStream input (text, strlen (text), false);
+                return FromVar::readJSON<TypeWithVersionedSerialisation> (input);
+            };
+
+            expect (readText (R"({ "b": 2, "d": 4, "a": 1, "c": 3, "__version__": 3 })") == TypeWithVersionedSerialisation { 1, 2, 3, 4 });
+            expect (readText (R"({ "a": 1, )") == std::nullopt);
+        }
     }
 
 private:
+    template <typename T>
+    void expectStreamedRoundTrip (const T& value)
+    {
+        MemoryOutputStream streamed;
+        JSONStreamWriter writer (streamed);
+        expect (ToVar::writeJSON (writer, value));
+        expect (writer.isComplete());
+
+        const auto viaVar = ToVar::convert (value);
+        expect (viaVar.has_value());
+        expectEquals (streamed.toString(), JSON::toString (*viaVar));
+
+        MemoryInputStream input (streamed.getData(), streamed.getDataSize(), false);
+        expect (FromVar::readJSON<T> (input) == value);
+    }
+
     void expectDeepEqual (const std::optional<var>& a, const std::optional<var>& b)
     {
         const auto text = a.has_value() && b.has_value()
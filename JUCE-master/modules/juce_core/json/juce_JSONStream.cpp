@@ -0,0 +1,1013 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct JSONStreamParserImpl
+{
+    JSONStreamParserImpl (InputStream& in, JSONStreamParser::Handler& h)
+        : input (in), handler (h) {}
+
+    using ErrorException = JSONParser::ErrorException;
+
+    //==============================================================================
+    void parse()
+    {
+        skipByteOrderMark();
+
+        for (;;)
+        {
+            if (! parseValue())
+                continue;
+
+            for (;;)
+            {
+                if (containers.empty())
+                    return;
+
+                const auto isObject = containers.back();
+
+                skipWhitespace();
+                const auto c = readByte();
+
+                if (c == ',')
+                {
+                    if (isObject)
+                        parsePropertyName();
+
+                    break;
+                }
+
+                if (c == (isObject ? '}' : ']'))
+                {
+                    containers.pop_back();
+
+                    if (isObject)
+                        handler.endObject();
+                    else
+                        handler.endArray();
+
+                    continue;
+                }
+
+                if (c < 0)
+                    throwError (isObject ? "Unexpected EOF in object declaration"
+                                         : "Unexpected EOF in array declaration");
+
+                throwError (isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    // Returns false if a container was opened, and its first element should be parsed next
+    bool parseValue()
+    {
+        skipWhitespace();
+        const auto c = readByte();
+
+        switch (c)
+        {
+            case '{':
+                handler.startObject();
+                skipWhitespace();
+
+                if (matchIf ('}'))
+                {
+                    handler.endObject();
+                    return true;
+                }
+
+                containers.push_back (true);
+                parsePropertyName();
+                return false;
+
+            case '[':
+                handler.startArray();
+                skipWhitespace();
+
+                if (matchIf (']'))
+                {
+                    handler.endArray();
+                    return true;
+                }
+
+                containers.push_back (false);
+                return false;
+
+            case '"':
+            case '\'':
+                handler.stringValue (parseString (c));
+                return true;
+
+            case '-':
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                parseNumber (c);
+                return true;
+
+            case 't':   if (matchString ("rue"))  { handler.boolValue (true);  return true; } break;
+            case 'f':   if (matchString ("alse")) { handler.boolValue (false); return true; } break;
+            case 'n':   if (matchString ("ull"))  { handler.nullValue();       return true; } break;
+
+            case -1:
+                throwError ("Unexpected EOF");
+
+            default:
+                break;
+        }
+
+        throwError ("Syntax error");
+    }
+
+    void parsePropertyName()
+    {
+        skipWhitespace();
+
+        if (readByte() != '"')
+            throwError ("Expected a property name in double-quotes");
+
+        auto name = parseString ('"');
+
+        skipWhitespace();
+
+        if (readByte() != ':')
+            throwError ("Expected ':'");
+
+        handler.propertyName (name);
+    }
+
+    //==============================================================================
+    String parseString (int quoteChar)
+    {
+        scratch.clear();
+
+        for (;;)
+        {
+            // Copy runs of plain characters straight out of the buffer
+            auto start = position;
+
+            while (position < numBuffered)
+            {
+                const auto b = buffer[position];
+
+                if (b == quoteChar || b == '\\' || b == '\n')
+                    break;
+
+                ++position;
+
+                if ((b & 0xc0) != 0x80)
+                    ++column;
+            }
+
+            scratch.append (reinterpret_cast<const char*> (buffer + start), (size_t) (position - start));
+
+            auto c = readByte();
+
+            if (c == quoteChar)
+                break;
+
+            if (c < 0)
+                throwError ("Unexpected EOF in string constant");
+
+            if (c == '\\')
+            {
+                c = readByte();
+
+                switch (c)
+                {
+                    case 'a': c = '\a'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'n': c = '\n'; break;
+                    case 'r': c = '\r'; break;
+                    case 't': c = '\t'; break;
+
+                    case 'u':
+                        appendCodePoint (parseEscapeSequence());
+                        continue;
+
+                    case -1:
+                        throwError ("Unexpected EOF in string constant");
+
+                    default: break;
+                }
+            }
+
+            scratch += (char) c;
+        }
+
+        return String::fromUTF8 (scratch.data(), (int) scratch.size());
+    }
+
+    int parseCodeUnit()
+    {
+        int result = 0;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto digit = CharacterFunctions::getHexDigitValue ((juce_wchar) readByte());
+
+            if (digit < 0)
+                throwError ("Invalid hex character");
+
+            result = (result << 4) | digit;
+        }
+
+        return result;
+    }
+
+    juce_wchar parseEscapeSequence()
+    {
+        const auto first = (juce_wchar) parseCodeUnit();
+
+        if (CharacterFunctions::isNonSurrogateCodePoint (first))
+            return first;
+
+        if (! CharacterFunctions::isHighSurrogate (first))
+            throwError ("Invalid UTF-16 escape sequence");
+
+        if (readByte() != '\\' || readByte() != 'u')
+            throwError ("Expected UTF-16 low surrogate");
+
+        const auto second = (juce_wchar) parseCodeUnit();
+
+        if (! CharacterFunctions::isLowSurrogate (second))
+            throwError ("Expected UTF-16 low surrogate");
+
+        return 0x10000 + ((first - 0xd800) << 10) + (second - 0xdc00);
+    }
+
+    void appendCodePoint (juce_wchar c)
+    {
+        char bytes[8] = {};
+        CharPointer_UTF8 dest (bytes);
+        dest.write (c);
+        scratch.append (bytes, (size_t) (dest.getAddress() - bytes));
+    }
+
+    //==============================================================================
+    void parseNumber (int firstChar)
+    {
+        const auto isNegative = firstChar == '-';
+        auto c = isNegative ? readByte() : firstChar;
+
+        if (! isDigit (c))
+            throwError ("Syntax error in number");
+
+        // Up to 19 significant digits are accumulated exactly, and any further digits
+        // only affect the exponent.
+        uint64 mantissa = 0;
+        int numSignificantDigits = 0, exponent = 0;
+        bool isInteger = true, isExact = true;
+
+        const auto addDigit = [&] (int digit, bool isFraction)
+        {
+            if (numSignificantDigits < 19)
+            {
+                mantissa = mantissa * 10 + (uint64) digit;
+
+                if (mantissa != 0)
+                    ++numSignificantDigits;
+
+                if (isFraction)
+                    --exponent;
+            }
+            else
+            {
+                isExact = false;
+
+                if (! isFraction)
+                    ++exponent;
+            }
+        };
+
+        addDigit (c - '0', false);
+
+        while (isDigit (peekByte()))
+            addDigit (readDigit(), false);
+
+        if (matchIf ('.'))
+        {
+            isInteger = false;
+
+            if (! isDigit (peekByte()))
+                throwError ("Syntax error in number");
+
+            while (isDigit (peekByte()))
+                addDigit (readDigit(), true);
+        }
+
+        if (peekByte() == 'e' || peekByte() == 'E')
+        {
+            readByte();
+            isInteger = false;
+
+            auto exponentIsNegative = false;
+
+            if (peekByte() == '-' || peekByte() == '+')
+            {
+                exponentIsNegative = readByte() == '-';
+            }
+
+            if (! isDigit (peekByte()))
+                throwError ("Syntax error in number");
+
+            int explicitExponent = 0;
+
+            while (isDigit (peekByte()))
+                explicitExponent = jmin (explicitExponent * 10 + readDigit(), 100000);
+
+            exponent += exponentIsNegative ? -explicitExponent : explicitExponent;
+        }
+
+        const auto next = peekByte();
+
+        if (! (next < 0 || next == ',' || next == '}' || next == ']' || isWhitespace (next)))
+            throwError ("Syntax error in number");
+
+        if (isInteger && isExact && exponent == 0)
+        {
+            if (! isNegative && mantissa <= (uint64) std::numeric_limits<int64>::max())
+                return handler.integerValue ((int64) mantissa);
+
+            if (isNegative && mantissa <= (uint64) std::numeric_limits<int64>::max() + 1)
+                return handler.integerValue ((int64) (0 - mantissa));
+        }
+
+        handler.doubleValue (toDouble (isNegative, mantissa, exponent, isExact));
+    }
+
+    static double toDouble (bool isNegative, uint64 mantissa, int exponent, bool isExact)
+    {
+        // When both the mantissa and the power of ten are exactly representable as
+        // doubles, a single multiplication or division gives a correctly-rounded result.
+        static constexpr double powersOfTen[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+        if (! isExact || mantissa > ((uint64) 1 << 53) || exponent < -22 || exponent > 22)
+        {
+            // Otherwise, fall back to the general-purpose conversion, giving it the
+            // digits in a normalised form that it can't lose precision on
+            const auto digits = String (mantissa);
+            const auto text = (isNegative ? "-" : "") + digits.substring (0, 1) + "." + digits.substring (1)
+                                + "e" + String (exponent + digits.length() - 1);
+            auto t = text.getCharPointer();
+            return CharacterFunctions::readDoubleValue (t);
+        }
+
+        auto result = (double) mantissa;
+        result = exponent < 0 ? result / powersOfTen[-exponent]
+                              : result * powersOfTen[exponent];
+
+        return isNegative ? -result : result;
+    }
+
+    int readDigit()
+    {
+        return readByte() - '0';
+    }
+
+    static bool isDigit (int c) noexcept        { return c >= '0' && c <= '9'; }
+    static bool isWhitespace (int c) noexcept   { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    //==============================================================================
+    int peekByte()
+    {
+        if (position == numBuffered && ! refill())
+            return -1;
+
+        return buffer[position];
+    }
+
+    int readByte()
+    {
+        if (position == numBuffered && ! refill())
+            return -1;
+
+        const auto b = buffer[position++];
+
+        errorLine = line;
+        errorColumn = column;
+
+        if (b == '\n')
+        {
+            ++line;
+            column = 1;
+        }
+        else if ((b & 0xc0) != 0x80)
+        {
+            ++column;
+        }
+
+        return b;
+    }
+
+    bool matchIf (char c)
+    {
+        if (peekByte() != c)
+            return false;
+
+        readByte();
+        return true;
+    }
+
+    bool matchString (const char* t)
+    {
+        while (*t != 0)
+            if (! matchIf (*t++))
+                return false;
+
+        return true;
+    }
+
+    void skipWhitespace()
+    {
+        while (isWhitespace (peekByte()))
+            readByte();
+    }
+
+    void skipByteOrderMark()
+    {
+        if (peekByte() == 0xef && numBuffered - position >= 3
+             && buffer[position + 1] == 0xbb && buffer[position + 2] == 0xbf)
+            position += 3;
+    }
+
+    bool refill()
+    {
+        // Preserve any unread bytes so that short look-aheads can span a refill
+        const auto remaining = numBuffered - position;
+        memmove (buffer, buffer + position, (size_t) remaining);
+        position = 0;
+        numBuffered = remaining;
+
+        const auto numRead = input.read (buffer + numBuffered, bufferSize - numBuffered);
+
+        if (numRead > 0)
+            numBuffered += numRead;
+
+        return numBuffered > 0;
+    }
+
+    [[noreturn]] void throwError (const char* message) const
+    {
+        ErrorException e;
+        e.message = message;
+        e.line = errorLine;
+        e.column = errorColumn;
+        throw e;
+    }
+
+    //==============================================================================
+    static constexpr int bufferSize = 16384;
+
+    InputStream& input;
+    JSONStreamParser::Handler& handler;
+    std::vector<bool> containers;
+    std::string scratch;
+    uint8 buffer[bufferSize];
+    int position = 0, numBuffered = 0;
+    int line = 1, column = 1, errorLine = 1, errorColumn = 1;
+};
+
+Result JSONStreamParser::parse (InputStream& input, Handler& handler)
+{
+    try
+    {
+        auto impl = std::make_unique<JSONStreamParserImpl> (input, handler);
+        impl->parse();
+    }
+    catch (const JSONParser::ErrorException& error)
+    {
+        return error.getResult();
+    }
+
+    return Result::ok();
+}
+
+//==============================================================================
+JSONStreamWriter::JSONStreamWriter (OutputStream& o, const JSON::FormatOptions& f)
+    : out (o), format (f)
+{
+}
+
+void JSONStreamWriter::startObject()    { startContainer (true); }
+void JSONStreamWriter::endObject()      { endContainer (true); }
+void JSONStreamWriter::startArray()     { startContainer (false); }
+void JSONStreamWriter::endArray()       { endContainer (false); }
+
+void JSONStreamWriter::writeName (StringRef name)
+{
+    // Names can only be written inside an object, once per value
+    jassert (! levels.empty() && levels.back().isObject && ! nameWritten);
+
+    auto& level = levels.back();
+
+    if (level.numItems++ > 0)
+    {
+        out << ',';
+
+        if (format.getSpacing() == JSON::Spacing::singleLine)
+            out << ' ';
+        else if (format.getSpacing() == JSON::Spacing::multiLine)
+            out << newLine;
+    }
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+        JSONFormatter::writeSpaces (out, getIndent());
+
+    out << '"';
+    JSONFormatter::writeString (out, name.text, format.getEncoding());
+    out << "\":";
+
+    if (format.getSpacing() != JSON::Spacing::none)
+        out << ' ';
+
+    nameWritten = true;
+}
+
+void JSONStreamWriter::writeString (StringRef text)
+{
+    startValue();
+    out << '"';
+    JSONFormatter::writeString (out, text.text, format.getEncoding());
+    out << '"';
+    finishValue();
+}
+
+void JSONStreamWriter::writeInteger (int64 value)
+{
+    startValue();
+    out << String (value);
+    finishValue();
+}
+
+void JSONStreamWriter::writeDouble (double value)
+{
+    startValue();
+
+    if (juce_isfinite (value))
+        out << serialiseDouble (value, format.getMaxDecimalPlaces());
+    else
+        out << "null";
+
+    finishValue();
+}
+
+void JSONStreamWriter::writeBool (bool value)
+{
+    startValue();
+    out << (value ? "true" : "false");
+    finishValue();
+}
+
+void JSONStreamWriter::writeNull()
+{
+    startValue();
+    out << "null";
+    finishValue();
+}
+
+void JSONStreamWriter::writeVar (const var& value)
+{
+    startValue();
+    JSON::writeToStream (out, value, format.withIndentLevel (getIndent()));
+    finishValue();
+}
+
+void JSONStreamWriter::startValue()
+{
+    // Only one top-level value can be written
+    jassert (! complete);
+
+    if (levels.empty())
+        return;
+
+    auto& level = levels.back();
+
+    if (level.isObject)
+    {
+        // Values inside an object must be preceded by a call to writeName()
+        jassert (nameWritten);
+        nameWritten = false;
+        return;
+    }
+
+    if (level.numItems++ > 0)
+    {
+        out << ',';
+
+        if (format.getSpacing() == JSON::Spacing::singleLine)
+            out << ' ';
+    }
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        out << newLine;
+        JSONFormatter::writeSpaces (out, getIndent());
+    }
+}
+
+void JSONStreamWriter::finishValue()
+{
+    complete = levels.empty();
+}
+
+void JSONStreamWriter::startContainer (bool isObject)
+{
+    startValue();
+    out << (isObject ? '{' : '[');
+
+    // An object always begins a new line, even when it turns out to be empty
+    if (isObject && format.getSpacing() == JSON::Spacing::multiLine)
+        out << newLine;
+
+    levels.push_back ({ isObject, 0 });
+}
+
+void JSONStreamWriter::endContainer (bool isObject)
+{
+    // Every container must be closed by the matching end call
+    jassert (! levels.empty() && levels.back().isObject == isObject && ! nameWritten);
+
+    if (levels.empty())
+        return;
+
+    const auto numItems = levels.back().numItems;
+    levels.pop_back();
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        if (numItems > 0)
+        {
+            out << newLine;
+            JSONFormatter::writeSpaces (out, getIndent());
+        }
+        else if (isObject)
+        {
+            JSONFormatter::writeSpaces (out, getIndent());
+        }
+    }
+
+    out << (isObject ? '}' : ']');
+    finishValue();
+}
+
+int JSONStreamWriter::getIndent() const noexcept
+{
+    return format.getIndentLevel() + (int) levels.size() * JSONFormatter::indentSize;
+}
+
+//==============================================================================
+namespace detail
+{
+
+struct JSONTapeBuilder final : public JSONStreamParser::Handler
+{
+    explicit JSONTapeBuilder (std::vector<JSONTape::Token>& t) : tokens (t) {}
+
+    using Kind = JSONTape::Token::Kind;
+
+    void startObject() override                   { openContainer (Kind::object); }
+    void endObject() override                     { closeContainer(); }
+    void startArray() override                    { openContainer (Kind::array); }
+    void endArray() override                      { closeContainer(); }
+    void propertyName (const String& n) override  { name = n; }
+
+    void stringValue (const String& s) override   { add (Kind::string).text = s; }
+    void integerValue (int64 v) override          { add (Kind::integer).intValue = v; }
+    void doubleValue (double v) override          { add (Kind::floating).doubleValue = v; }
+    void boolValue (bool v) override              { add (Kind::boolean).intValue = v ? 1 : 0; }
+    void nullValue() override                     { add (Kind::null); }
+
+private:
+    JSONTape::Token& add (Kind kind)
+    {
+        if (! openContainers.empty())
+            ++tokens[(size_t) openContainers.back()].numChildren;
+
+        auto& token = tokens.emplace_back();
+        token.kind = kind;
+        token.name = std::exchange (name, {});
+        token.end = (int) tokens.size();
+        return token;
+    }
+
+    void openContainer (Kind kind)
+    {
+        add (kind);
+        openContainers.push_back ((int) tokens.size() - 1);
+    }
+
+    void closeContainer()
+    {
+        tokens[(size_t) openContainers.back()].end = (int) tokens.size();
+        openContainers.pop_back();
+    }
+
+    std::vector<JSONTape::Token>& tokens;
+    std::vector<int> openContainers;
+    String name;
+};
+
+Result JSONTape::parse (InputStream& input, JSONTape& result)
+{
+    result.tokens.clear();
+    JSONTapeBuilder builder (result.tokens);
+    return JSONStreamParser::parse (input, builder);
+}
+
+var JSONTape::toVar (int index) const
+{
+    const auto& token = tokens[(size_t) index];
+
+    switch (token.kind)
+    {
+        case Token::Kind::null:       return {};
+        case Token::Kind::boolean:    return token.intValue != 0;
+        case Token::Kind::floating:   return token.doubleValue;
+        case Token::Kind::string:     return token.text;
+
+        case Token::Kind::integer:
+            return token.intValue == (int) token.intValue ? var ((int) token.intValue)
+                                                          : var (token.intValue);
+
+        case Token::Kind::array:
+        {
+            Array<var> array;
+            array.ensureStorageAllocated (token.numChildren);
+
+            for (auto i = index + 1; i < token.end; i = tokens[(size_t) i].end)
+                array.add (toVar (i));
+
+            return array;
+        }
+
+        case Token::Kind::object:
+        {
+            auto object = std::make_unique<DynamicObject>();
+
+            for (auto i = index + 1; i < token.end; i = tokens[(size_t) i].end)
+                object->setProperty (tokens[(size_t) i].name, toVar (i));
+
+            return object.release();
+        }
+    }
+
+    return {};
+}
+
+} // namespace detail
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONStreamTests final : public UnitTest
+{
+public:
+    JSONStreamTests()
+        : UnitTest ("JSONStream", UnitTestCategories::json)
+    {}
+
+    struct Recorder final : public JSONStreamParser::Handler
+    {
+        void startObject() override                   { events.add ("{"); }
+        void endObject() override                     { events.add ("}"); }
+        void startArray() override                    { events.add ("["); }
+        void endArray() override                      { events.add ("]"); }
+        void propertyName (const String& n) override  { events.add ("name:" + n); }
+        void stringValue (const String& s) override   { events.add ("str:" + s); }
+        void integerValue (int64 v) override          { events.add ("int:" + String (v)); }
+        void doubleValue (double v) override          { events.add ("dbl:" + String (v)); doubles.add (v); }
+        void boolValue (bool v) override              { events.add (v ? "true" : "false"); }
+        void nullValue() override                     { events.add ("null"); }
+
+        StringArray events;
+        Array<double> doubles;
+    };
+
+    static Result parse (const String& text, Recorder& recorder)
+    {
+        MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+        return JSONStreamParser::parse (stream, recorder);
+    }
+
+    static var parseViaTape (const String& text)
+    {
+        MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+        detail::JSONTape tape;
+
+        if (detail::JSONTape::parse (stream, tape).failed() || tape.tokens.empty())
+            return {};
+
+        return tape.toVar (0);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Events are reported in document order");
+        {
+            Recorder recorder;
+            expect (parse (R"({ "a": [1, -2.5, "x\n\u00e9", true, false, null], "b": {}, "c": [] })", recorder).wasOk());
+            expectEquals (recorder.events.joinIntoString (" "),
+                          String::fromUTF8 ("{ name:a [ int:1 dbl:-2.5 str:x\n\xc3\xa9 true false null ] name:b { } name:c [ ] }"));
+        }
+
+        beginTest ("Numbers");
+        {
+            Recorder recorder;
+            expect (parse ("[0, -0, 9223372036854775807, -9223372036854775808, 9223372036854775808, "
+                           "1e3, 0.1, 123.456e-2, 1.7976931348623157e308, 2.2250738585072014e-308, 3.14159265358979323846264338]", recorder).wasOk());
+
+            expectEquals (recorder.events[1], String ("int:0"));
+            expectEquals (recorder.events[2], String ("int:0"));
+            expectEquals (recorder.events[3], String ("int:9223372036854775807"));
+            expectEquals (recorder.events[4], String ("int:-9223372036854775808"));
+
+            const double expected[] = { 9223372036854775808.0, 1000.0, 0.1, 1.23456,
+                                        1.7976931348623157e308, 2.2250738585072014e-308, 3.14159265358979323846 };
+            expectEquals (recorder.doubles.size(), (int) std::size (expected));
+
+            for (int i = 0; i < recorder.doubles.size(); ++i)
+                expect (exactlyEqual (recorder.doubles[i], expected[i]), String (recorder.doubles[i], 20));
+
+            Random r;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                const auto value = (r.nextDouble() - 0.5) * std::pow (10.0, r.nextInt ({ -30, 30 }));
+                const auto text = serialiseDouble (value);
+
+                Recorder single;
+                expect (parse (text, single).wasOk());
+                expect (single.doubles.size() == 1 && exactlyEqual (single.doubles[0], std::strtod (text.toRawUTF8(), nullptr)), text);
+            }
+        }
+
+        beginTest ("Errors report their location");
+        {
+            Recorder recorder;
+            const auto result = parse ("{\n  \"a\": 1,\n  \"b\" 2\n}", recorder);
+            expect (result.failed());
+            expectEquals (result.getErrorMessage(), String ("3:7: error: Expected ':'"));
+
+            expect (parse ("[1, 2", recorder).failed());
+            expect (parse ("{\"a\": tru}", recorder).failed());
+            expect (parse ("[1.]", recorder).failed());
+            expect (parse ("[\"abc", recorder).failed());
+            expect (parse ("", recorder).failed());
+        }
+
+        beginTest ("Long strings and deep nesting span buffer boundaries");
+        {
+            const auto longString = String::repeatedString (String::fromUTF8 ("ab\xc3\xa9"), 20000);
+            const auto depth = 50000;
+            const auto text = "[\"" + longString + "\"," + String::repeatedString ("[", depth) + String::repeatedString ("]", depth) + "]";
+
+            Recorder recorder;
+            expect (parse (text, recorder).wasOk());
+            expectEquals (recorder.events[1], "str:" + longString);
+            expectEquals (recorder.events.size(), 3 + depth * 2);
+        }
+
+        beginTest ("Tape matches JSON::fromString");
+        {
+            Random r;
+
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto v = createRandomVar (r, 4);
+                const auto text = JSON::toString (v);
+                expect (JSONUtils::deepEqual (parseViaTape (text), JSON::fromString (text)), text);
+            }
+        }
+
+        beginTest ("Writer output matches JSON::writeToStream");
+        {
+            Random r;
+
+            for (auto spacing : { JSON::Spacing::none, JSON::Spacing::singleLine, JSON::Spacing::multiLine })
+            {
+                const auto options = JSON::FormatOptions{}.withSpacing (spacing);
+
+                for (int i = 0; i < 50; ++i)
+                {
+                    const auto v = createRandomVar (r, 4);
+
+                    MemoryOutputStream streamed;
+                    JSONStreamWriter writer (streamed, options);
+                    writeEvents (writer, v);
+                    expect (writer.isComplete());
+
+                    expectEquals (streamed.toString(), JSON::toString (v, options));
+                }
+            }
+        }
+    }
+
+private:
+    static var createRandomVar (Random& r, int depth)
+    {
+        switch (r.nextInt (depth > 0 ? 8 : 6))
+        {
+            case 0:  return {};
+            case 1:  return r.nextBool();
+            case 2:  return r.nextInt ({ -1000, 1000 });
+            case 3:  return r.nextInt64();
+            case 4:  return r.nextDouble() * 1000.0;
+            case 5:  return "text " + String (r.nextInt (100)) + String::fromUTF8 (" \xe2\x82\xac \"\\");
+
+            case 6:
+            {
+                Array<var> array;
+
+                for (int i = r.nextInt (5); --i >= 0;)
+                    array.add (createRandomVar (r, depth - 1));
+
+                return array;
+            }
+
+            default:
+            {
+                auto object = std::make_unique<DynamicObject>();
+
+                for (int i = r.nextInt (5); --i >= 0;)
+                    object->setProperty ("p" + String (i), createRandomVar (r, depth - 1));
+
+                return object.release();
+            }
+        }
+    }
+
+    static void writeEvents (JSONStreamWriter& writer, const var& v)
+    {
+        if (auto* array = v.getArray())
+        {
+            writer.startArray();
+
+            for (auto& item : *array)
+                writeEvents (writer, item);
+
+            writer.endArray();
+        }
+        else if (auto* object = v.getDynamicObject())
+        {
+            writer.startObject();
+
+            for (auto& prop : object->getProperties())
+            {
+                writer.writeName (prop.name.toString());
+                writeEvents (writer, prop.value);
+            }
+
+            writer.endObject();
+        }
+        else if (v.isString())  writer.writeString (v.toString());
+        else if (v.isDouble())  writer.writeDouble ((double) v);
+        else if (v.isBool())    writer.writeBool ((bool) v);
+        else if (v.isVoid())    writer.writeNull();
+        else                    writer.writeInteger ((int64) v);
+    }
+};
+
+static JSONStreamTests jsonStreamTests;
+
+#endif
+
+} // namespace juce
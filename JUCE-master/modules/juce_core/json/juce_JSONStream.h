@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An event-driven JSON parser which reads directly from an InputStream.
+
+    Unlike JSON::parse(), this never builds a tree of var objects or loads the
+    whole document into memory: the text is read through a small buffer and each
+    element is reported to a Handler as soon as it has been parsed. This makes it
+    suitable for documents that are too large to comfortably hold in memory, or
+    for cases where only a small part of a large document is needed.
+
+    The parser reads a single JSON value (which may be an object, an array or a
+    primitive) from the stream. Any text following that value is not examined,
+    although some of it may already have been read into the parser's buffer.
+
+    @code
+    struct Counter  : public JSONStreamParser::Handler
+    {
+        void stringValue (const String&) override   { ++numStrings; }
+        int numStrings = 0;
+    };
+
+    FileInputStream stream (file);
+    Counter counter;
+    auto result = JSONStreamParser::parse (stream, counter);
+    @endcode
+
+    @see JSONStreamWriter, JSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONStreamParser
+{
+public:
+    //==============================================================================
+    /** Receives the elements of a JSON document from a JSONStreamParser.
+
+        Callbacks are made in document order. Each member of an object is reported
+        by a call to propertyName() followed by the callbacks for its value.
+    */
+    struct JUCE_API  Handler
+    {
+        virtual ~Handler() = default;
+
+        /** Called when a '{' is read. */
+        virtual void startObject() {}
+        /** Called when the '}' matching a previous startObject() is read. */
+        virtual void endObject() {}
+        /** Called when a '[' is read. */
+        virtual void startArray() {}
+        /** Called when the ']' matching a previous startArray() is read. */
+        virtual void endArray() {}
+
+        /** Called with the name of each object member, just before its value. */
+        virtual void propertyName (const String&) {}
+
+        /** Called for a string value. */
+        virtual void stringValue (const String&) {}
+        /** Called for a number which has no fractional part or exponent, and which fits in an int64. */
+        virtual void integerValue (int64) {}
+        /** Called for any other number. */
+        virtual void doubleValue (double) {}
+        /** Called for 'true' or 'false'. */
+        virtual void boolValue (bool) {}
+        /** Called for 'null'. */
+        virtual void nullValue() {}
+    };
+
+    //==============================================================================
+    /** Parses a JSON value from the stream, passing its contents to the handler.
+
+        If the text is malformed, this returns a failed Result describing the line
+        and column of the problem. In that case the handler will already have
+        received callbacks for everything before the error.
+    */
+    static Result parse (InputStream& input, Handler& handler);
+
+private:
+    //==============================================================================
+    JSONStreamParser() = delete; // This class can't be instantiated - just use its static methods.
+};
+
+//==============================================================================
+/**
+    Writes JSON-formatted text to an OutputStream one element at a time.
+
+    This produces the same text as JSON::writeToStream() would for an equivalent
+    var, but without having to build that var first, so arbitrarily large
+    documents can be written with a constant amount of memory.
+
+    @code
+    JSONStreamWriter writer (stream, JSON::FormatOptions{}.withSpacing (JSON::Spacing::none));
+
+    writer.startObject();
+    writer.writeName ("values");
+    writer.startArray();
+
+    for (auto v : values)
+        writer.writeDouble (v);
+
+    writer.endArray();
+    writer.endObject();
+    @endcode
+
+    Inside an object, every value must be preceded by a call to writeName().
+
+    @see JSONStreamParser, JSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONStreamWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer which appends text to the given stream. The stream must
+        outlive the writer.
+    */
+    explicit JSONStreamWriter (OutputStream& output,
+                               const JSON::FormatOptions& format = {});
+
+    //==============================================================================
+    /** Writes a '{' and begins a new object. */
+    void startObject();
+
+    /** Closes the object that was most recently started. */
+    void endObject();
+
+    /** Writes a '[' and begins a new array. */
+    void startArray();
+
+    /** Closes the array that was most recently started. */
+    void endArray();
+
+    /** Writes the name of the next member of the current object. */
+    void writeName (StringRef name);
+
+    //==============================================================================
+    /** Writes a quoted, escaped string value. */
+    void writeString (StringRef text);
+
+    /** Writes an integer value. */
+    void writeInteger (int64 value);
+
+    /** Writes a floating-point value. Non-finite values are written as null. */
+    void writeDouble (double value);
+
+    /** Writes 'true' or 'false'. */
+    void writeBool (bool value);
+
+    /** Writes 'null'. */
+    void writeNull();
+
+    /** Writes an entire var, exactly as JSON::writeToStream() would. */
+    void writeVar (const var& value);
+
+    //==============================================================================
+    /** Returns true once a complete top-level value has been written. */
+    bool isComplete() const noexcept            { return complete; }
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        bool isObject = false;
+        int numItems = 0;
+    };
+
+    void startValue();
+    void startContainer (bool isObject);
+    void endContainer (bool isObject);
+    void finishValue();
+    int getIndent() const noexcept;
+
+    OutputStream& out;
+    JSON::FormatOptions format;
+    std::vector<Level> levels;
+    bool nameWritten = false, complete = false;
+
+    JUCE_DECLARE_NON_COPYABLE (JSONStreamWriter)
+};
+
+#ifndef DOXYGEN
+namespace detail
+{
+
+/*  A flat, read-only representation of a parsed JSON document.
+
+    Each token stores the index of the token following its last descendant, so
+    that siblings can be skipped over without walking their contents. This is
+    what FromVar::readJSON() binds to, rather than building a tree of vars.
+*/
+struct JSONTape
+{
+    struct Token
+    {
+        enum class Kind : uint8 { null, boolean, integer, floating, string, array, object };
+
+        String name, text;
+        int64 intValue = 0;
+        double doubleValue = 0.0;
+        int end = 0, numChildren = 0;
+        Kind kind = Kind::null;
+    };
+
+    static Result parse (InputStream& input, JSONTape& result);
+
+    var toVar (int index) const;
+
+    std::vector<Token> tokens;
+};
+
+} // namespace detail
+#endif
+
+} // namespace juce
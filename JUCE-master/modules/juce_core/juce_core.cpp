@@ -53,6 +53,14 @@
 #include <locale>
 #include <thread>
 
+#if JUCE_INTEL && (defined (__SSE2__) || JUCE_MSVC)
+ #include <emmintrin.h>
+ #define JUCE_CORE_USE_SSE2 1
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+ #include <arm_neon.h>
+ #define JUCE_CORE_USE_NEON 1
+#endif
+
 #if ! (JUCE_ANDROID || JUCE_BSD)
  #include <sys/timeb.h>
  #include <cwctype>
@@ -67,6 +75,7 @@
 
  #if ! JUCE_DONT_AUTOLINK_TO_WIN32_LIBRARIES
   #pragma comment (lib, "DbgHelp.lib")
+  #pragma comment (lib, "Synchronization.lib")
  #endif
 
 #else
@@ -99,6 +108,21 @@
   #endif
  #endif
 
+ #if JUCE_LINUX && __has_include (<linux/io_uring.h>)
+  #include <linux/io_uring.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #define JUCE_USE_IO_URING 1
+ #endif
+
+ #if JUCE_LINUX || JUCE_ANDROID
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <sys/timerfd.h>
+  #include <sys/eventfd.h>
+  #include <poll.h>
+ #endif
+
  #include <pwd.h>
  #include <fcntl.h>
  #include <netdb.h>
@@ -116,6 +140,15 @@
 #if JUCE_MAC || JUCE_IOS
  #include <xlocale.h>
  #include <mach/mach.h>
+
+ #if JUCE_ENABLE_PERFORMANCE_TRACING
+  #include <os/signpost.h>
+ #endif
+#endif
+
+#if JUCE_MSVC && JUCE_ENABLE_PERFORMANCE_TRACING
+ #include <TraceLoggingProvider.h>
+ #include <winmeta.h>
 #endif
 
 #if JUCE_ANDROID
@@ -138,15 +171,19 @@
 #include "files/juce_File.cpp"
 #include "files/juce_FileInputStream.cpp"
 #include "files/juce_FileOutputStream.cpp"
+#include "files/juce_AsyncFileReader.cpp"
 #include "files/juce_FileSearchPath.cpp"
 #include "files/juce_TemporaryFile.cpp"
 #include "logging/juce_FileLogger.cpp"
 #include "logging/juce_Logger.cpp"
+#include "logging/juce_AsyncFileLogger.cpp"
 #include "maths/juce_BigInteger.cpp"
 #include "maths/juce_Expression.cpp"
 #include "maths/juce_Random.cpp"
+#include "maths/juce_FastRandom.cpp"
 #include "memory/juce_MemoryBlock.cpp"
 #include "memory/juce_AllocationHooks.cpp"
+#include "memory/juce_SharedMemoryRingBuffer.cpp"
 #include "misc/juce_RuntimePermissions.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
@@ -164,6 +201,7 @@
 #include "zip/juce_zlib.h"
 #include "network/juce_NamedPipe.cpp"
 #include "network/juce_Socket.cpp"
+#include "network/juce_SocketReactor.cpp"
 #include "network/juce_IPAddress.cpp"
 #include "streams/juce_BufferedInputStream.cpp"
 #include "streams/juce_FileInputSource.cpp"
@@ -183,19 +221,29 @@
 #include "text/juce_TextDiff.cpp"
 #include "text/juce_Base64.cpp"
 #include "threads/juce_ReadWriteLock.cpp"
+#include "threads/juce_RealtimeSafety.cpp"
+#include "threads/juce_LockProfiler.cpp"
+#include "misc/juce_PerformanceTracing.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_TaskGroup.cpp"
+#include "threads/juce_ParallelFor.cpp"
+#include "files/juce_ParallelDirectoryWalker.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
+#include "streams/juce_ReadAheadInputStream.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_BenchmarkTest.cpp"
 #include "containers/juce_Variant.cpp"
 #include "json/juce_JSON.cpp"
 #include "json/juce_JSONUtils.cpp"
+#include "json/juce_JSONStream.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlStreamReader.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
@@ -275,6 +323,7 @@
 #include "files/juce_common_MimeTypes.h"
 #include "files/juce_common_MimeTypes.cpp"
 #include "native/juce_AndroidDocument_android.cpp"
+#include "native/juce_PlatformTimer_precise.cpp"
 #include "threads/juce_HighResolutionTimer.cpp"
 #include "threads/juce_WaitableEvent.cpp"
 #include "network/juce_URL.cpp"
@@ -282,20 +331,26 @@
 #if ! JUCE_WASM
  #include "threads/juce_ChildProcess.cpp"
  #include "network/juce_WebInputStream.cpp"
+ #include "network/juce_WebRequestQueue.cpp"
  #include "streams/juce_URLInputSource.cpp"
 #endif
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
  #include "containers/juce_HashMap_test.cpp"
+ #include "containers/juce_FlatHashMap_test.cpp"
  #include "containers/juce_Optional_test.cpp"
  #include "containers/juce_Enumerate_test.cpp"
  #include "containers/juce_ListenerList_test.cpp"
  #include "maths/juce_MathsFunctions_test.cpp"
  #include "misc/juce_EnumHelpers_test.cpp"
  #include "containers/juce_FixedSizeFunction_test.cpp"
+ #include "containers/juce_MultiProducerFifo_test.cpp"
  #include "json/juce_JSONSerialisation_test.cpp"
  #include "memory/juce_SharedResourcePointer_test.cpp"
+ #include "threads/juce_RealtimeSafety_test.cpp"
+ #include "threads/juce_LockProfiler_test.cpp"
+ #include "misc/juce_PerformanceTracing_test.cpp"
  #include "text/juce_CharPointer_UTF8_test.cpp"
  #include "text/juce_CharPointer_UTF16_test.cpp"
  #include "text/juce_CharPointer_UTF32_test.cpp"
@@ -197,6 +197,34 @@
  #define JUCE_ENABLE_ALLOCATION_HOOKS 0
 #endif
 
+/** Config: JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+    If enabled, allocations, lock contention and blocking calls made on realtime threads, such as
+    the audio callback, will be counted and recorded by the RealtimeSafety class. Detecting
+    allocations also requires JUCE_ENABLE_ALLOCATION_HOOKS.
+*/
+#ifndef JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+ #define JUCE_ENABLE_REALTIME_SAFETY_CHECKS 0
+#endif
+
+/** Config: JUCE_ENABLE_LOCK_PROFILING
+    If enabled, every CriticalSection and SpinLock records how often it is acquired, how
+    often and for how long threads have to wait for it, and which threads hold it. The
+    results can be retrieved from the LockProfiler class.
+*/
+#ifndef JUCE_ENABLE_LOCK_PROFILING
+ #define JUCE_ENABLE_LOCK_PROFILING 0
+#endif
+
+/** Config: JUCE_ENABLE_PERFORMANCE_TRACING
+    If enabled, the PerformanceTracing class records counters, gauges and histograms, and
+    can capture trace events from JUCE_SCOPED_TRACE to view in Perfetto, Instruments or
+    Windows Performance Analyzer. JUCE's own graph processing, audio callbacks, painting,
+    message dispatch and file I/O are already instrumented.
+*/
+#ifndef JUCE_ENABLE_PERFORMANCE_TRACING
+ #define JUCE_ENABLE_PERFORMANCE_TRACING 0
+#endif
+
 #ifndef JUCE_STRING_UTF_TYPE
  #define JUCE_STRING_UTF_TYPE 8
 #endif
@@ -297,10 +325,12 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "text/juce_Base64.h"
 #include "misc/juce_Functional.h"
 #include "containers/juce_Span.h"
+#include "containers/juce_MultiProducerFifo.h"
 #include "misc/juce_Result.h"
 #include "misc/juce_Uuid.h"
 #include "misc/juce_ConsoleApplication.h"
 #include "containers/juce_Variant.h"
+#include "containers/juce_FlatHashMap.h"
 #include "containers/juce_NamedValueSet.h"
 #include "json/juce_JSON.h"
 #include "containers/juce_DynamicObject.h"
@@ -321,6 +351,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "detail/juce_NativeFileHandle.h"
 #include "files/juce_FileInputStream.h"
 #include "files/juce_FileOutputStream.h"
+#include "files/juce_AsyncFileReader.h"
 #include "files/juce_FileSearchPath.h"
 #include "files/juce_MemoryMappedFile.h"
 #include "files/juce_TemporaryFile.h"
@@ -329,11 +360,13 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "streams/juce_FileInputSource.h"
 #include "logging/juce_FileLogger.h"
 #include "json/juce_JSONUtils.h"
+#include "json/juce_JSONStream.h"
 #include "serialisation/juce_Serialisation.h"
 #include "json/juce_JSONSerialisation.h"
 #include "maths/juce_BigInteger.h"
 #include "maths/juce_Expression.h"
 #include "maths/juce_Random.h"
+#include "maths/juce_FastRandom.h"
 #include "misc/juce_RuntimePermissions.h"
 #include "misc/juce_WindowsRegistry.h"
 #include "threads/juce_ChildProcess.h"
@@ -346,7 +379,11 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "threads/juce_HighResolutionTimer.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
+#include "threads/juce_TaskGroup.h"
+#include "threads/juce_ParallelFor.h"
+#include "files/juce_ParallelDirectoryWalker.h"
 #include "threads/juce_TimeSliceThread.h"
+#include "logging/juce_AsyncFileLogger.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
 #include "threads/juce_ScopedWriteLock.h"
@@ -354,19 +391,28 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
 #include "network/juce_Socket.h"
+#include "network/juce_SocketReactor.h"
 #include "network/juce_URL.h"
 #include "network/juce_WebInputStream.h"
+#include "network/juce_WebRequestQueue.h"
 #include "streams/juce_URLInputSource.h"
+#include "streams/juce_ReadAheadInputStream.h"
 #include "time/juce_PerformanceCounter.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_BenchmarkTest.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlStreamReader.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
 #include "containers/juce_PropertySet.h"
 #include "memory/juce_SharedResourcePointer.h"
+#include "memory/juce_SharedMemoryRingBuffer.h"
 #include "memory/juce_AllocationHooks.h"
+#include "threads/juce_RealtimeSafety.h"
+#include "threads/juce_LockProfiler.h"
+#include "misc/juce_PerformanceTracing.h"
 #include "memory/juce_Reservoir.h"
 #include "files/juce_AndroidDocument.h"
 #include "streams/juce_AndroidDocumentInputSource.h"
@@ -0,0 +1,381 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  A bounded queue which many threads can push messages into, and one thread reads from.
+
+    The storage is a ring of fixed-size slots, each with a sequence number that says
+    whether it's free or holds published data for a given lap of the ring. A message
+    that's too long for one slot claims several consecutive ones with a single
+    compare-and-swap. Its slots are published in reverse order, so once the reader
+    sees the first one, the rest are guaranteed to be ready.
+*/
+class AsyncFileLogger::MessageQueue
+{
+public:
+    explicit MessageQueue (int queueSizeBytes)
+        : numSlots ((size_t) nextPowerOfTwo (jmax (16, queueSizeBytes / (int) slotSize))),
+          mask (numSlots - 1),
+          sequences (numSlots),
+          slotCounts (numSlots),
+          messageSizes (numSlots),
+          text (numSlots * slotSize)
+    {
+        for (size_t i = 0; i < numSlots; ++i)
+            sequences[i].store (i, std::memory_order_relaxed);
+    }
+
+    bool push (const char* data, size_t numBytes) noexcept
+    {
+        const auto needed = jmax ((size_t) 1, (numBytes + slotSize - 1) / slotSize);
+
+        if (needed > numSlots)
+            return false;
+
+        auto pos = writePos.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            // The reader frees slots in order, so if the last one we need is free, so are the others
+            const auto lastPos = pos + needed - 1;
+            const auto diff = (std::ptrdiff_t) (sequences[lastPos & mask].load (std::memory_order_acquire) - lastPos);
+
+            if (diff == 0)
+            {
+                if (writePos.compare_exchange_weak (pos, pos + needed, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = writePos.load (std::memory_order_relaxed);
+            }
+        }
+
+        const auto first = pos & mask;
+        slotCounts[first] = (uint32) needed;
+        messageSizes[first] = (uint32) numBytes;
+
+        for (size_t i = 0; i < needed; ++i)
+        {
+            const auto offset = i * slotSize;
+            memcpy (text + ((pos + i) & mask) * slotSize, data + offset, jmin (slotSize, numBytes - jmin (numBytes, offset)));
+        }
+
+        for (auto i = needed; i > 0; --i)
+            sequences[(pos + i - 1) & mask].store (pos + i, std::memory_order_release);
+
+        return true;
+    }
+
+    template <typename WriteFn>
+    bool pop (WriteFn&& write)
+    {
+        const auto first = readPos & mask;
+
+        if (sequences[first].load (std::memory_order_acquire) != readPos + 1)
+            return false;
+
+        const auto needed = (size_t) slotCounts[first];
+        auto remaining = (size_t) messageSizes[first];
+
+        for (size_t i = 0; i < needed; ++i)
+        {
+            const auto index = (readPos + i) & mask;
+            const auto numBytes = jmin (slotSize, remaining);
+
+            write (text + index * slotSize, numBytes);
+            remaining -= numBytes;
+            sequences[index].store (readPos + i + numSlots, std::memory_order_release);
+        }
+
+        readPos += needed;
+        numRead.store (readPos, std::memory_order_release);
+        return true;
+    }
+
+    size_t getWritePosition() const noexcept    { return writePos.load(); }
+    size_t getReadPosition() const noexcept     { return numRead.load(); }
+
+private:
+    static constexpr size_t slotSize = 128;
+
+    const size_t numSlots, mask;
+    HeapBlock<std::atomic<size_t>> sequences;
+    HeapBlock<uint32> slotCounts, messageSizes;
+    HeapBlock<char> text;
+
+    std::atomic<size_t> writePos { 0 }, numRead { 0 };
+    size_t readPos = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (MessageQueue)
+};
+
+//==============================================================================
+AsyncFileLogger::AsyncFileLogger (const File& file,
+                                  const String& welcomeMessage,
+                                  int64 maxFileSizeBytes,
+                                  int maxNumBackupFiles,
+                                  int queueSizeBytes,
+                                  int flushIntervalMs)
+    : Thread ("AsyncFileLogger"),
+      logFile (file),
+      maxFileSize (maxFileSizeBytes),
+      maxNumBackups (jmax (0, maxNumBackupFiles)),
+      flushInterval (jmax (1, flushIntervalMs)),
+      queue (std::make_unique<MessageQueue> (queueSizeBytes))
+{
+    String welcome;
+    welcome << newLine
+            << "**********************************************************" << newLine
+            << welcomeMessage << newLine
+            << "Log started: " << Time::getCurrentTime().toString (true, true);
+
+    logMessage (welcome);
+    startThread (Priority::low);
+}
+
+AsyncFileLogger::~AsyncFileLogger()
+{
+    stopThread (-1);
+    writePendingMessages();
+}
+
+//==============================================================================
+void AsyncFileLogger::logMessage (const String& message)
+{
+    if (! queue->push (message.toRawUTF8(), message.getNumBytesAsUTF8()))
+        ++numDropped;
+}
+
+void AsyncFileLogger::flush()
+{
+    const auto target = queue->getWritePosition();
+
+    while (queue->getReadPosition() < target && isThreadRunning())
+    {
+        notify();
+        batchWritten.wait (flushInterval);
+    }
+}
+
+void AsyncFileLogger::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (flushInterval);
+        writePendingMessages();
+        batchWritten.signal();
+    }
+}
+
+void AsyncFileLogger::writePendingMessages()
+{
+    if (stream == nullptr)
+        openStream();
+
+    bool wroteAnything = false;
+
+    const auto write = [this] (const char* data, size_t numBytes)
+    {
+        if (stream != nullptr)
+            stream->write (data, numBytes);
+    };
+
+    while (queue->pop (write))
+    {
+        wroteAnything = true;
+
+        if (stream != nullptr)
+        {
+            *stream << newLine;
+
+            if (maxFileSize > 0 && stream->getPosition() > maxFileSize)
+                rotateFiles();
+        }
+    }
+
+    const auto dropped = numDropped.load();
+
+    if (dropped != numDroppedReported && stream != nullptr)
+    {
+        *stream << "(" << (dropped - numDroppedReported) << " log messages were dropped)" << newLine;
+        numDroppedReported = dropped;
+        wroteAnything = true;
+    }
+
+    if (wroteAnything && stream != nullptr)
+        stream->flush();
+}
+
+void AsyncFileLogger::openStream()
+{
+    if (! logFile.exists())
+        logFile.create();  // (to create the parent directories)
+
+    stream = std::make_unique<FileOutputStream> (logFile);
+
+    if (stream->failedToOpen())
+        stream.reset();
+}
+
+void AsyncFileLogger::rotateFiles()
+{
+    stream.reset();
+
+    const auto getBackupFile = [this] (int index)
+    {
+        return logFile.getSiblingFile (logFile.getFileNameWithoutExtension() + "." + String (index)
+                                         + logFile.getFileExtension());
+    };
+
+    if (maxNumBackups > 0)
+    {
+        getBackupFile (maxNumBackups).deleteFile();
+
+        for (int i = maxNumBackups - 1; i > 0; --i)
+            getBackupFile (i).moveFileTo (getBackupFile (i + 1));
+
+        logFile.moveFileTo (getBackupFile (1));
+    }
+
+    logFile.deleteFile();
+    openStream();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AsyncFileLoggerTests final : public UnitTest
+{
+public:
+    AsyncFileLoggerTests()
+        : UnitTest ("AsyncFileLogger", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile tempFolder;
+        const auto folder = tempFolder.getFile();
+        const auto logFile = folder.getChildFile ("test.log");
+
+        beginTest ("Messages from several threads are all written");
+        {
+            const String longMessage = String::repeatedString ("0123456789", 100);
+
+            {
+                AsyncFileLogger logger (logFile, "Welcome", 0, 0, 1024 * 1024);
+
+                std::vector<std::unique_ptr<std::thread>> threads;
+
+                for (int t = 0; t < 4; ++t)
+                    threads.push_back (std::make_unique<std::thread> ([&logger, t, &longMessage]
+                    {
+                        for (int i = 0; i < 500; ++i)
+                            logger.logMessage ("thread " + String (t) + " message " + String (i)
+                                                 + (i % 50 == 0 ? longMessage : String()));
+                    }));
+
+                for (auto& t : threads)
+                    t->join();
+
+                logger.flush();
+                expectEquals (logger.getNumDroppedMessages(), (int64) 0);
+            }
+
+            StringArray lines;
+            logFile.readLines (lines);
+            expect (lines.contains ("Welcome"));
+
+            for (int t = 0; t < 4; ++t)
+            {
+                expect (lines.contains ("thread " + String (t) + " message 1"));
+                expect (lines.contains ("thread " + String (t) + " message 499"));
+                expect (lines.contains ("thread " + String (t) + " message 450" + longMessage));
+            }
+
+            expect (logFile.deleteFile());
+        }
+
+        beginTest ("Messages are dropped when the queue is full");
+        {
+            AsyncFileLogger logger (logFile, "Welcome", 0, 0, 2048, 10000);
+
+            for (int i = 0; i < 1000; ++i)
+                logger.logMessage ("message " + String (i));
+
+            expect (logger.getNumDroppedMessages() > 0);
+            logger.flush();
+
+            StringArray lines;
+            logFile.readLines (lines);
+            expect (lines.contains ("message 0"));
+            expect (lines.joinIntoString ("\n").contains ("log messages were dropped"));
+        }
+
+        beginTest ("Files are rotated");
+        {
+            expect (logFile.deleteFile());
+
+            {
+                AsyncFileLogger logger (logFile, "Welcome", 1000, 2);
+
+                for (int i = 0; i < 200; ++i)
+                    logger.logMessage ("message " + String (i));
+            }
+
+            expect (logFile.exists());
+            expect (folder.getChildFile ("test.1.log").existsAsFile());
+            expect (folder.getChildFile ("test.2.log").existsAsFile());
+            expect (! folder.getChildFile ("test.3.log").exists());
+
+            StringArray lines;
+            logFile.readLines (lines);
+            expect (lines.contains ("message 199"));
+        }
+    }
+};
+
+static AsyncFileLoggerTests asyncFileLoggerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A Logger that writes to a file on a background thread, so that logging a
+    message never has to wait for the disk.
+
+    Calling logMessage() copies the text into a lock-free queue which is shared by
+    all the threads that log messages, and a writer thread periodically writes
+    everything that's been queued, flushing the file after each batch. This means
+    that it's safe to log from worker threads, and from realtime threads as long
+    as the String itself has been created without allocating.
+
+    If the queue fills up because messages are arriving faster than they can be
+    written, new messages are dropped rather than blocking the caller. The number of
+    messages that have been lost is available from getNumDroppedMessages(), and a
+    note is added to the log whenever this happens.
+
+    When the log file grows beyond a given size, it's renamed to "name.1.ext" (with
+    any older backups being renamed to "name.2.ext" etc.) and a new file is started.
+
+    @see FileLogger
+
+    @tags{Core}
+*/
+class JUCE_API  AsyncFileLogger  : public Logger,
+                                   private Thread
+{
+public:
+    //==============================================================================
+    /** Creates an AsyncFileLogger for a given file.
+
+        @param fileToWriteTo        the file to use - new messages will be appended to the
+                                    file. If the file doesn't exist, it will be created,
+                                    along with any parent directories that are needed.
+        @param welcomeMessage       when opened, the logger will write a header to the log, along
+                                    with the current date and time, and this welcome message
+        @param maxFileSizeBytes     when the file grows beyond this size, it will be rotated and a
+                                    new file started. If this is zero or less, the file will never
+                                    be rotated
+        @param maxNumBackupFiles    the number of rotated files to keep
+        @param queueSizeBytes       the amount of memory to use for messages that are waiting to be
+                                    written. Messages which arrive while the queue is full are dropped
+        @param flushIntervalMs      how often the writer thread should write any queued messages
+    */
+    AsyncFileLogger (const File& fileToWriteTo,
+                     const String& welcomeMessage,
+                     int64 maxFileSizeBytes = 1024 * 1024,
+                     int maxNumBackupFiles = 3,
+                     int queueSizeBytes = 64 * 1024,
+                     int flushIntervalMs = 100);
+
+    /** Destructor.
+        Any messages that are still queued will be written before the file is closed.
+    */
+    ~AsyncFileLogger() override;
+
+    //==============================================================================
+    /** Returns the file that this logger is writing to. */
+    const File& getLogFile() const noexcept               { return logFile; }
+
+    /** Returns the number of messages that have been dropped because the queue was full. */
+    int64 getNumDroppedMessages() const noexcept          { return numDropped.load(); }
+
+    /** Blocks until all the messages that were logged before this call have been
+        written to the file.
+    */
+    void flush();
+
+    // (implementation of the Logger virtual method)
+    void logMessage (const String&) override;
+
+private:
+    //==============================================================================
+    class MessageQueue;
+
+    void run() override;
+    void writePendingMessages();
+    void openStream();
+    void rotateFiles();
+
+    File logFile;
+    const int64 maxFileSize;
+    const int maxNumBackups, flushInterval;
+    std::unique_ptr<MessageQueue> queue;
+    std::unique_ptr<FileOutputStream> stream;
+    std::atomic<int64> numDropped { 0 };
+    int64 numDroppedReported = 0;
+    WaitableEvent batchWritten;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncFileLogger)
+};
+
+} // namespace juce
@@ -542,46 +542,157 @@ BigInteger& BigInteger::operator-= (const BigInteger& other)
     return *this;
 }
 
-BigInteger& BigInteger::operator*= (const BigInteger& other)
+//==============================================================================
+namespace BigIntegerHelpers
 {
-    if (this == &other)
-        return operator*= (BigInteger (other));
+    // Below this many words, the schoolbook method beats Karatsuba's extra additions
+    constexpr size_t karatsubaThreshold = 32;
 
-    auto n = getHighestBit();
-    auto t = other.getHighestBit();
+    // result[0, na + nb) += a * b
+    static void multiplyAccumulate (uint32* result, const uint32* a, size_t na, const uint32* b, size_t nb) noexcept
+    {
+        for (size_t i = 0; i < nb; ++i)
+        {
+            const auto bi = (uint64) b[i];
+            uint64 c = 0;
 
-    auto wasNegative = isNegative();
-    setNegative (false);
+            for (size_t j = 0; j < na; ++j)
+            {
+                const auto uv = (uint64) result[i + j] + (uint64) a[j] * bi + c;
+                result[i + j] = (uint32) uv;
+                c = uv >> 32;
+            }
 
-    BigInteger total;
-    total.highestBit = n + t + 1;
-    auto* totalValues = total.ensureSize (sizeNeededToHold (total.highestBit) + 1);
+            for (auto k = i + na; c != 0; ++k)
+            {
+                const auto uv = (uint64) result[k] + c;
+                result[k] = (uint32) uv;
+                c = uv >> 32;
+            }
+        }
+    }
 
-    n >>= 5;
-    t >>= 5;
+    // dest[0, n) += src[0, numSrc), propagating the carry to the end of dest
+    static void addInPlace (uint32* dest, size_t n, const uint32* src, size_t numSrc) noexcept
+    {
+        uint64 c = 0;
+        size_t i = 0;
 
-    auto m = other;
-    m.setNegative (false);
+        for (; i < numSrc; ++i)
+        {
+            c += (uint64) dest[i] + src[i];
+            dest[i] = (uint32) c;
+            c >>= 32;
+        }
 
-    auto* mValues = m.getValues();
-    auto* values = getValues();
+        for (; c != 0 && i < n; ++i)
+        {
+            c += dest[i];
+            dest[i] = (uint32) c;
+            c >>= 32;
+        }
+    }
+
+    // dest[0, n) -= src[0, numSrc), where the result is known to be non-negative
+    static void subtractInPlace (uint32* dest, size_t n, const uint32* src, size_t numSrc) noexcept
+    {
+        int64 borrow = 0;
+        size_t i = 0;
+
+        for (; i < numSrc; ++i)
+        {
+            const auto diff = (int64) dest[i] - (int64) src[i] + borrow;
+            dest[i] = (uint32) diff;
+            borrow = diff >> 32;
+        }
+
+        for (; borrow != 0 && i < n; ++i)
+        {
+            const auto diff = (int64) dest[i] + borrow;
+            dest[i] = (uint32) diff;
+            borrow = diff >> 32;
+        }
+    }
 
-    for (int i = 0; i <= t; ++i)
+    // result[0, 2n) = a * b, for two n-word operands
+    static void karatsuba (uint32* result, const uint32* a, const uint32* b, size_t n)
     {
-        uint32 c = 0;
+        std::fill (result, result + 2 * n, 0u);
 
-        for (int j = 0; j <= n; ++j)
+        if (n < karatsubaThreshold)
         {
-            auto uv = (uint64) totalValues[i + j] + (uint64) values[j] * (uint64) mValues[i] + (uint64) c;
-            totalValues[i + j] = (uint32) uv;
-            c = static_cast<uint32> (uv >> 32);
+            multiplyAccumulate (result, a, n, b, n);
+            return;
         }
 
-        totalValues[i + n + 1] = c;
+        // a = a1 * B^h + a0, b = b1 * B^h + b0
+        const auto h = n / 2, hh = n - h;
+
+        karatsuba (result, a, b, h);                 // z0 = a0 * b0
+        karatsuba (result + 2 * h, a + h, b + h, hh); // z2 = a1 * b1
+
+        std::vector<uint32> sums (2 * (hh + 1), 0), z1 (2 * (hh + 1));
+        auto* sa = sums.data();
+        auto* sb = sums.data() + hh + 1;
+
+        std::copy (a + h, a + n, sa);
+        addInPlace (sa, hh + 1, a, h);
+        std::copy (b + h, b + n, sb);
+        addInPlace (sb, hh + 1, b, h);
+
+        // z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+        karatsuba (z1.data(), sa, sb, hh + 1);
+        subtractInPlace (z1.data(), z1.size(), result, 2 * h);
+        subtractInPlace (z1.data(), z1.size(), result + 2 * h, 2 * hh);
+
+        addInPlace (result + h, 2 * n - h, z1.data(), std::min (z1.size(), 2 * n - h));
     }
 
+    // result[0, na + nb) = a * b
+    static void multiply (uint32* result, const uint32* a, size_t na, const uint32* b, size_t nb)
+    {
+        if (na < nb)
+        {
+            std::swap (a, b);
+            std::swap (na, nb);
+        }
+
+        // Karatsuba only pays off when the operands are both large and of similar sizes
+        if (nb >= karatsubaThreshold && na <= 2 * nb)
+        {
+            std::vector<uint32> paddedB (na, 0), product (2 * na);
+            std::copy (b, b + nb, paddedB.begin());
+            karatsuba (product.data(), a, paddedB.data(), na);
+            std::copy (product.begin(), product.begin() + (ptrdiff_t) (na + nb), result);
+            return;
+        }
+
+        std::fill (result, result + na + nb, 0u);
+        multiplyAccumulate (result, a, na, b, nb);
+    }
+}
+
+BigInteger& BigInteger::operator*= (const BigInteger& other)
+{
+    if (this == &other)
+        return operator*= (BigInteger (other));
+
+    auto n = getHighestBit();
+    auto t = other.getHighestBit();
+
+    if (n < 0 || t < 0)
+        return clear();
+
+    BigInteger total;
+    total.highestBit = n + t + 1;
+    auto* totalValues = total.ensureSize (sizeNeededToHold (total.highestBit) + 1);
+
+    BigIntegerHelpers::multiply (totalValues,
+                                 getValues(), sizeNeededToHold (n),
+                                 other.getValues(), sizeNeededToHold (t));
+
     total.highestBit = total.getHighestBit();
-    total.setNegative (wasNegative ^ other.isNegative());
+    total.setNegative (isNegative() ^ other.isNegative());
     swapWith (total);
 
     return *this;
@@ -957,45 +1068,149 @@ void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& m
     }
     else
     {
-        auto Rfactor = modulus.getHighestBit() + 1;
-        BigInteger R (1);
-        R.shiftLeft (Rfactor, 0);
+        if (isNegative())
+            *this += modulus;
+
+        // Montgomery reduction, working directly on the words of the numbers. With an odd
+        // modulus m of s words, and R = 2^(32 * s), each product is reduced word by word
+        // (the CIOS method), which avoids any division in the main loop.
+        const auto s = sizeNeededToHold (modulus.getHighestBit());
+        const auto* m = modulus.getValues();
+
+        // m' = -m^-1 mod 2^32, found by Newton's iteration, which doubles the correct bits each time
+        auto inverse = m[0];
 
-        BigInteger R1, m1, g;
-        g.extendedEuclidean (modulus, R, m1, R1);
+        for (int i = 0; i < 4; ++i)
+            inverse *= 2 - m[0] * inverse;
 
-        if (! g.isOne())
+        const auto mPrime = (uint32) (0 - inverse);
+
+        std::vector<uint32> t (s + 2);
+
+        const auto montgomeryMultiply = [&] (uint32* result, const uint32* a, const uint32* b)
         {
-            BigInteger a (*this);
+            std::fill (t.begin(), t.end(), 0u);
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
+            for (size_t i = 0; i < s; ++i)
             {
-                *this *= *this;
+                const auto bi = (uint64) b[i];
+                uint64 c = 0;
+
+                for (size_t j = 0; j < s; ++j)
+                {
+                    const auto uv = (uint64) t[j] + (uint64) a[j] * bi + c;
+                    t[j] = (uint32) uv;
+                    c = uv >> 32;
+                }
+
+                auto uv = (uint64) t[s] + c;
+                t[s] = (uint32) uv;
+                t[s + 1] = (uint32) (uv >> 32);
 
-                if (exp[i])
-                    *this *= a;
+                const auto q = (uint64) (uint32) (t[0] * mPrime);
+                c = ((uint64) t[0] + q * m[0]) >> 32;
+
+                for (size_t j = 1; j < s; ++j)
+                {
+                    uv = (uint64) t[j] + q * m[j] + c;
+                    t[j - 1] = (uint32) uv;
+                    c = uv >> 32;
+                }
 
-                if (compareAbsolute (modulus) >= 0)
-                    *this %= modulus;
+                uv = (uint64) t[s] + c;
+                t[s - 1] = (uint32) uv;
+                t[s] = t[s + 1] + (uint32) (uv >> 32);
             }
-        }
-        else
+
+            // The result is less than 2m, so at most one subtraction is needed
+            auto needsSubtract = t[s] != 0;
+
+            if (! needsSubtract)
+            {
+                needsSubtract = true;
+
+                for (auto i = s; i-- > 0;)
+                {
+                    if (t[i] != m[i])
+                    {
+                        needsSubtract = t[i] > m[i];
+                        break;
+                    }
+                }
+            }
+
+            if (needsSubtract)
+                BigIntegerHelpers::subtractInPlace (t.data(), s + 1, m, s);
+
+            std::copy (t.begin(), t.begin() + (ptrdiff_t) s, result);
+        };
+
+        const auto toMontgomery = [&] (const BigInteger& value)
+        {
+            auto shifted = value;
+            shifted.shiftLeft ((int) s * 32, 0);
+            shifted %= modulus;
+
+            std::vector<uint32> words (s, 0);
+            std::copy (shifted.getValues(), shifted.getValues() + std::min (s, sizeNeededToHold (jmax (0, shifted.getHighestBit()))), words.begin());
+            return words;
+        };
+
+        // Sliding window exponentiation: precompute the odd powers of the base, so that each
+        // window of up to w exponent bits costs a single multiplication
+        const auto expBits = exp.getHighestBit() + 1;
+        const auto w = expBits > 671 ? 6 : expBits > 239 ? 5 : expBits > 79 ? 4 : expBits > 23 ? 3 : 1;
+
+        std::vector<std::vector<uint32>> oddPowers ((size_t) 1 << (w - 1));
+        oddPowers[0] = toMontgomery (*this);
+
+        if (oddPowers.size() > 1)
         {
-            auto am  = (*this * R) % modulus;
-            auto xm = am;
-            auto um = R % modulus;
+            std::vector<uint32> square (s);
+            montgomeryMultiply (square.data(), oddPowers[0].data(), oddPowers[0].data());
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
+            for (size_t i = 1; i < oddPowers.size(); ++i)
             {
-                xm.montgomeryMultiplication (xm, modulus, m1, Rfactor);
+                oddPowers[i].resize (s);
+                montgomeryMultiply (oddPowers[i].data(), oddPowers[i - 1].data(), square.data());
+            }
+        }
 
-                if (exp[i])
-                    xm.montgomeryMultiplication (am, modulus, m1, Rfactor);
+        auto x = toMontgomery (1);
+
+        for (int i = expBits - 1; i >= 0;)
+        {
+            if (! exp[i])
+            {
+                montgomeryMultiply (x.data(), x.data(), x.data());
+                --i;
+                continue;
             }
 
-            xm.montgomeryMultiplication (1, modulus, m1, Rfactor);
-            swapWith (xm);
+            // Find the longest window starting at bit i that ends with a set bit
+            auto low = jmax (0, i - w + 1);
+
+            while (! exp[low])
+                ++low;
+
+            for (int j = i; j >= low; --j)
+                montgomeryMultiply (x.data(), x.data(), x.data());
+
+            const auto window = exp.getBitRangeAsInt (low, i - low + 1);
+            montgomeryMultiply (x.data(), x.data(), oddPowers[window >> 1].data());
+            i = low - 1;
         }
+
+        // Multiplying by 1 converts back out of Montgomery form
+        std::vector<uint32> one (s, 0);
+        one[0] = 1;
+        montgomeryMultiply (x.data(), x.data(), one.data());
+
+        BigInteger result;
+        result.highestBit = (int) s * 32 - 1;
+        std::copy (x.begin(), x.end(), result.ensureSize (s));
+        result.highestBit = result.getHighestBit();
+        swapWith (result);
     }
 }
 
@@ -1371,6 +1586,54 @@ public:
             }
         }
 
+        {
+            beginTest ("Large multiplications");
+
+            Random r = getRandom();
+
+            for (int j = 20; --j >= 0;)
+            {
+                BigInteger b1, b2;
+                r.fillBitsRandomly (b1, 0, r.nextInt (3000) + 1000);
+                r.fillBitsRandomly (b2, 0, r.nextInt (3000) + 1000);
+                b1.setBit (0);
+
+                const auto product = b1 * b2;
+                expect (product / b1 == b2);
+                expect ((product % b1).isZero());
+                expect (b1 * (b2 + 1) == product + b1);
+                expect ((-b1) * b2 == -product);
+            }
+        }
+
+        {
+            beginTest ("exponent modulo with large odd moduli");
+
+            Random r = getRandom();
+
+            // Fermat's little theorem: a^(p - 1) = 1 (mod p) for the Mersenne primes 2^127 - 1 and 2^521 - 1
+            for (const auto bits : { 127, 521 })
+            {
+                BigInteger prime;
+                prime.setRange (0, bits, true);
+
+                for (int j = 5; --j >= 0;)
+                {
+                    BigInteger base;
+                    r.fillBitsRandomly (base, 0, bits - 1);
+                    base += 2;
+
+                    auto result = base;
+                    result.exponentModulo (prime - 1, prime);
+                    expect (result.isOne());
+
+                    result = base;
+                    result.exponentModulo (prime - 2, prime);
+                    expect ((result * base) % prime == 1);
+                }
+            }
+        }
+
         {
             beginTest ("Bit setting");
 
@@ -182,6 +182,88 @@ public:
     */
     double evaluate (const Scope& scope, String& evaluationError) const;
 
+    //==============================================================================
+    /** An Expression that has been compiled into a flat list of instructions, for
+        evaluating it many times with different values for some of its symbols.
+
+        The symbols that were named as variables when compiling are read from the values
+        passed to evaluate(). Any other symbols are looked up in the Scope once, when the
+        expression is compiled, and the parts of the expression that don't depend on the
+        variables are reduced to constants.
+
+        @see Expression::compile
+    */
+    class JUCE_API  Compiled
+    {
+    public:
+        /** Creates a compiled expression with a value of 0. */
+        Compiled();
+
+        /** Destructor. */
+        ~Compiled();
+
+        Compiled (const Compiled&);
+        Compiled& operator= (const Compiled&);
+        Compiled (Compiled&&) noexcept;
+        Compiled& operator= (Compiled&&) noexcept;
+
+        /** Returns the number of variables that evaluate() needs values for. */
+        int getNumVariables() const noexcept        { return numVariables; }
+
+        /** Evaluates the expression.
+
+            The array must contain a value for each of the variables, in the order that
+            they were given to Expression::compile(). If a function in the scope throws an
+            EvaluationError, this returns 0.
+        */
+        double evaluate (const double* variableValues) const;
+
+        /** Evaluates the expression for a block of samples.
+
+            variableBuffers must contain a pointer to numSamples values for each of the
+            variables, in the order that they were given to Expression::compile(), and a
+            result is written to the results buffer for each sample. Each instruction is
+            applied to a chunk of samples at a time, in simple loops that the compiler
+            can vectorise. If a function in the scope throws an EvaluationError, the
+            results are cleared.
+        */
+        void evaluate (const float* const* variableBuffers, float* results, int numSamples) const;
+
+    private:
+        enum OpCode
+        {
+            pushConstant, pushVariable,
+            add, subtract, multiply, divide,
+            addConstant, subtractConstant, multiplyConstant, divideConstant,
+            negate, sine, cosine, tangent, absolute,
+            minimum, maximum, callFunction
+        };
+
+        struct Instruction;
+        std::vector<Instruction> instructions;
+        Array<double> constants;
+        StringArray functionNames;
+        const Scope* scope = nullptr;
+        int numVariables = 0, maxStackSize = 1, maxFunctionInputs = 0;
+
+        friend class Expression;
+    };
+
+    /** Compiles this expression so that it can be evaluated quickly many times.
+
+        The symbols named in variableNames become the variables of the compiled expression,
+        and their values are supplied when it's evaluated. All other symbols and relative
+        scopes are resolved using the scope when the expression is compiled.
+
+        min, max, sin, cos, tan and abs always use the built-in versions. Other functions
+        are called on the scope when it's evaluated if their parameters use any of the
+        variables, in which case the scope must outlive the compiled expression.
+
+        Any errors are returned in the compileError argument, in which case the result will
+        evaluate to 0.
+    */
+    Compiled compile (const StringArray& variableNames, const Scope& scope, String& compileError) const;
+
     /** Attempts to return an expression which is a copy of this one, but with a constant adjusted
         to make the expression resolve to a target value.
 
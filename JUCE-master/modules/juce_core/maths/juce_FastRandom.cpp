@@ -0,0 +1,449 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace FastRandomHelpers
+{
+    static uint64 splitMix64 (uint64& state) noexcept
+    {
+        auto z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Four 32-bit values that live in a single SIMD register where possible
+    struct Vec4
+    {
+       #if JUCE_CORE_USE_SSE2
+        __m128i v;
+
+        static Vec4 load (const uint32* src) noexcept      { return { _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src)) }; }
+        void store (uint32* dest) const noexcept           { _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), v); }
+
+        Vec4 operator+ (Vec4 other) const noexcept         { return { _mm_add_epi32 (v, other.v) }; }
+        Vec4 operator^ (Vec4 other) const noexcept         { return { _mm_xor_si128 (v, other.v) }; }
+        Vec4 operator| (Vec4 other) const noexcept         { return { _mm_or_si128 (v, other.v) }; }
+        Vec4 operator<< (int numBits) const noexcept       { return { _mm_slli_epi32 (v, numBits) }; }
+        Vec4 operator>> (int numBits) const noexcept       { return { _mm_srli_epi32 (v, numBits) }; }
+       #elif JUCE_CORE_USE_NEON
+        uint32x4_t v;
+
+        static Vec4 load (const uint32* src) noexcept      { return { vld1q_u32 (src) }; }
+        void store (uint32* dest) const noexcept           { vst1q_u32 (dest, v); }
+
+        Vec4 operator+ (Vec4 other) const noexcept         { return { vaddq_u32 (v, other.v) }; }
+        Vec4 operator^ (Vec4 other) const noexcept         { return { veorq_u32 (v, other.v) }; }
+        Vec4 operator| (Vec4 other) const noexcept         { return { vorrq_u32 (v, other.v) }; }
+        Vec4 operator<< (int numBits) const noexcept       { return { vshlq_u32 (v, vdupq_n_s32 (numBits)) }; }
+        Vec4 operator>> (int numBits) const noexcept       { return { vshlq_u32 (v, vdupq_n_s32 (-numBits)) }; }
+       #else
+        uint32 v[4];
+
+        static Vec4 load (const uint32* src) noexcept      { Vec4 r; std::copy (src, src + 4, r.v); return r; }
+        void store (uint32* dest) const noexcept           { std::copy (v, v + 4, dest); }
+
+        Vec4 operator+ (Vec4 other) const noexcept         { return apply ([&] (int i) { return v[i] + other.v[i]; }); }
+        Vec4 operator^ (Vec4 other) const noexcept         { return apply ([&] (int i) { return v[i] ^ other.v[i]; }); }
+        Vec4 operator| (Vec4 other) const noexcept         { return apply ([&] (int i) { return v[i] | other.v[i]; }); }
+        Vec4 operator<< (int numBits) const noexcept       { return apply ([&] (int i) { return v[i] << numBits; }); }
+        Vec4 operator>> (int numBits) const noexcept       { return apply ([&] (int i) { return v[i] >> numBits; }); }
+
+        template <typename Fn>
+        static Vec4 apply (Fn&& fn) noexcept               { return { { fn (0), fn (1), fn (2), fn (3) } }; }
+       #endif
+    };
+
+    static Vec4 rotateLeft (Vec4 x, int numBits) noexcept
+    {
+        return (x << numBits) | (x >> (32 - numBits));
+    }
+
+    // Four xoshiro128++ generators running in parallel
+    struct XoshiroLanes
+    {
+        Vec4 a, b, c, d;
+
+        Vec4 next() noexcept
+        {
+            const auto result = rotateLeft (a + d, 7) + a;
+            const auto t = b << 9;
+
+            c = c ^ a;
+            d = d ^ b;
+            b = b ^ c;
+            a = a ^ d;
+            c = c ^ t;
+            d = rotateLeft (d, 11);
+
+            return result;
+        }
+    };
+
+    // Returns a value in the range [0, 1) using the top 24 bits
+    static float toUnitFloat (uint32 value) noexcept
+    {
+        return (float) (int32) (value >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+//==============================================================================
+FastRandom::FastRandom (uint64 seed) noexcept                       { setSeed (seed); }
+FastRandom::FastRandom (uint64 seed, uint64 streamIndex) noexcept   { setSeed (seed, streamIndex); }
+FastRandom::FastRandom()                                            { setSeed ((uint64) Random::getSystemRandom().nextInt64()); }
+
+void FastRandom::setSeed (uint64 seed, uint64 streamIndex) noexcept
+{
+    using namespace FastRandomHelpers;
+
+    auto state = splitMix64 (seed) ^ (splitMix64 (streamIndex) * 0xd1b54a32d192ed03ULL);
+
+    for (size_t i = 0; i < numLanes; ++i)
+    {
+        auto a = splitMix64 (state);
+        auto b = splitMix64 (state);
+
+        s0[i] = (uint32) a;
+        s1[i] = (uint32) (a >> 32);
+        s2[i] = (uint32) b;
+        s3[i] = (uint32) (b >> 32);
+
+        // xoshiro gets stuck if its state is all zeros
+        if ((s0[i] | s1[i] | s2[i] | s3[i]) == 0)
+            s0[i] = 1;
+    }
+
+    blockPosition = numLanes;
+}
+
+void FastRandom::generateBlocks (uint32* dest, size_t numBlocks) noexcept
+{
+    using namespace FastRandomHelpers;
+
+    // The lanes are processed as two groups of four, held in local variables so that
+    // the whole state stays in SIMD registers for the duration of the loop.
+    static_assert (numLanes == 8);
+
+    XoshiroLanes low  { Vec4::load (s0),     Vec4::load (s1),     Vec4::load (s2),     Vec4::load (s3) };
+    XoshiroLanes high { Vec4::load (s0 + 4), Vec4::load (s1 + 4), Vec4::load (s2 + 4), Vec4::load (s3 + 4) };
+
+    for (; numBlocks > 0; --numBlocks)
+    {
+        low.next().store (dest);
+        high.next().store (dest + 4);
+        dest += numLanes;
+    }
+
+    low.a.store (s0);   high.a.store (s0 + 4);
+    low.b.store (s1);   high.b.store (s1 + 4);
+    low.c.store (s2);   high.c.store (s2 + 4);
+    low.d.store (s3);   high.d.store (s3 + 4);
+}
+
+template <typename Converter>
+void FastRandom::fillWith (size_t numValues, Converter&& convert) noexcept
+{
+    const auto numBuffered = jmin (numValues, numLanes - blockPosition);
+    convert (block + blockPosition, numBuffered);
+    blockPosition += numBuffered;
+    numValues -= numBuffered;
+
+    constexpr size_t blocksPerChunk = 32;
+    uint32 chunk[numLanes * blocksPerChunk];
+
+    while (numValues >= numLanes)
+    {
+        const auto numBlocks = jmin (numValues / numLanes, blocksPerChunk);
+
+        generateBlocks (chunk, numBlocks);
+        convert (chunk, numBlocks * numLanes);
+        numValues -= numBlocks * numLanes;
+    }
+
+    if (numValues > 0)
+    {
+        generateBlocks (block, 1);
+        convert (block, numValues);
+        blockPosition = numValues;
+    }
+}
+
+//==============================================================================
+uint32 FastRandom::nextUInt32() noexcept
+{
+    if (blockPosition == numLanes)
+    {
+        generateBlocks (block, 1);
+        blockPosition = 0;
+    }
+
+    return block[blockPosition++];
+}
+
+uint64 FastRandom::nextUInt64() noexcept
+{
+    const auto high = (uint64) nextUInt32();
+    return (high << 32) | nextUInt32();
+}
+
+int FastRandom::nextInt (int maxValue) noexcept
+{
+    jassert (maxValue > 0);
+    return (int) (((uint64) nextUInt32() * (uint64) maxValue) >> 32);
+}
+
+int FastRandom::nextInt (Range<int> range) noexcept
+{
+    return range.getStart() + nextInt (range.getLength());
+}
+
+float FastRandom::nextFloat() noexcept
+{
+    return FastRandomHelpers::toUnitFloat (nextUInt32());
+}
+
+double FastRandom::nextDouble() noexcept
+{
+    return (double) (nextUInt64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+float FastRandom::nextGaussian() noexcept
+{
+    float result;
+    fillGaussian (&result, 1);
+    return result;
+}
+
+//==============================================================================
+void FastRandom::fill (uint32* dest, size_t numValues) noexcept
+{
+    while (numValues > 0 && blockPosition < numLanes)
+    {
+        *dest++ = block[blockPosition++];
+        --numValues;
+    }
+
+    const auto numBlocks = numValues / numLanes;
+    generateBlocks (dest, numBlocks);
+    dest += numBlocks * numLanes;
+    numValues -= numBlocks * numLanes;
+
+    while (numValues-- > 0)
+        *dest++ = nextUInt32();
+}
+
+void FastRandom::fillUniform (int* dest, size_t numValues, Range<int> range) noexcept
+{
+    jassert (! range.isEmpty());
+
+    const auto start = range.getStart();
+    const auto length = (uint64) range.getLength();
+
+    fillWith (numValues, [&] (const uint32* values, size_t num)
+    {
+        for (size_t i = 0; i < num; ++i)
+            dest[i] = start + (int) (((uint64) values[i] * length) >> 32);
+
+        dest += num;
+    });
+}
+
+void FastRandom::fillUniform (float* dest, size_t numValues, Range<float> range) noexcept
+{
+    const auto start = range.getStart();
+    const auto length = range.getLength();
+
+    fillWith (numValues, [&] (const uint32* values, size_t num)
+    {
+        for (size_t i = 0; i < num; ++i)
+            dest[i] = start + FastRandomHelpers::toUnitFloat (values[i]) * length;
+
+        dest += num;
+    });
+}
+
+void FastRandom::fillGaussian (float* dest, size_t numValues, float mean, float standardDeviation) noexcept
+{
+    // Box-Muller transform: each pair of uniform values makes a pair of gaussian ones
+    constexpr size_t maxPairsPerChunk = 32;
+    uint32 values[maxPairsPerChunk * 2];
+
+    while (numValues > 0)
+    {
+        const auto numPairs = jmin ((numValues + 1) / 2, maxPairsPerChunk);
+        fill (values, numPairs * 2);
+
+        for (size_t i = 0; i < numPairs; ++i)
+        {
+            const auto u1 = FastRandomHelpers::toUnitFloat (values[2 * i]) + (1.0f / 16777216.0f); // (0, 1]
+            const auto u2 = FastRandomHelpers::toUnitFloat (values[2 * i + 1]);
+            const auto radius = standardDeviation * std::sqrt (-2.0f * std::log (u1));
+            const auto angle = MathConstants<float>::twoPi * u2;
+
+            *dest++ = mean + radius * std::cos (angle);
+
+            if (--numValues == 0)
+                break;
+
+            *dest++ = mean + radius * std::sin (angle);
+            --numValues;
+        }
+    }
+}
+
+void FastRandom::fillBitsRandomly (void* dest, size_t numBytes) noexcept
+{
+    auto d = static_cast<char*> (dest);
+
+    fillWith (numBytes / sizeof (uint32), [&d] (const uint32* values, size_t num)
+    {
+        memcpy (d, values, num * sizeof (uint32));
+        d += num * sizeof (uint32);
+    });
+
+    if (const auto remainder = numBytes % sizeof (uint32); remainder != 0)
+    {
+        const auto lastValue = nextUInt32();
+        memcpy (d, &lastValue, remainder);
+    }
+}
+
+//==============================================================================
+FastRandom& FastRandom::getThreadRandom() noexcept
+{
+    thread_local FastRandom threadRandom;
+    return threadRandom;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FastRandomTests final : public UnitTest
+{
+public:
+    FastRandomTests()
+        : UnitTest ("FastRandom", UnitTestCategories::maths)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Known sequence");
+        {
+            // These values pin down the sequence, which must never change between
+            // platforms or versions, as people will rely on it to reproduce results
+            FastRandom r (12345);
+            const uint32 expected[] = { 0x257f8eea, 0xcd6cbb75, 0x51e942b4, 0x66a5660f, 0x72e47b99, 0xa8edf729,
+                                        0x31c397c1, 0x5eb3bb1e, 0x26fe25d6, 0x27091331, 0xb702858f, 0x65d27b85 };
+
+            for (auto e : expected)
+                expect (r.nextUInt32() == e);
+        }
+
+        beginTest ("Bulk and single values give the same sequence");
+        {
+            for (auto size : { (size_t) 1, (size_t) 5, (size_t) 8, (size_t) 13, (size_t) 64, (size_t) 1000 })
+            {
+                FastRandom a (99, 3), b (99, 3);
+                std::vector<uint32> bulk (size + 3);
+
+                a.nextUInt32();
+                b.nextUInt32();
+                a.fill (bulk.data(), size);
+                a.fill (bulk.data() + size, 3);
+
+                for (auto v : bulk)
+                    expect (v == b.nextUInt32());
+            }
+        }
+
+        beginTest ("Streams are independent");
+        {
+            FastRandom a (7, 0), b (7, 1), c (7, 0), d (7, 7), e (8, 8);
+            int numSame = 0;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto va = a.nextUInt32();
+                numSame += va == b.nextUInt32() ? 1 : 0;
+                numSame += d.nextUInt32() == e.nextUInt32() ? 1 : 0;
+                expect (va == c.nextUInt32());
+            }
+
+            expect (numSame < 3);
+        }
+
+        beginTest ("Ranges and distributions");
+        {
+            FastRandom r ((uint64) getRandom().nextInt64());
+            constexpr size_t num = 100000;
+            std::vector<int> ints (num);
+            std::vector<float> floats (num);
+
+            r.fillUniform (ints.data(), num, { -3, 4 });
+            expect (std::all_of (ints.begin(), ints.end(), [] (int v) { return v >= -3 && v < 4; }));
+            expect (std::find (ints.begin(), ints.end(), -3) != ints.end());
+            expect (std::find (ints.begin(), ints.end(), 3) != ints.end());
+
+            r.fillUniform (floats.data(), num);
+            expect (std::all_of (floats.begin(), floats.end(), [] (float v) { return v >= 0.0f && v < 1.0f; }));
+            expectWithinAbsoluteError (std::accumulate (floats.begin(), floats.end(), 0.0) / num, 0.5, 0.01);
+
+            r.fillGaussian (floats.data(), num, 2.0f, 3.0f);
+            StatisticsAccumulator<double> stats;
+
+            for (auto v : floats)
+                stats.addValue (v);
+
+            expectWithinAbsoluteError (stats.getAverage(), 2.0, 0.05);
+            expectWithinAbsoluteError (stats.getStandardDeviation(), 3.0, 0.05);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto d = r.nextDouble();
+                expect (d >= 0.0 && d < 1.0);
+                expect (r.nextInt (5) >= 0 && r.nextInt (5) < 5);
+                expect (std::isfinite (r.nextGaussian()));
+            }
+        }
+    }
+};
+
+static FastRandomTests fastRandomTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast pseudo-random number generator that can fill whole buffers at once.
+
+    Internally this runs eight interleaved xoshiro128++ generators, stepping them
+    all together using SSE2 or NEON instructions where available. This makes it much
+    quicker than Random when you need lots of values, e.g. for noise, dither or
+    Monte-Carlo tests.
+
+    The sequence of values produced for a given seed is fully defined, and is the
+    same on every platform and compiler, whether you take values one at a time or
+    in bulk, so you can mix the two freely without affecting reproducibility. (The
+    one exception is the gaussian distribution, whose values depend on the platform's
+    implementations of std::log, std::sin and std::cos).
+
+    A FastRandom isn't thread-safe, so each thread should use its own. Use the
+    constructor that takes a stream index to create reproducible, independent
+    generators for a set of worker threads, or getThreadRandom() if you just need
+    some random numbers and don't care about the seed.
+
+    This generator is not suitable for cryptographic purposes.
+
+    @see Random
+
+    @tags{Core}
+*/
+class JUCE_API  FastRandom  final
+{
+public:
+    //==============================================================================
+    /** Creates a generator with the given seed. */
+    explicit FastRandom (uint64 seed) noexcept;
+
+    /** Creates one of a family of generators that share a seed.
+
+        Generators with the same seed and different stream indexes produce unrelated
+        sequences, so this is a handy way to give each of a set of worker threads its own
+        reproducible stream.
+    */
+    FastRandom (uint64 seed, uint64 streamIndex) noexcept;
+
+    /** Creates a generator with a seed taken from Random::getSystemRandom(). */
+    FastRandom();
+
+    //==============================================================================
+    /** Resets the generator to the start of the sequence for a given seed. */
+    void setSeed (uint64 seed, uint64 streamIndex = 0) noexcept;
+
+    //==============================================================================
+    /** Returns the next random 32-bit value. */
+    uint32 nextUInt32() noexcept;
+
+    /** Returns the next random 64-bit value. */
+    uint64 nextUInt64() noexcept;
+
+    /** Returns a random integer between 0 (inclusive) and maxValue (exclusive).
+        The maxValue parameter must be greater than zero.
+    */
+    int nextInt (int maxValue) noexcept;
+
+    /** Returns a random integer between the range start (inclusive) and its end (exclusive). */
+    int nextInt (Range<int> range) noexcept;
+
+    /** Returns a random value in the range 0 (inclusive) to 1.0 (exclusive). */
+    float nextFloat() noexcept;
+
+    /** Returns a random value in the range 0 (inclusive) to 1.0 (exclusive). */
+    double nextDouble() noexcept;
+
+    /** Returns a random value from a normal distribution with a mean of 0 and a
+        standard deviation of 1.
+    */
+    float nextGaussian() noexcept;
+
+    //==============================================================================
+    /** Fills a buffer with random 32-bit values. */
+    void fill (uint32* dest, size_t numValues) noexcept;
+
+    /** Fills a buffer with integers between the range start (inclusive) and its end (exclusive). */
+    void fillUniform (int* dest, size_t numValues, Range<int> range) noexcept;
+
+    /** Fills a buffer with values spread evenly over the given range. */
+    void fillUniform (float* dest, size_t numValues, Range<float> range = { 0.0f, 1.0f }) noexcept;
+
+    /** Fills a buffer with values from a normal distribution. */
+    void fillGaussian (float* dest, size_t numValues, float mean = 0.0f, float standardDeviation = 1.0f) noexcept;
+
+    /** Fills a block of memory with random bytes. */
+    void fillBitsRandomly (void* dest, size_t numBytes) noexcept;
+
+    //==============================================================================
+    /** Returns a generator that belongs to the calling thread, seeded randomly.
+
+        As with Random::getSystemRandom(), don't keep a reference to this object and
+        use it from another thread.
+    */
+    static FastRandom& getThreadRandom() noexcept;
+
+    /** The number of generators that run side-by-side. */
+    static constexpr size_t numLanes = 8;
+
+private:
+    //==============================================================================
+    uint32 s0[numLanes], s1[numLanes], s2[numLanes], s3[numLanes];
+    uint32 block[numLanes];
+    size_t blockPosition = numLanes;
+
+    void generateBlocks (uint32* dest, size_t numBlocks) noexcept;
+
+    template <typename Converter>
+    void fillWith (size_t numValues, Converter&&) noexcept;
+
+    JUCE_LEAK_DETECTOR (FastRandom)
+};
+
+} // namespace juce
@@ -802,6 +802,25 @@ namespace TypeHelpers
     template <>              struct UnsignedTypeWithSize<4>         { using type = uint32; };
     template <>              struct UnsignedTypeWithSize<8>         { using type = uint64; };
    #endif
+
+    /** Says whether an object of this type can be moved to a different address by copying
+        its bytes, after which the original is forgotten about without calling its destructor.
+
+        This is true of trivially copyable types, and also of most types that only hold
+        pointers to their data, such as String and var. It's false for any type that holds a
+        pointer to itself, or that has registered its address somewhere else.
+
+        The arrays use this to move their elements with memmove when they grow, or when
+        elements are inserted or removed, instead of moving them one at a time. You can
+        specialise it for your own types like this:
+        @code
+        template <> struct juce::TypeHelpers::IsTriviallyRelocatable<MyType> : std::true_type {};
+        @endcode
+
+        @tags{Core}
+    */
+    template <typename Type>
+    struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<Type>> {};
 }
 
 //==============================================================================
@@ -56,36 +56,42 @@ void notifyAllocationHooksForThread()
 void* operator new (size_t s)
 {
     juce::notifyAllocationHooksForThread();
+    JUCE_REPORT_REALTIME_VIOLATION (allocation)
     return std::malloc (s);
 }
 
 void* operator new[] (size_t s)
 {
     juce::notifyAllocationHooksForThread();
+    JUCE_REPORT_REALTIME_VIOLATION (allocation)
     return std::malloc (s);
 }
 
 void operator delete (void* p) noexcept
 {
     juce::notifyAllocationHooksForThread();
+    JUCE_REPORT_REALTIME_VIOLATION (deallocation)
     std::free (p);
 }
 
 void operator delete[] (void* p) noexcept
 {
     juce::notifyAllocationHooksForThread();
+    JUCE_REPORT_REALTIME_VIOLATION (deallocation)
     std::free (p);
 }
 
 void operator delete (void* p, size_t) noexcept
 {
     juce::notifyAllocationHooksForThread();
+    JUCE_REPORT_REALTIME_VIOLATION (deallocation)
     std::free (p);
 }
 
 void operator delete[] (void* p, size_t) noexcept
 {
     juce::notifyAllocationHooksForThread();
+    JUCE_REPORT_REALTIME_VIOLATION (deallocation)
     std::free (p);
 }
 
@@ -107,6 +113,23 @@ UnitTestAllocationChecker::~UnitTestAllocationChecker() noexcept
 
 void UnitTestAllocationChecker::newOrDeleteCalled() noexcept { ++calls; }
 
+//==============================================================================
+ScopedAllocationAssertion::ScopedAllocationAssertion()
+{
+    getAllocationHooksForThread().addListener (this);
+}
+
+ScopedAllocationAssertion::~ScopedAllocationAssertion() noexcept
+{
+    getAllocationHooksForThread().removeListener (this);
+}
+
+void ScopedAllocationAssertion::newOrDeleteCalled() noexcept
+{
+    // new or delete was called while this checker was active!
+    jassertfalse;
+}
+
 }
 
 #endif
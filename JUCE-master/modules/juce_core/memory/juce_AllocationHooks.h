@@ -80,6 +80,28 @@ private:
     size_t calls = 0;
 };
 
+//==============================================================================
+/** Scoped checker which will trigger an assertion if any new/delete calls are
+    made on the current thread during the lifetime of the ScopedAllocationAssertion.
+
+    This is intended for debugging code which must not allocate, such as the
+    parts of an audio callback which are expected to be realtime-safe.
+*/
+class ScopedAllocationAssertion  : private AllocationHooks::Listener
+{
+public:
+    /** Starts watching for new/delete calls on the current thread. */
+    ScopedAllocationAssertion();
+
+    /** Stops watching for new/delete calls. */
+    ~ScopedAllocationAssertion() noexcept override;
+
+private:
+    void newOrDeleteCalled() noexcept override;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedAllocationAssertion)
+};
+
 }
 
 #endif
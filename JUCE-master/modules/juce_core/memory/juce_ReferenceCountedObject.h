@@ -478,4 +478,9 @@ bool operator!= (const Type* object1, const ReferenceCountedObjectPtr<Type>& obj
     return object1 != object2.get();
 }
 
+#ifndef DOXYGEN
+template <typename Type>
+struct TypeHelpers::IsTriviallyRelocatable<ReferenceCountedObjectPtr<Type>> : std::true_type {};
+#endif
+
 } // namespace juce
@@ -0,0 +1,573 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// This lives at the start of the shared memory, followed by the message data. Each message
+// is a 32-bit size followed by its data, padded so that the next message is 8-byte aligned.
+struct SharedMemoryRingBuffer::Header
+{
+    static constexpr uint32 magicValue = 0x4a534d52;
+
+    uint32 magic;
+    uint32 unused;
+    uint64 capacity;
+
+    alignas (64) std::atomic<uint64> writePosition;
+    alignas (64) std::atomic<uint64> readPosition;
+
+    // These are incremented whenever their condition changes, and are used as futex words on Linux
+    alignas (64) std::atomic<uint32> dataSignal, readerIsWaiting;
+    alignas (64) std::atomic<uint32> spaceSignal, writerIsWaiting;
+
+    static constexpr size_t getDataOffset() noexcept;
+};
+
+constexpr size_t SharedMemoryRingBuffer::Header::getDataOffset() noexcept
+{
+    return (sizeof (Header) + 63) & ~(size_t) 63;
+}
+
+static_assert (std::atomic<uint64>::is_always_lock_free && std::atomic<uint32>::is_always_lock_free,
+               "Atomics in shared memory must be lock-free to work between processes");
+
+static constexpr size_t sharedMessageHeaderSize = 8;
+static constexpr uint32 sharedMessageWrapMarker = 0xffffffff;
+
+static constexpr size_t getSharedMessageSpace (size_t numBytes) noexcept
+{
+    return sharedMessageHeaderSize + ((numBytes + 7) & ~(size_t) 7);
+}
+
+//==============================================================================
+struct SharedMemoryRingBuffer::Native
+{
+    ~Native()
+    {
+       #if JUCE_WINDOWS
+        if (address != nullptr)     UnmapViewOfFile (address);
+        if (mapping != nullptr)     CloseHandle (mapping);
+        if (dataEvent != nullptr)   CloseHandle (dataEvent);
+        if (spaceEvent != nullptr)  CloseHandle (spaceEvent);
+       #elif JUCE_LINUX || JUCE_BSD || JUCE_MAC
+        if (address != nullptr)
+            munmap (address, size);
+
+        if (isOwner)
+            shm_unlink (getObjectName().toRawUTF8());
+       #endif
+    }
+
+    static std::unique_ptr<Native> openOrCreate (const String& name, size_t sizeToCreate, bool shouldCreate)
+    {
+        auto n = std::make_unique<Native>();
+        n->name = name;
+        n->isOwner = shouldCreate;
+
+       #if JUCE_WINDOWS
+        const auto objectName = n->getObjectName();
+
+        if (shouldCreate)
+        {
+            n->mapping = CreateFileMappingW (INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                             (DWORD) ((uint64) sizeToCreate >> 32), (DWORD) sizeToCreate,
+                                             objectName.toWideCharPointer());
+
+            if (n->mapping != nullptr && GetLastError() == ERROR_ALREADY_EXISTS)
+                return {};
+        }
+        else
+        {
+            n->mapping = OpenFileMappingW (FILE_MAP_ALL_ACCESS, FALSE, objectName.toWideCharPointer());
+        }
+
+        if (n->mapping == nullptr)
+            return {};
+
+        n->address = MapViewOfFile (n->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+
+        if (n->address == nullptr)
+            return {};
+
+        MEMORY_BASIC_INFORMATION info;
+
+        if (VirtualQuery (n->address, &info, sizeof (info)) == 0)
+            return {};
+
+        n->size = (size_t) info.RegionSize;
+        n->dataEvent  = CreateEventW (nullptr, FALSE, FALSE, (objectName + "_d").toWideCharPointer());
+        n->spaceEvent = CreateEventW (nullptr, FALSE, FALSE, (objectName + "_s").toWideCharPointer());
+
+        if (n->dataEvent == nullptr || n->spaceEvent == nullptr)
+            return {};
+
+        return n;
+       #elif JUCE_LINUX || JUCE_BSD || JUCE_MAC
+        const auto objectName = n->getObjectName();
+        const auto fd = shm_open (objectName.toRawUTF8(), shouldCreate ? (O_CREAT | O_EXCL | O_RDWR) : O_RDWR, 0600);
+
+        if (fd < 0)
+        {
+            n->isOwner = false;
+            return {};
+        }
+
+        if (shouldCreate)
+        {
+            n->size = sizeToCreate;
+
+            if (ftruncate (fd, (off_t) sizeToCreate) != 0)
+            {
+                ::close (fd);
+                return {};
+            }
+        }
+        else
+        {
+            struct stat info;
+
+            if (fstat (fd, &info) != 0)
+            {
+                ::close (fd);
+                return {};
+            }
+
+            n->size = (size_t) info.st_size;
+        }
+
+        const auto m = mmap (nullptr, n->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close (fd);
+
+        if (m == MAP_FAILED)
+            return {};
+
+        n->address = m;
+        return n;
+       #else
+        ignoreUnused (sizeToCreate);
+        return {};
+       #endif
+    }
+
+    void wait (std::atomic<uint32>& signal, uint32 expectedValue, bool forData, int timeoutMs)
+    {
+       #if JUCE_LINUX
+        ignoreUnused (forData);
+
+        timespec timeout { timeoutMs / 1000, (timeoutMs % 1000) * 1000000 };
+        syscall (SYS_futex, reinterpret_cast<uint32*> (&signal), FUTEX_WAIT, expectedValue,
+                 timeoutMs < 0 ? nullptr : &timeout, nullptr, 0);
+       #elif JUCE_WINDOWS
+        ignoreUnused (signal, expectedValue);
+        WaitForSingleObject (forData ? dataEvent : spaceEvent, timeoutMs < 0 ? INFINITE : (DWORD) timeoutMs);
+       #else
+        ignoreUnused (signal, expectedValue, forData);
+        Thread::sleep (timeoutMs < 0 ? 1 : jlimit (0, 1, timeoutMs));
+       #endif
+    }
+
+    void wake (std::atomic<uint32>& signal, bool forData)
+    {
+       #if JUCE_LINUX
+        ignoreUnused (forData);
+        syscall (SYS_futex, reinterpret_cast<uint32*> (&signal), FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+       #elif JUCE_WINDOWS
+        ignoreUnused (signal);
+        SetEvent (forData ? dataEvent : spaceEvent);
+       #else
+        ignoreUnused (signal, forData);
+       #endif
+    }
+
+    String getObjectName() const
+    {
+       #if JUCE_WINDOWS
+        return "Local\\juce_" + name;
+       #else
+        return "/" + name;
+       #endif
+    }
+
+    String name;
+    void* address = nullptr;
+    size_t size = 0;
+    bool isOwner = false;
+
+   #if JUCE_WINDOWS
+    HANDLE mapping = nullptr, dataEvent = nullptr, spaceEvent = nullptr;
+   #endif
+};
+
+//==============================================================================
+SharedMemoryRingBuffer::SharedMemoryRingBuffer (std::unique_ptr<Native> n)
+    : native (std::move (n)),
+      header (static_cast<Header*> (native->address)),
+      data (static_cast<std::byte*> (native->address) + Header::getDataOffset())
+{
+}
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer() = default;
+
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::create (const String& name, size_t capacityInBytes)
+{
+    const auto capacity = jmax ((size_t) 256, (capacityInBytes + 7) & ~(size_t) 7);
+    auto n = Native::openOrCreate (name, Header::getDataOffset() + capacity, true);
+
+    if (n == nullptr)
+        return {};
+
+    auto* h = new (n->address) Header();
+    h->capacity = capacity;
+    h->magic = Header::magicValue;
+
+    return std::unique_ptr<SharedMemoryRingBuffer> (new SharedMemoryRingBuffer (std::move (n)));
+}
+
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::open (const String& name)
+{
+    auto n = Native::openOrCreate (name, 0, false);
+
+    if (n == nullptr || n->size < Header::getDataOffset())
+        return {};
+
+    const auto* h = static_cast<const Header*> (n->address);
+
+    if (h->magic != Header::magicValue || Header::getDataOffset() + h->capacity > n->size)
+        return {};
+
+    return std::unique_ptr<SharedMemoryRingBuffer> (new SharedMemoryRingBuffer (std::move (n)));
+}
+
+size_t SharedMemoryRingBuffer::getCapacity() const noexcept
+{
+    return (size_t) header->capacity;
+}
+
+size_t SharedMemoryRingBuffer::getMaxMessageSize() const noexcept
+{
+    // If a message doesn't fit before the end of the buffer, it has to start again at the beginning,
+    // so this is the largest size that's guaranteed to fit in one of those two places
+    return getCapacity() / 2 - sharedMessageHeaderSize;
+}
+
+//==============================================================================
+std::byte* SharedMemoryRingBuffer::beginWrite (size_t numBytes, int timeoutMs)
+{
+    // You must call finishWrite() before starting another message!
+    jassert (! isWriting);
+
+    if (numBytes > getMaxMessageSize())
+        return nullptr;
+
+    const auto capacity = header->capacity;
+    const auto position = header->writePosition.load (std::memory_order_relaxed);
+    const auto offset = position % capacity;
+    const auto spaceToEnd = capacity - offset;
+    const auto spaceNeeded = (uint64) getSharedMessageSpace (numBytes);
+    const auto mustWrap = spaceNeeded > spaceToEnd;
+    const auto totalSpaceNeeded = mustWrap ? spaceToEnd + spaceNeeded : spaceNeeded;
+
+    const auto hasSpace = [&]
+    {
+        return capacity - (position - header->readPosition.load()) >= totalSpaceNeeded;
+    };
+
+    if (! waitFor (false, hasSpace, timeoutMs))
+        return nullptr;
+
+    pendingWritePosition = position;
+
+    if (mustWrap)
+    {
+        memcpy (data + offset, &sharedMessageWrapMarker, sizeof (uint32));
+        pendingWritePosition += spaceToEnd;
+        header->writePosition.store (pendingWritePosition);
+    }
+
+    pendingWriteSize = numBytes;
+    isWriting = true;
+    return data + (pendingWritePosition % capacity) + sharedMessageHeaderSize;
+}
+
+void SharedMemoryRingBuffer::finishWrite()
+{
+    // You must call beginWrite() first!
+    jassert (isWriting);
+
+    if (! std::exchange (isWriting, false))
+        return;
+
+    const auto size = (uint32) pendingWriteSize;
+    memcpy (data + (pendingWritePosition % header->capacity), &size, sizeof (size));
+    header->writePosition.store (pendingWritePosition + getSharedMessageSpace (pendingWriteSize));
+    notify (true);
+}
+
+bool SharedMemoryRingBuffer::write (const void* sourceData, size_t numBytes, int timeoutMs)
+{
+    if (auto* dest = beginWrite (numBytes, timeoutMs))
+    {
+        memcpy (dest, sourceData, numBytes);
+        finishWrite();
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+std::optional<Span<const std::byte>> SharedMemoryRingBuffer::beginRead()
+{
+    // You must call finishRead() before starting another message!
+    jassert (! isReading);
+
+    for (;;)
+    {
+        const auto position = header->readPosition.load (std::memory_order_relaxed);
+
+        if (position == header->writePosition.load())
+            return {};
+
+        const auto offset = position % header->capacity;
+        uint32 size;
+        memcpy (&size, data + offset, sizeof (size));
+
+        if (size != sharedMessageWrapMarker)
+        {
+            pendingReadSize = size;
+            isReading = true;
+            return Span<const std::byte> (data + offset + sharedMessageHeaderSize, size);
+        }
+
+        header->readPosition.store (position + header->capacity - offset);
+        notify (false);
+    }
+}
+
+void SharedMemoryRingBuffer::finishRead()
+{
+    // You must call beginRead() first!
+    jassert (isReading);
+
+    if (! std::exchange (isReading, false))
+        return;
+
+    header->readPosition.store (header->readPosition.load (std::memory_order_relaxed)
+                                  + getSharedMessageSpace (pendingReadSize));
+    notify (false);
+}
+
+bool SharedMemoryRingBuffer::waitForData (int timeoutMs)
+{
+    return waitFor (true, [this] { return header->readPosition.load() != header->writePosition.load(); }, timeoutMs);
+}
+
+void SharedMemoryRingBuffer::interruptWaits()
+{
+    ++interruptCount;
+
+    for (auto forData : { true, false })
+    {
+        (forData ? header->dataSignal : header->spaceSignal).fetch_add (1);
+        native->wake (forData ? header->dataSignal : header->spaceSignal, forData);
+    }
+}
+
+//==============================================================================
+bool SharedMemoryRingBuffer::waitFor (bool forData, const std::function<bool()>& condition, int timeoutMs)
+{
+    if (condition())
+        return true;
+
+    auto& signal  = forData ? header->dataSignal : header->spaceSignal;
+    auto& waiting = forData ? header->readerIsWaiting : header->writerIsWaiting;
+
+    const auto startTime = Time::getMillisecondCounter();
+    const auto startInterruptCount = interruptCount.load();
+
+    for (;;)
+    {
+        const auto remaining = timeoutMs < 0 ? -1 : timeoutMs - (int) (Time::getMillisecondCounter() - startTime);
+
+        if (timeoutMs >= 0 && remaining <= 0)
+            return condition();
+
+        const auto signalValue = signal.load();
+        waiting.store (1);
+
+        // The other side changes the condition before checking whether we're waiting, so
+        // either it sees our flag and wakes us, or we see its change here
+        if (condition())
+        {
+            waiting.store (0);
+            return true;
+        }
+
+        if (interruptCount.load() != startInterruptCount)
+        {
+            waiting.store (0);
+            return false;
+        }
+
+        native->wait (signal, signalValue, forData, remaining);
+        waiting.store (0);
+    }
+}
+
+void SharedMemoryRingBuffer::notify (bool forData)
+{
+    auto& signal = forData ? header->dataSignal : header->spaceSignal;
+    signal.fetch_add (1);
+
+    if ((forData ? header->readerIsWaiting : header->writerIsWaiting).load() != 0)
+        native->wake (signal, forData);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && (JUCE_LINUX || JUCE_BSD || JUCE_MAC || JUCE_WINDOWS)
+
+class SharedMemoryRingBufferTests final : public UnitTest
+{
+public:
+    SharedMemoryRingBufferTests()
+        : UnitTest ("SharedMemoryRingBuffer", UnitTestCategories::memory)
+    {}
+
+    void runTest() override
+    {
+        const auto bufferName = "jt" + String::toHexString (getRandom().nextInt64());
+
+        beginTest ("Creating and opening");
+        {
+            expect (SharedMemoryRingBuffer::open (bufferName) == nullptr);
+
+            auto created = SharedMemoryRingBuffer::create (bufferName, 1000);
+            expect (created != nullptr);
+            expect (SharedMemoryRingBuffer::create (bufferName, 1000) == nullptr);
+
+            auto opened = SharedMemoryRingBuffer::open (bufferName);
+            expect (opened != nullptr);
+            expectEquals ((int) opened->getCapacity(), (int) created->getCapacity());
+
+            expect (created->beginWrite (created->getMaxMessageSize() + 1) == nullptr);
+            expect (! opened->beginRead().has_value());
+            expect (! opened->waitForData (10));
+
+            expect (created->write ("hello", 5));
+            expect (opened->waitForData (0));
+
+            auto message = opened->beginRead();
+            expect (message.has_value() && message->size() == 5 && memcmp (message->data(), "hello", 5) == 0);
+            opened->finishRead();
+            expect (! opened->beginRead().has_value());
+        }
+
+        beginTest ("Streaming between threads");
+        {
+            auto writer = SharedMemoryRingBuffer::create (bufferName, 4096);
+            auto reader = SharedMemoryRingBuffer::open (bufferName);
+            expect (writer != nullptr && reader != nullptr);
+
+            constexpr int numMessages = 5000;
+            const auto maxSize = (int) writer->getMaxMessageSize();
+            std::atomic<bool> writeFailed { false };
+
+            std::thread writerThread ([&]
+            {
+                Random r (1);
+
+                for (int i = 0; i < numMessages; ++i)
+                {
+                    const auto size = (size_t) r.nextInt (maxSize + 1);
+                    auto* dest = writer->beginWrite (size, -1);
+
+                    if (dest == nullptr)
+                    {
+                        writeFailed = true;
+                        return;
+                    }
+
+                    for (size_t j = 0; j < size; ++j)
+                        dest[j] = (std::byte) (i + (int) j);
+
+                    writer->finishWrite();
+                }
+            });
+
+            Random r (1);
+            int numReceived = 0;
+            bool allMatched = true;
+
+            while (numReceived < numMessages && ! writeFailed)
+            {
+                if (! reader->waitForData (5000))
+                    break;
+
+                if (auto message = reader->beginRead())
+                {
+                    const auto expectedSize = (size_t) r.nextInt (maxSize + 1);
+                    allMatched = allMatched && message->size() == expectedSize;
+
+                    for (size_t j = 0; j < message->size(); ++j)
+                        allMatched = allMatched && (*message)[j] == (std::byte) (numReceived + (int) j);
+
+                    reader->finishRead();
+                    ++numReceived;
+                }
+            }
+
+            writerThread.join();
+            expect (! writeFailed);
+            expect (allMatched);
+            expectEquals (numReceived, numMessages);
+        }
+
+        beginTest ("Interrupting a wait");
+        {
+            auto buffer = SharedMemoryRingBuffer::create (bufferName, 1000);
+            std::thread t ([&] { Thread::sleep (50); buffer->interruptWaits(); });
+            expect (! buffer->waitForData (10000));
+            t.join();
+        }
+    }
+};
+
+static SharedMemoryRingBufferTests sharedMemoryRingBufferTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A queue of variable-sized messages in a block of memory that's shared between
+    two processes.
+
+    One process creates the buffer with create(), giving it a name which the other
+    process then passes to open(). After that, one side can write messages and the other
+    can read them, without any copying through the OS. Writes are done in place: call
+    beginWrite() to get a pointer into the shared memory, fill it in, and then call
+    finishWrite() to publish it. Similarly, beginRead() returns a view of the next
+    message directly in the shared memory, which stays valid until finishRead() is called.
+
+    There must only be one writer and one reader. For two-way communication, use a
+    pair of buffers.
+
+    A reader can block in waitForData() until a message arrives, and a writer can
+    block in beginWrite() until there's room. On Linux, waiting is done with a futex in
+    the shared memory, and on Windows with a named event. On other platforms the
+    waiting thread polls, so latency will be higher.
+
+    Shared memory isn't currently supported on Android, iOS or WebAssembly, where
+    create() and open() will always fail.
+
+    @see ChildProcessCoordinator::enableSharedMemoryTransport
+
+    @tags{Core}
+*/
+class JUCE_API  SharedMemoryRingBuffer
+{
+public:
+    //==============================================================================
+    /** Creates a new shared buffer with the given name and capacity.
+
+        The name should be short, alphanumeric and unique to this buffer, as it's used to
+        name OS objects. Returns nullptr if the buffer can't be created, e.g. because one
+        with this name already exists.
+    */
+    static std::unique_ptr<SharedMemoryRingBuffer> create (const String& name, size_t capacityInBytes);
+
+    /** Opens a buffer that was created by another process (or another part of this one).
+        Returns nullptr if there's no buffer with this name.
+    */
+    static std::unique_ptr<SharedMemoryRingBuffer> open (const String& name);
+
+    /** Destructor.
+        If this object created the buffer, its name is removed, so that no more processes
+        can open it, although any that have already opened it can carry on using it.
+    */
+    ~SharedMemoryRingBuffer();
+
+    //==============================================================================
+    /** Returns the size of the shared data area. */
+    size_t getCapacity() const noexcept;
+
+    /** Returns the largest message that can be written. */
+    size_t getMaxMessageSize() const noexcept;
+
+    //==============================================================================
+    /** Reserves space for a message of the given size, and returns a pointer to it.
+
+        If there isn't enough room, this will wait for up to timeoutMs milliseconds for the
+        reader to make some (pass -1 to wait forever). If there's still no space, or the message
+        is larger than getMaxMessageSize(), this returns nullptr.
+
+        After filling in the data, you must call finishWrite() to make it visible to the reader.
+    */
+    std::byte* beginWrite (size_t numBytes, int timeoutMs = 0);
+
+    /** Publishes the message that was started with beginWrite(). */
+    void finishWrite();
+
+    /** Copies a message into the buffer, waiting for up to timeoutMs milliseconds for space.
+        Returns false if it couldn't be written.
+    */
+    bool write (const void* data, size_t numBytes, int timeoutMs = 0);
+
+    //==============================================================================
+    /** Returns a view of the next message in the shared memory, or an empty optional if
+        there are no messages waiting.
+
+        The data stays valid until finishRead() is called to release it.
+    */
+    std::optional<Span<const std::byte>> beginRead();
+
+    /** Releases the message returned by beginRead(), so that its space can be reused. */
+    void finishRead();
+
+    /** Waits for up to timeoutMs milliseconds for a message to arrive (pass -1 to wait forever).
+
+        Returns true if there may be a message ready to read - very occasionally beginRead() may
+        still find nothing, so be prepared for that. Returns false if the time ran out or
+        interruptWaits() was called.
+    */
+    bool waitForData (int timeoutMs);
+
+    /** Wakes up a thread that's blocked in waitForData() or beginWrite(). */
+    void interruptWaits();
+
+private:
+    //==============================================================================
+    struct Header;
+    struct Native;
+
+    explicit SharedMemoryRingBuffer (std::unique_ptr<Native>);
+
+    bool waitFor (bool forData, const std::function<bool()>& condition, int timeoutMs);
+    void notify (bool forData);
+
+    std::unique_ptr<Native> native;
+    Header* header = nullptr;
+    std::byte* data = nullptr;
+    uint64 pendingWritePosition = 0;
+    size_t pendingWriteSize = 0, pendingReadSize = 0;
+    bool isWriting = false, isReading = false;
+    std::atomic<uint32> interruptCount { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryRingBuffer)
+};
+
+} // namespace juce
@@ -0,0 +1,552 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_PERFORMANCE_TRACING
+
+namespace juce
+{
+
+//==============================================================================
+/*  Metrics are registered once for each place that uses them, under a lock. Gauges are
+    stored globally, but counters and histograms are added up in a block of storage that
+    belongs to each thread, so updating them never contends with other threads. The blocks
+    are kept in a list that only grows, and a block is reused by a new thread once the
+    thread that owned it has finished.
+*/
+struct PerformanceTracingEvent
+{
+    const char* name;
+    int64 startTime, endTime;
+};
+
+struct PerformanceTracingThreadData
+{
+    std::atomic<bool> inUse { true };
+    PerformanceTracingThreadData* next = nullptr;
+    int index = 0;
+    String threadName;
+
+    std::atomic<int64> counters[PerformanceTracing::maxMetrics] {};
+    std::atomic<int64> histogramCounts[PerformanceTracing::maxHistograms] {};
+    std::atomic<int64> histogramTotals[PerformanceTracing::maxHistograms] {};
+    std::atomic<int64> histogramBuckets[PerformanceTracing::maxHistograms][PerformanceTracing::numHistogramBuckets] {};
+
+    // The events are only written by the owning thread, which clears them when it sees that
+    // a new capture has started
+    HeapBlock<PerformanceTracingEvent> events;
+    int eventCapacity = 0;
+    std::atomic<int> numEvents { 0 }, numDroppedEvents { 0 }, captureNumber { 0 };
+};
+
+struct PerformanceTracingState
+{
+    SpinLock lock;
+
+    const char* metricNames[PerformanceTracing::maxMetrics] {};
+    PerformanceTracing::MetricType metricTypes[PerformanceTracing::maxMetrics] {};
+    std::atomic<int64> gauges[PerformanceTracing::maxMetrics] {};
+    std::atomic<int> numMetrics { 0 };
+
+    const char* histogramNames[PerformanceTracing::maxHistograms] {};
+    std::atomic<int> numHistograms { 0 };
+
+    std::atomic<PerformanceTracingThreadData*> threads { nullptr };
+    int numThreads = 0;
+
+    std::atomic<bool> capturing { false }, nativeTracing { false };
+    std::atomic<int> captureNumber { 0 }, maxEventsPerThread { 0 };
+    std::atomic<int64> captureStartTime { 0 };
+};
+
+static PerformanceTracingState& getPerformanceTracingState() noexcept
+{
+    static PerformanceTracingState state;
+    return state;
+}
+
+static PerformanceTracingThreadData& acquirePerformanceTracingThreadData()
+{
+    auto& state = getPerformanceTracingState();
+    const auto* thread = Thread::getCurrentThread();
+    const auto name = thread != nullptr ? thread->getThreadName()
+                                        : "Thread " + String::toHexString ((pointer_sized_int) Thread::getCurrentThreadId());
+
+    const SpinLock::ScopedLockType sl (state.lock);
+
+    for (auto* data = state.threads.load(); data != nullptr; data = data->next)
+    {
+        auto wasInUse = false;
+
+        if (data->inUse.compare_exchange_strong (wasInUse, true))
+        {
+            data->threadName = name;
+            return *data;
+        }
+    }
+
+    auto* data = new PerformanceTracingThreadData();
+    data->index = ++state.numThreads;
+    data->threadName = name;
+    data->next = state.threads.load();
+    state.threads.store (data);
+    return *data;
+}
+
+struct PerformanceTracingThreadHolder
+{
+    ~PerformanceTracingThreadHolder()
+    {
+        if (data != nullptr)
+            data->inUse.store (false);
+    }
+
+    PerformanceTracingThreadData* data = nullptr;
+};
+
+static thread_local PerformanceTracingThreadHolder performanceTracingThreadHolder;
+
+static PerformanceTracingThreadData& getPerformanceTracingThreadData()
+{
+    auto& holder = performanceTracingThreadHolder;
+
+    if (holder.data == nullptr)
+        holder.data = &acquirePerformanceTracingThreadData();
+
+    return *holder.data;
+}
+
+template <typename Fn>
+static void forEachPerformanceTracingThread (Fn&& fn)
+{
+    for (auto* data = getPerformanceTracingState().threads.load(); data != nullptr; data = data->next)
+        fn (*data);
+}
+
+static void addToPerformanceTracingValue (std::atomic<int64>& value, int64 amount) noexcept
+{
+    // Only the owning thread writes to these, so this doesn't need to be a read-modify-write
+    value.store (value.load (std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+static int getHistogramBucket (int64 value) noexcept
+{
+    int bucket = 0;
+
+    for (auto v = (uint64) jmax ((int64) 0, value); v != 0 && bucket < PerformanceTracing::numHistogramBuckets - 1; v >>= 1)
+        ++bucket;
+
+    return bucket;
+}
+
+//==============================================================================
+#if JUCE_MAC || JUCE_IOS
+
+API_AVAILABLE (macos (10.14), ios (12.0))
+static os_log_t getPerformanceTracingLog()
+{
+    static auto log = os_log_create ("com.juce.performance", "PerformanceTracing");
+    return log;
+}
+
+static void beginNativeTrace (const char* name, const void* id) noexcept
+{
+    if (__builtin_available (macOS 10.14, iOS 12.0, *))
+    {
+        auto log = getPerformanceTracingLog();
+
+        if (os_signpost_enabled (log))
+            os_signpost_interval_begin (log, os_signpost_id_make_with_pointer (log, id), "JUCE", "%{public}s", name);
+    }
+}
+
+static void endNativeTrace (const char* name, const void* id) noexcept
+{
+    if (__builtin_available (macOS 10.14, iOS 12.0, *))
+    {
+        auto log = getPerformanceTracingLog();
+
+        if (os_signpost_enabled (log))
+            os_signpost_interval_end (log, os_signpost_id_make_with_pointer (log, id), "JUCE", "%{public}s", name);
+    }
+}
+
+static void registerNativeTracing() noexcept {}
+
+#elif JUCE_MSVC
+
+// {1B6E4C9A-7F0D-4E8B-9C6A-2F3D5E7A8B91}
+TRACELOGGING_DEFINE_PROVIDER (juceTracingProvider, "JUCEPerformanceTracing",
+                              (0x1b6e4c9a, 0x7f0d, 0x4e8b, 0x9c, 0x6a, 0x2f, 0x3d, 0x5e, 0x7a, 0x8b, 0x91));
+
+static void beginNativeTrace (const char* name, const void*) noexcept
+{
+    TraceLoggingWrite (juceTracingProvider, "Trace",
+                       TraceLoggingOpcode (WINEVENT_OPCODE_START),
+                       TraceLoggingString (name, "Name"));
+}
+
+static void endNativeTrace (const char* name, const void*) noexcept
+{
+    TraceLoggingWrite (juceTracingProvider, "Trace",
+                       TraceLoggingOpcode (WINEVENT_OPCODE_STOP),
+                       TraceLoggingString (name, "Name"));
+}
+
+static void registerNativeTracing() noexcept
+{
+    static const auto registered = TraceLoggingRegister (juceTracingProvider);
+    ignoreUnused (registered);
+}
+
+#else
+
+static void beginNativeTrace (const char*, const void*) noexcept {}
+static void endNativeTrace (const char*, const void*) noexcept {}
+static void registerNativeTracing() noexcept {}
+
+#endif
+
+//==============================================================================
+int PerformanceTracing::getMetricID (const char* name, MetricType type) noexcept
+{
+    auto& state = getPerformanceTracingState();
+    const SpinLock::ScopedLockType sl (state.lock);
+
+    if (type == MetricType::histogram)
+    {
+        const auto num = state.numHistograms.load();
+
+        for (int i = 0; i < num; ++i)
+            if (std::strcmp (state.histogramNames[i], name) == 0)
+                return maxMetrics + i;
+
+        // Too many histograms have been registered!
+        jassert (num < maxHistograms);
+
+        if (num >= maxHistograms)
+            return -1;
+
+        state.histogramNames[num] = name;
+        state.numHistograms.store (num + 1);
+        return maxMetrics + num;
+    }
+
+    const auto num = state.numMetrics.load();
+
+    for (int i = 0; i < num; ++i)
+        if (state.metricTypes[i] == type && std::strcmp (state.metricNames[i], name) == 0)
+            return i;
+
+    // Too many metrics have been registered!
+    jassert (num < maxMetrics);
+
+    if (num >= maxMetrics)
+        return -1;
+
+    state.metricNames[num] = name;
+    state.metricTypes[num] = type;
+    state.numMetrics.store (num + 1);
+    return num;
+}
+
+void PerformanceTracing::addToCounter (int metricID, int64 amount) noexcept
+{
+    if (isPositiveAndBelow (metricID, maxMetrics))
+        addToPerformanceTracingValue (getPerformanceTracingThreadData().counters[metricID], amount);
+}
+
+void PerformanceTracing::setGauge (int metricID, int64 value) noexcept
+{
+    if (isPositiveAndBelow (metricID, maxMetrics))
+        getPerformanceTracingState().gauges[metricID].store (value, std::memory_order_relaxed);
+}
+
+void PerformanceTracing::addToHistogram (int metricID, int64 value) noexcept
+{
+    const auto index = metricID - maxMetrics;
+
+    if (! isPositiveAndBelow (index, maxHistograms))
+        return;
+
+    auto& data = getPerformanceTracingThreadData();
+    addToPerformanceTracingValue (data.histogramCounts[index], 1);
+    addToPerformanceTracingValue (data.histogramTotals[index], value);
+    addToPerformanceTracingValue (data.histogramBuckets[index][getHistogramBucket (value)], 1);
+}
+
+std::vector<PerformanceTracing::Metric> PerformanceTracing::getMetrics()
+{
+    auto& state = getPerformanceTracingState();
+    std::vector<Metric> results;
+
+    for (int i = 0; i < state.numMetrics.load(); ++i)
+    {
+        Metric m { state.metricNames[i], state.metricTypes[i], 0, 0, {} };
+
+        if (m.type == MetricType::gauge)
+            m.value = state.gauges[i].load();
+        else
+            forEachPerformanceTracingThread ([&] (auto& data) { m.value += data.counters[i].load (std::memory_order_relaxed); });
+
+        results.push_back (m);
+    }
+
+    for (int i = 0; i < state.numHistograms.load(); ++i)
+    {
+        Metric m { state.histogramNames[i], MetricType::histogram, 0, 0, {} };
+
+        forEachPerformanceTracingThread ([&] (auto& data)
+        {
+            m.count += data.histogramCounts[i].load (std::memory_order_relaxed);
+            m.value += data.histogramTotals[i].load (std::memory_order_relaxed);
+
+            for (int b = 0; b < numHistogramBuckets; ++b)
+                m.buckets[(size_t) b] += data.histogramBuckets[i][b].load (std::memory_order_relaxed);
+        });
+
+        results.push_back (m);
+    }
+
+    return results;
+}
+
+String PerformanceTracing::getSummary()
+{
+    String s;
+
+    auto getPercentile = [] (const Metric& m, double proportion)
+    {
+        auto remaining = (int64) std::ceil ((double) m.count * proportion);
+
+        for (int b = 0; b < numHistogramBuckets; ++b)
+            if ((remaining -= m.buckets[(size_t) b]) <= 0)
+                return b == 0 ? (int64) 0 : (int64) 1 << (b - 1);
+
+        return (int64) 0;
+    };
+
+    for (auto& m : getMetrics())
+    {
+        s << String (m.name).paddedRight (' ', 40);
+
+        if (m.type == MetricType::histogram)
+        {
+            s << "count: " << m.count;
+
+            if (m.count > 0)
+                s << ", mean: " << String ((double) m.value / (double) m.count, 2)
+                  << ", median >= " << getPercentile (m, 0.5)
+                  << ", 99% >= " << getPercentile (m, 0.99);
+        }
+        else
+        {
+            s << (m.type == MetricType::gauge ? "gauge: " : "total: ") << m.value;
+        }
+
+        s << newLine;
+    }
+
+    return s;
+}
+
+void PerformanceTracing::resetMetrics() noexcept
+{
+    auto& state = getPerformanceTracingState();
+
+    for (auto& g : state.gauges)
+        g.store (0);
+
+    forEachPerformanceTracingThread ([] (auto& data)
+    {
+        for (auto& c : data.counters)            c.store (0);
+        for (auto& c : data.histogramCounts)     c.store (0);
+        for (auto& c : data.histogramTotals)     c.store (0);
+
+        for (auto& buckets : data.histogramBuckets)
+            for (auto& c : buckets)
+                c.store (0);
+    });
+}
+
+//==============================================================================
+void PerformanceTracing::startCapture (int maxEventsPerThread)
+{
+    auto& state = getPerformanceTracingState();
+    state.maxEventsPerThread.store (jmax (1, maxEventsPerThread));
+    state.captureStartTime.store (Time::getHighResolutionTicks());
+    state.captureNumber.fetch_add (1);
+    state.capturing.store (true);
+}
+
+void PerformanceTracing::stopCapture() noexcept
+{
+    getPerformanceTracingState().capturing.store (false);
+}
+
+bool PerformanceTracing::isCapturing() noexcept
+{
+    return getPerformanceTracingState().capturing.load (std::memory_order_relaxed);
+}
+
+void PerformanceTracing::setNativeTracingEnabled (bool shouldBeEnabled) noexcept
+{
+    if (shouldBeEnabled)
+        registerNativeTracing();
+
+    getPerformanceTracingState().nativeTracing.store (shouldBeEnabled);
+}
+
+bool PerformanceTracing::isActive() noexcept
+{
+    auto& state = getPerformanceTracingState();
+    return state.capturing.load (std::memory_order_relaxed) || state.nativeTracing.load (std::memory_order_relaxed);
+}
+
+void PerformanceTracing::ScopedTrace::begin() noexcept
+{
+    startTime = Time::getHighResolutionTicks();
+
+    if (getPerformanceTracingState().nativeTracing.load (std::memory_order_relaxed))
+        beginNativeTrace (name, this);
+}
+
+void PerformanceTracing::ScopedTrace::end() noexcept
+{
+    const auto endTime = Time::getHighResolutionTicks();
+    auto& state = getPerformanceTracingState();
+
+    if (state.nativeTracing.load (std::memory_order_relaxed))
+        endNativeTrace (name, this);
+
+    if (! state.capturing.load (std::memory_order_relaxed))
+        return;
+
+    auto& data = getPerformanceTracingThreadData();
+    const auto captureNumber = state.captureNumber.load (std::memory_order_acquire);
+
+    if (data.captureNumber.load (std::memory_order_relaxed) != captureNumber)
+    {
+        const auto capacity = state.maxEventsPerThread.load();
+
+        if (data.eventCapacity != capacity)
+        {
+            data.events.malloc (capacity);
+            data.eventCapacity = capacity;
+        }
+
+        data.numEvents.store (0);
+        data.numDroppedEvents.store (0);
+        data.captureNumber.store (captureNumber, std::memory_order_release);
+    }
+
+    const auto index = data.numEvents.load (std::memory_order_relaxed);
+
+    if (index < data.eventCapacity)
+    {
+        data.events[index] = { name, startTime, endTime };
+        data.numEvents.store (index + 1, std::memory_order_release);
+    }
+    else
+    {
+        data.numDroppedEvents.store (data.numDroppedEvents.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+void PerformanceTracing::writeChromeTrace (OutputStream& out)
+{
+    auto& state = getPerformanceTracingState();
+    const auto captureNumber = state.captureNumber.load();
+    const auto startTime = state.captureStartTime.load();
+    const auto ticksPerMicrosecond = (double) Time::getHighResolutionTicksPerSecond() / 1.0e6;
+    auto endTime = startTime;
+
+    std::map<const char*, String> quotedNames;
+
+    auto quote = [&] (const char* name) -> const String&
+    {
+        auto& quoted = quotedNames[name];
+
+        if (quoted.isEmpty())
+            quoted = "\"" + JSON::escapeString (name) + "\"";
+
+        return quoted;
+    };
+
+    auto separator = "\n";
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    forEachPerformanceTracingThread ([&] (PerformanceTracingThreadData& data)
+    {
+        if (data.captureNumber.load (std::memory_order_acquire) != captureNumber)
+            return;
+
+        {
+            const SpinLock::ScopedLockType sl (state.lock);
+
+            out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << data.index
+                << ",\"args\":{\"name\":\"" << JSON::escapeString (data.threadName) << "\"}}";
+            separator = ",\n";
+        }
+
+        const auto numEvents = data.numEvents.load (std::memory_order_acquire);
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const auto& e = data.events[i];
+            endTime = jmax (endTime, e.endTime);
+
+            out << separator << "{\"name\":" << quote (e.name) << ",\"cat\":\"juce\",\"ph\":\"X\",\"pid\":1,\"tid\":" << data.index
+                << ",\"ts\":" << String ((double) (e.startTime - startTime) / ticksPerMicrosecond, 3)
+                << ",\"dur\":" << String ((double) (e.endTime - e.startTime) / ticksPerMicrosecond, 3) << "}";
+        }
+    });
+
+    for (auto& m : getMetrics())
+    {
+        if (m.type == MetricType::histogram)
+            continue;
+
+        out << separator << "{\"name\":" << quote (m.name) << ",\"ph\":\"C\",\"pid\":1"
+            << ",\"ts\":" << String ((double) (endTime - startTime) / ticksPerMicrosecond, 3)
+            << ",\"args\":{\"value\":" << m.value << "}}";
+    }
+
+    out << "\n]}\n";
+}
+
+} // namespace juce
+
+#endif
@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_ENABLE_PERFORMANCE_TRACING || DOXYGEN
+
+//==============================================================================
+/**
+    A registry of performance metrics and trace events for instrumenting hot code paths.
+
+    When JUCE_ENABLE_PERFORMANCE_TRACING is enabled, the following can be recorded:
+    - counters, which add up an amount over time, e.g. the number of bytes written to files.
+    - gauges, which hold the latest value that was set, e.g. the size of a queue.
+    - histograms, which record how many values fell into each power-of-two range, along
+      with their count and total.
+    - trace events, which record when a scope started and finished on each thread.
+
+    Counters and histograms are accumulated separately for each thread, so updating them
+    only touches memory that belongs to the calling thread, and never locks or waits.
+    The first update made by a thread allocates its storage, which is kept and reused by
+    later threads after it exits.
+
+    Trace events are only recorded between calls to startCapture() and stopCapture(), and
+    JUCE_SCOPED_TRACE costs no more than reading an atomic flag at other times. A capture
+    can be saved with writeChromeTrace() and opened with the Perfetto UI or chrome://tracing.
+    If setNativeTracingEnabled() is used, trace events are also sent to os_signpost on
+    macOS and iOS, where they appear in Instruments, and to ETW on Windows.
+
+    JUCE already records trace events for processing the nodes of an AudioProcessorGraph,
+    the audio device callback, painting components, delivering messages, and reading and
+    writing files.
+
+    The time taken to create the MessageManager, the Desktop and its list of displays, the
+    default LookAndFeel, and to load typefaces is also recorded with
+    JUCE_SCOPED_INITIALISER_TRACE, and listed by getSummary(). Calling startCapture() before
+    any of these are created will show where the time goes when an app or plugin starts.
+
+    When JUCE_ENABLE_PERFORMANCE_TRACING is disabled, all the macros compile to nothing.
+
+    @code
+    void MySynth::renderNextBlock (AudioBuffer<float>& buffer, int start, int num)
+    {
+        JUCE_SCOPED_TRACE ("MySynth::renderNextBlock")
+        JUCE_TRACE_COUNTER_ADD ("Voices rendered", numActiveVoices)
+        ...
+    }
+
+    // ...and later on:
+    DBG (PerformanceTracing::getSummary());
+    @endcode
+
+    @tags{Core}
+*/
+class JUCE_API PerformanceTracing
+{
+public:
+    //==============================================================================
+    /** The kinds of metric that can be recorded. */
+    enum class MetricType
+    {
+        counter,
+        gauge,
+        histogram
+    };
+
+    /** The maximum number of counters and gauges that can be registered. */
+    static constexpr int maxMetrics = 256;
+
+    /** The maximum number of histograms that can be registered. */
+    static constexpr int maxHistograms = 32;
+
+    /** The number of buckets in each histogram. Bucket 0 holds values below 1, and bucket
+        n holds values from 2^(n-1) up to 2^n, with the last one holding all larger values.
+    */
+    static constexpr int numHistogramBuckets = 32;
+
+    /** Returns the ID of the metric with the given name and type, registering it if it
+        doesn't exist yet. Returns -1 if there's no more room for metrics of this type.
+
+        The name must be a string literal, or otherwise outlive the registry. The macros
+        call this once for each place that they're used.
+    */
+    static int getMetricID (const char* name, MetricType type) noexcept;
+
+    /** Adds an amount to a counter. */
+    static void addToCounter (int metricID, int64 amount) noexcept;
+
+    /** Sets the value of a gauge. */
+    static void setGauge (int metricID, int64 value) noexcept;
+
+    /** Adds a value to a histogram. */
+    static void addToHistogram (int metricID, int64 value) noexcept;
+
+    /** The current value of a metric. */
+    struct Metric
+    {
+        const char* name;
+        MetricType type;
+
+        /** The total for a counter or histogram, or the latest value of a gauge. */
+        int64 value;
+
+        /** The number of values added to a histogram. */
+        int64 count;
+
+        /** The number of values that fell into each bucket of a histogram. */
+        std::array<int64, numHistogramBuckets> buckets;
+    };
+
+    /** Returns the values of all the metrics, added up over all threads. */
+    static std::vector<Metric> getMetrics();
+
+    /** Returns a readable table of all the metrics. */
+    static String getSummary();
+
+    /** Sets all the metrics back to zero.
+        This mustn't be called while any other threads might be updating them.
+    */
+    static void resetMetrics() noexcept;
+
+    //==============================================================================
+    /** Starts recording trace events, clearing any that were recorded before.
+        Each thread keeps up to maxEventsPerThread events, after which the rest are dropped.
+    */
+    static void startCapture (int maxEventsPerThread = 65536);
+
+    /** Stops recording trace events. */
+    static void stopCapture() noexcept;
+
+    /** Returns true if trace events are being recorded. */
+    static bool isCapturing() noexcept;
+
+    /** Writes the trace events from the last capture, along with the current values of
+        the counters and gauges, in the JSON trace event format that is read by Perfetto
+        and chrome://tracing.
+
+        This can be called during a capture, but not at the same time as startCapture().
+    */
+    static void writeChromeTrace (OutputStream& output);
+
+    /** Sends trace events to os_signpost on macOS and iOS, or to ETW on Windows, whether
+        or not a capture is running. On Windows, the events come from the
+        "JUCEPerformanceTracing" provider, {1B6E4C9A-7F0D-4E8B-9C6A-2F3D5E7A8B91}.
+    */
+    static void setNativeTracingEnabled (bool shouldBeEnabled) noexcept;
+
+    //==============================================================================
+    /** Records a trace event covering the lifetime of this object.
+        @see JUCE_SCOPED_TRACE
+    */
+    class JUCE_API ScopedTrace
+    {
+    public:
+        /** The name must be a string literal, or otherwise outlive the capture. */
+        explicit ScopedTrace (const char* eventName) noexcept
+            : name (eventName)
+        {
+            if (isActive())
+                begin();
+        }
+
+        ~ScopedTrace() noexcept
+        {
+            if (startTime != 0)
+                end();
+        }
+
+    private:
+        void begin() noexcept;
+        void end() noexcept;
+
+        const char* name;
+        int64 startTime = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTrace)
+    };
+
+    /** Adds the time that this object exists for, in microseconds, to a counter.
+        @see JUCE_SCOPED_INITIALISER_TRACE
+    */
+    class JUCE_API ScopedTimer
+    {
+    public:
+        explicit ScopedTimer (int counterMetricID) noexcept
+            : metricID (counterMetricID), startTime (Time::getHighResolutionTicks()) {}
+
+        ~ScopedTimer() noexcept
+        {
+            addToCounter (metricID, (int64) (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTime) * 1.0e6));
+        }
+
+    private:
+        const int metricID;
+        const int64 startTime;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+private:
+    static bool isActive() noexcept;
+
+    PerformanceTracing() = delete;
+};
+
+/** Records a trace event for the rest of the enclosing scope.
+    When JUCE_ENABLE_PERFORMANCE_TRACING is disabled, this does nothing.
+    @see PerformanceTracing
+*/
+#define JUCE_SCOPED_TRACE(name) \
+    const juce::PerformanceTracing::ScopedTrace JUCE_JOIN_MACRO (scopedTrace, __LINE__) (name);
+
+/** Records a trace event for the rest of the enclosing scope, and adds the time it took
+    in microseconds to a counter called "Startup: " followed by the name, so that
+    PerformanceTracing::getSummary() reports the time spent in each initialiser.
+
+    This is meant for one-off work like creating a subsystem, and unlike JUCE_SCOPED_TRACE
+    it always reads the clock. The name must be a string literal.
+    When JUCE_ENABLE_PERFORMANCE_TRACING is disabled, this does nothing.
+    @see PerformanceTracing
+*/
+#define JUCE_SCOPED_INITIALISER_TRACE(name) \
+    JUCE_SCOPED_TRACE (name) \
+    static const auto JUCE_JOIN_MACRO (initialiserMetricID, __LINE__) \
+        = juce::PerformanceTracing::getMetricID ("Startup: " name, juce::PerformanceTracing::MetricType::counter); \
+    const juce::PerformanceTracing::ScopedTimer JUCE_JOIN_MACRO (initialiserTimer, __LINE__) (JUCE_JOIN_MACRO (initialiserMetricID, __LINE__));
+
+/** Adds an amount to the PerformanceTracing counter with the given name.
+    When JUCE_ENABLE_PERFORMANCE_TRACING is disabled, this does nothing.
+    @see PerformanceTracing
+*/
+#define JUCE_TRACE_COUNTER_ADD(name, amount) \
+    { static const auto metricID = juce::PerformanceTracing::getMetricID (name, juce::PerformanceTracing::MetricType::counter); \
+      juce::PerformanceTracing::addToCounter (metricID, (juce::int64) (amount)); }
+
+/** Sets the value of the PerformanceTracing gauge with the given name.
+    When JUCE_ENABLE_PERFORMANCE_TRACING is disabled, this does nothing.
+    @see PerformanceTracing
+*/
+#define JUCE_TRACE_GAUGE_SET(name, value) \
+    { static const auto metricID = juce::PerformanceTracing::getMetricID (name, juce::PerformanceTracing::MetricType::gauge); \
+      juce::PerformanceTracing::setGauge (metricID, (juce::int64) (value)); }
+
+/** Adds a value to the PerformanceTracing histogram with the given name.
+    When JUCE_ENABLE_PERFORMANCE_TRACING is disabled, this does nothing.
+    @see PerformanceTracing
+*/
+#define JUCE_TRACE_HISTOGRAM_ADD(name, value) \
+    { static const auto metricID = juce::PerformanceTracing::getMetricID (name, juce::PerformanceTracing::MetricType::histogram); \
+      juce::PerformanceTracing::addToHistogram (metricID, (juce::int64) (value)); }
+
+#else
+
+#define JUCE_SCOPED_TRACE(name)
+#define JUCE_SCOPED_INITIALISER_TRACE(name)
+#define JUCE_TRACE_COUNTER_ADD(name, amount)
+#define JUCE_TRACE_GAUGE_SET(name, value)
+#define JUCE_TRACE_HISTOGRAM_ADD(name, value)
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_PERFORMANCE_TRACING
+
+namespace juce
+{
+
+class PerformanceTracingTests final : public UnitTest
+{
+public:
+    PerformanceTracingTests()
+        : UnitTest ("PerformanceTracing", UnitTestCategories::threads) {}
+
+    void runTest() final
+    {
+        beginTest ("Counters are added up over all threads");
+        {
+            PerformanceTracing::resetMetrics();
+
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < 4; ++t)
+                threads.emplace_back ([]
+                {
+                    for (int i = 0; i < 1000; ++i)
+                        JUCE_TRACE_COUNTER_ADD ("test counter", 2)
+                });
+
+            for (auto& t : threads)
+                t.join();
+
+            JUCE_TRACE_COUNTER_ADD ("test counter", 1)
+
+            expectEquals (findMetric ("test counter").value, (int64) 8001);
+        }
+
+        beginTest ("Gauges keep the latest value");
+        {
+            JUCE_TRACE_GAUGE_SET ("test gauge", 10)
+            JUCE_TRACE_GAUGE_SET ("test gauge", 3)
+
+            const auto m = findMetric ("test gauge");
+            expect (m.type == PerformanceTracing::MetricType::gauge);
+            expectEquals (m.value, (int64) 3);
+        }
+
+        beginTest ("Histograms sort values into power-of-two buckets");
+        {
+            for (auto v : { 0, 1, 2, 3, 4, 1000 })
+                JUCE_TRACE_HISTOGRAM_ADD ("test histogram", v)
+
+            const auto m = findMetric ("test histogram");
+            expectEquals (m.count, (int64) 6);
+            expectEquals (m.value, (int64) 1010);
+            expectEquals (m.buckets[0], (int64) 1);
+            expectEquals (m.buckets[1], (int64) 1);
+            expectEquals (m.buckets[2], (int64) 2);
+            expectEquals (m.buckets[3], (int64) 1);
+            expectEquals (m.buckets[10], (int64) 1);
+
+            expect (PerformanceTracing::getSummary().contains ("test histogram"));
+        }
+
+        beginTest ("Initialisers report how long they took");
+        {
+            {
+                JUCE_SCOPED_INITIALISER_TRACE ("test initialiser")
+                Thread::sleep (20);
+            }
+
+            const auto m = findMetric ("Startup: test initialiser");
+            expect (m.type == PerformanceTracing::MetricType::counter);
+            expectGreaterOrEqual (m.value, (int64) 15000);
+            expectLessThan (m.value, (int64) 10000000);
+        }
+
+        beginTest ("Metrics with the same name share an ID");
+        {
+            const auto a = PerformanceTracing::getMetricID ("shared", PerformanceTracing::MetricType::counter);
+            const auto b = PerformanceTracing::getMetricID ("shared", PerformanceTracing::MetricType::counter);
+            const auto c = PerformanceTracing::getMetricID ("shared", PerformanceTracing::MetricType::histogram);
+
+            expectEquals (a, b);
+            expect (a != c);
+        }
+
+        beginTest ("Trace events are only recorded during a capture");
+        {
+            {
+                JUCE_SCOPED_TRACE ("not captured")
+            }
+
+            PerformanceTracing::startCapture();
+            expect (PerformanceTracing::isCapturing());
+
+            {
+                JUCE_SCOPED_TRACE ("outer \"event\"")
+                JUCE_SCOPED_TRACE ("inner event")
+            }
+
+            std::thread ([] { JUCE_SCOPED_TRACE ("other thread") }).join();
+
+            PerformanceTracing::stopCapture();
+            expect (! PerformanceTracing::isCapturing());
+
+            {
+                JUCE_SCOPED_TRACE ("also not captured")
+            }
+
+            MemoryOutputStream out;
+            PerformanceTracing::writeChromeTrace (out);
+            const auto trace = JSON::parse (out.toString());
+
+            const auto* events = trace["traceEvents"].getArray();
+            expect (events != nullptr);
+
+            if (events == nullptr)
+                return;
+
+            StringArray names;
+            std::set<int> threadIDs;
+
+            for (auto& e : *events)
+            {
+                if (e["ph"].toString() == "X")
+                {
+                    names.add (e["name"].toString());
+                    threadIDs.insert ((int) e["tid"]);
+                    expect ((double) e["dur"] >= 0.0);
+                }
+            }
+
+            expect (names.contains ("outer \"event\""));
+            expect (names.contains ("inner event"));
+            expect (names.contains ("other thread"));
+            expect (! names.contains ("not captured"));
+            expect (! names.contains ("also not captured"));
+            expectEquals ((int) threadIDs.size(), 2);
+        }
+
+        beginTest ("Events beyond the limit are dropped");
+        {
+            PerformanceTracing::startCapture (10);
+
+            for (int i = 0; i < 100; ++i)
+                JUCE_SCOPED_TRACE ("many events")
+
+            PerformanceTracing::stopCapture();
+
+            MemoryOutputStream out;
+            PerformanceTracing::writeChromeTrace (out);
+            expectEquals (countOccurrences (out.toString(), "\"many events\""), 10);
+        }
+    }
+
+private:
+    static PerformanceTracing::Metric findMetric (const char* name)
+    {
+        for (auto& m : PerformanceTracing::getMetrics())
+            if (String (m.name) == name)
+                return m;
+
+        return {};
+    }
+
+    static int countOccurrences (const String& text, StringRef toFind)
+    {
+        int count = 0;
+
+        for (auto i = text.indexOf (toFind); i >= 0; i = text.indexOf (i + 1, toFind))
+            ++count;
+
+        return count;
+    }
+};
+
+static PerformanceTracingTests performanceTracingTests;
+
+} // namespace juce
+
+#endif
@@ -80,6 +80,8 @@
  #include <objc/objc.h>
  #include <objc/message.h>
  #include <poll.h>
+ #include <sys/event.h>
+ #include <sys/ioctl.h>
 
 //==============================================================================
 #elif JUCE_WINDOWS
@@ -210,6 +212,7 @@
  #include <sys/wait.h>
  #include <sys/timerfd.h>
  #include <sys/eventfd.h>
+ #include <sys/epoll.h>
  #include <utime.h>
  #include <poll.h>
 
@@ -246,6 +249,7 @@
  #include <sys/wait.h>
  #include <utime.h>
  #include <poll.h>
+ #include <sys/event.h>
 
 //==============================================================================
 #elif JUCE_ANDROID
@@ -268,6 +272,7 @@
  #include <sys/wait.h>
  #include <sys/timerfd.h>
  #include <sys/eventfd.h>
+ #include <sys/epoll.h>
  #include <android/api-level.h>
  #include <poll.h>
 
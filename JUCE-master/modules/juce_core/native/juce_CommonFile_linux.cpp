@@ -85,8 +85,7 @@ class DirectoryIterator::NativeIterator::Pimpl
 {
 public:
     Pimpl (const File& directory, const String& wc)
-        : parentDir (File::addTrailingSeparator (directory.getFullPathName())),
-          wildCard (wc), dir (opendir (directory.getFullPathName().toUTF8()))
+        : wildCard (wc), dir (opendir (directory.getFullPathName().toUTF8()))
     {
     }
 
@@ -118,7 +117,7 @@ public:
                 {
                     filenameFound = CharPointer_UTF8 (de->d_name);
 
-                    updateStatInfoForFile (parentDir + filenameFound, isDir, fileSize, modTime, creationTime, isReadOnly);
+                    updateInfo (*de, isDir, fileSize, modTime, creationTime, isReadOnly);
 
                     if (isHidden != nullptr)
                         *isHidden = filenameFound.startsWithChar ('.');
@@ -132,9 +131,42 @@ public:
     }
 
 private:
-    String parentDir, wildCard;
+    String wildCard;
     DIR* dir;
 
+    /*  The type that readdir() returns is enough to tell whether most entries are folders,
+        so that a plain directory walk needn't stat anything. When more information is
+        needed, the entry is looked up relative to the open directory, which saves the
+        kernel from resolving the whole path again for each file.
+    */
+    void updateInfo (const dirent& de, bool* isDir, int64* fileSize,
+                     Time* modTime, Time* creationTime, bool* isReadOnly) const
+    {
+        const auto typeIsKnown = de.d_type != DT_UNKNOWN && de.d_type != DT_LNK;
+
+        if (fileSize != nullptr || modTime != nullptr || creationTime != nullptr || (isDir != nullptr && ! typeIsKnown))
+        {
+            juce_statStruct info;
+           #if JUCE_LINUX
+            const bool statOk = fstatat64 (dirfd (dir), de.d_name, &info, 0) == 0;
+           #else
+            const bool statOk = fstatat (dirfd (dir), de.d_name, &info, 0) == 0;
+           #endif
+
+            if (isDir != nullptr)         *isDir        = statOk && ((info.st_mode & S_IFDIR) != 0);
+            if (fileSize != nullptr)      *fileSize     = statOk ? (int64) info.st_size : 0;
+            if (modTime != nullptr)       *modTime      = Time (statOk ? (int64) info.st_mtime  * 1000 : 0);
+            if (creationTime != nullptr)  *creationTime = Time (statOk ? getCreationTime (info) * 1000 : 0);
+        }
+        else if (isDir != nullptr)
+        {
+            *isDir = de.d_type == DT_DIR;
+        }
+
+        if (isReadOnly != nullptr)
+            *isReadOnly = faccessat (dirfd (dir), de.d_name, W_OK, 0) != 0;
+    }
+
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
 
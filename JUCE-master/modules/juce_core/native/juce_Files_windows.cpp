@@ -393,6 +393,20 @@ int64 juce_fileSetPosition (void* handle, int64 pos)
     return li.QuadPart;
 }
 
+int64 juce_fileReadAt (void* handle, int64 pos, void* buffer, size_t numBytes)
+{
+    OVERLAPPED overlapped{};
+    overlapped.Offset = (DWORD) pos;
+    overlapped.OffsetHigh = (DWORD) (pos >> 32);
+
+    DWORD actualNum = 0;
+
+    if (! ReadFile ((HANDLE) handle, buffer, (DWORD) numBytes, &actualNum, &overlapped))
+        return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+
+    return (int64) actualNum;
+}
+
 void FileInputStream::openHandle()
 {
     auto h = CreateFile (file.getFullPathName().toWideCharPointer(),
@@ -495,18 +509,18 @@ void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exc
         range.setStart (range.getStart() - (range.getStart() % systemInfo.dwAllocationGranularity));
     }
 
-    DWORD accessMode = GENERIC_READ, createType = OPEN_EXISTING;
+    DWORD desiredAccess = GENERIC_READ, createType = OPEN_EXISTING;
     DWORD protect = PAGE_READONLY, access = FILE_MAP_READ;
 
     if (mode == readWrite)
     {
-        accessMode = GENERIC_READ | GENERIC_WRITE;
+        desiredAccess = GENERIC_READ | GENERIC_WRITE;
         createType = OPEN_ALWAYS;
         protect = PAGE_READWRITE;
         access = FILE_MAP_ALL_ACCESS;
     }
 
-    auto h = CreateFile (file.getFullPathName().toWideCharPointer(), accessMode,
+    auto h = CreateFile (file.getFullPathName().toWideCharPointer(), desiredAccess,
                          exclusive ? 0 : (FILE_SHARE_READ | FILE_SHARE_DELETE | (mode == readWrite ? FILE_SHARE_WRITE : 0)), nullptr,
                          createType, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
 
@@ -531,6 +545,80 @@ void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exc
     }
 }
 
+void MemoryMappedFile::prefetch (Range<int64> rangeInFile) const noexcept
+{
+    const auto section = range.getIntersectionWith (rangeInFile);
+
+    if (address == nullptr || section.isEmpty())
+        return;
+
+    // PrefetchVirtualMemory is only available from Windows 8 onwards
+    struct MemoryRangeEntry { void* virtualAddress; SIZE_T numberOfBytes; };
+    using PrefetchVirtualMemoryFn = BOOL (WINAPI*) (HANDLE, ULONG_PTR, MemoryRangeEntry*, ULONG);
+
+    static const auto prefetchVirtualMemory = (PrefetchVirtualMemoryFn) GetProcAddress (GetModuleHandleA ("kernel32.dll"),
+                                                                                         "PrefetchVirtualMemory");
+
+    if (prefetchVirtualMemory != nullptr)
+    {
+        MemoryRangeEntry entry { addBytesToPointer (address, section.getStart() - range.getStart()),
+                                 (SIZE_T) section.getLength() };
+
+        prefetchVirtualMemory (GetCurrentProcess(), 1, &entry, 0);
+    }
+}
+
+bool MemoryMappedFile::adviseAccessPattern (AccessPattern pattern, Range<int64> rangeInFile) const noexcept
+{
+    const auto section = range.getIntersectionWith (rangeInFile);
+
+    if (address == nullptr || section.isEmpty())
+        return false;
+
+    if (pattern == AccessPattern::willNeed)
+    {
+        prefetch (section);
+        return true;
+    }
+
+    if (pattern == AccessPattern::dontNeed && ! (exclusiveAccess && accessMode == readWrite))
+    {
+        // Unlocking pages that aren't locked removes them from the working set
+        VirtualUnlock (addBytesToPointer (address, section.getStart() - range.getStart()), (SIZE_T) section.getLength());
+        return true;
+    }
+
+    return false;
+}
+
+bool MemoryMappedFile::requestHugePages() const noexcept
+{
+    // Large pages can't be used for views of files on Windows
+    return false;
+}
+
+bool MemoryMappedFile::lockInMemory (Range<int64> rangeInFile) const noexcept
+{
+    const auto section = range.getIntersectionWith (rangeInFile);
+
+    if (address == nullptr || section.isEmpty())
+        return false;
+
+    if (VirtualLock (addBytesToPointer (address, section.getStart() - range.getStart()), (SIZE_T) section.getLength()))
+        return true;
+
+    prefault (section);
+    return false;
+}
+
+void MemoryMappedFile::unlockFromMemory (Range<int64> rangeInFile) const noexcept
+{
+    const auto section = range.getIntersectionWith (rangeInFile);
+
+    if (address != nullptr && ! section.isEmpty())
+        VirtualUnlock (addBytesToPointer (address, section.getStart() - range.getStart()), (SIZE_T) section.getLength());
+}
+
 MemoryMappedFile::~MemoryMappedFile()
 {
     if (address != nullptr)
@@ -1007,7 +1095,10 @@ public:
 
         if (handle == INVALID_HANDLE_VALUE)
         {
-            handle = FindFirstFile (directoryWithWildCard.toWideCharPointer(), &findData);
+            // The basic info level skips looking up the short 8.3 name, and the large fetch
+            // flag lets the OS return bigger batches of entries from each request.
+            handle = FindFirstFileEx (directoryWithWildCard.toWideCharPointer(), FindExInfoBasic, &findData,
+                                      FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
 
             if (handle == INVALID_HANDLE_VALUE)
                 return false;
@@ -40,6 +40,7 @@ struct CURLSymbols
     CURL* (*curl_easy_init) (void);
     CURLcode (*curl_easy_setopt) (CURL *curl, CURLoption option, ...);
     void (*curl_easy_cleanup) (CURL *curl);
+    void (*curl_easy_reset) (CURL *curl);
     CURLcode (*curl_easy_getinfo) (CURL *curl, CURLINFO info, ...);
     CURLMcode (*curl_multi_add_handle) (CURLM *multi_handle, CURL *curl_handle);
     CURLMcode (*curl_multi_cleanup) (CURLM *multi_handle);
@@ -52,6 +53,9 @@ struct CURLSymbols
     struct curl_slist* (*curl_slist_append) (struct curl_slist *, const char *);
     void (*curl_slist_free_all) (struct curl_slist *);
     curl_version_info_data* (*curl_version_info) (CURLversion);
+    CURLSH* (*curl_share_init) (void);
+    CURLSHcode (*curl_share_setopt) (CURLSH *share, CURLSHoption option, ...);
+    CURLSHcode (*curl_share_cleanup) (CURLSH *share);
 
     static std::unique_ptr<CURLSymbols> create()
     {
@@ -67,6 +71,7 @@ struct CURLSymbols
         JUCE_INIT_CURL_SYMBOL (curl_easy_init)
         JUCE_INIT_CURL_SYMBOL (curl_easy_setopt)
         JUCE_INIT_CURL_SYMBOL (curl_easy_cleanup)
+        JUCE_INIT_CURL_SYMBOL (curl_easy_reset)
         JUCE_INIT_CURL_SYMBOL (curl_easy_getinfo)
         JUCE_INIT_CURL_SYMBOL (curl_multi_add_handle)
         JUCE_INIT_CURL_SYMBOL (curl_multi_cleanup)
@@ -79,6 +84,9 @@ struct CURLSymbols
         JUCE_INIT_CURL_SYMBOL (curl_slist_append)
         JUCE_INIT_CURL_SYMBOL (curl_slist_free_all)
         JUCE_INIT_CURL_SYMBOL (curl_version_info)
+        JUCE_INIT_CURL_SYMBOL (curl_share_init)
+        JUCE_INIT_CURL_SYMBOL (curl_share_setopt)
+        JUCE_INIT_CURL_SYMBOL (curl_share_cleanup)
 
         return symbols;
     }
@@ -120,6 +128,124 @@ private:
 };
 
 
+//==============================================================================
+/*  Keeps hold of the curl handles belonging to streams that completed cleanly, so
+    that later requests can reuse them. Each multi handle owns a connection cache,
+    so reusing one lets a new request pick up a kept-alive (and, for HTTP/2,
+    multiplexed) connection to the same host instead of doing a fresh TCP and TLS
+    handshake. DNS lookups and TLS sessions are shared between all handles.
+*/
+class CurlHandlePool
+{
+public:
+    struct Handles
+    {
+        CURLM* multi = nullptr;
+        CURL* curl = nullptr;
+    };
+
+    static CurlHandlePool& getInstance()
+    {
+        static CurlHandlePool pool;
+        return pool;
+    }
+
+    /** Returns a pair of idle handles, or null handles if the pool is empty. */
+    Handles take()
+    {
+        const ScopedLock sl (lock);
+
+        if (idle.empty())
+            return {};
+
+        auto handles = idle.back();
+        idle.pop_back();
+        return handles;
+    }
+
+    /** Returns a pair of handles to the pool, or destroys them if the pool is full.
+        The easy handle must already have been removed from the multi handle.
+    */
+    void release (Handles handles)
+    {
+        if (symbols != nullptr)
+        {
+            symbols->curl_easy_reset (handles.curl);
+
+            const ScopedLock sl (lock);
+
+            if (idle.size() < maxIdleHandles)
+            {
+                idle.push_back (handles);
+                return;
+            }
+        }
+
+        destroy (handles);
+    }
+
+    CURLSH* getShareHandle() const noexcept     { return share; }
+
+private:
+    CurlHandlePool()
+    {
+        if (symbols == nullptr)
+            return;
+
+        share = symbols->curl_share_init();
+
+        if (share != nullptr)
+        {
+            symbols->curl_share_setopt (share, CURLSHOPT_USERDATA, this);
+            symbols->curl_share_setopt (share, CURLSHOPT_LOCKFUNC, lockShareData);
+            symbols->curl_share_setopt (share, CURLSHOPT_UNLOCKFUNC, unlockShareData);
+            symbols->curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            symbols->curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        }
+    }
+
+    ~CurlHandlePool()
+    {
+        for (auto& handles : idle)
+            destroy (handles);
+
+        if (share != nullptr)
+            symbols->curl_share_cleanup (share);
+    }
+
+    void destroy (Handles handles)
+    {
+        const ScopedLock sl (CURLSymbols::getLibcurlLock());
+        symbols->curl_easy_cleanup (handles.curl);
+        symbols->curl_multi_cleanup (handles.multi);
+    }
+
+    static void lockShareData (CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+    {
+        static_cast<CurlHandlePool*> (userptr)->getShareLock (data).enter();
+    }
+
+    static void unlockShareData (CURL*, curl_lock_data data, void* userptr)
+    {
+        static_cast<CurlHandlePool*> (userptr)->getShareLock (data).exit();
+    }
+
+    CriticalSection& getShareLock (curl_lock_data data) noexcept
+    {
+        return shareLocks[jlimit (0, (int) std::size (shareLocks) - 1, (int) data)];
+    }
+
+    static constexpr size_t maxIdleHandles = 8;
+
+    std::unique_ptr<CURLSymbols> symbols { CURLSymbols::create() };
+    CURLSH* share = nullptr;
+    CriticalSection shareLocks[CURL_LOCK_DATA_LAST];
+    CriticalSection lock;
+    std::vector<Handles> idle;
+
+    JUCE_DECLARE_NON_COPYABLE (CurlHandlePool)
+};
+
 //==============================================================================
 class WebInputStream::Pimpl
 {
@@ -133,6 +259,14 @@ public:
     {
         jassert (symbols); // Unable to load libcurl!
 
+        const auto pooled = CurlHandlePool::getInstance().take();
+
+        if (pooled.multi != nullptr)
+        {
+            multi = pooled.multi;
+            curl = pooled.curl;
+        }
+        else
         {
             const ScopedLock sl (CURLSymbols::getLibcurlLock());
             multi = symbols->curl_multi_init();
@@ -140,7 +274,8 @@ public:
 
         if (multi != nullptr)
         {
-            curl = symbols->curl_easy_init();
+            if (curl == nullptr)
+                curl = symbols->curl_easy_init();
 
             if (curl != nullptr)
                 if (symbols->curl_multi_add_handle (multi, curl) == CURLM_OK)
@@ -206,18 +341,32 @@ public:
     void cleanup()
     {
         const ScopedLock lock (cleanupLock);
-        const ScopedLock sl (CURLSymbols::getLibcurlLock());
+
+        // A transfer that ran to completion leaves its connection in a reusable
+        // state, so its handles can go back to the pool
+        const auto canBeReused = multi != nullptr && curl != nullptr && finished && lastError == CURLE_OK;
 
         if (curl != nullptr)
-        {
             symbols->curl_multi_remove_handle (multi, curl);
 
-            if (headerList != nullptr)
-            {
-                symbols->curl_slist_free_all (headerList);
-                headerList = nullptr;
-            }
+        if (headerList != nullptr)
+        {
+            symbols->curl_slist_free_all (headerList);
+            headerList = nullptr;
+        }
+
+        if (canBeReused)
+        {
+            CurlHandlePool::getInstance().release ({ multi, curl });
+            multi = nullptr;
+            curl = nullptr;
+            return;
+        }
 
+        const ScopedLock sl (CURLSymbols::getLibcurlLock());
+
+        if (curl != nullptr)
+        {
             symbols->curl_easy_cleanup (curl);
             curl = nullptr;
         }
@@ -286,6 +435,17 @@ public:
                 || symbols->curl_easy_setopt (curl, CURLOPT_HEADERFUNCTION, StaticCurlHeader) != CURLE_OK)
                 return false;
 
+            // These only affect performance, so failures (e.g. from an older libcurl,
+            // or one built without HTTP/2 support) are ignored
+            if (auto* share = CurlHandlePool::getInstance().getShareHandle())
+                symbols->curl_easy_setopt (curl, CURLOPT_SHARE, share);
+
+            symbols->curl_easy_setopt (curl, CURLOPT_TCP_KEEPALIVE, 1L);
+
+           #ifdef CURL_HTTP_VERSION_2TLS
+            symbols->curl_easy_setopt (curl, CURLOPT_HTTP_VERSION, (long) CURL_HTTP_VERSION_2TLS);
+           #endif
+
             if (timeOutMs > 0)
             {
                 auto timeOutSecs = ((long) timeOutMs + 999) / 1000;
@@ -481,8 +641,9 @@ public:
         }
         else
         {
-            // if curl does not return any sockets for to wait on, then the doc says to wait 100 ms
-            Thread::sleep (100);
+            // if curl does not return any sockets for to wait on, then the doc says to wait 100 ms,
+            // but there's no need to wait that long if curl has asked to be called again sooner
+            Thread::sleep ((int) jmin (curl_timeo, 100L));
         }
 
         int still_running = 0;
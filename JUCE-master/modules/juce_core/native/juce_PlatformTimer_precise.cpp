@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Sleeps until a given time, or until wake() is called, using the most precise
+    timer that the platform has: a timerfd on Linux and Android, and a high-resolution
+    waitable timer on Windows. Other platforms use a WaitableEvent.
+*/
+class PreciseSleeper
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    PreciseSleeper()
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        timerFd = timerfd_create (CLOCK_MONOTONIC, TFD_CLOEXEC);
+        wakeFd = eventfd (0, EFD_CLOEXEC);
+       #elif JUCE_WINDOWS
+        // CREATE_WAITABLE_TIMER_HIGH_RESOLUTION is only available from Windows 10 1803
+        timer = CreateWaitableTimerExW (nullptr, nullptr, 0x00000002 /* CREATE_WAITABLE_TIMER_HIGH_RESOLUTION */, TIMER_ALL_ACCESS);
+
+        if (timer == nullptr)
+            timer = CreateWaitableTimerExW (nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+
+        wakeEvent = CreateEvent (nullptr, TRUE, FALSE, nullptr);
+       #endif
+    }
+
+    ~PreciseSleeper()
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        for (auto fd : { timerFd, wakeFd })
+            if (fd >= 0)
+                close (fd);
+       #elif JUCE_WINDOWS
+        for (auto handle : { timer, wakeEvent })
+            if (handle != nullptr)
+                CloseHandle (handle);
+       #endif
+    }
+
+    /** Returns false if wake() has been called. */
+    bool sleepUntil (Clock::time_point time)
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        if (timerFd >= 0 && wakeFd >= 0)
+        {
+            // The kernel's CLOCK_MONOTONIC is what steady_clock uses
+            const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds> (time.time_since_epoch()).count();
+
+            itimerspec spec{};
+            spec.it_value.tv_sec  = (decltype (spec.it_value.tv_sec))  (nanos / 1'000'000'000);
+            spec.it_value.tv_nsec = (decltype (spec.it_value.tv_nsec)) (nanos % 1'000'000'000);
+
+            if (timerfd_settime (timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0)
+            {
+                pollfd fds[] { { timerFd, POLLIN, 0 }, { wakeFd, POLLIN, 0 } };
+
+                while (poll (fds, 2, -1) < 0 && errno == EINTR) {}
+
+                if ((fds[1].revents & POLLIN) != 0)
+                    return false;
+
+                uint64 numExpirations = 0;
+                [[maybe_unused]] const auto bytesRead = read (timerFd, &numExpirations, sizeof (numExpirations));
+                return true;
+            }
+        }
+       #elif JUCE_WINDOWS
+        if (timer != nullptr && wakeEvent != nullptr)
+        {
+            const auto hundredsOfNanos = std::chrono::duration_cast<std::chrono::duration<LONGLONG, std::ratio<1, 10'000'000>>> (time - Clock::now()).count();
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -jmax ((LONGLONG) 1, hundredsOfNanos);
+
+            if (SetWaitableTimer (timer, &dueTime, 0, nullptr, nullptr, FALSE))
+            {
+                const HANDLE handles[] { timer, wakeEvent };
+                return WaitForMultipleObjects (2, handles, FALSE, INFINITE) != WAIT_OBJECT_0 + 1;
+            }
+        }
+       #endif
+
+        const auto millisecondsUntil = std::chrono::duration<double, std::milli> (time - Clock::now()).count();
+        return ! woken.wait (jmax (0.0, millisecondsUntil));
+    }
+
+    bool hasBeenWoken() const
+    {
+        return wasWoken.load (std::memory_order_relaxed);
+    }
+
+    void wake()
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        if (wakeFd >= 0)
+            eventfd_write (wakeFd, 1);
+       #elif JUCE_WINDOWS
+        if (wakeEvent != nullptr)
+            SetEvent (wakeEvent);
+       #endif
+
+        wasWoken = true;
+        woken.signal();
+    }
+
+private:
+   #if JUCE_LINUX || JUCE_ANDROID
+    int timerFd = -1, wakeFd = -1;
+   #elif JUCE_WINDOWS
+    HANDLE timer = nullptr, wakeEvent = nullptr;
+   #endif
+
+    std::atomic<bool> wasWoken { false };
+    WaitableEvent woken { true };
+
+    JUCE_DECLARE_NON_COPYABLE (PreciseSleeper)
+    JUCE_DECLARE_NON_MOVEABLE (PreciseSleeper)
+};
+
+//==============================================================================
+/*  A timer for HighResolutionTimer::Precision::precise. It sleeps on a PreciseSleeper
+    until shortly before each callback is due, and then busy-waits for the rest of the
+    time. The callback times are calculated from the time the timer was started, so
+    that any lateness doesn't accumulate.
+*/
+class PrecisePlatformTimer final : private Thread
+{
+public:
+    explicit PrecisePlatformTimer (PlatformTimerListener& ptl)
+        : Thread { "PreciseHighResolutionTimerThread" },
+          listener { ptl }
+    {
+        if (startRealtimeThread (RealtimeOptions{}.withPriority (10)))
+            return;
+
+        // Realtime threads usually need special permissions on Linux, so try again
+        // without them
+        if (startThread (Priority::highest))
+            return;
+
+        // This likely suggests there are too many threads running!
+        jassertfalse;
+    }
+
+    ~PrecisePlatformTimer() override
+    {
+        signalThreadShouldExit();
+
+        {
+            std::scoped_lock lock { runCopyMutex };
+
+            if (timer != nullptr)
+                timer->cancel();
+        }
+
+        stopThread (-1);
+    }
+
+    void startTimer (double newIntervalMs)
+    {
+        jassert (newIntervalMs > 0.0);
+        jassert (timer == nullptr);
+
+        {
+            std::scoped_lock lock { runCopyMutex };
+            timer = std::make_shared<Timer> (listener, newIntervalMs);
+        }
+
+        notify();
+    }
+
+    void cancelTimer()
+    {
+        jassert (timer != nullptr);
+
+        timer->cancel();
+
+        std::scoped_lock lock { runCopyMutex };
+        timer = nullptr;
+    }
+
+    double getIntervalMs() const
+    {
+        return isThreadRunning() && timer != nullptr ? timer->getIntervalMs() : 0.0;
+    }
+
+private:
+    void run() final
+    {
+        const auto copyTimer = [&]
+        {
+            std::scoped_lock lock { runCopyMutex };
+            return timer;
+        };
+
+        while (! threadShouldExit())
+        {
+            if (auto t = copyTimer())
+                t->run();
+
+            wait (-1);
+        }
+    }
+
+    class Timer
+    {
+    public:
+        using Clock = PreciseSleeper::Clock;
+
+        Timer (PlatformTimerListener& l, double i)
+            : listener { l }, intervalMs { i } {}
+
+        double getIntervalMs() const
+        {
+            return intervalMs;
+        }
+
+        void cancel()
+        {
+            sleeper.wake();
+        }
+
+        void run()
+        {
+           #if JUCE_MAC || JUCE_IOS
+            tryToUpgradeCurrentThreadToRealtime (Thread::RealtimeOptions{}.withPeriodMs (intervalMs));
+           #endif
+
+            const auto interval = std::chrono::duration_cast<Clock::duration> (std::chrono::duration<double, std::milli> (intervalMs));
+
+            for (int64 numCallbacks = 1;; ++numCallbacks)
+            {
+                const auto callbackTime = startTime + interval * numCallbacks;
+
+                if (! waitUntil (callbackTime))
+                    return;
+
+                listener.onTimerExpired();
+
+                // If a callback took longer than the interval, skip the callbacks that
+                // were missed, rather than making them all at once to catch up
+                const auto now = Clock::now();
+
+                if (now > callbackTime + interval)
+                    numCallbacks = (now - startTime) / interval;
+            }
+        }
+
+    private:
+        bool waitUntil (Clock::time_point callbackTime)
+        {
+            const auto sleepEndTime = callbackTime - busyWaitTime;
+
+            if (Clock::now() < sleepEndTime)
+            {
+                if (! sleeper.sleepUntil (sleepEndTime))
+                    return false;
+
+                // Keep the busy-wait a bit longer than the time it usually takes to wake up
+                const auto lateness = jmax (Clock::duration::zero(), Clock::now() - sleepEndTime);
+                averageLateness = (averageLateness * 7 + lateness) / 8;
+                busyWaitTime = jlimit (minBusyWaitTime, maxBusyWaitTime, averageLateness * 2 + minBusyWaitTime);
+            }
+
+            while (Clock::now() < callbackTime)
+            {
+                if (sleeper.hasBeenWoken())
+                    return false;
+
+                detail::pauseCpu (16);
+            }
+
+            return ! sleeper.hasBeenWoken();
+        }
+
+        static constexpr Clock::duration minBusyWaitTime = std::chrono::microseconds (50);
+        static constexpr Clock::duration maxBusyWaitTime = std::chrono::milliseconds (2);
+
+        PlatformTimerListener& listener;
+        const double intervalMs;
+        const Clock::time_point startTime = Clock::now();
+        Clock::duration averageLateness { std::chrono::microseconds (500) };
+        Clock::duration busyWaitTime = maxBusyWaitTime;
+        PreciseSleeper sleeper;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Timer)
+        JUCE_DECLARE_NON_MOVEABLE (Timer)
+    };
+
+    PlatformTimerListener& listener;
+    mutable std::mutex runCopyMutex;
+    std::shared_ptr<Timer> timer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PrecisePlatformTimer)
+    JUCE_DECLARE_NON_MOVEABLE (PrecisePlatformTimer)
+};
+
+} // namespace juce
@@ -48,13 +48,46 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { pthread_mutex_destroy (&lock); }
-void CriticalSection::enter() const noexcept        { pthread_mutex_lock (&lock); }
-bool CriticalSection::tryEnter() const noexcept     { return pthread_mutex_trylock (&lock) == 0; }
 void CriticalSection::exit() const noexcept         { pthread_mutex_unlock (&lock); }
 
+bool CriticalSection::tryEnter() const noexcept
+{
+   #if JUCE_ENABLE_LOCK_PROFILING
+    if (pthread_mutex_trylock (&lock) != 0)
+        return false;
+
+    detail::lockAcquired (this, false, 0);
+    return true;
+   #else
+    return pthread_mutex_trylock (&lock) == 0;
+   #endif
+}
+
+void CriticalSection::enter() const noexcept
+{
+    if (tryEnter())
+        return;
+
+    JUCE_REPORT_REALTIME_VIOLATION (lockContention)
+
+   #if JUCE_ENABLE_LOCK_PROFILING
+    const auto waitStartTicks = Time::getHighResolutionTicks();
+   #endif
+
+    // The lock is usually released again sooner than it would take to sleep and wake up
+    if (! detail::spinBeforeBlocking ([this] { return pthread_mutex_trylock (&lock) == 0; }))
+        pthread_mutex_lock (&lock);
+
+   #if JUCE_ENABLE_LOCK_PROFILING
+    detail::lockAcquired (this, true, waitStartTicks);
+   #endif
+}
+
 //==============================================================================
 void JUCE_CALLTYPE Thread::sleep (int millisecs)
 {
+    JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+
     struct timespec time;
     time.tv_sec = millisecs / 1000;
     time.tv_nsec = (millisecs % 1000) * 1000000;
@@ -447,6 +480,34 @@ int64 juce_fileSetPosition (detail::NativeFileHandle handle, int64 pos)
     return -1;
 }
 
+int64 juce_fileReadAt (detail::NativeFileHandle handle, int64 pos, void* buffer, size_t numBytes)
+{
+    if (! handle.isValid())
+        return -1;
+
+    size_t numDone = 0;
+
+    while (numDone < numBytes)
+    {
+        auto result = pread (handle.get(), static_cast<char*> (buffer) + numDone, numBytes - numDone, (off_t) (pos + (int64) numDone));
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        if (result == 0)
+            break;
+
+        numDone += (size_t) result;
+    }
+
+    return (int64) numDone;
+}
+
 void FileInputStream::openHandle()
 {
     auto f = open (file.getFullPathName().toUTF8(), O_RDONLY);
@@ -607,6 +668,90 @@ void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exc
     }
 }
 
+static bool getPageAlignedSection (void* address, Range<int64> mappedRange, Range<int64> rangeInFile,
+                                   void*& start, size_t& numBytes) noexcept
+{
+    const auto section = mappedRange.getIntersectionWith (rangeInFile);
+
+    if (address == nullptr || section.isEmpty())
+        return false;
+
+    // The start of the mapping is page-aligned, so only the offset into it needs rounding
+    const auto pageSize = (int64) sysconf (_SC_PAGE_SIZE);
+    const auto offset = ((section.getStart() - mappedRange.getStart()) / pageSize) * pageSize;
+
+    start = addBytesToPointer (address, offset);
+    numBytes = (size_t) (section.getEnd() - mappedRange.getStart() - offset);
+    return true;
+}
+
+void MemoryMappedFile::prefetch (Range<int64> rangeInFile) const noexcept
+{
+    adviseAccessPattern (AccessPattern::willNeed, rangeInFile);
+}
+
+bool MemoryMappedFile::adviseAccessPattern (AccessPattern pattern, Range<int64> rangeInFile) const noexcept
+{
+    void* start = nullptr;
+    size_t numBytes = 0;
+
+    if (! getPageAlignedSection (address, range, rangeInFile, start, numBytes))
+        return false;
+
+    const auto advice = [&]
+    {
+        switch (pattern)
+        {
+            case AccessPattern::sequential:  return MADV_SEQUENTIAL;
+            case AccessPattern::random:      return MADV_RANDOM;
+            case AccessPattern::willNeed:    return MADV_WILLNEED;
+            case AccessPattern::dontNeed:    return MADV_DONTNEED;
+            case AccessPattern::normal:      break;
+        }
+
+        return MADV_NORMAL;
+    }();
+
+    // On a private writable mapping, MADV_DONTNEED would discard any modified pages
+    if (advice == MADV_DONTNEED && exclusiveAccess && accessMode == readWrite)
+        return false;
+
+    return madvise (start, numBytes, advice) == 0;
+}
+
+bool MemoryMappedFile::requestHugePages() const noexcept
+{
+   #if defined (MADV_HUGEPAGE)
+    return address != nullptr && madvise (address, (size_t) range.getLength(), MADV_HUGEPAGE) == 0;
+   #else
+    return false;
+   #endif
+}
+
+bool MemoryMappedFile::lockInMemory (Range<int64> rangeInFile) const noexcept
+{
+    void* start = nullptr;
+    size_t numBytes = 0;
+
+    if (! getPageAlignedSection (address, range, rangeInFile, start, numBytes))
+        return false;
+
+    if (mlock (start, numBytes) == 0)
+        return true;
+
+    prefault (rangeInFile);
+    return false;
+}
+
+void MemoryMappedFile::unlockFromMemory (Range<int64> rangeInFile) const noexcept
+{
+    void* start = nullptr;
+    size_t numBytes = 0;
+
+    if (getPageAlignedSection (address, range, rangeInFile, start, numBytes))
+        munlock (start, numBytes);
+}
+
 MemoryMappedFile::~MemoryMappedFile()
 {
     if (address != nullptr)
@@ -1027,41 +1172,48 @@ void JUCE_CALLTYPE Thread::yield()
  #define SUPPORT_AFFINITIES 1
 #endif
 
-void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask ([[maybe_unused]] uint32 affinityMask)
+void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (uint32 affinityMask)
+{
+    [[maybe_unused]] const auto result = setCurrentThreadAffinity (BigInteger (affinityMask));
+
+    // affinities aren't supported because either the appropriate header files weren't found,
+    // or the SUPPORT_AFFINITIES macro was turned off
+    jassert (result || affinityMask == 0);
+}
+
+bool JUCE_CALLTYPE Thread::setCurrentThreadAffinity ([[maybe_unused]] const BigInteger& cpus)
 {
    #if SUPPORT_AFFINITIES
+    if (cpus.isZero())
+        return false;
+
     cpu_set_t affinity;
     CPU_ZERO (&affinity);
 
-    for (int i = 0; i < 32; ++i)
+    for (int i = cpus.findNextSetBit (0); i >= 0 && i < CPU_SETSIZE; i = cpus.findNextSetBit (i + 1))
     {
-        if ((affinityMask & (uint32) (1 << i)) != 0)
-        {
-            // GCC 12 on FreeBSD complains about CPU_SET irrespective of
-            // the type of the first argument
-            JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wsign-conversion")
-            CPU_SET ((size_t) i, &affinity);
-            JUCE_END_IGNORE_WARNINGS_GCC_LIKE
-        }
+        // GCC 12 on FreeBSD complains about CPU_SET irrespective of
+        // the type of the first argument
+        JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wsign-conversion")
+        CPU_SET ((size_t) i, &affinity);
+        JUCE_END_IGNORE_WARNINGS_GCC_LIKE
     }
 
    #if (! JUCE_ANDROID) && ((! (JUCE_LINUX || JUCE_BSD)) || ((__GLIBC__ * 1000 + __GLIBC_MINOR__) >= 2004))
-    pthread_setaffinity_np (pthread_self(), sizeof (cpu_set_t), &affinity);
+    const auto result = pthread_setaffinity_np (pthread_self(), sizeof (cpu_set_t), &affinity);
    #elif JUCE_ANDROID
-    sched_setaffinity (gettid(), sizeof (cpu_set_t), &affinity);
+    const auto result = sched_setaffinity (gettid(), sizeof (cpu_set_t), &affinity);
    #else
     // NB: this call isn't really correct because it sets the affinity of the process,
     // (getpid) not the thread (not gettid). But it's included here as a fallback for
     // people who are using ridiculously old versions of glibc
-    sched_setaffinity (getpid(), sizeof (cpu_set_t), &affinity);
+    const auto result = sched_setaffinity (getpid(), sizeof (cpu_set_t), &affinity);
    #endif
 
     sched_yield();
-
+    return result == 0;
    #else
-    // affinities aren't supported because either the appropriate header files weren't found,
-    // or the SUPPORT_AFFINITIES macro was turned off
-    jassertfalse;
+    return false;
    #endif
 }
 
@@ -1101,6 +1253,121 @@ static String readPosixConfigFileValue (const char* file, const char* key)
 
     return {};
 }
+
+namespace CpuTopologyHelpers
+{
+    static String readSysfsValue (const String& path)
+    {
+        return File (path).loadFileAsString().trim();
+    }
+
+    // Parses the kernel's cpu-list format, e.g. "0-3,8,10-11"
+    static std::vector<int> parseCpuList (const String& text)
+    {
+        std::vector<int> result;
+
+        for (const auto& token : StringArray::fromTokens (text, ",", {}))
+        {
+            const auto range = token.trim();
+
+            if (range.isEmpty())
+                continue;
+
+            const auto first = range.upToFirstOccurrenceOf ("-", false, false).getIntValue();
+            const auto last  = range.containsChar ('-') ? range.fromFirstOccurrenceOf ("-", false, false).getIntValue()
+                                                        : first;
+
+            for (int i = first; i <= last; ++i)
+                result.push_back (i);
+        }
+
+        return result;
+    }
+
+    static std::vector<SystemStats::LogicalCpu> readFromSysfs()
+    {
+        const String cpuRoot ("/sys/devices/system/cpu/");
+        const auto indices = parseCpuList (readSysfsValue (cpuRoot + "present"));
+
+        if (indices.empty())
+            return {};
+
+        std::vector<SystemStats::LogicalCpu> result;
+        std::map<std::pair<int, int>, int> coreIndices;
+
+        for (auto index : indices)
+        {
+            const auto topologyDir = cpuRoot + "cpu" + String (index) + "/topology/";
+            const auto coreId      = readSysfsValue (topologyDir + "core_id");
+
+            if (coreId.isEmpty())
+                continue;
+
+            SystemStats::LogicalCpu cpu;
+            cpu.index = index;
+            cpu.package = jmax (0, readSysfsValue (topologyDir + "physical_package_id").getIntValue());
+
+            // core_id is only unique within a package, so build a global index instead
+            const auto key = std::make_pair (cpu.package, coreId.getIntValue());
+            cpu.physicalCore = coreIndices.emplace (key, (int) coreIndices.size()).first->second;
+
+            result.push_back (cpu);
+        }
+
+        const auto findCpu = [&] (int index) -> SystemStats::LogicalCpu*
+        {
+            for (auto& cpu : result)
+                if (cpu.index == index)
+                    return &cpu;
+
+            return nullptr;
+        };
+
+        for (const auto& entry : RangedDirectoryIterator (File ("/sys/devices/system/node"), false, "node*", File::findDirectories))
+        {
+            const auto node = entry.getFile().getFileName().substring (4);
+
+            if (! node.containsOnly ("0123456789"))
+                continue;
+
+            for (auto index : parseCpuList (readSysfsValue (entry.getFile().getChildFile ("cpulist").getFullPathName())))
+                if (auto* cpu = findCpu (index))
+                    cpu->numaNode = node.getIntValue();
+        }
+
+        // Intel hybrid parts expose separate PMUs for their P and E cores..
+        const auto performanceCpus = parseCpuList (readSysfsValue ("/sys/devices/cpu_core/cpus"));
+        const auto efficiencyCpus  = parseCpuList (readSysfsValue ("/sys/devices/cpu_atom/cpus"));
+
+        if (! performanceCpus.empty() && ! efficiencyCpus.empty())
+        {
+            for (auto index : performanceCpus)
+                if (auto* cpu = findCpu (index))
+                    cpu->coreType = SystemStats::CpuCoreType::performance;
+
+            for (auto index : efficiencyCpus)
+                if (auto* cpu = findCpu (index))
+                    cpu->coreType = SystemStats::CpuCoreType::efficiency;
+
+            return result;
+        }
+
+        // ..whereas ARM big.LITTLE systems report a relative capacity for each CPU
+        std::vector<int> capacities;
+
+        for (const auto& cpu : result)
+            capacities.push_back (readSysfsValue (cpuRoot + "cpu" + String (cpu.index) + "/cpu_capacity").getIntValue());
+
+        const auto [minCapacity, maxCapacity] = std::minmax_element (capacities.begin(), capacities.end());
+
+        if (minCapacity != capacities.end() && *minCapacity > 0 && *minCapacity != *maxCapacity)
+            for (size_t i = 0; i < result.size(); ++i)
+                result[i].coreType = capacities[i] == *maxCapacity ? SystemStats::CpuCoreType::performance
+                                                                   : SystemStats::CpuCoreType::efficiency;
+
+        return result;
+    }
+}
 #endif
 
 
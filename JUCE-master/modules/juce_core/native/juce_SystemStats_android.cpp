@@ -208,6 +208,11 @@ String SystemStats::getUniqueDeviceID()
 }
 
 //==============================================================================
+static std::vector<SystemStats::LogicalCpu> getNativeCpuTopology()
+{
+    return CpuTopologyHelpers::readFromSysfs();
+}
+
 void CPUInformation::initialise() noexcept
 {
     numPhysicalCPUs = numLogicalCPUs = jmax ((int) 1, (int) android_getCpuCount());
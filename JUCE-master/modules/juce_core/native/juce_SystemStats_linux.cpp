@@ -266,7 +266,8 @@ void CPUInformation::initialise() noexcept
                                     hasAVX512BW,
                                     hasAVX512VL,
                                     hasAVX512VBMI,
-                                    hasAVX512VPOPCNTDQ);
+                                    hasAVX512VPOPCNTDQ,
+                                    hasSHA);
    #endif
 
     numLogicalCPUs = numPhysicalCPUs = []
@@ -305,6 +306,7 @@ void CPUInformation::initialise() noexcept
     hasAVX512VBMI      = flags.contains ("avx512vbmi");
     hasAVX512VL        = flags.contains ("avx512vl");
     hasAVX512VPOPCNTDQ = flags.contains ("avx512_vpopcntdq");
+    hasSHA             = flags.contains ("sha_ni");
 
     numLogicalCPUs  = getCpuInfo ("processor").getIntValue() + 1;
 
@@ -316,6 +318,15 @@ void CPUInformation::initialise() noexcept
   #endif
 }
 
+static std::vector<SystemStats::LogicalCpu> getNativeCpuTopology()
+{
+   #if JUCE_BSD
+    return {};
+   #else
+    return CpuTopologyHelpers::readFromSysfs();
+   #endif
+}
+
 String SystemStats::getUniqueDeviceID()
 {
     static const auto deviceId = []()
@@ -80,7 +80,8 @@ void CPUInformation::initialise() noexcept
                                     hasAVX512BW,
                                     hasAVX512VL,
                                     hasAVX512VBMI,
-                                    hasAVX512VPOPCNTDQ);
+                                    hasAVX512VPOPCNTDQ,
+                                    hasSHA);
    #elif JUCE_ARM && __ARM_ARCH > 7
     hasNeon = true;
    #endif
@@ -97,6 +98,51 @@ void CPUInformation::initialise() noexcept
         numPhysicalCPUs = numLogicalCPUs;
 }
 
+static std::vector<SystemStats::LogicalCpu> getNativeCpuTopology()
+{
+    const auto getSysctlInt = [] (const String& name)
+    {
+        int value = 0;
+        size_t len = sizeof (value);
+        return sysctlbyname (name.toRawUTF8(), &value, &len, nullptr, 0) >= 0 ? value : 0;
+    };
+
+    // Apple silicon reports one "perflevel" per core type, with perflevel0 being the fastest.
+    // macOS doesn't let threads be pinned to specific CPUs, so these indices are only
+    // representative of how many cores of each kind are available.
+    const auto numLevels = getSysctlInt ("hw.nperflevels");
+
+    if (numLevels <= 0)
+        return {};
+
+    std::vector<SystemStats::LogicalCpu> result;
+    int numCores = 0;
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        const auto prefix = "hw.perflevel" + String (level) + ".";
+        const auto numLogical  = getSysctlInt (prefix + "logicalcpu");
+        const auto numPhysical = jlimit (1, jmax (1, numLogical), getSysctlInt (prefix + "physicalcpu"));
+
+        const auto type = numLevels == 1 ? SystemStats::CpuCoreType::unknown
+                                         : (level == 0 ? SystemStats::CpuCoreType::performance
+                                                       : SystemStats::CpuCoreType::efficiency);
+
+        for (int i = 0; i < numLogical; ++i)
+        {
+            SystemStats::LogicalCpu cpu;
+            cpu.index = (int) result.size();
+            cpu.physicalCore = numCores + (i * numPhysical) / numLogical;
+            cpu.coreType = type;
+            result.push_back (cpu);
+        }
+
+        numCores += numPhysical;
+    }
+
+    return result;
+}
+
 //==============================================================================
 #if ! JUCE_IOS
 static String getOSXVersion()
@@ -65,6 +65,11 @@ void CPUInformation::initialise() noexcept
     numPhysicalCPUs = 1;
 }
 
+static std::vector<SystemStats::LogicalCpu> getNativeCpuTopology()
+{
+    return {};
+}
+
 //==============================================================================
 uint32 juce_millisecondsSinceStartup() noexcept
 {
@@ -73,6 +73,96 @@ static int findNumberOfPhysicalCores() noexcept
     });
 }
 
+static std::vector<SystemStats::LogicalCpu> getNativeCpuTopology()
+{
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformationEx (RelationAll, nullptr, &bufferSize);
+
+    if (bufferSize == 0)
+        return {};
+
+    HeapBlock<char> buffer (bufferSize);
+
+    if (! GetLogicalProcessorInformationEx (RelationAll, unalignedPointerCast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*> (buffer.get()), &bufferSize))
+        return {};
+
+    // Logical CPU indices run through each processor group in turn
+    std::vector<int> groupOffsets;
+    int numLogical = 0;
+
+    for (WORD group = 0; group < GetActiveProcessorGroupCount(); ++group)
+    {
+        groupOffsets.push_back (numLogical);
+        numLogical += (int) GetActiveProcessorCount (group);
+    }
+
+    std::vector<SystemStats::LogicalCpu> result ((size_t) numLogical);
+
+    for (int i = 0; i < numLogical; ++i)
+        result[(size_t) i].index = i;
+
+    std::vector<BYTE> efficiencyClasses ((size_t) numLogical, 0);
+
+    const auto forEachCpu = [&] (const GROUP_AFFINITY& affinity, auto&& fn)
+    {
+        if (affinity.Group >= groupOffsets.size())
+            return;
+
+        for (int bit = 0; bit < (int) (sizeof (KAFFINITY) * 8); ++bit)
+        {
+            const auto index = groupOffsets[affinity.Group] + bit;
+
+            if ((affinity.Mask & ((KAFFINITY) 1 << bit)) != 0 && index < numLogical)
+                fn ((size_t) index);
+        }
+    };
+
+    int numCores = 0, numPackages = 0;
+
+    for (DWORD offset = 0; offset < bufferSize;)
+    {
+        const auto& info = *unalignedPointerCast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*> (buffer.get() + offset);
+
+        if (info.Size == 0)
+            break;
+
+        if (info.Relationship == RelationProcessorCore)
+        {
+            for (WORD i = 0; i < info.Processor.GroupCount; ++i)
+                forEachCpu (info.Processor.GroupMask[i], [&] (size_t index)
+                {
+                    result[index].physicalCore = numCores;
+                    efficiencyClasses[index] = info.Processor.EfficiencyClass;
+                });
+
+            ++numCores;
+        }
+        else if (info.Relationship == RelationProcessorPackage)
+        {
+            for (WORD i = 0; i < info.Processor.GroupCount; ++i)
+                forEachCpu (info.Processor.GroupMask[i], [&] (size_t index) { result[index].package = numPackages; });
+
+            ++numPackages;
+        }
+        else if (info.Relationship == RelationNumaNode)
+        {
+            forEachCpu (info.NumaNode.GroupMask, [&] (size_t index) { result[index].numaNode = (int) info.NumaNode.NodeNumber; });
+        }
+
+        offset += info.Size;
+    }
+
+    // Higher efficiency classes are faster cores, and all cores share one class on non-hybrid systems
+    const auto [minClass, maxClass] = std::minmax_element (efficiencyClasses.begin(), efficiencyClasses.end());
+
+    if (minClass != efficiencyClasses.end() && *minClass != *maxClass)
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i].coreType = efficiencyClasses[i] == *maxClass ? SystemStats::CpuCoreType::performance
+                                                                   : SystemStats::CpuCoreType::efficiency;
+
+    return result;
+}
+
 //==============================================================================
 #if JUCE_INTEL
  #if JUCE_MSVC && ! defined (__INTEL_COMPILER)
@@ -178,6 +268,7 @@ void CPUInformation::initialise() noexcept
     hasAVX512VL        = ((unsigned int) info[1] & (1u << 31)) != 0;
     hasAVX512VBMI      = ((unsigned int) info[2] & (1u <<  1)) != 0;
     hasAVX512VPOPCNTDQ = ((unsigned int) info[2] & (1u << 14)) != 0;
+    hasSHA             = ((unsigned int) info[1] & (1u << 29)) != 0;
 
     SYSTEM_INFO systemInfo;
     GetNativeSystemInfo (&systemInfo);
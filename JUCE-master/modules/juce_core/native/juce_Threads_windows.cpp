@@ -59,10 +59,41 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { DeleteCriticalSection ((CRITICAL_SECTION*) &lock); }
-void CriticalSection::enter() const noexcept        { EnterCriticalSection ((CRITICAL_SECTION*) &lock); }
-bool CriticalSection::tryEnter() const noexcept     { return TryEnterCriticalSection ((CRITICAL_SECTION*) &lock) != FALSE; }
 void CriticalSection::exit() const noexcept         { LeaveCriticalSection ((CRITICAL_SECTION*) &lock); }
 
+bool CriticalSection::tryEnter() const noexcept
+{
+   #if JUCE_ENABLE_LOCK_PROFILING
+    if (TryEnterCriticalSection ((CRITICAL_SECTION*) &lock) == FALSE)
+        return false;
+
+    detail::lockAcquired (this, false, 0);
+    return true;
+   #else
+    return TryEnterCriticalSection ((CRITICAL_SECTION*) &lock) != FALSE;
+   #endif
+}
+
+void CriticalSection::enter() const noexcept
+{
+    if (tryEnter())
+        return;
+
+    JUCE_REPORT_REALTIME_VIOLATION (lockContention)
+
+   #if JUCE_ENABLE_LOCK_PROFILING
+    const auto waitStartTicks = Time::getHighResolutionTicks();
+   #endif
+
+    // The lock is usually released again sooner than it would take to sleep and wake up
+    if (! detail::spinBeforeBlocking ([this] { return TryEnterCriticalSection ((CRITICAL_SECTION*) &lock) != FALSE; }))
+        EnterCriticalSection ((CRITICAL_SECTION*) &lock);
+
+   #if JUCE_ENABLE_LOCK_PROFILING
+    detail::lockAcquired (this, true, waitStartTicks);
+   #endif
+}
+
 //==============================================================================
 static unsigned int STDMETHODCALLTYPE threadEntryProc (void* userData)
 {
@@ -184,6 +215,40 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMa
     SetThreadAffinityMask (GetCurrentThread(), affinityMask);
 }
 
+bool JUCE_CALLTYPE Thread::setCurrentThreadAffinity (const BigInteger& cpus)
+{
+    const auto firstCpu = cpus.findNextSetBit (0);
+
+    if (firstCpu < 0)
+        return false;
+
+    // Logical CPU indices run through each processor group in turn, and a thread can only
+    // belong to one group, so use the group containing the first CPU in the set
+    const auto numGroups = GetActiveProcessorGroupCount();
+    int firstIndexInGroup = 0;
+
+    for (WORD group = 0; group < numGroups; ++group)
+    {
+        const auto numInGroup = (int) GetActiveProcessorCount (group);
+
+        if (firstCpu < firstIndexInGroup + numInGroup)
+        {
+            GROUP_AFFINITY affinity{};
+            affinity.Group = group;
+
+            for (int i = 0; i < jmin (numInGroup, (int) (sizeof (KAFFINITY) * 8)); ++i)
+                if (cpus[firstIndexInGroup + i])
+                    affinity.Mask |= (KAFFINITY) 1 << i;
+
+            return SetThreadGroupAffinity (GetCurrentThread(), &affinity, nullptr) != 0;
+        }
+
+        firstIndexInGroup += numInGroup;
+    }
+
+    return false;
+}
+
 //==============================================================================
 struct SleepEvent
 {
@@ -211,6 +276,8 @@ void JUCE_CALLTYPE Thread::sleep (const int millisecs)
 {
     jassert (millisecs >= 0);
 
+    JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+
     if (millisecs >= 10 || sleepEvent.handle == nullptr)
         Sleep ((DWORD) millisecs);
     else
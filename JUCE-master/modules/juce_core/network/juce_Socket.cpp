@@ -532,6 +532,26 @@ int StreamingSocket::write (const void* sourceBuffer, int numBytesToWrite)
     return (int) ::send ((SocketHandle) handle.load(), (const char*) sourceBuffer, (juce_recvsend_size_t) numBytesToWrite, 0);
 }
 
+int StreamingSocket::getNumBytesAvailable() const
+{
+    if (isListener || ! connected)
+        return -1;
+
+   #if JUCE_WINDOWS
+    u_long numBytes = 0;
+
+    if (ioctlsocket ((SOCKET) handle.load(), (long) FIONREAD, &numBytes) != 0)
+        return -1;
+   #else
+    int numBytes = 0;
+
+    if (ioctl (handle.load(), FIONREAD, &numBytes) != 0)
+        return -1;
+   #endif
+
+    return (int) numBytes;
+}
+
 //==============================================================================
 int StreamingSocket::waitUntilReady (bool readyForReading, int timeoutMsecs)
 {
@@ -212,6 +212,15 @@ public:
     int read (void* destBuffer, int maxBytesToRead,
               bool blockUntilSpecifiedAmountHasArrived);
 
+    /** Returns the number of bytes that are waiting to be read, so that exactly that
+        amount can be read without blocking.
+
+        @returns  the number of bytes available, or -1 if the socket isn't connected or
+                  an error occurs
+        @see read, SocketReactor
+    */
+    int getNumBytesAvailable() const;
+
     /** Writes bytes to the socket from a buffer.
 
         Note that this method will block unless you have checked the socket is ready
@@ -0,0 +1,445 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SocketReactor::Poller final : private Thread
+{
+public:
+    explicit Poller (int index)
+        : Thread ("Socket reactor " + String (index))
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        pollHandle = epoll_create1 (EPOLL_CLOEXEC);
+        wakeHandle = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = wakeHandle;
+        epoll_ctl (pollHandle, EPOLL_CTL_ADD, wakeHandle, &event);
+       #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+        pollHandle = kqueue();
+
+        struct kevent change;
+        EV_SET (&change, 0, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, nullptr);
+        kevent (pollHandle, &change, 1, nullptr, 0, nullptr);
+       #endif
+
+        startThread (Priority::high);
+    }
+
+    ~Poller() override
+    {
+        signalThreadShouldExit();
+        wake();
+        stopThread (-1);
+
+       #if JUCE_LINUX || JUCE_ANDROID
+        ::close (wakeHandle);
+        ::close (pollHandle);
+       #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+        ::close (pollHandle);
+       #endif
+    }
+
+    bool add (int handle, Callback callback)
+    {
+        {
+            const ScopedLock sl (registrationLock);
+
+            if (! callbacks.emplace (handle, std::make_shared<Callback> (std::move (callback))).second)
+                return false;
+        }
+
+       #if JUCE_LINUX || JUCE_ANDROID
+        epoll_event event {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = handle;
+
+        if (epoll_ctl (pollHandle, EPOLL_CTL_ADD, handle, &event) != 0)
+        {
+            const ScopedLock sl (registrationLock);
+            callbacks.erase (handle);
+            return false;
+        }
+       #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+        struct kevent change;
+        EV_SET (&change, (uintptr_t) handle, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+
+        if (kevent (pollHandle, &change, 1, nullptr, 0, nullptr) != 0)
+        {
+            const ScopedLock sl (registrationLock);
+            callbacks.erase (handle);
+            return false;
+        }
+       #endif
+
+        return true;
+    }
+
+    void remove (int handle)
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        epoll_ctl (pollHandle, EPOLL_CTL_DEL, handle, nullptr);
+       #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+        struct kevent change;
+        EV_SET (&change, (uintptr_t) handle, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+        kevent (pollHandle, &change, 1, nullptr, 0, nullptr);
+       #endif
+
+        {
+            const ScopedLock sl (registrationLock);
+            callbacks.erase (handle);
+        }
+
+        // Wait for any callback that's already in progress to finish. (The lock is
+        // re-entrant, so this won't block if we're being called from the callback)
+        const ScopedLock sl (callbackLock);
+    }
+
+    int getNumSockets() const
+    {
+        const ScopedLock sl (registrationLock);
+        return (int) callbacks.size();
+    }
+
+private:
+    void run() override
+    {
+        std::vector<int> readyHandles;
+
+        while (! threadShouldExit())
+        {
+            readyHandles.clear();
+            waitForEvents (readyHandles);
+
+            for (auto handle : readyHandles)
+            {
+                if (threadShouldExit())
+                    break;
+
+                const ScopedLock sl (callbackLock);
+                std::shared_ptr<Callback> callback;
+
+                {
+                    const ScopedLock rl (registrationLock);
+                    const auto found = callbacks.find (handle);
+
+                    if (found == callbacks.end())
+                        continue;
+
+                    callback = found->second;
+                }
+
+                (*callback)();
+            }
+        }
+    }
+
+    void wake()
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        eventfd_write (wakeHandle, 1);
+       #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+        struct kevent change;
+        EV_SET (&change, 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+        kevent (pollHandle, &change, 1, nullptr, 0, nullptr);
+       #endif
+    }
+
+    void waitForEvents (std::vector<int>& readyHandles)
+    {
+        constexpr int maxEvents = 64;
+
+       #if JUCE_LINUX || JUCE_ANDROID
+        epoll_event events[maxEvents];
+        const auto numEvents = epoll_wait (pollHandle, events, maxEvents, -1);
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            if (events[i].data.fd == wakeHandle)
+            {
+                eventfd_t value;
+                eventfd_read (wakeHandle, &value);
+            }
+            else
+            {
+                readyHandles.push_back (events[i].data.fd);
+            }
+        }
+       #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+        struct kevent events[maxEvents];
+        const auto numEvents = kevent (pollHandle, nullptr, 0, events, maxEvents, nullptr);
+
+        for (int i = 0; i < numEvents; ++i)
+            if (events[i].filter == EVFILT_READ)
+                readyHandles.push_back ((int) events[i].ident);
+       #else
+        // There's no way to interrupt select(), so the set of sockets is rebuilt
+        // after a short timeout to pick up any changes
+        std::vector<SOCKET> handles (1);
+
+        {
+            const ScopedLock sl (registrationLock);
+
+            for (const auto& c : callbacks)
+                handles.push_back ((SOCKET) c.first);
+        }
+
+        if (handles.size() == 1)
+        {
+            wait (10);
+            return;
+        }
+
+        // An fd_set is a count followed by an array of sockets, so a larger one than
+        // FD_SETSIZE allows can be made by using the first element to hold the count
+        static_assert (offsetof (fd_set, fd_array) == sizeof (SOCKET), "Unexpected fd_set layout");
+        *reinterpret_cast<u_int*> (handles.data()) = (u_int) (handles.size() - 1);
+        auto* set = reinterpret_cast<fd_set*> (handles.data());
+
+        timeval timeout { 0, 10000 };
+
+        if (select (0, set, nullptr, nullptr, &timeout) > 0)
+            for (u_int i = 0; i < set->fd_count; ++i)
+                readyHandles.push_back ((int) set->fd_array[i]);
+       #endif
+    }
+
+    CriticalSection registrationLock, callbackLock;
+    std::map<int, std::shared_ptr<Callback>> callbacks;
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    int pollHandle = -1, wakeHandle = -1;
+   #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+    int pollHandle = -1;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (Poller)
+};
+
+//==============================================================================
+SocketReactor::SocketReactor (int numThreads)
+{
+    jassert (numThreads > 0);
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        pollers.add (new Poller (i));
+}
+
+SocketReactor::~SocketReactor()
+{
+    // You should remove all your sockets before deleting the reactor!
+    jassert (getNumSockets() == 0);
+
+    pollers.clear();
+}
+
+bool SocketReactor::addSocket (const StreamingSocket& socket, Callback onReadyToRead)
+{
+    return addHandle (socket.getRawSocketHandle(), std::move (onReadyToRead));
+}
+
+bool SocketReactor::addSocket (const DatagramSocket& socket, Callback onReadyToRead)
+{
+    return addHandle (socket.getRawSocketHandle(), std::move (onReadyToRead));
+}
+
+void SocketReactor::removeSocket (const StreamingSocket& socket)
+{
+    removeHandle (socket.getRawSocketHandle());
+}
+
+void SocketReactor::removeSocket (const DatagramSocket& socket)
+{
+    removeHandle (socket.getRawSocketHandle());
+}
+
+int SocketReactor::getNumSockets() const
+{
+    const ScopedLock sl (lock);
+    return (int) pollersForHandles.size();
+}
+
+bool SocketReactor::addHandle (int handle, Callback callback)
+{
+    if (handle < 0 || callback == nullptr)
+        return false;
+
+    const ScopedLock sl (lock);
+
+    if (pollersForHandles.find (handle) != pollersForHandles.end())
+        return false;
+
+    auto* poller = *std::min_element (pollers.begin(), pollers.end(), [] (auto* a, auto* b)
+    {
+        return a->getNumSockets() < b->getNumSockets();
+    });
+
+    if (! poller->add (handle, std::move (callback)))
+        return false;
+
+    pollersForHandles[handle] = poller;
+    return true;
+}
+
+void SocketReactor::removeHandle (int handle)
+{
+    Poller* poller = nullptr;
+
+    {
+        const ScopedLock sl (lock);
+        const auto found = pollersForHandles.find (handle);
+
+        if (found == pollersForHandles.end())
+            return;
+
+        poller = found->second;
+        pollersForHandles.erase (found);
+    }
+
+    poller->remove (handle);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SocketReactorTests final : public UnitTest
+{
+public:
+    SocketReactorTests()
+        : UnitTest ("SocketReactor", UnitTestCategories::networking)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Many streaming sockets share a few threads");
+        {
+            constexpr int numClients = 50;
+
+            StreamingSocket listener;
+            expect (listener.createListener (0, "127.0.0.1"));
+
+            SocketReactor reactor (2);
+            expectEquals (reactor.getNumThreads(), 2);
+
+            OwnedArray<StreamingSocket> clients, serverSockets;
+            std::atomic<int> totalBytes { 0 }, numClosed { 0 };
+            WaitableEvent allReceived, allClosed;
+
+            for (int i = 0; i < numClients; ++i)
+            {
+                auto* client = clients.add (new StreamingSocket());
+                expect (client->connect ("127.0.0.1", listener.getBoundPort(), 1000));
+
+                auto* server = serverSockets.add (listener.waitForNextConnection());
+                expect (server != nullptr);
+
+                expect (reactor.addSocket (*server, [&, server]
+                {
+                    char buffer[256];
+                    const auto available = server->getNumBytesAvailable();
+
+                    if (available <= 0)
+                    {
+                        reactor.removeSocket (*server);
+
+                        if (++numClosed == numClients)
+                            allClosed.signal();
+
+                        return;
+                    }
+
+                    const auto numRead = server->read (buffer, jmin (available, (int) sizeof (buffer)), true);
+
+                    if (numRead > 0 && (totalBytes += numRead) == numClients * 100)
+                        allReceived.signal();
+                }));
+            }
+
+            expect (! reactor.addSocket (*serverSockets[0], [] {}));
+            expectEquals (reactor.getNumSockets(), numClients);
+
+            for (auto* client : clients)
+            {
+                char data[100] = {};
+                expectEquals (client->write (data, 50), 50);
+                expectEquals (client->write (data + 50, 50), 50);
+            }
+
+            expect (allReceived.wait (5000));
+            expectEquals (totalBytes.load(), numClients * 100);
+
+            for (auto* client : clients)
+                client->close();
+
+            expect (allClosed.wait (5000));
+            expectEquals (reactor.getNumSockets(), 0);
+        }
+
+        beginTest ("Datagram sockets");
+        {
+            DatagramSocket receiver, sender;
+            expect (receiver.bindToPort (0, "127.0.0.1"));
+
+            SocketReactor reactor;
+            std::atomic<int> numPackets { 0 };
+            WaitableEvent received;
+
+            expect (reactor.addSocket (receiver, [&]
+            {
+                char buffer[64];
+
+                if (receiver.read (buffer, sizeof (buffer), false) > 0 && ++numPackets == 3)
+                    received.signal();
+            }));
+
+            for (int i = 0; i < 3; ++i)
+                expectEquals (sender.write ("127.0.0.1", receiver.getBoundPort(), "hello", 5), 5);
+
+            expect (received.wait (5000));
+            reactor.removeSocket (receiver);
+            expectEquals (reactor.getNumSockets(), 0);
+        }
+    }
+};
+
+static SocketReactorTests socketReactorTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Waits for data to arrive on many sockets at once, using a small number of threads.
+
+    Rather than dedicating a blocking thread to each socket, you can add sockets to a
+    SocketReactor along with a callback, and the callback will be invoked on one of the
+    reactor's threads whenever there's data waiting to be read (or the connection has
+    been closed or has failed). Each socket is always serviced by the same thread, so its
+    callback will never be called concurrently with itself.
+
+    Internally this uses epoll on Linux and Android, kqueue on macOS, iOS and BSD, and
+    select() on Windows.
+
+    The callbacks must read the data that is waiting, otherwise they'll be called again
+    straight away. They should also avoid blocking, because while a callback is running,
+    the other sockets that share its thread won't be serviced. Use
+    StreamingSocket::getNumBytesAvailable() to find out how much can be read without
+    blocking. A callback may occasionally be called when there's nothing to read, so be
+    prepared for that too.
+
+    A socket must be removed from the reactor before it is closed or deleted, and the
+    reactor must outlive all the sockets that have been added to it.
+
+    @see StreamingSocket, DatagramSocket, InterprocessConnection::setSocketReactor
+
+    @tags{Core}
+*/
+class JUCE_API  SocketReactor
+{
+public:
+    //==============================================================================
+    /** Creates a reactor which will use the given number of threads to service its sockets. */
+    explicit SocketReactor (int numThreads = 1);
+
+    /** Destructor.
+        Any sockets that are still registered will stop receiving callbacks.
+    */
+    ~SocketReactor();
+
+    //==============================================================================
+    /** The type of function that is called when a socket is ready to be read. */
+    using Callback = std::function<void()>;
+
+    /** Starts watching a connected StreamingSocket.
+        Returns false if the socket isn't open, or is already being watched.
+    */
+    bool addSocket (const StreamingSocket& socket, Callback onReadyToRead);
+
+    /** Starts watching a bound DatagramSocket.
+        Returns false if the socket isn't open, or is already being watched.
+    */
+    bool addSocket (const DatagramSocket& socket, Callback onReadyToRead);
+
+    /** Stops watching a socket.
+
+        When this returns, the socket's callback is guaranteed not to be running, and won't
+        be called again, unless this is called from inside the callback itself, in which case
+        the callback will be allowed to finish.
+
+        Be careful not to remove a socket from inside the callback of a socket that's
+        serviced by a different thread, while that thread might be doing the same thing
+        in reverse, as this would deadlock.
+    */
+    void removeSocket (const StreamingSocket& socket);
+
+    /** Stops watching a socket.
+        @see removeSocket
+    */
+    void removeSocket (const DatagramSocket& socket);
+
+    /** Returns the number of sockets that are currently being watched. */
+    int getNumSockets() const;
+
+    /** Returns the number of threads that this reactor uses. */
+    int getNumThreads() const noexcept                  { return pollers.size(); }
+
+private:
+    //==============================================================================
+    class Poller;
+
+    bool addHandle (int handle, Callback);
+    void removeHandle (int handle);
+
+    OwnedArray<Poller> pollers;
+    CriticalSection lock;
+    std::map<int, Poller*> pollersForHandles;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SocketReactor)
+};
+
+} // namespace juce
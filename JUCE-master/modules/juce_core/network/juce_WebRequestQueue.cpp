@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+struct WebRequestQueue::Request final : public ThreadPoolJob
+{
+    Request (const URL& u, const URL::InputStreamOptions& o, Callback c)
+        : ThreadPoolJob ("WebRequest"), url (u), options (o), callback (std::move (c))
+    {}
+
+    JobStatus runJob() override
+    {
+        Response response;
+        response.url = url;
+
+        auto userProgressCallback = options.getProgressCallback();
+
+        const auto opts = options.withStatusCode (&response.statusCode)
+                                 .withResponseHeaders (&response.headers)
+                                 .withProgressCallback ([this, userProgressCallback] (int sent, int total)
+                                 {
+                                     return ! shouldExit()
+                                             && (userProgressCallback == nullptr || userProgressCallback (sent, total));
+                                 });
+
+        if (auto stream = url.createInputStream (opts))
+        {
+            MemoryOutputStream body (response.data, false);
+            const auto totalLength = stream->getTotalLength();
+
+            if (totalLength > 0)
+                body.preallocate ((size_t) totalLength);
+
+            HeapBlock<char> buffer (8192);
+
+            while (! stream->isExhausted())
+            {
+                if (shouldExit())
+                    return jobHasFinished;
+
+                const auto numRead = stream->read (buffer, 8192);
+
+                if (numRead <= 0)
+                    break;
+
+                body.write (buffer, (size_t) numRead);
+            }
+
+            body.flush();
+            response.wasSuccessful = totalLength < 0 || (int64) response.data.getSize() == totalLength;
+        }
+
+        if (! shouldExit() && callback != nullptr)
+            callback (response);
+
+        return jobHasFinished;
+    }
+
+    const URL url;
+    const URL::InputStreamOptions options;
+    const Callback callback;
+
+    JUCE_DECLARE_NON_COPYABLE (Request)
+};
+
+//==============================================================================
+WebRequestQueue::WebRequestQueue (int maxSimultaneousRequests)
+    : pool (ThreadPoolOptions{}.withThreadName ("WebRequestQueue")
+                               .withNumberOfThreads (jmax (1, maxSimultaneousRequests)))
+{
+}
+
+WebRequestQueue::~WebRequestQueue()
+{
+    pool.removeAllJobs (true, 10000);
+}
+
+void WebRequestQueue::addRequest (const URL& url, const URL::InputStreamOptions& options, Callback callback)
+{
+    pool.addJob (new Request (url, options, std::move (callback)), true);
+}
+
+void WebRequestQueue::addRequest (const URL& url, Callback callback)
+{
+    addRequest (url, URL::InputStreamOptions (URL::ParameterHandling::inAddress), std::move (callback));
+}
+
+void WebRequestQueue::cancelPendingRequests()
+{
+    pool.removeAllJobs (false, 0);
+}
+
+int WebRequestQueue::getNumPendingRequests() const noexcept
+{
+    return pool.getNumJobs();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WebRequestQueueTests final : public UnitTest
+{
+public:
+    WebRequestQueueTests()
+        : UnitTest ("WebRequestQueue", UnitTestCategories::networking)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Requests are completed by a few threads");
+        {
+            constexpr int numRequests = 20;
+
+            TestServer server (numRequests);
+            expect (server.isListening());
+
+            std::atomic<int> numCompleted { 0 }, numCorrect { 0 };
+            WaitableEvent allCompleted;
+
+            {
+                WebRequestQueue queue (3);
+
+                for (int i = 0; i < numRequests; ++i)
+                {
+                    const URL url ("http://127.0.0.1:" + String (server.getPort()) + "/item" + String (i));
+
+                    queue.addRequest (url, [&, i] (const Response& response)
+                    {
+                        if (response.wasSuccessful
+                             && response.statusCode == 200
+                             && response.headers["X-Test"] == "yes"
+                             && response.data.toString() == "/item" + String (i))
+                        {
+                            ++numCorrect;
+                        }
+
+                        if (++numCompleted == numRequests)
+                            allCompleted.signal();
+                    });
+                }
+
+                expect (allCompleted.wait (10000));
+            }
+
+            expectEquals (numCorrect.load(), numRequests);
+        }
+
+        beginTest ("Failed connections are reported");
+        {
+            StreamingSocket unusedPort;
+            expect (unusedPort.createListener (0, "127.0.0.1"));
+            const auto port = unusedPort.getBoundPort();
+            unusedPort.close();
+
+            WaitableEvent completed;
+            bool wasSuccessful = true;
+
+            WebRequestQueue queue (1);
+            queue.addRequest (URL ("http://127.0.0.1:" + String (port) + "/"),
+                              URL::InputStreamOptions (URL::ParameterHandling::inAddress).withConnectionTimeoutMs (2000),
+                              [&] (const Response& response)
+                              {
+                                  wasSuccessful = response.wasSuccessful;
+                                  completed.signal();
+                              });
+
+            expect (completed.wait (10000));
+            expect (! wasSuccessful);
+        }
+    }
+
+private:
+    using Response = WebRequestQueue::Response;
+
+    // Serves a fixed number of requests, replying to each with its own path
+    struct TestServer final : private Thread
+    {
+        explicit TestServer (int numRequestsToServe)
+            : Thread ("WebRequestQueue test server"), numToServe (numRequestsToServe)
+        {
+            if (listener.createListener (0, "127.0.0.1"))
+                startThread();
+        }
+
+        ~TestServer() override
+        {
+            signalThreadShouldExit();
+            listener.close();
+            stopThread (5000);
+        }
+
+        bool isListening() const     { return listener.isConnected(); }
+        int getPort() const          { return listener.getBoundPort(); }
+
+        void run() override
+        {
+            for (int i = 0; i < numToServe && ! threadShouldExit(); ++i)
+            {
+                std::unique_ptr<StreamingSocket> connection (listener.waitForNextConnection());
+
+                if (connection == nullptr)
+                    return;
+
+                String request;
+
+                while (! request.contains ("\r\n\r\n"))
+                {
+                    char c;
+
+                    if (connection->waitUntilReady (true, 5000) != 1 || connection->read (&c, 1, true) != 1)
+                        break;
+
+                    request += c;
+                }
+
+                const auto path = request.fromFirstOccurrenceOf (" ", false, false)
+                                         .upToFirstOccurrenceOf (" ", false, false);
+
+                const auto reply = "HTTP/1.1 200 OK\r\n"
+                                   "Content-Length: " + String (path.getNumBytesAsUTF8()) + "\r\n"
+                                   "Connection: close\r\n"
+                                   "X-Test: yes\r\n"
+                                   "\r\n" + path;
+
+                connection->write (reply.toRawUTF8(), (int) reply.getNumBytesAsUTF8());
+            }
+        }
+
+        StreamingSocket listener;
+        const int numToServe;
+    };
+};
+
+static WebRequestQueueTests webRequestQueueTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs HTTP requests asynchronously on a small, fixed set of threads.
+
+    Each request that's added is queued and later performed by one of the queue's
+    threads, which reads the whole response into memory and then passes it to the
+    request's callback. This makes it cheap to fire off large numbers of small requests
+    without creating a thread for each one.
+
+    Because the threads are reused, and the underlying network stack keeps idle
+    connections open, consecutive requests to the same host can usually avoid the cost
+    of opening a new connection and doing a new TLS handshake.
+
+    The callbacks are called on the queue's threads rather than the message thread, so
+    use MessageManager::callAsync() if you need to get back onto the message thread.
+
+    @see URL::createInputStream, WebInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  WebRequestQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue which will run up to the given number of requests at once. */
+    explicit WebRequestQueue (int maxSimultaneousRequests = 4);
+
+    /** Destructor.
+        Any requests that haven't started are discarded without calling their callbacks,
+        and this waits for any that are in progress to finish.
+    */
+    ~WebRequestQueue();
+
+    //==============================================================================
+    /** Holds the result of a request. */
+    struct Response
+    {
+        /** The URL that was requested. */
+        URL url;
+
+        /** True if a connection was made and the whole response body was read. */
+        bool wasSuccessful = false;
+
+        /** The HTTP status code, or 0 if no connection could be made. */
+        int statusCode = 0;
+
+        /** The HTTP response headers. */
+        StringPairArray headers;
+
+        /** The response body. */
+        MemoryBlock data;
+    };
+
+    /** The type of function that is called when a request has completed. */
+    using Callback = std::function<void (const Response&)>;
+
+    /** Adds a request to the queue.
+
+        The options are passed to URL::createInputStream(), except that any status code
+        and response header pointers that they contain are ignored - the values are
+        returned in the Response instead.
+    */
+    void addRequest (const URL& url,
+                     const URL::InputStreamOptions& options,
+                     Callback callback);
+
+    /** Adds a GET request with default options to the queue. */
+    void addRequest (const URL& url, Callback callback);
+
+    /** Discards any requests that haven't started yet, without calling their callbacks.
+        Requests that are already in progress will still complete.
+    */
+    void cancelPendingRequests();
+
+    /** Returns the number of requests that are queued or in progress. */
+    int getNumPendingRequests() const noexcept;
+
+private:
+    //==============================================================================
+    struct Request;
+
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WebRequestQueue)
+};
+
+} // namespace juce
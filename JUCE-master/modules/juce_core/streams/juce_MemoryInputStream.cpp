@@ -206,6 +206,47 @@ public:
         expectEquals (stream.getPosition(), (int64) data.getSize());
         expectEquals (stream.getNumBytesRemaining(), (int64) 0);
         expect (stream.isExhausted());
+
+        beginTest ("Reset keeps capacity");
+        {
+            MemoryOutputStream resetStream (16);
+            resetStream.writeRepeatedByte (1, 1000);
+            auto* storage = resetStream.getData();
+
+            resetStream.reset();
+            expectEquals ((int) resetStream.getDataSize(), 0);
+            resetStream.writeRepeatedByte (2, 1000);
+            expect (resetStream.getData() == storage);
+        }
+
+        beginTest ("Pooled streams");
+        {
+            PooledMemoryOutputStream::releaseCachedBlocks();
+
+            const void* storage = nullptr;
+
+            {
+                PooledMemoryOutputStream pooledStream;
+                pooledStream.writeRepeatedByte (3, 5000);
+                storage = pooledStream.getData();
+            }
+
+            for (int i = 0; i < 3; ++i)
+            {
+                PooledMemoryOutputStream pooledStream;
+                expectEquals ((int) pooledStream.getDataSize(), 0);
+                pooledStream << "pooled";
+                expect (pooledStream.getData() == storage);
+                expectEquals (pooledStream.toString(), String ("pooled"));
+            }
+
+            {
+                PooledMemoryOutputStream outer, inner;
+                expect (outer.getData() != inner.getData());
+            }
+
+            PooledMemoryOutputStream::releaseCachedBlocks();
+        }
     }
 
     static String createRandomWideCharString (Random& r)
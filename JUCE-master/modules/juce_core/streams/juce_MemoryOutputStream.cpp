@@ -55,6 +55,11 @@ MemoryOutputStream::MemoryOutputStream (void* destBuffer, size_t destBufferSize)
     jassert (externalData != nullptr); // This must be a valid pointer.
 }
 
+MemoryOutputStream::MemoryOutputStream (MemoryBlock&& storageToReuse) noexcept
+  : blockToUse (&internalBlock), internalBlock (std::move (storageToReuse))
+{
+}
+
 MemoryOutputStream::~MemoryOutputStream()
 {
     trimExternalBlockSize();
@@ -209,6 +214,61 @@ String MemoryOutputStream::toString() const
     return String::createStringFromData (getData(), (int) getDataSize());
 }
 
+//==============================================================================
+struct PooledMemoryOutputStreamCache
+{
+    static PooledMemoryOutputStreamCache& getForThisThread()
+    {
+        thread_local PooledMemoryOutputStreamCache cache;
+        return cache;
+    }
+
+    MemoryBlock take (size_t minimumSize)
+    {
+        if (numBlocks == 0)
+            return MemoryBlock (minimumSize);
+
+        auto block = std::move (blocks[--numBlocks]);
+        block.ensureSize (minimumSize);
+        return block;
+    }
+
+    void giveBack (MemoryBlock&& block)
+    {
+        if (numBlocks < PooledMemoryOutputStream::maxCachedBlocksPerThread
+             && block.getSize() > 0
+             && block.getSize() <= PooledMemoryOutputStream::maxCachedBlockSize)
+            blocks[numBlocks++] = std::move (block);
+    }
+
+    void clear()
+    {
+        for (auto& b : blocks)
+            b.reset();
+
+        numBlocks = 0;
+    }
+
+    MemoryBlock blocks[PooledMemoryOutputStream::maxCachedBlocksPerThread];
+    int numBlocks = 0;
+};
+
+PooledMemoryOutputStream::PooledMemoryOutputStream (size_t initialSize)
+    : MemoryOutputStream (PooledMemoryOutputStreamCache::getForThisThread().take (initialSize))
+{
+}
+
+PooledMemoryOutputStream::~PooledMemoryOutputStream()
+{
+    PooledMemoryOutputStreamCache::getForThisThread().giveBack (std::move (internalBlock));
+}
+
+void PooledMemoryOutputStream::releaseCachedBlocks()
+{
+    PooledMemoryOutputStreamCache::getForThisThread().clear();
+}
+
+//==============================================================================
 OutputStream& JUCE_CALLTYPE operator<< (OutputStream& stream, const MemoryOutputStream& streamToRead)
 {
     auto dataSize = streamToRead.getDataSize();
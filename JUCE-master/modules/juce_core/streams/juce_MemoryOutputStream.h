@@ -75,6 +75,13 @@ public:
     */
     MemoryOutputStream (void* destBuffer, size_t destBufferSize);
 
+    /** Creates an empty memory stream which takes ownership of an existing block, and
+        writes into its allocated space rather than allocating a new one.
+
+        The block's current content is ignored; only its capacity is reused.
+    */
+    explicit MemoryOutputStream (MemoryBlock&& storageToReuse) noexcept;
+
     /** Destructor.
         This will free any data that was written to it.
     */
@@ -91,7 +98,11 @@ public:
     */
     size_t getDataSize() const noexcept                 { return size; }
 
-    /** Resets the stream, clearing any data that has been written to it so far. */
+    /** Resets the stream, clearing any data that has been written to it so far.
+
+        The memory that the stream has allocated is kept, so a stream that is reset and
+        re-used for a series of similar-sized messages will only allocate once.
+    */
     void reset() noexcept;
 
     /** Increases the internal storage capacity to be able to contain at least the specified
@@ -136,9 +147,48 @@ private:
     void trimExternalBlockSize();
     char* prepareToWrite (size_t);
 
+    friend class PooledMemoryOutputStream;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryOutputStream)
 };
 
+//==============================================================================
+/**
+    A MemoryOutputStream whose storage is borrowed from a small per-thread cache of
+    blocks, and handed back to that cache when the stream is deleted.
+
+    This is intended for code that builds a short-lived stream for every message it
+    sends, e.g. when encoding network packets or IPC messages. Once the calling thread
+    has cached a block that is big enough, creating, filling and deleting one of these
+    streams won't touch the allocator at all.
+
+    Blocks that have grown beyond maxCachedBlockSize are freed rather than cached, so
+    an occasional very large message won't pin its memory for the thread's lifetime.
+
+    @tags{Core}
+*/
+class JUCE_API  PooledMemoryOutputStream  : public MemoryOutputStream
+{
+public:
+    /** Creates an empty stream, re-using a cached block if the calling thread has one. */
+    explicit PooledMemoryOutputStream (size_t initialSize = 256);
+
+    /** Destructor. This returns the stream's storage to the calling thread's cache. */
+    ~PooledMemoryOutputStream() override;
+
+    /** Frees any blocks that have been cached by the calling thread. */
+    static void releaseCachedBlocks();
+
+    /** Blocks larger than this are not kept in the cache. */
+    static constexpr size_t maxCachedBlockSize = 1024 * 1024;
+
+    /** The number of blocks that each thread will hold on to. */
+    static constexpr int maxCachedBlocksPerThread = 4;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PooledMemoryOutputStream)
+};
+
 /** Copies all the data that has been written to a MemoryOutputStream into another stream. */
 OutputStream& JUCE_CALLTYPE operator<< (OutputStream& stream, const MemoryOutputStream& streamToRead);
 
@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ReadAheadInputStream::ReadAheadInputStream (InputStream* sourceStream,
+                                            bool deleteSourceWhenDestroyed,
+                                            TimeSliceThread& backgroundThread,
+                                            int size, int numBuffersToReadAhead)
+    : source (sourceStream, deleteSourceWhenDestroyed),
+      thread (backgroundThread),
+      bufferSize (jmax (256, size)),
+      buffers ((size_t) jmax (1, numBuffersToReadAhead)),
+      position (sourceStream->getPosition()),
+      nextSourcePosition (position)
+{
+    for (auto& b : buffers)
+        b.data.malloc (bufferSize);
+
+    thread.addTimeSliceClient (this);
+}
+
+ReadAheadInputStream::~ReadAheadInputStream()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+//==============================================================================
+int64 ReadAheadInputStream::getTotalLength()
+{
+    const ScopedLock sl (sourceLock);
+    return source->getTotalLength();
+}
+
+int64 ReadAheadInputStream::getPosition()
+{
+    return position;
+}
+
+bool ReadAheadInputStream::setPosition (int64 newPosition)
+{
+    newPosition = jmax ((int64) 0, newPosition);
+    bool anyBuffersFreed = false;
+
+    {
+        const ScopedLock sl (queueLock);
+        anyBuffersFreed = discardBuffersBefore (newPosition);
+
+        if (numFilledBuffers > 0 ? (buffers[(size_t) firstBuffer].startPosition <= newPosition)
+                                 : (newPosition == nextSourcePosition))
+        {
+            position = newPosition;
+            newPosition = -1;
+        }
+    }
+
+    if (newPosition < 0)
+    {
+        if (anyBuffersFreed)
+            thread.moveToFrontOfQueue (this);
+
+        return true;
+    }
+
+    bool ok;
+
+    {
+        const ScopedLock sl (sourceLock);
+        const ScopedLock ql (queueLock);
+
+        firstBuffer = 0;
+        numFilledBuffers = 0;
+        sourceExhausted = false;
+
+        ok = source->setPosition (newPosition);
+        position = nextSourcePosition = source->getPosition();
+    }
+
+    thread.moveToFrontOfQueue (this);
+    return ok;
+}
+
+int ReadAheadInputStream::read (void* destBuffer, int maxBytesToRead)
+{
+    jassert (destBuffer != nullptr && maxBytesToRead >= 0);
+
+    auto* dest = static_cast<char*> (destBuffer);
+    int numDone = 0;
+
+    while (numDone < maxBytesToRead)
+    {
+        bool queueWasEmpty = false, bufferFreed = false;
+
+        {
+            const ScopedLock sl (queueLock);
+
+            if (numFilledBuffers > 0)
+            {
+                auto& b = buffers[(size_t) firstBuffer];
+                auto offset = (int) (position - b.startPosition);
+                auto num = jmin (maxBytesToRead - numDone, b.numBytes - offset);
+
+                memcpy (dest + numDone, b.data + offset, (size_t) num);
+                numDone += num;
+                position += num;
+
+                bufferFreed = discardBuffersBefore (position);
+            }
+            else
+            {
+                queueWasEmpty = true;
+            }
+        }
+
+        if (bufferFreed)
+            thread.moveToFrontOfQueue (this);
+
+        if (queueWasEmpty && ! fillNextBuffer (true))
+        {
+            const ScopedLock sl (queueLock);
+
+            if (numFilledBuffers == 0)
+                break;
+        }
+    }
+
+    return numDone;
+}
+
+bool ReadAheadInputStream::isExhausted()
+{
+    {
+        const ScopedLock sl (queueLock);
+
+        if (numFilledBuffers > 0)
+            return false;
+
+        if (sourceExhausted)
+            return true;
+    }
+
+    const ScopedLock sl (sourceLock);
+    const ScopedLock ql (queueLock);
+
+    return numFilledBuffers == 0 && (sourceExhausted || source->isExhausted());
+}
+
+//==============================================================================
+int ReadAheadInputStream::useTimeSlice()
+{
+    return fillNextBuffer (false) ? 0 : 500;
+}
+
+bool ReadAheadInputStream::fillNextBuffer (bool onlyIfQueueIsEmpty)
+{
+    const ScopedLock sl (sourceLock);
+    Buffer* b = nullptr;
+
+    {
+        const ScopedLock ql (queueLock);
+
+        if (sourceExhausted
+             || numFilledBuffers == (int) buffers.size()
+             || (onlyIfQueueIsEmpty && numFilledBuffers > 0))
+            return false;
+
+        b = &buffers[(size_t) ((firstBuffer + numFilledBuffers) % (int) buffers.size())];
+    }
+
+    // The slot that's being filled isn't visible to the reader until it's added to
+    // the queue, and the queue can only be reset while holding the source lock, so
+    // it's safe to read into it without holding the queue lock.
+    auto numRead = source->read (b->data, bufferSize);
+    auto reachedEnd = numRead <= 0 || source->isExhausted();
+
+    const ScopedLock ql (queueLock);
+    sourceExhausted = reachedEnd;
+
+    if (numRead <= 0)
+        return false;
+
+    b->startPosition = nextSourcePosition;
+    b->numBytes = numRead;
+    nextSourcePosition += numRead;
+    ++numFilledBuffers;
+    return true;
+}
+
+bool ReadAheadInputStream::discardBuffersBefore (int64 pos)
+{
+    bool anyDiscarded = false;
+
+    while (numFilledBuffers > 0)
+    {
+        auto& b = buffers[(size_t) firstBuffer];
+
+        if (b.startPosition + b.numBytes > pos)
+            break;
+
+        firstBuffer = (firstBuffer + 1) % (int) buffers.size();
+        --numFilledBuffers;
+        anyDiscarded = true;
+    }
+
+    return anyDiscarded;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ReadAheadInputStreamTests final : public UnitTest
+{
+    ReadAheadInputStreamTests()
+        : UnitTest ("ReadAheadInputStream", UnitTestCategories::streams)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        MemoryBlock data (50000);
+
+        for (size_t i = 0; i < data.getSize(); ++i)
+            data[i] = (char) random.nextInt (256);
+
+        TimeSliceThread thread ("read-ahead test");
+
+        beginTest ("Read without a running thread");
+        checkStream (data, thread, random);
+
+        thread.startThread();
+
+        beginTest ("Read with a running thread");
+        checkStream (data, thread, random);
+
+        for (auto bufferCount : { 1, 2, 8 })
+        {
+            for (auto bufferSize : { 256, 1000, 60000 })
+            {
+                ReadAheadInputStream stream (new MemoryInputStream (data, false), true,
+                                             thread, bufferSize, bufferCount);
+                MemoryBlock result;
+                stream.readIntoMemoryBlock (result);
+                expect (result == data);
+                expect (stream.isExhausted());
+            }
+        }
+
+        beginTest ("Seeking");
+        {
+            ReadAheadInputStream stream (new MemoryInputStream (data, false), true, thread, 1000, 4);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto pos = random.nextInt ((int) data.getSize() + 100);
+                expect (stream.setPosition (pos));
+
+                const auto expectedPos = jmin (pos, (int) data.getSize());
+                expectEquals (stream.getPosition(), (int64) expectedPos);
+
+                char buffer[300];
+                auto numRead = stream.read (buffer, (int) sizeof (buffer));
+                expectEquals (numRead, jmin ((int) sizeof (buffer), (int) data.getSize() - expectedPos));
+                expect (memcmp (buffer, data.begin() + expectedPos, (size_t) numRead) == 0);
+            }
+        }
+
+        thread.stopThread (1000);
+    }
+
+    void checkStream (const MemoryBlock& data, TimeSliceThread& thread, Random& random)
+    {
+        ReadAheadInputStream stream (new MemoryInputStream (data, false), true, thread, 1024, 3);
+
+        expectEquals (stream.getTotalLength(), (int64) data.getSize());
+        expect (! stream.isExhausted());
+
+        MemoryBlock readBuffer (data.getSize());
+        int numBytesRead = 0;
+
+        while (numBytesRead < (int) data.getSize())
+        {
+            auto num = stream.read (readBuffer.begin() + numBytesRead, random.nextInt (3000) + 1);
+            expect (num > 0);
+            numBytesRead += num;
+            expectEquals (stream.getPosition(), (int64) numBytesRead);
+        }
+
+        expect (readBuffer == data);
+        expect (stream.isExhausted());
+        expectEquals (stream.read (readBuffer.begin(), 10), 0);
+    }
+};
+
+static ReadAheadInputStreamTests readAheadInputStreamTests;
+
+#endif
+
+} // namespace juce
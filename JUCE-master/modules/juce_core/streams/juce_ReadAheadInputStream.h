@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Wraps another input stream, and uses a background thread to read ahead of the
+    position that the stream is being read from.
+
+    Where a BufferedInputStream refills its buffer synchronously when it runs dry,
+    this class keeps a queue of buffers which a TimeSliceThread fills while the
+    consumer is busy with the data it already has. That's useful for streams that
+    are slow or have unpredictable latency, such as a FileInputStream on a network
+    drive or a WebInputStream, when the data is being processed as it arrives.
+
+    Reading forwards is the fast path. Seeking to a position that has already been
+    read ahead just discards the buffers before it, but seeking anywhere else drops
+    the whole queue and repositions the source stream.
+
+    The source stream is only ever used by one thread at a time, but it must not be
+    used by anything else while this object exists. The TimeSliceThread will be used
+    when it is running; if it isn't, the data is read on demand, so the stream still
+    works, just without any read-ahead.
+
+    @see BufferedInputStream, TimeSliceThread
+    @tags{Core}
+*/
+class JUCE_API  ReadAheadInputStream  : public InputStream,
+                                        private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a ReadAheadInputStream.
+
+        @param sourceStream                 the source stream to read from
+        @param deleteSourceWhenDestroyed    whether the sourceStream that is passed in should be
+                                            deleted by this object when it is itself deleted.
+        @param backgroundThread             the thread that will do the reading. This can be
+                                            shared with other clients, and must outlive this object
+        @param bufferSize                   the size of each buffer in the read-ahead queue
+        @param numBuffersToReadAhead        how many buffers the background thread may fill in
+                                            advance of the current read position
+    */
+    ReadAheadInputStream (InputStream* sourceStream,
+                          bool deleteSourceWhenDestroyed,
+                          TimeSliceThread& backgroundThread,
+                          int bufferSize = 65536,
+                          int numBuffersToReadAhead = 4);
+
+    /** Destructor.
+
+        This will wait for the background thread to finish any read that's in progress,
+        and may also delete the source stream, if that option was chosen.
+    */
+    ~ReadAheadInputStream() override;
+
+    //==============================================================================
+    int64 getTotalLength() override;
+    int64 getPosition() override;
+    bool setPosition (int64 newPosition) override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+    bool isExhausted() override;
+
+private:
+    //==============================================================================
+    struct Buffer
+    {
+        HeapBlock<char> data;
+        int64 startPosition = 0;
+        int numBytes = 0;
+    };
+
+    OptionalScopedPointer<InputStream> source;
+    TimeSliceThread& thread;
+    const int bufferSize;
+    std::vector<Buffer> buffers;
+
+    CriticalSection sourceLock, queueLock;
+    int firstBuffer = 0, numFilledBuffers = 0;
+    int64 position, nextSourcePosition;
+    bool sourceExhausted = false;
+
+    int useTimeSlice() override;
+    bool fillNextBuffer (bool onlyIfQueueIsEmpty);
+    bool discardBuffersBefore (int64);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReadAheadInputStream)
+};
+
+} // namespace juce
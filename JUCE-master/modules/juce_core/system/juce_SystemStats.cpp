@@ -148,7 +148,7 @@ struct CPUInformation
          hasAVX512F  = false, hasAVX512BW   = false, hasAVX512CD   = false,
          hasAVX512DQ = false, hasAVX512ER   = false, hasAVX512IFMA = false,
          hasAVX512PF = false, hasAVX512VBMI = false, hasAVX512VL   = false,
-         hasAVX512VPOPCNTDQ = false,
+         hasAVX512VPOPCNTDQ = false, hasSHA = false,
          hasNeon = false;
 };
 
@@ -158,6 +158,35 @@ static const CPUInformation& getCPUInformation() noexcept
     return info;
 }
 
+static std::vector<SystemStats::LogicalCpu> getNativeCpuTopology();
+
+std::vector<SystemStats::LogicalCpu> SystemStats::getCpuTopology()
+{
+    static const auto topology = []
+    {
+        auto result = getNativeCpuTopology();
+
+        if (! result.empty())
+            return result;
+
+        // No detailed information available, so spread the logical CPUs evenly over the physical ones
+        const auto numLogical  = jmax (1, getNumCpus());
+        const auto numPhysical = jlimit (1, numLogical, getNumPhysicalCpus());
+
+        for (int i = 0; i < numLogical; ++i)
+        {
+            LogicalCpu cpu;
+            cpu.index = i;
+            cpu.physicalCore = (i * numPhysical) / numLogical;
+            result.push_back (cpu);
+        }
+
+        return result;
+    }();
+
+    return topology;
+}
+
 int SystemStats::getNumCpus() noexcept          { return getCPUInformation().numLogicalCPUs; }
 int SystemStats::getNumPhysicalCpus() noexcept  { return getCPUInformation().numPhysicalCPUs; }
 bool SystemStats::hasMMX() noexcept             { return getCPUInformation().hasMMX; }
@@ -182,34 +211,45 @@ bool SystemStats::hasAVX512PF() noexcept        { return getCPUInformation().has
 bool SystemStats::hasAVX512VBMI() noexcept      { return getCPUInformation().hasAVX512VBMI; }
 bool SystemStats::hasAVX512VL() noexcept        { return getCPUInformation().hasAVX512VL; }
 bool SystemStats::hasAVX512VPOPCNTDQ() noexcept { return getCPUInformation().hasAVX512VPOPCNTDQ; }
+bool SystemStats::hasSHA() noexcept             { return getCPUInformation().hasSHA; }
 bool SystemStats::hasNeon() noexcept            { return getCPUInformation().hasNeon; }
 
 
 //==============================================================================
-String SystemStats::getStackBacktrace()
+static int captureStackFrames (void** frames, int maxFrames) noexcept
+{
+   #if JUCE_ANDROID || JUCE_WASM
+    ignoreUnused (frames, maxFrames);
+    return 0;
+   #elif JUCE_WINDOWS
+    return (int) CaptureStackBackTrace (0, (DWORD) maxFrames, frames, nullptr);
+   #else
+    return (int) backtrace (frames, maxFrames);
+   #endif
+}
+
+static String describeStackFrames (void* const* frames, int numFrames)
 {
     String result;
 
    #if JUCE_ANDROID || JUCE_WASM
+    ignoreUnused (frames, numFrames);
     jassertfalse; // sorry, not implemented yet!
 
    #elif JUCE_WINDOWS
     HANDLE process = GetCurrentProcess();
     SymInitialize (process, nullptr, TRUE);
 
-    void* stack[128];
-    int frames = (int) CaptureStackBackTrace (0, numElementsInArray (stack), stack, nullptr);
-
     HeapBlock<SYMBOL_INFO> symbol;
     symbol.calloc (sizeof (SYMBOL_INFO) + 256, 1);
     symbol->MaxNameLen = 255;
     symbol->SizeOfStruct = sizeof (SYMBOL_INFO);
 
-    for (int i = 0; i < frames; ++i)
+    for (int i = 0; i < numFrames; ++i)
     {
         DWORD64 displacement = 0;
 
-        if (SymFromAddr (process, (DWORD64) stack[i], &displacement, symbol))
+        if (SymFromAddr (process, (DWORD64) frames[i], &displacement, symbol))
         {
             result << i << ": ";
 
@@ -225,11 +265,9 @@ String SystemStats::getStackBacktrace()
     }
 
    #else
-    void* stack[128];
-    auto frames = backtrace (stack, numElementsInArray (stack));
-    char** frameStrings = backtrace_symbols (stack, frames);
+    char** frameStrings = backtrace_symbols (frames, numFrames);
 
-    for (auto i = (decltype (frames)) 0; i < frames; ++i)
+    for (int i = 0; i < numFrames; ++i)
         result << frameStrings[i] << newLine;
 
     ::free (frameStrings);
@@ -238,6 +276,13 @@ String SystemStats::getStackBacktrace()
     return result;
 }
 
+String SystemStats::getStackBacktrace()
+{
+    void* stack[128];
+    const auto frames = captureStackFrames (stack, numElementsInArray (stack));
+    return describeStackFrames (stack, frames);
+}
+
 //==============================================================================
 #if ! JUCE_WASM
 
@@ -319,6 +364,45 @@ public:
 
 static UniqueHardwareIDTest uniqueHardwareIDTest;
 
+class CpuTopologyTests final : public UnitTest
+{
+public:
+    CpuTopologyTests() : UnitTest ("CpuTopology", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        beginTest ("Topology describes every logical CPU");
+        {
+            const auto topology = SystemStats::getCpuTopology();
+
+            expect (! topology.empty());
+
+            for (size_t i = 0; i < topology.size(); ++i)
+            {
+                if (i > 0)
+                    expect (topology[i].index > topology[i - 1].index);
+
+                expect (topology[i].physicalCore >= 0);
+                expect (topology[i].package >= 0);
+                expect (topology[i].numaNode >= 0);
+            }
+        }
+
+        beginTest ("Each physical core contains at least one logical CPU");
+        {
+            std::set<int> cores;
+
+            for (const auto& cpu : SystemStats::getCpuTopology())
+                cores.insert (cpu.physicalCore);
+
+            expect (! cores.empty());
+            expect ((int) cores.size() <= (int) SystemStats::getCpuTopology().size());
+        }
+    }
+};
+
+static CpuTopologyTests cpuTopologyTests;
+
 #endif
 
 } // namespace juce
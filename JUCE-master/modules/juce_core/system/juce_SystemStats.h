@@ -211,6 +211,53 @@ public:
     /** Returns the number of physical CPU cores. */
     static int getNumPhysicalCpus() noexcept;
 
+    /** The kind of core that a logical CPU belongs to, on hybrid processors. */
+    enum class CpuCoreType
+    {
+        unknown,        /**< The system doesn't distinguish between core types. */
+        performance,    /**< A high-performance ("P") core. */
+        efficiency      /**< A low-power efficiency ("E") core. */
+    };
+
+    /** Describes where one logical CPU sits in the machine's topology.
+
+        @see getCpuTopology
+    */
+    struct LogicalCpu
+    {
+        /** The index of this CPU, as used by Thread::setAffinity() and similar calls. */
+        int index = 0;
+
+        /** An index identifying the physical core that this CPU belongs to. Logical CPUs
+            that are hyper-threads of the same core share the same value. Values are unique
+            across all packages, and run from 0 to getNumPhysicalCpus() - 1 where possible.
+        */
+        int physicalCore = 0;
+
+        /** The index of the processor package (socket) containing this CPU. */
+        int package = 0;
+
+        /** The NUMA node that this CPU belongs to. */
+        int numaNode = 0;
+
+        /** Whether this is a performance or efficiency core, if the system reports it. */
+        CpuCoreType coreType = CpuCoreType::unknown;
+    };
+
+    /** Returns a description of each logical CPU in the system, ordered by index.
+
+        This can be used to choose sensible affinity masks for realtime threads, e.g. to
+        keep audio worker threads on separate physical performance cores.
+
+        Where the platform can't supply some of this information, it's filled in with
+        best-guess values: e.g. all CPUs are reported as being on package 0 and NUMA
+        node 0, with an unknown core type. On macOS, threads can't be pinned to specific
+        CPUs, so the indices only reflect how many cores of each type are available.
+
+        @see Thread::setAffinity, Thread::RealtimeOptions::withAffinity
+    */
+    static std::vector<LogicalCpu> getCpuTopology();
+
     /** Returns the approximate CPU speed.
         @returns    the speed in megahertz, e.g. 1500, 2500, 32000 (depending on
                     what year you're reading this...)
@@ -249,6 +296,7 @@ public:
     static bool hasAVX512VBMI() noexcept;      /**< Returns true if Intel AVX-512 Vector Bit Manipulation instructions are available. */
     static bool hasAVX512VL() noexcept;        /**< Returns true if Intel AVX-512 Vector Length instructions are available. */
     static bool hasAVX512VPOPCNTDQ() noexcept; /**< Returns true if Intel AVX-512 Vector Population Count Double and Quad-word instructions are available. */
+    static bool hasSHA() noexcept;             /**< Returns true if Intel SHA extensions are available. */
     static bool hasNeon() noexcept;            /**< Returns true if ARM NEON instructions are available. */
 
     //==============================================================================
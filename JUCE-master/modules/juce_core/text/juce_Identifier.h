@@ -141,4 +141,8 @@ private:
     String name;
 };
 
+#ifndef DOXYGEN
+template <> struct TypeHelpers::IsTriviallyRelocatable<Identifier> : std::true_type {};
+#endif
+
 } // namespace juce
@@ -63,12 +63,56 @@ struct StringHolder
     using CharType         = String::CharPointerType::CharType;
 
     std::atomic<int> refCount { 0 };
+    std::atomic<uint32> cachedHash { 0 }; // zero if not yet calculated
     size_t allocatedNumBytes = sizeof (CharType);
     CharType text[1] { 0 };
 };
 
 constexpr StringHolder emptyString;
 
+//==============================================================================
+/*  Strings holding small non-negative integers are very common (indexes, MIDI values,
+    property values, etc.) so these share a set of static holders rather than each one
+    needing a heap allocation. Like the empty string, they're never reference-counted.
+*/
+struct SmallIntegerStrings
+{
+    static constexpr int numStrings = 256;
+
+    struct Holder
+    {
+        constexpr explicit Holder (int number) noexcept
+        {
+            int i = 0;
+
+            if (number >= 100)  text[i++] = (StringHolder::CharType) ('0' + number / 100);
+            if (number >= 10)   text[i++] = (StringHolder::CharType) ('0' + (number / 10) % 10);
+
+            text[i] = (StringHolder::CharType) ('0' + number % 10);
+        }
+
+        std::atomic<int> refCount { 0 };
+        std::atomic<uint32> cachedHash { 0 };
+        size_t allocatedNumBytes = sizeof (text);
+        StringHolder::CharType text[4] {};
+    };
+
+    template <size_t... numbers>
+    constexpr explicit SmallIntegerStrings (std::index_sequence<numbers...>) noexcept
+        : holders { Holder ((int) numbers)... }
+    {}
+
+    const Holder* begin() const noexcept    { return holders; }
+    const Holder* end() const noexcept      { return holders + numStrings; }
+
+    Holder holders[numStrings];
+};
+
+static_assert (offsetof (SmallIntegerStrings::Holder, text) == offsetof (StringHolder, text),
+               "The small integer holders must have the same layout as a StringHolder");
+
+static SmallIntegerStrings smallIntegerStrings { std::make_index_sequence<SmallIntegerStrings::numStrings>() };
+
 //==============================================================================
 class StringHolderUtils
 {
@@ -82,6 +126,7 @@ public:
         auto* bytes = new char [sizeof (StringHolder) - sizeof (CharType) + numBytes];
         auto s = unalignedPointerCast<StringHolder*> (bytes);
         s->refCount = 0;
+        s->cachedHash = 0;
         s->allocatedNumBytes = numBytes;
         return CharPointerType (unalignedPointerCast<CharType*> (bytes + offsetof (StringHolder, text)));
     }
@@ -153,6 +198,12 @@ public:
         return dest;
     }
 
+    static CharPointerType getSmallIntegerString (int number) noexcept
+    {
+        jassert (isPositiveAndBelow (number, SmallIntegerStrings::numStrings));
+        return CharPointerType (smallIntegerStrings.holders[number].text);
+    }
+
     static CharPointerType createFromFixedLength (const char* const src, const size_t numChars)
     {
         auto dest = createUninitialisedBytes (numChars * sizeof (CharType) + sizeof (CharType));
@@ -165,13 +216,13 @@ public:
     {
         auto* b = bufferFromText (text);
 
-        if (! isEmptyString (b))
+        if (! isStaticString (b))
             ++(b->refCount);
     }
 
     static void release (StringHolder* const b) noexcept
     {
-        if (! isEmptyString (b))
+        if (! isStaticString (b))
             if (--(b->refCount) == -1)
                 delete[] reinterpret_cast<char*> (b);
     }
@@ -198,8 +249,12 @@ public:
             return newText;
         }
 
-        if (b->allocatedNumBytes >= numBytes && b->refCount <= 0)
+        if (b->allocatedNumBytes >= numBytes && b->refCount <= 0 && ! isSmallIntegerString (b))
+        {
+            // The caller is about to modify the text in-place
+            b->cachedHash.store (0, std::memory_order_relaxed);
             return text;
+        }
 
         auto newText = createUninitialisedBytes (jmax (b->allocatedNumBytes, numBytes));
         memcpy (newText.getAddress(), text.getAddress(), b->allocatedNumBytes);
@@ -213,6 +268,25 @@ public:
         return bufferFromText (text)->allocatedNumBytes;
     }
 
+    template <typename HashFunction>
+    static uint32 getCachedHash (const CharPointerType text, HashFunction calculateHash) noexcept
+    {
+        auto* b = bufferFromText (text);
+
+        if (isEmptyString (b))
+            return calculateHash (text);
+
+        auto hash = b->cachedHash.load (std::memory_order_relaxed);
+
+        if (hash == 0)
+        {
+            hash = calculateHash (text);
+            b->cachedHash.store (hash, std::memory_order_relaxed);
+        }
+
+        return hash;
+    }
+
 private:
     StringHolderUtils() = delete;
     ~StringHolderUtils() = delete;
@@ -227,6 +301,18 @@ private:
         return other == &emptyString;
     }
 
+    static bool isSmallIntegerString (StringHolder* other)
+    {
+        auto* address = reinterpret_cast<const char*> (other);
+        return address >= reinterpret_cast<const char*> (smallIntegerStrings.begin())
+            && address <  reinterpret_cast<const char*> (smallIntegerStrings.end());
+    }
+
+    static bool isStaticString (StringHolder* other)
+    {
+        return isEmptyString (other) || isSmallIntegerString (other);
+    }
+
     void compileTimeChecks()
     {
         // Let me know if any of these assertions fail on your system!
@@ -507,6 +593,9 @@ namespace NumberToStringConverters
     template <typename IntegerType>
     static String::CharPointerType createFromInteger (IntegerType number)
     {
+        if (isPositiveAndBelow (number, (IntegerType) SmallIntegerStrings::numStrings))
+            return StringHolderUtils::getSmallIntegerString ((int) number);
+
         char buffer [charsNeededForInt];
         auto* end = buffer + numElementsInArray (buffer);
         auto* start = numberToString (end, number);
@@ -576,7 +665,11 @@ struct HashGenerator
     enum { multiplier = sizeof (Type) > 4 ? 101 : 31 };
 };
 
-int String::hashCode() const noexcept       { return (int) HashGenerator<uint32>    ::calculate (text); }
+int String::hashCode() const noexcept
+{
+    return (int) StringHolderUtils::getCachedHash (text, [] (CharPointerType t) { return HashGenerator<uint32>::calculate (t); });
+}
+
 int64 String::hashCode64() const noexcept   { return (int64) HashGenerator<uint64>  ::calculate (text); }
 size_t String::hash() const noexcept        { return HashGenerator<size_t>          ::calculate (text); }
 
@@ -2463,6 +2556,17 @@ public:
             expect (s.hashCode64() != 0);
             expect (s.hashCode() != (s + s).hashCode());
             expect (s.hashCode64() != (s + s).hashCode64());
+
+            {
+                String appended (s);
+                const auto originalHash = appended.hashCode();
+                appended.preallocateBytes (64);
+                appended << "9";
+                expect (s.hashCode() == originalHash);
+                expect (appended.hashCode() == String ("0123456789").hashCode());
+                expect (appended.hashCode() != originalHash);
+            }
+
             expect (s.compare (String ("012345678")) == 0);
             expect (s.compare (String ("012345679")) < 0);
             expect (s.compare (String ("012345676")) > 0);
@@ -2663,6 +2767,21 @@ public:
             expectEquals (String (1e-34, 5,        true), String ("1.00000e-34"));
             expectEquals (String (1.39, 1,         true), String ("1.4e+00"));
 
+            for (int i = -5; i < 300; ++i)
+            {
+                String number (i);
+                expectEquals (number.getIntValue(), i);
+                expect (number == String (std::to_string (i)));
+
+                const auto hash = number.hashCode();
+                number << "x";
+                expect (String (i).getIntValue() == i && String (i).hashCode() == hash);
+                expect (number == String (std::to_string (i)) + "x");
+            }
+
+            expectEquals (String ((uint8) 200), String ("200"));
+            expectEquals (String ((uint64) 255), String ("255"));
+
             beginTest ("Subsections");
             String s3;
             s3 = "abcdeFGHIJ";
@@ -3013,6 +3132,62 @@ public:
 
 static StringTests stringUnitTests;
 
+//==============================================================================
+class StringBenchmarks final : public BenchmarkTest
+{
+public:
+    StringBenchmarks()
+        : BenchmarkTest ("String benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Building");
+        {
+            benchmark ("Appending 1000 short strings", []
+            {
+                String s;
+
+                for (int i = 0; i < 1000; ++i)
+                    s << "abc";
+
+                doNotOptimise (s);
+            });
+
+            benchmark ("Converting 1000 numbers", []
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    String s ((double) i * 1.25, 3);
+                    doNotOptimise (s);
+                }
+            });
+        }
+
+        beginTest ("Searching");
+        {
+            const auto text = String::repeatedString ("the quick brown fox jumps over the lazy dog ", 100) + "needle";
+
+            benchmark ("indexOf", [&]
+            {
+                doNotOptimise (text.indexOf ("needle"));
+            });
+
+            benchmark ("replace", [&]
+            {
+                doNotOptimise (text.replace ("fox", "cat"));
+            });
+
+            benchmark ("hashCode", [&]
+            {
+                doNotOptimise (text.hashCode64());
+            });
+        }
+    }
+};
+
+static StringBenchmarks stringBenchmarks;
+
 #endif
 
 } // namespace juce
@@ -1399,6 +1399,10 @@ private:
     static String createHex (Type n)  { return createHex (static_cast<typename TypeHelpers::UnsignedTypeWithSize<(int) sizeof (n)>::type> (n)); }
 };
 
+#ifndef DOXYGEN
+template <> struct TypeHelpers::IsTriviallyRelocatable<String> : std::true_type {};
+#endif
+
 //==============================================================================
 /** Concatenates two strings. */
 JUCE_API String JUCE_CALLTYPE operator+ (const char* string1,     const String& string2);
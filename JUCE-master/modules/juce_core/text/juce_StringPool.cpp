@@ -38,8 +38,8 @@ namespace juce
 static const int minNumberOfStringsForGarbageCollection = 300;
 static const uint32 garbageCollectionInterval = 30000;
 
-
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
+static constexpr int numShardBits = 5;
+static constexpr size_t numShards = 1 << numShardBits;
 
 struct StartEndString
 {
@@ -69,44 +69,254 @@ static int compareStrings (const StartEndString& string1, const String& string2)
     return 0;
 }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+//==============================================================================
+// The hashes are made from the characters rather than the encoded bytes, so that the
+// same string gives the same hash whichever type it's passed in as
+static uint32 mixStringHash (uint32 hash) noexcept
+{
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    return hash ^ (hash >> 16);
+}
+
+template <typename CharPointer>
+static uint32 hashStringCharacters (CharPointer s) noexcept
+{
+    uint32 hash = 2166136261u;
+
+    while (auto c = s.getAndAdvance())
+        hash = (hash ^ (uint32) c) * 16777619u;
+
+    return mixStringHash (hash);
+}
+
+static uint32 hashStringCharacters (const StartEndString& s) noexcept
 {
-    int start = 0;
-    int end = strings.size();
+    uint32 hash = 2166136261u;
 
-    while (start < end)
+    for (auto p = s.start; p < s.end;)
     {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+        auto c = p.getAndAdvance();
+
+        if (c == 0)
+            break;
+
+        hash = (hash ^ (uint32) c) * 16777619u;
+    }
+
+    return mixStringHash (hash);
+}
 
-        if (startComp == 0)
-            return startString;
+static uint32 hashStringCharacters (const String& s) noexcept  { return hashStringCharacters (s.getCharPointer()); }
 
-        const int halfway = (start + end) / 2;
+//==============================================================================
+/*  Each shard is an open-addressed hash table of pointers to entries.
 
-        if (halfway == start)
+    Readers look strings up without locking: they register themselves in one of two
+    reader counts, load the current table and copy the string out of the matching entry.
+    Everything that changes the shard happens under its lock. New entries are published
+    into empty slots of the current table, but growing the table or removing entries means
+    publishing a new table, after which the writer waits until all the readers that might
+    still be looking at the old one have finished before deleting it.
+*/
+struct StringPool::Shard
+{
+    struct Entry
+    {
+        String string;
+        uint32 hash;
+    };
+
+    struct Table
+    {
+        explicit Table (size_t numSlots)
+            : capacity (numSlots), slots (new std::atomic<Entry*>[numSlots])
         {
-            if (startComp > 0)
-                ++start;
+            for (size_t i = 0; i < capacity; ++i)
+                slots[i].store (nullptr, std::memory_order_relaxed);
+        }
 
-            break;
+        template <typename NewStringType>
+        Entry* find (const NewStringType& newString, uint32 hash) const noexcept
+        {
+            for (auto i = (size_t) hash & (capacity - 1);; i = (i + 1) & (capacity - 1))
+            {
+                auto* entry = slots[i].load (std::memory_order_acquire);
+
+                if (entry == nullptr)
+                    return nullptr;
+
+                if (entry->hash == hash && compareStrings (newString, entry->string) == 0)
+                    return entry;
+            }
         }
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+        void insert (Entry* entry) noexcept
+        {
+            jassert (numUsed < capacity / 2);
+
+            auto i = (size_t) entry->hash & (capacity - 1);
 
-        if (halfwayComp == 0)
-            return halfwayString;
+            while (slots[i].load (std::memory_order_relaxed) != nullptr)
+                i = (i + 1) & (capacity - 1);
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
+            slots[i].store (entry, std::memory_order_release);
+            ++numUsed;
+        }
+
+        const size_t capacity;
+        size_t numUsed = 0;
+        std::unique_ptr<std::atomic<Entry*>[]> slots;
+    };
+
+    ~Shard()
+    {
+        if (auto* t = table.load())
+        {
+            for (size_t i = 0; i < t->capacity; ++i)
+                delete t->slots[i].load();
+
+            delete t;
+        }
+    }
+
+    // Returns an empty string if there's no match. This doesn't need the lock.
+    template <typename NewStringType>
+    String find (const NewStringType& newString, uint32 hash) noexcept
+    {
+        const ScopedRead sr (*this);
+
+        if (auto* t = table.load())
+            if (auto* entry = t->find (newString, hash))
+                return entry->string;
+
+        return {};
+    }
+
+    template <typename NewStringType>
+    String add (const NewStringType& newString, uint32 hash)
+    {
+        garbageCollectIfNeeded();
+
+        auto* t = table.load();
+
+        if (t != nullptr)
+            if (auto* entry = t->find (newString, hash))
+                return entry->string;
+
+        if (t == nullptr || (t->numUsed + 1) * 2 > t->capacity)
+            t = createTable (t != nullptr ? t->capacity * 2 : 16, 0);
+
+        auto* entry = new Entry { newString, hash };
+        t->insert (entry);
+        return entry->string;
     }
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    void garbageCollect()
+    {
+        auto* t = table.load();
+
+        if (t == nullptr)
+            return;
+
+        Array<Entry*> unused;
+
+        for (size_t i = 0; i < t->capacity; ++i)
+            if (auto* entry = t->slots[i].load())
+                if (entry->string.getReferenceCount() == 1)
+                    unused.add (entry);
+
+        if (! unused.isEmpty())
+        {
+            t = createTable (t->capacity, 1);
+
+            // A reader may have taken a copy of one of these strings before the new table
+            // was published, so those have to go back in to stay unique
+            for (auto* entry : unused)
+            {
+                if (entry->string.getReferenceCount() == 1)
+                    delete entry;
+                else
+                    t->insert (entry);
+            }
+        }
+
+        lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    }
+
+    CriticalSection lock;
+
+private:
+    struct ScopedRead
+    {
+        explicit ScopedRead (Shard& s) noexcept  : count (s.numReaders[s.readPhase.load()])  { ++count; }
+        ~ScopedRead() noexcept  { --count; }
+
+        std::atomic<int>& count;
+    };
+
+    void garbageCollectIfNeeded()
+    {
+        if (auto* t = table.load())
+            if (t->numUsed > minNumberOfStringsForGarbageCollection / numShards
+                 && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
+                garbageCollect();
+    }
+
+    // Publishes a copy of the current table with a new capacity, leaving out any strings
+    // that have no more than maxReferencesToDrop references
+    Table* createTable (size_t capacity, int maxReferencesToDrop)
+    {
+        auto newTable = std::make_unique<Table> (capacity);
+
+        if (auto* t = table.load())
+            for (size_t i = 0; i < t->capacity; ++i)
+                if (auto* entry = t->slots[i].load())
+                    if (entry->string.getReferenceCount() > maxReferencesToDrop)
+                        newTable->insert (entry);
+
+        std::unique_ptr<Table> oldTable (table.exchange (newTable.get()));
+        waitForReaders();
+        return newTable.release();
+    }
+
+    void waitForReaders() noexcept
+    {
+        // Readers that arrive during the first wait will have seen the new table, but
+        // switching the phase twice makes sure that no reader of the old one is missed
+        for (int i = 0; i < 2; ++i)
+        {
+            const auto phase = readPhase.load();
+            readPhase.store (1 - phase);
+
+            while (numReaders[phase].load() != 0)
+                Thread::yield();
+        }
+    }
+
+    std::atomic<Table*> table { nullptr };
+    std::atomic<int> readPhase { 0 };
+    std::atomic<int> numReaders[2] { { 0 }, { 0 } };
+    uint32 lastGarbageCollectionTime = 0;
+};
+
+//==============================================================================
+StringPool::StringPool()  : shards (new Shard[numShards]) {}
+StringPool::~StringPool() = default;
+
+template <typename NewStringType>
+String StringPool::addPooledString (const NewStringType& newString)
+{
+    const auto hash = hashStringCharacters (newString);
+    auto& shard = shards[hash >> (32 - numShardBits)];
+
+    if (auto existing = shard.find (newString, hash); existing.isNotEmpty())
+        return existing;
+
+    const ScopedLock sl (shard.lock);
+    return shard.add (newString, hash);
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -114,9 +324,7 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return addPooledString (CharPointer_UTF8 (newString));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -124,9 +332,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return addPooledString (StartEndString (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -134,9 +340,7 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return addPooledString (newString.text);
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -144,27 +348,16 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
-}
-
-void StringPool::garbageCollectIfNeeded()
-{
-    if (strings.size() > minNumberOfStringsForGarbageCollection
-         && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
-        garbageCollect();
+    return addPooledString (newString);
 }
 
 void StringPool::garbageCollect()
 {
-    const ScopedLock sl (lock);
-
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference (i).getReferenceCount() == 1)
-            strings.remove (i);
-
-    lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    for (size_t i = 0; i < numShards; ++i)
+    {
+        const ScopedLock sl (shards[i].lock);
+        shards[i].garbageCollect();
+    }
 }
 
 StringPool& StringPool::getGlobalPool() noexcept
@@ -173,4 +366,100 @@ StringPool& StringPool::getGlobalPool() noexcept
     return pool;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StringPoolTests final : public UnitTest
+{
+public:
+    StringPoolTests()
+        : UnitTest ("StringPool", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Matching strings share the same text");
+        {
+            StringPool pool;
+            const String original ("a string to pool");
+            const auto pooled = pool.getPooledString (original);
+
+            expect (pooled == original);
+            expect (pool.getPooledString ("a string to pool").getCharPointer() == pooled.getCharPointer());
+            expect (pool.getPooledString (StringRef ("a string to pool")).getCharPointer() == pooled.getCharPointer());
+
+            const String longer ("a string to pool, and more");
+            expect (pool.getPooledString (longer.getCharPointer(), longer.getCharPointer() + original.length())
+                        .getCharPointer() == pooled.getCharPointer());
+
+            expect (pool.getPooledString ("another string").getCharPointer() != pooled.getCharPointer());
+            expect (pool.getPooledString (String()).isEmpty());
+        }
+
+        beginTest ("Garbage collection keeps strings that are still referenced");
+        {
+            StringPool pool;
+            StringArray kept;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                const auto pooled = pool.getPooledString ("string " + String (i));
+
+                if (i % 3 == 0)
+                    kept.add (pooled);
+            }
+
+            pool.garbageCollect();
+
+            for (int i = 0; i < kept.size(); ++i)
+                expect (pool.getPooledString ("string " + String (i * 3)).getCharPointer() == kept[i].getCharPointer());
+        }
+
+        beginTest ("Strings added from several threads are only pooled once");
+        {
+            StringPool pool;
+            std::vector<std::unique_ptr<PoolingThread>> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.push_back (std::make_unique<PoolingThread> (pool));
+
+            for (auto& t : threads)
+                t->startThread();
+
+            for (auto& t : threads)
+                t->waitForThreadToExit (-1);
+
+            for (int i = 0; i < PoolingThread::numStrings; ++i)
+                for (auto& t : threads)
+                    expect (t->results[i].getCharPointer() == threads.front()->results[i].getCharPointer());
+        }
+    }
+
+private:
+    struct PoolingThread final : public Thread
+    {
+        explicit PoolingThread (StringPool& p)  : Thread ("StringPool test"), pool (p) {}
+
+        void run() override
+        {
+            for (int i = 0; i < numStrings; ++i)
+            {
+                results.add (pool.getPooledString ("string " + String (i)));
+
+                if (i % 500 == 0)
+                    pool.garbageCollect();
+            }
+        }
+
+        static constexpr int numStrings = 2000;
+        StringPool& pool;
+        StringArray results;
+    };
+};
+
+static StringPoolTests stringPoolTests;
+
+#endif
+
 } // namespace juce
@@ -46,6 +46,10 @@ namespace juce
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
 
+    The strings are kept in a hash table that is split into shards which each have their
+    own lock, and strings that are already in the pool can be found without taking any
+    lock, so many threads can use the same pool at once.
+
     @tags{Core}
 */
 class JUCE_API  StringPool
@@ -53,7 +57,10 @@ class JUCE_API  StringPool
 public:
     //==============================================================================
     /** Creates an empty pool. */
-    StringPool() noexcept;
+    StringPool();
+
+    /** Destructor. */
+    ~StringPool();
 
     //==============================================================================
     /** Returns a pointer to a shared copy of the string that is passed in.
@@ -87,11 +94,11 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    struct Shard;
+    std::unique_ptr<Shard[]> shards;
 
-    void garbageCollectIfNeeded();
+    template <typename NewStringType>
+    String addPooledString (const NewStringType&);
 
     JUCE_DECLARE_NON_COPYABLE (StringPool)
 };
@@ -208,11 +208,329 @@ struct TextDiffHelpers
     }
 };
 
+//==============================================================================
+/*  Myers' O(ND) difference algorithm, using the linear space refinement: the shortest edit
+    path is searched for from both ends at once, and when the two searches meet, the parts
+    before and after the meeting point are compared in the same way.
+*/
+struct MyersDiff
+{
+    // Each token stands for a character or a line, and tokens compare equal when they're the same
+    MyersDiff (const std::vector<int>& tokensA, const std::vector<int>& tokensB)
+        : a (tokensA), b (tokensB)
+    {}
+
+    struct Hunk
+    {
+        int startA, lengthA, startB, lengthB;
+    };
+
+    // Returns the regions of the two sequences that differ, in order
+    std::vector<Hunk> findHunks()
+    {
+        std::vector<Hunk> hunks;
+        std::vector<Region> regions { { 0, (int) a.size(), 0, (int) b.size() } };
+
+        while (! regions.empty())
+        {
+            auto r = regions.back();
+            regions.pop_back();
+
+            while (r.startA < r.endA && r.startB < r.endB && a[(size_t) r.startA] == b[(size_t) r.startB])
+            {
+                ++r.startA;
+                ++r.startB;
+            }
+
+            while (r.startA < r.endA && r.startB < r.endB && a[(size_t) r.endA - 1] == b[(size_t) r.endB - 1])
+            {
+                --r.endA;
+                --r.endB;
+            }
+
+            if (r.startA == r.endA || r.startB == r.endB)
+            {
+                if (r.startA != r.endA || r.startB != r.endB)
+                    addHunk (hunks, { r.startA, r.endA - r.startA, r.startB, r.endB - r.startB });
+
+                continue;
+            }
+
+            const auto split = findSplit (r);
+
+            // The second half is pushed first so that the hunks come out in order
+            regions.push_back ({ r.startA + split.x, r.endA, r.startB + split.y, r.endB });
+            regions.push_back ({ r.startA, r.startA + split.x, r.startB, r.startB + split.y });
+        }
+
+        return hunks;
+    }
+
+    // The number of searches that failed to meet, which should never happen
+    int numUnmetSearches = 0;
+
+private:
+    struct Region
+    {
+        int startA, endA, startB, endB;
+    };
+
+    struct Point
+    {
+        int x, y;
+    };
+
+    const std::vector<int>& a;
+    const std::vector<int>& b;
+    std::vector<int> forward, backward;
+
+    static void addHunk (std::vector<Hunk>& hunks, Hunk h)
+    {
+        if (! hunks.empty())
+        {
+            auto& last = hunks.back();
+
+            if (last.startA + last.lengthA == h.startA && last.startB + last.lengthB == h.startB)
+            {
+                last.lengthA += h.lengthA;
+                last.lengthB += h.lengthB;
+                return;
+            }
+        }
+
+        hunks.push_back (h);
+    }
+
+    /*  Returns a point on the shortest edit path through a region whose first and last tokens
+        differ, relative to the start of the region.
+
+        Both searches store the furthest x reached on each diagonal k = x - y, with the backward
+        one working in coordinates measured back from the end of the region. Diagonals that run
+        off the edge of the region are dropped from the searches. If the number of differences
+        gets too large, the search is abandoned and the region is split at the furthest point
+        that the forward search reached, so the result may no longer be the smallest.
+    */
+    Point findSplit (const Region r)
+    {
+        const auto* ta = a.data() + r.startA;
+        const auto* tb = b.data() + r.startB;
+        const auto n = r.endA - r.startA, m = r.endB - r.startB;
+        const auto maxD = (n + m + 1) / 2;
+        const auto maxCost = jmax (256, maxComplexity / (n + m));
+        const auto offset = maxD + 1;
+        const auto delta = n - m;
+        const auto deltaIsOdd = (delta & 1) != 0;
+
+        forward .assign ((size_t) (2 * offset + 1), -1);
+        backward.assign ((size_t) (2 * offset + 1), -1);
+        forward [(size_t) offset + 1] = 0;
+        backward[(size_t) offset + 1] = 0;
+
+        int forwardStart = 0, forwardEnd = 0, backwardStart = 0, backwardEnd = 0;
+
+        for (int d = 0; d <= maxD; ++d)
+        {
+            if (d > maxCost)
+                return findFurthestForwardPoint (n, m, d - 1, forwardStart, forwardEnd, offset);
+
+            for (int k = -d + forwardStart; k <= d - forwardEnd; k += 2)
+            {
+                auto* v = forward.data() + offset + k;
+                auto x = (k == -d || (k != d && v[-1] < v[1])) ? v[1] : v[-1] + 1;
+                auto y = x - k;
+
+                while (x < n && y < m && ta[x] == tb[y])
+                {
+                    ++x;
+                    ++y;
+                }
+
+                *v = x;
+
+                // A diagonal that has left the region is marked as unreached again, so that
+                // its neighbours never continue from it
+                if (x > n)
+                {
+                    *v = -1;
+                    forwardEnd += 2;
+                }
+                else if (y > m)
+                {
+                    *v = -1;
+                    forwardStart += 2;
+                }
+                else if (deltaIsOdd)
+                {
+                    const auto backwardIndex = offset + delta - k;
+
+                    if (isPositiveAndBelow (backwardIndex, (int) backward.size())
+                         && backward[(size_t) backwardIndex] != -1
+                         && x >= n - backward[(size_t) backwardIndex])
+                        return { x, y };
+                }
+            }
+
+            for (int k = -d + backwardStart; k <= d - backwardEnd; k += 2)
+            {
+                auto* v = backward.data() + offset + k;
+                auto x = (k == -d || (k != d && v[-1] < v[1])) ? v[1] : v[-1] + 1;
+                auto y = x - k;
+
+                while (x < n && y < m && ta[n - x - 1] == tb[m - y - 1])
+                {
+                    ++x;
+                    ++y;
+                }
+
+                *v = x;
+
+                if (x > n)
+                {
+                    *v = -1;
+                    backwardEnd += 2;
+                }
+                else if (y > m)
+                {
+                    *v = -1;
+                    backwardStart += 2;
+                }
+                else if (! deltaIsOdd)
+                {
+                    const auto forwardIndex = offset + delta - k;
+
+                    if (isPositiveAndBelow (forwardIndex, (int) forward.size())
+                         && forward[(size_t) forwardIndex] != -1)
+                    {
+                        const auto forwardX = forward[(size_t) forwardIndex];
+
+                        if (forwardX >= n - x)
+                            return { forwardX, forwardX - (delta - k) };
+                    }
+                }
+            }
+        }
+
+        // The searches always meet for regions that start and end with different tokens
+        ++numUnmetSearches;
+        jassertfalse;
+        return { n, 0 };
+    }
+
+    Point findFurthestForwardPoint (int n, int m, int d, int forwardStart, int forwardEnd, int offset) const
+    {
+        Point best { 0, 0 };
+
+        for (int k = -d + forwardStart; k <= d - forwardEnd; k += 2)
+        {
+            const auto x = forward[(size_t) (offset + k)], y = x - k;
+
+            if (x >= 0 && x <= n && y >= 0 && y <= m && x + y < n + m && x + y > best.x + best.y)
+                best = { x, y };
+        }
+
+        jassert (best.x + best.y > 0);
+        return best;
+    }
+
+    enum { maxComplexity = 16 * 1024 * 1024 };
+};
+
+//==============================================================================
+struct TokenisedText
+{
+    std::vector<int> tokens;
+    Array<int> tokenStarts;   // the character index at which each token starts, followed by the total length
+};
+
+static TokenisedText tokeniseCharacters (const String& text)
+{
+    TokenisedText result;
+    result.tokens.reserve ((size_t) text.length());
+
+    for (auto t = text.getCharPointer(); ! t.isEmpty();)
+        result.tokens.push_back ((int) t.getAndAdvance());
+
+    return result;
+}
+
+static TokenisedText tokeniseLines (const String& text, std::unordered_map<String, int>& lineIDs)
+{
+    TokenisedText result;
+    int index = 0;
+
+    for (auto t = text.getCharPointer(); ! t.isEmpty();)
+    {
+        const auto lineStart = t;
+        result.tokenStarts.add (index);
+
+        for (;;)
+        {
+            const auto c = t.getAndAdvance();
+            ++index;
+
+            if (c == '\n' || t.isEmpty())
+                break;
+        }
+
+        const auto id = lineIDs.emplace (String (lineStart, t), (int) lineIDs.size()).first->second;
+        result.tokens.push_back (id);
+    }
+
+    result.tokenStarts.add (index);
+    return result;
+}
+
+static void diffTokens (TextDiff& td, const String& target, const TokenisedText& original, const TokenisedText& newText)
+{
+    auto getCharIndex = [] (const TokenisedText& t, int tokenIndex)
+    {
+        return t.tokenStarts.isEmpty() ? tokenIndex : t.tokenStarts.getUnchecked (tokenIndex);
+    };
+
+    auto targetText = target.getCharPointer();
+    int targetIndex = 0;
+
+    for (auto& hunk : MyersDiff (original.tokens, newText.tokens).findHunks())
+    {
+        const auto start = getCharIndex (newText, hunk.startB);
+        const auto numToDelete = getCharIndex (original, hunk.startA + hunk.lengthA) - getCharIndex (original, hunk.startA);
+        const auto numToInsert = getCharIndex (newText, hunk.startB + hunk.lengthB) - start;
+
+        targetText += start - targetIndex;
+        targetIndex = start;
+
+        if (numToDelete > 0)
+            TextDiffHelpers::addDeletion (td, start, numToDelete);
+
+        if (numToInsert > 0)
+            TextDiffHelpers::addInsertion (td, targetText, start, numToInsert);
+    }
+}
+
+//==============================================================================
 TextDiff::TextDiff (const String& original, const String& target)
 {
     TextDiffHelpers::diffSkippingCommonStart (*this, original, target);
 }
 
+TextDiff::TextDiff (const String& original, const String& target, Mode mode)
+{
+    if (mode == Mode::characters)
+    {
+        diffTokens (*this, target, tokeniseCharacters (original), tokeniseCharacters (target));
+    }
+    else if (mode == Mode::lines)
+    {
+        std::unordered_map<String, int> lineIDs;
+        const auto originalLines = tokeniseLines (original, lineIDs);
+        diffTokens (*this, target, originalLines, tokeniseLines (target, lineIDs));
+    }
+    else
+    {
+        TextDiffHelpers::diffSkippingCommonStart (*this, original, target);
+    }
+}
+
 String TextDiff::appliedTo (String text) const
 {
     for (auto& c : changes)
@@ -264,11 +582,27 @@ public:
         return CharPointer_UTF32 (buffer);
     }
 
+    static String createLines (Random& r, int numLines)
+    {
+        String s;
+
+        for (int i = 0; i < numLines; ++i)
+            s << "line " << r.nextInt (20) << (r.nextInt (10) == 0 ? "\r\n" : "\n");
+
+        if (r.nextBool())
+            s << "no newline " << r.nextInt (20);
+
+        return s;
+    }
+
     void testDiff (const String& a, const String& b)
     {
-        TextDiff diff (a, b);
-        auto result = diff.appliedTo (a);
-        expectEquals (result, b);
+        for (auto mode : { TextDiff::Mode::longestCommonSubstring, TextDiff::Mode::characters, TextDiff::Mode::lines })
+        {
+            TextDiff diff (a, b, mode);
+            auto result = diff.appliedTo (a);
+            expectEquals (result, b);
+        }
     }
 
     void runTest() override
@@ -291,6 +625,93 @@ public:
             testDiff (s, createString (r));
             testDiff (s + createString (r), s + createString (r));
         }
+
+        beginTest ("Lines");
+
+        for (int i = 200; --i >= 0;)
+        {
+            auto s = createLines (r, r.nextInt (50));
+            testDiff (s, createLines (r, r.nextInt (50)));
+            testDiff (s + createLines (r, 5), s + createLines (r, 5));
+        }
+
+        beginTest ("Myers diffs are minimal");
+
+        {
+            int numEdits = 0;
+
+            for (auto& c : TextDiff ("abcabba", "cbabac", TextDiff::Mode::characters).changes)
+                numEdits += c.isDeletion() ? c.length : c.insertedText.length();
+
+            expectEquals (numEdits, 5);
+        }
+
+        expectEquals (TextDiff ("a\nb\nc\n", "a\nx\nc\n", TextDiff::Mode::lines).changes.size(), 2);
+
+        // Regions where every token differs need the searches to go all the way to the middle
+        {
+            const auto checkSearchesMeet = [this] (const String& original, const String& target, int expectedNumEdits)
+            {
+                std::vector<int> tokensA, tokensB;
+
+                for (auto c : original)  tokensA.push_back ((int) c);
+                for (auto c : target)    tokensB.push_back ((int) c);
+
+                MyersDiff myers (tokensA, tokensB);
+                int numEdits = 0;
+
+                for (const auto& hunk : myers.findHunks())
+                    numEdits += hunk.lengthA + hunk.lengthB;
+
+                expectEquals (myers.numUnmetSearches, 0);
+                expectEquals (numEdits, expectedNumEdits);
+            };
+
+            checkSearchesMeet ("a", "b", 2);
+            checkSearchesMeet ("abcXdef", "abcYdef", 2);
+            checkSearchesMeet ("ab", "xy", 4);
+            checkSearchesMeet ("abc", "xy", 5);
+
+            for (int i = 100; --i >= 0;)
+            {
+                const auto original = createString (r) + "x";
+                const auto index = r.nextInt (original.length());
+                const auto target = original.substring (0, index) + "#" + original.substring (index + 1);
+
+                checkSearchesMeet (original, target, 2);
+            }
+        }
+
+        {
+            const TextDiff diff ("same\nold\nsame\n", "same\nnew\nsame\n", TextDiff::Mode::lines);
+
+            expectEquals (diff.changes.size(), 2);
+            expect (diff.changes[0].isDeletion());
+            expectEquals (diff.changes[0].start, 5);
+            expectEquals (diff.changes[0].length, 4);
+            expectEquals (diff.changes[1].insertedText, String ("new\n"));
+            expectEquals (diff.changes[1].start, 5);
+        }
+
+        beginTest ("Large inputs");
+
+        {
+            String original, target;
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                const auto line = "value " + String (r.nextInt (1000)) + "\n";
+                original << line;
+                target << (r.nextInt (50) == 0 ? "changed " + line : line);
+            }
+
+            for (auto mode : { TextDiff::Mode::characters, TextDiff::Mode::lines })
+                expectEquals (TextDiff (original, target, mode).appliedTo (original), target);
+
+            // Very different inputs make the search give up early
+            const auto unrelated = createLines (r, 20000);
+            expectEquals (TextDiff (original, unrelated, TextDiff::Mode::lines).appliedTo (original), unrelated);
+        }
     }
 };
 
@@ -48,10 +48,38 @@ namespace juce
 class JUCE_API TextDiff
 {
 public:
+    /** The ways in which the two strings can be compared. */
+    enum class Mode
+    {
+        /** Repeatedly matches the longest common substrings of the two strings. This gives
+            good results for short strings, but its cost grows with the product of their lengths.
+        */
+        longestCommonSubstring,
+
+        /** Compares the individual characters of the strings using Myers' O(ND) algorithm, which
+            finds the smallest set of changes in linear space, and a time that only grows with the
+            length of the strings and the number of differences between them. If the strings are
+            very different, the search is cut short and the changes may not be the smallest possible.
+        */
+        characters,
+
+        /** Like characters, but compares whole lines, so that each change replaces complete lines.
+            This is much faster for large documents.
+        */
+        lines
+    };
+
     /** Creates a set of diffs for converting the original string into the target. */
     TextDiff (const String& original,
               const String& target);
 
+    /** Creates a set of diffs for converting the original string into the target,
+        using the given method to compare them.
+    */
+    TextDiff (const String& original,
+              const String& target,
+              Mode mode);
+
     /** Applies this sequence of changes to the original string, producing the
         target string that was specified when generating them.
 
@@ -42,7 +42,7 @@ public:
     explicit Impl (HighResolutionTimer& o)
         : owner { o } {}
 
-    void startTimer (int newIntervalMs)
+    void startTimer (double newIntervalMs, Precision precision)
     {
         shouldCancelCallbacks.store (true);
 
@@ -53,13 +53,31 @@ public:
             if (timer.getIntervalMs() > 0)
                 timer.cancelTimer();
 
-            jassert (timer.getIntervalMs() == 0);
+            if (preciseTimer != nullptr && preciseTimer->getIntervalMs() > 0.0)
+                preciseTimer->cancelTimer();
 
-            if (newIntervalMs > 0)
-                timer.startTimer (jmax (0, newIntervalMs));
+            jassert (getIntervalMsLocked() == 0);
+
+            if (newIntervalMs > 0.0)
+            {
+                if (precision == Precision::precise)
+                {
+                    if (preciseTimer == nullptr)
+                        preciseTimer = std::make_unique<PrecisePlatformTimer> (static_cast<PlatformTimerListener&> (*this));
+
+                    resetJitterStatistics (newIntervalMs);
+                    preciseTimer->startTimer (newIntervalMs);
+                }
+                else
+                {
+                    const auto intervalMs = jmax (1, roundToInt (newIntervalMs));
+                    resetJitterStatistics (intervalMs);
+                    timer.startTimer (intervalMs);
+                }
+            }
 
             return callbackThreadId != std::this_thread::get_id()
-                && timer.getIntervalMs() <= 0;
+                && getIntervalMsLocked() <= 0;
         }();
 
         if (shouldWaitForPendingCallbacks)
@@ -69,7 +87,7 @@ public:
     int getIntervalMs() const
     {
         const std::scoped_lock lock { timerMutex };
-        return timer.getIntervalMs();
+        return getIntervalMsLocked();
     }
 
     bool isTimerRunning() const
@@ -77,9 +95,75 @@ public:
         return getIntervalMs() > 0;
     }
 
+    JitterStatistics getJitterStatistics() const
+    {
+        JitterStatistics result;
+        result.numIntervals = jitter.numIntervals.load();
+
+        if (result.numIntervals > 0)
+        {
+            const auto n = (double) result.numIntervals;
+            const auto mean = jitter.sumErrorMs.load() / n;
+
+            result.averageErrorMs = jitter.sumAbsoluteErrorMs.load() / n;
+            result.maxErrorMs = jitter.maxErrorMs.load();
+            result.standardDeviationMs = std::sqrt (jmax (0.0, jitter.sumSquaredErrorMs.load() / n - mean * mean));
+        }
+
+        return result;
+    }
+
 private:
+    int getIntervalMsLocked() const
+    {
+        if (preciseTimer != nullptr)
+            if (const auto preciseIntervalMs = preciseTimer->getIntervalMs(); preciseIntervalMs > 0.0)
+                return jmax (1, roundToInt (preciseIntervalMs));
+
+        return timer.getIntervalMs();
+    }
+
+    // These are only written by the timer thread, apart from when the timer is restarted
+    struct Jitter
+    {
+        std::atomic<double> intervalMs { 0.0 };
+        std::atomic<int64> lastCallbackTicks { 0 }, numIntervals { 0 };
+        std::atomic<double> sumErrorMs { 0.0 }, sumAbsoluteErrorMs { 0.0 }, sumSquaredErrorMs { 0.0 }, maxErrorMs { 0.0 };
+    };
+
+    void resetJitterStatistics (double newIntervalMs)
+    {
+        jitter.intervalMs = newIntervalMs;
+        jitter.lastCallbackTicks = 0;
+        jitter.numIntervals = 0;
+        jitter.sumErrorMs = 0.0;
+        jitter.sumAbsoluteErrorMs = 0.0;
+        jitter.sumSquaredErrorMs = 0.0;
+        jitter.maxErrorMs = 0.0;
+    }
+
+    void updateJitterStatistics()
+    {
+        const auto now = Time::getHighResolutionTicks();
+        const auto last = jitter.lastCallbackTicks.exchange (now);
+
+        if (last == 0)
+            return;
+
+        const auto error = Time::highResolutionTicksToSeconds (now - last) * 1000.0 - jitter.intervalMs.load();
+        const auto absoluteError = std::abs (error);
+
+        jitter.sumErrorMs = jitter.sumErrorMs.load() + error;
+        jitter.sumAbsoluteErrorMs = jitter.sumAbsoluteErrorMs.load() + absoluteError;
+        jitter.sumSquaredErrorMs = jitter.sumSquaredErrorMs.load() + error * error;
+        jitter.maxErrorMs = jmax (jitter.maxErrorMs.load(), absoluteError);
+        ++jitter.numIntervals;
+    }
+
     void onTimerExpired() final
     {
+        updateJitterStatistics();
+
         callbackThreadId.store (std::this_thread::get_id());
 
         {
@@ -109,7 +193,9 @@ private:
     std::mutex callbackMutex;
     std::atomic<std::thread::id> callbackThreadId{};
     std::atomic<bool> shouldCancelCallbacks { false };
+    Jitter jitter;
     PlatformTimer timer { *this };
+    std::unique_ptr<PrecisePlatformTimer> preciseTimer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Impl)
     JUCE_DECLARE_NON_MOVEABLE (Impl)
@@ -129,12 +215,17 @@ HighResolutionTimer::~HighResolutionTimer()
 
 void HighResolutionTimer::startTimer (int newIntervalMs)
 {
-    impl->startTimer (newIntervalMs);
+    impl->startTimer (newIntervalMs, Precision::standard);
+}
+
+void HighResolutionTimer::startTimer (double newIntervalMs, Precision precision)
+{
+    impl->startTimer (newIntervalMs, precision);
 }
 
 void HighResolutionTimer::stopTimer()
 {
-    impl->startTimer (0);
+    impl->startTimer (0.0, Precision::standard);
 }
 
 int HighResolutionTimer::getTimerInterval() const noexcept
@@ -147,6 +238,11 @@ bool HighResolutionTimer::isTimerRunning() const noexcept
     return impl->isTimerRunning();
 }
 
+HighResolutionTimer::JitterStatistics HighResolutionTimer::getJitterStatistics() const noexcept
+{
+    return impl->getJitterStatistics();
+}
+
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
@@ -160,9 +256,90 @@ public:
     {
         runBehaviourTestsWithBackgroundThreads<0>();
         runBehaviourTestsWithBackgroundThreads<16>();
+        runPrecisionTests();
         runStressTests();
     }
 
+    void runPrecisionTests()
+    {
+        constexpr int maximumTimeoutMs { 30'000 };
+
+        beginTest ("Precise timers can have fractional intervals, and don't drift");
+        {
+            constexpr int numCallbacks = 40;
+            constexpr double intervalMs = 2.6;
+
+            WaitableEvent finished;
+            std::atomic<int64> finishTicks { 0 };
+
+            Timer timer {[&, callbackCount = 0]() mutable
+            {
+                if (++callbackCount == numCallbacks)
+                {
+                    finishTicks = Time::getHighResolutionTicks();
+                    finished.signal();
+                }
+            }};
+
+            const auto startTicks = Time::getHighResolutionTicks();
+            timer.startTimer (intervalMs, HighResolutionTimer::Precision::precise);
+            expect (timer.isTimerRunning());
+            expectEquals (timer.getTimerInterval(), 3);
+
+            expect (finished.wait (maximumTimeoutMs));
+            timer.stopTimer();
+            expect (! timer.isTimerRunning());
+            expectEquals (timer.getTimerInterval(), 0);
+
+            // Callbacks are never early, so however late the others were, the last one
+            // can't have happened before its scheduled time
+            const auto elapsedMs = Time::highResolutionTicksToSeconds (finishTicks - startTicks) * 1000.0;
+            expectGreaterOrEqual (elapsedMs, numCallbacks * intervalMs);
+
+            const auto stats = timer.getJitterStatistics();
+            expectGreaterOrEqual (stats.numIntervals, (int64) numCallbacks - 1);
+            expectGreaterOrEqual (stats.maxErrorMs, stats.averageErrorMs);
+        }
+
+        beginTest ("Timers can switch between standard and precise");
+        {
+            WaitableEvent firedPrecisely;
+            WaitableEvent firedNormally;
+            std::atomic<bool> precise { true };
+
+            Timer timer {[&] { (precise ? firedPrecisely : firedNormally).signal(); }};
+
+            timer.startTimer (1.0, HighResolutionTimer::Precision::precise);
+            expect (firedPrecisely.wait (maximumTimeoutMs));
+
+            timer.stopTimer();
+            precise = false;
+            timer.startTimer (1);
+            expectEquals (timer.getTimerInterval(), 1);
+            expect (firedNormally.wait (maximumTimeoutMs));
+
+            timer.startTimer (0.25, HighResolutionTimer::Precision::precise);
+            expectEquals (timer.getTimerInterval(), 1);
+            timer.stopTimer();
+            expect (! timer.isTimerRunning());
+        }
+
+        beginTest ("Stopping a precise timer from its callback");
+        {
+            WaitableEvent stoppedTimer;
+
+            Timer timer {[&]
+            {
+                timer.stopTimer();
+                expect (! timer.isTimerRunning());
+                stoppedTimer.signal();
+            }};
+
+            timer.startTimer (100.0, HighResolutionTimer::Precision::precise);
+            expect (stoppedTimer.wait (maximumTimeoutMs));
+        }
+    }
+
     template <size_t NumBackgroundThreads>
     void runBehaviourTestsWithBackgroundThreads()
     {
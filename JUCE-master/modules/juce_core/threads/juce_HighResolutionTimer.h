@@ -80,6 +80,32 @@ public:
     */
     virtual void hiResTimerCallback() = 0;
 
+    //==============================================================================
+    /** Controls how the timer waits for each callback. */
+    enum class Precision
+    {
+        /** The platform's normal periodic timer, which uses very little CPU, but the
+            callbacks may be a millisecond or two late.
+        */
+        standard,
+
+        /** A dedicated thread with realtime priority sleeps on the platform's most
+            precise timer until shortly before each callback is due, and then busy-waits
+            for the rest of the time. This is a timerfd on Linux and Android, and a
+            high-resolution waitable timer on Windows.
+
+            The callback times are calculated from the time the timer was started, so
+            they don't drift. If a callback takes longer than the interval, the ones that
+            were missed are skipped.
+
+            This uses more CPU than a standard timer, so only use it when you need the
+            callbacks to be within a few microseconds of the right time, e.g. to send a
+            MIDI clock. Intervals shorter than a couple of milliseconds will spend most of
+            their time busy-waiting.
+        */
+        precise
+    };
+
     //==============================================================================
     /** Starts the timer and sets the length of interval required.
 
@@ -105,6 +131,18 @@ public:
     */
     void startTimer (int intervalInMilliseconds);
 
+    /** Starts the timer with the given precision.
+
+        This behaves like startTimer (int), but a precise timer can also have an interval
+        that isn't a whole number of milliseconds. A standard timer's interval is
+        rounded to the nearest millisecond.
+
+        @param  intervalInMilliseconds  the interval to use (a value of zero or less will stop the timer)
+        @param  precision               how the timer should wait for each callback
+        @see Precision
+    */
+    void startTimer (double intervalInMilliseconds, Precision precision);
+
     /** Stops the timer.
 
         This method may block while it waits for pending callbacks to complete.
@@ -125,9 +163,34 @@ public:
 
     /** Returns the timer's interval.
         @returns the timer's interval in milliseconds if it's running, or 0 if it's not.
+                 The interval of a precise timer is rounded to the nearest millisecond,
+                 but it will be at least 1.
     */
     int getTimerInterval() const noexcept;
 
+    //==============================================================================
+    /** How much the time between callbacks has differed from the timer's interval. */
+    struct JitterStatistics
+    {
+        /** The number of times between consecutive callbacks that have been measured. */
+        int64 numIntervals = 0;
+
+        /** The average and largest differences between the measured times and the
+            interval, in milliseconds.
+        */
+        double averageErrorMs = 0.0, maxErrorMs = 0.0;
+
+        /** The standard deviation of the measured times, in milliseconds. */
+        double standardDeviationMs = 0.0;
+    };
+
+    /** Returns the jitter that has been observed since the timer was last started.
+
+        The times are measured just before hiResTimerCallback() is called, so
+        callbacks that take a long time or that are skipped will also be included.
+    */
+    JitterStatistics getJitterStatistics() const noexcept;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl;
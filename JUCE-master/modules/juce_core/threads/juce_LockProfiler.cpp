@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_LOCK_PROFILING
+
+namespace juce
+{
+
+//==============================================================================
+/*  This is updated from inside every lock, including ones that are used while
+    allocating and before static constructors have run, so it's all plain data
+    which is constant-initialised. The locks are found by their address, using
+    open addressing with linear probing. Entries are never removed, so that the
+    probe sequences stay intact.
+*/
+struct LockProfilerEntry
+{
+    std::atomic<const void*> lock;
+    std::atomic<const char*> name;
+    std::atomic<int64> numAcquisitions, numContentions, totalWaitTicks, maxWaitTicks;
+
+    std::atomic<Thread::ThreadID> ownerIds[LockProfiler::maxOwners];
+    std::atomic<int64> ownerAcquisitions[LockProfiler::maxOwners], ownerContentions[LockProfiler::maxOwners];
+};
+
+static_assert (isPowerOfTwo (LockProfiler::maxLocks));
+
+static LockProfilerEntry lockProfilerEntries[LockProfiler::maxLocks] {};
+
+static LockProfilerEntry* findLockProfilerEntry (const void* lock, bool createIfMissing) noexcept
+{
+    constexpr auto mask = (size_t) LockProfiler::maxLocks - 1;
+
+    // Locks are usually at least 8-byte aligned, so the low bits aren't worth hashing
+    auto hash = (size_t) (pointer_sized_uint) lock >> 3;
+    hash ^= hash >> 11;
+
+    for (size_t i = 0; i <= mask; ++i)
+    {
+        auto& entry = lockProfilerEntries[(hash + i) & mask];
+        auto existing = entry.lock.load (std::memory_order_acquire);
+
+        if (existing == lock)
+            return &entry;
+
+        if (existing == nullptr)
+        {
+            if (! createIfMissing)
+                return nullptr;
+
+            if (entry.lock.compare_exchange_strong (existing, lock) || existing == lock)
+                return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+static int findLockProfilerOwner (LockProfilerEntry& entry, Thread::ThreadID thread) noexcept
+{
+    for (int i = 0; i < LockProfiler::maxOwners; ++i)
+    {
+        auto existing = entry.ownerIds[i].load();
+
+        if (existing == thread)
+            return i;
+
+        if (existing == nullptr && (entry.ownerIds[i].compare_exchange_strong (existing, thread) || existing == thread))
+            return i;
+    }
+
+    return -1;
+}
+
+void JUCE_CALLTYPE detail::lockAcquired (const void* lock, bool wasContended, int64 waitStartTicks) noexcept
+{
+    auto* entry = findLockProfilerEntry (lock, wasContended);
+
+    if (entry == nullptr)
+        return;
+
+    entry->numAcquisitions.fetch_add (1, std::memory_order_relaxed);
+
+    const auto owner = findLockProfilerOwner (*entry, Thread::getCurrentThreadId());
+
+    if (owner >= 0)
+        entry->ownerAcquisitions[owner].fetch_add (1, std::memory_order_relaxed);
+
+    if (! wasContended)
+        return;
+
+    const auto waitTicks = Time::getHighResolutionTicks() - waitStartTicks;
+
+    entry->numContentions.fetch_add (1, std::memory_order_relaxed);
+    entry->totalWaitTicks.fetch_add (waitTicks, std::memory_order_relaxed);
+
+    for (auto maxTicks = entry->maxWaitTicks.load (std::memory_order_relaxed);
+         maxTicks < waitTicks && ! entry->maxWaitTicks.compare_exchange_weak (maxTicks, waitTicks, std::memory_order_relaxed);)
+    {}
+
+    if (owner >= 0)
+        entry->ownerContentions[owner].fetch_add (1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+std::vector<LockProfiler::LockStats> LockProfiler::getStats()
+{
+    std::vector<LockStats> result;
+
+    for (auto& entry : lockProfilerEntries)
+    {
+        const auto* lock = entry.lock.load (std::memory_order_acquire);
+        const auto* name = entry.name.load();
+
+        if (lock == nullptr || (name == nullptr && entry.numAcquisitions.load() == 0))
+            continue;
+
+        LockStats stats;
+        stats.lock = lock;
+        stats.name = name != nullptr ? String (name) : String();
+        stats.numAcquisitions = entry.numAcquisitions.load();
+        stats.numContentions = entry.numContentions.load();
+        stats.totalWaitSeconds = Time::highResolutionTicksToSeconds (entry.totalWaitTicks.load());
+        stats.maxWaitSeconds = Time::highResolutionTicksToSeconds (entry.maxWaitTicks.load());
+
+        for (int i = 0; i < maxOwners; ++i)
+            if (auto* thread = entry.ownerIds[i].load())
+                stats.owners.push_back ({ thread, entry.ownerAcquisitions[i].load(), entry.ownerContentions[i].load() });
+
+        result.push_back (std::move (stats));
+    }
+
+    std::sort (result.begin(), result.end(), [] (const auto& a, const auto& b)
+    {
+        if (! exactlyEqual (a.totalWaitSeconds, b.totalWaitSeconds))
+            return a.totalWaitSeconds > b.totalWaitSeconds;
+
+        return a.numAcquisitions > b.numAcquisitions;
+    });
+
+    return result;
+}
+
+String LockProfiler::getSummary()
+{
+    String result;
+
+    for (const auto& stats : getStats())
+    {
+        result << (stats.name.isNotEmpty() ? stats.name : "0x" + String::toHexString ((pointer_sized_int) stats.lock))
+               << ": " << stats.numAcquisitions << " acquisitions, "
+               << stats.numContentions << " contended, "
+               << String (stats.totalWaitSeconds * 1000.0, 3) << " ms total wait, "
+               << String (stats.maxWaitSeconds * 1000.0, 3) << " ms max wait, "
+               << (int) stats.owners.size() << " threads" << newLine;
+    }
+
+    return result;
+}
+
+void LockProfiler::setName (const void* lock, const char* name) noexcept
+{
+    if (auto* entry = findLockProfilerEntry (lock, true))
+        entry->name = name;
+}
+
+void LockProfiler::reset() noexcept
+{
+    for (auto& entry : lockProfilerEntries)
+    {
+        entry.numAcquisitions = 0;
+        entry.numContentions = 0;
+        entry.totalWaitTicks = 0;
+        entry.maxWaitTicks = 0;
+
+        for (int i = 0; i < maxOwners; ++i)
+        {
+            entry.ownerIds[i] = nullptr;
+            entry.ownerAcquisitions[i] = 0;
+            entry.ownerContentions[i] = 0;
+        }
+    }
+}
+
+} // namespace juce
+
+#endif
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_ENABLE_LOCK_PROFILING || DOXYGEN
+
+//==============================================================================
+/**
+    Records how much each CriticalSection and SpinLock is contended.
+
+    When JUCE_ENABLE_LOCK_PROFILING is enabled, each lock reports every acquisition,
+    along with whether the calling thread had to wait for it and for how long. Locks
+    are tracked once they have been given a name with JUCE_NAME_LOCK, or from the
+    first time that they are contended, so that short-lived locks which are never
+    contended don't fill up the table.
+
+    The statistics are held in a fixed-size table which is updated without allocating
+    or locking, so it's fine to use this in a release build that's running in
+    production. Locks are identified by their address, so if a lock is deleted and
+    another is created in the same place, their statistics will be combined.
+
+    @code
+    CriticalSection voiceLock;
+    JUCE_NAME_LOCK (voiceLock, "voiceLock")
+
+    // ...and later on:
+    DBG (LockProfiler::getSummary());
+    @endcode
+
+    @tags{Core}
+*/
+class JUCE_API LockProfiler
+{
+public:
+    //==============================================================================
+    /** The maximum number of locks that can be tracked. */
+    static constexpr int maxLocks = 1024;
+
+    /** The maximum number of different threads that are recorded for each lock. */
+    static constexpr int maxOwners = 8;
+
+    /** How often a thread has acquired a lock. */
+    struct OwnerStats
+    {
+        Thread::ThreadID threadId;
+        int64 numAcquisitions;
+        int64 numContentions;
+    };
+
+    /** The statistics for a single lock. */
+    struct LockStats
+    {
+        const void* lock;
+
+        /** The name given with JUCE_NAME_LOCK, or an empty string. */
+        String name;
+
+        /** The number of times the lock was acquired, and the number of those times
+            when a thread had to wait for it.
+        */
+        int64 numAcquisitions, numContentions;
+
+        /** The total and longest times, in seconds, spent waiting for the lock. */
+        double totalWaitSeconds, maxWaitSeconds;
+
+        /** The first maxOwners threads to acquire the lock, with their own counts. */
+        std::vector<OwnerStats> owners;
+    };
+
+    /** Returns the statistics for all of the tracked locks, with the ones that have
+        been waited for the longest first.
+    */
+    static std::vector<LockStats> getStats();
+
+    /** Returns a readable table of the statistics for all of the tracked locks. */
+    static String getSummary();
+
+    /** Gives a lock a name, and starts tracking it if it isn't already tracked.
+        The name must be a string literal, or otherwise outlive the profiler.
+        @see JUCE_NAME_LOCK
+    */
+    static void setName (const void* lock, const char* name) noexcept;
+
+    /** Clears the statistics for all the locks, but keeps their names.
+        This mustn't be called while any other threads might be using a lock.
+    */
+    static void reset() noexcept;
+
+private:
+    LockProfiler() = delete;
+};
+
+/** Gives a CriticalSection or SpinLock a name to use in the LockProfiler statistics.
+    When JUCE_ENABLE_LOCK_PROFILING is disabled, this does nothing.
+    @see LockProfiler
+*/
+#define JUCE_NAME_LOCK(lock, name) \
+    juce::LockProfiler::setName (&(lock), name);
+
+#else
+
+#define JUCE_NAME_LOCK(lock, name)
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_LOCK_PROFILING
+
+namespace juce
+{
+
+class LockProfilerTests final : public UnitTest
+{
+public:
+    LockProfilerTests()
+        : UnitTest ("LockProfiler", UnitTestCategories::threads) {}
+
+    void runTest() final
+    {
+        beginTest ("Named locks count every acquisition");
+        {
+            LockProfiler::reset();
+
+            CriticalSection lock;
+            JUCE_NAME_LOCK (lock, "test lock")
+
+            for (int i = 0; i < 10; ++i)
+                const ScopedLock sl (lock);
+
+            const auto stats = findStats (&lock);
+            expectEquals (stats.name, String ("test lock"));
+            expectEquals (stats.numAcquisitions, (int64) 10);
+            expectEquals (stats.numContentions, (int64) 0);
+            expectEquals ((int) stats.owners.size(), 1);
+            expect (stats.owners[0].threadId == Thread::getCurrentThreadId());
+        }
+
+        beginTest ("Contended locks are tracked and their wait times recorded");
+        {
+            testContention<CriticalSection>();
+            testContention<SpinLock>();
+        }
+
+        beginTest ("The summary lists the locks");
+        {
+            SpinLock lock;
+            JUCE_NAME_LOCK (lock, "summary lock")
+
+            {
+                const SpinLock::ScopedLockType sl (lock);
+            }
+
+            expect (LockProfiler::getSummary().contains ("summary lock: 1 acquisitions"));
+        }
+    }
+
+private:
+    template <typename LockType>
+    void testContention()
+    {
+        LockProfiler::reset();
+
+        LockType lock;
+        lock.enter();
+
+        std::thread waiter ([&] { const typename LockType::ScopedLockType sl (lock); });
+
+        Thread::sleep (20);
+        lock.exit();
+        waiter.join();
+
+        const auto stats = findStats (&lock);
+        expectEquals (stats.numContentions, (int64) 1);
+        expectEquals (stats.numAcquisitions, (int64) 1);
+        expect (stats.maxWaitSeconds > 0.005);
+        expect (exactlyEqual (stats.totalWaitSeconds, stats.maxWaitSeconds));
+        expectEquals ((int) stats.owners.size(), 1);
+    }
+
+    LockProfiler::LockStats findStats (const void* lock)
+    {
+        for (auto& stats : LockProfiler::getStats())
+            if (stats.lock == lock)
+                return stats;
+
+        expect (false, "lock not found");
+        return {};
+    }
+};
+
+static LockProfilerTests lockProfilerTests;
+
+} // namespace juce
+
+#endif
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+int detail::getParallelForChunkSize (const ThreadPool& pool, int numItems, const ParallelForOptions& options)
+{
+    if (options.chunkSize > 0)
+        return options.chunkSize;
+
+    const auto numChunks = (pool.getNumThreads() + 1) * 4;
+    return (int) jmax ((int64) 1, ((int64) numItems + numChunks - 1) / numChunks);
+}
+
+bool parallelFor (ThreadPool& pool,
+                  Range<int> range,
+                  const std::function<void (Range<int>)>& body,
+                  const ParallelForOptions& options)
+{
+    if (range.isEmpty())
+        return true;
+
+    const auto chunkSize = (int64) detail::getParallelForChunkSize (pool, range.getLength(), options);
+    const auto numChunks = (int) (((int64) range.getLength() + chunkSize - 1) / chunkSize);
+
+    std::atomic<int> nextChunk { 0 }, numChunksCompleted { 0 };
+
+    const std::function<void()> work = [&]
+    {
+        for (;;)
+        {
+            if (options.cancellationFlag != nullptr && options.cancellationFlag->load())
+                return;
+
+            const auto chunk = nextChunk++;
+
+            if (chunk >= numChunks)
+                return;
+
+            const auto start = (int64) range.getStart() + chunk * chunkSize;
+            body ({ (int) start, (int) jmin (start + chunkSize, (int64) range.getEnd()) });
+            ++numChunksCompleted;
+        }
+    };
+
+    struct HelperJob final : public ThreadPoolJob
+    {
+        explicit HelperJob (const std::function<void()>& w)  : ThreadPoolJob ("parallelFor"), work (w) {}
+        JobStatus runJob() override                          { work(); return jobHasFinished; }
+
+        const std::function<void()>& work;
+    };
+
+    // The calling thread takes a share of the work too, so it only needs help with the rest
+    const auto numHelpers = jmin (pool.getNumThreads(), numChunks - 1);
+    std::vector<std::unique_ptr<HelperJob>> helpers;
+    std::vector<ThreadPoolJob*> helperPointers;
+
+    for (auto i = 0; i < numHelpers; ++i)
+    {
+        helpers.push_back (std::make_unique<HelperJob> (work));
+        helperPointers.push_back (helpers.back().get());
+    }
+
+    pool.addJobs (helperPointers, false);
+
+    work();
+
+    // Helpers that haven't started by now have nothing left to do, so they can just be
+    // removed, but any that are still running must be allowed to finish their chunks.
+    for (auto* helper : helperPointers)
+        pool.removeJob (helper, false, -1);
+
+    return numChunksCompleted == numChunks;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelForTests final : public UnitTest
+{
+public:
+    ParallelForTests()
+        : UnitTest ("parallelFor", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool (3);
+
+        beginTest ("Every index is processed exactly once");
+        {
+            for (const auto chunkSize : { 0, 1, 7, 1000 })
+            {
+                std::vector<std::atomic<int>> counts (500);
+
+                const auto completed = parallelFor (pool, { 10, 510 }, [&] (Range<int> chunk)
+                {
+                    for (auto i = chunk.getStart(); i < chunk.getEnd(); ++i)
+                        ++counts[(size_t) (i - 10)];
+                }, ParallelForOptions{}.withChunkSize (chunkSize));
+
+                expect (completed);
+                expect (std::all_of (counts.begin(), counts.end(), [] (const auto& c) { return c == 1; }));
+            }
+
+            expect (parallelFor (pool, {}, [this] (Range<int>) { expect (false); }));
+        }
+
+        beginTest ("Reductions combine chunks in order");
+        {
+            const auto sum = parallelReduce (pool, { 0, 10000 }, (int64) 0, [] (Range<int> chunk)
+            {
+                int64 total = 0;
+
+                for (auto i = chunk.getStart(); i < chunk.getEnd(); ++i)
+                    total += i;
+
+                return total;
+            }, std::plus<>());
+
+            expect (sum.has_value());
+            expectEquals (*sum, (int64) 10000 * 9999 / 2);
+
+            const auto concatenated = parallelReduce (pool, { 0, 20 }, String(), [] (Range<int> chunk)
+            {
+                return String (chunk.getStart()) + " ";
+            }, std::plus<>(), ParallelForOptions{}.withChunkSize (5));
+
+            expectEquals (concatenated.value_or (String()), String ("0 5 10 15 "));
+        }
+
+        beginTest ("Loops can be cancelled");
+        {
+            std::atomic<bool> cancelled { false };
+            std::atomic<int> numChunksRun { 0 };
+
+            const auto completed = parallelFor (pool, { 0, 1000 }, [&] (Range<int>)
+            {
+                ++numChunksRun;
+                cancelled = true;
+            }, ParallelForOptions{}.withChunkSize (1).withCancellationFlag (&cancelled));
+
+            expect (! completed);
+            expect (numChunksRun < 1000);
+
+            const auto sum = parallelReduce (pool, { 0, 1000 }, 0, [] (Range<int>) { return 1; }, std::plus<>(),
+                                             ParallelForOptions{}.withCancellationFlag (&cancelled));
+            expect (! sum.has_value());
+        }
+
+        beginTest ("Loops can be nested inside jobs on the same pool");
+        {
+            ThreadPool singleThreadPool (1);
+
+            auto result = singleThreadPool.addJobWithFuture ([&]
+            {
+                return parallelReduce (singleThreadPool, { 0, 100 }, 0, [] (Range<int> chunk) { return chunk.getLength(); }, std::plus<>());
+            });
+
+            expectEquals (result.get().value_or (0), 100);
+        }
+    }
+};
+
+static ParallelForTests parallelForTests;
+
+#endif
+
+} // namespace juce
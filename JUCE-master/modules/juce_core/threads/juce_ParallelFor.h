@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Options that control how parallelFor() and parallelReduce() split up their work.
+
+    @tags{Core}
+*/
+struct ParallelForOptions
+{
+    /** The number of consecutive indices that are passed to each call of the loop body.
+
+        If this is zero, the range is split into a few chunks for each thread in the pool,
+        which keeps the threads busy even if some chunks take longer than others.
+    */
+    [[nodiscard]] ParallelForOptions withChunkSize (int newChunkSize) const
+    {
+        return withMember (*this, &ParallelForOptions::chunkSize, newChunkSize);
+    }
+
+    /** A flag that can be set from any thread to stop the loop. Chunks that have already
+        started will be allowed to finish, but no more chunks will be started.
+    */
+    [[nodiscard]] ParallelForOptions withCancellationFlag (const std::atomic<bool>* newCancellationFlag) const
+    {
+        return withMember (*this, &ParallelForOptions::cancellationFlag, newCancellationFlag);
+    }
+
+    int chunkSize { 0 };
+    const std::atomic<bool>* cancellationFlag { nullptr };
+};
+
+namespace detail
+{
+    JUCE_API int getParallelForChunkSize (const ThreadPool&, int numItems, const ParallelForOptions&);
+}
+
+//==============================================================================
+/**
+    Calls a function for each chunk of a range of indices, using the threads of a ThreadPool.
+
+    The range is divided into consecutive chunks, and the body is called once for each
+    chunk with the sub-range that it should process. The chunks may be processed in any
+    order and on any thread, including the calling thread, which works through chunks
+    alongside the pool until the whole range has been processed.
+
+    The chunks are handed out using a single atomic counter, so nothing is allocated for
+    each chunk. It's safe to call this from inside a job that is running on the same pool.
+    The body mustn't throw exceptions.
+
+    @returns true if every chunk was processed, or false if the loop was cancelled
+    @see parallelReduce, ParallelForOptions, TaskGroup
+*/
+JUCE_API bool parallelFor (ThreadPool& pool,
+                           Range<int> range,
+                           const std::function<void (Range<int>)>& body,
+                           const ParallelForOptions& options = {});
+
+/**
+    Splits a range of indices into chunks, computes a value for each chunk in parallel,
+    and then combines the values.
+
+    The chunk results are combined in order on the calling thread, starting with
+    initialValue, so the result is the same each time as long as the chunk size is the
+    same. This makes it suitable for floating-point sums, which would otherwise depend on
+    the order in which the threads finished.
+
+    @param pool          the pool whose threads should help with the work
+    @param range         the indices to process
+    @param initialValue  the value to combine with the first chunk's result
+    @param chunkFunction a function that takes a Range<int> and returns the value for that chunk
+    @param combine       a function that takes two values and returns their combination
+    @param options       controls the chunk size and cancellation
+
+    @returns the combined value, or an empty optional if the loop was cancelled
+    @see parallelFor
+*/
+template <typename Value, typename ChunkFunction, typename CombineFunction>
+std::optional<Value> parallelReduce (ThreadPool& pool,
+                                     Range<int> range,
+                                     Value initialValue,
+                                     ChunkFunction&& chunkFunction,
+                                     CombineFunction&& combine,
+                                     const ParallelForOptions& options = {})
+{
+    if (range.isEmpty())
+        return initialValue;
+
+    const auto chunkSize = detail::getParallelForChunkSize (pool, range.getLength(), options);
+    const auto numChunks = (size_t) (((int64) range.getLength() + chunkSize - 1) / chunkSize);
+
+    std::vector<Value> chunkResults (numChunks, initialValue);
+
+    const auto completed = parallelFor (pool, range, [&] (Range<int> chunk)
+    {
+        const auto index = (size_t) (((int64) chunk.getStart() - range.getStart()) / chunkSize);
+        chunkResults[index] = chunkFunction (chunk);
+    }, options.withChunkSize (chunkSize));
+
+    if (! completed)
+        return {};
+
+    for (auto& result : chunkResults)
+        initialValue = combine (std::move (initialValue), std::move (result));
+
+    return initialValue;
+}
+
+} // namespace juce
@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+
+namespace juce
+{
+
+//==============================================================================
+/*  Everything here is accessed from within the global allocation functions, so it
+    must be usable without allocating, and before any static constructors have run.
+    That's why this is all plain data which is constant-initialised.
+*/
+struct RealtimeSafetyThreadState
+{
+    int depth;
+    int numExemptions;
+    bool isReporting;
+    const char* contextName;
+};
+
+static thread_local RealtimeSafetyThreadState realtimeSafetyThreadState {};
+
+static std::atomic<int> realtimeSafetyAction { (int) RealtimeSafety::Action::count };
+static std::atomic<int64> realtimeSafetyCounts[RealtimeSafety::numViolationTypes] {};
+static std::atomic<int> realtimeSafetyNumReportsClaimed { 0 };
+static std::atomic<bool> realtimeSafetyReportReady[RealtimeSafety::maxReports] {};
+static RealtimeSafety::Report realtimeSafetyReports[RealtimeSafety::maxReports] {};
+
+//==============================================================================
+void RealtimeSafety::setAction (Action newAction) noexcept    { realtimeSafetyAction = (int) newAction; }
+RealtimeSafety::Action RealtimeSafety::getAction() noexcept   { return (Action) realtimeSafetyAction.load(); }
+
+int64 RealtimeSafety::getNumViolations (Violation type) noexcept
+{
+    return realtimeSafetyCounts[(int) type].load();
+}
+
+int64 RealtimeSafety::getTotalNumViolations() noexcept
+{
+    int64 total = 0;
+
+    for (auto& count : realtimeSafetyCounts)
+        total += count.load();
+
+    return total;
+}
+
+std::vector<RealtimeSafety::Report> RealtimeSafety::getReports()
+{
+    std::vector<Report> result;
+    const auto numClaimed = jmin (realtimeSafetyNumReportsClaimed.load(), maxReports);
+
+    for (int i = 0; i < numClaimed; ++i)
+        if (realtimeSafetyReportReady[i].load (std::memory_order_acquire))
+            result.push_back (realtimeSafetyReports[i]);
+
+    return result;
+}
+
+static const char* getViolationName (RealtimeSafety::Violation type) noexcept
+{
+    switch (type)
+    {
+        case RealtimeSafety::Violation::allocation:      return "allocation";
+        case RealtimeSafety::Violation::deallocation:    return "deallocation";
+        case RealtimeSafety::Violation::lockContention:  return "lock contention";
+        case RealtimeSafety::Violation::blockingCall:    return "blocking call";
+    }
+
+    return "";
+}
+
+String RealtimeSafety::getDescription (const Report& report)
+{
+    String result;
+    result << "Realtime safety violation (" << getViolationName (report.violation) << ") in "
+           << report.context << " on thread " << String::toHexString ((pointer_sized_int) report.threadId) << newLine
+           << describeStackFrames (report.frames, report.numFrames);
+
+    return result;
+}
+
+void RealtimeSafety::reset() noexcept
+{
+    for (auto& count : realtimeSafetyCounts)
+        count = 0;
+
+    for (auto& ready : realtimeSafetyReportReady)
+        ready = false;
+
+    realtimeSafetyNumReportsClaimed = 0;
+}
+
+//==============================================================================
+bool RealtimeSafety::isRealtimeContext() noexcept
+{
+    const auto& state = realtimeSafetyThreadState;
+    return state.depth > 0 && state.numExemptions == 0;
+}
+
+void RealtimeSafety::reportViolation (Violation type) noexcept
+{
+    auto& state = realtimeSafetyThreadState;
+
+    // Capturing the stack may itself do something that we'd report, so we need to avoid recursing
+    if (state.isReporting || ! isRealtimeContext())
+        return;
+
+    state.isReporting = true;
+
+    ++realtimeSafetyCounts[(int) type];
+
+    const auto index = realtimeSafetyNumReportsClaimed++;
+
+    if (index < maxReports)
+    {
+        auto& report = realtimeSafetyReports[index];
+        report.violation = type;
+        report.context = state.contextName;
+        report.threadId = Thread::getCurrentThreadId();
+        report.numFrames = captureStackFrames (report.frames, maxStackFrames);
+        realtimeSafetyReportReady[index].store (true, std::memory_order_release);
+    }
+
+    const auto action = getAction();
+
+    if (action == Action::terminate)
+        std::abort();
+
+    if (action == Action::assertion)
+    {
+        // Something unsafe happened on a realtime thread! Have a look at the call stack
+        // to find out what it was.
+        jassertfalse;
+    }
+
+    state.isReporting = false;
+}
+
+//==============================================================================
+RealtimeSafety::ScopedRealtimeContext::ScopedRealtimeContext (const char* name) noexcept
+    : previousName (realtimeSafetyThreadState.contextName)
+{
+    ++realtimeSafetyThreadState.depth;
+    realtimeSafetyThreadState.contextName = name;
+}
+
+RealtimeSafety::ScopedRealtimeContext::~ScopedRealtimeContext() noexcept
+{
+    realtimeSafetyThreadState.contextName = previousName;
+    --realtimeSafetyThreadState.depth;
+}
+
+RealtimeSafety::ScopedExemption::ScopedExemption() noexcept    { ++realtimeSafetyThreadState.numExemptions; }
+RealtimeSafety::ScopedExemption::~ScopedExemption() noexcept   { --realtimeSafetyThreadState.numExemptions; }
+
+} // namespace juce
+
+#endif
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_ENABLE_REALTIME_SAFETY_CHECKS || DOXYGEN
+
+//==============================================================================
+/**
+    Detects operations which shouldn't happen on a realtime thread, such as heap
+    allocations, waiting for a lock, or making a blocking call.
+
+    A thread counts as realtime for as long as a ScopedRealtimeContext exists on it.
+    JUCE creates one around the audio callbacks made by AudioDeviceManager, the
+    processBlock() calls made by AudioProcessorPlayer, and each node rendered by an
+    AudioProcessorGraph, so usually all you need to do is enable
+    JUCE_ENABLE_REALTIME_SAFETY_CHECKS, choose an Action, and look at the results
+    at the end of a run. You can also use JUCE_SCOPED_REALTIME_CONTEXT to mark your
+    own realtime code.
+
+    The following are detected:
+    - calls to the global operator new and delete. This also needs
+      JUCE_ENABLE_ALLOCATION_HOOKS to be enabled, as that's what replaces them.
+    - a CriticalSection or SpinLock which can't be acquired immediately, because
+      another thread is holding it.
+    - WaitableEvent::wait(), Thread::sleep(), and reading, writing or flushing a
+      FileInputStream or FileOutputStream.
+
+    Code that uses std::mutex or makes system calls directly won't be noticed.
+
+    Each violation is counted, and the first maxReports violations are also stored
+    with the call stack that caused them. Recording a violation doesn't allocate or
+    lock, so it's safe to leave this enabled for long soak tests.
+
+    @tags{Core}
+*/
+class JUCE_API RealtimeSafety
+{
+public:
+    //==============================================================================
+    /** The different kinds of unsafe operation. */
+    enum class Violation
+    {
+        allocation,
+        deallocation,
+        lockContention,
+        blockingCall
+    };
+
+    static constexpr int numViolationTypes = 4;
+
+    /** What should happen when a violation is detected. */
+    enum class Action
+    {
+        count,      /**< Record the violation and carry on. This is the default. */
+        assertion,  /**< Record the violation and trigger a jassertfalse. */
+        terminate   /**< Record the violation and abort, so that a crash report is generated. */
+    };
+
+    /** Sets the action to take when a violation is detected. */
+    static void setAction (Action newAction) noexcept;
+
+    /** Returns the action taken when a violation is detected. */
+    static Action getAction() noexcept;
+
+    //==============================================================================
+    static constexpr int maxStackFrames = 32;
+    static constexpr int maxReports = 256;
+
+    /** A record of a single violation. */
+    struct Report
+    {
+        Violation violation;
+
+        /** The name passed to the innermost ScopedRealtimeContext. */
+        const char* context;
+
+        Thread::ThreadID threadId;
+
+        int numFrames;
+        void* frames[maxStackFrames];
+    };
+
+    /** Returns the number of violations of a given type since the last reset(). */
+    static int64 getNumViolations (Violation type) noexcept;
+
+    /** Returns the number of violations of all types since the last reset(). */
+    static int64 getTotalNumViolations() noexcept;
+
+    /** Returns the violations which have been stored since the last reset().
+        This allocates, so don't call it on a realtime thread!
+    */
+    static std::vector<Report> getReports();
+
+    /** Returns a readable description of a report, including its symbolicated call stack. */
+    static String getDescription (const Report& report);
+
+    /** Clears all the counters and stored reports.
+        This mustn't be called while any realtime threads might be reporting violations.
+    */
+    static void reset() noexcept;
+
+    //==============================================================================
+    /** Returns true if the calling thread is currently inside a ScopedRealtimeContext,
+        and not inside a ScopedExemption.
+    */
+    static bool isRealtimeContext() noexcept;
+
+    /** Records a violation if the calling thread is in a realtime context.
+        This is called by the JUCE functions that are checked, but you can also call it
+        from your own code to flag other unsafe operations.
+    */
+    static void reportViolation (Violation type) noexcept;
+
+    //==============================================================================
+    /** Marks the calling thread as realtime for the lifetime of this object.
+        Contexts can be nested, in which case reports are labelled with the innermost name.
+    */
+    class JUCE_API ScopedRealtimeContext
+    {
+    public:
+        /** The name must be a string literal, or otherwise outlive any reports. */
+        explicit ScopedRealtimeContext (const char* name) noexcept;
+        ~ScopedRealtimeContext() noexcept;
+
+    private:
+        const char* previousName;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeContext)
+    };
+
+    /** Suspends violation checking on the calling thread for the lifetime of this object.
+        This is for code that is known to be unsafe, but is acceptable for now, so that it
+        doesn't hide other problems.
+    */
+    class JUCE_API ScopedExemption
+    {
+    public:
+        ScopedExemption() noexcept;
+        ~ScopedExemption() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedExemption)
+    };
+
+private:
+    RealtimeSafety() = delete;
+};
+
+/** Marks the rest of the enclosing scope as realtime.
+    When JUCE_ENABLE_REALTIME_SAFETY_CHECKS is disabled, this does nothing.
+    @see RealtimeSafety
+*/
+#define JUCE_SCOPED_REALTIME_CONTEXT(name) \
+    const juce::RealtimeSafety::ScopedRealtimeContext JUCE_JOIN_MACRO (realtimeContext, __LINE__) (name);
+
+/** Records a RealtimeSafety::Violation if the calling thread is in a realtime context.
+    When JUCE_ENABLE_REALTIME_SAFETY_CHECKS is disabled, this does nothing.
+    @see RealtimeSafety
+*/
+#define JUCE_REPORT_REALTIME_VIOLATION(type) \
+    juce::RealtimeSafety::reportViolation (juce::RealtimeSafety::Violation::type);
+
+#else
+
+#define JUCE_SCOPED_REALTIME_CONTEXT(name)
+#define JUCE_REPORT_REALTIME_VIOLATION(type)
+
+#endif
+
+} // namespace juce
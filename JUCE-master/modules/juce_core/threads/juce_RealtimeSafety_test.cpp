@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+
+namespace juce
+{
+
+class RealtimeSafetyTests final : public UnitTest
+{
+public:
+    RealtimeSafetyTests()
+        : UnitTest ("RealtimeSafety", UnitTestCategories::threads) {}
+
+    void runTest() final
+    {
+        const auto previousAction = RealtimeSafety::getAction();
+        RealtimeSafety::setAction (RealtimeSafety::Action::count);
+
+        beginTest ("Only threads inside a realtime context are checked");
+        {
+            RealtimeSafety::reset();
+            expect (! RealtimeSafety::isRealtimeContext());
+
+            Thread::sleep (0);
+            expectEquals (RealtimeSafety::getTotalNumViolations(), (int64) 0);
+
+            {
+                JUCE_SCOPED_REALTIME_CONTEXT ("test")
+                Thread::sleep (0);
+            }
+
+            expectEquals (RealtimeSafety::getNumViolations (RealtimeSafety::Violation::blockingCall), (int64) 1);
+            expect (! RealtimeSafety::isRealtimeContext());
+        }
+
+        beginTest ("Reports are labelled with the innermost context");
+        {
+            RealtimeSafety::reset();
+
+            {
+                JUCE_SCOPED_REALTIME_CONTEXT ("outer")
+
+                {
+                    JUCE_SCOPED_REALTIME_CONTEXT ("inner")
+                    JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+                }
+
+                JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+            }
+
+            const auto reports = RealtimeSafety::getReports();
+            expectEquals ((int) reports.size(), 2);
+
+            if (reports.size() == 2)
+            {
+                expectEquals (String (reports[0].context), String ("inner"));
+                expectEquals (String (reports[1].context), String ("outer"));
+                expect (reports[0].threadId == Thread::getCurrentThreadId());
+            }
+        }
+
+        beginTest ("Exemptions suppress reporting");
+        {
+            RealtimeSafety::reset();
+
+            {
+                JUCE_SCOPED_REALTIME_CONTEXT ("test")
+                const RealtimeSafety::ScopedExemption exemption;
+                JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+            }
+
+            expectEquals (RealtimeSafety::getTotalNumViolations(), (int64) 0);
+        }
+
+        beginTest ("Only contended locks are reported");
+        {
+            RealtimeSafety::reset();
+            CriticalSection lock;
+
+            {
+                JUCE_SCOPED_REALTIME_CONTEXT ("test")
+                const ScopedLock sl (lock);
+            }
+
+            expectEquals (RealtimeSafety::getTotalNumViolations(), (int64) 0);
+
+            WaitableEvent locked;
+
+            std::thread holder ([&]
+            {
+                const ScopedLock sl (lock);
+                locked.signal();
+                Thread::sleep (100);
+            });
+
+            locked.wait();
+
+            {
+                JUCE_SCOPED_REALTIME_CONTEXT ("test")
+                const ScopedLock sl (lock);
+            }
+
+            holder.join();
+            expectEquals (RealtimeSafety::getNumViolations (RealtimeSafety::Violation::lockContention), (int64) 1);
+        }
+
+       #if JUCE_ENABLE_ALLOCATION_HOOKS
+        beginTest ("Allocations are reported");
+        {
+            RealtimeSafety::reset();
+
+            {
+                JUCE_SCOPED_REALTIME_CONTEXT ("test")
+                int* volatile allocated = new int();
+                delete allocated;
+            }
+
+            expectEquals (RealtimeSafety::getNumViolations (RealtimeSafety::Violation::allocation), (int64) 1);
+            expectEquals (RealtimeSafety::getNumViolations (RealtimeSafety::Violation::deallocation), (int64) 1);
+        }
+       #endif
+
+        RealtimeSafety::reset();
+        RealtimeSafety::setAction (previousAction);
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
+
+} // namespace juce
+
+#endif
@@ -35,6 +35,38 @@
 namespace juce
 {
 
+#ifndef DOXYGEN
+namespace detail
+{
+    // Pauses the CPU for a short time, using an instruction that tells it that the
+    // thread is spinning (such as pause on Intel or yield on ARM).
+    JUCE_API void JUCE_CALLTYPE pauseCpu (int numTimes) noexcept;
+
+    // Keeps trying to acquire a contended lock for a few microseconds, pausing for
+    // exponentially longer between attempts, and returns true if it succeeds. This is
+    // used before blocking, as locks are usually held for less time than it takes to
+    // put a thread to sleep and wake it up again.
+    template <typename TryLock>
+    bool spinBeforeBlocking (TryLock&& tryLock) noexcept
+    {
+        for (auto numPauses = 1; numPauses <= 128; numPauses *= 2)
+        {
+            pauseCpu (numPauses);
+
+            if (tryLock())
+                return true;
+        }
+
+        return false;
+    }
+
+   #if JUCE_ENABLE_LOCK_PROFILING
+    // Called by the locks after each acquisition when JUCE_ENABLE_LOCK_PROFILING is enabled
+    JUCE_API void JUCE_CALLTYPE lockAcquired (const void* lock, bool wasContended, int64 waitStartTicks) noexcept;
+   #endif
+}
+#endif
+
 //==============================================================================
 /**
     A simple spin-lock class that can be used as a simple, low-overhead mutex for
@@ -46,6 +78,11 @@ namespace juce
     It's most appropriate for simple situations where you're only going to hold the
     lock for a very brief time.
 
+    If the lock is held by another thread, enter() spins for a few microseconds,
+    backing off exponentially between attempts. If the lock still hasn't been released
+    by then, the thread sleeps until it is, using a futex on Linux and Android and
+    WaitOnAddress on Windows. On other platforms, it yields until the lock is free.
+
     @see CriticalSection
 
     @tags{Core}
@@ -70,14 +107,24 @@ public:
     /** Attempts to acquire the lock, returning true if this was successful. */
     inline bool tryEnter() const noexcept
     {
-        return lock.compareAndSetBool (1, 0);
+       #if JUCE_ENABLE_LOCK_PROFILING
+        if (! tryAcquire())
+            return false;
+
+        detail::lockAcquired (this, false, 0);
+        return true;
+       #else
+        return tryAcquire();
+       #endif
     }
 
     /** Releases the lock. */
     inline void exit() const noexcept
     {
-        jassert (lock.get() == 1); // Agh! Releasing a lock that isn't currently held!
-        lock = 0;
+        jassert (lock.get() != unlocked); // Agh! Releasing a lock that isn't currently held!
+
+        if (lock.value.exchange (unlocked, std::memory_order_release) == lockedWithWaiters)
+            wakeWaiter();
     }
 
     //==============================================================================
@@ -92,6 +139,15 @@ public:
 
 private:
     //==============================================================================
+    enum : int { unlocked, locked, lockedWithWaiters };
+
+    inline bool tryAcquire() const noexcept
+    {
+        return lock.compareAndSetBool (locked, unlocked);
+    }
+
+    void wakeWaiter() const noexcept;
+
     mutable Atomic<int> lock;
 
     JUCE_DECLARE_NON_COPYABLE (SpinLock)
@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  The state is shared with the jobs that have been added to the pool, so that any jobs that
+    are still waiting when the group is destroyed can safely do nothing.
+*/
+struct TaskGroup::State
+{
+    /*  Runs the next task in the queue and returns true, or returns false if it was empty. */
+    bool runNextTask()
+    {
+        std::function<void()> task;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (tasks.empty())
+                return false;
+
+            task = std::move (tasks.front());
+            tasks.pop_front();
+        }
+
+        if (! cancelled)
+            task();
+
+        if (--numUnfinished == 0)
+            finished.signal();
+
+        return true;
+    }
+
+    CriticalSection lock;
+    std::deque<std::function<void()>> tasks;
+    std::atomic<int> numUnfinished { 0 };
+    std::atomic<bool> cancelled { false };
+    WaitableEvent finished;
+};
+
+//==============================================================================
+TaskGroup::TaskGroup (ThreadPool& p)
+    : pool (p), state (std::make_shared<State>())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void TaskGroup::run (std::function<void()> task)
+{
+    jassert (task != nullptr);
+
+    ++state->numUnfinished;
+
+    {
+        const ScopedLock sl (state->lock);
+        state->tasks.push_back (std::move (task));
+    }
+
+    pool.addJob ([s = state] { s->runNextTask(); });
+}
+
+void TaskGroup::wait()
+{
+    while (state->runNextTask())
+    {}
+
+    while (state->numUnfinished > 0)
+        state->finished.wait();
+}
+
+void TaskGroup::cancel() noexcept
+{
+    state->cancelled = true;
+}
+
+bool TaskGroup::isCancelled() const noexcept
+{
+    return state->cancelled;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TaskGroupTests final : public UnitTest
+{
+public:
+    TaskGroupTests()
+        : UnitTest ("TaskGroup", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("All tasks have finished when wait returns");
+        {
+            ThreadPool pool (3);
+            TaskGroup group (pool);
+            std::array<std::atomic<int>, 100> results{};
+
+            for (size_t i = 0; i < results.size(); ++i)
+                group.run ([&results, i] { results[i] = (int) i * 2; });
+
+            group.wait();
+
+            for (size_t i = 0; i < results.size(); ++i)
+                expectEquals (results[i].load(), (int) i * 2);
+        }
+
+        beginTest ("Groups can be waited for from inside a job on the same pool");
+        {
+            ThreadPool pool (1);
+            std::atomic<int> counter { 0 };
+
+            auto outer = pool.addJobWithFuture ([&]
+            {
+                TaskGroup group (pool);
+
+                for (auto i = 0; i < 10; ++i)
+                    group.run ([&] { ++counter; });
+
+                group.wait();
+                return counter.load();
+            });
+
+            expectEquals (outer.get(), 10);
+        }
+
+        beginTest ("Cancelled tasks aren't run");
+        {
+            ThreadPool pool (1);
+            WaitableEvent blockerStarted, releaseBlocker;
+            pool.addJob ([&] { blockerStarted.signal(); releaseBlocker.wait(); });
+            expect (blockerStarted.wait (5000));
+
+            std::atomic<int> counter { 0 };
+            TaskGroup group (pool);
+
+            for (auto i = 0; i < 10; ++i)
+                group.run ([&] { ++counter; });
+
+            group.cancel();
+            expect (group.isCancelled());
+            releaseBlocker.signal();
+            group.wait();
+
+            expectEquals (counter.load(), 0);
+        }
+    }
+};
+
+static TaskGroupTests taskGroupTests;
+
+#endif
+
+} // namespace juce
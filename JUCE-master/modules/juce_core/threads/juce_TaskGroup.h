@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A set of tasks that are run on a ThreadPool, and which can be waited for as a group.
+
+    Use run() to add tasks to the group, and then call wait() to block until they have
+    all finished. While it's waiting, the calling thread will also run any of the group's
+    tasks that haven't been started by the pool yet, so a TaskGroup can safely be used
+    from inside a job that is itself running on the same pool.
+
+    @code
+    TaskGroup group (pool);
+
+    for (auto& file : files)
+        group.run ([&file] { analyse (file); });
+
+    group.wait();
+    @endcode
+
+    The tasks mustn't throw exceptions.
+
+    @see parallelFor, ThreadPool
+
+    @tags{Core}
+*/
+class JUCE_API  TaskGroup
+{
+public:
+    //==============================================================================
+    /** Creates an empty group that will run its tasks on the given pool.
+        The pool must outlive the TaskGroup.
+    */
+    explicit TaskGroup (ThreadPool& pool);
+
+    /** Destructor. This will call wait(). */
+    ~TaskGroup();
+
+    //==============================================================================
+    /** Adds a task to the group.
+        The task will be run by the next free thread in the pool, or by the thread that
+        calls wait(), whichever gets to it first.
+    */
+    void run (std::function<void()> task);
+
+    /** Blocks until all of the tasks that have been added to the group have finished.
+        The calling thread runs any tasks that haven't been started yet.
+    */
+    void wait();
+
+    /** Stops any tasks that haven't been started from being run.
+        Tasks that are already running will be allowed to finish, and you can check
+        isCancelled() from inside a long task to find out when you should return early.
+        Once a group has been cancelled, none of the tasks subsequently added will run.
+    */
+    void cancel() noexcept;
+
+    /** Returns true if cancel() has been called. */
+    bool isCancelled() const noexcept;
+
+private:
+    //==============================================================================
+    struct State;
+
+    ThreadPool& pool;
+    std::shared_ptr<State> state;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TaskGroup)
+};
+
+} // namespace juce
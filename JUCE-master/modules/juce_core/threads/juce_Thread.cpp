@@ -102,8 +102,12 @@ void Thread::threadEntryPoint()
     {
         jassert (getCurrentThreadId() == threadId);
 
-        if (affinityMask != 0)
-            setCurrentThreadAffinityMask (affinityMask);
+        const auto cpus = realtimeOptions.has_value() && ! realtimeOptions->getAffinity().isZero()
+                            ? realtimeOptions->getAffinity()
+                            : affinity;
+
+        if (! cpus.isZero())
+            setCurrentThreadAffinity (cpus);
 
         try
         {
@@ -293,7 +297,12 @@ bool Thread::isRealtime() const
 
 void Thread::setAffinityMask (const uint32 newAffinityMask)
 {
-    affinityMask = newAffinityMask;
+    affinity = BigInteger (newAffinityMask);
+}
+
+void Thread::setAffinity (const BigInteger& cpus)
+{
+    affinity = cpus;
 }
 
 //==============================================================================
@@ -343,17 +352,63 @@ bool Thread::launch (Priority priority, std::function<void()> functionToRun)
 }
 
 //==============================================================================
-void SpinLock::enter() const noexcept
+void JUCE_CALLTYPE detail::pauseCpu (int numTimes) noexcept
 {
-    if (! tryEnter())
+    for (int i = 0; i < numTimes; ++i)
     {
-        for (int i = 20; --i >= 0;)
-            if (tryEnter())
-                return;
+       #if JUCE_CORE_USE_SSE2
+        _mm_pause();
+       #elif JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+        __builtin_ia32_pause();
+       #elif JUCE_ARM && JUCE_MSVC
+        __yield();
+       #elif JUCE_ARM && (JUCE_GCC || JUCE_CLANG)
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+}
+
+void SpinLock::enter() const noexcept
+{
+    if (tryEnter())
+        return;
+
+    JUCE_REPORT_REALTIME_VIOLATION (lockContention)
+
+   #if JUCE_ENABLE_LOCK_PROFILING
+    const auto waitStartTicks = Time::getHighResolutionTicks();
+   #endif
 
-        while (! tryEnter())
+    if (! detail::spinBeforeBlocking ([this] { return tryAcquire(); }))
+    {
+        // Setting the state to lockedWithWaiters tells exit() that it needs to wake
+        // someone up. Whoever is woken will set it again, so that any other waiters
+        // are woken in turn.
+        while (lock.value.exchange (lockedWithWaiters, std::memory_order_acquire) != unlocked)
+        {
+           #if JUCE_LINUX || JUCE_ANDROID
+            syscall (SYS_futex, reinterpret_cast<int*> (&lock.value), FUTEX_WAIT_PRIVATE, (int) lockedWithWaiters, nullptr, nullptr, 0);
+           #elif JUCE_WINDOWS
+            auto expected = (int) lockedWithWaiters;
+            WaitOnAddress (&lock.value, &expected, sizeof (expected), INFINITE);
+           #else
             Thread::yield();
+           #endif
+        }
     }
+
+   #if JUCE_ENABLE_LOCK_PROFILING
+    detail::lockAcquired (this, true, waitStartTicks);
+   #endif
+}
+
+void SpinLock::wakeWaiter() const noexcept
+{
+   #if JUCE_LINUX || JUCE_ANDROID
+    syscall (SYS_futex, reinterpret_cast<int*> (&lock.value), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+   #elif JUCE_WINDOWS
+    WakeByAddressSingle (&lock.value);
+   #endif
 }
 
 //==============================================================================
@@ -546,6 +601,85 @@ private:
 
 ThreadLocalValueUnitTest threadLocalValueUnitTest;
 
+//==============================================================================
+class LockUnitTests final : public UnitTest
+{
+public:
+    LockUnitTests()
+        : UnitTest ("Locks", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("SpinLock gives mutual exclusion under contention");
+        testMutualExclusion<SpinLock>();
+
+        beginTest ("CriticalSection gives mutual exclusion under contention");
+        testMutualExclusion<CriticalSection>();
+
+        beginTest ("A thread waiting for a SpinLock wakes up when it is released");
+        {
+            SpinLock lock;
+            std::atomic<bool> acquired { false };
+
+            lock.enter();
+
+            std::thread waiter ([&]
+            {
+                const SpinLock::ScopedLockType sl (lock);
+                acquired = true;
+            });
+
+            // Long enough for the waiter to stop spinning and go to sleep
+            Thread::sleep (20);
+            expect (! acquired);
+
+            lock.exit();
+            waiter.join();
+
+            expect (acquired);
+            expect (lock.tryEnter());
+            lock.exit();
+        }
+    }
+
+private:
+    template <typename LockType>
+    void testMutualExclusion()
+    {
+        constexpr int numThreads = 4, numIterations = 2000;
+
+        LockType lock;
+        int counter = 0;
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back ([&]
+            {
+                for (int i = 0; i < numIterations; ++i)
+                {
+                    const typename LockType::ScopedLockType sl (lock);
+                    const auto value = counter;
+
+                    // Giving up the CPU while holding the lock makes the other threads wait for it
+                    if (i % 64 == 0)
+                        std::this_thread::yield();
+
+                    counter = value + 1;
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        expectEquals (counter, numThreads * numIterations);
+    }
+};
+
+static LockUnitTests lockUnitTests;
+
 #endif
 
 } // namespace juce
@@ -170,6 +170,24 @@ public:
             return withPeriodMs (1'000.0 / newPeriodHz);
         }
 
+        /** Specify the set of logical CPUs that the thread may run on, where bit n
+            of the set corresponds to the CPU with index n.
+
+            This takes precedence over any mask passed to setAffinityMask(). Use
+            SystemStats::getCpuTopology() to find out which CPUs are which.
+
+            Only used by Windows, Linux and Android. On Windows, a thread can only
+            run within a single processor group, so only the CPUs that share a group
+            with the lowest one in the set are used.
+
+            @see getAffinity, Thread::setAffinity
+        */
+        [[nodiscard]] RealtimeOptions withAffinity (const BigInteger& newAffinity) const
+        {
+            jassert (! newAffinity.isZero());
+            return withMember (*this, &RealtimeOptions::affinity, newAffinity);
+        }
+
         /** Returns a value with a range of 0-10, where 10 is the highest priority.
 
             @see withPriority
@@ -209,11 +227,22 @@ public:
             return periodMs;
         }
 
+        /** Returns the set of logical CPUs that the thread may run on, or an empty
+            set if it may run on any of them.
+
+            @see withAffinity
+        */
+        [[nodiscard]] BigInteger getAffinity() const
+        {
+            return affinity;
+        }
+
     private:
         int priority { 5 };
         std::optional<double> processingTimeMs;
         std::optional<double> maximumProcessingTimeMs;
         std::optional<double> periodMs{};
+        BigInteger affinity;
     };
 
     //==============================================================================
@@ -438,6 +467,18 @@ public:
     */
     void setAffinityMask (uint32 affinityMask);
 
+    /** Sets the set of logical CPUs that the thread may run on, where bit n of the
+        set corresponds to the CPU with index n. Unlike setAffinityMask(), this can
+        refer to more than 32 CPUs.
+
+        This will only have an effect next time the thread is started - i.e. if the
+        thread is already running when called, it'll have no effect. An empty set lets
+        the thread run on any CPU.
+
+        @see setCurrentThreadAffinity, RealtimeOptions::withAffinity, SystemStats::getCpuTopology
+    */
+    void setAffinity (const BigInteger& cpus);
+
     /** Changes the affinity mask for the caller thread.
 
         This will change the affinity mask for the thread that calls this static method.
@@ -446,6 +487,18 @@ public:
     */
     static void JUCE_CALLTYPE setCurrentThreadAffinityMask (uint32 affinityMask);
 
+    /** Restricts the calling thread to the given set of logical CPUs, where bit n of
+        the set corresponds to the CPU with index n.
+
+        On Windows, a thread can only run within a single processor group, so only the
+        CPUs that share a group with the lowest one in the set are used.
+
+        @returns true if the affinity was changed, or false if the set was empty, or
+                 the platform doesn't support setting thread affinities (e.g. macOS).
+        @see setAffinity
+    */
+    static bool JUCE_CALLTYPE setCurrentThreadAffinity (const BigInteger& cpus);
+
     //==============================================================================
     /** Suspends the execution of the current thread until the specified timeout period
         has elapsed (note that this may not be exact).
@@ -599,7 +652,7 @@ private:
     CriticalSection startStopLock;
     WaitableEvent startSuspensionEvent, defaultEvent;
     size_t threadStackSize;
-    uint32 affinityMask = 0;
+    BigInteger affinity;
     bool deleteOnThreadEnd = false;
     std::atomic<bool> shouldExit { false };
     ThreadSafeListenerList<Listener> listeners;
@@ -114,6 +114,29 @@ ThreadPool::ThreadPool (const Options& options)
     for (int i = jmax (1, options.numberOfThreads); --i >= 0;)
         threads.add (new ThreadPoolThread (*this, options));
 
+    if (! options.threadAffinity.isZero())
+    {
+        auto cpu = options.threadAffinity.findNextSetBit (0);
+
+        for (auto* t : threads)
+        {
+            if (! options.pinEachThreadToOneCpu)
+            {
+                t->setAffinity (options.threadAffinity);
+                continue;
+            }
+
+            BigInteger single;
+            single.setBit (cpu);
+            t->setAffinity (single);
+
+            cpu = options.threadAffinity.findNextSetBit (cpu + 1);
+
+            if (cpu < 0)
+                cpu = options.threadAffinity.findNextSetBit (0);
+        }
+    }
+
     for (auto* t : threads)
         t->startThread (options.desiredThreadPriority);
 }
@@ -144,24 +167,56 @@ void ThreadPool::stopThreads()
 
 void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
 {
-    jassert (job != nullptr);
-    jassert (job->pool == nullptr);
+    addJob (job, deleteJobWhenFinished, 0);
+}
+
+void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished, int priority)
+{
+    addJobs ({ &job, 1 }, deleteJobWhenFinished, priority);
+}
+
+void ThreadPool::addJobs (Span<ThreadPoolJob* const> jobsToAdd, bool deleteJobsWhenFinished, int priority)
+{
+    auto numAdded = 0;
 
-    if (job->pool == nullptr)
     {
-        job->pool = this;
-        job->shouldStop = false;
-        job->isActive = false;
-        job->shouldBeDeleted = deleteJobWhenFinished;
+        const ScopedLock sl (lock);
+        jobs.ensureStorageAllocated (jobs.size() + (int) jobsToAdd.size());
 
+        for (auto* job : jobsToAdd)
         {
-            const ScopedLock sl (lock);
-            jobs.add (job);
+            jassert (job != nullptr);
+            jassert (job->pool == nullptr);
+
+            if (job != nullptr && job->pool == nullptr)
+            {
+                job->pool = this;
+                job->shouldStop = false;
+                job->isActive = false;
+                job->shouldBeDeleted = deleteJobsWhenFinished;
+                job->priority = priority;
+
+                insertJob (job);
+                ++numAdded;
+            }
         }
+    }
 
+    if (numAdded > 0)
         for (auto* t : threads)
             t->notify();
-    }
+}
+
+void ThreadPool::insertJob (ThreadPoolJob* job)
+{
+    // Keep the queue sorted by priority, with new jobs going after the others in their band.
+    // Most jobs share the same priority, so it's quickest to search from the end.
+    auto index = jobs.size();
+
+    while (index > 0 && jobs.getUnchecked (index - 1)->priority < job->priority)
+        --index;
+
+    jobs.insert (index, job);
 }
 
 void ThreadPool::addJob (std::function<ThreadPoolJob::JobStatus()> jobToRun)
@@ -178,6 +233,11 @@ void ThreadPool::addJob (std::function<ThreadPoolJob::JobStatus()> jobToRun)
 }
 
 void ThreadPool::addJob (std::function<void()> jobToRun)
+{
+    addLambdaJob (std::move (jobToRun), 0);
+}
+
+void ThreadPool::addLambdaJob (std::function<void()> jobToRun, int priority)
 {
     struct LambdaJobWrapper final : public ThreadPoolJob
     {
@@ -187,7 +247,7 @@ void ThreadPool::addJob (std::function<void()> jobToRun)
         std::function<void()> job;
     };
 
-    addJob (new LambdaJobWrapper (std::move (jobToRun)), true);
+    addJob (new LambdaJobWrapper (std::move (jobToRun)), true, priority);
 }
 
 int ThreadPool::getNumJobs() const noexcept
@@ -346,30 +406,26 @@ StringArray ThreadPool::getNamesOfAllJobs (bool onlyReturnActiveJobs) const
     return s;
 }
 
-ThreadPoolJob* ThreadPool::pickNextJobToRun()
+ThreadPoolJob* ThreadPool::pickNextJobToRun (OwnedArray<ThreadPoolJob>& deletionList)
 {
-    OwnedArray<ThreadPoolJob> deletionList;
+    // the lock must be held when calling this
 
+    for (int i = 0; i < jobs.size(); ++i)
     {
-        const ScopedLock sl (lock);
-
-        for (int i = 0; i < jobs.size(); ++i)
+        if (auto* job = jobs[i])
         {
-            if (auto* job = jobs[i])
+            if (! job->isActive)
             {
-                if (! job->isActive)
+                if (job->shouldStop)
                 {
-                    if (job->shouldStop)
-                    {
-                        jobs.remove (i);
-                        addToDeleteList (deletionList, job);
-                        --i;
-                        continue;
-                    }
-
-                    job->isActive = true;
-                    return job;
+                    jobs.remove (i);
+                    addToDeleteList (deletionList, job);
+                    --i;
+                    continue;
                 }
+
+                job->isActive = true;
+                return job;
             }
         }
     }
@@ -379,7 +435,17 @@ ThreadPoolJob* ThreadPool::pickNextJobToRun()
 
 bool ThreadPool::runNextJob (ThreadPoolThread& thread)
 {
-    if (auto* job = pickNextJobToRun())
+    auto* job = [&]
+    {
+        OwnedArray<ThreadPoolJob> deletionList;
+        const ScopedLock sl (lock);
+        return pickNextJobToRun (deletionList);
+    }();
+
+    if (job == nullptr)
+        return false;
+
+    while (job != nullptr)
     {
         auto result = ThreadPoolJob::jobHasFinished;
         thread.currentJob = job;
@@ -396,33 +462,33 @@ bool ThreadPool::runNextJob (ThreadPoolThread& thread)
         thread.currentJob = nullptr;
 
         OwnedArray<ThreadPoolJob> deletionList;
+        const ScopedLock sl (lock);
 
+        const auto index = jobs.indexOf (job);
+
+        if (index >= 0)
         {
-            const ScopedLock sl (lock);
+            job->isActive = false;
+            jobs.remove (index);
 
-            if (jobs.contains (job))
+            if (result != ThreadPoolJob::jobNeedsRunningAgain || job->shouldStop)
             {
-                job->isActive = false;
-
-                if (result != ThreadPoolJob::jobNeedsRunningAgain || job->shouldStop)
-                {
-                    jobs.removeFirstMatchingValue (job);
-                    addToDeleteList (deletionList, job);
-
-                    jobFinishedSignal.signal();
-                }
-                else
-                {
-                    // move the job to the end of the queue if it wants another go
-                    jobs.move (jobs.indexOf (job), -1);
-                }
+                addToDeleteList (deletionList, job);
+                jobFinishedSignal.signal();
+            }
+            else
+            {
+                // move the job to the end of its priority band if it wants another go
+                insertJob (job);
             }
         }
 
-        return true;
+        // Picking the next job while the lock is still held means that each job only needs
+        // to take the lock once, which matters when there are lots of very short jobs
+        job = thread.threadShouldExit() ? nullptr : pickNextJobToRun (deletionList);
     }
 
-    return false;
+    return true;
 }
 
 void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, ThreadPoolJob* job) const
@@ -434,4 +500,86 @@ void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, Threa
         deletionList.add (job);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ThreadPoolTests final : public UnitTest
+{
+public:
+    ThreadPoolTests()
+        : UnitTest ("ThreadPool", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Futures hold the results of their jobs");
+        {
+            ThreadPool pool (2);
+
+            auto value = pool.addJobWithFuture ([] { return 42; });
+            auto failure = pool.addJobWithFuture ([]() -> int { throw std::runtime_error ("failed"); });
+
+            expectEquals (value.get(), 42);
+            expectThrowsType (failure.get(), std::runtime_error);
+        }
+
+        beginTest ("Jobs with a higher priority are started first");
+        {
+            ThreadPool pool (1);
+            WaitableEvent blockerStarted, releaseBlocker;
+
+            pool.addJob ([&] { blockerStarted.signal(); releaseBlocker.wait(); });
+            expect (blockerStarted.wait (5000));
+
+            std::vector<int> order;
+            std::vector<std::future<void>> results;
+
+            for (const auto priority : { 0, 1, -1, 2, 1 })
+                results.push_back (pool.addJobWithFuture ([&order, priority] { order.push_back (priority); }, priority));
+
+            releaseBlocker.signal();
+
+            for (auto& r : results)
+                r.get();
+
+            expect (order == std::vector<int> { 2, 1, 1, 0, -1 });
+        }
+
+        beginTest ("Jobs added in bulk are all run");
+        {
+            struct CountingJob final : public ThreadPoolJob
+            {
+                explicit CountingJob (std::atomic<int>& c) : ThreadPoolJob ("counter"), counter (c) {}
+                JobStatus runJob() override  { ++counter; return jobHasFinished; }
+
+                std::atomic<int>& counter;
+            };
+
+            constexpr auto numJobs = 1000;
+
+            ThreadPool pool (4);
+            std::atomic<int> counter { 0 };
+            std::vector<ThreadPoolJob*> jobs;
+
+            for (auto i = 0; i < numJobs; ++i)
+                jobs.push_back (new CountingJob (counter));
+
+            pool.addJobs (jobs, true);
+
+            const auto start = Time::getMillisecondCounter();
+
+            while (pool.getNumJobs() > 0 && Time::getMillisecondCounter() - start < 10000)
+                Thread::sleep (1);
+
+            expectEquals (counter.load(), numJobs);
+            expectEquals (pool.getNumJobs(), 0);
+        }
+    }
+};
+
+static ThreadPoolTests threadPoolTests;
+
+#endif
+
 } // namespace juce
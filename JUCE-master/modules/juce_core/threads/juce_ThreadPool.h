@@ -146,6 +146,7 @@ private:
     friend class ThreadPool;
     String jobName;
     ThreadPool* pool = nullptr;
+    int priority = 0;
     std::atomic<bool> shouldStop { false }, isActive { false }, shouldBeDeleted { false };
     ThreadSafeListenerList<Thread::Listener> listeners;
 
@@ -191,10 +192,27 @@ struct ThreadPoolOptions
         return withMember (*this, &ThreadPoolOptions::desiredThreadPriority, newDesiredThreadPriority);
     }
 
+    /** The set of logical CPUs that the threads in the pool may run on, where bit n of
+        the set corresponds to the CPU with index n. An empty set lets them run anywhere.
+
+        If pinEachThread is true, each thread is restricted to a single CPU from the set,
+        with the threads being given the CPUs in turn. Otherwise, every thread may run on
+        any CPU in the set.
+
+        @see Thread::setAffinity, SystemStats::getCpuTopology
+    */
+    [[nodiscard]] ThreadPoolOptions withThreadAffinity (const BigInteger& cpus, bool pinEachThread = false) const
+    {
+        return withMember (withMember (*this, &ThreadPoolOptions::threadAffinity, cpus),
+                           &ThreadPoolOptions::pinEachThreadToOneCpu, pinEachThread);
+    }
+
     String threadName { "Pool" };
     int numberOfThreads { SystemStats::getNumCpus() };
     size_t threadStackSizeBytes { Thread::osDefaultStackSize };
     Thread::Priority desiredThreadPriority { Thread::Priority::normal };
+    BigInteger threadAffinity;
+    bool pinEachThreadToOneCpu = false;
 };
 
 
@@ -300,6 +318,53 @@ public:
     */
     void addJob (std::function<void()> job);
 
+    /** Adds a job to the queue with a given priority.
+
+        Jobs with a higher priority will be started before any jobs with a lower priority
+        that are still waiting in the queue, and jobs with equal priorities are started in
+        the order that they were added. The other addJob() methods use a priority of zero.
+
+        Apart from its priority, the job will be treated in exactly the same way as by
+        addJob (ThreadPoolJob*, bool).
+    */
+    void addJob (ThreadPoolJob* job,
+                 bool deleteJobWhenFinished,
+                 int priority);
+
+    /** Adds a set of jobs to the queue in one go.
+
+        This has the same effect as calling addJob() for each of the jobs in turn, but
+        only takes the pool's lock once and wakes up the pool's threads once, which makes a
+        big difference when adding a large number of small jobs.
+
+        @see addJob
+    */
+    void addJobs (Span<ThreadPoolJob* const> jobsToAdd,
+                  bool deleteJobsWhenFinished,
+                  int priority = 0);
+
+    /** Adds a function to be called as a job, and returns a std::future that will hold
+        the function's result.
+
+        If the function throws an exception, it will be caught and stored in the future,
+        and rethrown when you call std::future::get().
+
+        Note that you mustn't wait on the future from inside a job running on the same
+        pool unless you're sure that another thread is free to run it.
+
+        @see addJob
+    */
+    template <typename Callable>
+    auto addJobWithFuture (Callable&& callable, int priority = 0)
+    {
+        using ResultType = std::invoke_result_t<std::decay_t<Callable>&>;
+
+        auto task = std::make_shared<std::packaged_task<ResultType()>> (std::forward<Callable> (callable));
+        auto result = task->get_future();
+        addLambdaJob ([task] { (*task)(); }, priority);
+        return result;
+    }
+
     /** Tries to remove a job from the pool.
 
         If the job isn't yet running, this will simply remove it. If it is running, it
@@ -391,7 +456,9 @@ private:
     WaitableEvent jobFinishedSignal;
 
     bool runNextJob (ThreadPoolThread&);
-    ThreadPoolJob* pickNextJobToRun();
+    ThreadPoolJob* pickNextJobToRun (OwnedArray<ThreadPoolJob>&);
+    void insertJob (ThreadPoolJob*);
+    void addLambdaJob (std::function<void()>, int priority);
     void addToDeleteList (OwnedArray<ThreadPoolJob>&, ThreadPoolJob*) const;
     void stopThreads();
 
@@ -42,6 +42,8 @@ WaitableEvent::WaitableEvent (bool manualReset) noexcept
 
 bool WaitableEvent::wait (double timeOutMilliseconds) const
 {
+    JUCE_REPORT_REALTIME_VIOLATION (blockingCall)
+
     std::unique_lock<std::mutex> lock (mutex);
 
     if (! triggered)
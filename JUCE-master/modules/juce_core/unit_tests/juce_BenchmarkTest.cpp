@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+BenchmarkTest::BenchmarkTest (const String& nm, const String& ctg)
+    : UnitTest (nm, ctg)
+{
+}
+
+void BenchmarkTest::measure (const String& benchmarkName, const std::function<void (int64)>& runIterations)
+{
+    // This method's only valid while the test is being run!
+    jassert (runner != nullptr);
+
+    if (! runner->isBenchmarkingEnabled())
+    {
+        runIterations (1);
+        return;
+    }
+
+    const auto timeIterations = [&] (int64 numIterations)
+    {
+        const auto start = Time::getHighResolutionTicks();
+        runIterations (numIterations);
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+    };
+
+    // Warm up, doubling the batch size until a batch takes long enough to time reliably
+    int64 iterationsPerSample = 1;
+    double warmUpSeconds = 0.0;
+
+    for (;;)
+    {
+        const auto seconds = timeIterations (iterationsPerSample);
+        warmUpSeconds += seconds;
+
+        if (seconds >= options.minSecondsPerSample)
+        {
+            if (warmUpSeconds >= options.warmUpSeconds)
+                break;
+        }
+        else
+        {
+            iterationsPerSample *= 2;
+        }
+    }
+
+    std::vector<double> samples;
+    samples.reserve ((size_t) jmax (1, options.numSamples));
+
+    for (int i = 0; i < jmax (1, options.numSamples); ++i)
+        samples.push_back (timeIterations (iterationsPerSample) * 1.0e9 / (double) iterationsPerSample);
+
+    const auto getMedian = [] (std::vector<double> values)
+    {
+        const auto middle = values.begin() + (std::ptrdiff_t) (values.size() / 2);
+        std::nth_element (values.begin(), middle, values.end());
+
+        if (values.size() % 2 != 0)
+            return *middle;
+
+        return (*middle + *std::max_element (values.begin(), middle)) / 2.0;
+    };
+
+    const auto median = getMedian (samples);
+
+    std::vector<double> deviations;
+
+    for (auto s : samples)
+        deviations.push_back (std::abs (s - median));
+
+    // Scaling the median absolute deviation makes it comparable to a standard deviation
+    const auto limit = options.outlierThreshold * 1.4826 * getMedian (deviations);
+
+    std::vector<double> kept;
+
+    for (auto s : samples)
+        if (std::abs (s - median) <= limit)
+            kept.push_back (s);
+
+    const auto n = (double) kept.size();
+    const auto mean = std::accumulate (kept.begin(), kept.end(), 0.0) / n;
+    const auto sumOfSquares = std::accumulate (kept.begin(), kept.end(), 0.0,
+                                               [mean] (double total, double s) { return total + (s - mean) * (s - mean); });
+
+    UnitTestRunner::BenchmarkResult result;
+
+    if (auto* r = runner->results.getLast())
+    {
+        result.unitTestName = r->unitTestName;
+        result.subcategoryName = r->subcategoryName;
+    }
+
+    result.benchmarkName = benchmarkName;
+    result.numSamples = (int) kept.size();
+    result.numOutliers = (int) (samples.size() - kept.size());
+    result.iterationsPerSample = iterationsPerSample;
+    result.medianNanoseconds = median;
+    result.meanNanoseconds = mean;
+    result.standardDeviationNanoseconds = n > 1 ? std::sqrt (sumOfSquares / (n - 1.0)) : 0.0;
+    result.fastestNanoseconds = *std::min_element (kept.begin(), kept.end());
+
+    runner->addBenchmarkResult (result);
+}
+
+#if JUCE_MSVC
+void BenchmarkTest::escape (const volatile void* pointer) noexcept
+{
+    static const volatile void* volatile sink = nullptr;
+    sink = pointer;
+}
+#endif
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class CountingBenchmark final : public BenchmarkTest
+{
+public:
+    CountingBenchmark()
+        : BenchmarkTest ("Counting", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Calls");
+
+        numCalls = 0;
+        benchmark ("Incrementing", [this] { ++numCalls; });
+    }
+
+    int64 numCalls = 0;
+};
+
+static CountingBenchmark countingBenchmark;
+
+class SummingBenchmark final : public BenchmarkTest
+{
+public:
+    SummingBenchmark()
+        : BenchmarkTest ("Summing", UnitTestCategories::benchmarks)
+    {
+        Options o;
+        o.warmUpSeconds = 0.0;
+        o.minSecondsPerSample = 0.0005;
+        o.numSamples = 15;
+        setOptions (o);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Square roots");
+
+        benchmark ("1000 values", []
+        {
+            double total = 0;
+
+            for (int i = 0; i < 1000; ++i)
+                total += std::sqrt ((double) i);
+
+            doNotOptimise (total);
+        });
+    }
+};
+
+static SummingBenchmark summingBenchmark;
+
+class BenchmarkTimingTests final : public UnitTest
+{
+public:
+    BenchmarkTimingTests()
+        : UnitTest ("BenchmarkTest timing", UnitTestCategories::benchmarks)
+    {}
+
+    struct SilentRunner final : public UnitTestRunner
+    {
+        void logMessage (const String&) override {}
+    };
+
+    void runTest() override
+    {
+        beginTest ("Benchmarks are run once when timing is disabled");
+        {
+            SilentRunner silentRunner;
+            silentRunner.runTests ({ &countingBenchmark });
+
+            expectEquals (countingBenchmark.numCalls, (int64) 1);
+            expectEquals (silentRunner.getNumBenchmarkResults(), 0);
+        }
+
+        beginTest ("Results are recorded when timing is enabled");
+        {
+            SilentRunner silentRunner;
+            silentRunner.setBenchmarkingEnabled (true);
+            silentRunner.runTests ({ &summingBenchmark });
+
+            expectEquals (silentRunner.getNumBenchmarkResults(), 1);
+
+            if (auto* r = silentRunner.getBenchmarkResult (0))
+            {
+                expectEquals (r->getKey(), String ("Summing / Square roots / 1000 values"));
+                expectEquals (r->numSamples + r->numOutliers, 15);
+                expectGreaterThan (r->numSamples, 0);
+                expectGreaterThan (r->medianNanoseconds, 0.0);
+                expectLessOrEqual (r->fastestNanoseconds, r->medianNanoseconds);
+                expectGreaterThan ((double) r->iterationsPerSample * r->medianNanoseconds, 0.5e6 * 0.5);
+            }
+        }
+    }
+};
+
+static BenchmarkTimingTests benchmarkTimingTests;
+
+#endif
+
+} // namespace juce
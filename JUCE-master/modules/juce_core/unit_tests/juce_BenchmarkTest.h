@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A UnitTest that measures how long pieces of code take to run.
+
+    A BenchmarkTest is written just like a UnitTest, but in addition to calling
+    expect(), its runTest() method can call benchmark() to time a function:
+
+    @code
+    class StringBenchmarks  : public BenchmarkTest
+    {
+    public:
+        StringBenchmarks()  : BenchmarkTest ("String benchmarks") {}
+
+        void runTest() override
+        {
+            beginTest ("Concatenation");
+
+            benchmark ("Appending", []
+            {
+                String s;
+
+                for (int i = 0; i < 100; ++i)
+                    s << "abc";
+
+                doNotOptimise (s);
+            });
+        }
+    };
+
+    static StringBenchmarks stringBenchmarks;
+    @endcode
+
+    Measurements are only timed when benchmarking has been enabled with
+    UnitTestRunner::setBenchmarkingEnabled(). Otherwise, each function passed to
+    benchmark() is just called once, so that benchmarks are cheap to run
+    alongside the normal tests and still check that the code they exercise works.
+
+    When timing, the function is run repeatedly to warm up caches and to find a
+    number of iterations that takes long enough to time reliably. It's then timed
+    for a number of samples, samples that are further from the median than the
+    outlier threshold are discarded, and the resulting statistics are passed to
+    the runner, where they can be retrieved with UnitTestRunner::getBenchmarkResult().
+
+    @see UnitTest, UnitTestRunner
+
+    @tags{Core}
+*/
+class JUCE_API  BenchmarkTest  : public UnitTest
+{
+public:
+    //==============================================================================
+    /** Creates a benchmark with the given name, placing it in the given category. */
+    explicit BenchmarkTest (const String& name, const String& category = "Benchmarks");
+
+    //==============================================================================
+    /** Controls how measurements are made. */
+    struct Options
+    {
+        /** The minimum time spent running the function before any samples are taken. */
+        double warmUpSeconds = 0.05;
+
+        /** The minimum duration of each sample. The number of iterations in each sample
+            is chosen so that it takes at least this long.
+        */
+        double minSecondsPerSample = 0.002;
+
+        /** The number of samples to take. */
+        int numSamples = 30;
+
+        /** Samples that are further from the median than this many times the median
+            absolute deviation are treated as outliers and discarded.
+        */
+        double outlierThreshold = 3.0;
+    };
+
+    /** Changes the options used by subsequent calls to benchmark(). */
+    void setOptions (const Options& newOptions) noexcept        { options = newOptions; }
+
+    /** Returns the options used to make measurements. */
+    const Options& getOptions() const noexcept                  { return options; }
+
+protected:
+    //==============================================================================
+    /** Measures how long a function takes to run.
+
+        This can only be called from within your runTest() method, after calling
+        beginTest(). The name is appended to the name of the current test to identify
+        the result.
+    */
+    template <typename Function>
+    void benchmark (const String& benchmarkName, Function&& function)
+    {
+        measure (benchmarkName, [&function] (int64 numIterations)
+        {
+            for (int64 i = 0; i < numIterations; ++i)
+                function();
+        });
+    }
+
+    //==============================================================================
+    /** Prevents the compiler from optimising away the computation of a value.
+
+        Pass the results of the code that you're benchmarking to this function,
+        otherwise the compiler may notice that they're never used and skip computing
+        them entirely.
+    */
+    template <typename Type>
+    static void doNotOptimise (Type&& value) noexcept
+    {
+       #if JUCE_MSVC
+        escape (&value);
+        _ReadWriteBarrier();
+       #else
+        asm volatile ("" : : "g" (&value) : "memory");
+       #endif
+    }
+
+    /** Forces the compiler to assume that all memory may have been read and written,
+        so that any pending writes have to actually be performed.
+    */
+    static void clobberMemory() noexcept
+    {
+       #if JUCE_MSVC
+        _ReadWriteBarrier();
+       #else
+        asm volatile ("" : : : "memory");
+       #endif
+    }
+
+private:
+    //==============================================================================
+    void measure (const String& benchmarkName, const std::function<void (int64)>& runIterations);
+
+   #if JUCE_MSVC
+    static void escape (const volatile void*) noexcept;
+   #endif
+
+    Options options;
+};
+
+} // namespace juce
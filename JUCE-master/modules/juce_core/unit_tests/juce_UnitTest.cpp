@@ -139,6 +139,11 @@ void UnitTestRunner::setPassesAreLogged (bool shouldDisplayPasses) noexcept
     logPasses = shouldDisplayPasses;
 }
 
+void UnitTestRunner::setBenchmarkingEnabled (bool shouldTimeBenchmarks) noexcept
+{
+    benchmarking = shouldTimeBenchmarks;
+}
+
 int UnitTestRunner::getNumResults() const noexcept
 {
     return results.size();
@@ -149,6 +154,16 @@ const UnitTestRunner::TestResult* UnitTestRunner::getResult (int index) const no
     return results [index];
 }
 
+int UnitTestRunner::getNumBenchmarkResults() const noexcept
+{
+    return benchmarkResults.size();
+}
+
+const UnitTestRunner::BenchmarkResult* UnitTestRunner::getBenchmarkResult (int index) const noexcept
+{
+    return benchmarkResults [index];
+}
+
 void UnitTestRunner::resultsUpdated()
 {
 }
@@ -156,6 +171,7 @@ void UnitTestRunner::resultsUpdated()
 void UnitTestRunner::runTests (const Array<UnitTest*>& tests, int64 randomSeed)
 {
     results.clear();
+    benchmarkResults.clear();
     resultsUpdated();
 
     if (randomSeed == 0)
@@ -295,4 +311,20 @@ void UnitTestRunner::addFail (const String& failureMessage)
     if (assertOnFailure) { jassertfalse; }
 }
 
+void UnitTestRunner::addBenchmarkResult (const BenchmarkResult& result)
+{
+    benchmarkResults.add (new BenchmarkResult (result));
+
+    String message ("Benchmark ");
+    message << result.benchmarkName << ": " << String (result.medianNanoseconds, 1) << " ns median, "
+            << String (result.meanNanoseconds, 1) << " +/- " << String (result.standardDeviationNanoseconds, 1) << " ns mean, "
+            << result.numSamples << " samples of " << result.iterationsPerSample << " iterations";
+
+    if (result.numOutliers > 0)
+        message << ", " << result.numOutliers << (result.numOutliers == 1 ? " outlier" : " outliers") << " discarded";
+
+    logMessage (message);
+    resultsUpdated();
+}
+
 } // namespace juce
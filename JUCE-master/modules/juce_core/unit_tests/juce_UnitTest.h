@@ -312,6 +312,8 @@ private:
     }
 
     //==============================================================================
+    friend class BenchmarkTest;
+
     const String name, category;
     UnitTestRunner* runner = nullptr;
 
@@ -379,6 +381,18 @@ public:
     */
     void setPassesAreLogged (bool shouldDisplayPasses) noexcept;
 
+    /** Sets a flag to indicate whether BenchmarkTest objects should time their measurements.
+
+        By default, this is set to false, and each function passed to BenchmarkTest::benchmark()
+        is only called once, to check that it works.
+    */
+    void setBenchmarkingEnabled (bool shouldTimeBenchmarks) noexcept;
+
+    /** Returns true if BenchmarkTest objects should time their measurements.
+        @see setBenchmarkingEnabled
+    */
+    bool isBenchmarkingEnabled() const noexcept                 { return benchmarking; }
+
     //==============================================================================
     /** Contains the results of a test.
 
@@ -425,6 +439,42 @@ public:
     */
     const TestResult* getResult (int index) const noexcept;
 
+    //==============================================================================
+    /** Contains the timing of one measurement made by BenchmarkTest::benchmark().
+
+        All the times are per call of the function that was measured, and exclude any
+        samples that were rejected as outliers.
+    */
+    struct BenchmarkResult
+    {
+        /** The name of the test, i.e. the name of the BenchmarkTest object being run. */
+        String unitTestName;
+        /** The name that was set when UnitTest::beginTest() was called. */
+        String subcategoryName;
+        /** The name that was passed to BenchmarkTest::benchmark(). */
+        String benchmarkName;
+
+        /** The number of samples that were kept, and the number that were discarded as outliers. */
+        int numSamples = 0, numOutliers = 0;
+        /** The number of times the function was called in each sample. */
+        int64 iterationsPerSample = 0;
+
+        double medianNanoseconds = 0, meanNanoseconds = 0, standardDeviationNanoseconds = 0, fastestNanoseconds = 0;
+
+        /** Returns a string that identifies this measurement, for comparing it with other runs. */
+        String getKey() const       { return unitTestName + " / " + subcategoryName + " / " + benchmarkName; }
+    };
+
+    /** Returns the number of BenchmarkResult objects that have been recorded.
+        @see getBenchmarkResult
+    */
+    int getNumBenchmarkResults() const noexcept;
+
+    /** Returns one of the BenchmarkResult objects that describes a measurement that has been made.
+        @see getNumBenchmarkResults
+    */
+    const BenchmarkResult* getBenchmarkResult (int index) const noexcept;
+
 protected:
     /** Called when the list of results changes.
         You can override this to perform some sort of behaviour when results are added.
@@ -445,11 +495,13 @@ protected:
 private:
     //==============================================================================
     friend class UnitTest;
+    friend class BenchmarkTest;
 
     UnitTest* currentTest = nullptr;
     String currentSubCategory;
     OwnedArray<TestResult, CriticalSection> results;
-    bool assertOnFailure = true, logPasses = false;
+    OwnedArray<BenchmarkResult, CriticalSection> benchmarkResults;
+    bool assertOnFailure = true, logPasses = false, benchmarking = false;
     Random randomForTest;
 
     void beginNewTest (UnitTest* test, const String& subCategory);
@@ -457,6 +509,7 @@ private:
 
     void addPass();
     void addFail (const String& failureMessage);
+    void addBenchmarkResult (const BenchmarkResult&);
 
     JUCE_DECLARE_NON_COPYABLE (UnitTestRunner)
 };
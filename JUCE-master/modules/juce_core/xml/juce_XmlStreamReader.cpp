@@ -0,0 +1,837 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XmlStreamReaderHelpers
+{
+    static bool isWhitespace (int c) noexcept   { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    static bool isNameChar (int c) noexcept
+    {
+        // Bytes of multi-byte UTF-8 sequences are accepted, as XmlDocument accepts non-ASCII letters
+        return c >= 0x80 || (c > 0 && XmlIdentifierChars::isIdentifierChar ((juce_wchar) c));
+    }
+
+    static bool equalsIgnoreCase (std::string_view a, const char* b) noexcept
+    {
+        for (auto c : a)
+            if (*b == 0 || CharacterFunctions::toLowerCase ((juce_wchar) (uint8) c) != (juce_wchar) *b++)
+                return false;
+
+        return *b == 0;
+    }
+
+    static String toString (std::string_view s)
+    {
+        return String::fromUTF8 (s.data(), (int) s.size());
+    }
+}
+
+//==============================================================================
+XmlStreamReader::XmlStreamReader (InputStream& s)  : source (s) {}
+XmlStreamReader::~XmlStreamReader() = default;
+
+void XmlStreamReader::setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept
+{
+    ignoreEmptyTextElements = shouldBeIgnored;
+}
+
+std::optional<std::string_view> XmlStreamReader::getAttributeValue (std::string_view attributeName) const noexcept
+{
+    for (auto& att : attributes)
+        if (att.name == attributeName)
+            return att.value;
+
+    return std::nullopt;
+}
+
+XmlStreamReader::Event XmlStreamReader::next()
+{
+    if (currentEvent == Event::endOfDocument || currentEvent == Event::error)
+        return currentEvent;
+
+    tagName = {};
+    text = {};
+    attributes.clear();
+    attributeRanges.clear();
+
+    if (needToPopTag)
+    {
+        needToPopTag = false;
+        openTagNames.resize (openTagStarts.back());
+        openTagStarts.pop_back();
+        documentElementClosed = openTagStarts.empty();
+    }
+
+    if (needToCloseEmptyTag)
+    {
+        needToCloseEmptyTag = false;
+        needToPopTag = true;
+        tagName = std::string_view (openTagNames).substr (openTagStarts.back());
+        return currentEvent = Event::endElement;
+    }
+
+    // Once the document element is closed, anything that follows is ignored, as in XmlDocument
+    if (documentElementClosed)
+        return currentEvent = Event::endOfDocument;
+
+    // Nothing refers to the text before the current position any more, so it can be discarded
+    if (position > 0)
+    {
+        numBuffered -= position;
+        memmove (buffer, buffer + position, numBuffered);
+        position = 0;
+    }
+
+    return currentEvent = parseNext();
+}
+
+XmlStreamReader::Event XmlStreamReader::parseNext()
+{
+    if (isFirstRead)
+    {
+        isFirstRead = false;
+
+        if (matches (0, "\xef\xbb\xbf"))
+            position = 3;
+        else if (matches (0, "\xfe\xff") || matches (0, "\xff\xfe"))
+            return fail ("UTF-16 input is not supported");
+    }
+
+    for (;;)
+    {
+        const auto c = peekAt (position);
+
+        if (c < 0)
+            return fail (openTagStarts.empty() ? "not enough input" : "unmatched tags");
+
+        if (c != '<')
+        {
+            if (openTagStarts.empty())
+            {
+                if (! XmlStreamReaderHelpers::isWhitespace (c))
+                    return fail ("expected '<'");
+
+                ++position;
+                continue;
+            }
+
+            const auto event = parseText (position, false);
+
+            if (event == Event::none)
+                continue;
+
+            return event;
+        }
+
+        if (matches (position, "<!--"))
+        {
+            const auto closeComment = find (position + 4, "-->");
+
+            if (closeComment < 0)
+                return fail ("unterminated comment");
+
+            position = (size_t) closeComment + 3;
+            continue;
+        }
+
+        if (matches (position, "<?"))
+        {
+            const auto closeBracket = find (position + 2, "?>");
+
+            if (closeBracket < 0)
+                return fail ("malformed header");
+
+            position = (size_t) closeBracket + 2;
+            continue;
+        }
+
+        if (matches (position, "<![CDATA["))
+        {
+            if (openTagStarts.empty())
+                return fail ("CDATA section found outside the document element");
+
+            return parseText (position + 9, true);
+        }
+
+        if (matches (position, "<!"))
+        {
+            // A DOCTYPE declaration, which may contain nested declarations
+            auto i = position + 2;
+
+            for (int depth = 1; depth > 0; ++i)
+            {
+                const auto ch = peekAt (i);
+
+                if (ch < 0)
+                    return fail ("malformed DTD");
+
+                if (ch == '<')
+                    ++depth;
+                else if (ch == '>')
+                    --depth;
+            }
+
+            position = i;
+            continue;
+        }
+
+        if (peekAt (position + 1) == '/')
+            return parseEndTag();
+
+        return parseStartTag();
+    }
+}
+
+XmlStreamReader::Event XmlStreamReader::parseStartTag()
+{
+    const Range name { position + 1, skipName (position + 1) };
+
+    if (name.end == name.start)
+        return fail ("tag name missing");
+
+    auto i = name.end;
+    auto isEmptyTag = false;
+
+    for (;;)
+    {
+        i = skipWhitespace (i);
+        const auto c = peekAt (i);
+
+        if (c == '/' && peekAt (i + 1) == '>')
+        {
+            i += 2;
+            isEmptyTag = true;
+            break;
+        }
+
+        if (c == '>')
+        {
+            ++i;
+            break;
+        }
+
+        if (c < 0)
+            return fail ("unexpected end of input");
+
+        const Range attributeName { i, skipName (i) };
+
+        if (attributeName.end == attributeName.start)
+            return fail ("illegal character found in " + XmlStreamReaderHelpers::toString (view (name))
+                           + ": '" + String::charToString ((juce_wchar) c) + "'");
+
+        i = skipWhitespace (attributeName.end);
+
+        if (peekAt (i) != '=')
+            return fail ("expected '=' after attribute '" + XmlStreamReaderHelpers::toString (view (attributeName)) + "'");
+
+        i = skipWhitespace (i + 1);
+        const auto quote = peekAt (i);
+
+        if (quote != '"' && quote != '\'')
+            return fail ("expected a quoted value for attribute '" + XmlStreamReaderHelpers::toString (view (attributeName)) + "'");
+
+        // Entities are expanded in place, which never makes the text longer
+        auto readIndex = i + 1, writeIndex = i + 1;
+
+        for (;;)
+        {
+            const auto ch = peekAt (readIndex);
+
+            if (ch < 0)
+                return fail ("unmatched quotes");
+
+            if (ch == quote)
+                break;
+
+            if (ch == '&')
+                decodeEntity (readIndex, writeIndex);
+            else
+                buffer[writeIndex++] = buffer[readIndex++];
+        }
+
+        attributeRanges.push_back (attributeName);
+        attributeRanges.push_back ({ i + 1, writeIndex });
+        i = readIndex + 1;
+    }
+
+    position = i;
+
+    openTagStarts.push_back (openTagNames.size());
+    openTagNames.append (buffer + name.start, name.end - name.start);
+    needToCloseEmptyTag = isEmptyTag;
+
+    // The buffer may have been reallocated while parsing, so the views are only made now
+    tagName = view (name);
+
+    for (size_t n = 0; n < attributeRanges.size(); n += 2)
+        attributes.push_back ({ view (attributeRanges[n]), view (attributeRanges[n + 1]) });
+
+    return Event::startElement;
+}
+
+XmlStreamReader::Event XmlStreamReader::parseEndTag()
+{
+    const Range name { position + 2, skipName (position + 2) };
+    const auto closeBracket = skipWhitespace (name.end);
+
+    if (peekAt (closeBracket) != '>')
+        return fail ("malformed closing tag");
+
+    const auto expected = std::string_view (openTagNames).substr (openTagStarts.back());
+
+    if (view (name) != expected)
+        return fail ("mismatched closing tag '" + XmlStreamReaderHelpers::toString (view (name))
+                       + "', expected '" + XmlStreamReaderHelpers::toString (expected) + "'");
+
+    position = closeBracket + 1;
+    needToPopTag = true;
+    tagName = expected;
+    return Event::endElement;
+}
+
+XmlStreamReader::Event XmlStreamReader::parseText (size_t textStart, bool isCData)
+{
+    if (isCData)
+    {
+        const auto end = find (textStart, "]]>");
+
+        if (end < 0)
+            return fail ("unterminated CDATA section");
+
+        position = (size_t) end + 3;
+        text = view ({ textStart, (size_t) end });
+        return Event::text;
+    }
+
+    auto readIndex = textStart, writeIndex = textStart;
+    auto contentShouldBeUsed = ! ignoreEmptyTextElements;
+
+    for (;;)
+    {
+        const auto c = peekAt (readIndex);
+
+        if (c < 0)
+            return fail ("unmatched tags");
+
+        if (c == '<')
+        {
+            if (! matches (readIndex, "<!--"))
+                break;
+
+            const auto closeComment = find (readIndex + 4, "-->");
+
+            if (closeComment < 0)
+                return fail ("unterminated comment");
+
+            readIndex = (size_t) closeComment + 3;
+            continue;
+        }
+
+        if (c == '&')
+        {
+            const auto entityStart = writeIndex;
+            decodeEntity (readIndex, writeIndex);
+
+            for (auto n = entityStart; n < writeIndex; ++n)
+                contentShouldBeUsed = contentShouldBeUsed || ! XmlStreamReaderHelpers::isWhitespace ((uint8) buffer[n]);
+
+            continue;
+        }
+
+        ++readIndex;
+
+        if (c == '\r')
+        {
+            if (peekAt (readIndex) == '\n')
+                continue;
+
+            buffer[writeIndex++] = '\n';
+            continue;
+        }
+
+        buffer[writeIndex++] = (char) c;
+        contentShouldBeUsed = contentShouldBeUsed || ! XmlStreamReaderHelpers::isWhitespace (c);
+    }
+
+    position = readIndex;
+
+    if (! contentShouldBeUsed)
+        return Event::none;
+
+    text = view ({ textStart, writeIndex });
+    return Event::text;
+}
+
+XmlStreamReader::Event XmlStreamReader::fail (const String& message)
+{
+    lastError = message;
+    return Event::error;
+}
+
+void XmlStreamReader::decodeEntity (size_t& readIndex, size_t& writeIndex)
+{
+    constexpr size_t maxNameLength = 10;
+    auto end = readIndex + 1;
+
+    for (;; ++end)
+    {
+        const auto c = peekAt (end);
+
+        if (c == ';')
+            break;
+
+        if (c < 0 || c == '<' || c == '&' || XmlStreamReaderHelpers::isWhitespace (c)
+             || end > readIndex + maxNameLength)
+        {
+            // Not an entity, so leave the ampersand as it is
+            buffer[writeIndex++] = buffer[readIndex++];
+            return;
+        }
+    }
+
+    const auto name = view ({ readIndex + 1, end });
+    juce_wchar result = 0;
+
+    if      (XmlStreamReaderHelpers::equalsIgnoreCase (name, "amp"))   result = '&';
+    else if (XmlStreamReaderHelpers::equalsIgnoreCase (name, "quot"))  result = '"';
+    else if (XmlStreamReaderHelpers::equalsIgnoreCase (name, "apos"))  result = '\'';
+    else if (XmlStreamReaderHelpers::equalsIgnoreCase (name, "lt"))    result = '<';
+    else if (XmlStreamReaderHelpers::equalsIgnoreCase (name, "gt"))    result = '>';
+    else if (name.size() > 1 && name[0] == '#')
+    {
+        const auto isHex = name[1] == 'x' || name[1] == 'X';
+        const auto digits = name.substr (isHex ? 2 : 1);
+        uint32 value = 0;
+
+        for (auto digit : digits)
+        {
+            const auto digitValue = isHex ? CharacterFunctions::getHexDigitValue ((juce_wchar) digit)
+                                          : (digit >= '0' && digit <= '9' ? digit - '0' : -1);
+
+            if (digitValue < 0 || value > 0x10ffff)
+            {
+                value = 0;
+                break;
+            }
+
+            value = value * (isHex ? 16u : 10u) + (uint32) digitValue;
+        }
+
+        if (value <= 0x10ffff)
+            result = (juce_wchar) value;
+    }
+
+    if (result == 0)
+    {
+        // Entities declared in a DTD aren't supported, so they're passed through unchanged
+        const auto length = end + 1 - readIndex;
+        memmove (buffer + writeIndex, buffer + readIndex, length);
+        writeIndex += length;
+        readIndex += length;
+        return;
+    }
+
+    // The UTF-8 encoding of a character is always shorter than the entity that describes it
+    CharPointer_UTF8 dest (buffer + writeIndex);
+    dest.write (result);
+    writeIndex = (size_t) (dest.getAddress() - buffer.get());
+    readIndex = end + 1;
+}
+
+//==============================================================================
+int XmlStreamReader::peekAt (size_t index)
+{
+    while (index >= numBuffered)
+        if (! readMore())
+            return -1;
+
+    return (uint8) buffer[index];
+}
+
+bool XmlStreamReader::readMore()
+{
+    if (sourceExhausted)
+        return false;
+
+    constexpr size_t minimumReadSize = 4096;
+
+    if (bufferSize - numBuffered < minimumReadSize)
+    {
+        bufferSize = jmax (bufferSize * 2, (size_t) 32768);
+        buffer.realloc (bufferSize);
+    }
+
+    const auto numToRead = (int) jmin (bufferSize - numBuffered, (size_t) std::numeric_limits<int>::max());
+    const auto numRead = source.read (buffer + numBuffered, numToRead);
+
+    if (numRead <= 0)
+    {
+        sourceExhausted = true;
+        return false;
+    }
+
+    numBuffered += (size_t) numRead;
+    return true;
+}
+
+bool XmlStreamReader::matches (size_t index, const char* sequence)
+{
+    for (; *sequence != 0; ++sequence)
+        if (peekAt (index++) != (uint8) *sequence)
+            return false;
+
+    return true;
+}
+
+int64 XmlStreamReader::find (size_t index, const char* sequence)
+{
+    for (;; ++index)
+    {
+        const auto c = peekAt (index);
+
+        if (c < 0)
+            return -1;
+
+        if (c == (uint8) *sequence && matches (index, sequence))
+            return (int64) index;
+    }
+}
+
+size_t XmlStreamReader::skipWhitespace (size_t index)
+{
+    while (XmlStreamReaderHelpers::isWhitespace (peekAt (index)))
+        ++index;
+
+    return index;
+}
+
+size_t XmlStreamReader::skipName (size_t index)
+{
+    while (XmlStreamReaderHelpers::isNameChar (peekAt (index)))
+        ++index;
+
+    return index;
+}
+
+std::string_view XmlStreamReader::view (Range range) const noexcept
+{
+    return { buffer + range.start, range.end - range.start };
+}
+
+//==============================================================================
+XmlElement* XmlStreamReader::createElementForCurrentTag() const
+{
+    auto* element = new XmlElement (XmlStreamReaderHelpers::toString (tagName));
+    LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (element->attributes);
+
+    for (auto& att : attributes)
+        attributeAppender.append (new XmlElement::XmlAttributeNode (XmlStreamReaderHelpers::toString (att.name),
+                                                                    XmlStreamReaderHelpers::toString (att.value)));
+
+    return element;
+}
+
+std::unique_ptr<XmlElement> XmlStreamReader::readElement()
+{
+    if (currentEvent != Event::startElement)
+    {
+        jassertfalse; // readElement() can only be called when positioned on a startElement
+        return {};
+    }
+
+    std::unique_ptr<XmlElement> result (createElementForCurrentTag());
+
+    // The list pointer that each open element's next child should be stored in
+    std::vector<LinkedListPointer<XmlElement>*> insertionPoints { &result->firstChildElement };
+
+    const auto append = [&] (XmlElement* element)
+    {
+        *insertionPoints.back() = element;
+        insertionPoints.back() = &element->nextListItem;
+    };
+
+    while (! insertionPoints.empty())
+    {
+        switch (next())
+        {
+            case Event::startElement:
+            {
+                auto* element = createElementForCurrentTag();
+                append (element);
+                insertionPoints.push_back (&element->firstChildElement);
+                break;
+            }
+
+            case Event::text:
+                append (XmlElement::createTextElement (XmlStreamReaderHelpers::toString (text)));
+                break;
+
+            case Event::endElement:
+                insertionPoints.pop_back();
+                break;
+
+            case Event::none:
+            case Event::endOfDocument:
+            case Event::error:
+                return {};
+        }
+    }
+
+    return result;
+}
+
+bool XmlStreamReader::skipElement()
+{
+    if (currentEvent != Event::startElement)
+    {
+        jassertfalse; // skipElement() can only be called when positioned on a startElement
+        return false;
+    }
+
+    const auto depth = getDepth();
+
+    for (;;)
+    {
+        switch (next())
+        {
+            case Event::endElement:
+                if (getDepth() == depth)
+                    return true;
+
+                break;
+
+            case Event::startElement:
+            case Event::text:
+                break;
+
+            case Event::none:
+            case Event::endOfDocument:
+            case Event::error:
+                return false;
+        }
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlStreamReaderTests final : public UnitTest
+{
+public:
+    XmlStreamReaderTests()
+        : UnitTest ("XmlStreamReader", UnitTestCategories::xml)
+    {}
+
+    // Hands out a few bytes at a time, so that every item straddles a buffer refill
+    struct TricklingInputStream final : public InputStream
+    {
+        explicit TricklingInputStream (const String& text)  : source (text.toRawUTF8(), text.getNumBytesAsUTF8(), true) {}
+
+        int64 getTotalLength() override             { return source.getTotalLength(); }
+        bool isExhausted() override                 { return source.isExhausted(); }
+        int64 getPosition() override                { return source.getPosition(); }
+        bool setPosition (int64 pos) override       { return source.setPosition (pos); }
+        int read (void* dest, int maxBytes) override { return source.read (dest, jmin (maxBytes, 3)); }
+
+        MemoryInputStream source;
+    };
+
+    static String describeEvents (const String& xml)
+    {
+        MemoryInputStream stream (xml.toRawUTF8(), xml.getNumBytesAsUTF8(), false);
+        XmlStreamReader reader (stream);
+        StringArray events;
+
+        for (;;)
+        {
+            switch (reader.next())
+            {
+                case XmlStreamReader::Event::startElement:
+                {
+                    String s ("<" + String (std::string (reader.getTagName())));
+
+                    for (auto& att : reader.getAttributes())
+                        s << " " << String (std::string (att.name)) << "=" << String (std::string (att.value));
+
+                    events.add (s + ">");
+                    break;
+                }
+
+                case XmlStreamReader::Event::endElement:   events.add ("</" + String (std::string (reader.getTagName())) + ">"); break;
+                case XmlStreamReader::Event::text:         events.add ("'" + String (std::string (reader.getText())) + "'"); break;
+                case XmlStreamReader::Event::error:        events.add ("error: " + reader.getLastError()); return events.joinIntoString (" ");
+                case XmlStreamReader::Event::none:
+                case XmlStreamReader::Event::endOfDocument: return events.joinIntoString (" ");
+            }
+        }
+    }
+
+    static std::unique_ptr<XmlElement> readWholeDocument (InputStream& stream)
+    {
+        XmlStreamReader reader (stream);
+        return reader.next() == XmlStreamReader::Event::startElement ? reader.readElement() : nullptr;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Events");
+        {
+            expectEquals (describeEvents (R"(<?xml version="1.0"?><!DOCTYPE root [<!ENTITY e "x">]><!-- c -->)"
+                                          R"(<root a="1" b='x &amp; &#x41;&#66; "&unknown;"'><child/>text &lt;here&gt;)"
+                                          "<![CDATA[<raw>]]><x>1</x><y attr = \"a>b\" ></y></root>trailing"),
+                          String (R"(<root a=1 b=x & AB "&unknown;"> <child> </child> 'text <here>' '<raw>' <x> '1' </x> <y attr=a>b> </y> </root>)"));
+
+            expectEquals (describeEvents ("<a>\r\n  <b>one<!-- skipped -->two</b>\r\n</a>"),
+                          String ("<a> <b> 'onetwo' </b> </a>"));
+        }
+
+        beginTest ("Errors");
+        {
+            expect (describeEvents ("<a><b></a>").endsWith ("error: mismatched closing tag 'a', expected 'b'"));
+            expect (describeEvents ("<a><b>").endsWith ("error: unmatched tags"));
+            expect (describeEvents ("<a b></a>").endsWith ("error: expected '=' after attribute 'b'"));
+            expect (describeEvents ("<a b=\"1></a>").endsWith ("error: unmatched quotes"));
+            expect (describeEvents ("").endsWith ("error: not enough input"));
+            expect (describeEvents ("<a><!-- </a>").endsWith ("error: unterminated comment"));
+        }
+
+        beginTest ("Materialised elements match XmlDocument");
+        {
+            Random r;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                const auto original = createRandomElement (r, 4);
+                const auto text = original->toString();
+
+                TricklingInputStream stream (text);
+                const auto streamed = readWholeDocument (stream);
+                const auto parsed = parseXML (text);
+
+                expect (streamed != nullptr && parsed != nullptr);
+
+                if (streamed != nullptr && parsed != nullptr)
+                    expect (streamed->isEquivalentTo (parsed.get(), false), text);
+            }
+        }
+
+        beginTest ("Selected subtrees can be materialised");
+        {
+            XmlElement root ("ROOT");
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto* item = root.createNewChildElement ("ITEM");
+                item->setAttribute ("id", i);
+                item->createNewChildElement ("VALUE")->addTextElement (String (i * 2));
+            }
+
+            const auto text = root.toString();
+            MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+            XmlStreamReader reader (stream);
+
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+            expect (reader.getTagName() == "ROOT");
+
+            int numRead = 0, numSkipped = 0;
+
+            while (reader.next() == XmlStreamReader::Event::startElement)
+            {
+                const auto id = String (std::string (reader.getAttributeValue ("id").value_or ("-1"))).getIntValue();
+                expectEquals (reader.getDepth(), 2);
+
+                if (id % 3 == 0)
+                {
+                    const auto item = reader.readElement();
+                    expect (item != nullptr && item->getChildByName ("VALUE")->getAllSubText() == String (id * 2));
+                    ++numRead;
+                }
+                else
+                {
+                    expect (reader.skipElement());
+                    ++numSkipped;
+                }
+            }
+
+            expect (reader.getCurrentEvent() == XmlStreamReader::Event::endElement);
+            expect (reader.getTagName() == "ROOT");
+            expect (reader.next() == XmlStreamReader::Event::endOfDocument);
+            expectEquals (numRead, 334);
+            expectEquals (numSkipped, 666);
+        }
+    }
+
+private:
+    static std::unique_ptr<XmlElement> createRandomElement (Random& r, int depth)
+    {
+        auto element = std::make_unique<XmlElement> ("E" + String (r.nextInt (10)));
+
+        for (int i = r.nextInt (4); --i >= 0;)
+            element->setAttribute ("a" + String (i), createRandomText (r));
+
+        if (depth > 0)
+        {
+            for (int i = r.nextInt (5); --i >= 0;)
+            {
+                if (r.nextBool())
+                    element->addChildElement (createRandomElement (r, depth - 1).release());
+                else
+                    element->addTextElement (createRandomText (r));
+            }
+        }
+
+        return element;
+    }
+
+    static String createRandomText (Random& r)
+    {
+        static const char* const fragments[] = { "abc", " ", "&", "<", ">", "\"", "'", "\xc3\xa9", "\xe2\x82\xac", "\t", "0123456789" };
+        String s;
+
+        for (int i = r.nextInt (8); --i >= 0;)
+            s << String::fromUTF8 (fragments[r.nextInt ((int) std::size (fragments))]);
+
+        return s + "x";
+    }
+};
+
+static XmlStreamReaderTests xmlStreamReaderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pull-based XML reader which parses a document incrementally from an InputStream.
+
+    Where XmlDocument builds an entire tree of XmlElement objects, this class reads
+    the document a piece at a time: each call to next() parses just enough of the
+    stream to produce the next start tag, end tag or block of text. Memory use is
+    therefore proportional to the size of the largest single tag or text block,
+    rather than to the size of the whole document.
+
+    Tag names, attributes and text are returned as views into the reader's internal
+    buffer, so no strings are allocated while scanning. These views are only valid
+    until the next call to next(), readElement() or skipElement().
+
+    @code
+    FileInputStream stream (file);
+    XmlStreamReader reader (stream);
+
+    while (reader.next() == XmlStreamReader::Event::startElement)
+    {
+        if (reader.getTagName() == "part")
+        {
+            if (auto part = reader.readElement())   // build an XmlElement for just this subtree
+                importPart (*part);
+        }
+    }
+
+    if (reader.getCurrentEvent() == XmlStreamReader::Event::error)
+        DBG (reader.getLastError());
+    @endcode
+
+    Comments, processing instructions and DOCTYPE declarations are skipped. The
+    predefined entities and numeric character references are expanded, but entities
+    declared in a DTD are not, and are passed through as literal text. Input must
+    be UTF-8.
+
+    @see XmlDocument, XmlElement
+
+    @tags{Core}
+*/
+class JUCE_API  XmlStreamReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader which will parse text from the given stream.
+        The stream must remain valid for the lifetime of the reader.
+    */
+    explicit XmlStreamReader (InputStream& source);
+
+    /** Destructor. */
+    ~XmlStreamReader();
+
+    //==============================================================================
+    /** The kinds of item that the reader can produce. */
+    enum class Event
+    {
+        none,           ///< next() hasn't been called yet
+        startElement,   ///< An opening tag, or an empty-element tag such as <foo/>
+        endElement,     ///< A closing tag. An empty-element tag produces both a startElement and an endElement
+        text,           ///< A block of character data, or a CDATA section
+        endOfDocument,  ///< The document element has been closed
+        error           ///< The document was malformed: see getLastError()
+    };
+
+    /** A view of an attribute in the current start tag. */
+    struct Attribute
+    {
+        std::string_view name, value;
+    };
+
+    //==============================================================================
+    /** Parses the next item from the stream, and returns its type.
+        Once endOfDocument or error has been returned, subsequent calls will keep
+        returning the same value.
+    */
+    Event next();
+
+    /** Returns the type of the item that was most recently parsed. */
+    Event getCurrentEvent() const noexcept                  { return currentEvent; }
+
+    /** Returns the number of elements enclosing the current item.
+
+        For a startElement or endElement this includes the element itself, so the
+        document element is at depth 1.
+    */
+    int getDepth() const noexcept                           { return (int) openTagStarts.size(); }
+
+    /** For a startElement or endElement, returns the element's tag name. */
+    std::string_view getTagName() const noexcept            { return tagName; }
+
+    /** For a startElement, returns the attributes of the element, in document order. */
+    Span<const Attribute> getAttributes() const noexcept    { return { attributes.data(), attributes.size() }; }
+
+    /** For a startElement, returns the value of the named attribute, or nullopt if the
+        element doesn't have an attribute with that name.
+    */
+    std::optional<std::string_view> getAttributeValue (std::string_view attributeName) const noexcept;
+
+    /** For a text item, returns its content with any entities already expanded. */
+    std::string_view getText() const noexcept               { return text; }
+
+    //==============================================================================
+    /** Reads the element at the current startElement, including all of its children,
+        and returns it as an XmlElement.
+
+        Afterwards the reader is positioned on the element's endElement, so calling
+        next() will continue with whatever follows it. Returns nullptr if the current
+        item isn't a startElement, or if the document is malformed.
+    */
+    std::unique_ptr<XmlElement> readElement();
+
+    /** Skips over the element at the current startElement, including all of its children,
+        leaving the reader positioned on the element's endElement.
+
+        Returns false if the current item isn't a startElement, or if the document is
+        malformed.
+    */
+    bool skipElement();
+
+    //==============================================================================
+    /** Returns a description of the problem if next() has returned an error. */
+    const String& getLastError() const noexcept             { return lastError; }
+
+    /** Sets a flag to change the treatment of empty text elements.
+
+        If this is true (the default state), then any text which contains only whitespace
+        characters is skipped over rather than being returned by next().
+    */
+    void setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept;
+
+private:
+    //==============================================================================
+    struct Range  { size_t start = 0, end = 0; };
+
+    Event parseNext();
+    Event parseStartTag();
+    Event parseEndTag();
+    Event parseText (size_t textStart, bool isCData);
+    Event fail (const String&);
+
+    int peekAt (size_t index);
+    bool readMore();
+    bool matches (size_t index, const char* sequence);
+    int64 find (size_t index, const char* sequence);
+    size_t skipWhitespace (size_t index);
+    size_t skipName (size_t index);
+    void decodeEntity (size_t& readIndex, size_t& writeIndex);
+    std::string_view view (Range) const noexcept;
+    XmlElement* createElementForCurrentTag() const;
+
+    InputStream& source;
+    HeapBlock<char> buffer;
+    size_t bufferSize = 0, position = 0, numBuffered = 0;
+    bool sourceExhausted = false;
+
+    Event currentEvent = Event::none;
+    String lastError;
+    std::string_view tagName, text;
+    std::vector<Attribute> attributes;
+    std::vector<Range> attributeRanges;
+
+    std::string openTagNames;
+    std::vector<size_t> openTagStarts;
+    bool needToPopTag = false, needToCloseEmptyTag = false, documentElementClosed = false;
+    bool ignoreEmptyTextElements = true, isFirstRead = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlStreamReader)
+};
+
+} // namespace juce
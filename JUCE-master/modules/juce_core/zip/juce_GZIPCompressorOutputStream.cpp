@@ -124,6 +124,263 @@ private:
     JUCE_DECLARE_NON_COPYABLE (GZIPCompressorHelper)
 };
 
+//==============================================================================
+class GZIPCompressorOutputStream::ParallelCompressorHelper
+{
+public:
+    ParallelCompressorHelper (ThreadPool& p, int compressionLevel, int windowBits, size_t size)
+        : pool (p),
+          compLevel ((compressionLevel < 0 || compressionLevel > 9) ? -1 : compressionLevel),
+          format (windowBits < 0 ? Format::raw : (windowBits > MAX_WBITS ? Format::gzip : Format::zlib)),
+          blockSize (jmax ((size_t) 1024, size)),
+          maxBlocksInFlight (jmax (2, pool.getNumThreads() * 2)),
+          checksum (format == Format::gzip ? 0 : 1)
+    {
+        // The parallel compressor always uses the largest window size, so it can only
+        // produce these formats.
+        jassert (windowBits == 0 || windowBits == MAX_WBITS
+                  || windowBits == windowBitsRaw || windowBits == windowBitsGZIP);
+
+        startNewBlock();
+    }
+
+    ~ParallelCompressorHelper()
+    {
+        // Any blocks that haven't been written must still be allowed to finish, as
+        // the jobs refer to them.
+        for (auto& b : blocksInFlight)
+            b->waitUntilDone();
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on a gzip stream, the stream is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        while (dataSize > 0)
+        {
+            auto num = jmin (dataSize, blockSize - currentBlock->inputSize);
+            memcpy (static_cast<uint8*> (currentBlock->input.getData()) + currentBlock->inputSize, data, num);
+            currentBlock->inputSize += num;
+            data += num;
+            dataSize -= num;
+
+            if (currentBlock->inputSize == blockSize)
+            {
+                submitCurrentBlock (false);
+
+                if (! writeFinishedBlocks (out, maxBlocksInFlight - 1))
+                    return false;
+
+                startNewBlock();
+            }
+        }
+
+        return ok;
+    }
+
+    void finish (OutputStream& out)
+    {
+        if (finished)
+            return;
+
+        finished = true;
+        submitCurrentBlock (true);
+
+        if (writeFinishedBlocks (out, 0))
+            writeTrailer (out);
+    }
+
+private:
+    enum class Format { zlib, gzip, raw };
+
+    struct Block
+    {
+        MemoryBlock input, dictionary, output;
+        size_t inputSize = 0, outputSize = 0;
+        zlibNamespace::uLong checksum = 0;
+        int compLevel = -1;
+        Format format = Format::zlib;
+        bool isLast = false, failed = false;
+
+        std::atomic<bool> claimed { false };
+        WaitableEvent done { true };
+
+        void compressIfNotClaimed()
+        {
+            if (! claimed.exchange (true))
+            {
+                compress();
+                done.signal();
+            }
+        }
+
+        void waitUntilDone()
+        {
+            compressIfNotClaimed();
+            done.wait();
+        }
+
+        void compress()
+        {
+            using namespace zlibNamespace;
+
+            auto* in = static_cast<const Bytef*> (input.getData());
+            checksum = format == Format::gzip ? crc32 (0, in, (uInt) inputSize)
+                                              : adler32 (1, in, (uInt) inputSize);
+
+            z_stream stream;
+            zerostruct (stream);
+
+            if (deflateInit2 (&stream, compLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            {
+                failed = true;
+                return;
+            }
+
+            if (! dictionary.isEmpty())
+                deflateSetDictionary (&stream, static_cast<const Bytef*> (dictionary.getData()), (uInt) dictionary.getSize());
+
+            output.setSize ((size_t) deflateBound (&stream, (uLong) inputSize) + 64, false);
+
+            stream.next_in   = in;
+            stream.avail_in  = (uInt) inputSize;
+            stream.next_out  = static_cast<Bytef*> (output.getData());
+            stream.avail_out = (uInt) output.getSize();
+
+            // Blocks other than the last one end with a sync flush, which leaves the
+            // output byte-aligned, so that the next block's data can simply be appended.
+            const auto flushMode = isLast ? Z_FINISH : Z_SYNC_FLUSH;
+
+            for (;;)
+            {
+                if (stream.avail_out == 0)
+                {
+                    auto used = output.getSize();
+                    output.ensureSize (used * 2);
+                    stream.next_out  = static_cast<Bytef*> (output.getData()) + used;
+                    stream.avail_out = (uInt) (output.getSize() - used);
+                }
+
+                auto result = deflate (&stream, flushMode);
+
+                if (result == Z_STREAM_END || (! isLast && result == Z_OK && stream.avail_out > 0))
+                    break;
+
+                if (result != Z_OK && result != Z_BUF_ERROR)
+                {
+                    failed = true;
+                    break;
+                }
+            }
+
+            outputSize = output.getSize() - stream.avail_out;
+            deflateEnd (&stream);
+        }
+    };
+
+    ThreadPool& pool;
+    const int compLevel;
+    const Format format;
+    const size_t blockSize;
+    const int maxBlocksInFlight;
+    std::deque<std::shared_ptr<Block>> blocksInFlight;
+    std::shared_ptr<Block> currentBlock;
+    zlibNamespace::uLong checksum;
+    uint64 totalInputSize = 0;
+    bool headerWritten = false, finished = false, ok = true;
+
+    static constexpr size_t dictionarySize = 32768;
+
+    void startNewBlock()
+    {
+        auto block = std::make_shared<Block>();
+        block->input.setSize (blockSize, false);
+        block->compLevel = compLevel;
+        block->format = format;
+
+        if (currentBlock != nullptr)
+        {
+            auto dictSize = jmin (dictionarySize, currentBlock->inputSize);
+            block->dictionary.replaceAll (static_cast<const char*> (currentBlock->input.getData())
+                                            + currentBlock->inputSize - dictSize, dictSize);
+        }
+
+        currentBlock = std::move (block);
+    }
+
+    void submitCurrentBlock (bool isLast)
+    {
+        currentBlock->isLast = isLast;
+        blocksInFlight.push_back (currentBlock);
+
+        pool.addJob ([block = currentBlock] { block->compressIfNotClaimed(); });
+    }
+
+    bool writeFinishedBlocks (OutputStream& out, int maxBlocksToLeave)
+    {
+        while ((int) blocksInFlight.size() > maxBlocksToLeave)
+        {
+            auto block = blocksInFlight.front();
+            blocksInFlight.pop_front();
+
+            block->waitUntilDone();
+            ok = ok && ! block->failed && writeHeader (out)
+                    && out.write (block->output.getData(), block->outputSize);
+
+            using namespace zlibNamespace;
+
+            checksum = format == Format::gzip ? crc32_combine   (checksum, block->checksum, (z_off_t) block->inputSize)
+                                              : adler32_combine (checksum, block->checksum, (z_off_t) block->inputSize);
+
+            totalInputSize += block->inputSize;
+        }
+
+        return ok;
+    }
+
+    bool writeHeader (OutputStream& out)
+    {
+        if (std::exchange (headerWritten, true))
+            return true;
+
+        if (format == Format::gzip)
+        {
+            const uint8 header[] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+            return out.write (header, sizeof (header));
+        }
+
+        if (format == Format::zlib)
+        {
+            const auto level = compLevel < 0 ? 6 : compLevel;
+            const uint8 cmf = 0x78;
+            auto flg = (uint8) ((level < 2 ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3))) << 6);
+            flg = (uint8) (flg + 31 - ((cmf * 256 + flg) % 31));
+
+            const uint8 header[] = { cmf, flg };
+            return out.write (header, sizeof (header));
+        }
+
+        return true;
+    }
+
+    void writeTrailer (OutputStream& out)
+    {
+        if (format == Format::gzip)
+        {
+            ok = out.writeInt ((int) (uint32) checksum)
+                  && out.writeInt ((int) (uint32) totalInputSize);
+        }
+        else if (format == Format::zlib)
+        {
+            ok = out.writeIntBigEndian ((int) (uint32) checksum);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelCompressorHelper)
+};
+
 //==============================================================================
 GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream& s, int compressionLevel, int windowBits)
    : GZIPCompressorOutputStream (&s, compressionLevel, false, windowBits)
@@ -137,6 +394,13 @@ GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream* out, int c
     jassert (out != nullptr);
 }
 
+GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream& out, ThreadPool& pool, int compressionLevel,
+                                                        int windowBits, size_t blockSize)
+   : destStream (&out, false),
+     parallelHelper (new ParallelCompressorHelper (pool, compressionLevel, windowBits, blockSize))
+{
+}
+
 GZIPCompressorOutputStream::~GZIPCompressorOutputStream()
 {
     flush();
@@ -144,7 +408,11 @@ GZIPCompressorOutputStream::~GZIPCompressorOutputStream()
 
 void GZIPCompressorOutputStream::flush()
 {
-    helper->finish (*destStream);
+    if (parallelHelper != nullptr)
+        parallelHelper->finish (*destStream);
+    else
+        helper->finish (*destStream);
+
     destStream->flush();
 }
 
@@ -152,6 +420,9 @@ bool GZIPCompressorOutputStream::write (const void* destBuffer, size_t howMany)
 {
     jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
 
+    if (parallelHelper != nullptr)
+        return parallelHelper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
+
     return helper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
 }
 
@@ -216,6 +487,60 @@ struct GZIPTests final : public UnitTest
                                 original.getData(),
                                 original.getDataSize()) == 0);
         }
+
+        beginTest ("Parallel compression");
+        {
+            ThreadPool pool (3);
+
+            MemoryOutputStream original;
+
+            for (int i = 0; i < 30000; ++i)
+                original << "line " << rng.nextInt (1000) << " of some compressible text\n";
+
+            const std::pair<int, GZIPDecompressorInputStream::Format> formats[]
+            {
+                { 0,                                                GZIPDecompressorInputStream::zlibFormat },
+                { GZIPCompressorOutputStream::windowBitsGZIP,       GZIPDecompressorInputStream::gzipFormat },
+                { GZIPCompressorOutputStream::windowBitsRaw,        GZIPDecompressorInputStream::deflateFormat }
+            };
+
+            for (auto [windowBits, format] : formats)
+            {
+                for (auto blockSize : { (size_t) 1024, (size_t) 50000, (size_t) 10000000 })
+                {
+                    auto level = rng.nextInt (10);
+                    MemoryOutputStream serial, parallel;
+
+                    {
+                        GZIPCompressorOutputStream zipper (serial, level, windowBits);
+                        zipper << original;
+                    }
+
+                    {
+                        GZIPCompressorOutputStream zipper (parallel, pool, level, windowBits, blockSize);
+
+                        // Write in uneven pieces, so that the writes don't line up with the blocks
+                        for (size_t pos = 0; pos < original.getDataSize();)
+                        {
+                            auto num = jmin ((size_t) rng.nextInt (7000), original.getDataSize() - pos);
+                            expect (zipper.write (static_cast<const char*> (original.getData()) + pos, num));
+                            pos += num;
+                        }
+                    }
+
+                    MemoryInputStream compressedInput (parallel.getData(), parallel.getDataSize(), false);
+                    GZIPDecompressorInputStream unzipper (&compressedInput, false, format);
+                    MemoryBlock uncompressed;
+                    unzipper.readIntoMemoryBlock (uncompressed);
+
+                    expect (uncompressed.matches (original.getData(), original.getDataSize()));
+
+                    // Priming each block with its predecessor's data should keep the overhead small
+                    if (blockSize > 1024 && level > 0)
+                        expect ((double) parallel.getDataSize() < (double) serial.getDataSize() * 1.05 + 64);
+                }
+            }
+        }
     }
 };
 
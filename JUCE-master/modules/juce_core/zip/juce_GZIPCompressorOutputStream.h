@@ -83,6 +83,32 @@ public:
                                 bool deleteDestStreamWhenDestroyed = false,
                                 int windowBits = 0);
 
+    /** Creates a compression stream which uses the threads of a ThreadPool to compress
+        several blocks of data at once.
+
+        The data is split into blocks of blockSize bytes, and each block is compressed as
+        a separate job, primed with the last 32K of the block before it, so the compression
+        ratio is only very slightly worse than with a single stream. The compressed blocks
+        are written out in order as they finish, along with the appropriate header and
+        checksum, so the result is a normal zlib, gzip or raw deflate stream which can be
+        read with a GZIPDecompressorInputStream or any other inflater.
+
+        The thread that writes to the stream helps out with any blocks that haven't been
+        started when it needs them, so this will still work if the pool's threads are busy.
+
+        @param destStream           the stream into which the compressed data will be written
+        @param pool                 the pool whose threads should compress the blocks
+        @param compressionLevel     how much to compress the data, as for the other constructors
+        @param windowBits           one of 0, windowBitsGZIP or windowBitsRaw, to select the
+                                    zlib, gzip or raw deflate format
+        @param blockSize            the number of bytes of input to compress in each job
+    */
+    GZIPCompressorOutputStream (OutputStream& destStream,
+                                ThreadPool& pool,
+                                int compressionLevel = -1,
+                                int windowBits = 0,
+                                size_t blockSize = 128 * 1024);
+
     /** Destructor. */
     ~GZIPCompressorOutputStream() override;
 
@@ -112,7 +138,9 @@ private:
     OptionalScopedPointer<OutputStream> destStream;
 
     class GZIPCompressorHelper;
+    class ParallelCompressorHelper;
     std::unique_ptr<GZIPCompressorHelper> helper;
+    std::unique_ptr<ParallelCompressorHelper> parallelHelper;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GZIPCompressorOutputStream)
 };
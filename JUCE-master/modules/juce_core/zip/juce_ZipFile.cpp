@@ -155,7 +155,12 @@ struct ZipFile::ZipInputStream final : public InputStream
           zipEntryHolder (zei),
           inputStream (zf.inputStream)
     {
-        if (zf.inputSource != nullptr)
+        if (zf.mappedFile != nullptr)
+        {
+            streamToDelete = std::make_unique<MemoryInputStream> (zf.mappedFile->getData(), zf.mappedFile->getSize(), false);
+            inputStream = streamToDelete.get();
+        }
+        else if (zf.inputSource != nullptr)
         {
             streamToDelete.reset (file.inputSource->createInputStream());
             inputStream = streamToDelete.get();
@@ -167,15 +172,28 @@ struct ZipFile::ZipInputStream final : public InputStream
            #endif
         }
 
-        char buffer[30];
+        auto readLocalHeader = [this]
+        {
+            char buffer[30];
+
+            if (inputStream != nullptr
+                 && inputStream->setPosition (zipEntryHolder.streamOffset)
+                 && inputStream->read (buffer, 30) == 30
+                 && ByteOrder::littleEndianInt (buffer) == 0x04034b50)
+            {
+                headerSize = 30 + ByteOrder::littleEndianShort (buffer + 26)
+                                + ByteOrder::littleEndianShort (buffer + 28);
+            }
+        };
 
-        if (inputStream != nullptr
-             && inputStream->setPosition (zei.streamOffset)
-             && inputStream->read (buffer, 30) == 30
-             && ByteOrder::littleEndianInt (buffer) == 0x04034b50)
+        if (inputStream == zf.inputStream)
+        {
+            const ScopedLock sl (zf.lock);
+            readLocalHeader();
+        }
+        else
         {
-            headerSize = 30 + ByteOrder::littleEndianShort (buffer + 26)
-                            + ByteOrder::littleEndianShort (buffer + 28);
+            readLocalHeader();
         }
     }
 
@@ -263,8 +281,13 @@ ZipFile::ZipFile (InputStream& stream)  : inputStream (&stream)
     init();
 }
 
-ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file))
+ZipFile::ZipFile (const File& file)
+    : inputSource (new FileInputSource (file)),
+      mappedFile (std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly))
 {
+    if (mappedFile->getData() == nullptr)
+        mappedFile.reset();
+
     init();
 }
 
@@ -329,6 +352,11 @@ InputStream* ZipFile::createStreamForEntry (const int index)
 
     if (auto* zei = entries[index])
     {
+        auto stored = getStoredEntryData (index);
+
+        if (! stored.empty())
+            return new MemoryInputStream (stored.data(), stored.size(), false);
+
         stream = new ZipInputStream (*this, *zei);
 
         if (zei->isCompressed)
@@ -354,6 +382,34 @@ InputStream* ZipFile::createStreamForEntry (const ZipEntry& entry)
     return nullptr;
 }
 
+Span<const std::byte> ZipFile::getStoredEntryData (int index) const
+{
+    auto* zei = entries[index];
+
+    if (zei == nullptr || zei->isCompressed || mappedFile == nullptr)
+        return {};
+
+    auto* data = static_cast<const char*> (mappedFile->getData());
+    auto dataSize = (int64) mappedFile->getSize();
+
+    if (zei->streamOffset + 30 > dataSize)
+        return {};
+
+    auto* localHeader = data + zei->streamOffset;
+
+    if (readUnalignedLittleEndianInt (localHeader) != 0x04034b50)
+        return {};
+
+    auto start = zei->streamOffset + 30
+                   + readUnalignedLittleEndianShort (localHeader + 26)
+                   + readUnalignedLittleEndianShort (localHeader + 28);
+
+    if (start + zei->compressedSize > dataSize)
+        return {};
+
+    return { reinterpret_cast<const std::byte*> (data + start), (size_t) zei->compressedSize };
+}
+
 void ZipFile::sortEntriesByFilename()
 {
     std::sort (entries.begin(), entries.end(),
@@ -366,7 +422,12 @@ void ZipFile::init()
     std::unique_ptr<InputStream> toDelete;
     InputStream* in = inputStream;
 
-    if (inputSource != nullptr)
+    if (mappedFile != nullptr)
+    {
+        in = new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false);
+        toDelete.reset (in);
+    }
+    else if (inputSource != nullptr)
     {
         in = inputSource->createInputStream();
         toDelete.reset (in);
@@ -424,6 +485,47 @@ Result ZipFile::uncompressTo (const File& targetDirectory,
     return Result::ok();
 }
 
+Result ZipFile::uncompressTo (const File& targetDirectory,
+                              ThreadPool& pool,
+                              const bool shouldOverwriteFiles)
+{
+    // Links are created once everything else has been written, so that a link can't
+    // appear in the middle of a path that another thread is about to write through.
+    Array<int> entriesToExpand, links;
+
+    for (int i = 0; i < entries.size(); ++i)
+        (entries.getUnchecked (i)->entry.isSymbolicLink ? links : entriesToExpand).add (i);
+
+    std::vector<Result> results ((size_t) entriesToExpand.size(), Result::ok());
+    std::atomic<bool> anyFailed { false };
+
+    parallelFor (pool, { 0, entriesToExpand.size() }, [&] (Range<int> chunk)
+    {
+        for (auto i = chunk.getStart(); i < chunk.getEnd(); ++i)
+        {
+            auto& result = results[(size_t) i];
+            result = uncompressEntry (entriesToExpand.getUnchecked (i), targetDirectory, shouldOverwriteFiles);
+
+            if (result.failed())
+                anyFailed = true;
+        }
+    }, ParallelForOptions().withChunkSize (1).withCancellationFlag (&anyFailed));
+
+    for (auto& result : results)
+        if (result.failed())
+            return result;
+
+    for (auto index : links)
+    {
+        auto result = uncompressEntry (index, targetDirectory, shouldOverwriteFiles);
+
+        if (result.failed())
+            return result;
+    }
+
+    return Result::ok();
+}
+
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool shouldOverwriteFiles)
 {
     return uncompressEntry (index,
@@ -451,7 +553,10 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, Overwri
         return Result::fail ("Entry " + entryPath + " is outside the target directory");
 
     if (entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\'))
+    {
+        const ScopedLock sl (directoryLock);
         return targetFile.createDirectory(); // (entry is a directory, not a file)
+    }
 
     std::unique_ptr<InputStream> in (createStreamForEntry (index));
 
@@ -467,11 +572,16 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, Overwri
             return Result::fail ("Failed to write to target file: " + targetFile.getFullPathName());
     }
 
-    if (followSymlinks == FollowSymlinks::no && hasSymbolicPart (targetDirectory, targetFile.getParentDirectory()))
-        return Result::fail ("Parent directory leads through symlink for target file: " + targetFile.getFullPathName());
+    {
+        // (this stops parallel calls from racing to create the same folders)
+        const ScopedLock sl (directoryLock);
+
+        if (followSymlinks == FollowSymlinks::no && hasSymbolicPart (targetDirectory, targetFile.getParentDirectory()))
+            return Result::fail ("Parent directory leads through symlink for target file: " + targetFile.getFullPathName());
 
-    if (! targetFile.getParentDirectory().createDirectory())
-        return Result::fail ("Failed to create target folder: " + targetFile.getParentDirectory().getFullPathName());
+        if (! targetFile.getParentDirectory().createDirectory())
+            return Result::fail ("Failed to create target folder: " + targetFile.getParentDirectory().getFullPathName());
+    }
 
     if (zei->entry.isSymbolicLink)
     {
@@ -688,7 +798,7 @@ struct ZIPTests final : public UnitTest
         : UnitTest ("ZIP", UnitTestCategories::compression)
     {}
 
-    static MemoryBlock createZipMemoryBlock (const StringArray& entryNames)
+    static MemoryBlock createZipMemoryBlock (const StringArray& entryNames, int compressionLevel = 9)
     {
         ZipFile::Builder builder;
         HashMap<String, MemoryBlock> blocks;
@@ -699,7 +809,7 @@ struct ZIPTests final : public UnitTest
             MemoryOutputStream mo (block, false);
             mo << entryName;
             mo.flush();
-            builder.addEntry (new MemoryInputStream (block, false), 9, entryName, Time::getCurrentTime());
+            builder.addEntry (new MemoryInputStream (block, false), compressionLevel, entryName, Time::getCurrentTime());
         }
 
         MemoryBlock data;
@@ -773,6 +883,97 @@ struct ZIPTests final : public UnitTest
 
         beginTest ("ZipSlip");
         runZipSlipTest();
+
+        beginTest ("Memory-mapped files");
+        runMappedFileTest();
+
+        beginTest ("Parallel extraction");
+        runParallelExtractionTest();
+    }
+
+    void runMappedFileTest()
+    {
+        StringArray entryNames { "stored", "dir/also stored" };
+
+        for (auto compressionLevel : { 0, 9 })
+        {
+            TemporaryFile zipFile (".zip");
+            auto data = createZipMemoryBlock (entryNames, compressionLevel);
+            expect (zipFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            ZipFile zip (zipFile.getFile());
+            expectEquals (zip.getNumEntries(), entryNames.size());
+
+            for (int i = 0; i < zip.getNumEntries(); ++i)
+            {
+                auto entryName = zip.getEntry (i)->filename;
+                auto stored = zip.getStoredEntryData (i);
+
+                expect (stored.empty() == (compressionLevel != 0));
+
+                if (! stored.empty())
+                    expectEquals (String::fromUTF8 (reinterpret_cast<const char*> (stored.data()), (int) stored.size()), entryName);
+
+                std::unique_ptr<InputStream> input (zip.createStreamForEntry (i));
+                expectEquals (input->readEntireStreamAsString(), entryName);
+            }
+        }
+    }
+
+    void runParallelExtractionTest()
+    {
+        StringArray entryNames;
+
+        for (int i = 0; i < 40; ++i)
+            entryNames.add ("folder" + String (i % 5) + "/sub" + String (i % 3) + "/file" + String (i));
+
+        ThreadPool pool (4);
+
+        for (auto compressionLevel : { 0, 9 })
+        {
+            TemporaryFile zipFile (".zip");
+            auto data = createZipMemoryBlock (entryNames, compressionLevel);
+            expect (zipFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            TemporaryFile tmpDir;
+            ZipFile zip (zipFile.getFile());
+            expect (zip.uncompressTo (tmpDir.getFile(), pool).wasOk());
+
+            for (auto& entryName : entryNames)
+                expectEquals (tmpDir.getFile().getChildFile (entryName).loadFileAsString(), entryName);
+
+            tmpDir.getFile().deleteRecursively();
+        }
+
+        {
+            // A user-supplied stream is shared between the threads, so this exercises the locking
+            auto data = createZipMemoryBlock (entryNames);
+            MemoryInputStream mi (data, false);
+            ZipFile zip (mi);
+
+            TemporaryFile tmpDir;
+            expect (zip.uncompressTo (tmpDir.getFile(), pool).wasOk());
+
+            for (auto& entryName : entryNames)
+                expectEquals (tmpDir.getFile().getChildFile (entryName).loadFileAsString(), entryName);
+
+            tmpDir.getFile().deleteRecursively();
+        }
+
+        {
+            StringArray namesWithEscape (entryNames);
+            namesWithEscape.add ("../outside");
+
+            auto data = createZipMemoryBlock (namesWithEscape);
+            MemoryInputStream mi (data, false);
+            ZipFile zip (mi);
+
+            TemporaryFile tmpDir;
+            tmpDir.getFile().createDirectory();
+            expect (zip.uncompressTo (tmpDir.getFile(), pool).failed());
+            expect (! tmpDir.getFile().getSiblingFile ("outside").exists());
+            tmpDir.getFile().deleteRecursively();
+        }
     }
 };
 
@@ -47,7 +47,13 @@ namespace juce
 class JUCE_API  ZipFile
 {
 public:
-    /** Creates a ZipFile to read a specific file. */
+    /** Creates a ZipFile to read a specific file.
+
+        If possible, the file is memory-mapped for as long as the ZipFile exists, so that
+        entry streams can read from it directly, without reopening the file or sharing a
+        lock, and entries that are stored without compression can be accessed in place
+        with getStoredEntryData().
+    */
     explicit ZipFile (const File& file);
 
     //==============================================================================
@@ -163,6 +169,18 @@ public:
     */
     InputStream* createStreamForEntry (const ZipEntry& entry);
 
+    /** If the zip file is memory-mapped and the given entry is stored without compression,
+        this returns the entry's content inside the mapped file.
+
+        This lets assets be used without copying or inflating them. The data remains valid
+        for as long as this ZipFile exists. For any other kind of entry, or if the file
+        isn't mapped, an empty span is returned, and you'll need to use
+        createStreamForEntry() instead.
+
+        @see ZipFile (const File&)
+    */
+    Span<const std::byte> getStoredEntryData (int index) const;
+
     //==============================================================================
     /** Uncompresses all of the files in the zip file.
 
@@ -176,6 +194,27 @@ public:
     Result uncompressTo (const File& targetDirectory,
                          bool shouldOverwriteFiles = true);
 
+    /** Uncompresses all of the files in the zip file, using the threads of a ThreadPool
+        to expand several entries at once.
+
+        This is much quicker than the single-threaded version when there are lots of large
+        compressed entries, particularly if the ZipFile was created from a File, in which
+        case every thread can read from the archive without waiting for the others.
+
+        Symbolic links are created after all the other entries have been expanded. If any
+        entry fails, the remaining entries are skipped, and the first failure (in the order
+        of the entries) is returned.
+
+        @param targetDirectory      the root folder to uncompress to
+        @param pool                 the pool whose threads should help with the work
+        @param shouldOverwriteFiles whether to overwrite existing files with similarly-named ones
+        @returns success if the file is successfully unzipped
+        @see parallelFor
+    */
+    Result uncompressTo (const File& targetDirectory,
+                         ThreadPool& pool,
+                         bool shouldOverwriteFiles = true);
+
     /** Uncompresses one of the entries from the zip file.
 
         This will expand the entry and write it in a target directory. The entry's path is used to
@@ -272,10 +311,11 @@ private:
     struct ZipEntryHolder;
 
     OwnedArray<ZipEntryHolder> entries;
-    CriticalSection lock;
+    CriticalSection lock, directoryLock;
     InputStream* inputStream = nullptr;
     std::unique_ptr<InputStream> streamToDelete;
     std::unique_ptr<InputSource> inputSource;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
@@ -283,7 +323,7 @@ private:
         OpenStreamCounter() = default;
         ~OpenStreamCounter();
 
-        int numOpenStreams = 0;
+        std::atomic<int> numOpenStreams { 0 };
     };
 
     OpenStreamCounter streamCounter;
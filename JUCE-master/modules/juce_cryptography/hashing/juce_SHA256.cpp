@@ -35,82 +35,229 @@
 namespace juce
 {
 
+#if JUCE_INTEL
+ #define JUCE_SHA256_USE_SHA_EXTENSIONS 1
+
+ #if JUCE_MSVC
+  #define JUCE_SHA_TARGET
+ #else
+  #define JUCE_SHA_TARGET __attribute__ ((target ("sha,sse4.1")))
+ #endif
+#elif JUCE_ARM && ! JUCE_MSVC && (defined (__ARM_FEATURE_SHA2) || defined (__ARM_FEATURE_CRYPTO))
+ #define JUCE_SHA256_USE_ARM_CRYPTO 1
+#endif
+
 struct SHA256Processor
 {
-    // expects 64 bytes of data
-    void processFullBlock (const void* data) noexcept
+    static constexpr uint32_t constants[] =
+    {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    // expects numBlocks * 64 bytes of data
+    static void processBlocksScalar (uint32_t* state, const uint8_t* d, size_t numBlocks) noexcept
     {
-        const uint32_t constants[] =
+        for (; numBlocks > 0; --numBlocks)
         {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-        };
-
-        uint32_t block[16], s[8];
-        memcpy (s, state, sizeof (s));
+            uint32_t block[16], s[8];
+            memcpy (s, state, sizeof (s));
 
-        auto d = static_cast<const uint8_t*> (data);
+            for (auto& b : block)
+            {
+                b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
+                d += 4;
+            }
 
-        for (auto& b : block)
+            auto convolve = [&] (uint32_t i, uint32_t j)
+            {
+                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
+                                     + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
+                                               : block[i]);
+                s[(3 - i) & 7] += s[(7 - i) & 7];
+                s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
+            };
+
+            for (uint32_t j = 0; j < 64; j += 16)
+                for (uint32_t i = 0; i < 16; ++i)
+                    convolve (i, j);
+
+            for (int i = 0; i < 8; ++i)
+                state[i] += s[i];
+        }
+    }
+
+   #if JUCE_SHA256_USE_SHA_EXTENSIONS
+    // Each call does four rounds, and works out the message words needed four rounds later
+    template <int i>
+    static forcedinline JUCE_SHA_TARGET void fourRoundsSHAExtensions (__m128i& abef, __m128i& cdgh, __m128i (&m)[4]) noexcept
+    {
+        auto msg = _mm_add_epi32 (m[i & 3], _mm_loadu_si128 (reinterpret_cast<const __m128i*> (constants + 4 * i)));
+        cdgh = _mm_sha256rnds2_epu32 (cdgh, abef, msg);
+
+        if constexpr (i >= 3 && i < 15)
         {
-            b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
-            d += 4;
+            auto& next = m[(i + 1) & 3];
+            next = _mm_add_epi32 (next, _mm_alignr_epi8 (m[i & 3], m[(i - 1) & 3], 4));
+            next = _mm_sha256msg2_epu32 (next, m[i & 3]);
         }
 
-        auto convolve = [&] (uint32_t i, uint32_t j)
+        abef = _mm_sha256rnds2_epu32 (abef, cdgh, _mm_shuffle_epi32 (msg, 0x0e));
+
+        if constexpr (i >= 1 && i < 13)
+            m[(i - 1) & 3] = _mm_sha256msg1_epu32 (m[(i - 1) & 3], m[i & 3]);
+    }
+
+    template <int... i>
+    static forcedinline JUCE_SHA_TARGET void allRoundsSHAExtensions (__m128i& abef, __m128i& cdgh, __m128i (&m)[4],
+                                                                     std::integer_sequence<int, i...>) noexcept
+    {
+        (fourRoundsSHAExtensions<i> (abef, cdgh, m), ...);
+    }
+
+    static JUCE_SHA_TARGET void processBlocksSHAExtensions (uint32_t* state, const uint8_t* d, size_t numBlocks) noexcept
+    {
+        const auto byteSwap = _mm_set_epi64x (0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+        // The instructions want the state arranged as ABEF and CDGH
+        auto dcba = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state)), 0xb1);
+        auto cdgh = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state + 4)), 0x1b);
+        auto abef = _mm_alignr_epi8 (dcba, cdgh, 8);
+        cdgh = _mm_blend_epi16 (cdgh, dcba, 0xf0);
+
+        for (; numBlocks > 0; --numBlocks)
         {
-            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
-                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
-                                           : block[i]);
-            s[(3 - i) & 7] += s[(7 - i) & 7];
-            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
-        };
+            const auto lastABEF = abef, lastCDGH = cdgh;
+            __m128i m[4];
 
-        for (uint32_t j = 0; j < 64; j += 16)
-            for (uint32_t i = 0; i < 16; ++i)
-                convolve (i, j);
+            for (auto& msg : m)
+            {
+                msg = _mm_shuffle_epi8 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (d)), byteSwap);
+                d += 16;
+            }
 
-        for (int i = 0; i < 8; ++i)
-            state[i] += s[i];
+            allRoundsSHAExtensions (abef, cdgh, m, std::make_integer_sequence<int, 16>());
+
+            abef = _mm_add_epi32 (abef, lastABEF);
+            cdgh = _mm_add_epi32 (cdgh, lastCDGH);
+        }
 
-        length += 64;
+        auto feba = _mm_shuffle_epi32 (abef, 0x1b);
+        auto dchg = _mm_shuffle_epi32 (cdgh, 0xb1);
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (state),     _mm_blend_epi16 (feba, dchg, 0xf0));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (state + 4), _mm_alignr_epi8 (dchg, feba, 8));
     }
 
-    void processFinalBlock (const void* data, uint32_t numBytes) noexcept
+    static bool canUseSHAExtensions() noexcept
     {
-        jassert (numBytes < 64);
+        static const bool canUse = SystemStats::hasSHA() && SystemStats::hasSSE41();
+        return canUse;
+    }
+   #endif
 
-        length += numBytes;
-        length *= 8; // (the length is stored as a count of bits, not bytes)
+   #if JUCE_SHA256_USE_ARM_CRYPTO
+    static void processBlocksARMCrypto (uint32_t* state, const uint8_t* d, size_t numBlocks) noexcept
+    {
+        auto abcd = vld1q_u32 (state);
+        auto efgh = vld1q_u32 (state + 4);
 
-        uint8_t finalBlocks[128];
+        for (; numBlocks > 0; --numBlocks)
+        {
+            const auto lastABCD = abcd, lastEFGH = efgh;
+            uint32x4_t m[4];
 
-        memcpy (finalBlocks, data, numBytes);
-        finalBlocks[numBytes++] = 128; // append a '1' bit
+            for (auto& msg : m)
+            {
+                msg = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (d)));
+                d += 16;
+            }
 
-        while (numBytes != 56 && numBytes < 64 + 56)
-            finalBlocks[numBytes++] = 0; // pad with zeros..
+            for (int i = 0; i < 16; ++i)
+            {
+                auto msg = vaddq_u32 (m[i & 3], vld1q_u32 (constants + 4 * i));
 
-        for (int i = 8; --i >= 0;)
-            finalBlocks[numBytes++] = (uint8_t) (length >> (i * 8)); // append the length.
+                if (i < 12)
+                    m[i & 3] = vsha256su1q_u32 (vsha256su0q_u32 (m[i & 3], m[(i + 1) & 3]), m[(i + 2) & 3], m[(i + 3) & 3]);
 
-        jassert (numBytes == 64 || numBytes == 128);
+                const auto previousABCD = abcd;
+                abcd = vsha256hq_u32 (abcd, efgh, msg);
+                efgh = vsha256h2q_u32 (efgh, previousABCD, msg);
+            }
 
-        processFullBlock (finalBlocks);
+            abcd = vaddq_u32 (abcd, lastABCD);
+            efgh = vaddq_u32 (efgh, lastEFGH);
+        }
+
+        vst1q_u32 (state, abcd);
+        vst1q_u32 (state + 4, efgh);
+    }
+   #endif
+
+    static void processBlocks (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+    {
+       #if JUCE_SHA256_USE_SHA_EXTENSIONS
+        if (canUseSHAExtensions())
+            return processBlocksSHAExtensions (state, data, numBlocks);
+       #elif JUCE_SHA256_USE_ARM_CRYPTO
+        return processBlocksARMCrypto (state, data, numBlocks);
+       #endif
+
+        processBlocksScalar (state, data, numBlocks);
+    }
+
+    //==============================================================================
+    void update (const void* data, size_t numBytes) noexcept
+    {
+        auto d = static_cast<const uint8_t*> (data);
+        length += numBytes;
+
+        if (numPending > 0)
+        {
+            auto numToCopy = jmin (numBytes, sizeof (pending) - numPending);
+            memcpy (pending + numPending, d, numToCopy);
+            numPending += numToCopy;
+            d += numToCopy;
+            numBytes -= numToCopy;
+
+            if (numPending < sizeof (pending))
+                return;
+
+            processBlocks (state, pending, 1);
+            numPending = 0;
+        }
+
+        auto numBlocks = numBytes / 64;
+        processBlocks (state, d, numBlocks);
+        d += numBlocks * 64;
+        numBytes -= numBlocks * 64;
 
-        if (numBytes > 64)
-            processFullBlock (finalBlocks + 64);
+        memcpy (pending, d, numBytes);
+        numPending = numBytes;
     }
 
-    void copyResult (uint8_t* result) const noexcept
+    void getResult (uint8_t* result) const noexcept
     {
-        for (auto s : state)
+        uint8_t finalBlocks[128] = {};
+        memcpy (finalBlocks, pending, numPending);
+        finalBlocks[numPending] = 128; // append a '1' bit
+
+        auto numBytes = numPending < 56 ? (size_t) 64 : (size_t) 128;
+        auto numBits = length * 8; // (the length is stored as a count of bits, not bytes)
+
+        for (size_t i = 0; i < 8; ++i)
+            finalBlocks[numBytes - 1 - i] = (uint8_t) (numBits >> (i * 8)); // append the length.
+
+        uint32_t finalState[8];
+        memcpy (finalState, state, sizeof (finalState));
+        processBlocks (finalState, finalBlocks, numBytes / 64);
+
+        for (auto s : finalState)
         {
             *result++ = (uint8_t) (s >> 24);
             *result++ = (uint8_t) (s >> 16);
@@ -119,33 +266,35 @@ struct SHA256Processor
         }
     }
 
-    void processStream (InputStream& input, int64_t numBytesToRead, uint8_t* result)
+    int64_t processStream (InputStream& input, int64_t numBytesToRead)
     {
         if (numBytesToRead < 0)
             numBytesToRead = std::numeric_limits<int64_t>::max();
 
-        for (;;)
+        constexpr int bufferSize = 65536;
+        HeapBlock<uint8_t> buffer (bufferSize);
+        int64_t totalRead = 0;
+
+        while (totalRead < numBytesToRead)
         {
-            uint8_t buffer[64];
-            auto bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64_t) sizeof (buffer)));
+            auto bytesRead = input.read (buffer, (int) jmin (numBytesToRead - totalRead, (int64_t) bufferSize));
 
-            if (bytesRead < (int) sizeof (buffer))
-            {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
+            if (bytesRead <= 0)
                 break;
-            }
 
-            numBytesToRead -= (int64_t) sizeof (buffer);
-            processFullBlock (buffer);
+            update (buffer, (size_t) bytesRead);
+            totalRead += bytesRead;
         }
 
-        copyResult (result);
+        return totalRead;
     }
 
 private:
     uint32_t state[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
                           0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
     uint64_t length = 0;
+    uint8_t pending[64] = {};
+    size_t numPending = 0;
 
     static uint32_t rotate (uint32_t x, uint32_t y) noexcept            { return (x >> y) | (x << (32 - y)); }
     static uint32_t ch  (uint32_t x, uint32_t y, uint32_t z) noexcept   { return z ^ ((y ^ z) & x); }
@@ -176,7 +325,8 @@ SHA256::SHA256 (const void* data, size_t numBytes)
 SHA256::SHA256 (InputStream& input, int64 numBytesToRead)
 {
     SHA256Processor processor;
-    processor.processStream (input, numBytesToRead, result);
+    processor.processStream (input, numBytesToRead);
+    processor.getResult (result);
 }
 
 SHA256::SHA256 (const File& file)
@@ -186,7 +336,8 @@ SHA256::SHA256 (const File& file)
     if (fin.getStatus().wasOk())
     {
         SHA256Processor processor;
-        processor.processStream (fin, -1, result);
+        processor.processStream (fin, -1);
+        processor.getResult (result);
     }
     else
     {
@@ -202,9 +353,55 @@ SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
 
 void SHA256::process (const void* data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     SHA256Processor processor;
-    processor.processStream (m, -1, result);
+    processor.update (data, numBytes);
+    processor.getResult (result);
+}
+
+std::vector<SHA256> SHA256::hashFiles (const Array<File>& files, int numThreads)
+{
+    std::vector<SHA256> results ((size_t) files.size());
+
+    if (numThreads <= 0)
+        numThreads = SystemStats::getNumCpus();
+
+    numThreads = jlimit (1, jmax (1, files.size()), numThreads);
+
+    std::atomic<int> nextIndex { 0 };
+
+    auto hashRemainingFiles = [&]
+    {
+        for (auto i = nextIndex++; i < files.size(); i = nextIndex++)
+            results[(size_t) i] = SHA256 (files.getReference (i));
+    };
+
+    if (numThreads > 1)
+    {
+        ThreadPool pool (ThreadPoolOptions{}.withThreadName ("SHA256 hasher")
+                                            .withNumberOfThreads (numThreads - 1));
+        std::atomic<int> numJobsRunning { numThreads - 1 };
+        WaitableEvent allJobsFinished;
+
+        for (int i = 1; i < numThreads; ++i)
+        {
+            pool.addJob ([&]
+            {
+                hashRemainingFiles();
+
+                if (--numJobsRunning == 0)
+                    allJobsFinished.signal();
+            });
+        }
+
+        hashRemainingFiles();
+        allJobsFinished.wait();
+    }
+    else
+    {
+        hashRemainingFiles();
+    }
+
+    return results;
 }
 
 MemoryBlock SHA256::getRawData() const
@@ -220,6 +417,43 @@ String SHA256::toHexString() const
 bool SHA256::operator== (const SHA256& other) const noexcept  { return memcmp (result, other.result, sizeof (result)) == 0; }
 bool SHA256::operator!= (const SHA256& other) const noexcept  { return ! operator== (other); }
 
+//==============================================================================
+struct SHA256::Hasher::Impl
+{
+    SHA256Processor processor;
+};
+
+SHA256::Hasher::Hasher() : impl (std::make_unique<Impl>()) {}
+SHA256::Hasher::~Hasher() = default;
+SHA256::Hasher::Hasher (const Hasher& other) : impl (std::make_unique<Impl> (*other.impl)) {}
+
+SHA256::Hasher& SHA256::Hasher::operator= (const Hasher& other)
+{
+    *impl = *other.impl;
+    return *this;
+}
+
+void SHA256::Hasher::update (const void* data, size_t numBytes) noexcept
+{
+    impl->processor.update (data, numBytes);
+}
+
+int64 SHA256::Hasher::update (InputStream& input, int64 maxBytesToRead)
+{
+    return impl->processor.processStream (input, maxBytesToRead);
+}
+
+SHA256 SHA256::Hasher::finalise() const noexcept
+{
+    SHA256 hash;
+    impl->processor.getResult (hash.result);
+    return hash;
+}
+
+void SHA256::Hasher::reset() noexcept
+{
+    impl->processor = {};
+}
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -258,6 +492,91 @@ public:
         test ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
         test ("The quick brown fox jumps over the lazy dog",  "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
         test ("The quick brown fox jumps over the lazy dog.", "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+        test ("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+        {
+            MemoryBlock million (1000000);
+            million.fillWith ('a');
+            expectEquals (SHA256 (million).toHexString(), String ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+        }
+
+        auto random = getRandom();
+
+        beginTest ("Accelerated block processing matches the portable version");
+        {
+            MemoryBlock data (64 * 50);
+            random.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (auto numBlocks : { (size_t) 1, (size_t) 2, (size_t) 7, (size_t) 50 })
+            {
+                uint32_t expected[8] = { 1, 2, 3, 4, 5, 6, 7, 8 }, actual[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+                SHA256Processor::processBlocksScalar (expected, static_cast<const uint8_t*> (data.getData()), numBlocks);
+                SHA256Processor::processBlocks (actual, static_cast<const uint8_t*> (data.getData()), numBlocks);
+                expect (std::equal (std::begin (expected), std::end (expected), std::begin (actual)));
+            }
+        }
+
+        beginTest ("Hasher");
+        {
+            MemoryBlock data (10000);
+            random.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (int i = 0; i < 20; ++i)
+            {
+                auto size = (size_t) random.nextInt (10000);
+                auto d = static_cast<const uint8*> (data.getData());
+
+                SHA256::Hasher hasher;
+
+                for (size_t pos = 0; pos < size;)
+                {
+                    auto n = jmin (size - pos, (size_t) random.nextInt (200));
+                    hasher.update (d + pos, n);
+                    pos += n;
+                }
+
+                expect (hasher.finalise() == SHA256 (d, size));
+                expect (hasher.finalise() == SHA256 (d, size));
+
+                auto copy = hasher;
+                copy.update (d + size, 1);
+                expect (copy.finalise() == SHA256 (d, size + 1));
+
+                hasher.reset();
+                MemoryInputStream stream (d, size, false);
+                expectEquals (hasher.update (stream), (int64) size);
+                expect (hasher.finalise() == SHA256 (d, size));
+            }
+        }
+
+        beginTest ("Hashing several files");
+        {
+            auto dir = File::createTempFile ("sha256_test");
+            dir.createDirectory();
+            Array<File> files;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                MemoryBlock data ((size_t) random.nextInt (200000));
+                random.fillBitsRandomly (data.getData(), data.getSize());
+                auto file = dir.getChildFile ("file" + String (i));
+                file.replaceWithData (data.getData(), data.getSize());
+                files.add (file);
+            }
+
+            files.add (dir.getChildFile ("nonexistent"));
+
+            auto hashes = SHA256::hashFiles (files, 3);
+            expectEquals ((int) hashes.size(), files.size());
+
+            for (int i = 0; i < files.size(); ++i)
+                expect (hashes[(size_t) i] == SHA256 (files[i]));
+
+            expect (hashes.back() == SHA256());
+            expect (SHA256::hashFiles ({}).empty());
+
+            dir.deleteRecursively();
+        }
     }
 };
 
@@ -43,6 +43,11 @@ namespace juce
     calculates the SHA-256 hash of that data.
 
     You can retrieve the hash as a raw 32-byte block, or as a 64-digit hex string.
+
+    If the data arrives in pieces, use a SHA256::Hasher to build the hash up
+    incrementally. On CPUs that support them, the Intel SHA extensions or the
+    ARMv8 cryptography instructions are used to do the work.
+
     @see MD5
 
     @tags{Cryptography}
@@ -94,6 +99,77 @@ public:
     */
     explicit SHA256 (CharPointer_UTF8 utf8Text) noexcept;
 
+    //==============================================================================
+    /** Hashes a set of files, using several threads to read and hash different files
+        at the same time.
+
+        The results are returned in the same order as the files. Any file that can't be
+        opened will have a hash full of zeros, as with the constructor that takes a File.
+
+        If numThreads is zero or less, one thread per CPU will be used.
+    */
+    static std::vector<SHA256> hashFiles (const Array<File>& files, int numThreads = 0);
+
+    //==============================================================================
+    /**
+        Calculates a SHA-256 hash from data that's supplied in a series of blocks.
+
+        This is useful when the data doesn't all fit in memory at once, or arrives
+        gradually, e.g.
+        @code
+        SHA256::Hasher hasher;
+
+        while (auto numRead = stream.read (buffer, bufferSize))
+            hasher.update (buffer, (size_t) numRead);
+
+        auto hash = hasher.finalise();
+        @endcode
+    */
+    class JUCE_API  Hasher
+    {
+    public:
+        /** Creates a Hasher that hasn't been given any data yet. */
+        Hasher();
+
+        /** Destructor. */
+        ~Hasher();
+
+        /** Creates a copy of another Hasher, including all the data it has been given. */
+        Hasher (const Hasher&);
+
+        /** Copies another Hasher, including all the data it has been given. */
+        Hasher& operator= (const Hasher&);
+
+        /** Appends a block of data to the hash. */
+        void update (const void* data, size_t numBytes) noexcept;
+
+        /** Reads from a stream and appends the data to the hash.
+
+            This will read from the stream until the stream is exhausted, or until
+            maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+            stream will be read.
+
+            @returns the number of bytes that were read
+        */
+        int64 update (InputStream& input, int64 maxBytesToRead = -1);
+
+        /** Returns the hash of all the data that has been passed to update().
+
+            This doesn't change the state of the Hasher, so you can carry on adding
+            more data afterwards if you need the hash of a longer sequence too.
+        */
+        SHA256 finalise() const noexcept;
+
+        /** Discards all the data that has been added so far. */
+        void reset() noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+
+        JUCE_LEAK_DETECTOR (Hasher)
+    };
+
     //==============================================================================
     /** Returns the hash as a 32-byte block of data. */
     MemoryBlock getRawData() const;
@@ -43,6 +43,12 @@
 
 #include "juce_cryptography.h"
 
+#if JUCE_INTEL
+ #include <immintrin.h>
+#elif JUCE_ARM && ! JUCE_MSVC && (defined (__ARM_FEATURE_SHA2) || defined (__ARM_FEATURE_CRYPTO))
+ #include <arm_neon.h>
+#endif
+
 #include "encryption/juce_BlowFish.cpp"
 #include "encryption/juce_Primes.cpp"
 #include "encryption/juce_RSAKey.cpp"
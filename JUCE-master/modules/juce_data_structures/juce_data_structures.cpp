@@ -46,6 +46,7 @@
 #include "values/juce_Value.cpp"
 #include "values/juce_ValueTree.cpp"
 #include "values/juce_ValueTreeSynchroniser.cpp"
+#include "values/juce_ValueTreeSnapshot.cpp"
 #include "values/juce_CachedValue.cpp"
 #include "undomanager/juce_UndoManager.cpp"
 #include "undomanager/juce_UndoableAction.cpp"
@@ -54,4 +55,5 @@
 
 #if JUCE_UNIT_TESTS
  #include "values/juce_ValueTreePropertyWithDefault_test.cpp"
+ #include "values/juce_ValueTreeSnapshot_test.cpp"
 #endif
@@ -71,6 +71,7 @@ struct UndoManager::ActionSet
     OwnedArray<UndoableAction> actions;
     String name;
     Time time { Time::getCurrentTime() };
+    uint32 lastActionTime = Time::getMillisecondCounter();
 };
 
 //==============================================================================
@@ -103,6 +104,17 @@ void UndoManager::setMaxNumberOfStoredUnits (int maxUnits, int minTransactions)
     minimumTransactionsToKeep  = jmax (1, minTransactions);
 }
 
+void UndoManager::setHardLimitOnStoredUnits (int maxUnits)
+{
+    hardLimitOnUnits = jmax (0, maxUnits);
+    dropOldTransactionsIfTooLarge();
+}
+
+void UndoManager::setCoalescingInterval (int milliseconds)
+{
+    coalescingIntervalMs = jmax (0, milliseconds);
+}
+
 //==============================================================================
 bool UndoManager::perform (UndoableAction* newAction, const String& actionName)
 {
@@ -132,29 +144,34 @@ bool UndoManager::perform (UndoableAction* newAction)
 
         if (action->perform())
         {
-            auto* actionSet = getCurrentSet();
-
-            if (actionSet != nullptr && ! newTransaction)
+            if (! (newTransaction && coalesceWithPreviousTransaction (*action)))
             {
-                if (auto* lastAction = actionSet->actions.getLast())
+                auto* actionSet = getCurrentSet();
+
+                if (actionSet != nullptr && ! newTransaction)
                 {
-                    if (auto coalescedAction = lastAction->createCoalescedAction (action.get()))
+                    if (auto* lastAction = actionSet->actions.getLast())
                     {
-                        action.reset (coalescedAction);
-                        totalUnitsStored -= lastAction->getSizeInUnits();
-                        actionSet->actions.removeLast();
+                        if (auto coalescedAction = lastAction->createCoalescedAction (action.get()))
+                        {
+                            action.reset (coalescedAction);
+                            totalUnitsStored -= lastAction->getSizeInUnits();
+                            actionSet->actions.removeLast();
+                        }
                     }
                 }
-            }
-            else
-            {
-                actionSet = new ActionSet (newTransactionName);
-                transactions.insert (nextIndex, actionSet);
-                ++nextIndex;
+                else
+                {
+                    actionSet = new ActionSet (newTransactionName);
+                    transactions.insert (nextIndex, actionSet);
+                    ++nextIndex;
+                }
+
+                totalUnitsStored += action->getSizeInUnits();
+                actionSet->actions.add (std::move (action));
+                actionSet->lastActionTime = Time::getMillisecondCounter();
             }
 
-            totalUnitsStored += action->getSizeInUnits();
-            actionSet->actions.add (std::move (action));
             newTransaction = false;
 
             moveFutureTransactionsToStash();
@@ -167,6 +184,35 @@ bool UndoManager::perform (UndoableAction* newAction)
     return false;
 }
 
+bool UndoManager::coalesceWithPreviousTransaction (UndoableAction& action)
+{
+    auto* actionSet = getCurrentSet();
+
+    if (coalescingIntervalMs <= 0
+         || actionSet == nullptr
+         || nextIndex < transactions.size()
+         || (newTransactionName.isNotEmpty() && newTransactionName != actionSet->name)
+         || Time::getMillisecondCounter() - actionSet->lastActionTime > (uint32) coalescingIntervalMs)
+        return false;
+
+    auto* lastAction = actionSet->actions.getLast();
+
+    if (lastAction == nullptr)
+        return false;
+
+    std::unique_ptr<UndoableAction> coalescedAction (lastAction->createCoalescedAction (&action));
+
+    if (coalescedAction == nullptr)
+        return false;
+
+    totalUnitsStored -= lastAction->getSizeInUnits();
+    actionSet->actions.removeLast();
+    totalUnitsStored += coalescedAction->getSizeInUnits();
+    actionSet->actions.add (std::move (coalescedAction));
+    actionSet->lastActionTime = Time::getMillisecondCounter();
+    return true;
+}
+
 void UndoManager::moveFutureTransactionsToStash()
 {
     if (nextIndex < transactions.size())
@@ -213,6 +259,18 @@ void UndoManager::dropOldTransactionsIfTooLarge()
         // consistent results from their getSizeInUnits() method
         jassert (totalUnitsStored >= 0);
     }
+
+    // The hard limit ignores minimumTransactionsToKeep, but never drops the open transaction
+    while (hardLimitOnUnits > 0
+            && nextIndex > 1
+            && totalUnitsStored > hardLimitOnUnits)
+    {
+        totalUnitsStored -= transactions.getFirst()->getTotalSize();
+        transactions.remove (0);
+        --nextIndex;
+
+        jassert (totalUnitsStored >= 0);
+    }
 }
 
 void UndoManager::beginNewTransaction()
@@ -375,4 +433,115 @@ int UndoManager::getNumActionsInCurrentTransaction() const
     return 0;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class UndoManagerTests final : public UnitTest
+{
+public:
+    UndoManagerTests()
+        : UnitTest ("UndoManager", UnitTestCategories::values)
+    {}
+
+    struct SetValueAction final : public UndoableAction
+    {
+        SetValueAction (int& v, int newVal, int size = 10)
+            : value (v), newValue (newVal), oldValue (v), sizeInUnits (size) {}
+
+        bool perform() override             { value = newValue; return true; }
+        bool undo() override                { value = oldValue; return true; }
+        int getSizeInUnits() override       { return sizeInUnits; }
+
+        UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
+        {
+            if (auto* next = dynamic_cast<SetValueAction*> (nextAction))
+                if (&next->value == &value)
+                    return new SetValueAction (value, oldValue, next->newValue, sizeInUnits);
+
+            return nullptr;
+        }
+
+        int& value;
+        const int newValue, oldValue, sizeInUnits;
+
+    private:
+        SetValueAction (int& v, int oldVal, int newVal, int size)
+            : value (v), newValue (newVal), oldValue (oldVal), sizeInUnits (size) {}
+    };
+
+    void runTest() override
+    {
+        beginTest ("Transactions are merged within the coalescing interval");
+        {
+            int value = 0, otherValue = 0;
+            UndoManager undoManager;
+            undoManager.setCoalescingInterval (60000);
+
+            for (int i = 1; i <= 1000; ++i)
+            {
+                undoManager.beginNewTransaction();
+                undoManager.perform (new SetValueAction (value, i));
+            }
+
+            expectEquals (value, 1000);
+            expectEquals (undoManager.getUndoDescriptions().size(), 1);
+            expectEquals (undoManager.getNumberOfUnitsTakenUpByStoredCommands(), 10);
+
+            undoManager.beginNewTransaction();
+            undoManager.perform (new SetValueAction (otherValue, 1));
+            expectEquals (undoManager.getUndoDescriptions().size(), 2);
+
+            undoManager.undo();
+            undoManager.undo();
+            expectEquals (value, 0);
+            expectEquals (otherValue, 0);
+
+            undoManager.redo();
+            expectEquals (value, 1000);
+        }
+
+        beginTest ("Transactions aren't merged by default");
+        {
+            int value = 0;
+            UndoManager undoManager;
+
+            for (int i = 1; i <= 10; ++i)
+            {
+                undoManager.beginNewTransaction();
+                undoManager.perform (new SetValueAction (value, i));
+            }
+
+            expectEquals (undoManager.getUndoDescriptions().size(), 10);
+        }
+
+        beginTest ("Hard limit overrides the minimum number of transactions");
+        {
+            int value = 0;
+            UndoManager undoManager (100, 30);
+
+            for (int i = 1; i <= 20; ++i)
+            {
+                undoManager.beginNewTransaction();
+                undoManager.perform (new SetValueAction (value, i, 50));
+            }
+
+            expectEquals (undoManager.getUndoDescriptions().size(), 20);
+
+            undoManager.setHardLimitOnStoredUnits (200);
+            expectEquals (undoManager.getUndoDescriptions().size(), 4);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() <= 200);
+
+            undoManager.beginNewTransaction();
+            undoManager.perform (new SetValueAction (value, 100, 1000));
+            expectEquals (undoManager.getUndoDescriptions().size(), 1);
+            expectEquals (value, 100);
+        }
+    }
+};
+
+static UndoManagerTests undoManagerTests;
+
+#endif
+
 } // namespace juce
@@ -106,6 +106,35 @@ public:
     void setMaxNumberOfStoredUnits (int maxNumberOfUnitsToKeep,
                                     int minimumTransactionsToKeep);
 
+    /** Sets a limit on the space used by stored UndoableAction objects that is enforced
+        even if it means keeping fewer than the minimum number of transactions passed to
+        setMaxNumberOfStoredUnits().
+
+        Older transactions are dropped until the total is below this limit, but the
+        transaction that is currently open is never dropped. JUCE's own actions report
+        their size in bytes, so for those this works as a memory budget. Pass 0 (the
+        default) to disable the limit.
+
+        @see setMaxNumberOfStoredUnits, getNumberOfUnitsTakenUpByStoredCommands
+    */
+    void setHardLimitOnStoredUnits (int maxNumberOfUnitsToKeep);
+
+    /** Allows actions that are performed soon after the previous transaction to be merged
+        into it.
+
+        Normally a call to beginNewTransaction() means the next action starts a new
+        transaction. If an interval is set here, and an action is performed within that many
+        milliseconds of the last action in the previous transaction, and the last action's
+        UndoableAction::createCoalescedAction() method is able to merge the two, then the
+        action is merged into the previous transaction instead.
+
+        This stops continuous gestures that begin a transaction for each small change, such
+        as dragging a slider, from filling the undo history with thousands of separate
+        transactions. Transactions that have been given different names are never merged.
+        Pass 0 (the default) to disable merging.
+    */
+    void setCoalescingInterval (int milliseconds);
+
     //==============================================================================
     /** Performs an action and adds it to the undo history list.
 
@@ -260,9 +289,11 @@ private:
     OwnedArray<ActionSet> transactions, stashedFutureTransactions;
     String newTransactionName;
     int totalUnitsStored = 0, maxNumUnitsToKeep = 0, minimumTransactionsToKeep = 0, nextIndex = 0;
+    int hardLimitOnUnits = 0, coalescingIntervalMs = 0;
     bool newTransaction = true, isInsideUndoRedoCall = false;
     ActionSet* getCurrentSet() const;
     ActionSet* getNextSet() const;
+    bool coalesceWithPreviousTransaction (UndoableAction&);
     void moveFutureTransactionsToStash();
     void restoreStashedFutureTransactions();
     void dropOldTransactionsIfTooLarge();
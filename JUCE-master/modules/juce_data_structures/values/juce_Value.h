@@ -231,7 +231,7 @@ private:
     //==============================================================================
     friend class ValueSource;
     ReferenceCountedObjectPtr<ValueSource> value;
-    ListenerList<Listener> listeners;
+    InlineListenerList<Listener> listeners;
 
     void callListeners();
     void removeFromListenerList();
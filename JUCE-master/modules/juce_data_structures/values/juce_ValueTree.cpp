@@ -35,6 +35,342 @@
 namespace juce
 {
 
+//==============================================================================
+/*  The format written by ValueTree::writeToCompactStream() is:
+
+    header  'J' 'V' 'T' 'C', a version byte, a compression byte, then the size of the
+            uncompressed body as a varint
+    body    the number of strings, then each string as a varint byte count followed by
+            its UTF-8 data, then the root node
+
+    node    the index of its type in the string table plus one (or zero for an invalid
+            tree), the number of properties, then a name index and value for each, then
+            the number of children, followed by each child node
+
+    value   a tag byte, followed by a zig-zag encoded varint for int and int64 values,
+            8 little-endian bytes for doubles, a byte count and UTF-8 data for strings,
+            or a byte count and the output of var::writeToStream() for anything else
+
+    All counts, lengths and indices are unsigned LEB128 varints.
+*/
+namespace CompactValueTreeFormat
+{
+    static constexpr uint8 magic[] = { 'J', 'V', 'T', 'C' };
+    static constexpr uint8 version = 1;
+    static constexpr int maxDepth = 1024;
+
+    // zlib can't compress by more than this, so anything claiming more is corrupt
+    static constexpr uint64 maxCompressionRatio = 1032;
+
+    enum Tag : uint8
+    {
+        tagVoid,
+        tagFalse,
+        tagTrue,
+        tagInt,
+        tagInt64,
+        tagDouble,
+        tagString,
+        tagOther
+    };
+
+    static void writeVarint (OutputStream& out, uint64 value)
+    {
+        uint8 buffer[10];
+        size_t numBytes = 0;
+
+        do
+        {
+            auto byte = (uint8) (value & 0x7f);
+            value >>= 7;
+            buffer[numBytes++] = (uint8) (byte | (value != 0 ? 0x80 : 0));
+        }
+        while (value != 0);
+
+        out.write (buffer, numBytes);
+    }
+
+    static uint64 zigZagEncode (int64 value) noexcept   { return ((uint64) value << 1) ^ (uint64) (value >> 63); }
+    static int64 zigZagDecode (uint64 value) noexcept   { return (int64) (value >> 1) ^ -(int64) (value & 1); }
+
+    //==============================================================================
+    struct Writer
+    {
+        explicit Writer (OutputStream& o) : out (o) {}
+
+        void addString (const Identifier& id)
+        {
+            if (indices.emplace (id.getCharPointer().getAddress(), (uint32) strings.size()).second)
+                strings.push_back (id);
+        }
+
+        uint32 getStringIndex (const Identifier& id) const
+        {
+            const auto it = indices.find (id.getCharPointer().getAddress());
+            jassert (it != indices.end());
+            return it->second;
+        }
+
+        void writeStringTable()
+        {
+            writeVarint (out, strings.size());
+
+            for (auto& s : strings)
+                writeUTF8 (s.toString());
+        }
+
+        void writeUTF8 (const String& s)
+        {
+            const auto numBytes = s.getNumBytesAsUTF8();
+            writeVarint (out, numBytes);
+            out.write (s.toRawUTF8(), numBytes);
+        }
+
+        void writeValue (const var& v)
+        {
+            if (v.isVoid())
+            {
+                out.writeByte ((char) tagVoid);
+            }
+            else if (v.isBool())
+            {
+                out.writeByte ((char) (static_cast<bool> (v) ? tagTrue : tagFalse));
+            }
+            else if (v.isInt())
+            {
+                out.writeByte ((char) tagInt);
+                writeVarint (out, zigZagEncode (static_cast<int> (v)));
+            }
+            else if (v.isInt64())
+            {
+                out.writeByte ((char) tagInt64);
+                writeVarint (out, zigZagEncode (static_cast<int64> (v)));
+            }
+            else if (v.isDouble())
+            {
+                out.writeByte ((char) tagDouble);
+                out.writeDouble (static_cast<double> (v));
+            }
+            else if (v.isString())
+            {
+                out.writeByte ((char) tagString);
+                writeUTF8 (v.toString());
+            }
+            else
+            {
+                MemoryOutputStream mo (64);
+                v.writeToStream (mo);
+
+                out.writeByte ((char) tagOther);
+                writeVarint (out, mo.getDataSize());
+                out.write (mo.getData(), mo.getDataSize());
+            }
+        }
+
+        OutputStream& out;
+        std::vector<Identifier> strings;
+        std::unordered_map<const void*, uint32> indices;
+    };
+
+    //==============================================================================
+    struct Reader
+    {
+        Reader (const void* data, size_t numBytes) noexcept
+            : pos (static_cast<const uint8*> (data)), end (pos + numBytes)
+        {
+        }
+
+        size_t getNumBytesRemaining() const noexcept    { return (size_t) (end - pos); }
+
+        uint64 readVarint() noexcept
+        {
+            uint64 result = 0;
+
+            for (int shift = 0; shift < 64 && pos < end; shift += 7)
+            {
+                const auto byte = *pos++;
+                result |= (uint64) (byte & 0x7f) << shift;
+
+                if ((byte & 0x80) == 0)
+                    return result;
+            }
+
+            failed = true;
+            return 0;
+        }
+
+        // Every item takes at least one byte, so any count bigger than the remaining
+        // data must be corrupt, and would otherwise cause a huge allocation
+        int readCount() noexcept
+        {
+            const auto count = readVarint();
+
+            if (count > getNumBytesRemaining())
+            {
+                failed = true;
+                return 0;
+            }
+
+            return (int) count;
+        }
+
+        const uint8* readBytes (size_t numBytes) noexcept
+        {
+            if (failed || numBytes > getNumBytesRemaining())
+            {
+                failed = true;
+                return nullptr;
+            }
+
+            return std::exchange (pos, pos + numBytes);
+        }
+
+        bool readUTF8 (CharPointer_UTF8& start, CharPointer_UTF8& finish) noexcept
+        {
+            const auto numBytes = (size_t) readVarint();
+            const auto* bytes = reinterpret_cast<const char*> (readBytes (numBytes));
+
+            if (bytes == nullptr || ! CharPointer_UTF8::isValidString (bytes, (int) numBytes))
+            {
+                failed = true;
+                return false;
+            }
+
+            start = CharPointer_UTF8 (bytes);
+            finish = CharPointer_UTF8 (bytes + numBytes);
+            return true;
+        }
+
+        bool readStringTable()
+        {
+            const auto numStrings = readCount();
+            strings.reserve ((size_t) numStrings);
+
+            for (int i = 0; i < numStrings && ! failed; ++i)
+            {
+                CharPointer_UTF8 start (nullptr), finish (nullptr);
+
+                if (! readUTF8 (start, finish) || start == finish)
+                    return false;
+
+               #if JUCE_STRING_UTF_TYPE == 8
+                strings.emplace_back (start, finish);
+               #else
+                strings.emplace_back (String (start, finish));
+               #endif
+            }
+
+            return ! failed;
+        }
+
+        const Identifier* readString() noexcept
+        {
+            const auto index = readVarint();
+
+            if (failed || index >= strings.size())
+            {
+                failed = true;
+                return nullptr;
+            }
+
+            return &strings[(size_t) index];
+        }
+
+        var readValue()
+        {
+            const auto* tag = readBytes (1);
+
+            if (tag == nullptr)
+                return {};
+
+            switch (*tag)
+            {
+                case tagVoid:   return {};
+                case tagFalse:  return false;
+                case tagTrue:   return true;
+                case tagInt:    return (int) zigZagDecode (readVarint());
+                case tagInt64:  return zigZagDecode (readVarint());
+
+                case tagDouble:
+                {
+                    if (const auto* bytes = readBytes (8))
+                    {
+                        auto bits = ByteOrder::littleEndianInt64 (bytes);
+                        double result;
+                        memcpy (&result, &bits, sizeof (result));
+                        return result;
+                    }
+
+                    return {};
+                }
+
+                case tagString:
+                {
+                    CharPointer_UTF8 start (nullptr), finish (nullptr);
+
+                    if (readUTF8 (start, finish))
+                        return String (start, finish);
+
+                    return {};
+                }
+
+                case tagOther:
+                {
+                    const auto numBytes = (size_t) readVarint();
+
+                    if (const auto* bytes = readBytes (numBytes))
+                    {
+                        MemoryInputStream in (bytes, numBytes, false);
+                        return var::readFromStream (in);
+                    }
+
+                    return {};
+                }
+
+                default:
+                    failed = true;
+                    return {};
+            }
+        }
+
+        const uint8* pos;
+        const uint8* end;
+        bool failed = false;
+        std::vector<Identifier> strings;
+    };
+}
+
+//==============================================================================
+struct ValueTree::ScopedTransaction::Pending
+{
+    struct Entry
+    {
+        Change::Type type;
+        ReferenceCountedObjectPtr<SharedObject> target, child;
+        Identifier property;
+        int oldIndex, newIndex;
+        Listener* listenerToExclude;
+    };
+
+    // A ValueTree with listeners that was an ancestor of a changed node when the
+    // change happened, along with the entries it needs to be told about
+    struct Recipient
+    {
+        ReferenceCountedObjectPtr<SharedObject> node;
+        ValueTree* tree;
+        std::vector<size_t> entries;
+    };
+
+    ReferenceCountedObjectPtr<SharedObject> root;
+    UndoManager* undoManager = nullptr;
+    std::vector<Entry> entries;
+    std::vector<Recipient> recipients;
+    std::map<std::pair<const SharedObject*, const ValueTree*>, size_t> recipientIndices;
+    std::map<std::pair<const SharedObject*, const void*>, size_t> propertyEntries;
+    OwnedArray<UndoableAction> actions;
+};
+
+//==============================================================================
 class ValueTree::SharedObject final : public ReferenceCountedObject
 {
 public:
@@ -101,26 +437,87 @@ public:
             t->callListeners (listenerToExclude, fn);
     }
 
+    bool recordChange (Change::Type changeType, const Identifier& property, SharedObject* child,
+                       int oldIndex, int newIndex, ValueTree::Listener* listenerToExclude)
+    {
+        auto* pending = getRoot().transaction;
+
+        if (pending == nullptr)
+            return false;
+
+        auto& entries = pending->entries;
+
+        if (changeType == Change::Type::propertyChanged)
+        {
+            const auto key = std::make_pair (static_cast<const SharedObject*> (this),
+                                             static_cast<const void*> (property.getCharPointer().getAddress()));
+            const auto existing = pending->propertyEntries.find (key);
+
+            if (existing != pending->propertyEntries.end())
+            {
+                auto& entry = entries[existing->second];
+
+                if (entry.listenerToExclude != listenerToExclude)
+                    entry.listenerToExclude = nullptr;
+
+                return true;
+            }
+
+            pending->propertyEntries.emplace (key, entries.size());
+        }
+
+        const auto entryIndex = entries.size();
+        entries.push_back ({ changeType, this, child, property, oldIndex, newIndex, listenerToExclude });
+
+        for (auto* t = this; t != nullptr; t = t->parent)
+        {
+            for (auto* v : t->valueTreesWithListeners)
+            {
+                const auto inserted = pending->recipientIndices.emplace (std::make_pair (static_cast<const SharedObject*> (t),
+                                                                                         static_cast<const ValueTree*> (v)),
+                                                                         pending->recipients.size());
+                if (inserted.second)
+                    pending->recipients.push_back ({ t, v, {} });
+
+                pending->recipients[inserted.first->second].entries.push_back (entryIndex);
+            }
+        }
+
+        return true;
+    }
+
     void sendPropertyChangeMessage (const Identifier& property, ValueTree::Listener* listenerToExclude = nullptr)
     {
+        if (recordChange (Change::Type::propertyChanged, property, nullptr, -1, -1, listenerToExclude))
+            return;
+
         ValueTree tree (*this);
         callListenersForAllParents (listenerToExclude, [&] (Listener& l) { l.valueTreePropertyChanged (tree, property); });
     }
 
     void sendChildAddedMessage (ValueTree child)
     {
+        if (recordChange (Change::Type::childAdded, {}, child.object.get(), -1, -1, nullptr))
+            return;
+
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [&] (Listener& l) { l.valueTreeChildAdded (tree, child); });
     }
 
     void sendChildRemovedMessage (ValueTree child, int index)
     {
+        if (recordChange (Change::Type::childRemoved, {}, child.object.get(), index, -1, nullptr))
+            return;
+
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [=, &tree, &child] (Listener& l) { l.valueTreeChildRemoved (tree, child, index); });
     }
 
     void sendChildOrderChangedMessage (int oldIndex, int newIndex)
     {
+        if (recordChange (Change::Type::childOrderChanged, {}, nullptr, oldIndex, newIndex, nullptr))
+            return;
+
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [=, &tree] (Listener& l) { l.valueTreeChildOrderChanged (tree, oldIndex, newIndex); });
     }
@@ -136,6 +533,37 @@ public:
         callListeners (nullptr, [&] (Listener& l) { l.valueTreeParentChanged (tree); });
     }
 
+    // Inside a transaction that uses the same UndoManager, actions are collected so that
+    // they can be added to the UndoManager as a single TransactionAction at the end
+    void performUndoableAction (UndoManager& undoManager, UndoableAction* newAction)
+    {
+        auto* pending = getRoot().transaction;
+
+        if (pending == nullptr || pending->undoManager != &undoManager)
+        {
+            undoManager.perform (newAction);
+            return;
+        }
+
+        std::unique_ptr<UndoableAction> action (newAction);
+
+        if (! action->perform())
+            return;
+
+        auto& actions = pending->actions;
+
+        if (auto* lastAction = actions.getLast())
+        {
+            if (auto* coalescedAction = lastAction->createCoalescedAction (action.get()))
+            {
+                action.reset (coalescedAction);
+                actions.removeLast();
+            }
+        }
+
+        actions.add (action.release());
+    }
+
     void setProperty (const Identifier& name, const var& newValue, UndoManager* undoManager,
                       ValueTree::Listener* listenerToExclude = nullptr)
     {
@@ -149,13 +577,13 @@ public:
             if (auto* existingValue = properties.getVarPointer (name))
             {
                 if (*existingValue != newValue)
-                    undoManager->perform (new SetPropertyAction (*this, name, newValue, *existingValue,
-                                                                 false, false, listenerToExclude));
+                    performUndoableAction (*undoManager, new SetPropertyAction (*this, name, newValue, *existingValue,
+                                                                                   false, false, listenerToExclude));
             }
             else
             {
-                undoManager->perform (new SetPropertyAction (*this, name, newValue, {},
-                                                             true, false, listenerToExclude));
+                performUndoableAction (*undoManager, new SetPropertyAction (*this, name, newValue, {},
+                                                                               true, false, listenerToExclude));
             }
         }
     }
@@ -175,7 +603,7 @@ public:
         else
         {
             if (properties.contains (name))
-                undoManager->perform (new SetPropertyAction (*this, name, {}, properties[name], false, true));
+                performUndoableAction (*undoManager, new SetPropertyAction (*this, name, {}, properties[name], false, true));
         }
     }
 
@@ -193,8 +621,8 @@ public:
         else
         {
             for (auto i = properties.size(); --i >= 0;)
-                undoManager->perform (new SetPropertyAction (*this, properties.getName (i), {},
-                                                             properties.getValueAt (i), false, true));
+                performUndoableAction (*undoManager, new SetPropertyAction (*this, properties.getName (i), {},
+                                                                               properties.getValueAt (i), false, true));
         }
     }
 
@@ -280,7 +708,7 @@ public:
                     if (! isPositiveAndBelow (index, children.size()))
                         index = children.size();
 
-                    undoManager->perform (new AddOrRemoveChildAction (*this, index, child));
+                    performUndoableAction (*undoManager, new AddOrRemoveChildAction (*this, index, child));
                 }
             }
             else
@@ -305,7 +733,7 @@ public:
             }
             else
             {
-                undoManager->perform (new AddOrRemoveChildAction (*this, childIndex, {}));
+                performUndoableAction (*undoManager, new AddOrRemoveChildAction (*this, childIndex, {}));
             }
         }
     }
@@ -334,7 +762,7 @@ public:
                 if (! isPositiveAndBelow (newIndex, children.size()))
                     newIndex = children.size() - 1;
 
-                undoManager->perform (new MoveChildAction (*this, currentIndex, newIndex));
+                performUndoableAction (*undoManager, new MoveChildAction (*this, currentIndex, newIndex));
             }
         }
     }
@@ -414,6 +842,67 @@ public:
         }
     }
 
+    //==============================================================================
+    void addStringsToCompactTable (CompactValueTreeFormat::Writer& writer) const
+    {
+        writer.addString (type);
+
+        for (auto& p : properties)
+            writer.addString (p.name);
+
+        for (auto* c : children)
+            c->addStringsToCompactTable (writer);
+    }
+
+    void writeToCompactStream (CompactValueTreeFormat::Writer& writer) const
+    {
+        CompactValueTreeFormat::writeVarint (writer.out, writer.getStringIndex (type) + 1);
+        CompactValueTreeFormat::writeVarint (writer.out, (uint64) properties.size());
+
+        for (auto& p : properties)
+        {
+            CompactValueTreeFormat::writeVarint (writer.out, writer.getStringIndex (p.name));
+            writer.writeValue (p.value);
+        }
+
+        CompactValueTreeFormat::writeVarint (writer.out, (uint64) children.size());
+
+        for (auto* c : children)
+            c->writeToCompactStream (writer);
+    }
+
+    static Ptr readFromCompactData (CompactValueTreeFormat::Reader& reader, int depth)
+    {
+        const auto typeIndex = reader.readVarint();
+
+        if (reader.failed || typeIndex == 0 || typeIndex > reader.strings.size() || depth > CompactValueTreeFormat::maxDepth)
+            return {};
+
+        Ptr result (new SharedObject (reader.strings[(size_t) typeIndex - 1]));
+
+        const auto numProps = reader.readCount();
+
+        for (int i = 0; i < numProps && ! reader.failed; ++i)
+            if (const auto* name = reader.readString())
+                result->properties.set (*name, reader.readValue());
+
+        const auto numChildren = reader.readCount();
+        result->children.ensureStorageAllocated (numChildren);
+
+        for (int i = 0; i < numChildren && ! reader.failed; ++i)
+        {
+            auto child = readFromCompactData (reader, depth + 1);
+
+            if (child == nullptr)
+                return {};
+
+            result->children.add (child);
+            child->parent = result.get();
+        }
+
+        return reader.failed ? nullptr : result;
+    }
+
     //==============================================================================
     struct SetPropertyAction final : public UndoableAction
     {
@@ -451,7 +940,18 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) (sizeof (*this) + getPayloadSize (newValue) + getPayloadSize (oldValue));
+        }
+
+        static size_t getPayloadSize (const var& v)
+        {
+            if (v.isString())
+                return v.toString().getNumBytesAsUTF8();
+
+            if (auto* block = v.getBinaryData())
+                return block->getSize();
+
+            return 0;
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
@@ -571,12 +1071,69 @@ public:
         JUCE_DECLARE_NON_COPYABLE (MoveChildAction)
     };
 
+    //==============================================================================
+    struct TransactionAction final : public UndoableAction
+    {
+        TransactionAction (Ptr rootObject, OwnedArray<UndoableAction>&& actionsToStore)
+            : root (std::move (rootObject)), actions (std::move (actionsToStore))
+        {
+        }
+
+        bool perform() override
+        {
+            // The actions have already been performed by the time the transaction is added
+            // to the UndoManager, so this only needs to do anything when redoing
+            if (! hasBeenPerformed)
+            {
+                hasBeenPerformed = true;
+                return true;
+            }
+
+            const ValueTree tree (root);
+            const ScopedTransaction transaction (tree);
+
+            for (auto* action : actions)
+                action->perform();
+
+            return true;
+        }
+
+        bool undo() override
+        {
+            const ValueTree tree (root);
+            const ScopedTransaction transaction (tree);
+
+            for (auto i = actions.size(); --i >= 0;)
+                actions.getUnchecked (i)->undo();
+
+            return true;
+        }
+
+        int getSizeInUnits() override
+        {
+            int total = (int) sizeof (*this);
+
+            for (auto* action : actions)
+                total += action->getSizeInUnits();
+
+            return total;
+        }
+
+    private:
+        const Ptr root;
+        OwnedArray<UndoableAction> actions;
+        bool hasBeenPerformed = false;
+
+        JUCE_DECLARE_NON_COPYABLE (TransactionAction)
+    };
+
     //==============================================================================
     const Identifier type;
     NamedValueSet properties;
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
     SharedObject* parent = nullptr;
+    ScopedTransaction::Pending* transaction = nullptr;
 
     JUCE_LEAK_DETECTOR (SharedObject)
 };
@@ -1101,6 +1658,96 @@ ValueTree ValueTree::readFromGZIPData (const void* data, size_t numBytes)
     return readFromStream (gzipStream);
 }
 
+void ValueTree::writeToCompactStream (OutputStream& output, CompactCompression compression) const
+{
+    using namespace CompactValueTreeFormat;
+
+    MemoryOutputStream body;
+    Writer writer (body);
+
+    if (object != nullptr)
+        object->addStringsToCompactTable (writer);
+
+    writer.writeStringTable();
+
+    if (object != nullptr)
+        object->writeToCompactStream (writer);
+    else
+        writeVarint (body, 0);
+
+    output.write (magic, sizeof (magic));
+    output.writeByte ((char) version);
+    output.writeByte ((char) compression);
+    writeVarint (output, body.getDataSize());
+
+    if (compression == CompactCompression::zlib)
+    {
+        GZIPCompressorOutputStream zipped (output);
+        zipped.write (body.getData(), body.getDataSize());
+    }
+    else
+    {
+        output.write (body.getData(), body.getDataSize());
+    }
+}
+
+bool ValueTree::isCompactData (const void* data, size_t numBytes) noexcept
+{
+    using namespace CompactValueTreeFormat;
+
+    return numBytes > sizeof (magic) + 2
+        && memcmp (data, magic, sizeof (magic)) == 0
+        && static_cast<const uint8*> (data)[sizeof (magic)] == version;
+}
+
+ValueTree ValueTree::readFromCompactData (const void* data, size_t numBytes)
+{
+    using namespace CompactValueTreeFormat;
+
+    if (! isCompactData (data, numBytes))
+        return {};
+
+    Reader header (static_cast<const uint8*> (data) + sizeof (magic) + 1, numBytes - sizeof (magic) - 1);
+    const auto compression = (CompactCompression) *header.readBytes (1);
+    const auto bodySize = header.readVarint();
+
+    if (header.failed)
+        return {};
+
+    MemoryBlock decompressed;
+    const void* body = header.pos;
+
+    if (compression == CompactCompression::zlib)
+    {
+        if (bodySize > header.getNumBytesRemaining() * maxCompressionRatio)
+            return {};
+
+        decompressed.setSize ((size_t) bodySize);
+
+        MemoryInputStream in (header.pos, header.getNumBytesRemaining(), false);
+        GZIPDecompressorInputStream unzipped (in);
+
+        if (unzipped.read (decompressed.getData(), (int) bodySize) != (int) bodySize)
+            return {};
+
+        body = decompressed.getData();
+    }
+    else if (compression != CompactCompression::none || bodySize > header.getNumBytesRemaining())
+    {
+        return {};
+    }
+
+    Reader reader (body, (size_t) bodySize);
+
+    if (! reader.readStringTable())
+        return {};
+
+    if (auto root = SharedObject::readFromCompactData (reader, 0))
+        return ValueTree (root);
+
+    return {};
+}
+
 void ValueTree::Listener::valueTreePropertyChanged   (ValueTree&, const Identifier&) {}
 void ValueTree::Listener::valueTreeChildAdded        (ValueTree&, ValueTree&)        {}
 void ValueTree::Listener::valueTreeChildRemoved      (ValueTree&, ValueTree&, int)   {}
@@ -1108,6 +1755,93 @@ void ValueTree::Listener::valueTreeChildOrderChanged (ValueTree&, int, int)
 void ValueTree::Listener::valueTreeParentChanged     (ValueTree&)                    {}
 void ValueTree::Listener::valueTreeRedirected        (ValueTree&)                    {}
 
+void ValueTree::Listener::valueTreeChangesBatched (ValueTree&, const Array<Change>& changes)
+{
+    for (auto& change : changes)
+    {
+        auto tree = change.tree;
+        auto child = change.child;
+
+        switch (change.type)
+        {
+            case Change::Type::propertyChanged:     valueTreePropertyChanged (tree, change.property); break;
+            case Change::Type::childAdded:          valueTreeChildAdded (tree, child); break;
+            case Change::Type::childRemoved:        valueTreeChildRemoved (tree, child, change.oldIndex); break;
+            case Change::Type::childOrderChanged:   valueTreeChildOrderChanged (tree, change.oldIndex, change.newIndex); break;
+        }
+    }
+}
+
+//==============================================================================
+ValueTree::ScopedTransaction::ScopedTransaction (const ValueTree& tree, UndoManager* undoManager)
+{
+    if (tree.object == nullptr)
+        return;
+
+    auto& root = tree.object->getRoot();
+
+    // If there's already a transaction on this tree, the changes just get added to that one
+    if (root.transaction != nullptr)
+        return;
+
+    pending = std::make_unique<Pending>();
+    pending->root = &root;
+    pending->undoManager = undoManager;
+    root.transaction = pending.get();
+}
+
+ValueTree::ScopedTransaction::~ScopedTransaction()
+{
+    if (pending == nullptr)
+        return;
+
+    const auto p = std::move (pending);
+    p->root->transaction = nullptr;
+
+    if (p->undoManager != nullptr && ! p->actions.isEmpty())
+        p->undoManager->perform (new SharedObject::TransactionAction (p->root, std::move (p->actions)));
+
+    Array<Change> changes;
+    Array<Listener*> excludedListeners;
+
+    for (auto& recipient : p->recipients)
+    {
+        changes.clearQuick();
+        excludedListeners.clearQuick();
+
+        for (auto index : recipient.entries)
+        {
+            auto& entry = p->entries[index];
+            changes.add ({ entry.type, ValueTree (entry.target), entry.property,
+                           entry.child != nullptr ? ValueTree (entry.child) : ValueTree(),
+                           entry.oldIndex, entry.newIndex });
+            excludedListeners.add (entry.listenerToExclude);
+        }
+
+        // The ValueTree may have been deleted or redirected by an earlier callback
+        if (! recipient.node->valueTreesWithListeners.contains (recipient.tree))
+            continue;
+
+        recipient.tree->listeners.call ([&] (Listener& l)
+        {
+            if (! excludedListeners.contains (&l))
+            {
+                l.valueTreeChangesBatched (*recipient.tree, changes);
+                return;
+            }
+
+            Array<Change> filtered;
+
+            for (auto [i, change] : enumerate (changes, int{}))
+                if (excludedListeners.getUnchecked (i) != &l)
+                    filtered.add (change);
+
+            if (! filtered.isEmpty())
+                l.valueTreeChangesBatched (*recipient.tree, filtered);
+        });
+    }
+}
+
 //==============================================================================
 #if JUCE_ALLOW_STATIC_NULL_VARIABLES
 
@@ -1220,6 +1954,44 @@ public:
             }
         }
 
+        {
+            beginTest ("Compact binary format");
+
+            auto r = getRandom();
+
+            for (int i = 10; --i >= 0;)
+            {
+                auto v1 = createRandomTree (nullptr, 0, r);
+                v1.setProperty ("int64", (int64) r.nextInt64(), nullptr);
+                v1.setProperty ("void", {}, nullptr);
+                v1.setProperty ("array", Array<var> { 1, "two", 3.0 }, nullptr);
+
+                for (auto compression : { ValueTree::CompactCompression::none, ValueTree::CompactCompression::zlib })
+                {
+                    MemoryOutputStream mo;
+                    v1.writeToCompactStream (mo, compression);
+
+                    expect (ValueTree::isCompactData (mo.getData(), mo.getDataSize()));
+                    expect (v1.isEquivalentTo (ValueTree::readFromCompactData (mo.getData(), mo.getDataSize())));
+
+                    // zlib can still produce the whole body if only its trailing checksum is missing
+                    const auto numBytesToTruncate = mo.getDataSize() - (compression == ValueTree::CompactCompression::zlib ? 8 : 0);
+
+                    for (size_t truncatedSize = 0; truncatedSize < numBytesToTruncate; truncatedSize += 1 + mo.getDataSize() / 16)
+                        expect (! ValueTree::readFromCompactData (mo.getData(), truncatedSize).isValid());
+                }
+
+                MemoryOutputStream legacy;
+                v1.writeToStream (legacy);
+                expect (! ValueTree::isCompactData (legacy.getData(), legacy.getDataSize()));
+            }
+
+            MemoryOutputStream empty;
+            ValueTree().writeToCompactStream (empty);
+            expect (ValueTree::isCompactData (empty.getData(), empty.getDataSize()));
+            expect (! ValueTree::readFromCompactData (empty.getData(), empty.getDataSize()).isValid());
+        }
+
         {
             beginTest ("Float formatting");
 
@@ -1252,11 +2024,167 @@ public:
                 expectEquals (lines[numLines - 1], "<Test number=\"" + test.second + "\"/>");
             }
         }
+
+        {
+            beginTest ("Batched transactions");
+
+            struct BatchListener final : public ValueTree::Listener
+            {
+                void valueTreeChangesBatched (ValueTree&, const Array<ValueTree::Change>& c) override
+                {
+                    ++numBatches;
+                    changes.addArray (c);
+                }
+
+                void valueTreePropertyChanged (ValueTree&, const Identifier&) override  { ++numImmediate; }
+                void valueTreeChildAdded (ValueTree&, ValueTree&) override              { ++numImmediate; }
+
+                int numBatches = 0, numImmediate = 0;
+                Array<ValueTree::Change> changes;
+            };
+
+            struct LegacyListener final : public ValueTree::Listener
+            {
+                void valueTreePropertyChanged (ValueTree&, const Identifier&) override  { ++numPropertyChanges; }
+                void valueTreeChildAdded (ValueTree&, ValueTree&) override              { ++numChildrenAdded; }
+
+                int numPropertyChanges = 0, numChildrenAdded = 0;
+            };
+
+            ValueTree root ("root");
+            BatchListener batchListener;
+            LegacyListener legacyListener;
+            root.addListener (&batchListener);
+            root.addListener (&legacyListener);
+
+            UndoManager undoManager;
+
+            {
+                const ValueTree::ScopedTransaction transaction (root, &undoManager);
+
+                for (int i = 0; i < 10; ++i)
+                {
+                    ValueTree child ("child");
+                    child.setProperty ("index", i, &undoManager);
+                    root.appendChild (child, &undoManager);
+                    child.setProperty ("index", i * 2, &undoManager);
+                    root.setProperty ("count", i + 1, &undoManager);
+                }
+
+                {
+                    const ValueTree::ScopedTransaction nested (root.getChild (0), &undoManager);
+                    root.getChild (0).setProperty ("nested", true, &undoManager);
+                }
+
+                expectEquals (batchListener.numBatches, 0);
+                expectEquals (legacyListener.numPropertyChanges, 0);
+            }
+
+            expectEquals (batchListener.numBatches, 1);
+            expectEquals (batchListener.numImmediate, 0);
+            expectEquals (batchListener.changes.size(), 10 + 9 + 1 + 1);
+            expectEquals (legacyListener.numChildrenAdded, 10);
+            expectEquals (legacyListener.numPropertyChanges, 9 + 1 + 1);
+            expectEquals ((int) root["count"], 10);
+            expectEquals ((int) root.getChild (9)["index"], 18);
+
+            expect (undoManager.canUndo());
+            undoManager.undo();
+            expect (! undoManager.canUndo());
+            expectEquals (root.getNumChildren(), 0);
+            expect (! root.hasProperty ("count"));
+            expectEquals (batchListener.numBatches, 2);
+
+            undoManager.redo();
+            expectEquals (root.getNumChildren(), 10);
+            expectEquals ((int) root["count"], 10);
+            expectEquals ((int) root.getChild (3)["index"], 6);
+            expect (root.getChild (0)["nested"]);
+            expectEquals (batchListener.numBatches, 3);
+
+            root.setProperty ("count", 0, nullptr);
+            expectEquals (batchListener.numImmediate, 1);
+            expectEquals (batchListener.numBatches, 3);
+        }
     }
 };
 
 static ValueTreeTests valueTreeTests;
 
+//==============================================================================
+class ValueTreeBenchmarks final : public BenchmarkTest
+{
+public:
+    ValueTreeBenchmarks()
+        : BenchmarkTest ("ValueTree benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    static ValueTree createTree()
+    {
+        ValueTree root ("Root");
+
+        for (int i = 0; i < 100; ++i)
+        {
+            ValueTree child ("Child");
+            child.setProperty ("index", i, nullptr);
+            child.setProperty ("name", "Child " + String (i), nullptr);
+            child.setProperty ("gain", i * 0.01, nullptr);
+            root.appendChild (child, nullptr);
+        }
+
+        return root;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Building");
+        {
+            benchmark ("Creating 100 children", []
+            {
+                doNotOptimise (createTree());
+            });
+        }
+
+        const auto tree = createTree();
+
+        beginTest ("Accessing");
+        {
+            const Identifier gain ("gain");
+
+            benchmark ("Reading 100 properties", [&]
+            {
+                double total = 0.0;
+
+                for (const auto& child : tree)
+                    total += (double) child[gain];
+
+                doNotOptimise (total);
+            });
+
+            benchmark ("Writing 100 properties", [&]
+            {
+                for (auto child : tree)
+                    child.setProperty (gain, 0.5, nullptr);
+            });
+        }
+
+        beginTest ("Serialising");
+        {
+            benchmark ("Copying deeply", [&]
+            {
+                doNotOptimise (tree.createCopy());
+            });
+
+            benchmark ("Writing XML", [&]
+            {
+                doNotOptimise (tree.toXmlString());
+            });
+        }
+    }
+};
+
+static ValueTreeBenchmarks valueTreeBenchmarks;
+
 #endif
 
 } // namespace juce
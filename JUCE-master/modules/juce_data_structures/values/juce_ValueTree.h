@@ -480,6 +480,49 @@ public:
     */
     static ValueTree readFromGZIPData (const void* data, size_t numBytes);
 
+    //==============================================================================
+    /** The types of compression that writeToCompactStream() can apply. */
+    enum class CompactCompression
+    {
+        none,
+        zlib
+    };
+
+    /** Stores this tree (and all its children) in a compact binary format.
+
+        Unlike writeToStream(), each type and property name is only written once, in a
+        table at the start of the data, and all counts and lengths are written as
+        variable-length integers. This makes the data smaller, and much faster to load
+        with readFromCompactData(), which is a good fit for large plugin states.
+
+        Data written by this method can't be read by readFromStream(), and vice-versa.
+        @see readFromCompactData, isCompactData
+    */
+    void writeToCompactStream (OutputStream& output,
+                               CompactCompression compression = CompactCompression::none) const;
+
+    /** Reloads a tree from a data block that was written with writeToCompactStream().
+
+        The data is parsed in place in a single pass, so the only allocations made are
+        for the nodes and values of the new tree. If the data was compressed, it's first
+        decompressed into one temporary block.
+
+        If the data is invalid, this returns an invalid tree.
+    */
+    static ValueTree readFromCompactData (const void* data, size_t numBytes);
+
+    /** Returns true if the given data looks like it was written by writeToCompactStream().
+        This can be used to tell the compact format apart from the one used by writeToStream(),
+        e.g. when loading a plugin state which may have been saved by an older version.
+    */
+    static bool isCompactData (const void* data, size_t numBytes) noexcept;
+
+    //==============================================================================
+    /** Describes a single change made during a ScopedTransaction.
+        @see Listener::valueTreeChangesBatched
+    */
+    struct Change;
+
     //==============================================================================
     /** Listener class for events that happen to a ValueTree.
 
@@ -544,6 +587,19 @@ public:
             will be made.
         */
         virtual void valueTreeRedirected (ValueTree& treeWhichHasBeenChanged);
+
+        /** This method is called at the end of a ScopedTransaction, with all the changes
+            that were made during it to the tree to which the listener is registered, or to
+            any of its children.
+
+            Repeated changes to the same property are coalesced into a single change. The
+            default implementation passes each change to the matching callback above, so
+            existing listeners carry on working, but you can override this to deal with a
+            large set of changes in one go.
+
+            @see ScopedTransaction
+        */
+        virtual void valueTreeChangesBatched (ValueTree& treeBeingListenedTo, const Array<Change>& changes);
     };
 
     /** Adds a listener to receive callbacks when this tree is changed in some way.
@@ -577,6 +633,48 @@ public:
     */
     void sendPropertyChangeMessage (const Identifier& property);
 
+    //==============================================================================
+    /** Defers the listener callbacks for changes made to a tree until the end of a scope.
+
+        While one of these exists, changes made to its tree and any of the tree's children
+        are recorded instead of being sent straight to listeners. When it's deleted, each
+        listener receives a single Listener::valueTreeChangesBatched() callback with all the
+        changes that affected it. This is much cheaper than sending a callback for each
+        change when making a large number of edits, such as pasting many nodes.
+
+        If an UndoManager is supplied, the undoable changes made with that UndoManager are
+        added to it as a single action when the transaction ends, and undoing or redoing
+        that action will also send batched callbacks.
+
+        Transactions can be nested, in which case the outermost one sends the callbacks.
+        Note that valueTreeParentChanged() callbacks aren't deferred.
+
+        @code
+        {
+            const ValueTree::ScopedTransaction transaction (tree, &undoManager);
+
+            for (auto& item : itemsToPaste)
+                tree.appendChild (item, &undoManager);
+        }
+        @endcode
+    */
+    class JUCE_API  ScopedTransaction
+    {
+    public:
+        /** Starts deferring callbacks for changes made to the root of the given tree. */
+        explicit ScopedTransaction (const ValueTree& tree, UndoManager* undoManager = nullptr);
+
+        /** Sends the deferred callbacks, and adds the recorded changes to the UndoManager. */
+        ~ScopedTransaction();
+
+    private:
+        friend class ValueTree;
+        struct Pending;
+        std::unique_ptr<Pending> pending;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTransaction)
+    };
+
     //==============================================================================
     /** This method uses a comparator object to sort the tree's children into order.
 
@@ -628,7 +726,7 @@ private:
     friend class SharedObject;
 
     ReferenceCountedObjectPtr<SharedObject> object;
-    ListenerList<Listener> listeners;
+    InlineListenerList<Listener> listeners;
 
     template <typename ElementComparator>
     struct ComparatorAdapter
@@ -652,4 +750,33 @@ private:
     explicit ValueTree (SharedObject&) noexcept;
 };
 
+//==============================================================================
+struct ValueTree::Change
+{
+    enum class Type
+    {
+        propertyChanged,
+        childAdded,
+        childRemoved,
+        childOrderChanged
+    };
+
+    Type type;
+
+    /** The tree whose property or children were changed. */
+    ValueTree tree;
+
+    /** For propertyChanged, the name of the property that changed. */
+    Identifier property;
+
+    /** For childAdded and childRemoved, the child that was added or removed. */
+    ValueTree child;
+
+    /** For childRemoved and childOrderChanged, the index that the child used to have. */
+    int oldIndex = -1;
+
+    /** For childOrderChanged, the child's new index. */
+    int newIndex = -1;
+};
+
 } // namespace juce
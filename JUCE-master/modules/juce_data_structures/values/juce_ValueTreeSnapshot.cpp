@@ -0,0 +1,319 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ValueTreeSnapshot::Node final : public ReferenceCountedObject
+{
+    using Ptr = ReferenceCountedObjectPtr<Node>;
+
+    explicit Node (const ValueTree& tree)
+        : type (tree.getType())
+    {
+        for (int i = 0; i < tree.getNumProperties(); ++i)
+        {
+            const auto name = tree.getPropertyName (i);
+            properties.set (name, tree.getProperty (name));
+        }
+
+        children.reserve ((size_t) tree.getNumChildren());
+    }
+
+    static Ptr createDeepCopy (const ValueTree& tree)
+    {
+        Ptr result (new Node (tree));
+
+        for (const auto& child : tree)
+            result->children.push_back (createDeepCopy (child));
+
+        return result;
+    }
+
+    const Identifier type;
+    NamedValueSet properties;
+    std::vector<Ptr> children;
+
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+//==============================================================================
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTree& tree)
+    : node (tree.isValid() ? Node::createDeepCopy (tree) : nullptr)
+{
+}
+
+ValueTreeSnapshot::ValueTreeSnapshot (ReferenceCountedObjectPtr<Node> n) noexcept  : node (std::move (n)) {}
+
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept = default;
+ValueTreeSnapshot::ValueTreeSnapshot (ValueTreeSnapshot&&) noexcept = default;
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (const ValueTreeSnapshot&) noexcept = default;
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (ValueTreeSnapshot&&) noexcept = default;
+ValueTreeSnapshot::~ValueTreeSnapshot() = default;
+
+Identifier ValueTreeSnapshot::getType() const noexcept
+{
+    return node != nullptr ? node->type : Identifier();
+}
+
+bool ValueTreeSnapshot::hasType (const Identifier& typeName) const noexcept
+{
+    return node != nullptr && node->type == typeName;
+}
+
+int ValueTreeSnapshot::getNumProperties() const noexcept
+{
+    return node != nullptr ? node->properties.size() : 0;
+}
+
+Identifier ValueTreeSnapshot::getPropertyName (int index) const noexcept
+{
+    return node != nullptr ? node->properties.getName (index) : Identifier();
+}
+
+const var& ValueTreeSnapshot::getProperty (const Identifier& name) const noexcept
+{
+    if (node != nullptr)
+        return node->properties[name];
+
+    static const var nullValue;
+    return nullValue;
+}
+
+var ValueTreeSnapshot::getProperty (const Identifier& name, const var& defaultReturnValue) const
+{
+    return node != nullptr ? node->properties.getWithDefault (name, defaultReturnValue)
+                           : defaultReturnValue;
+}
+
+bool ValueTreeSnapshot::hasProperty (const Identifier& name) const noexcept
+{
+    return node != nullptr && node->properties.contains (name);
+}
+
+int ValueTreeSnapshot::getNumChildren() const noexcept
+{
+    return node != nullptr ? (int) node->children.size() : 0;
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChild (int index) const noexcept
+{
+    if (node != nullptr && isPositiveAndBelow (index, node->children.size()))
+        return ValueTreeSnapshot (node->children[(size_t) index]);
+
+    return {};
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithName (const Identifier& type) const noexcept
+{
+    if (node != nullptr)
+        for (auto& child : node->children)
+            if (child->type == type)
+                return ValueTreeSnapshot (child);
+
+    return {};
+}
+
+ValueTree ValueTreeSnapshot::createValueTree() const
+{
+    if (node == nullptr)
+        return {};
+
+    ValueTree result (node->type);
+
+    for (auto& p : node->properties)
+        result.setProperty (p.name, p.value, nullptr);
+
+    for (auto i = 0; i < getNumChildren(); ++i)
+        result.appendChild (getChild (i).createValueTree(), nullptr);
+
+    return result;
+}
+
+//==============================================================================
+/*  The publisher keeps a tree of these alongside the ValueTree, each holding the
+    most recent snapshot of the corresponding node. A null snapshot means that the
+    node, or something below it, has changed since the last publish().
+*/
+struct ValueTreeSnapshotPublisher::MirrorNode
+{
+    explicit MirrorNode (const ValueTree& tree)
+    {
+        children.reserve ((size_t) tree.getNumChildren());
+
+        for (const auto& child : tree)
+            children.push_back (std::make_unique<MirrorNode> (child));
+    }
+
+    NodePtr update (const ValueTree& tree)
+    {
+        if (snapshot == nullptr)
+        {
+            // If this fails, the mirror has got out of step with the tree!
+            jassert ((int) children.size() == tree.getNumChildren());
+
+            NodePtr newNode (new ValueTreeSnapshot::Node (tree));
+
+            for (size_t i = 0; i < children.size(); ++i)
+                newNode->children.push_back (children[i]->update (tree.getChild ((int) i)));
+
+            snapshot = newNode;
+        }
+
+        return snapshot;
+    }
+
+    NodePtr snapshot;
+    std::vector<std::unique_ptr<MirrorNode>> children;
+};
+
+//==============================================================================
+ValueTreeSnapshotPublisher::ValueTreeSnapshotPublisher (const ValueTree& tree, bool publishAfterEveryChange)
+    : valueTree (tree),
+      mirror (std::make_unique<MirrorNode> (tree)),
+      autoPublish (publishAfterEveryChange)
+{
+    publish();
+    valueTree.addListener (this);
+}
+
+ValueTreeSnapshotPublisher::~ValueTreeSnapshotPublisher()
+{
+    valueTree.removeListener (this);
+}
+
+void ValueTreeSnapshotPublisher::publish()
+{
+    auto newRoot = valueTree.isValid() ? mirror->update (valueTree) : nullptr;
+
+    {
+        const SpinLock::ScopedLockType sl (publishedLock);
+
+        if (newRoot == published)
+            return;
+
+        std::swap (newRoot, published);
+    }
+
+    if (newRoot != nullptr)
+        retired.push_back (std::move (newRoot));
+
+    // Only release old roots once this is the last reference to them, so that
+    // nothing is ever deleted on a reader's thread
+    retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                   [] (const NodePtr& n) { return n->getReferenceCount() == 1; }),
+                   retired.end());
+}
+
+ValueTreeSnapshot ValueTreeSnapshotPublisher::getSnapshot() const noexcept
+{
+    const SpinLock::ScopedLockType sl (publishedLock);
+    return ValueTreeSnapshot (published);
+}
+
+ValueTreeSnapshotPublisher::MirrorNode* ValueTreeSnapshotPublisher::invalidatePathTo (const ValueTree& tree)
+{
+    Array<int> path;
+
+    for (auto t = tree; t != valueTree; t = t.getParent())
+    {
+        const auto parent = t.getParent();
+
+        if (! parent.isValid())
+            return nullptr;
+
+        path.add (parent.indexOf (t));
+    }
+
+    auto* m = mirror.get();
+    m->snapshot = nullptr;
+
+    for (int i = path.size(); --i >= 0;)
+    {
+        m = m->children[(size_t) path.getUnchecked (i)].get();
+        m->snapshot = nullptr;
+    }
+
+    return m;
+}
+
+void ValueTreeSnapshotPublisher::changed()
+{
+    if (autoPublish)
+        publish();
+}
+
+void ValueTreeSnapshotPublisher::valueTreePropertyChanged (ValueTree& tree, const Identifier&)
+{
+    if (invalidatePathTo (tree) != nullptr)
+        changed();
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildAdded (ValueTree& parent, ValueTree& child)
+{
+    if (auto* m = invalidatePathTo (parent))
+    {
+        const auto index = (size_t) parent.indexOf (child);
+        m->children.insert (m->children.begin() + (std::ptrdiff_t) index, std::make_unique<MirrorNode> (child));
+        changed();
+    }
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildRemoved (ValueTree& parent, ValueTree&, int index)
+{
+    if (auto* m = invalidatePathTo (parent))
+    {
+        m->children.erase (m->children.begin() + index);
+        changed();
+    }
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
+{
+    if (auto* m = invalidatePathTo (parent))
+    {
+        auto moved = std::move (m->children[(size_t) oldIndex]);
+        m->children.erase (m->children.begin() + oldIndex);
+        m->children.insert (m->children.begin() + newIndex, std::move (moved));
+        changed();
+    }
+}
+
+void ValueTreeSnapshotPublisher::valueTreeRedirected (ValueTree&)
+{
+    mirror = std::make_unique<MirrorNode> (valueTree);
+    changed();
+}
+
+} // namespace juce
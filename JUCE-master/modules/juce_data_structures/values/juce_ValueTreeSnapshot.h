@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An immutable copy of a ValueTree, which can be read safely from any thread.
+
+    Snapshots are cheap to copy, as they only hold a reference to a shared node.
+    Nodes that haven't changed between one snapshot and the next are shared rather
+    than copied, so you can also use isSameNodeAs() to quickly find out whether a
+    part of the tree has changed.
+
+    You'll normally get snapshots from a ValueTreeSnapshotPublisher, which keeps
+    them up to date as a ValueTree is edited.
+
+    Note that var objects such as DynamicObjects and arrays are shared with the
+    original tree rather than copied, so if you mutate those in place, readers of
+    the snapshot will see the changes.
+
+    @see ValueTreeSnapshotPublisher
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshot
+{
+public:
+    /** Creates an invalid snapshot. */
+    ValueTreeSnapshot() noexcept = default;
+
+    /** Creates a snapshot of the current state of a ValueTree.
+        This copies every node, so if you need to do this repeatedly, use a
+        ValueTreeSnapshotPublisher instead.
+    */
+    explicit ValueTreeSnapshot (const ValueTree& tree);
+
+    /** Creates a reference to the same node as another snapshot. */
+    ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept;
+
+    /** Creates a reference to the same node as another snapshot. */
+    ValueTreeSnapshot (ValueTreeSnapshot&&) noexcept;
+
+    /** Makes this refer to the same node as another snapshot. */
+    ValueTreeSnapshot& operator= (const ValueTreeSnapshot&) noexcept;
+
+    /** Makes this refer to the same node as another snapshot. */
+    ValueTreeSnapshot& operator= (ValueTreeSnapshot&&) noexcept;
+
+    /** Destructor. */
+    ~ValueTreeSnapshot();
+
+    //==============================================================================
+    /** Returns true if this snapshot refers to a node. */
+    bool isValid() const noexcept                               { return node != nullptr; }
+
+    /** Returns the type of this node. */
+    Identifier getType() const noexcept;
+
+    /** Returns true if this node has the given type. */
+    bool hasType (const Identifier& typeName) const noexcept;
+
+    /** Returns the number of properties of this node. */
+    int getNumProperties() const noexcept;
+
+    /** Returns the name of one of this node's properties. */
+    Identifier getPropertyName (int index) const noexcept;
+
+    /** Returns the value of a named property, or a void var if it doesn't exist. */
+    const var& getProperty (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property, or a default if it doesn't exist. */
+    var getProperty (const Identifier& name, const var& defaultReturnValue) const;
+
+    /** Returns true if this node has a property with the given name. */
+    bool hasProperty (const Identifier& name) const noexcept;
+
+    /** Returns the number of children this node has. */
+    int getNumChildren() const noexcept;
+
+    /** Returns one of this node's children, or an invalid snapshot if the index is out of range. */
+    ValueTreeSnapshot getChild (int index) const noexcept;
+
+    /** Returns the first child with the given type, or an invalid snapshot if there isn't one. */
+    ValueTreeSnapshot getChildWithName (const Identifier& type) const noexcept;
+
+    /** Returns true if both snapshots refer to exactly the same node.
+        Because unchanged nodes are shared between snapshots, this tells you that
+        nothing in this node or its children has changed between them.
+    */
+    bool isSameNodeAs (const ValueTreeSnapshot& other) const noexcept  { return node == other.node; }
+
+    /** Creates a new, independent ValueTree with the same contents as this snapshot. */
+    ValueTree createValueTree() const;
+
+private:
+    struct Node;
+    friend class ValueTreeSnapshotPublisher;
+
+    explicit ValueTreeSnapshot (ReferenceCountedObjectPtr<Node>) noexcept;
+
+    ReferenceCountedObjectPtr<Node> node;
+};
+
+//==============================================================================
+/**
+    Watches a ValueTree, and publishes immutable snapshots of it that other
+    threads can read.
+
+    The tree must only be edited on one thread, normally the message thread, and
+    that's also where publish() should be called. Each time it's called, the
+    nodes that changed, and their parents, are copied into a new snapshot, and
+    everything else is shared with the previous one. The new snapshot's root then
+    replaces the old one atomically.
+
+    Any thread can call getSnapshot() to get the latest root. Old snapshots are
+    kept alive by the publisher until nobody else is using them, and then released
+    during a later call to publish(). This means that a realtime thread holding a
+    root snapshot won't ever cause any memory to be freed when it lets go of it.
+    Keep hold of the root while you use its children, as a child snapshot doesn't
+    keep the root alive.
+
+    @code
+    // on the message thread
+    ValueTreeSnapshotPublisher publisher (document);
+
+    document.setProperty ("gain", 0.5f, nullptr);
+    publisher.publish();
+
+    // on the audio thread
+    const auto snapshot = publisher.getSnapshot();
+    const auto gain = (float) snapshot.getProperty ("gain");
+    @endcode
+
+    @see ValueTreeSnapshot
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshotPublisher  : private ValueTree::Listener
+{
+public:
+    /** Creates a publisher which watches the given tree, and publishes an initial snapshot of it.
+
+        If publishAfterEveryChange is true, a snapshot will be published each time the tree
+        changes. Otherwise, it's up to you to call publish() after making a set of changes.
+    */
+    explicit ValueTreeSnapshotPublisher (const ValueTree& tree, bool publishAfterEveryChange = false);
+
+    /** Destructor. */
+    ~ValueTreeSnapshotPublisher() override;
+
+    /** Publishes a snapshot of the current state of the tree, if it has changed since
+        the last one. This must be called on the thread that edits the tree.
+    */
+    void publish();
+
+    /** Returns the most recently published snapshot. This can be called from any thread. */
+    ValueTreeSnapshot getSnapshot() const noexcept;
+
+    /** Returns the tree that is being watched. */
+    const ValueTree& getValueTree() const noexcept       { return valueTree; }
+
+private:
+    struct MirrorNode;
+    using NodePtr = ReferenceCountedObjectPtr<ValueTreeSnapshot::Node>;
+
+    ValueTree valueTree;
+    std::unique_ptr<MirrorNode> mirror;
+    const bool autoPublish;
+
+    mutable SpinLock publishedLock;
+    NodePtr published;
+    std::vector<NodePtr> retired;
+
+    MirrorNode* invalidatePathTo (const ValueTree&);
+    void changed();
+
+    void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
+    void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+    void valueTreeRedirected (ValueTree&) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeSnapshotPublisher)
+};
+
+} // namespace juce
@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ValueTreeSnapshotTests final : public UnitTest
+{
+public:
+    ValueTreeSnapshotTests()
+        : UnitTest ("ValueTreeSnapshot", UnitTestCategories::values)
+    {}
+
+    static ValueTree createTree()
+    {
+        ValueTree root ("root");
+        root.setProperty ("name", "document", nullptr);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            ValueTree child ("child");
+            child.setProperty ("index", i, nullptr);
+            child.appendChild (ValueTree ("grandchild"), nullptr);
+            root.appendChild (child, nullptr);
+        }
+
+        return root;
+    }
+
+    void runTest() override
+    {
+        beginTest ("A snapshot has the same contents as its tree");
+        {
+            const auto tree = createTree();
+            const ValueTreeSnapshot snapshot (tree);
+
+            expect (snapshot.isValid());
+            expect (snapshot.hasType ("root"));
+            expectEquals (snapshot.getProperty ("name").toString(), String ("document"));
+            expectEquals (snapshot.getNumChildren(), 3);
+            expectEquals ((int) snapshot.getChild (2).getProperty ("index"), 2);
+            expect (! snapshot.getChild (3).isValid());
+            expect (snapshot.createValueTree().isEquivalentTo (tree));
+            expect (! ValueTreeSnapshot().isValid());
+        }
+
+        beginTest ("Snapshots don't change when the tree does");
+        {
+            auto tree = createTree();
+            ValueTreeSnapshotPublisher publisher (tree);
+            const auto before = publisher.getSnapshot();
+
+            tree.setProperty ("name", "changed", nullptr);
+            expect (publisher.getSnapshot().isSameNodeAs (before));
+
+            publisher.publish();
+            const auto after = publisher.getSnapshot();
+
+            expectEquals (before.getProperty ("name").toString(), String ("document"));
+            expectEquals (after.getProperty ("name").toString(), String ("changed"));
+        }
+
+        beginTest ("Only modified nodes and their parents are copied");
+        {
+            auto tree = createTree();
+            ValueTreeSnapshotPublisher publisher (tree);
+            const auto before = publisher.getSnapshot();
+
+            tree.getChild (1).getChild (0).setProperty ("x", 1, nullptr);
+            publisher.publish();
+            const auto after = publisher.getSnapshot();
+
+            expect (! after.isSameNodeAs (before));
+            expect (after.getChild (0).isSameNodeAs (before.getChild (0)));
+            expect (! after.getChild (1).isSameNodeAs (before.getChild (1)));
+            expect (after.getChild (2).isSameNodeAs (before.getChild (2)));
+            expect ((int) after.getChild (1).getChild (0).getProperty ("x") == 1);
+        }
+
+        beginTest ("Structural changes are published");
+        {
+            auto tree = createTree();
+            ValueTreeSnapshotPublisher publisher (tree, true);
+
+            tree.appendChild (ValueTree ("added"), nullptr);
+            expect (publisher.getSnapshot().getChild (3).hasType ("added"));
+
+            tree.moveChild (3, 0, nullptr);
+            tree.removeChild (1, nullptr);
+            tree.getChild (0).setProperty ("moved", true, nullptr);
+
+            const auto snapshot = publisher.getSnapshot();
+            expect (snapshot.createValueTree().isEquivalentTo (tree));
+            expect ((bool) snapshot.getChildWithName ("added").getProperty ("moved"));
+        }
+
+        beginTest ("Publishing without changes keeps the same root");
+        {
+            auto tree = createTree();
+            ValueTreeSnapshotPublisher publisher (tree);
+            const auto before = publisher.getSnapshot();
+
+            publisher.publish();
+            expect (publisher.getSnapshot().isSameNodeAs (before));
+        }
+
+        beginTest ("Snapshots can be read while the tree is being edited");
+        {
+            auto tree = createTree();
+            ValueTreeSnapshotPublisher publisher (tree);
+            std::atomic<bool> finished { false };
+            std::atomic<bool> consistent { true };
+
+            std::thread reader ([&]
+            {
+                while (! finished)
+                {
+                    const auto snapshot = publisher.getSnapshot();
+                    const auto count = (int) snapshot.getProperty ("count", 0);
+
+                    if (snapshot.getNumChildren() != 3 + count)
+                        consistent = false;
+                }
+            });
+
+            for (int i = 1; i <= 200; ++i)
+            {
+                tree.appendChild (ValueTree ("extra"), nullptr);
+                tree.setProperty ("count", i, nullptr);
+                publisher.publish();
+            }
+
+            finished = true;
+            reader.join();
+            expect (consistent);
+        }
+    }
+};
+
+static ValueTreeSnapshotTests valueTreeSnapshotTests;
+
+} // namespace juce
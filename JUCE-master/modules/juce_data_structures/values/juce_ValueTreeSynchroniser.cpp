@@ -44,7 +44,9 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        batch            = 7,
+        blobPatch        = 8
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -99,8 +101,467 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    static ValueTree findSubTree (ValueTree v, const Array<int>& path)
+    {
+        for (auto index : path)
+        {
+            if (! isPositiveAndBelow (index, v.getNumChildren()))
+                return {};
+
+            v = v.getChild (index);
+        }
+
+        return v;
+    }
 }
 
+//==============================================================================
+/*  A batch message contains a byte with the value 'batch', followed by:
+
+        - the number of paths, then each path as a count of levels and a child index for each
+        - the number of property names, then each name as a string
+        - the number of changes, then for each one a ChangeType byte, a path index, and:
+            propertyChanged:    a name index and the value
+            propertyRemoved:    a name index
+            blobPatch:          a name index, the number of bytes kept from the start and
+                                end of the previous block, then the size and data of the
+                                bytes that replace the rest
+            childAdded:         an index and the child tree
+            childRemoved:       an index
+            childMoved:         the old and new indexes
+
+    All numbers are written with writeCompressedInt().
+*/
+struct ValueTreeSynchroniser::SentBlobCache
+{
+    struct Entry
+    {
+        ValueTree tree;
+        Identifier property;
+        MemoryBlock lastSent;
+    };
+
+    Entry* find (const ValueTree& tree, const Identifier& property)
+    {
+        for (auto& e : entries)
+            if (e.tree == tree && e.property == property)
+                return &e;
+
+        return nullptr;
+    }
+
+    void remove (const ValueTree& tree, const Identifier& property)
+    {
+        entries.erase (std::remove_if (entries.begin(), entries.end(),
+                                       [&] (const Entry& e) { return e.tree == tree && e.property == property; }),
+                       entries.end());
+    }
+
+    void removeTreesWithin (const ValueTree& subTree)
+    {
+        entries.erase (std::remove_if (entries.begin(), entries.end(),
+                                       [&] (const Entry& e) { return e.tree == subTree || e.tree.isAChildOf (subTree); }),
+                       entries.end());
+    }
+
+    std::vector<Entry> entries;
+};
+
+struct ValueTreeSynchroniser::Batch
+{
+    using ChangeType = ValueTreeSynchroniserHelpers::ChangeType;
+
+    struct Change
+    {
+        ChangeType type;
+        int pathIndex, nameIndex;
+        ValueTree tree, child;
+        var value;
+        int index1, index2;
+    };
+
+    bool isEmpty() const noexcept    { return changes.empty(); }
+
+    void addPropertyChange (const ValueTree& root, const ValueTree& tree, const Identifier& property)
+    {
+        auto* value = tree.getPropertyPointer (property);
+        const auto type = value != nullptr ? ValueTreeSynchroniserHelpers::propertyChanged
+                                           : ValueTreeSynchroniserHelpers::propertyRemoved;
+        const auto pathIndex = getPathIndex (root, tree);
+        const auto nameIndex = getNameIndex (property);
+        const auto key = std::make_pair (pathIndex, nameIndex);
+
+        // No structural changes have been queued since the last change to this property,
+        // so the earlier change can just be updated with the latest value
+        if (const auto existing = latestPropertyChanges.find (key); existing != latestPropertyChanges.end())
+        {
+            auto& change = changes[existing->second];
+            change.type = type;
+            change.value = value != nullptr ? *value : var();
+            return;
+        }
+
+        latestPropertyChanges.emplace (key, changes.size());
+        changes.push_back ({ type, pathIndex, nameIndex, tree, {}, value != nullptr ? *value : var(), 0, 0 });
+    }
+
+    void addStructuralChange (const ValueTree& root, ChangeType type, const ValueTree& parent,
+                              const ValueTree& child, int index1, int index2)
+    {
+        var encodedChild;
+
+        if (type == ValueTreeSynchroniserHelpers::childAdded)
+        {
+            // The child has to be encoded now, as any later changes to it are sent separately
+            MemoryOutputStream m;
+            child.writeToStream (m);
+            encodedChild = m.getMemoryBlock();
+        }
+
+        latestPropertyChanges.clear();
+        changes.push_back ({ type, getPathIndex (root, parent), -1, parent, child, encodedChild, index1, index2 });
+    }
+
+    void writeTo (MemoryOutputStream& m, SentBlobCache* sentBlobs, size_t binaryDiffThreshold) const
+    {
+        m.writeByte ((char) ValueTreeSynchroniserHelpers::batch);
+
+        m.writeCompressedInt ((int) paths.size());
+
+        for (auto& path : paths)
+        {
+            m.writeCompressedInt ((int) path.size());
+
+            for (auto index : path)
+                m.writeCompressedInt (index);
+        }
+
+        m.writeCompressedInt (names.size());
+
+        for (auto& name : names)
+            m.writeString (name.toString());
+
+        m.writeCompressedInt ((int) changes.size());
+
+        for (auto& change : changes)
+        {
+            switch (change.type)
+            {
+                case ValueTreeSynchroniserHelpers::propertyChanged:
+                {
+                    if (sentBlobs != nullptr && writeBlobPatch (m, change, *sentBlobs, binaryDiffThreshold))
+                        break;
+
+                    writeChangeHeader (m, change);
+                    m.writeCompressedInt (change.nameIndex);
+                    change.value.writeToStream (m);
+                    break;
+                }
+
+                case ValueTreeSynchroniserHelpers::propertyRemoved:
+                    if (sentBlobs != nullptr)
+                        sentBlobs->remove (change.tree, names.getReference (change.nameIndex));
+
+                    writeChangeHeader (m, change);
+                    m.writeCompressedInt (change.nameIndex);
+                    break;
+
+                case ValueTreeSynchroniserHelpers::childAdded:
+                {
+                    if (sentBlobs != nullptr)
+                        sentBlobs->removeTreesWithin (change.child);
+
+                    writeChangeHeader (m, change);
+                    m.writeCompressedInt (change.index1);
+
+                    if (auto* data = change.value.getBinaryData())
+                        m << *data;
+
+                    break;
+                }
+
+                case ValueTreeSynchroniserHelpers::childRemoved:
+                    if (sentBlobs != nullptr)
+                        sentBlobs->removeTreesWithin (change.child);
+
+                    writeChangeHeader (m, change);
+                    m.writeCompressedInt (change.index1);
+                    break;
+
+                case ValueTreeSynchroniserHelpers::childMoved:
+                    writeChangeHeader (m, change);
+                    m.writeCompressedInt (change.index1);
+                    m.writeCompressedInt (change.index2);
+                    break;
+
+                case ValueTreeSynchroniserHelpers::fullSync:
+                case ValueTreeSynchroniserHelpers::batch:
+                case ValueTreeSynchroniserHelpers::blobPatch:
+                default:
+                    jassertfalse;
+                    break;
+            }
+        }
+    }
+
+    static bool apply (ValueTree& root, MemoryInputStream& input, UndoManager* undoManager)
+    {
+        const auto numPaths = input.readCompressedInt();
+
+        if (! isPositiveAndBelow (numPaths, 65536))
+            return false;
+
+        Array<Array<int>> pathTable;
+
+        for (int i = 0; i < numPaths; ++i)
+        {
+            const auto numLevels = input.readCompressedInt();
+
+            if (! isPositiveAndBelow (numLevels, 65536))
+                return false;
+
+            Array<int> path;
+
+            for (int j = 0; j < numLevels; ++j)
+                path.add (input.readCompressedInt());
+
+            pathTable.add (std::move (path));
+        }
+
+        const auto numNames = input.readCompressedInt();
+
+        if (! isPositiveAndBelow (numNames, 65536))
+            return false;
+
+        Array<Identifier> nameTable;
+
+        for (int i = 0; i < numNames; ++i)
+        {
+            const auto name = input.readString();
+
+            if (name.isEmpty())
+                return false;
+
+            nameTable.add (name);
+        }
+
+        const auto numChanges = input.readCompressedInt();
+
+        if (numChanges < 0)
+            return false;
+
+        const ValueTree::ScopedTransaction transaction (root, undoManager);
+
+        for (int i = 0; i < numChanges; ++i)
+        {
+            const auto type = (ChangeType) input.readByte();
+            const auto pathIndex = input.readCompressedInt();
+
+            if (! isPositiveAndBelow (pathIndex, pathTable.size()))
+                return false;
+
+            auto v = ValueTreeSynchroniserHelpers::findSubTree (root, pathTable.getReference (pathIndex));
+
+            if (! v.isValid())
+                return false;
+
+            if (! applyChange (v, type, input, nameTable, undoManager))
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    std::vector<Change> changes;
+    std::vector<std::vector<int>> paths;
+    std::map<std::vector<int>, int> pathIndices;
+    Array<Identifier> names;
+    std::map<std::pair<int, int>, size_t> latestPropertyChanges;
+
+    int getPathIndex (const ValueTree& root, const ValueTree& tree)
+    {
+        Array<int> reversedPath;
+        ValueTreeSynchroniserHelpers::getValueTreePath (tree, root, reversedPath);
+
+        std::vector<int> path (reversedPath.begin(), reversedPath.end());
+        std::reverse (path.begin(), path.end());
+
+        const auto inserted = pathIndices.emplace (path, (int) paths.size());
+
+        if (inserted.second)
+            paths.push_back (std::move (path));
+
+        return inserted.first->second;
+    }
+
+    int getNameIndex (const Identifier& name)
+    {
+        auto index = names.indexOf (name);
+
+        if (index < 0)
+        {
+            index = names.size();
+            names.add (name);
+        }
+
+        return index;
+    }
+
+    static void writeChangeHeader (MemoryOutputStream& m, const Change& change)
+    {
+        m.writeByte ((char) change.type);
+        m.writeCompressedInt (change.pathIndex);
+    }
+
+    bool writeBlobPatch (MemoryOutputStream& m, const Change& change,
+                         SentBlobCache& sentBlobs, size_t binaryDiffThreshold) const
+    {
+        auto* newBlock = change.value.getBinaryData();
+        const auto& name = names.getReference (change.nameIndex);
+
+        if (newBlock == nullptr || newBlock->getSize() < binaryDiffThreshold)
+        {
+            sentBlobs.remove (change.tree, name);
+            return false;
+        }
+
+        auto* previous = sentBlobs.find (change.tree, name);
+
+        if (previous == nullptr)
+        {
+            sentBlobs.entries.push_back ({ change.tree, name, *newBlock });
+            return false;
+        }
+
+        auto& oldBlock = previous->lastSent;
+        auto* oldData = static_cast<const uint8*> (oldBlock.getData());
+        auto* newData = static_cast<const uint8*> (newBlock->getData());
+        const auto oldSize = oldBlock.getSize(), newSize = newBlock->getSize();
+        const auto maxMatch = jmin (oldSize, newSize);
+
+        size_t prefix = 0;
+
+        while (prefix < maxMatch && oldData[prefix] == newData[prefix])
+            ++prefix;
+
+        size_t suffix = 0;
+
+        while (suffix < maxMatch - prefix && oldData[oldSize - 1 - suffix] == newData[newSize - 1 - suffix])
+            ++suffix;
+
+        const auto numChangedBytes = newSize - prefix - suffix;
+
+        m.writeByte ((char) ValueTreeSynchroniserHelpers::blobPatch);
+        m.writeCompressedInt (change.pathIndex);
+        m.writeCompressedInt (change.nameIndex);
+        m.writeCompressedInt ((int) prefix);
+        m.writeCompressedInt ((int) suffix);
+        m.writeCompressedInt ((int) numChangedBytes);
+        m.write (newData + prefix, numChangedBytes);
+
+        oldBlock = *newBlock;
+        return true;
+    }
+
+    static bool applyChange (ValueTree& v, ChangeType type, MemoryInputStream& input,
+                             const Array<Identifier>& nameTable, UndoManager* undoManager)
+    {
+        switch (type)
+        {
+            case ValueTreeSynchroniserHelpers::propertyChanged:
+            case ValueTreeSynchroniserHelpers::propertyRemoved:
+            case ValueTreeSynchroniserHelpers::blobPatch:
+            {
+                const auto nameIndex = input.readCompressedInt();
+
+                if (! isPositiveAndBelow (nameIndex, nameTable.size()))
+                    return false;
+
+                const auto& property = nameTable.getReference (nameIndex);
+
+                if (type == ValueTreeSynchroniserHelpers::propertyChanged)
+                {
+                    v.setProperty (property, var::readFromStream (input), undoManager);
+                    return true;
+                }
+
+                if (type == ValueTreeSynchroniserHelpers::propertyRemoved)
+                {
+                    v.removeProperty (property, undoManager);
+                    return true;
+                }
+
+                const auto prefix = input.readCompressedInt();
+                const auto suffix = input.readCompressedInt();
+                const auto numChangedBytes = input.readCompressedInt();
+                auto* oldBlock = v.getPropertyPointer (property) != nullptr ? v[property].getBinaryData() : nullptr;
+
+                if (oldBlock == nullptr || prefix < 0 || suffix < 0 || numChangedBytes < 0
+                     || (size_t) prefix + (size_t) suffix > oldBlock->getSize()
+                     || (int64) numChangedBytes > input.getNumBytesRemaining())
+                {
+                    jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                    return false;
+                }
+
+                MemoryBlock newBlock ((size_t) prefix + (size_t) numChangedBytes + (size_t) suffix);
+                newBlock.copyFrom (oldBlock->getData(), 0, (size_t) prefix);
+                input.read (addBytesToPointer (newBlock.getData(), prefix), numChangedBytes);
+                newBlock.copyFrom (addBytesToPointer (oldBlock->getData(), oldBlock->getSize() - (size_t) suffix),
+                                   prefix + numChangedBytes, (size_t) suffix);
+                v.setProperty (property, std::move (newBlock), undoManager);
+                return true;
+            }
+
+            case ValueTreeSynchroniserHelpers::childAdded:
+            {
+                const int index = input.readCompressedInt();
+                v.addChild (ValueTree::readFromStream (input), index, undoManager);
+                return true;
+            }
+
+            case ValueTreeSynchroniserHelpers::childRemoved:
+            {
+                const int index = input.readCompressedInt();
+
+                if (isPositiveAndBelow (index, v.getNumChildren()))
+                {
+                    v.removeChild (index, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                return false;
+            }
+
+            case ValueTreeSynchroniserHelpers::childMoved:
+            {
+                const int oldIndex = input.readCompressedInt();
+                const int newIndex = input.readCompressedInt();
+
+                if (isPositiveAndBelow (oldIndex, v.getNumChildren())
+                     && isPositiveAndBelow (newIndex, v.getNumChildren()))
+                {
+                    v.moveChild (oldIndex, newIndex, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                return false;
+            }
+
+            case ValueTreeSynchroniserHelpers::fullSync:
+            case ValueTreeSynchroniserHelpers::batch:
+            default:
+                jassertfalse; // Seem to have received some corrupt data?
+                return false;
+        }
+    }
+};
+
+//==============================================================================
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
 {
     valueTree.addListener (this);
@@ -113,14 +574,90 @@ ValueTreeSynchroniser::~ValueTreeSynchroniser()
 
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    // Anything that was queued is included in the full state
+    if (batch != nullptr)
+        batch = std::make_unique<Batch>();
+
+    if (sentBlobs != nullptr)
+        sentBlobs->entries.clear();
+
+    stopFlushTimer();
+
     MemoryOutputStream m;
     writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
     valueTree.writeToStream (m);
     stateChanged (m.getData(), m.getDataSize());
 }
 
+void ValueTreeSynchroniser::setFlushInterval (int intervalMs)
+{
+    jassert (intervalMs >= 0);
+
+    flushIntervalMs = jmax (0, intervalMs);
+
+    if (flushIntervalMs == 0)
+    {
+        flush();
+        batch.reset();
+        flushTimer.reset();
+        return;
+    }
+
+    if (batch == nullptr)
+        batch = std::make_unique<Batch>();
+
+    // The timer is only created when batching is used, so that synchronisers which send
+    // their changes immediately don't need a message thread
+    if (flushTimer == nullptr)
+        flushTimer = std::make_unique<TimedCallback> ([this] { flush(); });
+    else if (flushTimer->isTimerRunning())
+        flushTimer->startTimer (flushIntervalMs);
+}
+
+void ValueTreeSynchroniser::setBinaryDiffThreshold (size_t minimumBlockSize)
+{
+    binaryDiffThreshold = minimumBlockSize;
+
+    if (minimumBlockSize == 0)
+        sentBlobs.reset();
+    else if (sentBlobs == nullptr)
+        sentBlobs = std::make_unique<SentBlobCache>();
+}
+
+void ValueTreeSynchroniser::flush()
+{
+    stopFlushTimer();
+
+    if (batch == nullptr || batch->isEmpty())
+        return;
+
+    MemoryOutputStream m;
+    batch->writeTo (m, sentBlobs.get(), binaryDiffThreshold);
+    batch = std::make_unique<Batch>();
+    stateChanged (m.getData(), m.getDataSize());
+}
+
+void ValueTreeSynchroniser::startFlushTimer()
+{
+    if (flushTimer != nullptr && ! flushTimer->isTimerRunning())
+        flushTimer->startTimer (flushIntervalMs);
+}
+
+void ValueTreeSynchroniser::stopFlushTimer()
+{
+    if (flushTimer != nullptr)
+        flushTimer->stopTimer();
+}
+
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
+    if (batch != nullptr)
+    {
+        batch->addPropertyChange (valueTree, vt, property);
+        startFlushTimer();
+        return;
+    }
+
     MemoryOutputStream m;
 
     if (auto* value = vt.getPropertyPointer (property))
@@ -143,6 +680,13 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     const int index = parentTree.indexOf (childTree);
     jassert (index >= 0);
 
+    if (batch != nullptr)
+    {
+        batch->addStructuralChange (valueTree, ValueTreeSynchroniserHelpers::childAdded, parentTree, childTree, index, 0);
+        startFlushTimer();
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
@@ -150,8 +694,15 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     stateChanged (m.getData(), m.getDataSize());
 }
 
-void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
+void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree& childTree, int oldIndex)
 {
+    if (batch != nullptr)
+    {
+        batch->addStructuralChange (valueTree, ValueTreeSynchroniserHelpers::childRemoved, parentTree, childTree, oldIndex, 0);
+        startFlushTimer();
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
@@ -160,6 +711,13 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
 {
+    if (batch != nullptr)
+    {
+        batch->addStructuralChange (valueTree, ValueTreeSynchroniserHelpers::childMoved, parent, {}, oldIndex, newIndex);
+        startFlushTimer();
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
@@ -179,6 +737,9 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
+    if (type == ValueTreeSynchroniserHelpers::batch)
+        return Batch::apply (root, input, undoManager);
+
     ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
 
     if (! v.isValid())
@@ -238,6 +799,8 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         }
 
         case ValueTreeSynchroniserHelpers::fullSync:
+        case ValueTreeSynchroniserHelpers::batch:
+        case ValueTreeSynchroniserHelpers::blobPatch:
             break;
 
         default:
@@ -248,4 +811,142 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
     return false;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSynchroniserTests final : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests()
+        : UnitTest ("ValueTreeSynchroniser", UnitTestCategories::values)
+    {}
+
+    struct Sender final : public ValueTreeSynchroniser
+    {
+        using ValueTreeSynchroniser::ValueTreeSynchroniser;
+
+        void stateChanged (const void* data, size_t size) override
+        {
+            messages.add (MemoryBlock (data, size));
+        }
+
+        Array<MemoryBlock> messages;
+    };
+
+    static bool applyAll (ValueTree& target, const Array<MemoryBlock>& messages)
+    {
+        for (auto& m : messages)
+            if (! ValueTreeSynchroniser::applyChange (target, m.getData(), m.getSize(), nullptr))
+                return false;
+
+        return true;
+    }
+
+    static size_t getTotalSize (const Array<MemoryBlock>& messages)
+    {
+        size_t total = 0;
+
+        for (auto& m : messages)
+            total += m.getSize();
+
+        return total;
+    }
+
+    static void makeChanges (ValueTree& source)
+    {
+        for (int i = 0; i < 5; ++i)
+            source.appendChild (ValueTree ("child", { { "index", i } }), nullptr);
+
+        for (int i = 0; i < 100; ++i)
+            source.getChild (i % 5).getOrCreateChildWithName ("gain", nullptr).setProperty ("value", i, nullptr);
+
+        source.getChild (2).removeProperty ("index", nullptr);
+        source.moveChild (0, 4, nullptr);
+        source.removeChild (1, nullptr);
+        source.getChild (0).setProperty ("index", 42, nullptr);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Immediate changes");
+        {
+            ValueTree source ("root"), target;
+            Sender sender (source);
+            sender.sendFullSyncCallback();
+            makeChanges (source);
+
+            expect (applyAll (target, sender.messages));
+            expect (target.isEquivalentTo (source));
+        }
+
+        beginTest ("Batched changes");
+        {
+            // The flush timer needs a message thread
+            ScopedJuceInitialiser_GUI libraryInitialiser;
+
+            ValueTree source ("root"), target, unbatchedSource ("root");
+            Sender sender (source), unbatchedSender (unbatchedSource);
+            sender.sendFullSyncCallback();
+            expect (applyAll (target, sender.messages));
+            sender.messages.clear();
+
+            sender.setFlushInterval (1000);
+            makeChanges (source);
+            makeChanges (unbatchedSource);
+            expect (sender.messages.isEmpty());
+
+            sender.flush();
+            expectEquals (sender.messages.size(), 1);
+            expect (getTotalSize (sender.messages) < getTotalSize (unbatchedSender.messages) / 4);
+
+            expect (applyAll (target, sender.messages));
+            expect (target.isEquivalentTo (source));
+
+            sender.messages.clear();
+            sender.flush();
+            expect (sender.messages.isEmpty());
+        }
+
+        beginTest ("Binary diffs");
+        {
+            ScopedJuceInitialiser_GUI libraryInitialiser;
+
+            ValueTree source ("root"), target;
+            Sender sender (source);
+            sender.sendFullSyncCallback();
+            expect (applyAll (target, sender.messages));
+            sender.messages.clear();
+
+            sender.setFlushInterval (1000);
+            sender.setBinaryDiffThreshold (1024);
+
+            MemoryBlock block (8192, true);
+            Random r (0x1234);
+            r.fillBitsRandomly (block.getData(), block.getSize());
+            source.setProperty ("blob", block, nullptr);
+            sender.flush();
+
+            for (auto i : { 0, 100, 8191 })
+            {
+                block[i] = (char) (block[i] + 1);
+                source.setProperty ("blob", block, nullptr);
+                sender.flush();
+                expect (sender.messages.getLast().getSize() < 64);
+            }
+
+            block.append ("tail", 4);
+            source.setProperty ("blob", block, nullptr);
+            sender.flush();
+
+            expect (applyAll (target, sender.messages));
+            expect (target.isEquivalentTo (source));
+        }
+    }
+};
+
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+#endif
+
 } // namespace juce
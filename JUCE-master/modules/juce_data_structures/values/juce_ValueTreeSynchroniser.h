@@ -49,6 +49,10 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    By default, stateChanged() is called once for every change. When the changes
+    are being sent over a slow link, you can use setFlushInterval() to have them
+    collected and sent as a single, more compact message at regular intervals.
+
     @tags{DataStructures}
 */
 class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
@@ -79,6 +83,37 @@ public:
     */
     void sendFullSyncCallback();
 
+    /** Makes the synchroniser collect changes and send them in batches.
+
+        When the interval is greater than zero, changes are queued rather than being sent
+        immediately, and every intervalMs milliseconds any queued changes are passed to
+        stateChanged() as a single message. Within a batch, repeated changes to the same
+        property are coalesced so that only the latest value is sent, and each tree path
+        and property name is only written once.
+
+        Batched messages need a receiver that uses a version of applyChange() which
+        understands them. Passing 0 (the default) flushes any queued changes and goes
+        back to sending each change as it happens.
+
+        Any changes that are still queued when the synchroniser is deleted are discarded,
+        so you may want to call flush() in your subclass's destructor.
+
+        @see flush
+    */
+    void setFlushInterval (int intervalMs);
+
+    /** Immediately sends any changes that have been queued because of setFlushInterval(). */
+    void flush();
+
+    /** Enables sending binary diffs for large MemoryBlock properties in batched messages.
+
+        If a property holding a MemoryBlock of at least this many bytes changes, only the
+        range of bytes that differs from the last value that was sent is transmitted. This
+        needs a copy of the last value sent for each such property to be kept. Pass 0 (the
+        default) to always send the whole block.
+    */
+    void setBinaryDiffThreshold (size_t minimumBlockSize);
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -93,12 +128,22 @@ public:
     const ValueTree& getRoot() noexcept       { return valueTree; }
 
 private:
+    struct Batch;
+    struct SentBlobCache;
+
     ValueTree valueTree;
+    std::unique_ptr<Batch> batch;
+    std::unique_ptr<SentBlobCache> sentBlobs;
+    std::unique_ptr<TimedCallback> flushTimer;
+    int flushIntervalMs = 0;
+    size_t binaryDiffThreshold = 0;
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
     void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
     void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+    void startFlushTimer();
+    void stopFlushTimer();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeSynchroniser)
 };
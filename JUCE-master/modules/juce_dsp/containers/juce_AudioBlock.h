@@ -468,6 +468,12 @@ public:
     const AudioBlock& replaceWithProductOf (AudioBlock<Src1SampleType> src1, AudioBlock<Src2SampleType> src2) const noexcept   { replaceWithProductOfInternal (src1, src2); return *this; }
 
     //==============================================================================
+    /** Adds a smoothly changing value to each channel of this block. */
+    template <typename OtherSampleType, typename SmoothingType>
+    AudioBlock&       add (SmoothedValue<OtherSampleType, SmoothingType>& value)       noexcept   { addInternal (value); return *this; }
+    template <typename OtherSampleType, typename SmoothingType>
+    const AudioBlock& add (SmoothedValue<OtherSampleType, SmoothingType>& value) const noexcept   { addInternal (value); return *this; }
+
     /** Multiplies each channels of this block by a smoothly changing value. */
     template <typename OtherSampleType, typename SmoothingType>
     AudioBlock&       multiplyBy (SmoothedValue<OtherSampleType, SmoothingType>& value)       noexcept   { multiplyByInternal (value); return *this; }
@@ -547,6 +553,11 @@ public:
     AudioBlock&                            operator+= (AudioBlock src)         noexcept   { return add (src); }
     const AudioBlock&                      operator+= (AudioBlock src)   const noexcept   { return add (src); }
 
+    template <typename OtherSampleType, typename SmoothingType>
+    AudioBlock&       operator+= (SmoothedValue<OtherSampleType, SmoothingType>& value)       noexcept   { return add (value); }
+    template <typename OtherSampleType, typename SmoothingType>
+    const AudioBlock& operator+= (SmoothedValue<OtherSampleType, SmoothingType>& value) const noexcept   { return add (value); }
+
     AudioBlock&       JUCE_VECTOR_CALLTYPE operator-= (NumericType value)       noexcept   { return subtract (value); }
     const AudioBlock& JUCE_VECTOR_CALLTYPE operator-= (NumericType value) const noexcept   { return subtract (value); }
 
@@ -766,6 +777,31 @@ private:
             FloatVectorOperations::multiply (getDataPointer (ch), src1.getDataPointer (ch), src2.getDataPointer (ch), n);
     }
 
+    template <typename OtherSampleType, typename SmoothingType>
+    void addInternal (SmoothedValue<OtherSampleType, SmoothingType>& value) const noexcept
+    {
+        if (! value.isSmoothing())
+        {
+            addInternal ((NumericType) value.getTargetValue());
+        }
+        else
+        {
+            forEachSmoothedChunk (value, numSamples * sizeFactor, [this] (const auto* values, size_t start, size_t num)
+            {
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                {
+                    auto* dst = getDataPointer (ch) + start;
+
+                    if constexpr (std::is_same_v<OtherSampleType, NumericType>)
+                        FloatVectorOperations::add (dst, values, num);
+                    else
+                        for (size_t i = 0; i < num; ++i)
+                            dst[i] += (NumericType) values[i];
+                }
+            });
+        }
+    }
+
     template <typename OtherSampleType, typename SmoothingType>
     void multiplyByInternal (SmoothedValue<OtherSampleType, SmoothingType>& value) const noexcept
     {
@@ -775,13 +811,19 @@ private:
         }
         else
         {
-            for (size_t i = 0; i < numSamples; ++i)
+            forEachSmoothedChunk (value, numSamples, [this] (const auto* values, size_t start, size_t num)
             {
-                const auto scaler = (NumericType) value.getNextValue();
-
                 for (size_t ch = 0; ch < numChannels; ++ch)
-                    getDataPointer (ch)[i] *= scaler;
-            }
+                {
+                    auto* dst = getDataPointer (ch) + start;
+
+                    if constexpr (std::is_same_v<OtherSampleType, NumericType>)
+                        FloatVectorOperations::multiply (dst, values, num);
+                    else
+                        for (size_t i = 0; i < num; ++i)
+                            dst[i] *= (NumericType) values[i];
+                }
+            });
         }
     }
 
@@ -798,13 +840,37 @@ private:
         {
             auto n = jmin (numSamples, src.numSamples) * sizeFactor;
 
-            for (size_t i = 0; i < n; ++i)
+            forEachSmoothedChunk (value, n, [this, &src] (const auto* values, size_t start, size_t num)
             {
-                const auto scaler = (NumericType) value.getNextValue();
-
                 for (size_t ch = 0; ch < numChannels; ++ch)
-                    getDataPointer (ch)[i] = scaler * src.getChannelPointer (ch)[i];
-            }
+                {
+                    auto* dst = getDataPointer (ch) + start;
+                    auto* srcData = src.getChannelPointer (ch) + start;
+
+                    if constexpr (std::is_same_v<SmootherSampleType, NumericType> && std::is_same_v<BlockSampleType, NumericType>)
+                        FloatVectorOperations::multiply (dst, srcData, values, num);
+                    else
+                        for (size_t i = 0; i < num; ++i)
+                            dst[i] = (NumericType) values[i] * srcData[i];
+                }
+            });
+        }
+    }
+
+    // Renders the smoothed value's ramp into a small buffer, one chunk at a time, so
+    // that it can be applied to every channel with vectorised operations.
+    template <typename SmootherSampleType, typename SmoothingType, typename ChunkCallback>
+    static void forEachSmoothedChunk (SmoothedValue<SmootherSampleType, SmoothingType>& value,
+                                      size_t n, ChunkCallback&& callback) noexcept
+    {
+        constexpr size_t chunkSize = 128;
+        SmootherSampleType values[chunkSize];
+
+        for (size_t start = 0; start < n; start += chunkSize)
+        {
+            const auto num = jmin (chunkSize, n - start);
+            value.getNextValues (values, (int) num);
+            callback (values, start, num);
         }
     }
 
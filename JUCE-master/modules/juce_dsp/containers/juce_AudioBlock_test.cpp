@@ -432,6 +432,17 @@ private:
             expect (block.getSample (1, 2) > (SampleType) 0.0);
             expectEquals (block.getSample (0, 5), (SampleType) 0.0);
             expectEquals (block.getSample (1, 5), (SampleType) 0.0);
+
+            block.clear();
+            sv.setCurrentAndTargetValue (0.0f);
+            sv.setTargetValue (1.0f);
+            block.add (sv);
+            expect (block.getSample (0, 2) > (SampleType) 0.0);
+            expect (block.getSample (1, 2) > (SampleType) 0.0);
+            expect (block.getSample (0, 2) < (SampleType) 1.0);
+            expect (block.getSample (1, 2) < (SampleType) 1.0);
+            expectEquals (block.getSample (0, 5), (SampleType) 1.0);
+            expectEquals (block.getSample (1, 5), (SampleType) 1.0);
         }
     }
 
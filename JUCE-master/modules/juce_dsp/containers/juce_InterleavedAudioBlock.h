@@ -0,0 +1,410 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+#ifndef DOXYGEN
+namespace detail::Interleaving
+{
+    template <typename T>
+    struct NonDeduced { using Type = T; };
+
+    /*  With the number of channels known at compile time, these loops are turned into vector
+        loads, shuffles and stores by the compiler's auto-vectoriser.
+    */
+    template <size_t numChannels, typename T>
+    void interleave (const T* const* source, T* dest, size_t numSamples) noexcept
+    {
+        const T* src[numChannels];
+        std::copy (source, source + numChannels, src);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                dest[i * numChannels + ch] = src[ch][i];
+    }
+
+    template <size_t numChannels, typename T>
+    void deinterleave (const T* source, T* const* dest, size_t numSamples) noexcept
+    {
+        T* dst[numChannels];
+        std::copy (dest, dest + numChannels, dst);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                dst[ch][i] = source[i * numChannels + ch];
+    }
+
+    template <typename T>
+    void interleave (const T* const* source, size_t numSourceChannels, T* dest, size_t numDestChannels, size_t numSamples) noexcept
+    {
+        if (numSourceChannels == numDestChannels)
+        {
+            switch (numDestChannels)
+            {
+                case 1:   std::copy (source[0], source[0] + numSamples, dest); return;
+                case 2:   interleave<2>  (source, dest, numSamples); return;
+                case 4:   interleave<4>  (source, dest, numSamples); return;
+                case 8:   interleave<8>  (source, dest, numSamples); return;
+                case 16:  interleave<16> (source, dest, numSamples); return;
+                default:  break;
+            }
+        }
+
+        for (size_t ch = 0; ch < numDestChannels; ++ch)
+        {
+            auto* d = dest + ch;
+
+            if (ch < numSourceChannels)
+                for (size_t i = 0; i < numSamples; ++i)
+                    d[i * numDestChannels] = source[ch][i];
+            else
+                for (size_t i = 0; i < numSamples; ++i)
+                    d[i * numDestChannels] = T();
+        }
+    }
+
+    template <typename T>
+    void deinterleave (const T* source, size_t numSourceChannels, T* const* dest, size_t numDestChannels, size_t numSamples) noexcept
+    {
+        if (numSourceChannels == numDestChannels)
+        {
+            switch (numDestChannels)
+            {
+                case 1:   std::copy (source, source + numSamples, dest[0]); return;
+                case 2:   deinterleave<2>  (source, dest, numSamples); return;
+                case 4:   deinterleave<4>  (source, dest, numSamples); return;
+                case 8:   deinterleave<8>  (source, dest, numSamples); return;
+                case 16:  deinterleave<16> (source, dest, numSamples); return;
+                default:  break;
+            }
+        }
+
+        for (size_t ch = 0; ch < jmin (numSourceChannels, numDestChannels); ++ch)
+        {
+            const auto* s = source + ch;
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dest[ch][i] = s[i * numSourceChannels];
+        }
+    }
+}
+#endif
+
+//==============================================================================
+/**
+    A view of some interleaved audio data, in which the samples for all of the channels
+    at each point in time are stored next to each other.
+
+    Like AudioBlock, this doesn't own the data that it points to. Use copyFrom() and copyTo()
+    to convert to and from the planar layout that AudioBlock uses: these use vectorised
+    transposes for 2, 4, 8 and 16 channels.
+
+    An AudioBlock of SIMDRegisters, in which each lane of a register holds a different
+    channel, is interleaved too, and each of its channels can be viewed as an
+    InterleavedAudioBlock with one channel for each lane. See packChannels() and
+    unpackChannels() for converting whole blocks to and from that layout.
+
+    @see AudioBlock
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class InterleavedAudioBlock
+{
+private:
+    template <typename OtherSampleType>
+    using MayUseConvertingConstructor =
+        std::enable_if_t<std::is_same_v<std::remove_const_t<SampleType>,
+                                        std::remove_const_t<OtherSampleType>>
+                             && std::is_const_v<SampleType>
+                             && ! std::is_const_v<OtherSampleType>,
+                         int>;
+
+public:
+    //==============================================================================
+    using NumericType = std::remove_const_t<SampleType>;
+
+    //==============================================================================
+    /** Creates a zero-sized InterleavedAudioBlock. */
+    InterleavedAudioBlock() noexcept = default;
+
+    /** Creates an InterleavedAudioBlock that refers to numberOfChannels * numberOfSamples
+        values starting at data.
+    */
+    constexpr InterleavedAudioBlock (SampleType* data, size_t numberOfChannels, size_t numberOfSamples) noexcept
+        : samples (data),
+          numChannels (numberOfChannels),
+          numSamples (numberOfSamples)
+    {
+    }
+
+    /** Allocates a suitable amount of space in a HeapBlock, and initialises this object
+        to point into it.
+        The HeapBlock must of course not be freed or re-allocated while this object is still in
+        use, because it will be referencing its data.
+    */
+    InterleavedAudioBlock (HeapBlock<char>& heapBlockToUseForAllocation,
+                           size_t numberOfChannels, size_t numberOfSamples,
+                           size_t alignmentInBytes = 32) noexcept
+        : numChannels (numberOfChannels),
+          numSamples (numberOfSamples)
+    {
+        heapBlockToUseForAllocation.malloc (sizeof (SampleType) * numberOfChannels * numberOfSamples + alignmentInBytes - 1);
+        samples = snapPointerToAlignment (unalignedPointerCast<SampleType*> (heapBlockToUseForAllocation.getData()),
+                                          alignmentInBytes);
+    }
+
+    /** Creates a read-only view of a writable InterleavedAudioBlock. */
+    template <typename OtherSampleType, MayUseConvertingConstructor<OtherSampleType> = 0>
+    constexpr InterleavedAudioBlock (const InterleavedAudioBlock<OtherSampleType>& other) noexcept
+        : samples (other.getData()),
+          numChannels (other.getNumChannels()),
+          numSamples (other.getNumSamples())
+    {
+    }
+
+   #if JUCE_USE_SIMD || DOXYGEN
+    /** Views one channel of an AudioBlock of SIMDRegisters as an interleaved block with a
+        channel for each lane of the registers.
+    */
+    template <typename RegisterType,
+              std::enable_if_t<std::is_same_v<std::remove_const_t<RegisterType>, SIMDRegister<NumericType>>
+                                   && (std::is_const_v<SampleType> || ! std::is_const_v<RegisterType>), int> = 0>
+    InterleavedAudioBlock (const AudioBlock<RegisterType>& packed, size_t channel) noexcept
+        : samples (packed.getNumSamples() > 0 ? reinterpret_cast<SampleType*> (packed.getChannelPointer (channel)) : nullptr),
+          numChannels (SIMDRegister<NumericType>::size()),
+          numSamples (packed.getNumSamples())
+    {
+    }
+   #endif
+
+    //==============================================================================
+    /** Returns the number of channels in each frame. */
+    constexpr size_t getNumChannels() const noexcept          { return numChannels; }
+
+    /** Returns the number of frames. */
+    constexpr size_t getNumSamples() const noexcept           { return numSamples; }
+
+    /** Returns a pointer to the first sample. */
+    constexpr SampleType* getData() const noexcept            { return samples; }
+
+    /** Returns a pointer to the samples for all the channels at the given index. */
+    SampleType* getFramePointer (size_t sampleIndex) const noexcept
+    {
+        jassert (sampleIndex < numSamples);
+        return samples + sampleIndex * numChannels;
+    }
+
+    /** Returns a sample from the block. */
+    SampleType getSample (int channel, int sampleIndex) const noexcept
+    {
+        jassert (isPositiveAndBelow (channel, numChannels));
+        jassert (isPositiveAndBelow (sampleIndex, numSamples));
+        return samples[(size_t) sampleIndex * numChannels + (size_t) channel];
+    }
+
+    /** Modifies a sample in the block. */
+    void setSample (int channel, int sampleIndex, NumericType newValue) const noexcept
+    {
+        jassert (isPositiveAndBelow (channel, numChannels));
+        jassert (isPositiveAndBelow (sampleIndex, numSamples));
+        samples[(size_t) sampleIndex * numChannels + (size_t) channel] = newValue;
+    }
+
+    /** Returns a block that refers to a range of the frames in this one. */
+    InterleavedAudioBlock getSubBlock (size_t sampleStart, size_t length) const noexcept
+    {
+        jassert (sampleStart + length <= numSamples);
+        return InterleavedAudioBlock (samples + sampleStart * numChannels, numChannels, length);
+    }
+
+    /** Returns a block that refers to the frames from sampleStart to the end of this one. */
+    InterleavedAudioBlock getSubBlock (size_t sampleStart) const noexcept
+    {
+        return getSubBlock (sampleStart, numSamples - sampleStart);
+    }
+
+    //==============================================================================
+    /** Clears the memory referenced by this block. */
+    const InterleavedAudioBlock& clear() const noexcept
+    {
+        std::fill (samples, samples + numChannels * numSamples, NumericType());
+        return *this;
+    }
+
+    /** Interleaves the channels of a planar block into this one.
+
+        The source must have the same number of samples as this block. If it has fewer
+        channels, the remaining channels of this block are filled with zeros, and if it has
+        more, the extra channels are ignored.
+    */
+    const InterleavedAudioBlock& copyFrom (const AudioBlock<const NumericType>& source) const noexcept
+    {
+        jassert (source.getNumSamples() == numSamples);
+
+        if (numSamples == 0)
+            return *this;
+
+        const auto numSourceChannels = jmin (source.getNumChannels(), numChannels);
+        std::array<const NumericType*, 16> pointers;
+        HeapBlock<const NumericType*> extraPointers;
+        auto* channelPointers = pointers.data();
+
+        if (numSourceChannels > pointers.size())
+        {
+            extraPointers.malloc (numSourceChannels);
+            channelPointers = extraPointers.get();
+        }
+
+        for (size_t ch = 0; ch < numSourceChannels; ++ch)
+            channelPointers[ch] = source.getChannelPointer (ch);
+
+        detail::Interleaving::interleave (channelPointers, numSourceChannels, samples, numChannels, numSamples);
+        return *this;
+    }
+
+    /** De-interleaves the channels of this block into a planar block.
+
+        The destination must have the same number of samples as this block. If the channel
+        counts differ, only the channels that both blocks have are copied.
+    */
+    const InterleavedAudioBlock& copyTo (const AudioBlock<NumericType>& dest) const noexcept
+    {
+        jassert (dest.getNumSamples() == numSamples);
+
+        if (numSamples == 0)
+            return *this;
+
+        const auto numDestChannels = jmin (dest.getNumChannels(), numChannels);
+        std::array<NumericType*, 16> pointers;
+        HeapBlock<NumericType*> extraPointers;
+        auto* channelPointers = pointers.data();
+
+        if (numDestChannels > pointers.size())
+        {
+            extraPointers.malloc (numDestChannels);
+            channelPointers = extraPointers.get();
+        }
+
+        for (size_t ch = 0; ch < numDestChannels; ++ch)
+            channelPointers[ch] = dest.getChannelPointer (ch);
+
+        detail::Interleaving::deinterleave<NumericType> (samples, numChannels, channelPointers, numDestChannels, numSamples);
+        return *this;
+    }
+
+private:
+    //==============================================================================
+    SampleType* samples = nullptr;
+    size_t numChannels = 0, numSamples = 0;
+};
+
+#if JUCE_USE_SIMD || DOXYGEN
+//==============================================================================
+/** Returns the number of channels that an AudioBlock of SIMDRegisters needs in order to
+    hold numChannels channels, with one channel in each lane.
+
+    @see packChannels
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+constexpr size_t getNumPackedChannels (size_t numChannels) noexcept
+{
+    constexpr auto numLanes = SIMDRegister<SampleType>::size();
+    return (numChannels + numLanes - 1) / numLanes;
+}
+
+/** Copies the channels of a planar block into an AudioBlock of SIMDRegisters, so that lane n
+    of channel g of the packed block holds channel (g * SIMDRegister::size() + n) of the source.
+
+    A processor that works on SIMDRegisters, such as IIR::Filter<SIMDRegister<float>>, can
+    then process all of those channels at once. Lanes without a source channel are set to
+    zero. The packed block must have at least getNumPackedChannels() channels, and the same
+    number of samples as the source.
+
+    @see unpackChannels, InterleavedAudioBlock
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+void packChannels (const AudioBlock<const typename detail::Interleaving::NonDeduced<SampleType>::Type>& source,
+                   const AudioBlock<SIMDRegister<SampleType>>& packed) noexcept
+{
+    constexpr auto numLanes = SIMDRegister<SampleType>::size();
+    const auto numChannels = source.getNumChannels();
+
+    jassert (packed.getNumChannels() >= getNumPackedChannels<SampleType> (numChannels));
+    jassert (packed.getNumSamples() == source.getNumSamples());
+
+    for (size_t group = 0; group < packed.getNumChannels(); ++group)
+    {
+        const InterleavedAudioBlock<SampleType> lanes (packed, group);
+        const auto firstChannel = group * numLanes;
+
+        if (firstChannel < numChannels)
+            lanes.copyFrom (source.getSubsetChannelBlock (firstChannel, jmin (numLanes, numChannels - firstChannel)));
+        else
+            lanes.clear();
+    }
+}
+
+/** Copies the channels of an AudioBlock of SIMDRegisters, laid out as described in
+    packChannels(), back into a planar block.
+
+    @see packChannels, InterleavedAudioBlock
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+void unpackChannels (const AudioBlock<const SIMDRegister<typename detail::Interleaving::NonDeduced<SampleType>::Type>>& packed,
+                     const AudioBlock<SampleType>& dest) noexcept
+{
+    constexpr auto numLanes = SIMDRegister<SampleType>::size();
+    const auto numChannels = dest.getNumChannels();
+
+    jassert (packed.getNumChannels() >= getNumPackedChannels<SampleType> (numChannels));
+    jassert (packed.getNumSamples() == dest.getNumSamples());
+
+    for (size_t firstChannel = 0, group = 0; firstChannel < numChannels; firstChannel += numLanes, ++group)
+    {
+        const InterleavedAudioBlock<const SampleType> lanes (packed, group);
+        lanes.copyTo (dest.getSubsetChannelBlock (firstChannel, jmin (numLanes, numChannels - firstChannel)));
+    }
+}
+#endif
+
+} // namespace juce::dsp
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+template <typename SampleType>
+class InterleavedAudioBlockTests final : public UnitTest
+{
+public:
+    InterleavedAudioBlockTests()
+        : UnitTest ("InterleavedAudioBlock", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        constexpr size_t numSamples = 37;
+
+        beginTest ("Interleaving and de-interleaving round-trips");
+        {
+            for (size_t numChannels = 1; numChannels <= 17; ++numChannels)
+            {
+                AudioBuffer<SampleType> source ((int) numChannels, (int) numSamples), result ((int) numChannels, (int) numSamples);
+                fill (source);
+                result.clear();
+
+                HeapBlock<char> storage;
+                InterleavedAudioBlock<SampleType> interleaved (storage, numChannels, numSamples);
+                interleaved.copyFrom (AudioBlock<SampleType> (source));
+
+                expect (exactlyEqual (interleaved.getSample (0, 1), source.getSample (0, 1)));
+                expect (exactlyEqual (interleaved.getFramePointer (5)[numChannels - 1], source.getSample ((int) numChannels - 1, 5)));
+
+                interleaved.copyTo (AudioBlock<SampleType> (result));
+                expect (buffersMatch (source, result, (int) numChannels), "Failed for " + String (numChannels) + " channels");
+            }
+        }
+
+        beginTest ("Missing source channels are filled with zeros");
+        {
+            AudioBuffer<SampleType> source (3, (int) numSamples);
+            fill (source);
+
+            HeapBlock<char> storage;
+            InterleavedAudioBlock<SampleType> interleaved (storage, 4, numSamples);
+            std::fill (interleaved.getData(), interleaved.getData() + 4 * numSamples, (SampleType) 1);
+            interleaved.copyFrom (AudioBlock<SampleType> (source));
+
+            for (int i = 0; i < (int) numSamples; ++i)
+            {
+                expect (exactlyEqual (interleaved.getSample (2, i), source.getSample (2, i)));
+                expect (exactlyEqual (interleaved.getSample (3, i), SampleType()));
+            }
+        }
+
+        beginTest ("Sub-blocks refer to later frames");
+        {
+            HeapBlock<char> storage;
+            InterleavedAudioBlock<SampleType> interleaved (storage, 2, numSamples);
+            interleaved.clear();
+
+            const auto sub = interleaved.getSubBlock (10, 5);
+            expectEquals ((int) sub.getNumSamples(), 5);
+            sub.setSample (1, 0, (SampleType) 3);
+            expect (exactlyEqual (interleaved.getSample (1, 10), (SampleType) 3));
+        }
+
+       #if JUCE_USE_SIMD
+        beginTest ("Packing channels into SIMDRegisters round-trips");
+        {
+            constexpr auto numLanes = SIMDRegister<SampleType>::size();
+
+            for (const auto numChannels : { (size_t) 1, numLanes, numLanes + 1, 2 * numLanes + 3 })
+            {
+                AudioBuffer<SampleType> source ((int) numChannels, (int) numSamples), result ((int) numChannels, (int) numSamples);
+                fill (source);
+                result.clear();
+
+                HeapBlock<char> storage;
+                AudioBlock<SIMDRegister<SampleType>> packed (storage, getNumPackedChannels<SampleType> (numChannels), numSamples);
+                packChannels (AudioBlock<SampleType> (source), packed);
+
+                const auto lastChannel = numChannels - 1;
+                const auto& lastRegister = packed.getChannelPointer (lastChannel / numLanes)[4];
+                expect (exactlyEqual (lastRegister.get (lastChannel % numLanes), source.getSample ((int) lastChannel, 4)));
+
+                if (lastChannel % numLanes != numLanes - 1)
+                    expect (exactlyEqual (lastRegister.get (numLanes - 1), SampleType()));
+
+                unpackChannels (packed, AudioBlock<SampleType> (result));
+                expect (buffersMatch (source, result, (int) numChannels), "Failed for " + String (numChannels) + " channels");
+            }
+        }
+       #endif
+    }
+
+private:
+    void fill (AudioBuffer<SampleType>& buffer)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, (SampleType) (ch * 1000 + i + 1));
+    }
+
+    static bool buffersMatch (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b, int numChannels)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            if (! std::equal (a.getReadPointer (ch), a.getReadPointer (ch) + a.getNumSamples(), b.getReadPointer (ch)))
+                return false;
+
+        return true;
+    }
+};
+
+static InterleavedAudioBlockTests<float>  interleavedAudioBlockTestsFloat;
+static InterleavedAudioBlockTests<double> interleavedAudioBlockTestsDouble;
+
+} // namespace juce::dsp
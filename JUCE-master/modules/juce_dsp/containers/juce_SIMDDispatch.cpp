@@ -34,21 +34,36 @@
 
 namespace juce::dsp
 {
-    DEFINE_NEON_SIMD_CONST (int32_t, float, kAllBitsSet)     = { -1, -1, -1, -1 };
-    DEFINE_NEON_SIMD_CONST (int32_t, float, kEvenHighBit)    = { static_cast<int32_t> (0x80000000), 0, static_cast<int32_t> (0x80000000), 0 };
-    DEFINE_NEON_SIMD_CONST (float, float, kOne)              = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-   #if JUCE_64BIT
-    DEFINE_NEON_SIMD_CONST (int64_t, double, kAllBitsSet)    = { -1, -1 };
-    DEFINE_NEON_SIMD_CONST (double, double, kOne)            = { 1.0, 1.0 };
-   #endif
-
-    DEFINE_NEON_SIMD_CONST (int8_t, int8_t, kAllBitsSet)     = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
-    DEFINE_NEON_SIMD_CONST (uint8_t, uint8_t, kAllBitsSet)   = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
-    DEFINE_NEON_SIMD_CONST (int16_t, int16_t, kAllBitsSet)   = { -1, -1, -1, -1, -1, -1, -1, -1 };
-    DEFINE_NEON_SIMD_CONST (uint16_t, uint16_t, kAllBitsSet) = { 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff };
-    DEFINE_NEON_SIMD_CONST (int32_t, int32_t, kAllBitsSet)   = { -1, -1, -1, -1 };
-    DEFINE_NEON_SIMD_CONST (uint32_t, uint32_t, kAllBitsSet) = { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff };
-    DEFINE_NEON_SIMD_CONST (int64_t, int64_t, kAllBitsSet)   = { -1, -1 };
-    DEFINE_NEON_SIMD_CONST (uint64_t, uint64_t, kAllBitsSet) = { 0xffffffffffffffff, 0xffffffffffffffff };
+
+bool isSIMDInstructionSetSupported (SIMDInstructionSet instructionSet) noexcept
+{
+    switch (instructionSet)
+    {
+        case SIMDInstructionSet::scalar:    return true;
+
+       #if JUCE_INTEL
+        case SIMDInstructionSet::sse:       return SystemStats::hasSSE2();
+        case SIMDInstructionSet::avx2:      return SystemStats::hasAVX2();
+        case SIMDInstructionSet::avx512:    return SystemStats::hasAVX512F() && SystemStats::hasAVX512BW() && SystemStats::hasAVX512DQ();
+        case SIMDInstructionSet::neon:      return false;
+       #elif JUCE_ARM
+        case SIMDInstructionSet::sse:
+        case SIMDInstructionSet::avx2:
+        case SIMDInstructionSet::avx512:    return false;
+        #if defined (__ARM_NEON) || defined (_M_ARM64)
+         case SIMDInstructionSet::neon:     return true;
+        #else
+         case SIMDInstructionSet::neon:     return SystemStats::hasNeon();
+        #endif
+       #else
+        case SIMDInstructionSet::sse:
+        case SIMDInstructionSet::avx2:
+        case SIMDInstructionSet::avx512:
+        case SIMDInstructionSet::neon:      return false;
+       #endif
+    }
+
+    return false;
 }
+
+} // namespace juce::dsp
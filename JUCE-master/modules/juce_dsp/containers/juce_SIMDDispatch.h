@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+/** The SIMD backends that SIMDRegister can be compiled for.
+
+    Later entries in each family are preferred over earlier ones when they are
+    supported by the host CPU.
+
+    @see SIMDDispatcher, getCompiledSIMDInstructionSet
+
+    @tags{DSP}
+*/
+enum class SIMDInstructionSet
+{
+    scalar,     /**< Plain C++, no vector instructions. */
+    sse,        /**< 128-bit Intel SSE. */
+    avx2,       /**< 256-bit Intel AVX2. */
+    avx512,     /**< 512-bit Intel AVX-512 (F, BW and DQ). */
+    neon        /**< 128-bit ARM NEON. */
+};
+
+/** Returns true if the CPU that is running this code can execute the given
+    instruction set.
+
+    @tags{DSP}
+*/
+bool isSIMDInstructionSetSupported (SIMDInstructionSet instructionSet) noexcept;
+
+inline namespace JUCE_SIMD_NAMESPACE
+{
+    /** Returns the instruction set that SIMDRegister uses in the current
+        translation unit.
+
+        This is selected by the compiler flags used for the file, so a project
+        can contain several files which each have a different answer.
+
+        @tags{DSP}
+    */
+    constexpr SIMDInstructionSet getCompiledSIMDInstructionSet() noexcept
+    {
+       #if JUCE_SIMD_AVX512
+        return SIMDInstructionSet::avx512;
+       #elif JUCE_SIMD_AVX2
+        return SIMDInstructionSet::avx2;
+       #elif JUCE_SIMD_SSE
+        return SIMDInstructionSet::sse;
+       #elif JUCE_SIMD_NEON
+        return SIMDInstructionSet::neon;
+       #else
+        return SIMDInstructionSet::scalar;
+       #endif
+    }
+}
+
+//==============================================================================
+/**
+    Picks, at runtime, the best of several implementations of a function that
+    were compiled for different instruction sets.
+
+    SIMDRegister is a different type in each instruction set, so a kernel can be
+    written once as a template or inline function in a header, and then compiled
+    several times from small .cpp files that each use different compiler flags
+    (e.g. -mavx2, or -mavx512f -mavx512bw -mavx512dq with
+    JUCE_DSP_ENABLE_AVX512_SIMD=1). Each of these files exports a plain function
+    pointer, and a SIMDDispatcher chooses between them once:
+
+    @code
+    // kernel_avx2.cpp, built with -mavx2
+    void processAVX2 (float* data, size_t num)  { myKernel (data, num); }
+
+    // processor.cpp
+    static const SIMDDispatcher<void (*) (float*, size_t)> process
+    {
+        { SIMDInstructionSet::sse,  processSSE },
+        { SIMDInstructionSet::avx2, processAVX2 }
+    };
+
+    process (data, num);
+    @endcode
+
+    The files compiled with wider instruction sets should only contain the kernels
+    themselves: any other inline code that they instantiate may be shared with
+    other files by the linker, and could then be run on a CPU that doesn't
+    support it.
+
+    @tags{DSP}
+*/
+template <typename FunctionType>
+class SIMDDispatcher
+{
+public:
+    /** One of the implementations that a SIMDDispatcher can choose from. */
+    struct Implementation
+    {
+        SIMDInstructionSet instructionSet;
+        FunctionType function;
+    };
+
+    /** Chooses the best implementation that the host CPU supports.
+
+        At least one of the implementations must be supported, so the list should
+        normally contain a version built for the baseline instruction set.
+    */
+    SIMDDispatcher (std::initializer_list<Implementation> implementations) noexcept
+    {
+        for (auto& impl : implementations)
+        {
+            if (isSIMDInstructionSetSupported (impl.instructionSet)
+                 && (! found || static_cast<int> (impl.instructionSet) > static_cast<int> (chosen.instructionSet)))
+            {
+                chosen = impl;
+                found = true;
+            }
+        }
+
+        // None of the implementations can run on this CPU!
+        jassert (found);
+    }
+
+    /** Returns the chosen implementation. */
+    FunctionType get() const noexcept                        { return chosen.function; }
+
+    /** Returns the instruction set of the chosen implementation. */
+    SIMDInstructionSet getInstructionSet() const noexcept    { return chosen.instructionSet; }
+
+    /** Calls the chosen implementation. */
+    template <typename... Args>
+    decltype (auto) operator() (Args&&... args) const        { return chosen.function (std::forward<Args> (args)...); }
+
+private:
+    Implementation chosen {};
+    bool found = false;
+};
+
+} // namespace juce::dsp
@@ -36,7 +36,8 @@ namespace juce
 {
 namespace dsp
 {
-
+inline namespace JUCE_SIMD_NAMESPACE
+{
 
 //==============================================================================
 template <typename Type>
@@ -169,6 +170,8 @@ struct CmplxSIMDOps<std::complex<Scalar>>
 };
 #endif
 
+} // inline namespace JUCE_SIMD_NAMESPACE
+
 //==============================================================================
  namespace util
  {
@@ -213,6 +213,21 @@ public:
         }
     };
 
+    struct Division
+    {
+        template <typename typeOne, typename typeTwo>
+        static void inplace (typeOne& a, const typeTwo& b)
+        {
+            a /= b;
+        }
+
+        template <typename typeOne, typename typeTwo>
+        static typeOne outofplace (const typeOne& a, const typeTwo& b)
+        {
+            return a / b;
+        }
+    };
+
     struct BitAND
     {
         template <typename typeOne, typename typeTwo>
@@ -863,6 +878,7 @@ public:
         runTestForAllTypes ("AdditionOperators", OperatorTests<Addition>{});
         runTestForAllTypes ("SubtractionOperators", OperatorTests<Subtraction>{});
         runTestForAllTypes ("MultiplicationOperators", OperatorTests<Multiplication>{});
+        runTestFloatingPoint ("DivisionOperators", OperatorTests<Division>{});
 
         runTestForAllTypes ("BitANDOperators", BitOperatorTests<BitAND>{});
         runTestForAllTypes ("BitOROperators", BitOperatorTests<BitOR>{});
@@ -878,6 +894,26 @@ public:
         runTestSigned ("CheckAbs", CheckAbs{});
 
         runTestFloatingPoint ("CheckTruncate", CheckTruncate{});
+
+        beginTest ("SIMDDispatcher");
+        {
+            constexpr auto compiled = getCompiledSIMDInstructionSet();
+            expect (isSIMDInstructionSetSupported (compiled));
+
+           #if JUCE_ARM
+            constexpr auto unsupported = SIMDInstructionSet::avx512;
+           #else
+            constexpr auto unsupported = SIMDInstructionSet::neon;
+           #endif
+            expect (! isSIMDInstructionSetSupported (unsupported));
+
+            const SIMDDispatcher<int (*) (int)> dispatcher { { SIMDInstructionSet::scalar, [] (int x) { return x; } },
+                                                             { compiled,                   [] (int x) { return x + 1; } },
+                                                             { unsupported,                [] (int x) { return x + 2; } } };
+
+            expect (dispatcher.getInstructionSet() == compiled);
+            expectEquals (dispatcher (10), compiled == SIMDInstructionSet::scalar ? 10 : 11);
+        }
     }
 };
 
@@ -35,38 +35,53 @@
 namespace juce::dsp
 {
 
+// The Q of each second order section of a Butterworth filter of the given order
+template <typename FloatType>
+static FloatType getButterworthSectionQ (int order, int section)
+{
+    const auto angle = (2.0 * section + 1.0 + (order % 2)) * MathConstants<double>::pi / (order * 2.0);
+    return static_cast<FloatType> (1.0 / (2.0 * std::cos (angle)));
+}
+
 template <typename FloatType>
 typename FIR::Coefficients<FloatType>::Ptr
     FilterDesign<FloatType>::designFIRLowpassWindowMethod (FloatType frequency,
                                                            double sampleRate, size_t order,
                                                            WindowingMethod type,
                                                            FloatType beta)
+{
+    auto* result = new typename FIR::Coefficients<FloatType> (order + 1u);
+    designFIRLowpassWindowMethod (*result, frequency, sampleRate, type, beta);
+    return *result;
+}
+
+template <typename FloatType>
+void FilterDesign<FloatType>::designFIRLowpassWindowMethod (FIR::Coefficients<FloatType>& coefficientsToUpdate,
+                                                            FloatType frequency, double sampleRate,
+                                                            WindowingMethod type, FloatType beta)
 {
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert (coefficientsToUpdate.coefficients.size() > 0);
 
-    auto* result = new typename FIR::Coefficients<FloatType> (order + 1u);
-
-    auto* c = result->getRawCoefficients();
+    const auto order = coefficientsToUpdate.getFilterOrder();
+    auto* c = coefficientsToUpdate.getRawCoefficients();
     auto normalisedFrequency = frequency / sampleRate;
 
+    WindowingFunction<FloatType>::fillWindowingTables (c, order + 1, type, false, beta);
+
     for (size_t i = 0; i <= order; ++i)
     {
         if (i == order / 2)
         {
-            c[i] = static_cast<FloatType> (normalisedFrequency * 2);
+            c[i] *= static_cast<FloatType> (normalisedFrequency * 2);
         }
         else
         {
             auto indice = MathConstants<double>::pi * (static_cast<double> (i) - 0.5 * static_cast<double> (order));
-            c[i] = static_cast<FloatType> (std::sin (2.0 * indice * normalisedFrequency) / indice);
+            c[i] *= static_cast<FloatType> (std::sin (2.0 * indice * normalisedFrequency) / indice);
         }
     }
-
-    WindowingFunction<FloatType> theWindow (order + 1, type, false, beta);
-    theWindow.multiplyWithWindowingTable (c, order + 1);
-
-    return *result;
 }
 
 template <typename FloatType>
@@ -101,16 +116,27 @@ template <typename FloatType>
 typename FIR::Coefficients<FloatType>::Ptr
     FilterDesign<FloatType>::designFIRLowpassTransitionMethod (FloatType frequency, double sampleRate, size_t order,
                                                                FloatType normalisedTransitionWidth, FloatType spline)
+{
+    auto* result = new typename FIR::Coefficients<FloatType> (order + 1u);
+    designFIRLowpassTransitionMethod (*result, frequency, sampleRate, normalisedTransitionWidth, spline);
+    return *result;
+}
+
+template <typename FloatType>
+void FilterDesign<FloatType>::designFIRLowpassTransitionMethod (FIR::Coefficients<FloatType>& coefficientsToUpdate,
+                                                                FloatType frequency, double sampleRate,
+                                                                FloatType normalisedTransitionWidth, FloatType spline)
 {
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
     jassert (normalisedTransitionWidth > 0 && normalisedTransitionWidth <= 0.5);
     jassert (spline >= 1.0 && spline <= 4.0);
+    jassert (coefficientsToUpdate.coefficients.size() > 0);
 
     auto normalisedFrequency = frequency / static_cast<FloatType> (sampleRate);
 
-    auto* result = new typename FIR::Coefficients<FloatType> (order + 1u);
-    auto* c = result->getRawCoefficients();
+    const auto order = coefficientsToUpdate.getFilterOrder();
+    auto* c = coefficientsToUpdate.getRawCoefficients();
 
     for (size_t i = 0; i <= order; ++i)
     {
@@ -126,8 +152,6 @@ typename FIR::Coefficients<FloatType>::Ptr
                                             / indice * std::pow (std::sin (indice2) / indice2, spline));
         }
     }
-
-    return *result;
 }
 
 template <typename FloatType>
@@ -558,29 +582,38 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
     ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
 
     if (order % 2 == 1)
-    {
         arrayFilters.add (*IIR::Coefficients<FloatType>::makeFirstOrderLowPass (sampleRate, frequency));
 
-        for (int i = 0; i < order / 2; ++i)
-        {
-            auto Q = 1.0 / (2.0 * std::cos ((i + 1.0) * MathConstants<double>::pi / order));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeLowPass (sampleRate, frequency,
-                                                                          static_cast<FloatType> (Q)));
-        }
-    }
-    else
-    {
-        for (int i = 0; i < order / 2; ++i)
-        {
-            auto Q = 1.0 / (2.0 * std::cos ((2.0 * i + 1.0) * MathConstants<double>::pi / (order * 2.0)));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeLowPass (sampleRate, frequency,
-                                                                          static_cast<FloatType> (Q)));
-        }
-    }
+    for (int i = 0; i < order / 2; ++i)
+        arrayFilters.add (*IIR::Coefficients<FloatType>::makeLowPass (sampleRate, frequency,
+                                                                      getButterworthSectionQ<FloatType> (order, i)));
 
     return arrayFilters;
 }
 
+template <typename FloatType>
+void FilterDesign<FloatType>::designIIRLowpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                                          FloatType frequency, double sampleRate)
+{
+    using ArrayCoeffs = IIR::ArrayCoefficients<FloatType>;
+
+    jassert (sampleRate > 0);
+    jassert (frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert (! coefficientsToUpdate.isEmpty());
+
+    // An odd order filter starts with a first order section
+    const auto hasFirstOrderSection = coefficientsToUpdate.getFirst()->getFilterOrder() == 1;
+    const auto order = 2 * coefficientsToUpdate.size() - (hasFirstOrderSection ? 1 : 0);
+    auto section = 0;
+
+    if (hasFirstOrderSection)
+        *coefficientsToUpdate.getUnchecked (section++) = ArrayCoeffs::makeFirstOrderLowPass (sampleRate, frequency);
+
+    for (int i = 0; i < order / 2; ++i)
+        *coefficientsToUpdate.getUnchecked (section++) = ArrayCoeffs::makeLowPass (sampleRate, frequency,
+                                                                                    getButterworthSectionQ<FloatType> (order, i));
+}
+
 template <typename FloatType>
 ReferenceCountedArray<IIR::Coefficients<FloatType>>
     FilterDesign<FloatType>::designIIRHighpassHighOrderButterworthMethod (FloatType frequency,
@@ -593,29 +626,38 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
     ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
 
     if (order % 2 == 1)
-    {
         arrayFilters.add (*IIR::Coefficients<FloatType>::makeFirstOrderHighPass (sampleRate, frequency));
 
-        for (int i = 0; i < order / 2; ++i)
-        {
-            auto Q = 1.0 / (2.0 * std::cos ((i + 1.0) * MathConstants<double>::pi / order));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeHighPass (sampleRate, frequency,
-                                                                           static_cast<FloatType> (Q)));
-        }
-    }
-    else
-    {
-        for (int i = 0; i < order / 2; ++i)
-        {
-            auto Q = 1.0 / (2.0 * std::cos ((2.0 * i + 1.0) * MathConstants<double>::pi / (order * 2.0)));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeHighPass (sampleRate, frequency,
-                                                                           static_cast<FloatType> (Q)));
-        }
-    }
+    for (int i = 0; i < order / 2; ++i)
+        arrayFilters.add (*IIR::Coefficients<FloatType>::makeHighPass (sampleRate, frequency,
+                                                                       getButterworthSectionQ<FloatType> (order, i)));
 
     return arrayFilters;
 }
 
+template <typename FloatType>
+void FilterDesign<FloatType>::designIIRHighpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                                           FloatType frequency, double sampleRate)
+{
+    using ArrayCoeffs = IIR::ArrayCoefficients<FloatType>;
+
+    jassert (sampleRate > 0);
+    jassert (frequency > 0 && frequency <= sampleRate * 0.5);
+    jassert (! coefficientsToUpdate.isEmpty());
+
+    // An odd order filter starts with a first order section
+    const auto hasFirstOrderSection = coefficientsToUpdate.getFirst()->getFilterOrder() == 1;
+    const auto order = 2 * coefficientsToUpdate.size() - (hasFirstOrderSection ? 1 : 0);
+    auto section = 0;
+
+    if (hasFirstOrderSection)
+        *coefficientsToUpdate.getUnchecked (section++) = ArrayCoeffs::makeFirstOrderHighPass (sampleRate, frequency);
+
+    for (int i = 0; i < order / 2; ++i)
+        *coefficientsToUpdate.getUnchecked (section++) = ArrayCoeffs::makeHighPass (sampleRate, frequency,
+                                                                                     getButterworthSectionQ<FloatType> (order, i));
+}
+
 template <typename FloatType>
 typename FilterDesign<FloatType>::IIRPolyphaseAllpassStructure
     FilterDesign<FloatType>::designIIRLowpassHalfBandPolyphaseAllpassMethod (FloatType normalisedTransitionWidth,
@@ -700,7 +742,166 @@ typename FilterDesign<FloatType>::IIRPolyphaseAllpassStructure
     return structure;
 }
 
+//==============================================================================
+template <typename FloatType>
+FilterDesign<FloatType>::Cache::Cache (int maximumNumDesignsToKeep)
+    : maximumNumDesigns (jmax (1, maximumNumDesignsToKeep))
+{
+}
+
+template <typename FloatType>
+template <typename DesignFunction>
+const typename FilterDesign<FloatType>::Cache::Design&
+    FilterDesign<FloatType>::Cache::getDesign (Method method, std::array<double, 5> parameters,
+                                               DesignFunction&& designFunction)
+{
+    // The caller must hold the lock while using the result
+    const auto matches = [&] (const Design& d) { return d.method == method && d.parameters == parameters; };
+    const auto found = std::find_if (designs.begin(), designs.end(), matches);
+
+    if (found != designs.end())
+    {
+        std::rotate (found, found + 1, designs.end());
+        return designs.back();
+    }
+
+    if ((int) designs.size() >= maximumNumDesigns)
+        designs.erase (designs.begin());
+
+    designs.push_back ({ method, parameters, nullptr, {} });
+    designFunction (designs.back());
+    return designs.back();
+}
+
+template <typename FloatType>
+typename FilterDesign<FloatType>::FIRCoefficientsPtr
+    FilterDesign<FloatType>::Cache::designFIRLowpassWindowMethod (FloatType frequency, double sampleRate,
+                                                                  size_t order, WindowingMethod type,
+                                                                  FloatType beta)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::firWindow, { frequency, sampleRate, (double) order, (double) type, beta },
+                      [&] (Design& d) { d.fir = FilterDesign::designFIRLowpassWindowMethod (frequency, sampleRate, order, type, beta); }).fir;
+}
+
+template <typename FloatType>
+typename FilterDesign<FloatType>::FIRCoefficientsPtr
+    FilterDesign<FloatType>::Cache::designFIRLowpassKaiserMethod (FloatType frequency, double sampleRate,
+                                                                  FloatType normalisedTransitionWidth,
+                                                                  FloatType amplitudedB)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::firKaiser, { frequency, sampleRate, normalisedTransitionWidth, amplitudedB, 0.0 },
+                      [&] (Design& d) { d.fir = FilterDesign::designFIRLowpassKaiserMethod (frequency, sampleRate, normalisedTransitionWidth, amplitudedB); }).fir;
+}
+
+template <typename FloatType>
+typename FilterDesign<FloatType>::FIRCoefficientsPtr
+    FilterDesign<FloatType>::Cache::designFIRLowpassTransitionMethod (FloatType frequency, double sampleRate, size_t order,
+                                                                      FloatType normalisedTransitionWidth, FloatType spline)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::firTransition, { frequency, sampleRate, (double) order, normalisedTransitionWidth, spline },
+                      [&] (Design& d) { d.fir = FilterDesign::designFIRLowpassTransitionMethod (frequency, sampleRate, order, normalisedTransitionWidth, spline); }).fir;
+}
+
+template <typename FloatType>
+typename FilterDesign<FloatType>::FIRCoefficientsPtr
+    FilterDesign<FloatType>::Cache::designFIRLowpassLeastSquaresMethod (FloatType frequency, double sampleRate, size_t order,
+                                                                        FloatType normalisedTransitionWidth,
+                                                                        FloatType stopBandWeight)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::firLeastSquares, { frequency, sampleRate, (double) order, normalisedTransitionWidth, stopBandWeight },
+                      [&] (Design& d) { d.fir = FilterDesign::designFIRLowpassLeastSquaresMethod (frequency, sampleRate, order, normalisedTransitionWidth, stopBandWeight); }).fir;
+}
+
+template <typename FloatType>
+typename FilterDesign<FloatType>::FIRCoefficientsPtr
+    FilterDesign<FloatType>::Cache::designFIRLowpassHalfBandEquirippleMethod (FloatType normalisedTransitionWidth,
+                                                                              FloatType amplitudedB)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::firHalfBandEquiripple, { normalisedTransitionWidth, amplitudedB, 0.0, 0.0, 0.0 },
+                      [&] (Design& d) { d.fir = FilterDesign::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidth, amplitudedB); }).fir;
+}
+
+template <typename FloatType>
+ReferenceCountedArray<IIR::Coefficients<FloatType>>
+    FilterDesign<FloatType>::Cache::designIIRLowpassHighOrderButterworthMethod (FloatType frequency, double sampleRate,
+                                                                                FloatType normalisedTransitionWidth,
+                                                                                FloatType passbandAmplitudedB,
+                                                                                FloatType stopbandAmplitudedB)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::iirButterworth, { frequency, sampleRate, normalisedTransitionWidth, passbandAmplitudedB, stopbandAmplitudedB },
+                      [&] (Design& d) { d.iir = FilterDesign::designIIRLowpassHighOrderButterworthMethod (frequency, sampleRate, normalisedTransitionWidth,
+                                                                                                          passbandAmplitudedB, stopbandAmplitudedB); }).iir;
+}
+
+template <typename FloatType>
+ReferenceCountedArray<IIR::Coefficients<FloatType>>
+    FilterDesign<FloatType>::Cache::designIIRLowpassHighOrderChebyshev1Method (FloatType frequency, double sampleRate,
+                                                                               FloatType normalisedTransitionWidth,
+                                                                               FloatType passbandAmplitudedB,
+                                                                               FloatType stopbandAmplitudedB)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::iirChebyshev1, { frequency, sampleRate, normalisedTransitionWidth, passbandAmplitudedB, stopbandAmplitudedB },
+                      [&] (Design& d) { d.iir = FilterDesign::designIIRLowpassHighOrderChebyshev1Method (frequency, sampleRate, normalisedTransitionWidth,
+                                                                                                         passbandAmplitudedB, stopbandAmplitudedB); }).iir;
+}
+
+template <typename FloatType>
+ReferenceCountedArray<IIR::Coefficients<FloatType>>
+    FilterDesign<FloatType>::Cache::designIIRLowpassHighOrderChebyshev2Method (FloatType frequency, double sampleRate,
+                                                                               FloatType normalisedTransitionWidth,
+                                                                               FloatType passbandAmplitudedB,
+                                                                               FloatType stopbandAmplitudedB)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::iirChebyshev2, { frequency, sampleRate, normalisedTransitionWidth, passbandAmplitudedB, stopbandAmplitudedB },
+                      [&] (Design& d) { d.iir = FilterDesign::designIIRLowpassHighOrderChebyshev2Method (frequency, sampleRate, normalisedTransitionWidth,
+                                                                                                         passbandAmplitudedB, stopbandAmplitudedB); }).iir;
+}
+
+template <typename FloatType>
+ReferenceCountedArray<IIR::Coefficients<FloatType>>
+    FilterDesign<FloatType>::Cache::designIIRLowpassHighOrderEllipticMethod (FloatType frequency, double sampleRate,
+                                                                             FloatType normalisedTransitionWidth,
+                                                                             FloatType passbandAmplitudedB,
+                                                                             FloatType stopbandAmplitudedB)
+{
+    const ScopedLock sl (lock);
+
+    return getDesign (Method::iirElliptic, { frequency, sampleRate, normalisedTransitionWidth, passbandAmplitudedB, stopbandAmplitudedB },
+                      [&] (Design& d) { d.iir = FilterDesign::designIIRLowpassHighOrderEllipticMethod (frequency, sampleRate, normalisedTransitionWidth,
+                                                                                                       passbandAmplitudedB, stopbandAmplitudedB); }).iir;
+}
+
+template <typename FloatType>
+int FilterDesign<FloatType>::Cache::getNumDesigns() const
+{
+    const ScopedLock sl (lock);
+    return (int) designs.size();
+}
+
+template <typename FloatType>
+void FilterDesign<FloatType>::Cache::clear()
+{
+    const ScopedLock sl (lock);
+    designs.clear();
+}
 
+//==============================================================================
 template struct FilterDesign<float>;
 template struct FilterDesign<double>;
 
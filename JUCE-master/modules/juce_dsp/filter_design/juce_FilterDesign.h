@@ -76,6 +76,16 @@ struct FilterDesign
                                                             size_t order, WindowingMethod type,
                                                             FloatType beta = static_cast<FloatType> (2));
 
+    /** Calculates the same coefficients as designFIRLowpassWindowMethod(), but writes them
+        into an existing FIR::Coefficients object instead of allocating a new one. This
+        makes it suitable for modulating the cutoff frequency on the audio thread.
+
+        The order of the filter is the size of coefficientsToUpdate minus one.
+    */
+    static void designFIRLowpassWindowMethod (FIR::Coefficients<FloatType>& coefficientsToUpdate,
+                                              FloatType frequency, double sampleRate, WindowingMethod type,
+                                              FloatType beta = static_cast<FloatType> (2));
+
     /** This a variant of the function designFIRLowpassWindowMethod, which allows the
         user to specify a transition width and a negative gain in dB,
         to get a low-pass filter using the Kaiser windowing function, with calculated
@@ -114,6 +124,16 @@ struct FilterDesign
                                                                 FloatType normalisedTransitionWidth,
                                                                 FloatType spline);
 
+    /** Calculates the same coefficients as designFIRLowpassTransitionMethod(), but writes
+        them into an existing FIR::Coefficients object instead of allocating a new one.
+
+        The order of the filter is the size of coefficientsToUpdate minus one.
+    */
+    static void designFIRLowpassTransitionMethod (FIR::Coefficients<FloatType>& coefficientsToUpdate,
+                                                  FloatType frequency, double sampleRate,
+                                                  FloatType normalisedTransitionWidth,
+                                                  FloatType spline);
+
     /** This method generates a FIR::Coefficients for a low-pass filter, by
         minimizing the average error between the generated filter and an ideal one
         using the least squares error criterion and matrices operations.
@@ -196,6 +216,23 @@ struct FilterDesign
     static ReferenceCountedArray<IIRCoefficients> designIIRHighpassHighOrderButterworthMethod (FloatType frequency, double sampleRate,
                                                                                                int order);
 
+    /** Recalculates an array of IIR::Coefficients returned by
+        designIIRLowpassHighOrderButterworthMethod() for a new cutoff frequency, keeping the
+        same order. The existing objects are updated in place without allocating, so any
+        IIR::Filter using them picks up the change, and this can be called on the audio thread.
+    */
+    static void designIIRLowpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                            FloatType frequency, double sampleRate);
+
+    /** Recalculates an array of IIR::Coefficients returned by
+        designIIRHighpassHighOrderButterworthMethod() for a new cutoff frequency, keeping the
+        same order, without allocating.
+
+        @see designIIRLowpassHighOrderButterworthMethod
+    */
+    static void designIIRHighpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                             FloatType frequency, double sampleRate);
+
     /** This method returns an array of IIR::Coefficients, made to be used in
         cascaded IIRFilters, providing a minimum phase low-pass filter without any
         ripple in the stop band only.
@@ -291,6 +328,117 @@ struct FilterDesign
     static IIRPolyphaseAllpassStructure designIIRLowpassHalfBandPolyphaseAllpassMethod (FloatType normalisedTransitionWidth,
                                                                                         FloatType stopbandAmplitudedB);
 
+    //==============================================================================
+    /**
+        Keeps the results of the most recently used filter designs, so that designing the
+        same filter again, e.g. when a plug-in is re-prepared with the same settings, only
+        has to look them up.
+
+        Each design method has the same parameters as the FilterDesign function with the
+        same name. The coefficients returned are shared with the cache and with anyone else
+        asking for the same design, so they mustn't be modified: make a copy if you need to.
+
+        When the cache is full, the least recently used design is removed. The cache can be
+        used from several threads at once, but it isn't realtime safe.
+
+        @tags{DSP}
+    */
+    class Cache
+    {
+    public:
+        /** Creates a cache holding at most the given number of designs. */
+        explicit Cache (int maximumNumDesigns = 16);
+
+        //==============================================================================
+        /** @see FilterDesign::designFIRLowpassWindowMethod */
+        FIRCoefficientsPtr designFIRLowpassWindowMethod (FloatType frequency, double sampleRate,
+                                                         size_t order, WindowingMethod type,
+                                                         FloatType beta = static_cast<FloatType> (2));
+
+        /** @see FilterDesign::designFIRLowpassKaiserMethod */
+        FIRCoefficientsPtr designFIRLowpassKaiserMethod (FloatType frequency, double sampleRate,
+                                                         FloatType normalisedTransitionWidth,
+                                                         FloatType amplitudedB);
+
+        /** @see FilterDesign::designFIRLowpassTransitionMethod */
+        FIRCoefficientsPtr designFIRLowpassTransitionMethod (FloatType frequency, double sampleRate,
+                                                             size_t order,
+                                                             FloatType normalisedTransitionWidth,
+                                                             FloatType spline);
+
+        /** @see FilterDesign::designFIRLowpassLeastSquaresMethod */
+        FIRCoefficientsPtr designFIRLowpassLeastSquaresMethod (FloatType frequency, double sampleRate, size_t order,
+                                                               FloatType normalisedTransitionWidth,
+                                                               FloatType stopBandWeight);
+
+        /** @see FilterDesign::designFIRLowpassHalfBandEquirippleMethod */
+        FIRCoefficientsPtr designFIRLowpassHalfBandEquirippleMethod (FloatType normalisedTransitionWidth,
+                                                                     FloatType amplitudedB);
+
+        /** @see FilterDesign::designIIRLowpassHighOrderButterworthMethod */
+        ReferenceCountedArray<IIRCoefficients> designIIRLowpassHighOrderButterworthMethod (FloatType frequency, double sampleRate,
+                                                                                           FloatType normalisedTransitionWidth,
+                                                                                           FloatType passbandAmplitudedB,
+                                                                                           FloatType stopbandAmplitudedB);
+
+        /** @see FilterDesign::designIIRLowpassHighOrderChebyshev1Method */
+        ReferenceCountedArray<IIRCoefficients> designIIRLowpassHighOrderChebyshev1Method (FloatType frequency, double sampleRate,
+                                                                                          FloatType normalisedTransitionWidth,
+                                                                                          FloatType passbandAmplitudedB,
+                                                                                          FloatType stopbandAmplitudedB);
+
+        /** @see FilterDesign::designIIRLowpassHighOrderChebyshev2Method */
+        ReferenceCountedArray<IIRCoefficients> designIIRLowpassHighOrderChebyshev2Method (FloatType frequency, double sampleRate,
+                                                                                          FloatType normalisedTransitionWidth,
+                                                                                          FloatType passbandAmplitudedB,
+                                                                                          FloatType stopbandAmplitudedB);
+
+        /** @see FilterDesign::designIIRLowpassHighOrderEllipticMethod */
+        ReferenceCountedArray<IIRCoefficients> designIIRLowpassHighOrderEllipticMethod (FloatType frequency, double sampleRate,
+                                                                                        FloatType normalisedTransitionWidth,
+                                                                                        FloatType passbandAmplitudedB,
+                                                                                        FloatType stopbandAmplitudedB);
+
+        //==============================================================================
+        /** Returns the number of designs currently held. */
+        int getNumDesigns() const;
+
+        /** Removes all the designs. */
+        void clear();
+
+    private:
+        //==============================================================================
+        enum class Method
+        {
+            firWindow,
+            firKaiser,
+            firTransition,
+            firLeastSquares,
+            firHalfBandEquiripple,
+            iirButterworth,
+            iirChebyshev1,
+            iirChebyshev2,
+            iirElliptic
+        };
+
+        struct Design
+        {
+            Method method;
+            std::array<double, 5> parameters;
+            FIRCoefficientsPtr fir;
+            ReferenceCountedArray<IIRCoefficients> iir;
+        };
+
+        template <typename DesignFunction>
+        const Design& getDesign (Method, std::array<double, 5> parameters, DesignFunction&&);
+
+        CriticalSection lock;
+        std::vector<Design> designs; // the least recently used design is first
+        int maximumNumDesigns;
+
+        JUCE_DECLARE_NON_COPYABLE (Cache)
+    };
+
 private:
     //==============================================================================
     static Array<double> getPartialImpulseResponseHn (int n, double kp);
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class FilterDesignTest final : public UnitTest
+{
+public:
+    FilterDesignTest()
+        : UnitTest ("FilterDesign", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float");
+        runTestsForType<double> ("double");
+    }
+
+private:
+    template <typename FloatType>
+    void expectEqualCoefficients (const Array<FloatType>& a, const Array<FloatType>& b)
+    {
+        expectEquals (a.size(), b.size());
+
+        for (int i = 0; i < jmin (a.size(), b.size()); ++i)
+            expectWithinAbsoluteError (a[i], b[i], (FloatType) 1.0e-6);
+    }
+
+    template <typename FloatType>
+    void runTestsForType (const String& typeName)
+    {
+        using Design = FilterDesign<FloatType>;
+        const auto sampleRate = 44100.0;
+
+        beginTest ("FIR designs can update existing coefficients (" + typeName + ")");
+        {
+            const auto expected = Design::designFIRLowpassWindowMethod ((FloatType) 5000, sampleRate, 32,
+                                                                        WindowingFunction<FloatType>::kaiser, (FloatType) 4);
+            FIR::Coefficients<FloatType> coefficients (33);
+            const auto* storage = coefficients.getRawCoefficients();
+
+            Design::designFIRLowpassWindowMethod (coefficients, (FloatType) 5000, sampleRate,
+                                                  WindowingFunction<FloatType>::kaiser, (FloatType) 4);
+
+            expect (coefficients.getRawCoefficients() == storage);
+            expectEqualCoefficients (coefficients.coefficients, expected->coefficients);
+
+            const auto expectedTransition = Design::designFIRLowpassTransitionMethod ((FloatType) 3000, sampleRate, 32,
+                                                                                      (FloatType) 0.1, (FloatType) 2);
+            Design::designFIRLowpassTransitionMethod (coefficients, (FloatType) 3000, sampleRate, (FloatType) 0.1, (FloatType) 2);
+
+            expect (coefficients.getRawCoefficients() == storage);
+            expectEqualCoefficients (coefficients.coefficients, expectedTransition->coefficients);
+        }
+
+        beginTest ("Butterworth designs can update existing coefficients (" + typeName + ")");
+        {
+            for (auto order : { 1, 4, 5 })
+            {
+                auto lowpass  = Design::designIIRLowpassHighOrderButterworthMethod  ((FloatType) 1000, sampleRate, order);
+                auto highpass = Design::designIIRHighpassHighOrderButterworthMethod ((FloatType) 1000, sampleRate, order);
+
+                Array<const FloatType*> storage;
+
+                for (auto* c : lowpass)
+                    storage.add (c->getRawCoefficients());
+
+                Design::designIIRLowpassHighOrderButterworthMethod  (lowpass,  (FloatType) 2500, sampleRate);
+                Design::designIIRHighpassHighOrderButterworthMethod (highpass, (FloatType) 2500, sampleRate);
+
+                const auto expectedLowpass  = Design::designIIRLowpassHighOrderButterworthMethod  ((FloatType) 2500, sampleRate, order);
+                const auto expectedHighpass = Design::designIIRHighpassHighOrderButterworthMethod ((FloatType) 2500, sampleRate, order);
+
+                expectEquals (lowpass.size(), expectedLowpass.size());
+                expectEquals (highpass.size(), expectedHighpass.size());
+
+                for (int i = 0; i < lowpass.size(); ++i)
+                {
+                    expect (lowpass[i]->getRawCoefficients() == storage[i]);
+                    expectEqualCoefficients (lowpass[i]->coefficients, expectedLowpass[i]->coefficients);
+                    expectEqualCoefficients (highpass[i]->coefficients, expectedHighpass[i]->coefficients);
+                }
+            }
+        }
+
+        beginTest ("IIR coefficients can be assigned in place (" + typeName + ")");
+        {
+            auto coefficients = IIR::Coefficients<FloatType>::makeFirstOrderLowPass (sampleRate, (FloatType) 1000);
+            const auto* storage = coefficients->getRawCoefficients();
+
+            *coefficients = IIR::ArrayCoefficients<FloatType>::makePeakFilter (sampleRate, (FloatType) 1000, (FloatType) 2, (FloatType) 4);
+
+            expect (coefficients->getRawCoefficients() == storage);
+            expectEqualCoefficients (coefficients->coefficients,
+                                     IIR::Coefficients<FloatType>::makePeakFilter (sampleRate, (FloatType) 1000, (FloatType) 2, (FloatType) 4)->coefficients);
+        }
+
+        beginTest ("Cache (" + typeName + ")");
+        {
+            typename Design::Cache cache (2);
+            expectEquals (cache.getNumDesigns(), 0);
+
+            const auto a = cache.designFIRLowpassKaiserMethod ((FloatType) 10000, sampleRate, (FloatType) 0.05, (FloatType) -60);
+            expectEqualCoefficients (a->coefficients,
+                                     Design::designFIRLowpassKaiserMethod ((FloatType) 10000, sampleRate, (FloatType) 0.05, (FloatType) -60)->coefficients);
+
+            expect (cache.designFIRLowpassKaiserMethod ((FloatType) 10000, sampleRate, (FloatType) 0.05, (FloatType) -60) == a);
+            expectEquals (cache.getNumDesigns(), 1);
+
+            const auto b = cache.designFIRLowpassKaiserMethod ((FloatType) 12000, sampleRate, (FloatType) 0.05, (FloatType) -60);
+            expect (b != a);
+
+            const auto c = cache.designIIRLowpassHighOrderEllipticMethod ((FloatType) 10000, sampleRate, (FloatType) 0.05,
+                                                                          (FloatType) -0.1, (FloatType) -60);
+            expect (! c.isEmpty());
+            expectEquals (cache.getNumDesigns(), 2);
+
+            // b was used less recently than c, so it has been removed, and a was removed before it
+            expect (cache.designIIRLowpassHighOrderEllipticMethod ((FloatType) 10000, sampleRate, (FloatType) 0.05,
+                                                                   (FloatType) -0.1, (FloatType) -60).getFirst() == c.getFirst());
+            expect (cache.designFIRLowpassKaiserMethod ((FloatType) 10000, sampleRate, (FloatType) 0.05, (FloatType) -60) != a);
+            expect (cache.designIIRLowpassHighOrderEllipticMethod ((FloatType) 10000, sampleRate, (FloatType) 0.05,
+                                                                   (FloatType) -0.1, (FloatType) -60).getFirst() == c.getFirst());
+            expect (cache.designFIRLowpassKaiserMethod ((FloatType) 12000, sampleRate, (FloatType) 0.05, (FloatType) -60) != b);
+
+            cache.clear();
+            expectEquals (cache.getNumDesigns(), 0);
+        }
+    }
+};
+
+static FilterDesignTest filterDesignTest;
+
+} // namespace juce::dsp
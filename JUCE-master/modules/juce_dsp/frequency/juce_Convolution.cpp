@@ -152,6 +152,114 @@ ConvolutionMessageQueue::~ConvolutionMessageQueue() noexcept
 ConvolutionMessageQueue::ConvolutionMessageQueue (ConvolutionMessageQueue&&) noexcept = default;
 ConvolutionMessageQueue& ConvolutionMessageQueue::operator= (ConvolutionMessageQueue&&) noexcept = default;
 
+//==============================================================================
+// The frequency-domain partitions of one IR segment, along with the time-domain
+// samples they were made from. These are never modified once they have been
+// created, so they can be shared between engines.
+struct ImpulsePartitions
+{
+    std::vector<float> samples;
+    std::vector<AudioBuffer<float>> segments;
+};
+
+// Lets all the engines in the process that convolve identical IR segments with
+// the same partition size share a single copy of the partitions. Entries are
+// only kept alive by the engines that use them.
+class ImpulsePartitionCache
+{
+public:
+    static ImpulsePartitionCache& getInstance()
+    {
+        static ImpulsePartitionCache cache;
+        return cache;
+    }
+
+    template <typename CreateSegments>
+    std::shared_ptr<const ImpulsePartitions> getPartitions (const float* samples,
+                                                            size_t numSamples,
+                                                            size_t blockSize,
+                                                            CreateSegments&& createSegments)
+    {
+        const Key key { hashSamples (samples, numSamples), numSamples, blockSize };
+
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (auto existing = find (key, samples))
+                return existing;
+        }
+
+        // The partitions are created without holding the lock, so that loading
+        // one IR doesn't hold up the loading of others
+        auto created = std::make_shared<const ImpulsePartitions> (ImpulsePartitions { { samples, samples + numSamples },
+                                                                                      createSegments() });
+
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        if (auto existing = find (key, samples))
+            return existing;
+
+        entries.erase (std::remove_if (entries.begin(), entries.end(), [] (const Entry& e) { return e.partitions.expired(); }),
+                       entries.end());
+
+        entries.push_back ({ key, created });
+        return created;
+    }
+
+    size_t getNumSharedPartitions()
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        return (size_t) std::count_if (entries.begin(), entries.end(), [] (const Entry& e) { return ! e.partitions.expired(); });
+    }
+
+private:
+    struct Key
+    {
+        uint64 hash;
+        size_t numSamples, blockSize;
+
+        bool operator== (const Key& other) const noexcept
+        {
+            return hash == other.hash && numSamples == other.numSamples && blockSize == other.blockSize;
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        std::weak_ptr<const ImpulsePartitions> partitions;
+    };
+
+    static uint64 hashSamples (const float* samples, size_t numSamples) noexcept
+    {
+        // FNV-1a, over the bit patterns of the samples
+        auto hash = (uint64) 0xcbf29ce484222325;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            uint32 bits;
+            std::memcpy (&bits, samples + i, sizeof (bits));
+            hash = (hash ^ bits) * (uint64) 0x100000001b3;
+        }
+
+        return hash;
+    }
+
+    std::shared_ptr<const ImpulsePartitions> find (const Key& key, const float* samples) const
+    {
+        for (const auto& entry : entries)
+            if (entry.key == key)
+                if (auto partitions = entry.partitions.lock())
+                    if (std::equal (partitions->samples.begin(), partitions->samples.end(), samples))
+                        return partitions;
+
+        return nullptr;
+    }
+
+    std::vector<Entry> entries;
+    std::mutex mutex;
+};
+
 //==============================================================================
 struct ConvolutionEngine
 {
@@ -185,29 +293,36 @@ struct ConvolutionEngine
         };
 
         updateSegmentsIfNecessary (numInputSegments, buffersInputSegments);
-        updateSegmentsIfNecessary (numSegments,      buffersImpulseSegments);
 
-        auto FFTTempObject = std::make_unique<FFT> (roundToInt (std::log2 (fftSize)));
-        size_t currentPtr = 0;
-
-        for (auto& buf : buffersImpulseSegments)
+        impulseSegments = ImpulsePartitionCache::getInstance().getPartitions (samples, numSamples, blockSize, [&]
         {
-            buf.clear();
+            std::vector<AudioBuffer<float>> result;
+            updateSegmentsIfNecessary (numSegments, result);
 
-            auto* impulseResponse = buf.getWritePointer (0);
+            auto FFTTempObject = std::make_unique<FFT> (roundToInt (std::log2 (fftSize)));
+            size_t currentPtr = 0;
 
-            if (&buf == &buffersImpulseSegments.front())
-                impulseResponse[0] = 1.0f;
+            for (auto& buf : result)
+            {
+                buf.clear();
 
-            FloatVectorOperations::copy (impulseResponse,
-                                         samples + currentPtr,
-                                         static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+                auto* impulseResponse = buf.getWritePointer (0);
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+                if (&buf == &result.front())
+                    impulseResponse[0] = 1.0f;
 
-            currentPtr += (fftSize - blockSize);
-        }
+                FloatVectorOperations::copy (impulseResponse,
+                                             samples + currentPtr,
+                                             static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+
+                FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
+                prepareForConvolution (impulseResponse);
+
+                currentPtr += (fftSize - blockSize);
+            }
+
+            return result;
+        });
 
         reset();
     }
@@ -224,6 +339,8 @@ struct ConvolutionEngine
 
         currentSegment = 0;
         inputDataPos = 0;
+        numSilentBlocks = numInputSegments;
+        currentBlockIsSilent = true;
     }
 
     void processSamples (const float* input, float* output, size_t numSamples)
@@ -231,8 +348,6 @@ struct ConvolutionEngine
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
         auto* inputData      = bufferInput.getWritePointer (0);
         auto* outputTempData = bufferTempOutput.getWritePointer (0);
         auto* outputData     = bufferOutput.getWritePointer (0);
@@ -244,6 +359,7 @@ struct ConvolutionEngine
             auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
 
             FloatVectorOperations::copy (inputData + inputDataPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
+            currentBlockIsSilent = currentBlockIsSilent && isSilent (input + numSamplesProcessed, numSamplesToProcess);
 
             auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
             FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
@@ -254,27 +370,13 @@ struct ConvolutionEngine
             // Complex multiplication
             if (inputDataWasEmpty)
             {
-                FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
-
-                auto index = currentSegment;
-
-                for (size_t i = 1; i < numSegments; ++i)
-                {
-                    index += indexStep;
-
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
-
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
-                }
+                accumulatePreviousSegments (outputTempData);
             }
 
             FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
             convolutionProcessingAndAccumulate (inputSegmentData,
-                                                buffersImpulseSegments.front().getWritePointer (0),
+                                                impulseSegments->segments.front().getReadPointer (0),
                                                 outputData);
 
             updateSymmetricFrequencyDomainData (outputData);
@@ -299,7 +401,7 @@ struct ConvolutionEngine
                 // Save the overlap
                 FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
 
-                currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+                finishBlock();
             }
 
             numSamplesProcessed += numSamplesToProcess;
@@ -311,12 +413,8 @@ struct ConvolutionEngine
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
         auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
         auto* outputData     = bufferOutput.getWritePointer (0);
-        auto* overlapData    = bufferOverlap.getWritePointer (0);
 
         while (numSamplesProcessed < numSamples)
         {
@@ -332,58 +430,100 @@ struct ConvolutionEngine
             // processing itself when needed (with latency)
             if (inputDataPos == blockSize)
             {
-                // Copy input data in input segment
-                auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
-                FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
+                processFullInputBlock();
+                inputDataPos = 0;
+            }
+        }
+    }
 
-                fftObject->performRealOnlyForwardTransform (inputSegmentData);
-                prepareForConvolution (inputSegmentData);
+    // Convolves the blockSize samples at the start of bufferInput, leaving the next
+    // blockSize output samples at the start of bufferOutput and clearing the input.
+    void processFullInputBlock()
+    {
+        auto* inputData      = bufferInput.getWritePointer (0);
+        auto* outputTempData = bufferTempOutput.getWritePointer (0);
+        auto* outputData     = bufferOutput.getWritePointer (0);
+        auto* overlapData    = bufferOverlap.getWritePointer (0);
 
-                // Complex multiplication
-                FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
+        currentBlockIsSilent = isSilent (inputData, blockSize);
 
-                auto index = currentSegment;
+        // Copy input data in input segment
+        auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
+        FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
-                for (size_t i = 1; i < numSegments; ++i)
-                {
-                    index += indexStep;
+        fftObject->performRealOnlyForwardTransform (inputSegmentData);
+        prepareForConvolution (inputSegmentData);
 
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
+        // Complex multiplication
+        accumulatePreviousSegments (outputTempData);
 
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
-                }
+        FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
-                FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
+        convolutionProcessingAndAccumulate (inputSegmentData,
+                                            impulseSegments->segments.front().getReadPointer (0),
+                                            outputData);
 
-                convolutionProcessingAndAccumulate (inputSegmentData,
-                                                    buffersImpulseSegments.front().getWritePointer (0),
-                                                    outputData);
+        updateSymmetricFrequencyDomainData (outputData);
+        fftObject->performRealOnlyInverseTransform (outputData);
 
-                updateSymmetricFrequencyDomainData (outputData);
-                fftObject->performRealOnlyInverseTransform (outputData);
+        // Add overlap
+        FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
 
-                // Add overlap
-                FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
+        // Input buffer is empty again now
+        FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
 
-                // Input buffer is empty again now
-                FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
+        // Extra step for segSize > blockSize
+        FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
 
-                // Extra step for segSize > blockSize
-                FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+        // Save the overlap
+        FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
 
-                // Save the overlap
-                FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+        finishBlock();
+    }
 
-                currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+    // Sums the products of the IR partitions after the first with the previous input
+    // blocks. The blocks that were silent contribute nothing, so their partitions are
+    // skipped. This means that an engine that has stopped receiving input only does
+    // the work for the part of its tail that is still ringing out.
+    void accumulatePreviousSegments (float* outputTempData)
+    {
+        const auto indexStep = numInputSegments / numSegments;
 
-                inputDataPos = 0;
-            }
+        FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
+
+        auto index = currentSegment;
+
+        for (size_t i = 1; i < numSegments; ++i)
+        {
+            index += indexStep;
+
+            if (index >= numInputSegments)
+                index -= numInputSegments;
+
+            // The segment at this index holds the input from i * indexStep blocks ago
+            if (i * indexStep <= numSilentBlocks)
+                continue;
+
+            convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
+                                                impulseSegments->segments[i].getReadPointer (0),
+                                                outputTempData);
         }
     }
 
+    void finishBlock() noexcept
+    {
+        numSilentBlocks = currentBlockIsSilent ? jmin (numSilentBlocks + 1, numInputSegments) : 0;
+        currentBlockIsSilent = true;
+
+        currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+    }
+
+    static bool isSilent (const float* samples, size_t numSamples) noexcept
+    {
+        const auto range = FloatVectorOperations::findMinAndMax (samples, static_cast<int> (numSamples));
+        return exactlyEqual (range.getStart(), 0.0f) && exactlyEqual (range.getEnd(), 0.0f);
+    }
+
     // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
     void prepareForConvolution (float *samples) noexcept
     {
@@ -442,8 +582,200 @@ struct ConvolutionEngine
     const size_t numInputSegments;
     size_t currentSegment = 0, inputDataPos = 0;
 
+    // The number of most recent complete input blocks that were entirely silent
+    size_t numSilentBlocks = 0;
+    bool currentBlockIsSilent = true;
+
     AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-    std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+    std::vector<AudioBuffer<float>> buffersInputSegments;
+    std::shared_ptr<const ImpulsePartitions> impulseSegments;
+};
+
+//==============================================================================
+// One partition of a non-uniform tail, convolved one block at a time on a
+// background thread.
+//
+// The IR segment starts at twice the block size, so the result of each input
+// block isn't needed until a whole block after that input has been collected.
+// This gives the background thread one block period to do the work. If the
+// thread hasn't started on a block by the time it is needed, the audio thread
+// will process it instead, so the output never depends on thread timing.
+class BackgroundTailSegment
+{
+public:
+    BackgroundTailSegment (const float* samples, size_t numSamples, size_t blockSizeIn)
+        : engine (samples, numSamples, blockSizeIn),
+          blockSize (blockSizeIn),
+          pendingInput (1, static_cast<int> (blockSize)),
+          playback (1, static_cast<int> (blockSize))
+    {
+        pendingInput.clear();
+        playback.clear();
+    }
+
+    // Called on the audio thread. Adds the output of this segment to the output
+    // array, and returns true if a new block has been handed to the background thread.
+    bool processSamples (const float* input, float* output, size_t numSamples)
+    {
+        auto* pendingData  = pendingInput.getWritePointer (0);
+        auto* playbackData = playback.getWritePointer (0);
+        auto submittedBlock = false;
+
+        for (size_t numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
+        {
+            const auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - position);
+
+            FloatVectorOperations::copy (pendingData + position, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
+            FloatVectorOperations::add (output + numSamplesProcessed, playbackData + position, static_cast<int> (numSamplesToProcess));
+
+            numSamplesProcessed += numSamplesToProcess;
+            position += numSamplesToProcess;
+
+            if (position == blockSize)
+            {
+                position = 0;
+
+                if (waitForCurrentBlock())
+                    FloatVectorOperations::copy (playbackData, engine.bufferOutput.getReadPointer (0), static_cast<int> (blockSize));
+
+                FloatVectorOperations::copy (engine.bufferInput.getWritePointer (0), pendingData, static_cast<int> (blockSize));
+                state.store (State::queued, std::memory_order_release);
+                submittedBlock = true;
+            }
+        }
+
+        return submittedBlock;
+    }
+
+    // Called on the background thread. Returns true if a block was processed.
+    bool tryProcessQueuedBlock()
+    {
+        auto expected = State::queued;
+
+        if (! state.compare_exchange_strong (expected, State::running, std::memory_order_acquire))
+            return false;
+
+        engine.processFullInputBlock();
+        state.store (State::done, std::memory_order_release);
+        return true;
+    }
+
+    void reset()
+    {
+        waitForCurrentBlock();
+        state.store (State::idle, std::memory_order_relaxed);
+
+        engine.reset();
+        pendingInput.clear();
+        playback.clear();
+        position = 0;
+    }
+
+private:
+    enum class State { idle, queued, running, done };
+
+    // Returns false if no block had been submitted
+    bool waitForCurrentBlock()
+    {
+        if (state.load (std::memory_order_acquire) == State::idle)
+            return false;
+
+        // If the background thread is already working on this block, it won't be long
+        if (! tryProcessQueuedBlock())
+            while (state.load (std::memory_order_acquire) != State::done) {}
+
+        return true;
+    }
+
+    ConvolutionEngine engine;
+    const size_t blockSize;
+    size_t position = 0;
+    AudioBuffer<float> pendingInput, playback;
+    std::atomic<State> state { State::idle };
+};
+
+//==============================================================================
+// Splits the part of an IR after the head into partitions that double in size,
+// and convolves them on a background thread.
+class BackgroundTailProcessor  : private Thread
+{
+public:
+    BackgroundTailProcessor (const AudioBuffer<float>& buf, int numChannels, int headSize)
+        : Thread ("Convolution tail")
+    {
+        // Each segment covers [2 * blockSize, 4 * blockSize) of the IR,
+        // except for the last one which uses the largest size for the rest
+        constexpr auto maxBlockSize = 16384;
+        const auto irSize = buf.getNumSamples();
+
+        for (auto offset = headSize; offset < irSize;)
+        {
+            const auto segmentBlockSize = jmin (maxBlockSize, offset / 2);
+            const auto length = segmentBlockSize < maxBlockSize ? jmin (offset, irSize - offset)
+                                                                : irSize - offset;
+
+            segments.emplace_back();
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+            {
+                segments.back().push_back (std::make_unique<BackgroundTailSegment> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, channel), offset),
+                                                                                    static_cast<size_t> (length),
+                                                                                    static_cast<size_t> (segmentBlockSize)));
+            }
+
+            offset += length;
+        }
+
+        if (! startRealtimeThread (RealtimeOptions{}))
+            startThread (Priority::highest);
+    }
+
+    ~BackgroundTailProcessor() override
+    {
+        stopThread (-1);
+    }
+
+    // Adds the tail's output for one channel to the output array
+    void processSamples (size_t channel, const float* input, float* output, size_t numSamples)
+    {
+        auto submittedBlock = false;
+
+        for (auto& segment : segments)
+            submittedBlock = segment[channel]->processSamples (input, output, numSamples) || submittedBlock;
+
+        if (submittedBlock)
+            notify();
+    }
+
+    void reset()
+    {
+        for (auto& segment : segments)
+            for (auto& channel : segment)
+                channel->reset();
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            // The smallest blocks have the closest deadlines, so always start the search from the front
+            const auto processNextBlock = [this]
+            {
+                for (auto& segment : segments)
+                    for (auto& channel : segment)
+                        if (channel->tryProcessQueuedBlock())
+                            return true;
+
+                return false;
+            };
+
+            if (! processNextBlock())
+                wait (-1);
+        }
+    }
+
+    std::vector<std::vector<std::unique_ptr<BackgroundTailSegment>>> segments;
 };
 
 //==============================================================================
@@ -475,6 +807,19 @@ public:
             for (int i = 0; i < numChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
         }
+        else if (headSizeIn.processTailInBackground)
+        {
+            // The first tail segment needs a block size of at least the audio block
+            // size for the background thread to have any time to process it
+            const auto size = jmin (buf.getNumSamples(),
+                                    jmax (headSizeIn.headSizeInSamples, 2 * nextPowerOfTwo (maxBlockSize)));
+
+            for (int i = 0; i < numChannels; ++i)
+                head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
+
+            if (size != buf.getNumSamples())
+                backgroundTail = std::make_unique<BackgroundTailProcessor> (buf, numChannels, size);
+        }
         else
         {
             const auto size = jmin (buf.getNumSamples(), headSizeIn.headSizeInSamples);
@@ -497,6 +842,9 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        if (backgroundTail != nullptr)
+            backgroundTail->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -507,14 +855,24 @@ public:
         const AudioBlock<float> fullTailBlock (tailBuffer);
         const auto tailBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples);
 
-        const auto isUniform = tail.empty();
+        const auto isUniform = tail.empty() && backgroundTail == nullptr;
 
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
-            if (! isUniform)
+            if (backgroundTail != nullptr)
+            {
+                tailBlock.clear();
+                backgroundTail->processSamples (channel,
+                                                input.getChannelPointer (channel),
+                                                tailBlock.getChannelPointer (0),
+                                                numSamples);
+            }
+            else if (! isUniform)
+            {
                 tail[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
                                                                tailBlock.getChannelPointer (0),
                                                                numSamples);
+            }
 
             if (isZeroDelay)
                 head[channel]->processSamples (input.getChannelPointer (channel),
@@ -541,6 +899,7 @@ public:
 
 private:
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
+    std::unique_ptr<BackgroundTailProcessor> backgroundTail;
     AudioBuffer<float> tailBuffer;
 
     const int latency;
@@ -740,7 +1099,8 @@ public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
                               Convolution::NonUniform requiredHeadSize)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
-          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
+          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)),
+                     requiredHeadSize.processTailInBackground },
           shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
     {}
 
@@ -845,6 +1205,15 @@ static void setImpulseResponse (ConvolutionEngineFactory& factory,
                                 stereo, trim, normalise);
 }
 
+// IRs are prepared on a pool of threads that is shared by every Convolution in the
+// process, so that a slow load in one instance doesn't hold up the others.
+static ThreadPool& getImpulseResponseLoaderPool()
+{
+    static ThreadPool pool { ThreadPoolOptions{}.withThreadName ("Convolution IR loader")
+                                                .withNumberOfThreads (jlimit (1, 4, SystemStats::getNumCpus() / 2)) };
+    return pool;
+}
+
 // This class acts as a destination for convolution engines which are loaded on
 // a background thread.
 
@@ -902,6 +1271,13 @@ public:
         factory.setProcessSpec (spec);
     }
 
+    // Blocks until any IRs that have been handed to the loader pool are ready.
+    void waitForPendingLoads()
+    {
+        std::unique_lock<std::mutex> lock (loadMutex);
+        loadFinished.wait (lock, [this] { return ! loadInProgress; });
+    }
+
     // Call this regularly to try to resend any pending message.
     // This allows us to always apply the most recently requested
     // state (eventually), even if the message queue fills up.
@@ -917,6 +1293,8 @@ public:
     std::unique_ptr<MultichannelEngine> getEngine() { return factory.getEngine(); }
 
 private:
+    using Load = std::function<void (ConvolutionEngineFactory&)>;
+
     template <typename Fn>
     void callLater (Fn&& fn)
     {
@@ -925,32 +1303,97 @@ private:
         pendingCommand = [weak = weakFromThis(), callback = std::forward<Fn> (fn)]() mutable
         {
             if (auto t = weak.lock())
-                callback (t->factory);
+                t->startLoad (std::move (callback));
         };
 
         postPendingCommand();
     }
 
+    // Called on the message queue's thread. The loads for this instance are run one
+    // at a time, so that they finish in the order they were requested, but the loads
+    // for different instances can run in parallel. If several loads arrive while one is
+    // running, only the most recent is kept, as the others would be replaced anyway.
+    void startLoad (Load load)
+    {
+        {
+            const std::lock_guard<std::mutex> lock (loadMutex);
+
+            if (loadInProgress)
+            {
+                nextLoad = std::move (load);
+                return;
+            }
+
+            loadInProgress = true;
+        }
+
+        getImpulseResponseLoaderPool().addJob ([weak = weakFromThis(), l = std::move (load)]() mutable
+        {
+            if (auto t = weak.lock())
+                t->runLoads (std::move (l));
+        });
+    }
+
+    void runLoads (Load load)
+    {
+        for (;;)
+        {
+            load (factory);
+
+            const std::lock_guard<std::mutex> lock (loadMutex);
+
+            if (nextLoad == nullptr)
+            {
+                loadInProgress = false;
+                loadFinished.notify_all();
+                return;
+            }
+
+            load = std::exchange (nextLoad, nullptr);
+        }
+    }
+
     std::weak_ptr<ConvolutionEngineQueue> weakFromThis() { return shared_from_this(); }
 
     BackgroundMessageQueue& messageQueue;
     ConvolutionEngineFactory factory;
     BackgroundMessageQueue::IncomingCommand pendingCommand;
+
+    std::mutex loadMutex;
+    std::condition_variable loadFinished;
+    Load nextLoad;
+    bool loadInProgress = false;
 };
 
+// Switches from one engine to another without the cost of running two whole engines.
+// Over a short time the input is moved across from the previous engine to the current
+// one, after which the previous engine is only fed silence. Engines skip the IR
+// partitions for silent input, so the previous engine only works on the part of its
+// tail that is still ringing out, while the new engine's work builds up as its input
+// history fills. Between them they do about as much work as a single engine. The
+// tail of the previous engine is faded out over a longer time, so that it can be
+// destroyed without waiting for the whole IR to ring out.
 class CrossoverMixer
 {
 public:
     void reset()
     {
-        smoother.setCurrentAndTargetValue (1.0f);
+        inputSmoother.setCurrentAndTargetValue (0.0f);
+        outputSmoother.setCurrentAndTargetValue (0.0f);
     }
 
     void prepare (const ProcessSpec& spec)
     {
-        smoother.reset (spec.sampleRate, 0.05);
-        smootherBuffer.setSize (1, static_cast<int> (spec.maximumBlockSize));
-        mixBuffer.setSize (static_cast<int> (spec.numChannels), static_cast<int> (spec.maximumBlockSize));
+        inputSmoother.reset (spec.sampleRate, 0.01);
+        outputSmoother.reset (spec.sampleRate, 0.05);
+
+        const auto numChannels = static_cast<int> (spec.numChannels);
+        const auto numSamples = static_cast<int> (spec.maximumBlockSize);
+
+        smootherBuffer.setSize (1, numSamples);
+        previousInputBuffer.setSize (numChannels, numSamples);
+        currentInputBuffer.setSize (numChannels, numSamples);
+        mixBuffer.setSize (numChannels, numSamples);
         reset();
     }
 
@@ -961,57 +1404,84 @@ public:
                          ProcessPrevious&& previous,
                          NotifyDone&& notifyDone)
     {
-        if (smoother.isSmoothing())
+        if (! outputSmoother.isSmoothing())
         {
-            const auto numSamples = static_cast<int> (input.getNumSamples());
+            current (input, output);
+            return;
+        }
 
-            for (auto sample = 0; sample != numSamples; ++sample)
-                smootherBuffer.setSample (0, sample, smoother.getNextValue());
+        const auto numSamples = input.getNumSamples();
+        const auto numInputChannels = input.getNumChannels();
 
-            AudioBlock<float> mixBlock (mixBuffer);
-            mixBlock.clear();
-            previous (input, mixBlock);
+        auto previousInput = AudioBlock<float> (previousInputBuffer).getSubsetChannelBlock (0, numInputChannels)
+                                                                    .getSubBlock (0, numSamples);
+        auto mixBlock = AudioBlock<float> (mixBuffer).getSubsetChannelBlock (0, output.getNumChannels())
+                                                     .getSubBlock (0, numSamples);
+        mixBlock.clear();
 
-            for (size_t channel = 0; channel != output.getNumChannels(); ++channel)
-            {
-                FloatVectorOperations::multiply (mixBlock.getChannelPointer (channel),
-                                                 smootherBuffer.getReadPointer (0),
-                                                 numSamples);
-            }
-
-            FloatVectorOperations::multiply (smootherBuffer.getWritePointer (0), -1.0f, numSamples);
-            FloatVectorOperations::add (smootherBuffer.getWritePointer (0), 1.0f, numSamples);
+        if (inputSmoother.isSmoothing())
+        {
+            // The input may share its storage with the output, so split it before processing
+            auto currentInput = AudioBlock<float> (currentInputBuffer).getSubsetChannelBlock (0, numInputChannels)
+                                                                      .getSubBlock (0, numSamples);
 
-            current (input, output);
+            fillSmootherBuffer (inputSmoother, numSamples);
 
-            for (size_t channel = 0; channel != output.getNumChannels(); ++channel)
+            for (size_t channel = 0; channel != numInputChannels; ++channel)
             {
-                FloatVectorOperations::multiply (output.getChannelPointer (channel),
+                FloatVectorOperations::multiply (previousInput.getChannelPointer (channel),
+                                                 input.getChannelPointer (channel),
                                                  smootherBuffer.getReadPointer (0),
-                                                 numSamples);
-                FloatVectorOperations::add (output.getChannelPointer (channel),
-                                            mixBlock.getChannelPointer (channel),
-                                            numSamples);
+                                                 static_cast<int> (numSamples));
+                FloatVectorOperations::subtract (currentInput.getChannelPointer (channel),
+                                                 input.getChannelPointer (channel),
+                                                 previousInput.getChannelPointer (channel),
+                                                 static_cast<int> (numSamples));
             }
 
-            if (! smoother.isSmoothing())
-                notifyDone();
+            previous (previousInput, mixBlock);
+            current (currentInput, output);
         }
         else
         {
+            previousInput.clear();
+            previous (previousInput, mixBlock);
             current (input, output);
         }
+
+        fillSmootherBuffer (outputSmoother, numSamples);
+
+        for (size_t channel = 0; channel != output.getNumChannels(); ++channel)
+        {
+            FloatVectorOperations::addWithMultiply (output.getChannelPointer (channel),
+                                                    mixBlock.getChannelPointer (channel),
+                                                    smootherBuffer.getReadPointer (0),
+                                                    static_cast<int> (numSamples));
+        }
+
+        if (! outputSmoother.isSmoothing())
+            notifyDone();
     }
 
     void beginTransition()
     {
-        smoother.setCurrentAndTargetValue (1.0f);
-        smoother.setTargetValue (0.0f);
+        for (auto* smoother : { &inputSmoother, &outputSmoother })
+        {
+            smoother->setCurrentAndTargetValue (1.0f);
+            smoother->setTargetValue (0.0f);
+        }
     }
 
 private:
-    LinearSmoothedValue<float> smoother;
+    void fillSmootherBuffer (LinearSmoothedValue<float>& smoother, size_t numSamples)
+    {
+        for (auto sample = 0; sample != static_cast<int> (numSamples); ++sample)
+            smootherBuffer.setSample (0, sample, smoother.getNextValue());
+    }
+
+    LinearSmoothedValue<float> inputSmoother, outputSmoother;
     AudioBuffer<float> smootherBuffer;
+    AudioBuffer<float> previousInputBuffer, currentInputBuffer;
     AudioBuffer<float> mixBuffer;
 };
 
@@ -1042,6 +1512,7 @@ public:
     void prepare (const ProcessSpec& spec)
     {
         messageQueue->pimpl->popAll();
+        engineQueue->waitForPendingLoads();
         mixer.prepare (spec);
         engineQueue->prepare (spec);
 
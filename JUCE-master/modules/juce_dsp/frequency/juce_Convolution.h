@@ -39,7 +39,9 @@ namespace juce::dsp
     Used by the Convolution to dispatch engine-update messages on a background
     thread.
 
-    May be shared between multiple Convolution instances.
+    May be shared between multiple Convolution instances. The impulse responses
+    themselves are prepared on a pool of threads shared by every Convolution, so
+    instances sharing a queue can still load their impulse responses in parallel.
 
     @tags{DSP}
 */
@@ -97,6 +99,16 @@ private:
     latency version of the algorithm, or a simple non-uniform partitioned
     convolution algorithm.
 
+    Convolutions which end up with identical impulse responses (after any
+    trimming, normalisation and resampling) and the same partition sizes share
+    a single read-only copy of the frequency-domain partitions, so many
+    instances of the same IR don't use much more memory than one.
+
+    When a new impulse response is loaded, the input is moved across to the new
+    engine over a few milliseconds while the tail of the old engine fades out.
+    The engines skip the parts of the impulse response that only apply to
+    silent input, so the changeover costs about as much as running one engine.
+
     Threading: It is not safe to interleave calls to the methods of this
     class. If you need to load new impulse responses during processing the
     load() calls must be synchronised with process() calls, which in practice
@@ -138,7 +150,22 @@ public:
     explicit Convolution (const Latency& requiredLatency);
 
     /** Contains configuration information for a non-uniform convolution. */
-    struct NonUniform { int headSizeInSamples; };
+    struct NonUniform
+    {
+        /** The part of the IR which is processed with the smallest partitions. */
+        int headSizeInSamples;
+
+        /** If true, the rest of the IR is split into partitions which double in
+            size, and these are processed on a background thread instead of the
+            audio thread.
+
+            The output is the same as in the default mode and there is still no
+            latency, but the audio thread only has to process the head. If the
+            background thread falls behind, the audio thread will do the work
+            instead.
+        */
+        bool processTailInBackground = false;
+    };
 
     /** Initialises an object for performing convolution in the frequency domain
         using a non-uniform partitioned algorithm.
@@ -147,6 +174,10 @@ public:
         efficiency of the processing for IR sizes of 4096 samples or greater
         (recommended for reverberation IRs).
 
+        For very long IRs, and especially at small block sizes, also setting
+        NonUniform::processTailInBackground greatly reduces the CPU used by
+        each call to process().
+
         @param requiredHeadSize       the head IR size for two stage non-uniform
                                       partitioned convolution
      */
@@ -250,6 +250,62 @@ class ConvolutionTest final : public UnitTest
             testConvolution (spec, config, ir, irSampleRate, stereo, trim, normalise, expectedResult, sequence);
     }
 
+    // Feeds bursts of noise separated by silence through a convolution, so that the
+    // partitions holding silent input are skipped, and compares the output against
+    // a direct convolution.
+    template <typename ConvolutionConfig>
+    void testIntermittentInput (const ProcessSpec& spec, const ConvolutionConfig& config)
+    {
+        Random random;
+        const auto blockSize = static_cast<int> (spec.maximumBlockSize);
+
+        AudioBuffer<float> ir (1, blockSize * 6);
+
+        for (auto i = 0; i != ir.getNumSamples(); ++i)
+            ir.setSample (0, i, (random.nextFloat() - 0.5f) * 0.01f);
+
+        const auto numBlocks = 40;
+        AudioBuffer<float> input (1, numBlocks * blockSize);
+        input.clear();
+
+        for (auto blockIndex = 0; blockIndex < numBlocks; blockIndex += 1 + blockIndex % 9)
+            for (auto i = 0; i != blockSize; ++i)
+                input.setSample (0, blockIndex * blockSize + i, random.nextFloat() - 0.5f);
+
+        Convolution convolution (config);
+        auto copiedIr = ir;
+        convolution.loadImpulseResponse (std::move (copiedIr), spec.sampleRate, Convolution::Stereo::no, Convolution::Trim::no, Convolution::Normalise::no);
+        convolution.prepare (spec);
+
+        const auto latency = convolution.getLatency();
+        AudioBuffer<float> output (1, input.getNumSamples());
+        AudioBuffer<float> buffer (1, blockSize);
+
+        for (auto blockIndex = 0; blockIndex != numBlocks; ++blockIndex)
+        {
+            buffer.copyFrom (0, 0, input, 0, blockIndex * blockSize, blockSize);
+
+            AudioBlock<float> block { buffer };
+            convolution.process (ProcessContextReplacing<float> { block });
+
+            output.copyFrom (0, blockIndex * blockSize, buffer, 0, 0, blockSize);
+        }
+
+        auto maxError = 0.0f;
+
+        for (auto i = latency; i < output.getNumSamples(); ++i)
+        {
+            auto expected = 0.0f;
+
+            for (auto j = 0; j <= jmin (i - latency, ir.getNumSamples() - 1); ++j)
+                expected += ir.getSample (0, j) * input.getSample (0, i - latency - j);
+
+            maxError = jmax (maxError, std::abs (output.getSample (0, i) - expected));
+        }
+
+        expectLessThan (maxError, 1.0e-4f);
+    }
+
 public:
     ConvolutionTest()
         : UnitTest ("Convolution", UnitTestCategories::dsp)
@@ -538,6 +594,34 @@ public:
             }
         }
 
+        beginTest ("Convolutions with identical IRs share their partitions");
+        {
+            auto& cache = ImpulsePartitionCache::getInstance();
+            const auto numSharedBefore = cache.getNumSharedPartitions();
+
+            // Make sure that no other engine is already using this IR
+            auto ir = impulseData;
+            ir.applyGain (0.5f);
+
+            const auto makeConvolution = [&]
+            {
+                auto result = std::make_unique<Convolution>();
+                auto copiedIr = ir;
+                result->loadImpulseResponse (std::move (copiedIr), spec.sampleRate, Convolution::Stereo::yes, Convolution::Trim::no, Convolution::Normalise::no);
+                result->prepare (spec);
+                return result;
+            };
+
+            const auto first = makeConvolution();
+            const auto numSharedWithOne = cache.getNumSharedPartitions();
+
+            // One set of partitions for each channel of the IR
+            expect (numSharedWithOne == numSharedBefore + 2);
+
+            const auto second = makeConvolution();
+            expect (cache.getNumSharedPartitions() == numSharedWithOne);
+        }
+
         beginTest ("Non-uniform convolutions work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -555,6 +639,23 @@ public:
             }
         }
 
+        beginTest ("Non-uniform convolutions with a background tail work");
+        {
+            const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 64);
+
+            for (auto headSize : { spec.maximumBlockSize / 2, spec.maximumBlockSize * 4 })
+            {
+                testConvolution (spec,
+                                 Convolution::NonUniform { static_cast<int> (headSize), true },
+                                 ramp,
+                                 spec.sampleRate,
+                                 Convolution::Stereo::yes,
+                                 Convolution::Trim::no,
+                                 Convolution::Normalise::no,
+                                 ramp);
+            }
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -576,6 +677,75 @@ public:
                                  ramp);
             }
         }
+
+        beginTest ("Convolutions skip the partitions for silent input without changing the output");
+        {
+            const ProcessSpec monoSpec { spec.sampleRate, spec.maximumBlockSize, 1 };
+
+            testIntermittentInput (monoSpec, Convolution::Latency { 0 });
+            testIntermittentInput (monoSpec, Convolution::Latency { static_cast<int> (spec.maximumBlockSize) * 2 });
+            testIntermittentInput (monoSpec, Convolution::NonUniform { static_cast<int> (spec.maximumBlockSize) });
+            testIntermittentInput (monoSpec, Convolution::NonUniform { static_cast<int> (spec.maximumBlockSize), true });
+            testIntermittentInput ({ spec.sampleRate, 64, 1 }, Convolution::Latency { 0 });
+        }
+
+        beginTest ("Convolutions sharing a message queue all load their most recent IR");
+        {
+            ConvolutionMessageQueue queue;
+            std::vector<std::unique_ptr<Convolution>> convolutions;
+
+            for (auto i = 0; i != 4; ++i)
+            {
+                convolutions.push_back (std::make_unique<Convolution> (queue));
+                convolutions.back()->prepare (spec);
+            }
+
+            const auto getFinalIRSize = [] (size_t index) { return 1000 + 100 * (int) index; };
+
+            for (auto length : { 300, 200, 100 })
+            {
+                for (size_t i = 0; i != convolutions.size(); ++i)
+                {
+                    auto ir = makeRamp (length == 100 ? getFinalIRSize (i) : length);
+                    convolutions[i]->loadImpulseResponse (std::move (ir), spec.sampleRate, Convolution::Stereo::no, Convolution::Trim::no, Convolution::Normalise::no);
+                }
+            }
+
+            const auto allLoaded = [&]
+            {
+                for (size_t i = 0; i != convolutions.size(); ++i)
+                    if (convolutions[i]->getCurrentIRSize() != getFinalIRSize (i))
+                        return false;
+
+                return true;
+            };
+
+            const auto time = Time::getMillisecondCounter();
+
+            while (! allLoaded() && Time::getMillisecondCounter() - time < 10'000)
+            {
+                for (auto& convolution : convolutions)
+                {
+                    addDiracImpulse (block);
+                    convolution->process (context);
+                }
+            }
+
+            expect (allLoaded());
+
+            // Keep going until any transitions have finished, to make sure that no
+            // earlier IR replaces the most recent one
+            nTimes (100, [&]
+            {
+                for (auto& convolution : convolutions)
+                {
+                    addDiracImpulse (block);
+                    convolution->process (context);
+                }
+            });
+
+            expect (allLoaded());
+        }
     }
 };
 
@@ -41,6 +41,27 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // Engines that can process several transforms more efficiently than one at a
+    // time should override these, the default versions just loop over the buffers.
+    virtual void performBatch (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                               int numTransforms, bool inverse) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            perform (inputs[i], outputs[i], inverse);
+    }
+
+    virtual void performRealOnlyForwardTransformBatch (float* const* data, int numTransforms, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            performRealOnlyForwardTransform (data[i], ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransformBatch (float* const* data, int numTransforms) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            performRealOnlyInverseTransform (data[i]);
+    }
 };
 
 struct FFT::Engine
@@ -102,6 +123,14 @@ struct FFTFallback final : public FFT::Instance
         configInverse.reset (new FFTConfig (1 << order, true));
 
         size = 1 << order;
+
+       #if JUCE_USE_SIMD
+        if (size >= minSizeForSIMDConfig)
+        {
+            simdForward.reset (new SIMDFFTConfig (size, false));
+            simdInverse.reset (new SIMDFFTConfig (size, true));
+        }
+       #endif
     }
 
     void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
@@ -116,6 +145,29 @@ struct FFTFallback final : public FFT::Instance
 
         jassert (configForward != nullptr);
 
+       #if JUCE_USE_SIMD
+        if (simdForward != nullptr)
+        {
+            auto& config = inverse ? *simdInverse : *simdForward;
+            auto* re = config.getInputReal();
+            auto* im = config.getInputImag();
+
+            for (int i = 0; i < size; ++i)
+            {
+                re[i] = input[i].real();
+                im[i] = input[i].imag();
+            }
+
+            const auto result = config.perform();
+            const float scaleFactor = inverse ? 1.0f / (float) size : 1.0f;
+
+            for (int i = 0; i < size; ++i)
+                output[i] = { result.re[i] * scaleFactor, result.im[i] * scaleFactor };
+
+            return;
+        }
+       #endif
+
         if (inverse)
         {
             configInverse->perform (input, output);
@@ -138,6 +190,29 @@ struct FFTFallback final : public FFT::Instance
         if (size == 1)
             return;
 
+       #if JUCE_USE_SIMD
+        if (simdForward != nullptr)
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+
+            auto* re = simdForward->getInputReal();
+            auto* im = simdForward->getInputImag();
+
+            std::copy (d, d + size, re);
+            std::fill (im, im + size, 0.0f);
+
+            const auto result = simdForward->perform();
+
+            for (int i = 0; i < size; ++i)
+            {
+                d[2 * i]     = result.re[i];
+                d[2 * i + 1] = result.im[i];
+            }
+
+            return;
+        }
+       #endif
+
         const size_t scratchSize = 16 + (size_t) size * sizeof (Complex<float>);
 
         if (scratchSize < maxFFTScratchSpaceToAlloca)
@@ -158,6 +233,35 @@ struct FFTFallback final : public FFT::Instance
         if (size == 1)
             return;
 
+       #if JUCE_USE_SIMD
+        if (simdInverse != nullptr)
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+
+            auto* re = simdInverse->getInputReal();
+            auto* im = simdInverse->getInputImag();
+
+            for (int i = 0; i < size; ++i)
+            {
+                // only the non-negative frequencies are used, the rest are their conjugates
+                const auto index = i < (size >> 1) ? i : size - i;
+                re[i] = d[2 * index];
+                im[i] = i < (size >> 1) ? d[2 * index + 1] : -d[2 * index + 1];
+            }
+
+            const auto result = simdInverse->perform();
+            const float scaleFactor = 1.0f / (float) size;
+
+            for (int i = 0; i < size; ++i)
+            {
+                d[i]        = result.re[i] * scaleFactor;
+                d[i + size] = result.im[i] * scaleFactor;
+            }
+
+            return;
+        }
+       #endif
+
         const size_t scratchSize = 16 + (size_t) size * sizeof (Complex<float>);
 
         if (scratchSize < maxFFTScratchSpaceToAlloca)
@@ -197,6 +301,217 @@ struct FFTFallback final : public FFT::Instance
         }
     }
 
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    // The batched versions process one transform per SIMD lane. All transforms of
+    // the same size share the twiddles and the butterfly structure, so interleaving
+    // them like this lets a single pass through the FFT do the work of several.
+    using Lanes = SIMDRegister<float>;
+    static constexpr int numLanes = (int) Lanes::SIMDNumElements;
+
+    struct ComplexLanes
+    {
+        ComplexLanes() = default;
+        ComplexLanes (Lanes r, Lanes i) noexcept : re (r), im (i) {}
+
+        Lanes real() const noexcept     { return re; }
+        Lanes imag() const noexcept     { return im; }
+
+        ComplexLanes& operator+= (const ComplexLanes& other) noexcept    { re += other.re; im += other.im; return *this; }
+        ComplexLanes& operator-= (const ComplexLanes& other) noexcept    { re -= other.re; im -= other.im; return *this; }
+        ComplexLanes& operator*= (Complex<float> w) noexcept             { return *this = *this * w; }
+
+        ComplexLanes operator- (const ComplexLanes& other) const noexcept
+        {
+            return { re - other.re, im - other.im };
+        }
+
+        ComplexLanes operator* (Complex<float> w) const noexcept
+        {
+            return { re * w.real() - im * w.imag(),
+                     re * w.imag() + im * w.real() };
+        }
+
+        Lanes re, im;
+    };
+
+    using LaneBuffer = float[numLanes];
+
+    struct alignas (sizeof (Lanes)) AlignedLaneBuffer
+    {
+        LaneBuffer re, im;
+    };
+
+    template <typename Callback>
+    void withLaneScratchSpace (Callback&& callback) const noexcept
+    {
+        const size_t scratchSize = alignof (ComplexLanes) + 2 * (size_t) size * sizeof (ComplexLanes);
+
+        if (scratchSize < maxFFTScratchSpaceToAlloca)
+        {
+            JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6255)
+            auto* scratch = snapPointerToAlignment (static_cast<char*> (alloca (scratchSize)), alignof (ComplexLanes));
+            JUCE_END_IGNORE_WARNINGS_MSVC
+            auto* in = unalignedPointerCast<ComplexLanes*> (scratch);
+            callback (in, in + size);
+        }
+        else
+        {
+            HeapBlock<char> heapSpace (scratchSize);
+            auto* in = unalignedPointerCast<ComplexLanes*> (snapPointerToAlignment (heapSpace.getData(), alignof (ComplexLanes)));
+            callback (in, in + size);
+        }
+    }
+
+    static ComplexLanes loadLanes (AlignedLaneBuffer& buffer) noexcept
+    {
+        return { Lanes::fromRawArray (buffer.re), Lanes::fromRawArray (buffer.im) };
+    }
+
+    static void storeLanes (const ComplexLanes& value, AlignedLaneBuffer& buffer) noexcept
+    {
+        value.re.copyToRawArray (buffer.re);
+        value.im.copyToRawArray (buffer.im);
+    }
+
+    void performBatch (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                       int numTransforms, bool inverse) const noexcept override
+    {
+        if (size == 1 || numTransforms < 2)
+        {
+            FFT::Instance::performBatch (inputs, outputs, numTransforms, inverse);
+            return;
+        }
+
+        withLaneScratchSpace ([&] (ComplexLanes* in, ComplexLanes* out)
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+            const auto scaleFactor = inverse ? 1.0f / (float) size : 1.0f;
+            AlignedLaneBuffer buffer {};
+
+            for (int first = 0; first < numTransforms; first += numLanes)
+            {
+                const auto numInGroup = jmin (numLanes, numTransforms - first);
+
+                for (int i = 0; i < size; ++i)
+                {
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        buffer.re[lane] = inputs[first + lane][i].real();
+                        buffer.im[lane] = inputs[first + lane][i].imag();
+                    }
+
+                    in[i] = loadLanes (buffer);
+                }
+
+                (inverse ? configInverse : configForward)->perform (in, out);
+
+                for (int i = 0; i < size; ++i)
+                {
+                    storeLanes (out[i], buffer);
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                        outputs[first + lane][i] = { buffer.re[lane] * scaleFactor,
+                                                     buffer.im[lane] * scaleFactor };
+                }
+            }
+        });
+    }
+
+    void performRealOnlyForwardTransformBatch (float* const* data, int numTransforms, bool ignoreNegativeFreqs) const noexcept override
+    {
+        if (size == 1 || numTransforms < 2)
+        {
+            FFT::Instance::performRealOnlyForwardTransformBatch (data, numTransforms, ignoreNegativeFreqs);
+            return;
+        }
+
+        withLaneScratchSpace ([&] (ComplexLanes* in, ComplexLanes* out)
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+            AlignedLaneBuffer buffer {};
+
+            for (int first = 0; first < numTransforms; first += numLanes)
+            {
+                const auto numInGroup = jmin (numLanes, numTransforms - first);
+
+                for (int i = 0; i < size; ++i)
+                {
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        buffer.re[lane] = data[first + lane][i];
+                        buffer.im[lane] = 0.0f;
+                    }
+
+                    in[i] = loadLanes (buffer);
+                }
+
+                configForward->perform (in, out);
+
+                for (int i = 0; i < size; ++i)
+                {
+                    storeLanes (out[i], buffer);
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        data[first + lane][2 * i]     = buffer.re[lane];
+                        data[first + lane][2 * i + 1] = buffer.im[lane];
+                    }
+                }
+            }
+        });
+    }
+
+    void performRealOnlyInverseTransformBatch (float* const* data, int numTransforms) const noexcept override
+    {
+        if (size == 1 || numTransforms < 2)
+        {
+            FFT::Instance::performRealOnlyInverseTransformBatch (data, numTransforms);
+            return;
+        }
+
+        withLaneScratchSpace ([&] (ComplexLanes* in, ComplexLanes* out)
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+            const auto scaleFactor = 1.0f / (float) size;
+            AlignedLaneBuffer buffer {};
+
+            for (int first = 0; first < numTransforms; first += numLanes)
+            {
+                const auto numInGroup = jmin (numLanes, numTransforms - first);
+
+                for (int i = 0; i < size; ++i)
+                {
+                    // only the non-negative frequencies are used, the rest are their conjugates
+                    const auto index = i < (size >> 1) ? i : size - i;
+                    const auto sign  = i < (size >> 1) ? 1.0f : -1.0f;
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        buffer.re[lane] = data[first + lane][2 * index];
+                        buffer.im[lane] = data[first + lane][2 * index + 1] * sign;
+                    }
+
+                    in[i] = loadLanes (buffer);
+                }
+
+                configInverse->perform (in, out);
+
+                for (int i = 0; i < size; ++i)
+                {
+                    storeLanes (out[i], buffer);
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        data[first + lane][i]        = buffer.re[lane] * scaleFactor;
+                        data[first + lane][i + size] = buffer.im[lane] * scaleFactor;
+                    }
+                }
+            }
+        });
+    }
+   #endif
+
     //==============================================================================
     struct FFTConfig
     {
@@ -266,7 +581,8 @@ struct FFTFallback final : public FFT::Instance
             }
         }
 
-        void perform (const Complex<float>* input, Complex<float>* output) const noexcept
+        template <typename ValueType>
+        void perform (const ValueType* input, ValueType* output) const noexcept
         {
             perform (input, output, 1, 1, factors);
         }
@@ -278,7 +594,8 @@ struct FFTFallback final : public FFT::Instance
         Factor factors[32];
         HeapBlock<Complex<float>> twiddleTable;
 
-        void perform (const Complex<float>* input, Complex<float>* output, int stride, int strideIn, const Factor* facs) const noexcept
+        template <typename ValueType>
+        void perform (const ValueType* input, ValueType* output, int stride, int strideIn, const Factor* facs) const noexcept
         {
             auto factor = *facs++;
             auto* originalOutput = output;
@@ -316,7 +633,8 @@ struct FFTFallback final : public FFT::Instance
             butterfly (factor, originalOutput, stride);
         }
 
-        void butterfly (const Factor factor, Complex<float>* data, int stride) const noexcept
+        template <typename ValueType>
+        void butterfly (const Factor factor, ValueType* data, int stride) const noexcept
         {
             switch (factor.radix)
             {
@@ -327,7 +645,8 @@ struct FFTFallback final : public FFT::Instance
             }
 
             JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6255)
-            auto* scratch = static_cast<Complex<float>*> (alloca ((size_t) factor.radix * sizeof (Complex<float>)));
+            auto* scratch = snapPointerToAlignment (static_cast<ValueType*> (alloca ((size_t) factor.radix * sizeof (ValueType) + alignof (ValueType))),
+                                                    alignof (ValueType));
             JUCE_END_IGNORE_WARNINGS_MSVC
 
             for (int i = 0; i < factor.length; ++i)
@@ -362,7 +681,8 @@ struct FFTFallback final : public FFT::Instance
             }
         }
 
-        void butterfly2 (Complex<float>* data, const int stride, const int length) const noexcept
+        template <typename ValueType>
+        void butterfly2 (ValueType* data, const int stride, const int length) const noexcept
         {
             auto* dataEnd = data + length;
             auto* tw = twiddleTable.getData();
@@ -377,7 +697,8 @@ struct FFTFallback final : public FFT::Instance
             }
         }
 
-        void butterfly4 (Complex<float>* data, const int stride, const int length) const noexcept
+        template <typename ValueType>
+        void butterfly4 (ValueType* data, const int stride, const int length) const noexcept
         {
             auto lengthX2 = length * 2;
             auto lengthX3 = length * 3;
@@ -430,9 +751,277 @@ struct FFTFallback final : public FFT::Instance
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FFTConfig)
     };
 
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    /*  A vectorised radix-4 (plus one radix-2 pass for odd orders) Stockham FFT,
+        working on separate real and imaginary arrays.
+
+        Each pass turns s sub-sequences of length n into s * radix sub-sequences of
+        length m = n / radix. While m is large, every sub-sequence is stored
+        contiguously, so the butterflies of a pass can be computed over
+        SIMDRegister::SIMDNumElements consecutive values of p at once. Before m gets
+        too short for that, one pass writes its results in the classic Stockham
+        layout instead, where element p of sub-sequence q lives at q + s * p, so that
+        the remaining passes can be vectorised over q. The output ends up in natural
+        order, so no bit-reversal is needed.
+    */
+    struct SIMDFFTConfig
+    {
+        SIMDFFTConfig (int sizeOfFFT, bool isInverse)
+            : fftSize (sizeOfFFT), inverse (isInverse)
+        {
+            const auto order = roundToInt (std::log2 (fftSize));
+            const auto sign = inverse ? 1.0 : -1.0;
+            auto layoutIsSequential = true;
+
+            for (int n = fftSize, stride = 1; n > 1;)
+            {
+                Pass pass;
+                pass.radix  = (passes.empty() && (order & 1) != 0) ? 2 : 4;
+                pass.length = n / pass.radix;
+                pass.stride = stride;
+
+                // while stride == 1 both layouts are the same, so a short first pass can use either
+                if (layoutIsSequential && pass.length >= numLanes)
+                    pass.kind = (pass.length / 4 >= numLanes) ? PassKind::sequentialSIMD : PassKind::transposingSIMD;
+                else
+                    pass.kind = stride >= numLanes ? PassKind::stridedSIMD : PassKind::strided;
+
+                layoutIsSequential = (pass.kind == PassKind::sequentialSIMD);
+
+                pass.twiddles.allocate ((size_t) (2 * (pass.radix - 1) * pass.length));
+
+                for (int k = 1; k < pass.radix; ++k)
+                {
+                    for (int p = 0; p < pass.length; ++p)
+                    {
+                        const auto phase = sign * 2.0 * MathConstants<double>::pi * (double) (k * p) / (double) n;
+                        pass.getTwiddleReal (k)[p] = (float) std::cos (phase);
+                        pass.getTwiddleImag (k)[p] = (float) std::sin (phase);
+                    }
+                }
+
+                n = pass.length;
+                stride *= pass.radix;
+                passes.push_back (std::move (pass));
+            }
+
+            workspace.allocate (4 * (size_t) fftSize);
+        }
+
+        struct SplitComplex { const float* re; const float* im; };
+
+        float* getInputReal() noexcept      { return workspace.data; }
+        float* getInputImag() noexcept      { return workspace.data + fftSize; }
+
+        /*  Transforms the data written to getInputReal() and getInputImag(), and
+            returns the (unscaled) result, which points into the workspace.
+        */
+        SplitComplex perform() noexcept
+        {
+            float* in[]  = { workspace.data,                   workspace.data + fftSize };
+            float* out[] = { workspace.data + 2 * fftSize,     workspace.data + 3 * fftSize };
+
+            for (auto& pass : passes)
+            {
+                switch (pass.kind)
+                {
+                    case PassKind::sequentialSIMD:  performPass<Lanes, true,  true>  (pass, in, out); break;
+                    case PassKind::transposingSIMD: performPass<Lanes, true,  false> (pass, in, out); break;
+                    case PassKind::stridedSIMD:     performPass<Lanes, false, false> (pass, in, out); break;
+                    case PassKind::strided:         performPass<float, false, false> (pass, in, out); break;
+                }
+
+                std::swap (in[0], out[0]);
+                std::swap (in[1], out[1]);
+            }
+
+            return { in[0], in[1] };
+        }
+
+    private:
+        struct AlignedFloats
+        {
+            void allocate (size_t num)
+            {
+                storage.calloc (num + (size_t) numLanes);
+                data = snapPointerToAlignment (storage.getData(), sizeof (Lanes));
+            }
+
+            HeapBlock<float> storage;
+            float* data = nullptr;
+        };
+
+        enum class PassKind { sequentialSIMD, transposingSIMD, stridedSIMD, strided };
+
+        struct Pass
+        {
+            float* getTwiddleReal (int k) const noexcept    { return twiddles.data + (2 * (k - 1)) * length; }
+            float* getTwiddleImag (int k) const noexcept    { return twiddles.data + (2 * (k - 1) + 1) * length; }
+
+            PassKind kind = PassKind::strided;
+            int radix = 4, length = 0, stride = 0;
+            AlignedFloats twiddles;
+        };
+
+        template <typename Value>
+        static Value load (const float* p) noexcept
+        {
+            if constexpr (std::is_same_v<Value, float>)
+                return *p;
+            else
+                return Value::fromRawArray (p);
+        }
+
+        template <typename Value>
+        static Value broadcast (float v) noexcept
+        {
+            if constexpr (std::is_same_v<Value, float>)
+                return v;
+            else
+                return Value::expand (v);
+        }
+
+        template <typename Value>
+        static void store (Value v, float* p) noexcept
+        {
+            if constexpr (std::is_same_v<Value, float>)
+                *p = v;
+            else
+                v.copyToRawArray (p);
+        }
+
+        template <typename Value>
+        static void storeStrided (Value v, float* p, int stride) noexcept
+        {
+            alignas (sizeof (Value)) float values[Value::SIMDNumElements];
+            v.copyToRawArray (values);
+
+            for (size_t i = 0; i < Value::SIMDNumElements; ++i)
+                p[(int) i * stride] = values[i];
+        }
+
+        template <typename Value>
+        static void multiply (Value& re, Value& im, Value wr, Value wi) noexcept
+        {
+            const auto r = re * wr - im * wi;
+            im = re * wi + im * wr;
+            re = r;
+        }
+
+        template <typename Value, bool sequentialInput, bool sequentialOutput>
+        void performPass (const Pass& pass, float* const* in, float* const* out) const noexcept
+        {
+            if (pass.radix == 2)
+                performPass<Value, sequentialInput, sequentialOutput, 2> (pass, in, out);
+            else
+                performPass<Value, sequentialInput, sequentialOutput, 4> (pass, in, out);
+        }
+
+        template <typename Value, bool sequentialInput, bool sequentialOutput, int radix>
+        void performPass (const Pass& pass, float* const* in, float* const* out) const noexcept
+        {
+            constexpr int step = (int) (sizeof (Value) / sizeof (float));
+            const auto m = pass.length, s = pass.stride, n = m * radix;
+
+            // vectorise over p while the input sub-sequences are contiguous, otherwise over q
+            constexpr auto vectoriseOverP = sequentialInput;
+            const auto numOuter = vectoriseOverP ? s : m;
+            const auto numInner = vectoriseOverP ? m : s;
+
+            const float* const xr = in[0];
+            const float* const xi = in[1];
+            float* const yr = out[0];
+            float* const yi = out[1];
+
+            for (int outer = 0; outer < numOuter; ++outer)
+            {
+                for (int inner = 0; inner < numInner; inner += step)
+                {
+                    const auto q = vectoriseOverP ? outer : inner;
+                    const auto p = vectoriseOverP ? inner : outer;
+
+                    const auto inputIndex = [&] (int j)  { return sequentialInput ? q * n + p + j * m : q + s * (p + j * m); };
+                    const auto outputIndex = [&] (int k) { return sequentialOutput ? (q + s * k) * m + p : q + s * (radix * p + k); };
+
+                    const auto input = [&] (const float* x, int j)
+                    {
+                        return load<Value> (x + inputIndex (j));
+                    };
+
+                    const auto output = [&] (Value v, float* y, int k)
+                    {
+                        // when switching layouts, consecutive values of p are s * radix samples apart
+                        if constexpr (vectoriseOverP && ! sequentialOutput)
+                            storeStrided (v, y + outputIndex (k), s * radix);
+                        else
+                            store (v, y + outputIndex (k));
+                    };
+
+                    const auto twiddle = [&] (const float* table)
+                    {
+                        return vectoriseOverP ? load<Value> (table + p) : broadcast<Value> (table[p]);
+                    };
+
+                    const auto ar = input (xr, 0), ai = input (xi, 0);
+                    const auto br = input (xr, 1), bi = input (xi, 1);
+
+                    if constexpr (radix == 2)
+                    {
+                        auto dr = ar - br, di = ai - bi;
+                        multiply (dr, di, twiddle (pass.getTwiddleReal (1)), twiddle (pass.getTwiddleImag (1)));
+
+                        output (ar + br, yr, 0);  output (ai + bi, yi, 0);
+                        output (dr,      yr, 1);  output (di,      yi, 1);
+                    }
+                    else
+                    {
+                        const auto cr = input (xr, 2), ci = input (xi, 2);
+                        const auto dr = input (xr, 3), di = input (xi, 3);
+
+                        const auto apcr = ar + cr, apci = ai + ci;
+                        const auto amcr = ar - cr, amci = ai - ci;
+                        const auto bpdr = br + dr, bpdi = bi + di;
+                        const auto bmdr = br - dr, bmdi = bi - di;
+
+                        // (a - c) - i (b - d) and (a - c) + i (b - d), swapped for the inverse transform
+                        auto t1r = inverse ? amcr - bmdi : amcr + bmdi;
+                        auto t1i = inverse ? amci + bmdr : amci - bmdr;
+                        auto t3r = inverse ? amcr + bmdi : amcr - bmdi;
+                        auto t3i = inverse ? amci - bmdr : amci + bmdr;
+                        auto t2r = apcr - bpdr, t2i = apci - bpdi;
+
+                        multiply (t1r, t1i, twiddle (pass.getTwiddleReal (1)), twiddle (pass.getTwiddleImag (1)));
+                        multiply (t2r, t2i, twiddle (pass.getTwiddleReal (2)), twiddle (pass.getTwiddleImag (2)));
+                        multiply (t3r, t3i, twiddle (pass.getTwiddleReal (3)), twiddle (pass.getTwiddleImag (3)));
+
+                        output (apcr + bpdr, yr, 0);  output (apci + bpdi, yi, 0);
+                        output (t1r,         yr, 1);  output (t1i,         yi, 1);
+                        output (t2r,         yr, 2);  output (t2i,         yi, 2);
+                        output (t3r,         yr, 3);  output (t3i,         yi, 3);
+                    }
+                }
+            }
+        }
+
+        const int fftSize;
+        const bool inverse;
+        std::vector<Pass> passes;
+        AlignedFloats workspace;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SIMDFFTConfig)
+    };
+
+    // below this size the scalar FFTConfig is at least as fast
+    static constexpr int minSizeForSIMDConfig = 16;
+   #endif
+
     //==============================================================================
     SpinLock processLock;
     std::unique_ptr<FFTConfig> configForward, configInverse;
+   #if JUCE_USE_SIMD
+    std::unique_ptr<SIMDFFTConfig> simdForward, simdInverse;
+   #endif
     int size;
 };
 
@@ -988,6 +1577,25 @@ void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcep
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
+void FFT::perform (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                   int numTransforms, bool inverse) const noexcept
+{
+    if (engine != nullptr)
+        engine->performBatch (inputs, outputs, numTransforms, inverse);
+}
+
+void FFT::performRealOnlyForwardTransform (float* const* inputOutputData, int numTransforms, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransformBatch (inputOutputData, numTransforms, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyInverseTransform (float* const* inputOutputData, int numTransforms) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyInverseTransformBatch (inputOutputData, numTransforms);
+}
+
 void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
 {
     if (size == 1)
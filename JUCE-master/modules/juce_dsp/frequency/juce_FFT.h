@@ -114,6 +114,35 @@ public:
     void performFrequencyOnlyForwardTransform (float* inputOutputData,
                                                bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
 
+    //==============================================================================
+    /** Performs out-of-place FFTs on several buffers at once, either forward or inverse.
+
+        This is equivalent to calling perform() once for each pair of buffers, but
+        engines that can process several transforms together (such as the built-in
+        fallback engine, which interleaves the transforms across SIMD lanes) will
+        do so. Each of the arrays must contain at least getSize() elements.
+    */
+    void perform (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                  int numTransforms, bool inverse) const noexcept;
+
+    /** Performs in-place forward transforms on several blocks of real data at once.
+
+        This is equivalent to calling performRealOnlyForwardTransform() for each of
+        the buffers, but may be considerably faster when transforming a number of
+        channels of the same size. Each buffer must contain 2 * getSize() floats.
+
+        @see performRealOnlyForwardTransform
+    */
+    void performRealOnlyForwardTransform (float* const* inputOutputData, int numTransforms,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs the reverse operation of the batched performRealOnlyForwardTransform()
+        on several buffers at once. Each buffer must contain 2 * getSize() floats.
+
+        @see performRealOnlyInverseTransform
+    */
+    void performRealOnlyInverseTransform (float* const* inputOutputData, int numTransforms) const noexcept;
+
     /** Returns the number of data points that this FFT was created to work with. */
     int getSize() const noexcept            { return size; }
 
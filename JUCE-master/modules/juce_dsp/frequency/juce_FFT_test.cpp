@@ -203,6 +203,89 @@ struct FFTUnitTest final : public UnitTest
         }
     };
 
+    struct BatchTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (size_t order = 0; order <= 8; ++order)
+            {
+                auto n = (1u << order);
+
+                FFT fft ((int) order);
+
+                // odd numbers of transforms make sure that partially filled batches work too
+                for (auto numTransforms : { 1, 3, 11 })
+                {
+                    std::vector<std::vector<Complex<float>>> input, batched, reference;
+                    std::vector<const Complex<float>*> inputPtrs;
+                    std::vector<Complex<float>*> outputPtrs;
+                    std::vector<float*> realPtrs;
+
+                    for (int i = 0; i < numTransforms; ++i)
+                    {
+                        input.emplace_back (n);
+                        fillRandom (random, input.back().data(), n);
+                        batched.emplace_back (n);
+                        reference.emplace_back (n);
+
+                        fft.perform (input.back().data(), reference.back().data(), false);
+                        inputPtrs.push_back (input.back().data());
+                        outputPtrs.push_back (batched.back().data());
+                    }
+
+                    fft.perform (inputPtrs.data(), outputPtrs.data(), numTransforms, false);
+
+                    for (int i = 0; i < numTransforms; ++i)
+                        u.expect (checkArrayIsSimilar (batched[(size_t) i].data(), reference[(size_t) i].data(), n));
+
+                    std::vector<const Complex<float>*> spectrumPtrs (outputPtrs.begin(), outputPtrs.end());
+                    std::vector<Complex<float>*> inversePtrs;
+
+                    for (auto& r : reference)
+                        inversePtrs.push_back (r.data());
+
+                    fft.perform (spectrumPtrs.data(), inversePtrs.data(), numTransforms, true);
+
+                    for (int i = 0; i < numTransforms; ++i)
+                        u.expect (checkArrayIsSimilar (reference[(size_t) i].data(), input[(size_t) i].data(), n));
+
+                    for (int i = 0; i < numTransforms; ++i)
+                    {
+                        auto* real = reinterpret_cast<float*> (batched[(size_t) i].data());
+                        zeromem (real, n * sizeof (Complex<float>));
+
+                        for (size_t j = 0; j < n; ++j)
+                            real[j] = input[(size_t) i][j].real();
+
+                        auto* ref = reinterpret_cast<float*> (reference[(size_t) i].data());
+                        std::copy (real, real + 2 * n, ref);
+                        fft.performRealOnlyForwardTransform (ref);
+                        realPtrs.push_back (real);
+                    }
+
+                    fft.performRealOnlyForwardTransform (realPtrs.data(), numTransforms);
+
+                    for (int i = 0; i < numTransforms; ++i)
+                        u.expect (checkArrayIsSimilar (batched[(size_t) i].data(), reference[(size_t) i].data(), n));
+
+                    fft.performRealOnlyInverseTransform (realPtrs.data(), numTransforms);
+
+                    for (int i = 0; i < numTransforms; ++i)
+                    {
+                        std::vector<float> expected (n);
+
+                        for (size_t j = 0; j < n; ++j)
+                            expected[j] = input[(size_t) i][j].real();
+
+                        u.expect (checkArrayIsSimilar (realPtrs[(size_t) i], expected.data(), n));
+                    }
+                }
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -216,6 +299,7 @@ struct FFTUnitTest final : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<BatchTest> ("Batched transforms Test");
     }
 };
 
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+STFT::STFT (int fftOrder, int hop, WindowingMethod window, int frame)
+    : fft (fftOrder),
+      hopSize (hop),
+      frameSize (frame > 0 ? frame : fft.getSize())
+{
+    jassert (frameSize <= fft.getSize());
+    jassert (hopSize > 0 && hopSize <= frameSize);
+
+    analysisWindow = WindowingFunction<float>::getSharedTable ((size_t) frameSize, window, false, 0.0f, true);
+
+    // Dividing by the sum of the squared windows that overlap at each position
+    // makes the analysis and synthesis windows add up to one everywhere
+    const auto& w = *analysisWindow;
+    synthesisWindow.resize ((size_t) frameSize);
+
+    for (int i = 0; i < hopSize; ++i)
+    {
+        double sum = 0.0;
+
+        for (auto j = i; j < frameSize; j += hopSize)
+            sum += (double) w[(size_t) j] * (double) w[(size_t) j];
+
+        const auto scale = sum > 1.0e-6 ? 1.0 / sum : 0.0;
+
+        for (auto j = i; j < frameSize; j += hopSize)
+            synthesisWindow[(size_t) j] = (float) (w[(size_t) j] * scale);
+    }
+}
+
+//==============================================================================
+void STFT::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    const auto numChannels = (int) spec.numChannels;
+
+    inputFrames .setSize (numChannels, frameSize);
+    outputFrames.setSize (numChannels, frameSize);
+    fftData     .setSize (numChannels, 2 * fft.getSize());
+
+    spectra.malloc ((size_t) numChannels);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        spectra[channel] = reinterpret_cast<Complex<float>*> (fftData.getWritePointer (channel));
+
+    reset();
+}
+
+void STFT::reset() noexcept
+{
+    inputFrames.clear();
+    outputFrames.clear();
+    position = 0;
+}
+
+//==============================================================================
+void STFT::processBlock (const AudioBlock<const float>& input, AudioBlock<float>& output, bool bypassed) noexcept
+{
+    // Make sure to call prepare() first, with enough channels!
+    jassert (input.getNumChannels() <= (size_t) inputFrames.getNumChannels());
+
+    const auto numChannels = (int) input.getNumChannels();
+    const auto numSamples  = (int) input.getNumSamples();
+    const auto inputStart  = frameSize - hopSize;
+
+    for (int done = 0; done < numSamples;)
+    {
+        const auto num = jmin (numSamples - done, hopSize - position);
+
+        // The input is read before the output is written, so this also works in place
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            FloatVectorOperations::copy (inputFrames.getWritePointer (channel, inputStart + position),
+                                         input.getChannelPointer ((size_t) channel) + done, num);
+            FloatVectorOperations::copy (output.getChannelPointer ((size_t) channel) + done,
+                                         outputFrames.getReadPointer (channel, position), num);
+        }
+
+        done += num;
+        position += num;
+
+        if (position == hopSize)
+        {
+            position = 0;
+
+            if (bypassed)
+            {
+                // Overlap-adding the windowed frames without transforming them gives
+                // the same delayed signal, so the latency doesn't change
+                for (int channel = 0; channel < numChannels; ++channel)
+                    FloatVectorOperations::multiply (fftData.getWritePointer (channel), inputFrames.getReadPointer (channel),
+                                                     analysisWindow->data(), frameSize);
+            }
+            else
+            {
+                processFrame (numChannels);
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* in = inputFrames.getWritePointer (channel);
+                auto* out = outputFrames.getWritePointer (channel);
+
+                std::memmove (in, in + hopSize, sizeof (float) * (size_t) inputStart);
+                std::memmove (out, out + hopSize, sizeof (float) * (size_t) inputStart);
+                FloatVectorOperations::clear (out + inputStart, hopSize);
+
+                FloatVectorOperations::addWithMultiply (out, fftData.getReadPointer (channel), synthesisWindow.data(), frameSize);
+            }
+        }
+    }
+}
+
+void STFT::processFrame (int numChannels) noexcept
+{
+    const auto fftSize = fft.getSize();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* data = fftData.getWritePointer (channel);
+
+        FloatVectorOperations::multiply (data, inputFrames.getReadPointer (channel), analysisWindow->data(), frameSize);
+        FloatVectorOperations::clear (data + frameSize, 2 * fftSize - frameSize);
+    }
+
+    auto* const* channels = fftData.getArrayOfWritePointers();
+    fft.performRealOnlyForwardTransform (channels, numChannels, true);
+
+    if (spectrumCallback != nullptr)
+        spectrumCallback (spectra.get(), numChannels, getNumBins());
+
+    fft.performRealOnlyInverseTransform (channels, numChannels);
+}
+
+} // namespace juce::dsp
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    A short-time Fourier transform processor, which splits the signal into
+    overlapping windowed frames, passes the spectrum of each frame to a callback,
+    and resynthesises the result by overlap-add.
+
+    All the channels are transformed together for each frame, using the batched
+    transforms of FFT, and the callback gets the spectra of every channel at once.
+    The windowing and overlap-add use FloatVectorOperations.
+
+    Frames are frameSize samples long and start every hopSize samples. They are
+    zero-padded up to the FFT size, so a frame shorter than the FFT gives a lower
+    latency at the same frequency resolution. The output is delayed by
+    getLatencyInSamples() == frameSize samples.
+
+    The analysis window comes from WindowingFunction::getSharedTable(), so
+    processors with the same settings share one table. The synthesis window is the
+    same shape, divided by the sum of the squared windows that overlap at each
+    position, so if the callback leaves the spectra alone the output is exactly the
+    delayed input, for any hop size at which the windows overlap.
+
+    @tags{DSP}
+*/
+class JUCE_API  STFT
+{
+public:
+    //==============================================================================
+    using WindowingMethod = WindowingFunction<float>::WindowingMethod;
+
+    /** Called for each frame with the spectra of all the channels.
+
+        Each spectrum holds numBins == getFFTSize() / 2 + 1 complex values, from DC to
+        Nyquist, which may be modified in place. This is called on the audio thread.
+    */
+    using SpectrumCallback = std::function<void (Complex<float>* const* spectra, int numChannels, int numBins)>;
+
+    //==============================================================================
+    /** Creates an STFT.
+
+        @param fftOrder     the base-2 logarithm of the FFT size
+        @param hopSize      the number of samples between the starts of two frames,
+                            which must be between 1 and the frame size
+        @param window       the shape of the analysis and synthesis windows
+        @param frameSize    the number of samples in each frame, which can't be more
+                            than the FFT size. Zero uses the FFT size.
+    */
+    STFT (int fftOrder, int hopSize, WindowingMethod window = WindowingFunction<float>::hann, int frameSize = 0);
+
+    //==============================================================================
+    /** Sets the function that processes the spectra. Without one, the signal is
+        only delayed.
+    */
+    void setSpectrumCallback (SpectrumCallback newCallback)    { spectrumCallback = std::move (newCallback); }
+
+    /** Returns the FFT size. */
+    int getFFTSize() const noexcept                            { return fft.getSize(); }
+
+    /** Returns the number of complex values passed to the callback for each channel. */
+    int getNumBins() const noexcept                            { return fft.getSize() / 2 + 1; }
+
+    /** Returns the number of samples between the starts of two frames. */
+    int getHopSize() const noexcept                            { return hopSize; }
+
+    /** Returns the number of samples in each frame. */
+    int getFrameSize() const noexcept                          { return frameSize; }
+
+    /** Returns the delay of the output relative to the input, in samples. */
+    int getLatencyInSamples() const noexcept                   { return frameSize; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context.
+
+        The context must have no more channels than the spec passed to prepare().
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        processBlock (inputBlock, outputBlock, context.isBypassed);
+    }
+
+private:
+    //==============================================================================
+    void processBlock (const AudioBlock<const float>& input, AudioBlock<float>& output, bool bypassed) noexcept;
+    void processFrame (int numChannels) noexcept;
+
+    //==============================================================================
+    FFT fft;
+    int hopSize, frameSize;
+    WindowingFunction<float>::Table analysisWindow;
+    std::vector<float> synthesisWindow;
+    SpectrumCallback spectrumCallback;
+
+    AudioBuffer<float> inputFrames, outputFrames, fftData;
+    HeapBlock<Complex<float>*> spectra;
+    int position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFT)
+};
+
+} // namespace juce::dsp
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class STFTTest final : public UnitTest
+{
+public:
+    STFTTest()
+        : UnitTest ("STFT", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Window tables are shared");
+        {
+            using Window = WindowingFunction<float>;
+
+            const auto a = Window::getSharedTable (512, Window::hann);
+            const auto b = Window::getSharedTable (512, Window::hann);
+            const auto c = Window::getSharedTable (512, Window::hann, true, 0.0f, true);
+
+            expect (a == b);
+            expect (a != c);
+
+            Window window (512, Window::hann);
+            expect (window.getTable() == a);
+
+            std::vector<float> expected (512);
+            Window::fillWindowingTables (expected.data(), expected.size(), Window::hann);
+            expect (*a == expected);
+        }
+
+        beginTest ("Periodic windows");
+        {
+            using Window = WindowingFunction<double>;
+
+            const auto table = Window::getSharedTable (64, Window::hann, false, 0.0, true);
+
+            for (size_t i = 0; i < table->size(); ++i)
+                expectWithinAbsoluteError ((*table)[i], 0.5 - 0.5 * std::cos (MathConstants<double>::twoPi * (double) i / 64.0), 1.0e-12);
+        }
+
+        beginTest ("Resynthesis without processing reconstructs the delayed input");
+        {
+            struct Setup { int order, hop, frame; WindowingFunction<float>::WindowingMethod window; };
+
+            for (const auto& setup : { Setup { 10, 512, 0, WindowingFunction<float>::hann },
+                                       Setup { 10, 256, 0, WindowingFunction<float>::hann },
+                                       Setup { 10, 300, 0, WindowingFunction<float>::blackman },
+                                       Setup { 9, 128, 384, WindowingFunction<float>::hamming } })
+            {
+                STFT stft (setup.order, setup.hop, setup.window, setup.frame);
+                std::atomic<int> numFrames { 0 };
+
+                stft.setSpectrumCallback ([&] (Complex<float>* const*, int numChannels, int numBins)
+                {
+                    expectEquals (numChannels, 2);
+                    expectEquals (numBins, (1 << setup.order) / 2 + 1);
+                    ++numFrames;
+                });
+
+                expectReconstructs (stft, false);
+                expect (numFrames > 0);
+
+                stft.reset();
+                expectReconstructs (stft, true);
+            }
+        }
+
+        beginTest ("Spectra can be modified");
+        {
+            STFT stft (8, 64);
+
+            stft.setSpectrumCallback ([] (Complex<float>* const* spectra, int numChannels, int numBins)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                    std::fill (spectra[channel], spectra[channel] + numBins, Complex<float>());
+            });
+
+            stft.prepare ({ 44100.0, 100, 1 });
+
+            AudioBuffer<float> buffer (1, 100);
+            auto random = getRandom();
+
+            for (int block = 0; block < 20; ++block)
+            {
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+                AudioBlock<float> audioBlock (buffer);
+                stft.process (ProcessContextReplacing<float> (audioBlock));
+
+                expectEquals (buffer.getMagnitude (0, buffer.getNumSamples()), 0.0f);
+            }
+        }
+    }
+
+private:
+    void expectReconstructs (STFT& stft, bool bypassed)
+    {
+        constexpr int numChannels = 2, numSamples = 8000;
+
+        auto random = getRandom();
+        AudioBuffer<float> input (numChannels, numSamples), output (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        stft.prepare ({ 44100.0, 1000, (uint32) numChannels });
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto num = jmin (numSamples - start, 1 + random.nextInt (1000));
+
+            const AudioBlock<const float> in (input.getArrayOfReadPointers(), (size_t) numChannels, (size_t) start, (size_t) num);
+            AudioBlock<float> out (output.getArrayOfWritePointers(), (size_t) numChannels, (size_t) start, (size_t) num);
+
+            ProcessContextNonReplacing<float> context (in, out);
+            context.isBypassed = bypassed;
+            stft.process (context);
+
+            start += num;
+        }
+
+        const auto latency = stft.getLatencyInSamples();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (output.getSample (channel, i), i < latency ? 0.0f : input.getSample (channel, i - latency), 1.0e-4f);
+        }
+    }
+};
+
+static STFTTest stftTest;
+
+} // namespace juce::dsp
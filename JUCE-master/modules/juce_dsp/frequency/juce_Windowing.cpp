@@ -52,8 +52,42 @@ template <typename FloatType>
 void WindowingFunction<FloatType>::fillWindowingTables (size_t size, WindowingMethod type,
                                                         bool normalise, FloatType beta) noexcept
 {
-    windowTable.resize (static_cast<int> (size));
-    fillWindowingTables (windowTable.getRawDataPointer(), size, type, normalise, beta);
+    windowTable = getSharedTable (size, type, normalise, beta);
+}
+
+template <typename FloatType>
+typename WindowingFunction<FloatType>::Table WindowingFunction<FloatType>::getSharedTable (size_t size, WindowingMethod type,
+                                                                                           bool normalise, FloatType beta,
+                                                                                           bool periodic)
+{
+    using Key = std::tuple<size_t, int, bool, FloatType, bool>;
+
+    static CriticalSection lock;
+    static std::map<Key, std::weak_ptr<const std::vector<FloatType>>> tables;
+
+    const Key key { size, (int) type, normalise, type == kaiser ? beta : FloatType(), periodic };
+
+    const ScopedLock sl (lock);
+
+    if (auto existing = tables[key].lock())
+        return existing;
+
+    // Tables are only kept alive by their users, so forget about any that have gone
+    for (auto it = tables.begin(); it != tables.end();)
+        it = it->second.expired() ? tables.erase (it) : std::next (it);
+
+    auto table = std::make_shared<std::vector<FloatType>> (size + (periodic ? 1 : 0));
+    fillWindowingTables (table->data(), table->size(), type, false, beta);
+    table->resize (size);
+
+    if (normalise && size > 0)
+    {
+        const auto sum = std::accumulate (table->begin(), table->end(), FloatType());
+        FloatVectorOperations::multiply (table->data(), static_cast<FloatType> (size) / sum, static_cast<int> (size));
+    }
+
+    tables[key] = table;
+    return table;
 }
 
 template <typename FloatType>
@@ -175,7 +209,8 @@ void WindowingFunction<FloatType>::fillWindowingTables (FloatType* samples, size
 template <typename FloatType>
 void WindowingFunction<FloatType>::multiplyWithWindowingTable (FloatType* samples, size_t size) const noexcept
 {
-    FloatVectorOperations::multiply (samples, windowTable.getRawDataPointer(), jmin (static_cast<int> (size), windowTable.size()));
+    if (windowTable != nullptr)
+        FloatVectorOperations::multiply (samples, windowTable->data(), static_cast<int> (jmin (size, windowTable->size())));
 }
 
 template <typename FloatType>
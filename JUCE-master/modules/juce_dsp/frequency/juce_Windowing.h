@@ -43,6 +43,10 @@ namespace juce::dsp
     WindowingFunction object, or a static function to fill an array with the
     windowing method samples.
 
+    Tables are shared: WindowingFunction objects, and anything else that calls
+    getSharedTable(), that use the same settings all point at one immutable copy
+    of the window, which is only calculated the first time it's needed.
+
     @tags{DSP}
 */
 template <typename FloatType>
@@ -73,6 +77,32 @@ public:
     WindowingFunction (size_t size, WindowingMethod,
                        bool normalise = true, FloatType beta = 0);
 
+    //==============================================================================
+    /** An immutable window table, which may be shared between several users. */
+    using Table = std::shared_ptr<const std::vector<FloatType>>;
+
+    /** Returns a table of the given windowing method, shared with everything else
+        that has asked for a window with the same settings and still holds on to it.
+
+        This allocates and calculates the table if there isn't one already, so it
+        shouldn't be called on the audio thread.
+
+        @param size         the number of samples in the window
+        @param type         the type of windowing method being used
+        @param normalise    if the result must be normalised, creating a DC amplitude
+                            response of one
+        @param beta         an optional argument useful only for Kaiser's method
+        @param periodic     if true, the window is the first size samples of a
+                            symmetric window of size + 1 samples. This is the form
+                            that overlaps and adds up evenly, which is what short-time
+                            Fourier transforms need.
+    */
+    static Table getSharedTable (size_t size, WindowingMethod type, bool normalise = true,
+                                 FloatType beta = 0, bool periodic = false);
+
+    /** Returns the table used by this object. */
+    const Table& getTable() const noexcept      { return windowTable; }
+
     //==============================================================================
     /** Fills the content of the object array with a given windowing method table.
 
@@ -109,7 +139,7 @@ public:
 
 private:
     //==============================================================================
-    Array<FloatType> windowTable;
+    Table windowTable;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WindowingFunction)
 };
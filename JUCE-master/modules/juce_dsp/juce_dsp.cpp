@@ -65,6 +65,7 @@
  #define JUCE_IPP_AVAILABLE 1
 #endif
 
+#include "containers/juce_SIMDDispatch.cpp"
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
 #include "processors/juce_FirstOrderTPTFilter.cpp"
@@ -74,46 +75,49 @@
 #include "processors/juce_LinkwitzRileyFilter.cpp"
 #include "processors/juce_DelayLine.cpp"
 #include "processors/juce_DryWetMixer.cpp"
+#include "processors/juce_MatrixMixer.cpp"
 #include "processors/juce_StateVariableTPTFilter.cpp"
+#include "processors/juce_MultiVoiceStateVariableTPTFilter.cpp"
 #include "maths/juce_SpecialFunctions.cpp"
 #include "maths/juce_Matrix.cpp"
 #include "maths/juce_LookupTable.cpp"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFT.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
+#include "widgets/juce_MultiVoiceLadderFilter.cpp"
+#include "widgets/juce_WavetableOscillator.cpp"
 #include "widgets/juce_Compressor.cpp"
 #include "widgets/juce_NoiseGate.cpp"
 #include "widgets/juce_Limiter.cpp"
 #include "widgets/juce_Phaser.cpp"
 #include "widgets/juce_Chorus.cpp"
 
-#if JUCE_USE_SIMD
- #if JUCE_INTEL
-  #ifdef __AVX2__
-   #include "native/juce_SIMDNativeOps_avx.cpp"
-  #else
-   #include "native/juce_SIMDNativeOps_sse.cpp"
-  #endif
- #elif JUCE_ARM
-  #include "native/juce_SIMDNativeOps_neon.cpp"
- #else
-  #error "SIMD register support not implemented for this platform"
- #endif
-#endif
-
 #if JUCE_UNIT_TESTS
  #include "maths/juce_Matrix_test.cpp"
  #include "maths/juce_LogRampedValue_test.cpp"
+ #include "maths/juce_FastMathApproximations_test.cpp"
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
+  #include "processors/juce_MultiVoiceStateVariableTPTFilter_test.cpp"
+  #include "widgets/juce_MultiVoiceLadderFilter_test.cpp"
+  #include "widgets/juce_WavetableOscillator_test.cpp"
  #endif
 
  #include "containers/juce_AudioBlock_test.cpp"
+ #include "containers/juce_InterleavedAudioBlock_test.cpp"
+ #include "filter_design/juce_FilterDesign_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "frequency/juce_STFT_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "processors/juce_ProcessorDuplicator_test.cpp"
+ #include "widgets/juce_Compressor_test.cpp"
+ #include "widgets/juce_Limiter_test.cpp"
 #endif
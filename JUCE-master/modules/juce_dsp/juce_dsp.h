@@ -192,6 +192,20 @@
  #define JUCE_DSP_ENABLE_SNAP_TO_ZERO 1
 #endif
 
+/** Config: JUCE_DSP_ENABLE_AVX512_SIMD
+
+    When this flag is enabled and the module is compiled with AVX-512 (F, BW and DQ)
+    enabled, SIMDRegister will use 512-bit registers instead of 256-bit AVX2 ones.
+
+    This is disabled by default because it changes the size and alignment of
+    SIMDRegister, and because some CPUs lower their clock speed when running
+    512-bit instructions. See SIMDDispatcher for a way of using wider registers
+    in individual kernels, selected at runtime.
+*/
+#ifndef JUCE_DSP_ENABLE_AVX512_SIMD
+ #define JUCE_DSP_ENABLE_AVX512_SIMD 0
+#endif
+
 
 //==============================================================================
 #undef Complex  // apparently some C libraries actually define these symbols (!)
@@ -231,17 +245,37 @@ namespace util
 }
 
 //==============================================================================
+// Each SIMD backend lives in its own inline namespace, so that translation units
+// compiled for different instruction sets can be linked into the same binary.
+#if JUCE_USE_SIMD && JUCE_INTEL
+ #if JUCE_DSP_ENABLE_AVX512_SIMD && defined (__AVX512F__) && defined (__AVX512BW__) && defined (__AVX512DQ__)
+  #define JUCE_SIMD_AVX512 1
+  #define JUCE_SIMD_NAMESPACE SIMD_AVX512
+ #elif defined (__AVX2__)
+  #define JUCE_SIMD_AVX2 1
+  #define JUCE_SIMD_NAMESPACE SIMD_AVX2
+ #else
+  #define JUCE_SIMD_SSE 1
+  #define JUCE_SIMD_NAMESPACE SIMD_SSE
+ #endif
+#elif JUCE_USE_SIMD && JUCE_ARM
+ #define JUCE_SIMD_NEON 1
+ #define JUCE_SIMD_NAMESPACE SIMD_NEON
+#else
+ #define JUCE_SIMD_NAMESPACE SIMD_Scalar
+#endif
+
 #if JUCE_USE_SIMD
  #include "native/juce_SIMDNativeOps_fallback.h"
 
  // include the correct native file for this build target CPU
- #if JUCE_INTEL
-  #ifdef __AVX2__
-   #include "native/juce_SIMDNativeOps_avx.h"
-  #else
-   #include "native/juce_SIMDNativeOps_sse.h"
-  #endif
- #elif JUCE_ARM
+ #if JUCE_SIMD_AVX512
+  #include "native/juce_SIMDNativeOps_avx512.h"
+ #elif JUCE_SIMD_AVX2
+  #include "native/juce_SIMDNativeOps_avx.h"
+ #elif JUCE_SIMD_SSE
+  #include "native/juce_SIMDNativeOps_sse.h"
+ #elif JUCE_SIMD_NEON
   #include "native/juce_SIMDNativeOps_neon.h"
  #else
   #error "SIMD register support not implemented for this platform"
@@ -251,14 +285,18 @@ namespace util
  #include "containers/juce_SIMDRegister_Impl.h"
 #endif
 
+#include "containers/juce_SIMDDispatch.h"
+
 #include "maths/juce_SpecialFunctions.h"
 #include "maths/juce_Matrix.h"
+#include "maths/juce_FixedSizeMatrix.h"
 #include "maths/juce_Phase.h"
 #include "maths/juce_Polynomial.h"
 #include "maths/juce_FastMathApproximations.h"
 #include "maths/juce_LookupTable.h"
 #include "maths/juce_LogRampedValue.h"
 #include "containers/juce_AudioBlock.h"
+#include "containers/juce_InterleavedAudioBlock.h"
 #include "processors/juce_ProcessContext.h"
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
@@ -274,17 +312,22 @@ namespace util
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
+#include "processors/juce_MatrixMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
+#include "processors/juce_MultiVoiceStateVariableTPTFilter.h"
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFT.h"
 #include "filter_design/juce_FilterDesign.h"
 #include "widgets/juce_Reverb.h"
 #include "widgets/juce_Bias.h"
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_WavetableOscillator.h"
 #include "widgets/juce_LadderFilter.h"
+#include "widgets/juce_MultiVoiceLadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
 #include "widgets/juce_Limiter.h"
@@ -35,6 +35,53 @@
 namespace juce::dsp
 {
 
+namespace detail
+{
+    /*  Computes output[i] = function (input[i]) for a whole buffer. Where SIMD is
+        available, the function is called with SIMDRegisters for every run of values
+        starting at an aligned input position, and with scalars for the remainder.
+        The function must therefore accept both FloatType and SIMDRegister<FloatType>.
+
+        An unaligned output is written through a small aligned chunk: narrow reads
+        from a wide store are cheap, whereas the opposite would stall store-forwarding.
+    */
+    template <typename FloatType, typename Function>
+    void applyInLanes (const FloatType* input, FloatType* output, size_t numValues, Function&& function) noexcept
+    {
+        size_t i = 0;
+
+       #if JUCE_USE_SIMD
+        if constexpr (std::is_same_v<FloatType, float> || std::is_same_v<FloatType, double>)
+        {
+            using Lanes = SIMDRegister<FloatType>;
+            constexpr auto numLanes = Lanes::size();
+
+            for (; i < numValues && ! Lanes::isSIMDAligned (input + i); ++i)
+                output[i] = function (input[i]);
+
+            if (Lanes::isSIMDAligned (output + i))
+            {
+                for (; i + numLanes <= numValues; i += numLanes)
+                    function (Lanes::fromRawArray (input + i)).copyToRawArray (output + i);
+            }
+            else
+            {
+                alignas (sizeof (Lanes)) FloatType chunk[numLanes];
+
+                for (; i + numLanes <= numValues; i += numLanes)
+                {
+                    function (Lanes::fromRawArray (input + i)).copyToRawArray (chunk);
+                    std::copy (chunk, chunk + numLanes, output + i);
+                }
+            }
+        }
+       #endif
+
+        for (; i < numValues; ++i)
+            output[i] = function (input[i]);
+    }
+} // namespace detail
+
 /**
     This class contains various fast mathematical function approximations.
 
@@ -66,10 +113,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cosh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cosh (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::cosh (x); });
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function cosh(x) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> cosh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = ((x2 * (FloatType) -14615 - (FloatType) 1075032) * x2 - (FloatType) 18471600) * x2 - (FloatType) 39251520;
+        auto denominator = ((x2 * (FloatType) 127 - (FloatType) 16632) * x2 + (FloatType) 1154160) * x2 - (FloatType) 39251520;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function sinh(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -94,9 +157,25 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sinh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sinh (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::sinh (x); });
+    }
+
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function sinh(x) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> sinh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 * (FloatType) -479249 - (FloatType) 52785432) * x2 - (FloatType) 1640635920) * x2 - (FloatType) 11511339840);
+        auto denominator = ((x2 * (FloatType) 18361 - (FloatType) 3177720) * x2 + (FloatType) 277920720) * x2 - (FloatType) 11511339840;
+        return numerator / denominator;
     }
+   #endif
 
     /** Provides a fast approximation of the function tanh(x) using a Pade approximant
         continued fraction, calculated sample by sample.
@@ -122,10 +201,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tanh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tanh (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::tanh (x); });
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function tanh(x) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> tanh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 + (FloatType) 378) * x2 + (FloatType) 17325) * x2 + (FloatType) 135135);
+        auto denominator = ((x2 * (FloatType) 28 + (FloatType) 3150) * x2 + (FloatType) 62370) * x2 + (FloatType) 135135;
+        return numerator / denominator;
+    }
+   #endif
+
     //==============================================================================
     /** Provides a fast approximation of the function cos(x) using a Pade approximant
         continued fraction, calculated sample by sample.
@@ -151,9 +246,25 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cos (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cos (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::cos (x); });
+    }
+
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function cos(x) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> cos (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = ((x2 * (FloatType) -14615 + (FloatType) 1075032) * x2 - (FloatType) 18471600) * x2 + (FloatType) 39251520;
+        auto denominator = ((x2 * (FloatType) 127 + (FloatType) 16632) * x2 + (FloatType) 1154160) * x2 + (FloatType) 39251520;
+        return numerator / denominator;
     }
+   #endif
 
     /** Provides a fast approximation of the function sin(x) using a Pade approximant
         continued fraction, calculated sample by sample.
@@ -179,10 +290,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sin (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sin (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::sin (x); });
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function sin(x) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> sin (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 * (FloatType) -479249 + (FloatType) 52785432) * x2 - (FloatType) 1640635920) * x2 + (FloatType) 11511339840);
+        auto denominator = ((x2 * (FloatType) 18361 + (FloatType) 3177720) * x2 + (FloatType) 277920720) * x2 + (FloatType) 11511339840;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function tan(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -207,9 +334,25 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tan (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tan (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::tan (x); });
+    }
+
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function tan(x) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi/2 and +pi/2 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> tan (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 - (FloatType) 378) * x2 + (FloatType) 17325) * x2 - (FloatType) 135135);
+        auto denominator = ((x2 * (FloatType) 28 - (FloatType) 3150) * x2 + (FloatType) 62370) * x2 - (FloatType) 135135;
+        return numerator / denominator;
     }
+   #endif
 
     //==============================================================================
     /** Provides a fast approximation of the function exp(x) using a Pade approximant
@@ -235,10 +378,25 @@ struct FastMathApproximations
     template <typename FloatType>
     static void exp (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::exp (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::exp (x); });
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function exp(x) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -6 and +4 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> exp (SIMDRegister<FloatType> x) noexcept
+    {
+        auto numerator = (((x + (FloatType) 20) * x + (FloatType) 180) * x + (FloatType) 840) * x + (FloatType) 1680;
+        auto denominator = (((x - (FloatType) 20) * x + (FloatType) 180) * x - (FloatType) 840) * x + (FloatType) 1680;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function log(x+1) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -262,9 +420,24 @@ struct FastMathApproximations
     template <typename FloatType>
     static void logNPlusOne (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::logNPlusOne (values[i]);
+        detail::applyInLanes (values, values, numValues, [] (auto x) { return FastMathApproximations::logNPlusOne (x); });
+    }
+
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function log(x+1) using a Pade approximant
+        continued fraction, calculated on every element of a SIMDRegister.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -0.8 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> logNPlusOne (SIMDRegister<FloatType> x) noexcept
+    {
+        auto numerator = x * ((((x * (FloatType) 137 + (FloatType) 2310) * x + (FloatType) 9870) * x + (FloatType) 15120) * x + (FloatType) 7560);
+        auto denominator = ((((x * (FloatType) 30 + (FloatType) 900) * x + (FloatType) 6300) * x + (FloatType) 16800) * x + (FloatType) 18900) * x + (FloatType) 7560;
+        return numerator / denominator;
     }
+   #endif
 };
 
 } // namespace juce::dsp
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class FastMathApproximationsTests final : public UnitTest
+{
+public:
+    FastMathApproximationsTests()
+        : UnitTest ("FastMathApproximations", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Buffer functions match the sample by sample versions");
+        {
+            checkBufferFunctions<float>  (1.0e-5);
+            checkBufferFunctions<double> (1.0e-12);
+        }
+
+        beginTest ("LookupTableTransform buffer processing matches processSample");
+        {
+            checkLookupTable<float>  (1.0e-6);
+            checkLookupTable<double> (1.0e-12);
+        }
+    }
+
+private:
+    static constexpr size_t numValues = 67;
+
+    template <typename FloatType, typename ScalarFunction, typename BufferFunction>
+    void checkBufferFunction (FloatType minValue, FloatType maxValue, double maxError,
+                              ScalarFunction&& scalarFunction, BufferFunction&& bufferFunction)
+    {
+        // Start at every offset into the buffer so that both the aligned and the
+        // unaligned paths are used
+        HeapBlock<FloatType> buffer (numValues + 16);
+
+        for (size_t start = 0; start < 16; ++start)
+        {
+            auto* values = buffer.get() + start;
+
+            for (size_t i = 0; i < numValues; ++i)
+                values[i] = jmap ((FloatType) i, (FloatType) 0, (FloatType) (numValues - 1), minValue, maxValue);
+
+            bufferFunction (values, numValues);
+
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                auto input = jmap ((FloatType) i, (FloatType) 0, (FloatType) (numValues - 1), minValue, maxValue);
+                auto expected = scalarFunction (input);
+                expectWithinAbsoluteError ((double) values[i], (double) expected, maxError * jmax (1.0, std::abs ((double) expected)));
+            }
+        }
+    }
+
+    template <typename FloatType>
+    void checkBufferFunctions (double maxError)
+    {
+        using FMA = FastMathApproximations;
+        const auto pi = MathConstants<FloatType>::pi;
+
+        checkBufferFunction<FloatType> (-5, 5, maxError, [] (FloatType x) { return FMA::cosh (x); }, [] (FloatType* v, size_t n) { FMA::cosh (v, n); });
+        checkBufferFunction<FloatType> (-5, 5, maxError, [] (FloatType x) { return FMA::sinh (x); }, [] (FloatType* v, size_t n) { FMA::sinh (v, n); });
+        checkBufferFunction<FloatType> (-5, 5, maxError, [] (FloatType x) { return FMA::tanh (x); }, [] (FloatType* v, size_t n) { FMA::tanh (v, n); });
+        checkBufferFunction<FloatType> (-pi, pi, maxError, [] (FloatType x) { return FMA::cos (x); }, [] (FloatType* v, size_t n) { FMA::cos (v, n); });
+        checkBufferFunction<FloatType> (-pi, pi, maxError, [] (FloatType x) { return FMA::sin (x); }, [] (FloatType* v, size_t n) { FMA::sin (v, n); });
+        checkBufferFunction<FloatType> (-pi / 2, pi / 2, maxError, [] (FloatType x) { return FMA::tan (x); }, [] (FloatType* v, size_t n) { FMA::tan (v, n); });
+        checkBufferFunction<FloatType> (-6, 4, maxError, [] (FloatType x) { return FMA::exp (x); }, [] (FloatType* v, size_t n) { FMA::exp (v, n); });
+        checkBufferFunction<FloatType> ((FloatType) -0.8, 5, maxError, [] (FloatType x) { return FMA::logNPlusOne (x); }, [] (FloatType* v, size_t n) { FMA::logNPlusOne (v, n); });
+    }
+
+    template <typename FloatType>
+    void checkLookupTable (double maxError)
+    {
+        LookupTableTransform<FloatType> transform ([] (FloatType x) { return std::tanh (x); }, -5, 5, 64);
+
+        HeapBlock<FloatType> input (numValues + 16), output (numValues + 16);
+
+        for (size_t start = 0; start < 16; ++start)
+        {
+            // Offset the input and output differently, and go beyond the table range
+            auto* in = input.get() + start;
+            auto* out = output.get() + (start / 2);
+
+            for (size_t i = 0; i < numValues; ++i)
+                in[i] = jmap ((FloatType) i, (FloatType) 0, (FloatType) (numValues - 1), (FloatType) -6, (FloatType) 6);
+
+            transform.process (in, out, numValues);
+
+            for (size_t i = 0; i < numValues; ++i)
+                expectWithinAbsoluteError ((double) out[i], (double) transform.processSample (in[i]), maxError);
+
+            for (size_t i = 0; i < numValues; ++i)
+                in[i] = jlimit ((FloatType) -5, (FloatType) 5, in[i]);
+
+            transform.processUnchecked (in, out, numValues);
+
+            for (size_t i = 0; i < numValues; ++i)
+                expectWithinAbsoluteError ((double) out[i], (double) transform.processSampleUnchecked (in[i]), maxError);
+        }
+    }
+};
+
+static FastMathApproximationsTests fastMathApproximationsTests;
+
+} // namespace juce::dsp
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    A matrix with a size known at compile time, which keeps its elements inside the
+    object instead of on the heap. This makes it cheap to create, copy and pass around
+    on the audio thread, e.g. for small rotation or decoding matrices, and lets the
+    compiler unroll and vectorise the operations for the given size.
+
+    Large matrices take the same amount of space on the stack, so for sizes of more
+    than a few thousand elements it's better to use Matrix, or to keep the
+    FixedSizeMatrix as a member of another object.
+
+    @see Matrix, MatrixMixer
+
+    @tags{DSP}
+*/
+template <typename ElementType, size_t numRows, size_t numColumns>
+class FixedSizeMatrix
+{
+public:
+    //==============================================================================
+    /** Creates a matrix filled with zeroes. */
+    FixedSizeMatrix() noexcept                                  { clear(); }
+
+    /** Creates a matrix with initial data coming from an array, stored in row-major order. */
+    explicit FixedSizeMatrix (const ElementType* dataPointer) noexcept
+    {
+        std::copy (dataPointer, dataPointer + numRows * numColumns, data.begin());
+    }
+
+    /** Creates a matrix with the contents of a Matrix of the same size. */
+    explicit FixedSizeMatrix (const Matrix<ElementType>& other) noexcept
+        : FixedSizeMatrix (other.getRawDataPointer())
+    {
+        jassert (other.getNumRows() == numRows && other.getNumColumns() == numColumns);
+    }
+
+    /** Creates the identity matrix. */
+    static FixedSizeMatrix identity() noexcept
+    {
+        static_assert (numRows == numColumns, "The identity matrix must be square");
+
+        FixedSizeMatrix result;
+
+        for (size_t i = 0; i < numRows; ++i)
+            result (i, i) = 1;
+
+        return result;
+    }
+
+    //==============================================================================
+    /** Returns the number of rows in the matrix. */
+    static constexpr size_t getNumRows() noexcept               { return numRows; }
+
+    /** Returns the number of columns in the matrix. */
+    static constexpr size_t getNumColumns() noexcept            { return numColumns; }
+
+    /** Fills the contents of the matrix with zeroes. */
+    void clear() noexcept                                       { data.fill (ElementType()); }
+
+    /** Returns a Matrix with the same contents. */
+    Matrix<ElementType> toMatrix() const                        { return { numRows, numColumns, data.data() }; }
+
+    //==============================================================================
+    /** Returns the value of the matrix at a given row and column (for reading). */
+    ElementType operator() (size_t row, size_t column) const noexcept
+    {
+        jassert (row < numRows && column < numColumns);
+        return data[row * numColumns + column];
+    }
+
+    /** Returns the value of the matrix at a given row and column (for modifying). */
+    ElementType& operator() (size_t row, size_t column) noexcept
+    {
+        jassert (row < numRows && column < numColumns);
+        return data[row * numColumns + column];
+    }
+
+    /** Returns a pointer to the raw data of the matrix, in row-major order (for modifying). */
+    ElementType* getRawDataPointer() noexcept                   { return data.data(); }
+
+    /** Returns a pointer to the raw data of the matrix, in row-major order (for reading). */
+    const ElementType* getRawDataPointer() const noexcept       { return data.data(); }
+
+    //==============================================================================
+    /** Addition of two matrices */
+    FixedSizeMatrix& operator+= (const FixedSizeMatrix& other) noexcept
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] += other.data[i];
+
+        return *this;
+    }
+
+    /** Subtraction of two matrices */
+    FixedSizeMatrix& operator-= (const FixedSizeMatrix& other) noexcept
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] -= other.data[i];
+
+        return *this;
+    }
+
+    /** Scalar multiplication */
+    FixedSizeMatrix& operator*= (ElementType scalar) noexcept
+    {
+        for (auto& x : data)
+            x *= scalar;
+
+        return *this;
+    }
+
+    /** Addition of two matrices */
+    FixedSizeMatrix operator+ (const FixedSizeMatrix& other) const noexcept  { auto result = *this; result += other;  return result; }
+
+    /** Subtraction of two matrices */
+    FixedSizeMatrix operator- (const FixedSizeMatrix& other) const noexcept  { auto result = *this; result -= other;  return result; }
+
+    /** Scalar multiplication */
+    FixedSizeMatrix operator* (ElementType scalar) const noexcept            { auto result = *this; result *= scalar; return result; }
+
+    /** Matrix multiplication */
+    template <size_t otherColumns>
+    FixedSizeMatrix<ElementType, numRows, otherColumns> operator* (const FixedSizeMatrix<ElementType, numColumns, otherColumns>& other) const noexcept
+    {
+        FixedSizeMatrix<ElementType, numRows, otherColumns> result;
+
+        for (size_t i = 0; i < numRows; ++i)
+            for (size_t k = 0; k < numColumns; ++k)
+                for (size_t j = 0; j < otherColumns; ++j)
+                    result (i, j) += (*this) (i, k) * other (k, j);
+
+        return result;
+    }
+
+    /** Returns the transpose of this matrix. */
+    FixedSizeMatrix<ElementType, numColumns, numRows> transposed() const noexcept
+    {
+        FixedSizeMatrix<ElementType, numColumns, numRows> result;
+
+        for (size_t i = 0; i < numRows; ++i)
+            for (size_t j = 0; j < numColumns; ++j)
+                result (j, i) = (*this) (i, j);
+
+        return result;
+    }
+
+    /** Multiplies this matrix by a set of channels, e.g. to mix or decode a block of
+        multichannel audio.
+
+        @see Matrix::multiply
+    */
+    void multiply (const ElementType* const* inputChannels, ElementType* const* outputChannels,
+                   size_t numSamples) const noexcept
+    {
+        detail::multiplyMatrixByRows (data.data(), numRows, numColumns,
+                                      [inputChannels] (size_t i) { return inputChannels[i]; },
+                                      [outputChannels] (size_t i) { return outputChannels[i]; },
+                                      numSamples);
+    }
+
+    //==============================================================================
+    /** Compares two matrices with a given tolerance */
+    static bool compare (const FixedSizeMatrix& a, const FixedSizeMatrix& b, ElementType tolerance = 0) noexcept
+    {
+        tolerance = std::abs (tolerance);
+
+        for (size_t i = 0; i < a.data.size(); ++i)
+            if (std::abs (a.data[i] - b.data[i]) > tolerance)
+                return false;
+
+        return true;
+    }
+
+    /** Comparison operator */
+    bool operator== (const FixedSizeMatrix& other) const noexcept   { return compare (*this, other); }
+
+private:
+    //==============================================================================
+    std::array<ElementType, numRows * numColumns> data;
+};
+
+} // namespace juce::dsp
@@ -114,6 +114,42 @@ public:
         return jmap (f, x0, x1);
     }
 
+   #if JUCE_USE_SIMD
+    /** Calculates the approximated values for a SIMDRegister of indices without range checking.
+
+        The integer and fractional parts of the indices are computed for all elements at
+        once, the table reads and the interpolation are then done element by element.
+
+        @see getUnchecked
+    */
+    SIMDRegister<FloatType> getUnchecked (SIMDRegister<FloatType> index) const noexcept
+    {
+        using Lanes = SIMDRegister<FloatType>;
+
+        jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+        alignas (sizeof (Lanes)) FloatType indices[Lanes::size()];
+        alignas (sizeof (Lanes)) FloatType fractions[Lanes::size()];
+        alignas (sizeof (Lanes)) FloatType results[Lanes::size()];
+
+        auto i = Lanes::truncate (index);
+        i.copyToRawArray (indices);
+        (index - i).copyToRawArray (fractions);
+
+        const auto* table = data.begin();
+
+        for (size_t lane = 0; lane < Lanes::size(); ++lane)
+        {
+            jassert (isPositiveAndBelow (indices[lane], FloatType (getNumPoints())));
+
+            const auto* point = table + static_cast<int> (indices[lane]);
+            results[lane] = jmap (fractions[lane], point[0], point[1]);
+        }
+
+        return Lanes::fromRawArray (results);
+    }
+   #endif
+
     //==============================================================================
     /** Calculates the approximated value for the given index with range checking.
 
@@ -243,6 +279,18 @@ public:
         return lookupTable[scaler * value + offset];
     }
 
+   #if JUCE_USE_SIMD
+    /** Calculates the approximated values for a SIMDRegister of input values without
+        range checking.
+
+        @see processSampleUnchecked
+    */
+    SIMDRegister<FloatType> processSampleUnchecked (SIMDRegister<FloatType> value) const noexcept
+    {
+        return lookupTable.getUnchecked (value * scaler + offset);
+    }
+   #endif
+
     //==============================================================================
     /** Calculates the approximated value for the given input value with range checking.
 
@@ -265,6 +313,21 @@ public:
         return lookupTable[index];
     }
 
+   #if JUCE_USE_SIMD
+    /** Calculates the approximated values for a SIMDRegister of input values with range
+        checking. Out-of-range input values will be clipped to the specified input range.
+
+        @see processSample
+    */
+    SIMDRegister<FloatType> processSample (SIMDRegister<FloatType> value) const noexcept
+    {
+        using Lanes = SIMDRegister<FloatType>;
+
+        auto clipped = Lanes::min (Lanes::max (value, Lanes::expand (minInputValue)), Lanes::expand (maxInputValue));
+        return lookupTable.getUnchecked (clipped * scaler + offset);
+    }
+   #endif
+
     //==============================================================================
     /** @see processSampleUnchecked */
     FloatType operator[] (FloatType index) const noexcept       { return processSampleUnchecked (index); }
@@ -278,8 +341,7 @@ public:
     */
     void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSampleUnchecked (input[i]);
+        detail::applyInLanes (input, output, numSamples, [this] (auto x) { return processSampleUnchecked (x); });
     }
 
     //==============================================================================
@@ -288,8 +350,7 @@ public:
     */
     void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSample (input[i]);
+        detail::applyInLanes (input, output, numSamples, [this] (auto x) { return processSample (x); });
     }
 
     //==============================================================================
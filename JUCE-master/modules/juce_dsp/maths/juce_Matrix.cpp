@@ -119,37 +119,29 @@ Matrix<ElementType>& Matrix<ElementType>::swapRows (size_t rowOne, size_t rowTwo
 template <typename ElementType>
 Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& other) const
 {
-    auto n = getNumRows(), m = other.getNumColumns(), p = getNumColumns();
-    Matrix result (n, m);
-
-    jassert (p == other.getNumRows());
-
-    size_t offsetMat = 0, offsetlhs = 0;
-
-    auto* dst = result.getRawDataPointer();
-    auto* a = getRawDataPointer();
-    auto* b = other.getRawDataPointer();
-
-    for (size_t i = 0; i < n; ++i)
-    {
-        size_t offsetrhs = 0;
-
-        for (size_t k = 0; k < p; ++k)
-        {
-            auto ak = a[offsetlhs++];
-
-            for (size_t j = 0; j < m; ++j)
-                dst[offsetMat + j] += ak * b[offsetrhs + j];
-
-            offsetrhs += m;
-        }
-
-        offsetMat += m;
-    }
-
+    Matrix result (getNumRows(), other.getNumColumns());
+    multiply (*this, other, result);
     return result;
 }
 
+template <typename ElementType>
+void Matrix<ElementType>::multiply (const Matrix& a, const Matrix& b, Matrix& result) noexcept
+{
+    jassert (a.getNumColumns() == b.getNumRows());
+    jassert (result.getNumRows() == a.getNumRows() && result.getNumColumns() == b.getNumColumns());
+    jassert (&result != &a && &result != &b);
+
+    // Each row of the result is a combination of the rows of b
+    const auto m = b.getNumColumns();
+    const auto* bData = b.getRawDataPointer();
+    auto* resultData = result.getRawDataPointer();
+
+    detail::multiplyMatrixByRows (a.getRawDataPointer(), a.getNumRows(), a.getNumColumns(),
+                                  [bData, m] (size_t i) { return bData + i * m; },
+                                  [resultData, m] (size_t i) { return resultData + i * m; },
+                                  m);
+}
+
 //==============================================================================
 template <typename ElementType>
 bool Matrix<ElementType>::compare (const Matrix& a, const Matrix& b, ElementType tolerance) noexcept
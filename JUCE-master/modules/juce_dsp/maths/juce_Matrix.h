@@ -35,6 +35,69 @@
 namespace juce::dsp
 {
 
+namespace detail
+{
+    /*  Calculates destination (i) = sum over j of matrix (i, j) * source (j), where each
+        source and destination is a row of numSamples values, e.g. a channel of audio or
+        a row of another matrix. The matrix is stored in row-major order.
+
+        The rows are processed in chunks, so that the chunks of all the sources stay in the
+        cache while they are reused for each destination, and four sources are added at a
+        time, which saves loading and storing the destination for each of them. The inner
+        loops are simple enough for the compiler to vectorise.
+    */
+    template <typename ElementType, typename SourceRow, typename DestinationRow>
+    void multiplyMatrixByRows (const ElementType* matrix, size_t numRows, size_t numColumns,
+                               SourceRow&& getSource, DestinationRow&& getDestination,
+                               size_t numSamples) noexcept
+    {
+        constexpr size_t chunkSize = 64;
+
+        for (size_t start = 0; start < numSamples; start += chunkSize)
+        {
+            const auto num = jmin (chunkSize, numSamples - start);
+
+            for (size_t row = 0; row < numRows; ++row)
+            {
+                const auto* weights = matrix + row * numColumns;
+                auto* dst = getDestination (row) + start;
+
+                std::fill (dst, dst + num, ElementType());
+
+                size_t column = 0;
+
+                for (; column + 4 <= numColumns; column += 4)
+                {
+                    const auto w0 = weights[column],     w1 = weights[column + 1],
+                               w2 = weights[column + 2], w3 = weights[column + 3];
+
+                    // Skip the silent parts of sparse matrices
+                    if (exactlyEqual (w0, ElementType()) && exactlyEqual (w1, ElementType())
+                         && exactlyEqual (w2, ElementType()) && exactlyEqual (w3, ElementType()))
+                        continue;
+
+                    const auto* s0 = getSource (column) + start;
+                    const auto* s1 = getSource (column + 1) + start;
+                    const auto* s2 = getSource (column + 2) + start;
+                    const auto* s3 = getSource (column + 3) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        dst[i] += w0 * s0[i] + w1 * s1[i] + w2 * s2[i] + w3 * s3[i];
+                }
+
+                for (; column < numColumns; ++column)
+                {
+                    const auto w = weights[column];
+                    const auto* src = getSource (column) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        dst[i] += w * src[i];
+                }
+            }
+        }
+    }
+} // namespace detail
+
 /**
     General matrix and vectors class, meant for classic math manipulation such as
     additions, multiplications, and linear systems of equations solving.
@@ -167,6 +230,30 @@ public:
     /** Matrix multiplication */
     Matrix operator* (const Matrix& other) const;
 
+    /** Multiplies a by b and stores the result in an existing matrix, without allocating.
+        The result must already have as many rows as a and as many columns as b, and must
+        not be the same object as a or b.
+    */
+    static void multiply (const Matrix& a, const Matrix& b, Matrix& result) noexcept;
+
+    /** Multiplies this matrix by a set of channels, e.g. to mix or decode a block of
+        multichannel audio. For each row i of the matrix, outputChannels[i] is set to the
+        sum of inputChannels[j] * (*this) (i, j) over all the columns j.
+
+        There must be one input channel per column and one output channel per row, each
+        with numSamples values, and the outputs must not overlap the inputs.
+
+        @see MatrixMixer
+    */
+    void multiply (const ElementType* const* inputChannels, ElementType* const* outputChannels,
+                   size_t numSamples) const noexcept
+    {
+        detail::multiplyMatrixByRows (getRawDataPointer(), rows, columns,
+                                      [inputChannels] (size_t i) { return inputChannels[i]; },
+                                      [outputChannels] (size_t i) { return outputChannels[i]; },
+                                      numSamples);
+    }
+
     /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
     inline Matrix& hadarmard (const Matrix& other) noexcept             { return apply (other, [] (ElementType a, ElementType b) { return a * b; } ); }
 
@@ -153,6 +153,166 @@ struct LinearAlgebraUnitTest final : public UnitTest
         }
     };
 
+    template <typename ElementType>
+    static Matrix<ElementType> makeRandomMatrix (Random& random, size_t rows, size_t columns)
+    {
+        Matrix<ElementType> result (rows, columns);
+
+        for (auto& x : result)
+            x = (ElementType) (random.nextDouble() * 2.0 - 1.0);
+
+        return result;
+    }
+
+    template <typename ElementType>
+    static Matrix<ElementType> multiplyReference (const Matrix<ElementType>& a, const Matrix<ElementType>& b)
+    {
+        Matrix<ElementType> result (a.getNumRows(), b.getNumColumns());
+
+        for (size_t i = 0; i < a.getNumRows(); ++i)
+            for (size_t j = 0; j < b.getNumColumns(); ++j)
+                for (size_t k = 0; k < a.getNumColumns(); ++k)
+                    result (i, j) += a (i, k) * b (k, j);
+
+        return result;
+    }
+
+    struct LargeMultiplicationTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            Random random (42);
+
+            // Sizes which aren't multiples of the chunk size or of the number of rows added together
+            auto a = makeRandomMatrix<ElementType> (random, 37, 71);
+            auto b = makeRandomMatrix<ElementType> (random, 71, 133);
+
+            // A sparse part of the matrix, which is skipped
+            for (size_t i = 0; i < a.getNumRows(); ++i)
+                for (size_t j = 8; j < 16; ++j)
+                    a (i, j) = 0;
+
+            const auto expected = multiplyReference (a, b);
+            u.expect (Matrix<ElementType>::compare (a * b, expected, (ElementType) 1e-4));
+
+            Matrix<ElementType> result (37, 133);
+            Matrix<ElementType>::multiply (a, b, result);
+            u.expect (Matrix<ElementType>::compare (result, expected, (ElementType) 1e-4));
+        }
+    };
+
+    struct ChannelMultiplicationTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            Random random (43);
+
+            const size_t numInputs = 7, numOutputs = 5, numSamples = 300;
+            const auto m = makeRandomMatrix<ElementType> (random, numOutputs, numInputs);
+            const auto inputs = makeRandomMatrix<ElementType> (random, numInputs, numSamples);
+
+            AudioBuffer<ElementType> inputBuffer ((int) numInputs, (int) numSamples), outputBuffer ((int) numOutputs, (int) numSamples);
+
+            for (size_t i = 0; i < numInputs; ++i)
+                std::copy (inputs.begin() + i * numSamples, inputs.begin() + (i + 1) * numSamples, inputBuffer.getWritePointer ((int) i));
+
+            // The outputs are overwritten, not added to
+            for (size_t i = 0; i < numOutputs; ++i)
+                FloatVectorOperations::fill (outputBuffer.getWritePointer ((int) i), (ElementType) 1, (int) numSamples);
+
+            m.multiply (inputBuffer.getArrayOfReadPointers(), outputBuffer.getArrayOfWritePointers(), numSamples);
+
+            const auto expected = multiplyReference (m, inputs);
+
+            for (size_t i = 0; i < numOutputs; ++i)
+                for (size_t j = 0; j < numSamples; ++j)
+                    u.expectWithinAbsoluteError (outputBuffer.getSample ((int) i, (int) j), expected (i, j), (ElementType) 1e-4);
+
+            // The same, using a fixed size matrix
+            const FixedSizeMatrix<ElementType, numOutputs, numInputs> fixedSize (m);
+            outputBuffer.clear();
+            fixedSize.multiply (inputBuffer.getArrayOfReadPointers(), outputBuffer.getArrayOfWritePointers(), numSamples);
+
+            for (size_t i = 0; i < numOutputs; ++i)
+                for (size_t j = 0; j < numSamples; ++j)
+                    u.expectWithinAbsoluteError (outputBuffer.getSample ((int) i, (int) j), expected (i, j), (ElementType) 1e-4);
+        }
+    };
+
+    struct FixedSizeMatrixTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            Random random (44);
+
+            const auto a = makeRandomMatrix<ElementType> (random, 3, 4);
+            const auto b = makeRandomMatrix<ElementType> (random, 4, 2);
+
+            const FixedSizeMatrix<ElementType, 3, 4> fixedA (a);
+            const FixedSizeMatrix<ElementType, 4, 2> fixedB (b);
+
+            u.expect (Matrix<ElementType>::compare ((fixedA * fixedB).toMatrix(), a * b, (ElementType) 1e-5));
+            u.expect (Matrix<ElementType>::compare ((fixedA + fixedA).toMatrix(), a + a));
+            u.expect (Matrix<ElementType>::compare ((fixedA - fixedA * (ElementType) 2).toMatrix(), a - a * (ElementType) 2));
+            u.expect (FixedSizeMatrix<ElementType, 3, 3>::identity() * fixedA == fixedA);
+
+            const auto transposed = fixedA.transposed();
+
+            for (size_t i = 0; i < 3; ++i)
+                for (size_t j = 0; j < 4; ++j)
+                    u.expect (exactlyEqual (transposed (j, i), a (i, j)));
+        }
+    };
+
+    struct MatrixMixerTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            Random random (45);
+
+            const size_t numSamples = 100;
+            const auto gains = makeRandomMatrix<ElementType> (random, 3, 3);
+            const auto inputs = makeRandomMatrix<ElementType> (random, 3, numSamples);
+            const auto expected = multiplyReference (gains, inputs);
+
+            MatrixMixer<ElementType> mixer;
+            mixer.prepare ({ 44100.0, 32, 3 });
+            mixer.setMatrix (gains);
+
+            // In place, in several chunks of the maximum block size
+            AudioBuffer<ElementType> buffer (3, (int) numSamples);
+
+            for (int i = 0; i < 3; ++i)
+                std::copy (inputs.begin() + i * (int) numSamples, inputs.begin() + (i + 1) * (int) numSamples, buffer.getWritePointer (i));
+
+            AudioBlock<ElementType> block (buffer);
+            mixer.process (ProcessContextReplacing<ElementType> (block));
+
+            for (size_t i = 0; i < 3; ++i)
+                for (size_t j = 0; j < numSamples; ++j)
+                    u.expectWithinAbsoluteError (buffer.getSample ((int) i, (int) j), expected (i, j), (ElementType) 1e-4);
+
+            // Downmixing into a separate block
+            mixer.setSize (1, 3);
+            mixer.setGain (0, 0, (ElementType) 0.5);
+            mixer.setGain (0, 2, (ElementType) 0.25);
+
+            AudioBuffer<ElementType> mono (1, (int) numSamples);
+            AudioBlock<ElementType> monoBlock (mono);
+            AudioBlock<const ElementType> stereoBlock (buffer);
+            mixer.process (ProcessContextNonReplacing<ElementType> (stereoBlock, monoBlock));
+
+            for (int j = 0; j < (int) numSamples; ++j)
+                u.expectWithinAbsoluteError (mono.getSample (0, j),
+                                             (ElementType) 0.5 * buffer.getSample (0, j) + (ElementType) 0.25 * buffer.getSample (2, j),
+                                             (ElementType) 1e-6);
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -171,6 +331,10 @@ struct LinearAlgebraUnitTest final : public UnitTest
         runTestForAllTypes<MultiplicationTest> ("MultiplicationTest");
         runTestForAllTypes<IdentityMatrixTest> ("IdentityMatrixTest");
         runTestForAllTypes<SolvingTest> ("SolvingTest");
+        runTestForAllTypes<LargeMultiplicationTest> ("LargeMultiplicationTest");
+        runTestForAllTypes<ChannelMultiplicationTest> ("ChannelMultiplicationTest");
+        runTestForAllTypes<FixedSizeMatrixTest> ("FixedSizeMatrixTest");
+        runTestForAllTypes<MatrixMixerTest> ("MatrixMixerTest");
     }
 };
 
@@ -34,26 +34,15 @@
 
 namespace juce::dsp
 {
+inline namespace JUCE_SIMD_NAMESPACE
+{
 
 #ifndef DOXYGEN
 
 JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wignored-attributes")
 
-#ifdef _MSC_VER
- #define DECLARE_AVX_SIMD_CONST(type, name) \
-    static __declspec (align (32)) const type name[32 / sizeof (type)]
-
- #define DEFINE_AVX_SIMD_CONST(type, class_type, name) \
-    __declspec (align (32)) const type SIMDNativeOps<class_type>:: name[32 / sizeof (type)]
-
-#else
- #define DECLARE_AVX_SIMD_CONST(type, name) \
-    static const type name[32 / sizeof (type)] __attribute__ ((aligned (32)))
-
- #define DEFINE_AVX_SIMD_CONST(type, class_type, name) \
-    const type SIMDNativeOps<class_type>:: name[32 / sizeof (type)] __attribute__ ((aligned (32)))
-
-#endif
+#define DECLARE_AVX_SIMD_CONST(type, name) \
+    alignas (32) static inline const type name [32 / sizeof (type)]
 
 template <typename type>
 struct SIMDNativeOps;
@@ -69,9 +58,9 @@ struct SIMDNativeOps<float>
     using vSIMDType = __m256;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (int32_t, kAllBitsSet);
-    DECLARE_AVX_SIMD_CONST (int32_t, kEvenHighBit);
-    DECLARE_AVX_SIMD_CONST (float, kOne);
+    DECLARE_AVX_SIMD_CONST (int32_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1 };
+    DECLARE_AVX_SIMD_CONST (int32_t, kEvenHighBit) = { static_cast<int32_t> (0x80000000), 0, static_cast<int32_t> (0x80000000), 0, static_cast<int32_t> (0x80000000), 0, static_cast<int32_t> (0x80000000), 0 };
+    DECLARE_AVX_SIMD_CONST (float, kOne) = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
 
     //==============================================================================
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE vconst (const float* a) noexcept                     { return load (a); }
@@ -82,6 +71,7 @@ struct SIMDNativeOps<float>
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE add (__m256 a, __m256 b) noexcept                    { return _mm256_add_ps (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE sub (__m256 a, __m256 b) noexcept                    { return _mm256_sub_ps (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE mul (__m256 a, __m256 b) noexcept                    { return _mm256_mul_ps (a, b); }
+    static forcedinline __m256 JUCE_VECTOR_CALLTYPE div (__m256 a, __m256 b) noexcept                    { return _mm256_div_ps (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE bit_and (__m256 a, __m256 b) noexcept                { return _mm256_and_ps (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE bit_or  (__m256 a, __m256 b) noexcept                { return _mm256_or_ps  (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE bit_xor (__m256 a, __m256 b) noexcept                { return _mm256_xor_ps (a, b); }
@@ -149,9 +139,9 @@ struct SIMDNativeOps<double>
     using vSIMDType = __m256d;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (int64_t, kAllBitsSet);
-    DECLARE_AVX_SIMD_CONST (int64_t, kEvenHighBit);
-    DECLARE_AVX_SIMD_CONST (double, kOne);
+    DECLARE_AVX_SIMD_CONST (int64_t, kAllBitsSet) = { -1, -1, -1, -1 };
+    DECLARE_AVX_SIMD_CONST (int64_t, kEvenHighBit) = { static_cast<int64_t> (0x8000000000000000), 0, static_cast<int64_t> (0x8000000000000000), 0 };
+    DECLARE_AVX_SIMD_CONST (double, kOne) = { 1.0, 1.0, 1.0, 1.0 };
 
     //==============================================================================
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE vconst (const double* a) noexcept                      { return load (a); }
@@ -162,6 +152,7 @@ struct SIMDNativeOps<double>
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE add (__m256d a, __m256d b) noexcept                    { return _mm256_add_pd (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE sub (__m256d a, __m256d b) noexcept                    { return _mm256_sub_pd (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE mul (__m256d a, __m256d b) noexcept                    { return _mm256_mul_pd (a, b); }
+    static forcedinline __m256d JUCE_VECTOR_CALLTYPE div (__m256d a, __m256d b) noexcept                    { return _mm256_div_pd (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE bit_and (__m256d a, __m256d b) noexcept                { return _mm256_and_pd (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE bit_or  (__m256d a, __m256d b) noexcept                { return _mm256_or_pd  (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE bit_xor (__m256d a, __m256d b) noexcept                { return _mm256_xor_pd (a, b); }
@@ -216,7 +207,7 @@ struct SIMDNativeOps<int8_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (int8_t, kAllBitsSet);
+    DECLARE_AVX_SIMD_CONST (int8_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
 
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE expand (int8_t s) noexcept                             { return _mm256_set1_epi8 (s); }
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE load (const int8_t* p) noexcept                        { return _mm256_load_si256 (reinterpret_cast<const __m256i*> (p)); }
@@ -290,8 +281,8 @@ struct SIMDNativeOps<uint8_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (uint8_t, kHighBit);
-    DECLARE_AVX_SIMD_CONST (uint8_t, kAllBitsSet);
+    DECLARE_AVX_SIMD_CONST (uint8_t, kHighBit) = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 };
+    DECLARE_AVX_SIMD_CONST (uint8_t, kAllBitsSet) = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
 
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE ssign (__m256i a) noexcept                              { return _mm256_xor_si256 (a, load (kHighBit)); }
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE expand (uint8_t s) noexcept                             { return _mm256_set1_epi8 ((int8_t) s); }
@@ -366,7 +357,7 @@ struct SIMDNativeOps<int16_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (int16_t, kAllBitsSet);
+    DECLARE_AVX_SIMD_CONST (int16_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
 
     //==============================================================================
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE expand (int16_t s) noexcept                             { return _mm256_set1_epi16 (s); }
@@ -422,8 +413,8 @@ struct SIMDNativeOps<uint16_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (uint16_t, kHighBit);
-    DECLARE_AVX_SIMD_CONST (uint16_t, kAllBitsSet);
+    DECLARE_AVX_SIMD_CONST (uint16_t, kHighBit) = { 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000 };
+    DECLARE_AVX_SIMD_CONST (uint16_t, kAllBitsSet) = { 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff };
 
     //==============================================================================
     static forcedinline __m256i  JUCE_VECTOR_CALLTYPE ssign (__m256i a) noexcept                              { return _mm256_xor_si256 (a, load (kHighBit)); }
@@ -481,7 +472,7 @@ struct SIMDNativeOps<int32_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (int32_t, kAllBitsSet);
+    DECLARE_AVX_SIMD_CONST (int32_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1 };
 
     //==============================================================================
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE expand (int32_t s) noexcept                             { return _mm256_set1_epi32 (s); }
@@ -535,8 +526,8 @@ struct SIMDNativeOps<uint32_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (uint32_t, kAllBitsSet);
-    DECLARE_AVX_SIMD_CONST (uint32_t, kHighBit);
+    DECLARE_AVX_SIMD_CONST (uint32_t, kAllBitsSet) = { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff };
+    DECLARE_AVX_SIMD_CONST (uint32_t, kHighBit) = { 0x80000000, 0x80000000, 0x80000000, 0x80000000, 0x80000000, 0x80000000, 0x80000000, 0x80000000 };
 
     //==============================================================================
     static forcedinline __m256i  JUCE_VECTOR_CALLTYPE ssign (__m256i a) noexcept                              { return _mm256_xor_si256 (a, load (kHighBit)); }
@@ -592,7 +583,7 @@ struct SIMDNativeOps<int64_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (int64_t, kAllBitsSet);
+    DECLARE_AVX_SIMD_CONST (int64_t, kAllBitsSet) = { -1LL, -1LL, -1LL, -1LL };
 
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE expand (int64_t s) noexcept                             { return _mm256_set1_epi64x ((int64_t) s); }
     static forcedinline __m256i JUCE_VECTOR_CALLTYPE load (const int64_t* p) noexcept                        { return _mm256_load_si256 (reinterpret_cast<const __m256i*> (p)); }
@@ -631,8 +622,8 @@ struct SIMDNativeOps<uint64_t>
     using vSIMDType = __m256i;
 
     //==============================================================================
-    DECLARE_AVX_SIMD_CONST (uint64_t, kAllBitsSet);
-    DECLARE_AVX_SIMD_CONST (uint64_t, kHighBit);
+    DECLARE_AVX_SIMD_CONST (uint64_t, kAllBitsSet) = { 0xffffffffffffffffULL, 0xffffffffffffffffULL, 0xffffffffffffffffULL, 0xffffffffffffffffULL };
+    DECLARE_AVX_SIMD_CONST (uint64_t, kHighBit) = { 0x8000000000000000ULL, 0x8000000000000000ULL, 0x8000000000000000ULL, 0x8000000000000000ULL };
 
     static forcedinline __m256i  JUCE_VECTOR_CALLTYPE expand (uint64_t s) noexcept                            { return _mm256_set1_epi64x ((int64_t) s); }
     static forcedinline __m256i  JUCE_VECTOR_CALLTYPE load (const uint64_t* p) noexcept                       { return _mm256_load_si256 (reinterpret_cast<const __m256i*> (p)); }
@@ -664,4 +655,5 @@ struct SIMDNativeOps<uint64_t>
 
 JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 
+} // inline namespace JUCE_SIMD_NAMESPACE
 } // namespace juce::dsp
@@ -34,26 +34,15 @@
 
 namespace juce::dsp
 {
+inline namespace JUCE_SIMD_NAMESPACE
+{
 
 #ifndef DOXYGEN
 
 JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wignored-attributes")
 
-#ifdef _MSC_VER
- #define DECLARE_NEON_SIMD_CONST(type, name) \
-    static __declspec (align (16)) const type name [16 / sizeof (type)]
-
- #define DEFINE_NEON_SIMD_CONST(type, class_type, name) \
-    __declspec (align (16)) const type SIMDNativeOps<class_type>:: name [16 / sizeof (type)]
-
-#else
- #define DECLARE_NEON_SIMD_CONST(type, name) \
-    static const type name [16 / sizeof (type)] __attribute__ ((aligned (16)))
-
- #define DEFINE_NEON_SIMD_CONST(type, class_type, name) \
-    const type SIMDNativeOps<class_type>:: name [16 / sizeof (type)] __attribute__ ((aligned (16)))
-
-#endif
+#define DECLARE_NEON_SIMD_CONST(type, name) \
+    alignas (16) static inline const type name [16 / sizeof (type)]
 
 template <typename type>
 struct SIMDNativeOps;
@@ -71,7 +60,7 @@ struct SIMDNativeOps<uint32_t>
     using fb = SIMDFallbackOps<uint32_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (uint32_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (uint32_t, kAllBitsSet) = { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff };
 
     //==============================================================================
     static forcedinline vSIMDType expand (uint32_t s) noexcept                                  { return vdupq_n_u32 (s); }
@@ -117,7 +106,7 @@ struct SIMDNativeOps<int32_t>
     using fb = SIMDFallbackOps<int32_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (int32_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (int32_t, kAllBitsSet) = { -1, -1, -1, -1 };
 
     //==============================================================================
     static forcedinline vSIMDType expand (int32_t s) noexcept                                   { return vdupq_n_s32 (s); }
@@ -164,7 +153,7 @@ struct SIMDNativeOps<int8_t>
     using fb = SIMDFallbackOps<int8_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (int8_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (int8_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
 
     //==============================================================================
     static forcedinline vSIMDType expand (int8_t s) noexcept                                   { return vdupq_n_s8 (s); }
@@ -205,7 +194,7 @@ struct SIMDNativeOps<uint8_t>
     using fb = SIMDFallbackOps<uint8_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (uint8_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (uint8_t, kAllBitsSet) = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
 
     //==============================================================================
     static forcedinline vSIMDType expand (uint8_t s) noexcept                                  { return vdupq_n_u8 (s); }
@@ -246,7 +235,7 @@ struct SIMDNativeOps<int16_t>
     using fb = SIMDFallbackOps<int16_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (int16_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (int16_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1 };
 
     //==============================================================================
     static forcedinline vSIMDType expand (int16_t s) noexcept                                  { return vdupq_n_s16 (s); }
@@ -288,7 +277,7 @@ struct SIMDNativeOps<uint16_t>
     using fb = SIMDFallbackOps<uint16_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (uint16_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (uint16_t, kAllBitsSet) = { 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff };
 
     //==============================================================================
     static forcedinline vSIMDType expand (uint16_t s) noexcept                                 { return vdupq_n_u16 (s); }
@@ -329,7 +318,7 @@ struct SIMDNativeOps<int64_t>
     using fb = SIMDFallbackOps<int64_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (int64_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (int64_t, kAllBitsSet) = { -1, -1 };
 
     //==============================================================================
     static forcedinline vSIMDType expand (int64_t s) noexcept                                  { return vdupq_n_s64 (s); }
@@ -371,7 +360,7 @@ struct SIMDNativeOps<uint64_t>
     using fb = SIMDFallbackOps<uint64_t, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (uint64_t, kAllBitsSet);
+    DECLARE_NEON_SIMD_CONST (uint64_t, kAllBitsSet) = { 0xffffffffffffffff, 0xffffffffffffffff };
 
     //==============================================================================
     static forcedinline vSIMDType expand (uint64_t s) noexcept                                  { return vdupq_n_u64 (s); }
@@ -413,9 +402,9 @@ struct SIMDNativeOps<float>
     using fb = SIMDFallbackOps<float, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (int32_t, kAllBitsSet);
-    DECLARE_NEON_SIMD_CONST (int32_t, kEvenHighBit);
-    DECLARE_NEON_SIMD_CONST (float, kOne);
+    DECLARE_NEON_SIMD_CONST (int32_t, kAllBitsSet) = { -1, -1, -1, -1 };
+    DECLARE_NEON_SIMD_CONST (int32_t, kEvenHighBit) = { static_cast<int32_t> (0x80000000), 0, static_cast<int32_t> (0x80000000), 0 };
+    DECLARE_NEON_SIMD_CONST (float, kOne) = { 1.0f, 1.0f, 1.0f, 1.0f };
 
     //==============================================================================
     static forcedinline vSIMDType expand (float s) noexcept                                    { return vdupq_n_f32 (s); }
@@ -426,6 +415,11 @@ struct SIMDNativeOps<float>
     static forcedinline vSIMDType add (vSIMDType a, vSIMDType b) noexcept                      { return vaddq_f32 (a, b); }
     static forcedinline vSIMDType sub (vSIMDType a, vSIMDType b) noexcept                      { return vsubq_f32 (a, b); }
     static forcedinline vSIMDType mul (vSIMDType a, vSIMDType b) noexcept                      { return vmulq_f32 (a, b); }
+   #if JUCE_64BIT
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept                      { return vdivq_f32 (a, b); }
+   #else
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept                      { return fb::div (a, b); }
+   #endif
     static forcedinline vSIMDType bit_and (vSIMDType a, vSIMDType b) noexcept                  { return (vSIMDType) vandq_u32 ((vMaskType) a, (vMaskType) b); }
     static forcedinline vSIMDType bit_or  (vSIMDType a, vSIMDType b) noexcept                  { return (vSIMDType) vorrq_u32 ((vMaskType) a, (vMaskType) b); }
     static forcedinline vSIMDType bit_xor (vSIMDType a, vSIMDType b) noexcept                  { return (vSIMDType) veorq_u32 ((vMaskType) a, (vMaskType) b); }
@@ -476,8 +470,8 @@ struct SIMDNativeOps<double>
     using fb = SIMDFallbackOps<double, vSIMDType>;
 
     //==============================================================================
-    DECLARE_NEON_SIMD_CONST (int64_t, kAllBitsSet);
-    DECLARE_NEON_SIMD_CONST (double, kOne);
+    DECLARE_NEON_SIMD_CONST (int64_t, kAllBitsSet) = { -1, -1 };
+    DECLARE_NEON_SIMD_CONST (double, kOne) = { 1.0, 1.0 };
 
     //==============================================================================
     static forcedinline vSIMDType expand (double s) noexcept                                   { return vdupq_n_f64 (s); }
@@ -488,6 +482,7 @@ struct SIMDNativeOps<double>
     static forcedinline vSIMDType add (vSIMDType a, vSIMDType b) noexcept                      { return vaddq_f64 (a, b); }
     static forcedinline vSIMDType sub (vSIMDType a, vSIMDType b) noexcept                      { return vsubq_f64 (a, b); }
     static forcedinline vSIMDType mul (vSIMDType a, vSIMDType b) noexcept                      { return vmulq_f64 (a, b); }
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept                      { return vdivq_f64 (a, b); }
     static forcedinline vSIMDType bit_and (vSIMDType a, vSIMDType b) noexcept                  { return (vSIMDType) vandq_u64 ((vMaskType) a, (vMaskType) b); }
     static forcedinline vSIMDType bit_or  (vSIMDType a, vSIMDType b) noexcept                  { return (vSIMDType) vorrq_u64 ((vMaskType) a, (vMaskType) b); }
     static forcedinline vSIMDType bit_xor (vSIMDType a, vSIMDType b) noexcept                  { return (vSIMDType) veorq_u64 ((vMaskType) a, (vMaskType) b); }
@@ -522,6 +517,7 @@ struct SIMDNativeOps<double>
     static forcedinline vSIMDType add (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] + b.v[0], a.v[1] + b.v[1]}}; }
     static forcedinline vSIMDType sub (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] - b.v[0], a.v[1] - b.v[1]}}; }
     static forcedinline vSIMDType mul (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] * b.v[0], a.v[1] * b.v[1]}}; }
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] / b.v[0], a.v[1] / b.v[1]}}; }
     static forcedinline vSIMDType bit_and (vSIMDType a, vSIMDType b) noexcept                  { return fb::bit_and (a, b); }
     static forcedinline vSIMDType bit_or  (vSIMDType a, vSIMDType b) noexcept                  { return fb::bit_or  (a, b); }
     static forcedinline vSIMDType bit_xor (vSIMDType a, vSIMDType b) noexcept                  { return fb::bit_xor (a, b); }
@@ -545,4 +541,5 @@ struct SIMDNativeOps<double>
 
 JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 
+} // inline namespace JUCE_SIMD_NAMESPACE
 } // namespace juce::dsp
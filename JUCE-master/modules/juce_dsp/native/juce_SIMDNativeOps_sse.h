@@ -34,26 +34,15 @@
 
 namespace juce::dsp
 {
+inline namespace JUCE_SIMD_NAMESPACE
+{
 
 #ifndef DOXYGEN
 
 JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wignored-attributes")
 
-#ifdef _MSC_VER
- #define DECLARE_SSE_SIMD_CONST(type, name) \
-    static __declspec (align (16)) const type name [16 / sizeof (type)]
-
- #define DEFINE_SSE_SIMD_CONST(type, class_type, name) \
-    __declspec (align (16)) const type SIMDNativeOps<class_type>:: name [16 / sizeof (type)]
-
-#else
- #define DECLARE_SSE_SIMD_CONST(type, name) \
-    static const type name [16 / sizeof (type)] __attribute__ ((aligned (16)))
-
- #define DEFINE_SSE_SIMD_CONST(type, class_type, name) \
-    const type SIMDNativeOps<class_type>:: name [16 / sizeof (type)] __attribute__ ((aligned (16)))
-
-#endif
+#define DECLARE_SSE_SIMD_CONST(type, name) \
+    alignas (16) static inline const type name [16 / sizeof (type)]
 
 template <typename type>
 struct SIMDNativeOps;
@@ -70,9 +59,9 @@ struct SIMDNativeOps<float>
     using vSIMDType = __m128;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (int32_t, kAllBitsSet);
-    DECLARE_SSE_SIMD_CONST (int32_t, kEvenHighBit);
-    DECLARE_SSE_SIMD_CONST (float, kOne);
+    DECLARE_SSE_SIMD_CONST (int32_t, kAllBitsSet) = { -1, -1, -1, -1 };
+    DECLARE_SSE_SIMD_CONST (int32_t, kEvenHighBit) = { static_cast<int32_t> (0x80000000), 0, static_cast<int32_t> (0x80000000), 0 };
+    DECLARE_SSE_SIMD_CONST (float, kOne) = { 1.0f, 1.0f, 1.0f, 1.0f };
 
     //==============================================================================
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE expand (float s) noexcept                            { return _mm_load1_ps (&s); }
@@ -81,6 +70,7 @@ struct SIMDNativeOps<float>
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE add (__m128 a, __m128 b) noexcept                    { return _mm_add_ps (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE sub (__m128 a, __m128 b) noexcept                    { return _mm_sub_ps (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE mul (__m128 a, __m128 b) noexcept                    { return _mm_mul_ps (a, b); }
+    static forcedinline __m128 JUCE_VECTOR_CALLTYPE div (__m128 a, __m128 b) noexcept                    { return _mm_div_ps (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE bit_and (__m128 a, __m128 b) noexcept                { return _mm_and_ps (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE bit_or  (__m128 a, __m128 b) noexcept                { return _mm_or_ps  (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE bit_xor (__m128 a, __m128 b) noexcept                { return _mm_xor_ps (a, b); }
@@ -138,9 +128,9 @@ struct SIMDNativeOps<double>
     using vSIMDType = __m128d;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (int64_t, kAllBitsSet);
-    DECLARE_SSE_SIMD_CONST (int64_t, kEvenHighBit);
-    DECLARE_SSE_SIMD_CONST (double, kOne);
+    DECLARE_SSE_SIMD_CONST (int64_t, kAllBitsSet) = { -1LL, -1LL };
+    DECLARE_SSE_SIMD_CONST (int64_t, kEvenHighBit) = { static_cast<int64_t> (0x8000000000000000), 0 };
+    DECLARE_SSE_SIMD_CONST (double, kOne) = { 1.0, 1.0 };
 
     //==============================================================================
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE vconst (const double* a) noexcept                       { return load (a); }
@@ -151,6 +141,7 @@ struct SIMDNativeOps<double>
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE add (__m128d a, __m128d b) noexcept                     { return _mm_add_pd (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE sub (__m128d a, __m128d b) noexcept                     { return _mm_sub_pd (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE mul (__m128d a, __m128d b) noexcept                     { return _mm_mul_pd (a, b); }
+    static forcedinline __m128d JUCE_VECTOR_CALLTYPE div (__m128d a, __m128d b) noexcept                     { return _mm_div_pd (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE bit_and (__m128d a, __m128d b) noexcept                 { return _mm_and_pd (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE bit_or  (__m128d a, __m128d b) noexcept                 { return _mm_or_pd  (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE bit_xor (__m128d a, __m128d b) noexcept                 { return _mm_xor_pd (a, b); }
@@ -205,7 +196,7 @@ struct SIMDNativeOps<int8_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (int8_t, kAllBitsSet);
+    DECLARE_SSE_SIMD_CONST (int8_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
 
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE vconst (const int8_t* a) noexcept                       { return load (a); }
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE load (const int8_t* a) noexcept                         { return _mm_load_si128 (reinterpret_cast<const __m128i*> (a)); }
@@ -277,8 +268,8 @@ struct SIMDNativeOps<uint8_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (uint8_t, kHighBit);
-    DECLARE_SSE_SIMD_CONST (uint8_t, kAllBitsSet);
+    DECLARE_SSE_SIMD_CONST (uint8_t, kHighBit) = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 };
+    DECLARE_SSE_SIMD_CONST (uint8_t, kAllBitsSet) = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
 
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE vconst (const uint8_t* a) noexcept                      { return load (a); }
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE ssign (__m128i a) noexcept                              { return _mm_xor_si128 (a, vconst (kHighBit)); }
@@ -347,7 +338,7 @@ struct SIMDNativeOps<int16_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (int16_t, kAllBitsSet);
+    DECLARE_SSE_SIMD_CONST (int16_t, kAllBitsSet) = { -1, -1, -1, -1, -1, -1, -1, -1 };
 
     //==============================================================================
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE vconst (const int16_t* a) noexcept                      { return load (a); }
@@ -401,8 +392,8 @@ struct SIMDNativeOps<uint16_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (uint16_t, kHighBit);
-    DECLARE_SSE_SIMD_CONST (uint16_t, kAllBitsSet);
+    DECLARE_SSE_SIMD_CONST (uint16_t, kHighBit) = { 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000 };
+    DECLARE_SSE_SIMD_CONST (uint16_t, kAllBitsSet) = { 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff };
 
     //==============================================================================
     static forcedinline __m128i  JUCE_VECTOR_CALLTYPE vconst (const uint16_t* a) noexcept                     { return load (a); }
@@ -462,7 +453,7 @@ struct SIMDNativeOps<int32_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (int32_t, kAllBitsSet);
+    DECLARE_SSE_SIMD_CONST (int32_t, kAllBitsSet) = { -1, -1, -1, -1 };
 
     //==============================================================================
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE vconst (const int32_t* a) noexcept                      { return load (a); }
@@ -542,8 +533,8 @@ struct SIMDNativeOps<uint32_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (uint32_t, kAllBitsSet);
-    DECLARE_SSE_SIMD_CONST (uint32_t, kHighBit);
+    DECLARE_SSE_SIMD_CONST (uint32_t, kAllBitsSet) = { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff };
+    DECLARE_SSE_SIMD_CONST (uint32_t, kHighBit) = { 0x80000000, 0x80000000, 0x80000000, 0x80000000 };
 
     //==============================================================================
     static forcedinline __m128i  JUCE_VECTOR_CALLTYPE vconst (const uint32_t* a) noexcept                     { return load (a); }
@@ -624,7 +615,7 @@ struct SIMDNativeOps<int64_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (int64_t, kAllBitsSet);
+    DECLARE_SSE_SIMD_CONST (int64_t, kAllBitsSet) = { -1, -1 };
 
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE vconst (const int64_t* a) noexcept                      { return load (a); }
     static forcedinline __m128i JUCE_VECTOR_CALLTYPE expand (int64_t s) noexcept                             { return _mm_set1_epi64x (s); }
@@ -682,8 +673,8 @@ struct SIMDNativeOps<uint64_t>
     using vSIMDType = __m128i;
 
     //==============================================================================
-    DECLARE_SSE_SIMD_CONST (uint64_t, kAllBitsSet);
-    DECLARE_SSE_SIMD_CONST (uint64_t, kHighBit);
+    DECLARE_SSE_SIMD_CONST (uint64_t, kAllBitsSet) = { 0xffffffffffffffff, 0xffffffffffffffff };
+    DECLARE_SSE_SIMD_CONST (uint64_t, kHighBit) = { 0x8000000000000000, 0x8000000000000000 };
 
     static forcedinline __m128i  JUCE_VECTOR_CALLTYPE vconst (const uint64_t* a) noexcept                     { return load (a); }
     static forcedinline __m128i  JUCE_VECTOR_CALLTYPE expand (uint64_t s) noexcept                            { return _mm_set1_epi64x ((int64_t) s); }
@@ -734,4 +725,5 @@ struct SIMDNativeOps<uint64_t>
 
 JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 
+} // inline namespace JUCE_SIMD_NAMESPACE
 } // namespace juce::dsp
@@ -120,13 +120,8 @@ public:
         }
 
         for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
-        }
+            processSamples ((int) channel, inputBlock.getChannelPointer (channel),
+                            outputBlock.getChannelPointer (channel), numSamples);
 
        #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
         snapToZero();
@@ -136,6 +131,12 @@ public:
     /** Processes one sample at a time on a given channel. */
     SampleType processSample (int channel, SampleType inputValue);
 
+    /** Processes a run of samples on a given channel. This gives the same results
+        as calling processSample() for each of them, but is faster. The input and
+        output may be the same.
+    */
+    void processSamples (int channel, const SampleType* input, SampleType* output, size_t numSamples) noexcept;
+
     /** Ensure that the state variables are rounded to zero if the state
         variables are denormals. This is only needed if you are doing
         sample by sample processing.
@@ -153,4 +154,7 @@ private:
     LevelCalculationType levelType = LevelCalculationType::peak;
 };
 
+template <typename SampleType>
+struct SupportsPerSampleProcessing<BallisticsFilter<SampleType>>  : std::true_type {};
+
 } // namespace juce::dsp
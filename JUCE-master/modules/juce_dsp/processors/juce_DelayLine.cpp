@@ -78,7 +78,7 @@ void DelayLine<SampleType, InterpolationType>::prepare (const ProcessSpec& spec)
 {
     jassert (spec.numChannels > 0);
 
-    bufferData.setSize ((int) spec.numChannels, totalSize, false, false, true);
+    bufferData.setSize ((int) spec.numChannels, totalSize + numGuardSamples, false, false, true);
 
     writePos.resize (spec.numChannels);
     readPos.resize  (spec.numChannels);
@@ -94,7 +94,7 @@ void DelayLine<SampleType, InterpolationType>::setMaximumDelayInSamples (int max
 {
     jassert (maxDelayInSamples >= 0);
     totalSize = jmax (4, maxDelayInSamples + 2);
-    bufferData.setSize ((int) bufferData.getNumChannels(), totalSize, false, false, true);
+    bufferData.setSize ((int) bufferData.getNumChannels(), totalSize + numGuardSamples, false, false, true);
     reset();
 }
 
@@ -114,6 +114,10 @@ template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::pushSample (int channel, SampleType sample)
 {
     bufferData.setSample (channel, writePos[(size_t) channel], sample);
+
+    if (writePos[(size_t) channel] < numGuardSamples)
+        bufferData.setSample (channel, writePos[(size_t) channel] + totalSize, sample);
+
     writePos[(size_t) channel] = (writePos[(size_t) channel] + totalSize - 1) % totalSize;
 }
 
@@ -131,6 +135,250 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     return result;
 }
 
+//==============================================================================
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::pushSamples (int channel, const SampleType* samples, int numSamples)
+{
+    auto* data = bufferData.getWritePointer (channel);
+    auto pos = writePos[(size_t) channel];
+
+    // The samples are written backwards from the write position, which wraps around at most
+    // once for each pass through the buffer
+    for (int i = 0; i < numSamples;)
+    {
+        auto numToWrite = jmin (numSamples - i, pos + 1);
+
+        for (int j = 0; j < numToWrite; ++j)
+            data[pos - j] = samples[i + j];
+
+        i += numToWrite;
+        pos -= numToWrite;
+
+        if (pos < 0)
+            pos = totalSize - 1;
+    }
+
+    std::copy (data, data + numGuardSamples, data + totalSize);
+    writePos[(size_t) channel] = pos;
+}
+
+//==============================================================================
+/*  The kernels used by DelayLine::popSamples. They work either on single samples or
+    on SIMDRegisters, so that the delays and the interpolation of several samples are
+    computed at once. Only the reads from the delay line are done one sample at a time.
+*/
+template <typename SampleType>
+struct DelayLineBlockKernels
+{
+   #if JUCE_USE_SIMD
+    using Lanes = SIMDRegister<SampleType>;
+    static constexpr int numLanes = (int) Lanes::SIMDNumElements;
+   #else
+    static constexpr int numLanes = 1;
+   #endif
+
+    static constexpr int chunkSize = 64;
+
+    struct alignas (numLanes * sizeof (SampleType)) Chunk
+    {
+        SampleType delays[chunkSize], delayInts[chunkSize], fracs[chunkSize];
+        SampleType values[4][chunkSize];
+        SampleType output[chunkSize];
+    };
+
+    static SampleType load (const SampleType* source, SampleType) noexcept     { return *source; }
+    static void store (SampleType value, SampleType* dest) noexcept             { *dest = value; }
+    static SampleType truncate (SampleType value) noexcept                     { return std::trunc (value); }
+
+    static SampleType clamp (SampleType value, SampleType upperLimit) noexcept
+    {
+        return jlimit ((SampleType) 0, upperLimit, value);
+    }
+
+    static SampleType getShift (SampleType delayInt, SampleType frac, SampleType maxFrac) noexcept
+    {
+        return delayInt >= 1 && frac < maxFrac ? (SampleType) 1 : (SampleType) 0;
+    }
+
+   #if JUCE_USE_SIMD
+    static Lanes load (const SampleType* source, Lanes) noexcept               { return Lanes::fromRawArray (source); }
+    static void store (Lanes value, SampleType* dest) noexcept                  { value.copyToRawArray (dest); }
+    static Lanes truncate (Lanes value) noexcept                                { return Lanes::truncate (value); }
+
+    static Lanes clamp (Lanes value, SampleType upperLimit) noexcept
+    {
+        return Lanes::min (Lanes::max (value, Lanes::expand (0)), Lanes::expand (upperLimit));
+    }
+
+    static Lanes getShift (Lanes delayInt, Lanes frac, SampleType maxFrac) noexcept
+    {
+        return Lanes::expand (1) & (Lanes::greaterThanOrEqual (delayInt, Lanes::expand (1))
+                                     & Lanes::lessThan (frac, Lanes::expand (maxFrac)));
+    }
+   #endif
+
+    /** Calls fn with a SIMDRegister for each group of lanes, then with single
+        samples for the remaining ones.
+    */
+    template <typename Fn>
+    static void forEachValue (int numSamples, Fn&& fn)
+    {
+        int i = 0;
+
+       #if JUCE_USE_SIMD
+        for (; i + numLanes <= numSamples; i += numLanes)
+            fn (i, Lanes());
+       #endif
+
+        for (; i < numSamples; ++i)
+            fn (i, SampleType());
+    }
+};
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popSamples (int channel, const SampleType* delaysInSamples,
+                                                           SampleType* outputSamples, int numSamples,
+                                                           bool updateReadPointer)
+{
+    using Kernels = DelayLineBlockKernels<SampleType>;
+    namespace Types = DelayLineInterpolationTypes;
+
+    if (numSamples <= 0)
+        return;
+
+    const auto* data = bufferData.getReadPointer (channel);
+    const auto upperLimit = (SampleType) getMaximumDelayInSamples();
+    auto pos = readPos[(size_t) channel];
+
+    // These are the same splits of the delays as in updateInternalVariables
+    constexpr auto maxFracForShift = std::is_same_v<InterpolationType, Types::Lagrange3rd> ? (SampleType) 2.0
+                                   : std::is_same_v<InterpolationType, Types::Thiran>      ? (SampleType) 0.618
+                                                                                           : (SampleType) 0.0;
+
+    typename Kernels::Chunk chunk;
+
+    for (int start = 0; start < numSamples; start += Kernels::chunkSize)
+    {
+        const auto num = jmin (Kernels::chunkSize, numSamples - start);
+        std::copy (delaysInSamples + start, delaysInSamples + start + num, chunk.delays);
+
+        Kernels::forEachValue (num, [&] (int i, auto type)
+        {
+            auto delayValue = Kernels::clamp (Kernels::load (chunk.delays + i, type), upperLimit);
+            auto wholePart = Kernels::truncate (delayValue);
+            auto frac = delayValue - wholePart;
+
+            if constexpr (maxFracForShift > 0)
+            {
+                auto shift = Kernels::getShift (wholePart, frac, maxFracForShift);
+                wholePart = wholePart - shift;
+                frac = frac + shift;
+            }
+
+            Kernels::store (wholePart, chunk.delayInts + i);
+            Kernels::store (frac, chunk.fracs + i);
+        });
+
+        // The read position moves backwards, and the guard samples after the end of the
+        // buffer mean that only the first index of each read needs to be wrapped
+        auto getIndex = [&] (int i)
+        {
+            auto index = pos + (int) chunk.delayInts[i];
+
+            if (index >= totalSize)
+                index -= totalSize;
+
+            pos = (pos == 0 ? totalSize : pos) - 1;
+            return index;
+        };
+
+        auto* output = outputSamples + start;
+
+        if constexpr (std::is_same_v<InterpolationType, Types::None>)
+        {
+            for (int i = 0; i < num; ++i)
+                output[i] = data[getIndex (i)];
+        }
+        else if constexpr (std::is_same_v<InterpolationType, Types::Linear>)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                auto index = getIndex (i);
+                chunk.values[0][i] = data[index];
+                chunk.values[1][i] = data[index + 1];
+            }
+
+            Kernels::forEachValue (num, [&] (int i, auto type)
+            {
+                auto value1 = Kernels::load (chunk.values[0] + i, type);
+                auto value2 = Kernels::load (chunk.values[1] + i, type);
+                auto frac   = Kernels::load (chunk.fracs + i, type);
+
+                Kernels::store (value1 + frac * (value2 - value1), chunk.output + i);
+            });
+
+            std::copy (chunk.output, chunk.output + num, output);
+        }
+        else if constexpr (std::is_same_v<InterpolationType, Types::Lagrange3rd>)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                auto index = getIndex (i);
+
+                for (int n = 0; n < 4; ++n)
+                    chunk.values[n][i] = data[index + n];
+            }
+
+            Kernels::forEachValue (num, [&] (int i, auto type)
+            {
+                auto value1 = Kernels::load (chunk.values[0] + i, type);
+                auto value2 = Kernels::load (chunk.values[1] + i, type);
+                auto value3 = Kernels::load (chunk.values[2] + i, type);
+                auto value4 = Kernels::load (chunk.values[3] + i, type);
+                auto frac   = Kernels::load (chunk.fracs + i, type);
+
+                auto d1 = frac - (SampleType) 1;
+                auto d2 = frac - (SampleType) 2;
+                auto d3 = frac - (SampleType) 3;
+
+                auto c1 = d1 * d2 * d3 * (SampleType) (-1.0 / 6.0);
+                auto c2 = d2 * d3 * (SampleType) 0.5;
+                auto c3 = d1 * d3 * (SampleType) -0.5;
+                auto c4 = d1 * d2 * (SampleType) (1.0 / 6.0);
+
+                Kernels::store (value1 * c1 + frac * (value2 * c2 + value3 * c3 + value4 * c4), chunk.output + i);
+            });
+
+            std::copy (chunk.output, chunk.output + num, output);
+        }
+        else if constexpr (std::is_same_v<InterpolationType, Types::Thiran>)
+        {
+            // The allpass filter is recursive, so only the delays can be split in parallel
+            auto state = v[(size_t) channel];
+
+            for (int i = 0; i < num; ++i)
+            {
+                auto index = getIndex (i);
+                auto frac = chunk.fracs[i];
+
+                auto value1 = data[index];
+                auto value2 = data[index + 1];
+
+                auto alphaValue = (1 - frac) / (1 + frac);
+                state = approximatelyEqual (frac, (SampleType) 0) ? value1 : value2 + alphaValue * (value1 - state);
+                output[i] = state;
+            }
+
+            v[(size_t) channel] = state;
+        }
+    }
+
+    if (updateReadPointer)
+        readPos[(size_t) channel] = pos;
+
+    setDelay (delaysInSamples[numSamples - 1]);
+}
+
 //==============================================================================
 template class DelayLine<float,  DelayLineInterpolationTypes::None>;
 template class DelayLine<double, DelayLineInterpolationTypes::None>;
@@ -167,6 +167,45 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Pushes a block of samples into one channel of the delay line.
+
+        This is the same as calling pushSample for each of the samples in turn.
+
+        @see popSamples
+    */
+    void pushSamples (int channel, const SampleType* samples, int numSamples);
+
+    /** Pops a block of samples from one channel of the delay line, with a different
+        delay for each of them.
+
+        Use this function together with pushSamples instead of pushSample and popSample
+        to modulate the delay, when the samples don't need to be fed back into the delay
+        line within the block. Pushing a block and then popping it gives the same
+        results as pushing and popping each sample in turn, as long as the delays plus
+        the number of samples in the block stay below the maximum delay. With Thiran
+        interpolation, all the taps of a channel share the state of its allpass filter,
+        so multi-tap reads depend on the order of the calls.
+
+        @param channel              the target channel for the delay line.
+
+        @param delaysInSamples      the fractional delay in samples for each of the output
+                                    samples.
+
+        @param outputSamples        where the numSamples delayed samples are written.
+
+        @param numSamples           the number of samples to pop.
+
+        @param updateReadPointer    should be set to true if you use the function once
+                                    for each block, or false if you need multi-tap delay
+                                    capabilities, in which case only the last tap
+                                    should update the read pointer.
+
+        @see pushSamples, popSample
+    */
+    void popSamples (int channel, const SampleType* delaysInSamples, SampleType* outputSamples,
+                     int numSamples, bool updateReadPointer = true);
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -309,6 +348,10 @@ private:
     }
 
     //==============================================================================
+    // The first samples of each channel are repeated after its end, so that the
+    // interpolators of popSamples never need to wrap their indices around
+    static constexpr int numGuardSamples = 3;
+
     double sampleRate;
 
     //==============================================================================
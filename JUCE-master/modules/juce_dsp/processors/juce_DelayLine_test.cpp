@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class DelayLineTest final : public UnitTest
+{
+public:
+    DelayLineTest()
+        : UnitTest ("DelayLine", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float,  DelayLineInterpolationTypes::None>        ("float, None");
+        runTestsForType<float,  DelayLineInterpolationTypes::Linear>      ("float, Linear");
+        runTestsForType<float,  DelayLineInterpolationTypes::Lagrange3rd> ("float, Lagrange3rd");
+        runTestsForType<float,  DelayLineInterpolationTypes::Thiran>      ("float, Thiran");
+        runTestsForType<double, DelayLineInterpolationTypes::Lagrange3rd> ("double, Lagrange3rd");
+        runTestsForType<double, DelayLineInterpolationTypes::Thiran>      ("double, Thiran");
+    }
+
+private:
+    template <typename SampleType, typename InterpolationType>
+    void runTestsForType (const String& typeName)
+    {
+        constexpr int numChannels = 2, blockSize = 150, maxDelay = 200;
+        const ProcessSpec spec { 44100.0, (uint32) blockSize, (uint32) numChannels };
+
+        beginTest ("Block reads match sample by sample reads (" + typeName + ")");
+        {
+            DelayLine<SampleType, InterpolationType> sampleBySample (maxDelay + blockSize), blocks (maxDelay + blockSize);
+            sampleBySample.prepare (spec);
+            blocks.prepare (spec);
+
+            std::vector<SampleType> input ((size_t) blockSize), delays ((size_t) blockSize), delays2 ((size_t) blockSize),
+                                    expected ((size_t) blockSize), expected2 ((size_t) blockSize),
+                                    output ((size_t) blockSize), output2 ((size_t) blockSize);
+            auto random = getRandom();
+            auto maxError = (SampleType) 0;
+            auto phase = 0.0;
+
+            // The Thiran interpolator has a single state for each channel, so its taps
+            // depend on the order in which they're read
+            constexpr auto useSecondTap = ! std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>;
+
+            // The blocks don't divide the buffer length, so the reads wrap around at various positions
+            for (int block = 0; block < 12; ++block)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    for (int i = 0; i < blockSize; ++i)
+                    {
+                        input[(size_t) i] = (SampleType) (2.0f * random.nextFloat() - 1.0f);
+                        delays[(size_t) i]  = (SampleType) (100.0 + 90.0 * std::sin (phase + 0.01 * i));
+                        delays2[(size_t) i] = (SampleType) (random.nextFloat() * 3.0f);
+                    }
+
+                    for (int i = 0; i < blockSize; ++i)
+                    {
+                        sampleBySample.pushSample (channel, input[(size_t) i]);
+
+                        if (useSecondTap)
+                            expected2[(size_t) i] = sampleBySample.popSample (channel, delays2[(size_t) i], false);
+
+                        expected[(size_t) i] = sampleBySample.popSample (channel, delays[(size_t) i]);
+                    }
+
+                    blocks.pushSamples (channel, input.data(), blockSize);
+
+                    if (useSecondTap)
+                        blocks.popSamples (channel, delays2.data(), output2.data(), blockSize, false);
+
+                    blocks.popSamples (channel, delays.data(), output.data(), blockSize);
+
+                    for (size_t i = 0; i < (size_t) blockSize; ++i)
+                        maxError = jmax (maxError, std::abs (expected[i] - output[i]), std::abs (expected2[i] - output2[i]));
+                }
+
+                phase += 1.7;
+            }
+
+            expectLessThan (maxError, (SampleType) 1.0e-5);
+            expectEquals (blocks.getDelay(), sampleBySample.getDelay());
+        }
+    }
+};
+
+static DelayLineTest delayLineUnitTest;
+
+} // namespace juce::dsp
@@ -160,6 +160,457 @@ void FIR::Coefficients<NumericType>::Coefficients::normalise() noexcept
     FloatVectorOperations::multiply (coefs, magnitudeInv, static_cast<int> (n));
 }
 
+//==============================================================================
+class FIR::FastFilter::Engine
+{
+public:
+    virtual ~Engine() = default;
+
+    virtual void reset() noexcept = 0;
+
+    // Processes up to the maximum block size given to the constructor, for up to
+    // the number of channels given to the constructor. The input and output may
+    // point to the same memory.
+    virtual void process (const float* const* input, float* const* output,
+                          size_t numChannels, size_t numSamples) noexcept = 0;
+};
+
+//==============================================================================
+class FIR::FastFilter::DirectFormEngine final : public FIR::FastFilter::Engine
+{
+public:
+    DirectFormEngine (const float* coefficients, size_t numTapsIn, size_t maxBlockSize, size_t numChannels)
+        : numTaps (numTapsIn),
+          reversedCoefficients (coefficients, coefficients + numTaps),
+          history ((int) numChannels, (int) (numTaps - 1 + maxBlockSize))
+    {
+        std::reverse (reversedCoefficients.begin(), reversedCoefficients.end());
+        reset();
+    }
+
+    void reset() noexcept override
+    {
+        history.clear();
+    }
+
+    void process (const float* const* input, float* const* output,
+                  size_t numChannels, size_t numSamples) noexcept override
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* samples = history.getWritePointer ((int) channel);
+            const auto numPrevious = numTaps - 1;
+
+            FloatVectorOperations::copy (samples + numPrevious, input[channel], (int) numSamples);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                output[channel][i] = FloatVectorOperations::dotProduct (samples + i, reversedCoefficients.data(), (int) numTaps);
+
+            std::memmove (samples, samples + numSamples, numPrevious * sizeof (float));
+        }
+    }
+
+private:
+    const size_t numTaps;
+    std::vector<float> reversedCoefficients;
+
+    // The last numTaps - 1 input samples of each channel, followed by space for a block
+    AudioBuffer<float> history;
+};
+
+//==============================================================================
+#if JUCE_USE_SIMD
+class FIR::FastFilter::InterleavedEngine final : public FIR::FastFilter::Engine
+{
+public:
+    using Lanes = SIMDRegister<float>;
+    static constexpr size_t numLanes = Lanes::SIMDNumElements;
+
+    InterleavedEngine (const float* coefficients, size_t numTapsIn, size_t maxBlockSize, size_t numChannels)
+        : numTaps (numTapsIn),
+          historySize (numTaps - 1 + maxBlockSize),
+          numGroups ((numChannels + numLanes - 1) / numLanes),
+          reversedCoefficients (coefficients, coefficients + numTaps)
+    {
+        std::reverse (reversedCoefficients.begin(), reversedCoefficients.end());
+
+        storage.malloc (numGroups * historySize * sizeof (Lanes) + sizeof (Lanes));
+        history = unalignedPointerCast<Lanes*> (snapPointerToAlignment (storage.getData(), sizeof (Lanes)));
+        reset();
+    }
+
+    void reset() noexcept override
+    {
+        std::fill (history, history + numGroups * historySize, Lanes::expand (0.0f));
+    }
+
+    void process (const float* const* input, float* const* output,
+                  size_t numChannels, size_t numSamples) noexcept override
+    {
+        alignas (sizeof (Lanes)) float lanes[numLanes] = {};
+        const auto numPrevious = numTaps - 1;
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            const auto firstChannel = group * numLanes;
+
+            if (firstChannel >= numChannels)
+                break;
+
+            const auto numChannelsInGroup = jmin (numLanes, numChannels - firstChannel);
+            auto* samples = history + group * historySize;
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+                    lanes[lane] = input[firstChannel + lane][i];
+
+                samples[numPrevious + i] = Lanes::fromRawArray (lanes);
+            }
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto sum = Lanes::expand (0.0f);
+
+                for (size_t k = 0; k < numTaps; ++k)
+                    sum += samples[i + k] * reversedCoefficients[k];
+
+                sum.copyToRawArray (lanes);
+
+                for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+                    output[firstChannel + lane][i] = lanes[lane];
+            }
+
+            std::copy (samples + numSamples, samples + numSamples + numPrevious, samples);
+        }
+    }
+
+private:
+    const size_t numTaps, historySize, numGroups;
+    std::vector<float> reversedCoefficients;
+
+    // For each group of channels, the last numTaps - 1 input samples followed by
+    // space for a block, with one channel in each lane
+    HeapBlock<char> storage;
+    Lanes* history = nullptr;
+};
+#endif
+
+//==============================================================================
+// Zero-latency, uniformly partitioned overlap-save convolution.
+//
+// The filter is split into partitions of blockSize taps, and each partition is
+// convolved with frames of 2 * blockSize input samples: the previous block and
+// the one that's currently being collected. Only the contributions of the wanted
+// output samples are kept, so there's no overlap to add. The spectra of the
+// older frames are combined once per block, and only the current frame is
+// transformed again on each call, with the samples that haven't arrived yet set
+// to zero. Since each output sample only depends on past input samples, this
+// gives exactly the result of the direct form without any added latency.
+class FIR::FastFilter::OverlapSaveEngine final : public FIR::FastFilter::Engine
+{
+public:
+    OverlapSaveEngine (const float* coefficients, size_t numTaps, size_t maxBlockSize, size_t numChannels)
+        : blockSize ((size_t) nextPowerOfTwo ((int) jmax (maxBlockSize, (size_t) 32))),
+          fftSize (2 * blockSize),
+          numBins (blockSize + 1),
+          numPartitions ((numTaps + blockSize - 1) / blockSize),
+          fft (roundToInt (std::log2 (fftSize))),
+          filterSpectra (2 * (int) numPartitions, (int) numBins),
+          fftBuffer (1, 2 * (int) fftSize),
+          accumulator (2, (int) numBins)
+    {
+        for (size_t partition = 0; partition < numPartitions; ++partition)
+        {
+            auto* data = fftBuffer.getWritePointer (0);
+            fftBuffer.clear();
+
+            const auto start = partition * blockSize;
+            FloatVectorOperations::copy (data, coefficients + start, (int) jmin (blockSize, numTaps - start));
+
+            fft.performRealOnlyForwardTransform (data, true);
+            deinterleave (data, filterSpectra.getWritePointer (2 * (int) partition), filterSpectra.getWritePointer (2 * (int) partition + 1));
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            channels.emplace_back (fftSize, numBins, numPartitions);
+
+        reset();
+    }
+
+    void reset() noexcept override
+    {
+        for (auto& channel : channels)
+        {
+            channel.frame.clear();
+            channel.inputSpectra.clear();
+            channel.olderContributions.clear();
+            channel.position = 0;
+            channel.currentFrame = 0;
+        }
+    }
+
+    void process (const float* const* input, float* const* output,
+                  size_t numChannels, size_t numSamples) noexcept override
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            processChannel (channels[channel], input[channel], output[channel], numSamples);
+    }
+
+private:
+    struct ChannelState
+    {
+        ChannelState (size_t fftSize, size_t numBins, size_t numPartitions)
+            : frame (1, (int) fftSize),
+              inputSpectra (2 * (int) numPartitions, (int) numBins),
+              olderContributions (2, (int) numBins)
+        {}
+
+        AudioBuffer<float> frame, inputSpectra, olderContributions;
+        size_t position = 0, currentFrame = 0;
+    };
+
+    void processChannel (ChannelState& state, const float* input, float* output, size_t numSamples) noexcept
+    {
+        auto* frame = state.frame.getWritePointer (0);
+        auto* data = fftBuffer.getWritePointer (0);
+        auto* sumReal = accumulator.getWritePointer (0);
+        auto* sumImag = accumulator.getWritePointer (1);
+
+        for (size_t done = 0; done < numSamples;)
+        {
+            const auto numToDo = jmin (numSamples - done, blockSize - state.position);
+
+            if (state.position == 0)
+                accumulateOlderFrames (state);
+
+            FloatVectorOperations::copy (frame + blockSize + state.position, input + done, (int) numToDo);
+
+            FloatVectorOperations::copy (data, frame, (int) fftSize);
+            FloatVectorOperations::clear (data + fftSize, (int) fftSize);
+            fft.performRealOnlyForwardTransform (data, true);
+
+            auto* inputReal = state.inputSpectra.getWritePointer (2 * (int) state.currentFrame);
+            auto* inputImag = state.inputSpectra.getWritePointer (2 * (int) state.currentFrame + 1);
+            deinterleave (data, inputReal, inputImag);
+
+            FloatVectorOperations::copy (sumReal, state.olderContributions.getReadPointer (0), (int) numBins);
+            FloatVectorOperations::copy (sumImag, state.olderContributions.getReadPointer (1), (int) numBins);
+            multiplyAccumulate (inputReal, inputImag, 0, sumReal, sumImag);
+
+            for (size_t bin = 0; bin < numBins; ++bin)
+            {
+                data[2 * bin]     = sumReal[bin];
+                data[2 * bin + 1] = sumImag[bin];
+            }
+
+            fft.performRealOnlyInverseTransform (data);
+            FloatVectorOperations::copy (output + done, data + blockSize + state.position, (int) numToDo);
+
+            state.position += numToDo;
+            done += numToDo;
+
+            if (state.position == blockSize)
+            {
+                FloatVectorOperations::copy (frame, frame + blockSize, (int) blockSize);
+                FloatVectorOperations::clear (frame + blockSize, (int) blockSize);
+
+                state.position = 0;
+                state.currentFrame = (state.currentFrame + 1) % numPartitions;
+            }
+        }
+    }
+
+    // Sums the contributions of the frames before the current one, which stay the
+    // same until the current block is complete.
+    void accumulateOlderFrames (ChannelState& state) noexcept
+    {
+        auto* sumReal = state.olderContributions.getWritePointer (0);
+        auto* sumImag = state.olderContributions.getWritePointer (1);
+
+        FloatVectorOperations::clear (sumReal, (int) numBins);
+        FloatVectorOperations::clear (sumImag, (int) numBins);
+
+        for (size_t partition = 1; partition < numPartitions; ++partition)
+        {
+            const auto frameIndex = (state.currentFrame + numPartitions - partition) % numPartitions;
+
+            multiplyAccumulate (state.inputSpectra.getReadPointer (2 * (int) frameIndex),
+                                state.inputSpectra.getReadPointer (2 * (int) frameIndex + 1),
+                                partition, sumReal, sumImag);
+        }
+    }
+
+    void multiplyAccumulate (const float* inputReal, const float* inputImag, size_t partition,
+                             float* sumReal, float* sumImag) const noexcept
+    {
+        const auto* filterReal = filterSpectra.getReadPointer (2 * (int) partition);
+        const auto* filterImag = filterSpectra.getReadPointer (2 * (int) partition + 1);
+        const auto num = (int) numBins;
+
+        FloatVectorOperations::addWithMultiply      (sumReal, inputReal, filterReal, num);
+        FloatVectorOperations::subtractWithMultiply (sumReal, inputImag, filterImag, num);
+        FloatVectorOperations::addWithMultiply      (sumImag, inputReal, filterImag, num);
+        FloatVectorOperations::addWithMultiply      (sumImag, inputImag, filterReal, num);
+    }
+
+    void deinterleave (const float* source, float* real, float* imag) const noexcept
+    {
+        for (size_t bin = 0; bin < numBins; ++bin)
+        {
+            real[bin] = source[2 * bin];
+            imag[bin] = source[2 * bin + 1];
+        }
+    }
+
+    const size_t blockSize, fftSize, numBins, numPartitions;
+    FFT fft;
+    AudioBuffer<float> filterSpectra, fftBuffer, accumulator;
+    std::vector<ChannelState> channels;
+};
+
+//==============================================================================
+FIR::FastFilter::FastFilter()
+    : FastFilter (new Coefficients<float>)
+{
+}
+
+FIR::FastFilter::FastFilter (Coefficients<float>::Ptr coefficientsToUse, Method methodToUse)
+    : coefficients (std::move (coefficientsToUse)), method (methodToUse)
+{
+}
+
+FIR::FastFilter::~FastFilter() = default;
+
+void FIR::FastFilter::setCoefficients (Coefficients<float>::Ptr newCoefficients)
+{
+    coefficients = std::move (newCoefficients);
+
+    if (engine != nullptr)
+        rebuildEngine();
+}
+
+void FIR::FastFilter::setMethod (Method newMethod)
+{
+    method = newMethod;
+
+    if (engine != nullptr)
+        rebuildEngine();
+}
+
+FIR::FastFilter::Method FIR::FastFilter::chooseMethod (size_t numTaps, const ProcessSpec& processSpec) noexcept
+{
+    const auto blockSize = (size_t) nextPowerOfTwo ((int) jmax ((uint32) 32, processSpec.maximumBlockSize));
+    const auto numPartitions = (numTaps + blockSize - 1) / blockSize;
+
+   #if JUCE_USE_SIMD
+    // Interleaving only pays off if most of the lanes are filled with channels
+    const auto numLanes = (size_t) SIMDRegister<float>::SIMDNumElements;
+    const auto numChannels = (size_t) processSpec.numChannels;
+    const auto numGroups = (numChannels + numLanes - 1) / numLanes;
+    const auto useInterleaved = numChannels > 1 && 2 * numChannels > numGroups * numLanes;
+   #else
+    const auto useInterleaved = false;
+   #endif
+
+    // Rough costs per output sample: a multiply-add for each tap in the time domain
+    // (a bit less when interleaved), against a forward and an inverse transform of
+    // twice the block size, plus a complex multiply-add for each partition, in the
+    // frequency domain.
+    const auto directCost = (double) numTaps * (useInterleaved ? 0.6 : 1.0);
+    const auto fftCost = 4.0 * std::log2 ((double) (2 * blockSize)) + 4.0 * (double) numPartitions + 32.0;
+
+    if (fftCost < directCost)
+        return Method::overlapSave;
+
+    if (useInterleaved)
+        return Method::interleavedDirectForm;
+
+    return Method::directForm;
+}
+
+void FIR::FastFilter::prepare (const ProcessSpec& newSpec)
+{
+    jassert (newSpec.maximumBlockSize > 0 && newSpec.numChannels > 0);
+
+    spec = newSpec;
+    bypassBuffer.setSize ((int) spec.numChannels, (int) spec.maximumBlockSize);
+    inputPointers.resize (spec.numChannels);
+    outputPointers.resize (spec.numChannels);
+    rebuildEngine();
+}
+
+void FIR::FastFilter::reset() noexcept
+{
+    if (engine != nullptr)
+        engine->reset();
+}
+
+void FIR::FastFilter::rebuildEngine()
+{
+    jassert (coefficients != nullptr);
+
+    // an empty set of coefficients produces silence, like a single zero tap
+    static constexpr float silence = 0.0f;
+    const auto hasTaps = ! coefficients->coefficients.isEmpty();
+    const auto* taps = hasTaps ? coefficients->getRawCoefficients() : &silence;
+    const auto numTaps = hasTaps ? (size_t) coefficients->coefficients.size() : (size_t) 1;
+    const auto maxBlockSize = (size_t) spec.maximumBlockSize;
+    const auto numChannels = (size_t) spec.numChannels;
+
+    activeMethod = method == Method::automatic ? chooseMethod (numTaps, spec) : method;
+
+    switch (activeMethod)
+    {
+        case Method::overlapSave:
+            engine = std::make_unique<OverlapSaveEngine> (taps, numTaps, maxBlockSize, numChannels);
+            break;
+
+        case Method::interleavedDirectForm:
+           #if JUCE_USE_SIMD
+            engine = std::make_unique<InterleavedEngine> (taps, numTaps, maxBlockSize, numChannels);
+            break;
+           #else
+            activeMethod = Method::directForm;
+            [[fallthrough]];
+           #endif
+
+        case Method::automatic:
+        case Method::directForm:
+            engine = std::make_unique<DirectFormEngine> (taps, numTaps, maxBlockSize, numChannels);
+            break;
+    }
+}
+
+void FIR::FastFilter::processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, bool isBypassed) noexcept
+{
+    // You must call prepare() before processing
+    jassert (engine != nullptr);
+
+    // The block is larger than the spec passed to prepare()
+    jassert (input.getNumChannels() <= spec.numChannels && input.getNumSamples() <= spec.maximumBlockSize);
+    jassert (input.getNumChannels() == output.getNumChannels());
+    jassert (input.getNumSamples()  == output.getNumSamples());
+
+    const auto numChannels = jmin (input.getNumChannels(), output.getNumChannels(), (size_t) spec.numChannels);
+    const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples(), (size_t) spec.maximumBlockSize);
+
+    if (engine == nullptr || numChannels == 0 || numSamples == 0)
+        return;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        inputPointers[channel]  = input.getChannelPointer (channel);
+        outputPointers[channel] = isBypassed ? bypassBuffer.getWritePointer ((int) channel)
+                                             : output.getChannelPointer (channel);
+    }
+
+    engine->process (inputPointers.data(), outputPointers.data(), numChannels, numSamples);
+
+    if (isBypassed && input.getChannelPointer (0) != output.getChannelPointer (0))
+        output.copyFrom (input);
+}
+
 //==============================================================================
 template struct FIR::Coefficients<float>;
 template struct FIR::Coefficients<double>;
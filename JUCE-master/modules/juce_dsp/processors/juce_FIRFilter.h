@@ -47,10 +47,10 @@ namespace juce::dsp::FIR
 
         Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
         samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        FastFilter instead, which switches to processing in the frequency domain
+        thanks to FFT without adding any latency, or Convolution.
 
-        @see FIRFilter::Coefficients, Convolution, FFT
+        @see FIRFilter::Coefficients, FastFilter, Convolution, FFT
 
         @tags{DSP}
     */
@@ -284,4 +284,126 @@ namespace juce::dsp::FIR
         Array<NumericType> coefficients;
     };
 
+    //==============================================================================
+    /**
+        An FIR filter for multi-channel float signals which picks the most efficient way
+        of processing its coefficients.
+
+        Depending on the number of taps, the maximum block size and the number of
+        channels given to prepare(), the filter will use one of these methods:
+        - a direct-form kernel, which computes each output sample as a SIMD
+          dot-product of the coefficients with the most recent input samples
+        - an interleaved direct-form kernel, which processes several channels at once
+          in the lanes of a SIMDRegister, and is the fastest choice for short
+          filters on multi-channel signals
+        - uniformly partitioned FFT overlap-save convolution, which is much cheaper
+          than the direct form for filters that are longer than a few hundred taps
+
+        Unlike Convolution, the FFT method doesn't add any latency: each call to
+        process() produces the output for the samples it was given, so all three
+        methods behave identically apart from tiny rounding differences, and the
+        filter can switch between them without any change in latency.
+
+        It uses the same Coefficients as Filter, but a single instance can process
+        any number of channels, so there's no need for a ProcessorDuplicator.
+
+        @see Filter, Coefficients, Convolution
+
+        @tags{DSP}
+    */
+    class JUCE_API  FastFilter
+    {
+    public:
+        //==============================================================================
+        /** The method used to process the filter. */
+        enum class Method
+        {
+            automatic,              /**< Picks one of the other methods according to the filter and the ProcessSpec. */
+            directForm,             /**< Processes each channel in the time domain. */
+            interleavedDirectForm,  /**< Processes several channels at once in the time domain. */
+            overlapSave             /**< Processes the filter in the frequency domain using FFT overlap-save. */
+        };
+
+        //==============================================================================
+        /** This will create a filter which will produce silence. */
+        FastFilter();
+
+        /** Creates a filter with a given set of coefficients. */
+        explicit FastFilter (Coefficients<float>::Ptr coefficientsToUse, Method methodToUse = Method::automatic);
+
+        /** Destructor. */
+        ~FastFilter();
+
+        //==============================================================================
+        /** Changes the coefficients of the filter.
+
+            If the filter has already been prepared, this rebuilds its processing state,
+            which will allocate memory and reset the filter, so it shouldn't be called
+            on the audio thread.
+        */
+        void setCoefficients (Coefficients<float>::Ptr newCoefficients);
+
+        /** Returns the coefficients that the filter is using. */
+        Coefficients<float>::Ptr getCoefficients() const noexcept       { return coefficients; }
+
+        /** Changes the processing method.
+
+            Like setCoefficients(), this rebuilds the processing state if the filter
+            has already been prepared.
+        */
+        void setMethod (Method newMethod);
+
+        /** Returns the method that was requested with setMethod(). */
+        Method getMethod() const noexcept                               { return method; }
+
+        /** Returns the method that is actually being used after the last call to
+            prepare(). This will never be Method::automatic.
+        */
+        Method getActiveMethod() const noexcept                         { return activeMethod; }
+
+        /** Returns the method that Method::automatic would pick for a filter with the
+            given number of taps, processed with the given ProcessSpec.
+        */
+        static Method chooseMethod (size_t numTaps, const ProcessSpec& spec) noexcept;
+
+        //==============================================================================
+        /** Prepares the filter for processing. This will allocate memory. */
+        void prepare (const ProcessSpec& spec);
+
+        /** Resets the processing state, ready to start a new stream of data. */
+        void reset() noexcept;
+
+        /** Processes a block of samples.
+
+            The block must not contain more channels or samples than were specified in
+            the ProcessSpec given to prepare().
+        */
+        template <typename ProcessContext,
+                  std::enable_if_t<std::is_same_v<typename ProcessContext::SampleType, float>, int> = 0>
+        void process (const ProcessContext& context) noexcept
+        {
+            processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+        }
+
+    private:
+        //==============================================================================
+        class Engine;
+        class DirectFormEngine;
+        class InterleavedEngine;
+        class OverlapSaveEngine;
+
+        void processSamples (const AudioBlock<const float>&, AudioBlock<float>&, bool isBypassed) noexcept;
+        void rebuildEngine();
+
+        Coefficients<float>::Ptr coefficients;
+        Method method = Method::automatic, activeMethod = Method::directForm;
+        ProcessSpec spec { 0.0, 0, 0 };
+        std::unique_ptr<Engine> engine;
+        AudioBuffer<float> bypassBuffer;
+        std::vector<const float*> inputPointers;
+        std::vector<float*> outputPointers;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FastFilter)
+    };
+
 } // namespace juce::dsp::FIR
@@ -210,6 +210,72 @@ class FIRFilterTest final : public UnitTest
     }
 
 
+    //==============================================================================
+    void runFastFilterTest()
+    {
+        beginTest ("FastFilter");
+
+        Random random (8392829);
+
+        constexpr size_t n = 3000, maxBlockSize = 256;
+        constexpr FIR::FastFilter::Method methods[] { FIR::FastFilter::Method::directForm,
+                                                      FIR::FastFilter::Method::interleavedDirectForm,
+                                                      FIR::FastFilter::Method::overlapSave };
+
+        for (auto numTaps : { 1, 13, 100, 700 })
+        {
+            std::vector<float> taps ((size_t) numTaps);
+            fillRandom (random, taps.data(), taps.size());
+
+            for (auto numChannels : { 1, 3, 9 })
+            {
+                AudioBuffer<float> input (numChannels, (int) n), expected (numChannels, (int) n);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    fillRandom (random, input.getWritePointer (channel), n);
+                    reference<float, float> (taps.data(), taps.size(), input.getReadPointer (channel), expected.getWritePointer (channel), n);
+                }
+
+                for (auto method : methods)
+                {
+                    FIR::FastFilter filter (new FIR::Coefficients<float> (taps.data(), taps.size()), method);
+                    filter.prepare ({ 44100.0, (uint32) maxBlockSize, (uint32) numChannels });
+
+                    // process in place, with irregular block sizes
+                    auto output = input;
+
+                    for (size_t i = 0, blockSize = 0; i < n; i += blockSize)
+                    {
+                        blockSize = jmin (n - i, (size_t) random.nextInt ({ 1, (int) maxBlockSize + 1 }));
+
+                        AudioBlock<float> block (output);
+                        auto subBlock = block.getSubBlock (i, blockSize);
+                        filter.process (ProcessContextReplacing<float> (subBlock));
+                    }
+
+                    auto maxError = 0.0f;
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        for (int i = 0; i < (int) n; ++i)
+                            maxError = jmax (maxError, std::abs (output.getSample (channel, i) - expected.getSample (channel, i)));
+
+                    expectLessThan (maxError, 1.0e-4f);
+                }
+            }
+        }
+
+        {
+            const ProcessSpec spec { 44100.0, 512, 2 };
+            expect (FIR::FastFilter::chooseMethod (8,    spec) != FIR::FastFilter::Method::overlapSave);
+            expect (FIR::FastFilter::chooseMethod (4096, spec) == FIR::FastFilter::Method::overlapSave);
+
+            FIR::FastFilter filter (new FIR::Coefficients<float> (4096));
+            filter.prepare (spec);
+            expect (filter.getActiveMethod() == FIR::FastFilter::Method::overlapSave);
+        }
+    }
+
 public:
     FIRFilterTest()
         : UnitTest ("FIR Filter", UnitTestCategories::dsp)
@@ -220,6 +286,7 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+        runFastFilterTest();
     }
 };
 
@@ -154,4 +154,7 @@ private:
     SampleType cutoffFrequency = 1000.0;
 };
 
+template <typename SampleType>
+struct SupportsPerSampleProcessing<FirstOrderTPTFilter<SampleType>>  : std::true_type {};
+
 } // namespace juce::dsp
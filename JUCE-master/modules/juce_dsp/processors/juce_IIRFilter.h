@@ -156,7 +156,16 @@ namespace juce::dsp::IIR
         template <size_t Num>
         explicit Coefficients (const std::array<NumericType, Num>& values) { assignImpl<Num> (values.data()); }
 
-        /** Assigns contents from an array. */
+        /** Assigns contents from an array.
+
+            This doesn't allocate when the object already has room for the coefficients,
+            which is always true for up to 8 values in objects created by the functions in
+            this class. Together with ArrayCoefficients, this is a realtime-safe way to
+            update a filter in place, e.g.
+            @code
+            *filter.coefficients = IIR::ArrayCoefficients<float>::makeLowPass (sampleRate, cutoff);
+            @endcode
+        */
         template <size_t Num>
         Coefficients& operator= (const std::array<NumericType, Num>& values) { return assignImpl<Num> (values.data()); }
 
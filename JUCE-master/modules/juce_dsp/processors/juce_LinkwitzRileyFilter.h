@@ -146,4 +146,7 @@ private:
     Type filterType = Type::lowpass;
 };
 
+template <typename SampleType>
+struct SupportsPerSampleProcessing<LinkwitzRileyFilter<SampleType>>  : std::true_type {};
+
 } // namespace juce::dsp
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+MatrixMixer<SampleType>::MatrixMixer()
+    : matrix (Matrix<SampleType>::identity (1))
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void MatrixMixer<SampleType>::setSize (size_t numOutputs, size_t numInputs)
+{
+    matrix = Matrix<SampleType> (numOutputs, numInputs);
+
+    if (maximumBlockSize > 0)
+        scratch.setSize ((int) numOutputs, maximumBlockSize, false, false, true);
+}
+
+template <typename SampleType>
+void MatrixMixer<SampleType>::setMatrix (const Matrix<SampleType>& newMatrix)
+{
+    if (newMatrix.getNumRows() != getNumOutputs() || newMatrix.getNumColumns() != getNumInputs())
+        setSize (newMatrix.getNumRows(), newMatrix.getNumColumns());
+
+    std::copy (newMatrix.begin(), newMatrix.end(), matrix.begin());
+}
+
+//==============================================================================
+template <typename SampleType>
+void MatrixMixer<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.maximumBlockSize > 0);
+
+    maximumBlockSize = (int) spec.maximumBlockSize;
+    scratch.setSize ((int) getNumOutputs(), maximumBlockSize, false, false, true);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MatrixMixer<SampleType>::processBlock (const AudioBlock<const SampleType>& input,
+                                            AudioBlock<SampleType>& output,
+                                            bool separateInputAndOutput) noexcept
+{
+    const auto getInput  = [&input]  (size_t channel) { return input.getChannelPointer (channel); };
+    const auto getOutput = [&output] (size_t channel) { return output.getChannelPointer (channel); };
+
+    if (separateInputAndOutput)
+    {
+        detail::multiplyMatrixByRows (matrix.getRawDataPointer(), getNumOutputs(), getNumInputs(),
+                                      getInput, getOutput, output.getNumSamples());
+        return;
+    }
+
+    // When processing in place, the outputs can't be written until all the inputs have
+    // been used, so each part of the block is mixed into the scratch buffer first
+    jassert (input.getNumChannels() == output.getNumChannels());
+
+    // Make sure to call prepare() first!
+    jassert (maximumBlockSize > 0 && scratch.getNumChannels() == (int) getNumOutputs());
+
+    AudioBlock<SampleType> scratchBlock (scratch);
+    const auto chunkSize = jmin ((size_t) maximumBlockSize, scratchBlock.getNumSamples());
+
+    for (size_t start = 0; start < output.getNumSamples() && chunkSize > 0; start += chunkSize)
+    {
+        const auto num = jmin (chunkSize, output.getNumSamples() - start);
+
+        detail::multiplyMatrixByRows (matrix.getRawDataPointer(), getNumOutputs(), getNumInputs(),
+                                      [&] (size_t channel) { return getInput (channel) + start; },
+                                      [&] (size_t channel) { return scratchBlock.getChannelPointer (channel); },
+                                      num);
+
+        output.getSubBlock (start, num).copyFrom (scratchBlock.getSubBlock (0, num));
+    }
+}
+
+//==============================================================================
+template class MatrixMixer<float>;
+template class MatrixMixer<double>;
+
+} // namespace juce::dsp
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    Mixes a number of input channels into a number of output channels, with a gain for
+    each pair of input and output: each output channel is the sum of all the input
+    channels, multiplied by the gains in its row of a matrix.
+
+    This can be used for anything from simple routing and downmixing to ambisonic
+    decoding and beamforming. The mixing uses Matrix::multiply(), which is designed
+    to stay efficient for large numbers of channels.
+
+    The gains aren't smoothed, so if they change while audio is playing it's up to the
+    caller to avoid clicks, e.g. by changing them gradually.
+
+    @see Matrix, FixedSizeMatrix
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MatrixMixer
+{
+public:
+    //==============================================================================
+    /** Creates a mixer with one input and one output, with a gain of 1. */
+    MatrixMixer();
+
+    //==============================================================================
+    /** Sets the number of output and input channels, which are the number of rows and
+        columns of the matrix, and resets all the gains to 0.
+
+        This allocates memory, so shouldn't be called on the audio thread.
+    */
+    void setSize (size_t numOutputs, size_t numInputs);
+
+    /** Sets all the gains from a matrix with one row per output and one column per input.
+
+        If the size of the matrix is different from the current one, this allocates
+        memory, otherwise it is realtime safe.
+    */
+    void setMatrix (const Matrix<SampleType>& newMatrix);
+
+    /** Sets all the gains from a matrix with one row per output and one column per input.
+        @see setMatrix
+    */
+    template <size_t numOutputs, size_t numInputs>
+    void setMatrix (const FixedSizeMatrix<SampleType, numOutputs, numInputs>& newMatrix)
+    {
+        if (numOutputs != getNumOutputs() || numInputs != getNumInputs())
+            setSize (numOutputs, numInputs);
+
+        std::copy (newMatrix.getRawDataPointer(), newMatrix.getRawDataPointer() + numOutputs * numInputs,
+                   matrix.getRawDataPointer());
+    }
+
+    /** Sets the gain with which an input is added to an output. */
+    void setGain (size_t output, size_t input, SampleType gain) noexcept    { matrix (output, input) = gain; }
+
+    /** Returns the gain with which an input is added to an output. */
+    SampleType getGain (size_t output, size_t input) const noexcept         { return matrix (output, input); }
+
+    /** Returns the matrix of gains. */
+    const Matrix<SampleType>& getMatrix() const noexcept                     { return matrix; }
+
+    /** Returns the number of output channels, which is the number of rows of the matrix. */
+    size_t getNumOutputs() const noexcept                                    { return matrix.getNumRows(); }
+
+    /** Returns the number of input channels, which is the number of columns of the matrix. */
+    size_t getNumInputs() const noexcept                                     { return matrix.getNumColumns(); }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept {}
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context.
+
+        The input block must have getNumInputs() channels and the output block must have
+        getNumOutputs() channels. If the context processes in place, both numbers must be
+        the same.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels()  == getNumInputs());
+        jassert (outputBlock.getNumChannels() == getNumOutputs());
+        jassert (inputBlock.getNumSamples()   == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+            {
+                const auto numChannels = jmin (inputBlock.getNumChannels(), outputBlock.getNumChannels());
+
+                outputBlock.getSubsetChannelBlock (0, numChannels)
+                           .copyFrom (inputBlock.getSubsetChannelBlock (0, numChannels));
+                outputBlock.getSubsetChannelBlock (numChannels, outputBlock.getNumChannels() - numChannels).clear();
+            }
+
+            return;
+        }
+
+        processBlock (inputBlock, outputBlock, context.usesSeparateInputAndOutputBlocks());
+    }
+
+private:
+    //==============================================================================
+    void processBlock (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output,
+                       bool separateInputAndOutput) noexcept;
+
+    //==============================================================================
+    Matrix<SampleType> matrix;
+    AudioBuffer<SampleType> scratch;
+    int maximumBlockSize = 0;
+};
+
+} // namespace juce::dsp
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+#if JUCE_USE_SIMD
+
+//==============================================================================
+/*  Returns tan (x) for 0 <= x < pi / 2. Above pi / 4 this uses tan (x) = 1 / tan (pi / 2 - x),
+    which keeps the Pade approximation in the range where it's accurate to about 1e-13.
+*/
+template <typename SampleType>
+static SIMDRegister<SampleType> multiVoiceFilterPrewarp (SIMDRegister<SampleType> x) noexcept
+{
+    using VectorType = SIMDRegister<SampleType>;
+
+    const auto halfPi = VectorType::expand (MathConstants<SampleType>::halfPi);
+    const auto upper = VectorType::greaterThan (x, halfPi * static_cast<SampleType> (0.5));
+
+    const auto reduced = (x & ~upper) + ((halfPi - x) & upper);
+    const auto t = FastMathApproximations::tan (reduced);
+
+    return (t & ~upper) + ((VectorType::expand (1) / t) & upper);
+}
+
+//==============================================================================
+template <typename SampleType>
+MultiVoiceStateVariableTPTFilter<SampleType>::MultiVoiceStateVariableTPTFilter()
+{
+    setResonance (resonance);
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::setCutoffFrequency (SampleType newFrequencyHz) noexcept
+{
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (sampleRate * 0.5)));
+
+    cutoffFrequency = newFrequencyHz;
+
+    for (auto& group : groups)
+    {
+        group.cutoff = VectorType::expand (newFrequencyHz);
+        update (group);
+    }
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::setCutoffFrequency (size_t voice, SampleType newFrequencyHz) noexcept
+{
+    jassert (voice < numVoices);
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (sampleRate * 0.5)));
+
+    auto& group = groups[voice / numLanes];
+    group.cutoff[voice % numLanes] = newFrequencyHz;
+    update (group);
+}
+
+template <typename SampleType>
+SampleType MultiVoiceStateVariableTPTFilter<SampleType>::getCutoffFrequency (size_t voice) const noexcept
+{
+    jassert (voice < numVoices);
+    return groups[voice / numLanes].cutoff[voice % numLanes];
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::setResonance (SampleType newResonance) noexcept
+{
+    jassert (newResonance > static_cast<SampleType> (0));
+
+    resonance = newResonance;
+    R2 = static_cast<SampleType> (1.0 / resonance);
+
+    for (auto& group : groups)
+        update (group);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    numVoices = spec.numChannels;
+
+    groups.resize ((numVoices + numLanes - 1) / numLanes);
+    scratch.prepare (spec.maximumBlockSize);
+
+    for (auto& group : groups)
+    {
+        group.cutoff = VectorType::expand (cutoffFrequency);
+        update (group);
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::reset() noexcept
+{
+    for (auto& group : groups)
+    {
+        group.s1 = VectorType::expand (0);
+        group.s2 = VectorType::expand (0);
+    }
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::resetVoice (size_t voice) noexcept
+{
+    jassert (voice < numVoices);
+
+    auto& group = groups[voice / numLanes];
+    group.s1[voice % numLanes] = 0;
+    group.s2[voice % numLanes] = 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::processGroup (size_t groupIndex, const VectorType* input,
+                                                                 VectorType* output, size_t numSamples) noexcept
+{
+    jassert (groupIndex < groups.size());
+    auto& group = groups[groupIndex];
+
+    for (size_t i = 0; i < numSamples; ++i)
+        output[i] = tick (group, input[i], group.g, group.h);
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::processGroup (size_t groupIndex, const VectorType* input, VectorType* output,
+                                                                 const VectorType* cutoffFrequencies, size_t numSamples) noexcept
+{
+    jassert (groupIndex < groups.size());
+    auto& group = groups[groupIndex];
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        VectorType g, h;
+        calculateCoefficients (cutoffFrequencies[i], g, h);
+        output[i] = tick (group, input[i], g, h);
+    }
+}
+
+template <typename SampleType>
+typename MultiVoiceStateVariableTPTFilter<SampleType>::VectorType
+    MultiVoiceStateVariableTPTFilter<SampleType>::processSample (size_t groupIndex, VectorType input) noexcept
+{
+    jassert (groupIndex < groups.size());
+    auto& group = groups[groupIndex];
+
+    return tick (group, input, group.g, group.h);
+}
+
+template <typename SampleType>
+typename MultiVoiceStateVariableTPTFilter<SampleType>::VectorType
+    MultiVoiceStateVariableTPTFilter<SampleType>::processSample (size_t groupIndex, VectorType input, VectorType cutoffFrequencies) noexcept
+{
+    jassert (groupIndex < groups.size());
+
+    VectorType g, h;
+    calculateCoefficients (cutoffFrequencies, g, h);
+    return tick (groups[groupIndex], input, g, h);
+}
+
+//==============================================================================
+template <typename SampleType>
+typename MultiVoiceStateVariableTPTFilter<SampleType>::VectorType
+    MultiVoiceStateVariableTPTFilter<SampleType>::tick (Group& group, VectorType input, VectorType g, VectorType h) const noexcept
+{
+    auto yHP = h * (input - group.s1 * (g + R2) - group.s2);
+
+    auto yBP = yHP * g + group.s1;
+    group.s1 = yHP * g + yBP;
+
+    auto yLP = yBP * g + group.s2;
+    group.s2 = yBP * g + yLP;
+
+    switch (filterType)
+    {
+        case Type::lowpass:   return yLP;
+        case Type::bandpass:  return yBP;
+        case Type::highpass:  return yHP;
+        default:              return yLP;
+    }
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::calculateCoefficients (VectorType cutoff, VectorType& g, VectorType& h) const noexcept
+{
+    const auto maxCutoff = VectorType::expand (static_cast<SampleType> (sampleRate * 0.49));
+    const auto clamped = VectorType::min (VectorType::max (cutoff, VectorType::expand (0)), maxCutoff);
+
+    g = multiVoiceFilterPrewarp (clamped * static_cast<SampleType> (MathConstants<double>::pi / sampleRate));
+    h = VectorType::expand (1) / (g * (g + R2) + static_cast<SampleType> (1));
+}
+
+template <typename SampleType>
+void MultiVoiceStateVariableTPTFilter<SampleType>::update (Group& group) noexcept
+{
+    calculateCoefficients (group.cutoff, group.g, group.h);
+}
+
+//==============================================================================
+template class MultiVoiceStateVariableTPTFilter<float>;
+template class MultiVoiceStateVariableTPTFilter<double>;
+
+#endif
+
+} // namespace juce::dsp
@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+#if JUCE_USE_SIMD
+
+namespace detail
+{
+    /*  Scratch space used by the multi-voice filters to move voices from the channels
+        of an AudioBlock into the lanes of SIMDRegisters and back again.
+
+        The voices are handled in groups of SIMDRegister::size(). Each group is
+        interleaved into a buffer of SIMDRegisters, optionally together with a
+        per-sample cutoff buffer, passed to the filter's group function, and then
+        de-interleaved into the output block. Unused lanes are filled with zeros.
+    */
+    template <typename SampleType>
+    struct MultiVoiceScratch
+    {
+        using VectorType = SIMDRegister<SampleType>;
+        static constexpr size_t numLanes = VectorType::SIMDNumElements;
+
+        void prepare (size_t maximumBlockSize)
+        {
+            block = AudioBlock<VectorType> (data, 2, maximumBlockSize);
+        }
+
+        template <typename ProcessContext, typename GroupFunction>
+        void process (const ProcessContext& context,
+                      const AudioBlock<const SampleType>* cutoffs,
+                      size_t numVoices,
+                      GroupFunction&& processGroup) noexcept
+        {
+            const auto& inputBlock = context.getInputBlock();
+            auto& outputBlock      = context.getOutputBlock();
+            const auto numChannels = outputBlock.getNumChannels();
+            const auto numSamples  = outputBlock.getNumSamples();
+
+            jassert (inputBlock.getNumChannels() <= numVoices);
+            jassert (inputBlock.getNumChannels() == numChannels);
+            jassert (inputBlock.getNumSamples()  == numSamples);
+            jassert (numSamples <= block.getNumSamples());
+            jassert (cutoffs == nullptr || (cutoffs->getNumChannels() >= numChannels
+                                             && cutoffs->getNumSamples() >= numSamples));
+            ignoreUnused (numVoices);
+
+            auto* audio  = block.getChannelPointer (0);
+            auto* cutoff = block.getChannelPointer (1);
+
+            for (size_t firstVoice = 0, group = 0; firstVoice < numChannels; firstVoice += numLanes, ++group)
+            {
+                const auto numVoicesInGroup = jmin (numLanes, numChannels - firstVoice);
+
+                if (numVoicesInGroup < numLanes)
+                    block.getSubBlock (0, numSamples).clear();
+
+                interleave (audio, inputBlock, firstVoice, numVoicesInGroup, numSamples);
+
+                if (cutoffs != nullptr)
+                    interleave (cutoff, *cutoffs, firstVoice, numVoicesInGroup, numSamples);
+
+                processGroup (group, audio, cutoffs != nullptr ? cutoff : nullptr, numSamples);
+
+                for (size_t lane = 0; lane < numVoicesInGroup; ++lane)
+                {
+                    auto* dst = outputBlock.getChannelPointer (firstVoice + lane);
+                    auto* src = reinterpret_cast<const SampleType*> (audio) + lane;
+
+                    for (size_t i = 0; i < numSamples; ++i)
+                        dst[i] = src[i * numLanes];
+                }
+            }
+        }
+
+        template <typename BlockType>
+        static void interleave (VectorType* dest, const BlockType& source,
+                                size_t firstVoice, size_t numVoicesInGroup, size_t numSamples) noexcept
+        {
+            for (size_t lane = 0; lane < numVoicesInGroup; ++lane)
+            {
+                auto* src = source.getChannelPointer (firstVoice + lane);
+                auto* dst = reinterpret_cast<SampleType*> (dest) + lane;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    dst[i * numLanes] = src[i];
+            }
+        }
+
+    private:
+        HeapBlock<char> data;
+        AudioBlock<VectorType> block;
+    };
+} // namespace detail
+
+//==============================================================================
+/**
+    A version of StateVariableTPTFilter that runs many independent voices, such as
+    the voices of a polyphonic synthesiser, with one voice in each lane of a
+    SIMDRegister.
+
+    Each voice has its own cutoff frequency and state, while the filter type and
+    resonance are shared. The cutoff can either be set per voice with
+    setCutoffFrequency(), or modulated at audio rate by passing a block of cutoff
+    frequencies to process(), in which case the coefficients are recalculated for
+    every sample, with a vectorised approximation of the tan prewarping.
+
+    The voices are the channels of the blocks passed to process(). Code which keeps
+    its voices interleaved in SIMDRegisters already can call processGroup() or
+    processSample() directly, where group n holds voices n * numLanes onwards.
+
+    see StateVariableTPTFilter, MultiVoiceLadderFilter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultiVoiceStateVariableTPTFilter
+{
+public:
+    //==============================================================================
+    using Type = StateVariableTPTFilterType;
+    using VectorType = SIMDRegister<SampleType>;
+
+    /** The number of voices processed together in each SIMDRegister. */
+    static constexpr size_t numLanes = VectorType::SIMDNumElements;
+
+    //==============================================================================
+    /** Constructor. */
+    MultiVoiceStateVariableTPTFilter();
+
+    //==============================================================================
+    /** Sets the filter type of all the voices. */
+    void setType (Type newType) noexcept               { filterType = newType; }
+
+    /** Sets the cutoff frequency of all the voices.
+
+        @param newFrequencyHz the new cutoff frequency in Hz.
+    */
+    void setCutoffFrequency (SampleType newFrequencyHz) noexcept;
+
+    /** Sets the cutoff frequency of one voice.
+
+        @param voice          the index of the voice, which is the channel in process()
+        @param newFrequencyHz the new cutoff frequency in Hz.
+    */
+    void setCutoffFrequency (size_t voice, SampleType newFrequencyHz) noexcept;
+
+    /** Sets the resonance of all the voices.
+
+        @see StateVariableTPTFilter::setResonance
+    */
+    void setResonance (SampleType newResonance) noexcept;
+
+    //==============================================================================
+    /** Returns the type of the filter. */
+    Type getType() const noexcept                      { return filterType; }
+
+    /** Returns the cutoff frequency of a voice. */
+    SampleType getCutoffFrequency (size_t voice) const noexcept;
+
+    /** Returns the resonance of the filter. */
+    SampleType getResonance() const noexcept           { return resonance; }
+
+    /** Returns the number of voices that the filter was prepared for. */
+    size_t getNumVoices() const noexcept               { return numVoices; }
+
+    /** Returns the number of SIMDRegister groups that hold the voices. */
+    size_t getNumGroups() const noexcept               { return groups.size(); }
+
+    //==============================================================================
+    /** Initialises the filter, with one voice for each channel of the spec. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the state of all the voices. */
+    void reset() noexcept;
+
+    /** Resets the state of a single voice, e.g. when it starts a new note. */
+    void resetVoice (size_t voice) noexcept;
+
+    //==============================================================================
+    /** Processes the voices in the channels of the context, using the cutoff
+        frequency of each voice.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        processBlock (context, nullptr);
+    }
+
+    /** Processes the voices in the channels of the context, using a cutoff frequency
+        in Hz for every sample, taken from the same channel of cutoffFrequencies.
+
+        The frequencies are clamped to the range 0 to 0.49 times the sample rate.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<const SampleType>& cutoffFrequencies) noexcept
+    {
+        processBlock (context, &cutoffFrequencies);
+    }
+
+    //==============================================================================
+    /** Processes a block of interleaved samples for one group of voices, using the
+        cutoff frequency of each voice. The input and output may be the same.
+    */
+    void processGroup (size_t group, const VectorType* input, VectorType* output, size_t numSamples) noexcept;
+
+    /** Processes a block of interleaved samples for one group of voices, with a
+        cutoff frequency in Hz for every sample. The input and output may be the same.
+    */
+    void processGroup (size_t group, const VectorType* input, VectorType* output,
+                       const VectorType* cutoffFrequencies, size_t numSamples) noexcept;
+
+    /** Processes one sample for a group of voices, using the cutoff frequency of
+        each voice.
+    */
+    VectorType processSample (size_t group, VectorType input) noexcept;
+
+    /** Processes one sample for a group of voices, with the given cutoff frequencies
+        in Hz.
+    */
+    VectorType processSample (size_t group, VectorType input, VectorType cutoffFrequencies) noexcept;
+
+private:
+    //==============================================================================
+    struct Group
+    {
+        VectorType s1, s2, cutoff, g, h;
+    };
+
+    template <typename ProcessContext>
+    void processBlock (const ProcessContext& context, const AudioBlock<const SampleType>* cutoffs) noexcept
+    {
+        if (context.isBypassed)
+        {
+            context.getOutputBlock().copyFrom (context.getInputBlock());
+            return;
+        }
+
+        scratch.process (context, cutoffs, numVoices, [this] (size_t group, VectorType* data, const VectorType* cutoff, size_t numSamples)
+        {
+            if (cutoff != nullptr)
+                processGroup (group, data, data, cutoff, numSamples);
+            else
+                processGroup (group, data, data, numSamples);
+        });
+    }
+
+    VectorType tick (Group&, VectorType input, VectorType g, VectorType h) const noexcept;
+    void calculateCoefficients (VectorType cutoff, VectorType& g, VectorType& h) const noexcept;
+    void update (Group&) noexcept;
+
+    //==============================================================================
+    std::vector<Group> groups;
+    detail::MultiVoiceScratch<SampleType> scratch;
+    size_t numVoices = 0;
+
+    double sampleRate = 44100.0;
+    Type filterType = Type::lowpass;
+    SampleType cutoffFrequency = static_cast<SampleType> (1000.0),
+               resonance       = static_cast<SampleType> (1.0 / std::sqrt (2.0)),
+               R2              = static_cast<SampleType> (std::sqrt (2.0));
+};
+
+#endif
+
+} // namespace juce::dsp
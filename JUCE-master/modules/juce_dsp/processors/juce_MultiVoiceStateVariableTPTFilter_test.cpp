@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class MultiVoiceStateVariableTPTFilterTest final : public UnitTest
+{
+public:
+    MultiVoiceStateVariableTPTFilterTest()
+        : UnitTest ("MultiVoiceStateVariableTPTFilter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float",  1.0e-4f);
+        runTestsForType<double> ("double", 1.0e-9);
+    }
+
+private:
+    static constexpr uint32 numVoices = 11, maxBlockSize = 128;
+
+    template <typename SampleType>
+    void runTestsForType (const String& typeName, SampleType tolerance)
+    {
+        using Type = StateVariableTPTFilterType;
+        const ProcessSpec spec { 48000.0, maxBlockSize, numVoices };
+        auto random = getRandom();
+
+        for (auto type : { Type::lowpass, Type::bandpass, Type::highpass })
+        {
+            beginTest ("Fixed cutoffs match StateVariableTPTFilter (" + typeName + ")");
+            {
+                MultiVoiceStateVariableTPTFilter<SampleType> multiVoice;
+                multiVoice.setType (type);
+                multiVoice.setResonance (SampleType (2));
+                multiVoice.prepare (spec);
+
+                std::vector<StateVariableTPTFilter<SampleType>> voices (numVoices);
+
+                for (size_t v = 0; v < numVoices; ++v)
+                {
+                    const auto cutoff = SampleType (20.0 * std::pow (1000.0, random.nextDouble()));
+
+                    multiVoice.setCutoffFrequency (v, cutoff);
+                    prepareReference (voices[v], spec, type, cutoff);
+                    voices[v].setResonance (SampleType (2));
+                }
+
+                AudioBuffer<SampleType> input ((int) numVoices, (int) maxBlockSize), output (input);
+                fillWithNoise (input, random);
+
+                auto inputBlock = AudioBlock<SampleType> (input);
+                auto outputBlock = AudioBlock<SampleType> (output);
+                multiVoice.process (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock));
+
+                auto maxError = SampleType (0);
+
+                for (size_t v = 0; v < numVoices; ++v)
+                    for (size_t i = 0; i < maxBlockSize; ++i)
+                        maxError = jmax (maxError, std::abs (voices[v].processSample (0, inputBlock.getSample ((int) v, (int) i))
+                                                               - outputBlock.getSample ((int) v, (int) i)));
+
+                expectLessThan (maxError, tolerance);
+            }
+
+            beginTest ("Audio-rate cutoffs match StateVariableTPTFilter (" + typeName + ")");
+            {
+                MultiVoiceStateVariableTPTFilter<SampleType> multiVoice;
+                multiVoice.setType (type);
+                multiVoice.prepare (spec);
+
+                std::vector<StateVariableTPTFilter<SampleType>> voices (numVoices);
+
+                for (auto& voice : voices)
+                    prepareReference (voice, spec, type, SampleType (1000));
+
+                AudioBuffer<SampleType> input ((int) numVoices, (int) maxBlockSize), output (input), cutoffs (input);
+                fillWithNoise (input, random);
+
+                for (int v = 0; v < cutoffs.getNumChannels(); ++v)
+                    for (int i = 0; i < cutoffs.getNumSamples(); ++i)
+                        cutoffs.setSample (v, i, SampleType (2000.0 + 1800.0 * std::sin (0.01 * (i + 1) * (v + 1))));
+
+                auto inputBlock = AudioBlock<SampleType> (input);
+                auto outputBlock = AudioBlock<SampleType> (output);
+                multiVoice.process (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock),
+                                    AudioBlock<const SampleType> (cutoffs));
+
+                auto maxError = SampleType (0);
+
+                for (size_t v = 0; v < numVoices; ++v)
+                {
+                    for (size_t i = 0; i < maxBlockSize; ++i)
+                    {
+                        voices[v].setCutoffFrequency (cutoffs.getSample ((int) v, (int) i));
+
+                        maxError = jmax (maxError, std::abs (voices[v].processSample (0, inputBlock.getSample ((int) v, (int) i))
+                                                               - outputBlock.getSample ((int) v, (int) i)));
+                    }
+                }
+
+                expectLessThan (maxError, tolerance);
+            }
+        }
+
+        beginTest ("Resetting a voice doesn't affect the others (" + typeName + ")");
+        {
+            MultiVoiceStateVariableTPTFilter<SampleType> multiVoice;
+            multiVoice.prepare (spec);
+
+            AudioBuffer<SampleType> input ((int) numVoices, (int) maxBlockSize), output (input);
+            input.clear();
+
+            for (int v = 0; v < input.getNumChannels(); ++v)
+                input.setSample (v, 0, SampleType (1));
+
+            auto inputBlock = AudioBlock<SampleType> (input);
+            auto outputBlock = AudioBlock<SampleType> (output);
+            auto firstOutputSample = outputBlock.getSubBlock (0, 1);
+            multiVoice.process (ProcessContextNonReplacing<SampleType> (inputBlock.getSubBlock (0, 1), firstOutputSample));
+
+            multiVoice.resetVoice (3);
+            input.clear();
+            multiVoice.process (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock));
+
+            for (int v = 0; v < output.getNumChannels(); ++v)
+            {
+                const auto energy = output.getMagnitude (v, 0, output.getNumSamples());
+
+                if (v == 3)
+                    expectEquals (energy, SampleType (0));
+                else
+                    expectGreaterThan (energy, SampleType (0));
+            }
+        }
+    }
+
+    template <typename SampleType>
+    static void prepareReference (StateVariableTPTFilter<SampleType>& filter, const ProcessSpec& spec,
+                                  StateVariableTPTFilterType type, SampleType cutoff)
+    {
+        filter.prepare ({ spec.sampleRate, spec.maximumBlockSize, 1 });
+        filter.setType (type);
+        filter.setCutoffFrequency (cutoff);
+    }
+
+    template <typename SampleType>
+    static void fillWithNoise (AudioBuffer<SampleType>& buffer, Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, static_cast<SampleType> (2.0f * random.nextFloat() - 1.0f));
+    }
+};
+
+static MultiVoiceStateVariableTPTFilterTest multiVoiceStateVariableTPTFilterTest;
+
+} // namespace juce::dsp
@@ -72,6 +72,97 @@ struct Oversampling<SampleType>::OversamplingStage
 };
 
 
+//==============================================================================
+/** Aligned storage for the filter states of the oversampling stages, which can
+    hold either samples or SIMDRegisters.
+*/
+template <typename Value>
+struct OversamplingStateBuffer
+{
+    void allocate (size_t newSize)
+    {
+        size = newSize;
+        storage.malloc (size * sizeof (Value) + alignof (Value));
+        data = unalignedPointerCast<Value*> (snapPointerToAlignment (storage.getData(), alignof (Value)));
+        clear();
+    }
+
+    void clear() noexcept
+    {
+        std::fill (data, data + size, Value());
+    }
+
+    Value* get (size_t offset) const noexcept
+    {
+        jassert (offset < size);
+        return data + offset;
+    }
+
+    HeapBlock<char> storage;
+    Value* data = nullptr;
+    size_t size = 0;
+};
+
+#if JUCE_USE_SIMD
+//==============================================================================
+/** Helper for the oversampling stages which filter groups of channels at once,
+    with one channel in each lane of a SIMDRegister.
+*/
+template <typename SampleType>
+struct OversamplingChannelGroups
+{
+    using Lanes = SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Lanes::SIMDNumElements;
+
+    /** Returns the number of groups needed for a number of channels, or zero
+        when there's a single channel, which is better processed without SIMD.
+    */
+    static size_t getNumGroups (size_t numChannels) noexcept
+    {
+        return numChannels > 1 ? (numChannels + numLanes - 1) / numLanes : 0;
+    }
+
+    /** Fills the channel pointers of a group, and returns how many of the lanes
+        are actually used.
+    */
+    template <typename BlockType, typename PointerType>
+    static size_t getChannels (const BlockType& block, size_t group, PointerType* channels) noexcept
+    {
+        const auto firstChannel = group * numLanes;
+
+        if (firstChannel >= block.getNumChannels())
+            return 0;
+
+        const auto numChannelsInGroup = jmin (numLanes, block.getNumChannels() - firstChannel);
+
+        for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            channels[lane] = block.getChannelPointer (firstChannel + lane);
+
+        return numChannelsInGroup;
+    }
+
+    static Lanes load (const SampleType* const* channels, size_t numChannelsInGroup, size_t index) noexcept
+    {
+        alignas (sizeof (Lanes)) SampleType lanes[numLanes] = {};
+
+        for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            lanes[lane] = channels[lane][index];
+
+        return Lanes::fromRawArray (lanes);
+    }
+
+    static void store (Lanes value, SampleType* const* channels, size_t numChannelsInGroup, size_t index) noexcept
+    {
+        alignas (sizeof (Lanes)) SampleType lanes[numLanes];
+        value.copyToRawArray (lanes);
+
+        for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            channels[lane][index] = lanes[lane];
+    }
+};
+#endif
+
+
 //==============================================================================
 /** Dummy oversampling stage class which simply copies and pastes the input
     signal, which could be equivalent to a "one time" oversampling processing.
@@ -142,6 +233,27 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
 
         position.resize (static_cast<int> (this->numChannels));
+
+       #if JUCE_USE_SIMD
+        numGroups = Groups::getNumGroups (this->numChannels);
+
+        if (numGroups > 0)
+        {
+            // Only the even taps, and so every other sample of the states, are used. The
+            // histories are twice as long as needed, so that the samples can be written
+            // twice instead of being shifted for each new sample
+            historySizeUp   = 2 * ((coefficientsUp.getFilterOrder() / 2) + 1);
+            historySizeDown = 2 * ((coefficientsDown.getFilterOrder() / 2) + 1);
+
+            historyUp.allocate   (numGroups * historySizeUp);
+            historyDown.allocate (numGroups * historySizeDown);
+            delayDown.allocate   (numGroups * (Ndiv4 + 1));
+
+            positionsUp.resize    (static_cast<int> (numGroups));
+            positionsDown.resize  (static_cast<int> (numGroups));
+            positionsDelay.resize (static_cast<int> (numGroups));
+        }
+       #endif
     }
 
     //==============================================================================
@@ -159,6 +271,19 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         stateDown2.clear();
 
         position.fill (0);
+
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            historyUp.clear();
+            historyDown.clear();
+            delayDown.clear();
+
+            positionsUp.fill (0);
+            positionsDown.fill (0);
+            positionsDelay.fill (0);
+        }
+       #endif
     }
 
     void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
@@ -166,6 +291,14 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
         jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            processSamplesUpGroups (inputBlock);
+            return;
+        }
+       #endif
+
         // Initialization
         auto fir = coefficientsUp.getRawCoefficients();
         auto N = coefficientsUp.getFilterOrder() + 1;
@@ -206,6 +339,14 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
         jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            processSamplesDownGroups (outputBlock);
+            return;
+        }
+       #endif
+
         // Initialization
         auto fir = coefficientsDown.getRawCoefficients();
         auto N = coefficientsDown.getFilterOrder() + 1;
@@ -253,11 +394,128 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
     }
 
 private:
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Lanes = typename Groups::Lanes;
+
+    /*  These do the same processing as the scalar versions, with one channel in each
+        lane. The sample at index k of the scalar states is found at index k / 2 of
+        the windows of the histories, which start with the newest samples.
+    */
+    void processSamplesUpGroups (const AudioBlock<const SampleType>& inputBlock) noexcept
+    {
+        auto fir = coefficientsUp.getRawCoefficients();
+        auto N = coefficientsUp.getFilterOrder() + 1;
+        auto Ndiv2 = N / 2;
+        auto M = historySizeUp / 2;
+        auto numSamples = inputBlock.getNumSamples();
+        auto outputs = AudioBlock<SampleType> (ParentType::buffer);
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            const SampleType* input[Groups::numLanes];
+            SampleType* output[Groups::numLanes];
+            auto numChannelsInGroup = Groups::getChannels (inputBlock, group, input);
+
+            if (numChannelsInGroup == 0)
+                break;
+
+            Groups::getChannels (outputs, group, output);
+
+            auto* history = historyUp.get (group * historySizeUp);
+            auto pos = positionsUp.getUnchecked (static_cast<int> (group));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // Input
+                pos = (pos == 0 ? M : pos) - 1;
+                history[pos] = history[pos + M] = Groups::load (input, numChannelsInGroup, i) * static_cast<SampleType> (2);
+
+                auto* window = history + pos;
+
+                // Convolution
+                auto out = Lanes::expand (0);
+
+                for (size_t k = 0; k < Ndiv2; k += 2)
+                    out += (window[M - 1 - k / 2] + window[k / 2]) * fir[k];
+
+                // Outputs
+                Groups::store (out, output, numChannelsInGroup, i << 1);
+                Groups::store (window[M - 1 - (Ndiv2 + 1) / 2] * fir[Ndiv2], output, numChannelsInGroup, (i << 1) + 1);
+            }
+
+            positionsUp.setUnchecked (static_cast<int> (group), pos);
+        }
+    }
+
+    void processSamplesDownGroups (AudioBlock<SampleType>& outputBlock) noexcept
+    {
+        auto fir = coefficientsDown.getRawCoefficients();
+        auto N = coefficientsDown.getFilterOrder() + 1;
+        auto Ndiv2 = N / 2;
+        auto Ndiv4 = Ndiv2 / 2;
+        auto M = historySizeDown / 2;
+        auto numSamples = outputBlock.getNumSamples();
+        auto inputs = AudioBlock<SampleType> (ParentType::buffer);
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            SampleType* input[Groups::numLanes];
+            SampleType* output[Groups::numLanes];
+            auto numChannelsInGroup = Groups::getChannels (outputBlock, group, output);
+
+            if (numChannelsInGroup == 0)
+                break;
+
+            Groups::getChannels (inputs, group, input);
+
+            auto* history = historyDown.get (group * historySizeDown);
+            auto* delay = delayDown.get (group * (Ndiv4 + 1));
+            auto pos = positionsDown.getUnchecked (static_cast<int> (group));
+            auto delayPos = positionsDelay.getUnchecked (static_cast<int> (group));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // Input
+                pos = (pos == 0 ? M : pos) - 1;
+                history[pos] = history[pos + M] = Groups::load (input, numChannelsInGroup, i << 1);
+
+                auto* window = history + pos;
+
+                // Convolution
+                auto out = Lanes::expand (0);
+
+                for (size_t k = 0; k < Ndiv2; k += 2)
+                    out += (window[M - 1 - k / 2] + window[k / 2]) * fir[k];
+
+                // Output
+                out += delay[delayPos] * fir[Ndiv2];
+                delay[delayPos] = Groups::load (input, numChannelsInGroup, (i << 1) + 1);
+
+                Groups::store (out, output, numChannelsInGroup, i);
+
+                // Circular buffer
+                delayPos = (delayPos == 0 ? Ndiv4 : delayPos - 1);
+            }
+
+            positionsDown.setUnchecked  (static_cast<int> (group), pos);
+            positionsDelay.setUnchecked (static_cast<int> (group), delayPos);
+        }
+    }
+   #endif
+
     //==============================================================================
     FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
     AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
     Array<size_t> position;
 
+   #if JUCE_USE_SIMD
+    size_t numGroups = 0, historySizeUp = 0, historySizeDown = 0;
+    OversamplingStateBuffer<Lanes> historyUp, historyDown, delayDown;
+    Array<size_t> positionsUp, positionsDown, positionsDelay;
+   #endif
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
 };
@@ -303,6 +561,17 @@ struct Oversampling2TimesPolyphaseIIR final : public Oversampling<SampleType>::O
         v1Up.setSize   (static_cast<int> (this->numChannels), coefficientsUp.size());
         v1Down.setSize (static_cast<int> (this->numChannels), coefficientsDown.size());
         delayDown.resize (static_cast<int> (this->numChannels));
+
+       #if JUCE_USE_SIMD
+        numGroups = Groups::getNumGroups (this->numChannels);
+
+        if (numGroups > 0)
+        {
+            v1UpGroups.allocate   (numGroups * static_cast<size_t> (coefficientsUp.size()));
+            v1DownGroups.allocate (numGroups * static_cast<size_t> (coefficientsDown.size()));
+            delayDownGroups.allocate (numGroups);
+        }
+       #endif
     }
 
     //==============================================================================
@@ -317,6 +586,15 @@ struct Oversampling2TimesPolyphaseIIR final : public Oversampling<SampleType>::O
         v1Up.clear();
         v1Down.clear();
         delayDown.fill (0);
+
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            v1UpGroups.clear();
+            v1DownGroups.clear();
+            delayDownGroups.clear();
+        }
+       #endif
     }
 
     void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
@@ -324,6 +602,14 @@ struct Oversampling2TimesPolyphaseIIR final : public Oversampling<SampleType>::O
         jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
         jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            processSamplesUpGroups (inputBlock);
+            return;
+        }
+       #endif
+
         // Initialization
         auto coeffs = coefficientsUp.getRawDataPointer();
         auto numStages = coefficientsUp.size();
@@ -380,6 +666,14 @@ struct Oversampling2TimesPolyphaseIIR final : public Oversampling<SampleType>::O
         jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
         jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            processSamplesDownGroups (outputBlock);
+            return;
+        }
+       #endif
+
         // Initialization
         auto coeffs = coefficientsDown.getRawDataPointer();
         auto numStages = coefficientsDown.size();
@@ -461,6 +755,106 @@ struct Oversampling2TimesPolyphaseIIR final : public Oversampling<SampleType>::O
     }
 
 private:
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Lanes = typename Groups::Lanes;
+
+    /*  These do the same processing as the scalar versions, with one channel in each
+        lane. The states can't be snapped to zero here, so denormals have to be
+        avoided with a ScopedNoDenormals around the processing.
+    */
+    static void processAllpassCascade (const SampleType* coeffs, Lanes* lv1, int firstStage, int lastStage, Lanes& input) noexcept
+    {
+        for (auto n = firstStage; n < lastStage; ++n)
+        {
+            auto alpha = coeffs[n];
+            auto output = input * alpha + lv1[n];
+            lv1[n] = input - output * alpha;
+            input = output;
+        }
+    }
+
+    void processSamplesUpGroups (const AudioBlock<const SampleType>& inputBlock) noexcept
+    {
+        auto coeffs = coefficientsUp.getRawDataPointer();
+        auto numStages = coefficientsUp.size();
+        auto delayedStages = numStages / 2;
+        auto directStages = numStages - delayedStages;
+        auto numSamples = inputBlock.getNumSamples();
+        auto outputs = AudioBlock<SampleType> (ParentType::buffer);
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            const SampleType* input[Groups::numLanes];
+            SampleType* output[Groups::numLanes];
+            auto numChannelsInGroup = Groups::getChannels (inputBlock, group, input);
+
+            if (numChannelsInGroup == 0)
+                break;
+
+            Groups::getChannels (outputs, group, output);
+            auto* lv1 = v1UpGroups.get (group * static_cast<size_t> (numStages));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto samples = Groups::load (input, numChannelsInGroup, i);
+
+                // Direct path cascaded allpass filters
+                auto directOut = samples;
+                processAllpassCascade (coeffs, lv1, 0, directStages, directOut);
+                Groups::store (directOut, output, numChannelsInGroup, i << 1);
+
+                // Delayed path cascaded allpass filters
+                auto delayedOut = samples;
+                processAllpassCascade (coeffs, lv1, directStages, numStages, delayedOut);
+                Groups::store (delayedOut, output, numChannelsInGroup, (i << 1) + 1);
+            }
+        }
+    }
+
+    void processSamplesDownGroups (AudioBlock<SampleType>& outputBlock) noexcept
+    {
+        auto coeffs = coefficientsDown.getRawDataPointer();
+        auto numStages = coefficientsDown.size();
+        auto delayedStages = numStages / 2;
+        auto directStages = numStages - delayedStages;
+        auto numSamples = outputBlock.getNumSamples();
+        auto inputs = AudioBlock<SampleType> (ParentType::buffer);
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            SampleType* input[Groups::numLanes];
+            SampleType* output[Groups::numLanes];
+            auto numChannelsInGroup = Groups::getChannels (outputBlock, group, output);
+
+            if (numChannelsInGroup == 0)
+                break;
+
+            Groups::getChannels (inputs, group, input);
+            auto* lv1 = v1DownGroups.get (group * static_cast<size_t> (numStages));
+            auto delay = *delayDownGroups.get (group);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // Direct path cascaded allpass filters
+                auto directOut = Groups::load (input, numChannelsInGroup, i << 1);
+                processAllpassCascade (coeffs, lv1, 0, directStages, directOut);
+
+                // Delayed path cascaded allpass filters
+                auto delayedOut = Groups::load (input, numChannelsInGroup, (i << 1) + 1);
+                processAllpassCascade (coeffs, lv1, directStages, numStages, delayedOut);
+
+                // Output
+                Groups::store ((delay + directOut) * static_cast<SampleType> (0.5), output, numChannelsInGroup, i);
+                delay = delayedOut;
+            }
+
+            *delayDownGroups.get (group) = delay;
+        }
+    }
+   #endif
+
     //==============================================================================
     /** This function calculates the equivalent high order IIR filter of a given
         polyphase cascaded allpass filters structure.
@@ -530,11 +924,351 @@ private:
     AudioBuffer<SampleType> v1Up, v1Down;
     Array<SampleType> delayDown;
 
+   #if JUCE_USE_SIMD
+    size_t numGroups = 0;
+    OversamplingStateBuffer<Lanes> v1UpGroups, v1DownGroups, delayDownGroups;
+   #endif
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseIIR)
 };
 
 
+//==============================================================================
+/** Oversampling stage class performing 2 times oversampling with the minimum
+    phase version of the Filter Design FIR Equiripple half-band filters. The
+    magnitude response is the same, but most of the latency of the linear phase
+    filters is removed, at the cost of some phase distortion close to Nyquist.
+    Since the filters aren't half-band anymore, both of their polyphase
+    components are used in the processing.
+*/
+template <typename SampleType>
+struct Oversampling2TimesMinimumPhaseFIR final : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+
+    Oversampling2TimesMinimumPhaseFIR (size_t numChans,
+                                       SampleType normalisedTransitionWidthUp,
+                                       SampleType stopbandAmplitudedBUp,
+                                       SampleType normalisedTransitionWidthDown,
+                                       SampleType stopbandAmplitudedBDown)
+        : ParentType (numChans, 2)
+    {
+        auto impulseUp   = getMinimumPhaseImpulseResponse (*FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp));
+        auto impulseDown = getMinimumPhaseImpulseResponse (*FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+
+        latency = getGroupDelayAtDC (impulseUp) + getGroupDelayAtDC (impulseDown);
+
+        // The upsampling needs a gain of 2 to compensate for the inserted zeros
+        splitIntoPhases (impulseUp, static_cast<SampleType> (2), evenUp, oddUp);
+        splitIntoPhases (impulseDown, static_cast<SampleType> (1), evenDown, oddDown);
+
+        numTapsUp   = static_cast<size_t> (evenUp.size());
+        numTapsDown = static_cast<size_t> (evenDown.size());
+
+        // The histories are twice as long as needed, so that the samples can be written
+        // twice instead of being shifted for each new sample. The downsampling keeps
+        // separate histories for the even and the odd input samples
+        historyUp.allocate   (this->numChannels * 2 * numTapsUp);
+        historyDown.allocate (this->numChannels * 4 * numTapsDown);
+
+        positionsUp.resize   (static_cast<int> (this->numChannels));
+        positionsDown.resize (static_cast<int> (this->numChannels));
+
+       #if JUCE_USE_SIMD
+        numGroups = Groups::getNumGroups (this->numChannels);
+
+        if (numGroups > 0)
+        {
+            historyUpGroups.allocate   (numGroups * 2 * numTapsUp);
+            historyDownGroups.allocate (numGroups * 4 * numTapsDown);
+        }
+       #endif
+    }
+
+    //==============================================================================
+    SampleType getLatencyInSamples() const override
+    {
+        return latency;
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        historyUp.clear();
+        historyDown.clear();
+
+        positionsUp.fill (0);
+        positionsDown.fill (0);
+
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            historyUpGroups.clear();
+            historyDownGroups.clear();
+        }
+       #endif
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        auto numSamples = inputBlock.getNumSamples();
+
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            auto outputs = AudioBlock<SampleType> (ParentType::buffer);
+
+            for (size_t group = 0; group < numGroups; ++group)
+            {
+                const SampleType* input[Groups::numLanes];
+                SampleType* output[Groups::numLanes];
+                auto numChannelsInGroup = Groups::getChannels (inputBlock, group, input);
+
+                if (numChannelsInGroup == 0)
+                    break;
+
+                Groups::getChannels (outputs, group, output);
+
+                upsample (historyUpGroups.get (group * 2 * numTapsUp),
+                          positionsUp.getReference (static_cast<int> (group)), numSamples,
+                          [&] (size_t i)          { return Groups::load (input, numChannelsInGroup, i); },
+                          [&] (size_t i, Lanes x) { Groups::store (x, output, numChannelsInGroup, i); });
+            }
+
+            return;
+        }
+       #endif
+
+        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        {
+            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
+            auto samples = inputBlock.getChannelPointer (channel);
+
+            upsample (historyUp.get (channel * 2 * numTapsUp),
+                      positionsUp.getReference (static_cast<int> (channel)), numSamples,
+                      [&] (size_t i)               { return samples[i]; },
+                      [&] (size_t i, SampleType x) { bufferSamples[i] = x; });
+        }
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        auto numSamples = outputBlock.getNumSamples();
+
+       #if JUCE_USE_SIMD
+        if (numGroups > 0)
+        {
+            auto inputs = AudioBlock<SampleType> (ParentType::buffer);
+
+            for (size_t group = 0; group < numGroups; ++group)
+            {
+                SampleType* input[Groups::numLanes];
+                SampleType* output[Groups::numLanes];
+                auto numChannelsInGroup = Groups::getChannels (outputBlock, group, output);
+
+                if (numChannelsInGroup == 0)
+                    break;
+
+                Groups::getChannels (inputs, group, input);
+
+                downsample (historyDownGroups.get (group * 4 * numTapsDown),
+                            positionsDown.getReference (static_cast<int> (group)), numSamples,
+                            [&] (size_t i)          { return Groups::load (input, numChannelsInGroup, i); },
+                            [&] (size_t i, Lanes x) { Groups::store (x, output, numChannelsInGroup, i); });
+            }
+
+            return;
+        }
+       #endif
+
+        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        {
+            auto bufferSamples = ParentType::buffer.getReadPointer (static_cast<int> (channel));
+            auto samples = outputBlock.getChannelPointer (channel);
+
+            downsample (historyDown.get (channel * 4 * numTapsDown),
+                        positionsDown.getReference (static_cast<int> (channel)), numSamples,
+                        [&] (size_t i)               { return bufferSamples[i]; },
+                        [&] (size_t i, SampleType x) { samples[i] = x; });
+        }
+    }
+
+private:
+    //==============================================================================
+    /*  These are used both for single channels and for groups of channels in SIMD
+        lanes. The windows of the histories start with the newest samples.
+    */
+    template <typename Value, typename LoadFn, typename StoreFn>
+    void upsample (Value* history, size_t& position, size_t numSamples, LoadFn&& load, StoreFn&& store) const noexcept
+    {
+        auto even = evenUp.getRawDataPointer();
+        auto odd  = oddUp.getRawDataPointer();
+        auto pos = position;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            pos = (pos == 0 ? numTapsUp : pos) - 1;
+            history[pos] = history[pos + numTapsUp] = load (i);
+
+            auto* window = history + pos;
+            auto outEven = window[0] * even[0];
+            auto outOdd  = window[0] * odd[0];
+
+            for (size_t k = 1; k < numTapsUp; ++k)
+            {
+                outEven += window[k] * even[k];
+                outOdd  += window[k] * odd[k];
+            }
+
+            store (i << 1, outEven);
+            store ((i << 1) + 1, outOdd);
+        }
+
+        position = pos;
+    }
+
+    template <typename Value, typename LoadFn, typename StoreFn>
+    void downsample (Value* history, size_t& position, size_t numSamples, LoadFn&& load, StoreFn&& store) const noexcept
+    {
+        auto even = evenDown.getRawDataPointer();
+        auto odd  = oddDown.getRawDataPointer();
+        auto* historyEven = history;
+        auto* historyOdd  = history + 2 * numTapsDown;
+        auto pos = position;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            // The odd taps apply to the odd samples of the previous pairs
+            auto* windowOdd = historyOdd + pos;
+
+            pos = (pos == 0 ? numTapsDown : pos) - 1;
+            historyEven[pos] = historyEven[pos + numTapsDown] = load (i << 1);
+
+            auto* windowEven = historyEven + pos;
+            auto out = windowEven[0] * even[0] + windowOdd[0] * odd[0];
+
+            for (size_t k = 1; k < numTapsDown; ++k)
+                out += windowEven[k] * even[k] + windowOdd[k] * odd[k];
+
+            historyOdd[pos] = historyOdd[pos + numTapsDown] = load ((i << 1) + 1);
+
+            store (i, out);
+        }
+
+        position = pos;
+    }
+
+    //==============================================================================
+    /** Returns the minimum phase filter with the same magnitude response as a linear
+        phase one, using the homomorphic method: the real cepstrum of the filter is
+        folded onto the positive quefrencies, which moves all its zeros inside the
+        unit circle.
+    */
+    static Array<SampleType> getMinimumPhaseImpulseResponse (const FIR::Coefficients<SampleType>& linearPhase)
+    {
+        auto numTaps = linearPhase.getFilterOrder() + 1;
+        auto* taps = linearPhase.getRawCoefficients();
+
+        // The cepstrum is aliased in time, so the transforms must be much longer than the filter
+        FFT fft (jmin (16, roundToInt (std::ceil (std::log2 ((double) numTaps))) + 5));
+        auto size = static_cast<size_t> (fft.getSize());
+
+        std::vector<Complex<float>> signal (size), spectrum (size);
+
+        for (size_t i = 0; i < numTaps; ++i)
+            signal[i] = static_cast<float> (taps[i]);
+
+        fft.perform (signal.data(), spectrum.data(), false);
+
+        // The zeros in the stopband are clipped at about -140 dB before taking the logarithm
+        for (auto& bin : spectrum)
+            bin = std::log (jmax (std::abs (bin), 1.0e-7f));
+
+        fft.perform (spectrum.data(), signal.data(), true);
+
+        for (size_t i = 1; i < size; ++i)
+            signal[i] = i < size / 2 ? 2.0f * signal[i].real() : (i == size / 2 ? signal[i].real() : 0.0f);
+
+        signal[0] = signal[0].real();
+
+        fft.perform (signal.data(), spectrum.data(), false);
+
+        for (auto& bin : spectrum)
+            bin = std::exp (bin);
+
+        fft.perform (spectrum.data(), signal.data(), true);
+
+        // Keeps the gain at DC of the original filter
+        Array<SampleType> result;
+        auto sumLinear = static_cast<SampleType> (0), sumMinimum = static_cast<SampleType> (0);
+
+        for (size_t i = 0; i < numTaps; ++i)
+        {
+            result.add (static_cast<SampleType> (signal[i].real()));
+            sumLinear  += taps[i];
+            sumMinimum += result.getLast();
+        }
+
+        for (auto& tap : result)
+            tap *= sumLinear / sumMinimum;
+
+        return result;
+    }
+
+    static SampleType getGroupDelayAtDC (const Array<SampleType>& impulse)
+    {
+        auto sum = static_cast<SampleType> (0), weightedSum = static_cast<SampleType> (0);
+
+        for (int i = 0; i < impulse.size(); ++i)
+        {
+            sum += impulse[i];
+            weightedSum += static_cast<SampleType> (i) * impulse[i];
+        }
+
+        return weightedSum / sum;
+    }
+
+    static void splitIntoPhases (const Array<SampleType>& impulse, SampleType gain,
+                                 Array<SampleType>& even, Array<SampleType>& odd)
+    {
+        for (int i = 0; i < impulse.size(); i += 2)
+        {
+            even.add (impulse[i] * gain);
+            odd.add (i + 1 < impulse.size() ? impulse[i + 1] * gain : static_cast<SampleType> (0));
+        }
+    }
+
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Lanes = typename Groups::Lanes;
+   #endif
+
+    Array<SampleType> evenUp, oddUp, evenDown, oddDown;
+    size_t numTapsUp = 0, numTapsDown = 0;
+    SampleType latency;
+
+    OversamplingStateBuffer<SampleType> historyUp, historyDown;
+    Array<size_t> positionsUp, positionsDown;
+
+   #if JUCE_USE_SIMD
+    size_t numGroups = 0;
+    OversamplingStateBuffer<Lanes> historyUpGroups, historyDownGroups;
+   #endif
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesMinimumPhaseFIR)
+};
+
+
 //==============================================================================
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels)
@@ -574,7 +1308,7 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
                                   twDown, gaindBStartDown + gaindBFactorDown * (float) n);
         }
     }
-    else if (newType == FilterType::filterHalfBandFIREquiripple)
+    else if (newType == FilterType::filterHalfBandFIREquiripple || newType == FilterType::filterHalfBandFIRMinimumPhase)
     {
         for (size_t n = 0; n < newFactor; ++n)
         {
@@ -586,7 +1320,7 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
             auto gaindBFactorUp   = (isMaximumQuality ? 10.0f  : 8.0f);
             auto gaindBFactorDown = (isMaximumQuality ? 10.0f  : 8.0f);
 
-            addOversamplingStage (FilterType::filterHalfBandFIREquiripple,
+            addOversamplingStage (newType,
                                   twUp, gaindBStartUp + gaindBFactorUp * (float) n,
                                   twDown, gaindBStartDown + gaindBFactorDown * (float) n);
         }
@@ -619,6 +1353,12 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                                     normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
                                                                     normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
+    else if (type == FilterType::filterHalfBandFIRMinimumPhase)
+    {
+        stages.add (new Oversampling2TimesMinimumPhaseFIR<SampleType> (numChannels,
+                                                                       normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                                       normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+    }
     else
     {
         stages.add (new Oversampling2TimesEquirippleFIR<SampleType> (numChannels,
@@ -52,7 +52,12 @@ namespace juce::dsp
     Choose between FIR or IIR filtering depending on your needs in terms of
     latency and phase distortion. With FIR filters the phase is linear but the
     latency is maximised. With IIR filtering the phase is compromised around the
-    Nyquist frequency but the latency is minimised.
+    Nyquist frequency but the latency is minimised. The minimum phase FIR filters
+    sit in between, keeping the magnitude response of the linear phase ones with
+    a much lower latency.
+
+    When there is more than one channel, the channels are filtered in groups,
+    with one channel in each lane of a SIMDRegister.
 
     @see FilterDesign.
 
@@ -67,6 +72,7 @@ public:
     {
         filterHalfBandFIREquiripple = 0,
         filterHalfBandPolyphaseIIR,
+        filterHalfBandFIRMinimumPhase,
         numFilterTypes
     };
 
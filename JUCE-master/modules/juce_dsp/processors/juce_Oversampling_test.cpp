@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class OversamplingTest final : public UnitTest
+{
+public:
+    OversamplingTest()
+        : UnitTest ("Oversampling", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float");
+        runTestsForType<double> ("double");
+    }
+
+private:
+    using FilterType = Oversampling<float>::FilterType;
+
+    static constexpr FilterType filterTypes[] { FilterType::filterHalfBandFIREquiripple,
+                                                FilterType::filterHalfBandPolyphaseIIR,
+                                                FilterType::filterHalfBandFIRMinimumPhase };
+
+    template <typename SampleType>
+    void runTestsForType (const String& typeName)
+    {
+        constexpr size_t maxBlockSize = 128;
+
+        beginTest ("Multichannel processing matches single channels (" + typeName + ")");
+        {
+            constexpr size_t numChannels = 5;
+
+            for (auto type : filterTypes)
+            {
+                Oversampling<SampleType> multichannel (numChannels, 2, (typename Oversampling<SampleType>::FilterType) type);
+                multichannel.initProcessing (maxBlockSize);
+
+                OwnedArray<Oversampling<SampleType>> single;
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    single.add (new Oversampling<SampleType> (1, 2, (typename Oversampling<SampleType>::FilterType) type));
+                    single.getLast()->initProcessing (maxBlockSize);
+                }
+
+                AudioBuffer<SampleType> input ((int) numChannels, (int) maxBlockSize), outputMultichannel (input), outputSingle (input);
+                auto random = getRandom();
+                auto maxError = static_cast<SampleType> (0);
+
+                for (int block = 0; block < 16; ++block)
+                {
+                    auto numSamples = (size_t) random.nextInt ({ 1, (int) maxBlockSize + 1 });
+
+                    for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                        for (size_t i = 0; i < numSamples; ++i)
+                            input.setSample (channel, (int) i, static_cast<SampleType> (2.0f * random.nextFloat() - 1.0f));
+
+                    auto inputBlock = AudioBlock<const SampleType> (input).getSubBlock (0, numSamples);
+                    auto outputBlock = AudioBlock<SampleType> (outputMultichannel).getSubBlock (0, numSamples);
+                    auto upsampled = multichannel.processSamplesUp (inputBlock);
+                    multichannel.processSamplesDown (outputBlock);
+
+                    for (size_t channel = 0; channel < numChannels; ++channel)
+                    {
+                        auto singleUpsampled = single[(int) channel]->processSamplesUp (inputBlock.getSingleChannelBlock (channel));
+
+                        for (size_t i = 0; i < singleUpsampled.getNumSamples(); ++i)
+                            maxError = jmax (maxError, std::abs (singleUpsampled.getSample (0, (int) i) - upsampled.getSample ((int) channel, (int) i)));
+
+                        auto singleOutput = AudioBlock<SampleType> (outputSingle).getSingleChannelBlock (channel).getSubBlock (0, numSamples);
+                        single[(int) channel]->processSamplesDown (singleOutput);
+
+                        for (size_t i = 0; i < numSamples; ++i)
+                            maxError = jmax (maxError, std::abs (singleOutput.getSample (0, (int) i) - outputBlock.getSample ((int) channel, (int) i)));
+                    }
+                }
+
+                expectLessThan (maxError, static_cast<SampleType> (1.0e-5));
+            }
+        }
+
+        beginTest ("Minimum phase FIR filters (" + typeName + ")");
+        {
+            Oversampling<SampleType> linearPhase  (1, 2, Oversampling<SampleType>::filterHalfBandFIREquiripple);
+            Oversampling<SampleType> minimumPhase (1, 2, Oversampling<SampleType>::filterHalfBandFIRMinimumPhase);
+
+            expectLessThan (minimumPhase.getLatencyInSamples(), linearPhase.getLatencyInSamples() * static_cast<SampleType> (0.5));
+
+            // A sine wave in the passband must go through without any change of amplitude
+            minimumPhase.initProcessing (maxBlockSize);
+
+            AudioBuffer<SampleType> buffer (1, (int) maxBlockSize);
+            auto phase = 0.0;
+            auto peak = static_cast<SampleType> (0);
+
+            for (int block = 0; block < 32; ++block)
+            {
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    buffer.setSample (0, i, static_cast<SampleType> (std::sin (phase)));
+                    phase += MathConstants<double>::twoPi * 0.0513;
+                }
+
+                auto audioBlock = AudioBlock<SampleType> (buffer);
+                minimumPhase.processSamplesUp (audioBlock);
+                minimumPhase.processSamplesDown (audioBlock);
+
+                if (block >= 16)
+                    peak = jmax (peak, audioBlock.findMinAndMax().getEnd());
+            }
+
+            expectWithinAbsoluteError (peak, static_cast<SampleType> (1), static_cast<SampleType> (0.01));
+        }
+    }
+};
+
+static OversamplingTest oversamplingUnitTest;
+
+} // namespace juce::dsp
@@ -59,9 +59,29 @@ namespace detail
 
     template <typename Context, size_t Ix>
     inline constexpr auto useContextDirectly = ! Context::usesSeparateInputAndOutputBlocks() || Ix == 0;
+
+    template <typename Processor, typename = void>
+    inline constexpr auto hasSnapToZero = false;
+
+    template <typename Processor>
+    inline constexpr auto hasSnapToZero<Processor, std::void_t<decltype (std::declval<Processor&>().snapToZero())>> = true;
 }
 #endif
 
+/** Specialise this for a processor class to let ProcessorChain::processInSubBlocks
+    run it sample by sample, in the same loop as its neighbours in the chain.
+
+    The processor must have a `processSample (int channel, SampleType)` method, and
+    its process() method must be equivalent to calling processSample() for each
+    sample of each channel, followed by a call to snapToZero() if it has one.
+
+    @see ProcessorChain::processInSubBlocks
+
+    @tags{DSP}
+*/
+template <typename Processor>
+struct SupportsPerSampleProcessing  : std::false_type {};
+
 /** This variadically-templated class lets you join together any number of processor
     classes into a single processor which will call process() on them all in sequence.
 
@@ -105,7 +125,125 @@ public:
                                 processors);
     }
 
+    /** Process `context` through all inner processors, one sub-block of at most
+        `subBlockSize` samples at a time, so that the samples are still in the cache
+        when they reach the next processor.
+
+        Consecutive processors for which SupportsPerSampleProcessing is specialised are
+        fused into a single loop, which passes each sample through all of them in turn.
+
+        The result is the same as with process(), as long as the processors don't
+        depend on the size of the blocks they are given.
+
+        @see FusedProcessorChain, SupportsPerSampleProcessing
+    */
+    template <size_t subBlockSize, typename ProcessContext>
+    void processInSubBlocks (const ProcessContext& context) noexcept
+    {
+        static_assert (subBlockSize > 0, "The sub-blocks can't be empty");
+
+        using SampleType = typename ProcessContext::SampleType;
+
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumSamples() == numSamples);
+
+        for (size_t start = 0; start < numSamples; start += subBlockSize)
+        {
+            const auto length = jmin (subBlockSize, numSamples - start);
+            auto subOutputBlock = outputBlock.getSubBlock (start, length);
+
+            if constexpr (ProcessContext::usesSeparateInputAndOutputBlocks())
+            {
+                const auto subInputBlock = inputBlock.getSubBlock (start, length);
+                ProcessContextNonReplacing<SampleType> subContext (subInputBlock, subOutputBlock);
+                subContext.isBypassed = context.isBypassed;
+
+                processFused (subContext);
+            }
+            else
+            {
+                ProcessContextReplacing<SampleType> subContext (subOutputBlock);
+                subContext.isBypassed = context.isBypassed;
+
+                processFused (subContext);
+            }
+        }
+    }
+
 private:
+    static constexpr std::array<bool, sizeof... (Processors)> perSampleProcessors { { SupportsPerSampleProcessing<Processors>::value... } };
+
+    static constexpr size_t getNumPerSampleProcessorsFrom (size_t index)
+    {
+        auto end = index;
+
+        while (end < perSampleProcessors.size() && perSampleProcessors[end])
+            ++end;
+
+        return end - index;
+    }
+
+    template <typename Context>
+    void processFused (const Context& context) noexcept
+    {
+        detail::forEachInTuple ([this, &context] (auto& proc, auto index) noexcept { this->processFusedOne (context, proc, index); },
+                                processors);
+    }
+
+    template <typename Context, typename Proc, size_t Ix>
+    void processFusedOne (const Context& context, Proc& proc, std::integral_constant<size_t, Ix> index) noexcept
+    {
+        if constexpr (! perSampleProcessors[Ix])
+            processOne (context, proc, index);
+        else if constexpr (Ix == 0 || ! perSampleProcessors[Ix - 1])
+            processPerSample<Ix> (context, std::make_index_sequence<getNumPerSampleProcessorsFrom (Ix)>());
+    }
+
+    template <size_t First, typename Context, size_t... Ix>
+    void processPerSample (const Context& context, std::index_sequence<Ix...>) noexcept
+    {
+        // The bypassed processors are left to handle it in their own way
+        if (context.isBypassed || (bypassed[First + Ix] || ...))
+        {
+            (processOne (context, std::get<First + Ix> (processors), std::integral_constant<size_t, First + Ix>()), ...);
+            return;
+        }
+
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (context.getInputBlock().getNumChannels() == numChannels);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* outputSamples = outputBlock.getChannelPointer (channel);
+            const typename Context::SampleType* inputSamples = outputSamples;
+
+            if constexpr (detail::useContextDirectly<Context, First>)
+                inputSamples = context.getInputBlock().getChannelPointer (channel);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto sample = inputSamples[i];
+                ((sample = std::get<First + Ix> (processors).processSample ((int) channel, sample)), ...);
+                outputSamples[i] = sample;
+            }
+        }
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        detail::forEachInTuple ([] (auto& proc, auto) noexcept
+                                {
+                                    if constexpr (detail::hasSnapToZero<std::remove_reference_t<decltype (proc)>>)
+                                        proc.snapToZero();
+                                },
+                                std::forward_as_tuple (std::get<First + Ix> (processors)...));
+       #endif
+    }
+
     template <typename Context, typename Proc, size_t Ix>
     void processOne (const Context& context, Proc& proc, std::integral_constant<size_t, Ix>) noexcept
     {
@@ -130,6 +268,26 @@ private:
     std::array<bool, sizeof... (Processors)> bypassed { {} };
 };
 
+/** A ProcessorChain which always processes its blocks in sub-blocks of at most
+    `subBlockSize` samples, fusing the processors that support per-sample
+    processing into single loops.
+
+    @see ProcessorChain::processInSubBlocks, SupportsPerSampleProcessing
+
+    @tags{DSP}
+*/
+template <size_t subBlockSize, typename... Processors>
+class FusedProcessorChain  : public ProcessorChain<Processors...>
+{
+public:
+    /** Process `context` through all inner processors, one sub-block at a time. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        this->template processInSubBlocks<subBlockSize> (context);
+    }
+};
+
 /** Non-member equivalent of ProcessorChain::get which avoids awkward
     member template syntax.
 */
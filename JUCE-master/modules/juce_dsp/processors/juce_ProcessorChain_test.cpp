@@ -165,6 +165,73 @@ public:
                 expectEquals (outBuf.getSample (0, 0), 4.0f);
             }
         }
+
+        beginTest ("Processing in sub-blocks gives the same results as processing whole blocks");
+        {
+            using Chain = ProcessorChain<StateVariableTPTFilter<float>, FirstOrderTPTFilter<float>,
+                                         Gain<float>, LinkwitzRileyFilter<float>, Compressor<float>>;
+
+            constexpr size_t numChannels = 3, numSamples = 300;
+            const ProcessSpec spec { 44100.0, (uint32) numSamples, (uint32) numChannels };
+
+            Chain chain;
+            FusedProcessorChain<64, StateVariableTPTFilter<float>, FirstOrderTPTFilter<float>,
+                                Gain<float>, LinkwitzRileyFilter<float>, Compressor<float>> fusedChain;
+
+            auto setUp = [&] (auto& c)
+            {
+                get<2> (c).setGainDecibels (-6.0f);
+                get<2> (c).setRampDurationSeconds (0.002);
+                get<4> (c).setThreshold (-12.0f);
+                get<4> (c).setRatio (4.0f);
+                c.prepare (spec);
+            };
+
+            setUp (chain);
+            setUp (fusedChain);
+
+            AudioBuffer<float> input ((int) numChannels, (int) numSamples), expected (input), output (input);
+            auto random = getRandom();
+
+            for (auto bypassFirstOrderFilter : { false, true })
+            {
+                setBypassed<1> (chain, bypassFirstOrderFilter);
+                setBypassed<1> (fusedChain, bypassFirstOrderFilter);
+
+                for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                    for (int i = 0; i < input.getNumSamples(); ++i)
+                        input.setSample (channel, i, 2.0f * random.nextFloat() - 1.0f);
+
+                AudioBlock<const float> inputBlock (input);
+                AudioBlock<float> expectedBlock (expected), outputBlock (output);
+
+                chain.process (ProcessContextNonReplacing<float> (inputBlock, expectedBlock));
+                fusedChain.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+
+                auto maxError = 0.0f;
+
+                for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                    for (int i = 0; i < input.getNumSamples(); ++i)
+                        maxError = jmax (maxError, std::abs (expected.getSample (channel, i) - output.getSample (channel, i)));
+
+                expectLessThan (maxError, 1.0e-6f);
+            }
+
+            // Replacing contexts
+            AudioBlock<float> expectedBlock (expected), outputBlock (output);
+            outputBlock.copyFrom (expectedBlock);
+
+            chain.process (ProcessContextReplacing<float> (expectedBlock));
+            fusedChain.processInSubBlocks<17> (ProcessContextReplacing<float> (outputBlock));
+
+            auto maxError = 0.0f;
+
+            for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    maxError = jmax (maxError, std::abs (expected.getSample (channel, i) - output.getSample (channel, i)));
+
+            expectLessThan (maxError, 1.0e-6f);
+        }
     }
 };
 
@@ -102,4 +102,118 @@ private:
     juce::OwnedArray<MonoProcessorType> processors;
 };
 
+#if JUCE_USE_SIMD
+//==============================================================================
+/**
+    A multi-channel version of a mono processor class, which runs the processor on
+    SIMDRegisters, with one channel in each lane.
+
+    It takes the same template arguments as ProcessorDuplicator, and the mono
+    processor must be a class template on its sample type, which can also be used
+    with SIMDRegister<SampleType>, such as IIR::Filter or FIR::Filter. For
+    example, SIMDProcessorDuplicator<IIR::Filter<float>, IIR::Coefficients<float>>
+    runs IIR::Filter<SIMDRegister<float>> instances, each of them filtering as
+    many channels as there are in a SIMDRegister<float>.
+
+    The channels of each group are interleaved into a buffer of SIMDRegisters,
+    processed, and then de-interleaved back into the output block. Unused lanes
+    are filled with zeros.
+
+    When SIMD support isn't available this class is the same as ProcessorDuplicator.
+
+    @see ProcessorDuplicator, SIMDRegister
+
+    @tags{DSP}
+*/
+template <typename MonoProcessorType, typename StateType>
+struct SIMDProcessorDuplicator
+{
+private:
+    template <typename ProcessorType>
+    struct ProcessorTraits;
+
+    template <template <typename> class ProcessorTemplate, typename Type>
+    struct ProcessorTraits<ProcessorTemplate<Type>>
+    {
+        using SampleType = Type;
+        using VectorProcessorType = ProcessorTemplate<SIMDRegister<Type>>;
+    };
+
+public:
+    using SampleType = typename ProcessorTraits<MonoProcessorType>::SampleType;
+    using VectorType = SIMDRegister<SampleType>;
+    using VectorProcessorType = typename ProcessorTraits<MonoProcessorType>::VectorProcessorType;
+
+    static constexpr size_t numLanes = VectorType::SIMDNumElements;
+
+    SIMDProcessorDuplicator() : state (new StateType()) {}
+    SIMDProcessorDuplicator (StateType* stateToUse) : state (stateToUse) {}
+    SIMDProcessorDuplicator (typename StateType::Ptr stateToUse) : state (std::move (stateToUse)) {}
+
+    void prepare (const ProcessSpec& spec)
+    {
+        auto numGroups = (int) ((spec.numChannels + numLanes - 1) / numLanes);
+
+        processors.removeRange (numGroups, processors.size());
+
+        while (processors.size() < numGroups)
+            processors.add (new VectorProcessorType (state));
+
+        auto monoSpec = spec;
+        monoSpec.numChannels = 1;
+
+        for (auto* p : processors)
+            p->prepare (monoSpec);
+
+        interleaved = AudioBlock<VectorType> (interleavedData, 1, spec.maximumBlockSize);
+        maximumNumChannels = spec.numChannels;
+    }
+
+    void reset() noexcept      { for (auto* p : processors) p->reset(); }
+
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels()  <= maximumNumChannels);
+        jassert (outputBlock.getNumChannels() <= maximumNumChannels);
+        jassert (inputBlock.getNumSamples() == outputBlock.getNumSamples());
+        jassert (outputBlock.getNumSamples() <= interleaved.getNumSamples());
+
+        auto numChannels = jmin (inputBlock.getNumChannels(), outputBlock.getNumChannels());
+        auto numSamples  = outputBlock.getNumSamples();
+        auto block = interleaved.getSubBlock (0, numSamples);
+        const InterleavedAudioBlock<SampleType> lanes (block, 0);
+
+        for (size_t firstChannel = 0, group = 0; firstChannel < numChannels; firstChannel += numLanes, ++group)
+        {
+            auto numChannelsInGroup = jmin (numLanes, numChannels - firstChannel);
+
+            // Unused lanes are filled with zeros
+            lanes.copyFrom (inputBlock.getSubsetChannelBlock (firstChannel, numChannelsInGroup));
+
+            ProcessContextReplacing<VectorType> vectorContext (block);
+            vectorContext.isBypassed = context.isBypassed;
+            processors.getUnchecked ((int) group)->process (vectorContext);
+
+            lanes.copyTo (outputBlock.getSubsetChannelBlock (firstChannel, numChannelsInGroup));
+        }
+    }
+
+    typename StateType::Ptr state;
+
+private:
+    juce::OwnedArray<VectorProcessorType> processors;
+
+    HeapBlock<char> interleavedData;
+    AudioBlock<VectorType> interleaved;
+    size_t maximumNumChannels = 0;
+};
+#else
+template <typename MonoProcessorType, typename StateType>
+using SIMDProcessorDuplicator = ProcessorDuplicator<MonoProcessorType, StateType>;
+#endif
+
 } // namespace juce::dsp
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class ProcessorDuplicatorTest final : public UnitTest
+{
+public:
+    ProcessorDuplicatorTest()
+        : UnitTest ("ProcessorDuplicator", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float");
+        runTestsForType<double> ("double");
+    }
+
+private:
+    template <typename SampleType>
+    void runTestsForType (const String& typeName)
+    {
+        using Filter = IIR::Filter<SampleType>;
+        using Coefficients = IIR::Coefficients<SampleType>;
+
+        constexpr uint32 numChannels = 7, maxBlockSize = 256;
+        const ProcessSpec spec { 44100.0, maxBlockSize, numChannels };
+
+        beginTest ("SIMDProcessorDuplicator matches ProcessorDuplicator (" + typeName + ")");
+        {
+            auto coefficients = Coefficients::makeLowPass (spec.sampleRate, 1000.0);
+
+            ProcessorDuplicator<Filter, Coefficients> duplicator (coefficients);
+            SIMDProcessorDuplicator<Filter, Coefficients> simdDuplicator (coefficients);
+
+            duplicator.prepare (spec);
+            simdDuplicator.prepare (spec);
+
+            AudioBuffer<SampleType> input ((int) numChannels, (int) maxBlockSize),
+                                    expected (input), output (input);
+            auto random = getRandom();
+            auto maxError = static_cast<SampleType> (0);
+
+            for (int block = 0; block < 8; ++block)
+            {
+                auto numSamples = (size_t) random.nextInt ({ 1, (int) maxBlockSize + 1 });
+
+                for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                    for (size_t i = 0; i < numSamples; ++i)
+                        input.setSample (channel, (int) i, static_cast<SampleType> (2.0f * random.nextFloat() - 1.0f));
+
+                auto inputBlock = AudioBlock<SampleType> (input).getSubBlock (0, numSamples);
+                auto expectedBlock = AudioBlock<SampleType> (expected).getSubBlock (0, numSamples);
+                auto outputBlock = AudioBlock<SampleType> (output).getSubBlock (0, numSamples);
+
+                duplicator.process (ProcessContextNonReplacing<SampleType> (inputBlock, expectedBlock));
+
+                // The replacing version would overwrite the input, so it's used on a copy
+                outputBlock.copyFrom (inputBlock);
+                simdDuplicator.process (ProcessContextReplacing<SampleType> (outputBlock));
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    for (size_t i = 0; i < numSamples; ++i)
+                        maxError = jmax (maxError, std::abs (expectedBlock.getSample ((int) channel, (int) i)
+                                                               - outputBlock.getSample ((int) channel, (int) i)));
+            }
+
+            expectLessThan (maxError, static_cast<SampleType> (1.0e-5));
+        }
+
+        beginTest ("SIMDProcessorDuplicator bypass (" + typeName + ")");
+        {
+            SIMDProcessorDuplicator<Filter, Coefficients> simdDuplicator (Coefficients::makeLowPass (spec.sampleRate, 1000.0));
+            simdDuplicator.prepare (spec);
+
+            AudioBuffer<SampleType> input ((int) numChannels, (int) maxBlockSize), output (input);
+
+            for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    input.setSample (channel, i, static_cast<SampleType> (channel + i));
+
+            auto inputBlock = AudioBlock<const SampleType> (input);
+            auto outputBlock = AudioBlock<SampleType> (output);
+
+            ProcessContextNonReplacing<SampleType> context (inputBlock, outputBlock);
+            context.isBypassed = true;
+            simdDuplicator.process (context);
+
+            for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    expectEquals (output.getSample (channel, i), input.getSample (channel, i));
+        }
+    }
+};
+
+static ProcessorDuplicatorTest processorDuplicatorUnitTest;
+
+} // namespace juce::dsp
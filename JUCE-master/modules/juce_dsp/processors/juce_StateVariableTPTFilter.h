@@ -169,4 +169,7 @@ private:
                resonance       = static_cast<SampleType> (1.0 / std::sqrt (2.0));
 };
 
+template <typename SampleType>
+struct SupportsPerSampleProcessing<StateVariableTPTFilter<SampleType>>  : std::true_type {};
+
 } // namespace juce::dsp
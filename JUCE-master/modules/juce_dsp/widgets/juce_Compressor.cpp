@@ -35,6 +35,75 @@
 namespace juce::dsp
 {
 
+//==============================================================================
+/*  Fast log2 and exp2 for the gain computer. They only use arithmetic and integer
+    operations on the float representation, with no branches or calls, so that
+    loops over them can be vectorised by the compiler.
+*/
+template <typename FloatType>
+struct CompressorMaths
+{
+    using BitsType = std::conditional_t<std::is_same_v<FloatType, float>, uint32, uint64>;
+    using IntType  = std::conditional_t<std::is_same_v<FloatType, float>, int32, int64>;
+
+    static constexpr int mantissaBits = std::numeric_limits<FloatType>::digits - 1;
+    static constexpr IntType exponentBias = std::numeric_limits<FloatType>::max_exponent - 1;
+    static constexpr BitsType mantissaMask = (BitsType (1) << mantissaBits) - 1;
+
+    /*  log2 (x) for x >= 0, limited to the range 0 to (exponentBias - 1), from the
+        exponent and the series for atanh of the mantissa, which is kept between
+        sqrt (0.5) and sqrt (2). Accurate to about 4e-8.
+
+        Positive floats sort in the same order as their bits, so the limits and the
+        mantissa range can be dealt with using integer comparisons, which don't stop
+        the compiler from vectorising the loop.
+    */
+    static forcedinline FloatType log2Limited (FloatType x) noexcept
+    {
+        constexpr auto one = (BitsType) exponentBias << mantissaBits;
+        constexpr auto largest = (BitsType) (2 * exponentBias - 1) << mantissaBits;
+        constexpr auto sqrt2Mantissa = std::is_same_v<FloatType, float> ? (BitsType) 0x3504f3
+                                                                         : (BitsType) 0x6a09e667f3bcdULL;
+        BitsType bits;
+        std::memcpy (&bits, &x, sizeof (x));
+        bits = jlimit (one, largest, bits);
+
+        const auto isHigh = (IntType) ((bits & mantissaMask) > sqrt2Mantissa);
+        const auto exponent = (IntType) (bits >> mantissaBits) - exponentBias + isHigh;
+        bits = (bits & mantissaMask) | ((BitsType) (exponentBias - isHigh) << mantissaBits);
+
+        FloatType mantissa;
+        std::memcpy (&mantissa, &bits, sizeof (mantissa));
+
+        const auto s = (mantissa - 1) / (mantissa + 1);
+        const auto s2 = s * s;
+
+        constexpr auto c = 2.0 / 0.693147180559945309; // 2 / ln (2)
+        const auto series = s * ((FloatType) c + s2 * ((FloatType) (c / 3) + s2 * ((FloatType) (c / 5) + s2 * (FloatType) (c / 7))));
+
+        return (FloatType) exponent + series;
+    }
+
+    /*  2^y for y between (1 - exponentBias) and 0, from the exponent bits and the
+        Taylor series of exp for the remainder, which is kept between -0.5 and 0.5.
+        Accurate to about 6e-9.
+    */
+    static forcedinline FloatType exp2 (FloatType y) noexcept
+    {
+        const auto exponent = (IntType) (y - static_cast<FloatType> (0.5));
+        const auto t = (y - (FloatType) exponent) * static_cast<FloatType> (0.693147180559945309);
+
+        const auto series = 1 + t * (1 + t * ((FloatType) (1.0 / 2) + t * ((FloatType) (1.0 / 6) + t * ((FloatType) (1.0 / 24)
+                              + t * ((FloatType) (1.0 / 120) + t * ((FloatType) (1.0 / 720) + t * (FloatType) (1.0 / 5040)))))));
+
+        const auto bits = (BitsType) (exponent + exponentBias) << mantissaBits;
+        FloatType scale;
+        std::memcpy (&scale, &bits, sizeof (scale));
+
+        return series * scale;
+    }
+};
+
 //==============================================================================
 template <typename SampleType>
 Compressor<SampleType>::Compressor()
@@ -84,6 +153,9 @@ void Compressor<SampleType>::prepare (const ProcessSpec& spec)
 
     envelopeFilter.prepare (spec);
 
+    envelopeSize = jmax ((size_t) spec.maximumBlockSize, (size_t) 1);
+    envelope.allocate (envelopeSize, true);
+
     update();
     reset();
 }
@@ -109,6 +181,73 @@ SampleType Compressor<SampleType>::processSample (int channel, SampleType inputV
     return gain * inputValue;
 }
 
+template <typename SampleType>
+void Compressor<SampleType>::processBlock (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output,
+                                          const AudioBlock<const SampleType>& detector) noexcept
+{
+    // Make sure to call prepare() first!
+    jassert (envelopeSize > 0);
+
+    const auto numChannels = output.getNumChannels();
+    const auto numSamples  = output.getNumSamples();
+    const auto numDetectorChannels = detector.getNumChannels();
+    auto* env = envelope.get();
+
+    for (size_t start = 0; start < numSamples; start += envelopeSize)
+    {
+        const auto num = jmin (envelopeSize, numSamples - start);
+
+        if (linked)
+        {
+            FloatVectorOperations::abs (env, detector.getChannelPointer (0) + start, (int) num);
+
+            for (size_t channel = 1; channel < numDetectorChannels; ++channel)
+            {
+                const auto* src = detector.getChannelPointer (channel) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    env[i] = jmax (env[i], std::abs (src[i]));
+            }
+
+            envelopeFilter.processSamples (0, env, env, num);
+            calculateGains (env, num);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::multiply (output.getChannelPointer (channel) + start,
+                                                 input.getChannelPointer (channel) + start, env, (int) num);
+        }
+        else
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* src = detector.getChannelPointer (jmin (channel, numDetectorChannels - 1)) + start;
+
+                envelopeFilter.processSamples ((int) channel, src, env, num);
+                calculateGains (env, num);
+
+                FloatVectorOperations::multiply (output.getChannelPointer (channel) + start,
+                                                 input.getChannelPointer (channel) + start, env, (int) num);
+            }
+        }
+    }
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    envelopeFilter.snapToZero();
+   #endif
+}
+
+template <typename SampleType>
+void Compressor<SampleType>::calculateGains (SampleType* envelopeToGains, size_t numSamples) const noexcept
+{
+    using Maths = CompressorMaths<SampleType>;
+
+    // Same as processSample(): (env / threshold) ^ (1 / ratio - 1) above the threshold
+    const auto exponent = ratioInverse - static_cast<SampleType> (1.0);
+
+    for (size_t i = 0; i < numSamples; ++i)
+        envelopeToGains[i] = Maths::exp2 (Maths::log2Limited (envelopeToGains[i] * thresholdInverse) * exponent);
+}
+
 template <typename SampleType>
 void Compressor<SampleType>::update()
 {
@@ -39,6 +39,15 @@ namespace juce::dsp
     A simple compressor with standard threshold, ratio, attack time and release time
     controls.
 
+    The channels can either be compressed independently, or linked so that they all
+    get the same gain, and the level that drives the compression can be taken from
+    a sidechain signal.
+
+    process() works on whole blocks: the envelopes are followed for each block
+    first, and then the gains are calculated for the whole block with fast log2 and
+    exp2 approximations that the compiler can vectorise, which are accurate to
+    about 1e-6 dB. processSample() uses the exact functions.
+
     @tags{DSP}
 */
 template <typename SampleType>
@@ -62,6 +71,15 @@ public:
     /** Sets the release time in milliseconds of the compressor.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets whether all the channels are compressed by the same amount, which is
+        worked out from the loudest channel. This keeps the stereo image stable.
+        By default each channel is compressed independently.
+    */
+    void setLinked (bool shouldBeLinked) noexcept    { linked = shouldBeLinked; }
+
+    /** Returns true if the channels are linked. @see setLinked */
+    bool isLinked() const noexcept                   { return linked; }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -76,11 +94,9 @@ public:
     {
         const auto& inputBlock = context.getInputBlock();
         auto& outputBlock      = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
-        const auto numSamples  = outputBlock.getNumSamples();
 
-        jassert (inputBlock.getNumChannels() == numChannels);
-        jassert (inputBlock.getNumSamples()  == numSamples);
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
 
         if (context.isBypassed)
         {
@@ -88,14 +104,34 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
+        processBlock (inputBlock, outputBlock, inputBlock);
+    }
+
+    /** Processes the samples supplied in the processing context, with the amount of
+        compression driven by the level of a sidechain signal instead of the input.
+
+        The sidechain must have the same number of samples as the context. If it
+        has fewer channels than the context, its last channel is used for the
+        remaining ones.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<const SampleType>& sidechain) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+        jassert (sidechain.getNumSamples()   == outputBlock.getNumSamples());
+        jassert (sidechain.getNumChannels() > 0);
 
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
         }
+
+        processBlock (inputBlock, outputBlock, sidechain);
     }
 
     /** Performs the processing operation on a single sample at a time. */
@@ -104,13 +140,22 @@ public:
 private:
     //==============================================================================
     void update();
+    void processBlock (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output,
+                       const AudioBlock<const SampleType>& detector) noexcept;
+    void calculateGains (SampleType* envelopeToGains, size_t numSamples) const noexcept;
 
     //==============================================================================
     SampleType threshold, thresholdInverse, ratioInverse;
     BallisticsFilter<SampleType> envelopeFilter;
+    HeapBlock<SampleType> envelope;
+    size_t envelopeSize = 0;
+    bool linked = false;
 
     double sampleRate = 44100.0;
     SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0;
 };
 
+template <typename SampleType>
+struct SupportsPerSampleProcessing<Compressor<SampleType>>  : std::true_type {};
+
 } // namespace juce::dsp
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class CompressorTest final : public UnitTest
+{
+public:
+    CompressorTest()
+        : UnitTest ("Compressor", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float");
+        runTestsForType<double> ("double");
+    }
+
+private:
+    static constexpr uint32 numChannels = 2, blockSize = 100, numSamples = 1000;
+
+    template <typename SampleType>
+    static void prepareCompressor (Compressor<SampleType>& compressor)
+    {
+        compressor.setThreshold ((SampleType) -20.0);
+        compressor.setRatio     ((SampleType) 4.0);
+        compressor.setAttack    ((SampleType) 1.0);
+        compressor.setRelease   ((SampleType) 50.0);
+        compressor.prepare ({ 44100.0, blockSize, numChannels });
+    }
+
+    template <typename SampleType>
+    static void fillWithSignal (AudioBuffer<SampleType>& buffer)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, (SampleType) ((i < buffer.getNumSamples() / 2 ? 0.9 : 0.05)
+                                                              * std::sin (0.05 * (channel + 1) * i)));
+    }
+
+    template <typename SampleType>
+    void processInBlocks (Compressor<SampleType>& compressor, AudioBuffer<SampleType>& buffer,
+                          const AudioBuffer<SampleType>* sidechain = nullptr)
+    {
+        for (int start = 0; start < buffer.getNumSamples(); start += (int) blockSize)
+        {
+            auto block = AudioBlock<SampleType> (buffer).getSubBlock ((size_t) start, blockSize);
+            ProcessContextReplacing<SampleType> context (block);
+
+            if (sidechain != nullptr)
+                compressor.process (context, AudioBlock<const SampleType> (*sidechain).getSubBlock ((size_t) start, blockSize));
+            else
+                compressor.process (context);
+        }
+    }
+
+    template <typename SampleType>
+    void runTestsForType (const String& typeName)
+    {
+        beginTest ("Block processing matches processSample (" + typeName + ")");
+        {
+            Compressor<SampleType> blockCompressor, sampleCompressor;
+            prepareCompressor (blockCompressor);
+            prepareCompressor (sampleCompressor);
+
+            AudioBuffer<SampleType> buffer ((int) numChannels, (int) numSamples), reference;
+            fillWithSignal (buffer);
+            reference.makeCopyOf (buffer);
+
+            processInBlocks (blockCompressor, buffer);
+
+            for (int i = 0; i < reference.getNumSamples(); ++i)
+                for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+                    reference.setSample (channel, i, sampleCompressor.processSample (channel, reference.getSample (channel, i)));
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (buffer.getSample (channel, i), reference.getSample (channel, i), (SampleType) 1.0e-5);
+        }
+
+        beginTest ("Linked channels get the same gain (" + typeName + ")");
+        {
+            Compressor<SampleType> linkedCompressor, compressor;
+            prepareCompressor (linkedCompressor);
+            prepareCompressor (compressor);
+            linkedCompressor.setLinked (true);
+
+            // With identical channels, linking makes no difference
+            AudioBuffer<SampleType> buffer ((int) numChannels, (int) numSamples), reference;
+            fillWithSignal (buffer);
+            buffer.copyFrom (1, 0, buffer, 0, 0, buffer.getNumSamples());
+            reference.makeCopyOf (buffer);
+
+            processInBlocks (linkedCompressor, buffer);
+            processInBlocks (compressor, reference);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                expectWithinAbsoluteError (buffer.getSample (0, i), reference.getSample (0, i), (SampleType) 1.0e-6);
+
+            // A quiet channel is turned down as much as the loud one
+            linkedCompressor.reset();
+            fillWithSignal (buffer);
+            buffer.applyGain (1, 0, buffer.getNumSamples(), (SampleType) 0.01);
+            reference.makeCopyOf (buffer);
+
+            processInBlocks (linkedCompressor, buffer);
+
+            for (int i = 1; i < buffer.getNumSamples(); ++i)
+            {
+                if (std::abs (reference.getSample (0, i)) > (SampleType) 0.1 && std::abs (reference.getSample (1, i)) > (SampleType) 1.0e-4)
+                {
+                    const auto gain0 = buffer.getSample (0, i) / reference.getSample (0, i);
+                    const auto gain1 = buffer.getSample (1, i) / reference.getSample (1, i);
+                    expectWithinAbsoluteError (gain1, gain0, (SampleType) 1.0e-4);
+                }
+            }
+
+            expectLessThan (buffer.getMagnitude (1, (int) numSamples / 4, (int) numSamples / 4),
+                            (SampleType) 0.5 * reference.getMagnitude (1, (int) numSamples / 4, (int) numSamples / 4));
+        }
+
+        beginTest ("Sidechain drives the compression (" + typeName + ")");
+        {
+            Compressor<SampleType> compressor;
+            prepareCompressor (compressor);
+
+            AudioBuffer<SampleType> buffer ((int) numChannels, (int) numSamples), reference, sidechain (1, (int) numSamples);
+            fillWithSignal (buffer);
+            reference.makeCopyOf (buffer);
+
+            // A silent sidechain leaves the audio untouched
+            sidechain.clear();
+            processInBlocks (compressor, buffer, &sidechain);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectEquals (buffer.getSample (channel, i), reference.getSample (channel, i));
+
+            // A loud sidechain turns down quiet audio
+            compressor.reset();
+            buffer.applyGain ((SampleType) 0.01);
+            reference.makeCopyOf (buffer);
+
+            for (int i = 0; i < sidechain.getNumSamples(); ++i)
+                sidechain.setSample (0, i, (SampleType) 1.0);
+
+            processInBlocks (compressor, buffer, &sidechain);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                expectLessThan (buffer.getMagnitude (channel, (int) numSamples / 2, (int) numSamples / 2),
+                                (SampleType) 0.5 * reference.getMagnitude (channel, (int) numSamples / 2, (int) numSamples / 2));
+        }
+    }
+};
+
+static CompressorTest compressorTest;
+
+} // namespace juce::dsp
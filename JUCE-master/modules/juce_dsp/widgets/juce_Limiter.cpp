@@ -50,6 +50,27 @@ void Limiter<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Limiter<SampleType>::setLinked (bool shouldBeLinked) noexcept
+{
+    firstStageCompressor.setLinked (shouldBeLinked);
+    secondStageCompressor.setLinked (shouldBeLinked);
+}
+
+template <typename SampleType>
+void Limiter<SampleType>::setLookAhead (SampleType newLookAheadMs)
+{
+    jassert (newLookAheadMs >= 0);
+
+    lookAheadTime = jmax ((SampleType) 0, newLookAheadMs);
+
+    if (preparedChannels > 0)
+    {
+        prepareLookAhead();
+        reset();
+    }
+}
+
 //==============================================================================
 template <typename SampleType>
 void Limiter<SampleType>::prepare (const ProcessSpec& spec)
@@ -58,9 +79,12 @@ void Limiter<SampleType>::prepare (const ProcessSpec& spec)
     jassert (spec.numChannels > 0);
 
     sampleRate = spec.sampleRate;
+    maximumBlockSize = spec.maximumBlockSize;
+    preparedChannels = spec.numChannels;
 
     firstStageCompressor.prepare (spec);
     secondStageCompressor.prepare (spec);
+    prepareLookAhead();
 
     update();
     reset();
@@ -73,6 +97,127 @@ void Limiter<SampleType>::reset()
     secondStageCompressor.reset();
 
     outputVolume.reset (sampleRate, 0.001);
+
+    delayBuffer.clear();
+    delayPosition = minimumStart = minimumSize = averagePosition = 0;
+    sampleCount = 0;
+
+    if (averageValues != nullptr)
+        for (int i = 0; i <= lookAheadSamples; ++i)
+            averageValues[i] = (SampleType) 1.0;
+
+    averageSum = lookAheadSamples + 1;
+    currentGain = (SampleType) 1.0;
+}
+
+template <typename SampleType>
+void Limiter<SampleType>::prepareLookAhead()
+{
+    lookAheadSamples = roundToInt (lookAheadTime * 0.001 * sampleRate);
+
+    const auto windowSize = (size_t) lookAheadSamples + 1;
+
+    delayBuffer.setSize ((int) preparedChannels, jmax (lookAheadSamples, 1));
+    gains.allocate (jmax ((size_t) maximumBlockSize, (size_t) 1), true);
+    minimumValues.allocate (windowSize, true);
+    minimumIndices.allocate (windowSize, true);
+    averageValues.allocate (windowSize, true);
+}
+
+//==============================================================================
+template <typename SampleType>
+void Limiter<SampleType>::processLookAhead (const AudioBlock<const SampleType>& input,
+                                            AudioBlock<SampleType>& output) noexcept
+{
+    // Make sure to call prepare() first, and that the block is not larger than expected!
+    jassert (output.getNumChannels() <= (size_t) delayBuffer.getNumChannels());
+    jassert (output.getNumSamples() <= (size_t) maximumBlockSize);
+
+    const auto numOutputChannels = jmin (output.getNumChannels(), (size_t) delayBuffer.getNumChannels());
+    const auto numSamples = jmin (output.getNumSamples(), (size_t) maximumBlockSize);
+    const auto windowSize = lookAheadSamples + 1;
+    const auto averageScale = 1.0 / windowSize;
+    auto* g = gains.get();
+
+    // The peak level of all the channels
+    FloatVectorOperations::abs (g, input.getChannelPointer (0), (int) numSamples);
+
+    for (size_t channel = 1; channel < numOutputChannels; ++channel)
+    {
+        const auto* src = input.getChannelPointer (channel);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            g[i] = jmax (g[i], std::abs (src[i]));
+    }
+
+    // The gain that each sample needs is held for the whole look-ahead window by
+    // the sliding minimum, and then ramped to by the moving average, so that it is
+    // reached when the sample comes out of the delay line. Both only take a few
+    // operations per sample, however long the window is.
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto required = g[i] > thresholdGain ? thresholdGain / g[i] : (SampleType) 1.0;
+
+        while (minimumSize > 0)
+        {
+            const auto last = (minimumStart + minimumSize - 1) % windowSize;
+
+            if (minimumValues[last] < required)
+                break;
+
+            --minimumSize;
+        }
+
+        const auto next = (minimumStart + minimumSize) % windowSize;
+        minimumValues[next] = required;
+        minimumIndices[next] = sampleCount;
+        ++minimumSize;
+
+        if (minimumIndices[minimumStart] <= sampleCount - windowSize)
+        {
+            minimumStart = (minimumStart + 1) % windowSize;
+            --minimumSize;
+        }
+
+        const auto minimum = minimumValues[minimumStart];
+
+        averageSum += minimum - averageValues[averagePosition];
+        averageValues[averagePosition] = minimum;
+        averagePosition = (averagePosition + 1) % windowSize;
+
+        const auto target = (SampleType) (averageSum * averageScale);
+
+        currentGain = target < currentGain ? target
+                                           : target + releaseCoefficient * (currentGain - target);
+
+        g[i] = currentGain;
+        ++sampleCount;
+    }
+
+    // Ceiling at 0 dB
+    FloatVectorOperations::multiply (g, (SampleType) 1.0 / thresholdGain, (int) numSamples);
+
+    for (size_t channel = 0; channel < numOutputChannels; ++channel)
+    {
+        const auto* src = input.getChannelPointer (channel);
+        auto* dst = output.getChannelPointer (channel);
+        auto* delay = delayBuffer.getWritePointer ((int) channel);
+        auto position = delayPosition;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto delayed = delay[position];
+            delay[position] = src[i];
+            dst[i] = delayed * g[i];
+
+            if (++position == lookAheadSamples)
+                position = 0;
+        }
+
+        FloatVectorOperations::clip (dst, dst, (SampleType) -1.0, (SampleType) 1.0, (int) numSamples);
+    }
+
+    delayPosition = (int) ((delayPosition + (int64) numSamples) % lookAheadSamples);
 }
 
 //==============================================================================
@@ -95,6 +240,9 @@ void Limiter<SampleType>::update()
     gain *= Decibels::decibelsToGain (-thresholddB, (SampleType) -100.0);
 
     outputVolume.setTargetValue (gain);
+
+    thresholdGain = Decibels::decibelsToGain (thresholddB, (SampleType) -100.0);
+    releaseCoefficient = (SampleType) std::exp (-1.0 / (jmax ((double) releaseTime, 0.001) * 0.001 * sampleRate));
 }
 
 //==============================================================================
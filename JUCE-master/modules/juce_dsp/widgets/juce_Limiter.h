@@ -39,6 +39,12 @@ namespace juce::dsp
     A simple limiter with standard threshold and release time controls, featuring
     two compressors and a hard clipper at 0 dB.
 
+    Optionally, the limiter can look ahead: the audio is then delayed by the
+    look-ahead time, and the gain is brought down smoothly before each peak arrives
+    instead of relying on the clipper, using a linked gain for all the channels.
+    The cost of this mode grows linearly with the block size and doesn't depend on
+    the look-ahead time.
+
     @tags{DSP}
 */
 template <typename SampleType>
@@ -56,6 +62,25 @@ public:
     /** Sets the release time in milliseconds of the limiter.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets whether all the channels get the same amount of gain reduction.
+        @see Compressor::setLinked
+    */
+    void setLinked (bool shouldBeLinked) noexcept;
+
+    /** Sets the look-ahead time in milliseconds, or 0 to disable the look-ahead.
+
+        When the look-ahead is enabled, the output is delayed by getLatencyInSamples()
+        and the gain reduction starts early enough for no peak to exceed 0 dB. The
+        channels are always linked in this mode.
+
+        If the limiter has already been prepared, this has to allocate memory, so
+        it shouldn't be called on the audio thread.
+    */
+    void setLookAhead (SampleType newLookAheadMs);
+
+    /** Returns the number of samples by which the look-ahead delays the audio. */
+    int getLatencyInSamples() const noexcept          { return lookAheadSamples; }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -82,6 +107,12 @@ public:
             return;
         }
 
+        if (lookAheadSamples > 0)
+        {
+            processLookAhead (inputBlock, outputBlock);
+            return;
+        }
+
         firstStageCompressor.process (context);
 
         auto secondContext = ProcessContextReplacing<SampleType> (outputBlock);
@@ -99,13 +130,27 @@ public:
 private:
     //==============================================================================
     void update();
+    void prepareLookAhead();
+    void processLookAhead (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept;
 
     //==============================================================================
     Compressor<SampleType> firstStageCompressor, secondStageCompressor;
     SmoothedValue<SampleType, ValueSmoothingTypes::Linear> outputVolume;
 
+    // Look-ahead state: the delayed audio, a sliding minimum of the required gains
+    // kept as a monotonic queue, and a moving average which smooths the gain ramps
+    AudioBuffer<SampleType> delayBuffer;
+    HeapBlock<SampleType> gains, minimumValues, averageValues;
+    HeapBlock<int64> minimumIndices;
+    int delayPosition = 0, minimumStart = 0, minimumSize = 0, averagePosition = 0;
+    int64 sampleCount = 0;
+    double averageSum = 0.0;
+    SampleType currentGain = 1.0, thresholdGain = 1.0, releaseCoefficient = 0.0;
+    int lookAheadSamples = 0;
+
     double sampleRate = 44100.0;
-    SampleType thresholddB = -10.0, releaseTime = 100.0;
+    uint32 maximumBlockSize = 0, preparedChannels = 0;
+    SampleType thresholddB = -10.0, releaseTime = 100.0, lookAheadTime = 0.0;
 };
 
 } // namespace juce::dsp
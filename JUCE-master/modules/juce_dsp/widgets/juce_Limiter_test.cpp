@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class LimiterTest final : public UnitTest
+{
+public:
+    LimiterTest()
+        : UnitTest ("Limiter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float");
+        runTestsForType<double> ("double");
+    }
+
+private:
+    static constexpr uint32 numChannels = 2, blockSize = 64, numSamples = 4096;
+
+    template <typename SampleType>
+    void process (Limiter<SampleType>& limiter, AudioBuffer<SampleType>& buffer)
+    {
+        for (int start = 0; start < buffer.getNumSamples(); start += (int) blockSize)
+        {
+            auto block = AudioBlock<SampleType> (buffer).getSubBlock ((size_t) start, blockSize);
+            limiter.process (ProcessContextReplacing<SampleType> (block));
+        }
+    }
+
+    template <typename SampleType>
+    void runTestsForType (const String& typeName)
+    {
+        const auto sampleRate = 48000.0;
+
+        beginTest ("Look-ahead delays the audio (" + typeName + ")");
+        {
+            Limiter<SampleType> limiter;
+            limiter.setThreshold ((SampleType) -6.0);
+            limiter.setRelease ((SampleType) 20.0);
+            limiter.prepare ({ sampleRate, blockSize, numChannels });
+            expectEquals (limiter.getLatencyInSamples(), 0);
+
+            limiter.setLookAhead ((SampleType) 1.0);
+            expectEquals (limiter.getLatencyInSamples(), 48);
+
+            limiter.setLookAhead ((SampleType) 0.0);
+            expectEquals (limiter.getLatencyInSamples(), 0);
+
+            limiter.setLookAhead ((SampleType) 2.0);
+            expectEquals (limiter.getLatencyInSamples(), 96);
+
+            // A single loud spike comes out of the delay line at the ceiling, with no clipping needed
+            AudioBuffer<SampleType> buffer ((int) numChannels, (int) numSamples);
+            buffer.clear();
+            buffer.setSample (1, 1000, (SampleType) 4.0);
+
+            process (limiter, buffer);
+
+            expectWithinAbsoluteError (buffer.getSample (1, 1096), (SampleType) 1.0, (SampleType) 1.0e-4);
+            expectEquals (buffer.getMagnitude (0, 0, (int) numSamples), (SampleType) 0.0);
+            expectEquals (buffer.getMagnitude (1, 0, 1096), (SampleType) 0.0);
+        }
+
+        beginTest ("Look-ahead keeps the output below the ceiling (" + typeName + ")");
+        {
+            Limiter<SampleType> limiter;
+            limiter.setThreshold ((SampleType) -12.0);
+            limiter.setRelease ((SampleType) 50.0);
+            limiter.setLookAhead ((SampleType) 1.5);
+            limiter.prepare ({ sampleRate, blockSize, numChannels });
+
+            const auto latency = limiter.getLatencyInSamples();
+
+            AudioBuffer<SampleType> buffer ((int) numChannels, (int) numSamples), reference;
+            Random random (1234);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (channel, i, (SampleType) (std::sin (0.01 * i) * (random.nextDouble() * 2.0 - 1.0)
+                                                                  * (i % 1000 < 500 ? 3.0 : 0.1)));
+
+            reference.makeCopyOf (buffer);
+            process (limiter, buffer);
+
+            const auto ceiling = Decibels::decibelsToGain ((SampleType) 12.0);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                for (int i = latency; i < buffer.getNumSamples(); ++i)
+                {
+                    const auto in = reference.getSample (channel, i - latency) * ceiling;
+                    const auto out = buffer.getSample (channel, i);
+
+                    // The gain is never above the makeup gain, and the output stays below the
+                    // ceiling without relying on the clipper
+                    expect (std::abs (out) <= std::abs (in) + (SampleType) 1.0e-5);
+                    expect (std::abs (out) <= (SampleType) (1.0 + 1.0e-5));
+                }
+            }
+        }
+    }
+};
+
+static LimiterTest limiterTest;
+
+} // namespace juce::dsp
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+#if JUCE_USE_SIMD
+
+//==============================================================================
+/*  Returns exp (x) for -pi <= x <= 0. The Pade approximation is evaluated at x / 2 and
+    squared, which brings its error down to about 5e-6.
+*/
+template <typename SampleType>
+static SIMDRegister<SampleType> multiVoiceLadderCutoffTransform (SIMDRegister<SampleType> x) noexcept
+{
+    const auto halfExp = FastMathApproximations::exp (x * static_cast<SampleType> (0.5));
+    return halfExp * halfExp;
+}
+
+//==============================================================================
+template <typename SampleType>
+MultiVoiceLadderFilter<SampleType>::MultiVoiceLadderFilter()
+{
+    cutoffFreqScaler = SampleType (-2.0 * juce::MathConstants<double>::pi) / sampleRate;
+    setDrive (SampleType (1.2));
+
+    mode = Mode::LPF24;
+    setMode (Mode::LPF12);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::setMode (Mode newMode) noexcept
+{
+    if (newMode == mode)
+        return;
+
+    switch (newMode)
+    {
+        case Mode::LPF12:   A = {{ SampleType (0), SampleType (0),  SampleType (1), SampleType (0),  SampleType (0) }}; comp = SampleType (0.5);  break;
+        case Mode::HPF12:   A = {{ SampleType (1), SampleType (-2), SampleType (1), SampleType (0),  SampleType (0) }}; comp = SampleType (0);    break;
+        case Mode::BPF12:   A = {{ SampleType (0), SampleType (1), SampleType (-1), SampleType (0),  SampleType (0) }}; comp = SampleType (0.5);  break;
+        case Mode::LPF24:   A = {{ SampleType (0), SampleType (0),  SampleType (0), SampleType (0),  SampleType (1) }}; comp = SampleType (0.5);  break;
+        case Mode::HPF24:   A = {{ SampleType (1), SampleType (-4), SampleType (6), SampleType (-4), SampleType (1) }}; comp = SampleType (0);    break;
+        case Mode::BPF24:   A = {{ SampleType (0), SampleType (0),  SampleType (1), SampleType (-2), SampleType (1) }}; comp = SampleType (0.5);  break;
+        default:            jassertfalse;                                                                                                         break;
+    }
+
+    static constexpr auto outputGain = SampleType (1.2);
+
+    for (auto& a : A)
+        a *= outputGain;
+
+    mode = newMode;
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = SampleType (spec.sampleRate);
+    cutoffFreqScaler = SampleType (-2.0 * juce::MathConstants<double>::pi) / sampleRate;
+
+    static constexpr SampleType smootherRampTimeSec = SampleType (0.05);
+    rampLengthInSamples = (int) std::floor (smootherRampTimeSec * sampleRate);
+
+    numVoices = spec.numChannels;
+    groups.resize ((numVoices + numLanes - 1) / numLanes);
+    scratch.prepare (spec.maximumBlockSize);
+
+    for (auto& group : groups)
+    {
+        group.cutoff = VectorType::expand (cutoffFreqHz);
+        updateCutoffFreq (group);
+
+        group.scaledResonance.reset (sampleRate, smootherRampTimeSec);
+        group.scaledResonance.setTargetValue (getScaledResonance());
+    }
+
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::reset() noexcept
+{
+    for (auto& group : groups)
+    {
+        group.state.fill (VectorType::expand (0));
+
+        group.cutoffTransform = group.cutoffTransformTarget;
+        group.cutoffStepsRemaining = 0;
+
+        group.scaledResonance.setCurrentAndTargetValue (group.scaledResonance.getTargetValue());
+    }
+}
+
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::resetVoice (size_t voice) noexcept
+{
+    jassert (voice < numVoices);
+
+    auto& group = groups[voice / numLanes];
+    const auto lane = voice % numLanes;
+
+    for (auto& s : group.state)
+        s[lane] = 0;
+
+    group.cutoffTransform[lane] = group.cutoffTransformTarget[lane];
+    group.cutoffTransformStep[lane] = 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::setCutoffFrequencyHz (SampleType newCutoff) noexcept
+{
+    jassert (newCutoff > SampleType (0));
+    cutoffFreqHz = newCutoff;
+
+    for (auto& group : groups)
+    {
+        group.cutoff = VectorType::expand (newCutoff);
+        updateCutoffFreq (group);
+    }
+}
+
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::setCutoffFrequencyHz (size_t voice, SampleType newCutoff) noexcept
+{
+    jassert (voice < numVoices);
+    jassert (newCutoff > SampleType (0));
+
+    auto& group = groups[voice / numLanes];
+    group.cutoff[voice % numLanes] = newCutoff;
+    updateCutoffFreq (group);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::setResonance (SampleType newResonance) noexcept
+{
+    jassert (newResonance >= SampleType (0) && newResonance <= SampleType (1));
+    resonance = newResonance;
+
+    for (auto& group : groups)
+        group.scaledResonance.setTargetValue (getScaledResonance());
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::setDrive (SampleType newDrive) noexcept
+{
+    jassert (newDrive >= SampleType (1));
+
+    drive = newDrive;
+    gain = std::pow (drive, SampleType (-2.642))   * SampleType (0.6103) + SampleType (0.3903);
+    drive2 = drive                                 * SampleType (0.04)   + SampleType (0.96);
+    gain2 = std::pow (drive2, SampleType (-2.642)) * SampleType (0.6103) + SampleType (0.3903);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::processGroup (size_t groupIndex, const VectorType* input,
+                                                       VectorType* output, size_t numSamples) noexcept
+{
+    jassert (groupIndex < groups.size());
+    auto& group = groups[groupIndex];
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto cutoffTransform = getNextCutoffTransform (group);
+        output[i] = tick (group, input[i], cutoffTransform, group.scaledResonance.getNextValue());
+    }
+}
+
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::processGroup (size_t groupIndex, const VectorType* input, VectorType* output,
+                                                       const VectorType* cutoffFrequencies, size_t numSamples) noexcept
+{
+    jassert (groupIndex < groups.size());
+    auto& group = groups[groupIndex];
+
+    const auto maxCutoff = VectorType::expand (sampleRate * SampleType (0.5));
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto clamped = VectorType::min (VectorType::max (cutoffFrequencies[i], VectorType::expand (0)), maxCutoff);
+        const auto cutoffTransform = multiVoiceLadderCutoffTransform (clamped * cutoffFreqScaler);
+
+        output[i] = tick (group, input[i], cutoffTransform, group.scaledResonance.getNextValue());
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+typename MultiVoiceLadderFilter<SampleType>::VectorType
+    MultiVoiceLadderFilter<SampleType>::tick (Group& group, VectorType inputValue,
+                                              VectorType cutoffTransform, SampleType scaledResonance) const noexcept
+{
+    auto& s = group.state;
+
+    const auto a1 = cutoffTransform;
+    const auto g = a1 * SampleType (-1) + SampleType (1);
+    const auto b0 = g * SampleType (0.76923076923);
+    const auto b1 = g * SampleType (0.23076923076);
+
+    const auto dx = saturationLUT.processSample (inputValue * drive) * gain;
+    const auto a  = dx + (saturationLUT.processSample (s[4] * drive2) * gain2 - dx * comp) * (scaledResonance * SampleType (-4));
+
+    const auto b = b1 * s[0] + a1 * s[1] + b0 * a;
+    const auto c = b1 * s[1] + a1 * s[2] + b0 * b;
+    const auto d = b1 * s[2] + a1 * s[3] + b0 * c;
+    const auto e = b1 * s[3] + a1 * s[4] + b0 * d;
+
+    s[0] = a;
+    s[1] = b;
+    s[2] = c;
+    s[3] = d;
+    s[4] = e;
+
+    return a * A[0] + b * A[1] + c * A[2] + d * A[3] + e * A[4];
+}
+
+//==============================================================================
+template <typename SampleType>
+typename MultiVoiceLadderFilter<SampleType>::VectorType
+    MultiVoiceLadderFilter<SampleType>::getNextCutoffTransform (Group& group) const noexcept
+{
+    if (group.cutoffStepsRemaining <= 0)
+        return group.cutoffTransformTarget;
+
+    if (--group.cutoffStepsRemaining > 0)
+        group.cutoffTransform += group.cutoffTransformStep;
+    else
+        group.cutoffTransform = group.cutoffTransformTarget;
+
+    return group.cutoffTransform;
+}
+
+template <typename SampleType>
+void MultiVoiceLadderFilter<SampleType>::updateCutoffFreq (Group& group) noexcept
+{
+    // The transforms of the voices whose cutoff hasn't changed will have the same
+    // target, so their steps will just be recalculated to finish at the same time
+    // as the new ramp
+    for (size_t lane = 0; lane < numLanes; ++lane)
+        group.cutoffTransformTarget[lane] = std::exp (group.cutoff[lane] * cutoffFreqScaler);
+
+    if (rampLengthInSamples <= 0)
+    {
+        group.cutoffTransform = group.cutoffTransformTarget;
+        group.cutoffStepsRemaining = 0;
+        return;
+    }
+
+    group.cutoffStepsRemaining = rampLengthInSamples;
+    group.cutoffTransformStep = (group.cutoffTransformTarget - group.cutoffTransform) / (SampleType) rampLengthInSamples;
+}
+
+//==============================================================================
+template class MultiVoiceLadderFilter<float>;
+template class MultiVoiceLadderFilter<double>;
+
+#endif
+
+} // namespace juce::dsp
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+#if JUCE_USE_SIMD
+
+/**
+    A version of LadderFilter that runs many independent voices, such as the voices
+    of a polyphonic synthesiser, with one voice in each lane of a SIMDRegister.
+
+    Each voice has its own cutoff frequency and state, while the mode, resonance
+    and drive are shared. The cutoff can either be set per voice with
+    setCutoffFrequencyHz(), in which case it's smoothed in the same way as
+    LadderFilter, or modulated at audio rate by passing a block of cutoff
+    frequencies to process(), in which case the coefficients are recalculated for
+    every sample with a vectorised approximation of exp.
+
+    The voices are the channels of the blocks passed to process(). Code which keeps
+    its voices interleaved in SIMDRegisters already can call processGroup()
+    directly, where group n holds voices n * numLanes onwards.
+
+    @see LadderFilter, MultiVoiceStateVariableTPTFilter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultiVoiceLadderFilter
+{
+public:
+    //==============================================================================
+    using Mode = LadderFilterMode;
+    using VectorType = SIMDRegister<SampleType>;
+
+    /** The number of voices processed together in each SIMDRegister. */
+    static constexpr size_t numLanes = VectorType::SIMDNumElements;
+
+    //==============================================================================
+    /** Creates an uninitialised filter. Call prepare() before first use. */
+    MultiVoiceLadderFilter();
+
+    /** Enables or disables the filter. If disabled it will simply pass through the input signal. */
+    void setEnabled (bool isEnabled) noexcept    { enabled = isEnabled; }
+
+    /** Sets the filter mode of all the voices. */
+    void setMode (Mode newMode) noexcept;
+
+    /** Initialises the filter, with one voice for each channel of the spec. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Returns the number of voices that the filter was prepared for. */
+    size_t getNumVoices() const noexcept         { return numVoices; }
+
+    /** Returns the number of SIMDRegister groups that hold the voices. */
+    size_t getNumGroups() const noexcept         { return groups.size(); }
+
+    /** Resets the state of all the voices. */
+    void reset() noexcept;
+
+    /** Resets the state of a single voice, e.g. when it starts a new note. */
+    void resetVoice (size_t voice) noexcept;
+
+    /** Sets the cutoff frequency of all the voices.
+
+        @param newCutoff cutoff frequency in Hz
+    */
+    void setCutoffFrequencyHz (SampleType newCutoff) noexcept;
+
+    /** Sets the cutoff frequency of one voice.
+
+        @param voice     the index of the voice, which is the channel in process()
+        @param newCutoff cutoff frequency in Hz
+    */
+    void setCutoffFrequencyHz (size_t voice, SampleType newCutoff) noexcept;
+
+    /** Sets the resonance of all the voices.
+
+        @param newResonance a value between 0 and 1; higher values increase the resonance and can result in self oscillation!
+    */
+    void setResonance (SampleType newResonance) noexcept;
+
+    /** Sets the amount of saturation of all the voices.
+
+        @param newDrive saturation amount; it can be any number greater than or equal to one. Higher values result in more distortion.
+    */
+    void setDrive (SampleType newDrive) noexcept;
+
+    //==============================================================================
+    /** Processes the voices in the channels of the context, using the cutoff
+        frequency of each voice.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        processBlock (context, nullptr);
+    }
+
+    /** Processes the voices in the channels of the context, using a cutoff frequency
+        in Hz for every sample, taken from the same channel of cutoffFrequencies.
+
+        The frequencies are clamped to the range 0 to half the sample rate.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<const SampleType>& cutoffFrequencies) noexcept
+    {
+        processBlock (context, &cutoffFrequencies);
+    }
+
+    //==============================================================================
+    /** Processes a block of interleaved samples for one group of voices, using the
+        cutoff frequency of each voice. The input and output may be the same.
+    */
+    void processGroup (size_t group, const VectorType* input, VectorType* output, size_t numSamples) noexcept;
+
+    /** Processes a block of interleaved samples for one group of voices, with a
+        cutoff frequency in Hz for every sample. The input and output may be the same.
+    */
+    void processGroup (size_t group, const VectorType* input, VectorType* output,
+                       const VectorType* cutoffFrequencies, size_t numSamples) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr size_t numStates = 5;
+
+    struct Group
+    {
+        std::array<VectorType, numStates> state;
+        VectorType cutoff, cutoffTransform, cutoffTransformTarget, cutoffTransformStep;
+        int cutoffStepsRemaining = 0;
+        SmoothedValue<SampleType> scaledResonance;
+    };
+
+    template <typename ProcessContext>
+    void processBlock (const ProcessContext& context, const AudioBlock<const SampleType>* cutoffs) noexcept
+    {
+        if (! enabled || context.isBypassed)
+        {
+            context.getOutputBlock().copyFrom (context.getInputBlock());
+            return;
+        }
+
+        scratch.process (context, cutoffs, numVoices, [this] (size_t group, VectorType* data, const VectorType* cutoff, size_t numSamples)
+        {
+            if (cutoff != nullptr)
+                processGroup (group, data, data, cutoff, numSamples);
+            else
+                processGroup (group, data, data, numSamples);
+        });
+    }
+
+    VectorType tick (Group&, VectorType input, VectorType cutoffTransform, SampleType scaledResonance) const noexcept;
+    VectorType getNextCutoffTransform (Group&) const noexcept;
+    void updateCutoffFreq (Group&) noexcept;
+    SampleType getScaledResonance() const noexcept   { return jmap (resonance, SampleType (0.1), SampleType (1.0)); }
+
+    //==============================================================================
+    std::vector<Group> groups;
+    detail::MultiVoiceScratch<SampleType> scratch;
+    size_t numVoices = 0;
+
+    SampleType drive, drive2, gain, gain2, comp;
+    std::array<SampleType, numStates> A;
+
+    LookupTableTransform<SampleType> saturationLUT { [] (SampleType x) { return std::tanh (x); },
+                                                     SampleType (-5), SampleType (5), 128 };
+
+    SampleType cutoffFreqHz { SampleType (200) };
+    SampleType resonance { SampleType (0) };
+
+    SampleType sampleRate { SampleType (1000) }, cutoffFreqScaler;
+    int rampLengthInSamples = 0;
+
+    Mode mode;
+    bool enabled = true;
+};
+
+#endif
+
+} // namespace juce::dsp
@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class MultiVoiceLadderFilterTest final : public UnitTest
+{
+public:
+    MultiVoiceLadderFilterTest()
+        : UnitTest ("MultiVoiceLadderFilter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float",  1.0e-4f);
+        runTestsForType<double> ("double", 1.0e-9);
+    }
+
+private:
+    static constexpr uint32 numVoices = 11, maxBlockSize = 256;
+
+    template <typename SampleType>
+    void runTestsForType (const String& typeName, SampleType tolerance)
+    {
+        using Mode = LadderFilterMode;
+        const ProcessSpec spec { 48000.0, maxBlockSize, numVoices };
+        auto random = getRandom();
+
+        for (auto mode : { Mode::LPF12, Mode::HPF12, Mode::BPF12, Mode::LPF24, Mode::HPF24, Mode::BPF24 })
+        {
+            beginTest ("Per-voice cutoffs match LadderFilter (" + typeName + ")");
+
+            MultiVoiceLadderFilter<SampleType> multiVoice;
+            multiVoice.setMode (mode);
+            multiVoice.setResonance (SampleType (0.7));
+            multiVoice.setDrive (SampleType (2));
+            multiVoice.prepare (spec);
+
+            std::vector<LadderFilter<SampleType>> voices (numVoices);
+
+            for (auto& voice : voices)
+            {
+                voice.setMode (mode);
+                voice.setResonance (SampleType (0.7));
+                voice.setDrive (SampleType (2));
+                voice.prepare ({ spec.sampleRate, spec.maximumBlockSize, 1 });
+            }
+
+            AudioBuffer<SampleType> input ((int) numVoices, (int) maxBlockSize), output (input), expected (input);
+            auto maxError = SampleType (0);
+
+            // The cutoff changes are smoothed from the second block onwards
+            for (int block = 0; block < 4; ++block)
+            {
+                for (size_t v = 0; v < numVoices; ++v)
+                {
+                    const auto cutoff = SampleType (50.0 * std::pow (200.0, random.nextDouble()));
+                    multiVoice.setCutoffFrequencyHz (v, cutoff);
+                    voices[v].setCutoffFrequencyHz (cutoff);
+                }
+
+                fillWithNoise (input, random);
+
+                auto inputBlock = AudioBlock<SampleType> (input);
+                auto outputBlock = AudioBlock<SampleType> (output);
+                auto expectedBlock = AudioBlock<SampleType> (expected);
+
+                multiVoice.process (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock));
+
+                for (size_t v = 0; v < numVoices; ++v)
+                {
+                    auto voiceBlock = expectedBlock.getSingleChannelBlock (v);
+                    voices[v].process (ProcessContextNonReplacing<SampleType> (inputBlock.getSingleChannelBlock (v), voiceBlock));
+                }
+
+                maxError = jmax (maxError, getMaxDifference (output, expected));
+            }
+
+            expectLessThan (maxError, tolerance);
+        }
+
+        beginTest ("Audio-rate cutoffs (" + typeName + ")");
+        {
+            MultiVoiceLadderFilter<SampleType> fixed, modulated;
+
+            for (auto* filter : { &fixed, &modulated })
+            {
+                filter->setResonance (SampleType (0.5));
+                filter->prepare (spec);
+            }
+
+            AudioBuffer<SampleType> input ((int) numVoices, (int) maxBlockSize), output (input), expected (input), cutoffs (input);
+            fillWithNoise (input, random);
+
+            // With a constant cutoff buffer, the only difference is the approximation of exp
+            for (size_t v = 0; v < numVoices; ++v)
+            {
+                const auto cutoff = SampleType (100 * (v + 1));
+                fixed.setCutoffFrequencyHz (v, cutoff);
+
+                for (int i = 0; i < cutoffs.getNumSamples(); ++i)
+                    cutoffs.setSample ((int) v, i, cutoff);
+            }
+
+            fixed.reset();
+
+            auto inputBlock = AudioBlock<SampleType> (input);
+            auto outputBlock = AudioBlock<SampleType> (output);
+            auto expectedBlock = AudioBlock<SampleType> (expected);
+
+            fixed.process (ProcessContextNonReplacing<SampleType> (inputBlock, expectedBlock));
+            modulated.process (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock),
+                               AudioBlock<const SampleType> (cutoffs));
+
+            expectLessThan (getMaxDifference (output, expected), SampleType (1.0e-3));
+        }
+
+        beginTest ("Bypass (" + typeName + ")");
+        {
+            MultiVoiceLadderFilter<SampleType> multiVoice;
+            multiVoice.prepare (spec);
+            multiVoice.setEnabled (false);
+
+            AudioBuffer<SampleType> input ((int) numVoices, (int) maxBlockSize), output (input);
+            fillWithNoise (input, random);
+
+            auto outputBlock = AudioBlock<SampleType> (output);
+            multiVoice.process (ProcessContextNonReplacing<SampleType> (AudioBlock<SampleType> (input), outputBlock));
+            expectEquals (getMaxDifference (input, output), SampleType (0));
+        }
+    }
+
+    template <typename SampleType>
+    static SampleType getMaxDifference (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b)
+    {
+        auto maxDifference = SampleType (0);
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxDifference = jmax (maxDifference, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return maxDifference;
+    }
+
+    template <typename SampleType>
+    static void fillWithNoise (AudioBuffer<SampleType>& buffer, Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, static_cast<SampleType> (2.0f * random.nextFloat() - 1.0f));
+    }
+};
+
+static MultiVoiceLadderFilterTest multiVoiceLadderFilterTest;
+
+} // namespace juce::dsp
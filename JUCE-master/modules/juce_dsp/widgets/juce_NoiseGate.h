@@ -113,4 +113,7 @@ private:
     SampleType thresholddB = -100, ratio = 10.0, attackTime = 1.0, releaseTime = 100.0;
 };
 
+template <typename SampleType>
+struct SupportsPerSampleProcessing<NoiseGate<SampleType>>  : std::true_type {};
+
 } // namespace juce::dsp
@@ -38,6 +38,10 @@ namespace juce::dsp
 /**
     Generates a signal based on a user-supplied function.
 
+    The function isn't band-limited, so it will alias at high frequencies. For
+    band-limited waveforms, or for large numbers of oscillators, see
+    WavetableOscillatorBank.
+
     @tags{DSP}
 */
 template <typename SampleType>
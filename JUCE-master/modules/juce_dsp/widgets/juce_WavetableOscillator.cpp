@@ -0,0 +1,353 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+template <typename FloatType>
+BandLimitedWavetable<FloatType>::BandLimitedWavetable (const std::function<FloatType (FloatType)>& function, size_t size)
+    : tableSize (size)
+{
+    std::vector<FloatType> singleCycle (tableSize);
+
+    for (size_t i = 0; i < tableSize; ++i)
+        singleCycle[i] = function (static_cast<FloatType> (MathConstants<double>::twoPi * (double) i / (double) tableSize
+                                                             - MathConstants<double>::pi));
+
+    createTables (singleCycle.data());
+}
+
+template <typename FloatType>
+BandLimitedWavetable<FloatType>::BandLimitedWavetable (const FloatType* singleCycle, size_t numSamples)
+    : tableSize (numSamples)
+{
+    createTables (singleCycle);
+}
+
+template <typename FloatType>
+const FloatType* BandLimitedWavetable<FloatType>::getTable (int level) const noexcept
+{
+    jassert (isPositiveAndBelow (level, numLevels));
+    return tables.data() + (size_t) level * (tableSize + 2);
+}
+
+template <typename FloatType>
+int BandLimitedWavetable<FloatType>::getLevelForFrequency (FloatType frequencyOverSampleRate) const noexcept
+{
+    const auto maxHarmonics = static_cast<FloatType> (0.5) / frequencyOverSampleRate;
+
+    if (frequencyOverSampleRate <= 0 || maxHarmonics >= static_cast<FloatType> (getNumHarmonics (0)))
+        return 0;
+
+    const auto level = (int) std::ceil (std::log2 (static_cast<FloatType> (getNumHarmonics (0)) / maxHarmonics));
+    return jmin (level, numLevels - 1);
+}
+
+//==============================================================================
+template <typename FloatType>
+void BandLimitedWavetable<FloatType>::createTables (const FloatType* singleCycle)
+{
+    // The table size must be a power of two!
+    jassert (isPowerOfTwo (tableSize) && tableSize >= 8);
+
+    const auto order = roundToInt (std::log2 ((double) tableSize));
+    numLevels = order - 1;
+    tables.assign ((size_t) numLevels * (tableSize + 2), FloatType (0));
+
+    FFT fft (order);
+    std::vector<float> spectrum (2 * tableSize), level (2 * tableSize);
+
+    for (size_t i = 0; i < tableSize; ++i)
+        spectrum[i] = static_cast<float> (singleCycle[i]);
+
+    fft.performRealOnlyForwardTransform (spectrum.data(), true);
+
+    for (int l = 0; l < numLevels; ++l)
+    {
+        std::copy (spectrum.begin(), spectrum.end(), level.begin());
+
+        std::fill (level.begin() + (std::ptrdiff_t) (2 * (getNumHarmonics (l) + 1)), level.end(), 0.0f);
+
+        fft.performRealOnlyInverseTransform (level.data());
+
+        auto* table = tables.data() + (size_t) l * (tableSize + 2);
+
+        for (size_t i = 0; i < tableSize; ++i)
+            table[i] = static_cast<FloatType> (level[i]);
+
+        table[tableSize]     = table[0];
+        table[tableSize + 1] = table[1];
+    }
+}
+
+template class BandLimitedWavetable<float>;
+template class BandLimitedWavetable<double>;
+
+#if JUCE_USE_SIMD
+
+//==============================================================================
+template <typename SampleType>
+WavetableOscillatorBank<SampleType>::WavetableOscillatorBank (typename Wavetable::Ptr wavetableToUse)
+{
+    setWavetable (std::move (wavetableToUse));
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setWavetable (typename Wavetable::Ptr newWavetable) noexcept
+{
+    wavetable = std::move (newWavetable);
+
+    for (size_t i = 0; i < numOscillators; ++i)
+        updateIncrement (groups[i / numLanes], i % numLanes, frequenciesHz[i]);
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setFrequency (SampleType newFrequencyHz) noexcept
+{
+    defaultFrequency = newFrequencyHz;
+
+    for (size_t i = 0; i < numOscillators; ++i)
+        setFrequency (i, newFrequencyHz);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setFrequency (size_t oscillator, SampleType newFrequencyHz) noexcept
+{
+    jassert (oscillator < numOscillators);
+
+    frequenciesHz[oscillator] = newFrequencyHz;
+    updateIncrement (groups[oscillator / numLanes], oscillator % numLanes, newFrequencyHz);
+}
+
+template <typename SampleType>
+SampleType WavetableOscillatorBank<SampleType>::getFrequency (size_t oscillator) const noexcept
+{
+    jassert (oscillator < numOscillators);
+    return frequenciesHz[oscillator];
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setGain (size_t oscillator, SampleType newGain) noexcept
+{
+    jassert (oscillator < numOscillators);
+    groups[oscillator / numLanes].gain[oscillator % numLanes] = newGain;
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setPhase (size_t oscillator, SampleType newPhase) noexcept
+{
+    jassert (oscillator < numOscillators);
+    groups[oscillator / numLanes].phase[oscillator % numLanes] = newPhase - std::floor (newPhase);
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    numOscillators = spec.numChannels;
+
+    groups.assign ((numOscillators + numLanes - 1) / numLanes, {});
+    frequenciesHz.resize (numOscillators, defaultFrequency);
+
+    scratch.prepare (spec.maximumBlockSize);
+    mixBlock = AudioBlock<VectorType> (mixData, 2, spec.maximumBlockSize);
+    positionsBlock = AudioBlock<VectorType> (positionsData, 1, spec.maximumBlockSize);
+    mix.allocate (spec.maximumBlockSize, true);
+
+    for (auto& group : groups)
+    {
+        group.phase     = VectorType::expand (0);
+        group.increment = VectorType::expand (0);
+        group.levels.fill (0);
+    }
+
+    // The lanes that don't hold an oscillator have no gain, so they're silent in the mix
+    for (size_t i = 0; i < groups.size() * numLanes; ++i)
+        groups[i / numLanes].gain[i % numLanes] = i < numOscillators ? SampleType (1) : SampleType (0);
+
+    for (size_t i = 0; i < numOscillators; ++i)
+        updateIncrement (groups[i / numLanes], i % numLanes, frequenciesHz[i]);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::reset() noexcept
+{
+    for (auto& group : groups)
+        group.phase = VectorType::expand (0);
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::processGroup (size_t group, VectorType* output, size_t numSamples) noexcept
+{
+    jassert (group < groups.size());
+    render (groups[group], output, nullptr, numSamples);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::processGroup (size_t group, VectorType* output,
+                                                        const VectorType* frequencies, size_t numSamples) noexcept
+{
+    jassert (group < groups.size());
+    render (groups[group], output, frequencies, numSamples);
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::renderMix (size_t numSamples, const AudioBlock<const SampleType>* frequencies) noexcept
+{
+    jassert (numSamples <= mixBlock.getNumSamples());
+    jassert (frequencies == nullptr || (frequencies->getNumChannels() >= numOscillators
+                                         && frequencies->getNumSamples() >= numSamples));
+
+    auto* sum = mixBlock.getChannelPointer (0);
+    auto* groupFrequencies = mixBlock.getChannelPointer (1);
+    std::fill (sum, sum + numSamples, VectorType::expand (0));
+
+    for (size_t group = 0; group < groups.size(); ++group)
+    {
+        if (frequencies == nullptr)
+        {
+            render (groups[group], sum, nullptr, numSamples);
+            continue;
+        }
+
+        const auto firstOscillator = group * numLanes;
+        const auto numOscillatorsInGroup = jmin (numLanes, numOscillators - firstOscillator);
+
+        if (numOscillatorsInGroup < numLanes)
+            std::fill (groupFrequencies, groupFrequencies + numSamples, VectorType::expand (0));
+
+        detail::MultiVoiceScratch<SampleType>::interleave (groupFrequencies, *frequencies,
+                                                           firstOscillator, numOscillatorsInGroup, numSamples);
+
+        render (groups[group], sum, groupFrequencies, numSamples);
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+        mix[i] = sum[i].sum();
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::updateIncrement (Group& group, size_t lane, SampleType frequencyHz) noexcept
+{
+    const auto increment = jlimit (SampleType (0), SampleType (0.5), static_cast<SampleType> (frequencyHz / sampleRate));
+
+    group.increment[lane] = increment;
+    group.levels[lane] = wavetable != nullptr ? wavetable->getLevelForFrequency (increment) : 0;
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::render (Group& group, VectorType* output,
+                                                  const VectorType* frequencies, size_t numSamples) noexcept
+{
+    jassert (wavetable != nullptr);
+
+    const auto inverseSampleRate = static_cast<SampleType> (1.0 / sampleRate);
+    const auto nyquist = VectorType::expand (static_cast<SampleType> (sampleRate * 0.5));
+    const auto zero = VectorType::expand (0);
+    const auto one = VectorType::expand (1);
+    const auto tableSize = static_cast<SampleType> (wavetable->getTableSize());
+
+    // With audio-rate frequencies, each oscillator uses the level that suits its
+    // highest frequency in this block
+    std::array<const SampleType*, numLanes> tables;
+
+    if (frequencies != nullptr)
+    {
+        auto peak = zero;
+
+        for (size_t i = 0; i < numSamples; ++i)
+            peak = VectorType::max (peak, frequencies[i]);
+
+        peak = VectorType::min (peak, nyquist);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            tables[lane] = wavetable->getTable (wavetable->getLevelForFrequency (peak[lane] * inverseSampleRate));
+    }
+    else
+    {
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            tables[lane] = wavetable->getTable (group.levels[lane]);
+    }
+
+    // There's no gather operation, so the table positions for the block are worked out
+    // in lanes first, and then each lane does its table reads and interpolation
+    jassert (numSamples <= (size_t) positionsBlock.getNumSamples());
+    auto* positions = positionsBlock.getChannelPointer (0);
+    auto phase = group.phase;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        positions[i] = phase * tableSize;
+
+        const auto increment = frequencies != nullptr ? VectorType::min (VectorType::max (frequencies[i], zero), nyquist) * inverseSampleRate
+                                                      : group.increment;
+
+        phase += increment;
+        phase -= one & VectorType::greaterThanOrEqual (phase, one);
+    }
+
+    for (size_t lane = 0; lane < numLanes; ++lane)
+    {
+        const auto* table = tables[lane];
+        const auto gain = group.gain[lane];
+        const auto* position = reinterpret_cast<const SampleType*> (positions) + lane;
+        auto* out = reinterpret_cast<SampleType*> (output) + lane;
+
+        for (size_t i = 0; i < numSamples * numLanes; i += numLanes)
+        {
+            const auto index = (int) position[i];
+            const auto fraction = position[i] - (SampleType) index;
+            const auto* point = table + index;
+
+            out[i] += (point[0] + (point[1] - point[0]) * fraction) * gain;
+        }
+    }
+
+    group.phase = phase;
+}
+
+//==============================================================================
+template class WavetableOscillatorBank<float>;
+template class WavetableOscillatorBank<double>;
+
+#endif
+
+} // namespace juce::dsp
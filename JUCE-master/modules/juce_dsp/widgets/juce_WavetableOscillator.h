@@ -0,0 +1,302 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    A single-cycle waveform stored as a set of band-limited tables, for use with
+    WavetableOscillatorBank.
+
+    Level 0 holds the harmonics of the waveform up to a quarter of the table size,
+    so that every table is oversampled enough for linear interpolation, and each
+    following level holds half as many harmonics as the one before, down to a pure
+    sine. An oscillator then reads from the richest level whose harmonics all stay
+    below the Nyquist frequency, which avoids aliasing at any pitch.
+
+    The tables are built with an FFT when the object is created, which isn't
+    realtime safe, and can then be shared between any number of oscillators.
+
+    @tags{DSP}
+*/
+template <typename FloatType>
+class BandLimitedWavetable  : public ReferenceCountedObject
+{
+public:
+    //==============================================================================
+    using Ptr = ReferenceCountedObjectPtr<BandLimitedWavetable>;
+
+    /** Creates the tables from a periodic function with a period of -pi..pi, in the
+        same way as Oscillator.
+
+        @param function   the waveform, which is sampled at tableSize points
+        @param tableSize  the number of points in each table, which must be a power of two
+    */
+    BandLimitedWavetable (const std::function<FloatType (FloatType)>& function, size_t tableSize = 2048);
+
+    /** Creates the tables from one cycle of a waveform.
+
+        @param singleCycle  the samples of the waveform
+        @param numSamples   the length of the cycle, which must be a power of two.
+                            This is also the size of each table.
+    */
+    BandLimitedWavetable (const FloatType* singleCycle, size_t numSamples);
+
+    //==============================================================================
+    /** Returns the number of points in each table. */
+    size_t getTableSize() const noexcept                 { return tableSize; }
+
+    /** Returns the number of band-limited levels. */
+    int getNumLevels() const noexcept                    { return numLevels; }
+
+    /** Returns the highest harmonic that's present in a level. */
+    size_t getNumHarmonics (int level) const noexcept    { return (tableSize / 4) >> level; }
+
+    /** Returns the table for a level, which has getTableSize() points followed by
+        two guard points that repeat the start of the cycle.
+    */
+    const FloatType* getTable (int level) const noexcept;
+
+    /** Returns the richest level that can be played at the given frequency, expressed
+        as a fraction of the sample rate, without aliasing.
+    */
+    int getLevelForFrequency (FloatType frequencyOverSampleRate) const noexcept;
+
+private:
+    //==============================================================================
+    void createTables (const FloatType* singleCycle);
+
+    size_t tableSize = 0;
+    int numLevels = 0;
+    std::vector<FloatType> tables;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BandLimitedWavetable)
+};
+
+#if JUCE_USE_SIMD
+
+//==============================================================================
+/**
+    A bank of wavetable oscillators which all play the same BandLimitedWavetable,
+    running one oscillator in each lane of a SIMDRegister.
+
+    Unlike Oscillator, which evaluates a function for every sample, this reads
+    linearly interpolated values from the band-limited tables, so it's suitable for
+    large numbers of oscillators, such as the partials of an additive synthesiser,
+    and for high frequencies where Oscillator would alias.
+
+    Each oscillator has its own frequency, phase and gain. The frequencies can
+    either be set per oscillator, in which case changes take effect immediately, or
+    passed to process() as a block with one frequency per sample. The table level of
+    each oscillator is chosen once per block, from its highest frequency in that
+    block.
+
+    process() adds each oscillator to the matching channel of the context, and
+    processMix() adds the gain-weighted sum of all the oscillators to every channel.
+    Code which keeps its oscillators interleaved in SIMDRegisters already can call
+    processGroup() directly, where group n holds oscillators n * numLanes onwards.
+
+    @see BandLimitedWavetable, Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class WavetableOscillatorBank
+{
+public:
+    //==============================================================================
+    using VectorType = SIMDRegister<SampleType>;
+    using Wavetable = BandLimitedWavetable<SampleType>;
+
+    /** The number of oscillators processed together in each SIMDRegister. */
+    static constexpr size_t numLanes = VectorType::SIMDNumElements;
+
+    //==============================================================================
+    /** Creates a bank without a wavetable. Call setWavetable() and prepare() before first use. */
+    WavetableOscillatorBank() = default;
+
+    /** Creates a bank that plays the given wavetable. */
+    explicit WavetableOscillatorBank (typename Wavetable::Ptr wavetableToUse);
+
+    /** Sets the wavetable that all the oscillators play. */
+    void setWavetable (typename Wavetable::Ptr newWavetable) noexcept;
+
+    /** Returns the wavetable that the oscillators play. */
+    typename Wavetable::Ptr getWavetable() const noexcept   { return wavetable; }
+
+    //==============================================================================
+    /** Sets the frequency of all the oscillators, in Hz. */
+    void setFrequency (SampleType newFrequencyHz) noexcept;
+
+    /** Sets the frequency of one oscillator, in Hz. */
+    void setFrequency (size_t oscillator, SampleType newFrequencyHz) noexcept;
+
+    /** Returns the frequency of an oscillator, in Hz. */
+    SampleType getFrequency (size_t oscillator) const noexcept;
+
+    /** Sets the gain of an oscillator. The default is 1. */
+    void setGain (size_t oscillator, SampleType newGain) noexcept;
+
+    /** Sets the phase of an oscillator, as a fraction of a cycle between 0 and 1. */
+    void setPhase (size_t oscillator, SampleType newPhase) noexcept;
+
+    /** Returns the number of oscillators that the bank was prepared for. */
+    size_t getNumOscillators() const noexcept     { return numOscillators; }
+
+    /** Returns the number of SIMDRegister groups that hold the oscillators. */
+    size_t getNumGroups() const noexcept          { return groups.size(); }
+
+    //==============================================================================
+    /** Initialises the bank, with one oscillator for each channel of the spec. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the phases of all the oscillators to zero. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Adds each oscillator to the matching channel of the context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        processBlock (context, nullptr);
+    }
+
+    /** Adds each oscillator to the matching channel of the context, using a frequency
+        in Hz for every sample, taken from the same channel of frequencies.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<const SampleType>& frequencies) noexcept
+    {
+        processBlock (context, &frequencies);
+    }
+
+    /** Adds the sum of all the oscillators, weighted by their gains, to every channel
+        of the context.
+    */
+    template <typename ProcessContext>
+    void processMix (const ProcessContext& context) noexcept
+    {
+        processMixBlock (context, nullptr);
+    }
+
+    /** Adds the sum of all the oscillators, weighted by their gains, to every channel
+        of the context, using a frequency in Hz for every sample of every oscillator,
+        taken from the channels of frequencies.
+    */
+    template <typename ProcessContext>
+    void processMix (const ProcessContext& context, const AudioBlock<const SampleType>& frequencies) noexcept
+    {
+        processMixBlock (context, &frequencies);
+    }
+
+    //==============================================================================
+    /** Adds a block of interleaved samples for one group of oscillators to output. */
+    void processGroup (size_t group, VectorType* output, size_t numSamples) noexcept;
+
+    /** Adds a block of interleaved samples for one group of oscillators to output,
+        with a frequency in Hz for every sample.
+    */
+    void processGroup (size_t group, VectorType* output, const VectorType* frequencies, size_t numSamples) noexcept;
+
+private:
+    //==============================================================================
+    struct Group
+    {
+        VectorType phase, increment, gain;
+        std::array<int, numLanes> levels;
+    };
+
+    template <typename ProcessContext>
+    void processBlock (const ProcessContext& context, const AudioBlock<const SampleType>* frequencies) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        scratch.process (context, frequencies, numOscillators, [this] (size_t group, VectorType* data, const VectorType* freqs, size_t numSamples)
+        {
+            if (freqs != nullptr)
+                processGroup (group, data, freqs, numSamples);
+            else
+                processGroup (group, data, numSamples);
+        });
+    }
+
+    template <typename ProcessContext>
+    void processMixBlock (const ProcessContext& context, const AudioBlock<const SampleType>* frequencies) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom (inputBlock);
+
+        if (context.isBypassed)
+            return;
+
+        renderMix (numSamples, frequencies);
+
+        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+            FloatVectorOperations::add (outputBlock.getChannelPointer (channel), mix.getData(), (int) numSamples);
+    }
+
+    void renderMix (size_t numSamples, const AudioBlock<const SampleType>* frequencies) noexcept;
+    void updateIncrement (Group&, size_t lane, SampleType frequencyHz) noexcept;
+    void render (Group&, VectorType* output, const VectorType* frequencies, size_t numSamples) noexcept;
+
+    //==============================================================================
+    typename Wavetable::Ptr wavetable;
+    std::vector<Group> groups;
+    std::vector<SampleType> frequenciesHz;
+    detail::MultiVoiceScratch<SampleType> scratch;
+    HeapBlock<char> mixData, positionsData;
+    AudioBlock<VectorType> mixBlock, positionsBlock;
+    HeapBlock<SampleType> mix;
+    size_t numOscillators = 0;
+    SampleType defaultFrequency = static_cast<SampleType> (440.0);
+    double sampleRate = 48000.0;
+};
+
+#endif
+
+} // namespace juce::dsp
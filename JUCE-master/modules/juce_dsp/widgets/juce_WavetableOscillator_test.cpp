@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class WavetableOscillatorTest final : public UnitTest
+{
+public:
+    WavetableOscillatorTest()
+        : UnitTest ("WavetableOscillator", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float");
+        runTestsForType<double> ("double");
+    }
+
+private:
+    static constexpr uint32 numOscillators = 11, maxBlockSize = 256;
+
+    template <typename SampleType>
+    void runTestsForType (const String& typeName)
+    {
+        using Wavetable = BandLimitedWavetable<SampleType>;
+
+        const auto saw = [] (SampleType x) { return x / MathConstants<SampleType>::pi; };
+        const auto sine = [] (SampleType x) { return std::sin (x); };
+
+        beginTest ("Levels are band-limited (" + typeName + ")");
+        {
+            typename Wavetable::Ptr wavetable (new Wavetable (saw, 1024));
+            expectEquals (wavetable->getNumLevels(), 9);
+
+            for (int level = 0; level < wavetable->getNumLevels(); ++level)
+            {
+                const auto harmonics = wavetable->getNumHarmonics (level);
+                const auto* table = wavetable->getTable (level);
+
+                // The harmonics of a sawtooth have amplitudes of 2 / (pi * k), although the
+                // highest ones are slightly changed by sampling the function
+                expectWithinAbsoluteError (getHarmonicAmplitude (table, 1024, 1), SampleType (2.0 / MathConstants<double>::pi), SampleType (1.0e-3));
+                expectGreaterThan (getHarmonicAmplitude (table, 1024, harmonics), SampleType (1.0 / (MathConstants<double>::pi * (double) harmonics)));
+
+                for (auto removed = harmonics + 1; removed < 512; removed *= 2)
+                    expectLessThan (getHarmonicAmplitude (table, 1024, removed), SampleType (1.0e-5));
+            }
+
+            for (auto frequency : { 20.0, 440.0, 1000.0, 5000.0, 15000.0, 23000.0 })
+            {
+                const auto level = wavetable->getLevelForFrequency (SampleType (frequency / 48000.0));
+                expect ((double) wavetable->getNumHarmonics (level) * frequency <= 24000.0 || level == wavetable->getNumLevels() - 1);
+                expect (level == 0 || (double) wavetable->getNumHarmonics (level - 1) * frequency > 24000.0);
+            }
+        }
+
+        const ProcessSpec spec { 48000.0, maxBlockSize, numOscillators };
+        typename Wavetable::Ptr sineTable (new Wavetable (sine));
+
+        beginTest ("Oscillators match a sine (" + typeName + ")");
+        {
+            WavetableOscillatorBank<SampleType> bank (sineTable);
+            bank.prepare (spec);
+
+            for (size_t i = 0; i < numOscillators; ++i)
+                bank.setFrequency (i, SampleType (100 + 997 * i));
+
+            AudioBuffer<SampleType> output ((int) numOscillators, (int) maxBlockSize);
+            auto maxError = SampleType (0);
+
+            for (int block = 0; block < 3; ++block)
+            {
+                output.clear();
+                auto outputBlock = AudioBlock<SampleType> (output);
+                bank.process (ProcessContextReplacing<SampleType> (outputBlock));
+
+                for (int i = 0; i < output.getNumChannels(); ++i)
+                {
+                    for (int n = 0; n < output.getNumSamples(); ++n)
+                    {
+                        const auto t = (double) (block * (int) maxBlockSize + n);
+                        const auto expected = std::sin (MathConstants<double>::twoPi * (100.0 + 997.0 * i) * t / spec.sampleRate
+                                                          - MathConstants<double>::pi);
+                        maxError = jmax (maxError, (SampleType) std::abs (output.getSample (i, n) - expected));
+                    }
+                }
+            }
+
+            expectLessThan (maxError, SampleType (1.0e-3));
+        }
+
+        beginTest ("Constant frequency buffers match fixed frequencies (" + typeName + ")");
+        {
+            WavetableOscillatorBank<SampleType> fixed (sineTable), modulated (sineTable);
+            fixed.prepare (spec);
+            modulated.prepare (spec);
+
+            AudioBuffer<SampleType> frequencies ((int) numOscillators, (int) maxBlockSize), expected (frequencies), output (frequencies);
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                fixed.setFrequency (i, SampleType (55 * (i + 1)));
+
+                for (int n = 0; n < frequencies.getNumSamples(); ++n)
+                    frequencies.setSample ((int) i, n, SampleType (55 * (i + 1)));
+            }
+
+            expected.clear();
+            output.clear();
+
+            auto expectedBlock = AudioBlock<SampleType> (expected);
+            auto outputBlock = AudioBlock<SampleType> (output);
+            fixed.process (ProcessContextReplacing<SampleType> (expectedBlock));
+            modulated.process (ProcessContextReplacing<SampleType> (outputBlock), AudioBlock<const SampleType> (frequencies));
+
+            expectLessThan (getMaxDifference (output, expected), SampleType (1.0e-5));
+        }
+
+        beginTest ("Mix is the weighted sum of the oscillators (" + typeName + ")");
+        {
+            WavetableOscillatorBank<SampleType> separate (sineTable), mixed (sineTable);
+
+            for (auto* bank : { &separate, &mixed })
+            {
+                bank->prepare (spec);
+
+                for (size_t i = 0; i < numOscillators; ++i)
+                {
+                    bank->setFrequency (i, SampleType (220 * (i + 1)));
+                    bank->setGain (i, SampleType (1.0 / (double) (i + 1)));
+                    bank->setPhase (i, SampleType (0.1 * (double) i));
+                }
+            }
+
+            AudioBuffer<SampleType> channels ((int) numOscillators, (int) maxBlockSize), mix (2, (int) maxBlockSize);
+            channels.clear();
+            mix.clear();
+
+            auto channelsBlock = AudioBlock<SampleType> (channels);
+            auto mixBlock = AudioBlock<SampleType> (mix);
+            separate.process (ProcessContextReplacing<SampleType> (channelsBlock));
+            mixed.processMix (ProcessContextReplacing<SampleType> (mixBlock));
+
+            auto maxError = SampleType (0);
+
+            for (int n = 0; n < channels.getNumSamples(); ++n)
+            {
+                auto sum = SampleType (0);
+
+                for (int i = 0; i < channels.getNumChannels(); ++i)
+                    sum += channels.getSample (i, n);
+
+                for (int channel = 0; channel < mix.getNumChannels(); ++channel)
+                    maxError = jmax (maxError, std::abs (mix.getSample (channel, n) - sum));
+            }
+
+            expectLessThan (maxError, SampleType (1.0e-4));
+        }
+    }
+
+    template <typename SampleType>
+    static SampleType getHarmonicAmplitude (const SampleType* table, size_t size, size_t harmonic)
+    {
+        double re = 0, im = 0;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const auto angle = MathConstants<double>::twoPi * (double) (harmonic * i) / (double) size;
+            re += (double) table[i] * std::cos (angle);
+            im += (double) table[i] * std::sin (angle);
+        }
+
+        return static_cast<SampleType> (2.0 * std::sqrt (re * re + im * im) / (double) size);
+    }
+
+    template <typename SampleType>
+    static SampleType getMaxDifference (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b)
+    {
+        auto maxDifference = SampleType (0);
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxDifference = jmax (maxDifference, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return maxDifference;
+    }
+};
+
+static WavetableOscillatorTest wavetableOscillatorTest;
+
+} // namespace juce::dsp
@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Holds a dirty bit and an owner pointer for every BatchedAsyncUpdater.
+
+    The table is made of fixed-size chunks that are never moved or freed while the table
+    exists, so the updaters can set their bits without locking. Each chunk also has a
+    summary word with one bit for each of its words of dirty bits, so that a pass only
+    needs to look at the words that have bits set.
+*/
+class BatchedAsyncUpdater::DirtyTable
+{
+public:
+    DirtyTable() = default;
+
+    ~DirtyTable()
+    {
+        for (auto& chunk : chunks)
+            delete chunk.load();
+    }
+
+    size_t allocateIndex (BatchedAsyncUpdater* owner)
+    {
+        const ScopedLock sl (lock);
+
+        size_t index;
+
+        if (! freeIndexes.empty())
+        {
+            index = freeIndexes.back();
+            freeIndexes.pop_back();
+        }
+        else
+        {
+            index = numIndexesUsed++;
+
+            // You've created more BatchedAsyncUpdaters than the table can hold!
+            jassert (index < maxChunks * Chunk::numUpdaters);
+
+            auto& chunk = chunks[index / Chunk::numUpdaters];
+
+            if (chunk.load() == nullptr)
+                chunk = new Chunk();
+        }
+
+        getChunk (index).owners[index % Chunk::numUpdaters] = owner;
+        return index;
+    }
+
+    void releaseIndex (size_t index)
+    {
+        clear (index);
+        getChunk (index).owners[index % Chunk::numUpdaters] = nullptr;
+
+        const ScopedLock sl (lock);
+        freeIndexes.push_back (index);
+    }
+
+    bool trigger (size_t index) noexcept
+    {
+        auto& chunk = getChunk (index);
+        const auto word = (index % Chunk::numUpdaters) / 64;
+        const auto bit = getBit (index);
+
+        if ((chunk.dirty[word].fetch_or (bit) & bit) != 0)
+            return false;
+
+        chunk.summary.fetch_or (uint64 { 1 } << word);
+        return ! passPosted.exchange (true);
+    }
+
+    bool clear (size_t index) noexcept
+    {
+        const auto bit = getBit (index);
+        return (getDirtyWord (index).fetch_and (~bit) & bit) != 0;
+    }
+
+    bool isSet (size_t index) const noexcept
+    {
+        return (getDirtyWord (index).load() & getBit (index)) != 0;
+    }
+
+    void postPass()
+    {
+        if (! passMessage->post())
+            passPosted = false;
+    }
+
+private:
+    struct Chunk
+    {
+        static constexpr size_t numWords = 64;
+        static constexpr size_t numUpdaters = numWords * 64;
+
+        std::atomic<uint64> summary { 0 };
+        std::array<std::atomic<uint64>, numWords> dirty {};
+        std::array<std::atomic<BatchedAsyncUpdater*>, numUpdaters> owners {};
+    };
+
+    struct PassMessage final : public MessageManager::MessageBase
+    {
+        void messageCallback() override
+        {
+            if (auto instance = SharedResourcePointer<DirtyTable>::getSharedObjectWithoutCreating())
+                (*instance)->servicePass();
+        }
+    };
+
+    static constexpr size_t maxChunks = 256;
+
+    std::array<std::atomic<Chunk*>, maxChunks> chunks {};
+    std::atomic<bool> passPosted { false };
+    MessageManager::MessageBase::Ptr passMessage { new PassMessage() };
+
+    CriticalSection lock;
+    std::vector<size_t> freeIndexes;
+    size_t numIndexesUsed = 0;
+
+    Chunk& getChunk (size_t index) const noexcept
+    {
+        auto* chunk = chunks[index / Chunk::numUpdaters].load();
+        jassert (chunk != nullptr);
+        return *chunk;
+    }
+
+    std::atomic<uint64>& getDirtyWord (size_t index) const noexcept
+    {
+        return getChunk (index).dirty[(index % Chunk::numUpdaters) / 64];
+    }
+
+    static uint64 getBit (size_t index) noexcept
+    {
+        return uint64 { 1 } << (index % 64);
+    }
+
+    void servicePass()
+    {
+        // This is cleared before looking at any bits, so a trigger that happens during the
+        // pass will either be seen by it, or will post another one.
+        passPosted = false;
+
+        for (auto& c : chunks)
+        {
+            auto* chunk = c.load();
+
+            if (chunk == nullptr)
+                break;
+
+            for (auto summary = chunk->summary.exchange (0); summary != 0; summary &= summary - 1)
+            {
+                const auto word = getLowestBitIndex (summary);
+                auto& dirty = chunk->dirty[word];
+
+                for (auto bits = dirty.load(); bits != 0; bits &= bits - 1)
+                {
+                    const auto bit = bits & (~bits + 1);
+
+                    // Each bit is claimed just before its callback, so that an updater that gets
+                    // cancelled or deleted by an earlier callback in this pass is skipped.
+                    if ((dirty.fetch_and (~bit) & bit) == 0)
+                        continue;
+
+                    if (auto* owner = chunk->owners[word * 64 + getLowestBitIndex (bit)].load())
+                    {
+                        JUCE_TRY
+                        {
+                            owner->handleAsyncUpdate();
+                        }
+                        JUCE_CATCH_EXCEPTION
+                    }
+                }
+            }
+        }
+    }
+
+    static size_t getLowestBitIndex (uint64 value) noexcept
+    {
+        return (size_t) countNumberOfBits ((value & (~value + 1)) - 1);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirtyTable)
+};
+
+//==============================================================================
+BatchedAsyncUpdater::BatchedAsyncUpdater()
+    : index (table->allocateIndex (this))
+{
+}
+
+BatchedAsyncUpdater::~BatchedAsyncUpdater()
+{
+    // You're deleting this object with a background thread while there's an update
+    // pending on the main event thread - that's pretty dodgy threading, as the callback could
+    // happen after this destructor has finished. You should either use a MessageManagerLock while
+    // deleting this object, or find some other way to avoid such a race condition.
+    jassert ((! isUpdatePending())
+              || MessageManager::getInstanceWithoutCreating() == nullptr
+              || MessageManager::getInstanceWithoutCreating()->currentThreadHasLockedMessageManager());
+
+    table->releaseIndex (index);
+}
+
+void BatchedAsyncUpdater::triggerAsyncUpdate() noexcept
+{
+    // If you're calling this before (or after) the MessageManager is
+    // running, then you're not going to get any callbacks!
+    JUCE_ASSERT_MESSAGE_MANAGER_EXISTS
+
+    if (table->trigger (index))
+        table->postPass();
+}
+
+void BatchedAsyncUpdater::cancelPendingUpdate() noexcept
+{
+    table->clear (index);
+}
+
+void BatchedAsyncUpdater::handleUpdateNowIfNeeded()
+{
+    // This can only be called by the event thread.
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    if (table->clear (index))
+        handleAsyncUpdate();
+}
+
+bool BatchedAsyncUpdater::isUpdatePending() const noexcept
+{
+    return table->isSet (index);
+}
+
+} // namespace juce
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Has a callback method that is triggered asynchronously, like an AsyncUpdater,
+    but shares a single message with all the other BatchedAsyncUpdaters.
+
+    Triggering an AsyncUpdater posts a message for that updater, so when thousands
+    of objects (e.g. level meters) are all triggered from the audio thread, the
+    message queue ends up full of them. Triggering a BatchedAsyncUpdater just sets
+    a bit in a table shared by all BatchedAsyncUpdater objects, without taking
+    any locks. The first trigger after the table has been serviced posts one
+    message, and when that arrives the message thread calls handleAsyncUpdate()
+    on every updater that has been triggered since, in a single pass.
+
+    @see AsyncUpdater
+
+    @tags{Events}
+*/
+class JUCE_API  BatchedAsyncUpdater
+{
+public:
+    //==============================================================================
+    /** Creates a BatchedAsyncUpdater object. */
+    BatchedAsyncUpdater();
+
+    /** Destructor.
+        If there is a pending callback when the object is deleted, it is lost.
+    */
+    virtual ~BatchedAsyncUpdater();
+
+    //==============================================================================
+    /** Causes the callback to be triggered at a later time.
+
+        This method returns immediately, after which a callback to the
+        handleAsyncUpdate() method will be made by the message thread as
+        soon as possible.
+
+        If an update callback is already pending but hasn't happened yet, calling
+        this method will have no effect.
+
+        It's thread-safe to call this method from any thread, and it never locks.
+        The only exception is the first trigger of any BatchedAsyncUpdater after the
+        message thread's last pass, which posts a message to the system queue and
+        so may block. This happens at most once per pass, rather than once for
+        every updater.
+    */
+    void triggerAsyncUpdate() noexcept;
+
+    /** This will stop any pending updates from happening.
+
+        If called after triggerAsyncUpdate() and before the handleAsyncUpdate()
+        callback happens, this will cancel the handleAsyncUpdate() callback.
+    */
+    void cancelPendingUpdate() noexcept;
+
+    /** If an update has been triggered and is pending, this will invoke it
+        synchronously.
+
+        Because this may invoke the callback, this method must only be called on
+        the main event thread.
+    */
+    void handleUpdateNowIfNeeded();
+
+    /** Returns true if there's an update callback in the pipeline. */
+    bool isUpdatePending() const noexcept;
+
+    //==============================================================================
+    /** Called back to do whatever your class needs to do.
+
+        This method is called by the message thread at the next convenient time
+        after the triggerAsyncUpdate() method has been called.
+    */
+    virtual void handleAsyncUpdate() = 0;
+
+private:
+    //==============================================================================
+    class DirtyTable;
+    SharedResourcePointer<DirtyTable> table;
+    const size_t index;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchedAsyncUpdater)
+};
+
+} // namespace juce
@@ -106,7 +106,7 @@ private:
 
     friend class ChangeBroadcasterCallback;
     ChangeBroadcasterCallback broadcastCallback;
-    ListenerList <ChangeListener> changeListeners;
+    InlineListenerList<ChangeListener> changeListeners;
 
     std::atomic<bool> anyListeners { false };
 
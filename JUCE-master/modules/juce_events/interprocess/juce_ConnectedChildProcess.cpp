@@ -40,6 +40,7 @@ enum { magicCoordWorkerConnectionHeader = 0x712baf04 };
 static const char* startMessage = "__ipc_st";
 static const char* killMessage  = "__ipc_k_";
 static const char* pingMessage  = "__ipc_p_";
+static const char* sharedMemoryMessage = "__ipc_sm";
 enum { specialMessageSize = 8, defaultTimeoutMs = 8000 };
 
 static bool isMessageType (const MemoryBlock& mb, const char* messageType) noexcept
@@ -97,14 +98,89 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessPingThread)
 };
 
+//==============================================================================
+// Owns the pair of shared-memory buffers used by sendDataToWorker() and
+// sendDataToCoordinator(), and runs a thread that delivers incoming data.
+struct SharedMemoryTransport final : private Thread
+{
+    using Handler = std::function<void (Span<const std::byte>)>;
+
+    SharedMemoryTransport (std::unique_ptr<SharedMemoryRingBuffer> out,
+                           std::unique_ptr<SharedMemoryRingBuffer> in,
+                           Handler h)
+        : Thread (SystemStats::getJUCEVersion() + ": IPC shared memory"),
+          outgoing (std::move (out)), incoming (std::move (in)), handler (std::move (h))
+    {
+        startThread (Priority::high);
+    }
+
+    ~SharedMemoryTransport() override
+    {
+        signalThreadShouldExit();
+        incoming->interruptWaits();
+        stopThread (-1);
+    }
+
+    static std::unique_ptr<SharedMemoryTransport> create (const String& outgoingName, const String& incomingName,
+                                                          size_t bufferSize, Handler h)
+    {
+        auto out = SharedMemoryRingBuffer::create (outgoingName, bufferSize);
+        auto in  = SharedMemoryRingBuffer::create (incomingName, bufferSize);
+
+        if (out == nullptr || in == nullptr)
+            return {};
+
+        return std::make_unique<SharedMemoryTransport> (std::move (out), std::move (in), std::move (h));
+    }
+
+    static std::unique_ptr<SharedMemoryTransport> open (const String& outgoingName, const String& incomingName, Handler h)
+    {
+        auto out = SharedMemoryRingBuffer::open (outgoingName);
+        auto in  = SharedMemoryRingBuffer::open (incomingName);
+
+        if (out == nullptr || in == nullptr)
+            return {};
+
+        return std::make_unique<SharedMemoryTransport> (std::move (out), std::move (in), std::move (h));
+    }
+
+    const std::unique_ptr<SharedMemoryRingBuffer> outgoing, incoming;
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (! incoming->waitForData (-1))
+                continue;
+
+            while (auto data = incoming->beginRead())
+            {
+                handler (*data);
+                incoming->finishRead();
+            }
+        }
+    }
+
+    Handler handler;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryTransport)
+};
+
+static String getSharedMemoryName (const String& pipeName, bool toWorker)
+{
+    return pipeName + (toWorker ? "_cw" : "_wc");
+}
+
 //==============================================================================
 struct ChildProcessCoordinator::Connection final : public InterprocessConnection,
                                                    private ChildProcessPingThread
 {
-    Connection (ChildProcessCoordinator& m, const String& pipeName, int timeout)
+    Connection (ChildProcessCoordinator& m, const String& name, int timeout)
         : InterprocessConnection (false, magicCoordWorkerConnectionHeader),
           ChildProcessPingThread (timeout),
-          owner (m)
+          owner (m),
+          pipeName (name)
     {
         createPipe (pipeName, timeoutMs);
     }
@@ -113,10 +189,30 @@ struct ChildProcessCoordinator::Connection final : public InterprocessConnection
     {
         cancelPendingUpdate();
         stopThread (10000);
+        sharedMemory.reset();
     }
 
     using ChildProcessPingThread::startPinging;
 
+    bool enableSharedMemory (size_t bufferSize)
+    {
+        if (sharedMemory != nullptr)
+            return true;
+
+        sharedMemory = SharedMemoryTransport::create (getSharedMemoryName (pipeName, true),
+                                                      getSharedMemoryName (pipeName, false),
+                                                      bufferSize,
+                                                      [this] (Span<const std::byte> data) { owner.handleDataFromWorker (data); });
+
+        if (sharedMemory == nullptr)
+            return false;
+
+        outgoingSharedMemory = sharedMemory->outgoing.get();
+        return owner.sendMessageToWorker ({ sharedMemoryMessage, specialMessageSize });
+    }
+
+    std::atomic<SharedMemoryRingBuffer*> outgoingSharedMemory { nullptr };
+
 private:
     void connectionMade() override  {}
     void connectionLost() override  { owner.handleConnectionLost(); }
@@ -133,6 +229,8 @@ private:
     }
 
     ChildProcessCoordinator& owner;
+    const String pipeName;
+    std::unique_ptr<SharedMemoryTransport> sharedMemory;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Connection)
 };
@@ -163,6 +261,31 @@ bool ChildProcessCoordinator::sendMessageToWorker (const MemoryBlock& mb)
     return false;
 }
 
+bool ChildProcessCoordinator::enableSharedMemoryTransport (size_t bufferSizeBytes)
+{
+    if (connection != nullptr)
+        return connection->enableSharedMemory (bufferSizeBytes);
+
+    jassertfalse; // this can only be used when the connection is active!
+    return false;
+}
+
+void ChildProcessCoordinator::handleDataFromWorker (Span<const std::byte>) {}
+
+bool ChildProcessCoordinator::sendDataToWorker (const void* data, size_t numBytes, int timeoutMs)
+{
+    if (auto* buffer = getSharedMemoryToWorker())
+        return buffer->write (data, numBytes, timeoutMs);
+
+    jassertfalse; // this can only be used after calling enableSharedMemoryTransport()!
+    return false;
+}
+
+SharedMemoryRingBuffer* ChildProcessCoordinator::getSharedMemoryToWorker() const noexcept
+{
+    return connection != nullptr ? connection->outgoingSharedMemory.load() : nullptr;
+}
+
 bool ChildProcessCoordinator::launchWorkerProcess (const File& executable, const String& commandLineUniqueID,
                                                    int timeoutMs, int streamFlags)
 {
@@ -220,10 +343,11 @@ void ChildProcessCoordinator::killWorkerProcess()
 struct ChildProcessWorker::Connection final : public InterprocessConnection,
                                               private ChildProcessPingThread
 {
-    Connection (ChildProcessWorker& p, const String& pipeName, int timeout)
+    Connection (ChildProcessWorker& p, const String& name, int timeout)
         : InterprocessConnection (false, magicCoordWorkerConnectionHeader),
           ChildProcessPingThread (timeout),
-          owner (p)
+          owner (p),
+          pipeName (name)
     {
         connectToPipe (pipeName, timeoutMs);
     }
@@ -233,12 +357,30 @@ struct ChildProcessWorker::Connection final : public InterprocessConnection,
         cancelPendingUpdate();
         stopThread (10000);
         disconnect();
+        sharedMemory.reset();
     }
 
     using ChildProcessPingThread::startPinging;
 
+    std::atomic<SharedMemoryRingBuffer*> outgoingSharedMemory { nullptr };
+
 private:
     ChildProcessWorker& owner;
+    const String pipeName;
+    std::unique_ptr<SharedMemoryTransport> sharedMemory;
+
+    void openSharedMemory()
+    {
+        if (sharedMemory != nullptr)
+            return;
+
+        sharedMemory = SharedMemoryTransport::open (getSharedMemoryName (pipeName, false),
+                                                    getSharedMemoryName (pipeName, true),
+                                                    [this] (Span<const std::byte> data) { owner.handleDataFromCoordinator (data); });
+
+        if (sharedMemory != nullptr)
+            outgoingSharedMemory = sharedMemory->outgoing.get();
+    }
 
     void connectionMade() override  {}
     void connectionLost() override  { owner.handleConnectionLost(); }
@@ -259,6 +401,9 @@ private:
         if (isMessageType (m, startMessage))
             return owner.handleConnectionMade();
 
+        if (isMessageType (m, sharedMemoryMessage))
+            return openSharedMemory();
+
         owner.handleMessageFromCoordinator (m);
     }
 
@@ -288,6 +433,22 @@ bool ChildProcessWorker::sendMessageToCoordinator (const MemoryBlock& mb)
     return false;
 }
 
+void ChildProcessWorker::handleDataFromCoordinator (Span<const std::byte>) {}
+
+bool ChildProcessWorker::sendDataToCoordinator (const void* data, size_t numBytes, int timeoutMs)
+{
+    if (auto* buffer = getSharedMemoryToCoordinator())
+        return buffer->write (data, numBytes, timeoutMs);
+
+    jassertfalse; // this can only be used once the coordinator has enabled the shared-memory transport!
+    return false;
+}
+
+SharedMemoryRingBuffer* ChildProcessWorker::getSharedMemoryToCoordinator() const noexcept
+{
+    return connection != nullptr ? connection->outgoingSharedMemory.load() : nullptr;
+}
+
 bool ChildProcessWorker::initialiseFromCommandLine (const String& commandLine,
                                                     const String& commandLineUniqueID,
                                                     int timeoutMs)
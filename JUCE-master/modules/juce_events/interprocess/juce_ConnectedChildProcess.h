@@ -120,6 +120,37 @@ public:
     [[deprecated ("Replaced by sendMessageToCoordinator.")]]
     bool sendMessageToMaster (const MemoryBlock& mb) { return sendMessageToCoordinator (mb); }
 
+    //==============================================================================
+    /** This will be called to deliver a block of data that the coordinator sent with
+        ChildProcessCoordinator::sendDataToWorker().
+
+        The data is a view directly into the shared memory, and is only valid for the
+        duration of this call. The call is made on a background thread which is used only
+        for this purpose.
+
+        @see ChildProcessCoordinator::enableSharedMemoryTransport
+    */
+    virtual void handleDataFromCoordinator (Span<const std::byte> data);
+
+    /** Sends a block of data to the coordinator through shared memory, so that it arrives
+        in ChildProcessCoordinator::handleDataFromWorker().
+
+        This will only work once the coordinator has called enableSharedMemoryTransport().
+        If there's no room in the buffer, it waits for up to timeoutMs milliseconds for some
+        to become free. It must only be called by one thread at a time. Returns false if the
+        data couldn't be sent.
+    */
+    bool sendDataToCoordinator (const void* data, size_t numBytes, int timeoutMs = 0);
+
+    /** Returns the shared-memory buffer that carries data to the coordinator, or nullptr if
+        the coordinator hasn't enabled the shared-memory transport.
+
+        You can use this to write data directly into the shared memory with
+        SharedMemoryRingBuffer::beginWrite() and finishWrite(), rather than copying it in
+        with sendDataToCoordinator().
+    */
+    SharedMemoryRingBuffer* getSharedMemoryToCoordinator() const noexcept;
+
 private:
     struct Connection;
     std::unique_ptr<Connection> connection;
@@ -226,6 +257,55 @@ public:
     [[deprecated ("Replaced by sendMessageToWorker.")]]
     bool sendMessageToSlave (const MemoryBlock& mb) { return sendMessageToWorker (mb); }
 
+    //==============================================================================
+    /** Creates a pair of shared-memory buffers for sending blocks of data to and from
+        the worker without going through the messaging pipe.
+
+        This is intended for streaming large amounts of data such as audio, where the
+        copying and system calls involved in sending pipe messages would be too slow. Data
+        sent with sendDataToWorker() arrives in ChildProcessWorker::handleDataFromCoordinator(),
+        and data sent with ChildProcessWorker::sendDataToCoordinator() arrives in
+        handleDataFromWorker(), in each case as a view directly into the shared memory.
+
+        The worker process must already be running. bufferSizeBytes is the size of each of
+        the two buffers, and the largest block that can be sent is about half of this.
+        Returns true if the buffers were created, or had already been created.
+
+        @see SharedMemoryRingBuffer
+    */
+    bool enableSharedMemoryTransport (size_t bufferSizeBytes = 4 * 1024 * 1024);
+
+    /** This will be called to deliver a block of data that the worker sent with
+        ChildProcessWorker::sendDataToCoordinator().
+
+        The data is a view directly into the shared memory, and is only valid for the
+        duration of this call. The call is made on a background thread which is used only
+        for this purpose.
+
+        @see enableSharedMemoryTransport
+    */
+    virtual void handleDataFromWorker (Span<const std::byte> data);
+
+    /** Sends a block of data to the worker through shared memory, so that it arrives
+        in ChildProcessWorker::handleDataFromCoordinator().
+
+        This will only work after enableSharedMemoryTransport() has been called. Note that
+        the worker may not have opened the shared memory by the time this is called, but the
+        data will be waiting for it when it does. If there's no room in the buffer, this waits
+        for up to timeoutMs milliseconds for some to become free. It must only be called by one
+        thread at a time. Returns false if the data couldn't be sent.
+    */
+    bool sendDataToWorker (const void* data, size_t numBytes, int timeoutMs = 0);
+
+    /** Returns the shared-memory buffer that carries data to the worker, or nullptr if
+        enableSharedMemoryTransport() hasn't been called.
+
+        You can use this to write data directly into the shared memory with
+        SharedMemoryRingBuffer::beginWrite() and finishWrite(), rather than copying it in
+        with sendDataToWorker().
+    */
+    SharedMemoryRingBuffer* getSharedMemoryToWorker() const noexcept;
+
 private:
     std::shared_ptr<ChildProcess> childProcess;
 
@@ -157,9 +157,18 @@ bool InterprocessConnection::createPipe (const String& pipeName, int timeoutMs,
     return false;
 }
 
+void InterprocessConnection::setSocketReactor (SocketReactor* reactorToUse)
+{
+    // This must be called before the connection is opened!
+    jassert (socket == nullptr && pipe == nullptr);
+
+    socketReactor = reactorToUse;
+}
+
 void InterprocessConnection::disconnect (int timeoutMs, Notify notify)
 {
     thread->signalThreadShouldExit();
+    stopSocketReactorCallbacks (false);
 
     {
         const ScopedReadLock sl (pipeAndSocketLock);
@@ -214,14 +223,14 @@ bool InterprocessConnection::sendMessage (const MemoryBlock& message)
     uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
                                 ByteOrder::swapIfBigEndian ((uint32) message.getSize()) };
 
-    MemoryBlock messageData (sizeof (messageHeader) + message.getSize());
-    messageData.copyFrom (messageHeader, 0, sizeof (messageHeader));
-    messageData.copyFrom (message.getData(), sizeof (messageHeader), message.getSize());
+    PooledMemoryOutputStream messageData (sizeof (messageHeader) + message.getSize());
+    messageData.write (messageHeader, sizeof (messageHeader));
+    messageData.write (message.getData(), message.getSize());
 
-    return writeData (messageData.getData(), (int) messageData.getSize()) == (int) messageData.getSize();
+    return writeData (messageData.getData(), (int) messageData.getDataSize()) == (int) messageData.getDataSize();
 }
 
-int InterprocessConnection::writeData (void* data, int dataSize)
+int InterprocessConnection::writeData (const void* data, int dataSize)
 {
     const ScopedReadLock sl (pipeAndSocketLock);
 
@@ -240,6 +249,18 @@ void InterprocessConnection::initialise()
     safeAction->setSafe (true);
     threadIsRunning = true;
     connectionMadeInt();
+
+    if (socketReactor != nullptr && socket != nullptr)
+    {
+        isReadingHeader = true;
+        numIncomingBytes = 0;
+
+        socketIsInReactor = socketReactor->addSocket (*socket, [this] { handleSocketReadyToRead(); });
+
+        if (socketIsInReactor)
+            return;
+    }
+
     thread->startThread();
 }
 
@@ -398,6 +419,84 @@ bool InterprocessConnection::readNextMessage()
     return false;
 }
 
+// When a socket reactor is in use, the socket is only ever replaced or deleted after
+// it has been removed from the reactor, so the reactor callback can use it without locking
+void InterprocessConnection::handleSocketReadyToRead()
+{
+    auto available = socket->getNumBytesAvailable();
+
+    if (available <= 0)
+    {
+        // the socket was reported as readable but has nothing to read, so it's been closed
+        stopSocketReactorCallbacks (true);
+        connectionLostInt();
+        return;
+    }
+
+    while (available > 0 && threadIsRunning)
+    {
+        const auto numNeeded = isReadingHeader ? (int) sizeof (incomingHeader) - numIncomingBytes
+                                               : (int) incomingMessage.getSize() - numIncomingBytes;
+        auto* dest = isReadingHeader ? addBytesToPointer (incomingHeader, numIncomingBytes)
+                                     : addBytesToPointer (incomingMessage.getData(), numIncomingBytes);
+
+        const auto numRead = socket->read (dest, jmin (available, numNeeded), true);
+
+        if (numRead <= 0)
+        {
+            stopSocketReactorCallbacks (true);
+            connectionLostInt();
+            return;
+        }
+
+        available -= numRead;
+        numIncomingBytes += numRead;
+
+        if (numRead < numNeeded)
+            continue;
+
+        numIncomingBytes = 0;
+
+        if (isReadingHeader)
+        {
+            if (ByteOrder::swapIfBigEndian (incomingHeader[0]) != magicMessageHeader)
+            {
+                stopSocketReactorCallbacks (true);
+                connectionLostInt();
+                return;
+            }
+
+            const auto messageSize = (size_t) ByteOrder::swapIfBigEndian (incomingHeader[1]);
+
+            if (messageSize > 0)
+            {
+                incomingMessage.setSize (messageSize);
+                isReadingHeader = false;
+            }
+        }
+        else
+        {
+            isReadingHeader = true;
+
+            MemoryBlock message;
+            message.swapWith (incomingMessage);
+            deliverDataInt (message);
+        }
+    }
+}
+
+void InterprocessConnection::stopSocketReactorCallbacks (bool closeSocket)
+{
+    if (socketIsInReactor.exchange (false))
+    {
+        threadIsRunning = false;
+        socketReactor->removeSocket (*socket);
+
+        if (closeSocket)
+            socket->close();
+    }
+}
+
 void InterprocessConnection::runThread()
 {
     while (! thread->threadShouldExit())
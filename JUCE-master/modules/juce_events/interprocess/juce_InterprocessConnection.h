@@ -132,6 +132,24 @@ public:
     */
     bool createPipe (const String& pipeName, int pipeReceiveMessageTimeoutMs, bool mustNotExist = false);
 
+    /** Makes this connection use a SocketReactor to wait for incoming data, rather than
+        using a thread of its own.
+
+        This lets a process handle a large number of socket connections with only a few
+        threads. It must be called before the connection is made - for connections that
+        are created by an InterprocessConnectionServer, you can call it in your
+        InterprocessConnectionServer::createConnectionObject() method. The reactor must
+        outlive this connection. Passing nullptr returns to using a dedicated thread.
+
+        This only affects socket connections - a connection that uses a named pipe will
+        still use its own thread.
+
+        If callbacksOnMessageThread was false, the connectionLost() and messageReceived()
+        callbacks will be made on one of the reactor's threads, so they should return
+        quickly to avoid holding up other connections.
+    */
+    void setSocketReactor (SocketReactor* reactorToUse);
+
     /** Whether the disconnect call should trigger callbacks. */
     enum class Notify { no, yes };
 
@@ -221,6 +239,15 @@ private:
     void deliverDataInt (const MemoryBlock&);
     bool readNextMessage();
     int readData (void*, int);
+    void handleSocketReadyToRead();
+    void stopSocketReactorCallbacks (bool closeSocket);
+
+    SocketReactor* socketReactor = nullptr;
+    uint32 incomingHeader[2];
+    MemoryBlock incomingMessage;
+    int numIncomingBytes = 0;
+    bool isReadingHeader = true;
+    std::atomic<bool> socketIsInReactor { false };
 
     struct ConnectionThread;
     std::unique_ptr<ConnectionThread> thread;
@@ -230,7 +257,7 @@ private:
     std::shared_ptr<SafeAction> safeAction;
 
     void runThread();
-    int writeData (void*, int);
+    int writeData (const void*, int);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InterprocessConnection)
 };
@@ -63,6 +63,11 @@
 
 #elif JUCE_LINUX || JUCE_BSD
  #include <unistd.h>
+
+ #if JUCE_LINUX
+  #include <sys/epoll.h>
+  #include <sys/eventfd.h>
+ #endif
 #endif
 
 //==============================================================================
@@ -72,6 +77,7 @@
 #include "messages/juce_MessageManager.cpp"
 #include "broadcasters/juce_ActionBroadcaster.cpp"
 #include "broadcasters/juce_AsyncUpdater.cpp"
+#include "broadcasters/juce_BatchedAsyncUpdater.cpp"
 #include "broadcasters/juce_LockingAsyncUpdater.cpp"
 #include "broadcasters/juce_ChangeBroadcaster.cpp"
 #include "timers/juce_MultiTimer.cpp"
@@ -36,7 +36,8 @@ namespace juce
 {
 
 MessageManager::MessageManager() noexcept
-  : messageThreadId (Thread::getCurrentThreadId())
+  : messageThreadId (Thread::getCurrentThreadId()),
+    prioritisedCalls (std::make_unique<PrioritisedCallQueue>())
 {
     JUCE_VERSION_ID
 
@@ -47,6 +48,7 @@ MessageManager::MessageManager() noexcept
 MessageManager::~MessageManager() noexcept
 {
     broadcaster.reset();
+    prioritisedCalls.reset();
 
     doPlatformSpecificShutdown();
 
@@ -60,6 +62,7 @@ MessageManager* MessageManager::getInstance()
 {
     if (instance == nullptr)
     {
+        JUCE_SCOPED_INITIALISER_TRACE ("MessageManager")
         instance = new MessageManager();
         doPlatformSpecificInitialisation();
     }
@@ -91,6 +94,207 @@ bool MessageManager::MessageBase::post()
     return true;
 }
 
+bool MessageManager::MessageBase::post (Priority priority)
+{
+    return postPrioritisedCall (priority, [message = Ptr (this)] { message->messageCallback(); });
+}
+
+//==============================================================================
+class MessageManager::PrioritisedCallQueue
+{
+public:
+    PrioritisedCallQueue() = default;
+
+    ~PrioritisedCallQueue()
+    {
+        for (auto& lane : lanes)
+            deleteNodes (lane.first);
+
+        deleteNodes (freeNodes);
+    }
+
+    bool post (Priority priority, PrioritisedCall&& call)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            auto* node = freeNodes;
+
+            if (node != nullptr)
+            {
+                freeNodes = node->next;
+                --numFreeNodes;
+                node->next = nullptr;
+            }
+            else
+            {
+                node = new Node();
+            }
+
+            node->call = std::move (call);
+
+            auto& lane = lanes[(size_t) priority];
+
+            if (lane.last != nullptr)
+                lane.last->next = node;
+            else
+                lane.first = node;
+
+            lane.last = node;
+
+            if (std::exchange (batchPosted, true))
+                return true;
+        }
+
+        if (postBatchMessage())
+            return true;
+
+        const ScopedLock sl (lock);
+        batchPosted = false;
+        return false;
+    }
+
+    void deliverBatch()
+    {
+        auto endTime = Time::getMillisecondCounterHiRes() + batchTimeBudgetMs;
+
+        for (;;)
+        {
+            Node* node = nullptr;
+
+            {
+                const ScopedLock sl (lock);
+                node = popNextNode();
+
+                if (node == nullptr)
+                {
+                    batchPosted = false;
+                    return;
+                }
+            }
+
+            JUCE_TRY
+            {
+                node->call();
+            }
+            JUCE_CATCH_EXCEPTION
+
+            node->call = nullptr;
+
+            {
+                const ScopedLock sl (lock);
+                recycleNode (node);
+
+                if (Time::getMillisecondCounterHiRes() < endTime)
+                    continue;
+
+                if (std::none_of (lanes.begin(), lanes.end(), [] (const auto& l) { return l.first != nullptr; }))
+                {
+                    batchPosted = false;
+                    return;
+                }
+            }
+
+            // out of time: let the event loop catch up before delivering the rest
+            if (! postBatchMessage())
+            {
+                const ScopedLock sl (lock);
+                batchPosted = false;
+            }
+
+            return;
+        }
+    }
+
+private:
+    struct Node
+    {
+        PrioritisedCall call;
+        Node* next = nullptr;
+    };
+
+    struct Lane
+    {
+        Node* first = nullptr;
+        Node* last = nullptr;
+    };
+
+    struct BatchMessage final : public MessageBase
+    {
+        void messageCallback() override
+        {
+            if (auto* mm = MessageManager::instance)
+                if (auto* queue = mm->prioritisedCalls.get())
+                    queue->deliverBatch();
+        }
+    };
+
+    static constexpr double batchTimeBudgetMs = 4.0;
+    static constexpr int maxFreeNodes = 1024;
+
+    CriticalSection lock;
+    std::array<Lane, 4> lanes;
+    Node* freeNodes = nullptr;
+    int numFreeNodes = 0;
+    bool batchPosted = false;
+    MessageBase::Ptr batchMessage { new BatchMessage() };
+
+    bool postBatchMessage()
+    {
+        return batchMessage->post();
+    }
+
+    Node* popNextNode() noexcept
+    {
+        for (auto& lane : lanes)
+        {
+            if (auto* node = lane.first)
+            {
+                lane.first = node->next;
+
+                if (lane.first == nullptr)
+                    lane.last = nullptr;
+
+                node->next = nullptr;
+                return node;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void recycleNode (Node* node) noexcept
+    {
+        if (numFreeNodes >= maxFreeNodes)
+        {
+            delete node;
+            return;
+        }
+
+        node->next = freeNodes;
+        freeNodes = node;
+        ++numFreeNodes;
+    }
+
+    static void deleteNodes (Node* node) noexcept
+    {
+        while (node != nullptr)
+            delete std::exchange (node, node->next);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PrioritisedCallQueue)
+};
+
+bool MessageManager::postPrioritisedCall (Priority priority, PrioritisedCall&& call)
+{
+    auto* mm = MessageManager::instance;
+
+    if (mm == nullptr || mm->quitMessagePosted.get() != 0 || mm->prioritisedCalls == nullptr)
+        return false;
+
+    return mm->prioritisedCalls->post (priority, std::move (call));
+}
+
 //==============================================================================
 #if ! (JUCE_MAC || JUCE_IOS || JUCE_ANDROID)
 // implemented in platform-specific code (juce_Messaging_linux.cpp and juce_Messaging_windows.cpp)
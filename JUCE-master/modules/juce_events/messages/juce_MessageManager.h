@@ -127,6 +127,42 @@ public:
         return (new AsyncCallInvoker { std::move (function) })->post();
     }
 
+    /** The priorities that can be given to calls made with callAsync (Priority, Function&&). */
+    enum class Priority
+    {
+        input,      /**< The highest priority, for work that responds directly to user input. */
+        repaint,    /**< For work that updates what's on screen. */
+        normal,     /**< For general work. */
+        background  /**< The lowest priority, for work that can wait until nothing else is pending. */
+    };
+
+    /** Asynchronously invokes a function or C++11 lambda on the message thread, with a given priority.
+
+        Rather than posting a message to the system queue for every call, calls made with this method
+        are held in one queue per priority and delivered in batches. Each batch calls the pending
+        functions in priority order (and in the order they were posted within each priority) until
+        none are left or a few milliseconds have passed, and then returns to the event loop so that
+        input and paint events aren't held up by a flood of calls; any that remain are delivered in
+        the next batch. The storage for each call is recycled, so posting a function whose captures
+        are small doesn't need to allocate.
+
+        Calls made this way are not ordered with respect to messages posted by other means.
+
+        @param priority  the queue to add the call to
+        @param function  the function to call, which should have no arguments
+        @returns         true if the call was successfully queued, or false otherwise.
+    */
+    template <typename Function>
+    static bool callAsync (Priority priority, Function&& function)
+    {
+        using NonRef = std::remove_cv_t<std::remove_reference_t<Function>>;
+
+        if constexpr (sizeof (NonRef) <= prioritisedCallSize && alignof (NonRef) <= alignof (std::max_align_t))
+            return postPrioritisedCall (priority, PrioritisedCall { std::forward<Function> (function) });
+        else
+            return postPrioritisedCall (priority, [fn = std::make_unique<NonRef> (std::forward<Function> (function))] { (*fn)(); });
+    }
+
     /** Calls a function using the message-thread.
 
         This can be used by any thread to cause this function to be called-back
@@ -259,6 +295,11 @@ public:
         virtual void messageCallback() = 0;
         bool post();
 
+        /** Posts this message to one of the priority queues used by callAsync (Priority, Function&&),
+            rather than directly to the system queue.
+        */
+        bool post (Priority priority);
+
         using Ptr = ReferenceCountedObjectPtr<MessageBase>;
 
         JUCE_DECLARE_NON_COPYABLE (MessageBase)
@@ -426,6 +467,13 @@ private:
         }
     }
 
+    static constexpr size_t prioritisedCallSize = 64;
+    using PrioritisedCall = FixedSizeFunction<prioritisedCallSize, void()>;
+
+    class PrioritisedCallQueue;
+    std::unique_ptr<PrioritisedCallQueue> prioritisedCalls;
+
+    static bool postPrioritisedCall (Priority, PrioritisedCall&&);
     static bool postMessageToSystemQueue (MessageBase*);
     static void* exitModalLoopCallback (void*);
     static void doPlatformSpecificInitialisation();
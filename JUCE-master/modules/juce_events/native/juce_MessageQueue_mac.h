@@ -86,6 +86,9 @@ private:
         if (nextMessage == nullptr)
             return false;
 
+        JUCE_SCOPED_TRACE ("Message dispatch")
+        JUCE_TRACE_COUNTER_ADD ("Messages delivered", 1)
+
         JUCE_AUTORELEASEPOOL
         {
             JUCE_TRY
@@ -111,6 +111,9 @@ private:
             if (message == nullptr)
                 break;
 
+            JUCE_SCOPED_TRACE ("Message dispatch")
+            JUCE_TRACE_COUNTER_ADD ("Messages delivered", 1)
+
             message->messageCallback();
         }
     }
@@ -41,14 +41,24 @@ class InternalMessageQueue
 public:
     InternalMessageQueue()
     {
+       #if JUCE_LINUX
+        msgpipe[0] = msgpipe[1] = ::eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+        jassert (msgpipe[0] >= 0);
+       #else
         [[maybe_unused]] auto err = ::socketpair (AF_LOCAL, SOCK_STREAM, 0, msgpipe);
         jassert (err == 0);
+       #endif
 
         LinuxEventLoop::registerFdCallback (getReadHandle(),
                                             [this] (int fd)
                                             {
-                                                while (auto msg = popNextMessage (fd))
+                                                clearWakeup (fd);
+
+                                                while (auto msg = popNextMessage())
                                                 {
+                                                    JUCE_SCOPED_TRACE ("Message dispatch")
+                                                    JUCE_TRACE_COUNTER_ADD ("Messages delivered", 1)
+
                                                     JUCE_TRY
                                                     {
                                                         msg->messageCallback();
@@ -63,7 +73,9 @@ public:
         LinuxEventLoop::unregisterFdCallback (getReadHandle());
 
         close (getReadHandle());
-        close (getWriteHandle());
+
+        if (getWriteHandle() != getReadHandle())
+            close (getWriteHandle());
 
         clearSingletonInstance();
     }
@@ -74,13 +86,19 @@ public:
         ScopedLock sl (lock);
         queue.add (msg);
 
-        if (bytesInSocket < maxBytesInSocketQueue)
+        // Only the first message posted since the queue was last woken needs to signal
+        // the fd, as the callback delivers everything that's queued at that point. The fd
+        // is written and read with the lock held, so it's signalled exactly when
+        // wakeupPending is set.
+        if (! std::exchange (wakeupPending, true))
         {
-            bytesInSocket++;
-
-            ScopedUnlock ul (lock);
+           #if JUCE_LINUX
+            uint64_t x = 1;
+           #else
             unsigned char x = 0xff;
-            [[maybe_unused]] auto numBytes = write (getWriteHandle(), &x, 1);
+           #endif
+
+            [[maybe_unused]] auto numBytes = write (getWriteHandle(), &x, sizeof (x));
         }
     }
 
@@ -91,26 +109,32 @@ private:
     CriticalSection lock;
     ReferenceCountedArray <MessageManager::MessageBase> queue;
 
+    // On Linux both handles refer to the same eventfd
     int msgpipe[2];
-    int bytesInSocket = 0;
-    static constexpr int maxBytesInSocketQueue = 128;
+    bool wakeupPending = false;
 
     int getWriteHandle() const noexcept  { return msgpipe[0]; }
     int getReadHandle() const noexcept   { return msgpipe[1]; }
 
-    MessageManager::MessageBase::Ptr popNextMessage (int fd) noexcept
+    void clearWakeup (int fd) noexcept
     {
         const ScopedLock sl (lock);
 
-        if (bytesInSocket > 0)
+        if (std::exchange (wakeupPending, false))
         {
-            --bytesInSocket;
-
-            ScopedUnlock ul (lock);
+           #if JUCE_LINUX
+            uint64_t x;
+           #else
             unsigned char x;
-            [[maybe_unused]] auto numBytes = read (fd, &x, 1);
+           #endif
+
+            [[maybe_unused]] auto numBytes = read (fd, &x, sizeof (x));
         }
+    }
 
+    MessageManager::MessageBase::Ptr popNextMessage() noexcept
+    {
+        const ScopedLock sl (lock);
         return queue.removeAndReturn (0);
     }
 };
@@ -138,7 +162,21 @@ private:
 struct InternalRunLoop
 {
 public:
+   #if JUCE_LINUX
+    InternalRunLoop()
+        : epollFd (epoll_create1 (EPOLL_CLOEXEC))
+    {
+        jassert (epollFd >= 0);
+    }
+
+    ~InternalRunLoop()
+    {
+        if (epollFd >= 0)
+            close (epollFd);
+    }
+   #else
     InternalRunLoop() = default;
+   #endif
 
     void registerFdCallback (int fd, std::function<void()>&& cb, short eventMask)
     {
@@ -147,6 +185,15 @@ public:
 
             callbacks.emplace (fd, std::make_shared<std::function<void()>> (std::move (cb)));
 
+           #if JUCE_LINUX
+            // The poll and epoll event flags have the same values
+            epoll_event event{};
+            event.events = (uint32_t) (unsigned short) eventMask;
+            event.data.fd = fd;
+
+            if (epoll_ctl (epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+                jassertfalse;
+           #else
             const auto iter = getPollfd (fd);
 
             if (iter == pfds.end() || iter->fd != fd)
@@ -155,6 +202,7 @@ public:
                 jassertfalse;
 
             jassert (pfdsAreSorted());
+           #endif
         }
 
         listeners.call ([] (auto& l) { l.fdCallbacksChanged(); });
@@ -165,6 +213,18 @@ public:
         {
             const ScopedLock sl (lock);
 
+           #if JUCE_LINUX
+            if (callbacks.erase (fd) != 0)
+            {
+                // this fails harmlessly if the fd has already been closed, which removes it
+                // from the epoll set anyway
+                epoll_ctl (epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            }
+            else
+            {
+                jassertfalse;
+            }
+           #else
             callbacks.erase (fd);
 
             const auto iter = getPollfd (fd);
@@ -175,6 +235,7 @@ public:
                 jassertfalse;
 
             jassert (pfdsAreSorted());
+           #endif
         }
 
         listeners.call ([] (auto& l) { l.fdCallbacksChanged(); });
@@ -208,8 +269,15 @@ public:
 
     bool sleepUntilNextEvent (int timeoutMs)
     {
+       #if JUCE_LINUX
+        // The epoll set is level-triggered, so this doesn't consume the events it sees, and
+        // fds can be registered by other threads while this is waiting.
+        epoll_event event;
+        return epoll_wait (epollFd, &event, 1, timeoutMs) != 0;
+       #else
         const ScopedLock sl (lock);
         return poll (pfds.data(), static_cast<nfds_t> (pfds.size()), timeoutMs) != 0;
+       #endif
     }
 
     std::vector<int> getRegisteredFds()
@@ -241,6 +309,21 @@ private:
     */
     void getFunctionsToCallThisTime (std::vector<SharedCallback>& functions)
     {
+       #if JUCE_LINUX
+        // Only the fds that are ready are returned, so this doesn't depend on how many
+        // fds are registered.
+        const auto numReady = epoll_wait (epollFd, readyEvents.data(), (int) readyEvents.size(), 0);
+
+        const ScopedLock sl (lock);
+
+        for (int i = 0; i < numReady; ++i)
+        {
+            const auto iter = callbacks.find (readyEvents[(size_t) i].data.fd);
+
+            if (iter != callbacks.end())
+                functions.emplace_back (iter->second);
+        }
+       #else
         const ScopedLock sl (lock);
 
         if (! sleepUntilNextEvent (0))
@@ -256,8 +339,10 @@ private:
                     functions.emplace_back (iter->second);
             }
         }
+       #endif
     }
 
+   #if ! JUCE_LINUX
     std::vector<pollfd>::iterator getPollfd (int fd)
     {
         return std::lower_bound (pfds.begin(), pfds.end(), fd, [] (auto descriptor, auto toFind)
@@ -270,12 +355,19 @@ private:
     {
         return std::is_sorted (pfds.begin(), pfds.end(), [] (auto a, auto b) { return a.fd < b.fd; });
     }
+   #endif
 
     CriticalSection lock;
 
     std::map<int, SharedCallback> callbacks;
     std::vector<SharedCallback> callbackStorage;
+
+   #if JUCE_LINUX
+    int epollFd = -1;
+    std::array<epoll_event, 64> readyEvents;
+   #else
     std::vector<pollfd> pfds;
+   #endif
 
     ListenerList<LinuxEventLoopInternal::Listener> listeners;
 };
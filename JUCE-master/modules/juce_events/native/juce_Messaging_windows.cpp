@@ -198,6 +198,9 @@ private:
 
     static void dispatchMessage (MessageManager::MessageBase* message)
     {
+        JUCE_SCOPED_TRACE ("Message dispatch")
+        JUCE_TRACE_COUNTER_ADD ("Messages delivered", 1)
+
         JUCE_TRY
         {
             message->messageCallback();
@@ -89,7 +89,6 @@ public:
     TimerThread()
         : Thread (SystemStats::getJUCEVersion() + ": Timer")
     {
-        timers.reserve (32);
         ShutdownDetector::addListener (this);
     }
 
@@ -105,17 +104,11 @@ public:
 
     void run() override
     {
-        auto lastTime = Time::getMillisecondCounter();
         ReferenceCountedObjectPtr<CallTimersMessage> messageToSend (new CallTimersMessage());
 
         while (! threadShouldExit())
         {
-            auto now = Time::getMillisecondCounter();
-            auto elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                  : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
-
-            auto timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            auto timeUntilFirstTimer = getTimeUntilFirstTimer();
 
             if (timeUntilFirstTimer <= 0)
             {
@@ -141,7 +134,7 @@ public:
 
             // don't wait for too long because running this loop also helps keep the
             // Time::getApproximateMillisecondTimer value stay up-to-date
-            wait (jlimit (1, 100, timeUntilFirstTimer));
+            wait (jlimit (1, maxLookAheadMs, timeUntilFirstTimer));
         }
     }
 
@@ -151,17 +144,21 @@ public:
 
         const LockType::ScopedLockType sl (lock);
 
-        while (! timers.empty())
-        {
-            auto& first = timers.front();
+        // All the timers that are due get rescheduled relative to the same moment, so timers
+        // with the same period that fire together in this pass will keep firing together.
+        // When callbacks are aligned to a grid, that moment is the grid point this pass is
+        // servicing, so that a slightly late pass doesn't push timers back by a whole interval.
+        auto now = updateCurrentTime();
+        collectDueTimers (now);
+        auto passTime = now - getOffsetFromGrid (now);
 
-            if (first.countdownMs > 0)
-                break;
+        auto& due = queues[dueQueueIndex];
 
-            auto* timer = first.timer;
-            first.countdownMs = timer->timerPeriodMs;
-            shuffleTimerBackInQueue (0);
-            notify();
+        while (! due.empty())
+        {
+            auto* timer = due.back();
+            unlinkTimer (timer);
+            scheduleTimer (timer, passTime + timer->timerPeriodMs);
 
             const LockType::ScopedUnlockType ul (lock);
 
@@ -193,14 +190,10 @@ public:
 
         // Trying to add a timer that's already here - shouldn't get to this point,
         // so if you get this assertion, let me know!
-        jassert (std::none_of (timers.begin(), timers.end(),
-                               [t] (TimerCountdown i) { return i.timer == t; }));
-
-        auto pos = timers.size();
+        jassert (t->queueIndex < 0);
 
-        timers.push_back ({ t, t->timerPeriodMs });
-        t->positionInQueue = pos;
-        shuffleTimerForwardInQueue (pos);
+        scheduleTimer (t, updateCurrentTime() + t->timerPeriodMs);
+        ++numTimers;
         notify();
     }
 
@@ -208,56 +201,43 @@ public:
     {
         const LockType::ScopedLockType sl (lock);
 
-        auto pos = t->positionInQueue;
-        auto lastIndex = timers.size() - 1;
-
-        jassert (pos <= lastIndex);
-        jassert (timers[pos].timer == t);
-
-        for (auto i = pos; i < lastIndex; ++i)
-        {
-            timers[i] = timers[i + 1];
-            timers[i].timer->positionInQueue = i;
-        }
-
-        timers.pop_back();
+        unlinkTimer (t);
+        --numTimers;
     }
 
     void resetTimerCounter (Timer* t) noexcept
     {
         const LockType::ScopedLockType sl (lock);
 
-        auto pos = t->positionInQueue;
-
-        jassert (pos < timers.size());
-        jassert (timers[pos].timer == t);
-
-        auto lastCountdown = timers[pos].countdownMs;
-        auto newCountdown = t->timerPeriodMs;
-
-        if (newCountdown != lastCountdown)
-        {
-            timers[pos].countdownMs = newCountdown;
-
-            if (newCountdown > lastCountdown)
-                shuffleTimerBackInQueue (pos);
-            else
-                shuffleTimerForwardInQueue (pos);
+        unlinkTimer (t);
+        scheduleTimer (t, updateCurrentTime() + t->timerPeriodMs);
+        notify();
+    }
 
-            notify();
-        }
+    static void setAlignment (int intervalMs, double gridOriginMs) noexcept
+    {
+        auto& alignment = getAlignment();
+        alignment.originMs = (int64) gridOriginMs;
+        alignment.intervalMs = intervalMs;
     }
 
 private:
-    LockType lock;
+    //==============================================================================
+    // The timers live in a hashed timing wheel: each timer sits in the slot for the
+    // millisecond in which it's due (modulo the number of slots), so starting, stopping
+    // and restarting a timer never has to touch any of the others. The extra queue after
+    // the wheel holds timers that are due but haven't had their callback yet.
+    static constexpr size_t numSlots = 512;
+    static constexpr size_t dueQueueIndex = numSlots;
+    static constexpr int maxLookAheadMs = 100;
 
-    struct TimerCountdown
-    {
-        Timer* timer;
-        int countdownMs;
-    };
+    LockType lock;
+    std::array<std::vector<Timer*>, numSlots + 1> queues;
+    size_t numTimers = 0;
 
-    std::vector<TimerCountdown> timers;
+    uint32 lastCounterValue = Time::getMillisecondCounter();
+    int64 currentTimeMs = (int64) Time::getMillisecondCounterHiRes();
+    int64 firstUncollectedTimeMs = 0;
 
     WaitableEvent callbackArrived;
 
@@ -272,68 +252,135 @@ private:
         }
     };
 
+    struct Alignment
+    {
+        std::atomic<int64> originMs { 0 };
+        std::atomic<int> intervalMs { 0 };
+    };
+
+    static Alignment& getAlignment() noexcept
+    {
+        static Alignment alignment;
+        return alignment;
+    }
+
     //==============================================================================
-    void shuffleTimerBackInQueue (size_t pos)
+    int64 updateCurrentTime() noexcept
     {
-        auto numTimers = timers.size();
+        auto counter = Time::getMillisecondCounter();
+        currentTimeMs += (int64) (uint32) (counter - lastCounterValue);
+        lastCounterValue = counter;
+        return currentTimeMs;
+    }
 
-        if (pos < numTimers - 1)
-        {
-            auto t = timers[pos];
+    // Returns how far the given time is past the most recent point on the alignment grid.
+    static int64 getOffsetFromGrid (int64 time) noexcept
+    {
+        auto& alignment = getAlignment();
+        auto interval = (int64) alignment.intervalMs.load();
 
-            for (;;)
-            {
-                auto next = pos + 1;
+        if (interval <= 0)
+            return 0;
 
-                if (next == numTimers || timers[next].countdownMs >= t.countdownMs)
-                    break;
+        auto offset = (time - alignment.originMs.load()) % interval;
+        return offset < 0 ? offset + interval : offset;
+    }
 
-                timers[pos] = timers[next];
-                timers[pos].timer->positionInQueue = pos;
+    static int64 alignToGrid (int64 time) noexcept
+    {
+        auto offset = getOffsetFromGrid (time);
+        return offset == 0 ? time : time + (getAlignment().intervalMs.load() - offset);
+    }
 
-                ++pos;
-            }
+    static size_t getSlotIndex (int64 time) noexcept
+    {
+        return (size_t) time & (numSlots - 1);
+    }
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
-        }
+    void appendToQueue (Timer* t, size_t queueIndex)
+    {
+        auto& queue = queues[queueIndex];
+        t->queueIndex = (int) queueIndex;
+        t->positionInQueue = queue.size();
+        queue.push_back (t);
     }
 
-    void shuffleTimerForwardInQueue (size_t pos)
+    void scheduleTimer (Timer* t, int64 callbackTime)
     {
-        if (pos > 0)
-        {
-            auto t = timers[pos];
+        // anything earlier than this would land in a slot that has already been collected
+        t->nextCallbackTimeMs = alignToGrid (jmax (callbackTime, currentTimeMs + 1));
+        appendToQueue (t, getSlotIndex (t->nextCallbackTimeMs));
+    }
 
-            while (pos > 0)
-            {
-                auto& prev = timers[(size_t) pos - 1];
+    void unlinkTimer (Timer* t) noexcept
+    {
+        jassert (isPositiveAndNotGreaterThan (t->queueIndex, (int) dueQueueIndex));
 
-                if (prev.countdownMs <= t.countdownMs)
-                    break;
+        auto& queue = queues[(size_t) t->queueIndex];
+        auto pos = t->positionInQueue;
 
-                timers[pos] = prev;
-                timers[pos].timer->positionInQueue = pos;
+        jassert (pos < queue.size());
+        jassert (queue[pos] == t);
 
-                --pos;
-            }
+        queue[pos] = queue.back();
+        queue[pos]->positionInQueue = pos;
+        queue.pop_back();
+
+        t->queueIndex = -1;
+        t->positionInQueue = (size_t) -1;
+    }
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+    // Moves every timer that's due at or before the given time into the due queue, with
+    // the earliest ones at the back so that they get called first.
+    void collectDueTimers (int64 now)
+    {
+        auto firstTime = jmax (firstUncollectedTimeMs, now - (int64) numSlots + 1);
+
+        for (auto time = now; time >= firstTime; --time)
+        {
+            auto& slot = queues[getSlotIndex (time)];
+
+            // iterating backwards, anything swapped into position i has already been checked
+            for (auto i = slot.size(); i-- > 0;)
+            {
+                auto* t = slot[i];
+
+                if (t->nextCallbackTimeMs <= now)
+                {
+                    unlinkTimer (t);
+                    appendToQueue (t, dueQueueIndex);
+                }
+            }
         }
+
+        firstUncollectedTimeMs = now + 1;
     }
 
-    int getTimeUntilFirstTimer (int numMillisecsElapsed)
+    int getTimeUntilFirstTimer()
     {
         const LockType::ScopedLockType sl (lock);
 
-        if (timers.empty())
+        if (numTimers == 0)
             return 1000;
 
-        for (auto& t : timers)
-            t.countdownMs -= numMillisecsElapsed;
+        if (! queues[dueQueueIndex].empty())
+            return 0;
 
-        return timers.front().countdownMs;
+        auto now = updateCurrentTime();
+        auto firstTime = jmax (firstUncollectedTimeMs, now - (int64) numSlots + 1);
+
+        for (auto time = firstTime; time <= now + maxLookAheadMs; ++time)
+        {
+            for (auto* t : queues[getSlotIndex (time)])
+                if (t->nextCallbackTimeMs <= time)
+                    return (int) jmax ((int64) 0, time - now);
+
+            // nothing is due yet, so there's no need to look at these slots again
+            if (time == now)
+                firstUncollectedTimeMs = now + 1;
+        }
+
+        return maxLookAheadMs;
     }
 
     //==============================================================================
@@ -401,6 +448,12 @@ void Timer::stopTimer() noexcept
     }
 }
 
+void JUCE_CALLTYPE Timer::setCallbackAlignment (int intervalMs, double gridOriginMs)
+{
+    jassert (intervalMs >= 0);
+    TimerThread::setAlignment (jmax (0, intervalMs), gridOriginMs);
+}
+
 void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
 {
     if (auto instance = SharedResourcePointer<TimerThread>::getSharedObjectWithoutCreating())
@@ -131,6 +131,25 @@ public:
     /** Invokes a lambda after a given number of milliseconds. */
     static void JUCE_CALLTYPE callAfterDelay (int milliseconds, std::function<void()> functionToCall);
 
+    //==============================================================================
+    /** Aligns the callbacks of all timers to a common grid of times.
+
+        While an interval is set, each timer's next callback time is rounded up to the next
+        point on the grid, so timers that would otherwise fire at slightly different moments
+        become due together and are called in a single pass on the message thread. Timers
+        whose periods are multiples of the interval also stay in step with each other. The
+        price is that a callback may arrive up to intervalMs later than it otherwise would.
+
+        A typical use is to pass the display's frame interval and the timestamp of a recent
+        vertical blank (e.g. the value given to a VBlankAttachment callback, multiplied by
+        1000), so that UI timers are serviced once per frame rather than in between frames.
+
+        @param intervalMs     the spacing of the grid in milliseconds, or 0 to turn alignment off
+        @param gridOriginMs   any point on the grid, in the same units as
+                              Time::getMillisecondCounterHiRes()
+    */
+    static void JUCE_CALLTYPE setCallbackAlignment (int intervalMs, double gridOriginMs = 0.0);
+
     //==============================================================================
     /** For internal use only: invokes any timers that need callbacks.
         Don't call this unless you really know what you're doing!
@@ -140,6 +159,8 @@ public:
 private:
     class TimerThread;
     size_t positionInQueue = (size_t) -1;
+    int64 nextCallbackTimeMs = 0;
+    int queueIndex = -1;
     int timerPeriodMs = 0;
     SharedResourcePointer<TimerThread> timerThread;
 
@@ -519,6 +519,7 @@ void Graphics::drawFittedText (const String& text, int x, int y, int width, int
 void Graphics::fillRect (Rectangle<int> r) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME_RECT_I32 (etw::fillRect, etw::graphicsKeyword, context.getFrameId(), r)
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     context.fillRect (r, false);
 }
@@ -526,6 +527,7 @@ void Graphics::fillRect (Rectangle<int> r) const
 void Graphics::fillRect (Rectangle<float> r) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME_RECT_F32 (etw::fillRect, etw::graphicsKeyword, context.getFrameId(), r)
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     context.fillRect (r);
 }
@@ -533,6 +535,7 @@ void Graphics::fillRect (Rectangle<float> r) const
 void Graphics::fillRect (int x, int y, int width, int height) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME_RECT_I32 (etw::fillRect, etw::graphicsKeyword, context.getFrameId(), (Rectangle { x, y, width, height }))
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     context.fillRect (coordsToRectangle (x, y, width, height), false);
 }
@@ -547,6 +550,7 @@ void Graphics::fillRect (float x, float y, float width, float height) const
 void Graphics::fillRectList (const RectangleList<float>& rectangles) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME_RECT_F32 (etw::fillRectList, etw::graphicsKeyword, context.getFrameId(), rectangles)
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     context.fillRectList (rectangles);
 }
@@ -554,6 +558,7 @@ void Graphics::fillRectList (const RectangleList<float>& rectangles) const
 void Graphics::fillRectList (const RectangleList<int>& rects) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME_RECT_I32 (etw::fillRectList, etw::graphicsKeyword, context.getFrameId(), rects)
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     RectangleList<float> converted;
 
@@ -566,6 +571,7 @@ void Graphics::fillRectList (const RectangleList<int>& rects) const
 void Graphics::fillAll() const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME (etw::fillAll, etw::graphicsKeyword, context.getFrameId())
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     context.fillAll();
 }
@@ -573,6 +579,7 @@ void Graphics::fillAll() const
 void Graphics::fillAll (Colour colourToUse) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME (etw::fillAll, etw::graphicsKeyword, context.getFrameId())
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     if (! colourToUse.isTransparent())
     {
@@ -587,6 +594,7 @@ void Graphics::fillAll (Colour colourToUse) const
 void Graphics::fillPath (const Path& path) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME (etw::fillPath, etw::graphicsKeyword, context.getFrameId());
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     if (! (context.isClipEmpty() || path.isEmpty()))
         context.fillPath (path, AffineTransform());
@@ -595,6 +603,7 @@ void Graphics::fillPath (const Path& path) const
 void Graphics::fillPath (const Path& path, const AffineTransform& transform) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME (etw::fillPath, etw::graphicsKeyword, context.getFrameId())
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     if (! (context.isClipEmpty() || path.isEmpty()))
         context.fillPath (path, transform);
@@ -605,6 +614,7 @@ void Graphics::strokePath (const Path& path,
                            const AffineTransform& transform) const
 {
     JUCE_SCOPED_TRACE_EVENT_FRAME (etw::strokePath, etw::graphicsKeyword, context.getFrameId())
+    JUCE_RENDERING_METRICS_COUNT (fills)
 
     if (! (context.isClipEmpty() || path.isEmpty()))
         context.strokePath (path, strokeType, transform);
@@ -637,6 +647,8 @@ void Graphics::drawRect (Rectangle<float> r, const float lineThickness) const
 //==============================================================================
 void Graphics::fillEllipse (Rectangle<float> area) const
 {
+    JUCE_RENDERING_METRICS_COUNT (fills)
+
     context.fillEllipse (area);
 }
 
@@ -662,6 +674,8 @@ void Graphics::fillRoundedRectangle (float x, float y, float width, float height
 
 void Graphics::fillRoundedRectangle (Rectangle<float> r, const float cornerSize) const
 {
+    JUCE_RENDERING_METRICS_COUNT (fills)
+
     context.fillRoundedRectangle (r, cornerSize);
 }
 
@@ -892,6 +906,103 @@ public:
                 for (auto* targetType : types)
                     renderImageSubsection (*sourceType, *targetType);
         }
+
+        beginTest ("Paths with cached geometry render identically to uncached paths");
+        {
+            Path path;
+            path.addStar ({ 40.0f, 35.0f }, 7, 12.0f, 30.0f, 0.2f);
+            path.addEllipse (10.5f, 60.25f, 50.0f, 20.0f);
+
+            auto cachedPath = path;
+            cachedPath.setGeometryCachingEnabled (true);
+
+            const auto transform = AffineTransform::rotation (0.4f, 40.0f, 40.0f).translated (3.3f, 1.7f);
+            const PathStrokeType stroke (3.5f, PathStrokeType::curved, PathStrokeType::rounded);
+
+            for (auto pass = 0; pass < 2; ++pass)
+            {
+                const auto draw = [&] (const Path& p, Rectangle<int> clip)
+                {
+                    Image image { Image::ARGB, 100, 100, true, SoftwareImageType() };
+                    Graphics g { image };
+                    g.reduceClipRegion (clip);
+                    g.setColour (Colours::orange);
+                    g.fillPath (p, transform);
+                    g.setColour (Colours::darkblue.withAlpha (0.7f));
+                    g.strokePath (p, stroke, transform);
+                    return image;
+                };
+
+                // The second pass uses the cached geometry, drawn into a different clip region
+                for (const auto clip : { Rectangle { 0, 0, 100, 100 }, Rectangle { 20, 15, 37, 51 } })
+                    expect (imagesAreEqual (draw (path, clip), draw (cachedPath, clip)));
+            }
+        }
+
+        beginTest ("Shared gradient lookup tables match freshly created ones");
+        {
+            ColourGradient gradient { Colours::red, 10.0f, 10.0f, Colours::blue.withAlpha (0.5f), 90.0f, 40.0f, false };
+            gradient.addColour (0.3, Colours::yellow);
+
+            for (const auto& transform : { AffineTransform(), AffineTransform::scale (2.5f), AffineTransform::rotation (1.0f) })
+            {
+                for (auto pass = 0; pass < 2; ++pass)
+                {
+                    HeapBlock<PixelARGB> expected;
+                    const auto numEntries = gradient.createLookupTable (transform, expected);
+                    const auto table = RenderingHelpers::GradientLookupTableCache::getInstance().get (gradient, transform);
+
+                    expect ((int) table->size() == numEntries);
+                    expect (std::equal (table->begin(), table->end(), expected.get(), [] (auto a, auto b)
+                    {
+                        return a.getNativeARGB() == b.getNativeARGB();
+                    }));
+                }
+            }
+        }
+
+        beginTest ("Blurs keep solid areas solid and fade out towards the edges");
+        {
+            for (const auto format : { Image::SingleChannel, Image::RGB, Image::ARGB })
+            {
+                Image image { format, 120, 90, true, SoftwareImageType() };
+                Graphics { image }.fillAll (Colours::white);
+
+                image.getPixelData()->applyGaussianBlurEffectInArea ({ 10, 10, 100, 70 }, 8.0f);
+
+                if (format == Image::SingleChannel)
+                    image.getPixelData()->applySingleChannelBoxBlurEffectInArea ({ 10, 10, 100, 70 }, 5);
+
+                const Image::BitmapData bitmap { image, Image::BitmapData::readOnly };
+                const auto getLevel = [&] (int x, int y) { return bitmap.getPixelColour (x, y).getPixelARGB().getRed(); };
+
+                expect (getLevel (60, 45) == 0xff);
+                expect (getLevel (10, 10) < getLevel (20, 20));
+                expect (getLevel (0, 0) == 0xff);
+            }
+        }
+
+        beginTest ("Cached drop shadows match however they are clipped");
+        {
+            Path path;
+            path.addRoundedRectangle (20.3f, 15.6f, 60.0f, 40.0f, 8.0f);
+            const DropShadow shadow { Colours::black.withAlpha (0.6f), 9, { 3, 4 } };
+
+            const auto draw = [&] (Rectangle<int> clip)
+            {
+                Image image { Image::ARGB, 100, 80, true, SoftwareImageType() };
+                Graphics g { image };
+                g.reduceClipRegion (clip);
+                shadow.drawForPath (g, path);
+                return image.getClippedImage (clip);
+            };
+
+            const auto full = draw ({ 0, 0, 100, 80 });
+            expect (imagesAreEqual (full, draw ({ 0, 0, 100, 80 })));
+
+            const Rectangle<int> clip { 10, 40, 33, 25 };
+            expect (imagesAreEqual (full.getClippedImage (clip), draw (clip)));
+        }
     }
 
 private:
@@ -937,6 +1048,19 @@ private:
             expect (numFailures == 0);
         }
     }
+
+    static bool imagesAreEqual (const Image& a, const Image& b)
+    {
+        const Image::BitmapData bitmapA { a, Image::BitmapData::readOnly };
+        const Image::BitmapData bitmapB { b, Image::BitmapData::readOnly };
+
+        for (auto y = 0; y < bitmapA.height; ++y)
+            for (auto x = 0; x < bitmapA.width; ++x)
+                if (bitmapA.getPixelColour (x, y) != bitmapB.getPixelColour (x, y))
+                    return false;
+
+        return true;
+    }
 };
 
 static GraphicsTests graphicsTests;
@@ -56,4 +56,99 @@ LowLevelGraphicsSoftwareRenderer::~LowLevelGraphicsSoftwareRenderer()
     JUCE_TRACE_LOG_PAINT_CALL (etw::endGDIFrame, getFrameId());
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PixelSpanBlendingTests : public UnitTest
+{
+public:
+    PixelSpanBlendingTests() : UnitTest ("PixelSpanBlending", UnitTestCategories::graphics) {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("ARGB spans match per-pixel blending");
+        {
+            for (int width = 0; width < 40; ++width)
+            {
+                for (auto extraAlpha : { 0u, 1u, 0x7fu, 0xfeu, 0xffu, 0x100u })
+                {
+                    std::vector<PixelARGB> src, dest;
+
+                    for (int i = 0; i < width; ++i)
+                    {
+                        src.push_back (randomPremultipliedPixel (r));
+                        dest.push_back (randomPremultipliedPixel (r));
+                    }
+
+                    auto expected = dest;
+
+                    for (int i = 0; i < width; ++i)
+                    {
+                        if (extraAlpha < 0x100)
+                            expected[(size_t) i].blend (src[(size_t) i], extraAlpha);
+                        else
+                            expected[(size_t) i].blend (src[(size_t) i]);
+                    }
+
+                    RenderingHelpers::SpanBlending::blendSpan (dest.data(), src.data(), width, extraAlpha);
+                    expect (equal (dest, expected));
+                }
+            }
+        }
+
+        beginTest ("Solid colour spans match per-pixel blending");
+        {
+            for (int width = 0; width < 40; ++width)
+            {
+                const auto colour = randomPremultipliedPixel (r);
+
+                std::vector<PixelARGB> argb;
+                std::vector<PixelRGB> rgb;
+
+                for (int i = 0; i < width; ++i)
+                {
+                    argb.push_back (randomPremultipliedPixel (r));
+                    rgb.emplace_back();
+                    rgb.back().set (randomPremultipliedPixel (r));
+                }
+
+                auto expectedARGB = argb;
+                auto expectedRGB = rgb;
+
+                for (auto& p : expectedARGB)  p.blend (colour);
+                for (auto& p : expectedRGB)   p.blend (colour);
+
+                RenderingHelpers::SpanBlending::blendSolid (argb.data(), colour, width);
+                RenderingHelpers::SpanBlending::blendSolid (rgb.data(), colour, width);
+
+                expect (equal (argb, expectedARGB));
+                expect (equal (rgb, expectedRGB));
+            }
+        }
+    }
+
+private:
+    static PixelARGB randomPremultipliedPixel (Random& r)
+    {
+        PixelARGB p ((uint8) r.nextInt (256), (uint8) r.nextInt (256), (uint8) r.nextInt (256), (uint8) r.nextInt (256));
+        p.premultiply();
+        return p;
+    }
+
+    template <class PixelType>
+    static bool equal (const std::vector<PixelType>& a, const std::vector<PixelType>& b)
+    {
+        return std::equal (a.begin(), a.end(), b.begin(), b.end(), [] (const auto& x, const auto& y)
+        {
+            return x.getNativeARGB() == y.getNativeARGB();
+        });
+    }
+};
+
+static PixelSpanBlendingTests pixelSpanBlendingTests;
+
+#endif
+
 } // namespace juce
@@ -0,0 +1,487 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// Lets the tile renderers write straight into the target's pixels. Going through the
+// target's own ImagePixelData from several threads at once isn't safe, as it may send
+// change notifications each time its pixels are accessed.
+class TiledRendererTargetPixelData final : public ImagePixelData
+{
+public:
+    explicit TiledRendererTargetPixelData (const Image::BitmapData& bitmap)
+        : ImagePixelData (bitmap.pixelFormat, bitmap.width, bitmap.height),
+          data (bitmap.data),
+          lineStride (bitmap.lineStride),
+          pixelStride (bitmap.pixelStride)
+    {
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (*this));
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode) override
+    {
+        const auto offset = (size_t) x * (size_t) pixelStride + (size_t) y * (size_t) lineStride;
+        bitmap.data = data + offset;
+        bitmap.size = (size_t) (height * lineStride) - offset;
+        bitmap.pixelFormat = pixelFormat;
+        bitmap.lineStride = lineStride;
+        bitmap.pixelStride = pixelStride;
+    }
+
+    Ptr clone() override
+    {
+        auto result = SoftwareImageType().create (pixelFormat, width, height, false);
+        Image::BitmapData dest (Image { result }, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+            memcpy (dest.getLinePointer (y), data + (size_t) y * (size_t) lineStride, (size_t) (width * pixelStride));
+
+        return result;
+    }
+
+    std::unique_ptr<ImageType> createType() const override    { return std::make_unique<SoftwareImageType>(); }
+
+private:
+    uint8* data;
+    const int lineStride, pixelStride;
+};
+
+// Tracks the clip and transform while the operations are being recorded, so that queries
+// like getClipBounds() can be answered, and the area touched by each operation is known.
+// Nothing is ever drawn with it.
+class TiledRendererStateTracker final : public RenderingHelpers::StackBasedLowLevelGraphicsContext<RenderingHelpers::SoftwareRendererSavedState>
+{
+public:
+    TiledRendererStateTracker (const Image& image, const RectangleList<int>& initialClip, Point<int> origin)
+        : StackBasedLowLevelGraphicsContext (new RenderingHelpers::SoftwareRendererSavedState (image, initialClip, origin))
+    {
+    }
+
+    Rectangle<int> getDeviceClipBounds() const
+    {
+        return stack->clip != nullptr ? stack->clip->getClipBounds() : Rectangle<int>();
+    }
+
+    Rectangle<int> getDeviceBounds (Rectangle<float> userArea) const
+    {
+        return stack->transform.boundsAfterTransform (userArea)
+                               .getSmallestIntegerContainer()
+                               .expanded (1)
+                               .getIntersection (getDeviceClipBounds());
+    }
+};
+
+struct TiledRendererThreads
+{
+    ThreadPool pool { ThreadPoolOptions{}.withThreadName ("JUCE Tiled Renderer")
+                                         .withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)) };
+};
+
+// Shared between the thread that's flushing and the pool's jobs. A job that only starts
+// once every tile has been taken returns without touching anything else, so it doesn't
+// matter if it outlives the flush.
+struct TiledRendererJobs
+{
+    std::function<void (size_t)> renderTile;
+    size_t numTiles = 0;
+    std::atomic<size_t> nextTile { 0 }, numTilesDone { 0 };
+    WaitableEvent allTilesDone;
+
+    void run()
+    {
+        for (auto i = nextTile++; i < numTiles; i = nextTile++)
+        {
+            renderTile (i);
+
+            if (++numTilesDone == numTiles)
+                allTilesDone.signal();
+        }
+    }
+};
+
+//==============================================================================
+struct LowLevelGraphicsTiledSoftwareRenderer::Pimpl
+{
+    Pimpl (const Image& im, Point<int> o, const RectangleList<int>& clip, int size)
+        : image (im), origin (o), initialClip (clip), tileSize (jmax (16, size)),
+          state (im, clip, o)
+    {
+    }
+
+    enum class CommandType
+    {
+        stateChange,    // needed by every tile
+        drawing,        // only needed by the tiles that its bounds touch
+        beginLayer,     // tiles outside the layer's bounds just save their state instead..
+        endLayer        // ..and restore it here
+    };
+
+    struct Command
+    {
+        std::function<void (LowLevelGraphicsContext&)> apply;
+        Rectangle<int> deviceBounds;
+        CommandType type;
+    };
+
+    template <typename Fn>
+    void addStateChange (Fn&& fn)
+    {
+        commands.push_back ({ std::forward<Fn> (fn), {}, CommandType::stateChange });
+    }
+
+    template <typename Fn>
+    void addDrawing (Rectangle<int> deviceBounds, Fn&& fn)
+    {
+        if (! deviceBounds.isEmpty())
+            commands.push_back ({ std::forward<Fn> (fn), deviceBounds, CommandType::drawing });
+    }
+
+    void beginLayer (float opacity)
+    {
+        const auto bounds = state.getDeviceClipBounds();
+        layerBounds.push_back (bounds);
+        commands.push_back ({ [opacity] (auto& c) { c.beginTransparencyLayer (opacity); }, bounds, CommandType::beginLayer });
+
+        // A transparency layer has the same clip and transform as the state it's created
+        // from, so the tracker can treat it as a saved state rather than allocating an image.
+        state.saveState();
+    }
+
+    void endLayer()
+    {
+        jassert (! layerBounds.empty());
+        const auto bounds = layerBounds.empty() ? Rectangle<int>() : layerBounds.back();
+
+        if (! layerBounds.empty())
+            layerBounds.pop_back();
+
+        commands.push_back ({ [] (auto& c) { c.endTransparencyLayer(); }, bounds, CommandType::endLayer });
+        state.restoreState();
+    }
+
+    static bool isDrawing (const Command& c)    { return c.type == CommandType::drawing; }
+
+    void flush()
+    {
+        // A layer's contents only get composited when it ends, so nothing can be rendered
+        // while one is open
+        if (! layerBounds.empty() || std::none_of (commands.begin(), commands.end(), isDrawing))
+            return;
+
+        std::vector<Rectangle<int>> tiles;
+        const auto area = initialClip.getBounds();
+
+        for (int y = area.getY(); y < area.getBottom(); y += tileSize)
+            for (int x = area.getX(); x < area.getRight(); x += tileSize)
+                if (Rectangle<int> tile (x, y, tileSize, tileSize); initialClip.intersects (tile))
+                    tiles.push_back (tile);
+
+        const Image::BitmapData bitmap (image, Image::BitmapData::readWrite);
+        const Image target { new TiledRendererTargetPixelData (bitmap) };
+
+        auto jobs = std::make_shared<TiledRendererJobs>();
+        jobs->numTiles = tiles.size();
+        jobs->renderTile = [&] (size_t index) { renderTile (target, tiles[index]); };
+
+        const auto numJobs = jmin ((int) tiles.size() - 1, threads->pool.getNumThreads());
+
+        for (int i = 0; i < numJobs; ++i)
+            threads->pool.addJob ([jobs] { jobs->run(); });
+
+        jobs->run();
+        jobs->allTilesDone.wait();
+
+        commands.erase (std::remove_if (commands.begin(), commands.end(), isDrawing), commands.end());
+    }
+
+    void renderTile (const Image& target, Rectangle<int> tile) const
+    {
+        auto clip = initialClip;
+        clip.clipTo (tile);
+
+        LowLevelGraphicsSoftwareRenderer context (target, origin, clip);
+
+        for (auto& command : commands)
+        {
+            const auto touchesTile = command.deviceBounds.intersects (tile);
+
+            switch (command.type)
+            {
+                case CommandType::stateChange:  command.apply (context); break;
+                case CommandType::drawing:      if (touchesTile) command.apply (context); break;
+                case CommandType::beginLayer:   if (touchesTile) command.apply (context); else context.saveState(); break;
+                case CommandType::endLayer:     if (touchesTile) command.apply (context); else context.restoreState(); break;
+            }
+        }
+    }
+
+    Image image;
+    const Point<int> origin;
+    const RectangleList<int> initialClip;
+    const int tileSize;
+
+    TiledRendererStateTracker state;
+    std::vector<Command> commands;
+    std::vector<Rectangle<int>> layerBounds;
+    SharedResourcePointer<TiledRendererThreads> threads;
+};
+
+//==============================================================================
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& image, Point<int> origin,
+                                                                              const RectangleList<int>& initialClip,
+                                                                              int tileSize)
+    : pimpl (std::make_unique<Pimpl> (image, origin, initialClip, tileSize))
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    flush();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    pimpl->flush();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::isVectorDevice() const                  { return false; }
+float LowLevelGraphicsTiledSoftwareRenderer::getPhysicalPixelScaleFactor() const    { return pimpl->state.getPhysicalPixelScaleFactor(); }
+bool LowLevelGraphicsTiledSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r) { return pimpl->state.clipRegionIntersects (r); }
+Rectangle<int> LowLevelGraphicsTiledSoftwareRenderer::getClipBounds() const         { return pimpl->state.getClipBounds(); }
+bool LowLevelGraphicsTiledSoftwareRenderer::isClipEmpty() const                     { return pimpl->state.isClipEmpty(); }
+const Font& LowLevelGraphicsTiledSoftwareRenderer::getFont()                        { return pimpl->state.getFont(); }
+uint64_t LowLevelGraphicsTiledSoftwareRenderer::getFrameId() const                  { return pimpl->state.getFrameId(); }
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    pimpl->state.setOrigin (o);
+    pimpl->addStateChange ([o] (auto& c) { c.setOrigin (o); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    pimpl->state.addTransform (t);
+    pimpl->addStateChange ([t] (auto& c) { c.addTransform (t); });
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    pimpl->addStateChange ([r] (auto& c) { c.clipToRectangle (r); });
+    return pimpl->state.clipToRectangle (r);
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& r)
+{
+    pimpl->addStateChange ([r] (auto& c) { c.clipToRectangleList (r); });
+    return pimpl->state.clipToRectangleList (r);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    pimpl->state.excludeClipRectangle (r);
+    pimpl->addStateChange ([r] (auto& c) { c.excludeClipRectangle (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    pimpl->state.clipToPath (path, t);
+    pimpl->addStateChange ([path, t] (auto& c) { c.clipToPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    pimpl->state.clipToImageAlpha (im, t);
+    pimpl->addStateChange ([im, t] (auto& c) { c.clipToImageAlpha (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    pimpl->state.saveState();
+    pimpl->addStateChange ([] (auto& c) { c.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    pimpl->state.restoreState();
+    pimpl->addStateChange ([] (auto& c) { c.restoreState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    pimpl->beginLayer (opacity);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    pimpl->endLayer();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fill)
+{
+    pimpl->state.setFill (fill);
+    pimpl->addStateChange ([fill] (auto& c) { c.setFill (fill); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float opacity)
+{
+    pimpl->state.setOpacity (opacity);
+    pimpl->addStateChange ([opacity] (auto& c) { c.setOpacity (opacity); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    pimpl->state.setInterpolationQuality (quality);
+    pimpl->addStateChange ([quality] (auto& c) { c.setInterpolationQuality (quality); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& font)
+{
+    pimpl->state.setFont (font);
+    pimpl->addStateChange ([font] (auto& c) { c.setFont (font); });
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::fillAll()
+{
+    pimpl->addDrawing (pimpl->state.getDeviceClipBounds(), [] (auto& c) { c.fillAll(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (r.toFloat()),
+                       [r, replaceExistingContents] (auto& c) { c.fillRect (r, replaceExistingContents); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (r), [r] (auto& c) { c.fillRect (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (list.getBounds()), [list] (auto& c) { c.fillRectList (list); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (path.getBoundsTransformed (t)),
+                       [path, t] (auto& c) { c.fillPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawRect (const Rectangle<float>& r, float lineThickness)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (r), [r, lineThickness] (auto& c) { c.drawRect (r, lineThickness); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::strokePath (const Path& path, const PathStrokeType& strokeType, const AffineTransform& t)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceClipBounds(),
+                       [path, strokeType, t] (auto& c) { c.strokePath (path, strokeType, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (im.getBounds().toFloat().transformedBy (t)),
+                       [im, t] (auto& c) { c.drawImage (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (Rectangle<float> (line.getStart(), line.getEnd())),
+                       [line] (auto& c) { c.drawLine (line); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLineWithThickness (const Line<float>& line, float lineThickness)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (Rectangle<float> (line.getStart(), line.getEnd()).expanded (lineThickness)),
+                       [line, lineThickness] (auto& c) { c.drawLineWithThickness (line, lineThickness); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyphs (Span<const uint16_t> glyphs,
+                                                        Span<const Point<float>> positions,
+                                                        const AffineTransform& t)
+{
+    jassert (glyphs.size() == positions.size());
+
+    const auto& font = pimpl->state.getFont();
+    auto bounds = pimpl->state.getDeviceClipBounds();
+
+    if (auto typeface = font.getTypefacePtr())
+    {
+        const auto glyphScale = AffineTransform::scale (font.getHeight() * font.getHorizontalScale(), font.getHeight());
+        Rectangle<float> glyphBounds;
+
+        for (const auto [index, glyph] : enumerate (glyphs))
+            glyphBounds = glyphBounds.getUnion (typeface->getGlyphBounds (font.getMetricsKind(), glyph)
+                                                         .transformedBy (glyphScale)
+                                                         + positions[(size_t) index]);
+
+        bounds = pimpl->state.getDeviceBounds (glyphBounds.transformedBy (t));
+    }
+
+    pimpl->addDrawing (bounds,
+                       [g = std::vector<uint16_t> (glyphs.begin(), glyphs.end()),
+                        p = std::vector<Point<float>> (positions.begin(), positions.end()),
+                        t] (auto& c) { c.drawGlyphs (g, p, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawRoundedRectangle (const Rectangle<float>& r, float cornerSize, float lineThickness)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (r.expanded (lineThickness)),
+                       [r, cornerSize, lineThickness] (auto& c) { c.drawRoundedRectangle (r, cornerSize, lineThickness); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRoundedRectangle (const Rectangle<float>& r, float cornerSize)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (r), [r, cornerSize] (auto& c) { c.fillRoundedRectangle (r, cornerSize); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawEllipse (const Rectangle<float>& area, float lineThickness)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (area.expanded (lineThickness)),
+                       [area, lineThickness] (auto& c) { c.drawEllipse (area, lineThickness); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillEllipse (const Rectangle<float>& area)
+{
+    pimpl->addDrawing (pimpl->state.getDeviceBounds (area), [area] (auto& c) { c.fillEllipse (area); });
+}
+
+} // namespace juce
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A LowLevelGraphicsContext that renders into an image in memory like the
+    LowLevelGraphicsSoftwareRenderer, but spreads the work over several threads.
+
+    Instead of drawing immediately, this context records each drawing operation it's
+    given, noting which area of the image the operation can touch. When the context is
+    deleted (or flush() is called), the area being painted is divided into square tiles,
+    and each tile is rendered by a LowLevelGraphicsSoftwareRenderer on a worker thread
+    that replays the recorded operations, skipping any that can't affect that tile.
+    Every pixel belongs to exactly one tile and is produced by the same sequence of
+    operations whatever the number of threads, so the output is deterministic.
+
+    Because the drawing is deferred, any images passed to drawImage() or clipToImageAlpha()
+    must not be modified until the frame has been rendered.
+
+    To use this for a window's painting, return one of these from
+    LookAndFeel::createGraphicsContext().
+
+    @see LowLevelGraphicsSoftwareRenderer
+
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer  : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into a clipped subsection of an image.
+
+        @param imageToRenderOnto   the image to draw into
+        @param origin              the position within the image of the context's origin
+        @param initialClip         the region of the image that may be drawn to
+        @param tileSize            the width and height, in pixels, of the tiles that the
+                                   region is divided into for rendering
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           int tileSize = 128);
+
+    /** Destructor. Renders anything that has been drawn since the last flush(). */
+    ~LowLevelGraphicsTiledSoftwareRenderer() override;
+
+    /** Renders all the operations that have been recorded so far into the image.
+
+        This blocks until all the tiles have been rendered. The context's current state
+        (clip, transform, fill, etc.) is kept, so drawing can continue afterwards. If a
+        transparency layer has been started but not yet ended, this does nothing.
+    */
+    void flush();
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() const override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillAll() override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawRect (const Rectangle<float>&, float lineThickness) override;
+    void strokePath (const Path&, const PathStrokeType&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void drawLineWithThickness (const Line<float>&, float lineThickness) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyphs (Span<const uint16_t>, Span<const Point<float>>, const AffineTransform&) override;
+    void drawRoundedRectangle (const Rectangle<float>&, float cornerSize, float lineThickness) override;
+    void fillRoundedRectangle (const Rectangle<float>&, float cornerSize) override;
+    void drawEllipse (const Rectangle<float>&, float lineThickness) override;
+    void fillEllipse (const Rectangle<float>&) override;
+    uint64_t getFrameId() const override;
+
+private:
+    //==============================================================================
+    struct Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_RENDERING_METRICS
+
+namespace juce
+{
+
+//==============================================================================
+class RenderingMetrics::Connection  : public InterprocessConnection
+{
+public:
+    explicit Connection (RenderingMetrics& ownerIn)
+        : InterprocessConnection (false, magicNumber),
+          owner (ownerIn)
+    {
+    }
+
+    ~Connection() override
+    {
+        disconnect();
+    }
+
+    void connectionMade() override {}
+
+    void connectionLost() override
+    {
+        lost = true;
+    }
+
+    void messageReceived (const MemoryBlock& message) override
+    {
+        owner.handleRequest (*this, message.toString().trim());
+    }
+
+    void send (const var& json)
+    {
+        const auto text = JSON::toString (json, JSON::FormatOptions{}.withSpacing (JSON::Spacing::none));
+        sendMessage (MemoryBlock (text.toRawUTF8(), text.getNumBytesAsUTF8()));
+    }
+
+    std::atomic<bool> lost { false };
+
+private:
+    RenderingMetrics& owner;
+};
+
+class RenderingMetrics::Server  : public InterprocessConnectionServer
+{
+public:
+    explicit Server (RenderingMetrics& ownerIn) : owner (ownerIn) {}
+
+    ~Server() override
+    {
+        stop();
+    }
+
+    InterprocessConnection* createConnectionObject() override
+    {
+        auto connection = std::make_unique<Connection> (owner);
+        auto* result = connection.get();
+
+        const ScopedLock sl (owner.streamingLock);
+        owner.connections.push_back (std::move (connection));
+        return result;
+    }
+
+private:
+    RenderingMetrics& owner;
+};
+
+//==============================================================================
+RenderingMetrics::RenderingMetrics() = default;
+
+RenderingMetrics::~RenderingMetrics()
+{
+    stopStreaming();
+    clearSingletonInstance();
+}
+
+const char* RenderingMetrics::getStatName (Stat stat) noexcept
+{
+   #define JUCE_RENDERING_METRICS_STAT(name) #name,
+    static const char* const names[] { JUCE_RENDERING_METRICS_STAT_LIST };
+   #undef JUCE_RENDERING_METRICS_STAT
+
+    return isPositiveAndBelow ((int) stat, (int) numStats) ? names[stat] : "";
+}
+
+var RenderingMetrics::Values::toVar() const
+{
+    auto* object = new DynamicObject();
+    object->setProperty ("count", (int64) count);
+    object->setProperty ("total", total);
+    object->setProperty ("average", average);
+    object->setProperty ("minimum", minimum);
+    object->setProperty ("maximum", maximum);
+    object->setProperty ("standardDeviation", standardDeviation);
+    return object;
+}
+
+var RenderingMetrics::Snapshot::toVar() const
+{
+    auto* rendererObject = new DynamicObject();
+
+    for (const auto& [name, stats] : renderers)
+    {
+        auto* statsObject = new DynamicObject();
+
+        for (int i = 0; i < numStats; ++i)
+            statsObject->setProperty (getStatName ((Stat) i), stats[(size_t) i].toVar());
+
+        rendererObject->setProperty (name, statsObject);
+    }
+
+    auto* componentObject = new DynamicObject();
+
+    for (const auto& [name, values] : components)
+        componentObject->setProperty (name, values.toVar());
+
+    auto* result = new DynamicObject();
+    result->setProperty ("renderers", rendererObject);
+    result->setProperty ("components", componentObject);
+    return result;
+}
+
+RenderingMetrics::Values RenderingMetrics::Accumulator::getValues() const
+{
+    Values v;
+    v.count = stats.getCount();
+
+    if (v.count > 0)
+    {
+        v.total = total;
+        v.average = stats.getAverage();
+        v.minimum = stats.getMinValue();
+        v.maximum = stats.getMaxValue();
+        v.standardDeviation = stats.getStandardDeviation();
+    }
+
+    return v;
+}
+
+RenderingMetrics::Snapshot RenderingMetrics::getSnapshot() const
+{
+    const ScopedLock sl (lock);
+    Snapshot result;
+
+    for (const auto& [name, accumulators] : renderers)
+    {
+        auto& stats = result.renderers[name];
+
+        for (size_t i = 0; i < stats.size(); ++i)
+            stats[i] = accumulators[i].getValues();
+    }
+
+    for (const auto& [name, accumulator] : components)
+        result.components[name] = accumulator.getValues();
+
+    return result;
+}
+
+void RenderingMetrics::reset()
+{
+    const ScopedLock sl (lock);
+    renderers.clear();
+    components.clear();
+    frameComponentPaintTime = 0;
+
+    for (auto& c : frameCounts)
+        c = 0;
+}
+
+//==============================================================================
+void RenderingMetrics::addFrame (const String& rendererName, double milliseconds)
+{
+    std::array<int, numStats> counts {};
+    double componentMilliseconds = 0;
+
+    for (size_t i = fills; i < counts.size(); ++i)
+        counts[i] = frameCounts[i].exchange (0, std::memory_order_relaxed);
+
+    {
+        const ScopedLock sl (lock);
+        componentMilliseconds = std::exchange (frameComponentPaintTime, 0.0);
+
+        auto& accumulators = renderers[rendererName];
+        accumulators[framePaintTime].add (milliseconds);
+        accumulators[componentPaintTime].add (componentMilliseconds);
+
+        for (size_t i = fills; i < counts.size(); ++i)
+            accumulators[i].add ((double) counts[i]);
+    }
+
+    const ScopedLock sl (streamingLock);
+
+    // Connections can't delete themselves from their own thread, so they're removed here
+    connections.erase (std::remove_if (connections.begin(), connections.end(),
+                                       [] (const auto& c) { return c->lost.load(); }),
+                       connections.end());
+
+    if (connections.empty())
+        return;
+
+    auto* frame = new DynamicObject();
+    frame->setProperty ("renderer", rendererName);
+    frame->setProperty (getStatName (framePaintTime), milliseconds);
+    frame->setProperty (getStatName (componentPaintTime), componentMilliseconds);
+
+    for (size_t i = fills; i < counts.size(); ++i)
+        frame->setProperty (getStatName ((Stat) i), counts[i]);
+
+    const var json (frame);
+
+    for (auto& c : connections)
+        if (c->isConnected())
+            c->send (json);
+}
+
+void RenderingMetrics::addComponentPaint (const String& componentName, double milliseconds)
+{
+    const ScopedLock sl (lock);
+    components[componentName].add (milliseconds);
+    frameComponentPaintTime += milliseconds;
+}
+
+//==============================================================================
+int RenderingMetrics::startStreaming (int portNumber)
+{
+    stopStreaming();
+
+    auto newServer = std::make_unique<Server> (*this);
+
+    if (! newServer->beginWaitingForSocket (portNumber, "127.0.0.1"))
+        return 0;
+
+    server = std::move (newServer);
+    return server->getBoundPort();
+}
+
+void RenderingMetrics::stopStreaming()
+{
+    // The server must stop before the connections go, in case it's creating a new one
+    server.reset();
+
+    const ScopedLock sl (streamingLock);
+    connections.clear();
+}
+
+void RenderingMetrics::handleRequest (Connection& connection, const String& request)
+{
+    if (request == "snapshot")
+        connection.send (getSnapshot().toVar());
+    else if (request == "reset")
+        reset();
+}
+
+} // namespace juce
+
+#endif
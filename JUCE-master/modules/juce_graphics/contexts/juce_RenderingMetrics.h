@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_RENDERING_METRICS
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Collects paint-timing statistics from whichever renderer is in use.
+
+    This is only available when JUCE_RENDERING_METRICS is enabled. The software,
+    CoreGraphics, Direct2D and OpenGL renderers report the time taken by each frame,
+    the time spent in each component's paint() and paintOverChildren() methods,
+    and per-frame counts of fills, glyph cache hits and misses, image uploads and, for
+    the OpenGL renderer, draw calls.
+
+    The results can be read at any time with getSnapshot(), or streamed to another
+    process with startStreaming().
+
+    Frame counters are shared by all windows, so if several windows (or an OpenGL
+    render thread) paint at the same moment, their counts may be attributed to
+    whichever frame finishes first.
+
+    @tags{Graphics}
+*/
+class JUCE_API  RenderingMetrics  : public DeletedAtShutdown
+{
+public:
+    //==============================================================================
+   #define JUCE_RENDERING_METRICS_STAT_LIST \
+        JUCE_RENDERING_METRICS_STAT (framePaintTime) \
+        JUCE_RENDERING_METRICS_STAT (componentPaintTime) \
+        JUCE_RENDERING_METRICS_STAT (fills) \
+        JUCE_RENDERING_METRICS_STAT (glyphCacheHits) \
+        JUCE_RENDERING_METRICS_STAT (glyphCacheMisses) \
+        JUCE_RENDERING_METRICS_STAT (imageUploads) \
+        JUCE_RENDERING_METRICS_STAT (drawCalls)
+
+   #define JUCE_RENDERING_METRICS_STAT(name) name,
+    /** The statistics that are gathered for each frame. The times are in milliseconds.
+        The componentPaintTime is the part of the frame that was spent inside components'
+        own paint methods, and the other values are counts.
+    */
+    enum Stat
+    {
+        JUCE_RENDERING_METRICS_STAT_LIST
+        numStats
+    };
+   #undef JUCE_RENDERING_METRICS_STAT
+
+    /** Returns the name of a statistic, as used in the JSON output. */
+    static const char* getStatName (Stat stat) noexcept;
+
+    //==============================================================================
+    /** A summary of the values that have been recorded for one statistic. */
+    struct Values
+    {
+        size_t count = 0;
+        double total = 0, average = 0, minimum = 0, maximum = 0, standardDeviation = 0;
+
+        var toVar() const;
+    };
+
+    /** All the statistics gathered since the last reset, for each renderer. */
+    struct Snapshot
+    {
+        std::map<String, std::array<Values, numStats>> renderers;
+        std::map<String, Values> components;
+
+        /** Returns the snapshot as a JSON-compatible object. */
+        var toVar() const;
+    };
+
+    Snapshot getSnapshot() const;
+
+    /** Clears everything recorded so far. */
+    void reset();
+
+    //==============================================================================
+    /** Starts sending a JSON description of every frame to any process that connects to
+        the given port on the local machine.
+
+        Clients should use an InterprocessConnection with the magicNumber below. Each
+        message they receive is a UTF-8 JSON object. A client can send the text "snapshot"
+        to be sent the result of getSnapshot(), or "reset" to clear the statistics.
+
+        Pass 0 to use any free port. Returns the port number, or 0 if the socket couldn't
+        be opened.
+    */
+    int startStreaming (int portNumber);
+
+    /** Disconnects all clients and closes the socket opened by startStreaming(). */
+    void stopStreaming();
+
+    static constexpr uint32 magicNumber = 0x6d657472;
+
+    //==============================================================================
+    /** Adds one to a per-frame counter. This may be called from any thread. */
+    void addToCount (Stat counter) noexcept
+    {
+        jassert (counter >= fills && counter < numStats);
+        frameCounts[(size_t) counter].fetch_add (1, std::memory_order_relaxed);
+    }
+
+    /** Records a whole frame, along with the counters accumulated since the previous one. */
+    void addFrame (const String& rendererName, double milliseconds);
+
+    /** Records the time taken by a component's own painting. */
+    void addComponentPaint (const String& componentName, double milliseconds);
+
+    //==============================================================================
+    /** Times a frame, and records it when this object goes out of scope. */
+    struct ScopedFrame
+    {
+        explicit ScopedFrame (String rendererNameIn) : rendererName (std::move (rendererNameIn)) {}
+
+        ~ScopedFrame()
+        {
+            if (auto* m = RenderingMetrics::getInstance())
+                m->addFrame (rendererName, getElapsedMilliseconds (startTicks));
+        }
+
+        String rendererName;
+        int64 startTicks = Time::getHighResolutionTicks();
+    };
+
+    /** Times a component's paint callback, and records it when this object goes out of scope. */
+    struct ScopedComponentPaint
+    {
+        explicit ScopedComponentPaint (String componentNameIn) : componentName (std::move (componentNameIn)) {}
+
+        ~ScopedComponentPaint()
+        {
+            if (auto* m = RenderingMetrics::getInstance())
+                m->addComponentPaint (componentName, getElapsedMilliseconds (startTicks));
+        }
+
+        String componentName;
+        int64 startTicks = Time::getHighResolutionTicks();
+    };
+
+    //==============================================================================
+    RenderingMetrics();
+    ~RenderingMetrics() override;
+
+    JUCE_DECLARE_SINGLETON_INLINE (RenderingMetrics, false)
+
+private:
+    //==============================================================================
+    struct Accumulator
+    {
+        void add (double value) noexcept    { stats.addValue (value); total += value; }
+        Values getValues() const;
+
+        StatisticsAccumulator<double> stats;
+        double total = 0;
+    };
+
+    class Connection;
+    class Server;
+
+    static double getElapsedMilliseconds (int64 startTicks) noexcept
+    {
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    }
+
+    void handleRequest (Connection&, const String&);
+
+    CriticalSection lock;
+    std::map<String, std::array<Accumulator, numStats>> renderers;
+    std::map<String, Accumulator> components;
+    double frameComponentPaintTime = 0;
+    std::array<std::atomic<int>, numStats> frameCounts {};
+
+    CriticalSection streamingLock;
+    std::unique_ptr<Server> server;
+    std::vector<std::unique_ptr<Connection>> connections;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderingMetrics)
+};
+
+} // namespace juce
+
+ #define JUCE_RENDERING_METRICS_COUNT(counter) \
+    if (auto* renderingMetrics_ = juce::RenderingMetrics::getInstance()) renderingMetrics_->addToCount (juce::RenderingMetrics::counter);
+
+ #define JUCE_RENDERING_METRICS_SCOPED_FRAME(rendererName) \
+    juce::RenderingMetrics::ScopedFrame renderingMetricsScopedFrame_ { rendererName };
+
+ #define JUCE_RENDERING_METRICS_SCOPED_COMPONENT_PAINT(componentName) \
+    juce::RenderingMetrics::ScopedComponentPaint renderingMetricsScopedPaint_ { componentName };
+
+#else
+
+ #define JUCE_RENDERING_METRICS_COUNT(counter)
+ #define JUCE_RENDERING_METRICS_SCOPED_FRAME(rendererName)
+ #define JUCE_RENDERING_METRICS_SCOPED_COMPONENT_PAINT(componentName)
+
+#endif
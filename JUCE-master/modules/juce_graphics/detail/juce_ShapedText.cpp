@@ -140,6 +140,92 @@ public:
 
     auto& getJustifiedText() const { return justifiedText; }
 
+    //==============================================================================
+    /*  An Impl never changes after it has been built, so the results of shaping the same text
+        with the same options can be shared between every ShapedText that asks for them, e.g.
+        labels that are redrawn every frame, or the same string drawn by many components.
+    */
+    class Cache final : public DeletedAtShutdown
+    {
+    public:
+        Cache() = default;
+
+        ~Cache() override
+        {
+            clearSingletonInstance();
+        }
+
+        std::shared_ptr<Impl> get (String textIn, Options optionsIn)
+        {
+            Key key { std::move (textIn), std::move (optionsIn) };
+
+            {
+                const ScopedLock sl (lock);
+
+                if (const auto iter = entries.find (key); iter != entries.end())
+                {
+                    lru.splice (lru.end(), lru, iter->second.lruPosition);
+                    return iter->second.impl;
+                }
+            }
+
+            // Shaping can take a while, so this is done without holding the lock
+            auto impl = std::make_shared<Impl> (key.text, key.options);
+
+            const ScopedLock sl (lock);
+
+            if (const auto iter = entries.find (key); iter != entries.end())
+                return iter->second.impl;
+
+            while (entries.size() >= maxEntries)
+            {
+                entries.erase (lru.front());
+                lru.pop_front();
+            }
+
+            const auto position = lru.insert (lru.end(), key);
+            entries.emplace (std::move (key), Entry { impl, position });
+            return impl;
+        }
+
+        JUCE_DECLARE_SINGLETON_INLINE (Cache, false)
+
+    private:
+        static constexpr size_t maxEntries = 512;
+
+        struct Key
+        {
+            String text;
+            Options options;
+
+            bool operator== (const Key& other) const
+            {
+                return text == other.text && options == other.options;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator() (const Key& key) const noexcept
+            {
+                auto h = (size_t) key.text.hash();
+                h = h * 31 + (size_t) key.options.getJustification().getFlags();
+                h = h * 31 + std::hash<std::optional<float>>() (key.options.getMaxWidth());
+                return h * 31 + std::hash<std::optional<float>>() (key.options.getHeight());
+            }
+        };
+
+        struct Entry
+        {
+            std::shared_ptr<Impl> impl;
+            std::list<Key>::iterator lruPosition;
+        };
+
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        std::list<Key> lru;
+        CriticalSection lock;
+    };
+
 private:
     ShapedTextOptions options;
     String text;
@@ -157,7 +243,7 @@ ShapedText::ShapedText (String text) : ShapedText (std::move (text), {})
 
 ShapedText::ShapedText (String text, Options options)
 {
-    impl = std::make_shared<Impl> (std::move (text), std::move (options));
+    impl = Impl::Cache::getInstance()->get (std::move (text), std::move (options));
 }
 
 void ShapedText::draw (const Graphics& g, AffineTransform transform) const
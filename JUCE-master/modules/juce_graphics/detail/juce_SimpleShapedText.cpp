@@ -870,10 +870,18 @@ static auto rangedValuesWithOffset (detail::RangedValues<T> rv, int64 offset = 0
     return rv;
 }
 
+/*  Everything about a paragraph that doesn't depend on the width it's laid out in: the bidi
+    levels and visual order, the soft break opportunities, the script and font runs, and the glyphs
+    for each run. Line fitting only reads this, so a Shaper can be reused by every layout of the
+    same paragraph with the same fonts, reading direction and language.
+*/
 struct Shaper
 {
-    Shaper (const String& stringIn, Range<int64> lineRange, const ShapedTextOptions& options)
-        : string { stringIn.substring ((int) lineRange.getStart(), (int) lineRange.getEnd()) }
+    Shaper (String paragraph,
+            const RangedValues<Font>& fontsForParagraph,
+            std::optional<TextDirection> readingDir,
+            const String& language)
+        : string { std::move (paragraph) }
     {
         const auto analysis = Unicode::performAnalysis (string);
 
@@ -887,16 +895,15 @@ struct Shaper
                                            });
 
         const BidiAlgorithm bidiAlgorithm { string32 };
-        const auto bidiParagraph = bidiAlgorithm.createParagraph (0, options.getReadingDirection());
+        const auto bidiParagraph = bidiAlgorithm.createParagraph (0, readingDir);
         const auto bidiLine = bidiParagraph.createLine (0, bidiParagraph.getLength());
         bidiLine.computeVisualOrder (visualOrder);
 
         const auto bidiLevels = bidiParagraph.getResolvedLevels();
 
-        const auto fonts = resolveFontsWithFallback (string,
-                                                     rangedValuesWithOffset (options.getFontsForRange(),
-                                                                             lineRange.getStart()));
+        const auto fonts = resolveFontsWithFallback (string, fontsForParagraph);
 
+        RangedValues<ShapingParams> shaperRuns;
         detail::Ranges::Operations ops;
 
         for (Unicode::ScriptRunIterator scriptIter { makeSpan (analysis) }; auto scriptRun = scriptIter.next();)
@@ -925,7 +932,7 @@ struct Shaper
                 {
                     shaperRuns.set (range,
                                     { scriptRun->front().script,
-                                      options.getLanguage(),
+                                      language,
                                       *it,
                                       font },
                                     ops,
@@ -948,22 +955,78 @@ struct Shaper
             if (softBreakBeforePoints.empty() || softBreakBeforePoints.back() != v)
                 softBreakBeforePoints.push_back (v);
         }
+
+        // Line fitting always asks for the chunks starting at each soft break in turn, whatever
+        // the width, so shaping them in that same order up front gives identical glyphs.
+        for (int64 startFrom = 0; startFrom < (int64) visualOrder.size(); startFrom = getNextSoftBreakBefore (startFrom))
+            shapeUpToNextSafeBreak (shaperRuns, startFrom);
     }
 
-    WrappedGlyphs getChunksUpToNextSafeBreak (int64 startFrom)
+    WrappedGlyphs getChunksUpToNextSafeBreak (int64 startFrom) const
     {
-        const auto nextSoftBreakBefore = std::invoke ([&]
-                                                      {
-                                                          const auto it = std::upper_bound (softBreakBeforePoints.begin(),
-                                                                                            softBreakBeforePoints.end(),
-                                                                                            startFrom);
+        const auto nextSoftBreakBefore = getNextSoftBreakBefore (startFrom);
 
-                                                          if (it == softBreakBeforePoints.end())
-                                                              return (int64) visualOrder.size();
+        auto glyphsIt = shapedGlyphs.find (startFrom);
+        WrappedGlyphs result;
 
-                                                          return *it;
-                                                      });
+        while (true)
+        {
+            // The stored glyphs data can be empty if there are input codepoints for which we failed to
+            // resolve a valid Typeface::Ptr.
+            if (glyphsIt == shapedGlyphs.end() || glyphsIt->value.data->empty())
+                break;
+
+            const ShapedGlyph* start = glyphsIt->value.data->data();
+            const ShapedGlyph* const endIt = glyphsIt->value.data->data() + glyphsIt->value.data->size();
 
+            while (start < endIt && start->cluster < startFrom)
+                ++start;
+
+            const ShapedGlyph* end = start;
+
+            while (end < endIt && end->cluster < nextSoftBreakBefore)
+                ++end;
+
+            const auto startingCluster = std::max (startFrom, start->cluster);
+
+            if (! result.empty())
+                result.back().setTextRange (result.back().getTextRange().withEnd (startingCluster));
+
+            result.push_back ({ glyphsIt->value,
+                                Span<const ShapedGlyph> { start, (size_t) std::distance (start, end) },
+                                { startingCluster, nextSoftBreakBefore },
+                                visualOrder[(size_t) start->cluster] });
+
+            if (end != endIt && end->cluster >= nextSoftBreakBefore)
+                break;
+
+            ++glyphsIt;
+        }
+
+        return result;
+    }
+
+    String string;
+    std::vector<size_t> visualOrder;
+    std::vector<int64> softBreakBeforePoints;
+    RangedValues<GlyphsStorage> shapedGlyphs;
+
+private:
+    int64 getNextSoftBreakBefore (int64 startFrom) const
+    {
+        const auto it = std::upper_bound (softBreakBeforePoints.begin(),
+                                          softBreakBeforePoints.end(),
+                                          startFrom);
+
+        if (it == softBreakBeforePoints.end())
+            return (int64) visualOrder.size();
+
+        return *it;
+    }
+
+    void shapeUpToNextSafeBreak (const RangedValues<ShapingParams>& shaperRuns, int64 startFrom)
+    {
+        const auto nextSoftBreakBefore = getNextSoftBreakBefore (startFrom);
         detail::Ranges::Operations ops;
 
         if (! shapedGlyphs.getRanges().covers ({ startFrom, nextSoftBreakBefore }))
@@ -993,52 +1056,100 @@ struct Shaper
                 ops.clear();
             }
         }
+    }
+};
 
-        auto glyphsIt = shapedGlyphs.find (startFrom);
-        WrappedGlyphs result;
+//==============================================================================
+/*  Keeps the Shapers for recently laid out paragraphs, so that laying out the same text again at a
+    different width, e.g. while a window is being resized, only has to fit the glyphs into lines.
+*/
+class ShaperCache final : public DeletedAtShutdown
+{
+public:
+    ShaperCache() = default;
+
+    ~ShaperCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    std::shared_ptr<const Shaper> get (String paragraph,
+                                       RangedValues<Font> fontsForParagraph,
+                                       std::optional<TextDirection> readingDir,
+                                       String language)
+    {
+        Key key { std::move (paragraph), std::move (fontsForParagraph), readingDir, std::move (language) };
 
-        while (true)
         {
-            // The stored glyphs data can be empty if there are input codepoints for which we failed to
-            // resolve a valid Typeface::Ptr.
-            if (glyphsIt == shapedGlyphs.end() || glyphsIt->value.data->empty())
-                break;
+            const ScopedLock sl (lock);
 
-            const ShapedGlyph* start = glyphsIt->value.data->data();
-            const ShapedGlyph* const endIt = glyphsIt->value.data->data() + glyphsIt->value.data->size();
+            if (const auto iter = entries.find (key); iter != entries.end())
+            {
+                lru.splice (lru.end(), lru, iter->second.lruPosition);
+                return iter->second.shaper;
+            }
+        }
 
-            while (start < endIt && start->cluster < startFrom)
-                ++start;
+        // Shaping can take a while, so this is done without holding the lock
+        std::shared_ptr<const Shaper> shaper = std::make_shared<Shaper> (key.paragraph,
+                                                                         key.fonts,
+                                                                         key.readingDir,
+                                                                         key.language);
 
-            const ShapedGlyph* end = start;
+        const ScopedLock sl (lock);
 
-            while (end < endIt && end->cluster < nextSoftBreakBefore)
-                ++end;
+        if (const auto iter = entries.find (key); iter != entries.end())
+            return iter->second.shaper;
 
-            const auto startingCluster = std::max (startFrom, start->cluster);
+        while (entries.size() >= maxEntries)
+        {
+            entries.erase (lru.front());
+            lru.pop_front();
+        }
 
-            if (! result.empty())
-                result.back().setTextRange (result.back().getTextRange().withEnd (startingCluster));
+        const auto position = lru.insert (lru.end(), key);
+        entries.emplace (std::move (key), Entry { shaper, position });
+        return shaper;
+    }
 
-            result.push_back ({ glyphsIt->value,
-                                Span<const ShapedGlyph> { start, (size_t) std::distance (start, end) },
-                                { startingCluster, nextSoftBreakBefore },
-                                visualOrder[(size_t) start->cluster] });
+    JUCE_DECLARE_SINGLETON_INLINE (ShaperCache, false)
 
-            if (end != endIt && end->cluster >= nextSoftBreakBefore)
-                break;
+private:
+    static constexpr size_t maxEntries = 1024;
 
-            ++glyphsIt;
+    struct Key
+    {
+        String paragraph;
+        RangedValues<Font> fonts;
+        std::optional<TextDirection> readingDir;
+        String language;
+
+        bool operator== (const Key& other) const
+        {
+            return std::tie (paragraph, fonts, readingDir, language)
+                == std::tie (other.paragraph, other.fonts, other.readingDir, other.language);
         }
+    };
 
-        return result;
-    }
+    struct KeyHash
+    {
+        size_t operator() (const Key& key) const noexcept
+        {
+            auto h = (size_t) key.paragraph.hash();
+            h = h * 31 + (size_t) key.language.hash();
+            return h * 31 + (size_t) key.fonts.size();
+        }
+    };
 
-    String string;
-    std::vector<size_t> visualOrder;
-    RangedValues<ShapingParams> shaperRuns;
-    std::vector<int64> softBreakBeforePoints;
-    RangedValues<GlyphsStorage> shapedGlyphs;
+    struct Entry
+    {
+        std::shared_ptr<const Shaper> shaper;
+        std::list<Key>::iterator lruPosition;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::list<Key> lru;
+    CriticalSection lock;
 };
 
 struct LineState
@@ -1179,7 +1290,7 @@ struct FillLinesOptions
         return withMember (*this, &FillLinesOptions::forceConsumeFirstWord, x);
     }
 
-    LineDataAndChunkStorage fillLines (Shaper& shaper) const
+    LineDataAndChunkStorage fillLines (const Shaper& shaper) const
     {
         LineDataAndChunkStorage result;
         LineOfWrappedGlyphCursorRanges line { width - firstLinePadding, trailingWhitespaceCanExtendBeyondMargin };
@@ -1270,12 +1381,21 @@ void SimpleShapedText::shape (const String& data,
 
     for (const auto& lineRange : getLineRanges (data))
     {
-        Shaper shaper { data, lineRange, options };
+        // Only the fonts inside the paragraph matter, so they're trimmed to it to let paragraphs
+        // that appear at different positions in different strings share a Shaper
+        auto fontsForParagraph = rangedValuesWithOffset (options.getFontsForRange(), lineRange.getStart());
+        fontsForParagraph.eraseFrom (lineRange.getLength(), ops);
+        ops.clear();
+
+        const auto shaper = ShaperCache::getInstance()->get (data.substring ((int) lineRange.getStart(), (int) lineRange.getEnd()),
+                                                             std::move (fontsForParagraph),
+                                                             options.getReadingDirection(),
+                                                             options.getLanguage());
         auto lineDataAndStorage = FillLinesOptions{}.withWidth (options.getMaxWidth().value_or ((float) 1e6))
                                                     .withFirstLinePadding (options.getFirstLineIndent())
                                                     .withTrailingWhitespaceCanExtendBeyondMargin (! options.getTrailingWhitespacesShouldFit())
                                                     .withForceConsumeFirstWord (! options.getAllowBreakingInsideWord())
-                                                    .fillLines (shaper);
+                                                    .fillLines (*shaper);
         auto& lineData = lineDataAndStorage.lines;
 
         foldLinesBeyondLineLimit (lineData, (size_t) options.getMaxNumLines() - lineNumbersForGlyphRanges.size());
@@ -1573,6 +1693,40 @@ struct SimpleShapedTextTests : public UnitTest
             for (auto* testString : testStrings)
                 runTest (testString, 60.0f);
         }
+
+        beginTest ("Laying out the same text at different widths produces the same glyphs");
+        {
+            const auto defaultTypeface = Font::getDefaultTypefaceForFont (FontOptions{});
+
+            if (defaultTypeface == nullptr)
+            {
+                DBG ("Skipping test: No default typeface found!");
+                return;
+            }
+
+            const auto getGlyphs = [&] (const String& text, float maxWidth)
+            {
+                SimpleShapedText st { &text, ShapedTextOptions{}.withFont (FontOptions { defaultTypeface })
+                                                                .withMaxWidth (maxWidth) };
+
+                std::vector<std::pair<int64, uint32_t>> result;
+
+                for (const auto& glyph : st.getGlyphs())
+                    result.emplace_back (glyph.cluster, glyph.glyphId);
+
+                std::sort (result.begin(), result.end());
+                return result;
+            };
+
+            for (auto* testString : testStrings)
+            {
+                const String text { testString };
+                const auto wide = getGlyphs (text, 100'000.0f);
+
+                expect (getGlyphs (text, 60.0f) == wide);
+                expect (getGlyphs (text, 100'000.0f) == wide);
+            }
+        }
     }
 };
 
@@ -41,6 +41,146 @@ DropShadow::DropShadow (Colour shadowColour, const int r, Point<int> o) noexcept
     jassert (radius > 0);
 }
 
+//==============================================================================
+/*  Blurring is by far the most expensive part of drawing a shadow, and most shadows are
+    drawn over and over again with exactly the same shape. This keeps the most recently
+    used blurred masks, so that drawing a shadow which hasn't changed is just a blit.
+*/
+class ShadowMaskCache  : private DeletedAtShutdown
+{
+public:
+    ShadowMaskCache() = default;
+
+    ~ShadowMaskCache() override
+    {
+        getSingletonPointer() = nullptr;
+    }
+
+    static ShadowMaskCache& getInstance()
+    {
+        auto& c = getSingletonPointer();
+
+        if (c == nullptr)
+            c = new ShadowMaskCache();
+
+        return *c;
+    }
+
+    /** Masks covering more pixels than this are always rendered from scratch. */
+    static constexpr int maxCachedPixels = 512 * 512;
+
+    template <typename CreateFn>
+    Image getMaskForPath (const Path& path, int radius, Point<int> offset, CreateFn&& create)
+    {
+        const ScopedLock sl (lock);
+        return pathMasks.get (PathKey { path, radius, offset }, [&] (const auto&) { return create(); });
+    }
+
+    /** Returns a blurred copy of a single-channel mask, reusing an earlier result if the
+        same pixels have been blurred with the same radius before.
+    */
+    template <typename CreateFn>
+    Image getMaskForImage (const Image& mask, int radius, CreateFn&& create)
+    {
+        const ScopedLock sl (lock);
+        const ImageKey key { getContentHash (mask), mask.getWidth(), mask.getHeight(), radius };
+        const auto& entry = imageMasks.get (key, [&] (const auto&) { return ImageEntry { mask, create() }; });
+
+        // A hash collision is very unlikely, but would otherwise draw the wrong shadow
+        if (entry.source != mask && ! havePixelsEqual (entry.source, mask))
+            return create();
+
+        return entry.blurred;
+    }
+
+private:
+    struct PathKey
+    {
+        PathKey (const Path& p, int r, Point<int> o)
+            : path (p), hash (RenderingHelpers::PathGeometryCache::getContentHash (p)), radius (r), offset (o)
+        {
+        }
+
+        Path path;
+        uint64 hash;
+        int radius;
+        Point<int> offset;
+
+        bool operator< (const PathKey& other) const
+        {
+            const auto a = std::tuple (hash, radius, offset.x, offset.y);
+            const auto b = std::tuple (other.hash, other.radius, other.offset.x, other.offset.y);
+
+            if (a != b)
+                return a < b;
+
+            return path != other.path && path.toString() < other.path.toString();
+        }
+    };
+
+    struct ImageKey
+    {
+        uint64 hash;
+        int width, height, radius;
+
+        bool operator< (const ImageKey& other) const
+        {
+            return std::tie (hash, width, height, radius) < std::tie (other.hash, other.width, other.height, other.radius);
+        }
+    };
+
+    struct ImageEntry
+    {
+        Image source, blurred;
+    };
+
+    static uint64 getContentHash (const Image& mask)
+    {
+        const Image::BitmapData data (mask, Image::BitmapData::readOnly);
+        uint64 h = 14695981039346656037ull;
+
+        for (int y = 0; y < data.height; ++y)
+        {
+            const auto* line = data.getLinePointer (y);
+            const auto numBytes = (size_t) (data.width * data.pixelStride);
+            size_t i = 0;
+
+            for (; i + 8 <= numBytes; i += 8)
+                h = (h ^ readUnaligned<uint64> (line + i)) * 1099511628211ull;
+
+            for (; i < numBytes; ++i)
+                h = (h ^ line[i]) * 1099511628211ull;
+        }
+
+        return h;
+    }
+
+    static bool havePixelsEqual (const Image& a, const Image& b)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < dataA.height; ++y)
+            if (std::memcmp (dataA.getLinePointer (y), dataB.getLinePointer (y), (size_t) (dataA.width * dataA.pixelStride)) != 0)
+                return false;
+
+        return true;
+    }
+
+    LruCache<PathKey, Image, 32> pathMasks;
+    LruCache<ImageKey, ImageEntry, 32> imageMasks;
+    CriticalSection lock;
+
+    static ShadowMaskCache*& getSingletonPointer() noexcept
+    {
+        static ShadowMaskCache* c = nullptr;
+        return c;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ShadowMaskCache)
+};
+
+//==============================================================================
 void DropShadow::drawForImage (Graphics& g, const Image& srcImage) const
 {
     jassert (radius > 0);
@@ -48,26 +188,32 @@ void DropShadow::drawForImage (Graphics& g, const Image& srcImage) const
     if (! srcImage.isValid())
         return;
 
-    auto blurred = srcImage.convertedToFormat (Image::SingleChannel);
-    blurred.setBackupEnabled (false);
+    // The mask gets blurred in place, so it mustn't share its pixels with the source
+    auto blurred = srcImage.getFormat() == Image::SingleChannel ? srcImage.createCopy()
+                                                                : srcImage.convertedToFormat (Image::SingleChannel);
 
-    blurred.getPixelData()->applySingleChannelBoxBlurEffect (radius);
+    if (blurred.getWidth() * blurred.getHeight() <= ShadowMaskCache::maxCachedPixels)
+    {
+        blurred = ShadowMaskCache::getInstance().getMaskForImage (blurred, radius, [&]
+        {
+            auto copy = blurred.createCopy();
+            copy.setBackupEnabled (false);
+            copy.getPixelData()->applySingleChannelBoxBlurEffect (radius);
+            return copy;
+        });
+    }
+    else
+    {
+        blurred.setBackupEnabled (false);
+        blurred.getPixelData()->applySingleChannelBoxBlurEffect (radius);
+    }
 
     g.setColour (colour);
     g.drawImageAt (blurred, offset.x, offset.y, true);
 }
 
-void DropShadow::drawForPath (Graphics& g, const Path& path) const
+static Image createBlurredPathMask (const Path& path, Rectangle<int> area, Point<int> offset, int radius)
 {
-    jassert (radius > 0);
-
-    auto area = (path.getBounds().getSmallestIntegerContainer() + offset)
-            .expanded (radius + 1)
-            .getIntersection (g.getClipBounds().expanded (radius + 1));
-
-    if (area.getWidth() <= 2 || area.getHeight() <= 2)
-        return;
-
     Image pathImage { Image::SingleChannel, area.getWidth(), area.getHeight(), true };
     pathImage.setBackupEnabled (false);
 
@@ -79,9 +225,37 @@ void DropShadow::drawForPath (Graphics& g, const Path& path) const
     }
 
     pathImage.getPixelData()->applySingleChannelBoxBlurEffect (radius);
+    return pathImage;
+}
+
+void DropShadow::drawForPath (Graphics& g, const Path& path) const
+{
+    jassert (radius > 0);
+
+    const auto shadowArea = (path.getBounds().getSmallestIntegerContainer() + offset).expanded (radius + 1);
+    auto area = shadowArea.getIntersection (g.getClipBounds().expanded (radius + 1));
+
+    if (area.getWidth() <= 2 || area.getHeight() <= 2)
+        return;
+
+    Image mask;
+
+    // Small shadows are rendered in full, so that the same mask can be reused however they're clipped
+    if (shadowArea.getWidth() * shadowArea.getHeight() <= ShadowMaskCache::maxCachedPixels)
+    {
+        area = shadowArea;
+        mask = ShadowMaskCache::getInstance().getMaskForPath (path, radius, offset, [&]
+        {
+            return createBlurredPathMask (path, area, offset, radius);
+        });
+    }
+    else
+    {
+        mask = createBlurredPathMask (path, area, offset, radius);
+    }
 
     g.setColour (colour);
-    g.drawImageAt (pathImage, area.getX(), area.getY(), true);
+    g.drawImageAt (mask, area.getX(), area.getY(), true);
 }
 
 static void drawShadowSection (Graphics& g, ColourGradient& cg, Rectangle<float> area,
@@ -104,6 +104,7 @@ public:
         }
 
         const ScopedWriteLock slw (lock);
+        JUCE_SCOPED_INITIALISER_TRACE ("loading typefaces")
 
         auto newFace = CachedFace { key,
                                     ++counter,
@@ -174,6 +175,50 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TypefaceCache)
 };
 
+//==============================================================================
+/*  Remembers the typefaces that the system suggested as fallbacks, so that text which
+    needs the same fallback doesn't have to ask the system again.
+
+    A suggestion is stored against the typeface that asked for it, the language, and the
+    first codepoint that the typeface couldn't display, along with any variation selector
+    following that codepoint, as that can change the choice (e.g. emoji or text style).
+*/
+class FallbackTypefaceCache final : private DeletedAtShutdown
+{
+public:
+    FallbackTypefaceCache() = default;
+
+    ~FallbackTypefaceCache()
+    {
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON_INLINE (FallbackTypefaceCache, false)
+
+    template <typename Fn>
+    Typeface::Ptr get (const Typeface& typeface, const String& language,
+                       juce_wchar codepoint, juce_wchar variationSelector, Fn&& findFallback)
+    {
+        const ScopedLock sl (lock);
+        return cache.get ({ typeface.getName(), typeface.getStyle(), language, codepoint, variationSelector },
+                          [&] (const auto&) { return findFallback(); });
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+        cache = {};
+    }
+
+private:
+    using Key = std::tuple<String, String, String, juce_wchar, juce_wchar>;
+
+    CriticalSection lock;
+    LruCache<Key, Typeface::Ptr, 1024> cache;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FallbackTypefaceCache)
+};
+
 void Typeface::setTypefaceCacheSize (int numFontsToCache)
 {
     TypefaceCache::getInstance()->setSize (numFontsToCache);
@@ -185,6 +230,9 @@ void Typeface::clearTypefaceCache()
 {
     TypefaceCache::getInstance()->clear();
 
+    if (auto* fallbacks = FallbackTypefaceCache::getInstanceWithoutCreating())
+        fallbacks->clear();
+
     RenderingHelpers::SoftwareRendererSavedState::clearGlyphCache();
 
     NullCheckedInvocation::invoke (clearOpenGLGlyphCache);
@@ -852,28 +900,57 @@ static bool characterNotRendered (uint32_t c)
     return std::find (std::begin (points), std::end (points), c) != std::end (points);
 }
 
-static bool isFontSuitableForCodepoint (const Font& font, juce_wchar c)
+static bool isTypefaceSuitableForCodepoint (const Typeface& typeface, juce_wchar c)
 {
-    const auto& hbFont = font.getNativeDetails().font;
-
-    if (hbFont == nullptr)
-        return false;
-
-    hb_codepoint_t glyph{};
+    return characterNotRendered ((uint32_t) c) || typeface.hasGlyphForCodepoint (c);
+}
 
-    return characterNotRendered ((uint32_t) c)
-           || hb_font_get_nominal_glyph (hbFont.get(), (hb_codepoint_t) c, &glyph);
+static bool isFontSuitableForCodepoint (const Font& font, juce_wchar c)
+{
+    const auto typeface = font.getTypefacePtr();
+    return typeface != nullptr && isTypefaceSuitableForCodepoint (*typeface, c);
 }
 
 static bool isFontSuitableForText (const Font& font, const String& str)
 {
+    const auto typeface = font.getTypefacePtr();
+
+    if (typeface == nullptr)
+        return false;
+
     for (const auto c : str)
-        if (! isFontSuitableForCodepoint (font, c))
+        if (! isTypefaceSuitableForCodepoint (*typeface, c))
             return false;
 
     return true;
 }
 
+static bool isVariationSelector (juce_wchar c)
+{
+    return (0xfe00 <= c && c <= 0xfe0f) || (0xe0100 <= c && c <= 0xe01ef);
+}
+
+static Typeface::Ptr findSystemFallback (const Font& font, const Typeface& typeface,
+                                         const String& text, const String& language)
+{
+    const auto current = font.getTypefacePtr();
+
+    for (auto ptr = text.getCharPointer(); ! ptr.isEmpty();)
+    {
+        const auto c = ptr.getAndAdvance();
+
+        if (current != nullptr && isTypefaceSuitableForCodepoint (*current, c))
+            continue;
+
+        const auto next = *ptr;
+
+        return FallbackTypefaceCache::getInstance()->get (typeface, language, c, isVariationSelector (next) ? next : 0,
+                                                          [&] { return typeface.createSystemFallback (text, language); });
+    }
+
+    return typeface.createSystemFallback (text, language);
+}
+
 Font Font::findSuitableFontForText (const String& text, const String& language) const
 {
     if (! getFallbackEnabled() || isFontSuitableForText (*this, text))
@@ -900,7 +977,7 @@ Font Font::findSuitableFontForText (const String& text, const String& language)
 
     if (fallbackTypefacePtr != nullptr)
     {
-        if (auto suggested = fallbackTypefacePtr->createSystemFallback (text, language))
+        if (auto suggested = findSystemFallback (*this, *fallbackTypefacePtr, text, language))
         {
             auto copy = *this;
 
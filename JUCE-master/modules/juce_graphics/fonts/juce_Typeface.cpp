@@ -347,6 +347,44 @@ struct FontStyleHelpers
     }
 };
 
+//==============================================================================
+/*  The codepoints that a typeface has glyphs for, as sorted ranges. These are
+    copied out of the face's cmap once, and are then safe to read from any thread.
+*/
+class Typeface::Coverage
+{
+public:
+    explicit Coverage (hb_font_t* font)
+    {
+        if (font == nullptr)
+            return;
+
+        const std::unique_ptr<hb_set_t, FunctionPointerDestructor<hb_set_destroy>> unicodes { hb_set_create() };
+        hb_face_collect_unicodes (hb_font_get_face (font), unicodes.get());
+
+        hb_codepoint_t first = HB_SET_VALUE_INVALID, last = HB_SET_VALUE_INVALID;
+
+        while (hb_set_next_range (unicodes.get(), &first, &last))
+            ranges.push_back ({ (uint32_t) first, (uint32_t) last });
+    }
+
+    /*  Fonts without a cmap table, such as some bitmap fonts, still map codepoints
+        through their font functions, so an empty map can't be trusted.
+    */
+    bool isKnown() const noexcept   { return ! ranges.empty(); }
+
+    bool contains (uint32_t codepoint) const noexcept
+    {
+        const auto iter = std::upper_bound (ranges.begin(), ranges.end(), codepoint,
+                                            [] (uint32_t c, const auto& range) { return c < range.first; });
+
+        return iter != ranges.begin() && codepoint <= std::prev (iter)->second;
+    }
+
+private:
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+};
+
 //==============================================================================
 Typeface::Typeface (const String& faceName, const String& faceStyle) noexcept
     : name (faceName),
@@ -587,6 +625,16 @@ std::optional<uint32_t> Typeface::getNominalGlyphForCodepoint (juce_wchar cp) co
     return result;
 }
 
+bool Typeface::hasGlyphForCodepoint (juce_wchar cp) const
+{
+    std::call_once (coverageFlag, [this] { coverage = std::make_unique<Coverage> (getNativeDetails().getFont()); });
+
+    if (coverage->isKnown())
+        return coverage->contains ((uint32_t) cp);
+
+    return getNominalGlyphForCodepoint (cp).has_value();
+}
+
 static constexpr auto hbTag (const char (&arr)[5])
 {
     return HB_TAG (arr[0], arr[1], arr[2], arr[3]);
@@ -785,6 +833,20 @@ public:
             expect (font.getTypefacePtr()->getStyle() == ptr->getStyle());
         }
 
+        beginTest ("The coverage map agrees with the typeface's glyph lookup");
+        {
+            int numCovered = 0;
+
+            for (juce_wchar c = 0; c < 0x3000; ++c)
+            {
+                const auto hasGlyph = ptr->hasGlyphForCodepoint (c);
+                expect (hasGlyph == ptr->getNominalGlyphForCodepoint (c).has_value());
+                numCovered += hasGlyph ? 1 : 0;
+            }
+
+            expect (numCovered > 0);
+        }
+
         // Unload font
         ptr = nullptr;
 
@@ -318,6 +318,14 @@ public:
     */
     std::optional<uint32_t> getNominalGlyphForCodepoint (juce_wchar) const;
 
+    /** Returns true if the typeface has a glyph for the provided codepoint.
+
+        The first call makes a map of all the codepoints that the typeface covers, which
+        makes this much quicker than getNominalGlyphForCodepoint() when checking lots of
+        text, as font fallback does.
+    */
+    bool hasGlyphForCodepoint (juce_wchar) const;
+
     /** @internal */
     class Native;
 
@@ -389,9 +397,14 @@ public:
 
 private:
     //==============================================================================
+    class Coverage;
+
     String name;
     String style;
 
+    mutable std::once_flag coverageFlag;
+    mutable std::unique_ptr<Coverage> coverage;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Typeface)
 };
 
@@ -416,6 +416,11 @@ void EdgeTable::optimiseTable()
     remapTableForNumEdges (maxLineElements);
 }
 
+size_t EdgeTable::getAllocatedSize() const noexcept
+{
+    return sizeof (int) * getEdgeTableAllocationSize (lineStrideElements, bounds.getHeight());
+}
+
 void EdgeTable::addEdgePoint (const int x, const int y, const int winding)
 {
     jassert (y >= 0 && y < bounds.getHeight());
@@ -1013,6 +1018,77 @@ private:
 
 static EdgeTableTests edgeTableTests;
 
+//==============================================================================
+class PathAndEdgeTableBenchmarks final : public BenchmarkTest
+{
+public:
+    PathAndEdgeTableBenchmarks()
+        : BenchmarkTest ("Path and EdgeTable benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    static Path createPath()
+    {
+        Path p;
+        p.startNewSubPath (10.0f, 250.0f);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const auto x = 10.0f + (float) i * 4.8f;
+            p.cubicTo (x + 1.6f, 10.0f, x + 3.2f, 490.0f, x + 4.8f, 250.0f);
+        }
+
+        p.addEllipse (100.0f, 100.0f, 300.0f, 300.0f);
+        return p;
+    }
+
+    void runTest() override
+    {
+        const auto path = createPath();
+        const Rectangle<int> bounds (0, 0, 500, 500);
+
+        beginTest ("Paths");
+        {
+            benchmark ("Building", []
+            {
+                doNotOptimise (createPath());
+            });
+
+            benchmark ("Stroking", [&]
+            {
+                Path stroked;
+                PathStrokeType (3.0f, PathStrokeType::curved, PathStrokeType::rounded).createStrokedPath (stroked, path);
+                doNotOptimise (stroked);
+            });
+        }
+
+        beginTest ("EdgeTables");
+        {
+            benchmark ("Rasterising a path", [&]
+            {
+                EdgeTable et (bounds, path, {});
+                doNotOptimise (et);
+            });
+
+            benchmark ("Rasterising a transformed path", [&]
+            {
+                EdgeTable et (bounds, path, AffineTransform::rotation (0.3f, 250.0f, 250.0f));
+                doNotOptimise (et);
+            });
+
+            const EdgeTable table (bounds, path, {});
+
+            benchmark ("Intersecting", [&]
+            {
+                EdgeTable et (table);
+                et.clipToRectangle ({ 50, 50, 300, 300 });
+                doNotOptimise (et);
+            });
+        }
+    }
+};
+
+static PathAndEdgeTableBenchmarks pathAndEdgeTableBenchmarks;
+
 #endif
 
 } // namespace juce
@@ -91,6 +91,10 @@ public:
     */
     void optimiseTable();
 
+    /** Returns the number of bytes that the table's storage currently occupies.
+        @see optimiseTable
+    */
+    size_t getAllocatedSize() const noexcept;
 
     //==============================================================================
     /** Iterates the lines in the table, for rendering.
@@ -112,7 +112,8 @@ Path::~Path() = default;
 Path::Path (const Path& other)
     : data (other.data),
       bounds (other.bounds),
-      useNonZeroWinding (other.useNonZeroWinding)
+      useNonZeroWinding (other.useNonZeroWinding),
+      cacheGeometry (other.cacheGeometry)
 {
 }
 
@@ -126,7 +127,8 @@ Path& Path::operator= (const Path& other)
 Path::Path (Path&& other) noexcept
     : data (std::exchange (other.data, {})),
       bounds (std::exchange (other.bounds, {})),
-      useNonZeroWinding (std::exchange (other.useNonZeroWinding, {}))
+      useNonZeroWinding (std::exchange (other.useNonZeroWinding, {})),
+      cacheGeometry (std::exchange (other.cacheGeometry, {}))
 {
 }
 
@@ -156,6 +158,7 @@ void Path::swapWithPath (Path& other) noexcept
     data.swapWith (other.data);
     std::swap (bounds, other.bounds);
     std::swap (useNonZeroWinding, other.useNonZeroWinding);
+    std::swap (cacheGeometry, other.cacheGeometry);
 }
 
 //==============================================================================
@@ -164,6 +167,11 @@ void Path::setUsingNonZeroWinding (const bool isNonZero) noexcept
     useNonZeroWinding = isNonZero;
 }
 
+void Path::setGeometryCachingEnabled (const bool shouldCacheGeometry) noexcept
+{
+    cacheGeometry = shouldCacheGeometry;
+}
+
 void Path::scaleToFit (float x, float y, float w, float h, bool preserveProportions) noexcept
 {
     applyTransform (getTransformToScaleToFit (x, y, w, h, preserveProportions));
@@ -724,6 +724,26 @@ public:
     */
     bool isUsingNonZeroWinding() const                  { return useNonZeroWinding; }
 
+    /** Marks this path as one that is likely to be drawn many times without changing,
+        such as an icon or a meter outline.
+
+        When this is set, the software and OpenGL renderers will keep the edge tables and
+        stroke outlines that they build for the path, and reuse them whenever the same path
+        is drawn again with the same transform and stroke. The cached geometry is looked up
+        by the path's contents, so modifying the path simply causes a cache miss.
+
+        Like the winding flag, this doesn't affect the contents of the path, and it is copied
+        along with it. The default for a new path is false.
+
+        @see isGeometryCachingEnabled
+    */
+    void setGeometryCachingEnabled (bool shouldCacheGeometry) noexcept;
+
+    /** Returns true if the renderer may cache geometry built from this path.
+        @see setGeometryCachingEnabled
+    */
+    bool isGeometryCachingEnabled() const noexcept      { return cacheGeometry; }
+
     //==============================================================================
     /** Iterates the lines and curves that a path contains.
 
@@ -833,6 +853,7 @@ private:
 
     PathBounds bounds;
     bool useNonZeroWinding = true;
+    bool cacheGeometry = false;
 
     static constexpr float lineMarker           = 100001.0f;
     static constexpr float moveMarker           = 100002.0f;
@@ -226,6 +226,11 @@ void JPEGImageFormat::setQuality (const float newQuality)
     quality = newQuality;
 }
 
+void JPEGImageFormat::setDecodeSizeHint (int maxWidth, int maxHeight)
+{
+    decodeSizeHint = { jmax (0, maxWidth), jmax (0, maxHeight) };
+}
+
 String JPEGImageFormat::getFormatName()                   { return "JPEG"; }
 bool JPEGImageFormat::usesFileExtension (const File& f)   { return f.hasFileExtension ("jpeg;jpg"); }
 
@@ -296,6 +301,20 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
         if (! hasFailed)
         {
+            if (! decodeSizeHint.isEmpty())
+            {
+                // Let the IDCT shrink the image by the largest power of two that still leaves it
+                // big enough to be scaled down to the hinted size afterwards
+                const auto scale = jmin ((double) decodeSizeHint.getWidth()  / (double) jpegDecompStruct.image_width,
+                                         (double) decodeSizeHint.getHeight() / (double) jpegDecompStruct.image_height);
+
+                jpegDecompStruct.scale_num = 1;
+                jpegDecompStruct.scale_denom = 1;
+
+                while (jpegDecompStruct.scale_denom < 8 && scale * (jpegDecompStruct.scale_denom * 2) <= 1.0)
+                    jpegDecompStruct.scale_denom *= 2;
+            }
+
             jpeg_calc_output_dimensions (&jpegDecompStruct);
 
             if (! hasFailed)
@@ -333,7 +352,6 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
                             for (int i = width; --i >= 0;)
                             {
                                 ((PixelARGB*) dest)->setARGB (0xff, src[0], src[1], src[2]);
-                                ((PixelARGB*) dest)->premultiply();
                                 dest += destData.pixelStride;
                                 src += 3;
                             }
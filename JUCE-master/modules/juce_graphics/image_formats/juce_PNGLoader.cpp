@@ -405,10 +405,77 @@ namespace PNGHelpers
 
     JUCE_END_IGNORE_WARNINGS_MSVC
 
+    // Converts a line of RGBA bytes from libpng into premultiplied PixelARGBs, giving exactly
+    // the same results as PixelARGB::setARGB() followed by premultiply()
+    static void convertLineToPremultipliedARGB (const uint8* src, PixelARGB* dest, int width) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_GRAPHICS_USE_SSE2
+        constexpr auto swizzle = (0 << (2 * PixelARGB::indexR)) | (1 << (2 * PixelARGB::indexG))
+                               | (2 << (2 * PixelARGB::indexB)) | (3 << (2 * PixelARGB::indexA));
+
+        const auto zero = _mm_setzero_si128();
+        const auto rounding = _mm_set1_epi16 (0x7f);
+        const auto opaque = _mm_set1_epi16 (0xff);
+
+        alignas (16) int16_t alphaLanes[8] {};
+        alphaLanes[PixelARGB::indexA] = alphaLanes[PixelARGB::indexA + 4] = -1;
+        const auto alphaLaneMask = _mm_load_si128 (reinterpret_cast<const __m128i*> (alphaLanes));
+
+        const auto premultiplyTwo = [&] (__m128i rgba)
+        {
+            const auto argb  = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (rgba, swizzle), swizzle);
+            const auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (rgba, 0xff), 0xff);
+            const auto scaled = _mm_srli_epi16 (_mm_add_epi16 (_mm_mullo_epi16 (argb, alpha), rounding), 8);
+            const auto keep = _mm_or_si128 (_mm_cmpeq_epi16 (alpha, opaque), alphaLaneMask);
+            return _mm_or_si128 (_mm_and_si128 (keep, argb), _mm_andnot_si128 (keep, scaled));
+        };
+
+        for (; i + 4 <= width; i += 4)
+        {
+            const auto rgba = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i * 4));
+            const auto result = _mm_packus_epi16 (premultiplyTwo (_mm_unpacklo_epi8 (rgba, zero)),
+                                                  premultiplyTwo (_mm_unpackhi_epi8 (rgba, zero)));
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i), result);
+        }
+       #elif JUCE_GRAPHICS_USE_NEON
+        const auto opaque = vdup_n_u8 (0xff);
+        const auto rounding = vdupq_n_u16 (0x7f);
+
+        const auto premultiply = [&] (uint8x8_t c, uint8x8_t a)
+        {
+            const auto scaled = vshrn_n_u16 (vaddq_u16 (vmull_u8 (c, a), rounding), 8);
+            return vbsl_u8 (vceq_u8 (a, opaque), c, scaled);
+        };
+
+        for (; i + 8 <= width; i += 8)
+        {
+            const auto rgba = vld4_u8 (src + i * 4);
+
+            uint8x8x4_t argb;
+            argb.val[PixelARGB::indexR] = premultiply (rgba.val[0], rgba.val[3]);
+            argb.val[PixelARGB::indexG] = premultiply (rgba.val[1], rgba.val[3]);
+            argb.val[PixelARGB::indexB] = premultiply (rgba.val[2], rgba.val[3]);
+            argb.val[PixelARGB::indexA] = rgba.val[3];
+
+            vst4_u8 (reinterpret_cast<uint8*> (dest + i), argb);
+        }
+       #endif
+
+        for (; i < width; ++i)
+        {
+            const auto* p = src + i * 4;
+            dest[i].setARGB (p[3], p[0], p[1], p[2]);
+            dest[i].premultiply();
+        }
+    }
+
     static Image createImageFromData (bool hasAlphaChan, int width, int height, png_bytepp rows)
     {
         // now convert the data to a juce image format..
-        Image image (hasAlphaChan ? Image::ARGB : Image::RGB, width, height, hasAlphaChan);
+        // (every pixel gets written below, so there's no need to clear it first)
+        Image image (hasAlphaChan ? Image::ARGB : Image::RGB, width, height, false);
 
         image.getProperties()->set ("originalImageHadAlpha", image.hasAlphaChannel());
         hasAlphaChan = image.hasAlphaChannel(); // (the native image creator may not give back what we expect)
@@ -420,7 +487,11 @@ namespace PNGHelpers
             const uint8* src = rows[y];
             uint8* dest = destData.getLinePointer (y);
 
-            if (hasAlphaChan)
+            if (hasAlphaChan && destData.pixelStride == (int) sizeof (PixelARGB))
+            {
+                convertLineToPremultipliedARGB (src, (PixelARGB*) dest, width);
+            }
+            else if (hasAlphaChan)
             {
                 for (int i = (int) width; --i >= 0;)
                 {
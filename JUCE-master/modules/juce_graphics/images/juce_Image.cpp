@@ -202,40 +202,6 @@ namespace BitmapDataDetail
         return result;
     }
 
-    static void blurDataTriplets (uint8* d, int num, const int delta) noexcept
-    {
-        uint32 last = d[0];
-        d[0] = (uint8) ((d[0] + d[delta] + 1) / 3);
-        d += delta;
-
-        num -= 2;
-
-        do
-        {
-            const uint32 newLast = d[0];
-            d[0] = (uint8) ((last + d[0] + d[delta] + 1) / 3);
-            d += delta;
-            last = newLast;
-        }
-        while (--num > 0);
-
-        d[0] = (uint8) ((last + d[0] + 1) / 3);
-    }
-
-    static void blurSingleChannelImage (uint8* const data, const int w, const int h,
-                                        const int lineStride, const int repetitions) noexcept
-    {
-        jassert (w > 2 && h > 2);
-
-        for (int y = 0; y < h; ++y)
-            for (int i = repetitions; --i >= 0;)
-                blurDataTriplets (data + lineStride * y, w, 1);
-
-        for (int x = 0; x < w; ++x)
-            for (int i = repetitions; --i >= 0;)
-                blurDataTriplets (data + x, h, lineStride);
-    }
-
     template <class PixelType>
     struct PixelIterator
     {
@@ -478,17 +444,39 @@ void ImagePixelData::applySingleChannelBoxBlurEffectInArea (Rectangle<int> bound
     if (pixelFormat == Image::SingleChannel)
     {
         const Image::BitmapData bm (Image { this }, bounds, Image::BitmapData::readWrite);
-        BitmapDataDetail::blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, 2 * radius);
+
+        // Matches the spread of the 2 * radius three-pixel box passes that this used to perform
+        detail::SeparableBlur::apply (bm.data, bm.width, bm.height, bm.lineStride, bm.pixelStride,
+                                      detail::SeparableBlur::getBoxRadiiForVariance (4.0 * radius / 3.0));
     }
 }
 
 void ImagePixelData::applyGaussianBlurEffectInArea (Rectangle<int> bounds, float radius)
 {
-    ImageConvolutionKernel blurKernel (roundToInt (radius * 2.0f));
-    blurKernel.createGaussianBlur (radius);
+    // ImageConvolutionKernel::createGaussianBlur() truncates its kernel to a width of
+    // 2 * radius, so the box passes are matched to the variance of that truncated kernel.
+    const auto size = roundToInt (radius * 2.0f);
+    bounds = bounds.getIntersection ({ width, height });
+
+    if (size < 2 || bounds.isEmpty() || pixelFormat == Image::UnknownFormat)
+        return;
+
+    const auto centre = size >> 1;
+    double total = 0.0, sum = 0.0, sumOfSquares = 0.0;
+
+    for (int i = 0; i < size; ++i)
+    {
+        const auto x = (double) (i - centre);
+        const auto weight = std::exp (-x * x / (2.0 * radius * radius));
+        total += weight;
+        sum += weight * x;
+        sumOfSquares += weight * x * x;
+    }
 
-    Image target { this };
-    blurKernel.applyToImage (target, Image { this }.createCopy(), bounds);
+    const auto mean = sum / total;
+    const Image::BitmapData bm (Image { this }, bounds, Image::BitmapData::readWrite);
+    detail::SeparableBlur::apply (bm.data, bm.width, bm.height, bm.lineStride, bm.pixelStride,
+                                  detail::SeparableBlur::getBoxRadiiForVariance (sumOfSquares / total - mean * mean));
 }
 
 void ImagePixelData::multiplyAllAlphasInArea (Rectangle<int> b, float amount)
@@ -42,6 +42,7 @@ struct ImageCache::Pimpl     : private Timer,
 
     ~Pimpl() override
     {
+        decoderPool.removeAllJobs (true, 5000);
         stopTimer();
         clearSingletonInstance();
     }
@@ -52,17 +53,14 @@ struct ImageCache::Pimpl     : private Timer,
     {
         const ScopedLock sl (lock);
 
-        for (auto& item : images)
+        if (auto* item = images.find (hashCode))
         {
-            if (item.hashCode == hashCode)
-            {
-                item.lastUseTime = Time::getApproximateMillisecondCounter();
-                return item.image;
-            }
+            item->lastUseTime = Time::getApproximateMillisecondCounter();
+            return item->image;
         }
 
         return {};
-     }
+    }
 
     void addImageToCache (const Image& image, const int64 hashCode)
     {
@@ -72,30 +70,58 @@ struct ImageCache::Pimpl     : private Timer,
                 startTimer (2000);
 
             const ScopedLock sl (lock);
-            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter() });
+            images.set (hashCode, { image, Time::getApproximateMillisecondCounter() });
+            trimToSizeLimit();
         }
     }
 
-    void timerCallback() override
+    void loadAsync (const int64 hashCode, std::function<Image()> load, std::function<void (const Image&)> callback)
     {
-        auto now = Time::getApproximateMillisecondCounter();
+        {
+            const ScopedLock sl (lock);
+            auto& callbacks = pendingLoads[hashCode];
+            callbacks.push_back (std::move (callback));
 
-        const ScopedLock sl (lock);
+            // Someone has already asked for this image, so just wait for that load to finish
+            if (callbacks.size() > 1)
+                return;
+        }
 
-        for (int i = images.size(); --i >= 0;)
+        decoderPool.addJob ([this, hashCode, load = std::move (load)]
         {
-            auto& item = images.getReference (i);
+            const auto image = load();
+            addImageToCache (image, hashCode);
+
+            std::vector<std::function<void (const Image&)>> callbacks;
 
-            if (item.image.getReferenceCount() <= 1)
             {
-                if (now > item.lastUseTime + cacheTimeout || now < item.lastUseTime - 1000)
-                    images.remove (i);
+                const ScopedLock sl (lock);
+                callbacks = std::move (pendingLoads[hashCode]);
+                pendingLoads.erase (hashCode);
             }
-            else
+
+            MessageManager::callAsync ([image, callbacks = std::move (callbacks)]
             {
-                item.lastUseTime = now; // multiply-referenced, so this image is still in use.
-            }
-        }
+                for (auto& pendingCallback : callbacks)
+                    NullCheckedInvocation::invoke (pendingCallback, image);
+            });
+        });
+    }
+
+    void timerCallback() override
+    {
+        auto now = Time::getApproximateMillisecondCounter();
+
+        const ScopedLock sl (lock);
+
+        images.removeIf ([this, now] (int64, Item& item)
+        {
+            if (item.image.getReferenceCount() <= 1)
+                return now > item.lastUseTime + cacheTimeout || now < item.lastUseTime - 1000;
+
+            item.lastUseTime = now; // multiply-referenced, so this image is still in use.
+            return false;
+        });
 
         if (images.isEmpty())
             stopTimer();
@@ -105,25 +131,111 @@ struct ImageCache::Pimpl     : private Timer,
     {
         const ScopedLock sl (lock);
 
-        for (int i = images.size(); --i >= 0;)
-            if (images.getReference (i).image.getReferenceCount() <= 1)
-                images.remove (i);
+        images.removeIf ([] (int64, const Item& item) { return item.image.getReferenceCount() <= 1; });
+    }
+
+    void setSizeLimit (size_t newLimit)
+    {
+        const ScopedLock sl (lock);
+        sizeLimit = newLimit;
+        trimToSizeLimit();
+    }
+
+    static size_t getSizeInBytes (const Image& image)
+    {
+        const auto bytesPerPixel = image.getFormat() == Image::ARGB ? 4
+                                 : image.getFormat() == Image::RGB  ? 3 : 1;
+
+        return (size_t) image.getWidth() * (size_t) image.getHeight() * (size_t) bytesPerPixel;
+    }
+
+    // Evicts the least recently used images that nobody else is referencing until the
+    // cache fits the limit. Images that are still in use can't be freed, so they're skipped.
+    void trimToSizeLimit()
+    {
+        size_t total = 0;
+        std::vector<std::pair<uint32, int64>> unused;
+
+        for (const auto& entry : images)
+        {
+            total += getSizeInBytes (entry.value.image);
+
+            if (entry.value.image.getReferenceCount() <= 1)
+                unused.emplace_back (entry.value.lastUseTime, entry.key);
+        }
+
+        if (total <= sizeLimit)
+            return;
+
+        std::sort (unused.begin(), unused.end());
+
+        for (const auto& [lastUseTime, hashCode] : unused)
+        {
+            if (total <= sizeLimit)
+                break;
+
+            total -= getSizeInBytes (images.find (hashCode)->image);
+            images.remove (hashCode);
+        }
     }
 
     struct Item
     {
         Image image;
-        int64 hashCode;
         uint32 lastUseTime;
     };
 
-    Array<Item> images;
+    FlatHashMap<int64, Item> images;
+    std::map<int64, std::vector<std::function<void (const Image&)>>> pendingLoads;
     CriticalSection lock;
     unsigned int cacheTimeout = 5000;
+    size_t sizeLimit = std::numeric_limits<size_t>::max();
+
+    ThreadPool decoderPool { ThreadPoolOptions{}.withThreadName ("JUCE ImageCache")
+                                                .withNumberOfThreads (2) };
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
 
+//==============================================================================
+static Image loadImageToFit (const File& file, int maxWidth, int maxHeight)
+{
+    auto image = [&]
+    {
+        if (maxWidth > 0 && maxHeight > 0)
+        {
+            FileInputStream stream (file);
+            JPEGImageFormat jpeg;
+
+            if (stream.openedOk() && jpeg.canUnderstand (stream) && stream.setPosition (0))
+            {
+                jpeg.setDecodeSizeHint (maxWidth, maxHeight);
+                return jpeg.decodeImage (stream);
+            }
+        }
+
+        return ImageFileFormat::loadFrom (file);
+    }();
+
+    if (image.isNull() || maxWidth <= 0 || maxHeight <= 0
+         || (image.getWidth() <= maxWidth && image.getHeight() <= maxHeight))
+        return image;
+
+    const auto scale = jmin ((double) maxWidth / image.getWidth(), (double) maxHeight / image.getHeight());
+
+    return image.rescaled (jmax (1, roundToInt (image.getWidth() * scale)),
+                           jmax (1, roundToInt (image.getHeight() * scale)),
+                           Graphics::highResamplingQuality);
+}
+
+static int64 getHashCodeForFile (const File& file, int maxWidth, int maxHeight)
+{
+    if (maxWidth <= 0 || maxHeight <= 0)
+        return file.hashCode64();
+
+    return (file.getFullPathName() + "@" + String (maxWidth) + "x" + String (maxHeight)).hashCode64();
+}
+
 //==============================================================================
 Image ImageCache::getFromHashCode (const int64 hashCode)
 {
@@ -140,18 +252,101 @@ void ImageCache::addImageToCache (const Image& image, const int64 hashCode)
 
 Image ImageCache::getFromFile (const File& file)
 {
-    auto hashCode = file.hashCode64();
+    return getFromFile (file, 0, 0);
+}
+
+Image ImageCache::getFromFile (const File& file, int maxWidth, int maxHeight)
+{
+    auto hashCode = getHashCodeForFile (file, maxWidth, maxHeight);
     auto image = getFromHashCode (hashCode);
 
     if (image.isNull())
     {
-        image = ImageFileFormat::loadFrom (file);
+        image = loadImageToFit (file, maxWidth, maxHeight);
         addImageToCache (image, hashCode);
     }
 
     return image;
 }
 
+Array<Image> ImageCache::getFromFiles (const Array<File>& files, int maxWidth, int maxHeight)
+{
+    Array<Image> results;
+    Array<int> toLoad;
+
+    for (const auto& file : files)
+    {
+        results.add (getFromHashCode (getHashCodeForFile (file, maxWidth, maxHeight)));
+
+        if (results.getLast().isNull())
+            toLoad.add (results.size() - 1);
+    }
+
+    if (toLoad.isEmpty())
+        return results;
+
+    std::atomic<int> nextToLoad { 0 };
+
+    const auto loadNext = [&]
+    {
+        for (int i; (i = nextToLoad++) < toLoad.size();)
+        {
+            const auto index = toLoad.getUnchecked (i);
+            results.getReference (index) = loadImageToFit (files.getReference (index), maxWidth, maxHeight);
+        }
+    };
+
+    const auto numHelpers = jmin (SystemStats::getNumCpus(), toLoad.size()) - 1;
+
+    if (numHelpers > 0)
+    {
+        std::atomic<int> numHelpersFinished { 0 };
+        WaitableEvent helpersFinished;
+
+        ThreadPool pool { ThreadPoolOptions{}.withThreadName ("JUCE ImageCache loader")
+                                             .withNumberOfThreads (numHelpers) };
+
+        for (int i = 0; i < numHelpers; ++i)
+        {
+            pool.addJob ([&]
+            {
+                loadNext();
+
+                if (++numHelpersFinished == numHelpers)
+                    helpersFinished.signal();
+            });
+        }
+
+        loadNext();
+        helpersFinished.wait();
+    }
+    else
+    {
+        loadNext();
+    }
+
+    for (auto index : toLoad)
+        addImageToCache (results.getReference (index),
+                         getHashCodeForFile (files.getReference (index), maxWidth, maxHeight));
+
+    return results;
+}
+
+Image ImageCache::getFromFileAsync (const File& file,
+                                    std::function<void (const Image&)> callback,
+                                    int maxWidth, int maxHeight)
+{
+    auto hashCode = getHashCodeForFile (file, maxWidth, maxHeight);
+    auto image = getFromHashCode (hashCode);
+
+    if (image.isNull())
+        Pimpl::getInstance()->loadAsync (hashCode,
+                                         [file, maxWidth, maxHeight] { return loadImageToFit (file, maxWidth, maxHeight); },
+                                         std::move (callback));
+
+    return image;
+}
+
 Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
 {
     auto hashCode = (int64) (pointer_sized_int) imageData;
@@ -172,6 +367,11 @@ void ImageCache::setCacheTimeout (const int millisecs)
     Pimpl::getInstance()->cacheTimeout = (unsigned int) millisecs;
 }
 
+void ImageCache::setCacheSizeLimit (size_t maxBytes)
+{
+    Pimpl::getInstance()->setSizeLimit (maxBytes);
+}
+
 void ImageCache::releaseUnusedImages()
 {
     Pimpl::getInstance()->releaseUnusedImages();
@@ -72,6 +72,48 @@ public:
     */
     static Image getFromFile (const File& file);
 
+    /** Loads an image from a file, shrinking it to fit within the given size.
+
+        Images that already fit are returned at their original size. The shrunken image
+        is cached separately from the full-size one, so thumbnails don't keep the large
+        originals in memory. If either size is zero or less, this is the same as
+        getFromFile (file).
+
+        @see getFromFileAsync
+    */
+    static Image getFromFile (const File& file, int maxWidth, int maxHeight);
+
+    /** Loads an image from a file on a background thread, so that the caller doesn't
+        have to wait for it to be decoded.
+
+        If the image is already in the cache it is returned straight away and the callback
+        is not called. Otherwise this returns an invalid image, which you can treat as a
+        placeholder, and the callback will later be called on the message thread with the
+        loaded image (or an invalid image if it couldn't be loaded). Several requests for
+        the same image while it's loading are all served by a single decode.
+
+        The callback may be called after the object that asked for the image has been
+        deleted, so use a SafePointer or similar if it refers to a component.
+
+        If maxWidth and maxHeight are greater than zero, the image is shrunk to fit within
+        them on the background thread, in the same way as getFromFile (file, maxWidth, maxHeight).
+    */
+    /** Loads a set of images from files, decoding any that aren't already cached in
+        parallel on all the available CPU cores.
+
+        This is intended for loading the images that an app needs at startup. The call
+        blocks until they're all loaded, and the results are in the same order as the
+        files, with an invalid image for any that couldn't be loaded. If maxWidth and
+        maxHeight are greater than zero, the images are shrunk to fit within them, in the
+        same way as getFromFile (file, maxWidth, maxHeight).
+    */
+    static Array<Image> getFromFiles (const Array<File>& files, int maxWidth = 0, int maxHeight = 0);
+
+    static Image getFromFileAsync (const File& file,
+                                   std::function<void (const Image&)> callback,
+                                   int maxWidth = 0,
+                                   int maxHeight = 0);
+
     /** Loads an image from an in-memory image file, (or just returns the image if it's already cached).
 
         If the cache already contains an image that was loaded from this block of memory,
@@ -117,6 +159,14 @@ public:
     */
     static void setCacheTimeout (int millisecs);
 
+    /** Limits the amount of memory that the pixels of cached images may occupy.
+
+        When the limit is exceeded, the least recently used images that aren't referenced
+        anywhere else are released straight away, rather than waiting for the cache timeout.
+        Images that are still in use are never released. By default there is no limit.
+    */
+    static void setCacheSizeLimit (size_t maxBytes);
+
     /** Releases any images in the cache that aren't being referenced by active
         Image objects.
     */
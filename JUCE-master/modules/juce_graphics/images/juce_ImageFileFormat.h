@@ -195,6 +195,19 @@ public:
     */
     void setQuality (float newQuality);
 
+    /** Tells the decoder the largest size that the image will be displayed at.
+
+        Large JPEGs can then be reduced by a half, a quarter or an eighth while they are
+        being decompressed, which is much faster than decoding them at full size and
+        rescaling them. The decoded image is never made smaller than would be needed to
+        fit it within these bounds without upscaling, so you'll usually still want to
+        rescale it to the exact size you need.
+
+        Passing zero for either size decodes at full size, which is the default. This hint
+        is ignored on platforms where JPEGs are decoded by the OS.
+    */
+    void setDecodeSizeHint (int maxWidth, int maxHeight);
+
     //==============================================================================
     String getFormatName() override;
     bool usesFileExtension (const File&) override;
@@ -204,6 +217,7 @@ public:
 
 private:
     float quality;
+    Rectangle<int> decodeSizeHint;
 };
 
 //==============================================================================
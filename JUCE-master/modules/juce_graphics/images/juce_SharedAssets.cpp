@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SharedAssets::Registry
+{
+public:
+    Image getImage (const void* data, size_t size)
+    {
+        const ScopedLock sl (lock);
+        auto& image = images[{ data, size }];
+
+        if (image.isNull())
+            image = ImageCache::getFromMemory (data, (int) size);
+
+        return image;
+    }
+
+    Image getImage (const File& file)
+    {
+        const ScopedLock sl (lock);
+        auto& image = fileImages[file.getFullPathName()];
+
+        if (image.isNull())
+            image = ImageCache::getFromFile (file);
+
+        return image;
+    }
+
+    Typeface::Ptr getTypeface (const void* data, size_t size)
+    {
+        const ScopedLock sl (lock);
+        auto& typeface = typefaces[{ data, size }];
+
+        if (typeface == nullptr)
+            typeface = Typeface::createSystemTypefaceFor (data, size);
+
+        return typeface;
+    }
+
+    std::shared_ptr<void> getObject (const String& key, const void* typeTag, const std::function<std::shared_ptr<void>()>& create)
+    {
+        const ScopedLock sl (lock);
+        auto& weak = objects[{ typeTag, key }];
+
+        if (auto existing = weak.lock())
+            return existing;
+
+        auto created = create();
+        weak = created;
+        return created;
+    }
+
+private:
+    using DataKey = std::pair<const void*, size_t>;
+
+    CriticalSection lock;
+    std::map<DataKey, Image> images;
+    std::map<String, Image> fileImages;
+    std::map<DataKey, Typeface::Ptr> typefaces;
+    std::map<std::pair<const void*, String>, std::weak_ptr<void>> objects;
+};
+
+//==============================================================================
+SharedAssets::SharedAssets() = default;
+SharedAssets::~SharedAssets() = default;
+
+Image SharedAssets::getImage (const void* imageFileData, size_t dataSize)
+{
+    return registry->getImage (imageFileData, dataSize);
+}
+
+Image SharedAssets::getImage (const File& file)
+{
+    return registry->getImage (file);
+}
+
+Typeface::Ptr SharedAssets::getTypeface (const void* fontFileData, size_t dataSize)
+{
+    return registry->getTypeface (fontFileData, dataSize);
+}
+
+std::shared_ptr<void> SharedAssets::getObject (const String& key, const void* typeTag, const std::function<std::shared_ptr<void>()>& create)
+{
+    return registry->getObject (key, typeTag, create);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SharedAssetsTests final : public UnitTest
+{
+public:
+    SharedAssetsTests()
+        : UnitTest ("SharedAssets", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        // The ImageCache uses a timer to release unused images
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("Images from the same data are shared");
+        {
+            const auto data = createPNG();
+
+            SharedAssets a, b;
+            const auto imageA = a.getImage (data.getData(), data.getSize());
+            const auto imageB = b.getImage (data.getData(), data.getSize());
+
+            expect (imageA.isValid());
+            expectEquals (imageA.getWidth(), 16);
+            expect (imageA == imageB);
+            expect (imageA == ImageCache::getFromMemory (data.getData(), (int) data.getSize()));
+        }
+
+        beginTest ("Images are kept while any SharedAssets object exists");
+        {
+            const auto data = createPNG();
+            auto first = std::make_unique<SharedAssets>();
+            auto* pixels = first->getImage (data.getData(), data.getSize()).getPixelData().get();
+
+            SharedAssets second;
+            first.reset();
+            ImageCache::releaseUnusedImages();
+
+            expect (second.getImage (data.getData(), data.getSize()).getPixelData().get() == pixels);
+        }
+
+        beginTest ("Objects are shared by type and key, and released when unused");
+        {
+            struct Counted
+            {
+                Counted()   { ++numInstances; }
+                ~Counted()  { --numInstances; }
+            };
+
+            SharedAssets a, b;
+            auto x = a.getObject<Counted>();
+            auto y = b.getObject<Counted>();
+            auto z = b.getObject<Counted> ("other", [] { return std::make_shared<Counted>(); });
+
+            expect (x == y);
+            expect (x != z);
+            expect (a.getObject<int> ({}, [] { return std::make_shared<int> (3); }).get() != (void*) x.get());
+            expectEquals (numInstances, 2);
+
+            x.reset();
+            y.reset();
+            z.reset();
+            expectEquals (numInstances, 0);
+
+            expect (a.getObject<Counted>() != nullptr);
+            expectEquals (numInstances, 0);
+        }
+    }
+
+private:
+    static inline int numInstances = 0;
+
+    static MemoryBlock createPNG()
+    {
+        Image image (Image::ARGB, 16, 8, true, SoftwareImageType());
+        image.clear (image.getBounds(), Colours::red);
+
+        MemoryOutputStream out;
+        PNGImageFormat().writeImageToStream (image, out);
+        return out.getMemoryBlock();
+    }
+};
+
+static SharedAssetsTests sharedAssetsTests;
+
+#endif
+
+} // namespace juce
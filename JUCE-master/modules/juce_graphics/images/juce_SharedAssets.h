@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Shares decoded assets, such as images, typefaces and look-and-feels, between all the
+    instances of a plugin or other class in the process.
+
+    Each instance of a plugin normally decodes its own copy of the images and fonts in its
+    BinaryData, so a session with many instances holds many identical copies. If each
+    instance keeps a SharedAssets object and loads its assets through it, the first
+    instance decodes them, and all the others get the same objects.
+
+    All the SharedAssets objects refer to one registry, which is managed by a
+    SharedResourcePointer. Images and typefaces are kept until the last SharedAssets object
+    is deleted, so closing and reopening an editor doesn't decode them again, and nothing is
+    left behind when the last instance goes away. Objects returned by getObject() are only
+    kept while something holds a pointer to them.
+
+    Assets loaded from memory are identified by the address and size of their data, so
+    this is intended for data that doesn't move or change, like BinaryData.
+
+    @code
+    class MyEditor  : public AudioProcessorEditor
+    {
+    public:
+        MyEditor (MyProcessor& p)
+            : AudioProcessorEditor (p),
+              background (assets.getImage (BinaryData::skin_png, BinaryData::skin_pngSize)),
+              lookAndFeel (assets.getObject<MyLookAndFeel>())
+        {
+            setLookAndFeel (lookAndFeel.get());
+        }
+
+        ...
+
+    private:
+        SharedAssets assets;
+        Image background;
+        std::shared_ptr<MyLookAndFeel> lookAndFeel;
+    };
+    @endcode
+
+    @see ImageCache, SharedResourcePointer
+
+    @tags{Graphics}
+*/
+class JUCE_API SharedAssets
+{
+public:
+    //==============================================================================
+    /** Creates an object that refers to the shared registry, creating the registry if
+        this is the first one.
+    */
+    SharedAssets();
+
+    /** Destructor. If this is the last SharedAssets object, the registry and any assets
+        that it holds are released.
+    */
+    ~SharedAssets();
+
+    //==============================================================================
+    /** Returns an image decoded from the given image file data.
+
+        The image is decoded the first time it is asked for, and is also added to the
+        ImageCache, so ImageCache::getFromMemory() returns the same image for this data.
+
+        Remember that the image is shared, so call Image::duplicateIfShared() before
+        drawing into it.
+    */
+    Image getImage (const void* imageFileData, size_t dataSize);
+
+    /** Returns an image loaded from a file, which is also added to the ImageCache.
+        @see ImageCache::getFromFile
+    */
+    Image getImage (const File& file);
+
+    /** Returns a typeface created from the given font file data with
+        Typeface::createSystemTypefaceFor(). The typeface is only created once.
+    */
+    Typeface::Ptr getTypeface (const void* fontFileData, size_t dataSize);
+
+    //==============================================================================
+    /** Returns the shared object of this type with the given key, calling the create
+        function to make a new one if there isn't one that's still in use.
+
+        The returned object is shared with every other caller that asks for the same type
+        and key, and is deleted once they've all released it. The create function is called
+        while the registry is locked, so it mustn't use this SharedAssets object itself.
+    */
+    template <typename ObjectType, typename CreateFn>
+    std::shared_ptr<ObjectType> getObject (const String& key, CreateFn&& create)
+    {
+        return std::static_pointer_cast<ObjectType> (getObject (key, getTypeTag<ObjectType>(), [&]
+        {
+            return std::shared_ptr<void> (create());
+        }));
+    }
+
+    /** Returns the shared default-constructed object of this type, such as a LookAndFeel.
+        @see getObject
+    */
+    template <typename ObjectType>
+    std::shared_ptr<ObjectType> getObject()
+    {
+        return getObject<ObjectType> ({}, [] { return std::make_shared<ObjectType>(); });
+    }
+
+private:
+    //==============================================================================
+    class Registry;
+    SharedResourcePointer<Registry> registry;
+
+    template <typename ObjectType>
+    static const void* getTypeTag() noexcept
+    {
+        static const char tag = 0;
+        return &tag;
+    }
+
+    std::shared_ptr<void> getObject (const String& key, const void* typeTag, const std::function<std::shared_ptr<void>()>& create);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedAssets)
+};
+
+} // namespace juce
@@ -87,6 +87,16 @@
  #define JUCE_DISABLE_COREGRAPHICS_FONT_SMOOTHING 0
 #endif
 
+/** Config: JUCE_RENDERING_METRICS
+
+    Enables the RenderingMetrics class, which collects paint timings and counters from
+    all the renderers, and can stream them to another process over a local socket.
+    This adds a little overhead to every paint, so it's disabled by default.
+*/
+#ifndef JUCE_RENDERING_METRICS
+ #define JUCE_RENDERING_METRICS 0
+#endif
+
 #ifndef JUCE_INCLUDE_PNGLIB_CODE
  #define JUCE_INCLUDE_PNGLIB_CODE 1
 #endif
@@ -145,10 +155,14 @@ namespace juce
 #include "fonts/juce_GlyphArrangement.h"
 #include "fonts/juce_TextLayout.h"
 #include "contexts/juce_LowLevelGraphicsContext.h"
+#include "contexts/juce_RenderingMetrics.h"
 #include "images/juce_ScaledImage.h"
+#include "images/juce_SharedAssets.h"
 #include "fonts/juce_LruCache.h"
+#include "native/juce_PixelSpanBlending.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
 #include "effects/juce_GlowEffect.h"
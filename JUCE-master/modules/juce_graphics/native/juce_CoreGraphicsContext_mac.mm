@@ -127,6 +127,7 @@ public:
         if (cgim != nullptr)
             return cgim;
 
+        JUCE_RENDERING_METRICS_COUNT (imageUploads)
         const Image::BitmapData srcData (juceImage, Image::BitmapData::readOnly);
 
         const auto usableSize = jmin ((size_t) srcData.lineStride * (size_t) srcData.height, srcData.size);
@@ -164,6 +165,7 @@ public:
         if (cachedImageRef != nullptr)
             return CFUniquePtr<CGImageRef> { CGImageRetain (cachedImageRef.get()) };
 
+        JUCE_RENDERING_METRICS_COUNT (imageUploads)
         const Image::BitmapData srcData { Image { this }, Image::BitmapData::readOnly };
 
         detail::DataProviderPtr provider { CGDataProviderCreateWithData (new ImageDataContainer::Ptr (imageData),
@@ -130,6 +130,7 @@ class FTTypefaceList final : private DeletedAtShutdown
 public:
     FTTypefaceList()
     {
+        JUCE_SCOPED_INITIALISER_TRACE ("scanning font directories")
         scanFontPaths (getDefaultFontDirectories());
     }
 
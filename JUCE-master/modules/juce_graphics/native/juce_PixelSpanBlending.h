@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if ! defined (JUCE_GRAPHICS_USE_SSE2) && ! defined (JUCE_GRAPHICS_USE_NEON) && JUCE_LITTLE_ENDIAN
+ #if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define JUCE_GRAPHICS_USE_SSE2 1
+  #include <emmintrin.h>
+ #elif defined (__ARM_NEON__) || defined (__ARM_NEON)
+  #define JUCE_GRAPHICS_USE_NEON 1
+  #include <arm_neon.h>
+ #endif
+#endif
+
+namespace juce::RenderingHelpers::SpanBlending
+{
+
+/*  These functions composite runs of contiguous pixels, four at a time where the
+    target has SSE2 or NEON. Each one produces exactly the same result as calling the
+    corresponding PixelARGB/PixelRGB::blend() method on every pixel in turn, so
+    callers can switch between them without any visible difference.
+*/
+
+#if JUCE_GRAPHICS_USE_SSE2
+ static_assert (PixelARGB::indexA == 3);
+
+ forcedinline __m128i blendFour (__m128i src, __m128i dst, __m128i extraAlpha, bool useExtraAlpha) noexcept
+ {
+     const auto zero = _mm_setzero_si128();
+     const auto full = _mm_set1_epi16 (0x100);
+
+     auto srcLo = _mm_unpacklo_epi8 (src, zero);
+     auto srcHi = _mm_unpackhi_epi8 (src, zero);
+
+     if (useExtraAlpha)
+     {
+         srcLo = _mm_srli_epi16 (_mm_mullo_epi16 (srcLo, extraAlpha), 8);
+         srcHi = _mm_srli_epi16 (_mm_mullo_epi16 (srcHi, extraAlpha), 8);
+     }
+
+     const auto alphaLo = _mm_sub_epi16 (full, _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (srcLo, 0xff), 0xff));
+     const auto alphaHi = _mm_sub_epi16 (full, _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (srcHi, 0xff), 0xff));
+
+     const auto dstLo = _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (dst, zero), alphaLo), 8);
+     const auto dstHi = _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (dst, zero), alphaHi), 8);
+
+     return _mm_packus_epi16 (_mm_add_epi16 (srcLo, dstLo), _mm_add_epi16 (srcHi, dstHi));
+ }
+
+ forcedinline __m128i blendFourWithConstant (__m128i srcLo, __m128i srcHi, __m128i alpha, __m128i dst) noexcept
+ {
+     const auto zero = _mm_setzero_si128();
+     const auto dstLo = _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (dst, zero), alpha), 8);
+     const auto dstHi = _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (dst, zero), alpha), 8);
+
+     return _mm_packus_epi16 (_mm_add_epi16 (srcLo, dstLo), _mm_add_epi16 (srcHi, dstHi));
+ }
+#elif JUCE_GRAPHICS_USE_NEON
+ static_assert (PixelARGB::indexA == 3);
+
+ forcedinline uint8x16_t blendFour (uint8x16_t src, uint8x16_t dst, uint16x8_t extraAlpha, bool useExtraAlpha) noexcept
+ {
+     const auto full = vdupq_n_u16 (0x100);
+
+     const auto srcAlpha = vreinterpretq_u8_u32 (vmulq_n_u32 (vshrq_n_u32 (vreinterpretq_u32_u8 (src), 24), 0x01010101));
+
+     auto srcLo   = vmovl_u8 (vget_low_u8  (src));
+     auto srcHi   = vmovl_u8 (vget_high_u8 (src));
+     auto alphaLo = vmovl_u8 (vget_low_u8  (srcAlpha));
+     auto alphaHi = vmovl_u8 (vget_high_u8 (srcAlpha));
+
+     if (useExtraAlpha)
+     {
+         srcLo   = vshrq_n_u16 (vmulq_u16 (srcLo,   extraAlpha), 8);
+         srcHi   = vshrq_n_u16 (vmulq_u16 (srcHi,   extraAlpha), 8);
+         alphaLo = vshrq_n_u16 (vmulq_u16 (alphaLo, extraAlpha), 8);
+         alphaHi = vshrq_n_u16 (vmulq_u16 (alphaHi, extraAlpha), 8);
+     }
+
+     const auto dstLo = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_low_u8  (dst)), vsubq_u16 (full, alphaLo)), 8);
+     const auto dstHi = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_high_u8 (dst)), vsubq_u16 (full, alphaHi)), 8);
+
+     return vcombine_u8 (vqmovn_u16 (vaddq_u16 (srcLo, dstLo)), vqmovn_u16 (vaddq_u16 (srcHi, dstHi)));
+ }
+
+ forcedinline uint8x16_t blendFourWithConstant (uint16x8_t srcLo, uint16x8_t srcHi, uint16x8_t alpha, uint8x16_t dst) noexcept
+ {
+     const auto dstLo = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_low_u8  (dst)), alpha), 8);
+     const auto dstHi = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_high_u8 (dst)), alpha), 8);
+
+     return vcombine_u8 (vqmovn_u16 (vaddq_u16 (srcLo, dstLo)), vqmovn_u16 (vaddq_u16 (srcHi, dstHi)));
+ }
+#endif
+
+/** Blends a run of premultiplied pixels onto a contiguous ARGB span.
+
+    If extraAlpha is less than 0x100 the source opacity is scaled by it first,
+    in the same way as PixelARGB::blend (src, extraAlpha).
+*/
+inline void blendSpan (PixelARGB* dest, const PixelARGB* src, int width, uint32 extraAlpha = 0x100) noexcept
+{
+    const auto useExtraAlpha = extraAlpha < 0x100;
+    int i = 0;
+
+   #if JUCE_GRAPHICS_USE_SSE2
+    const auto extra = _mm_set1_epi16 ((short) extraAlpha);
+
+    for (; i + 4 <= width; i += 4)
+    {
+        const auto s = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+        const auto d = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (dest + i));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i), blendFour (s, d, extra, useExtraAlpha));
+    }
+   #elif JUCE_GRAPHICS_USE_NEON
+    const auto extra = vdupq_n_u16 ((uint16) extraAlpha);
+
+    for (; i + 4 <= width; i += 4)
+    {
+        const auto s = vld1q_u8 (reinterpret_cast<const uint8*> (src + i));
+        const auto d = vld1q_u8 (reinterpret_cast<const uint8*> (dest + i));
+        vst1q_u8 (reinterpret_cast<uint8*> (dest + i), blendFour (s, d, extra, useExtraAlpha));
+    }
+   #endif
+
+    if (useExtraAlpha)
+    {
+        for (; i < width; ++i)
+            dest[i].blend (src[i], extraAlpha);
+    }
+    else
+    {
+        for (; i < width; ++i)
+            dest[i].blend (src[i]);
+    }
+}
+
+/** Blends a single premultiplied colour onto a contiguous ARGB span. */
+inline void blendSolid (PixelARGB* dest, PixelARGB colour, int width) noexcept
+{
+    int i = 0;
+
+   #if JUCE_GRAPHICS_USE_SSE2 || JUCE_GRAPHICS_USE_NEON
+    const auto c = colour.getNativeARGB();
+    const auto alpha = (uint16) (0x100 - colour.getAlpha());
+   #endif
+
+   #if JUCE_GRAPHICS_USE_SSE2
+    const auto s = _mm_set1_epi32 ((int) c);
+    const auto srcLo = _mm_unpacklo_epi8 (s, _mm_setzero_si128());
+    const auto alphas = _mm_set1_epi16 ((short) alpha);
+
+    for (; i + 4 <= width; i += 4)
+    {
+        const auto d = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (dest + i));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i), blendFourWithConstant (srcLo, srcLo, alphas, d));
+    }
+   #elif JUCE_GRAPHICS_USE_NEON
+    const auto srcLo = vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (c)));
+    const auto alphas = vdupq_n_u16 (alpha);
+
+    for (; i + 4 <= width; i += 4)
+    {
+        const auto d = vld1q_u8 (reinterpret_cast<const uint8*> (dest + i));
+        vst1q_u8 (reinterpret_cast<uint8*> (dest + i), blendFourWithConstant (srcLo, srcLo, alphas, d));
+    }
+   #endif
+
+    for (; i < width; ++i)
+        dest[i].blend (colour);
+}
+
+/** Blends a single premultiplied colour onto a contiguous RGB span.
+
+    Because every channel gets the same treatment, this works on the raw bytes,
+    using a source pattern that repeats every three 16-byte blocks.
+*/
+inline void blendSolid (PixelRGB* dest, PixelARGB colour, int width) noexcept
+{
+    auto* bytes = reinterpret_cast<uint8*> (dest);
+    const auto numBytes = width * 3;
+    const auto alpha = (uint32) (0x100 - colour.getAlpha());
+
+    uint8 components[3];
+    components[PixelRGB::indexR] = colour.getRed();
+    components[PixelRGB::indexG] = colour.getGreen();
+    components[PixelRGB::indexB] = colour.getBlue();
+
+    int i = 0;
+
+   #if JUCE_GRAPHICS_USE_SSE2 || JUCE_GRAPHICS_USE_NEON
+    uint8 pattern[48];
+
+    for (int j = 0; j < 48; ++j)
+        pattern[j] = components[j % 3];
+   #endif
+
+   #if JUCE_GRAPHICS_USE_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto alphas = _mm_set1_epi16 ((short) alpha);
+    __m128i srcLo[3], srcHi[3];
+
+    for (int j = 0; j < 3; ++j)
+    {
+        const auto s = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (pattern + j * 16));
+        srcLo[j] = _mm_unpacklo_epi8 (s, zero);
+        srcHi[j] = _mm_unpackhi_epi8 (s, zero);
+    }
+
+    for (int block = 0; i + 16 <= numBytes; i += 16, block = (block + 1) % 3)
+    {
+        const auto d = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (bytes + i));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (bytes + i), blendFourWithConstant (srcLo[block], srcHi[block], alphas, d));
+    }
+   #elif JUCE_GRAPHICS_USE_NEON
+    const auto alphas = vdupq_n_u16 ((uint16) alpha);
+    uint16x8_t srcLo[3], srcHi[3];
+
+    for (int j = 0; j < 3; ++j)
+    {
+        const auto s = vld1q_u8 (pattern + j * 16);
+        srcLo[j] = vmovl_u8 (vget_low_u8  (s));
+        srcHi[j] = vmovl_u8 (vget_high_u8 (s));
+    }
+
+    for (int block = 0; i + 16 <= numBytes; i += 16, block = (block + 1) % 3)
+    {
+        const auto d = vld1q_u8 (bytes + i);
+        vst1q_u8 (bytes + i, blendFourWithConstant (srcLo[block], srcHi[block], alphas, d));
+    }
+   #endif
+
+    for (; i < numBytes; ++i)
+        bytes[i] = (uint8) jmin (0xffu, components[i % 3] + ((bytes[i] * alpha) >> 8));
+}
+
+} // namespace juce::RenderingHelpers::SpanBlending
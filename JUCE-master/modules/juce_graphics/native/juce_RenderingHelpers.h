@@ -171,11 +171,17 @@ public:
 //==============================================================================
 /** Holds a cache of recently-used glyph objects of some type.
 
+    Entries are found by hashing the font and glyph number, and the least recently
+    used ones are evicted once the layers held by the cache exceed a byte budget.
+    The software and OpenGL renderers both draw from this one cache.
+
     @tags{Graphics}
 */
 class GlyphCache  : private DeletedAtShutdown
 {
 public:
+    using Layers = std::shared_ptr<const std::vector<GlyphLayer>>;
+
     GlyphCache() = default;
 
     ~GlyphCache() override
@@ -197,22 +203,44 @@ public:
     void reset()
     {
         const ScopedLock sl { lock };
-        cache = {};
+        entries.clear();
+        lru.clear();
+        totalBytes = 0;
     }
 
-    const auto& get (const Font& font, const int glyphNumber)
+    /** Changes the amount of memory the cached glyphs may occupy before old ones are evicted. */
+    void setByteBudget (size_t newBudget)
     {
         const ScopedLock sl { lock };
-        return cache.get (Key { font, glyphNumber }, [] (const auto& key)
-        {
-            auto fontHeight = key.font.getHeight();
-            auto typeface = key.font.getTypefacePtr();
-            return typeface->getLayersForGlyph (key.font.getMetricsKind(),
-                                                key.glyph,
-                                                AffineTransform::scale (fontHeight * key.font.getHorizontalScale(),
-                                                                        fontHeight),
-                                                fontHeight);
-        });
+        byteBudget = newBudget;
+        evictUntilWithinBudget();
+    }
+
+    // The layers are shared and immutable, so they stay valid even if another thread
+    // evicts the entry as soon as the lock is released
+    Layers get (const Font& font, const int glyphNumber)
+    {
+        Key key { font, glyphNumber };
+
+        const ScopedLock sl { lock };
+
+        if (const auto iter = entries.find (key); iter != entries.end())
+        {
+            JUCE_RENDERING_METRICS_COUNT (glyphCacheHits)
+            lru.splice (lru.end(), lru, iter->second.lruPosition);
+            return iter->second.layers;
+        }
+
+        JUCE_RENDERING_METRICS_COUNT (glyphCacheMisses)
+        auto layers = createLayers (key);
+        const auto size = getSizeInBytes (*layers);
+
+        const auto position = lru.insert (lru.end(), key);
+        entries.emplace (std::move (key), Entry { layers, position, size });
+        totalBytes += size;
+
+        evictUntilWithinBudget();
+        return layers;
     }
 
 private:
@@ -221,19 +249,81 @@ private:
         Font font;
         int glyph;
 
-        bool operator< (const Key& other) const
+        bool operator== (const Key& other) const
         {
-            if (glyph < other.glyph)
-                return true;
-
-            if (other.glyph < glyph)
-                return false;
+            return glyph == other.glyph
+                && ! GraphicsFontHelpers::compareFont (font, other.font)
+                && ! GraphicsFontHelpers::compareFont (other.font, font);
+        }
+    };
 
-            return GraphicsFontHelpers::compareFont (font, other.font);
+    struct KeyHash
+    {
+        size_t operator() (const Key& key) const noexcept
+        {
+            // Only uses properties that fonts which compare equal must share
+            auto h = (size_t) key.font.getTypefaceName().hash();
+            h = h * 31 + (size_t) key.font.getTypefaceStyle().hash();
+            h = h * 31 + std::hash<float>() (key.font.getHeight());
+            h = h * 31 + std::hash<float>() (key.font.getHorizontalScale());
+            return h * 31 + (size_t) key.glyph;
         }
     };
 
-    LruCache<Key, std::vector<GlyphLayer>> cache;
+    struct Entry
+    {
+        Layers layers;
+        std::list<Key>::iterator lruPosition;
+        size_t size;
+    };
+
+    static Layers createLayers (const Key& key)
+    {
+        auto fontHeight = key.font.getHeight();
+        auto typeface = key.font.getTypefacePtr();
+        auto layers = typeface->getLayersForGlyph (key.font.getMetricsKind(),
+                                                   key.glyph,
+                                                   AffineTransform::scale (fontHeight * key.font.getHorizontalScale(),
+                                                                           fontHeight),
+                                                   fontHeight);
+
+        for (auto& layer : layers)
+            if (auto* colourLayer = std::get_if<ColourLayer> (&layer.layer))
+                colourLayer->clip.optimiseTable();
+
+        return std::make_shared<const std::vector<GlyphLayer>> (std::move (layers));
+    }
+
+    static size_t getSizeInBytes (const std::vector<GlyphLayer>& layers)
+    {
+        auto size = sizeof (Entry) + sizeof (Key) + layers.size() * sizeof (GlyphLayer);
+
+        for (const auto& layer : layers)
+        {
+            if (auto* colourLayer = std::get_if<ColourLayer> (&layer.layer))
+                size += colourLayer->clip.getAllocatedSize();
+            else if (auto* imageLayer = std::get_if<ImageLayer> (&layer.layer))
+                size += (size_t) (imageLayer->image.getWidth() * imageLayer->image.getHeight() * 4);
+        }
+
+        return size;
+    }
+
+    void evictUntilWithinBudget()
+    {
+        // Always keep the newest entry, even if it's larger than the whole budget
+        while (totalBytes > byteBudget && lru.size() > 1)
+        {
+            const auto iter = entries.find (lru.front());
+            totalBytes -= iter->second.size;
+            entries.erase (iter);
+            lru.pop_front();
+        }
+    }
+
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::list<Key> lru;
+    size_t totalBytes = 0, byteBudget = 8 * 1024 * 1024;
     CriticalSection lock;
 
     static GlyphCache*& getSingletonPointer() noexcept
@@ -245,6 +335,224 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphCache)
 };
 
+//==============================================================================
+/** Holds the edge tables and stroke outlines of recently-drawn paths that have
+    had Path::setGeometryCachingEnabled() turned on.
+
+    Entries are keyed on the path's contents together with the transform and stroke,
+    so a modified path just misses the cache, and stale entries age out of the LRU.
+
+    @tags{Graphics}
+*/
+class PathGeometryCache  : private DeletedAtShutdown
+{
+public:
+    PathGeometryCache() = default;
+
+    ~PathGeometryCache() override
+    {
+        getSingletonPointer() = nullptr;
+    }
+
+    static PathGeometryCache& getInstance()
+    {
+        auto& c = getSingletonPointer();
+
+        if (c == nullptr)
+            c = new PathGeometryCache();
+
+        return *c;
+    }
+
+    //==============================================================================
+    void reset()
+    {
+        const ScopedLock sl { lock };
+        edgeTables = {};
+        strokes = {};
+    }
+
+    /** Returns an edge table covering the whole of the transformed path, or nullptr if
+        the path is too large to be worth caching.
+    */
+    std::shared_ptr<const EdgeTable> getEdgeTable (const Path& path, const AffineTransform& transform)
+    {
+        const auto area = path.getBoundsTransformed (transform).getSmallestIntegerContainer().expanded (1);
+
+        if (area.getWidth() > maxCachedSize || area.getHeight() > maxCachedSize)
+            return {};
+
+        const ScopedLock sl { lock };
+        return edgeTables.get (Key { path, transform, PathStrokeType (0.0f), 0.0f }, [area] (const auto& key)
+        {
+            return std::make_shared<const EdgeTable> (area, key.path, key.transform);
+        });
+    }
+
+    /** Returns the outline that PathStrokeType::createStrokedPath() would produce. */
+    std::shared_ptr<const Path> getStroke (const Path& path, const PathStrokeType& strokeType,
+                                           const AffineTransform& transform, float extraAccuracy)
+    {
+        const ScopedLock sl { lock };
+        return strokes.get (Key { path, transform, strokeType, extraAccuracy }, [] (const auto& key)
+        {
+            auto stroke = std::make_shared<Path>();
+            key.stroke.createStrokedPath (*stroke, key.path, key.transform, key.extraAccuracy);
+            stroke->setGeometryCachingEnabled (true);
+            return std::shared_ptr<const Path> (std::move (stroke));
+        });
+    }
+
+    /** Returns a hash of the path's elements and winding rule, suitable for use as a cache key. */
+    static uint64 getContentHash (const Path& p)
+    {
+        uint64 h = p.isUsingNonZeroWinding() ? 14695981039346656037ull : 1099511628211ull;
+
+        const auto addToHash = [&h] (float f)
+        {
+            h = (h ^ readUnaligned<uint32> (&f)) * 1099511628211ull;
+        };
+
+        for (Path::Iterator i (p); i.next();)
+        {
+            addToHash ((float) i.elementType);
+
+            for (auto f : { i.x1, i.y1, i.x2, i.y2, i.x3, i.y3 })
+                addToHash (f);
+        }
+
+        return h;
+    }
+
+private:
+    static constexpr int maxCachedSize = 4096;
+
+    struct Key
+    {
+        Key (const Path& p, const AffineTransform& t, const PathStrokeType& s, float accuracy)
+            : path (p), transform (t), stroke (s), extraAccuracy (accuracy), hash (getContentHash (p))
+        {
+        }
+
+        Path path;
+        AffineTransform transform;
+        PathStrokeType stroke;
+        float extraAccuracy;
+        uint64 hash;
+
+        auto tie() const
+        {
+            return std::tuple (hash,
+                               transform.mat00, transform.mat01, transform.mat02,
+                               transform.mat10, transform.mat11, transform.mat12,
+                               stroke.getStrokeThickness(), stroke.getJointStyle(), stroke.getEndStyle(),
+                               extraAccuracy);
+        }
+
+        bool operator< (const Key& other) const
+        {
+            const auto a = tie(), b = other.tie();
+
+            if (a != b)
+                return a < b;
+
+            // Only reached when the hashes collide, so the slow comparison is fine here
+            return path != other.path && path.toString() < other.path.toString();
+        }
+    };
+
+    LruCache<Key, std::shared_ptr<const EdgeTable>> edgeTables;
+    LruCache<Key, std::shared_ptr<const Path>> strokes;
+    CriticalSection lock;
+
+    static PathGeometryCache*& getSingletonPointer() noexcept
+    {
+        static PathGeometryCache* c = nullptr;
+        return c;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PathGeometryCache)
+};
+
+//==============================================================================
+/** Holds recently used gradient lookup tables.
+
+    A table only depends on the gradient's colour stops and on the number of entries,
+    which follows the length of the gradient on screen. Gradients that get redrawn
+    with the same colours and size, e.g. in animated meters, can share one table
+    rather than rebuilding it on every fill.
+
+    @tags{Graphics}
+*/
+class GradientLookupTableCache  : private DeletedAtShutdown
+{
+public:
+    GradientLookupTableCache() = default;
+
+    ~GradientLookupTableCache() override
+    {
+        getSingletonPointer() = nullptr;
+    }
+
+    static GradientLookupTableCache& getInstance()
+    {
+        auto& c = getSingletonPointer();
+
+        if (c == nullptr)
+            c = new GradientLookupTableCache();
+
+        return *c;
+    }
+
+    using Table = std::shared_ptr<const std::vector<PixelARGB>>;
+
+    /** Returns the table that ColourGradient::createLookupTable (transform, table) would create. */
+    Table get (const ColourGradient& gradient, const AffineTransform& transform)
+    {
+        Key key;
+        key.stops.reserve ((size_t) gradient.getNumColours());
+
+        for (int i = 0; i < gradient.getNumColours(); ++i)
+            key.stops.emplace_back (gradient.getColourPosition (i), gradient.getColour (i).getARGB());
+
+        // This must match the size chosen by ColourGradient::createLookupTable()
+        key.numEntries = jlimit (1, jmax (1, (gradient.getNumColours() - 1) << 8),
+                                 3 * (int) gradient.point1.transformedBy (transform)
+                                                          .getDistanceFrom (gradient.point2.transformedBy (transform)));
+
+        const ScopedLock sl (lock);
+        return tables.get (std::move (key), [&gradient] (const Key& k)
+        {
+            auto table = std::make_shared<std::vector<PixelARGB>> ((size_t) k.numEntries);
+            gradient.createLookupTable (table->data(), k.numEntries);
+            return Table (std::move (table));
+        });
+    }
+
+private:
+    struct Key
+    {
+        std::vector<std::pair<double, uint32>> stops;
+        int numEntries = 0;
+
+        bool operator< (const Key& other) const
+        {
+            return std::tie (numEntries, stops) < std::tie (other.numEntries, other.stops);
+        }
+    };
+
+    LruCache<Key, Table> tables;
+    CriticalSection lock;
+
+    static GradientLookupTableCache*& getSingletonPointer() noexcept
+    {
+        static GradientLookupTableCache* c = nullptr;
+        return c;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GradientLookupTableCache)
+};
+
 //==============================================================================
 /** Calculates the alpha values and positions for rendering the edges of a
     non-pixel-aligned rectangle.
@@ -407,6 +715,19 @@ namespace GradientPixelIterators
                             : lookupTable[jlimit (0, numEntries, (x * scale - start) >> (int) numScaleBits)];
         }
 
+        /** Fills in the colours of a run of pixels, stepping through the table incrementally. */
+        void getPixels (int x, PixelARGB* dest, int num) const noexcept
+        {
+            if (vertical)
+            {
+                std::fill (dest, dest + num, linePix);
+                return;
+            }
+
+            for (auto position = x * scale - start; --num >= 0; position += scale)
+                *dest++ = lookupTable[jlimit (0, numEntries, position >> (int) numScaleBits)];
+        }
+
         const PixelARGB* const lookupTable;
         const int numEntries;
         PixelARGB linePix;
@@ -611,11 +932,28 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
-        inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
+        template <class DestPixelType>
+        inline void blendLine (DestPixelType* dest, PixelARGB colour, int width) const noexcept
         {
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
+        inline void blendLine (PixelARGB* dest, PixelARGB colour, int width) const noexcept
+        {
+            if ((size_t) destData.pixelStride == sizeof (*dest))
+                SpanBlending::blendSolid (dest, colour, width);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+        }
+
+        inline void blendLine (PixelRGB* dest, PixelARGB colour, int width) const noexcept
+        {
+            if ((size_t) destData.pixelStride == sizeof (*dest))
+                SpanBlending::blendSolid (dest, colour, width);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+        }
+
         forcedinline void replaceLine (PixelRGB* dest, PixelARGB colour, int width) const noexcept
         {
             if ((size_t) destData.pixelStride == sizeof (*dest) && areRGBComponentsEqual)
@@ -634,7 +972,10 @@ namespace EdgeTableFillers
 
         forcedinline void replaceLine (PixelARGB* dest, const PixelARGB colour, int width) const noexcept
         {
-            JUCE_PERFORM_PIXEL_OP_LOOP (set (colour))
+            if ((size_t) destData.pixelStride == sizeof (*dest))
+                std::fill (dest, dest + width, colour);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (set (colour))
         }
 
         JUCE_DECLARE_NON_COPYABLE (SolidColour)
@@ -672,6 +1013,12 @@ namespace EdgeTableFillers
         {
             auto* dest = getPixel (x);
 
+            if constexpr (std::is_same_v<PixelType, PixelARGB>)
+            {
+                if ((size_t) destData.pixelStride == sizeof (PixelARGB))
+                    return blendSpans (dest, x, width, alphaLevel < 0xff ? (uint32) alphaLevel : 0x100u);
+            }
+
             if (alphaLevel < 0xff)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
             else
@@ -680,8 +1027,7 @@ namespace EdgeTableFillers
 
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
-            auto* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+            handleEdgeTableLine (x, width, 0xff);
         }
 
         void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
@@ -711,6 +1057,33 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        // Generates the gradient in short runs so that each run can be blended as a block.
+        void blendSpans (PixelARGB* dest, int x, int width, uint32 extraAlpha) const noexcept
+        {
+            constexpr int spanSize = 64;
+            PixelARGB span[spanSize];
+
+            while (width > 0)
+            {
+                const auto num = jmin (width, spanSize);
+
+                if constexpr (std::is_same_v<GradientType, GradientPixelIterators::Linear>)
+                {
+                    GradientType::getPixels (x, span, num);
+                }
+                else
+                {
+                    for (int i = 0; i < num; ++i)
+                        span[i] = GradientType::getPixel (x + i);
+                }
+
+                SpanBlending::blendSpan (dest, span, num, extraAlpha);
+                dest += num;
+                x += num;
+                width -= num;
+            }
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -772,7 +1145,7 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                    blendRow (dest, getSrcPixel (x), width, (uint32) alphaLevel);
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -795,7 +1168,7 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                    blendRow (dest, getSrcPixel (x), width, (uint32) extraAlpha);
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -859,6 +1232,10 @@ namespace EdgeTableFillers
             {
                 memcpy ((void*) dest, src, (size_t) (width * srcStride));
             }
+            else if (canBlendSpans())
+            {
+                SpanBlending::blendSpan ((PixelARGB*) dest, (const PixelARGB*) src, width);
+            }
             else
             {
                 do
@@ -870,6 +1247,33 @@ namespace EdgeTableFillers
             }
         }
 
+        forcedinline void blendRow (DestPixelType* dest, SrcPixelType const* src, int width, uint32 alpha) const noexcept
+        {
+            if (canBlendSpans())
+            {
+                SpanBlending::blendSpan ((PixelARGB*) dest, (const PixelARGB*) src, width, alpha);
+            }
+            else
+            {
+                auto destStride = destData.pixelStride;
+                auto srcStride  = srcData.pixelStride;
+
+                do
+                {
+                    dest->blend (*src, alpha);
+                    dest = addBytesToPointer (dest, destStride);
+                    src  = addBytesToPointer (src, srcStride);
+                } while (--width > 0);
+            }
+        }
+
+        forcedinline bool canBlendSpans() const noexcept
+        {
+            return std::is_same_v<DestPixelType, PixelARGB> && std::is_same_v<SrcPixelType, PixelARGB>
+                    && (size_t) destData.pixelStride == sizeof (PixelARGB)
+                    && (size_t) srcData.pixelStride  == sizeof (PixelARGB);
+        }
+
         JUCE_DECLARE_NON_COPYABLE (ImageFill)
     };
 
@@ -930,6 +1334,12 @@ namespace EdgeTableFillers
             alphaLevel *= extraAlpha;
             alphaLevel >>= 8;
 
+            if constexpr (std::is_same_v<DestPixelType, PixelARGB> && std::is_same_v<SrcPixelType, PixelARGB>)
+            {
+                if ((size_t) destData.pixelStride == sizeof (PixelARGB))
+                    return SpanBlending::blendSpan (dest, span, width, alphaLevel < 0xfe ? (uint32) alphaLevel : 0x100u);
+            }
+
             if (alphaLevel < 0xfe)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
             else
@@ -2262,8 +2672,19 @@ public:
             auto trans = transform.getTransformWith (t);
             auto clipRect = clip->getClipBounds();
 
-            if (path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
-                fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
+            if (! path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
+                return;
+
+            if (path.isGeometryCachingEnabled())
+            {
+                if (auto edgeTable = PathGeometryCache::getInstance().getEdgeTable (path, trans))
+                {
+                    fillShape (*new EdgeTableRegionType (*edgeTable), false);
+                    return;
+                }
+            }
+
+            fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
         }
     }
 
@@ -2494,8 +2915,9 @@ public:
     template <typename IteratorType>
     void fillWithGradient (IteratorType& iter, ColourGradient& gradient, const AffineTransform& trans, bool isIdentity) const
     {
-        HeapBlock<PixelARGB> lookupTable;
-        auto numLookupEntries = gradient.createLookupTable (trans, lookupTable);
+        const auto table = GradientLookupTableCache::getInstance().get (gradient, trans);
+        const auto* lookupTable = table->data();
+        const auto numLookupEntries = (int) table->size();
         jassert (numLookupEntries > 0);
 
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
@@ -2609,6 +3031,15 @@ public:
     void fillRect (const Rectangle<float>& r)                                override { stack->fillRect (r); }
     void fillRectList (const RectangleList<float>& list)                     override { stack->fillRectList (list); }
     void fillPath (const Path& path, const AffineTransform& t)               override { stack->fillPath (path, t); }
+
+    void strokePath (const Path& path, const PathStrokeType& strokeType, const AffineTransform& t) override
+    {
+        if (path.isGeometryCachingEnabled())
+            stack->fillPath (*PathGeometryCache::getInstance().getStroke (path, strokeType, t, getPhysicalPixelScaleFactor()), {});
+        else
+            LowLevelGraphicsContext::strokePath (path, strokeType, t);
+    }
+
     void drawImage (const Image& im, const AffineTransform& t)               override { stack->drawImage (im, t); }
     void drawLine (const Line<float>& line)                                  override { stack->drawLine (line); }
     void setFont (const Font& newFont)                                       override { stack->font = newFont; }
@@ -2660,13 +3091,14 @@ protected:
             const auto fontTransform = AffineTransform::scale (fontHeight * stack->font.getHorizontalScale(),
                                                                fontHeight).followedBy (t);
             const auto fullTransform = stack->transform.getTransformWith (fontTransform);
-            return std::tuple (stack->font.getTypefacePtr()->getLayersForGlyph (stack->font.getMetricsKind(), i, fullTransform, fontHeight), Point<float>{});
+            auto uncachedLayers = stack->font.getTypefacePtr()->getLayersForGlyph (stack->font.getMetricsKind(), i, fullTransform, fontHeight);
+            return std::tuple (std::make_shared<const std::vector<GlyphLayer>> (std::move (uncachedLayers)), Point<float>{});
         }();
 
         const auto initialFill = stack->fillType;
         const ScopeGuard scope { [&] { this->stack->setFillType (initialFill); } };
 
-        for (const auto& layer : layers)
+        for (const auto& layer : *layers)
         {
             if (auto* colourLayer = std::get_if<ColourLayer> (&layer.layer))
             {
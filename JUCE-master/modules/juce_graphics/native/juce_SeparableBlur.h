@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+/*  Approximates a gaussian blur with three box filters in each direction. Every box
+    pass keeps a running sum per column, so its cost doesn't depend on the radius.
+
+    Columns are filtered a whole row at a time, which keeps the inner loop running over
+    contiguous bytes (sixteen at a time where SSE2 or NEON is available). Rows are
+    filtered by transposing the image, filtering the columns of the transposed copy,
+    and transposing back again. Pixels outside the area are treated as zero, and every
+    channel is filtered independently, so premultiplied images stay premultiplied.
+*/
+class SeparableBlur
+{
+public:
+    using BoxRadii = std::array<int, 3>;
+
+    /** Returns three box radii whose combined variance is as close as possible to the given one. */
+    static BoxRadii getBoxRadiiForVariance (double variance)
+    {
+        constexpr int numPasses = 3;
+
+        if (variance <= 0.0)
+            return {};
+
+        auto lowerWidth = (int) std::floor (std::sqrt (12.0 * variance / numPasses + 1.0));
+
+        if ((lowerWidth & 1) == 0)
+            --lowerWidth;
+
+        const auto numLower = jlimit (0, numPasses, roundToInt ((12.0 * variance
+                                                                   - numPasses * lowerWidth * lowerWidth
+                                                                   - 4 * numPasses * lowerWidth
+                                                                   - 3 * numPasses)
+                                                                  / (-4.0 * lowerWidth - 4.0)));
+        BoxRadii result;
+
+        for (int i = 0; i < numPasses; ++i)
+            result[(size_t) i] = (i < numLower ? lowerWidth - 1 : lowerWidth + 1) / 2;
+
+        return result;
+    }
+
+    /** Blurs an image in place. The pixelStride may be 1, 3 or 4 bytes. */
+    static void apply (uint8* data, int width, int height, int lineStride, int pixelStride, const BoxRadii& radii)
+    {
+        if (width <= 0 || height <= 0 || std::all_of (radii.begin(), radii.end(), [] (int r) { return r <= 0; }))
+            return;
+
+        const auto rowBytes = width * pixelStride;
+        const auto transposedRowBytes = height * pixelStride;
+        HeapBlock<uint8> bufferA ((size_t) rowBytes * (size_t) height),
+                         bufferB ((size_t) rowBytes * (size_t) height);
+
+        auto* columns = blurColumns (data, lineStride, bufferA, bufferB, rowBytes, height, radii);
+        const auto columnsStride = columns == data ? lineStride : rowBytes;
+
+        auto* transposed = columns == bufferA.get() ? bufferB.get() : bufferA.get();
+        transpose (columns, columnsStride, transposed, transposedRowBytes, width, height, pixelStride);
+
+        auto* rows = blurColumns (transposed, transposedRowBytes,
+                                  transposed == bufferA.get() ? bufferB.get() : bufferA.get(), transposed,
+                                  transposedRowBytes, width, radii);
+
+        transpose (rows, transposedRowBytes, data, lineStride, height, width, pixelStride);
+    }
+
+private:
+    // Runs each box pass over the columns, alternating between the two scratch buffers.
+    static uint8* blurColumns (uint8* src, int srcStride, uint8* scratch1, uint8* scratch2,
+                               int rowBytes, int numRows, const BoxRadii& radii)
+    {
+        HeapBlock<uint8> zeros ((size_t) rowBytes, true);
+
+        for (auto radius : radii)
+        {
+            if (radius <= 0)
+                continue;
+
+            auto* dst = src == scratch1 ? scratch2 : scratch1;
+
+            if (radius < maxRadiusFor16BitSums)
+                boxColumns<uint16> (src, srcStride, dst, rowBytes, numRows, radius, zeros);
+            else
+                boxColumns<uint32> (src, srcStride, dst, rowBytes, numRows, radius, zeros);
+
+            src = dst;
+            srcStride = rowBytes;
+        }
+
+        return src;
+    }
+
+    template <typename SumType>
+    static void boxColumns (const uint8* src, int srcStride, uint8* dst, int rowBytes,
+                            int numRows, int radius, const uint8* zeros)
+    {
+        HeapBlock<SumType> sums ((size_t) rowBytes, true);
+        const auto getRow = [&] (int y) { return isPositiveAndBelow (y, numRows) ? src + y * srcStride : zeros; };
+
+        for (int y = 0; y < radius; ++y)
+            addRow (sums.get(), getRow (y), rowBytes);
+
+        for (int y = 0; y < numRows; ++y)
+        {
+            advanceRow (sums.get(), getRow (y + radius), getRow (y - radius - 1), rowBytes, 2 * radius + 1);
+            writeRow (sums.get(), dst + y * rowBytes, rowBytes, 2 * radius + 1);
+        }
+    }
+
+    template <typename SumType>
+    static void addRow (SumType* sums, const uint8* row, int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+            sums[i] = (SumType) (sums[i] + row[i]);
+    }
+
+    // With 16-bit sums the division is done as a fixed-point multiply, which is exact
+    // enough to keep a solid area solid as long as the box is no wider than 127 pixels.
+    static constexpr int maxRadiusFor16BitSums = 64;
+
+    static void writeRow (const uint32* sums, uint8* dst, int num, int boxSize) noexcept
+    {
+        const auto half = (uint32) boxSize / 2;
+
+        for (int i = 0; i < num; ++i)
+            dst[i] = (uint8) ((sums[i] + half) / (uint32) boxSize);
+    }
+
+    static void advanceRow (uint32* sums, const uint8* added, const uint8* removed, int num, int) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+            sums[i] += (uint32) added[i] - (uint32) removed[i];
+    }
+
+    static void advanceRow (uint16* sums, const uint8* added, const uint8* removed, int num, int) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_GRAPHICS_USE_SSE2
+        const auto zero = _mm_setzero_si128();
+
+        for (; i + 16 <= num; i += 16)
+        {
+            const auto a = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (added + i));
+            const auto r = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (removed + i));
+            auto* s = reinterpret_cast<__m128i*> (sums + i);
+
+            _mm_storeu_si128 (s,     _mm_sub_epi16 (_mm_add_epi16 (_mm_loadu_si128 (s),     _mm_unpacklo_epi8 (a, zero)), _mm_unpacklo_epi8 (r, zero)));
+            _mm_storeu_si128 (s + 1, _mm_sub_epi16 (_mm_add_epi16 (_mm_loadu_si128 (s + 1), _mm_unpackhi_epi8 (a, zero)), _mm_unpackhi_epi8 (r, zero)));
+        }
+       #elif JUCE_GRAPHICS_USE_NEON
+        for (; i + 16 <= num; i += 16)
+        {
+            const auto a = vld1q_u8 (added + i);
+            const auto r = vld1q_u8 (removed + i);
+
+            vst1q_u16 (sums + i,     vsubq_u16 (vaddq_u16 (vld1q_u16 (sums + i),     vmovl_u8 (vget_low_u8  (a))), vmovl_u8 (vget_low_u8  (r))));
+            vst1q_u16 (sums + i + 8, vsubq_u16 (vaddq_u16 (vld1q_u16 (sums + i + 8), vmovl_u8 (vget_high_u8 (a))), vmovl_u8 (vget_high_u8 (r))));
+        }
+       #endif
+
+        for (; i < num; ++i)
+            sums[i] = (uint16) (sums[i] + added[i] - removed[i]);
+    }
+
+    static void writeRow (const uint16* sums, uint8* dst, int num, int boxSize) noexcept
+    {
+        const auto half = (uint16) (boxSize / 2);
+        const auto multiplier = (uint16) (65536 / boxSize);
+        int i = 0;
+
+       #if JUCE_GRAPHICS_USE_SSE2
+        const auto halves = _mm_set1_epi16 ((short) half);
+        const auto multipliers = _mm_set1_epi16 ((short) multiplier);
+
+        for (; i + 16 <= num; i += 16)
+        {
+            const auto* s = reinterpret_cast<const __m128i*> (sums + i);
+            const auto lo = _mm_mulhi_epu16 (_mm_add_epi16 (_mm_loadu_si128 (s),     halves), multipliers);
+            const auto hi = _mm_mulhi_epu16 (_mm_add_epi16 (_mm_loadu_si128 (s + 1), halves), multipliers);
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + i), _mm_packus_epi16 (lo, hi));
+        }
+       #elif JUCE_GRAPHICS_USE_NEON
+        const auto halves = vdupq_n_u16 (half);
+        const auto multipliers = vdup_n_u16 (multiplier);
+
+        const auto divide = [&] (uint16x8_t s)
+        {
+            s = vaddq_u16 (s, halves);
+            return vcombine_u16 (vshrn_n_u32 (vmull_u16 (vget_low_u16  (s), multipliers), 16),
+                                 vshrn_n_u32 (vmull_u16 (vget_high_u16 (s), multipliers), 16));
+        };
+
+        for (; i + 16 <= num; i += 16)
+            vst1q_u8 (dst + i, vcombine_u8 (vqmovn_u16 (divide (vld1q_u16 (sums + i))),
+                                            vqmovn_u16 (divide (vld1q_u16 (sums + i + 8)))));
+       #endif
+
+        for (; i < num; ++i)
+            dst[i] = (uint8) (((uint32) (sums[i] + half) * multiplier) >> 16);
+    }
+
+    //==============================================================================
+    template <int pixelStride>
+    static void transpose (const uint8* src, int srcStride, uint8* dst, int dstStride, int width, int height) noexcept
+    {
+        // Working in small tiles keeps both the rows being read and the rows being written in cache
+        constexpr int tileSize = 16;
+
+        for (int tileY = 0; tileY < height; tileY += tileSize)
+        {
+            for (int tileX = 0; tileX < width; tileX += tileSize)
+            {
+                const auto endY = jmin (height, tileY + tileSize);
+                const auto endX = jmin (width,  tileX + tileSize);
+
+                for (int y = tileY; y < endY; ++y)
+                {
+                    const auto* s = src + y * srcStride + tileX * pixelStride;
+
+                    for (int x = tileX; x < endX; ++x, s += pixelStride)
+                        std::memcpy (dst + x * dstStride + y * pixelStride, s, pixelStride);
+                }
+            }
+        }
+    }
+
+    static void transpose (const uint8* src, int srcStride, uint8* dst, int dstStride,
+                           int width, int height, int pixelStride) noexcept
+    {
+        switch (pixelStride)
+        {
+            case 1:  return transpose<1> (src, srcStride, dst, dstStride, width, height);
+            case 3:  return transpose<3> (src, srcStride, dst, dstStride, width, height);
+            case 4:  return transpose<4> (src, srcStride, dst, dstStride, width, height);
+            default: jassertfalse; return;
+        }
+    }
+};
+
+} // namespace juce::detail
@@ -238,6 +238,237 @@ private:
     ImageEffectFilter* effect;
 };
 
+//==============================================================================
+/*  A uniform grid over a component's area that records which children overlap each cell,
+    so that finding the child under a point only needs to look at a handful of candidates,
+    rather than walking every child.
+
+    Bounds changes of individual children are applied incrementally, whereas anything that
+    changes the z-order or the size of the parent causes a rebuild the next time it's used.
+*/
+class Component::HitTestIndex
+{
+public:
+    static constexpr int minNumChildren = 128;
+
+    explicit HitTestIndex (Component& c) : owner (c) {}
+
+    void invalidate() noexcept      { needsRebuild = true; }
+
+    static void childBoundsChanged (Component& child)
+    {
+        if (child.parentComponent != nullptr)
+            if (auto* index = child.parentComponent->hitTestIndex.get())
+                index->updateChild (child);
+    }
+
+    Component* findChildAt (Point<float> position)
+    {
+        if (needsRebuild)
+            rebuild();
+
+        const auto p = position.roundToInt();
+
+        if (! owner.getLocalBounds().contains (p))
+            return nullptr;
+
+        const auto& candidates = cells[(size_t) getCellIndex (p.x / cellSize.x, p.y / cellSize.y)];
+
+        // The candidates are in z-order, so search from the front-most backwards
+        for (auto i = candidates.size(); i > 0; --i)
+        {
+            auto* child = candidates[i - 1].second;
+
+            if (auto* c = child->getComponentAt (detail::ComponentHelpers::convertFromParentSpace (*child, position)))
+                return c;
+
+            if (needsRebuild || i > candidates.size())
+                return nullptr; // the hierarchy was changed by a hitTest() callback
+        }
+
+        return nullptr;
+    }
+
+private:
+    using Cell = std::vector<std::pair<int, Component*>>;
+
+    struct Entry
+    {
+        int zOrder;
+        Rectangle<int> cellRange;
+    };
+
+    void rebuild()
+    {
+        needsRebuild = false;
+        entries.clear();
+
+        const auto& children = owner.childComponentList;
+        const auto bounds = owner.getLocalBounds();
+
+        // Aim for a few children per cell, on average
+        const auto numCellsPerSide = jlimit (1, 128, roundToInt (std::sqrt ((double) children.size() / 4.0)));
+        numCells = { numCellsPerSide, numCellsPerSide };
+        cellSize = { jmax (1, (bounds.getWidth()  + numCells.x - 1) / numCells.x),
+                     jmax (1, (bounds.getHeight() + numCells.y - 1) / numCells.y) };
+
+        cells.clear();
+        cells.resize ((size_t) (numCells.x * numCells.y));
+
+        for (int i = 0; i < children.size(); ++i)
+        {
+            auto* child = children.getUnchecked (i);
+            const Entry entry { i, getCellRange (*child) };
+            entries[child] = entry;
+            addToCells (*child, entry);
+        }
+    }
+
+    void updateChild (Component& child)
+    {
+        if (needsRebuild)
+            return;
+
+        const auto iter = entries.find (&child);
+
+        if (iter == entries.end())
+        {
+            needsRebuild = true;
+            return;
+        }
+
+        const auto newRange = getCellRange (child);
+
+        if (newRange == iter->second.cellRange)
+            return;
+
+        removeFromCells (child, iter->second);
+        iter->second.cellRange = newRange;
+        addToCells (child, iter->second);
+    }
+
+    Rectangle<int> getCellRange (const Component& child) const
+    {
+        // expanded slightly to allow for rounding of transformed bounds
+        const auto area = child.getBoundsInParent().expanded (1).getIntersection (owner.getLocalBounds());
+
+        if (area.isEmpty())
+            return {};
+
+        const auto x1 = jmin (numCells.x - 1, area.getX() / cellSize.x);
+        const auto y1 = jmin (numCells.y - 1, area.getY() / cellSize.y);
+        const auto x2 = jmin (numCells.x - 1, (area.getRight()  - 1) / cellSize.x);
+        const auto y2 = jmin (numCells.y - 1, (area.getBottom() - 1) / cellSize.y);
+
+        return Rectangle<int>::leftTopRightBottom (x1, y1, x2 + 1, y2 + 1);
+    }
+
+    int getCellIndex (int x, int y) const noexcept
+    {
+        return jmin (y, numCells.y - 1) * numCells.x + jmin (x, numCells.x - 1);
+    }
+
+    template <typename Fn>
+    void forEachCell (const Entry& entry, Fn&& fn)
+    {
+        for (int y = entry.cellRange.getY(); y < entry.cellRange.getBottom(); ++y)
+            for (int x = entry.cellRange.getX(); x < entry.cellRange.getRight(); ++x)
+                fn (cells[(size_t) getCellIndex (x, y)]);
+    }
+
+    void addToCells (Component& child, const Entry& entry)
+    {
+        forEachCell (entry, [&] (Cell& cell)
+        {
+            const std::pair<int, Component*> item { entry.zOrder, &child };
+            cell.insert (std::upper_bound (cell.begin(), cell.end(), item,
+                                           [] (const auto& a, const auto& b) { return a.first < b.first; }),
+                         item);
+        });
+    }
+
+    void removeFromCells (Component& child, const Entry& entry)
+    {
+        forEachCell (entry, [&] (Cell& cell)
+        {
+            cell.erase (std::remove_if (cell.begin(), cell.end(), [&] (const auto& item) { return item.second == &child; }),
+                        cell.end());
+        });
+    }
+
+    Component& owner;
+    std::vector<Cell> cells;
+    std::unordered_map<Component*, Entry> entries;
+    Point<int> numCells, cellSize;
+    bool needsRebuild = true;
+
+    JUCE_DECLARE_NON_COPYABLE (HitTestIndex)
+};
+
+//==============================================================================
+class Component::RepaintRateLimiter final : private Timer
+{
+public:
+    RepaintRateLimiter (Component& c, int maxRepaintsPerSecond)
+        : owner (c), rate (maxRepaintsPerSecond)
+    {
+    }
+
+    int getRate() const noexcept { return rate; }
+
+    /*  Returns true if the repaint has been held back, in which case it'll be delivered
+        later, merged with any other repaints that arrive in the meantime.
+    */
+    bool deferRepaint (Rectangle<int> area, bool isEntireComponent)
+    {
+        if (isFlushing)
+            return false;
+
+        const auto now = Time::getMillisecondCounter();
+        const auto interval = (uint32) (1000 / rate);
+        const auto elapsed = now - lastRepaintTime;
+
+        if (! isTimerRunning() && elapsed >= interval)
+        {
+            lastRepaintTime = now;
+            return false;
+        }
+
+        pendingArea = pendingArea.isEmpty() ? area : pendingArea.getUnion (area);
+        pendingIsEntireComponent |= isEntireComponent;
+
+        if (! isTimerRunning())
+            startTimer (jmax (1, (int) interval - (int) elapsed));
+
+        return true;
+    }
+
+private:
+    void timerCallback() override
+    {
+        stopTimer();
+        lastRepaintTime = Time::getMillisecondCounter();
+
+        const auto isEntireComponent = std::exchange (pendingIsEntireComponent, false);
+        const auto area = std::exchange (pendingArea, {});
+
+        const ScopedValueSetter<bool> svs (isFlushing, true);
+
+        if (isEntireComponent)
+            owner.internalRepaintUnchecked (owner.getLocalBounds(), true);
+        else
+            owner.internalRepaint (area);
+    }
+
+    Component& owner;
+    const int rate;
+    uint32 lastRepaintTime = 0;
+    Rectangle<int> pendingArea;
+    bool pendingIsEntireComponent = false, isFlushing = false;
+
+    JUCE_DECLARE_NON_COPYABLE (RepaintRateLimiter)
+};
+
 //==============================================================================
 Component::Component() noexcept
   : componentFlags (0)
@@ -586,11 +817,13 @@ void Component::setBufferedToImage (bool shouldBeBuffered)
     // so by calling setBufferedToImage, you'll be deleting the custom one - this is almost certainly
     // not what you wanted to happen... If you really do know what you're doing here, and want to
     // avoid this assertion, just call setCachedComponentImage (nullptr) before setBufferedToImage().
-    jassert (cachedImage == nullptr || dynamic_cast<detail::StandardCachedComponentImage*> (cachedImage.get()) != nullptr);
+    jassert (cachedImage == nullptr
+             || dynamic_cast<detail::StandardCachedComponentImage*> (cachedImage.get()) != nullptr
+             || dynamic_cast<detail::AdaptiveCachedComponentImage*> (cachedImage.get()) != nullptr);
 
     if (shouldBeBuffered)
     {
-        if (cachedImage == nullptr)
+        if (cachedImage == nullptr || dynamic_cast<detail::AdaptiveCachedComponentImage*> (cachedImage.get()) != nullptr)
             cachedImage = std::make_unique<detail::StandardCachedComponentImage> (*this);
     }
     else
@@ -599,6 +832,34 @@ void Component::setBufferedToImage (bool shouldBeBuffered)
     }
 }
 
+void Component::setAutomaticImageCaching (bool shouldCacheAutomatically)
+{
+    // This assertion means that this component is already using a custom CachedComponentImage,
+    // which would be deleted by calling this method. If that's really what you want, call
+    // setCachedComponentImage (nullptr) first.
+    jassert (cachedImage == nullptr
+             || dynamic_cast<detail::StandardCachedComponentImage*> (cachedImage.get()) != nullptr
+             || dynamic_cast<detail::AdaptiveCachedComponentImage*> (cachedImage.get()) != nullptr);
+
+    const auto isAdaptive = dynamic_cast<detail::AdaptiveCachedComponentImage*> (cachedImage.get()) != nullptr;
+
+    if (shouldCacheAutomatically == isAdaptive)
+        return;
+
+    if (shouldCacheAutomatically)
+        cachedImage = std::make_unique<detail::AdaptiveCachedComponentImage> (*this);
+    else
+        cachedImage.reset();
+
+    repaint();
+}
+
+void Component::setAutomaticImageCachingMemoryLimit (int64 maxNumBytes)
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+    detail::CachedLayerBudget::getInstance().setLimit (maxNumBytes);
+}
+
 //==============================================================================
 void Component::reorderChildInternal (int sourceIndex, int destIndex)
 {
@@ -610,6 +871,9 @@ void Component::reorderChildInternal (int sourceIndex, int destIndex)
 
         childComponentList.move (sourceIndex, destIndex);
 
+        if (hitTestIndex != nullptr)
+            hitTestIndex->invalidate();
+
         sendFakeMouseMove();
         internalChildrenChanged();
     }
@@ -840,6 +1104,11 @@ void Component::setBounds (int x, int y, int w, int h)
 
         boundsRelativeToParent.setBounds (x, y, w, h);
 
+        HitTestIndex::childBoundsChanged (*this);
+
+        if (wasResized && hitTestIndex != nullptr)
+            hitTestIndex->invalidate();
+
         if (showing)
         {
             if (wasResized)
@@ -1016,6 +1285,7 @@ void Component::setTransform (const AffineTransform& newTransform)
             repaint();
             affineTransform.reset();
             repaint();
+            HitTestIndex::childBoundsChanged (*this);
             sendMovedResizedMessages (false, false);
         }
     }
@@ -1024,6 +1294,7 @@ void Component::setTransform (const AffineTransform& newTransform)
         repaint();
         affineTransform.reset (new AffineTransform (newTransform));
         repaint();
+        HitTestIndex::childBoundsChanged (*this);
         sendMovedResizedMessages (false, false);
     }
     else if (*affineTransform != newTransform)
@@ -1031,6 +1302,7 @@ void Component::setTransform (const AffineTransform& newTransform)
         repaint();
         *affineTransform = newTransform;
         repaint();
+        HitTestIndex::childBoundsChanged (*this);
         sendMovedResizedMessages (false, false);
     }
 }
@@ -1141,6 +1413,17 @@ Component* Component::getComponentAt (Point<float> position)
 {
     if (flags.visibleFlag && detail::ComponentHelpers::hitTest (*this, position))
     {
+        if (childComponentList.size() >= HitTestIndex::minNumChildren)
+        {
+            if (hitTestIndex == nullptr)
+                hitTestIndex = std::make_unique<HitTestIndex> (*this);
+
+            if (auto* child = hitTestIndex->findChildAt (position))
+                return child;
+
+            return this;
+        }
+
         for (int i = childComponentList.size(); --i >= 0;)
         {
             auto* child = childComponentList.getUnchecked (i);
@@ -1199,6 +1482,9 @@ void Component::addChildComponent (Component& child, int zOrder)
 
         childComponentList.insert (zOrder, &child);
 
+        if (hitTestIndex != nullptr)
+            hitTestIndex->invalidate();
+
         child.internalHierarchyChanged();
         internalChildrenChanged();
     }
@@ -1262,6 +1548,9 @@ Component* Component::removeChildComponent (int index, bool sendParentEvents, bo
         childComponentList.remove (index);
         child->parentComponent = nullptr;
 
+        if (hitTestIndex != nullptr)
+            hitTestIndex->invalidate();
+
         detail::ComponentHelpers::releaseAllCachedImageResources (*child);
 
         // (NB: there are obscure situations where child->isShowing() = false, but it still has the focus)
@@ -1631,6 +1920,9 @@ void Component::internalRepaintUnchecked (Rectangle<int> area, bool isEntireComp
 
     if (flags.visibleFlag)
     {
+        if (repaintRateLimiter != nullptr && repaintRateLimiter->deferRepaint (area, isEntireComponent))
+            return;
+
         if (cachedImage != nullptr)
             if (! (isEntireComponent ? cachedImage->invalidateAll()
                                      : cachedImage->invalidate (area)))
@@ -1654,7 +1946,14 @@ void Component::internalRepaintUnchecked (Rectangle<int> area, bool isEntireComp
         else
         {
             if (parentComponent != nullptr)
-                parentComponent->internalRepaint (detail::ComponentHelpers::convertToParentSpace (*this, area));
+            {
+                const auto areaInParent = detail::ComponentHelpers::convertToParentSpace (*this, area);
+
+                // No need to repaint anything that's hidden behind opaque siblings
+                if (affineTransform != nullptr
+                     || ! detail::ComponentHelpers::isObscuredByOpaqueSiblings (*this, areaInParent))
+                    parentComponent->internalRepaint (areaInParent);
+            }
         }
     }
 }
@@ -1683,6 +1982,16 @@ void Component::paintWithinParentContext (Graphics& g)
         paintEntireComponent (g, false);
 }
 
+#if JUCE_RENDERING_METRICS
+static String getNameForRenderingMetrics (const Component& c)
+{
+    if (auto name = c.getName(); name.isNotEmpty())
+        return name;
+
+    return typeid (c).name();
+}
+#endif
+
 void Component::paintComponentAndChildren (Graphics& g)
 {
    #if JUCE_ETW_TRACELOGGING
@@ -1703,6 +2012,7 @@ void Component::paintComponentAndChildren (Graphics& g)
 
     if (flags.dontClipGraphicsFlag && getNumChildComponents() == 0)
     {
+        JUCE_RENDERING_METRICS_SCOPED_COMPONENT_PAINT (getNameForRenderingMetrics (*this))
         paint (g);
     }
     else
@@ -1710,7 +2020,10 @@ void Component::paintComponentAndChildren (Graphics& g)
         Graphics::ScopedSaveState ss (g);
 
         if (! (detail::ComponentHelpers::clipObscuredRegions (*this, g, clipBounds, {}) && g.isClipEmpty()))
+        {
+            JUCE_RENDERING_METRICS_SCOPED_COMPONENT_PAINT (getNameForRenderingMetrics (*this))
             paint (g);
+        }
     }
 
     for (int i = 0; i < childComponentList.size(); ++i)
@@ -1740,11 +2053,14 @@ void Component::paintComponentAndChildren (Graphics& g)
                 {
                     bool nothingClipped = true;
 
+                    const auto childBounds = child.getBounds();
+
                     for (int j = i + 1; j < childComponentList.size(); ++j)
                     {
                         auto& sibling = *childComponentList.getUnchecked (j);
 
-                        if (sibling.flags.opaqueFlag && sibling.isVisible() && sibling.affineTransform == nullptr)
+                        if (sibling.flags.opaqueFlag && sibling.isVisible() && sibling.affineTransform == nullptr
+                             && sibling.getBounds().intersects (childBounds))
                         {
                             nothingClipped = false;
                             g.excludeClipRegion (sibling.getBounds());
@@ -1759,6 +2075,7 @@ void Component::paintComponentAndChildren (Graphics& g)
     }
 
     Graphics::ScopedSaveState ss (g);
+    JUCE_RENDERING_METRICS_SCOPED_COMPONENT_PAINT (getNameForRenderingMetrics (*this))
     paintOverChildren (g);
 }
 
@@ -1809,6 +2126,30 @@ bool Component::isPaintingUnclipped() const noexcept
     return flags.dontClipGraphicsFlag;
 }
 
+void Component::setMaximumRepaintRate (int maxRepaintsPerSecond)
+{
+    // The rate must be a positive number of repaints per second, or 0 to remove the limit
+    jassert (maxRepaintsPerSecond >= 0);
+
+    if (maxRepaintsPerSecond == getMaximumRepaintRate())
+        return;
+
+    const auto hadLimiter = repaintRateLimiter != nullptr;
+    repaintRateLimiter.reset();
+
+    if (maxRepaintsPerSecond > 0)
+        repaintRateLimiter = std::make_unique<RepaintRateLimiter> (*this, jmin (maxRepaintsPerSecond, 1000));
+
+    // makes sure that any repaint that the old limiter was holding back doesn't get lost
+    if (hadLimiter)
+        repaint();
+}
+
+int Component::getMaximumRepaintRate() const noexcept
+{
+    return repaintRateLimiter != nullptr ? repaintRateLimiter->getRate() : 0;
+}
+
 //==============================================================================
 Image Component::createComponentSnapshot (Rectangle<int> areaToGrab,
                                           bool clipImageToComponentBounds, float scaleFactor)
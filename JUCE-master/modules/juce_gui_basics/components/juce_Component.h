@@ -1145,6 +1145,29 @@ public:
     */
     void setBufferedToImage (bool shouldBeBuffered);
 
+    /** Lets the component decide for itself whether to buffer its drawing in an image.
+
+        When enabled, the component measures how long it takes to paint, and how often its
+        content actually changes between paints. If it's expensive to draw but is mostly being
+        redrawn because of changes elsewhere, it'll start using an image buffer in the same way
+        as setBufferedToImage(), re-rendering only the parts that have been invalidated. If its
+        content changes on most paints, or it's cheap to draw, it'll be painted directly.
+
+        All the buffers created this way share a common memory limit, which can be changed
+        with setAutomaticImageCachingMemoryLimit(). When the limit is reached, the buffers of
+        the components that were drawn least recently are released.
+
+        @see setBufferedToImage, setAutomaticImageCachingMemoryLimit
+    */
+    void setAutomaticImageCaching (bool shouldCacheAutomatically);
+
+    /** Sets the total number of bytes that the buffers of all the components using
+        setAutomaticImageCaching() may use. The default is 64MB.
+
+        @see setAutomaticImageCaching
+    */
+    static void setAutomaticImageCachingMemoryLimit (int64 maxNumBytes);
+
     /** Generates a snapshot of part of this component.
 
         This will return a new Image, the size of the rectangle specified,
@@ -1202,6 +1225,23 @@ public:
     */
     bool isPaintingUnclipped() const noexcept;
 
+    /** Limits how often this component's repaint requests are passed on to be drawn.
+
+        This is useful for components such as meters or visualisers that call repaint() from
+        a fast timer or in response to a stream of incoming data, where painting every request
+        would be wasted effort. Any repaints requested within the minimum interval are merged
+        together and delivered as a single repaint when the interval has elapsed, so no update
+        is ever lost, it just arrives a little later.
+
+        Pass 0 to remove the limit, which is the default.
+
+        @see getMaximumRepaintRate
+    */
+    void setMaximumRepaintRate (int maxRepaintsPerSecond);
+
+    /** Returns the limit set by setMaximumRepaintRate(), or 0 if there isn't one. */
+    int getMaximumRepaintRate() const noexcept;
+
     //==============================================================================
     /** Adds an effect filter to alter the component's appearance.
 
@@ -2655,10 +2695,16 @@ private:
     std::unique_ptr<EffectState> effectState;
     std::unique_ptr<CachedComponentImage> cachedImage;
 
+    class RepaintRateLimiter;
+    std::unique_ptr<RepaintRateLimiter> repaintRateLimiter;
+
+    class HitTestIndex;
+    std::unique_ptr<HitTestIndex> hitTestIndex;
+
     class MouseListenerList;
     std::unique_ptr<MouseListenerList> mouseListeners;
     std::unique_ptr<Array<KeyListener*>> keyListeners;
-    ListenerList<ComponentListener> componentListeners;
+    InlineListenerList<ComponentListener> componentListeners;
     NamedValueSet properties;
 
     friend class WeakReference<Component>;
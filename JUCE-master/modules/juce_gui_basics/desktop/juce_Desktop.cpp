@@ -37,10 +37,8 @@ namespace juce
 
 Desktop::Desktop()
     : mouseSources (new detail::MouseInputSourceList()),
-      masterScaleFactor ((float) getDefaultMasterScale()),
-      nativeDarkModeChangeDetectorImpl (createNativeDarkModeChangeDetectorImpl())
+      masterScaleFactor ((float) getDefaultMasterScale())
 {
-    displays.reset (new Displays (*this));
 }
 
 Desktop::~Desktop()
@@ -59,7 +57,10 @@ Desktop::~Desktop()
 Desktop& JUCE_CALLTYPE Desktop::getInstance()
 {
     if (instance == nullptr)
+    {
+        JUCE_SCOPED_INITIALISER_TRACE ("Desktop")
         instance = new Desktop();
+    }
 
     return *instance;
 }
@@ -104,7 +105,10 @@ LookAndFeel& Desktop::getDefaultLookAndFeel() noexcept
         return *lf;
 
     if (defaultLookAndFeel == nullptr)
+    {
+        JUCE_SCOPED_INITIALISER_TRACE ("default LookAndFeel")
         defaultLookAndFeel.reset (new LookAndFeel_V4());
+    }
 
     auto lf = defaultLookAndFeel.get();
     jassert (lf != nullptr);
@@ -229,11 +233,28 @@ void Desktop::handleAsyncUpdate()
 }
 
 //==============================================================================
-void Desktop::addDarkModeSettingListener    (DarkModeSettingListener* l)  { darkModeSettingListeners.add (l); }
+void Desktop::addDarkModeSettingListener (DarkModeSettingListener* l)
+{
+    // Changes to the setting are only detected once something is interested in them
+    getNativeDarkModeChangeDetector();
+    darkModeSettingListeners.add (l);
+}
+
 void Desktop::removeDarkModeSettingListener (DarkModeSettingListener* l)  { darkModeSettingListeners.remove (l); }
 
 void Desktop::darkModeChanged()  { darkModeSettingListeners.call ([] (auto& l) { l.darkModeSettingChanged(); }); }
 
+Desktop::NativeDarkModeChangeDetectorImpl& Desktop::getNativeDarkModeChangeDetector() const
+{
+    if (nativeDarkModeChangeDetectorImpl == nullptr)
+    {
+        JUCE_SCOPED_INITIALISER_TRACE ("dark mode detector")
+        nativeDarkModeChangeDetectorImpl = createNativeDarkModeChangeDetectorImpl();
+    }
+
+    return *nativeDarkModeChangeDetectorImpl;
+}
+
 //==============================================================================
 void Desktop::resetTimer()
 {
@@ -365,13 +386,31 @@ void Desktop::setGlobalScaleFactor (float newScaleFactor) noexcept
     if (! approximatelyEqual (masterScaleFactor, newScaleFactor))
     {
         masterScaleFactor = newScaleFactor;
-        displays->refresh();
+        refreshDisplays();
+    }
+}
+
+const Displays& Desktop::getDisplays() const noexcept
+{
+    if (displays == nullptr)
+    {
+        JUCE_SCOPED_INITIALISER_TRACE ("Displays")
+        displays.reset (new Displays (const_cast<Desktop&> (*this)));
     }
+
+    return *displays;
+}
+
+void Desktop::refreshDisplays()
+{
+    // If the displays haven't been needed yet, they'll be up to date when they're created
+    if (displays != nullptr)
+        displays->refresh();
 }
 
 bool Desktop::isHeadless() const noexcept
 {
-    return displays->displays.isEmpty();
+    return getDisplays().displays.isEmpty();
 }
 
 bool Desktop::supportsBorderlessNonClientResize() const
@@ -389,7 +389,7 @@ public:
 
         @see Displays
     */
-    const Displays& getDisplays() const noexcept        { return *displays; }
+    const Displays& getDisplays() const noexcept;
 
     //==============================================================================
     /** Sets a global scale factor to be used for all desktop windows.
@@ -442,7 +442,10 @@ private:
     Array<Component*> desktopComponents;
     Array<ComponentPeer*> peers;
 
-    std::unique_ptr<Displays> displays;
+    // These are created the first time they're needed, as finding the displays and
+    // watching the dark mode setting can be slow, and plugin instances often don't need them
+    mutable std::unique_ptr<Displays> displays;
+    void refreshDisplays();
 
     Point<float> lastFakeMouseMove;
     void sendMouseMove();
@@ -490,9 +493,10 @@ private:
 
     //==============================================================================
     class NativeDarkModeChangeDetectorImpl;
-    std::unique_ptr<NativeDarkModeChangeDetectorImpl> nativeDarkModeChangeDetectorImpl;
+    mutable std::unique_ptr<NativeDarkModeChangeDetectorImpl> nativeDarkModeChangeDetectorImpl;
 
     static std::unique_ptr<NativeDarkModeChangeDetectorImpl> createNativeDarkModeChangeDetectorImpl();
+    NativeDarkModeChangeDetectorImpl& getNativeDarkModeChangeDetector() const;
     void darkModeChanged();
 
     //==============================================================================
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+struct AdaptiveCachedComponentImage;
+
+//==============================================================================
+/*  Keeps the total memory used by all the adaptively cached component images within a
+    limit, by throwing away the least recently drawn ones when space is needed.
+
+    This is only ever used from the message thread.
+*/
+class CachedLayerBudget
+{
+public:
+    static CachedLayerBudget& getInstance()
+    {
+        static CachedLayerBudget instance;
+        return instance;
+    }
+
+    void setLimit (int64 newLimit)
+    {
+        limit = jmax ((int64) 0, newLimit);
+        evictUntilWithinLimit (0);
+    }
+
+    int64 getLimit() const noexcept          { return limit; }
+    int64 getTotalSize() const noexcept      { return totalSize; }
+
+    /*  Updates the size of a layer and marks it as the most recently used, evicting others if
+        necessary. Returns false if the layer can't fit at all, in which case it isn't tracked.
+    */
+    bool update (AdaptiveCachedComponentImage& layer, int64 numBytes)
+    {
+        remove (layer);
+
+        if (numBytes > limit)
+            return false;
+
+        evictUntilWithinLimit (numBytes);
+        entries.push_back ({ &layer, numBytes });
+        totalSize += numBytes;
+        return true;
+    }
+
+    void remove (AdaptiveCachedComponentImage& layer)
+    {
+        const auto iter = std::find_if (entries.begin(), entries.end(), [&] (const Entry& e) { return e.layer == &layer; });
+
+        if (iter != entries.end())
+        {
+            totalSize -= iter->numBytes;
+            entries.erase (iter);
+        }
+    }
+
+private:
+    CachedLayerBudget() = default;
+
+    inline void evictUntilWithinLimit (int64 bytesNeeded);
+
+    struct Entry
+    {
+        AdaptiveCachedComponentImage* layer;
+        int64 numBytes;
+    };
+
+    std::vector<Entry> entries; // ordered from least to most recently used
+    int64 totalSize = 0, limit = (int64) 64 * 1024 * 1024;
+
+    JUCE_DECLARE_NON_COPYABLE (CachedLayerBudget)
+};
+
+//==============================================================================
+/*  A CachedComponentImage that decides for itself whether caching is worthwhile.
+
+    It measures how long the component takes to paint and how often its content actually
+    changes between paints. Components that are expensive to draw but are mostly repainted
+    because of things happening around them are drawn into a StandardCachedComponentImage,
+    which only re-renders the invalidated parts. Components whose content changes on most
+    paints, or that are cheap to draw, are painted directly. All the cached images share the
+    memory limit held by CachedLayerBudget.
+*/
+struct AdaptiveCachedComponentImage : public CachedComponentImage
+{
+    explicit AdaptiveCachedComponentImage (Component& c) noexcept
+        : owner (c)
+    {
+    }
+
+    ~AdaptiveCachedComponentImage() override
+    {
+        CachedLayerBudget::getInstance().remove (*this);
+    }
+
+    void paint (Graphics& g) override
+    {
+        ++numPaints;
+
+        if (std::exchange (contentChanged, false))
+            ++numPaintsWithChanges;
+
+        if (cache != nullptr)
+        {
+            cache->paint (g);
+
+            if (! CachedLayerBudget::getInstance().update (*this, cache->getImageSizeInBytes()))
+                evict();
+        }
+        else
+        {
+            const auto start = Time::getHighResolutionTicks();
+            owner.paintEntireComponent (g, false);
+            const auto cost = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+            averagePaintCost = averagePaintCost < 0.0 ? cost : averagePaintCost + (cost - averagePaintCost) * 0.25;
+        }
+
+        if (numPaints >= numPaintsBeforeDecision)
+            updatePolicy();
+    }
+
+    bool invalidateAll() override
+    {
+        contentChanged = true;
+        return cache == nullptr || cache->invalidateAll();
+    }
+
+    bool invalidate (const Rectangle<int>& area) override
+    {
+        contentChanged = true;
+        return cache == nullptr || cache->invalidate (area);
+    }
+
+    void releaseResources() override
+    {
+        evict();
+    }
+
+    bool isCaching() const noexcept     { return cache != nullptr; }
+
+    void evict()
+    {
+        if (cache == nullptr)
+            return;
+
+        CachedLayerBudget::getInstance().remove (*this);
+        cache.reset();
+
+        // Give the cache a rest before trying again, to avoid thrashing when memory is tight
+        numPaints = numPaintsWithChanges = 0;
+        numPaintsBeforeDecision = evaluationPeriod * 4;
+    }
+
+private:
+    static constexpr int evaluationPeriod = 8;
+    static constexpr double minPaintCostToCache = 0.0005;
+
+    void updatePolicy()
+    {
+        const auto changeRate = (double) numPaintsWithChanges / (double) numPaints;
+        numPaints = numPaintsWithChanges = 0;
+        numPaintsBeforeDecision = evaluationPeriod;
+
+        if (cache == nullptr)
+        {
+            if (averagePaintCost >= minPaintCostToCache && changeRate <= 0.25)
+                cache = std::make_unique<StandardCachedComponentImage> (owner);
+        }
+        else if (changeRate > 0.5)
+        {
+            CachedLayerBudget::getInstance().remove (*this);
+            cache.reset();
+        }
+    }
+
+    Component& owner;
+    std::unique_ptr<StandardCachedComponentImage> cache;
+    double averagePaintCost = -1.0;
+    int numPaints = 0, numPaintsWithChanges = 0, numPaintsBeforeDecision = evaluationPeriod;
+    bool contentChanged = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AdaptiveCachedComponentImage)
+};
+
+void CachedLayerBudget::evictUntilWithinLimit (int64 bytesNeeded)
+{
+    while (! entries.empty() && totalSize + bytesNeeded > limit)
+        entries.front().layer->evict();
+}
+
+} // namespace juce::detail
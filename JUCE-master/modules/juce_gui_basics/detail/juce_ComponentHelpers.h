@@ -214,6 +214,51 @@ struct ComponentHelpers
         return clipObscuredRegions (child, g, newClip - childPos, childPos + delta);
     }
 
+    static bool isOpaqueUntransformedAndVisible (const Component& c)
+    {
+        return c.isOpaque() && c.componentTransparency == 0 && c.isVisible() && ! c.isTransformed();
+    }
+
+    /*  Returns true if an area of the child's parent (in the parent's coordinate space) is completely
+        hidden behind opaque siblings that are in front of the child, which means that repainting it
+        would have no visible effect.
+    */
+    static bool isObscuredByOpaqueSiblings (const Component& child, Rectangle<int> areaInParent)
+    {
+        auto* parent = child.getParentComponent();
+
+        if (parent == nullptr)
+            return false;
+
+        std::optional<RectangleList<int>> remaining;
+
+        for (int i = parent->childComponentList.size(); --i >= 0;)
+        {
+            auto& sibling = *parent->childComponentList.getUnchecked (i);
+
+            if (&sibling == &child)
+                break;
+
+            const auto siblingBounds = sibling.boundsRelativeToParent;
+
+            if (! isOpaqueUntransformedAndVisible (sibling) || ! siblingBounds.intersects (areaInParent))
+                continue;
+
+            if (siblingBounds.contains (areaInParent))
+                return true;
+
+            if (! remaining.has_value())
+                remaining.emplace (areaInParent);
+
+            remaining->subtract (siblingBounds);
+
+            if (remaining->isEmpty())
+                return true;
+        }
+
+        return false;
+    }
+
     static bool clipObscuredRegions (const Component& comp,
                                      Graphics& g,
                                      const Rectangle<int> clipRect,
@@ -98,6 +98,11 @@ struct StandardCachedComponentImage : public CachedComponentImage
     bool invalidate (const Rectangle<int>& area) override    { validArea.subtract (area); return true; }
     void releaseResources() override                         { image = Image(); }
 
+    int64 getImageSizeInBytes() const
+    {
+        return image.isValid() ? (int64) image.getWidth() * image.getHeight() * (image.hasAlphaChannel() ? 4 : 3) : 0;
+    }
+
 private:
     Image image;
     RectangleList<int> validArea;
@@ -114,16 +114,25 @@ void DirectoryContentsList::clear()
 void DirectoryContentsList::refresh()
 {
     stopSearching();
-    wasEmpty = files.isEmpty();
-    files.clear();
 
     if (root.isDirectory())
-    {
-        fileFindHandle = std::make_unique<RangedDirectoryIterator> (root, false, "*", fileTypeFlags);
-        shouldStop = false;
-        isSearching = true;
-        thread.addTimeSliceClient (this);
-    }
+        startSearching();
+    else
+        clear();
+}
+
+void DirectoryContentsList::startSearching()
+{
+    // If there's already something on screen, the new results are collected separately and
+    // swapped in when the scan is complete, so the list doesn't empty and re-fill itself.
+    replaceWhenFinished = ! files.isEmpty();
+    scannedFiles.clear();
+
+    lastDirectoryModificationTime = root.getLastModificationTime();
+    fileFindHandle = std::make_unique<RangedDirectoryIterator> (root, false, "*", fileTypeFlags);
+    shouldStop = false;
+    isSearching = true;
+    thread.addTimeSliceClient (this);
 }
 
 void DirectoryContentsList::setFileFilter (const FileFilter* newFileFilter)
@@ -186,6 +195,23 @@ void DirectoryContentsList::changed()
 //==============================================================================
 int DirectoryContentsList::useTimeSlice()
 {
+    if (fileFindHandle == nullptr)
+    {
+        // Adding, removing or renaming an entry updates the directory's own modification
+        // time, so this is enough to spot changes without rescanning the whole folder.
+        if (! shouldStop && root.getLastModificationTime() != lastDirectoryModificationTime)
+        {
+            replaceWhenFinished = true;
+            scannedFiles.clear();
+            lastDirectoryModificationTime = root.getLastModificationTime();
+            fileFindHandle = std::make_unique<RangedDirectoryIterator> (root, false, "*", fileTypeFlags);
+            isSearching = true;
+            return 0;
+        }
+
+        return directoryCheckIntervalMs;
+    }
+
     auto startTime = Time::getApproximateMillisecondCounter();
     bool hasChanged = false;
 
@@ -196,7 +222,7 @@ int DirectoryContentsList::useTimeSlice()
             if (hasChanged)
                 changed();
 
-            return 500;
+            return directoryCheckIntervalMs;
         }
 
         if (shouldStop || (Time::getApproximateMillisecondCounter() > startTime + 150))
@@ -217,6 +243,10 @@ bool DirectoryContentsList::checkNextFile (bool& hasChanged)
     if (*fileFindHandle == RangedDirectoryIterator())
     {
         fileFindHandle = nullptr;
+
+        if (replaceWhenFinished)
+            replaceWithScannedFiles();
+
         isSearching = false;
         hasChanged = true;
         return false;
@@ -224,56 +254,105 @@ bool DirectoryContentsList::checkNextFile (bool& hasChanged)
 
     const auto entry = *(*fileFindHandle)++;
 
-    hasChanged |= addFile (entry.getFile(),
-                           entry.isDirectory(),
-                           entry.getFileSize(),
-                           entry.getModificationTime(),
-                           entry.getCreationTime(),
-                           entry.isReadOnly());
+    if (auto info = createFileInfo (entry.getFile(),
+                                    entry.isDirectory(),
+                                    entry.getFileSize(),
+                                    entry.getModificationTime(),
+                                    entry.getCreationTime(),
+                                    entry.isReadOnly()))
+    {
+        if (replaceWhenFinished)
+            scannedFiles.add (std::move (info));
+        else
+            hasChanged |= addFile (std::move (info));
+    }
 
     return true;
 }
 
-bool DirectoryContentsList::addFile (const File& file, const bool isDir,
-                                     const int64 fileSize,
-                                     Time modTime, Time creationTime,
-                                     const bool isReadOnly)
+std::unique_ptr<DirectoryContentsList::FileInfo> DirectoryContentsList::createFileInfo (const File& file, const bool isDir,
+                                                                                        const int64 fileSize,
+                                                                                        Time modTime, Time creationTime,
+                                                                                        const bool isReadOnly) const
+{
+    {
+        const ScopedLock sl (fileListLock);
+
+        if (! (fileFilter == nullptr
+                || ((! isDir) && fileFilter->isFileSuitable (file))
+                || (isDir && fileFilter->isDirectorySuitable (file))))
+            return {};
+    }
+
+    auto info = std::make_unique<FileInfo>();
+
+    info->filename         = file.getFileName();
+    info->fileSize         = fileSize;
+    info->modificationTime = modTime;
+    info->creationTime     = creationTime;
+    info->isDirectory      = isDir;
+    info->isReadOnly       = isReadOnly;
+
+    return info;
+}
+
+bool DirectoryContentsList::isBefore (const FileInfo* a, const FileInfo* b)
+{
+   #if JUCE_WINDOWS
+    if (a->isDirectory != b->isDirectory)
+        return a->isDirectory;
+   #endif
+
+    return a->filename.compareNatural (b->filename) < 0;
+}
+
+bool DirectoryContentsList::addFile (std::unique_ptr<FileInfo> info)
 {
     const ScopedLock sl (fileListLock);
 
-    if (fileFilter == nullptr
-         || ((! isDir) && fileFilter->isFileSuitable (file))
-         || (isDir && fileFilter->isDirectorySuitable (file)))
-    {
-        auto info = std::make_unique<FileInfo>();
+    const auto range = std::equal_range (files.begin(), files.end(), info.get(), isBefore);
 
-        info->filename         = file.getFileName();
-        info->fileSize         = fileSize;
-        info->modificationTime = modTime;
-        info->creationTime     = creationTime;
-        info->isDirectory      = isDir;
-        info->isReadOnly       = isReadOnly;
+    for (auto it = range.first; it != range.second; ++it)
+        if ((*it)->filename == info->filename)
+            return false;
 
-        for (int i = files.size(); --i >= 0;)
-            if (files.getUnchecked (i)->filename == info->filename)
-                return false;
+    files.insert ((int) std::distance (files.begin(), range.second), info.release());
+    return true;
+}
 
-        files.add (std::move (info));
+void DirectoryContentsList::replaceWithScannedFiles()
+{
+    std::stable_sort (scannedFiles.begin(), scannedFiles.end(), isBefore);
 
-        std::sort (files.begin(), files.end(), [] (const FileInfo* a, const FileInfo* b)
+    // Drop any duplicates, keeping the first one found, as addFile() does
+    for (int i = 1; i < scannedFiles.size(); ++i)
+    {
+        for (int j = i; --j >= 0 && ! isBefore (scannedFiles.getUnchecked (j), scannedFiles.getUnchecked (i));)
         {
-           #if JUCE_WINDOWS
-            if (a->isDirectory != b->isDirectory)
-                return a->isDirectory;
-           #endif
+            if (scannedFiles.getUnchecked (j)->filename == scannedFiles.getUnchecked (i)->filename)
+            {
+                scannedFiles.remove (i--);
+                break;
+            }
+        }
+    }
+
+    const auto isSameInfo = [] (const FileInfo* a, const FileInfo* b)
+    {
+        return a->filename == b->filename
+            && a->fileSize == b->fileSize
+            && a->modificationTime == b->modificationTime
+            && a->creationTime == b->creationTime
+            && a->isDirectory == b->isDirectory
+            && a->isReadOnly == b->isReadOnly;
+    };
 
-            return a->filename.compareNatural (b->filename) < 0;
-        });
+    const ScopedLock sl (fileListLock);
 
-        return true;
-    }
+    if (! std::equal (files.begin(), files.end(), scannedFiles.begin(), scannedFiles.end(), isSameInfo))
+        files.swapWith (scannedFiles);
 
-    return false;
+    scannedFiles.clear();
 }
 
 } // namespace juce
@@ -214,19 +214,25 @@ private:
     int fileTypeFlags = File::ignoreHiddenFiles | File::findFiles;
 
     CriticalSection fileListLock;
-    OwnedArray<FileInfo> files;
+    OwnedArray<FileInfo> files, scannedFiles;
 
     std::unique_ptr<RangedDirectoryIterator> fileFindHandle;
     std::atomic<bool> shouldStop { true }, isSearching { false };
 
-    bool wasEmpty = true;
+    Time lastDirectoryModificationTime;
+    bool replaceWhenFinished = false;
+    static constexpr int directoryCheckIntervalMs = 500;
 
     int useTimeSlice() override;
+    void startSearching();
     void stopSearching();
     void changed();
     bool checkNextFile (bool& hasChanged);
-    bool addFile (const File&, bool isDir, int64 fileSize, Time modTime,
-                  Time creationTime, bool isReadOnly);
+    std::unique_ptr<FileInfo> createFileInfo (const File&, bool isDir, int64 fileSize, Time modTime,
+                                              Time creationTime, bool isReadOnly) const;
+    bool addFile (std::unique_ptr<FileInfo>);
+    void replaceWithScannedFiles();
+    static bool isBefore (const FileInfo*, const FileInfo*);
     void setTypeFlags (int);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectoryContentsList)
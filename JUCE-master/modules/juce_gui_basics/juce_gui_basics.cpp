@@ -154,6 +154,7 @@
 #include "detail/juce_AlertWindowHelpers.h"
 #include "detail/juce_TopLevelWindowManager.h"
 #include "detail/juce_StandardCachedComponentImage.h"
+#include "detail/juce_AdaptiveCachedComponentImage.h"
 
 //==============================================================================
 #if JUCE_IOS || JUCE_WINDOWS
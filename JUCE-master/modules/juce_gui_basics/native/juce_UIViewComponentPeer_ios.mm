@@ -2209,7 +2209,7 @@ bool UIViewComponentPeer::canBecomeKeyWindow()
 //==============================================================================
 void Desktop::setKioskComponent (Component* kioskModeComp, bool enableOrDisable, bool /*allowMenusAndBars*/)
 {
-    displays->refresh();
+    refreshDisplays();
 
     if (auto* peer = kioskModeComp->getPeer())
     {
@@ -2345,7 +2345,7 @@ std::unique_ptr<Desktop::NativeDarkModeChangeDetectorImpl> Desktop::createNative
 
 bool Desktop::isDarkModeActive() const
 {
-    return nativeDarkModeChangeDetectorImpl->isDarkModeEnabled();
+    return getNativeDarkModeChangeDetector().isDarkModeEnabled();
 }
 
 double Desktop::getDefaultMasterScale()
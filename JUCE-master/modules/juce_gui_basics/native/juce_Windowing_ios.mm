@@ -612,7 +612,7 @@ void Displays::findDisplays (float masterScale)
             static void setKeyboardScreenBounds (id self, BorderSize<double> insets)
             {
                 if (std::exchange (getIvar<OnScreenKeyboardChangeDetectorImpl*> (self, "owner")->insets, insets) != insets)
-                    Desktop::getInstance().displays->refresh();
+                    Desktop::getInstance().refreshDisplays();
             }
         };
 
@@ -444,23 +444,26 @@ private:
         {
             XWindowSystem::getInstance()->processPendingPaintsForWindow (peer.windowH);
 
-            if (XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) > 0)
+            if (! canStartNewFrame())
                 return;
 
             if (! regionsNeedingRepaint.isEmpty())
                 performAnyPendingRepaintsNow();
             else if (Time::getApproximateMillisecondCounter() > lastTimeImageUsed + 3000)
-                image = Image();
+                images = {};
         }
 
         void repaint (Rectangle<int> area)
         {
             regionsNeedingRepaint.add (area * peer.currentScaleFactor);
+
+            if (regionsNeedingRepaint.getNumRectangles() > maxRectanglesBeforeCoalescing)
+                coalesceRegionsNeedingRepaint();
         }
 
         void performAnyPendingRepaintsNow()
         {
-            if (XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) > 0)
+            if (! canStartNewFrame())
                 return;
 
             auto originalRepaintRegion = regionsNeedingRepaint;
@@ -469,9 +472,15 @@ private:
 
             if (! totalArea.isEmpty())
             {
-                const auto wasImageNull = image.isNull();
+                // While the server is still reading the previous frame from shared memory, we
+                // paint into the other buffer so that we don't tear the frame that's in flight.
+                if (isDoubleBuffered())
+                    currentImage ^= 1;
+
+                auto& image = images[(size_t) currentImage];
+                const auto wasImageNull = images[0].isNull() && images[1].isNull();
 
-                if (wasImageNull || image.getWidth() < totalArea.getWidth()
+                if (image.isNull() || image.getWidth() < totalArea.getWidth()
                      || image.getHeight() < totalArea.getHeight())
                 {
                     image = XWindowSystem::getInstance()->createImage (isSemiTransparentWindow,
@@ -510,17 +519,59 @@ private:
                     peer.handlePaint (*context);
                 }
 
-                for (auto& i : originalRepaintRegion)
-                   XWindowSystem::getInstance()->blitToWindow (peer.windowH, image, i, totalArea);
+                XWindowSystem::getInstance()->blitToWindow (peer.windowH, image, originalRepaintRegion, totalArea);
             }
 
             lastTimeImageUsed = Time::getApproximateMillisecondCounter();
         }
 
     private:
+        static constexpr int maxRectanglesBeforeCoalescing = 16;
+        static constexpr int coalescingTileSize = 32;
+
+        /*  Lots of small scattered rectangles make clipping expensive and mean many separate
+            blits, so once there are too many, we snap them outwards to a coarse grid, which
+            lets neighbouring areas merge into a few larger ones. If that still leaves too many,
+            the bounding box is cheaper to paint than the fragmented region.
+        */
+        void coalesceRegionsNeedingRepaint()
+        {
+            RectangleList<int> snapped;
+
+            for (auto& r : regionsNeedingRepaint)
+            {
+                const auto x1 = r.getX() - (((r.getX() % coalescingTileSize) + coalescingTileSize) % coalescingTileSize);
+                const auto y1 = r.getY() - (((r.getY() % coalescingTileSize) + coalescingTileSize) % coalescingTileSize);
+                const auto x2 = x1 + ((r.getRight()  - x1 + coalescingTileSize - 1) / coalescingTileSize) * coalescingTileSize;
+                const auto y2 = y1 + ((r.getBottom() - y1 + coalescingTileSize - 1) / coalescingTileSize) * coalescingTileSize;
+
+                snapped.add (Rectangle<int>::leftTopRightBottom (x1, y1, x2, y2));
+            }
+
+            snapped.clipTo (regionsNeedingRepaint.getBounds());
+            snapped.consolidate();
+
+            if (snapped.getNumRectangles() > maxRectanglesBeforeCoalescing)
+                regionsNeedingRepaint = RectangleList<int> (regionsNeedingRepaint.getBounds());
+            else
+                regionsNeedingRepaint.swapWith (snapped);
+        }
+
+        bool isDoubleBuffered() const
+        {
+            return XWindowSystem::getInstance()->isSharedMemoryImage (images[(size_t) currentImage]);
+        }
+
+        bool canStartNewFrame() const
+        {
+            const auto maxFramesInFlight = isDoubleBuffered() ? 2 : 1;
+            return XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) < maxFramesInFlight;
+        }
+
         LinuxComponentPeer& peer;
         const bool isSemiTransparentWindow;
-        Image image;
+        std::array<Image, 2> images;
+        int currentImage = 0;
         uint32 lastTimeImageUsed = 0;
         RectangleList<int> regionsNeedingRepaint;
 
@@ -693,7 +744,7 @@ std::unique_ptr<Desktop::NativeDarkModeChangeDetectorImpl> Desktop::createNative
 
 bool Desktop::isDarkModeActive() const
 {
-    return nativeDarkModeChangeDetectorImpl->isDarkModeEnabled();
+    return getNativeDarkModeChangeDetector().isDarkModeEnabled();
 }
 
 static bool screenSaverAllowed = true;
@@ -853,7 +853,7 @@ std::unique_ptr<Desktop::NativeDarkModeChangeDetectorImpl> Desktop::createNative
 
 bool Desktop::isDarkModeActive() const
 {
-    return nativeDarkModeChangeDetectorImpl->isDarkModeEnabled();
+    return getNativeDarkModeChangeDetector().isDarkModeEnabled();
 }
 
 Desktop::DisplayOrientation Desktop::getCurrentOrientation() const
@@ -181,6 +181,8 @@ bool X11Symbols::loadAllSymbols()
                        makeSymbolBinding (xSelectInput,                "XSelectInput"),
                        makeSymbolBinding (xSendEvent,                  "XSendEvent"),
                        makeSymbolBinding (xSetClassHint,               "XSetClassHint"),
+                       makeSymbolBinding (xSetClipMask,                "XSetClipMask"),
+                       makeSymbolBinding (xSetClipRectangles,          "XSetClipRectangles"),
                        makeSymbolBinding (xSetErrorHandler,            "XSetErrorHandler"),
                        makeSymbolBinding (xSetIOErrorHandler,          "XSetIOErrorHandler"),
                        makeSymbolBinding (xSetInputFocus,              "XSetInputFocus"),
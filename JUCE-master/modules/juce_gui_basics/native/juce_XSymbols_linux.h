@@ -426,6 +426,14 @@ public:
                                          (::Display*, ::Window, XClassHint*),
                                          void)
 
+    JUCE_GENERATE_FUNCTION_WITH_DEFAULT (XSetClipMask, xSetClipMask,
+                                         (::Display*, GC, Pixmap),
+                                         int)
+
+    JUCE_GENERATE_FUNCTION_WITH_DEFAULT (XSetClipRectangles, xSetClipRectangles,
+                                         (::Display*, GC, int, int, XRectangle*, int, int),
+                                         int)
+
     JUCE_GENERATE_FUNCTION_WITH_DEFAULT (XSetErrorHandler, xSetErrorHandler,
                                          (XErrorHandler),
                                          XErrorHandler)
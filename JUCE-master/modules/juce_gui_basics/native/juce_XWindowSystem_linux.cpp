@@ -1029,59 +1029,78 @@ public:
             XWindowSystem::getInstance()->addPendingPaintForWindow (window);
        #endif
 
-        if (gc == None)
+        createGCIfNeeded (window);
+        convertToNativeDepth ({ sx, sy, (int) dw, (int) dh });
+        putImage (window, sx, sy, dx, dy, dw, dh);
+    }
+
+    /*  Sends all the rectangles in the source area to the window in one go. With shared memory,
+        the bounding box is sent as a single XShmPutImage clipped to the region, so that a frame
+        only generates one completion event. Without it, a single clipped XPutImage is used when the
+        region covers most of its bounds, and one request per rectangle otherwise.
+    */
+    void blitRegionToWindow (::Window window, const RectangleList<int>& sourceArea, Point<int> destOffset)
+    {
+        if (sourceArea.isEmpty())
+            return;
+
+        XWindowSystemUtilities::ScopedXLock xLock;
+
+        createGCIfNeeded (window);
+
+        for (auto& r : sourceArea)
+            convertToNativeDepth (r);
+
+        const auto bounds = sourceArea.getBounds();
+        const auto numRects = sourceArea.getNumRectangles();
+
+        const auto blitRect = [&] (Rectangle<int> r)
         {
-            XGCValues gcvalues;
-            gcvalues.foreground = None;
-            gcvalues.background = None;
-            gcvalues.function = GXcopy;
-            gcvalues.plane_mask = AllPlanes;
-            gcvalues.clip_mask = None;
-            gcvalues.graphics_exposures = False;
+            putImage (window, r.getX(), r.getY(), r.getX() + destOffset.x, r.getY() + destOffset.y,
+                      (unsigned int) r.getWidth(), (unsigned int) r.getHeight());
+        };
+
+        if (numRects == 1)
+        {
+           #if JUCE_USE_XSHM
+            if (isUsingXShm())
+                XWindowSystem::getInstance()->addPendingPaintForWindow (window);
+           #endif
 
-            gc = X11Symbols::getInstance()->xCreateGC (display, window,
-                                                       GCBackground | GCForeground | GCFunction | GCPlaneMask | GCClipMask | GCGraphicsExposures,
-                                                       &gcvalues);
+            blitRect (bounds);
+            return;
         }
 
-        if (imageDepth == 16)
+       #if JUCE_USE_XSHM
+        const auto useSingleRequest = isUsingXShm() || isMostlyCovered (sourceArea, bounds);
+       #else
+        const auto useSingleRequest = isMostlyCovered (sourceArea, bounds);
+       #endif
+
+        if (! useSingleRequest)
         {
-            auto rMask   = (uint32) xImage->red_mask;
-            auto gMask   = (uint32) xImage->green_mask;
-            auto bMask   = (uint32) xImage->blue_mask;
-            auto rShiftL = (uint32) jmax (0,  getShiftNeeded (rMask));
-            auto rShiftR = (uint32) jmax (0, -getShiftNeeded (rMask));
-            auto gShiftL = (uint32) jmax (0,  getShiftNeeded (gMask));
-            auto gShiftR = (uint32) jmax (0, -getShiftNeeded (gMask));
-            auto bShiftL = (uint32) jmax (0,  getShiftNeeded (bMask));
-            auto bShiftR = (uint32) jmax (0, -getShiftNeeded (bMask));
+            for (auto& r : sourceArea)
+                blitRect (r);
 
-            Image::BitmapData srcData (Image (this), Image::BitmapData::readOnly);
+            return;
+        }
 
-            for (int y = sy; y < sy + (int) dh; ++y)
-            {
-                auto* p = srcData.getPixelPointer (sx, y);
+        HeapBlock<XRectangle> clipRects ((size_t) numRects);
+        auto* clip = clipRects.get();
 
-                for (int x = sx; x < sx + (int) dw; ++x)
-                {
-                    auto* pixel = (PixelRGB*) p;
-                    p += srcData.pixelStride;
+        for (auto& r : sourceArea)
+            *clip++ = { (short) (r.getX() + destOffset.x), (short) (r.getY() + destOffset.y),
+                        (unsigned short) r.getWidth(), (unsigned short) r.getHeight() };
 
-                    X11Symbols::getInstance()->xPutPixel (xImage.get(), x, y,
-                                                              (((((uint32) pixel->getRed())   << rShiftL) >> rShiftR) & rMask)
-                                                            | (((((uint32) pixel->getGreen()) << gShiftL) >> gShiftR) & gMask)
-                                                            | (((((uint32) pixel->getBlue())  << bShiftL) >> bShiftR) & bMask));
-                }
-            }
-        }
+        X11Symbols::getInstance()->xSetClipRectangles (display, gc, 0, 0, clipRects.get(), numRects, Unsorted);
 
-        // blit results to screen.
        #if JUCE_USE_XSHM
         if (isUsingXShm())
-            X11Symbols::getInstance()->xShmPutImage (display, (::Drawable) window, gc, xImage.get(), sx, sy, dx, dy, dw, dh, True);
-        else
+            XWindowSystem::getInstance()->addPendingPaintForWindow (window);
        #endif
-            X11Symbols::getInstance()->xPutImage (display, (::Drawable) window, gc, xImage.get(), sx, sy, dx, dy, dw, dh);
+
+        blitRect (bounds);
+        X11Symbols::getInstance()->xSetClipMask (display, gc, None);
     }
 
     #if JUCE_USE_XSHM
@@ -1090,6 +1109,81 @@ public:
 
 private:
     //==============================================================================
+    void createGCIfNeeded (::Window window)
+    {
+        if (gc != None)
+            return;
+
+        XGCValues gcvalues;
+        gcvalues.foreground = None;
+        gcvalues.background = None;
+        gcvalues.function = GXcopy;
+        gcvalues.plane_mask = AllPlanes;
+        gcvalues.clip_mask = None;
+        gcvalues.graphics_exposures = False;
+
+        gc = X11Symbols::getInstance()->xCreateGC (display, window,
+                                                   GCBackground | GCForeground | GCFunction | GCPlaneMask | GCClipMask | GCGraphicsExposures,
+                                                   &gcvalues);
+    }
+
+    void convertToNativeDepth (Rectangle<int> area)
+    {
+        if (imageDepth != 16)
+            return;
+
+        auto rMask   = (uint32) xImage->red_mask;
+        auto gMask   = (uint32) xImage->green_mask;
+        auto bMask   = (uint32) xImage->blue_mask;
+        auto rShiftL = (uint32) jmax (0,  getShiftNeeded (rMask));
+        auto rShiftR = (uint32) jmax (0, -getShiftNeeded (rMask));
+        auto gShiftL = (uint32) jmax (0,  getShiftNeeded (gMask));
+        auto gShiftR = (uint32) jmax (0, -getShiftNeeded (gMask));
+        auto bShiftL = (uint32) jmax (0,  getShiftNeeded (bMask));
+        auto bShiftR = (uint32) jmax (0, -getShiftNeeded (bMask));
+
+        Image::BitmapData srcData (Image (this), Image::BitmapData::readOnly);
+
+        for (int y = area.getY(); y < area.getBottom(); ++y)
+        {
+            auto* p = srcData.getPixelPointer (area.getX(), y);
+
+            for (int x = area.getX(); x < area.getRight(); ++x)
+            {
+                auto* pixel = (PixelRGB*) p;
+                p += srcData.pixelStride;
+
+                X11Symbols::getInstance()->xPutPixel (xImage.get(), x, y,
+                                                          (((((uint32) pixel->getRed())   << rShiftL) >> rShiftR) & rMask)
+                                                        | (((((uint32) pixel->getGreen()) << gShiftL) >> gShiftR) & gMask)
+                                                        | (((((uint32) pixel->getBlue())  << bShiftL) >> bShiftR) & bMask));
+            }
+        }
+    }
+
+    void putImage (::Window window, int sx, int sy, int dx, int dy, unsigned int dw, unsigned int dh)
+    {
+       #if JUCE_USE_XSHM
+        if (isUsingXShm())
+            X11Symbols::getInstance()->xShmPutImage (display, (::Drawable) window, gc, xImage.get(), sx, sy, dx, dy, dw, dh, True);
+        else
+       #endif
+            X11Symbols::getInstance()->xPutImage (display, (::Drawable) window, gc, xImage.get(), sx, sy, dx, dy, dw, dh);
+    }
+
+    /*  Sending the bounding box is cheaper than issuing lots of small requests, unless the
+        region is sparse enough that we'd be pushing a lot of pixels that aren't needed.
+    */
+    static bool isMostlyCovered (const RectangleList<int>& area, Rectangle<int> bounds)
+    {
+        int64 covered = 0;
+
+        for (auto& r : area)
+            covered += (int64) r.getWidth() * r.getHeight();
+
+        return covered * 4 >= (int64) bounds.getWidth() * bounds.getHeight() * 3;
+    }
+
     struct Deleter
     {
         void operator() (XImage* img) const noexcept
@@ -2216,6 +2310,30 @@ void XWindowSystem::blitToWindow (::Window windowH, Image image, Rectangle<int>
                            destinationRect.getX() - totalRect.getX(), destinationRect.getY() - totalRect.getY());
 }
 
+void XWindowSystem::blitToWindow (::Window windowH, Image image, const RectangleList<int>& destinationArea, Rectangle<int> totalRect) const
+{
+    jassert (windowH != 0);
+
+    auto* xbitmap = static_cast<XBitmapImage*> (image.getPixelData().get());
+
+    RectangleList<int> sourceArea (destinationArea);
+    sourceArea.offsetAll (-totalRect.getX(), -totalRect.getY());
+
+    xbitmap->blitRegionToWindow (windowH, sourceArea, totalRect.getPosition());
+}
+
+bool XWindowSystem::isSharedMemoryImage (const Image& image) const
+{
+   #if JUCE_USE_XSHM
+    if (auto* xbitmap = dynamic_cast<XBitmapImage*> (image.getPixelData().get()))
+        return xbitmap->isUsingXShm();
+   #else
+    ignoreUnused (image);
+   #endif
+
+    return false;
+}
+
 void XWindowSystem::processPendingPaintsForWindow (::Window windowH)
 {
    #if JUCE_USE_XSHM
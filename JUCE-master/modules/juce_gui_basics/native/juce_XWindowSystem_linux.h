@@ -218,6 +218,8 @@ public:
 
     Image createImage (bool isSemiTransparentWindow, int width, int height, bool argb) const;
     void blitToWindow (::Window, Image, Rectangle<int> destinationRect, Rectangle<int> totalRect) const;
+    void blitToWindow (::Window, Image, const RectangleList<int>& destinationArea, Rectangle<int> totalRect) const;
+    bool isSharedMemoryImage (const Image&) const;
 
     void setScreenSaverEnabled (bool enabled) const;
 
@@ -1311,7 +1311,7 @@ public:
     Slider& owner;
     SliderStyle style;
 
-    ListenerList<Slider::Listener> listeners;
+    InlineListenerList<Slider::Listener> listeners;
     Value currentValue, valueMin, valueMax;
     double lastCurrentValue = 0, lastValueMin = 0, lastValueMax = 0;
     NormalisableRange<double> normRange { 0.0, 10.0 };
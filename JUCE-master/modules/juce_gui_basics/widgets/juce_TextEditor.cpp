@@ -781,25 +781,12 @@ detail::RangedValues<T> TextEditor::getGlyphRanges (const detail::RangedValues<T
 
 bool TextEditor::isTextStorageHeightGreaterEqualThan (float value) const
 {
-    float height = 0.0;
-
-    for (auto paragraphItem : *textStorage)
-    {
-        height += paragraphItem.value->getHeight();
-
-        if (height >= value)
-            return true;
-    }
-
-    return false;
+    return textStorage->getTotalHeight() >= value;
 }
 
 float TextEditor::getTextStorageHeight() const
 {
-    const auto textHeight = std::accumulate (textStorage->begin(), textStorage->end(), 0.0f, [&] (auto acc, auto item)
-    {
-        return acc + item.value->getHeight();
-    });
+    const auto textHeight = textStorage->getTotalHeight();
 
     if (! textStorage->isEmpty() && ! textStorage->back().value->getText().endsWith ("\n"))
         return textHeight;
@@ -877,16 +864,13 @@ TextEditor::CaretEdge TextEditor::getTextSelectionEdge (int index, Edge edge) co
     jassert (0 <= index && index < getTotalNumChars());
     const auto textRange = Range<int64>::withStartAndLength ((int64) index, 1);
 
-    const auto paragraphIt = std::find_if (textStorage->begin(),
-                                           textStorage->end(),
-                                           [&] (const auto& p)
-                                           {
-                                               return p.range.contains (textRange.getStart());
-                                           });
+    const auto paragraphItem = textStorage->getParagraphContainingCodepointIndex (textRange.getStart());
+    jassert (paragraphItem.has_value());
 
-    jassert (paragraphIt != textStorage->end());
+    if (! paragraphItem.has_value())
+        return getDefaultCursorEdge();
 
-    auto& paragraph = paragraphIt->value;
+    auto& paragraph = paragraphItem->value;
     const auto& shapedText = paragraph->getShapedText();
 
     const auto glyphRange = std::invoke ([&]() -> Range<int64>
@@ -992,21 +976,7 @@ void TextEditor::checkLayout()
         const auto textBottom = topIndent
                                 + (int) std::ceil (getYOffset() + getTextStorageHeight());
 
-        const auto maxTextWidth = std::accumulate (textStorage->begin(), textStorage->end(), 0.0f, [&](auto pMax, auto paragraph)
-                                                   {
-                                                       auto& shapedText = paragraph.value->getShapedText();
-
-                                                       const auto paragraphWidth = std::accumulate (shapedText.getLineMetricsForGlyphRange().begin(),
-                                                                                                    shapedText.getLineMetricsForGlyphRange().end(),
-                                                                                                    0.0f,
-                                                                                                    [&] (auto lMax, auto line)
-                                                                                                    {
-                                                                                                        return std::max (lMax,
-                                                                                                                         line.value.effectiveLineLength);
-                                                                                                    });
-
-                                                       return std::max (pMax, paragraphWidth);
-                                                   });
+        const auto maxTextWidth = textStorage->getMaxWidth();
 
         const auto textRight = std::max (viewport->getMaximumVisibleWidth(),
                                          (int) std::ceil (maxTextWidth) + leftIndent + rightEdgeSpace);
@@ -1315,12 +1285,33 @@ void TextEditor::drawContent (Graphics& g)
 
     detail::Ranges::Operations ops;
 
-    const auto glyphColours = getGlyphRanges (textStorage->getColours());
+    const auto clip = std::invoke ([&]
+    {
+        auto c = g.getClipBounds();
+        c.setY (roundToInt ((float) c.getY() - yOffset));
+        return c;
+    });
+
+    // Only the paragraphs within the clip region are visited, so that the cost of painting
+    // doesn't depend on the size of the whole document
+    const auto [firstVisible, endVisible] = textStorage->getIndicesInVerticalRange ((float) clip.getY(),
+                                                                                    (float) clip.getBottom());
+
+    if (firstVisible >= endVisible)
+        return;
+
+    const auto visibleChars = textStorage->getParagraph (firstVisible).range
+                                          .getUnionWith (textStorage->getParagraph (endVisible - 1).range);
+
+    const auto visibleGlyphs = Range<int64> (textStorage->getStartingGlyph (firstVisible),
+                                             textStorage->getStartingGlyph (endVisible));
+
+    const auto glyphColours = getGlyphRanges (textStorage->getColours().getIntersectionsWith (visibleChars));
 
     const auto selectedTextRanges = std::invoke ([&]
     {
         detail::RangedValues<int8_t> rv;
-        rv.set (asInt64Range (selection), 1, ops);
+        rv.set (asInt64Range (selection).getIntersectionWith (visibleChars), 1, ops);
         return getGlyphRanges (rv);
     });
 
@@ -1329,7 +1320,7 @@ void TextEditor::drawContent (Graphics& g)
         ops.clear();
 
         detail::RangedValues<int8_t> rv;
-        rv.set ({ 0, textStorage->getTotalNumGlyphs() }, 0, ops);
+        rv.set (visibleGlyphs, 0, ops);
 
         for (const auto item : selectedTextRanges)
             rv.set (item.range, item.value, ops);
@@ -1342,10 +1333,10 @@ void TextEditor::drawContent (Graphics& g)
         ops.clear();
 
         detail::RangedValues<int> rv;
-        rv.set ({ 0, textStorage->getTotalNumChars() }, 0, ops);
+        rv.set (visibleChars, 0, ops);
 
         for (const auto& underlined : underlinedSections)
-            rv.set (asInt64Range (underlined), 1, ops);
+            rv.set (asInt64Range (underlined).getIntersectionWith (visibleChars), 1, ops);
 
         return getGlyphRanges (rv);
     });
@@ -1436,22 +1427,18 @@ void TextEditor::drawContent (Graphics& g)
         }
     };
 
-    const auto clip = std::invoke ([&]
-    {
-        auto c = g.getClipBounds();
-        c.setY (roundToInt ((float) c.getY() - yOffset));
-        return c;
-    });
+    const auto baseYOffset = yOffset;
 
-    for (auto [range, paragraph] : *textStorage)
+    for (auto index = firstVisible; index < endVisible; ++index)
     {
-        ignoreUnused (range);
+        auto& paragraph = textStorage->getParagraph (index).value;
 
-        const auto glyphsRange = Range<int64>::withStartAndLength (paragraph->getStartingGlyph(),
+        const auto glyphsRange = Range<int64>::withStartAndLength (textStorage->getStartingGlyph (index),
                                                                    paragraph->getNumGlyphs());
 
-        const auto top = paragraph->getTop();
+        const auto top = textStorage->getTop (index);
         const auto bottom = top + paragraph->getHeight();
+        yOffset = baseYOffset + top;
 
         if ((float) clip.getY() <= bottom && top <= (float) clip.getBottom())
         {
@@ -1463,8 +1450,6 @@ void TextEditor::drawContent (Graphics& g)
                                                            textSelectionMask.getIntersectionsStartingAtZeroWith (glyphsRange),
                                                            underlining.getIntersectionsStartingAtZeroWith (glyphsRange));
         }
-
-        yOffset += paragraph->getHeight();
     }
 }
 
@@ -2189,29 +2174,16 @@ int TextEditor::indexAtPosition (float x, float y) const
     if (getWordWrapWidth() <= 0)
         return getTotalNumChars();
 
-    auto paragraphIt = textStorage->begin();
-    float paragraphTop = 0.0f;
-
-    while (paragraphIt != textStorage->end())
-    {
-        auto& paragraph = paragraphIt->value;
-        const auto paragraphBottom = paragraphTop + paragraph->getHeight();
+    const auto index = textStorage->getIndexAtY (y);
 
-        if (paragraphTop <= y && y < paragraphBottom)
-            break;
-
-        if (y < paragraphTop)
-            return {};
-
-        paragraphTop = paragraphBottom;
-        ++paragraphIt;
-    }
-
-    if (paragraphIt == textStorage->end())
+    if (! index.has_value())
         return getTotalNumChars();
 
-    auto& shapedText = paragraphIt->value->getShapedText();
-    return (int) (shapedText.getTextIndexForCaret ({ x, y - paragraphTop }) + paragraphIt->range.getStart());
+    const auto paragraph = textStorage->getParagraph (*index);
+    const auto paragraphTop = textStorage->getTop (*index);
+
+    auto& shapedText = paragraph.value->getShapedText();
+    return (int) (shapedText.getTextIndexForCaret ({ x, y - paragraphTop }) + paragraph.range.getStart());
 }
 
 //==============================================================================
@@ -2311,7 +2283,7 @@ void TextEditor::CaretState::updateEdge()
     {
         edge = Edge::leading;
     }
-    else if (owner.getText()[clampedPosition - 1] == '\n')
+    else if (owner.getTextInRange ({ clampedPosition - 1, clampedPosition }) == "\n")
     {
         edge = Edge::leading;
     }
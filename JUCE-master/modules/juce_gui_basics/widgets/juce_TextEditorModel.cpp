@@ -83,6 +83,20 @@ public:
         return *numGlyphs;
     }
 
+    float getWidth()
+    {
+        if (! width.has_value())
+        {
+            const auto& lineMetrics = getShapedText().getLineMetricsForGlyphRange();
+            width = std::accumulate (lineMetrics.begin(), lineMetrics.end(), 0.0f, [] (auto w, auto line)
+            {
+                return std::max (w, line.value.effectiveLineLength);
+            });
+        }
+
+        return *width;
+    }
+
     float getTop();
 
     int64 getStartingGlyph();
@@ -98,7 +112,7 @@ private:
     Range<int64> range;
     const TextEditorStorage& storage;
     std::optional<detail::ShapedText> shapedText;
-    std::optional<float> height;
+    std::optional<float> height, width;
     std::optional<int64> numGlyphs;
 };
 
@@ -218,16 +232,114 @@ public:
 
     int64 getTotalNumGlyphs() const
     {
-        return std::accumulate (storage.begin(),
-                                storage.end(),
-                                (int64) 0,
-                                [] (const auto& sum, const auto& item)
-                                {
-                                    return sum + item->getNumGlyphs();
-                                });
+        updateLayoutCache (storage.size());
+        return startingGlyphs[storage.size()];
+    }
+
+    size_t size() const { return storage.size(); }
+
+    ParagraphItem getParagraph (size_t index) const
+    {
+        jassert (index < storage.size());
+        return { ranges.get (index), storage[index] };
+    }
+
+    std::optional<size_t> getIndexOf (const ParagraphStorage& paragraph) const
+    {
+        if (const auto index = ranges.getIndexForEnclosingRange (paragraph.getRange().getStart()))
+            if (storage[*index].get() == &paragraph)
+                return index;
+
+        const auto iter = std::find_if (storage.begin(), storage.end(), [&] (const auto& p) { return p.get() == &paragraph; });
+
+        if (iter == storage.end())
+            return std::nullopt;
+
+        return (size_t) std::distance (storage.begin(), iter);
+    }
+
+    float getTop (size_t index) const
+    {
+        updateLayoutCache (index);
+        return tops[index];
+    }
+
+    int64 getStartingGlyph (size_t index) const
+    {
+        updateLayoutCache (index);
+        return startingGlyphs[index];
+    }
+
+    float getTotalHeight() const
+    {
+        return getTop (storage.size());
+    }
+
+    float getMaxWidth() const
+    {
+        updateLayoutCache (storage.size());
+        return maxWidths[storage.size()];
+    }
+
+    /*  Returns the range of indices of the paragraphs that overlap the given vertical range. */
+    std::pair<size_t, size_t> getIndicesInVerticalRange (float top, float bottom) const
+    {
+        updateLayoutCache (storage.size());
+
+        const auto bottomsBegin = std::next (tops.begin());
+        const auto bottomsEnd = std::next (tops.begin(), (std::ptrdiff_t) storage.size() + 1);
+        const auto first = std::lower_bound (bottomsBegin, bottomsEnd, top);
+        const auto last  = std::upper_bound (tops.begin(), std::prev (bottomsEnd), bottom);
+
+        return { (size_t) std::distance (bottomsBegin, first),
+                 (size_t) std::max (std::distance (tops.begin(), last), std::distance (bottomsBegin, first)) };
+    }
+
+    /*  Returns the index of the paragraph containing the given y position, or nullopt if it's
+        below the last paragraph.
+    */
+    std::optional<size_t> getIndexAtY (float y) const
+    {
+        updateLayoutCache (storage.size());
+
+        const auto bottomsBegin = std::next (tops.begin());
+        const auto bottomsEnd = std::next (tops.begin(), (std::ptrdiff_t) storage.size() + 1);
+        const auto iter = std::upper_bound (bottomsBegin, bottomsEnd, y);
+
+        if (iter == bottomsEnd)
+            return std::nullopt;
+
+        return (size_t) std::distance (bottomsBegin, iter);
+    }
+
+    void invalidateLayoutFrom (size_t index)
+    {
+        numValidLayoutEntries = std::min (numValidLayoutEntries, index + 1);
     }
 
 private:
+    // Keeps running totals of the paragraph heights, glyph counts and widths, so that finding
+    // the position of a paragraph doesn't need to visit all the ones before it. Entry i holds
+    // the totals for the paragraphs before i, and the entries from numValidLayoutEntries onwards
+    // are recalculated when needed.
+    void updateLayoutCache (size_t index) const
+    {
+        jassert (index <= storage.size());
+
+        tops.resize (storage.size() + 1);
+        startingGlyphs.resize (storage.size() + 1);
+        maxWidths.resize (storage.size() + 1);
+        numValidLayoutEntries = std::clamp (numValidLayoutEntries, (size_t) 1, storage.size() + 1);
+
+        for (; numValidLayoutEntries <= index; ++numValidLayoutEntries)
+        {
+            auto& paragraph = *storage[numValidLayoutEntries - 1];
+            tops[numValidLayoutEntries] = tops[numValidLayoutEntries - 1] + paragraph.getHeight();
+            startingGlyphs[numValidLayoutEntries] = startingGlyphs[numValidLayoutEntries - 1] + paragraph.getNumGlyphs();
+            maxWidths[numValidLayoutEntries] = std::max (maxWidths[numValidLayoutEntries - 1], paragraph.getWidth());
+        }
+    }
+
     static void mergeForward (detail::Ranges& ranges, size_t index, detail::Ranges::Operations& ops)
     {
         if (ranges.size() > index + 1)
@@ -238,32 +350,63 @@ private:
     {
         using namespace detail;
 
-        for (const auto& op : ops)
+        auto firstChangedIndex = storage.size();
+
+        for (size_t opIndex = 0; opIndex < ops.size(); ++opIndex)
         {
+            const auto& op = ops[opIndex];
+
             if (auto* newOp = std::get_if<Ranges::Ops::New> (&op))
             {
+                firstChangedIndex = std::min (firstChangedIndex, newOp->index);
                 storage.insert (iteratorWithAdvance (storage.begin(), newOp->index),
                                 createParagraph (text));
             }
             else if (auto* split = std::get_if<Ranges::Ops::Split> (&op))
             {
-                const auto& splitValue = storage[split->index]->getText();
-                const auto localLeftRange = split->leftRange.movedToStartAt (0);
-                const auto localRightRange = split->rightRange.movedToStartAt (localLeftRange.getEnd());
+                firstChangedIndex = std::min (firstChangedIndex, split->index);
+
+                // Inserting text with many line breaks produces a run of splits, each one cutting
+                // the right-hand part of the previous one. Handling the whole run together means
+                // that the text is only walked once, instead of copying the remainder every time.
+                std::vector<int64> pieceLengths { split->leftRange.getLength() };
+                auto* lastSplit = split;
+
+                while (opIndex + 1 < ops.size())
+                {
+                    auto* nextSplit = std::get_if<Ranges::Ops::Split> (&ops[opIndex + 1]);
+
+                    if (nextSplit == nullptr || nextSplit->index != lastSplit->index + 1)
+                        break;
+
+                    pieceLengths.push_back (nextSplit->leftRange.getLength());
+                    lastSplit = nextSplit;
+                    ++opIndex;
+                }
 
-                auto leftSplitValue = splitValue.substring ((int) localLeftRange.getStart(),
-                                                            (int) localLeftRange.getEnd());
+                pieceLengths.push_back (lastSplit->rightRange.getLength());
 
-                auto rightSplitValue = splitValue.substring ((int) localRightRange.getStart(),
-                                                             (int) localRightRange.getEnd());
+                std::vector<std::unique_ptr<ParagraphStorage>> pieces;
+                pieces.reserve (pieceLengths.size());
 
-                storage[split->index] = createParagraph (std::move (leftSplitValue));
+                auto pieceStart = storage[split->index]->getText().getCharPointer();
 
+                for (const auto length : pieceLengths)
+                {
+                    auto pieceEnd = pieceStart;
+                    pieceEnd += (int) length;
+                    pieces.push_back (createParagraph (String (pieceStart, pieceEnd)));
+                    pieceStart = pieceEnd;
+                }
+
+                storage[split->index] = std::move (pieces.front());
                 storage.insert (iteratorWithAdvance (storage.begin(), split->index + 1),
-                                createParagraph (std::move (rightSplitValue)));
+                                std::make_move_iterator (std::next (pieces.begin())),
+                                std::make_move_iterator (pieces.end()));
             }
             else if (auto* erased = std::get_if<Ranges::Ops::Erase> (&op))
             {
+                firstChangedIndex = std::min (firstChangedIndex, (size_t) erased->range.getStart());
                 storage.erase (iteratorWithAdvance (storage.begin(), erased->range.getStart()),
                                iteratorWithAdvance (storage.begin(), erased->range.getEnd()));
             }
@@ -276,6 +419,8 @@ private:
                 if (oldRange.getLength() == newRange.getLength())
                     continue;
 
+                firstChangedIndex = std::min (firstChangedIndex, changed->index);
+
                 auto deltaStart = (int) (newRange.getStart() - oldRange.getStart());
                 auto deltaEnd   = (int) (newRange.getEnd() - oldRange.getEnd());
 
@@ -297,6 +442,8 @@ private:
             }
         }
 
+        invalidateLayoutFrom (firstChangedIndex);
+
         for (const auto [index, range] : enumerate (ranges, size_t{}))
             storage[index]->setRange (range);
     }
@@ -309,6 +456,10 @@ private:
     const TextEditorStorage& owner;
     detail::Ranges ranges;
     std::vector<std::unique_ptr<ParagraphStorage>> storage;
+    mutable std::vector<float> tops { 0.0f };
+    mutable std::vector<int64> startingGlyphs { 0 };
+    mutable std::vector<float> maxWidths { 0.0f };
+    mutable size_t numValidLayoutEntries = 1;
 };
 
 //==============================================================================
@@ -461,11 +612,23 @@ public:
         return paragraphs.getParagraphContainingCodepointIndex (index);
     }
 
+    size_t getNumParagraphs() const                         { return paragraphs.size(); }
+    auto getParagraph (size_t index) const                  { return paragraphs.getParagraph (index); }
+    float getTop (size_t index) const                       { return paragraphs.getTop (index); }
+    int64 getStartingGlyph (size_t index) const             { return paragraphs.getStartingGlyph (index); }
+    float getTotalHeight() const                            { return paragraphs.getTotalHeight(); }
+    float getMaxWidth() const                               { return paragraphs.getMaxWidth(); }
+    auto getIndicesInVerticalRange (float top, float bottom) const    { return paragraphs.getIndicesInVerticalRange (top, bottom); }
+    auto getIndexAtY (float y) const                        { return paragraphs.getIndexAtY (y); }
+    auto getIndexOf (const ParagraphStorage& p) const       { return paragraphs.getIndexOf (p); }
+
 private:
     void clearShapedTexts()
     {
         for (auto p : paragraphs)
             p.value->clearShapedText();
+
+        paragraphs.invalidateLayoutFrom (0);
     }
 
     detail::RangedValues<Font> fonts;
@@ -499,32 +662,16 @@ const detail::ShapedText& TextEditor::ParagraphStorage::getShapedText()
 
 float TextEditor::ParagraphStorage::getTop()
 {
-    float top = 0.0f;
-
-    for (const auto paragraphItem : storage)
-    {
-        if (paragraphItem.value.get() == this)
-            break;
-
-        top += paragraphItem.value->getHeight();
-    }
-
-    return top;
+    const auto index = storage.getIndexOf (*this);
+    jassert (index.has_value());
+    return index.has_value() ? storage.getTop (*index) : 0.0f;
 }
 
 int64 TextEditor::ParagraphStorage::getStartingGlyph()
 {
-    int64 startingGlyph = 0;
-
-    for (const auto paragraph : storage)
-    {
-        if (paragraph.value.get() == this)
-            break;
-
-        startingGlyph += paragraph.value->getNumGlyphs();
-    }
-
-    return startingGlyph;
+    const auto index = storage.getIndexOf (*this);
+    jassert (index.has_value());
+    return index.has_value() ? storage.getStartingGlyph (*index) : 0;
 }
 
 void TextEditor::ParagraphStorage::updatePasswordReplacementText()
@@ -565,6 +712,7 @@ void TextEditor::ParagraphStorage::clearShapedText()
 {
     shapedText.reset();
     height.reset();
+    width.reset();
     numGlyphs.reset();
     updatePasswordReplacementText();
 }
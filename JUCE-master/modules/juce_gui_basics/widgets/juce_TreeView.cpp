@@ -590,7 +590,7 @@ private:
 
     void handleAsyncUpdate() override
     {
-        owner.updateVisibleItems();
+        owner.updateChangedItems();
     }
 
     //==============================================================================
@@ -641,27 +641,25 @@ private:
                                                                                            : nextItem;
     }
 
-    template <typename Fn>
-    static void forEachDepthFirst (TreeViewItem* item, bool includeItem, Fn&& callback)
+    // Sub-items are laid out in order, so we can skip straight to the first one that reaches the
+    // visible area, and stop as soon as we pass it, without visiting any of the others
+    static void collectItemsInRange (TreeViewItem* item, bool includeItem, int top, int bottom,
+                                     std::vector<TreeViewItem*>& result)
     {
-        if (includeItem)
-            callback (item);
+        if (includeItem && item->y + item->itemHeight >= top && item->y <= bottom)
+            result.push_back (item);
 
-        if (item->isOpen())
-            for (auto i = 0; i < item->getNumSubItems(); ++i)
-                forEachDepthFirst (item->getSubItem (i), true, callback);
-    }
-
-    std::vector<TreeViewItem*> collectAllItems() const
-    {
-        size_t count{};
-        forEachDepthFirst (owner.rootItem, owner.rootItemVisible, [&] (auto*) { ++count; });
+        if (! item->isOpen())
+            return;
 
-        std::vector<TreeViewItem*> allItems;
-        allItems.reserve (count);
-        forEachDepthFirst (owner.rootItem, owner.rootItemVisible, [&] (auto* item) { allItems.push_back (item); });
+        auto& subItems = item->subItems;
+        auto iter = std::lower_bound (subItems.begin(), subItems.end(), top, [] (const TreeViewItem* i, int t)
+        {
+            return i->y + i->totalHeight < t;
+        });
 
-        return allItems;
+        for (; iter != subItems.end() && (*iter)->y <= bottom; ++iter)
+            collectItemsInRange (*iter, true, top, bottom, result);
     }
 
     std::vector<TreeViewItem*> getAllVisibleItems() const
@@ -671,27 +669,26 @@ private:
 
         const auto visibleTop = -getY();
         const auto visibleBottom = visibleTop + getParentHeight();
-        auto allItems = collectAllItems();
 
-        const auto lower = std::lower_bound (allItems.begin(), allItems.end(), visibleTop, [] (TreeViewItem* item, const auto y)
-        {
-            return item->y + item->getItemHeight() < y;
-        });
+        std::vector<TreeViewItem*> items;
+        collectItemsInRange (owner.rootItem, owner.rootItemVisible, visibleTop, visibleBottom, items);
 
-        const auto upper = std::upper_bound (allItems.begin(), allItems.end(), visibleBottom, [] (const auto y, TreeViewItem* item)
-        {
-            return y < item->y;
-        });
+        if (items.empty())
+            return items;
 
-        const std::ptrdiff_t padding = 2;
+        const int padding = 2;
+        const auto firstRow = items.front()->getRowNumberInTree();
+        const auto lastRow  = items.back()->getRowNumberInTree();
 
-        const auto frontToErase = std::max (padding, std::distance (allItems.begin(), lower)) - padding;
-        const auto backToErase  = std::max (padding, std::distance (upper, allItems.end()))   - padding;
+        for (int i = 1; i <= padding; ++i)
+            if (auto* item = owner.getItemOnRow (firstRow - i))
+                items.insert (items.begin(), item);
 
-        allItems.erase (allItems.begin(), std::next (allItems.begin(), frontToErase));
-        allItems.erase (std::prev (allItems.end(), backToErase), allItems.end());
+        for (int i = 1; i <= padding; ++i)
+            if (auto* item = owner.getItemOnRow (lastRow + i))
+                items.push_back (item);
 
-        return allItems;
+        return items;
     }
 
     //==============================================================================
@@ -994,6 +991,7 @@ void TreeView::setRootItem (TreeViewItem* const newRootItem)
             rootItem->setOwnerView (nullptr);
 
         rootItem = newRootItem;
+        ++layoutGeneration;
 
         if (newRootItem != nullptr)
             newRootItem->setOwnerView (this);
@@ -1039,6 +1037,7 @@ void TreeView::setIndentSize (const int newIndentSize)
     {
         indentSize = newIndentSize;
         resized();
+        updateVisibleItems();
     }
 }
 
@@ -1192,7 +1191,7 @@ void TreeView::paint (Graphics& g)
 void TreeView::resized()
 {
     viewport->setBounds (getLocalBounds());
-    updateVisibleItems();
+    updateChangedItems();
 }
 
 void TreeView::enablementChanged()
@@ -1245,7 +1244,7 @@ void TreeView::scrollToKeepItemVisible (const TreeViewItem* item)
 {
     if (item != nullptr && item->ownerView == this)
     {
-        updateVisibleItems();
+        updateChangedItems();
 
         item = item->getDeepestOpenParentItem();
 
@@ -1364,9 +1363,16 @@ bool TreeView::keyPressed (const KeyPress& key)
 
 void TreeView::updateVisibleItems (std::optional<Point<int>> viewportPosition)
 {
+    // Anything might have changed, so all the cached item layouts must be rebuilt
+    ++layoutGeneration;
     viewport->recalculatePositions (TreeViewport::Async::yes, std::move (viewportPosition));
 }
 
+void TreeView::updateChangedItems()
+{
+    viewport->recalculatePositions (TreeViewport::Async::yes, {});
+}
+
 //==============================================================================
 void TreeView::showDragHighlight (const InsertPoint& insertPos) noexcept
 {
@@ -1604,7 +1610,7 @@ void TreeViewItem::clearSubItems()
         if (! subItems.isEmpty())
         {
             removeAllSubItemsFromList();
-            treeHasChanged();
+            subtreeHasChanged();
         }
     }
     else
@@ -1635,7 +1641,7 @@ void TreeViewItem::addSubItem (TreeViewItem* const newItem, const int insertPosi
         if (ownerView != nullptr)
         {
             subItems.insert (insertPosition, newItem);
-            treeHasChanged();
+            subtreeHasChanged();
 
             if (newItem->isOpen())
                 newItem->itemOpennessChanged (true);
@@ -1655,7 +1661,7 @@ void TreeViewItem::removeSubItem (int index, bool deleteItem)
     if (ownerView != nullptr)
     {
         if (removeSubItemFromList (index, deleteItem))
-            treeHasChanged();
+            subtreeHasChanged();
     }
     else
     {
@@ -1689,7 +1695,7 @@ void TreeViewItem::setOpenness (Openness newOpenness)
 
     if (isNowOpen != wasOpen)
     {
-        treeHasChanged();
+        subtreeHasChanged();
         itemOpennessChanged (isNowOpen);
     }
 }
@@ -1873,6 +1879,23 @@ void TreeViewItem::treeHasChanged() const noexcept
         ownerView->updateVisibleItems();
 }
 
+void TreeViewItem::subtreeHasChanged()
+{
+    invalidateLayout();
+
+    if (ownerView != nullptr)
+        ownerView->updateChangedItems();
+}
+
+void TreeViewItem::invalidateLayout() noexcept
+{
+    for (auto* item = this; item != nullptr; item = item->parentItem)
+    {
+        item->numRows = -1;
+        item->layoutNeedsUpdate = true;
+    }
+}
+
 void TreeViewItem::repaintItem() const
 {
     if (ownerView != nullptr && areAllParentsOpen())
@@ -1888,6 +1911,18 @@ bool TreeViewItem::areAllParentsOpen() const noexcept
 
 void TreeViewItem::updatePositions (int newY)
 {
+    const auto generation = ownerView != nullptr ? ownerView->layoutGeneration : 0;
+
+    // If nothing inside this item has changed, its layout can only have moved
+    if (! layoutNeedsUpdate && positionsGeneration == generation)
+    {
+        moveBy (newY - y);
+        return;
+    }
+
+    layoutNeedsUpdate = false;
+    positionsGeneration = generation;
+
     y = newY;
     itemHeight = getItemHeight();
     totalHeight = itemHeight;
@@ -1908,6 +1943,18 @@ void TreeViewItem::updatePositions (int newY)
     }
 }
 
+void TreeViewItem::moveBy (int deltaY) noexcept
+{
+    if (deltaY == 0)
+        return;
+
+    y += deltaY;
+
+    if (isOpen())
+        for (auto* i : subItems)
+            i->moveBy (deltaY);
+}
+
 const TreeViewItem* TreeViewItem::getDeepestOpenParentItem() const noexcept
 {
     auto* result = this;
@@ -1927,6 +1974,8 @@ const TreeViewItem* TreeViewItem::getDeepestOpenParentItem() const noexcept
 void TreeViewItem::setOwnerView (TreeView* const newOwner) noexcept
 {
     ownerView = newOwner;
+    numRows = -1;
+    layoutNeedsUpdate = true;
 
     for (auto* i : subItems)
     {
@@ -1987,11 +2036,28 @@ TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
 
 int TreeViewItem::getNumRows() const noexcept
 {
+    if (ownerView != nullptr && numRows >= 0 && rowsGeneration == ownerView->layoutGeneration)
+        return numRows;
+
     int num = 1;
+    subItemRowOffsets.clear();
 
     if (isOpen())
+    {
+        subItemRowOffsets.reserve ((size_t) subItems.size());
+
         for (auto* i : subItems)
+        {
+            subItemRowOffsets.push_back (num - 1);
             num += i->getNumRows();
+        }
+    }
+
+    if (ownerView != nullptr)
+    {
+        numRows = num;
+        rowsGeneration = ownerView->layoutGeneration;
+    }
 
     return num;
 }
@@ -2001,22 +2067,16 @@ TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
     if (index == 0)
         return this;
 
-    if (index > 0 && isOpen())
+    if (index > 0 && isOpen() && index < getNumRows())
     {
+        // getNumRows() has filled in the first row of each sub-item, so we can binary-search them
         --index;
 
-        for (auto* i : subItems)
-        {
-            if (index == 0)
-                return i;
-
-            auto numRows = i->getNumRows();
+        const auto iter = std::upper_bound (subItemRowOffsets.begin(), subItemRowOffsets.end(), index);
+        const auto subIndex = (int) std::distance (subItemRowOffsets.begin(), iter) - 1;
 
-            if (numRows > index)
-                return i->getItemOnRow (index);
-
-            index -= numRows;
-        }
+        if (auto* item = subItems[subIndex])
+            return item->getItemOnRow (index - subItemRowOffsets[(size_t) subIndex]);
     }
 
     return nullptr;
@@ -2066,11 +2126,13 @@ int TreeViewItem::getRowNumberInTree() const noexcept
 
         auto n = 1 + parentItem->getRowNumberInTree();
 
-        auto ourIndex = parentItem->subItems.indexOf (this);
+        const auto ourIndex = parentItem->subItems.indexOf (this);
         jassert (ourIndex >= 0);
 
-        while (--ourIndex >= 0)
-            n += parentItem->subItems [ourIndex]->getNumRows();
+        parentItem->getNumRows();
+
+        if (isPositiveAndBelow (ourIndex, (int) parentItem->subItemRowOffsets.size()))
+            n += parentItem->subItemRowOffsets[(size_t) ourIndex];
 
         if (parentItem->parentItem == nullptr
              && ! ownerView->rootItemVisible)
@@ -619,6 +619,9 @@ private:
     friend class TreeView;
 
     void updatePositions (int);
+    void moveBy (int) noexcept;
+    void invalidateLayout() noexcept;
+    void subtreeHasChanged();
     int getIndentX() const noexcept;
     void setOwnerView (TreeView*) noexcept;
     TreeViewItem* getTopLevelItem() noexcept;
@@ -644,6 +647,14 @@ private:
 
     Openness openness = Openness::opennessDefault;
     int y = 0, itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0, uid = 0;
+
+    // Cached layout, invalidated either along the path to the root when this part of the tree
+    // changes, or all at once when the TreeView's layoutGeneration changes
+    mutable std::vector<int> subItemRowOffsets;
+    mutable int numRows = -1;
+    mutable uint32 rowsGeneration = 0;
+    uint32 positionsGeneration = 0;
+    bool layoutNeedsUpdate = true;
     bool selected = false, redrawNeeded = true, drawLinesInside = false, drawLinesSet = false,
          drawsInLeftMargin = false, drawsInRightMargin = false;
 
@@ -946,6 +957,7 @@ private:
 
     void itemsChanged() noexcept;
     void updateVisibleItems (std::optional<Point<int>> viewportPosition = {});
+    void updateChangedItems();
     void updateButtonUnderMouse (const MouseEvent&);
     void showDragHighlight (const InsertPoint&) noexcept;
     void hideDragHighlight() noexcept;
@@ -961,6 +973,7 @@ private:
     std::unique_ptr<InsertPointHighlight> dragInsertPointHighlight;
     std::unique_ptr<TargetGroupHighlight> dragTargetGroupHighlight;
     int indentSize = -1;
+    uint32 layoutGeneration = 1;
     bool defaultOpenness = false, rootItemVisible = true, multiSelectEnabled = false, openCloseButtonsVisible = true;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TreeView)
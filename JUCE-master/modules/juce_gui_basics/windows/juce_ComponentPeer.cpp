@@ -114,6 +114,9 @@ void ComponentPeer::handleMagnifyGesture (MouseInputSource::InputSourceType type
 //==============================================================================
 void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
 {
+    JUCE_RENDERING_METRICS_SCOPED_FRAME (getAvailableRenderingEngines()[getCurrentRenderingEngine()])
+    JUCE_SCOPED_TRACE ("ComponentPeer::handlePaint")
+
     Graphics g (contextToPaintTo);
 
     if (component.isTransformed())
@@ -614,7 +617,7 @@ ModifierKeys ComponentPeer::getCurrentModifiersRealtime() noexcept
 //==============================================================================
 void ComponentPeer::forceDisplayUpdate()
 {
-    Desktop::getInstance().displays->refresh();
+    Desktop::getInstance().refreshDisplays();
 }
 
 void ComponentPeer::callVBlankListeners (double timestampSec)
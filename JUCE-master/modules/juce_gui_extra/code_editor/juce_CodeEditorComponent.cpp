@@ -356,6 +356,203 @@ namespace CodeEditorHelpers
     }
 }
 
+//==============================================================================
+/*  Remembers, for each line of the document, where the tokeniser has to restart in order
+    to produce the tokens for that line, i.e. the start of the token that contains the
+    line's first character.
+
+    Lines before the first edited one stay valid after a change. Lines after it are kept
+    as stale entries, shifted to their new line numbers, and as soon as a rescan arrives at
+    one of them with an identical restart point past the edited text, the rest of the
+    cache is known to be correct again.
+
+    Long rescans are done in small time-sliced chunks on a timer, and the visible lines are
+    retokenised once the scan has caught up with them.
+*/
+class CodeEditorComponent::TokenStateCache final : private Timer
+{
+public:
+    explicit TokenStateCache (CodeEditorComponent& ed)
+        : owner (ed)
+    {
+        numLines = getNumLinesInDocument();
+        offsets.assign ((size_t) numLines, -1);
+        offsets[0] = 0;
+        scanInBackgroundIfNeeded();
+    }
+
+    void documentChanged (int start, int oldEnd, int newEnd)
+    {
+        const auto newNumLines = getNumLinesInDocument();
+        const auto lineDelta = newNumLines - numLines;
+        const auto editLine = CodeDocument::Position (owner.document, start).getLineNumber();
+        const auto firstShiftedLine = jmin ((size_t) editLine + 1, offsets.size());
+
+        if (lineDelta > 0)
+            offsets.insert (offsets.begin() + (ptrdiff_t) firstShiftedLine, (size_t) lineDelta, -1);
+        else if (lineDelta < 0)
+            offsets.erase (offsets.begin() + (ptrdiff_t) firstShiftedLine,
+                           offsets.begin() + (ptrdiff_t) jmin (firstShiftedLine + (size_t) -lineDelta, offsets.size()));
+
+        offsets.resize ((size_t) newNumLines, -1);
+
+        if (numKnown > editLine + 1)
+            numKnown = jmax (editLine + 1, numKnown + lineDelta);
+
+        numLines = newNumLines;
+        numKnown = jmin (numKnown, numLines);
+        numValid = jmin (numValid, numLines);
+
+        if (resyncPosition >= oldEnd)
+            resyncPosition += newEnd - oldEnd;
+        else if (resyncPosition > start)
+            resyncPosition = newEnd;
+
+        invalidate (editLine, newEnd);
+    }
+
+    void retokenise (int start, int end)
+    {
+        invalidate (CodeDocument::Position (owner.document, start).getLineNumber(), end);
+    }
+
+    /*  Returns an iterator positioned at the start of the token containing the first
+        character of the given line. If the cache is a long way behind, this just returns
+        the start of the line, and the editor is asked to retokenise once the background
+        scan has caught up.
+    */
+    CodeDocument::Iterator getIteratorForLine (int line)
+    {
+        if (owner.codeTokeniser == nullptr)
+            return CodeDocument::Iterator (owner.document);
+
+        line = jlimit (0, numLines - 1, line);
+
+        if (line >= numValid && line - numValid < maxLinesToScanSynchronously)
+            scan (line, std::numeric_limits<uint32>::max());
+
+        if (line >= numValid)
+        {
+            visibleLinesNeedUpdating = true;
+            scanInBackgroundIfNeeded();
+            return CodeDocument::Iterator (CodeDocument::Position (owner.document, line, 0));
+        }
+
+        return CodeDocument::Iterator (CodeDocument::Position (owner.document, getLineStart (line) - offsets[(size_t) line]));
+    }
+
+private:
+    static constexpr int maxLinesToScanSynchronously = 2000;
+    static constexpr int backgroundTimeSliceMs = 4;
+
+    CodeEditorComponent& owner;
+    std::vector<int> offsets;
+    int numLines = 0, numValid = 1, numKnown = 1, resyncPosition = 0;
+    bool visibleLinesNeedUpdating = false;
+
+    int getNumLinesInDocument() const
+    {
+        return jmax (1, owner.document.getNumLines());
+    }
+
+    int getLineStart (int line) const
+    {
+        return CodeDocument::Position (owner.document, line, 0).getPosition();
+    }
+
+    void invalidate (int firstChangedLine, int endOfChangedText)
+    {
+        if (numKnown <= numValid)
+        {
+            numKnown = numValid;
+            resyncPosition = 0;
+        }
+
+        // The restart point of the edited line itself is recalculated too, in case the
+        // tokeniser looked ahead into the changed text when ending the previous token.
+        numValid = jlimit (1, numValid, firstChangedLine);
+        resyncPosition = jmax (resyncPosition, endOfChangedText);
+
+        scanInBackgroundIfNeeded();
+    }
+
+    void scanInBackgroundIfNeeded()
+    {
+        if (owner.codeTokeniser != nullptr && numValid < numLines)
+        {
+            if (! isTimerRunning())
+                startTimer (10);
+        }
+        else
+        {
+            stopTimer();
+        }
+    }
+
+    void timerCallback() override
+    {
+        scan (numLines - 1, Time::getMillisecondCounter() + (uint32) backgroundTimeSliceMs);
+
+        if (visibleLinesNeedUpdating && numValid > owner.firstLineOnScreen)
+        {
+            visibleLinesNeedUpdating = false;
+            owner.rebuildLineTokensAsync();
+        }
+
+        scanInBackgroundIfNeeded();
+    }
+
+    // Extends the valid region to include lastLineNeeded, or until the deadline passes.
+    void scan (int lastLineNeeded, uint32 deadline)
+    {
+        auto& tokeniser = *owner.codeTokeniser;
+
+        while (numValid <= lastLineNeeded)
+        {
+            const auto resumeLine = numValid - 1;
+            CodeDocument::Iterator source (CodeDocument::Position (owner.document, getLineStart (resumeLine) - offsets[(size_t) resumeLine]));
+            auto nextLineStart = getLineStart (numValid);
+            auto resynced = false;
+
+            for (int numTokensRead = 1; numValid <= lastLineNeeded && ! resynced; ++numTokensRead)
+            {
+                const auto tokenStart = source.getPosition();
+                tokeniser.readNextToken (source);
+                const auto tokenEnd = source.getPosition();
+
+                if (tokenEnd <= tokenStart)
+                {
+                    // End of the document, or a tokeniser that has stopped making progress
+                    std::fill (offsets.begin() + numValid, offsets.end(), 0);
+                    numValid = numKnown = numLines;
+                    return;
+                }
+
+                while (nextLineStart < tokenEnd && numValid < numLines)
+                {
+                    const auto offset = nextLineStart - tokenStart;
+
+                    if (numValid < numKnown && tokenStart >= resyncPosition && offsets[(size_t) numValid] == offset)
+                    {
+                        numValid = numKnown;
+                        resynced = true;
+                        break;
+                    }
+
+                    offsets[(size_t) numValid++] = offset;
+                    numKnown = jmax (numKnown, numValid);
+                    nextLineStart = getLineStart (numValid);
+                }
+
+                if ((numTokensRead & 63) == 0 && Time::getMillisecondCounter() >= deadline)
+                    return;
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TokenStateCache)
+};
+
 //==============================================================================
 class CodeEditorComponent::Pimpl   : public Timer,
                                      public AsyncUpdater,
@@ -381,11 +578,13 @@ private:
 
     void codeDocumentTextInserted (const String& newText, int pos) override
     {
+        owner.tokenStateCache->documentChanged (pos, pos, pos + newText.length());
         owner.codeDocumentChanged (pos, pos + newText.length());
     }
 
     void codeDocumentTextDeleted (int start, int end) override
     {
+        owner.tokenStateCache->documentChanged (start, end, start);
         owner.codeDocumentChanged (start, end);
     }
 
@@ -452,6 +651,7 @@ CodeEditorComponent::CodeEditorComponent (CodeDocument& doc, CodeTokeniser* cons
       codeTokeniser (tokeniser)
 {
     pimpl.reset (new Pimpl (*this));
+    tokenStateCache = std::make_unique<TokenStateCache> (*this);
 
     caretPos.setPositionMaintained (true);
     selectionStart.setPositionMaintained (true);
@@ -498,7 +698,6 @@ int CodeEditorComponent::getGutterSize() const noexcept
 
 void CodeEditorComponent::loadContent (const String& newContent)
 {
-    clearCachedIterators (0);
     document.replaceAllContent (newContent);
     document.clearUndoHistory();
     document.setSavePoint();
@@ -639,8 +838,7 @@ void CodeEditorComponent::rebuildLineTokens()
 
     jassert (numNeeded == lines.size());
 
-    CodeDocument::Iterator source (document);
-    getIteratorForPosition (CodeDocument::Position (document, firstLineOnScreen, 0).getPosition(), source);
+    auto source = tokenStateCache->getIteratorForLine (firstLineOnScreen);
 
     for (int i = 0; i < numNeeded; ++i)
     {
@@ -665,7 +863,7 @@ void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int e
     const CodeDocument::Position affectedTextStart (document, startIndex);
     const CodeDocument::Position affectedTextEnd (document, endIndex);
 
-    retokenise (startIndex, endIndex);
+    rebuildLineTokensAsync();
 
     updateCaretPosition();
     columnToTryToMaintain = -1;
@@ -682,12 +880,9 @@ void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int e
     updateScrollBars();
 }
 
-void CodeEditorComponent::retokenise (int startIndex, [[maybe_unused]] int endIndex)
+void CodeEditorComponent::retokenise (int startIndex, int endIndex)
 {
-    const CodeDocument::Position affectedTextStart (document, startIndex);
-
-    clearCachedIterators (affectedTextStart.getLineNumber());
-
+    tokenStateCache->retokenise (startIndex, endIndex);
     rebuildLineTokensAsync();
 }
 
@@ -792,7 +987,6 @@ void CodeEditorComponent::scrollToLineInternal (int newFirstLineOnScreen)
         firstLineOnScreen = newFirstLineOnScreen;
         updateCaretPosition();
 
-        updateCachedIterators (firstLineOnScreen);
         rebuildLineTokensAsync();
         pimpl->handleUpdateNowIfNeeded();
 
@@ -1735,80 +1929,6 @@ Colour CodeEditorComponent::getColourForTokenType (const int tokenType) const
                 : findColour (CodeEditorComponent::defaultTextColourId);
 }
 
-void CodeEditorComponent::clearCachedIterators (const int firstLineToBeInvalid)
-{
-    int i;
-    for (i = cachedIterators.size(); --i >= 0;)
-        if (cachedIterators.getUnchecked (i).getLine() < firstLineToBeInvalid)
-            break;
-
-    cachedIterators.removeRange (jmax (0, i - 1), cachedIterators.size());
-}
-
-void CodeEditorComponent::updateCachedIterators (int maxLineNum)
-{
-    const int maxNumCachedPositions = 5000;
-    const int linesBetweenCachedSources = jmax (10, document.getNumLines() / maxNumCachedPositions);
-
-    if (cachedIterators.size() == 0)
-        cachedIterators.add (CodeDocument::Iterator (document));
-
-    if (codeTokeniser != nullptr)
-    {
-        for (;;)
-        {
-            const auto last = cachedIterators.getLast();
-
-            if (last.getLine() >= maxLineNum)
-                break;
-
-            cachedIterators.add (CodeDocument::Iterator (last));
-            auto& t = cachedIterators.getReference (cachedIterators.size() - 1);
-            const int targetLine = jmin (maxLineNum, last.getLine() + linesBetweenCachedSources);
-
-            for (;;)
-            {
-                codeTokeniser->readNextToken (t);
-
-                if (t.getLine() >= targetLine)
-                    break;
-
-                if (t.isEOF())
-                    return;
-            }
-        }
-    }
-}
-
-void CodeEditorComponent::getIteratorForPosition (int position, CodeDocument::Iterator& source)
-{
-    if (codeTokeniser != nullptr)
-    {
-        for (int i = cachedIterators.size(); --i >= 0;)
-        {
-            auto& t = cachedIterators.getReference (i);
-
-            if (t.getPosition() <= position)
-            {
-                source = t;
-                break;
-            }
-        }
-
-        while (source.getPosition() < position)
-        {
-            const CodeDocument::Iterator original (source);
-            codeTokeniser->readNextToken (source);
-
-            if (source.getPosition() > position || source.isEOF())
-            {
-                source = original;
-                break;
-            }
-        }
-    }
-}
-
 CodeEditorComponent::State::State (const CodeEditorComponent& editor)
     : lastTopLine (editor.getFirstLineOnScreen()),
       lastCaretPos (editor.getCaretPos().getPosition()),
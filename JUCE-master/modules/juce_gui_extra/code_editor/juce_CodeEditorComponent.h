@@ -456,10 +456,8 @@ private:
     void rebuildLineTokensAsync();
     void codeDocumentChanged (int start, int end);
 
-    Array<CodeDocument::Iterator> cachedIterators;
-    void clearCachedIterators (int firstLineToBeInvalid);
-    void updateCachedIterators (int maxLineNum);
-    void getIteratorForPosition (int position, CodeDocument::Iterator&);
+    class TokenStateCache;
+    std::unique_ptr<TokenStateCache> tokenStateCache;
 
     void moveLineDelta (int delta, bool selecting);
     int getGutterSize() const noexcept;
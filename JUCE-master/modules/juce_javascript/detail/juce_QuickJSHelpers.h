@@ -407,6 +407,65 @@ static VarOrError quickJSToJuce (const qjs::QuickJSContext::ValuePtr& ptr)
     }
 }
 
+//==============================================================================
+static qjs::JSValue createArrayBufferView (qjs::JSContext* ctx,
+                                           JSArrayBuffer::Ptr buffer,
+                                           JSArrayBuffer::ViewType viewType)
+{
+    using namespace qjs;
+
+    if (buffer == nullptr)
+        return JS_NULL;
+
+    // The size must be a whole number of elements
+    jassert (buffer->getSize() % juce::JSArrayBuffer::getElementSize (viewType) == 0);
+
+    // The ArrayBuffer holds a reference to the block, which it releases when it's garbage collected
+    const auto release = [] (JSRuntime*, void* opaque, void*)
+    {
+        static_cast<juce::JSArrayBuffer*> (opaque)->decReferenceCount();
+    };
+
+    buffer->incReferenceCount();
+
+    QuickJSContext::ValuePtr arrayBuffer { JS_NewArrayBuffer (ctx,
+                                                              static_cast<uint8_t*> (buffer->getData()),
+                                                              buffer->getSize(),
+                                                              release,
+                                                              buffer.get(),
+                                                              false),
+                                           ctx };
+
+    if (JS_IsException (arrayBuffer.get()))
+    {
+        buffer->decReferenceCount();
+        return arrayBuffer.release();
+    }
+
+    const auto* constructorName = [&]() -> const char*
+    {
+        switch (viewType)
+        {
+            case juce::JSArrayBuffer::ViewType::arrayBuffer:   return nullptr;
+            case juce::JSArrayBuffer::ViewType::uint8Array:    return "Uint8Array";
+            case juce::JSArrayBuffer::ViewType::int32Array:    return "Int32Array";
+            case juce::JSArrayBuffer::ViewType::float32Array:  return "Float32Array";
+            case juce::JSArrayBuffer::ViewType::float64Array:  return "Float64Array";
+        }
+
+        return nullptr;
+    }();
+
+    if (constructorName == nullptr)
+        return arrayBuffer.release();
+
+    QuickJSContext::ValuePtr global { JS_GetGlobalObject (ctx), ctx };
+    QuickJSContext::ValuePtr constructor { JS_GetPropertyStr (ctx, global.get(), constructorName), ctx };
+    auto argument = arrayBuffer.get();
+
+    return JS_CallConstructor (ctx, constructor.get(), 1, &argument);
+}
+
 //==============================================================================
 // Any type that references the QuickJS types inside the anonymous namespace added by us requires
 // this with GCC. Suppressing this warning is fine, since these classes are only visible and used
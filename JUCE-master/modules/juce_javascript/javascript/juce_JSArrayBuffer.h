@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+/**
+    A block of memory that C++ and Javascript code can both access directly.
+
+    Use JSObject::setArrayBuffer() or JSCursor::setArrayBuffer() to make the memory visible to
+    scripts as an ArrayBuffer, or as a typed array view such as a Float32Array. Nothing is
+    copied, so anything that C++ code writes into the block can be read by the script straight
+    away, and vice versa. This is much cheaper than passing arrays of numbers through var
+    objects, which converts every element.
+
+    The block is reference-counted, and each ArrayBuffer created from it holds a reference, so
+    the memory stays valid for as long as either side is still using it.
+
+    The engine doesn't do any locking, so if you write to the block on one thread while a script
+    reads it on another, it's up to you to synchronise the two.
+
+    @code
+    JSArrayBuffer::Ptr meterData = new JSArrayBuffer (numBins * sizeof (float));
+    engine.getRootObject().setArrayBuffer ("meter", meterData, JSArrayBuffer::ViewType::float32Array);
+
+    // later, for each frame
+    std::copy (levels.begin(), levels.end(), meterData->getSpan<float>().begin());
+    engine.callFunction ("drawMeter", {});
+    @endcode
+
+    @tags{Core}
+*/
+class JUCE_API  JSArrayBuffer  : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<JSArrayBuffer>;
+
+    /** The kind of Javascript object used to access the memory. */
+    enum class ViewType
+    {
+        arrayBuffer,
+        uint8Array,
+        int32Array,
+        float32Array,
+        float64Array
+    };
+
+    /** Creates a zero-initialised block of the given size in bytes. */
+    explicit JSArrayBuffer (size_t numBytes)
+        : data (jmax ((size_t) 1, numBytes), true),
+          size (numBytes)
+    {
+    }
+
+    /** Returns a pointer to the start of the memory. */
+    void* getData() const noexcept              { return data.get(); }
+
+    /** Returns the size of the memory in bytes. */
+    size_t getSize() const noexcept             { return size; }
+
+    /** Returns the memory as a span of elements of the given type. */
+    template <typename ElementType>
+    Span<ElementType> getSpan() const noexcept  { return { reinterpret_cast<ElementType*> (data.get()), size / sizeof (ElementType) }; }
+
+    /** Returns the size in bytes of a single element of the given view type. */
+    static size_t getElementSize (ViewType type) noexcept
+    {
+        switch (type)
+        {
+            case ViewType::arrayBuffer:
+            case ViewType::uint8Array:    return 1;
+            case ViewType::int32Array:
+            case ViewType::float32Array:  return 4;
+            case ViewType::float64Array:  return 8;
+        }
+
+        return 1;
+    }
+
+private:
+    HeapBlock<char> data;
+    size_t size;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JSArrayBuffer)
+};
+
+} // namespace juce
@@ -78,6 +78,27 @@ void JSCursor::set (const var& value) const
     }
 }
 
+void JSCursor::setArrayBuffer (JSArrayBuffer::Ptr buffer, JSArrayBuffer::ViewType viewType) const
+{
+    const auto resolved = getPartialResolution();
+
+    if (! resolved.has_value())
+    {
+        jassertfalse;  // Can't resolve an Object to change along the path stored in the cursor
+        return;
+    }
+
+    const auto& [object, property] = *resolved;
+
+    if (! property.has_value())
+    {
+        jassertfalse;  // Can't set the value of the root Object
+        return;
+    }
+
+    std::visit ([&, &o = object] (const auto& prop) { o.setArrayBuffer (prop, buffer, viewType); }, *property);
+}
+
 JSCursor JSCursor::getChild (const Identifier& name) const
 {
     auto copy = *this;
@@ -107,6 +107,16 @@ public:
     */
     void set (const var& value) const;
 
+    /** Sets the Object under the cursor's location to an ArrayBuffer or typed array that gives
+        the script direct access to the memory of a JSArrayBuffer.
+
+        You must only call this function for valid cursors.
+
+        @see JSObject::setArrayBuffer, isValid
+    */
+    void setArrayBuffer (JSArrayBuffer::Ptr buffer,
+                         JSArrayBuffer::ViewType viewType = JSArrayBuffer::ViewType::float32Array) const;
+
     /** Invokes this node as though it were a method. If the optional Result pointer is provided it
         will contain Result::ok() in case of success, or an error message in case an exception was
         thrown during evaluation.
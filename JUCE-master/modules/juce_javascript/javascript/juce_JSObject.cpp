@@ -87,6 +87,26 @@ public:
         detail::qjs::JS_SetPropertyInt64 (ctx, valuePtr.get(), index, detail::juceToQuickJs (value, ctx));
     }
 
+    void setArrayBuffer (const Identifier& name, JSArrayBuffer::Ptr buffer, JSArrayBuffer::ViewType viewType) const
+    {
+        // Creating a typed array calls its JS constructor, which is subject to the timeout
+        engine->resetTimeout();
+
+        auto* ctx = engine->getQuickJSContext();
+
+        detail::qjs::JS_SetPropertyStr (ctx, valuePtr.get(), name.toString().toRawUTF8(), detail::createArrayBufferView (ctx, buffer, viewType));
+    }
+
+    void setArrayBuffer (int64 index, JSArrayBuffer::Ptr buffer, JSArrayBuffer::ViewType viewType) const
+    {
+        // Creating a typed array calls its JS constructor, which is subject to the timeout
+        engine->resetTimeout();
+
+        auto* ctx = engine->getQuickJSContext();
+
+        detail::qjs::JS_SetPropertyInt64 (ctx, valuePtr.get(), index, detail::createArrayBufferView (ctx, buffer, viewType));
+    }
+
     var get() const
     {
         if (auto* opaque = detail::qjs::JS_GetOpaque (valuePtr.get(), detail::DynamicObjectWrapper::getClassId()))
@@ -258,6 +278,16 @@ void JSObject::setProperty (int64 index, const var& value) const
     impl->setProperty (index, value);
 }
 
+void JSObject::setArrayBuffer (const Identifier& name, JSArrayBuffer::Ptr buffer, JSArrayBuffer::ViewType viewType) const
+{
+    impl->setArrayBuffer (name, std::move (buffer), viewType);
+}
+
+void JSObject::setArrayBuffer (int64 index, JSArrayBuffer::Ptr buffer, JSArrayBuffer::ViewType viewType) const
+{
+    impl->setArrayBuffer (index, std::move (buffer), viewType);
+}
+
 var JSObject::invokeMethod (const Identifier& methodName,
                             Span<const var> args,
                             Result* result) const
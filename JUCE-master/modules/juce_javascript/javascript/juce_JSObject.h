@@ -145,6 +145,24 @@ public:
     */
     void setProperty (int64 index, const var& value) const;
 
+    /** Adds a named property that gives the script direct access to the memory of a
+        JSArrayBuffer, or replaces an existing property with this name.
+
+        The property is an ArrayBuffer, or a typed array that views the whole buffer, depending
+        on the view type. The size of the buffer must be a multiple of the view's element size.
+        No data is copied, and the buffer is kept alive for as long as the script references it.
+    */
+    void setArrayBuffer (const Identifier& name,
+                         JSArrayBuffer::Ptr buffer,
+                         JSArrayBuffer::ViewType viewType = JSArrayBuffer::ViewType::float32Array) const;
+
+    /** Like setArrayBuffer (const Identifier&, JSArrayBuffer::Ptr, JSArrayBuffer::ViewType), but
+        assigns an element of the underlying Array.
+    */
+    void setArrayBuffer (int64 index,
+                         JSArrayBuffer::Ptr buffer,
+                         JSArrayBuffer::ViewType viewType = JSArrayBuffer::ViewType::float32Array) const;
+
     /** Invokes this node as though it were a method.
 
         If the optional Result pointer is provided it will contain Result::ok() in case of success,
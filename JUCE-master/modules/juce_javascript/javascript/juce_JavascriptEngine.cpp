@@ -35,6 +35,86 @@
 namespace juce
 {
 
+//==============================================================================
+/*  Holds the bytecode compiled by executeCached(), so that engines running the same source
+    can skip compilation. Each engine has its own QuickJS runtime, so the compiled functions
+    themselves can't be shared, but reading bytecode is much faster than parsing.
+*/
+class BytecodeCache
+{
+public:
+    static BytecodeCache& getInstance()
+    {
+        static BytecodeCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const MemoryBlock> find (const String& key) const
+    {
+        const ScopedLock sl (lock);
+        const auto it = entries.find (key);
+        return it != entries.end() ? it->second : nullptr;
+    }
+
+    std::shared_ptr<const MemoryBlock> insert (const String& key, MemoryBlock bytecode)
+    {
+        const ScopedLock sl (lock);
+        auto& entry = entries[key];
+
+        if (entry == nullptr)
+            entry = std::make_shared<const MemoryBlock> (std::move (bytecode));
+
+        return entry;
+    }
+
+    static std::optional<MemoryBlock> readFile (const File& file)
+    {
+        if (! file.existsAsFile())
+            return {};
+
+        MemoryBlock contents;
+
+        if (! file.loadFileAsData (contents))
+            return {};
+
+        const auto header = getHeader();
+
+        if (contents.getSize() <= header.getSize()
+            || std::memcmp (contents.getData(), header.getData(), header.getSize()) != 0)
+            return {};
+
+        contents.removeSection (0, header.getSize());
+        return contents;
+    }
+
+    static void writeFile (const File& file, const MemoryBlock& bytecode)
+    {
+        if (file == File())
+            return;
+
+        // Writing to a temporary file first stops other processes from reading a partial file
+        TemporaryFile temp (file);
+        auto data = getHeader();
+        data.append (bytecode.getData(), bytecode.getSize());
+
+        if (temp.getFile().replaceWithData (data.getData(), data.getSize()))
+            temp.overwriteTargetFileWithTemporary();
+    }
+
+private:
+    BytecodeCache() = default;
+
+    // Bytecode written by one version of QuickJS can't be read by another
+    static MemoryBlock getHeader()
+    {
+        const String header = "JUCE QuickJS bytecode " CONFIG_VERSION " " + String ((int) sizeof (void*)) + "\n";
+        return { header.toRawUTF8(), header.getNumBytesAsUTF8() };
+    }
+
+    CriticalSection lock;
+    std::map<String, std::shared_ptr<const MemoryBlock>> entries;
+};
+
 //==============================================================================
 class JavascriptEngine::Impl
 {
@@ -144,6 +224,95 @@ public:
         return result;
     }
 
+    MemoryBlock compile (const String& code, Result* errorMessage)
+    {
+        using namespace detail::qjs;
+
+        engine->resetTimeout();
+
+        if (errorMessage != nullptr)
+            *errorMessage = Result::ok();
+
+        auto* ctx = engine->getQuickJSContext();
+        const ValuePtr function { JS_Eval (ctx,
+                                           code.toRawUTF8(),
+                                           code.getNumBytesAsUTF8(),
+                                           "",
+                                           JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY),
+                                  ctx };
+
+        if (JS_IsException (function.get()))
+        {
+            const auto error = detail::quickJSToJuce (function);
+
+            if (auto* e = std::get_if<String> (&error))
+                if (errorMessage != nullptr)
+                    *errorMessage = Result::fail (*e);
+
+            return {};
+        }
+
+        size_t size = 0;
+        auto* data = JS_WriteObject (ctx, &size, function.get(), JS_WRITE_OBJ_BYTECODE);
+
+        if (data == nullptr)
+        {
+            if (errorMessage != nullptr)
+                *errorMessage = Result::fail ("Couldn't serialise the compiled code");
+
+            return {};
+        }
+
+        MemoryBlock bytecode { data, size };
+        js_free (ctx, data);
+        return bytecode;
+    }
+
+    Result executeBytecode (const MemoryBlock& bytecode)
+    {
+        using namespace detail::qjs;
+
+        engine->resetTimeout();
+
+        if (bytecode.isEmpty())
+            return Result::fail ("No bytecode to execute");
+
+        auto* ctx = engine->getQuickJSContext();
+        auto function = JS_ReadObject (ctx, static_cast<const uint8_t*> (bytecode.getData()), bytecode.getSize(), JS_READ_OBJ_BYTECODE);
+
+        // JS_EvalFunction takes ownership of the function, and returns an exception if reading failed
+        const auto result = detail::quickJSToJuce ({ JS_IsException (function) ? function : JS_EvalFunction (ctx, function), ctx });
+
+        if (auto* e = std::get_if<String> (&result))
+            return Result::fail (*e);
+
+        return Result::ok();
+    }
+
+    Result executeCached (const String& code, const File& cacheDirectory)
+    {
+        const auto key = String::toHexString (code.hashCode64()) + "_" + String::toHexString ((int64) code.getNumBytesAsUTF8());
+        auto& cache = BytecodeCache::getInstance();
+
+        if (auto bytecode = cache.find (key))
+            return executeBytecode (*bytecode);
+
+        const auto cacheFile = cacheDirectory.isDirectory() ? cacheDirectory.getChildFile (key + ".qjsbc")
+                                                            : File();
+
+        if (auto bytecode = BytecodeCache::readFile (cacheFile))
+            return executeBytecode (*cache.insert (key, std::move (*bytecode)));
+
+        auto result = Result::ok();
+        auto bytecode = compile (code, &result);
+
+        if (result.failed())
+            return result;
+
+        BytecodeCache::writeFile (cacheFile, bytecode);
+        return executeBytecode (*cache.insert (key, std::move (bytecode)));
+    }
+
     var callFunction (const Identifier& function,
                       const var::NativeFunctionArgs& args,
                       Result* errorMessage)
@@ -222,6 +391,21 @@ var JavascriptEngine::callFunction (const Identifier& function,
     return impl->callFunction (function, args, errorMessage);
 }
 
+MemoryBlock JavascriptEngine::compile (const String& javascriptCode, Result* errorMessage)
+{
+    return impl->compile (javascriptCode, errorMessage);
+}
+
+Result JavascriptEngine::executeBytecode (const MemoryBlock& bytecode)
+{
+    return impl->executeBytecode (bytecode);
+}
+
+Result JavascriptEngine::executeCached (const String& javascriptCode, const File& cacheDirectory)
+{
+    return impl->executeCached (javascriptCode, cacheDirectory);
+}
+
 void JavascriptEngine::stop() noexcept
 {
     impl->stop();
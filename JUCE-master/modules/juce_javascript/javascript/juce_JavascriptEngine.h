@@ -78,6 +78,45 @@ public:
     var evaluate (const String& javascriptCode,
                   Result* errorMessage = nullptr);
 
+    //==============================================================================
+    /** Compiles a block of javascript code into QuickJS bytecode, without running it.
+
+        The bytecode can be passed to executeBytecode() on this or any other engine, which
+        skips parsing the source again. If there's a syntax error, an empty block is returned
+        and the error description is written to errorMessage.
+
+        Bytecode is only valid for the version of QuickJS that produced it, so don't ship it
+        with your app or share it between builds.
+
+        @see executeBytecode, executeCached
+    */
+    MemoryBlock compile (const String& javascriptCode,
+                         Result* errorMessage = nullptr);
+
+    /** Runs bytecode that was created by compile().
+
+        This behaves just like execute(), but QuickJS doesn't validate bytecode, so it must
+        only ever come from a trusted source.
+    */
+    Result executeBytecode (const MemoryBlock& bytecode);
+
+    /** Runs a block of javascript code, reusing bytecode that was compiled for the same
+        source before.
+
+        The bytecode is kept in memory, shared by all the engines in the process, so several
+        engines that load the same script will only compile it once. If cacheDirectory is a
+        valid directory, the bytecode is also stored there in a file named after a hash of
+        the source, so that it can be reused by later runs of the app. Files written by a
+        different version of QuickJS are ignored and replaced.
+
+        The cache directory must not be writable by anyone you don't trust, because its
+        contents are run without being validated.
+
+        @see compile, executeBytecode
+    */
+    Result executeCached (const String& javascriptCode,
+                          const File& cacheDirectory = {});
+
     /** Calls a function in the root namespace, and returns the result.
         The function arguments are passed in the same format as used by native
         methods in the var class.
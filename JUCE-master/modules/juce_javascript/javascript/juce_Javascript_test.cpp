@@ -447,6 +447,82 @@ public:
 
             expect (numCalls == 2);
         }
+
+        beginTest ("Typed arrays share memory with JSArrayBuffer objects");
+        {
+            JSArrayBuffer::Ptr buffer = new JSArrayBuffer (4 * sizeof (float));
+            const auto reference = buffer;
+
+            {
+                JavascriptEngine temporaryEngine;
+                temporaryEngine.getRootObject().setArrayBuffer ("samples", buffer);
+                JSCursor { temporaryEngine.getRootObject() }["bytes"].setArrayBuffer (buffer, JSArrayBuffer::ViewType::uint8Array);
+
+                expect (temporaryEngine.evaluate ("samples instanceof Float32Array && samples.length === 4") == var { true });
+                expect (temporaryEngine.evaluate ("bytes.length") == var { 16 });
+
+                buffer->getSpan<float>()[2] = 0.5f;
+                expect (temporaryEngine.evaluate ("samples[2]") == var { 0.5 });
+
+                expect (temporaryEngine.execute ("samples[3] = -1.25;").wasOk());
+                expectEquals (buffer->getSpan<float>()[3], -1.25f);
+
+                buffer = nullptr;
+                expect (temporaryEngine.evaluate ("samples[2]") == var { 0.5 });
+                // One reference for each ArrayBuffer created by the engine
+                expectEquals (reference->getReferenceCount(), 3);
+            }
+
+            expectEquals (reference->getReferenceCount(), 1);
+        }
+
+        beginTest ("Compiled bytecode can be run by other engines");
+        {
+            auto result = Result::fail ("");
+            const auto bytecode = JavascriptEngine{}.compile ("var compiled = [1, 2, 3].map (x => x * 2);", &result);
+            expect (result.wasOk());
+            expect (! bytecode.isEmpty());
+
+            for (int i = 0; i < 2; ++i)
+            {
+                JavascriptEngine temporaryEngine;
+                expect (temporaryEngine.executeBytecode (bytecode).wasOk());
+                expect (temporaryEngine.evaluate ("compiled[2]") == var { 6 });
+            }
+        }
+
+        beginTest ("Syntax errors are reported when compiling");
+        {
+            auto result = Result::ok();
+            expect (JavascriptEngine{}.compile ("var = ;", &result).isEmpty());
+            expect (result.failed());
+            expect (JavascriptEngine{}.executeBytecode ({}).failed());
+        }
+
+        beginTest ("Cached bytecode is stored on disk and reused");
+        {
+            const TemporaryFile tempDirectory;
+            const auto directory = tempDirectory.getFile();
+            expect (directory.createDirectory().wasOk());
+
+            const auto source = "var cached = 'cached ' + " + String (Random::getSystemRandom().nextInt()) + ";";
+
+            JavascriptEngine first;
+            expect (first.executeCached (source, directory).wasOk());
+            expectEquals (directory.getNumberOfChildFiles (File::findFiles), 1);
+
+            const auto cacheFile = directory.findChildFiles (File::findFiles, false)[0];
+            expect (cacheFile.getSize() > 0);
+
+            JavascriptEngine second;
+            expect (second.executeCached (source, directory).wasOk());
+            expectEquals (second.evaluate ("cached").toString(), first.evaluate ("cached").toString());
+
+            expect (first.executeCached ("var = ;", directory).failed());
+            expectEquals (directory.getNumberOfChildFiles (File::findFiles), 1);
+
+            directory.deleteRecursively();
+        }
     }
 };
 
@@ -63,6 +63,7 @@
 
 #include <juce_core/juce_core.h>
 
+#include "javascript/juce_JSArrayBuffer.h"
 #include "javascript/juce_JSObject.h"
 #include "javascript/juce_JSCursor.h"
 #include "javascript/juce_JavascriptEngine.h"
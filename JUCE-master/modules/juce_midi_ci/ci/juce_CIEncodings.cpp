@@ -151,47 +151,95 @@ std::vector<std::byte> Encodings::stringTo7BitText (const String& text)
 std::vector<std::byte> Encodings::toMcoded7 (Span<const std::byte> bytes)
 {
     std::vector<std::byte> result;
-    result.reserve ((bytes.size() * 8) + 6 / 7);
+    toMcoded7 (bytes, result);
+    return result;
+}
+
+std::vector<std::byte> Encodings::fromMcoded7 (Span<const std::byte> bytes)
+{
+    std::vector<std::byte> result;
+    fromMcoded7 (bytes, result);
+    return result;
+}
+
+void Encodings::toMcoded7 (Span<const std::byte> bytes, std::vector<std::byte>& destination)
+{
+    const auto numFullGroups = bytes.size() / 7;
+    const auto remainder = bytes.size() % 7;
+    const auto start = destination.size();
+
+    // Resizing once up-front lets us write the groups directly, without any reallocation
+    destination.resize (start + numFullGroups * 8 + (remainder != 0 ? remainder + 1 : 0));
+
+    auto* out = destination.data() + start;
 
     for (size_t index = 0; index < bytes.size(); index += 7)
     {
-        std::array<std::byte, 7> slice{};
         const auto sliceSize = std::min ((size_t) 7, bytes.size() - index);
-        std::copy (bytes.begin() + index, bytes.begin() + index + sliceSize, slice.begin());
-
-        result.push_back ((slice[0] & std::byte { 0x80 }) >> 1
-                        | (slice[1] & std::byte { 0x80 }) >> 2
-                        | (slice[2] & std::byte { 0x80 }) >> 3
-                        | (slice[3] & std::byte { 0x80 }) >> 4
-                        | (slice[4] & std::byte { 0x80 }) >> 5
-                        | (slice[5] & std::byte { 0x80 }) >> 6
-                        | (slice[6] & std::byte { 0x80 }) >> 7);
-        std::transform (slice.begin(),
-                        std::next (slice.begin(), (ptrdiff_t) sliceSize),
-                        std::back_inserter (result),
-                        [] (const std::byte b) { return b & std::byte { 0x7f }; });
-    }
+        std::byte highBits{};
 
-    return result;
+        for (size_t i = 0; i < sliceSize; ++i)
+        {
+            const auto b = bytes[index + i];
+            highBits |= (b & std::byte { 0x80 }) >> (i + 1);
+            out[i + 1] = b & std::byte { 0x7f };
+        }
+
+        out[0] = highBits;
+        out += sliceSize + 1;
+    }
 }
 
-std::vector<std::byte> Encodings::fromMcoded7 (Span<const std::byte> bytes)
+void Encodings::fromMcoded7 (Span<const std::byte> bytes, std::vector<std::byte>& destination)
 {
-    std::vector<std::byte> result;
-    result.reserve ((bytes.size() * 7) + 7 / 8);
+    const auto numFullGroups = bytes.size() / 8;
+    const auto remainder = bytes.size() % 8;
+    const auto start = destination.size();
+
+    destination.resize (start + numFullGroups * 7 + (remainder != 0 ? remainder - 1 : 0));
+
+    auto* out = destination.data() + start;
 
     for (size_t index = 0; index < bytes.size(); index += 8)
     {
         const auto sliceSize = std::min ((size_t) 7, bytes.size() - index - 1);
+        const auto highBits = bytes[index];
 
         for (size_t i = 0; i < sliceSize; ++i)
+            out[i] = ((highBits << (i + 1)) & std::byte { 0x80 }) | bytes[index + 1 + i];
+
+        out += sliceSize;
+    }
+}
+
+std::optional<std::vector<std::byte>> Encodings::decompress (Span<const std::byte> bytes)
+{
+    MemoryInputStream memoryStream (bytes.data(), bytes.size(), false);
+    GZIPDecompressorInputStream zipStream (memoryStream);
+
+    const size_t chunkSize = 1 << 12;
+
+    std::vector<std::byte> result;
+    result.reserve (bytes.size() * 4);
+
+    for (;;)
+    {
+        const auto previousSize = result.size();
+        result.resize (previousSize + chunkSize);
+        const auto read = zipStream.read (result.data() + previousSize, chunkSize);
+
+        if (read < 0)
         {
-            const auto highBit = (bytes[index] & std::byte { (uint8_t) (1 << (6 - i)) }) << (i + 1);
-            result.push_back (highBit | bytes[index + 1 + i]);
+            // Decompression failed!
+            jassertfalse;
+            return {};
         }
-    }
 
-    return result;
+        result.resize ((size_t) read + previousSize);
+
+        if (read == 0)
+            return result;
+    }
 }
 
 std::optional<std::vector<std::byte>> Encodings::tryEncode (Span<const std::byte> bytes, Encoding mutualEncoding)
@@ -236,35 +284,7 @@ std::vector<std::byte> Encodings::decode (Span<const std::byte> bytes, Encoding
         return fromMcoded7 (bytes);
 
     if (mutualEncoding == Encoding::zlibAndMcoded7)
-    {
-        const auto mcoded = fromMcoded7 (bytes);
-        MemoryInputStream memoryStream (mcoded.data(), mcoded.size(), false);
-
-        GZIPDecompressorInputStream zipStream (memoryStream);
-
-        const size_t chunkSize = 1 << 8;
-
-        std::vector<std::byte> result;
-
-        for (;;)
-        {
-            const auto previousSize = result.size();
-            result.resize (previousSize + chunkSize);
-            const auto read = zipStream.read (result.data() + previousSize, chunkSize);
-
-            if (read < 0)
-            {
-                // Decompression failed!
-                jassertfalse;
-                return {};
-            }
-
-            result.resize ((size_t) read + previousSize);
-
-            if (read == 0)
-                return result;
-        }
-    }
+        return decompress (fromMcoded7 (bytes)).value_or (std::vector<std::byte>{});
 
     // Unknown encoding!
     jassertfalse;
@@ -355,6 +375,43 @@ public:
                 expect (rangesEqual (converted, expected));
             }
         }
+
+        beginTest ("Mcoded7 data can be encoded and decoded incrementally");
+        {
+            Random random;
+            std::vector<std::byte> input (1000);
+            std::generate (input.begin(), input.end(), [&] { return (std::byte) random.nextInt (256); });
+
+            const auto encoded = Encodings::toMcoded7 (input);
+            expectEquals ((int) encoded.size(), 1143);
+
+            std::vector<std::byte> incrementallyEncoded;
+
+            for (size_t i = 0; i < input.size(); i += 70)
+                Encodings::toMcoded7 (Span (input.data() + i, std::min ((size_t) 70, input.size() - i)), incrementallyEncoded);
+
+            expect (rangesEqual (encoded, incrementallyEncoded));
+
+            std::vector<std::byte> decoded;
+
+            for (size_t i = 0; i < encoded.size(); i += 64)
+                Encodings::fromMcoded7 (Span (encoded.data() + i, std::min ((size_t) 64, encoded.size() - i)), decoded);
+
+            expect (rangesEqual (decoded, input));
+        }
+
+        beginTest ("zlib round trip");
+        {
+            std::vector<std::byte> input (20000);
+
+            for (size_t i = 0; i < input.size(); ++i)
+                input[i] = (std::byte) ((i * 7) % 0x7f);
+
+            const auto encoded = Encodings::tryEncode (input, Encoding::zlibAndMcoded7);
+            expect (encoded.has_value());
+            expect (encoded->size() < input.size());
+            expect (rangesEqual (Encodings::decode (*encoded, Encoding::zlibAndMcoded7), input));
+        }
     }
 
 private:
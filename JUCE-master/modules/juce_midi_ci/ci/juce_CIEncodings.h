@@ -75,6 +75,29 @@ struct Encodings
     */
     static std::vector<std::byte> fromMcoded7 (Span<const std::byte> bytes);
 
+    /** Appends the Mcoded7 encoding of the provided bytes to the destination vector.
+
+        This allows a single buffer to be reused for several messages. The bytes are encoded
+        in groups of seven, so when encoding a long stream in several calls, every call apart
+        from the last should supply a multiple of seven bytes.
+    */
+    static void toMcoded7 (Span<const std::byte> bytes, std::vector<std::byte>& destination);
+
+    /** Appends the bytes decoded from the provided Mcoded7 data to the destination vector.
+
+        This allows a stream to be decoded incrementally as it arrives, e.g. one message chunk
+        at a time. The data is decoded in groups of eight bytes, so every call apart from the
+        last should supply a multiple of eight bytes.
+    */
+    static void fromMcoded7 (Span<const std::byte> bytes, std::vector<std::byte>& destination);
+
+    /** Decompresses zlib data, such as the result of decoding the Mcoded7 payload of a message
+        that uses the zlibAndMcoded7 encoding.
+
+        Returns nullopt if the data couldn't be decompressed.
+    */
+    static std::optional<std::vector<std::byte>> decompress (Span<const std::byte> bytes);
+
     /** Attempts to encode the provided byte span using the specified encoding.
 
         The ASCII encoding does not make any changes to the input stream, but
@@ -35,10 +35,54 @@
 namespace juce::midi_ci
 {
 
+/*  Keeps hold of the storage used by finished transactions, so that the next transactions can
+    reuse it instead of growing new buffers chunk by chunk.
+*/
+class PropertyExchangeBufferPool
+{
+public:
+    std::vector<std::byte> take()
+    {
+        if (buffers.empty())
+            return {};
+
+        auto result = std::move (buffers.back());
+        buffers.pop_back();
+        return result;
+    }
+
+    void give (std::vector<std::byte>&& buffer)
+    {
+        if (buffers.size() >= maxNumBuffers || buffer.capacity() == 0 || buffer.capacity() > maxCapacity)
+            return;
+
+        buffer.clear();
+        buffers.push_back (std::move (buffer));
+    }
+
+private:
+    // Large enough for a few simultaneous patch dumps, without holding on to huge one-off buffers
+    static constexpr size_t maxNumBuffers = 8, maxCapacity = 1 << 22;
+
+    std::vector<std::vector<std::byte>> buffers;
+};
+
+//==============================================================================
 class PropertyExchangeCache
 {
 public:
-    PropertyExchangeCache() = default;
+    explicit PropertyExchangeCache (PropertyExchangeBufferPool& poolIn)
+        : pool (poolIn),
+          bodyStorage (pool.take()),
+          encodedStorage (pool.take())
+    {
+    }
+
+    ~PropertyExchangeCache()
+    {
+        pool.give (std::move (bodyStorage));
+        pool.give (std::move (encodedStorage));
+    }
 
     struct OwningResult
     {
@@ -67,7 +111,14 @@ public:
                         chunk.header.end(),
                         std::back_inserter (headerStorage),
                         [] (std::byte b) { return char (b); });
-        bodyStorage.insert (bodyStorage.end(), chunk.data.begin(), chunk.data.end());
+
+        // The header must fit in the first chunk, so the encoding is normally known from then on,
+        // and the body can be decoded as it arrives rather than all at once at the end.
+        if (! encoding.has_value() && ! chunk.header.empty())
+            if (const auto json = JSON::parse (String (headerStorage.data(), headerStorage.size())); json.isObject())
+                encoding = getEncoding (json);
+
+        addBody (chunk.data);
 
         if (chunk.thisChunkNum != 0 && chunk.thisChunkNum != chunk.totalNumChunks)
             return {};
@@ -75,7 +126,6 @@ public:
         const auto headerJson = JSON::parse (String (headerStorage.data(), headerStorage.size()));
 
         terminate();
-        const auto encodingString = headerJson.getProperty ("mutualEncoding", "ASCII").toString();
 
         if (chunk.thisChunkNum != chunk.totalNumChunks)
             return std::optional<OwningResult> { std::in_place, PropertyExchangeResult::Error::partial };
@@ -85,9 +135,7 @@ public:
         if (status == 343)
             return std::optional<OwningResult> { std::in_place, PropertyExchangeResult::Error::tooManyTransactions };
 
-        return std::optional<OwningResult> { std::in_place,
-                                             headerJson,
-                                             Encodings::decode (bodyStorage, EncodingUtils::toEncoding (encodingString.toRawUTF8()).value_or (Encoding::ascii)) };
+        return std::optional<OwningResult> { std::in_place, headerJson, finishBody (getEncoding (headerJson)) };
     }
 
     std::optional<OwningResult> notify (Span<const std::byte> header)
@@ -112,8 +160,53 @@ public:
     }
 
 private:
+    static Encoding getEncoding (const var& headerJson)
+    {
+        const auto encodingString = headerJson.getProperty ("mutualEncoding", "ASCII").toString();
+        return EncodingUtils::toEncoding (encodingString.toRawUTF8()).value_or (Encoding::ascii);
+    }
+
+    void addBody (Span<const std::byte> data)
+    {
+        if (! encoding.has_value() || *encoding == Encoding::ascii)
+        {
+            bodyStorage.insert (bodyStorage.end(), data.begin(), data.end());
+            return;
+        }
+
+        // Only whole groups of eight bytes can be decoded, so any leftover bytes are held back
+        // until the next chunk arrives
+        encodedStorage.insert (encodedStorage.end(), data.begin(), data.end());
+        const auto numToDecode = encodedStorage.size() - encodedStorage.size() % 8;
+        Encodings::fromMcoded7 (Span (encodedStorage.data(), numToDecode), bodyStorage);
+        encodedStorage.erase (encodedStorage.begin(), encodedStorage.begin() + (ptrdiff_t) numToDecode);
+    }
+
+    std::vector<std::byte> finishBody (Encoding finalEncoding)
+    {
+        // If the header didn't arrive in one piece, nothing has been decoded yet
+        if (! encoding.has_value())
+            return Encodings::decode (bodyStorage, finalEncoding);
+
+        jassert (*encoding == finalEncoding);
+
+        Encodings::fromMcoded7 (encodedStorage, bodyStorage);
+        encodedStorage.clear();
+
+        if (*encoding == Encoding::zlibAndMcoded7)
+        {
+            auto decompressed = Encodings::decompress (bodyStorage).value_or (std::vector<std::byte>{});
+            pool.give (std::exchange (bodyStorage, {}));
+            return decompressed;
+        }
+
+        return std::exchange (bodyStorage, {});
+    }
+
+    PropertyExchangeBufferPool& pool;
     std::vector<char> headerStorage;
-    std::vector<std::byte> bodyStorage;
+    std::vector<std::byte> bodyStorage, encodedStorage;
+    std::optional<Encoding> encoding;
     uint16_t lastChunk = 0;
     bool ongoing = true;
 };
@@ -139,7 +232,7 @@ public:
             ids.erase (entry->key);
         }
 
-        const auto& item = entry.emplace (id, std::move (onDone), Token64 { lastKey });
+        const auto& item = entry.emplace (pool, id, std::move (onDone), Token64 { lastKey });
         ids.emplace (item.key, id);
         return item.key;
     }
@@ -235,8 +328,8 @@ private:
     class Transaction
     {
     public:
-        Transaction (uint8_t i, std::function<void (const PropertyExchangeResult&)> onSuccess, Token64 k)
-            : onFinish (std::move (onSuccess)), key (k), id (i) {}
+        Transaction (PropertyExchangeBufferPool& p, uint8_t i, std::function<void (const PropertyExchangeResult&)> onSuccess, Token64 k)
+            : cache (p), onFinish (std::move (onSuccess)), key (k), id (i) {}
 
         PropertyExchangeCache cache;
         std::function<void (const PropertyExchangeResult&)> onFinish;
@@ -249,16 +342,20 @@ private:
     {
         if (auto& entry = caches[b.asInt()])
         {
-            if (const auto result = withCache (entry->cache))
+            if (auto result = withCache (entry->cache))
             {
-                const auto tmp = std::move (*entry);
-                ids.erase (tmp.key);
+                const auto onFinish = std::move (entry->onFinish);
+                ids.erase (entry->key);
                 entry.reset();
-                NullCheckedInvocation::invoke (tmp.onFinish, result->result);
+                NullCheckedInvocation::invoke (onFinish, result->result);
+
+                // The result only refers to the body during the callback, so its storage can be reused
+                pool.give (std::move (result->backingStorage));
             }
         }
     }
 
+    PropertyExchangeBufferPool pool;
     std::array<std::optional<Transaction>, numCaches> caches;
     std::map<Token64, uint8_t> ids;
     uint64_t lastKey = 0;
@@ -361,4 +458,65 @@ void ResponderPropertyExchangeCache::addChunk (RequestID b, const Message::Dynam
 void ResponderPropertyExchangeCache::notify (RequestID b, Span<const std::byte> header) { pimpl->notify (b, header); }
 int ResponderPropertyExchangeCache::countOngoingTransactions() const { return pimpl->countOngoingTransactions(); }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PropertyExchangeCacheTests : public UnitTest
+{
+public:
+    PropertyExchangeCacheTests() : UnitTest ("PropertyExchangeCache", UnitTestCategories::midi) {}
+
+    void runTest() override
+    {
+        for (const auto encoding : { Encoding::ascii, Encoding::mcoded7, Encoding::zlibAndMcoded7 })
+        {
+            beginTest ("Bodies split into chunks are reassembled and decoded, encoding " + String (EncodingUtils::toString (encoding)));
+
+            std::vector<std::byte> body (5000);
+
+            for (size_t i = 0; i < body.size(); ++i)
+                body[i] = (std::byte) ((i * 13) % (encoding == Encoding::ascii ? 0x80 : 0x100));
+
+            const auto encoded = Encodings::tryEncode (body, encoding);
+            expect (encoded.has_value());
+
+            const auto header = Encodings::jsonTo7BitText (JSONUtils::makeObjectWithKeyFirst ({ { "status", 200 },
+                                                                                                { "mutualEncoding", EncodingUtils::toString (encoding) } },
+                                                                                              "status"));
+
+            ResponderPropertyExchangeCache cache;
+            const auto id = *RequestID::create (1);
+
+            for (auto transaction = 0; transaction < 2; ++transaction)
+            {
+                std::vector<std::byte> received;
+                cache.primeCache (1, [&] (const PropertyExchangeResult& r) { received.assign (r.getBody().begin(), r.getBody().end()); }, id);
+
+                // Deliberately use chunk sizes that aren't multiples of the Mcoded7 group size
+                const size_t chunkSize = 333;
+                const auto numChunks = (uint16_t) ((encoded->size() + chunkSize - 1) / chunkSize);
+
+                for (uint16_t i = 0; i < numChunks; ++i)
+                {
+                    const auto start = i * chunkSize;
+                    Message::DynamicSizePropertyExchange chunk;
+                    chunk.requestID = id.asByte();
+                    chunk.header = i == 0 ? Span<const std::byte> (header) : Span<const std::byte>();
+                    chunk.totalNumChunks = numChunks;
+                    chunk.thisChunkNum = (uint16_t) (i + 1);
+                    chunk.data = Span (encoded->data() + start, std::min (chunkSize, encoded->size() - start));
+                    cache.addChunk (id, chunk);
+                }
+
+                expect (received == body);
+                expectEquals (cache.countOngoingTransactions(), 0);
+            }
+        }
+    }
+};
+
+static PropertyExchangeCacheTests propertyExchangeCacheTests;
+
+#endif
+
 } // namespace juce::midi_ci
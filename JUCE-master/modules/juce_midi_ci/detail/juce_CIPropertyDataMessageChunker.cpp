@@ -108,7 +108,9 @@ bool PropertyDataMessageChunker::hasRoomForBody() const
 
 void PropertyDataMessageChunker::populateStorage() const
 {
+    // The storage is reused for every chunk, so this only allocates when writing the first one
     storage->clear();
+    storage->reserve ((size_t) chunkSize);
     storage->resize ((size_t) getRoomForBody());
 
     // Read body data into buffer
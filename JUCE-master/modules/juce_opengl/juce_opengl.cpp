@@ -252,6 +252,7 @@ private:
 } // namespace juce
 
 //==============================================================================
+#include "opengl/juce_OpenGLPixelBufferRing.h"
 #include "opengl/juce_OpenGLFrameBuffer.cpp"
 #include "opengl/juce_OpenGLGraphicsContext.cpp"
 #include "opengl/juce_OpenGLHelpers.cpp"
@@ -158,6 +158,9 @@ public:
         else
             nativeContext.reset();
 
+        if (context.renderComponents && context.decouplePainting)
+            decoupledPainter = std::make_unique<DecoupledPainter> (*this);
+
         refreshDisplayLinkConnection();
     }
 
@@ -207,6 +210,9 @@ public:
         associatedObjectNames.clear();
         associatedObjects.clear();
         cachedImageFrameBuffer.release();
+
+        if (decoupledPainter != nullptr)
+            decoupledPainter->releaseTexture();
         nativeContext->shutdownOnRenderThread();
     }
 
@@ -237,14 +243,25 @@ public:
     bool invalidateAll() override
     {
         validArea.clear();
-        triggerRepaint();
+
+        if (decoupledPainter != nullptr)
+            decoupledPainter->invalidateAll();
+        else
+            triggerRepaint();
+
         return false;
     }
 
     bool invalidate (const Rectangle<int>& area) override
     {
-        validArea.subtract (area.toFloat().transformedBy (transform).getSmallestIntegerContainer());
-        triggerRepaint();
+        const auto scaledArea = area.toFloat().transformedBy (transform).getSmallestIntegerContainer();
+        validArea.subtract (scaledArea);
+
+        if (decoupledPainter != nullptr)
+            decoupledPainter->invalidate (scaledArea);
+        else
+            triggerRepaint();
+
         return false;
     }
 
@@ -364,7 +381,7 @@ public:
 
         const auto isUpdating = isFlagSet (stateToUse, StateFlags::paintComponents);
 
-        if (context.renderComponents && isUpdating)
+        if (context.renderComponents && decoupledPainter == nullptr && isUpdating)
         {
             bool abortScope = false;
             // If we early-exit here, we need to restore these flags so that the render is
@@ -415,7 +432,12 @@ public:
                 clearGLError();
             }
 
-            if (context.renderComponents)
+            if (decoupledPainter != nullptr)
+            {
+                glViewport (0, 0, viewportArea.getWidth(), viewportArea.getHeight());
+                decoupledPainter->drawLatestFrame (viewportArea);
+            }
+            else if (context.renderComponents)
             {
                 if (isUpdating)
                 {
@@ -528,6 +550,7 @@ public:
             clearRegionInFrameBuffer (invalid);
 
             {
+                JUCE_RENDERING_METRICS_SCOPED_FRAME ("OpenGL")
                 std::unique_ptr<LowLevelGraphicsContext> g (createOpenGLGraphicsContext (context, cachedImageFrameBuffer));
                 g->clipToRectangleList (invalid);
                 g->addTransform (transform);
@@ -541,6 +564,12 @@ public:
     }
 
     void drawComponentBuffer()
+    {
+        const Rectangle<int> cacheBounds (cachedImageFrameBuffer.getWidth(), cachedImageFrameBuffer.getHeight());
+        drawComponentTexture (cachedImageFrameBuffer.getTextureID(), cacheBounds, cacheBounds, cacheBounds);
+    }
+
+    void drawComponentTexture (GLuint textureID, Rectangle<int> area, Rectangle<int> textureBounds, Rectangle<int> viewportArea)
     {
         if (! OpenGLRendering::TraitsVAO::isCoreProfile())
             glEnable (GL_TEXTURE_2D);
@@ -556,10 +585,8 @@ public:
             context.extensions.glActiveTexture (GL_TEXTURE0);
         }
 
-        glBindTexture (GL_TEXTURE_2D, cachedImageFrameBuffer.getTextureID());
-
-        const Rectangle<int> cacheBounds (cachedImageFrameBuffer.getWidth(), cachedImageFrameBuffer.getHeight());
-        context.copyTexture (cacheBounds, cacheBounds, cacheBounds.getWidth(), cacheBounds.getHeight(), false);
+        glBindTexture (GL_TEXTURE_2D, textureID);
+        context.copyTexture (area, textureBounds, viewportArea.getWidth(), viewportArea.getHeight(), false);
         glBindTexture (GL_TEXTURE_2D, 0);
         JUCE_CHECK_OPENGL_ERROR
     }
@@ -956,6 +983,132 @@ public:
         CachedImage& image;
     };
 
+    //==============================================================================
+    /*  Used when component painting is decoupled from the render thread. The message
+        thread paints into one of three software images, publishes it by swapping its
+        index into 'latest', and the render thread swaps that index out again to upload
+        the image. Each thread only ever touches the image whose index it holds.
+    */
+    class DecoupledPainter final : private AsyncUpdater
+    {
+    public:
+        explicit DecoupledPainter (CachedImage& i)  : image (i)
+        {
+            texture.setNumStreamingBuffers (2);
+        }
+
+        ~DecoupledPainter() override
+        {
+            cancelPendingUpdate();
+        }
+
+        // Called on the message thread
+        void invalidate (Rectangle<int> area)
+        {
+            for (auto& frame : frames)
+                frame.dirtyRegion.add (area);
+
+            triggerAsyncUpdate();
+        }
+
+        // Called on the message thread
+        void invalidateAll()
+        {
+            for (auto& frame : frames)
+                frame.isFullyDirty = true;
+
+            triggerAsyncUpdate();
+        }
+
+        // Called on the render thread, with the context active
+        void drawLatestFrame (Rectangle<int> viewportArea)
+        {
+            const auto hasNewFrame = (latest.load() & newFrameFlag) != 0;
+
+            if (hasNewFrame)
+                readIndex = latest.exchange (readIndex) & indexMask;
+
+            const auto& source = frames[(size_t) readIndex].pixels;
+
+            if (! source.isValid())
+                return;
+
+            if (hasNewFrame || texture.getTextureID() == 0)
+                texture.loadImage (source);
+
+            // The image is uploaded with its top-left at texture coordinate (0, 1), so
+            // a texture that has been padded to a power-of-two still lines up at the top.
+            image.drawComponentTexture (texture.getTextureID(),
+                                        source.getBounds(),
+                                        { texture.getWidth(), texture.getHeight() },
+                                        viewportArea);
+        }
+
+        // Called on the render thread, with the context active
+        void releaseTexture()
+        {
+            texture.release();
+        }
+
+    private:
+        struct Frame
+        {
+            Image pixels;
+            RectangleList<int> dirtyRegion;
+            bool isFullyDirty = true;
+        };
+
+        static constexpr int indexMask = 3, newFrameFlag = 4;
+
+        void handleAsyncUpdate() override
+        {
+            const auto area = image.areaAndScale.get().area;
+
+            if (area.isEmpty())
+                return;
+
+            auto& frame = frames[(size_t) writeIndex];
+
+            if (frame.pixels.getWidth() != area.getWidth() || frame.pixels.getHeight() != area.getHeight())
+            {
+                frame.pixels = Image (Image::ARGB, area.getWidth(), area.getHeight(), false, SoftwareImageType());
+                frame.isFullyDirty = true;
+            }
+
+            auto region = frame.isFullyDirty ? RectangleList<int> (frame.pixels.getBounds())
+                                             : frame.dirtyRegion;
+            region.clipTo (frame.pixels.getBounds());
+
+            frame.dirtyRegion.clear();
+            frame.isFullyDirty = false;
+
+            if (region.isEmpty())
+                return;
+
+            for (auto& r : region)
+                frame.pixels.clear (r);
+
+            {
+                JUCE_RENDERING_METRICS_SCOPED_FRAME ("OpenGL (decoupled)")
+                auto g = frame.pixels.getPixelData()->createLowLevelContext();
+                g->clipToRectangleList (region);
+                g->addTransform (image.transform);
+                image.paintOwner (*g);
+            }
+
+            writeIndex = latest.exchange (writeIndex | newFrameFlag) & indexMask;
+
+            image.state |= StateFlags::pendingRender;
+            image.renderThread->triggerRepaint();
+        }
+
+        CachedImage& image;
+        std::array<Frame, 3> frames;
+        std::atomic<int> latest { 1 };
+        int writeIndex = 0, readIndex = 2;
+        OpenGLTexture texture;
+    };
+
     //==============================================================================
     friend class NativeContext;
     std::unique_ptr<NativeContext> nativeContext;
@@ -983,6 +1136,7 @@ public:
     bool textureNpotSupported = false;
     std::chrono::steady_clock::time_point lastMMLockReleaseTime{};
     BufferSwapper bufferSwapper { *this };
+    std::unique_ptr<DecoupledPainter> decoupledPainter;
 
    #if JUCE_MAC
     NSView* getCurrentView() const
@@ -1259,6 +1413,15 @@ void OpenGLContext::setComponentPaintingEnabled (bool shouldPaintComponent) noex
     renderComponents = shouldPaintComponent;
 }
 
+void OpenGLContext::setComponentPaintingDecoupled (bool shouldDecouplePainting) noexcept
+{
+    // This method must not be called when the context has already been attached!
+    // Call it before attaching your context, or use detach() first, before calling this!
+    jassert (nativeContext == nullptr);
+
+    decouplePainting = shouldDecouplePainting;
+}
+
 void OpenGLContext::setContinuousRepainting (bool shouldContinuouslyRepaint) noexcept
 {
     continuousRepaint = shouldContinuouslyRepaint;
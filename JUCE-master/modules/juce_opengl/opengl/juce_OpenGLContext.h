@@ -180,6 +180,23 @@ public:
     */
     void setComponentPaintingEnabled (bool shouldPaintComponent) noexcept;
 
+    /** Stops the render thread from waiting for the message thread when painting components.
+
+        Normally, the render thread locks the MessageManager and calls the component's paint
+        methods itself, so slow painting holds up GL frames and vice versa. When this is
+        enabled, the component is painted on the message thread into one of three software
+        images, and the render thread uploads whichever image was finished most recently.
+        The images are handed over with an atomic exchange, so neither thread ever waits for
+        the other. The trade-off is that components are drawn by the software renderer, and
+        each new frame has to be uploaded as a texture.
+
+        This has no effect if component painting is disabled. By default it's false.
+
+        Note: This must be called BEFORE attaching your context to a target component!
+        @see setComponentPaintingEnabled
+    */
+    void setComponentPaintingDecoupled (bool shouldDecouplePainting) noexcept;
+
     /** Enables or disables continuous repainting.
         If set to true, the context will run a loop, re-rendering itself without waiting
         for triggerRepaint() to be called, at a frequency determined by the swap interval
@@ -366,7 +383,7 @@ private:
     void* contextToShareWith = nullptr;
     OpenGLVersion versionRequired = defaultGLVersion;
     size_t imageCacheMaxSize = 8 * 1024 * 1024;
-    bool renderComponents = true, useMultisampling = false, overrideCanAttach = false;
+    bool renderComponents = true, decouplePainting = false, useMultisampling = false, overrideCanAttach = false;
     std::atomic<bool> continuousRepaint { false };
     TextureMagnificationFilter texMagFilter = linear;
 
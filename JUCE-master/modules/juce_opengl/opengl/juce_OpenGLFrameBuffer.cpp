@@ -138,6 +138,8 @@ public:
     const int width, height;
     GLuint textureID, frameBufferID, depthOrStencilBuffer;
     bool hasDepthBuffer, hasStencilBuffer;
+    std::unique_ptr<OpenGLTexture> uploadTexture;
+    std::unique_ptr<OpenGLPixelBufferRing> readBuffers;
 
 private:
     bool checkStatus() noexcept
@@ -339,6 +341,31 @@ bool OpenGLFrameBuffer::readPixels (PixelARGB* target, const Rectangle<int>& are
     return true;
 }
 
+bool OpenGLFrameBuffer::readPixelsAsync (PixelARGB* target, const Rectangle<int>& area)
+{
+    if (numStreamingBuffers <= 0 || ! OpenGLPixelBufferRing::isSupported())
+        return readPixels (target, area);
+
+    if (! makeCurrentRenderingTarget())
+        return false;
+
+    auto& buffers = pimpl->readBuffers;
+
+    if (buffers == nullptr || buffers->getNumBuffers() != numStreamingBuffers)
+        buffers = std::make_unique<OpenGLPixelBufferRing> (GL_PIXEL_PACK_BUFFER, numStreamingBuffers);
+
+    glPixelStorei (GL_PACK_ALIGNMENT, 4);
+    const auto filled = buffers->readPixels (target, area, JUCE_RGBA_FORMAT, sizeof (PixelARGB));
+
+    pimpl->unbind();
+    return filled;
+}
+
+void OpenGLFrameBuffer::setNumStreamingBuffers (int numBuffers)
+{
+    numStreamingBuffers = jmax (0, numBuffers);
+}
+
 bool OpenGLFrameBuffer::writePixels (const PixelARGB* data, const Rectangle<int>& area)
 {
     OpenGLTargetSaver ts (pimpl->context);
@@ -350,7 +377,19 @@ bool OpenGLFrameBuffer::writePixels (const PixelARGB* data, const Rectangle<int>
     glDisable (GL_BLEND);
     JUCE_CHECK_OPENGL_ERROR
 
-    OpenGLTexture tex;
+    OpenGLTexture localTexture;
+    auto& tex = [&]() -> OpenGLTexture&
+    {
+        if (numStreamingBuffers <= 0)
+            return localTexture;
+
+        if (pimpl->uploadTexture == nullptr)
+            pimpl->uploadTexture = std::make_unique<OpenGLTexture>();
+
+        pimpl->uploadTexture->setNumStreamingBuffers (numStreamingBuffers);
+        return *pimpl->uploadTexture;
+    }();
+
     tex.loadARGB (data, area.getWidth(), area.getHeight());
 
     glViewport (0, 0, pimpl->width, pimpl->height);
@@ -129,12 +129,39 @@ public:
     */
     bool writePixels (const PixelARGB* srcData, const Rectangle<int>& targetArea);
 
+    /** Starts reading an area of pixels from the framebuffer without waiting for the GPU.
+
+        The read is queued into one of the buffers set up by setNumStreamingBuffers(),
+        and targetData receives the pixels from the read that was queued that many
+        calls earlier. This suits continuous captures, where a few frames of latency
+        are better than stalling the GL thread on every frame.
+
+        Returns true if targetData was filled, which needs an earlier call with an area
+        of the same size. If streaming isn't enabled or supported, this behaves just
+        like readPixels().
+    */
+    bool readPixelsAsync (PixelARGB* targetData, const Rectangle<int>& sourceArea);
+
+    /** Sets the number of pixel buffer objects used to stream data in and out of this
+        framebuffer.
+
+        When this is greater than zero, writePixels() uploads its data through a reusable
+        texture that has the same number of streaming buffers (see
+        OpenGLTexture::setNumStreamingBuffers()), and readPixelsAsync() reads back through
+        a ring of this many buffers. Passing 0 (the default) turns streaming off.
+    */
+    void setNumStreamingBuffers (int numBuffers);
+
+    /** Returns the number of streaming buffers set with setNumStreamingBuffers(). */
+    int getNumStreamingBuffers() const noexcept         { return numStreamingBuffers; }
+
 private:
     class Pimpl;
     std::unique_ptr<Pimpl> pimpl;
 
     class SavedState;
     std::unique_ptr<SavedState> savedState;
+    int numStreamingBuffers = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLFrameBuffer)
 };
@@ -1289,25 +1289,17 @@ struct StateHelpers
         {
             JUCE_CHECK_OPENGL_ERROR
 
-           #if JUCE_ANDROID || JUCE_IOS
-            int numQuads = maxNumQuads;
-           #else
+           #if ! (JUCE_ANDROID || JUCE_IOS)
             GLint maxIndices = 0;
             glGetIntegerv (GL_MAX_ELEMENTS_INDICES, &maxIndices);
-            auto numQuads = jmin ((int) maxNumQuads, (int) maxIndices / 6);
+            auto numQuads = jlimit ((int) minNumQuads, (int) maxNumQuads, (int) maxIndices / 6);
             maxVertices = numQuads * 4 - 4;
            #endif
 
-            for (int i = 0, v = 0; i < numQuads * 6; i += 6, v += 4)
-            {
-                indexData[i] = (GLushort) v;
-                indexData[i + 1] = indexData[i + 3] = (GLushort) (v + 1);
-                indexData[i + 2] = indexData[i + 4] = (GLushort) (v + 2);
-                indexData[i + 5] = (GLushort) (v + 3);
-            }
+            const auto& indexData = getIndexData();
 
             savedElementArrayBuffer.bind();
-            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (indexData), indexData, GL_STATIC_DRAW);
+            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (indexData), indexData.data(), GL_STATIC_DRAW);
 
             savedArrayBuffer.bind();
             context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), vertexData, GL_STREAM_DRAW);
@@ -1391,12 +1383,13 @@ struct StateHelpers
             GLuint colour;
         };
 
-        enum { maxNumQuads = 256 };
+        // Batches are only broken by a change of shader, texture or blend mode, so these
+        // are large enough for a whole frame of solid fills and text to need very few draws.
+        enum { minNumQuads = 256, maxNumQuads = 8192 };
 
         SavedBinding<TraitsArrayBuffer> savedArrayBuffer;
         SavedBinding<TraitsElementArrayBuffer> savedElementArrayBuffer;
         VertexInfo vertexData[maxNumQuads * 4];
-        GLushort indexData[maxNumQuads * 6];
         const OpenGLContext& context;
         int numVertices = 0;
 
@@ -1406,14 +1399,41 @@ struct StateHelpers
         int maxVertices = 0;
        #endif
 
+        static const std::array<GLushort, maxNumQuads * 6>& getIndexData() noexcept
+        {
+            static const auto indices = []
+            {
+                std::array<GLushort, maxNumQuads * 6> result{};
+
+                for (size_t i = 0, v = 0; i < result.size(); i += 6, v += 4)
+                {
+                    result[i] = (GLushort) v;
+                    result[i + 1] = result[i + 3] = (GLushort) (v + 1);
+                    result[i + 2] = result[i + 4] = (GLushort) (v + 2);
+                    result[i + 5] = (GLushort) (v + 3);
+                }
+
+                return result;
+            }();
+
+            return indices;
+        }
+
         void draw() noexcept
         {
+            // Orphaning the previous storage means the driver doesn't have to wait for the
+            // GPU to finish with the last batch before this one can be uploaded.
+            context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), nullptr, GL_STREAM_DRAW);
             context.extensions.glBufferSubData (GL_ARRAY_BUFFER, 0, (GLsizeiptr) ((size_t) numVertices * sizeof (VertexInfo)), vertexData);
             // NB: If you get a random crash in here and are running in a Parallels VM, it seems to be a bug in
             // their driver.. Can't find a workaround unfortunately.
             glDrawElements (GL_TRIANGLES, (numVertices * 3) / 2, GL_UNSIGNED_SHORT, nullptr);
             JUCE_CHECK_OPENGL_ERROR
             numVertices = 0;
+
+           #if JUCE_RENDERING_METRICS
+            RenderingMetrics::getInstance()->addToCount (RenderingMetrics::drawCalls);
+           #endif
         }
 
         JUCE_DECLARE_NON_COPYABLE (ShaderQuadQueue)
@@ -1771,8 +1791,6 @@ struct SavedState final : public RenderingHelpers::SavedStateBase<SavedState>
 
         state->shaderQuadQueue.add (iter, PixelARGB ((uint8) alpha, (uint8) alpha, (uint8) alpha, (uint8) alpha));
         state->shaderQuadQueue.flush();
-
-        state->currentShader.clearShader (state->shaderQuadQueue);
     }
 
     template <typename IteratorType>
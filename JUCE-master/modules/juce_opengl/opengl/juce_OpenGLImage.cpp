@@ -62,11 +62,15 @@ public:
         return createOpenGLGraphicsContext (context, frameBuffer);
     }
 
-    std::unique_ptr<ImageType> createType() const override     { return std::make_unique<OpenGLImageType>(); }
+    std::unique_ptr<ImageType> createType() const override
+    {
+        return std::make_unique<OpenGLImageType> (frameBuffer.getNumStreamingBuffers());
+    }
 
     ImagePixelData::Ptr clone() override
     {
         std::unique_ptr<OpenGLFrameBufferImage> im (new OpenGLFrameBufferImage (context, width, height));
+        im->frameBuffer.setNumStreamingBuffers (frameBuffer.getNumStreamingBuffers());
 
         if (! im->initialise())
             return ImagePixelData::Ptr();
@@ -137,6 +141,7 @@ private:
 
 //==============================================================================
 OpenGLImageType::OpenGLImageType() {}
+OpenGLImageType::OpenGLImageType (int numBuffers) : numStreamingBuffers (jmax (0, numBuffers)) {}
 OpenGLImageType::~OpenGLImageType() {}
 
 int OpenGLImageType::getTypeID() const
@@ -150,6 +155,7 @@ ImagePixelData::Ptr OpenGLImageType::create (Image::PixelFormat, int width, int
     jassert (currentContext != nullptr); // an OpenGL image can only be created when a valid context is active!
 
     std::unique_ptr<OpenGLFrameBufferImage> im (new OpenGLFrameBufferImage (*currentContext, width, height));
+    im->frameBuffer.setNumStreamingBuffers (numStreamingBuffers);
 
     if (! im->initialise())
         return ImagePixelData::Ptr();
@@ -52,12 +52,23 @@ class JUCE_API  OpenGLImageType     : public ImageType
 {
 public:
     OpenGLImageType();
+
+    /** Creates a type whose images move their pixel data in and out of the GPU through
+        the given number of pixel buffer objects, rather than waiting for each transfer.
+
+        @see OpenGLFrameBuffer::setNumStreamingBuffers
+    */
+    explicit OpenGLImageType (int numStreamingBuffers);
+
     ~OpenGLImageType() override;
 
     ImagePixelData::Ptr create (Image::PixelFormat, int width, int height, bool shouldClearImage) const override;
     int getTypeID() const override;
 
     static OpenGLFrameBuffer* getFrameBufferFrom (const Image&);
+
+private:
+    int numStreamingBuffers = 0;
 };
 
 } // namespace juce
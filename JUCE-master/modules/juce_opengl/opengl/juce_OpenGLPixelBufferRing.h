@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/*  A small ring of pixel buffer objects, used to stream texture uploads and
+    framebuffer readbacks without making the GL thread wait for the transfer.
+
+    Each buffer is protected by a fence, so it's only written again once the GPU
+    has finished with the transfer that last used it.
+*/
+class OpenGLPixelBufferRing
+{
+public:
+    OpenGLPixelBufferRing (GLenum bufferTarget, int numBuffers)
+        : target (bufferTarget),
+          slots ((size_t) jmax (1, numBuffers))
+    {
+        for (auto& slot : slots)
+            glGenBuffers (1, &slot.buffer);
+
+        JUCE_CHECK_OPENGL_ERROR
+    }
+
+    ~OpenGLPixelBufferRing()
+    {
+        if (! OpenGLHelpers::isContextActive())
+            return;
+
+        for (auto& slot : slots)
+        {
+            if (slot.fence != nullptr)
+                glDeleteSync (slot.fence);
+
+            glDeleteBuffers (1, &slot.buffer);
+        }
+    }
+
+    static bool isSupported() noexcept
+    {
+        return glMapBufferRange != nullptr
+            && glUnmapBuffer != nullptr
+            && glFenceSync != nullptr
+            && glClientWaitSync != nullptr
+            && glDeleteSync != nullptr;
+    }
+
+    int getNumBuffers() const noexcept      { return (int) slots.size(); }
+
+    /*  Copies some data into the next buffer and leaves it bound as the unpack buffer,
+        so that a following glTexImage2D/glTexSubImage2D call can read from offset 0.
+        Returns false, leaving nothing bound, if the buffer couldn't be mapped.
+    */
+    bool beginUpload (const void* data, size_t numBytes)
+    {
+        jassert (target == GL_PIXEL_UNPACK_BUFFER);
+
+        auto& slot = slots[next];
+        const auto isIdle = waitUntilIdle (slot);
+
+        glBindBuffer (target, slot.buffer);
+        allocate (slot, numBytes, GL_STREAM_DRAW);
+
+        auto access = (GLbitfield) (GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+        if (isIdle)
+            access |= GL_MAP_UNSYNCHRONIZED_BIT;
+
+        if (auto* mapped = glMapBufferRange (target, 0, (GLsizeiptr) numBytes, access))
+        {
+            memcpy (mapped, data, numBytes);
+
+            if (glUnmapBuffer (target) != GL_FALSE)
+                return true;
+        }
+
+        glBindBuffer (target, 0);
+        JUCE_CHECK_OPENGL_ERROR
+        return false;
+    }
+
+    /*  Call this after the GL command that reads from the buffer bound by beginUpload(). */
+    void endUpload()
+    {
+        glBindBuffer (target, 0);
+        fenceAndAdvance();
+    }
+
+    /*  Queues a glReadPixels of the given area of the currently bound framebuffer into
+        the next buffer, after copying out the result of the read that last used that
+        buffer. The pixels that are copied into destData are therefore the ones that
+        were requested getNumBuffers() calls earlier.
+        Returns true if destData was filled, which needs a previous read of the same size.
+    */
+    bool readPixels (void* destData, Rectangle<int> area, GLenum format, size_t bytesPerPixel)
+    {
+        jassert (target == GL_PIXEL_PACK_BUFFER);
+
+        auto& slot = slots[next];
+        const auto numBytes = (size_t) area.getWidth() * (size_t) area.getHeight() * bytesPerPixel;
+        auto copied = false;
+
+        glBindBuffer (target, slot.buffer);
+
+        if (slot.fence != nullptr)
+        {
+            waitUntilIdle (slot);
+
+            if (slot.pendingArea.getWidth() == area.getWidth()
+                 && slot.pendingArea.getHeight() == area.getHeight())
+            {
+                if (auto* mapped = glMapBufferRange (target, 0, (GLsizeiptr) numBytes, GL_MAP_READ_BIT))
+                {
+                    memcpy (destData, mapped, numBytes);
+                    copied = glUnmapBuffer (target) != GL_FALSE;
+                }
+            }
+        }
+
+        allocate (slot, numBytes, GL_STREAM_READ);
+        glReadPixels (area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                      format, GL_UNSIGNED_BYTE, nullptr);
+        slot.pendingArea = area;
+
+        glBindBuffer (target, 0);
+        fenceAndAdvance();
+        JUCE_CHECK_OPENGL_ERROR
+        return copied;
+    }
+
+private:
+    struct Slot
+    {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        size_t size = 0;
+        Rectangle<int> pendingArea;
+    };
+
+    GLenum target;
+    std::vector<Slot> slots;
+    size_t next = 0;
+
+    static bool waitUntilIdle (Slot& slot)
+    {
+        if (slot.fence == nullptr)
+            return true;
+
+        auto result = glClientWaitSync (slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync (slot.fence, 0, 1000000);
+
+        glDeleteSync (slot.fence);
+        slot.fence = nullptr;
+
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    void allocate (Slot& slot, size_t numBytes, GLenum usage)
+    {
+        if (slot.size != numBytes)
+        {
+            glBufferData (target, (GLsizeiptr) numBytes, nullptr, usage);
+            slot.size = numBytes;
+        }
+    }
+
+    void fenceAndAdvance()
+    {
+        slots[next].fence = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        next = (next + 1) % slots.size();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (OpenGLPixelBufferRing)
+};
+
+} // namespace juce
@@ -58,6 +58,11 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
     // context. You'll need to create this object in one of the OpenGLContext's callbacks.
     jassert (ownerContext != nullptr);
 
+   #if JUCE_RENDERING_METRICS
+    if (pixels != nullptr)
+        RenderingMetrics::getInstance()->addToCount (RenderingMetrics::imageUploads);
+   #endif
+
     if (textureID == 0)
     {
         JUCE_CHECK_OPENGL_ERROR
@@ -92,23 +97,51 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
 
     const GLint internalformat = type == GL_ALPHA ? GL_ALPHA : GL_RGBA;
 
-    if (width != w || height != h)
-    {
+    const auto needsPadding = (width != w || height != h);
+
+    // The padded texture must be allocated before an unpack buffer is bound, otherwise
+    // its null data pointer would be treated as an offset into that buffer.
+    if (needsPadding)
         glTexImage2D (GL_TEXTURE_2D, 0, internalformat,
                       width, height, 0, type, GL_UNSIGNED_BYTE, nullptr);
 
+    const auto isStreamed = pixels != nullptr
+                             && beginStreamedUpload (pixels, (size_t) w * (size_t) h * (type == GL_ALPHA ? 1u : 4u));
+
+    const void* source = isStreamed ? nullptr : pixels;
+
+    if (needsPadding)
         glTexSubImage2D (GL_TEXTURE_2D, 0, 0, topLeft ? (height - h) : 0, w, h,
-                         type, GL_UNSIGNED_BYTE, pixels);
-    }
+                         type, GL_UNSIGNED_BYTE, source);
     else
-    {
         glTexImage2D (GL_TEXTURE_2D, 0, internalformat,
-                      w, h, 0, type, GL_UNSIGNED_BYTE, pixels);
-    }
+                      w, h, 0, type, GL_UNSIGNED_BYTE, source);
+
+    if (isStreamed)
+        streamingBuffers->endUpload();
 
     JUCE_CHECK_OPENGL_ERROR
 }
 
+bool OpenGLTexture::beginStreamedUpload (const void* pixels, size_t numBytes)
+{
+    if (numStreamingBuffers <= 0 || ! OpenGLPixelBufferRing::isSupported())
+        return false;
+
+    if (streamingBuffers == nullptr || streamingBuffers->getNumBuffers() != numStreamingBuffers)
+        streamingBuffers = std::make_unique<OpenGLPixelBufferRing> (GL_PIXEL_UNPACK_BUFFER, numStreamingBuffers);
+
+    return streamingBuffers->beginUpload (pixels, numBytes);
+}
+
+void OpenGLTexture::setNumStreamingBuffers (int numBuffers)
+{
+    numStreamingBuffers = jmax (0, numBuffers);
+
+    if (numStreamingBuffers == 0 && ownerContext == OpenGLContext::getCurrentContext())
+        streamingBuffers.reset();
+}
+
 template <class PixelType>
 struct Flipper
 {
@@ -185,6 +218,7 @@ void OpenGLTexture::release()
         if (ownerContext == OpenGLContext::getCurrentContext())
         {
             glDeleteTextures (1, &textureID);
+            streamingBuffers.reset();
 
             textureID = 0;
             width = 0;
@@ -35,6 +35,8 @@
 namespace juce
 {
 
+class OpenGLPixelBufferRing;
+
 //==============================================================================
 /**
     Creates an openGL texture from an Image.
@@ -80,6 +82,22 @@ public:
     */
     void loadAlpha (const uint8* pixels, int width, int height);
 
+    /** Makes the load methods stage their pixels through a ring of pixel buffer objects.
+
+        When this is enabled, each upload is copied into the next buffer in the ring, and
+        the texture is filled from there, so the GL thread doesn't have to wait while the
+        driver transfers the data. Each buffer is only reused once the GPU has finished
+        with it, so two or three buffers are usually enough for a texture that's
+        reloaded every frame.
+
+        Passing 0 (the default) makes uploads synchronous again. This setting is also
+        ignored if the current context doesn't support pixel buffer objects and fences.
+    */
+    void setNumStreamingBuffers (int numBuffers);
+
+    /** Returns the number of streaming buffers set with setNumStreamingBuffers(). */
+    int getNumStreamingBuffers() const noexcept     { return numStreamingBuffers; }
+
     /** Frees the texture, if there is one. */
     void release();
 
@@ -104,8 +122,11 @@ private:
     GLuint textureID;
     int width, height;
     OpenGLContext* ownerContext;
+    int numStreamingBuffers = 0;
+    std::unique_ptr<OpenGLPixelBufferRing> streamingBuffers;
 
     void create (int w, int h, const void*, GLenum, bool topLeft);
+    bool beginStreamedUpload (const void*, size_t numBytes);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLTexture)
 };
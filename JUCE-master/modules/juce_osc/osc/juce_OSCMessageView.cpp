@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+namespace OSCMessageViewHelpers
+{
+    // Returns the size of the null-terminated, zero-padded string at the start of the
+    // data, or 0 if the data doesn't contain one
+    static size_t getPaddedStringSize (const char* data, size_t available) noexcept
+    {
+        auto* terminator = static_cast<const char*> (std::memchr (data, 0, available));
+
+        if (terminator == nullptr)
+            return 0;
+
+        auto size = ((size_t) (terminator - data) + 4) & ~(size_t) 3;
+
+        if (size > available)
+            return 0;
+
+        for (auto* p = terminator + 1; p < data + size; ++p)
+            if (*p != 0)
+                return 0;
+
+        return size;
+    }
+
+    // Returns the size of the argument of the given type at the start of the data, or 0
+    // if the data doesn't contain a well-formed one
+    static size_t getArgumentSize (OSCType type, const char* data, size_t available) noexcept
+    {
+        if (available < 4)
+            return 0;
+
+        if (type == OSCTypes::int32 || type == OSCTypes::float32 || type == OSCTypes::colour)
+            return 4;
+
+        if (type == OSCTypes::string)
+            return getPaddedStringSize (data, available);
+
+        if (type == OSCTypes::blob)
+        {
+            const auto blobSize = (size_t) ByteOrder::bigEndianInt (data);
+            const auto paddedSize = (blobSize + 3) & ~(size_t) 3;
+
+            if (blobSize > 0x7fffffff || paddedSize > available - 4)
+                return 0;
+
+            for (auto i = blobSize; i < paddedSize; ++i)
+                if (data[4 + i] != 0)
+                    return 0;
+
+            return 4 + paddedSize;
+        }
+
+        return 0;
+    }
+}
+
+//==============================================================================
+std::optional<OSCMessageView> OSCMessageView::fromData (const void* data, size_t dataSize) noexcept
+{
+    using namespace OSCMessageViewHelpers;
+
+    auto* start = static_cast<const char*> (data);
+
+    if (start == nullptr || dataSize < 4 || start[0] != '/')
+        return {};
+
+    const auto addressSize = getPaddedStringSize (start, dataSize);
+
+    if (addressSize == 0 || addressSize == dataSize || start[addressSize] != ',')
+        return {};
+
+    auto* typeTagString = start + addressSize;
+    const auto typeTagSize = getPaddedStringSize (typeTagString, dataSize - addressSize);
+
+    if (typeTagSize == 0)
+        return {};
+
+    OSCMessageView view;
+    view.addressPattern = start;
+    view.typeTags = typeTagString + 1;
+    view.firstArgument = typeTagString + typeTagSize;
+
+    auto* end = start + dataSize;
+    auto* argument = view.firstArgument;
+
+    for (auto* type = view.typeTags; *type != 0; ++type)
+    {
+        const auto size = getArgumentSize (*type, argument, (size_t) (end - argument));
+
+        if (size == 0)
+            return {};
+
+        argument += size;
+        ++view.numArguments;
+    }
+
+    if (argument != end)
+        return {};
+
+    return view;
+}
+
+OSCMessageView::Argument OSCMessageView::operator[] (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numArguments));
+
+    auto it = begin();
+
+    while (--index >= 0)
+        ++it;
+
+    return *it;
+}
+
+OSCMessage OSCMessageView::toOSCMessage() const
+{
+    OSCMessage message { OSCAddressPattern (String::fromUTF8 (addressPattern)) };
+
+    for (auto argument : *this)
+        message.addArgument (argument.toOSCArgument());
+
+    return message;
+}
+
+OSCMessageView::Iterator& OSCMessageView::Iterator::operator++() noexcept
+{
+    data += Argument (*type, data).getSize();
+    ++type;
+    return *this;
+}
+
+//==============================================================================
+int32 OSCMessageView::Argument::getInt32() const noexcept
+{
+    jassert (isInt32());
+    return (int32) ByteOrder::bigEndianInt (data);
+}
+
+float OSCMessageView::Argument::getFloat32() const noexcept
+{
+    jassert (isFloat32());
+    union { uint32 asInt; float asFloat; } n;
+    n.asInt = ByteOrder::bigEndianInt (data);
+    return n.asFloat;
+}
+
+OSCColour OSCMessageView::Argument::getColour() const noexcept
+{
+    jassert (isColour());
+    return OSCColour::fromInt32 (ByteOrder::bigEndianInt (data));
+}
+
+const char* OSCMessageView::Argument::getString() const noexcept
+{
+    jassert (isString());
+    return data;
+}
+
+Span<const std::byte> OSCMessageView::Argument::getBlob() const noexcept
+{
+    jassert (isBlob());
+    return { reinterpret_cast<const std::byte*> (data + 4), (size_t) ByteOrder::bigEndianInt (data) };
+}
+
+OSCArgument OSCMessageView::Argument::toOSCArgument() const
+{
+    if (isInt32())      return OSCArgument (getInt32());
+    if (isFloat32())    return OSCArgument (getFloat32());
+    if (isString())     return OSCArgument (String::fromUTF8 (getString()));
+    if (isColour())     return OSCArgument (getColour());
+
+    const auto blob = getBlob();
+    return OSCArgument (MemoryBlock (blob.data(), blob.size()));
+}
+
+size_t OSCMessageView::Argument::getSize() const noexcept
+{
+    if (isString())
+        return (std::strlen (data) + 4) & ~(size_t) 3;
+
+    if (isBlob())
+        return 4 + (((size_t) ByteOrder::bigEndianInt (data) + 3) & ~(size_t) 3);
+
+    return 4;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCMessageViewTests final : public UnitTest
+{
+public:
+    OSCMessageViewTests()
+        : UnitTest ("OSCMessageView class", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("reading a valid message");
+        {
+            const uint8 data[] = {
+                '/', 't', 'e', 's', 't', '\0', '\0', '\0',
+                ',', 'i', 'f', 's', 'b', 'r', '\0', '\0',
+                0xFF, 0xFF, 0xF8, 0x21,
+                0x43, 0xAC, 0xCE, 0x66,
+                'H', 'e', 'l', 'l', 'o', ',', ' ', 'W', 'o', 'r', 'l', 'd', '!', '\0', '\0', '\0',
+                0x00, 0x00, 0x00, 0x05, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00, 0x00, 0x00,
+                0x11, 0x22, 0x33, 0x44
+            };
+
+            const auto view = OSCMessageView::fromData (data, sizeof (data));
+            expect (view.has_value());
+
+            expectEquals (String (view->getAddressPattern()), String ("/test"));
+            expectEquals (view->size(), 5);
+
+            expectEquals ((*view)[0].getInt32(), (int32) -2015);
+            expectEquals ((*view)[1].getFloat32(), 345.6125f);
+            expectEquals (String ((*view)[2].getString()), String ("Hello, World!"));
+
+            const auto blob = (*view)[3].getBlob();
+            expectEquals ((int) blob.size(), 5);
+            expect (blob[0] == std::byte { 0xBB } && blob[4] == std::byte { 0xFF });
+
+            expect ((*view)[4].getColour().red == 0x11 && (*view)[4].getColour().alpha == 0x44);
+
+            int numArguments = 0;
+
+            for (auto argument : *view)
+                expect (argument.getType() == "ifsbr"[numArguments++]);
+
+            expectEquals (numArguments, 5);
+
+            const auto message = view->toOSCMessage();
+            expectEquals (message.getAddressPattern().toString(), String ("/test"));
+            expectEquals (message.size(), 5);
+            expectEquals (message[2].getString(), String ("Hello, World!"));
+            expect (message[3].getBlob() == MemoryBlock (data + 44, 5));
+        }
+
+        beginTest ("reading a message with no arguments");
+        {
+            const uint8 data[] = { '/', 'a', '\0', '\0', ',', '\0', '\0', '\0' };
+
+            const auto view = OSCMessageView::fromData (data, sizeof (data));
+            expect (view.has_value());
+            expect (view->isEmpty());
+            expect (view->begin() == view->end());
+        }
+
+        beginTest ("rejecting malformed messages");
+        {
+            const uint8 noTypeTags[]      = { '/', 'a', '\0', '\0' };
+            const uint8 badPadding[]      = { '/', 'a', '\0', 'x', ',', '\0', '\0', '\0' };
+            const uint8 truncated[]       = { '/', 'a', '\0', '\0', ',', 'i', '\0', '\0', 0x00, 0x01 };
+            const uint8 trailingData[]    = { '/', 'a', '\0', '\0', ',', '\0', '\0', '\0', 0x00, 0x00, 0x00, 0x00 };
+            const uint8 unknownType[]     = { '/', 'a', '\0', '\0', ',', 'x', '\0', '\0', 0x00, 0x00, 0x00, 0x00 };
+            const uint8 hugeBlob[]        = { '/', 'a', '\0', '\0', ',', 'b', '\0', '\0', 0x7F, 0xFF, 0xFF, 0xFF };
+            const uint8 unterminated[]    = { '/', 'a', '\0', '\0', ',', 's', '\0', '\0', 'a', 'b', 'c', 'd' };
+            const uint8 notAMessage[]     = { '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0' };
+
+            expect (! OSCMessageView::fromData (noTypeTags, sizeof (noTypeTags)).has_value());
+            expect (! OSCMessageView::fromData (badPadding, sizeof (badPadding)).has_value());
+            expect (! OSCMessageView::fromData (truncated, sizeof (truncated)).has_value());
+            expect (! OSCMessageView::fromData (trailingData, sizeof (trailingData)).has_value());
+            expect (! OSCMessageView::fromData (unknownType, sizeof (unknownType)).has_value());
+            expect (! OSCMessageView::fromData (hugeBlob, sizeof (hugeBlob)).has_value());
+            expect (! OSCMessageView::fromData (unterminated, sizeof (unterminated)).has_value());
+            expect (! OSCMessageView::fromData (notAMessage, sizeof (notAMessage)).has_value());
+            expect (! OSCMessageView::fromData (nullptr, 0).has_value());
+        }
+    }
+};
+
+static OSCMessageViewTests OSCMessageViewUnitTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    A read-only view of an OSC message held in a block of memory.
+
+    Unlike OSCMessage, an OSCMessageView doesn't copy or allocate anything: the
+    address pattern, string arguments and blob arguments are all returned as
+    pointers into the original data. This makes it suitable for use on realtime
+    threads, but it also means that a view must not be used after the data that it
+    refers to has been changed or deleted.
+
+    The data is fully validated when the view is created, so none of the accessor
+    methods can fail.
+
+    @see OSCMessage, OSCReceiver::MessageViewListener
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCMessageView
+{
+public:
+    //==============================================================================
+    /** Tries to interpret a block of data as an OSC message.
+
+        Returns an empty optional if the data isn't a well-formed OSC message, as
+        defined by the OpenSoundControl 1.0 specification.
+    */
+    static std::optional<OSCMessageView> fromData (const void* data, size_t dataSize) noexcept;
+
+    //==============================================================================
+    /** One of the arguments of an OSCMessageView.
+
+        Calling a getter that doesn't match the argument's type results in undefined
+        behaviour, so check the type first.
+    */
+    class JUCE_API  Argument
+    {
+    public:
+        /** Returns the type of this argument. */
+        OSCType getType() const noexcept                { return type; }
+
+        bool isInt32() const noexcept                   { return type == OSCTypes::int32; }
+        bool isFloat32() const noexcept                 { return type == OSCTypes::float32; }
+        bool isString() const noexcept                  { return type == OSCTypes::string; }
+        bool isBlob() const noexcept                    { return type == OSCTypes::blob; }
+        bool isColour() const noexcept                  { return type == OSCTypes::colour; }
+
+        int32 getInt32() const noexcept;
+        float getFloat32() const noexcept;
+        OSCColour getColour() const noexcept;
+
+        /** Returns a null-terminated UTF-8 string pointing into the original data. */
+        const char* getString() const noexcept;
+
+        /** Returns the blob's contents, pointing into the original data. */
+        Span<const std::byte> getBlob() const noexcept;
+
+        /** Creates an OSCArgument containing a copy of this argument's value. */
+        OSCArgument toOSCArgument() const;
+
+    private:
+        friend class OSCMessageView;
+        Argument (OSCType t, const char* d) noexcept  : type (t), data (d) {}
+
+        size_t getSize() const noexcept;
+
+        OSCType type;
+        const char* data;
+    };
+
+    //==============================================================================
+    /** Iterates over the arguments of an OSCMessageView. */
+    class JUCE_API  Iterator
+    {
+    public:
+        Argument operator*() const noexcept             { return { *type, data }; }
+        Iterator& operator++() noexcept;
+
+        bool operator== (const Iterator& other) const noexcept     { return type == other.type; }
+        bool operator!= (const Iterator& other) const noexcept     { return type != other.type; }
+
+    private:
+        friend class OSCMessageView;
+        Iterator (const char* t, const char* d) noexcept  : type (t), data (d) {}
+
+        const char* type;
+        const char* data;
+    };
+
+    //==============================================================================
+    /** Returns the address pattern as a null-terminated string pointing into the original data. */
+    const char* getAddressPattern() const noexcept      { return addressPattern; }
+
+    /** Returns the number of arguments in the message. */
+    int size() const noexcept                           { return numArguments; }
+
+    /** Returns true if the message has no arguments. */
+    bool isEmpty() const noexcept                       { return numArguments == 0; }
+
+    /** Returns the argument at the given index.
+        This doesn't check the range, and has to step over the preceding arguments, so
+        when looking at all the arguments in turn it's quicker to iterate over them.
+    */
+    Argument operator[] (int index) const noexcept;
+
+    Iterator begin() const noexcept                     { return { typeTags, firstArgument }; }
+    Iterator end() const noexcept                       { return { typeTags + numArguments, nullptr }; }
+
+    /** Creates an OSCMessage containing a copy of this message. */
+    OSCMessage toOSCMessage() const;
+
+private:
+    OSCMessageView() = default;
+
+    const char* addressPattern = nullptr;
+    const char* typeTags = nullptr;
+    const char* firstArgument = nullptr;
+    int numArguments = 0;
+};
+
+} // namespace juce
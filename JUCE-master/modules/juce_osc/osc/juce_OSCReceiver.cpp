@@ -389,12 +389,17 @@ struct OSCReceiver::Pimpl   : private Thread,
     void addListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToAdd,
                       OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, listenersWithAddress);
+        listenersWithAddress.add (addressToMatch, listenerToAdd);
     }
 
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd, OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.add (addressToMatch, listenerToAdd);
+    }
+
+    void addListener (MessageViewListener* listenerToAdd)
+    {
+        viewListeners.add (listenerToAdd);
     }
 
     void removeListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToRemove)
@@ -409,12 +414,17 @@ struct OSCReceiver::Pimpl   : private Thread,
 
     void removeListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, listenersWithAddress);
+        listenersWithAddress.remove (listenerToRemove);
     }
 
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.remove (listenerToRemove);
+    }
+
+    void removeListener (MessageViewListener* listenerToRemove)
+    {
+        viewListeners.remove (listenerToRemove);
     }
 
     //==============================================================================
@@ -429,6 +439,26 @@ struct OSCReceiver::Pimpl   : private Thread,
     //==============================================================================
     void handleBuffer (const char* data, size_t dataSize)
     {
+        if (! viewListeners.isEmpty())
+        {
+            // check the whole packet first, so that a malformed bundle doesn't get
+            // partially delivered
+            if (! forEachMessageView (data, dataSize, [] (const OSCMessageView&) {}))
+            {
+                NullCheckedInvocation::invoke (formatErrorHandler, data, (int) dataSize);
+                return;
+            }
+
+            forEachMessageView (data, dataSize, [this] (const OSCMessageView& message)
+            {
+                viewListeners.call ([&] (MessageViewListener& l) { l.oscMessageReceived (message); });
+            });
+
+            if (listeners.isEmpty() && listenersWithAddress.isEmpty()
+                 && realtimeListeners.isEmpty() && realtimeListenersWithAddress.isEmpty())
+                return;
+        }
+
         OSCInputStream inStream (data, dataSize);
 
         try
@@ -444,7 +474,7 @@ struct OSCReceiver::Pimpl   : private Thread,
 
             // now post the message that will trigger the handleMessage callback
             // dealing with the non-realtime listeners.
-            if (listeners.size() > 0 || listenersWithAddress.size() > 0)
+            if (listeners.size() > 0 || ! listenersWithAddress.isEmpty())
                 postMessage (new CallbackMessage (content));
         }
         catch (const OSCFormatError&)
@@ -461,10 +491,56 @@ struct OSCReceiver::Pimpl   : private Thread,
 
 private:
     //==============================================================================
+    static constexpr int bufferSize = 65535;
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    // Collects as many waiting datagrams as possible with a single system call
+    struct DatagramBatch
+    {
+        static constexpr unsigned int maxNumDatagrams = 16;
+
+        DatagramBatch()
+        {
+            for (unsigned int i = 0; i < maxNumDatagrams; ++i)
+            {
+                vectors[i].iov_base = buffers + (size_t) i * bufferSize;
+                vectors[i].iov_len = (size_t) bufferSize;
+                headers[i].msg_hdr.msg_iov = vectors + i;
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+        }
+
+        int receive (int socketHandle) noexcept
+        {
+            for (auto& h : headers)
+            {
+                h.msg_hdr.msg_name = nullptr;
+                h.msg_hdr.msg_namelen = 0;
+                h.msg_hdr.msg_control = nullptr;
+                h.msg_hdr.msg_controllen = 0;
+                h.msg_hdr.msg_flags = 0;
+                h.msg_len = 0;
+            }
+
+            return ::recvmmsg (socketHandle, headers, maxNumDatagrams, MSG_DONTWAIT, nullptr);
+        }
+
+        const char* getData (int index) const noexcept      { return buffers + (size_t) index * bufferSize; }
+        size_t getSize (int index) const noexcept           { return (size_t) headers[index].msg_len; }
+
+        HeapBlock<char> buffers { (size_t) maxNumDatagrams * bufferSize };
+        iovec vectors[maxNumDatagrams] {};
+        mmsghdr headers[maxNumDatagrams] {};
+    };
+   #endif
+
     void run() override
     {
-        int bufferSize = 65535;
+       #if JUCE_LINUX || JUCE_ANDROID
+        DatagramBatch batch;
+       #else
         HeapBlock<char> oscBuffer (bufferSize);
+       #endif
 
         while (! threadShouldExit())
         {
@@ -477,44 +553,203 @@ private:
             if (ready == 0)
                 continue;
 
-            auto bytesRead = (size_t) socket->read (oscBuffer.getData(), bufferSize, false);
+            // Once the socket is readable, keep reading until there's nothing left, to
+            // avoid waiting on the socket again for every datagram
+           #if JUCE_LINUX || JUCE_ANDROID
+            for (;;)
+            {
+                const auto numReceived = batch.receive (socket->getRawSocketHandle());
+
+                if (numReceived <= 0)
+                    break;
 
-            if (bytesRead >= 4)
-                handleBuffer (oscBuffer.getData(), bytesRead);
+                for (int i = 0; i < numReceived; ++i)
+                    if (batch.getSize (i) >= 4)
+                        handleBuffer (batch.getData (i), batch.getSize (i));
+
+                if (numReceived < (int) DatagramBatch::maxNumDatagrams || threadShouldExit())
+                    break;
+            }
+           #else
+            while (! threadShouldExit())
+            {
+                auto bytesRead = socket->read (oscBuffer.getData(), bufferSize, false);
+
+                if (bytesRead <= 0)
+                    break;
+
+                if (bytesRead >= 4)
+                    handleBuffer (oscBuffer.getData(), (size_t) bytesRead);
+            }
+           #endif
         }
     }
 
     //==============================================================================
-    template <typename ListenerType>
-    void addListenerWithAddress (ListenerType* listenerToAdd,
-                                 OSCAddress address,
-                                 Array<std::pair<OSCAddress, ListenerType*>>& array)
+    // Calls the callback for each message in a packet, including the messages inside
+    // bundles. Returns false if the packet isn't valid OSC data.
+    template <typename Callback>
+    static bool forEachMessageView (const char* data, size_t dataSize, Callback&& callback)
     {
-        for (auto& i : array)
-            if (address == i.first && listenerToAdd == i.second)
-                return;
+        if (dataSize >= 4 && data[0] == '/')
+        {
+            if (auto view = OSCMessageView::fromData (data, dataSize))
+            {
+                callback (*view);
+                return true;
+            }
+
+            return false;
+        }
+
+        if (dataSize < 16 || std::memcmp (data, "#bundle", 8) != 0)
+            return false;
+
+        for (size_t pos = 16; pos < dataSize;)
+        {
+            if (dataSize - pos < 4)
+                return false;
+
+            const auto elementSize = (size_t) ByteOrder::bigEndianInt (data + pos);
+            pos += 4;
 
-        array.add (std::make_pair (address, listenerToAdd));
+            if (elementSize < 4 || elementSize > dataSize - pos
+                 || ! forEachMessageView (data + pos, elementSize, callback))
+                return false;
+
+            pos += elementSize;
+        }
+
+        return true;
     }
 
     //==============================================================================
+    // Holds the listeners that were added with an OSCAddress, arranged in a tree by
+    // the parts of their addresses. Finding the listeners for an incoming address
+    // pattern only visits the nodes along the pattern's path (plus, where a part of the
+    // pattern contains wildcards, the children that it's matched against), so the cost
+    // depends on the depth of the address rather than the number of listeners.
     template <typename ListenerType>
-    void removeListenerWithAddress (ListenerType* listenerToRemove,
-                                    Array<std::pair<OSCAddress, ListenerType*>>& array)
+    class AddressTree
     {
-        for (int i = 0; i < array.size(); ++i)
+    public:
+        void add (const OSCAddress& address, ListenerType* listener)
+        {
+            for (auto& i : registrations)
+                if (address == i.first && listener == i.second)
+                    return;
+
+            registrations.add (std::make_pair (address, listener));
+            findNode (address, true)->listeners.add (listener);
+        }
+
+        void remove (ListenerType* listener)
+        {
+            for (int i = 0; i < registrations.size(); ++i)
+            {
+                auto& registration = registrations.getReference (i);
+
+                if (listener == registration.second)
+                {
+                    if (auto* node = findNode (registration.first, false))
+                        node->listeners.removeFirstMatchingValue (listener);
+
+                    // aarrgh... can't simply call array.remove (i) because this
+                    // requires a default c'tor to be present for OSCAddress...
+                    // luckily, we don't care about methods preserving element order:
+                    registrations.swap (i, registrations.size() - 1);
+                    registrations.removeLast();
+                    break;
+                }
+            }
+        }
+
+        bool isEmpty() const noexcept       { return registrations.isEmpty(); }
+
+        template <typename Callback>
+        void callMatchingListeners (const OSCAddressPattern& pattern, Callback&& callback) const
+        {
+            const auto address = pattern.toString();
+            callMatchingListeners (root, address.toRawUTF8(), callback);
+        }
+
+    private:
+        struct Node
         {
-            if (listenerToRemove == array.getReference (i).second)
+            String name;
+            std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+            Array<ListenerType*> listeners;
+        };
+
+        Node* findNode (const OSCAddress& address, bool createIfMissing)
+        {
+            auto* node = &root;
+
+            for (auto& part : StringArray::fromTokens (address.toString(), "/", {}))
             {
-                // aarrgh... can't simply call array.remove (i) because this
-                // requires a default c'tor to be present for OSCAddress...
-                // luckily, we don't care about methods preserving element order:
-                array.swap (i, array.size() - 1);
-                array.removeLast();
-                break;
+                if (part.isEmpty())
+                    continue;
+
+                auto child = node->children.find (part.toStdString());
+
+                if (child == node->children.end())
+                {
+                    if (! createIfMissing)
+                        return nullptr;
+
+                    auto newNode = std::make_unique<Node>();
+                    newNode->name = part;
+                    child = node->children.emplace (part.toStdString(), std::move (newNode)).first;
+                }
+
+                node = child->second.get();
             }
+
+            return node;
         }
-    }
+
+        template <typename Callback>
+        static void callMatchingListeners (const Node& node, const char* pattern, Callback& callback)
+        {
+            while (*pattern == '/')
+                ++pattern;
+
+            if (*pattern == 0)
+            {
+                for (auto* listener : node.listeners)
+                    callback (*listener);
+
+                return;
+            }
+
+            auto* partEnd = pattern;
+            bool partHasWildcards = false;
+
+            for (; *partEnd != 0 && *partEnd != '/'; ++partEnd)
+                partHasWildcards = partHasWildcards || std::strchr ("?*[]{}", *partEnd) != nullptr;
+
+            const auto partLength = (size_t) (partEnd - pattern);
+
+            if (! partHasWildcards)
+            {
+                auto child = node.children.find (std::string_view (pattern, partLength));
+
+                if (child != node.children.end())
+                    callMatchingListeners (*child->second, partEnd, callback);
+
+                return;
+            }
+
+            const String part (pattern, partLength);
+
+            for (auto& child : node.children)
+                if (matchOscPattern (part, child.second->name))
+                    callMatchingListeners (*child.second, partEnd, callback);
+        }
+
+        Node root;
+        Array<std::pair<OSCAddress, ListenerType*>> registrations;
+    };
 
     //==============================================================================
     void handleMessage (const Message& msg) override
@@ -566,26 +801,21 @@ private:
     //==============================================================================
     void callListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : listenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        listenersWithAddress.callMatchingListeners (message.getAddressPattern(), [&] (auto& l) { l.oscMessageReceived (message); });
     }
 
     void callRealtimeListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : realtimeListenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        realtimeListenersWithAddress.callMatchingListeners (message.getAddressPattern(), [&] (auto& l) { l.oscMessageReceived (message); });
     }
 
     //==============================================================================
     ListenerList<OSCReceiver::Listener<OSCReceiver::MessageLoopCallback>> listeners;
     LightweightListenerList<OSCReceiver::Listener<OSCReceiver::RealtimeCallback>> realtimeListeners;
+    LightweightListenerList<OSCReceiver::MessageViewListener> viewListeners;
 
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>*>> listenersWithAddress;
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*>>    realtimeListenersWithAddress;
+    AddressTree<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>> listenersWithAddress;
+    AddressTree<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>>    realtimeListenersWithAddress;
 
     OptionalScopedPointer<DatagramSocket> socket;
     OSCReceiver::FormatErrorHandler formatErrorHandler { nullptr };
@@ -642,6 +872,11 @@ void OSCReceiver::addListener (ListenerWithOSCAddress<RealtimeCallback>* listene
     pimpl->addListener (listenerToAdd, addressToMatch);
 }
 
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd)
+{
+    pimpl->addListener (listenerToAdd);
+}
+
 void OSCReceiver::removeListener (Listener<MessageLoopCallback>* listenerToRemove)
 {
     pimpl->removeListener (listenerToRemove);
@@ -662,6 +897,11 @@ void OSCReceiver::removeListener (ListenerWithOSCAddress<RealtimeCallback>* list
     pimpl->removeListener (listenerToRemove);
 }
 
+void OSCReceiver::removeListener (MessageViewListener* listenerToRemove)
+{
+    pimpl->removeListener (listenerToRemove);
+}
+
 void OSCReceiver::registerFormatErrorHandler (FormatErrorHandler handler)
 {
     pimpl->registerFormatErrorHandler (handler);
@@ -1197,6 +1437,156 @@ public:
 
 static OSCInputStreamTests OSCInputStreamUnitTests;
 
+//==============================================================================
+class OSCReceiverTests final : public UnitTest
+{
+public:
+    OSCReceiverTests()
+        : UnitTest ("OSCReceiver class", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("message view listeners receive messages and bundle contents");
+        {
+            // The receiver is a MessageListener, so it needs a MessageManager
+            ScopedJuceInitialiser_GUI libraryInitialiser;
+
+            DatagramSocket receiverSocket;
+            expect (receiverSocket.bindToPort (0, "127.0.0.1"));
+
+            OSCReceiver receiver;
+            ViewCounter counter;
+            receiver.addListener (&counter);
+            expect (receiver.connectToSocket (receiverSocket));
+
+            OSCSender sender;
+            expect (sender.connect ("127.0.0.1", receiverSocket.getBoundPort()));
+
+            for (int i = 0; i < numMessages; ++i)
+                expect (sender.send ("/value", (int32) i, 0.5f, String ("text")));
+
+            OSCBundle bundle;
+            bundle.addElement (OSCMessage ("/value", (int32) numMessages, 0.5f, String ("text")));
+            bundle.addElement (OSCMessage ("/value", (int32) numMessages + 1, 0.5f, String ("text")));
+            expect (sender.send (bundle));
+
+            // unlike the OSC data, this should be reported as a format error
+            WaitableEvent formatErrorReceived;
+            receiver.registerFormatErrorHandler ([&] (const char*, int) { formatErrorReceived.signal(); });
+            DatagramSocket().write ("127.0.0.1", receiverSocket.getBoundPort(), "#bad", 4);
+
+            expect (counter.allReceived.wait (5000));
+            expect (formatErrorReceived.wait (5000));
+            expectEquals (counter.numValid.load(), numMessages + 2);
+
+            receiver.removeListener (&counter);
+            receiver.disconnect();
+        }
+
+        beginTest ("address listeners are matched against literal and wildcard patterns");
+        {
+            ScopedJuceInitialiser_GUI libraryInitialiser;
+
+            DatagramSocket receiverSocket;
+            expect (receiverSocket.bindToPort (0, "127.0.0.1"));
+
+            OSCReceiver receiver;
+            OwnedArray<AddressCounter> counters;
+
+            for (int track = 0; track < 20; ++track)
+            {
+                for (auto* param : { "gain", "pan", "mute" })
+                {
+                    auto* counter = counters.add (new AddressCounter());
+                    receiver.addListener (counter, OSCAddress ("/track/" + String (track) + "/" + param));
+                }
+            }
+
+            // a listener added twice with the same address is only called once, and
+            // removing a listener only removes the first address that it was added with
+            receiver.addListener (counters[0], OSCAddress ("/track/0/gain"));
+            receiver.addListener (counters[1], OSCAddress ("/master"));
+            receiver.removeListener (counters[1]);
+
+            expect (receiver.connectToSocket (receiverSocket));
+
+            OSCSender sender;
+            expect (sender.connect ("127.0.0.1", receiverSocket.getBoundPort()));
+
+            WaitableEvent done;
+            SyncListener sync (done);
+            receiver.addListener (&sync, OSCAddress ("/sync"));
+
+            expect (sender.send ("/track/0/gain", 1.0f));
+            expect (sender.send ("/track/1[0-9]/pan", 1.0f));
+            expect (sender.send ("/track/*/mute", 1.0f));
+            expect (sender.send ("/track/{2,3}/*", 1.0f));
+            expect (sender.send ("/track/1", 1.0f));
+            expect (sender.send ("/master", 1.0f));
+            expect (sender.send ("/sync"));
+
+            expect (done.wait (5000));
+
+            auto getCount = [&] (int track, int param) { return counters[track * 3 + param]->numCalls.load(); };
+
+            expectEquals (getCount (0, 0), 1);
+            expectEquals (getCount (0, 1), 1);
+            expectEquals (getCount (10, 1), 1);
+            expectEquals (getCount (1, 1), 0);
+            expectEquals (getCount (7, 2), 1);
+            expectEquals (getCount (2, 0), 1);
+            expectEquals (getCount (3, 2), 2);
+            expectEquals (getCount (4, 0), 0);
+
+            receiver.disconnect();
+        }
+    }
+
+private:
+    static constexpr int numMessages = 200;
+
+    struct AddressCounter final : public OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>
+    {
+        void oscMessageReceived (const OSCMessage&) override     { ++numCalls; }
+
+        std::atomic<int> numCalls { 0 };
+    };
+
+    struct SyncListener final : public OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>
+    {
+        explicit SyncListener (WaitableEvent& e)  : event (e) {}
+        void oscMessageReceived (const OSCMessage&) override     { event.signal(); }
+
+        WaitableEvent& event;
+    };
+
+    struct ViewCounter final : public OSCReceiver::MessageViewListener
+    {
+        void oscMessageReceived (const OSCMessageView& message) override
+        {
+            if (String (message.getAddressPattern()) == "/value"
+                 && message.size() == 3
+                 && message[0].isInt32()
+                 && message[0].getInt32() == numReceived
+                 && exactlyEqual (message[1].getFloat32(), 0.5f)
+                 && String (message[2].getString()) == "text")
+            {
+                ++numValid;
+            }
+
+            if (++numReceived == numMessages + 2)
+                allReceived.signal();
+        }
+
+        int numReceived = 0;
+        std::atomic<int> numValid { 0 };
+        WaitableEvent allReceived;
+    };
+};
+
+static OSCReceiverTests OSCReceiverUnitTests;
+
 #endif
 
 } // namespace juce
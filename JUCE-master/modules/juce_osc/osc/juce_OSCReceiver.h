@@ -166,6 +166,31 @@ public:
         virtual void oscMessageReceived (const OSCMessage& message) = 0;
     };
 
+    //==============================================================================
+    /** A class for receiving OSC messages from an OSCReceiver without any memory
+        being allocated.
+
+        The listener is called directly on the network thread for each OSC message
+        that arrives, including each of the messages inside a bundle. The messages are
+        passed as OSCMessageView objects that refer to the receiver's own buffer, so
+        they're only valid for the duration of the callback.
+
+        If the only listeners that a receiver has are of this type, it won't create any
+        OSCMessage or OSCBundle objects at all, which makes this the cheapest way to
+        handle high rates of incoming messages.
+
+        @see OSCReceiver::addListener, OSCMessageView
+    */
+    class JUCE_API  MessageViewListener
+    {
+    public:
+        /** Destructor. */
+        virtual ~MessageViewListener() = default;
+
+        /** Called when the OSCReceiver receives a new OSC message. */
+        virtual void oscMessageReceived (const OSCMessageView& message) = 0;
+    };
+
     //==============================================================================
     /** Adds a listener that listens to OSC messages and bundles.
         This listener will be called on the application's message loop.
@@ -192,6 +217,12 @@ public:
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd,
                       OSCAddress addressToMatch);
 
+    /** Adds a listener that receives views of OSC messages.
+        This listener will be called in real-time directly on the network thread
+        that receives OSC data.
+    */
+    void addListener (MessageViewListener* listenerToAdd);
+
     /** Removes a previously-registered listener. */
     void removeListener (Listener<MessageLoopCallback>* listenerToRemove);
 
@@ -204,6 +235,9 @@ public:
     /** Removes a previously-registered listener. */
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove);
 
+    /** Removes a previously-registered listener. */
+    void removeListener (MessageViewListener* listenerToRemove);
+
     //==============================================================================
     /** An error handler function for OSC format errors that can be called by the
         OSCReceiver.
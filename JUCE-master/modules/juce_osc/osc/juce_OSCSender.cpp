@@ -208,8 +208,27 @@ namespace
                      && output.setPosition (endPos);
         }
 
+        //==============================================================================
+        /** Returns the number of bytes that writeMessage() would write for a message. */
+        static size_t getEncodedSize (const OSCMessage& msg)
+        {
+            auto getPaddedSize = [] (size_t size) { return (size + 3) & ~(size_t) 3; };
+
+            auto size = getPaddedSize (msg.getAddressPattern().toString().getNumBytesAsUTF8() + 1)
+                      + getPaddedSize ((size_t) msg.size() + 2);
+
+            for (auto& arg : msg)
+            {
+                if (arg.isString())     size += getPaddedSize (arg.getString().getNumBytesAsUTF8() + 1);
+                else if (arg.isBlob())  size += 4 + getPaddedSize (arg.getBlob().getSize());
+                else                    size += 4;
+            }
+
+            return size;
+        }
+
     private:
-        MemoryOutputStream output;
+        PooledMemoryOutputStream output;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
     };
@@ -253,10 +272,58 @@ struct OSCSender::Pimpl
 
     bool disconnect()
     {
+        flush();
+
+        const ScopedLock sl (bundlingLock);
         socket.reset();
         return true;
     }
 
+    //==============================================================================
+    void enableAutoBundling (int maxPacketSizeBytes, int flushIntervalMs, bool coalesce)
+    {
+        disableAutoBundling();
+
+        {
+            const ScopedLock sl (bundlingLock);
+            maxBundleSize = (size_t) jmax (64, maxPacketSizeBytes);
+            coalesceByAddress = coalesce;
+            isBundling = true;
+        }
+
+        if (flushIntervalMs > 0)
+            flusher = std::make_unique<Flusher> (*this, flushIntervalMs);
+    }
+
+    void disableAutoBundling()
+    {
+        flusher.reset();
+        flush();
+
+        const ScopedLock sl (bundlingLock);
+        isBundling = false;
+    }
+
+    bool flush()
+    {
+        const ScopedLock sl (bundlingLock);
+
+        if (pendingMessages.empty())
+            return true;
+
+        // the stream's storage comes from a per-thread pool, so this doesn't allocate
+        OSCOutputStream outStream;
+
+        auto ok = pendingMessages.size() == 1 ? outStream.writeMessage (pendingMessages.front())
+                                              : writePendingBundle (outStream);
+
+        pendingMessages.clear();
+        pendingIndexes.clear();
+        pendingSize = 0;
+
+        return ok && sendOutputStream (outStream, targetHostName, targetPortNumber);
+    }
+
     //==============================================================================
     bool send (const OSCMessage& message, const String& hostName, int portNumber)
     {
@@ -274,10 +341,118 @@ struct OSCSender::Pimpl
             && sendOutputStream (outStream, hostName, portNumber);
     }
 
-    bool send (const OSCMessage& message)   { return send (message, targetHostName, targetPortNumber); }
-    bool send (const OSCBundle& bundle)     { return send (bundle,  targetHostName, targetPortNumber); }
+    bool send (const OSCMessage& message)
+    {
+        {
+            const ScopedLock sl (bundlingLock);
+
+            if (isBundling)
+                return addToBundle (message);
+        }
+
+        return send (message, targetHostName, targetPortNumber);
+    }
+
+    bool send (const OSCBundle& bundle)
+    {
+        // keep this in order with any messages that are waiting to be bundled
+        return flush() && send (bundle, targetHostName, targetPortNumber);
+    }
 
 private:
+    //==============================================================================
+    // Sends the pending messages shortly after the first of them was added
+    struct Flusher final : public Thread
+    {
+        Flusher (Pimpl& p, int intervalMs)  : Thread ("OSC sender"), owner (p), flushIntervalMs (intervalMs)
+        {
+            startThread();
+        }
+
+        ~Flusher() override
+        {
+            signalThreadShouldExit();
+            notify();
+            stopThread (-1);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wait (-1);
+
+                const auto deadline = Time::getMillisecondCounter() + (uint32) flushIntervalMs;
+
+                for (auto now = Time::getMillisecondCounter(); now < deadline && ! threadShouldExit();
+                     now = Time::getMillisecondCounter())
+                    wait ((int) (deadline - now));
+
+                owner.flush();
+            }
+        }
+
+        Pimpl& owner;
+        const int flushIntervalMs;
+    };
+
+    //==============================================================================
+    bool addToBundle (const OSCMessage& message)
+    {
+        const auto messageSize = OSCOutputStream::getEncodedSize (message);
+        const auto address = coalesceByAddress ? message.getAddressPattern().toString() : String();
+
+        if (coalesceByAddress && pendingIndexes.contains (address))
+        {
+            auto& pending = pendingMessages[(size_t) pendingIndexes[address]];
+            const auto sizeWithReplacement = pendingSize - OSCOutputStream::getEncodedSize (pending) + messageSize;
+
+            if (sizeWithReplacement <= maxBundleSize)
+            {
+                pending = message;
+                pendingSize = sizeWithReplacement;
+                return true;
+            }
+        }
+
+        // a bundle has a 16 byte header, and a 4 byte size before each element
+        if (! pendingMessages.empty() && pendingSize + 4 + messageSize > maxBundleSize)
+            if (! flush())
+                return false;
+
+        if (16 + 4 + messageSize > maxBundleSize)
+            return send (message, targetHostName, targetPortNumber);
+
+        if (pendingMessages.empty())
+        {
+            pendingSize = 16;
+
+            if (flusher != nullptr)
+                flusher->notify();
+        }
+
+        if (coalesceByAddress)
+            pendingIndexes.set (address, (int) pendingMessages.size());
+
+        pendingMessages.push_back (message);
+        pendingSize += 4 + messageSize;
+        return true;
+    }
+
+    bool writePendingBundle (OSCOutputStream& outStream)
+    {
+        if (! (outStream.writeString ("#bundle") && outStream.writeTimeTag (OSCTimeTag::immediately)))
+            return false;
+
+        for (auto& message : pendingMessages)
+            if (! (outStream.writeInt32 ((int32) OSCOutputStream::getEncodedSize (message))
+                    && outStream.writeMessage (message)))
+                return false;
+
+        return true;
+    }
+
+    //==============================================================================
     //==============================================================================
     bool sendOutputStream (OSCOutputStream& outStream, const String& hostName, int portNumber)
     {
@@ -302,6 +477,13 @@ private:
     String targetHostName;
     int targetPortNumber = 0;
 
+    CriticalSection bundlingLock;
+    std::vector<OSCMessage> pendingMessages;
+    HashMap<String, int> pendingIndexes;
+    size_t pendingSize = 0, maxBundleSize = 0;
+    bool isBundling = false, coalesceByAddress = false;
+    std::unique_ptr<Flusher> flusher;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
 
@@ -333,6 +515,15 @@ bool OSCSender::disconnect()
     return pimpl->disconnect();
 }
 
+//==============================================================================
+void OSCSender::enableAutoBundling (int maxPacketSizeBytes, int flushIntervalMs, bool coalesceMessagesWithSameAddress)
+{
+    pimpl->enableAutoBundling (maxPacketSizeBytes, flushIntervalMs, coalesceMessagesWithSameAddress);
+}
+
+void OSCSender::disableAutoBundling()   { pimpl->disableAutoBundling(); }
+bool OSCSender::flush()                 { return pimpl->flush(); }
+
 //==============================================================================
 bool OSCSender::send (const OSCMessage& message)    { return pimpl->send (message); }
 bool OSCSender::send (const OSCBundle& bundle)      { return pimpl->send (bundle); }
@@ -880,6 +1071,119 @@ public:
 
 static OSCRoundTripTests OSCRoundTripUnitTests;
 
+//==============================================================================
+class OSCSenderBundlingTests final : public UnitTest
+{
+public:
+    OSCSenderBundlingTests()
+        : UnitTest ("OSCSender auto-bundling", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Encoded message sizes");
+        {
+            for (auto& message : { OSCMessage ("/a"),
+                                   OSCMessage ("/abc", 1, 2.0f),
+                                   OSCMessage ("/abcd", String ("xyz"), String ("wxyz")),
+                                   OSCMessage ("/b", MemoryBlock (5), OSCColour { 1, 2, 3, 4 }) })
+            {
+                OSCOutputStream output;
+                output.writeMessage (message);
+                expectEquals (OSCOutputStream::getEncodedSize (message), output.getDataSize());
+            }
+        }
+
+        DatagramSocket receiverSocket;
+        expect (receiverSocket.bindToPort (0, "127.0.0.1"));
+
+        OSCSender sender;
+        expect (sender.connect ("127.0.0.1", receiverSocket.getBoundPort()));
+
+        beginTest ("Messages with the same address are coalesced");
+        {
+            sender.enableAutoBundling (1400, 0, true);
+            expect (sender.send ("/a", 1));
+            expect (sender.send ("/b", 2));
+            expect (sender.send ("/a", 3));
+            expect (sender.flush());
+
+            auto packets = receivePackets (receiverSocket, 1);
+            expectEquals (packets.size(), 1);
+
+            auto& packet = packets.getReference (0);
+            OSCInputStream input (packet.getData(), packet.getSize());
+            auto bundle = input.readBundle();
+
+            expectEquals (bundle.size(), 2);
+            expectEquals (bundle[0].getMessage().getAddressPattern().toString(), String ("/a"));
+            expectEquals (bundle[0].getMessage()[0].getInt32(), 3);
+            expectEquals (bundle[1].getMessage()[0].getInt32(), 2);
+        }
+
+        beginTest ("Bundles are split to fit the packet size");
+        {
+            constexpr int numMessages = 100;
+            constexpr int maxPacketSize = 256;
+
+            sender.enableAutoBundling (maxPacketSize, 0, false);
+
+            for (int i = 0; i < numMessages; ++i)
+                expect (sender.send ("/value", i));
+
+            expect (sender.flush());
+
+            int numReceived = 0;
+
+            for (auto& packet : receivePackets (receiverSocket, numMessages))
+            {
+                expect (packet.getSize() <= (size_t) maxPacketSize);
+
+                OSCInputStream input (packet.getData(), packet.getSize());
+
+                for (auto& element : input.readBundle())
+                    expectEquals (element.getMessage()[0].getInt32(), numReceived++);
+            }
+
+            expectEquals (numReceived, numMessages);
+        }
+
+        beginTest ("Pending messages are sent after the flush interval");
+        {
+            sender.enableAutoBundling (1400, 10, true);
+            expect (sender.send ("/single", 42));
+
+            auto packets = receivePackets (receiverSocket, 1);
+            expectEquals (packets.size(), 1);
+
+            auto& packet = packets.getReference (0);
+            OSCInputStream input (packet.getData(), packet.getSize());
+            expectEquals (input.readMessage()[0].getInt32(), 42);
+
+            sender.disableAutoBundling();
+        }
+    }
+
+private:
+    static Array<MemoryBlock> receivePackets (DatagramSocket& socket, int maxNumPackets)
+    {
+        Array<MemoryBlock> packets;
+        char buffer[2048];
+
+        while (packets.size() < maxNumPackets && socket.waitUntilReady (true, 1000) == 1)
+        {
+            const auto numRead = socket.read (buffer, (int) sizeof (buffer), false);
+
+            if (numRead > 0)
+                packets.add (MemoryBlock (buffer, (size_t) numRead));
+        }
+
+        return packets;
+    }
+};
+
+static OSCSenderBundlingTests OSCSenderBundlingUnitTests;
+
 #endif
 
 } // namespace juce
@@ -90,10 +90,48 @@ public:
     */
     bool disconnect();
 
+    //==============================================================================
+    /** Makes send() collect messages into OSC bundles, instead of sending each one
+        in a packet of its own.
+
+        This is useful when sending lots of small messages at once (e.g. a set of
+        parameter updates for each frame), because each bundle only needs one system
+        call and one network packet. The messages are sent to the target when adding
+        another one would make the bundle bigger than maxPacketSizeBytes, when flush()
+        is called, and, if flushIntervalMs is greater than zero, that many milliseconds
+        after the first message of the bundle was added. A message that is too big for
+        a bundle of its own is sent straight away.
+
+        If coalesceMessagesWithSameAddress is true, a message replaces any message with
+        the same address pattern that's still waiting to be sent, so only the latest
+        value for each address is sent.
+
+        Only messages passed to send() are bundled; bundles and messages sent with
+        sendToIPAddress() are sent immediately as usual.
+
+        @see disableAutoBundling, flush
+    */
+    void enableAutoBundling (int maxPacketSizeBytes = 1400,
+                             int flushIntervalMs = 5,
+                             bool coalesceMessagesWithSameAddress = true);
+
+    /** Sends any pending messages and goes back to sending each message individually.
+        @see enableAutoBundling
+    */
+    void disableAutoBundling();
+
+    /** Sends any messages that are waiting to be bundled.
+        @returns true if the operation was successful.
+        @see enableAutoBundling
+    */
+    bool flush();
+
     //==============================================================================
     /** Sends an OSC message to the target.
+        If auto-bundling is enabled, the message may be sent later as part of a bundle.
         @param  message   The OSC message to send.
         @returns true if the operation was successful.
+        @see enableAutoBundling
     */
     bool send (const OSCMessage& message);
 
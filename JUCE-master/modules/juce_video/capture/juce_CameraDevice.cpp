@@ -191,6 +191,144 @@ void CameraDevice::removeListener (Listener* listenerToRemove)
         pimpl->removeListener (listenerToRemove);
 }
 
+void CameraDevice::addFrameListener (FrameListener* listenerToAdd)
+{
+   #if JUCE_MAC || JUCE_WINDOWS
+    if (listenerToAdd != nullptr)
+        pimpl->addFrameListener (listenerToAdd);
+   #else
+    // Frames aren't available on this platform yet, use addListener() instead.
+    ignoreUnused (listenerToAdd);
+    jassertfalse;
+   #endif
+}
+
+void CameraDevice::removeFrameListener (FrameListener* listenerToRemove)
+{
+   #if JUCE_MAC || JUCE_WINDOWS
+    if (listenerToRemove != nullptr)
+        pimpl->removeFrameListener (listenerToRemove);
+   #else
+    ignoreUnused (listenerToRemove);
+   #endif
+}
+
+//==============================================================================
+namespace CameraFrameHelpers
+{
+    // BT.601 conversion in 8.8 fixed point
+    static PixelRGB yCbCrToRGB (int y, int cb, int cr, bool fullRange) noexcept
+    {
+        const auto d = cb - 128;
+        const auto e = cr - 128;
+
+        const auto toByte = [] (int v) { return (uint8) jlimit (0, 255, (v + 128) >> 8); };
+
+        PixelRGB result;
+
+        if (fullRange)
+        {
+            const auto c = y * 256;
+            result.setARGB (255, toByte (c + 359 * e), toByte (c - 88 * d - 183 * e), toByte (c + 454 * d));
+        }
+        else
+        {
+            const auto c = (y - 16) * 298;
+            result.setARGB (255, toByte (c + 409 * e), toByte (c - 100 * d - 208 * e), toByte (c + 516 * d));
+        }
+
+        return result;
+    }
+
+    template <typename GetPixel>
+    static Image convert (const CameraDevice::Frame& frame, Image::PixelFormat format, GetPixel&& getPixel)
+    {
+        Image image (format, frame.width, frame.height, false);
+        const Image::BitmapData data (image, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < frame.height; ++y)
+        {
+            for (int x = 0; x < frame.width; ++x)
+            {
+                auto* dest = data.getPixelPointer (x, y);
+
+                if (format == Image::RGB)
+                    reinterpret_cast<PixelRGB*> (dest)->set (getPixel (x, y));
+                else
+                    reinterpret_cast<PixelARGB*> (dest)->set (getPixel (x, y));
+            }
+        }
+
+        return image;
+    }
+}
+
+Image CameraDevice::Frame::toImage() const
+{
+    using namespace CameraFrameHelpers;
+
+    if (width <= 0 || height <= 0 || numPlanes <= 0 || planes[0] == nullptr)
+        return {};
+
+    const auto row = [this] (int plane, int y) { return planes[plane] + (ptrdiff_t) y * lineStrides[plane]; };
+
+    switch (pixelFormat)
+    {
+        case PixelFormat::bgr24:
+            return convert (*this, Image::RGB, [&] (int x, int y)
+            {
+                const auto* p = row (0, y) + x * 3;
+                PixelRGB pixel;
+                pixel.setARGB (255, p[2], p[1], p[0]);
+                return pixel;
+            });
+
+        case PixelFormat::bgra32:
+            return convert (*this, Image::ARGB, [&] (int x, int y)
+            {
+                const auto* p = row (0, y) + x * 4;
+                PixelARGB pixel (p[3], p[2], p[1], p[0]);
+                pixel.premultiply();
+                return pixel;
+            });
+
+        case PixelFormat::nv12:
+        case PixelFormat::nv12FullRange:
+        {
+            if (numPlanes < 2 || planes[1] == nullptr)
+                return {};
+
+            const auto fullRange = pixelFormat == PixelFormat::nv12FullRange;
+
+            return convert (*this, Image::RGB, [&] (int x, int y)
+            {
+                const auto* chroma = row (1, y / 2) + (x & ~1);
+                return yCbCrToRGB (row (0, y)[x], chroma[0], chroma[1], fullRange);
+            });
+        }
+
+        case PixelFormat::yuyv:
+        case PixelFormat::uyvy:
+        {
+            const auto lumaFirst = pixelFormat == PixelFormat::yuyv;
+
+            return convert (*this, Image::RGB, [&] (int x, int y)
+            {
+                const auto* pair = row (0, y) + (x / 2) * 4;
+                const auto luma = lumaFirst ? pair[(x & 1) * 2] : pair[(x & 1) * 2 + 1];
+                const auto cb   = lumaFirst ? pair[1] : pair[0];
+                const auto cr   = lumaFirst ? pair[3] : pair[2];
+                return yCbCrToRGB (luma, cb, cr, false);
+            });
+        }
+
+        case PixelFormat::unknown:
+            break;
+    }
+
+    return {};
+}
+
 //==============================================================================
 StringArray CameraDevice::getAvailableDevices()
 {
@@ -223,6 +223,104 @@ public:
     /** Removes a listener that was previously added with addListener(). */
     void removeListener (Listener* listenerToRemove);
 
+    //==============================================================================
+    /**
+        A video frame from a CameraDevice, pointing straight at the memory that the
+        camera driver delivered it in, so that no conversion or copying has happened.
+
+        The pixel data is only valid during FrameListener::frameReceived(), so
+        anything you need has to be copied or processed before returning.
+
+        To draw frames with OpenGL, the planes can be uploaded as textures as they
+        are, with a shader doing the conversion from YCbCr. On macOS, the
+        CVPixelBufferRef in nativeHandle can also be turned into a texture without
+        copying, using a CVOpenGLTextureCache or CVMetalTextureCache.
+
+        @see FrameListener
+    */
+    struct JUCE_API  Frame
+    {
+        /** The layouts that a frame's pixels can arrive in. */
+        enum class PixelFormat
+        {
+            unknown,        /**< A layout that isn't described here. Use the nativeHandle to read it. */
+            bgr24,          /**< One plane of blue, green and red bytes. */
+            bgra32,         /**< One plane of blue, green, red and alpha bytes. */
+            nv12,           /**< A plane of luma bytes, then a plane of interleaved Cb and Cr bytes
+                                 at half the width and height, in video range. */
+            nv12FullRange,  /**< The same as nv12, but using the full range of values. */
+            yuyv,           /**< One plane of 4:2:2 samples in Y0, Cb, Y1, Cr order, in video range. */
+            uyvy            /**< One plane of 4:2:2 samples in Cb, Y0, Cr, Y1 order, in video range. */
+        };
+
+        /** Converts the frame to an Image. This does the work that Listener::imageReceived()
+            would have done, so only call it when you really need an Image.
+
+            Returns an invalid Image if the pixel format is unknown.
+        */
+        Image toImage() const;
+
+        /** The layout of the pixels. */
+        PixelFormat pixelFormat = PixelFormat::unknown;
+
+        /** The size of the frame in pixels. */
+        int width = 0, height = 0;
+
+        /** The number of planes that are in use. */
+        int numPlanes = 0;
+
+        /** The first row of each plane. */
+        const uint8* planes[3] = {};
+
+        /** The number of bytes from the start of one row to the next, for each plane.
+            This is negative for frames that are stored bottom-up.
+        */
+        int lineStrides[3] = {};
+
+        /** The time at which the frame was captured, in seconds. Only the differences
+            between the times of frames are meaningful.
+        */
+        double timestamp = 0.0;
+
+        /** The platform's own object for the frame: a CVPixelBufferRef on macOS, or an
+            IMediaSample* on Windows. It's only valid during the callback.
+        */
+        void* nativeHandle = nullptr;
+    };
+
+    //==============================================================================
+    /**
+        Receives the frames from a CameraDevice as they arrive from the driver, without
+        converting them to Images.
+
+        This is currently available on macOS and Windows.
+
+        @see CameraDevice::addFrameListener, Frame
+    */
+    class JUCE_API  FrameListener
+    {
+    public:
+        FrameListener() {}
+        virtual ~FrameListener() {}
+
+        /** This method is called when a new frame arrives.
+
+            This is called on the camera's own thread, so be careful about thread-safety.
+            The frame's data can't be used after this returns, and the listener mustn't
+            be removed from inside this callback.
+        */
+        virtual void frameReceived (const Frame& frame) = 0;
+    };
+
+    /** Adds a listener to receive frames from the camera.
+        Be very careful not to delete the listener without first removing it by calling
+        removeFrameListener().
+    */
+    void addFrameListener (FrameListener* listenerToAdd);
+
+    /** Removes a listener that was previously added with addFrameListener(). */
+    void removeFrameListener (FrameListener* listenerToRemove);
+
 private:
     String name;
 
@@ -52,7 +52,7 @@
   minimumCppStandard: 17
 
   dependencies:       juce_gui_extra
-  OSXFrameworks:      AVKit AVFoundation CoreMedia
+  OSXFrameworks:      AVKit AVFoundation CoreMedia CoreVideo
   iOSFrameworks:      AVKit AVFoundation CoreMedia
 
  END_JUCE_MODULE_DECLARATION
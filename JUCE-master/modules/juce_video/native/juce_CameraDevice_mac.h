@@ -76,6 +76,7 @@ struct CameraDevice::Pimpl
         removeInput();
         removeImageCapture();
         removeMovieCapture();
+        removeVideoDataOutput();
         [session release];
         [callbackDelegate release];
     }
@@ -144,6 +145,36 @@ struct CameraDevice::Pimpl
         listeners.remove (listenerToRemove);
     }
 
+    void addFrameListener (CameraDevice::FrameListener* listenerToAdd)
+    {
+        const auto isFirst = [&]
+        {
+            const ScopedLock sl (listenerLock);
+            frameListeners.add (listenerToAdd);
+            return frameListeners.size() == 1;
+        }();
+
+        if (isFirst)
+        {
+            addVideoDataOutput();
+            startSession();
+        }
+    }
+
+    void removeFrameListener (CameraDevice::FrameListener* listenerToRemove)
+    {
+        const auto wasLast = [&]
+        {
+            const ScopedLock sl (listenerLock);
+            frameListeners.remove (listenerToRemove);
+            return frameListeners.isEmpty();
+        }();
+
+        // The lock isn't held here, because the delivery queue may be waiting for it
+        if (wasLast)
+            removeVideoDataOutput();
+    }
+
     static NSArray* getCaptureDevices()
     {
         if (@available (macOS 10.15, *))
@@ -399,6 +430,132 @@ private:
     };
     JUCE_END_IGNORE_DEPRECATION_WARNINGS
 
+    //==============================================================================
+    /*  Delivers the camera's frames in the device's own format, rather than
+        converting them, and passes them on to the FrameListeners.
+    */
+    class VideoDataDelegateClass  : public ObjCClass<NSObject<AVCaptureVideoDataOutputSampleBufferDelegate>>
+    {
+    public:
+        VideoDataDelegateClass()
+            : ObjCClass ("JUCECameraVideoDataDelegate_")
+        {
+            addIvar<Pimpl*> ("owner");
+
+            addMethod (@selector (captureOutput:didOutputSampleBuffer:fromConnection:),
+                       [] (id self, SEL, AVCaptureOutput*, CMSampleBufferRef sampleBuffer, AVCaptureConnection*)
+                       {
+                           getOwner (self).handleSampleBuffer (sampleBuffer);
+                       });
+
+            registerClass();
+        }
+
+        static Pimpl& getOwner (id self) { return *getIvar<Pimpl*> (self, "owner"); }
+        static void setOwner (id self, Pimpl* t) { object_setInstanceVariable (self, "owner", t); }
+    };
+
+    void addVideoDataOutput()
+    {
+        if (videoDataOutput != nil)
+            return;
+
+        static VideoDataDelegateClass cls;
+        videoDataDelegate.reset ([cls.createInstance() init]);
+        VideoDataDelegateClass::setOwner (videoDataDelegate.get(), this);
+
+        videoDataQueue = dispatch_queue_create ("JUCE camera frames", DISPATCH_QUEUE_SERIAL);
+
+        videoDataOutput = [[AVCaptureVideoDataOutput alloc] init];
+
+        // An empty dictionary asks for the device's native format
+        videoDataOutput.videoSettings = @{};
+        videoDataOutput.alwaysDiscardsLateVideoFrames = YES;
+        [videoDataOutput setSampleBufferDelegate: videoDataDelegate.get()
+                                           queue: videoDataQueue];
+
+        [session beginConfiguration];
+
+        if ([session canAddOutput: videoDataOutput])
+            [session addOutput: videoDataOutput];
+
+        [session commitConfiguration];
+    }
+
+    void removeVideoDataOutput()
+    {
+        if (videoDataOutput == nil)
+            return;
+
+        [videoDataOutput setSampleBufferDelegate: nil queue: nil];
+        [session removeOutput: videoDataOutput];
+        [videoDataOutput release];
+        videoDataOutput = nil;
+
+        // Let any frame that's being delivered finish before the delegate goes away
+        dispatch_sync (videoDataQueue, ^{});
+        dispatch_release (videoDataQueue);
+        videoDataQueue = nullptr;
+
+        videoDataDelegate.reset();
+    }
+
+    static CameraDevice::Frame::PixelFormat getPixelFormat (OSType type)
+    {
+        using PixelFormat = CameraDevice::Frame::PixelFormat;
+
+        switch (type)
+        {
+            case kCVPixelFormatType_24BGR:                          return PixelFormat::bgr24;
+            case kCVPixelFormatType_32BGRA:                         return PixelFormat::bgra32;
+            case kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange:   return PixelFormat::nv12;
+            case kCVPixelFormatType_420YpCbCr8BiPlanarFullRange:    return PixelFormat::nv12FullRange;
+            case kCVPixelFormatType_422YpCbCr8_yuvs:                return PixelFormat::yuyv;
+            case kCVPixelFormatType_422YpCbCr8:                     return PixelFormat::uyvy;
+            default:                                                return PixelFormat::unknown;
+        }
+    }
+
+    void handleSampleBuffer (CMSampleBufferRef sampleBuffer)
+    {
+        auto pixelBuffer = CMSampleBufferGetImageBuffer (sampleBuffer);
+
+        if (pixelBuffer == nullptr
+             || CVPixelBufferLockBaseAddress (pixelBuffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess)
+            return;
+
+        CameraDevice::Frame frame;
+        frame.pixelFormat = getPixelFormat (CVPixelBufferGetPixelFormatType (pixelBuffer));
+        frame.width  = (int) CVPixelBufferGetWidth (pixelBuffer);
+        frame.height = (int) CVPixelBufferGetHeight (pixelBuffer);
+        frame.timestamp = CMTimeGetSeconds (CMSampleBufferGetPresentationTimeStamp (sampleBuffer));
+        frame.nativeHandle = pixelBuffer;
+
+        if (CVPixelBufferIsPlanar (pixelBuffer))
+        {
+            frame.numPlanes = (int) jmin ((size_t) 3, CVPixelBufferGetPlaneCount (pixelBuffer));
+
+            for (int i = 0; i < frame.numPlanes; ++i)
+            {
+                frame.planes[i] = static_cast<const uint8*> (CVPixelBufferGetBaseAddressOfPlane (pixelBuffer, (size_t) i));
+                frame.lineStrides[i] = (int) CVPixelBufferGetBytesPerRowOfPlane (pixelBuffer, (size_t) i);
+            }
+        }
+        else
+        {
+            frame.numPlanes = 1;
+            frame.planes[0] = static_cast<const uint8*> (CVPixelBufferGetBaseAddress (pixelBuffer));
+            frame.lineStrides[0] = (int) CVPixelBufferGetBytesPerRow (pixelBuffer);
+        }
+
+        {
+            const ScopedLock sl (listenerLock);
+            frameListeners.call ([&] (FrameListener& l) { l.frameReceived (frame); });
+        }
+
+        CVPixelBufferUnlockBaseAddress (pixelBuffer, kCVPixelBufferLock_ReadOnly);
+    }
+
     //==============================================================================
     void addImageCapture()
     {
@@ -569,6 +726,11 @@ private:
 
     CriticalSection listenerLock;
     ListenerList<Listener> listeners;
+    ListenerList<FrameListener> frameListeners;
+
+    AVCaptureVideoDataOutput* videoDataOutput = nil;
+    NSUniquePtr<NSObject<AVCaptureVideoDataOutputSampleBufferDelegate>> videoDataDelegate;
+    dispatch_queue_t videoDataQueue = nullptr;
 
     std::function<void (const Image&)> pictureTakenCallback = nullptr;
 
@@ -134,8 +134,9 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             sampleGrabber->SetMediaType (&mt);
         }
 
+        // Using SampleCB rather than BufferCB means the grabber doesn't copy each frame
         callback = becomeComSmartPtrOwner (new GrabberCallback (*this));
-        hr = sampleGrabber->SetCallback (callback, 1);
+        hr = sampleGrabber->SetCallback (callback, 0);
 
         hr = graphBuilder->AddFilter (sampleGrabberBase, _T ("Sample Grabber"));
         if (FAILED (hr))
@@ -254,12 +255,53 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             removeUser();
     }
 
+    void addFrameListener (CameraDevice::FrameListener* listenerToAdd)
+    {
+        const ScopedLock sl (listenerLock);
+
+        if (frameListeners.size() == 0)
+            addUser();
+
+        frameListeners.add (listenerToAdd);
+    }
+
+    void removeFrameListener (CameraDevice::FrameListener* listenerToRemove)
+    {
+        const ScopedLock sl (listenerLock);
+        frameListeners.remove (listenerToRemove);
+
+        if (frameListeners.size() == 0)
+            removeUser();
+    }
+
     void callListeners (const Image& image)
     {
         const ScopedLock sl (listenerLock);
         listeners.call ([=] (Listener& l) { l.imageReceived (image); });
     }
 
+    void callFrameListeners (const CameraDevice::Frame& frame)
+    {
+        const ScopedLock sl (listenerLock);
+        frameListeners.call ([&] (FrameListener& l) { l.frameReceived (frame); });
+    }
+
+    bool needsImages()
+    {
+        if (numViewers > 0)
+            return true;
+
+        {
+            const ScopedLock sl (listenerLock);
+
+            if (! listeners.isEmpty())
+                return true;
+        }
+
+        const ScopedLock sl (pictureTakenCallbackLock);
+        return pictureTakenCallback != nullptr;
+    }
+
     void notifyPictureTakenIfNeeded (const Image& image)
     {
         {
@@ -291,8 +333,13 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             mediaControl->Stop();
     }
 
-    void handleFrame (double /*time*/, BYTE* buffer, long /*bufferSize*/)
+    void handleFrame (double time, IMediaSample* sample)
     {
+        BYTE* buffer = nullptr;
+
+        if (FAILED (sample->GetPointer (&buffer)) || buffer == nullptr)
+            return;
+
         if (recordNextFrameTime)
         {
             const double defaultCameraLatency = 0.1;
@@ -313,8 +360,30 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             }
         }
 
+        // The grabber delivers bottom-up RGB24 rows, padded to a multiple of 4 bytes
+        const int lineStride = (width * 3 + 3) & ~3;
+
+        if ((long) lineStride * height > sample->GetActualDataLength())
+            return;
+
+        {
+            CameraDevice::Frame frame;
+            frame.pixelFormat = CameraDevice::Frame::PixelFormat::bgr24;
+            frame.width = width;
+            frame.height = height;
+            frame.numPlanes = 1;
+            frame.planes[0] = buffer + lineStride * (height - 1);
+            frame.lineStrides[0] = -lineStride;
+            frame.timestamp = time;
+            frame.nativeHandle = sample;
+
+            callFrameListeners (frame);
+        }
+
+        if (! needsImages())
+            return;
+
         Image loadingImage (Image::RGB, width, height, true);
-        const int lineStride = width * 3;
 
         {
             const Image::BitmapData destData (loadingImage, 0, 0, width, height, Image::BitmapData::writeOnly);
@@ -322,7 +391,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             for (int i = 0; i < height; ++i)
                 memcpy (destData.getLinePointer ((height - 1) - i),
                         buffer + lineStride * i,
-                        (size_t) lineStride);
+                        (size_t) width * 3);
         }
 
         if (! listeners.isEmpty())
@@ -559,14 +628,14 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             return ComBaseClassHelperBase<ISampleGrabberCB>::QueryInterface (refId, result);
         }
 
-        JUCE_COMRESULT SampleCB (double, IMediaSample*)  override { return E_FAIL; }
-
-        JUCE_COMRESULT BufferCB (double time, BYTE* buffer, long bufferSize) override
+        JUCE_COMRESULT SampleCB (double time, IMediaSample* sample) override
         {
-            owner.handleFrame (time, buffer, bufferSize);
+            owner.handleFrame (time, sample);
             return S_OK;
         }
 
+        JUCE_COMRESULT BufferCB (double, BYTE*, long) override { return E_FAIL; }
+
         Pimpl& owner;
 
         JUCE_DECLARE_NON_COPYABLE (GrabberCallback)
@@ -578,6 +647,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
 
     CriticalSection listenerLock;
     ListenerList<Listener> listeners;
+    ListenerList<FrameListener> frameListeners;
 
     CriticalSection pictureTakenCallbackLock;
     std::function<void (const Image&)> pictureTakenCallback;
@@ -587,6 +657,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
     Time firstRecordedTime;
 
     Array<ViewerComponent*> viewerComps;
+    std::atomic<int> numViewers { 0 };
 
     ComSmartPtr<ICaptureGraphBuilder2> captureGraphBuilder;
     ComSmartPtr<IBaseFilter> filter, smartTee, asfWriter;
@@ -789,6 +860,7 @@ struct CameraDevice::ViewerComponent  : public Component,
         owner->addChangeListener (this);
         owner->addUser();
         owner->viewerComps.add (this);
+        ++owner->numViewers;
         setSize (owner->width, owner->height);
     }
 
@@ -797,6 +869,7 @@ struct CameraDevice::ViewerComponent  : public Component,
         if (owner != nullptr)
         {
             owner->viewerComps.removeFirstMatchingValue (this);
+            --owner->numViewers;
             owner->removeUser();
             owner->removeChangeListener (this);
         }